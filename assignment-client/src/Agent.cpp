@@ -114,7 +114,7 @@ Agent::Agent(ReceivedMessage& message) :
         { PacketType::MixedAudio, PacketType::SilentAudioFrame },
         PacketReceiver::makeUnsourcedListenerReference<Agent>(this, &Agent::handleAudioPacket));
     packetReceiver.registerListenerForTypes(
-        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
+        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityPhysicsState },
         PacketReceiver::makeSourcedListenerReference<Agent>(this, &Agent::handleOctreePacket));
     packetReceiver.registerListener(PacketType::SelectedAudioFormat,
         PacketReceiver::makeUnsourcedListenerReference<Agent>(this, &Agent::handleSelectedAudioFormat));
@@ -167,6 +167,8 @@ void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNo
         _entityViewer.processDatagram(*message, senderNode);
     } else if (packetType == PacketType::EntityErase) {
         _entityViewer.processEraseMessage(*message, senderNode);
+    } else if (packetType == PacketType::EntityPhysicsState) {
+        _entityViewer.getTree()->processPhysicsStateMessage(*message, senderNode);
     }
 }
 
@@ -669,6 +671,10 @@ void Agent::queryAvatars() {
 
     destinationBuffer += conicalView.serialize(destinationBuffer);
 
+    AvatarDataPacket::QueryCapabilities capabilities = AvatarDataPacket::QUERY_WANTS_COMPACT_JOINT_DATA;
+    memcpy(destinationBuffer, &capabilities, sizeof(capabilities));
+    destinationBuffer += sizeof(capabilities);
+
     avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
     DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket),
@@ -714,21 +720,20 @@ void Agent::processAgentAvatarAudio() {
 
         int16_t numAvailableSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
         const int16_t* nextSoundOutput = NULL;
+        int16_t soundSamples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
 
         if (_avatarSound && _avatarSound->isReady()) {
             if (isPlayingRecording && !_shouldMuteRecordingAudio) {
                 _shouldMuteRecordingAudio = true;
             }
-            
-            auto audioData = _avatarSound->getAudioData();
-            nextSoundOutput = reinterpret_cast<const int16_t*>(audioData->rawData()
-                    + _numAvatarSoundSentBytes);
-
-            int numAvailableBytes = (audioData->getNumBytes() - _numAvatarSoundSentBytes) > AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL
-                ? AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL
-                : audioData->getNumBytes() - _numAvatarSoundSentBytes;
-            numAvailableSamples = (int16_t)numAvailableBytes / sizeof(int16_t);
 
+            // a long sound is decoded as it is sent
+            if (!_avatarSoundStream) {
+                _avatarSoundStream = _avatarSound->createStream();
+            }
+            numAvailableSamples = (int16_t)_avatarSoundStream->read(soundSamples,
+                                                                    AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            nextSoundOutput = soundSamples;
 
             // check if the all of the _numAvatarAudioBufferSamples to be sent are silence
             for (int i = 0; i < numAvailableSamples; ++i) {
@@ -738,12 +743,12 @@ void Agent::processAgentAvatarAudio() {
                 }
             }
 
-            _numAvatarSoundSentBytes += numAvailableBytes;
-            if (_numAvatarSoundSentBytes == (int)audioData->getNumBytes()) {
+            if (numAvailableSamples < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL ||
+                _avatarSoundStream->getPosition() >= _avatarSoundStream->getNumSamples()) {
                 // we're done with this sound object - so set our pointer back to NULL
-                // and our sent bytes back to zero
+                // and drop its stream
                 _avatarSound.clear();
-                _numAvatarSoundSentBytes = 0;
+                _avatarSoundStream.reset();
                 _flushEncoder = true;
 
                 if (_shouldMuteRecordingAudio) {
@@ -97,7 +97,7 @@ private:
     MixedAudioStream _receivedAudioStream;
     float _lastReceivedAudioLoudness;
 
-    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; }
+    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; _avatarSoundStream.reset(); }
 
     void queryAvatars();
 
@@ -107,7 +107,7 @@ private:
     bool _isListeningToAudioStream = false;
     SharedSoundPointer _avatarSound;
     bool _shouldMuteRecordingAudio { false };
-    int _numAvatarSoundSentBytes = 0;
+    std::unique_ptr<SoundStream> _avatarSoundStream;
     bool _isAvatar = false;
     QTimer* _avatarQueryTimer = nullptr;
     QHash<QUuid, quint16> _outgoingScriptAudioSequenceNumbers;
@@ -292,10 +292,15 @@ void AssignmentClientMonitor::spawnChildClient() {
 }
 
 void AssignmentClientMonitor::checkSpares() {
+    static const unsigned int MAX_TARGET_SPARE_COUNT = 8;
+    static const quint64 SPARE_DECAY_USECS = 60 * USECS_PER_SECOND;
+
     auto nodeList = DependencyManager::get<NodeList>();
     QUuid aSpareId = "";
     unsigned int spareCount = 0;
     unsigned int totalCount = 0;
+    unsigned int sparesTaken = 0;
+    QSet<QUuid> spareIDs;
 
     nodeList->removeSilentNodes();
 
@@ -305,19 +310,49 @@ void AssignmentClientMonitor::checkSpares() {
         if (childData->getChildType() == Assignment::Type::AllTypes) {
             ++spareCount;
             aSpareId = node->getUUID();
+            spareIDs.insert(node->getUUID());
+        } else if (_lastSpareIDs.contains(node->getUUID())) {
+            ++sparesTaken;
         }
     });
+    _lastSpareIDs = spareIDs;
+
+    // Keep more spares while the domain keeps handing out assignments, e.g. a burst of queued agents, and fewer once
+    // it stops.
+    quint64 now = usecTimestampNow();
+    if (sparesTaken > 0) {
+        _targetSpareCount = std::min(_targetSpareCount * 2, MAX_TARGET_SPARE_COUNT);
+        _lastSpareTakenUsecs = now;
+    } else if (_targetSpareCount > 1 && now - _lastSpareTakenUsecs > SPARE_DECAY_USECS) {
+        --_targetSpareCount;
+        _lastSpareTakenUsecs = now;
+    }
 
     // Spawn or kill children, as needed.  If --min or --max weren't specified, allow the child count
     // to drift up or down as far as needed.
 
-    if (spareCount < 1 || totalCount < _minAssignmentClientForks) {
-        if (!_maxAssignmentClientForks || totalCount < _maxAssignmentClientForks) {
-            spawnChildClient();
-        }
+    // the children spawned that have yet to report in will be spares too
+    unsigned int numChildren = (unsigned int)_childProcesses.size();
+    unsigned int pendingCount = numChildren > totalCount ? numChildren - totalCount : 0;
+    unsigned int numToSpawn = 0;
+    if (spareCount + pendingCount < _targetSpareCount) {
+        numToSpawn = _targetSpareCount - spareCount - pendingCount;
+    }
+    if (totalCount + pendingCount < _minAssignmentClientForks) {
+        numToSpawn = std::max(numToSpawn, _minAssignmentClientForks - totalCount - pendingCount);
+    }
+    if (_maxAssignmentClientForks) {
+        unsigned int room = numChildren < _maxAssignmentClientForks ? _maxAssignmentClientForks - numChildren : 0;
+        numToSpawn = std::min(numToSpawn, room);
+    }
+    if (numToSpawn > 0) {
+        qDebug() << "spawning" << numToSpawn << "children to keep" << _targetSpareCount << "spares";
+    }
+    for (unsigned int i = 0; i < numToSpawn; ++i) {
+        spawnChildClient();
     }
 
-    if (spareCount > 1) {
+    if (spareCount > _targetSpareCount) {
         if (!_minAssignmentClientForks || totalCount > _minAssignmentClientForks) {
             // kill aSpareId
             qDebug() << "asking child" << aSpareId << "to exit.";
@@ -399,6 +434,7 @@ bool AssignmentClientMonitor::handleHTTPRequest(HTTPConnection* connection, cons
         }
 
         status["servers"] = servers;
+        status["target_spare_count"] = (int)_targetSpareCount;
 
         QJsonDocument document { status };
 
@@ -83,6 +83,12 @@ private:
 
     bool _wantsChildFileLogging { false };
     bool _disableDomainPortAutoDiscovery { false };
+
+    // the number of idle children kept ready, doubled each time spares are taken by assignments and brought back
+    // down one at a time once none have been for a while
+    unsigned int _targetSpareCount { 1 };
+    QSet<QUuid> _lastSpareIDs;
+    quint64 _lastSpareTakenUsecs { 0 };
 };
 
 #endif // hifi_AssignmentClientMonitor_h
@@ -0,0 +1,93 @@
+//
+//  AssetChunkIndex.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkIndex.h"
+
+#include <QtCore/QRegExp>
+#include <QtCore/QThreadPool>
+
+#include "AssetServerLogging.h"
+
+void AssetChunkIndex::addFile(const AssetUtils::AssetHash& fileHash, const char* data, size_t size) {
+    if (size < AssetUtils::MIN_CHUNKED_UPLOAD_SIZE) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_chunksByFile.contains(fileHash)) {
+            return;
+        }
+    }
+
+    // chunked without the lock, it reads the whole file
+    auto chunks = AssetUtils::chunkData(data, size);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_chunksByFile.contains(fileHash)) {
+        return;
+    }
+    auto& fileChunks = _chunksByFile[fileHash];
+    fileChunks.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+        _chunks.insert(chunk.hash, { fileHash, chunk.offset, chunk.size });
+        fileChunks.push_back(chunk.hash);
+    }
+}
+
+void AssetChunkIndex::removeFile(const AssetUtils::AssetHash& fileHash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto fileChunks = _chunksByFile.find(fileHash);
+    if (fileChunks == _chunksByFile.end()) {
+        return;
+    }
+    for (const auto& chunkHash : *fileChunks) {
+        auto chunk = _chunks.find(chunkHash);
+        // another file may have the same chunk, and be where it's found now
+        if (chunk != _chunks.end() && chunk->fileHash == fileHash) {
+            _chunks.erase(chunk);
+        }
+    }
+    _chunksByFile.erase(fileChunks);
+}
+
+bool AssetChunkIndex::findChunk(const QByteArray& chunkHash, Location& location) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto chunk = _chunks.find(chunkHash);
+    if (chunk == _chunks.end()) {
+        return false;
+    }
+    location = *chunk;
+    return true;
+}
+
+void AssetChunkIndex::indexFiles(const QDir& filesDirectory, const std::shared_ptr<AssetFileCache>& fileCache) {
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    QStringList fileNames;
+    for (const auto& fileInfo : filesDirectory.entryInfoList(QDir::Files)) {
+        if (hashFileRegex.exactMatch(fileInfo.fileName()) && (uint64_t)fileInfo.size() >= AssetUtils::MIN_CHUNKED_UPLOAD_SIZE) {
+            fileNames.push_back(fileInfo.fileName());
+        }
+    }
+
+    auto self = shared_from_this();
+    QThreadPool::globalInstance()->start([self, fileNames, fileCache] {
+        for (const auto& fileName : fileNames) {
+            if (self->_stopIndexingFiles) {
+                return;
+            }
+            auto file = fileCache->getFile(fileName);
+            if (file) {
+                self->addFile(fileName, reinterpret_cast<const char*>(file->data()), file->size());
+            }
+        }
+        qCDebug(asset_server) << "Indexed the chunks of" << fileNames.size() << "asset files";
+    });
+}
@@ -0,0 +1,53 @@
+//
+//  AssetChunkIndex.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkIndex_h
+#define hifi_AssetChunkIndex_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+
+#include "AssetFileCache.h"
+#include "AssetUtils.h"
+
+// Where the chunks of the asset files are, by hash, so a chunked upload only needs to send the chunks no file
+// has yet; the rest are copied from the files that have them. The files are split as AssetUtils::chunkData()
+// splits uploads, and only those big enough to be uploaded in chunks are indexed.
+class AssetChunkIndex : public std::enable_shared_from_this<AssetChunkIndex> {
+public:
+    struct Location {
+        AssetUtils::AssetHash fileHash;
+        uint64_t offset;
+        uint32_t size;
+    };
+
+    void addFile(const AssetUtils::AssetHash& fileHash, const char* data, size_t size);
+    void removeFile(const AssetUtils::AssetHash& fileHash);
+    bool findChunk(const QByteArray& chunkHash, Location& location) const;
+
+    // Indexes the asset files already there, on a thread of its own, until done or stopped
+    void indexFiles(const QDir& filesDirectory, const std::shared_ptr<AssetFileCache>& fileCache);
+    void stopIndexingFiles() { _stopIndexingFiles = true; }
+
+private:
+    mutable std::mutex _mutex;
+    QHash<QByteArray, Location> _chunks;
+    QHash<AssetUtils::AssetHash, std::vector<QByteArray>> _chunksByFile;
+
+    std::atomic<bool> _stopIndexingFiles { false };
+};
+
+#endif // hifi_AssetChunkIndex_h
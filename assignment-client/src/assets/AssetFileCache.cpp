@@ -0,0 +1,105 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QFileInfo>
+
+#include "AssetServerLogging.h"
+
+namespace {
+    // files up to this size are kept in memory, larger ones are mapped
+    const size_t MAX_CACHED_FILE_SIZE = 1024 * 1024;
+    const size_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+}
+
+AssetFileCache::AssetFileCache(const QDir& filesDirectory) :
+    _filesDirectory(filesDirectory)
+{
+}
+
+storage::StoragePointer AssetFileCache::getFile(const AssetUtils::AssetHash& hash) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto cached = _cachedFiles.find(hash);
+        if (cached != _cachedFiles.end()) {
+            _recentlyUsed.splice(_recentlyUsed.begin(), _recentlyUsed, cached->recentlyUsed);
+            return cached->contents;
+        }
+        auto mapped = _mappedFiles.value(hash).lock();
+        if (mapped) {
+            return mapped;
+        }
+    }
+
+    QString filePath = _filesDirectory.absoluteFilePath(hash);
+    if (!QFileInfo(filePath).isFile()) {
+        return nullptr;
+    }
+    auto file = std::make_shared<storage::FileStorage>(filePath);
+    if (!(*file)) {
+        return nullptr;
+    }
+
+    if (file->size() > MAX_CACHED_FILE_SIZE) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto i = _mappedFiles.begin(); i != _mappedFiles.end();) {
+            if (i->expired()) {
+                i = _mappedFiles.erase(i);
+            } else {
+                ++i;
+            }
+        }
+        // another request may have mapped it in the meantime, either mapping is fine to send from
+        _mappedFiles.insert(hash, file);
+        return file;
+    }
+
+    auto contents = file->toMemoryStorage();
+    auto data = QByteArray::fromRawData(reinterpret_cast<const char*>(contents->data()), (int)contents->size());
+    if (AssetUtils::hashData(data).toHex() == hash) {
+        cacheFile(hash, contents);
+    } else {
+        // most likely an upload still being written, send what is there but don't keep it
+        qCDebug(asset_server) << "Not caching asset file" << hash << "since its contents don't match its hash";
+    }
+    return contents;
+}
+
+void AssetFileCache::cacheFile(const AssetUtils::AssetHash& hash, const storage::StoragePointer& contents) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_cachedFiles.contains(hash)) {
+        return;
+    }
+
+    _recentlyUsed.push_front(hash);
+    _cachedFiles.insert(hash, { contents, _recentlyUsed.begin() });
+    _cachedSize += contents->size();
+
+    while (_cachedSize > MAX_CACHE_SIZE && !_recentlyUsed.empty()) {
+        auto leastRecentlyUsed = _cachedFiles.find(_recentlyUsed.back());
+        _cachedSize -= leastRecentlyUsed->contents->size();
+        _cachedFiles.erase(leastRecentlyUsed);
+        _recentlyUsed.pop_back();
+    }
+}
+
+void AssetFileCache::removeFile(const AssetUtils::AssetHash& hash) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto cached = _cachedFiles.find(hash);
+    if (cached != _cachedFiles.end()) {
+        _cachedSize -= cached->contents->size();
+        _recentlyUsed.erase(cached->recentlyUsed);
+        _cachedFiles.erase(cached);
+    }
+    // a mapping still being sent from stays valid after the file is removed, it just isn't found again
+    _mappedFiles.remove(hash);
+}
@@ -0,0 +1,58 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <list>
+#include <mutex>
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+
+#include <shared/Storage.h>
+
+#include "AssetUtils.h"
+
+// The asset files the asset server sends from. Asset files are named by the hash of their contents and never change,
+// so their contents can be shared by every request for them. Small files are kept in memory, up to a total size,
+// dropping the least recently used first; they are only kept once their contents are checked against their hash.
+// Larger files are memory mapped instead, and the mapping is shared by the requests sending it at the same time, so
+// a large asset asked for by many users at once is sent from one copy in the page cache rather than one in memory
+// per request.
+class AssetFileCache {
+public:
+    AssetFileCache(const QDir& filesDirectory);
+
+    // the contents of the asset file, or nullptr if there's no such file
+    storage::StoragePointer getFile(const AssetUtils::AssetHash& hash);
+
+    // drops the file from the cache, for when it is deleted
+    void removeFile(const AssetUtils::AssetHash& hash);
+
+private:
+    struct CachedFile {
+        storage::StoragePointer contents;
+        std::list<AssetUtils::AssetHash>::iterator recentlyUsed;
+    };
+
+    void cacheFile(const AssetUtils::AssetHash& hash, const storage::StoragePointer& contents);
+
+    const QDir _filesDirectory;
+
+    std::mutex _mutex;
+    QHash<AssetUtils::AssetHash, CachedFile> _cachedFiles;
+    std::list<AssetUtils::AssetHash> _recentlyUsed; // most recently used first
+    size_t _cachedSize { 0 };
+    QHash<AssetUtils::AssetHash, std::weak_ptr<const storage::Storage>> _mappedFiles;
+};
+
+#endif // hifi_AssetFileCache_h
@@ -0,0 +1,165 @@
+//
+//  AssetHTTPServer.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetHTTPServer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QIODevice>
+#include <QtCore/QRegExp>
+
+#include <HTTPConnection.h>
+#include <HTTPSConnection.h>
+
+#include "AssetServerLogging.h"
+
+namespace {
+    const QString HASH_PATH_PREFIX = "/hash/";
+    const char* STATUS_CODE_206 = "206 Partial Content";
+    const char* STATUS_CODE_304 = "304 Not Modified";
+    const char* STATUS_CODE_416 = "416 Range Not Satisfiable";
+    const char* ASSET_CONTENT_TYPE = "application/octet-stream";
+    const QByteArray IMMUTABLE_CACHE_CONTROL = "public, max-age=31536000, immutable";
+
+    // reads a range of an asset file straight from the cache or the mapping
+    class AssetFileDevice : public QIODevice {
+    public:
+        AssetFileDevice(const storage::StoragePointer& file, qint64 offset, qint64 size) :
+            _file(file),
+            _offset(offset),
+            _size(size)
+        {
+            open(QIODevice::ReadOnly);
+        }
+
+        qint64 size() const override { return _size; }
+
+    protected:
+        qint64 readData(char* data, qint64 maxSize) override {
+            qint64 bytesToRead = std::min(maxSize, _size - pos());
+            if (bytesToRead <= 0) {
+                return bytesToRead == 0 ? 0 : -1;
+            }
+            memcpy(data, _file->data() + _offset + pos(), bytesToRead);
+            return bytesToRead;
+        }
+        qint64 writeData(const char* data, qint64 maxSize) override { return -1; }
+
+    private:
+        storage::StoragePointer _file;
+        qint64 _offset;
+        qint64 _size;
+    };
+
+    // parses a single "bytes=" range into [first, last], false if it can't be satisfied, leaves the whole file if
+    // there's no range or it isn't one we handle
+    bool parseRange(const QByteArray& rangeHeader, qint64 fileSize, qint64& first, qint64& last, bool& isRange) {
+        first = 0;
+        last = fileSize - 1;
+        isRange = false;
+
+        static const QRegExp RANGE_REGEX { "^bytes=(\\d*)-(\\d*)$" };
+        QRegExp rangeRegex { RANGE_REGEX };
+        if (rangeHeader.isEmpty() || !rangeRegex.exactMatch(QString::fromLatin1(rangeHeader).trimmed())) {
+            return true;
+        }
+        QString start = rangeRegex.cap(1);
+        QString end = rangeRegex.cap(2);
+        if (start.isEmpty() && end.isEmpty()) {
+            return true;
+        }
+
+        isRange = true;
+        if (start.isEmpty()) {
+            // the last N bytes
+            qint64 suffixLength = end.toLongLong();
+            if (suffixLength <= 0 || fileSize == 0) {
+                return false;
+            }
+            first = std::max<qint64>(fileSize - suffixLength, 0);
+        } else {
+            first = start.toLongLong();
+            if (!end.isEmpty()) {
+                last = std::min(end.toLongLong(), fileSize - 1);
+            }
+        }
+        return first <= last && first < fileSize;
+    }
+}
+
+AssetHTTPServer::AssetHTTPServer(quint16 port, std::shared_ptr<AssetFileCache> fileCache) :
+    _fileCache(fileCache),
+    _httpManager(new HTTPManager(QHostAddress::Any, port, QString(), this))
+{
+    qCInfo(asset_server) << "Serving asset files over HTTP on port" << port;
+}
+
+AssetHTTPServer::AssetHTTPServer(quint16 port, const QSslCertificate& certificate, const QSslKey& privateKey,
+                                 std::shared_ptr<AssetFileCache> fileCache) :
+    _fileCache(fileCache),
+    _httpManager(new HTTPSManager(QHostAddress::Any, port, certificate, privateKey, QString(), this))
+{
+    qCInfo(asset_server) << "Serving asset files over HTTPS on port" << port;
+}
+
+bool AssetHTTPServer::handleHTTPSRequest(HTTPSConnection* connection, const QUrl& url, bool skipSubHandler) {
+    return handleHTTPRequest(connection, url, skipSubHandler);
+}
+
+bool AssetHTTPServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    QString path = url.path();
+    QString hash = path.mid(HASH_PATH_PREFIX.size()).toLower();
+    if (connection->requestOperation() != QNetworkAccessManager::GetOperation || !path.startsWith(HASH_PATH_PREFIX)
+        || !AssetUtils::isValidHash(hash)) {
+        connection->respond(HTTPConnection::StatusCode404, "Not found");
+        return true;
+    }
+
+    Headers headers;
+    QByteArray entityTag = "\"" + hash.toLatin1() + "\"";
+    headers.insert("ETag", entityTag);
+    headers.insert("Cache-Control", IMMUTABLE_CACHE_CONTROL);
+    headers.insert("Accept-Ranges", "bytes");
+    headers.insert("Access-Control-Allow-Origin", "*");
+
+    // the hash names the contents, so a client holding any copy of it already has the right one
+    QByteArray ifNoneMatch = connection->requestHeader("If-None-Match");
+    if (!ifNoneMatch.isEmpty() && (ifNoneMatch.contains(entityTag) || ifNoneMatch.trimmed() == "*")) {
+        connection->respond(STATUS_CODE_304, QByteArray(), ASSET_CONTENT_TYPE, headers);
+        return true;
+    }
+
+    auto file = _fileCache->getFile(hash);
+    if (!file) {
+        connection->respond(HTTPConnection::StatusCode404, "Asset not found");
+        return true;
+    }
+
+    qint64 fileSize = (qint64)file->size();
+    qint64 first;
+    qint64 last;
+    bool isRange;
+    if (!parseRange(connection->requestHeader("Range"), fileSize, first, last, isRange)) {
+        headers.insert("Content-Range", "bytes */" + QByteArray::number(fileSize));
+        connection->respond(STATUS_CODE_416, QByteArray(), ASSET_CONTENT_TYPE, headers);
+        return true;
+    }
+
+    if (isRange) {
+        headers.insert("Content-Range", "bytes " + QByteArray::number(first) + "-" + QByteArray::number(last) + "/" +
+                       QByteArray::number(fileSize));
+    }
+    qint64 size = fileSize > 0 ? last - first + 1 : 0;
+    connection->respond(isRange ? STATUS_CODE_206 : HTTPConnection::StatusCode200,
+                        std::unique_ptr<QIODevice>(new AssetFileDevice(file, first, size)), ASSET_CONTENT_TYPE, headers);
+    return true;
+}
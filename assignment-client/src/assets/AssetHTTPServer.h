@@ -0,0 +1,41 @@
+//
+//  AssetHTTPServer.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetHTTPServer_h
+#define hifi_AssetHTTPServer_h
+
+#include <memory>
+
+#include <QtNetwork/QSslCertificate>
+#include <QtNetwork/QSslKey>
+
+#include <HTTPSManager.h>
+
+#include "AssetFileCache.h"
+
+// Serves asset files over HTTP, or HTTPS given a certificate, at /hash/<sha256>, so that clients can fetch them
+// without going through the reliable udt connection and a CDN or browser can cache them. An asset file never changes,
+// so responses carry its hash as a strong ETag and are marked as cacheable forever. Single byte ranges are supported.
+class AssetHTTPServer : public HTTPSRequestHandler {
+public:
+    AssetHTTPServer(quint16 port, std::shared_ptr<AssetFileCache> fileCache);
+    AssetHTTPServer(quint16 port, const QSslCertificate& certificate, const QSslKey& privateKey,
+                    std::shared_ptr<AssetFileCache> fileCache);
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+    bool handleHTTPSRequest(HTTPSConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
+private:
+    std::shared_ptr<AssetFileCache> _fileCache;
+    std::unique_ptr<HTTPManager> _httpManager;
+};
+
+#endif // hifi_AssetHTTPServer_h
@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <limits>
 #include <thread>
 #include <memory>
 
@@ -35,10 +36,12 @@
 #include <PathUtils.h>
 #include <image/TextureProcessing.h>
 
+#include "AssetHTTPServer.h"
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
+#include "UploadChunkedAssetTask.h"
 
 static const uint8_t MIN_CORES_FOR_MULTICORE = 4;
 static const uint8_t CPU_AFFINITY_COUNT_HIGH = 2;
@@ -131,6 +134,20 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || (*it)->isBaking()) {
+        return;
+    }
+
+    // the pool runs the waiting task with the highest priority first, so it goes back in with its new one
+    auto& task = *it;
+    int priority = task->addRequest();
+    if (_bakingTaskPool.tryTake(task.get())) {
+        _bakingTaskPool.start(task.get(), priority);
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -291,24 +308,30 @@ void updateConsumedCores() {
 }
 
 
+// Most of the work will be I/O bound, reading from disk and constructing packet objects,
+// so the ideal is greater than the number of cores on the system.
+static const int SEND_TASK_POOL_THREAD_COUNT = 50;
+static const int UPLOAD_TASK_POOL_THREAD_COUNT = 8;
+// beyond these, clients are told the server is busy and try again later
+static const int MAX_PENDING_SENDS = 1000;
+static const int MAX_PENDING_UPLOADS = 100;
+
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
-    _transferTaskPool(this),
+    _sendTaskPool(SEND_TASK_POOL_THREAD_COUNT, MAX_PENDING_SENDS, this),
+    _uploadTaskPool(UPLOAD_TASK_POOL_THREAD_COUNT, MAX_PENDING_UPLOADS, this),
     _bakingTaskPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
     BAKEABLE_TEXTURE_EXTENSIONS = image::getSupportedFormats();
     qDebug() << "Supported baking texture formats:" << BAKEABLE_MODEL_EXTENSIONS;
 
-    // Most of the work will be I/O bound, reading from disk and constructing packet objects,
-    // so the ideal is greater than the number of cores on the system.
-    static const int TASK_POOL_THREAD_COUNT = 50;
-    _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
     _bakingTaskPool.setMaxThreadCount(1);
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation },
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetUploadChunks,
+                                              PacketType::AssetMappingOperation },
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::queueRequests));
 
 #ifdef Q_OS_WIN
@@ -329,7 +352,9 @@ AssetServer::AssetServer(ReceivedMessage& message) :
 void AssetServer::aboutToFinish() {
 
     // remove pending transfer tasks
-    _transferTaskPool.clear();
+    _sendTaskPool.clear();
+    _uploadTaskPool.clear();
+    _chunkIndex->stopIndexingFiles();
 
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
@@ -424,6 +449,32 @@ void AssetServer::completeSetup() {
         setFinished(true);
         return;
     }
+    _fileCache = std::make_shared<AssetFileCache>(_filesDirectory);
+    _chunkIndex->indexFiles(_filesDirectory, _fileCache);
+
+    // optionally serve the asset files over HTTP(S) too, clients use it if the domain advertises its URL
+    static const QString HTTP_PORT_OPTION = "http_port";
+    static const QString HTTP_CERTIFICATE_OPTION = "http_certificate";
+    static const QString HTTP_PRIVATE_KEY_OPTION = "http_private_key";
+    auto httpPort = assetServerObject[HTTP_PORT_OPTION].toInt(0);
+    if (httpPort > 0 && httpPort <= std::numeric_limits<quint16>::max()) {
+        auto certificatePath = assetServerObject[HTTP_CERTIFICATE_OPTION].toString();
+        auto privateKeyPath = assetServerObject[HTTP_PRIVATE_KEY_OPTION].toString();
+        if (!certificatePath.isEmpty() && !privateKeyPath.isEmpty()) {
+            QFile certificateFile { certificatePath };
+            QFile privateKeyFile { privateKeyPath };
+            if (certificateFile.open(QIODevice::ReadOnly) && privateKeyFile.open(QIODevice::ReadOnly)) {
+                QSslCertificate certificate { &certificateFile };
+                QSslKey privateKey { &privateKeyFile, QSsl::Rsa, QSsl::Pem, QSsl::PrivateKey };
+                _httpServer.reset(new AssetHTTPServer(httpPort, certificate, privateKey, _fileCache));
+            } else {
+                qCWarning(asset_server) << "Unable to read the HTTPS certificate or private key, not serving asset files"
+                    << "over HTTPS";
+            }
+        } else {
+            _httpServer.reset(new AssetHTTPServer(httpPort, _fileCache));
+        }
+    }
 
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
@@ -471,6 +522,8 @@ void AssetServer::completeSetup() {
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetInfo));
     packetReceiver.registerListener(PacketType::AssetUpload,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+    packetReceiver.registerListener(PacketType::AssetUploadChunks,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUploadChunks));
     packetReceiver.registerListener(PacketType::AssetMappingOperation,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetMappingOperation));
 
@@ -512,6 +565,9 @@ void AssetServer::replayRequests() {
             case PacketType::AssetUpload:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetUploadChunks:
+                handleAssetUploadChunks(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -544,6 +600,8 @@ void AssetServer::cleanupUnmappedFiles() {
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
+                    _fileCache->removeFile(filename);
+                    _chunkIndex->removeFile(filename);
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
                     removeBakedPathsForDeletedAsset(filename);
@@ -700,6 +758,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                     maybeBake(assetPath, originalAssetHash);
                 }
             }
+
+            // a client is loading the original while the baked version is still waiting to be made
+            prioritizeBake(originalAssetHash);
         }
     } else {
         replyPacket.writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -872,8 +933,31 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
-    _transferTaskPool.start(task);
+    auto task = new SendAssetTask(message, senderNode, _fileCache);
+    if (!_sendTaskPool.tryStart(task)) {
+        replyToAssetGet(*message, senderNode, AssetUtils::AssetServerError::ServerBusy);
+    }
+}
+
+void AssetServer::replyToAssetGet(ReceivedMessage& message, const SharedNodePointer& senderNode,
+                                  AssetUtils::AssetServerError error) {
+    MessageID messageID;
+    message.seek(0);
+    message.readPrimitive(&messageID);
+    QByteArray assetHash = message.read(AssetUtils::SHA256_HASH_LENGTH);
+
+    // the same reply SendAssetTask sends, so the client reads it the same way
+    auto replyPacketList = NLPacketList::create(PacketType::AssetGetReply, QByteArray(), true, true);
+    replyPacketList->write(assetHash);
+    replyPacketList->writePrimitive(messageID);
+    replyPacketList->writePrimitive(error);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), message.getSenderSockAddr());
+    }
 }
 
 void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -886,30 +970,91 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
-        _transferTaskPool.start(task);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _chunkIndex);
+        if (!_uploadTaskPool.tryStart(task)) {
+            replyToAssetUpload(*message, senderNode, AssetUtils::AssetServerError::ServerBusy);
+        }
     } else {
         // this is a node the domain told us is not allowed to rez entities
         // for now this also means it isn't allowed to add assets
         // so return a packet with error that indicates that
+        replyToAssetUpload(*message, senderNode, AssetUtils::AssetServerError::PermissionDenied);
+    }
+}
 
-        auto permissionErrorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
+void AssetServer::replyToAssetUpload(ReceivedMessage& message, const SharedNodePointer& senderNode,
+                                     AssetUtils::AssetServerError error) {
+    auto errorPacket = NLPacket::create(PacketType::AssetUploadReply, sizeof(MessageID) + sizeof(AssetUtils::AssetServerError), true);
 
-        MessageID messageID;
-        message->readPrimitive(&messageID);
+    MessageID messageID;
+    message.seek(0);
+    message.readPrimitive(&messageID);
 
-        // write the message ID and a permission denied error
-        permissionErrorPacket->writePrimitive(messageID);
-        permissionErrorPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    // write the message ID and the error
+    errorPacket->writePrimitive(messageID);
+    errorPacket->writePrimitive(error);
 
-        // send off the packet
-        auto nodeList = DependencyManager::get<NodeList>();
-        if (senderNode) {
-            nodeList->sendPacket(std::move(permissionErrorPacket), *senderNode);
-        } else {
-            nodeList->sendPacket(std::move(permissionErrorPacket), message->getSenderSockAddr());
+    // send off the packet
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacket(std::move(errorPacket), *senderNode);
+    } else {
+        nodeList->sendPacket(std::move(errorPacket), message.getSenderSockAddr());
+    }
+}
+
+void AssetServer::handleAssetUploadChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    bool canWriteToAssetServer = true;
+    if (senderNode) {
+        canWriteToAssetServer = senderNode->getCanWriteToAssetServer();
+    }
+
+    ChunkedUploadHeader header;
+    bool isValid = header.read(*message);
+
+    if (canWriteToAssetServer && isValid && header.operation == AssetUtils::UploadMissingChunks) {
+        qCDebug(asset_server) << "Starting an UploadChunkedAssetTask for upload from" << message->getSourceID();
+
+        auto task = new UploadChunkedAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _chunkIndex, _fileCache);
+        if (_uploadTaskPool.tryStart(task)) {
+            return;
         }
     }
+
+    auto replyPacketList = NLPacketList::create(PacketType::AssetUploadChunksReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(header.messageID);
+
+    if (!canWriteToAssetServer) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (!isValid) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else if (header.fileSize > _filesizeLimit) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else if (header.operation == AssetUtils::UploadMissingChunks) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::ServerBusy);
+    } else {
+        // the chunks no asset file has, which the client then sends
+        std::vector<uint32_t> missingChunks;
+        AssetChunkIndex::Location location;
+        for (uint32_t i = 0; i < (uint32_t)header.chunks.size(); ++i) {
+            if (!_chunkIndex->findChunk(header.chunks[i].hash, location) || location.size != header.chunks[i].size) {
+                missingChunks.push_back(i);
+            }
+        }
+
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacketList->writePrimitive((uint32_t)missingChunks.size());
+        for (auto index : missingChunks) {
+            replyPacketList->writePrimitive(index);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), message->getSenderSockAddr());
+    }
 }
 
 void AssetServer::sendStatsPacket() {
@@ -936,6 +1081,7 @@ void AssetServer::sendStatsPacket() {
         connectionStats["5. Period (us)"] = stats.packetSendPeriod;
         connectionStats["6. Up (Mb/s)"] = stats.sentBytes * megabitsPerSecPerByte;
         connectionStats["7. Down (Mb/s)"] = stats.receivedBytes * megabitsPerSecPerByte;
+        connectionStats["8. Pacing (P/s)"] = stats.pacingRate;
         connectionStats["last_heard_time_msecs"] = date.toUTC().toMSecsSinceEpoch();
         connectionStats["last_heard_ago_msecs"] = date.msecsTo(QDateTime::currentDateTime());
 
@@ -965,6 +1111,11 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    QJsonObject queueStats;
+    queueStats["Sends"] = _sendTaskPool.getStats();
+    queueStats["Uploads"] = _uploadTaskPool.getStats();
+    serverStats["Request Queues"] = queueStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1181,6 +1332,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
+                _fileCache->removeFile(hash);
+                _chunkIndex->removeFile(hash);
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
                 removeBakedPathsForDeletedAsset(hash);
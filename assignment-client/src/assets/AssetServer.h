@@ -12,6 +12,8 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
@@ -19,6 +21,10 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetChunkIndex.h"
+#include "AssetFileCache.h"
+#include "AssetHTTPServer.h"
+#include "AssetTaskPool.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -42,6 +48,9 @@ enum class BakedAssetType : int {
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    OptimizedMeshes,
+    MeshLODs,
+    CollisionShapes,
 
     COUNT
 };
@@ -88,6 +97,7 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetUploadChunks(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void sendStatsPacket() override;
@@ -102,6 +112,9 @@ private:
     void handleRenameMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleSetBakingEnabledOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
 
+    void replyToAssetGet(ReceivedMessage& message, const SharedNodePointer& senderNode, AssetUtils::AssetServerError error);
+    void replyToAssetUpload(ReceivedMessage& message, const SharedNodePointer& senderNode, AssetUtils::AssetServerError error);
+
     void handleAssetServerBackup(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleAssetServerRestore(ReceivedMessage& message, NLPacketList& replyPacket);
 
@@ -136,6 +149,8 @@ private:
     bool hasMetaFile(const AssetUtils::AssetHash& hash);
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
+    /// Move a bake still waiting its turn ahead of the bakes of assets fewer clients have asked for
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
 
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
@@ -153,9 +168,15 @@ private:
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
-
-    /// Task pool for handling uploads and downloads of assets
-    QThreadPool _transferTaskPool;
+    std::shared_ptr<AssetFileCache> _fileCache;
+    std::shared_ptr<AssetChunkIndex> _chunkIndex { std::make_shared<AssetChunkIndex>() };
+    std::unique_ptr<AssetHTTPServer> _httpServer;
+
+    /// Task pools for sending and receiving asset files, each bounded so that a burst of one can't hold up the other
+    /// or queue without limit. Asset info and mapping requests are cheap and stay on the server's own thread, so they
+    /// never wait behind transfers.
+    AssetTaskPool _sendTaskPool;
+    AssetTaskPool _uploadTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
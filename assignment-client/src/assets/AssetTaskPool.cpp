@@ -0,0 +1,68 @@
+//
+//  AssetTaskPool.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetTaskPool.h"
+
+#include <memory>
+
+// Runs a task, counting it as pending until it's deleted, whether it ran or was dropped from the queue
+class AssetTaskPool::CountedTask : public QRunnable {
+public:
+    CountedTask(QRunnable* task, std::atomic<int>& pendingTasks) : _task(task), _pendingTasks(pendingTasks) {}
+    ~CountedTask() { --_pendingTasks; }
+
+    void run() override { _task->run(); }
+
+private:
+    std::unique_ptr<QRunnable> _task;
+    std::atomic<int>& _pendingTasks;
+};
+
+AssetTaskPool::AssetTaskPool(int maxThreadCount, int maxPendingTasks, QObject* parent) :
+    _pool(parent),
+    _maxPendingTasks(maxPendingTasks)
+{
+    _pool.setMaxThreadCount(maxThreadCount);
+}
+
+bool AssetTaskPool::tryStart(QRunnable* task) {
+    int pendingTasks = _pendingTasks;
+    do {
+        if (pendingTasks >= _maxPendingTasks) {
+            ++_rejectedTasks;
+            delete task;
+            return false;
+        }
+    } while (!_pendingTasks.compare_exchange_weak(pendingTasks, pendingTasks + 1));
+
+    int peakPendingTasks = _peakPendingTasks;
+    while (pendingTasks + 1 > peakPendingTasks && !_peakPendingTasks.compare_exchange_weak(peakPendingTasks, pendingTasks + 1)) {
+    }
+
+    ++_startedTasks;
+    _pool.start(new CountedTask(task, _pendingTasks));
+    return true;
+}
+
+void AssetTaskPool::clear() {
+    _pool.clear();
+}
+
+QJsonObject AssetTaskPool::getStats() {
+    QJsonObject stats;
+    stats["1. Pending"] = _pendingTasks.load();
+    stats["2. Peak Pending"] = _peakPendingTasks.exchange(_pendingTasks);
+    stats["3. Max Pending"] = _maxPendingTasks;
+    stats["4. Active Threads"] = _pool.activeThreadCount();
+    stats["5. Started"] = (qint64)_startedTasks.load();
+    stats["6. Turned Away"] = (qint64)_rejectedTasks.load();
+    return stats;
+}
@@ -0,0 +1,50 @@
+//
+//  AssetTaskPool.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetTaskPool_h
+#define hifi_AssetTaskPool_h
+
+#include <atomic>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+// A thread pool for one kind of asset request, with a bound on how many tasks it holds, running or waiting. A kind of
+// request that comes in faster than it's served is turned away once the pool is full, so the client can try again
+// later, rather than queueing without limit and holding up the requests of other kinds.
+class AssetTaskPool {
+public:
+    AssetTaskPool(int maxThreadCount, int maxPendingTasks, QObject* parent = nullptr);
+
+    // Takes the task, false if the pool is full, in which case the task is deleted without running
+    bool tryStart(QRunnable* task);
+    // Drops the tasks still waiting for a thread
+    void clear();
+
+    int getPendingTaskCount() const { return _pendingTasks; }
+    int getMaxPendingTasks() const { return _maxPendingTasks; }
+
+    // the queue depth and counts of tasks run and turned away, for the stats packet
+    QJsonObject getStats();
+
+private:
+    class CountedTask;
+
+    QThreadPool _pool;
+    const int _maxPendingTasks;
+    std::atomic<int> _pendingTasks { 0 };
+    std::atomic<int> _peakPendingTasks { 0 };
+    std::atomic<uint64_t> _startedTasks { 0 };
+    std::atomic<uint64_t> _rejectedTasks { 0 };
+};
+
+#endif // hifi_AssetTaskPool_h
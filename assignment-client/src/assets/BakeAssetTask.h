@@ -31,6 +31,10 @@ public:
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
 
+    // how many times clients asked for the asset while it waited to be baked, only used by the asset server thread
+    int getNumRequests() const { return _numRequests; }
+    int addRequest() { return ++_numRequests; }
+
     void run() override;
 
 public slots:
@@ -48,6 +52,7 @@ private:
     QString _filePath;
     std::unique_ptr<QProcess> _ovenProcess { nullptr };
     std::atomic<bool> _wasAborted { false };
+    int _numRequests { 0 };
 };
 
 #endif // hifi_BakeAssetTask_h
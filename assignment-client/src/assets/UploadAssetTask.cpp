@@ -13,6 +13,7 @@
 
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
@@ -21,11 +22,13 @@
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 std::shared_ptr<AssetChunkIndex> chunkIndex) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _chunkIndex(chunkIndex)
 {
     
 }
@@ -64,48 +67,12 @@ void UploadAssetTask::run() {
         } else {
             qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
         }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
-
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
-            }
-        }
-
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
 
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
-            }
+        auto error = writeAssetFile(_resourcesDir, hash, fileData, _chunkIndex.get());
+        replyPacket->writePrimitive(error);
+        if (error == AssetUtils::AssetServerError::NoError) {
+            replyPacket->write(hash);
         }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
@@ -115,3 +82,45 @@ void UploadAssetTask::run() {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
 }
+
+AssetUtils::AssetServerError UploadAssetTask::writeAssetFile(const QDir& resourcesDir, const QByteArray& hash,
+                                                             const QByteArray& fileData, AssetChunkIndex* chunkIndex) {
+    auto hexHash = hash.toHex();
+    QFile file { resourcesDir.filePath(QString(hexHash)) };
+
+    if (file.exists()) {
+        // check if the local file has the correct contents, otherwise we overwrite
+        if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
+            qDebug() << "Not overwriting existing verified file: " << hexHash;
+            if (chunkIndex) {
+                chunkIndex->addFile(hexHash, fileData.constData(), fileData.size());
+            }
+            return AssetUtils::AssetServerError::NoError;
+        }
+        qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+        file.close();
+    }
+
+    // written to a temporary file and moved into place, so that a file being sent from a mapping is never
+    // truncated under it
+    QSaveFile saveFile { file.fileName() };
+    if (saveFile.open(QIODevice::WriteOnly) && saveFile.write(fileData) == qint64(fileData.size()) && saveFile.commit()) {
+        qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+        if (chunkIndex) {
+            chunkIndex->addFile(hexHash, fileData.constData(), fileData.size());
+        }
+        return AssetUtils::AssetServerError::NoError;
+    }
+
+    qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
+    saveFile.cancelWriting();
+
+    // upload has failed - remove the file and return an error
+    auto removed = !file.exists() || file.remove();
+
+    if (!removed) {
+        qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+    }
+
+    return AssetUtils::AssetServerError::FileOperationFailed;
+}
@@ -14,11 +14,16 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include <AssetUtils.h>
+
+#include "AssetChunkIndex.h"
 #include "ReceivedMessage.h"
 
 class NLPacketList;
@@ -27,15 +32,20 @@ class Node;
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, std::shared_ptr<AssetChunkIndex> chunkIndex);
 
     void run() override;
 
+    // Stores the uploaded file under its hash, unless it's already there, and indexes its chunks
+    static AssetUtils::AssetServerError writeAssetFile(const QDir& resourcesDir, const QByteArray& hash,
+                                                       const QByteArray& fileData, AssetChunkIndex* chunkIndex);
+
 private:
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    std::shared_ptr<AssetChunkIndex> _chunkIndex;
 };
 
 #endif // hifi_UploadAssetTask_h
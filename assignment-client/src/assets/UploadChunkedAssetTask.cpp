@@ -0,0 +1,144 @@
+//
+//  UploadChunkedAssetTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UploadChunkedAssetTask.h"
+
+#include <cstring>
+
+#include <NodeList.h>
+#include <NLPacketList.h>
+
+#include "AssetServerLogging.h"
+#include "UploadAssetTask.h"
+
+bool ChunkedUploadHeader::read(ReceivedMessage& message) {
+    const qint64 HEADER_SIZE = sizeof(MessageID) + sizeof(AssetUtils::ChunkedUploadOperation) + AssetUtils::SHA256_HASH_LENGTH +
+        sizeof(uint64_t) + sizeof(uint32_t);
+    const qint64 CHUNK_ENTRY_SIZE = AssetUtils::SHA256_HASH_LENGTH + sizeof(uint32_t);
+
+    message.seek(0);
+    if (message.getBytesLeftToRead() < HEADER_SIZE) {
+        return false;
+    }
+    message.readPrimitive(&messageID);
+    message.readPrimitive(&operation);
+    fileHash = message.read(AssetUtils::SHA256_HASH_LENGTH);
+    message.readPrimitive(&fileSize);
+
+    uint32_t numChunks;
+    message.readPrimitive(&numChunks);
+    if (message.getBytesLeftToRead() < (qint64)numChunks * CHUNK_ENTRY_SIZE) {
+        return false;
+    }
+
+    chunks.clear();
+    chunks.reserve(numChunks);
+    uint64_t chunksSize = 0;
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        Chunk chunk;
+        chunk.hash = message.read(AssetUtils::SHA256_HASH_LENGTH);
+        message.readPrimitive(&chunk.size);
+        chunksSize += chunk.size;
+        chunks.push_back(chunk);
+    }
+    return chunksSize == fileSize;
+}
+
+UploadChunkedAssetTask::UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode,
+                                               const QDir& resourcesDir, uint64_t filesizeLimit,
+                                               std::shared_ptr<AssetChunkIndex> chunkIndex,
+                                               std::shared_ptr<AssetFileCache> fileCache) :
+    _receivedMessage(message),
+    _senderNode(senderNode),
+    _resourcesDir(resourcesDir),
+    _filesizeLimit(filesizeLimit),
+    _chunkIndex(chunkIndex),
+    _fileCache(fileCache)
+{
+}
+
+void UploadChunkedAssetTask::run() {
+    ChunkedUploadHeader header;
+    bool isValid = header.read(*_receivedMessage);
+
+    auto replyPacketList = NLPacketList::create(PacketType::AssetUploadChunksReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(header.messageID);
+
+    QByteArray fileData;
+    if (!isValid) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    } else if (header.fileSize > _filesizeLimit) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else {
+        auto error = assembleFile(header, fileData);
+        if (error == AssetUtils::AssetServerError::NoError) {
+            error = UploadAssetTask::writeAssetFile(_resourcesDir, header.fileHash, fileData, _chunkIndex.get());
+        }
+        replyPacketList->writePrimitive(error);
+        if (error == AssetUtils::AssetServerError::NoError) {
+            replyPacketList->write(header.fileHash);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (_senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *_senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), _receivedMessage->getSenderSockAddr());
+    }
+}
+
+AssetUtils::AssetServerError UploadChunkedAssetTask::assembleFile(const ChunkedUploadHeader& header, QByteArray& fileData) {
+    fileData = QByteArray((int)header.fileSize, Qt::Uninitialized);
+
+    // the chunks sent, by index into the chunk list, right after it
+    std::vector<const char*> sentChunks(header.chunks.size(), nullptr);
+    uint32_t numSentChunks = 0;
+    _receivedMessage->readPrimitive(&numSentChunks);
+    for (uint32_t i = 0; i < numSentChunks; ++i) {
+        uint32_t index;
+        if (_receivedMessage->readPrimitive(&index) != sizeof(index) || index >= header.chunks.size() ||
+            _receivedMessage->getBytesLeftToRead() < header.chunks[index].size) {
+            qCWarning(asset_server) << "Bad chunked upload" << header.fileHash.toHex();
+            return AssetUtils::AssetServerError::FileOperationFailed;
+        }
+        sentChunks[index] = _receivedMessage->readWithoutCopy(header.chunks[index].size).constData();
+    }
+
+    uint64_t offset = 0;
+    int numCopiedChunks = 0;
+    for (size_t i = 0; i < header.chunks.size(); ++i) {
+        const auto& chunk = header.chunks[i];
+        if (sentChunks[i]) {
+            memcpy(fileData.data() + offset, sentChunks[i], chunk.size);
+        } else {
+            // the file it was found in may have been deleted since, the client then sends all of it
+            AssetChunkIndex::Location location;
+            auto file = _chunkIndex->findChunk(chunk.hash, location) ? _fileCache->getFile(location.fileHash) : nullptr;
+            if (!file || location.size != chunk.size || location.offset + location.size > file->size()) {
+                qCDebug(asset_server) << "Chunk" << chunk.hash.toHex() << "of" << header.fileHash.toHex() << "is gone";
+                return AssetUtils::AssetServerError::FileOperationFailed;
+            }
+            memcpy(fileData.data() + offset, file->data() + location.offset, chunk.size);
+            ++numCopiedChunks;
+        }
+        offset += chunk.size;
+    }
+
+    if (AssetUtils::hashData(fileData) != header.fileHash) {
+        qCWarning(asset_server) << "Chunked upload doesn't match its hash" << header.fileHash.toHex();
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+
+    qCDebug(asset_server) << "Put" << header.fileHash.toHex() << "together from" << numSentChunks << "chunks sent and"
+        << numCopiedChunks << "chunks already there";
+    return AssetUtils::AssetServerError::NoError;
+}
@@ -0,0 +1,68 @@
+//
+//  UploadChunkedAssetTask.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UploadChunkedAssetTask_h
+#define hifi_UploadChunkedAssetTask_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+
+#include <AssetUtils.h>
+#include <Node.h>
+#include <ReceivedMessage.h>
+
+#include "AssetChunkIndex.h"
+#include "AssetFileCache.h"
+
+// The chunk list both steps of a chunked upload start with: the hash and size of the whole file and of each of its
+// chunks, in order
+struct ChunkedUploadHeader {
+    struct Chunk {
+        QByteArray hash;
+        uint32_t size;
+    };
+
+    MessageID messageID { 0 };
+    AssetUtils::ChunkedUploadOperation operation { AssetUtils::QueryMissingChunks };
+    QByteArray fileHash;
+    uint64_t fileSize { 0 };
+    std::vector<Chunk> chunks;
+
+    // false if the message is too short or the chunks don't add up to the file
+    bool read(ReceivedMessage& message);
+};
+
+// Puts an uploaded file together from the chunks sent with it and the chunks the asset files already have, checks it
+// against its hash and stores it as UploadAssetTask does
+class UploadChunkedAssetTask : public QRunnable {
+public:
+    UploadChunkedAssetTask(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode, const QDir& resourcesDir,
+                           uint64_t filesizeLimit, std::shared_ptr<AssetChunkIndex> chunkIndex,
+                           std::shared_ptr<AssetFileCache> fileCache);
+
+    void run() override;
+
+private:
+    AssetUtils::AssetServerError assembleFile(const ChunkedUploadHeader& header, QByteArray& fileData);
+
+    QSharedPointer<ReceivedMessage> _receivedMessage;
+    SharedNodePointer _senderNode;
+    QDir _resourcesDir;
+    uint64_t _filesizeLimit;
+    std::shared_ptr<AssetChunkIndex> _chunkIndex;
+    std::shared_ptr<AssetFileCache> _fileCache;
+};
+
+#endif // hifi_UploadChunkedAssetTask_h
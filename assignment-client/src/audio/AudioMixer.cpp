@@ -23,12 +23,18 @@
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
+#include <NodeTelemetry.h>
 #include <OctreeConstants.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
+#include <Profile.h>
 #include <udt/PacketHeaders.h>
+#include <ResourceCache.h>
+#include <ResourceManager.h>
 #include <SharedUtil.h>
+#include <SoundCache.h>
 #include <StDev.h>
+#include <Trace.h>
 #include <UUID.h>
 #include <CPUDetect.h>
 
@@ -48,6 +54,8 @@ static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
+// a frame that took longer than this has the trace recorder dump the seconds that led to it
+static const int FRAME_OVERRUN_USECS = 2 * AudioConstants::NETWORK_FRAME_USECS;
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
@@ -57,6 +65,7 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+AudioMixerPartition AudioMixer::_partition;
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -69,6 +78,10 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     // hash the available codecs (on the mixer)
     _availableCodecs.clear(); // Make sure struct is clean
     auto pluginManager = DependencyManager::set<PluginManager>();
+    // the sounds of the ambient sources are loaded over ATP or HTTP
+    DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceCacheSharedItems>();
+    DependencyManager::set<SoundCache>();
     // Only load codec plugins; for now assume codec plugins have 'codec' in their name.
     auto codecPluginFilter = [](const QJsonObject& metaData) {
         QJsonValue nameValue = metaData["MetaData"]["name"];
@@ -123,6 +136,10 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 }
 
 void AudioMixer::aboutToFinish() {
+    _workerSharedData.ambientSources.clear();
+    DependencyManager::destroy<SoundCache>();
+    DependencyManager::destroy<ResourceCacheSharedItems>();
+    DependencyManager::destroy<ResourceManager>();
     DependencyManager::destroy<PluginManager>();
 }
 
@@ -179,12 +196,11 @@ void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> mes
         newPacket->writePrimitive(position);
         newPacket->writePrimitive(radius);
 
-        nodeList->eachNode([&](const SharedNodePointer& node){
-            if (node->getType() == NodeType::Agent && node->getActiveSocket() &&
-                node->getLinkedData() && node != sendingNode) {
+        for (const auto& node : nodeList->getNodeSnapshot()->ofType(NodeType::Agent)) {
+            if (node->getActiveSocket() && node->getLinkedData() && node != sendingNode) {
                 nodeList->sendUnreliablePacket(*newPacket, *node);
             }
-        });
+        }
     }
 }
 
@@ -283,6 +299,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
 
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["work_stealing"] = _slavePool.isWorkStealing();
 
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
@@ -290,6 +307,7 @@ void AudioMixer::sendStatsPacket() {
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
+    statsObject["avg_listeners_(near_silent)_per_frame"] = (float)_stats.sumListenersNearSilent / (float)_numStatFrames;
 
     statsObject["silent_packets_per_frame"] = (float)_numSilentPackets / (float)_numStatFrames;
 
@@ -329,6 +347,46 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
 
+    if (_workerSharedData.hrtfCache.isEnabled()) {
+        int hrtfCacheLookups = _stats.hrtfCacheHits + _stats.hrtfCacheMisses;
+        float hrtfCacheHitRate = hrtfCacheLookups > 0 ? (float)_stats.hrtfCacheHits / hrtfCacheLookups : 0.0f;
+        mixStats["1_hrtf_cache_tolerance"] = _workerSharedData.hrtfCache.getTolerance();
+        mixStats["1_hrtf_cache_hits"] = (int)(_stats.hrtfCacheHits / (float)_numStatFrames);
+        mixStats["1_hrtf_cache_misses"] = (int)(_stats.hrtfCacheMisses / (float)_numStatFrames);
+        mixStats["1_hrtf_cache_%_hits"] = QString::number(hrtfCacheHitRate * 100.0f, 'f', 2);
+
+        // estimate the time saved from the average cost of the renders that did happen
+        uint64_t nsPerRender = _stats.hrtfCacheMisses > 0 ? _stats.hrtfCacheRenderTime / _stats.hrtfCacheMisses : 0;
+        mixStats["1_hrtf_cache_us_saved_per_frame"] =
+            (qint64)((nsPerRender * _stats.hrtfCacheHits) / (1000 * (uint64_t)_numStatFrames));
+    }
+
+    if (_workerSharedData.foaZones.isEnabled()) {
+        mixStats["1_foa_zone_size"] = _workerSharedData.foaZones.getZoneSize();
+        mixStats["1_foa_near_radius"] = _workerSharedData.foaZones.getNearRadius();
+        mixStats["1_foa_active_zones"] = _workerSharedData.foaZones.getNumActiveZones();
+        mixStats["1_foa_bed_sources"] = _workerSharedData.foaZones.getNumBedSources();
+        mixStats["1_foa_listeners"] = (int)(_stats.foaListeners / (float)_numStatFrames);
+        mixStats["1_foa_bed_mixes"] = (int)(_stats.foaBedMixes / (float)_numStatFrames);
+    }
+
+    if (_workerSharedData.masking.isEnabled()) {
+        mixStats["1_masking_threshold_db"] = _workerSharedData.masking.getThreshold();
+        mixStats["1_masked_streams"] = (int)(_stats.masked / (float)_numStatFrames);
+        mixStats["%_streams_masked"] = (_stats.active > 0) ?
+            QString::number(((float)_stats.masked / _stats.active) * 100.0f, 'f', 2) : QString("0.0");
+    }
+
+    if (_partition.isEnabled()) {
+        mixStats["1_partition_neighbors"] = _partition.getNumNeighbors();
+        mixStats["1_partition_margin"] = _partition.getMargin();
+    }
+
+    if (_workerSharedData.ambientSources.isEnabled()) {
+        mixStats["1_ambient_sources"] = _workerSharedData.ambientSources.getNumSources();
+        mixStats["1_ambient_sources_playing"] = _workerSharedData.ambientSources.getNumPlaying();
+    }
+
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
@@ -345,6 +403,21 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["mix_stats"] = mixStats;
 
+    // slave scheduling stats
+    QJsonObject slaveStats;
+
+    for (size_t i = 0; i < _slaveStats.size(); ++i) {
+        QJsonObject schedulingStats;
+        schedulingStats["steals_per_frame"] = _slaveStats[i].workSteals / (float)_numStatFrames;
+        schedulingStats["us_idle_per_frame"] = (qint64)(_slaveStats[i].workIdleUsecs / _numStatFrames);
+        slaveStats[QString("slave_%1").arg(i)] = schedulingStats;
+        _slaveStats[i].reset();
+    }
+    slaveStats["total_steals_per_frame"] = _stats.workSteals / (float)_numStatFrames;
+    slaveStats["total_us_idle_per_frame"] = (qint64)(_stats.workIdleUsecs / _numStatFrames);
+
+    statsObject["slave_stats"] = slaveStats;
+
     _numStatFrames = _numSilentPackets = 0;
     _stats.reset();
 
@@ -370,6 +443,9 @@ void AudioMixer::sendStatsPacket() {
     // add the listeners object to the root object
     statsObject["z_listeners"] = listenerStats;
 
+    NodeTelemetry::mergeHistogram("frame_usecs", _frameHistogram);
+    _frameHistogram.reset();
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
@@ -415,6 +491,11 @@ void AudioMixer::start() {
         parseSettingsObject(settingsObject);
     }
 
+    // ambient sources may be assets on the asset server
+    if (_workerSharedData.ambientSources.isEnabled()) {
+        nodeList->addNodeTypeToInterestSet(NodeType::AssetServer);
+    }
+
     // mix state
     unsigned int frame = 1;
 
@@ -427,12 +508,18 @@ void AudioMixer::start() {
             auto timer = _checkTimeTiming.timer();
             auto frameDuration = timeFrame();
             throttle(frameDuration, frame);
+
+            if (frameDuration.count() > FRAME_OVERRUN_USECS) {
+                tracing::requestRecordingDump("audio mixer frame overrun");
+            }
         }
 
         auto frameTimer = _frameTiming.timer();
+        auto frameStart = p_high_resolution_clock::now();
 
         // process (node-isolated) audio packets across slave threads
         {
+            PROFILE_RANGE(audio, "processPackets");
             auto packetsTimer = _packetsTiming.timer();
 
             // first clear the concurrent vector of added streams that the slaves will add to when they process packets
@@ -445,6 +532,7 @@ void AudioMixer::start() {
 
         // process queued events (networking, global audio packets, &c.)
         {
+            PROFILE_RANGE(audio, "processEvents");
             auto eventsTimer = _eventsTiming.timer();
 
             // clear removed nodes and removed streams before we process events that will setup the new set
@@ -455,23 +543,42 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        // pop a frame of each ambient source, now that the removed streams of this frame have been cleared
+        if (_workerSharedData.ambientSources.isEnabled()) {
+            _workerSharedData.ambientSources.prepare(_workerSharedData.addedStreams);
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            // encode far sources into the shared ambisonic beds
+            _workerSharedData.foaZones.prepare(cbegin, cend, frame);
+
             // mix across slave threads
+            PROFILE_RANGE(audio, "mix");
             auto mixTimer = _mixTiming.timer();
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
+        // drop shared HRTF blocks that no listener used this frame
+        if (_workerSharedData.hrtfCache.isEnabled()) {
+            _workerSharedData.hrtfCache.prune(frame);
+        }
+
         // gather stats
+        _slaveStats.resize(_slavePool.numThreads());
+        size_t slaveIndex = 0;
         _slavePool.each([&](AudioMixerSlave& slave) {
             _stats.accumulate(slave.stats);
+            _slaveStats[slaveIndex++].accumulate(slave.stats);
             slave.stats.reset();
         });
 
+        _frameHistogram.record(chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - frameStart).count());
+
         ++frame;
         ++_numStatFrames;
 
@@ -555,6 +662,8 @@ void AudioMixer::clearDomainSettings() {
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _partition.clear();
+    _workerSharedData.ambientSources.clear();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -573,6 +682,38 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString HRTF_CACHE_TOLERANCE_KEY = "hrtf_cache_tolerance";
+        _workerSharedData.hrtfCache.setTolerance(audioThreadingGroupObject[HRTF_CACHE_TOLERANCE_KEY].toDouble(0.0));
+        qCDebug(audio) << "HRTF cache tolerance:" << _workerSharedData.hrtfCache.getTolerance();
+
+        const QString FOA_ZONE_SIZE_KEY = "foa_zone_size";
+        const QString FOA_NEAR_RADIUS_KEY = "foa_near_radius";
+        const QString FOA_MIN_BED_SOURCES_KEY = "foa_min_bed_sources";
+        const int DEFAULT_FOA_MIN_BED_SOURCES = 8;
+        _workerSharedData.foaZones.setZoneSize(audioThreadingGroupObject[FOA_ZONE_SIZE_KEY].toDouble(0.0));
+        _workerSharedData.foaZones.setNearRadius(audioThreadingGroupObject[FOA_NEAR_RADIUS_KEY].toDouble(0.0));
+        _workerSharedData.foaZones.setMinBedSources(
+            audioThreadingGroupObject[FOA_MIN_BED_SOURCES_KEY].toInt(DEFAULT_FOA_MIN_BED_SOURCES));
+        if (_workerSharedData.foaZones.isEnabled()) {
+            qCDebug(audio) << "FOA zones: size" << _workerSharedData.foaZones.getZoneSize()
+                           << "near radius" << _workerSharedData.foaZones.getNearRadius()
+                           << "min bed sources" << _workerSharedData.foaZones.getMinBedSources();
+        } else {
+            qCDebug(audio) << "FOA zones: disabled";
+        }
+
+        const QString MASKING_THRESHOLD_KEY = "masking_threshold";
+        _workerSharedData.masking.setThreshold(audioThreadingGroupObject[MASKING_THRESHOLD_KEY].toDouble(0.0));
+        if (_workerSharedData.masking.isEnabled()) {
+            qCDebug(audio) << "Masking threshold:" << _workerSharedData.masking.getThreshold() << "dB";
+        } else {
+            qCDebug(audio) << "Masking: disabled";
+        }
+
+        const QString WORK_STEALING_KEY = "work_stealing";
+        _slavePool.setWorkStealing(audioThreadingGroupObject[WORK_STEALING_KEY].toBool(false));
+        qCDebug(audio) << "Work stealing:" << (_slavePool.isWorkStealing() ? "enabled" : "disabled");
+
         const QString THROTTLE_START_KEY = "throttle_start";
         const QString THROTTLE_BACKOFF_KEY = "throttle_backoff";
 
@@ -806,6 +947,100 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 }
             }
         }
+
+        const QString AMBIENT_SOURCES = "ambient_sources";
+        if (audioEnvGroupObject[AMBIENT_SOURCES].isArray()) {
+            const QJsonArray& ambientSources = audioEnvGroupObject[AMBIENT_SOURCES].toArray();
+
+            const QString URL = "url";
+            const QString X = "x";
+            const QString Y = "y";
+            const QString Z = "z";
+            const QString VOLUME = "volume";
+            const QString LOOP = "loop";
+            std::vector<AudioMixerAmbientSources::Source> sources;
+            for (int i = 0; i < ambientSources.count(); ++i) {
+                QJsonObject sourceObject = ambientSources[i].toObject();
+
+                QUrl url = QUrl(sourceObject.value(URL).toString().trimmed());
+                if (!url.isValid() || url.isEmpty()) {
+                    continue;
+                }
+
+                AudioMixerAmbientSources::Source source;
+                source.url = url;
+                bool ok, allOk = true;
+                source.position.x = sourceObject.value(X).toString().toFloat(&ok);
+                allOk &= ok;
+                source.position.y = sourceObject.value(Y).toString().toFloat(&ok);
+                allOk &= ok;
+                source.position.z = sourceObject.value(Z).toString().toFloat(&ok);
+                allOk &= ok;
+                if (sourceObject.contains(VOLUME)) {
+                    source.volume = sourceObject.value(VOLUME).toString().toFloat(&ok);
+                    allOk &= ok;
+                }
+                source.loop = sourceObject.value(LOOP).toBool(true);
+
+                if (allOk) {
+                    sources.push_back(source);
+                    qCDebug(audio) << "Added ambient source:" << url << "(position:" << source.position
+                                   << ", volume:" << source.volume << ", loop:" << source.loop << ")";
+                }
+            }
+            _workerSharedData.ambientSources.setSources(sources);
+        }
+
+        const QString PARTITION_NEIGHBORS = "partition_neighbors";
+        if (audioEnvGroupObject[PARTITION_NEIGHBORS].isArray()) {
+            const QJsonArray& partitionNeighbors = audioEnvGroupObject[PARTITION_NEIGHBORS].toArray();
+
+            const QString ADDRESS = "address";
+            const QString PORT = "port";
+            const QString X_MIN = "x_min";
+            const QString X_MAX = "x_max";
+            const QString Y_MIN = "y_min";
+            const QString Y_MAX = "y_max";
+            const QString Z_MIN = "z_min";
+            const QString Z_MAX = "z_max";
+            std::vector<AudioMixerPartition::Neighbor> neighbors;
+            for (int i = 0; i < partitionNeighbors.count(); ++i) {
+                QJsonObject neighborObject = partitionNeighbors[i].toObject();
+
+                float xMin, xMax, yMin, yMax, zMin, zMax;
+                bool ok, allOk = true;
+                quint16 port = neighborObject.value(PORT).toString().toUShort(&ok);
+                allOk &= ok;
+                xMin = neighborObject.value(X_MIN).toString().toFloat(&ok);
+                allOk &= ok;
+                xMax = neighborObject.value(X_MAX).toString().toFloat(&ok);
+                allOk &= ok;
+                yMin = neighborObject.value(Y_MIN).toString().toFloat(&ok);
+                allOk &= ok;
+                yMax = neighborObject.value(Y_MAX).toString().toFloat(&ok);
+                allOk &= ok;
+                zMin = neighborObject.value(Z_MIN).toString().toFloat(&ok);
+                allOk &= ok;
+                zMax = neighborObject.value(Z_MAX).toString().toFloat(&ok);
+                allOk &= ok;
+
+                SockAddr address(SocketType::UDP, neighborObject.value(ADDRESS).toString(), port, true);
+                if (allOk && !address.isNull()) {
+                    glm::vec3 corner(xMin, yMin, zMin);
+                    glm::vec3 dimensions(xMax - xMin, yMax - yMin, zMax - zMin);
+                    neighbors.push_back({ address, AABox(corner, dimensions) });
+                    qCDebug(audio) << "Added partition neighbor:" << address
+                                   << "(corner:" << corner << ", dimensions:" << dimensions << ")";
+                }
+            }
+
+            const QString PARTITION_MARGIN = "partition_margin";
+            const float DEFAULT_PARTITION_MARGIN = 20.0f;
+            bool ok;
+            float margin = audioEnvGroupObject[PARTITION_MARGIN].toString().toFloat(&ok);
+            _partition.setNeighbors(neighbors, ok ? margin : DEFAULT_PARTITION_MARGIN);
+            qCDebug(audio) << "Partition margin:" << _partition.getMargin();
+        }
     }
 }
 
@@ -19,9 +19,11 @@
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
+#include <shared/LatencyHistogram.h>
 
 #include <plugins/Forward.h>
 
+#include "AudioMixerPartition.h"
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
 
@@ -29,6 +31,7 @@ class PositionalAudioStream;
 class AvatarAudioStream;
 class AudioHRTF;
 class AudioMixerClientData;
+class AudioMixerBenchmarkTests;
 
 /// Handles assignments of type AudioMixer - mixing streams of audio and re-distributing to various clients.
 class AudioMixer : public ThreadedAssignment {
@@ -58,6 +61,7 @@ public:
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static const AudioMixerPartition& getPartition() { return _partition; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -85,6 +89,8 @@ private slots:
     void start();
 
 private:
+    friend class ::AudioMixerBenchmarkTests;
+
     // mixing helpers
     std::chrono::microseconds timeFrame();
     void throttle(std::chrono::microseconds frameDuration, int frame);
@@ -106,6 +112,7 @@ private:
 
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
+    std::vector<AudioMixerStats> _slaveStats;
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
@@ -139,6 +146,7 @@ private:
     Timer _mixTiming;
     Timer _eventsTiming;
     Timer _packetsTiming;
+    LatencyHistogram _frameHistogram; // the work of each frame, sent with the stats
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
@@ -149,6 +157,7 @@ private:
     static std::vector<ZoneDescription> _audioZones;
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
+    static AudioMixerPartition _partition;
 
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
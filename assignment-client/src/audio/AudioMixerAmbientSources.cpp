@@ -0,0 +1,115 @@
+//
+//  AudioMixerAmbientSources.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerAmbientSources.h"
+
+#include <DependencyManager.h>
+
+#include "AudioLogging.h"
+
+AudioMixerAmbientSources::Stream::Stream(const StreamID& streamID, bool isStereo, const glm::vec3& position, float volume) :
+    InjectedAudioStream(streamID, isStereo)
+{
+    _position = position;
+    _orientation = glm::quat();
+    _attenuationRatio = volume;
+}
+
+void AudioMixerAmbientSources::Stream::writeFrame(const int16_t* samples, int numSamples) {
+    _ringBuffer.writeSamples(samples, numSamples);
+    _ringBuffer.addSilentSamples(_ringBuffer.getNumFrameSamples() - numSamples);
+
+    // nothing to wait for, the frame is popped as soon as it is written
+    _isStarved = false;
+    if (popFrames(1, true) > 0) {
+        updateLastPopOutputLoudnessAndTrailingLoudness();
+    }
+}
+
+void AudioMixerAmbientSources::Stream::stop() {
+    _lastPopSucceeded = false;
+    resetStats();
+}
+
+void AudioMixerAmbientSources::setSources(const std::vector<Source>& sources) {
+    clear();
+
+    auto soundCache = DependencyManager::get<SoundCache>();
+    _sources.resize(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        _sources[i].source = sources[i];
+        _sources[i].sound = soundCache->getSound(sources[i].url);
+        _sources[i].nodeIDStreamID = NodeIDStreamID(QUuid(), Node::NULL_LOCAL_ID, QUuid::createUuid());
+    }
+}
+
+void AudioMixerAmbientSources::prepare(AudioMixerClientData::ConcurrentAddedStreams& addedStreams) {
+    _numPlaying = 0;
+
+    for (auto& source : _sources) {
+        if (source.isFinished) {
+            continue;
+        }
+
+        if (!source.stream) {
+            if (source.sound->isFailed()) {
+                qCWarning(audio) << "Ambient source" << source.source.url << "failed to load";
+                source.isFinished = true;
+                continue;
+            }
+            if (!source.sound->isReady()) {
+                continue;
+            }
+
+            // long sounds are decoded as they are played
+            source.soundStream = source.sound->createStream();
+            if (source.sound->isAmbisonic() || source.soundStream->getNumSamples() == 0) {
+                qCWarning(audio) << "Ambient source" << source.source.url << "is not a mono or stereo sound";
+                source.isFinished = true;
+                continue;
+            }
+
+            source.stream.reset(new Stream(source.nodeIDStreamID.streamID, source.sound->isStereo(),
+                                           source.source.position, source.source.volume));
+            addedStreams.push_back(AudioMixerClientData::AddedStream(source.nodeIDStreamID.nodeID,
+                                                                     source.nodeIDStreamID.nodeLocalID,
+                                                                     source.nodeIDStreamID.streamID,
+                                                                     source.stream.get()));
+        }
+
+        // read the next frame of the sound, from its start again when looping
+        const int numFrameSamples = source.stream->getNumFrameSamples();
+        int16_t frame[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        int numSamples = source.soundStream->read(frame, numFrameSamples);
+        while (source.source.loop && numSamples < numFrameSamples) {
+            source.soundStream->seek(0);
+            int numReadFromStart = source.soundStream->read(frame + numSamples, numFrameSamples - numSamples);
+            if (numReadFromStart == 0) {
+                break;
+            }
+            numSamples += numReadFromStart;
+        }
+
+        if (numSamples == 0) {
+            source.stream->stop();
+            source.isFinished = true;
+            continue;
+        }
+
+        source.stream->writeFrame(frame, numSamples);
+        ++_numPlaying;
+    }
+}
+
+void AudioMixerAmbientSources::clear() {
+    _sources.clear();
+    _numPlaying = 0;
+}
@@ -0,0 +1,90 @@
+//
+//  AudioMixerAmbientSources.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerAmbientSources_h
+#define hifi_AudioMixerAmbientSources_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QUrl>
+
+#include <glm/glm.hpp>
+
+#include <InjectedAudioStream.h>
+#include <SoundCache.h>
+
+#include "AudioMixerClientData.h"
+
+// Positional sounds played by the mixer itself.
+//
+// Each source is an ATP or HTTP asset listed in the domain settings, loaded through the SoundCache and fed into an
+// injector stream one frame at a time, so that background music and ambience take no Agent script and no hop through
+// an Agent. Long sounds are decoded a frame at a time as they are played.
+//   prepare must be called while no slaves are mixing; the streams are then mixed by the slaves like any other.
+class AudioMixerAmbientSources {
+public:
+    struct Source {
+        QUrl url;
+        glm::vec3 position;
+        float volume { 1.0f };
+        bool loop { true };
+    };
+
+    // starts loading the sounds of these sources, replacing any previous ones
+    void setSources(const std::vector<Source>& sources);
+    bool isEnabled() const { return !_sources.empty(); }
+
+    // pops the next frame of each ready source, adding the streams that just started to addedStreams
+    void prepare(AudioMixerClientData::ConcurrentAddedStreams& addedStreams);
+
+    // calls f(nodeIDStreamID, positionalStream) for each started stream
+    template <typename F>
+    void forEachStream(F f) const {
+        for (const auto& source : _sources) {
+            if (source.stream) {
+                f(source.nodeIDStreamID, source.stream.get());
+            }
+        }
+    }
+
+    int getNumSources() const { return (int)_sources.size(); }
+    int getNumPlaying() const { return _numPlaying; }
+
+    void clear();
+
+private:
+    // an injector stream written by the mixer instead of parsed from packets
+    class Stream : public InjectedAudioStream {
+    public:
+        Stream(const StreamID& streamID, bool isStereo, const glm::vec3& position, float volume);
+
+        // writes a frame, padded with silence, and pops it
+        void writeFrame(const int16_t* samples, int numSamples);
+
+        // the stream stops being mixed
+        void stop();
+    };
+
+    struct PlayingSource {
+        Source source;
+        SharedSoundPointer sound;
+        NodeIDStreamID nodeIDStreamID { QUuid(), Node::NULL_LOCAL_ID, QUuid() };
+        std::unique_ptr<SoundStream> soundStream;
+        std::unique_ptr<Stream> stream;
+        bool isFinished { false };
+    };
+
+    std::vector<PlayingSource> _sources;
+    int _numPlaying { 0 };
+};
+
+#endif // hifi_AudioMixerAmbientSources_h
@@ -74,9 +74,9 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
                     setupCodecForReplicatedAgent(packet);
                 }
 
-                processStreamPacket(*packet, addedStreams);
+                auto stream = processStreamPacket(*packet, addedStreams);
 
-                optionallyReplicatePacket(*packet, *node);
+                optionallyReplicatePacket(*packet, *node, stream);
                 break;
             }
             case PacketType::AudioStreamStats: {
@@ -127,50 +127,66 @@ bool isReplicatedPacket(PacketType packetType) {
         || packetType == PacketType::ReplicatedSilentAudioFrame;
 }
 
-void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
+void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, const Node& node,
+                                                     const PositionalAudioStream* stream) {
+    const auto& partition = AudioMixer::getPartition();
+
+    // sources of our own clients near a neighboring region are forwarded to its mixer, but not those it forwarded to us
+    bool shouldForward = stream && !node.isUpstream() && partition.isEnabled();
 
     // first, make sure that this is a packet from a node we are supposed to replicate
-    if (node.isReplicated()) {
+    if (!node.isReplicated() && !shouldForward) {
+        return;
+    }
 
-        // now make sure it's a packet type that we want to replicate
+    // now make sure it's a packet type that we want to replicate
 
-        // first check if it is an original type that we should replicate
-        PacketType mirroredType = PacketTypeEnum::getReplicatedPacketMapping().value(message.getType());
+    // first check if it is an original type that we should replicate
+    PacketType mirroredType = PacketTypeEnum::getReplicatedPacketMapping().value(message.getType());
 
-        if (mirroredType == PacketType::Unknown) {
-            // if it wasn't check if it is a replicated type that we should re-replicate
-            if (PacketTypeEnum::getReplicatedPacketMapping().key(message.getType()) != PacketType::Unknown) {
-                mirroredType = message.getType();
-            } else {
-                qCDebug(audio) << "Packet passed to optionallyReplicatePacket was not a replicatable type - returning";
-                return;
-            }
+    if (mirroredType == PacketType::Unknown) {
+        // if it wasn't check if it is a replicated type that we should re-replicate
+        if (PacketTypeEnum::getReplicatedPacketMapping().key(message.getType()) != PacketType::Unknown) {
+            mirroredType = message.getType();
+        } else {
+            qCDebug(audio) << "Packet passed to optionallyReplicatePacket was not a replicatable type - returning";
+            return;
         }
+    }
+
+    std::unique_ptr<NLPacket> packet;
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    // construct the packet only once, if we have anyone to send to
+    auto getPacket = [&]() -> const NLPacket& {
+        if (!packet) {
+            // construct an NLPacket to send to the replicant that has the contents of the received packet
+            packet = NLPacket::create(mirroredType);
 
-        std::unique_ptr<NLPacket> packet;
-        auto nodeList = DependencyManager::get<NodeList>();
+            if (!isReplicatedPacket(message.getType())) {
+                // since this packet will be non-sourced, we add the replicated node's ID here
+                packet->write(node.getUUID().toRfc4122());
+            }
+
+            packet->write(message.getMessage());
+        }
+        return *packet;
+    };
 
+    if (node.isReplicated()) {
         // enumerate the downstream audio mixers and send them the replicated version of this packet
         nodeList->unsafeEachNode([&](const SharedNodePointer& downstreamNode) {
             if (AudioMixer::shouldReplicateTo(node, *downstreamNode)) {
-                // construct the packet only once, if we have any downstream audio mixers to send to
-                if (!packet) {
-                    // construct an NLPacket to send to the replicant that has the contents of the received packet
-                    packet = NLPacket::create(mirroredType);
-
-                    if (!isReplicatedPacket(message.getType())) {
-                        // since this packet will be non-sourced, we add the replicated node's ID here
-                        packet->write(node.getUUID().toRfc4122());
-                    }
-
-                    packet->write(message.getMessage());
-                }
-                
-                nodeList->sendUnreliablePacket(*packet, *downstreamNode);
+                nodeList->sendUnreliablePacket(getPacket(), *downstreamNode);
             }
         });
     }
 
+    if (shouldForward) {
+        partition.forEachNeighborNear(stream->getPosition(), [&](const SockAddr& neighbor) {
+            nodeList->sendUnreliablePacket(getPacket(), neighbor);
+        });
+    }
 }
 
 void AudioMixerClientData::negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node) {
@@ -433,11 +449,12 @@ bool AudioMixerClientData::containsValidPosition(ReceivedMessage& message) const
     return true;
 }
 
-void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams &addedStreams) {
+PositionalAudioStream* AudioMixerClientData::processStreamPacket(ReceivedMessage& message,
+                                                                 ConcurrentAddedStreams &addedStreams) {
 
     if (!containsValidPosition(message)) {
         qDebug() << "Refusing to process audio stream from" << message.getSourceID() << "with invalid position";
-        return;
+        return nullptr;
     }
 
     SharedStreamPointer matchingStream;
@@ -545,6 +562,8 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
         // whenever a stream is added, push it to the concurrent vector of streams added this frame
         addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), matchingStream->getStreamIdentifier(), matchingStream.get()));
     }
+
+    return matchingStream.get();
 }
 
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
@@ -23,6 +23,7 @@
 #include <QtCore/QSharedPointer>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -63,7 +64,8 @@ public:
 
     // packet parsers
     int parseData(ReceivedMessage& message) override;
-    void processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
+    // returns the stream that parsed the packet, or nullptr if it was refused
+    PositionalAudioStream* processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
     void negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node);
     void parseRequestsDomainListData(ReceivedMessage& message);
     void parsePerAvatarGainSet(ReceivedMessage& message, const SharedNodePointer& node);
@@ -93,6 +95,9 @@ public:
 
     AudioLimiter audioLimiter;
 
+    // decoder state for the shared ambisonic bed of this listener's zone
+    AudioFOA& getFOA() { return _foa; }
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
     void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
@@ -124,6 +129,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool isMasked { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -180,7 +186,7 @@ private:
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
-    void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
+    void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node, const PositionalAudioStream* stream);
 
     void setGainForAvatar(QUuid nodeID, float gain);
 
@@ -188,6 +194,8 @@ private:
 
     Streams _streams;
 
+    AudioFOA _foa;
+
     quint16 _outgoingMixedAudioSequenceNumber;
 
     AudioStreamStats _downstreamAudioStreamStats;
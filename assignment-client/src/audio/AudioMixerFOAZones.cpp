@@ -0,0 +1,201 @@
+//
+//  AudioMixerFOAZones.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerFOAZones.h"
+
+#include <algorithm>
+
+#include <InjectedAudioStream.h>
+
+#include "AudioMixer.h"
+#include "AudioMixerClientData.h"
+#include "AudioMixerSlave.h"
+
+const float AudioMixerFOAZones::BED_HEADROOM = 8.0f; // +18dB
+
+// the near region must contain the whole zone, so that listeners never hear themselves through the bed
+static const float HALF_DIAGONAL = 0.8660254f; // sqrt(3)/2
+
+void AudioMixerFOAZones::setZoneSize(float zoneSize) {
+    zoneSize = std::max(zoneSize, 0.0f);
+    if (zoneSize != _zoneSize) {
+        clear();
+    }
+    _zoneSize = zoneSize;
+    _nearRadius = std::max(_requestedNearRadius, _zoneSize * HALF_DIAGONAL);
+}
+
+void AudioMixerFOAZones::setNearRadius(float nearRadius) {
+    _requestedNearRadius = std::max(nearRadius, 0.0f);
+    _nearRadius = std::max(_requestedNearRadius, _zoneSize * HALF_DIAGONAL);
+}
+
+glm::ivec3 AudioMixerFOAZones::cellForPosition(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor(position / _zoneSize));
+}
+
+void AudioMixerFOAZones::prepare(NodeList::const_iterator begin, NodeList::const_iterator end, unsigned int frame) {
+    _frame = frame;
+    _numActiveZones = 0;
+    _numBedSources = 0;
+    _activeZones.clear();
+
+    if (!isEnabled()) {
+        return;
+    }
+
+    // find the zones that have listeners this frame
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (node->getType() != NodeType::Agent || !data || !data->getAvatarAudioStream()) {
+            return;
+        }
+
+        glm::ivec3 cell = cellForPosition(data->getAvatarAudioStream()->getPosition());
+        auto& zone = _zones[cell];
+        if (zone.frame != frame) {
+            zone.frame = frame;
+            zone.center = (glm::vec3(cell) + 0.5f) * _zoneSize;
+            zone.numSources = 0;
+            _activeZones.push_back(&zone);
+        }
+    });
+
+    // zones without listeners are dropped
+    for (auto it = _zones.begin(); it != _zones.end();) {
+        if (it->second.frame != frame) {
+            it = _zones.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (_activeZones.empty()) {
+        return;
+    }
+
+    _accumulation.assign(_activeZones.size() * AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC, 0.0f);
+
+    // encode each far source into the bed of every zone with listeners
+    int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    float mono[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data) {
+            return;
+        }
+
+        for (auto& stream : data->getAudioStreams()) {
+            if (!stream->lastPopSucceeded() || stream->getLastPopOutputLoudness() == 0.0f) {
+                continue;
+            }
+
+            float sourceGain = 1.0f;
+            if (stream->getType() == PositionalAudioStream::Injector) {
+                sourceGain *= static_cast<const InjectedAudioStream*>(stream.get())->getAttenuationRatio();
+            }
+
+            bool hasSamples = false;
+
+            for (size_t i = 0; i < _activeZones.size(); ++i) {
+                Zone& zone = *_activeZones[i];
+
+                glm::vec3 relativePosition = stream->getPosition() - zone.center;
+                float distance = glm::length(relativePosition);
+                if (distance <= _nearRadius) {
+                    continue;
+                }
+
+                float gain = sourceGain * distanceAttenuation(AudioMixer::getAttenuationPerDoublingInDistance(), distance);
+                if (gain == 0.0f) {
+                    continue;
+                }
+
+                if (!hasSamples) {
+                    // read, and downmix to mono
+                    AudioRingBuffer::ConstIterator streamPopOutput = stream->getLastPopOutput();
+                    if (stream->isStereo()) {
+                        streamPopOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+                        for (int j = 0; j < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++j) {
+                            mono[j] = 0.5f * ((float)samples[2 * j + 0] + (float)samples[2 * j + 1]);
+                        }
+                    } else {
+                        streamPopOutput.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+                        for (int j = 0; j < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++j) {
+                            mono[j] = (float)samples[j];
+                        }
+                    }
+                    hasSamples = true;
+                }
+
+                // plane wave from the source direction, converted from Y-up (OpenGL) to ambiX (W, Y, Z, X)
+                glm::vec3 direction = relativePosition / distance;
+                float gainW = gain;
+                float gainY = -direction.x * gain;
+                float gainZ = direction.y * gain;
+                float gainX = -direction.z * gain;
+
+                float* accumulation = &_accumulation[i * AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+                for (int j = 0; j < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++j) {
+                    accumulation[4 * j + 0] += gainW * mono[j];
+                    accumulation[4 * j + 1] += gainY * mono[j];
+                    accumulation[4 * j + 2] += gainZ * mono[j];
+                    accumulation[4 * j + 3] += gainX * mono[j];
+                }
+
+                ++zone.numSources;
+            }
+        }
+    });
+
+    // convert the beds to the AudioFOA input format
+    const float BED_SCALE = 1.0f / BED_HEADROOM;
+    for (size_t i = 0; i < _activeZones.size(); ++i) {
+        Zone& zone = *_activeZones[i];
+
+        const float* accumulation = &_accumulation[i * AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC];
+        for (int j = 0; j < AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC; ++j) {
+            float sample = std::round(accumulation[j] * BED_SCALE);
+            zone.bed[j] = (int16_t)glm::clamp(sample, (float)AudioConstants::MIN_SAMPLE_VALUE,
+                                              (float)AudioConstants::MAX_SAMPLE_VALUE);
+        }
+
+        if (zone.numSources >= _minBedSources) {
+            ++_numActiveZones;
+            _numBedSources += zone.numSources;
+        }
+    }
+}
+
+const AudioMixerFOAZones::Zone* AudioMixerFOAZones::findZone(const glm::vec3& position) const {
+    if (!isEnabled()) {
+        return nullptr;
+    }
+
+    auto it = _zones.find(cellForPosition(position));
+    if (it == _zones.end() || it->second.frame != _frame || it->second.numSources < _minBedSources) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+bool AudioMixerFOAZones::isInBed(const Zone& zone, const PositionalAudioStream& stream) const {
+    return glm::distance(stream.getPosition(), zone.center) > _nearRadius;
+}
+
+void AudioMixerFOAZones::clear() {
+    _zones.clear();
+    _activeZones.clear();
+    _numActiveZones = 0;
+    _numBedSources = 0;
+}
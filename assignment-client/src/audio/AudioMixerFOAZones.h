@@ -0,0 +1,94 @@
+//
+//  AudioMixerFOAZones.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerFOAZones_h
+#define hifi_AudioMixerFOAZones_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AudioConstants.h>
+#include <NodeList.h>
+
+class PositionalAudioStream;
+
+// Shared First-Order Ambisonic beds for crowded areas.
+//
+// Space is divided into cubic zones. For each zone that contains listeners, every active source further than
+// the near radius from the zone center is encoded once per frame into an ambisonic bed. Listeners in that zone
+// then decode the bed with their own orientation, and only run a full HRTF for the near sources.
+//   prepare must be called while no slaves are mixing; the accessors are then safe from any slave.
+class AudioMixerFOAZones {
+public:
+    struct Zone {
+        glm::vec3 center;
+        int16_t bed[AudioConstants::NETWORK_FRAME_SAMPLES_AMBISONIC]; // interleaved, ambiX (ACN/SN3D)
+        int numSources { 0 };
+        unsigned int frame { 0 };
+    };
+
+    // headroom reserved in the bed to sum many sources, to be restored on decode
+    static const float BED_HEADROOM;
+
+    // zone size of 0 disables the beds
+    void setZoneSize(float zoneSize);
+    float getZoneSize() const { return _zoneSize; }
+    bool isEnabled() const { return _zoneSize > 0.0f; }
+
+    // sources within this distance of the zone center get a full HRTF (always covers the whole zone)
+    void setNearRadius(float nearRadius);
+    float getNearRadius() const { return _nearRadius; }
+
+    // a bed is only used once it holds at least this many sources
+    void setMinBedSources(int minBedSources) { _minBedSources = std::max(minBedSources, 1); }
+    int getMinBedSources() const { return _minBedSources; }
+
+    // encode the beds for this frame
+    void prepare(NodeList::const_iterator begin, NodeList::const_iterator end, unsigned int frame);
+
+    // returns the zone whose bed should be used by a listener at this position, or nullptr
+    const Zone* findZone(const glm::vec3& position) const;
+
+    // returns true if the stream is encoded in the bed of this zone
+    bool isInBed(const Zone& zone, const PositionalAudioStream& stream) const;
+
+    int getNumActiveZones() const { return _numActiveZones; }
+    int getNumBedSources() const { return _numBedSources; }
+
+    void clear();
+
+private:
+    struct CellHasher {
+        size_t operator()(const glm::ivec3& cell) const {
+            return ((size_t)cell.x * 73856093) ^ ((size_t)cell.y * 19349663) ^ ((size_t)cell.z * 83492791);
+        }
+    };
+
+    glm::ivec3 cellForPosition(const glm::vec3& position) const;
+
+    std::unordered_map<glm::ivec3, Zone, CellHasher> _zones;
+
+    std::vector<Zone*> _activeZones;
+    std::vector<float> _accumulation;
+
+    float _zoneSize { 0.0f };
+    float _requestedNearRadius { 0.0f };
+    float _nearRadius { 0.0f };
+    int _minBedSources { 8 };
+    unsigned int _frame { 0 };
+
+    int _numActiveZones { 0 };
+    int _numBedSources { 0 };
+};
+
+#endif // hifi_AudioMixerFOAZones_h
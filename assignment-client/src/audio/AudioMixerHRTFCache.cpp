@@ -0,0 +1,99 @@
+//
+//  AudioMixerHRTFCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerHRTFCache.h"
+
+#include <assert.h>
+#include <cmath>
+#include <limits>
+
+#include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
+
+// quantization at a tolerance of 1.0
+static const float AZIMUTH_STEP = TWO_PI / HRTF_AZIMUTHS; // HRTF table resolution
+static const float DISTANCE_STEP = 0.25f;                  // in octaves
+static const float GAIN_STEP = 1.0f / 6.0f;                // in octaves (~1dB)
+
+static const float MAX_TOLERANCE = 4.0f;
+static const int16_t SILENT_GAIN_BUCKET = std::numeric_limits<int16_t>::min();
+
+void AudioMixerHRTFCache::setTolerance(float tolerance) {
+    tolerance = std::min(std::max(tolerance, 0.0f), MAX_TOLERANCE);
+    if (tolerance != _tolerance) {
+        clear();
+    }
+
+    _tolerance = tolerance;
+    _azimuthStep = tolerance * AZIMUTH_STEP;
+    _distanceStep = tolerance * DISTANCE_STEP;
+    _gainStep = tolerance * GAIN_STEP;
+}
+
+bool AudioMixerHRTFCache::render(const PositionalAudioStream* stream, int16_t* input, float* output, int index,
+                                 float azimuth, float distance, float gain, unsigned int frame, uint64_t& renderTime) {
+    assert(isEnabled());
+
+    // quantize to the bucket, and render using its center
+    Key key;
+    key.stream = stream;
+    key.azimuth = (int16_t)std::round(azimuth / _azimuthStep);
+    key.distance = (int16_t)std::round(fastLog2f(distance) / _distanceStep);
+    key.gain = gain > 0.0f ? (int16_t)std::round(fastLog2f(gain) / _gainStep) : SILENT_GAIN_BUCKET;
+
+    auto it = _buckets.find(key);
+    if (it == _buckets.end()) {
+        // if another slave inserts the same key concurrently, its bucket wins and ours is dropped
+        it = _buckets.emplace(key, std::make_shared<Bucket>()).first;
+    }
+    auto& bucket = *it->second;
+
+    bool hit;
+    {
+        std::lock_guard<std::mutex> lock(bucket.mutex);
+        hit = (bucket.frame == frame);
+        if (!hit) {
+            auto start = p_high_resolution_clock::now();
+
+            float bucketAzimuth = key.azimuth * _azimuthStep;
+            float bucketDistance = std::exp2(key.distance * _distanceStep);
+            float bucketGain = key.gain == SILENT_GAIN_BUCKET ? 0.0f : std::exp2(key.gain * _gainStep);
+
+            memset(bucket.output, 0, sizeof(bucket.output));
+            bucket.hrtf.render(input, bucket.output, index, bucketAzimuth, bucketDistance, bucketGain,
+                               AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            bucket.frame = frame;
+
+            renderTime = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start).count();
+        }
+    }
+
+    // the block is not written again until the next frame
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+        output[i] += bucket.output[i];
+    }
+
+    return hit;
+}
+
+void AudioMixerHRTFCache::prune(unsigned int frame) {
+    for (auto it = _buckets.begin(); it != _buckets.end();) {
+        if (it->second->frame != frame) {
+            it = _buckets.unsafe_erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void AudioMixerHRTFCache::clear() {
+    _buckets.clear();
+}
@@ -0,0 +1,85 @@
+//
+//  AudioMixerHRTFCache.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerHRTFCache_h
+#define hifi_AudioMixerHRTFCache_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <TBBHelpers.h>
+
+class PositionalAudioStream;
+
+// Per-frame cache of HRTF-filtered source blocks, shared by listeners that hear a source
+// from (approximately) the same azimuth, distance and gain.
+//   render is thread-safe; prune and clear must only be called while no slaves are mixing.
+class AudioMixerHRTFCache {
+public:
+    // tolerance of 0 disables the cache; 1 quantizes to the HRTF azimuth resolution (5 degrees),
+    // a quarter octave of distance and roughly 1dB of gain; larger values trade accuracy for hits
+    void setTolerance(float tolerance);
+    float getTolerance() const { return _tolerance; }
+    bool isEnabled() const { return _tolerance > 0.0f; }
+
+    // accumulate the shared HRTF-filtered block for this source and bucket into output,
+    // rendering it if no listener has done so yet this frame
+    // returns true on a cache hit, otherwise renderTime is set to the time spent rendering (in ns)
+    bool render(const PositionalAudioStream* stream, int16_t* input, float* output, int index,
+                float azimuth, float distance, float gain, unsigned int frame, uint64_t& renderTime);
+
+    // remove buckets not used during the given frame
+    void prune(unsigned int frame);
+    void clear();
+
+private:
+    struct Key {
+        const PositionalAudioStream* stream;
+        int16_t azimuth;
+        int16_t distance;
+        int16_t gain;
+
+        bool operator==(const Key& other) const {
+            return stream == other.stream && azimuth == other.azimuth &&
+                distance == other.distance && gain == other.gain;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const {
+            size_t hash = std::hash<const void*>()(key.stream);
+            hash ^= ((size_t)(uint16_t)key.azimuth * 73856093) ^ ((size_t)(uint16_t)key.distance * 19349663) ^
+                ((size_t)(uint16_t)key.gain * 83492791);
+            return hash;
+        }
+    };
+
+    struct Bucket {
+        std::mutex mutex;
+        AudioHRTF hrtf;
+        float output[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+        unsigned int frame { (unsigned int)-1 }; // guarded by mutex
+    };
+
+    using Buckets = tbb::concurrent_unordered_map<Key, std::shared_ptr<Bucket>, KeyHasher>;
+
+    Buckets _buckets;
+
+    float _tolerance { 0.0f };
+    float _azimuthStep { 0.0f };
+    float _distanceStep { 0.0f };
+    float _gainStep { 0.0f };
+};
+
+#endif // hifi_AudioMixerHRTFCache_h
@@ -0,0 +1,81 @@
+//
+//  AudioMixerMasking.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerMasking.h"
+
+#include <algorithm>
+#include <cmath>
+
+using BandEnergies = PositionalAudioStream::BandEnergies;
+static const int NUM_BANDS = PositionalAudioStream::NUM_BANDS;
+
+void AudioMixerMasking::setThreshold(float thresholdDB) {
+    _thresholdDB = std::min(thresholdDB, 0.0f);
+    _thresholdRatio = powf(10.0f, _thresholdDB / 10.0f);
+}
+
+int AudioMixerMasking::cull(std::vector<Source>& sources) const {
+    if (!isEnabled() || sources.size() < 2) {
+        return 0;
+    }
+
+    // the whole mix, as heard by the listener
+    BandEnergies total {};
+    for (const auto& source : sources) {
+        const auto& energies = source.stream->getLastPopOutputBandEnergies();
+        float power = source.gain * source.gain;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            total[band] += power * energies[band];
+        }
+    }
+
+    // quietest first, by the trailing energies since a masked sound stays masked for a while after its masker
+    auto trailingEnergy = [](const Source& source) {
+        const auto& energies = source.stream->getLastPopOutputTrailingBandEnergies();
+        float sum = 0.0f;
+        for (float energy : energies) {
+            sum += energy;
+        }
+        return sum * source.gain * source.gain;
+    };
+    std::sort(sources.begin(), sources.end(), [&](const Source& a, const Source& b) {
+        return trailingEnergy(a) < trailingEnergy(b);
+    });
+
+    // cull while everything culled so far stays below the threshold of what is left, in every band
+    BandEnergies culled {};
+    BandEnergies removed {};
+    int numMasked = 0;
+    for (auto& source : sources) {
+        const auto& energies = source.stream->getLastPopOutputBandEnergies();
+        const auto& trailingEnergies = source.stream->getLastPopOutputTrailingBandEnergies();
+        float power = source.gain * source.gain;
+
+        BandEnergies nextCulled;
+        BandEnergies nextRemoved;
+        bool isMasked = true;
+        for (int band = 0; band < NUM_BANDS && isMasked; ++band) {
+            nextCulled[band] = culled[band] + power * trailingEnergies[band];
+            nextRemoved[band] = removed[band] + power * energies[band];
+            isMasked = nextCulled[band] <= _thresholdRatio * (total[band] - nextRemoved[band]);
+        }
+        if (!isMasked) {
+            break;
+        }
+
+        culled = nextCulled;
+        removed = nextRemoved;
+        source.isMasked = true;
+        ++numMasked;
+    }
+
+    return numMasked;
+}
@@ -0,0 +1,47 @@
+//
+//  AudioMixerMasking.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerMasking_h
+#define hifi_AudioMixerMasking_h
+
+#include <vector>
+
+#include <PositionalAudioStream.h>
+
+// Perceptual culling of the streams a listener cannot hear.
+//
+// The band energies of each stream, scaled by its gain to the listener, are weighed against the rest of the mix:
+// the quietest streams are culled for as long as, all together, they stay below the masking threshold of what is left
+// in every band, so that leaving them out is not heard. Culled streams are not rendered through the HRTF at all.
+//   cull is thread-safe; the threshold must only be set while no slaves are mixing.
+class AudioMixerMasking {
+public:
+    struct Source {
+        const PositionalAudioStream* stream;
+        float gain; // to the listener
+        int index; // of the stream, for the caller
+        bool isMasked { false };
+    };
+
+    // threshold below the rest of the mix, in dB; 0 disables the culling
+    void setThreshold(float thresholdDB);
+    float getThreshold() const { return _thresholdDB; }
+    bool isEnabled() const { return _thresholdDB < 0.0f; }
+
+    // reorders the sources and flags the masked ones, returns how many are masked
+    int cull(std::vector<Source>& sources) const;
+
+private:
+    float _thresholdDB { 0.0f };
+    float _thresholdRatio { 0.0f }; // of energies
+};
+
+#endif // hifi_AudioMixerMasking_h
@@ -0,0 +1,30 @@
+//
+//  AudioMixerPartition.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerPartition.h"
+
+#include <algorithm>
+
+void AudioMixerPartition::setNeighbors(const std::vector<Neighbor>& neighbors, float margin) {
+    _margin = std::max(margin, 0.0f);
+    _neighbors.clear();
+    _neighbors.reserve(neighbors.size());
+    for (const auto& neighbor : neighbors) {
+        glm::vec3 corner = neighbor.region.getCorner() - glm::vec3(_margin);
+        glm::vec3 dimensions = neighbor.region.getDimensions() + glm::vec3(2.0f * _margin);
+        _neighbors.push_back({ neighbor.address, AABox(corner, dimensions) });
+    }
+}
+
+void AudioMixerPartition::clear() {
+    _neighbors.clear();
+    _margin = 0.0f;
+}
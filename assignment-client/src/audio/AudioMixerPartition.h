@@ -0,0 +1,58 @@
+//
+//  AudioMixerPartition.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerPartition_h
+#define hifi_AudioMixerPartition_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+#include <SockAddr.h>
+
+// The neighbors of this mixer when a large event is split by region across several domains, each with its own mixer.
+//
+// Every mixer still only mixes for its own listeners; the sources of its own clients that are within the margin of a
+// neighboring region are forwarded to that region's mixer as replicated audio, where they are mixed like the sources
+// of any upstream mixer. Sources that were themselves forwarded are not forwarded again.
+//   set and clear must only be called while no slaves are processing packets.
+class AudioMixerPartition {
+public:
+    struct Neighbor {
+        SockAddr address;
+        AABox region;
+    };
+
+    // margin in meters around each neighboring region within which sources are forwarded
+    void setNeighbors(const std::vector<Neighbor>& neighbors, float margin);
+    bool isEnabled() const { return !_neighbors.empty(); }
+    int getNumNeighbors() const { return (int)_neighbors.size(); }
+    float getMargin() const { return _margin; }
+
+    void clear();
+
+    // calls f(address) for each neighbor whose listeners may hear a source at this position
+    template <typename F>
+    void forEachNeighborNear(const glm::vec3& position, F f) const {
+        for (const auto& neighbor : _neighbors) {
+            if (neighbor.region.contains(position)) {
+                f(neighbor.address);
+            }
+        }
+    }
+
+private:
+    std::vector<Neighbor> _neighbors; // with the margin added to their regions
+    float _margin { 0.0f };
+};
+
+#endif // hifi_AudioMixerPartition_h
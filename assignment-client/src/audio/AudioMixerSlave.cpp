@@ -12,10 +12,12 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
 #include <glm/gtx/vector_angle.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include <LogHandler.h>
 #include <NetworkAccessManager.h>
@@ -49,6 +51,10 @@ void sendMutePacket(const SharedNodePointer& node, AudioMixerClientData&);
 void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData& data);
 
 // mix helpers
+static const int HRTF_DATASET_INDEX = 1;
+// one bit of the 16-bit output, in the scale of the mix
+static const float NEAR_SILENT_PEAK = 1.0f / (float)AudioConstants::MAX_SAMPLE_VALUE;
+
 inline float approximateGain(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd);
 inline float computeGain(float masterAvatarGain, float masterInjectorGain, const AvatarAudioStream& listeningNodeStream,
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
@@ -101,17 +107,18 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
 
         // send audio packet
         if (mixHasAudio || data->shouldFlushEncoder()) {
-            QByteArray encodedBuffer;
+            // the encoders resize the buffer they are given, so reusing it spares them the heap
             if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                // encode the audio, read in place from the mix
+                QByteArray decodedBuffer = QByteArray::fromRawData(reinterpret_cast<char*>(_bufferSamples),
+                                                                   AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                data->encode(decodedBuffer, _encodedBuffer);
             } else {
                 // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+                data->encodeFrameOfZeros(_encodedBuffer);
             }
 
-            sendMixPacket(node, *data, encodedBuffer);
+            sendMixPacket(node, *data, _encodedBuffer);
         } else {
             ++stats.sumListenersSilent;
             sendSilentPacket(node, *data);
@@ -209,6 +216,11 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
             }
         });
 
+        // and the streams of the mixer's own ambient sources, which no listener can ignore
+        _sharedData.ambientSources.forEachStream([&](const NodeIDStreamID& nodeIDStreamID, PositionalAudioStream* stream) {
+            streams.active.emplace_back(nodeIDStreamID, stream);
+        });
+
         // flag this listener as having received their first mix so we know we don't need to enumerate all nodes again
         listenerData.setHasReceivedFirstMix(true);
     } else {
@@ -306,6 +318,53 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+bool AudioMixerSlave::canUseFOAZone(const AudioMixerClientData& listenerData, bool isSoloing) const {
+    // the bed is shared, so it cannot leave out sources for a single listener
+    if (isSoloing || !listenerData.getNewIgnoredNodeIDs().empty() || !listenerData.getNewIgnoringNodeIDs().empty()) {
+        return false;
+    }
+
+    const auto& skipped = listenerData.getStreams().skipped;
+    return std::none_of(skipped.begin(), skipped.end(), [&](const MixableStream& stream) {
+        return (stream.ignoredByListener || stream.ignoringListener) &&
+            _sharedData.foaZones.isInBed(*_foaZone, *stream.positionalStream);
+    });
+}
+
+AudioMixerClientData::MixableStreamsVector::iterator AudioMixerSlave::cullMaskedStreams(
+        AudioMixerClientData::MixableStreamsVector& streams, const AvatarAudioStream& listenerAudioStream) {
+    _maskingSources.clear();
+    for (int i = 0; i < (int)streams.size(); ++i) {
+        const auto& stream = streams[i];
+
+        // never cull the echo of the listener's own stream
+        if (stream.positionalStream == &listenerAudioStream) {
+            continue;
+        }
+
+        float gain = approximateGain(listenerAudioStream, *(stream.positionalStream));
+        if (stream.nodeStreamID.streamID.isNull()) {
+            gain *= stream.hrtf->getGainAdjustment();
+        }
+        _maskingSources.push_back({ stream.positionalStream, gain, i });
+    }
+
+    stats.masked += _sharedData.masking.cull(_maskingSources);
+
+    for (const auto& source : _maskingSources) {
+        auto& stream = streams[source.index];
+        if (source.isMasked && !stream.isMasked) {
+            // drop the tail of the last mixed block, as for throttled streams
+            resetHRTFState(stream);
+        }
+        stream.isMasked = source.isMasked;
+    }
+
+    return std::partition(streams.begin(), streams.end(), [](const MixableStream& stream) {
+        return !stream.isMasked;
+    });
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
@@ -315,11 +374,19 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
+    // soloing already leaves out all but the soloed streams
+    bool isMasking = _sharedData.masking.isEnabled() && !isSoloing;
 
     auto& streams = listenerData->getStreams();
 
     addStreams(*listener, *listenerData);
 
+    // far sources may be heard through the shared ambisonic bed of this listener's zone
+    _foaZone = _sharedData.foaZones.findZone(listenerAudioStream->getPosition());
+    if (_foaZone && !canUseFOAZone(*listenerData, isSoloing)) {
+        _foaZone = nullptr;
+    }
+
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
         if (shouldBeRemoved(stream, _sharedData)) {
@@ -337,7 +404,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
-        if (!isThrottling) {
+        if (!isThrottling && !isMasking) {
             updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
                                  listenerData->getMasterInjectorGain());
         }
@@ -362,7 +429,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
-        if (!isThrottling) {
+        if (!isThrottling && !isMasking) {
             updateHRTFParameters(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(),
                                  listenerData->getMasterInjectorGain());
         }
@@ -375,8 +442,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
-        if (isThrottling) {
-            // we're throttling, so we need to update the approximate volume for any un-skipped streams
+        if (isThrottling || isMasking) {
+            // we're throttling or culling, so we need to update the approximate volume for any un-skipped streams
             // unless this is simply for an echo (in which case the approx volume is 1.0)
             stream.approximateVolume = approximateVolume(stream, listenerAudioStream);
         } else {
@@ -403,16 +470,22 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         return false;
     });
 
-    if (isThrottling) {
+    if (isThrottling || isMasking) {
+        // streams masked by louder ones for this listener are left out first
+        auto audibleEnd = isMasking ? cullMaskedStreams(streams.active, *listenerAudioStream) : end(streams.active);
+        int numAudible = (int)(audibleEnd - begin(streams.active));
+
         // since we're throttling, we need to partition the mixable into throttled and unthrottled streams
-        int numToRetain = min(_numToRetain, (int)streams.active.size()); // Make sure we don't overflow
+        int numToRetain = isThrottling ? min(_numToRetain, numAudible) : numAudible; // Make sure we don't overflow
         auto throttlePoint = begin(streams.active) + numToRetain;
 
-        std::nth_element(streams.active.begin(), throttlePoint, streams.active.end(),
-                         [](const auto& a, const auto& b)
-                         {
-                             return a.approximateVolume > b.approximateVolume;
-                         });
+        if (isThrottling) {
+            std::nth_element(streams.active.begin(), throttlePoint, audibleEnd,
+                             [](const auto& a, const auto& b)
+                             {
+                                 return a.approximateVolume > b.approximateVolume;
+                             });
+        }
 
         SegmentedEraseIf<MixableStreamsVector> erase(streams.active);
         erase.iterateTo(throttlePoint, [&](MixableStream& stream) {
@@ -442,7 +515,10 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             // sources on the first frame where the source becomes throttled
             // this ensures at least remove the tail from last mixed block
             // preventing excessive artifacts on the next first block
-            resetHRTFState(stream);
+            // (masked streams were reset when they became masked)
+            if (!stream.isMasked) {
+                resetHRTFState(stream);
+            }
 
             if (shouldBeSkipped(stream, *listener, *listenerAudioStream, *listenerData)) {
                 streams.skipped.push_back(move(stream));
@@ -460,6 +536,25 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
         });
     }
 
+    // render any HRTFs still queued
+    flushHRTFBatch();
+
+    // decode the shared bed with this listener's orientation
+    if (_foaZone) {
+        // convert from Y-up (OpenGL) to Z-up (Ambisonic) coordinate system
+        glm::quat relativeOrientation = glm::inverse(listenerAudioStream->getOrientation());
+        float qw = relativeOrientation.w;
+        float qx = -relativeOrientation.z;
+        float qy = -relativeOrientation.x;
+        float qz = relativeOrientation.y;
+
+        float gain = listenerData->getMasterAvatarGain() * AudioMixerFOAZones::BED_HEADROOM;
+        listenerData->getFOA().render(const_cast<int16_t*>(_foaZone->bed), _mixSamples, HRTF_DATASET_INDEX,
+                                      qw, qx, qy, qz, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++stats.foaListeners;
+        _foaZone = nullptr;
+    }
+
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
@@ -474,13 +569,15 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 #endif
 
     // check for silent audio before limiting
-    // limiting uses a dither and can only guarantee abs(sample) <= 1
-    bool hasAudio = false;
+    // limiting uses a dither and can only guarantee abs(sample) <= 1, so a mix that stays under one bit of the output,
+    // such as the tail of a distant source, would be encoded and sent as dither alone; it goes out as silence instead
+    float peak = 0.0f;
     for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-        if (_mixSamples[i] != 0.0f) {
-            hasAudio = true;
-            break;
-        }
+        peak = std::max(peak, std::abs(_mixSamples[i]));
+    }
+    bool hasAudio = peak >= NEAR_SILENT_PEAK;
+    if (!hasAudio && peak > 0.0f) {
+        ++stats.sumListenersNearSilent;
     }
 
     // use the per listener AudioLimiter to render the mixed data
@@ -501,6 +598,14 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     // check if this is a server echo of a source back to itself
     bool isEcho = (streamToAdd == &listeningNodeStream);
 
+    // far sources are already in the shared bed
+    if (_foaZone && !isEcho && _sharedData.foaZones.isInBed(*_foaZone, *streamToAdd)) {
+        // start from a clean state if this source is rendered individually again
+        mixableStream.hrtf->reset();
+        ++stats.foaBedMixes;
+        return;
+    }
+
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
@@ -510,8 +615,6 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
-
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
 
@@ -536,10 +639,7 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
             // (this is not done for stereo streams since they do not go through the HRTF)
             if (!streamToAdd->isStereo() && !isEcho) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                           AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-                ++stats.hrtfRenders;
+                renderHRTF(mixableStream, silentMonoBlock, HRTF_DATASET_INDEX, azimuth, distance, gain);
             }
 
             return;
@@ -569,9 +669,52 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
-        mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
-                                   AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-        ++stats.hrtfRenders;
+        renderHRTF(mixableStream, _bufferSamples, HRTF_DATASET_INDEX, azimuth, distance, gain);
+    }
+}
+
+void AudioMixerSlave::renderHRTF(AudioMixerClientData::MixableStream& mixableStream, int16_t* input, int index,
+                                 float azimuth, float distance, float gain) {
+    auto& hrtfCache = _sharedData.hrtfCache;
+    if (hrtfCache.isEnabled()) {
+        // the shared block is rendered without this listener's gain adjustment, so fold it into the gain
+        float adjustedGain = gain * mixableStream.hrtf->getGainAdjustment() / HRTF_GAIN;
+
+        uint64_t renderTime = 0;
+        if (hrtfCache.render(mixableStream.positionalStream, input, _mixSamples, index, azimuth, distance, adjustedGain,
+                             _frame, renderTime)) {
+            ++stats.hrtfCacheHits;
+        } else {
+            ++stats.hrtfCacheMisses;
+            ++stats.hrtfRenders;
+            stats.hrtfCacheRenderTime += renderTime;
+        }
+
+        // the per-listener state is not advanced while cached, so make sure it starts clean if it is used again
+        mixableStream.hrtf->reset();
+        return;
+    }
+
+    // queue the render, to be run with others through the batched HRTF
+    assert(index == HRTF_DATASET_INDEX);
+    int i = _hrtfBatchSize++;
+    memcpy(_hrtfBatchSamples[i], input, sizeof(_hrtfBatchSamples[i]));
+    _hrtfBatch[i] = mixableStream.hrtf.get();
+    _hrtfBatchInputs[i] = _hrtfBatchSamples[i];
+    _hrtfBatchParameters[i] = { azimuth, distance, gain };
+
+    ++stats.hrtfRenders;
+
+    if (_hrtfBatchSize == HRTF_BATCH) {
+        flushHRTFBatch();
+    }
+}
+
+void AudioMixerSlave::flushHRTFBatch() {
+    if (_hrtfBatchSize > 0) {
+        AudioHRTF::renderBatch(_hrtfBatch, _hrtfBatchInputs, _hrtfBatchParameters, _mixSamples, HRTF_DATASET_INDEX,
+                               _hrtfBatchSize, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        _hrtfBatchSize = 0;
     }
 }
 
@@ -603,6 +746,8 @@ void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixabl
 
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
+    // a late mix is as good as a lost one, so don't let it wait behind bulk packets
+    audioPacket->setSendPriority(udt::Packet::SendPriority::High);
     audioPacket->writePrimitive(sequence);
     audioPacket->writeString(codec);
     return audioPacket;
@@ -771,6 +916,11 @@ float computeGain(float masterAvatarGain,
         }
     }
 
+    gain *= distanceAttenuation(attenuationPerDoublingInDistance, distance);
+    return std::min(gain, ATTN_GAIN_MAX);
+}
+
+float distanceAttenuation(float attenuationPerDoublingInDistance, float distance) {
     if (attenuationPerDoublingInDistance < 0.0f) {
         // translate a negative zone setting to distance limit
         const float MIN_DISTANCE_LIMIT = ATTN_DISTANCE_REF + 1.0f;  // silent after 1m
@@ -779,8 +929,7 @@ float computeGain(float masterAvatarGain,
         // calculate the LINEAR attenuation using the distance to this node
         // reference attenuation of 0dB at distance = ATTN_DISTANCE_REF
         float d = distance - ATTN_DISTANCE_REF;
-        gain *= std::max(1.0f - d / (distanceLimit - ATTN_DISTANCE_REF), 0.0f);
-        gain = std::min(gain, ATTN_GAIN_MAX);
+        return std::max(1.0f - d / (distanceLimit - ATTN_DISTANCE_REF), 0.0f);
 
     } else if (attenuationPerDoublingInDistance < 1.0f) {
         // translate a positive zone setting to gain per log2(distance)
@@ -790,15 +939,12 @@ float computeGain(float masterAvatarGain,
         // calculate the LOGARITHMIC attenuation using the distance to this node
         // reference attenuation of 0dB at distance = ATTN_DISTANCE_REF
         float d = (1.0f / ATTN_DISTANCE_REF) * std::max(distance, HRTF_NEARFIELD_MIN);
-        gain *= fastExp2f(fastLog2f(g) * fastLog2f(d));
-        gain = std::min(gain, ATTN_GAIN_MAX);
+        return fastExp2f(fastLog2f(g) * fastLog2f(d));
 
     } else {
         // translate a zone setting of 1.0 be silent at any distance
-        gain = 0.0f;
+        return 0.0f;
     }
-
-    return gain;
 }
 
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
@@ -25,12 +25,19 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioMixerAmbientSources.h"
 #include "AudioMixerClientData.h"
+#include "AudioMixerFOAZones.h"
+#include "AudioMixerHRTFCache.h"
+#include "AudioMixerMasking.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
 class AudioHRTF;
 
+// distance attenuation for a given attenuation coefficient (see AudioMixer::getAttenuationPerDoublingInDistance)
+float distanceAttenuation(float attenuationPerDoublingInDistance, float distance);
+
 class AudioMixerSlave {
 public:
     using ConstIter = NodeList::const_iterator;
@@ -39,6 +46,10 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerHRTFCache hrtfCache;
+        AudioMixerFOAZones foaZones;
+        AudioMixerMasking masking;
+        AudioMixerAmbientSources ambientSources;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -68,13 +79,38 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    void renderHRTF(AudioMixerClientData::MixableStream& mixableStream, int16_t* input, int index,
+                    float azimuth, float distance, float gain);
+    void flushHRTFBatch();
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
+    bool canUseFOAZone(const AudioMixerClientData& listenerData, bool isSoloing) const;
+
+    // moves the streams masked for this listener to the back, returns the end of the audible ones
+    AudioMixerClientData::MixableStreamsVector::iterator cullMaskedStreams(
+        AudioMixerClientData::MixableStreamsVector& streams, const AvatarAudioStream& listenerAudioStream);
+
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // pending HRTF renders, flushed through AudioHRTF::renderBatch
+    AudioHRTF* _hrtfBatch[HRTF_BATCH];
+    int16_t* _hrtfBatchInputs[HRTF_BATCH];
+    AudioHRTF::BatchParameters _hrtfBatchParameters[HRTF_BATCH];
+    int16_t _hrtfBatchSamples[HRTF_BATCH][AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    int _hrtfBatchSize { 0 };
+
+    // scratch for the masking estimate of the current listener
+    std::vector<AudioMixerMasking::Source> _maskingSources;
+
+    // the encoded mix of the current listener, kept so that encoding into it can reuse its space
+    QByteArray _encodedBuffer;
+
+    // shared ambisonic bed heard by the current listener, if any
+    const AudioMixerFOAZones::Zone* _foaZone { nullptr };
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
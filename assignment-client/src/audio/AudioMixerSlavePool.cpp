@@ -24,8 +24,18 @@ void AudioMixerSlaveThread::run() {
 
         // iterate over all available nodes
         SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        if (_pool._workStealing) {
+            // measure each node so the next frame can be balanced
+            while (try_pop(node)) {
+                auto start = p_high_resolution_clock::now();
+                (this->*_function)(node);
+                auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(p_high_resolution_clock::now() - start);
+                _costs.emplace_back(node->getLocalID(), (uint64_t)cost.count());
+            }
+        } else {
+            while (try_pop(node)) {
+                (this->*_function)(node);
+            }
         }
 
         bool stopping = _stop;
@@ -53,6 +63,7 @@ void AudioMixerSlaveThread::wait() {
 }
 
 void AudioMixerSlaveThread::notify(bool stopping) {
+    _finishTime = p_high_resolution_clock::now();
     {
         Lock lock(_pool._mutex);
         assert(_pool._numFinished < _pool._numThreads);
@@ -65,13 +76,49 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    if (!_pool._workStealing) {
+        return _pool._queue.try_pop(node);
+    }
+
+    // take the most expensive remaining node from our own deque...
+    {
+        Lock lock(_dequeMutex);
+        if (!_deque.empty()) {
+            node = std::move(_deque.front());
+            _deque.pop_front();
+            return true;
+        }
+    }
+
+    // ...or steal from another slave
+    return try_steal(node);
+}
+
+bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node) {
+    auto& slaves = _pool._slaves;
+    int numSlaves = (int)slaves.size();
+
+    // start with our neighbour, so that idle slaves spread out over their victims
+    for (int i = 1; i < numSlaves; ++i) {
+        auto& victim = *slaves[(_index + i) % numSlaves];
+
+        Lock lock(victim._dequeMutex);
+        if (!victim._deque.empty()) {
+            // steal from the back, where the victim keeps its cheapest nodes
+            node = std::move(victim._deque.back());
+            victim._deque.pop_back();
+            ++stats.workSteals;
+            return true;
+        }
+    }
+
+    return false;
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, _packetCosts);
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -80,17 +127,22 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
         slave.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    run(begin, end, _mixCosts);
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, CostMap& costs) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    if (_workStealing) {
+        // seed the per-slave deques
+        distribute(_begin, _end, costs);
+    } else {
+        // fill the queue
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            _queue.push(node);
+        });
+    }
 
     {
         Lock lock(_mutex);
@@ -109,6 +161,73 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
     }
 
     assert(_queue.empty());
+
+    // account for the time each slave spent waiting on the slowest one
+    auto lastFinishTime = _slaves.front()->_finishTime;
+    for (auto& slave : _slaves) {
+        lastFinishTime = std::max(lastFinishTime, slave->_finishTime);
+    }
+    for (auto& slave : _slaves) {
+        auto idle = std::chrono::duration_cast<std::chrono::microseconds>(lastFinishTime - slave->_finishTime);
+        slave->stats.workIdleUsecs += idle.count();
+    }
+
+    if (_workStealing) {
+        collectCosts(costs);
+    }
+}
+
+void AudioMixerSlavePool::distribute(ConstIter begin, ConstIter end, const CostMap& costs) {
+    // nodes without a measurement yet (new, or work-stealing was just enabled) are given the average cost
+    uint64_t defaultCost = 1;
+    if (!costs.empty()) {
+        uint64_t sum = 0;
+        for (auto& cost : costs) {
+            sum += cost.second;
+        }
+        defaultCost = std::max(sum / costs.size(), (uint64_t)1);
+    }
+
+    std::vector<std::pair<uint64_t, SharedNodePointer>> work;
+    work.reserve(std::distance(begin, end));
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto it = costs.find(node->getLocalID());
+        work.emplace_back(it != costs.end() ? it->second : defaultCost, node);
+    });
+
+    // longest-processing-time first: hand the most expensive remaining node to the least loaded slave
+    std::sort(work.begin(), work.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    std::vector<uint64_t> loads(_slaves.size(), 0);
+    for (auto& item : work) {
+        auto leastLoaded = std::min_element(loads.begin(), loads.end()) - loads.begin();
+        loads[leastLoaded] += item.first;
+
+        // slaves are not running yet, so the deques can be filled without locking
+        _slaves[leastLoaded]->_deque.push_back(std::move(item.second));
+    }
+}
+
+void AudioMixerSlavePool::collectCosts(CostMap& costs) {
+    // only keep nodes that were processed this frame, smoothing against their previous cost
+    CostMap previousCosts;
+    previousCosts.swap(costs);
+
+    for (auto& slave : _slaves) {
+        assert(slave->_deque.empty());
+        for (auto& cost : slave->_costs) {
+            auto it = previousCosts.find(cost.first);
+            if (it != previousCosts.end()) {
+                const uint64_t TRAILING_WEIGHT = 3;
+                costs[cost.first] = (it->second * TRAILING_WEIGHT + cost.second) / (TRAILING_WEIGHT + 1);
+            } else {
+                costs[cost.first] = cost.second;
+            }
+        }
+        slave->_costs.clear();
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -161,6 +280,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
         // start new slaves
         for (int i = 0; i < numThreads - _numThreads; ++i) {
             auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+            slave->_index = (int)_slaves.size();
             QObject::connect(slave, &QThread::started, [] { setThreadName("AudioMixerSlaveThread"); });
             slave->start();
             _slaves.emplace_back(slave);
@@ -13,10 +13,13 @@
 #define hifi_AudioMixerSlavePool_h
 
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <QThread>
+#include <PortableHighResolutionClock.h>
 #include <shared/QtHelpers.h>
 #include <TBBHelpers.h>
 
@@ -42,10 +45,18 @@ private:
     void wait();
     void notify(bool stopping);
     bool try_pop(SharedNodePointer& node);
+    bool try_steal(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
+    int _index { 0 };
+
+    // work-stealing state
+    Mutex _dequeMutex;
+    std::deque<SharedNodePointer> _deque; // guarded by _dequeMutex
+    std::vector<std::pair<Node::LocalID, uint64_t>> _costs; // measured ns per node, owned by this thread during a run
+    p_high_resolution_clock::time_point _finishTime;
 };
 
 // Slave pool for audio mixers
@@ -55,6 +66,7 @@ class AudioMixerSlavePool {
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
+    using CostMap = std::unordered_map<Node::LocalID, uint64_t>;
 
 public:
     using ConstIter = NodeList::const_iterator;
@@ -79,8 +91,15 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // when enabled, nodes are distributed to per-slave deques balanced by last frame's measured cost,
+    // and idle slaves steal from busy ones; otherwise all slaves pull from a single shared queue
+    void setWorkStealing(bool enabled) { _workStealing = enabled; }
+    bool isWorkStealing() const { return _workStealing; }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(ConstIter begin, ConstIter end, CostMap& costs);
+    void distribute(ConstIter begin, ConstIter end, const CostMap& costs);
+    void collectCosts(CostMap& costs);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
@@ -88,6 +107,7 @@ private:
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
     friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend bool AudioMixerSlaveThread::try_steal(SharedNodePointer& node);
 
     // synchronization state
     Mutex _mutex;
@@ -104,6 +124,11 @@ private:
     Queue _queue;
     ConstIter _begin;
     ConstIter _end;
+    bool _workStealing { false };
+
+    // trailing per-node cost, used to seed the work-stealing deques
+    CostMap _packetCosts;
+    CostMap _mixCosts;
 
     AudioMixerSlave::SharedData& _workerSharedData;
 };
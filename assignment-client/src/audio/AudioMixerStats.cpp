@@ -15,6 +15,7 @@ void AudioMixerStats::reset() {
     sumStreams = 0;
     sumListeners = 0;
     sumListenersSilent = 0;
+    sumListenersNearSilent = 0;
 
     totalMixes = 0;
 
@@ -22,6 +23,13 @@ void AudioMixerStats::reset() {
     hrtfResets = 0;
     hrtfUpdates = 0;
 
+    hrtfCacheHits = 0;
+    hrtfCacheMisses = 0;
+    hrtfCacheRenderTime = 0;
+
+    foaListeners = 0;
+    foaBedMixes = 0;
+
     manualStereoMixes = 0;
     manualEchoMixes = 0;
 
@@ -35,6 +43,10 @@ void AudioMixerStats::reset() {
     skipped = 0;
     inactive = 0;
     active = 0;
+    masked = 0;
+
+    workSteals = 0;
+    workIdleUsecs = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -45,6 +57,7 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     sumStreams += otherStats.sumStreams;
     sumListeners += otherStats.sumListeners;
     sumListenersSilent += otherStats.sumListenersSilent;
+    sumListenersNearSilent += otherStats.sumListenersNearSilent;
 
     totalMixes += otherStats.totalMixes;
 
@@ -52,6 +65,13 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
 
+    hrtfCacheHits += otherStats.hrtfCacheHits;
+    hrtfCacheMisses += otherStats.hrtfCacheMisses;
+    hrtfCacheRenderTime += otherStats.hrtfCacheRenderTime;
+
+    foaListeners += otherStats.foaListeners;
+    foaBedMixes += otherStats.foaBedMixes;
+
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
 
@@ -65,6 +85,10 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    masked += otherStats.masked;
+
+    workSteals += otherStats.workSteals;
+    workIdleUsecs += otherStats.workIdleUsecs;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
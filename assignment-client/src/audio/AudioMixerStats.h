@@ -12,14 +12,13 @@
 #ifndef hifi_AudioMixerStats_h
 #define hifi_AudioMixerStats_h
 
-#ifdef HIFI_AUDIO_MIXER_DEBUG
 #include <cstdint>
-#endif
 
 struct AudioMixerStats {
     int sumStreams { 0 };
     int sumListeners { 0 };
     int sumListenersSilent { 0 };
+    int sumListenersNearSilent { 0 };
 
     int totalMixes { 0 };
 
@@ -27,6 +26,13 @@ struct AudioMixerStats {
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
 
+    int hrtfCacheHits { 0 };
+    int hrtfCacheMisses { 0 };
+    uint64_t hrtfCacheRenderTime { 0 }; // ns spent rendering cache misses
+
+    int foaListeners { 0 };
+    int foaBedMixes { 0 };
+
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
 
@@ -40,6 +46,10 @@ struct AudioMixerStats {
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int masked { 0 };
+
+    int workSteals { 0 };
+    uint64_t workIdleUsecs { 0 };
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
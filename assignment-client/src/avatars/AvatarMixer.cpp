@@ -31,6 +31,7 @@
 #include <AvatarLogging.h>
 #include <LogHandler.h>
 #include <NodeList.h>
+#include <NodeTelemetry.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -106,6 +107,18 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
         PacketReceiver::makeUnsourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleReplicatedBulkAvatarPacket));
 
     auto nodeList = DependencyManager::get<NodeList>();
+
+    // avatar data read by a receive shard goes straight to the queue the slaves process
+    nodeList->registerShardListener(PacketType::AvatarData,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            auto clientData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
+            if (clientData) {
+                clientData->queueShardPacket(message);
+            } else {
+                // client data is only created on the mixer thread
+                QMetaObject::invokeMethod(this, [this, message, node] { queueIncomingPacket(message, node); });
+            }
+        });
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
     connect(nodeList.data(), &NodeList::nodeAdded, this, [this](const SharedNodePointer& node) {
         if (node->getType() == NodeType::DownstreamAvatarMixer) {
@@ -202,17 +215,19 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
         std::unique_ptr<NLPacket> packet;
 
         auto nodeList = DependencyManager::get<NodeList>();
-        nodeList->eachMatchingNode([&](const SharedNodePointer& downstreamNode) {
-            return shouldReplicateTo(node, *downstreamNode);
-        }, [&](const SharedNodePointer& node) {
+        for (const auto& downstreamNode : nodeList->getNodeSnapshot()->ofType(NodeType::DownstreamAvatarMixer)) {
+            if (!shouldReplicateTo(node, *downstreamNode)) {
+                continue;
+            }
+
             if (!packet) {
                 // construct an NLPacket to send to the replicant that has the contents of the received packet
                 packet = NLPacket::create(replicatedType, message.getSize());
                 packet->write(message.getMessage());
             }
 
-            nodeList->sendUnreliablePacket(*packet, *node);
-        });
+            nodeList->sendUnreliablePacket(*packet, *downstreamNode);
+        }
     }
 }
 
@@ -335,6 +350,8 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+                // the slaves only read the grid, so it's built here before they start
+                _slaveSharedData.avatarGrid.rebuild(cbegin, cend, frame);
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
@@ -755,6 +772,23 @@ void AvatarMixer::handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage
     _handleRadiusIgnoreRequestPacketElapsedTime += (end - start);
 }
 
+// the per-frame distribution of each broadcast phase, in usecs
+static QJsonObject broadcastPhaseHistogramStats(const AvatarMixerSlaveStats& stats) {
+    QJsonObject phasesObject;
+    for (int i = 0; i < AvatarMixerSlaveStats::NUM_BROADCAST_PHASES; ++i) {
+        const LatencyHistogram& histogram = stats.broadcastPhaseHistograms[i];
+        QJsonObject phaseObject;
+        phaseObject["frames"] = (double)histogram.getCount();
+        phaseObject["mean"] = histogram.getMean();
+        phaseObject["p50"] = (double)histogram.getPercentile(50.0);
+        phaseObject["p90"] = (double)histogram.getPercentile(90.0);
+        phaseObject["p99"] = (double)histogram.getPercentile(99.0);
+        phaseObject["max"] = (double)histogram.getMax();
+        phasesObject[QString("%1_%2").arg(i + 1).arg(AvatarMixerSlaveStats::BROADCAST_PHASE_NAMES[i])] = phaseObject;
+    }
+    return phasesObject;
+}
+
 void AvatarMixer::sendStatsPacket() {
     if (!_numTightLoopFrames) {
         return;
@@ -766,6 +800,7 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _slavePool.numThreads();
+    statsObject["receive_shards"] = DependencyManager::get<NodeList>()->getNumReceiveShards();
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
@@ -826,13 +861,21 @@ void AvatarMixer::sendStatsPacket() {
 
 
     AvatarMixerSlaveStats aggregateStats;
+    QJsonObject tailLatencyObject;
+    int slaveIndex = 0;
 
     // gather stats
     _slavePool.each([&](AvatarMixerSlave& slave) {
         AvatarMixerSlaveStats stats;
         slave.harvestStats(stats);
         aggregateStats += stats;
+        tailLatencyObject[QString("slave_%1").arg(slaveIndex++)] = broadcastPhaseHistogramStats(stats);
     });
+    tailLatencyObject["pool"] = broadcastPhaseHistogramStats(aggregateStats);
+    for (int i = 0; i < AvatarMixerSlaveStats::NUM_BROADCAST_PHASES; ++i) {
+        NodeTelemetry::mergeHistogram(QString("broadcast_%1_usecs").arg(AvatarMixerSlaveStats::BROADCAST_PHASE_NAMES[i]),
+                                      aggregateStats.broadcastPhaseHistograms[i]);
+    }
 
     QJsonObject slavesAggregatObject;
 
@@ -852,14 +895,24 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
 
+    float averageOthersConsidered = averageNodes ? aggregateStats.numOthersConsidered / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageOthersConsidered"] = TIGHT_LOOP_STAT(averageOthersConsidered);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
     slavesAggregatObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime);
     slavesAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
     slavesAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
+    slavesAggregatObject["timing_7_sorting"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.sortingElapsedTime);
+    slavesAggregatObject["timing_8_frameOverruns"] = aggregateStats.numBroadcastFrameOverruns;
+
+    slavesAggregatObject["arena_1_allocations"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.numArenaAllocations);
+    slavesAggregatObject["arena_2_bytesAllocated"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.numArenaBytesAllocated);
+    slavesAggregatObject["arena_3_heapAllocations"] = aggregateStats.numArenaHeapAllocations;
 
     statsObject["slaves_aggregate (per frame)"] = slavesAggregatObject;
+    statsObject["slaves_broadcast_tail_latency (usecs per frame)"] = tailLatencyObject;
 
     _handleViewFrustumPacketElapsedTime = 0;
     _handleAvatarIdentityPacketElapsedTime = 0;
@@ -1023,6 +1076,14 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         qCDebug(avatars) << "Avatar mixer will automatically determine number of threads to use. Using:" << _slavePool.numThreads() << "threads.";
     }
 
+    {
+        const QString RECEIVE_SHARDS = "receive_shards";
+        auto nodeList = DependencyManager::get<NodeList>();
+        int numReceiveShards = avatarMixerGroupObject[RECEIVE_SHARDS].toVariant().toInt();
+        nodeList->setNumReceiveShards(numReceiveShards);
+        qCDebug(avatars) << "Avatar mixer will read packets with" << nodeList->getNumReceiveShards() << "receive shards";
+    }
+
     {
         const QString CONNECTION_RATE = "connection_rate";
         auto nodeList = DependencyManager::get<NodeList>();
@@ -1042,6 +1103,28 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {   // Size of the cells avatars are bucketed in for broadcast, zero to consider every avatar for every destination:
+        static const QString SPATIAL_GRID_CELL_SIZE_KEY = "spatial_grid_cell_size";
+        if (avatarMixerGroupObject.contains(SPATIAL_GRID_CELL_SIZE_KEY)) {
+            float cellSize = (float)avatarMixerGroupObject[SPATIAL_GRID_CELL_SIZE_KEY].toVariant().toDouble();
+            _slaveSharedData.avatarGrid.setCellSize(std::max(0.0f, cellSize));
+        }
+
+        static const QString SPATIAL_GRID_MIN_AGENTS_KEY = "spatial_grid_min_agents";
+        if (avatarMixerGroupObject.contains(SPATIAL_GRID_MIN_AGENTS_KEY)) {
+            _slaveSharedData.avatarGrid.setMinAgents(avatarMixerGroupObject[SPATIAL_GRID_MIN_AGENTS_KEY].toVariant().toInt());
+        }
+        qCDebug(avatars) << "Avatar mixer spatial grid cell size:" << _slaveSharedData.avatarGrid.getCellSize();
+    }
+
+    {   // Whether lower priority avatars are sent to each client in fewer frames:
+        static const QString UPDATE_RATE_LOD_KEY = "update_rate_lod";
+        if (avatarMixerGroupObject.contains(UPDATE_RATE_LOD_KEY)) {
+            _slaveSharedData.updateRateLOD = avatarMixerGroupObject[UPDATE_RATE_LOD_KEY].toBool();
+        }
+        qCDebug(avatars) << "Avatar mixer update rate LOD" << (_slaveSharedData.updateRateLOD ? "enabled" : "disabled");
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
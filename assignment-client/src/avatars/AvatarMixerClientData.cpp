@@ -12,10 +12,12 @@
 #include "AvatarMixerClientData.h"
 
 #include <algorithm>
+#include <limits>
 #include <udt/PacketHeaders.h>
 
 #include <DependencyManager.h>
 #include <NodeList.h>
+#include <PrioritySortUtil.h>
 #include <EntityTree.h>
 #include <ZoneEntityItem.h>
 
@@ -23,6 +25,26 @@
 
 #include "AvatarMixerSlave.h"
 
+// Tuned to the default sort coefficients, where an in-view avatar's priority is roughly 8 * radius / distance + 0.25:
+// about 10 m away is every frame (45 Hz), 20 m is every other and out of view is every ninth (5 Hz).
+// An avatar that goes a second without being sent gains at least a whole unit of priority from its age.
+const std::array<AvatarMixerClientData::UpdateRateBucket, AvatarMixerClientData::NUM_UPDATE_RATE_BUCKETS>
+    AvatarMixerClientData::UPDATE_RATE_BUCKETS = { {
+    { "45hz", 1.0f, 1 },
+    { "22hz", 0.6f, 2 },
+    { "15hz", 0.4f, 3 },
+    { "9hz", OUT_OF_VIEW_THRESHOLD, 5 },
+    { "5hz", std::numeric_limits<float>::lowest(), 9 }
+} };
+
+int AvatarMixerClientData::updateRateBucketFor(float priority) {
+    int bucket = 0;
+    while (bucket < NUM_UPDATE_RATE_BUCKETS - 1 && priority < UPDATE_RATE_BUCKETS[bucket].minPriority) {
+        ++bucket;
+    }
+    return bucket;
+}
+
 AvatarMixerClientData::AvatarMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) : NodeData(nodeID, nodeLocalID) {
     // in case somebody calls getSessionUUID on the AvatarData instance, make sure it has the right ID
     _avatar->setID(nodeID);
@@ -83,6 +105,12 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
     }
     assert(_packetQueue.empty());
 
+    QSharedPointer<ReceivedMessage> shardPacket;
+    while (_shardPacketQueue.tryPop(shardPacket)) {
+        packetsProcessed++;
+        parseData(*shardPacket, slaveSharedData);
+    }
+
     if (_avatar) {
         _avatar->processCertifyEvents();
     }
@@ -90,50 +118,6 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
     return packetsProcessed;
 }
 
-namespace {
-using std::static_pointer_cast;
-
-// Operator to find if a point is within an avatar-priority (hero) Zone Entity.
-struct FindContainingZone {
-    glm::vec3 position;
-    bool isInPriorityZone { false };
-    bool isInScreenshareZone { false };
-    float priorityZoneVolume { std::numeric_limits<float>::max() };
-    float screenshareZoneVolume { priorityZoneVolume };
-    EntityItemID screenshareZoneid{};
-
-    static bool operation(const OctreeElementPointer& element, void* extraData) {
-        auto findContainingZone = static_cast<FindContainingZone*>(extraData);
-        if (element->getAACube().contains(findContainingZone->position)) {
-            const EntityTreeElementPointer entityTreeElement = static_pointer_cast<EntityTreeElement>(element);
-            entityTreeElement->forEachEntity([&findContainingZone](EntityItemPointer item) {
-                if (item->getType() == EntityTypes::Zone && item->contains(findContainingZone->position)) {
-                    auto zoneItem = static_pointer_cast<ZoneEntityItem>(item);
-                    auto avatarPriorityProperty = zoneItem->getAvatarPriority();
-                    auto screenshareProperty = zoneItem->getScreenshare();
-                    float volume = zoneItem->getVolumeEstimate();
-                    if (avatarPriorityProperty != COMPONENT_MODE_INHERIT
-                        && volume < findContainingZone->priorityZoneVolume) {  // Smaller volume wins
-                        findContainingZone->isInPriorityZone = avatarPriorityProperty == COMPONENT_MODE_ENABLED;
-                        findContainingZone->priorityZoneVolume = volume;
-                    }
-                    if (screenshareProperty != COMPONENT_MODE_INHERIT
-                        && volume < findContainingZone->screenshareZoneVolume) {
-                            findContainingZone->isInScreenshareZone = screenshareProperty == COMPONENT_MODE_ENABLED;
-                            findContainingZone->screenshareZoneVolume = volume;
-                            findContainingZone->screenshareZoneid = zoneItem->getEntityItemID();
-                    }
-                }
-            });
-            return true;  // Keep recursing
-        } else {          // Position isn't within this subspace, so end recursion.
-            return false;
-        }
-    }
-};
-
-}  // namespace
-
 int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveSharedData& slaveSharedData) {
     // pull the sequence number from the data first
     uint16_t sequenceNumber;
@@ -158,18 +142,35 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveShared
     auto newPosition = _avatar->getClientGlobalPosition();
     if (newPosition != oldPosition || _avatar->getNeedsHeroCheck()) {
         EntityTree& entityTree = *slaveSharedData.entityTree;
-        FindContainingZone findContainingZone{ newPosition };
-        entityTree.recurseTreeWithOperation(&FindContainingZone::operation, &findContainingZone);
-        bool currentlyHasPriority = findContainingZone.isInPriorityZone;
+        std::vector<ZoneEntityItemPointer> zones;
+        entityTree.findZonesContaining(newPosition, zones, &_zoneCache);
+
+        // the zones come smallest first, and the smallest that sets a property wins
+        bool currentlyHasPriority = false;
+        bool isInScreenshareZone = false;
+        EntityItemID screenshareZoneID;
+        auto priorityZone = std::find_if(zones.begin(), zones.end(), [](const ZoneEntityItemPointer& zone) {
+            return zone->getAvatarPriority() != COMPONENT_MODE_INHERIT;
+        });
+        if (priorityZone != zones.end()) {
+            currentlyHasPriority = (*priorityZone)->getAvatarPriority() == COMPONENT_MODE_ENABLED;
+        }
+        auto screenshareZone = std::find_if(zones.begin(), zones.end(), [](const ZoneEntityItemPointer& zone) {
+            return zone->getScreenshare() != COMPONENT_MODE_INHERIT;
+        });
+        if (screenshareZone != zones.end()) {
+            isInScreenshareZone = (*screenshareZone)->getScreenshare() == COMPONENT_MODE_ENABLED;
+            screenshareZoneID = (*screenshareZone)->getEntityItemID();
+        }
+
         if (currentlyHasPriority != _avatar->getHasPriority()) {
             _avatar->setHasPriority(currentlyHasPriority);
         }
-        bool isInScreenshareZone = findContainingZone.isInScreenshareZone;
         if (isInScreenshareZone != _avatar->isInScreenshareZone()
-            || findContainingZone.screenshareZoneid != _avatar->getScreenshareZone()) {
+            || screenshareZoneID != _avatar->getScreenshareZone()) {
             _avatar->setInScreenshareZone(isInScreenshareZone);
-            _avatar->setScreenshareZone(findContainingZone.screenshareZoneid);
-            const QUuid& zoneId = isInScreenshareZone ? findContainingZone.screenshareZoneid : QUuid();
+            _avatar->setScreenshareZone(screenshareZoneID);
+            const QUuid& zoneId = isInScreenshareZone ? screenshareZoneID : QUuid();
             auto nodeList = DependencyManager::get<NodeList>();
             auto packet = NLPacket::create(PacketType::AvatarZonePresence, 2 * NUM_BYTES_RFC4122_UUID, true);
             packet->write(_avatar->getSessionUUID().toRfc4122());
@@ -233,6 +234,8 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                     // Deferred for UX work. With no PoP check, no need to get the .fst.
                     _avatar->fetchAvatarFST();
                 }
+                // after the whitelist check, which may have replaced the skeleton URL
+                _packedSimpleTraits[traitType] = _avatar->packTrait(traitType);
 
                 anyTraitsChanged = true;
             } else {
@@ -459,6 +462,14 @@ void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
     }
 }
 
+void AvatarMixerClientData::updateIgnoredNodeIDs(const Node& node) {
+    uint32_t version = node.getIgnoredNodeIDsVersion();
+    if (version != _ignoredNodeIDsVersion) {
+        _sortedIgnoredNodeIDs = node.getSortedIgnoredNodeIDs();
+        _ignoredNodeIDsVersion = version;
+    }
+}
+
 bool AvatarMixerClientData::isRadiusIgnoring(const QUuid& other) const {
     return std::find(_radiusIgnoredOthers.cbegin(), _radiusIgnoredOthers.cend(), other) != _radiusIgnoredOthers.cend();
 }
@@ -489,6 +500,7 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
     _currentViewFrustums.clear();
 
     auto sourceBuffer = reinterpret_cast<const unsigned char*>(message.constData());
+    auto endBuffer = sourceBuffer + message.size();
 
     uint8_t numFrustums = 0;
     memcpy(&numFrustums, sourceBuffer, sizeof(numFrustums));
@@ -500,6 +512,12 @@ void AvatarMixerClientData::readViewFrustumPacket(const QByteArray& message) {
 
         _currentViewFrustums.push_back(frustum);
     }
+
+    AvatarDataPacket::QueryCapabilities capabilities = 0;
+    if (endBuffer - sourceBuffer >= (int)sizeof(capabilities)) {
+        memcpy(&capabilities, sourceBuffer, sizeof(capabilities));
+    }
+    _wantsCompactJointData = (capabilities & AvatarDataPacket::QUERY_WANTS_COMPACT_JOINT_DATA) != 0;
 }
 
 bool AvatarMixerClientData::otherAvatarInView(const AABox& otherAvatarBox) {
@@ -512,7 +530,9 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["num_avs_sent_last_frame"] = _numAvatarsSentLastFrame;
     jsonObject["avg_other_av_starves_per_second"] = getAvgNumOtherAvatarStarvesPerSecond();
     jsonObject["avg_other_av_skips_per_second"] = getAvgNumOtherAvatarSkipsPerSecond();
+    jsonObject["avg_other_av_held_back_per_second"] = getAvgNumOtherAvatarsHeldBackPerSecond();
     jsonObject["total_num_out_of_order_sends"] = _numOutOfOrderSends;
+    jsonObject["total_num_dropped_inbound_av_data"] = (double)_shardPacketQueue.getNumDropped();
 
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
@@ -521,6 +541,13 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
     jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
     jsonObject["recent_other_av_out_of_view"] = _recentOtherAvatarsOutOfView;
+
+    QJsonObject sentPerRateBucket;
+    for (int i = 0; i < NUM_UPDATE_RATE_BUCKETS; ++i) {
+        sentPerRateBucket[UPDATE_RATE_BUCKETS[i].name] = _numAvatarsSentPerRateBucket[i];
+    }
+    jsonObject["num_avs_sent_per_rate_last_frame"] = sentPerRateBucket;
+    jsonObject["num_avs_deferred_last_frame"] = _numAvatarsDeferredLastFrame;
 }
 
 AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherAvatarTraitsSendPoint(
@@ -13,7 +13,9 @@
 #define hifi_AvatarMixerClientData_h
 
 #include <algorithm>
+#include <array>
 #include <cfloat>
+#include <limits>
 #include <unordered_map>
 #include <vector>
 #include <queue>
@@ -22,8 +24,11 @@
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUrl>
 
+#include <shared/BoundedMPSCQueue.h>
+
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
+#include <EntityTreeZoneIndex.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -46,6 +51,17 @@ public:
     using HRCTime = p_high_resolution_clock::time_point;
     using PerNodeTraitVersions = std::unordered_map<Node::LocalID, AvatarTraits::TraitVersions>;
 
+    // Temporal LOD: other avatars are sent to this client every frameInterval broadcast frames, where the bucket is
+    // the first whose minPriority their PrioritySortUtil priority for this client reaches.
+    struct UpdateRateBucket {
+        const char* name;
+        float minPriority;
+        int frameInterval;
+    };
+    static const int NUM_UPDATE_RATE_BUCKETS = 5;
+    static const std::array<UpdateRateBucket, NUM_UPDATE_RATE_BUCKETS> UPDATE_RATE_BUCKETS;
+    static int updateRateBucketFor(float priority);
+
     using NodeData::parseData;  // Avoid clang warning about hiding.
     int parseData(ReceivedMessage& message, const SlaveSharedData& SlaveSharedData);
     MixerAvatar& getAvatar() { return *_avatar; }
@@ -77,9 +93,13 @@ public:
     void incrementNumAvatarsSentLastFrame() { ++_numAvatarsSentLastFrame; }
     int getNumAvatarsSentLastFrame() const { return _numAvatarsSentLastFrame; }
 
-    void recordNumOtherAvatarStarves(int numAvatarsHeldBack) { _otherAvatarStarves.updateAverage((float) numAvatarsHeldBack); }
+    void recordNumOtherAvatarStarves(int numAvatarsStarved) { _otherAvatarStarves.updateAverage((float) numAvatarsStarved); }
     float getAvgNumOtherAvatarStarvesPerSecond() const { return _otherAvatarStarves.getAverageSampleValuePerSecond(); }
 
+    // avatars not sent down to a downstream mixer because it already has their latest data
+    void recordNumOtherAvatarsHeldBack(int numAvatarsHeldBack) { _otherAvatarsHeldBack.updateAverage((float) numAvatarsHeldBack); }
+    float getAvgNumOtherAvatarsHeldBackPerSecond() const { return _otherAvatarsHeldBack.getAverageSampleValuePerSecond(); }
+
     void recordNumOtherAvatarSkips(int numOtherAvatarSkips) { _otherAvatarSkips.updateAverage((float) numOtherAvatarSkips); }
     float getAvgNumOtherAvatarSkipsPerSecond() const { return _otherAvatarSkips.getAverageSampleValuePerSecond(); }
 
@@ -102,6 +122,13 @@ public:
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
+    // the node's ignored node IDs as of its last packet processing, so that the broadcast can check the ignores of each
+    // pair of avatars without taking the node's lock
+    void updateIgnoredNodeIDs(const Node& node);
+    bool isIgnoringNodeWithID(const QUuid& nodeID) const {
+        return std::binary_search(_sortedIgnoredNodeIDs.cbegin(), _sortedIgnoredNodeIDs.cend(), nodeID);
+    }
+
     bool isRadiusIgnoring(const QUuid& other) const;
     void addToRadiusIgnoringSet(const QUuid& other);
     void removeFromRadiusIgnoringSet(const QUuid& other);
@@ -115,6 +142,10 @@ public:
     void resetInViewStats() { _recentOtherAvatarsInView = _recentOtherAvatarsOutOfView = 0; }
     void incrementAvatarInView() { _recentOtherAvatarsInView++; }
     void incrementAvatarOutOfView() { _recentOtherAvatarsOutOfView++; }
+
+    void resetUpdateRateStats() { _numAvatarsSentPerRateBucket.fill(0); _numAvatarsDeferredLastFrame = 0; }
+    void incrementAvatarSentAtRate(int bucket) { _numAvatarsSentPerRateBucket[bucket]++; }
+    void incrementAvatarDeferred() { _numAvatarsDeferredLastFrame++; }
     const QString& getBaseDisplayName() { return _baseDisplayName; }
     void setBaseDisplayName(const QString& baseDisplayName) { _baseDisplayName = baseDisplayName; }
     bool getRequestsDomainListData() { return _requestsDomainListData; }
@@ -123,6 +154,7 @@ public:
     void setPrevRequestsDomainListData(bool requesting) { _prevRequestsDomainListData = requesting; }
 
     const ConicalViewFrustums& getViewFrustums() const { return _currentViewFrustums; }
+    bool getWantsCompactJointData() const { return _wantsCompactJointData; }
 
     uint64_t getLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar) const;
     void setLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar, uint64_t time);
@@ -130,6 +162,10 @@ public:
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+    // thread-safe and never blocks, for AvatarData read by a receive shard
+    // if the slaves fall behind, the oldest queued AvatarData is dropped - newer data supersedes it anyway
+    void queueShardPacket(QSharedPointer<ReceivedMessage> message) { _shardPacketQueue.push(message); }
+    uint64_t getNumDroppedShardPackets() const { return _shardPacketQueue.getNumDropped(); }
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
 
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
@@ -145,6 +181,9 @@ public:
     AvatarTraits::TraitVersions& getLastReceivedTraitVersions() { return _lastReceivedTraitVersions; }
     const AvatarTraits::TraitVersions& getLastReceivedTraitVersions() const { return _lastReceivedTraitVersions; }
 
+    // the avatar's simple traits as last received, packed once and shared by every destination they're sent to
+    const QByteArray& getPackedSimpleTrait(AvatarTraits::TraitType traitType) const { return _packedSimpleTraits[traitType]; }
+
     TraitsCheckTimestamp getLastOtherAvatarTraitsSendPoint(Node::LocalID otherAvatar) const;
     void setLastOtherAvatarTraitsSendPoint(Node::LocalID otherAvatar, TraitsCheckTimestamp sendPoint)
         { _lastSentTraitsTimestamps[otherAvatar] = sendPoint; }
@@ -166,9 +205,14 @@ private:
     };
     PacketQueue _packetQueue;
 
+    // avatar data handed over directly by the receive shard threads
+    static const size_t SHARD_PACKET_QUEUE_SIZE = 64;
+    BoundedMPSCQueue<QSharedPointer<ReceivedMessage>> _shardPacketQueue { SHARD_PACKET_QUEUE_SIZE };
+
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
+    EntityTreeZoneIndex::Cache _zoneCache; // of the zones around the avatar, for its hero and screenshare checks
     std::unordered_map<NLPacket::LocalID, uint16_t> _lastBroadcastSequenceNumbers;
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastBroadcastTimes;
 
@@ -185,21 +229,28 @@ private:
     int _numFramesSinceAdjustment = 0;
 
     SimpleMovingAverage _otherAvatarStarves;
+    SimpleMovingAverage _otherAvatarsHeldBack;
     SimpleMovingAverage _otherAvatarSkips;
     int _numOutOfOrderSends = 0;
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
     SimpleMovingAverage _avgOtherAvatarTraitsRate;
     std::vector<QUuid> _radiusIgnoredOthers;
+    Node::IgnoredNodeIDs _sortedIgnoredNodeIDs;
+    uint32_t _ignoredNodeIDsVersion { std::numeric_limits<uint32_t>::max() };
     ConicalViewFrustums _currentViewFrustums;
+    bool _wantsCompactJointData { false };
 
     int _recentOtherAvatarsInView { 0 };
     int _recentOtherAvatarsOutOfView { 0 };
+    std::array<int, NUM_UPDATE_RATE_BUCKETS> _numAvatarsSentPerRateBucket {};
+    int _numAvatarsDeferredLastFrame { 0 };
     QString _baseDisplayName{}; // The santized key used in determinging unique sessionDisplayName, so that we can remove from dictionary.
     bool _requestsDomainListData { false };
     bool _prevRequestsDomainListData{ false };
 
     AvatarTraits::TraitVersions _lastReceivedTraitVersions;
+    std::array<QByteArray, AvatarTraits::NUM_SIMPLE_TRAITS> _packedSimpleTraits;
     TraitsCheckTimestamp _lastReceivedTraitsChange;
 
     AvatarTraits::TraitMessageSequence _currentTraitsMessageSequence{ 0 };
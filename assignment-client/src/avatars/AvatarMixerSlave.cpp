@@ -12,6 +12,7 @@
 #include "AvatarMixerSlave.h"
 
 #include <algorithm>
+#include <atomic>
 #include <random>
 #include <chrono>
 
@@ -36,6 +37,20 @@
 
 namespace chrono = std::chrono;
 
+const char* const AvatarMixerSlaveStats::BROADCAST_PHASE_NAMES[NUM_BROADCAST_PHASES] = {
+    "ignoreCalculation", "sorting", "avatarDataPacking", "packetSending", "total"
+};
+
+static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
+static const uint64_t USECS_PER_BROADCAST_FRAME = USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+
+namespace {
+    // how many of an overrunning frame's destinations are logged, and how often at most (across all slaves)
+    const size_t NUM_HEAVIEST_DESTINATIONS_LOGGED = 3;
+    const quint64 BROADCAST_OVERRUN_LOG_INTERVAL_USECS = 10 * USECS_PER_SECOND;
+    std::atomic<quint64> lastBroadcastOverrunLogTime { 0 };
+}
+
 void AvatarMixerSlave::configure(ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
@@ -51,9 +66,69 @@ void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end,
     _maxKbpsPerNode = maxKbpsPerNode;
     _throttlingRatio = throttlingRatio;
     _avatarHeroFraction = priorityReservedFraction;
+
+    if (_broadcastFrameStarted) {
+        finishBroadcastFrame();
+    }
+    _broadcastFrameStarted = true;
+}
+
+AvatarMixerSlave::PhaseTimes AvatarMixerSlave::getPhaseElapsedTimes() const {
+    PhaseTimes phaseTimes;
+    phaseTimes[AvatarMixerSlaveStats::IgnoreCalculationPhase] = _stats.ignoreCalculationElapsedTime;
+    phaseTimes[AvatarMixerSlaveStats::SortingPhase] = _stats.sortingElapsedTime;
+    phaseTimes[AvatarMixerSlaveStats::AvatarDataPackingPhase] = _stats.avatarDataPackingElapsedTime;
+    phaseTimes[AvatarMixerSlaveStats::PacketSendingPhase] = _stats.packetSendingElapsedTime;
+    phaseTimes[AvatarMixerSlaveStats::BroadcastTotalPhase] = _stats.jobElapsedTime;
+    return phaseTimes;
+}
+
+void AvatarMixerSlave::finishBroadcastFrame() {
+    const quint64 frameTime = _framePhaseTimes[AvatarMixerSlaveStats::BroadcastTotalPhase];
+    for (int i = 0; i < AvatarMixerSlaveStats::NUM_BROADCAST_PHASES; ++i) {
+        _stats.broadcastPhaseHistograms[i].record(_framePhaseTimes[i]);
+    }
+
+    if (frameTime > USECS_PER_BROADCAST_FRAME) {
+        _stats.numBroadcastFrameOverruns++;
+
+        quint64 now = usecTimestampNow();
+        quint64 lastLogTime = lastBroadcastOverrunLogTime.load();
+        if (now - lastLogTime > BROADCAST_OVERRUN_LOG_INTERVAL_USECS
+            && lastBroadcastOverrunLogTime.compare_exchange_strong(lastLogTime, now)) {
+            // name the phase that took longest
+            int heaviestPhase = 0;
+            for (int i = 1; i < AvatarMixerSlaveStats::BroadcastTotalPhase; ++i) {
+                if (_framePhaseTimes[i] > _framePhaseTimes[heaviestPhase]) {
+                    heaviestPhase = i;
+                }
+            }
+
+            qCWarning(avatars) << "Avatar broadcast took" << frameTime << "usecs against a budget of"
+                << USECS_PER_BROADCAST_FRAME << "- mostly in" << AvatarMixerSlaveStats::BROADCAST_PHASE_NAMES[heaviestPhase]
+                << "(" << _framePhaseTimes[heaviestPhase] << "usecs). Heaviest destinations:";
+            for (const auto& destination : _frameHeaviestDestinations) {
+                QString phases;
+                for (int i = 0; i < AvatarMixerSlaveStats::BroadcastTotalPhase; ++i) {
+                    phases += QString(" %1=%2").arg(AvatarMixerSlaveStats::BROADCAST_PHASE_NAMES[i])
+                        .arg(destination.phaseTimes[i]);
+                }
+                qCWarning(avatars) << "    " << destination.nodeID
+                    << destination.phaseTimes[AvatarMixerSlaveStats::BroadcastTotalPhase] << "usecs:" << qPrintable(phases);
+            }
+        }
+    }
+
+    _framePhaseTimes.fill(0);
+    _frameHeaviestDestinations.clear();
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
+    FrameArena::Stats arenaStats = _frameArena.harvestStats();
+    _stats.numArenaAllocations += arenaStats.numAllocations;
+    _stats.numArenaBytesAllocated += arenaStats.numBytesAllocated;
+    _stats.numArenaHeapAllocations += arenaStats.numHeapAllocations;
+
     stats = _stats;
     _stats.reset();
 }
@@ -64,7 +139,14 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
         _stats.nodesProcessed++;
-        _stats.packetsProcessed += nodeData->processPackets(*_sharedData);
+        nodeData->updateIgnoredNodeIDs(*node);
+        int packetsProcessed = nodeData->processPackets(*_sharedData);
+        _stats.packetsProcessed += packetsProcessed;
+
+        // joints are quantized here once, rather than once per destination in the broadcast
+        if (packetsProcessed > 0) {
+            nodeData->getAvatar().packJointDataForBroadcast();
+        }
     }
     auto end = usecTimestampNow();
     _stats.processIncomingPacketsElapsedTime += (end - start);
@@ -141,8 +223,8 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                 if (lastReceivedVersion > lastSentVersionRef) {
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
                     // there is an update to this trait, add it to the traits packet
-                    bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList,
-                                                                     lastReceivedVersion, *sendingAvatar);
+                    bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList, lastReceivedVersion,
+                                                                     sendingNodeData->getPackedSimpleTrait(traitType));
                     // update the last sent version
                     lastSentVersionRef = lastReceivedVersion;
                     // Remember which versions we sent in this particular packet
@@ -260,19 +342,43 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
     }
 }
 
-static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
-
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
+    const PhaseTimes phaseTimesBefore = getPhaseElapsedTimes();
     quint64 start = usecTimestampNow();
 
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->openSendBatch();
+
     if ((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && node->getLinkedData() && node->getActiveSocket() && !node->isUpstream()) {
         broadcastAvatarDataToAgent(node);
     } else if (node->getType() == NodeType::DownstreamAvatarMixer) {
         broadcastAvatarDataToDownstreamMixer(node);
     }
 
+    nodeList->flushSendBatch();
+
     quint64 end = usecTimestampNow();
     _stats.jobElapsedTime += (end - start);
+
+    // keep this frame's totals, and the destinations that cost the most in case the frame overruns
+    const PhaseTimes phaseTimesAfter = getPhaseElapsedTimes();
+    DestinationTimes destinationTimes { node->getUUID(), {} };
+    for (int i = 0; i < AvatarMixerSlaveStats::NUM_BROADCAST_PHASES; ++i) {
+        destinationTimes.phaseTimes[i] = phaseTimesAfter[i] - phaseTimesBefore[i];
+        _framePhaseTimes[i] += destinationTimes.phaseTimes[i];
+    }
+
+    auto heavier = [](const DestinationTimes& a, const DestinationTimes& b) {
+        return a.phaseTimes[AvatarMixerSlaveStats::BroadcastTotalPhase] > b.phaseTimes[AvatarMixerSlaveStats::BroadcastTotalPhase];
+    };
+    auto position = std::upper_bound(_frameHeaviestDestinations.begin(), _frameHeaviestDestinations.end(),
+        destinationTimes, heavier);
+    if (position - _frameHeaviestDestinations.begin() < (ptrdiff_t)NUM_HEAVIEST_DESTINATIONS_LOGGED) {
+        _frameHeaviestDestinations.insert(position, destinationTimes);
+        if (_frameHeaviestDestinations.size() > NUM_HEAVIEST_DESTINATIONS_LOGGED) {
+            _frameHeaviestDestinations.pop_back();
+        }
+    }
 }
 
 AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
@@ -326,6 +432,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     AvatarMixerClientData* destinationNodeData = reinterpret_cast<AvatarMixerClientData*>(destinationNode->getLinkedData());
 
     destinationNodeData->resetInViewStats();
+    destinationNodeData->resetUpdateRateStats();
 
     const AvatarData& avatar = destinationNodeData->getAvatar();
     glm::vec3 destinationPosition = avatar.getClientGlobalPosition();
@@ -348,8 +455,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     const int maxAvatarBytesPerFrame = int(_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
     const int maxHeroBytesPerFrame = int(maxAvatarBytesPerFrame * _avatarHeroFraction);  // 5555, typical
 
-    // keep track of the number of other avatars held back in this frame
-    int numAvatarsHeldBack = 0;
+    // keep track of the number of other avatars starved in this frame, that is with no new data from their sender
+    int numAvatarsStarved = 0;
 
     // keep track of the number of other avatar frames skipped
     int numAvatarsWithSkippedFrames = 0;
@@ -362,6 +469,10 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // When this is true, the AvatarMixer will send Avatar data to a client about avatars that have ignored them
     bool getsAnyIgnored = PALIsOpen && destinationNode->getCanKick();
 
+    // Heroes, and everyone while the PAL is open, are sent at the full rate.
+    const bool useUpdateRateLOD = _sharedData->updateRateLOD && !PALIsOpen;
+    const uint64_t broadcastStart = usecTimestampNow();
+
     // Bandwidth allowance for data that must be sent.
     int minimumBytesPerAvatar = PALIsOpen ? AvatarDataPacket::AVATAR_HAS_FLAGS_SIZE + NUM_BYTES_RFC4122_UUID +
         sizeof(AvatarDataPacket::AvatarGlobalPosition) + sizeof(AvatarDataPacket::AudioLoudness) : 0;
@@ -373,27 +484,32 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // prepare to sort
     const auto& cameraViews = destinationNodeData->getViewFrustums();
 
-    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
+    // the queues only live while this destination is handled, so they take their space from the arena,
+    // which gets it back for the next destination
+    _frameArena.reset();
+    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar, FrameArenaAllocator<SortableAvatar>>;
+    FrameArenaAllocator<SortableAvatar> allocator(_frameArena);
     // Keep two independent queues, one for heroes and one for the riff-raff.
     enum PriorityVariants { kHero, kNonhero };
     AvatarPriorityQueue avatarPriorityQueues[2] =
     {
         {cameraViews, AvatarData::_avatarSortCoefficientSize, 
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge},
+            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge, allocator},
         {cameraViews, AvatarData::_avatarSortCoefficientSize,
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
+            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge, allocator}
     };
 
     avatarPriorityQueues[kNonhero].reserve(_end - _begin);
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    auto considerSourceAvatar = [&](Node* otherNodeRaw) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
-            continue;
+            return;
         }
 
+        _stats.numOthersConsidered++;
+
         auto sourceAvatarNode = otherNodeRaw;
 
         bool sendAvatar = true;  // We will consider this source avatar for sending.
@@ -412,8 +528,9 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         // make sure we have data for this avatar, that it isn't the same node,
         // and isn't an avatar that the viewing node has ignored
         // or that has ignored the viewing node
-        if ((destinationNode->isIgnoringNodeWithID(sourceAvatarNode->getUUID()) && !PALIsOpen)
-            || (sourceAvatarNode->isIgnoringNodeWithID(destinationNode->getUUID()) && !getsAnyIgnored)) {
+        bool isDestinationIgnoringSource = destinationNodeData->isIgnoringNodeWithID(sourceAvatarNode->getUUID());
+        bool isSourceIgnoringDestination = sourceAvatarNodeData->isIgnoringNodeWithID(destinationNode->getUUID());
+        if ((isDestinationIgnoringSource && !PALIsOpen) || (isSourceIgnoringDestination && !getsAnyIgnored)) {
             sendAvatar = false;
         } else {
             // Check to see if the space bubble is enabled
@@ -458,7 +575,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             // make sure we haven't already sent this data from this sender to this receiver
             // or that somehow we haven't sent
             if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                ++numAvatarsHeldBack;
+                ++numAvatarsStarved;
                 sendAvatar = false;
             } else if (lastSeqFromSender == 0) {
                 // We have have not yet received any data about this avatar. Ignore it for now
@@ -490,8 +607,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         // will be sent when it doesn't need to be (but where it _should_ be OK to send).
         // However, it's less heavy-handed than using `shouldIgnore`.
         if (PALWasOpen && !PALIsOpen &&
-            (destinationNode->isIgnoringNodeWithID(sourceAvatarNode->getUUID()) ||
-                sourceAvatarNode->isIgnoringNodeWithID(destinationNode->getUUID()))) {
+            (isDestinationIgnoringSource || isSourceIgnoringDestination)) {
             // ...send a Kill Packet to Node A, instructing Node A to kill Avatar B,
             // then have Node A cleanup the killed Node B.
             auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
@@ -502,6 +618,24 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         }
 
         destinationNodeData->setPrevRequestsDomainListData(PALIsOpen);
+    };
+
+    // With the PAL open, or just closed, the client is owed news of every avatar, not only the nearby ones.
+    const AvatarSpatialGrid& avatarGrid = _sharedData->avatarGrid;
+    if (avatarGrid.isActive() && !PALIsOpen && !PALWasOpen) {
+        _queryPositions.clear();
+        _queryPositions.push_back(destinationPosition);
+        for (const auto& view : cameraViews) {
+            _queryPositions.push_back(view.getPosition());
+        }
+
+        _candidates.clear();
+        avatarGrid.getCandidates(_queryPositions, _candidates);
+        std::for_each(_candidates.begin(), _candidates.end(), considerSourceAvatar);
+    } else {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& listedNode) {
+            considerSourceAvatar(listedNode.data());
+        });
     }
 
     // loop through our sorted avatars and allocate our bandwidth to them accordingly
@@ -518,13 +652,28 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
     // Loop over two priorities - hero avatars then everyone else:
     for (PriorityVariants currentVariant = kHero; currentVariant <= kNonhero; ++((int&)currentVariant)) {
+        quint64 startSorting = usecTimestampNow();
         const auto& sortedAvatarVector = avatarPriorityQueues[currentVariant].getSortedVector(numToSendEst);
+        _stats.sortingElapsedTime += usecTimestampNow() - startSorting;
         for (const auto& sortedAvatar : sortedAvatarVector) {
             const Node* sourceNode = sortedAvatar.getNode();
             auto lastEncodeForOther = sortedAvatar.getTimestamp();
 
             assert(sourceNode); // we can't have gotten here without the avatarData being a valid key in the map
 
+            int rateBucket = 0;
+            if (useUpdateRateLOD && currentVariant == kNonhero) {
+                rateBucket = AvatarMixerClientData::updateRateBucketFor(sortedAvatar.getPriority());
+                // half a frame of slack absorbs the jitter in when each frame's broadcast gets to this destination
+                uint64_t minSendInterval = AvatarMixerClientData::UPDATE_RATE_BUCKETS[rateBucket].frameInterval *
+                    USECS_PER_BROADCAST_FRAME - USECS_PER_BROADCAST_FRAME / 2;
+                if (lastEncodeForOther != 0 && broadcastStart - lastEncodeForOther < minSendInterval) {
+                    destinationNodeData->incrementAvatarDeferred();
+                    remainingAvatars--;
+                    continue;
+                }
+            }
+
             AvatarData::AvatarDataDetail detail = AvatarData::NoData;
 
             // NOTE: Here's where we determine if we are over budget and drop remaining avatars,
@@ -579,6 +728,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             const bool dropFaceTracking = false;
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
+            sendStatus.compactJoints = destinationNodeData->getWantsCompactJointData();
 
             do {
                 auto startSerialize = chrono::high_resolution_clock::now();
@@ -590,6 +740,10 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
 
                 avatarPacket->write(bytes);
+                if (currentVariant == kHero) {
+                    // a packet carrying any hero avatar leaves ahead of the bulk packets
+                    avatarPacket->setSendPriority(udt::Packet::SendPriority::High);
+                }
                 avatarSpaceAvailable -= bytes.size();
                 numAvatarDataBytes += bytes.size();
                 if (!sendStatus || avatarSpaceAvailable < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE) {
@@ -603,6 +757,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             if (detail != AvatarData::NoData) {
                 _stats.numOthersIncluded++;
+                destinationNodeData->incrementAvatarSentAtRate(rateBucket);
                 if (sourceAvatar->getHasPriority()) {
                     _stats.numHeroesIncluded++;
                 }
@@ -670,8 +825,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     destinationNodeData->recordSentAvatarData(numAvatarDataBytes, traitBytesSent);
 
 
-    // record the number of avatars held back this frame
-    destinationNodeData->recordNumOtherAvatarStarves(numAvatarsHeldBack);
+    // record the number of avatars starved this frame
+    destinationNodeData->recordNumOtherAvatarStarves(numAvatarsStarved);
     destinationNodeData->recordNumOtherAvatarSkips(numAvatarsWithSkippedFrames);
 
     quint64 endPacketSending = usecTimestampNow();
@@ -693,6 +848,9 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
 
     int numAvatarDataBytes = 0;
 
+    // keep track of the number of avatars held back because the downstream mixer already has their data
+    int numAvatarsHeldBack = 0;
+
     // reset the number of sent avatars
     nodeData->resetNumAvatarsSentLastFrame();
 
@@ -709,11 +867,26 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
 
             quint64 startAvatarDataPacking = usecTimestampNow();
 
+            auto lastBroadcastTime = nodeData->getLastBroadcastTime(agentNode->getLocalID());
+            if (lastBroadcastTime <= agentNodeData->getIdentityChangeTimestamp()
+                || (startAvatarDataPacking - lastBroadcastTime) >= REBROADCAST_IDENTITY_TO_DOWNSTREAM_EVERY_US) {
+                sendReplicatedIdentityPacket(*agentNode, agentNodeData, *node);
+                nodeData->setLastBroadcastTime(agentNode->getLocalID(), startAvatarDataPacking);
+            }
+
+            // Nothing new has come in for this avatar since it was last sent down. Downstream mixers can relay to their
+            // own downstream mixers in turn, so resending it would cost every tier below this one as well.
+            AvatarDataSequenceNumber lastSequenceSent = nodeData->getLastBroadcastSequenceNumber(agentNode->getLocalID());
+            if (lastSequenceSent != 0 && lastSequenceSent == agentNodeData->getLastReceivedSequenceNumber()) {
+                ++numAvatarsHeldBack;
+                return;
+            }
+
             // we cannot send a downstream avatar mixer any updates that expect them to have previous state for this avatar
             // since we have no idea if they're online and receiving our packets
 
             // so we always send a full update for this avatar
-            
+
             quint64 start = usecTimestampNow();
             AvatarDataPacket::SendStatus sendStatus;
 
@@ -724,13 +897,6 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
             quint64 end = usecTimestampNow();
             _stats.toByteArrayElapsedTime += (end - start);
 
-            auto lastBroadcastTime = nodeData->getLastBroadcastTime(agentNode->getLocalID());
-            if (lastBroadcastTime <= agentNodeData->getIdentityChangeTimestamp()
-                || (start - lastBroadcastTime) >= REBROADCAST_IDENTITY_TO_DOWNSTREAM_EVERY_US) {
-                sendReplicatedIdentityPacket(*agentNode, agentNodeData, *node);
-                nodeData->setLastBroadcastTime(agentNode->getLocalID(), start);
-            }
-
             // figure out how large our avatar byte array can be to fit in the packet list
             // given that we need it and the avatar UUID and the size of the byte array (16 bit)
             // to fit in a segment of the packet list
@@ -809,5 +975,7 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
         quint64 endPacketSending = usecTimestampNow();
         _stats.packetSendingElapsedTime += (endPacketSending - startPacketSending);
     }
+
+    nodeData->recordNumOtherAvatarsHeldBack(numAvatarsHeldBack);
 }
 
@@ -12,12 +12,30 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <array>
+#include <vector>
+
 #include <NodeList.h>
+#include <shared/FrameArena.h>
+#include <shared/LatencyHistogram.h>
+
+#include "AvatarSpatialGrid.h"
 
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
 public:
+    // the phases of a broadcast frame whose per-frame times are kept in histograms
+    enum BroadcastPhase {
+        IgnoreCalculationPhase = 0,
+        SortingPhase,
+        AvatarDataPackingPhase,
+        PacketSendingPhase,
+        BroadcastTotalPhase,
+        NUM_BROADCAST_PHASES
+    };
+    static const char* const BROADCAST_PHASE_NAMES[NUM_BROADCAST_PHASES];
+
     int nodesProcessed { 0 };
     int packetsProcessed { 0 };
     quint64 processIncomingPacketsElapsedTime { 0 };
@@ -31,15 +49,26 @@ public:
     int numTraitsPacketsSent { 0 };
     int numIdentityPacketsSent { 0 };
     int numOthersIncluded { 0 };
+    int numOthersConsidered { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
+    quint64 sortingElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
     quint64 packetSendingElapsedTime { 0 };
     quint64 toByteArrayElapsedTime { 0 };
     quint64 jobElapsedTime { 0 };
 
+    // the scratch space of broadcasting, which only goes to the heap while the arena grows
+    quint64 numArenaAllocations { 0 };
+    quint64 numArenaBytesAllocated { 0 };
+    int numArenaHeapAllocations { 0 };
+
+    // one sample per broadcast frame of the time this slave spent in each phase
+    std::array<LatencyHistogram, NUM_BROADCAST_PHASES> broadcastPhaseHistograms;
+    int numBroadcastFrameOverruns { 0 };
+
     void reset() {
         // receiving job stats
         nodesProcessed = 0;
@@ -57,14 +86,25 @@ public:
         numTraitsPacketsSent = 0;
         numIdentityPacketsSent = 0;
         numOthersIncluded = 0;
+        numOthersConsidered = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
 
         ignoreCalculationElapsedTime = 0;
+        sortingElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
         packetSendingElapsedTime = 0;
         toByteArrayElapsedTime = 0;
         jobElapsedTime = 0;
+
+        numArenaAllocations = 0;
+        numArenaBytesAllocated = 0;
+        numArenaHeapAllocations = 0;
+
+        for (auto& histogram : broadcastPhaseHistograms) {
+            histogram.reset();
+        }
+        numBroadcastFrameOverruns = 0;
     }
 
     AvatarMixerSlaveStats& operator+=(const AvatarMixerSlaveStats& rhs) {
@@ -81,14 +121,25 @@ public:
         numTraitsPacketsSent += rhs.numTraitsPacketsSent;
         numIdentityPacketsSent += rhs.numIdentityPacketsSent;
         numOthersIncluded += rhs.numOthersIncluded;
+        numOthersConsidered += rhs.numOthersConsidered;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
+        sortingElapsedTime += rhs.sortingElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
         packetSendingElapsedTime += rhs.packetSendingElapsedTime;
         toByteArrayElapsedTime += rhs.toByteArrayElapsedTime;
         jobElapsedTime += rhs.jobElapsedTime;
+
+        numArenaAllocations += rhs.numArenaAllocations;
+        numArenaBytesAllocated += rhs.numArenaBytesAllocated;
+        numArenaHeapAllocations += rhs.numArenaHeapAllocations;
+
+        for (int i = 0; i < NUM_BROADCAST_PHASES; ++i) {
+            broadcastPhaseHistograms[i] += rhs.broadcastPhaseHistograms[i];
+        }
+        numBroadcastFrameOverruns += rhs.numBroadcastFrameOverruns;
         return *this;
     }
 };
@@ -100,6 +151,8 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+    AvatarSpatialGrid avatarGrid; // rebuilt by the mixer before each broadcast
+    bool updateRateLOD { true }; // send lower priority avatars in fewer frames
 };
 
 class AvatarMixerSlave {
@@ -134,6 +187,12 @@ private:
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
+    using PhaseTimes = std::array<quint64, AvatarMixerSlaveStats::NUM_BROADCAST_PHASES>;
+    PhaseTimes getPhaseElapsedTimes() const;
+
+    // records the phase times of the frame just broadcast, and logs its heaviest destinations if it overran
+    void finishBroadcastFrame();
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -143,6 +202,20 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    // the frame being broadcast: time spent in each phase, and the destinations that took longest
+    struct DestinationTimes {
+        QUuid nodeID;
+        PhaseTimes phaseTimes;
+    };
+    PhaseTimes _framePhaseTimes {};
+    std::vector<DestinationTimes> _frameHeaviestDestinations;
+    bool _broadcastFrameStarted { false };
+
+    // scratch space for the destination being broadcast to, kept to spare the heap
+    FrameArena _frameArena;
+    std::vector<glm::vec3> _queryPositions;
+    std::vector<Node*> _candidates;
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
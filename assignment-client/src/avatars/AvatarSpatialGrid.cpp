@@ -0,0 +1,102 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include "AvatarMixerClientData.h"
+
+const float AvatarSpatialGrid::DEFAULT_CELL_SIZE = 32.0f; // meters
+const int AvatarSpatialGrid::DEFAULT_MIN_AGENTS = 64;
+
+namespace {
+    // cells this close (in cells, along any axis) to a query cell are considered in full
+    const int32_t NEAR_CELL_RADIUS = 1;
+    // the avatars in the furthest cells are considered at least this often (in frames)
+    const int32_t MAX_FAR_DECIMATION = 32;
+}
+
+size_t AvatarSpatialGrid::CellKeyHash::operator()(const CellKey& key) const {
+    size_t hash = std::hash<int32_t>()(key.x);
+    hash = hash * 31 + std::hash<int32_t>()(key.y);
+    hash = hash * 31 + std::hash<int32_t>()(key.z);
+    return hash;
+}
+
+AvatarSpatialGrid::CellKey AvatarSpatialGrid::cellKeyFor(const glm::vec3& position) const {
+    glm::vec3 cell = glm::floor(position / _cellSize);
+    return { (int32_t)cell.x, (int32_t)cell.y, (int32_t)cell.z };
+}
+
+void AvatarSpatialGrid::rebuild(ConstIter begin, ConstIter end, uint32_t frame) {
+    _cells.clear();
+    _priorityNodes.clear();
+    _frame = frame;
+
+    int numAgents = (int)std::count_if(begin, end, [](const SharedNodePointer& node) {
+        return node->getType() == NodeType::Agent && node->getLinkedData();
+    });
+
+    _isActive = _cellSize > 0.0f && numAgents >= _minAgents;
+    if (!_isActive) {
+        return;
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        if (node->getType() != NodeType::Agent || !node->getLinkedData()) {
+            return;
+        }
+
+        auto nodeData = reinterpret_cast<const AvatarMixerClientData*>(node->getLinkedData());
+        const MixerAvatar* avatar = nodeData->getConstAvatarData();
+        if (avatar->getHasPriority()) {
+            _priorityNodes.push_back(node.data());
+        } else {
+            _cells[cellKeyFor(avatar->getClientGlobalPosition())].push_back(node.data());
+        }
+    });
+}
+
+void AvatarSpatialGrid::getCandidates(const std::vector<glm::vec3>& positions, std::vector<Node*>& candidates) const {
+    std::vector<CellKey> queryKeys;
+    queryKeys.reserve(positions.size());
+    for (const auto& position : positions) {
+        CellKey key = cellKeyFor(position);
+        if (std::find(queryKeys.begin(), queryKeys.end(), key) == queryKeys.end()) {
+            queryKeys.push_back(key);
+        }
+    }
+
+    for (const auto& cell : _cells) {
+        int32_t distance = std::numeric_limits<int32_t>::max();
+        for (const auto& key : queryKeys) {
+            int32_t cellDistance = std::max(std::abs(cell.first.x - key.x),
+                std::max(std::abs(cell.first.y - key.y), std::abs(cell.first.z - key.z)));
+            distance = std::min(distance, cellDistance);
+        }
+
+        const auto& nodes = cell.second;
+        if (distance <= NEAR_CELL_RADIUS) {
+            candidates.insert(candidates.end(), nodes.begin(), nodes.end());
+        } else {
+            // each avatar in the cell comes up once every `decimation` frames, their priority having aged in between
+            uint32_t decimation = (uint32_t)std::min(distance - NEAR_CELL_RADIUS + 1, MAX_FAR_DECIMATION);
+            for (size_t i = _frame % decimation; i < nodes.size(); i += decimation) {
+                candidates.push_back(nodes[i]);
+            }
+        }
+    }
+
+    candidates.insert(candidates.end(), _priorityNodes.begin(), _priorityNodes.end());
+}
@@ -0,0 +1,73 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+// A uniform grid of the agents' avatar positions, rebuilt by the mixer once per frame before the broadcast.
+// Rather than every destination considering every other avatar, a destination considers all the avatars in the
+// cells around itself and its views, plus a rotating sample of the avatars further out - the further their cell,
+// the fewer frames in which they are considered. Priority avatars are always considered.
+// The grid is read-only while the slaves broadcast.
+class AvatarSpatialGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    static const float DEFAULT_CELL_SIZE;
+    static const int DEFAULT_MIN_AGENTS;
+
+    // a cell size of zero turns the grid off, the slaves then consider every avatar
+    void setCellSize(float cellSize) { _cellSize = cellSize; }
+    float getCellSize() const { return _cellSize; }
+
+    // below this many agents the grid isn't worth it and isn't built
+    void setMinAgents(int minAgents) { _minAgents = minAgents; }
+
+    void rebuild(ConstIter begin, ConstIter end, uint32_t frame);
+
+    // true when the last rebuild produced a grid to query
+    bool isActive() const { return _isActive; }
+
+    // appends the nodes the destination at these positions should consider this frame, each at most once
+    void getCandidates(const std::vector<glm::vec3>& positions, std::vector<Node*>& candidates) const;
+
+private:
+    struct CellKey {
+        int32_t x;
+        int32_t y;
+        int32_t z;
+
+        bool operator==(const CellKey& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const;
+    };
+
+    CellKey cellKeyFor(const glm::vec3& position) const;
+
+    float _cellSize { DEFAULT_CELL_SIZE };
+    int _minAgents { DEFAULT_MIN_AGENTS };
+
+    bool _isActive { false };
+    uint32_t _frame { 0 };
+    std::unordered_map<CellKey, std::vector<Node*>, CellKeyHash> _cells;
+    std::vector<Node*> _priorityNodes;
+};
+
+#endif // hifi_AvatarSpatialGrid_h
@@ -0,0 +1,285 @@
+//
+//  EntityChangeFeed.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityChangeFeed.h"
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtScript/QScriptEngine>
+#include <QtWebSockets/QWebSocket>
+#include <QtWebSockets/QWebSocketServer>
+
+#include <EntitiesLogging.h>
+#include <SharedUtil.h>
+
+// a tool that falls this far behind is dropped rather than holding the server's memory
+const qint64 MAX_SUBSCRIBER_BACKLOG = 16 * 1024 * 1024;
+
+EntityChangeFeed::EntityChangeFeed(EntityTreePointer tree, QObject* parent) :
+    QObject(parent),
+    _tree(tree)
+{
+    // direct, as the tree is changed on other threads
+    connect(tree.get(), &EntityTree::addingEntity, this, [this](const EntityItemID& id) {
+        entityChanged(id, Added);
+    }, Qt::DirectConnection);
+    connect(tree.get(), &EntityTree::editingEntityPointer, this, [this](const EntityItemPointer& entity) {
+        if (entity) {
+            entityChanged(entity->getEntityItemID(), Edited);
+        }
+    }, Qt::DirectConnection);
+    connect(tree.get(), &EntityTree::deletingEntityPointer, this, [this](EntityItem* entity) {
+        entityDeleted(entity);
+    }, Qt::DirectConnection);
+
+    connect(&_flushTimer, &QTimer::timeout, this, &EntityChangeFeed::flush);
+}
+
+EntityChangeFeed::~EntityChangeFeed() {
+    close();
+}
+
+bool EntityChangeFeed::listen(const QHostAddress& address, quint16 port, const QString& accessToken) {
+    close();
+
+    _accessToken = accessToken;
+    _server = new QWebSocketServer(QStringLiteral("Entity Change Feed"), QWebSocketServer::NonSecureMode, this);
+    if (!_server->listen(address, port)) {
+        qCWarning(entities) << "Entity change feed couldn't listen on" << address << port << "-" << _server->errorString();
+        _server->deleteLater();
+        _server = nullptr;
+        return false;
+    }
+    connect(_server, &QWebSocketServer::newConnection, this, &EntityChangeFeed::newConnection);
+    _flushTimer.start(FLUSH_INTERVAL_MSECS);
+    qCInfo(entities) << "Entity change feed listening on" << address << port;
+    return true;
+}
+
+void EntityChangeFeed::close() {
+    _flushTimer.stop();
+    for (auto socket : _subscribers.keys()) {
+        socket->disconnect(this);
+        socket->close();
+        socket->deleteLater();
+    }
+    _subscribers.clear();
+    _numSubscribers = 0;
+    if (_server) {
+        _server->close();
+        _server->deleteLater();
+        _server = nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    _pendingChanges.clear();
+    _pendingDeletes.clear();
+}
+
+void EntityChangeFeed::newConnection() {
+    while (_server && _server->hasPendingConnections()) {
+        QWebSocket* socket = _server->nextPendingConnection();
+        connect(socket, &QWebSocket::textMessageReceived, this, &EntityChangeFeed::subscriptionReceived);
+        connect(socket, &QWebSocket::disconnected, this, &EntityChangeFeed::subscriberDisconnected);
+        _subscribers.insert(socket, Subscriber());
+    }
+}
+
+void EntityChangeFeed::subscriptionReceived(const QString& message) {
+    auto socket = qobject_cast<QWebSocket*>(sender());
+    auto subscriber = _subscribers.find(socket);
+    if (subscriber == _subscribers.end()) {
+        return;
+    }
+
+    QJsonObject request = QJsonDocument::fromJson(message.toUtf8()).object();
+    if (!_accessToken.isEmpty() && request["token"].toString() != _accessToken) {
+        qCWarning(entities) << "Entity change feed refused" << socket->peerAddress() << "- wrong token";
+        socket->close(QWebSocketProtocol::CloseCodePolicyViolated);
+        return;
+    }
+
+    Filter filter;
+    QJsonObject region = request["region"].toObject();
+    if (!region.isEmpty()) {
+        QJsonArray center = region["center"].toArray();
+        QJsonArray dimensions = region["dimensions"].toArray();
+        if (center.size() == 3 && dimensions.size() == 3) {
+            glm::vec3 regionDimensions(dimensions[0].toDouble(), dimensions[1].toDouble(), dimensions[2].toDouble());
+            glm::vec3 regionCenter(center[0].toDouble(), center[1].toDouble(), center[2].toDouble());
+            filter.hasRegion = true;
+            filter.region = AABox(regionCenter - 0.5f * regionDimensions, regionDimensions);
+        }
+    }
+    for (const auto& type : request["types"].toArray()) {
+        filter.types.insert(EntityTypes::getEntityTypeFromName(type.toString()));
+    }
+    for (const auto& owner : request["owners"].toArray()) {
+        filter.owners.insert(QUuid(owner.toString()));
+    }
+    filter.withProperties = request["properties"].toBool();
+
+    if (!subscriber->isSubscribed) {
+        subscriber->isSubscribed = true;
+        ++_numSubscribers;
+    }
+    subscriber->filter = filter;
+    socket->sendTextMessage(QJsonDocument(QJsonObject { { "subscribed", true } }).toJson(QJsonDocument::Compact));
+}
+
+void EntityChangeFeed::subscriberDisconnected() {
+    auto socket = qobject_cast<QWebSocket*>(sender());
+    auto subscriber = _subscribers.find(socket);
+    if (subscriber != _subscribers.end()) {
+        if (subscriber->isSubscribed) {
+            --_numSubscribers;
+        }
+        _subscribers.erase(subscriber);
+    }
+    socket->deleteLater();
+}
+
+void EntityChangeFeed::entityChanged(const EntityItemID& id, EventType type) {
+    if (_numSubscribers == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    auto pending = _pendingChanges.find(id);
+    if (pending == _pendingChanges.end()) {
+        _pendingChanges.insert(id, type);
+    } else if (type == Added) {
+        // an entity deleted and added again in the same batch
+        pending.value() = Added;
+    }
+}
+
+void EntityChangeFeed::entityDeleted(EntityItem* entity) {
+    if (_numSubscribers == 0 || !entity) {
+        return;
+    }
+    Summary summary = summarize(*entity);
+    summary.timestamp = usecTimestampNow();
+
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    // the subscribers never see an entity that came and went in the same batch
+    auto pending = _pendingChanges.find(summary.id);
+    if (pending != _pendingChanges.end()) {
+        bool wasAdded = pending.value() == Added;
+        _pendingChanges.erase(pending);
+        if (wasAdded) {
+            return;
+        }
+    }
+    _pendingDeletes.push_back(summary);
+}
+
+EntityChangeFeed::Summary EntityChangeFeed::summarize(const EntityItem& entity) {
+    Summary summary;
+    summary.id = entity.getEntityItemID();
+    summary.timestamp = entity.getLastEdited();
+    summary.type = entity.getType();
+    bool success;
+    summary.position = entity.getWorldPosition(success);
+    summary.owner = entity.getOwningAvatarID().isNull() ? entity.getLastEditedBy() : entity.getOwningAvatarID();
+    return summary;
+}
+
+bool EntityChangeFeed::Filter::matches(const Summary& summary) const {
+    return (!hasRegion || region.contains(summary.position)) &&
+        (types.isEmpty() || types.contains(summary.type)) &&
+        (owners.isEmpty() || owners.contains(summary.owner));
+}
+
+void EntityChangeFeed::appendEvent(QByteArray& batch, EventType type, const Summary& summary) {
+    uint8_t entityType = (uint8_t)summary.type;
+    batch.append((char)type);
+    batch.append(summary.id.toRfc4122());
+    batch.append(reinterpret_cast<const char*>(&summary.timestamp), sizeof(summary.timestamp));
+    batch.append((char)entityType);
+    batch.append(reinterpret_cast<const char*>(&summary.position), sizeof(summary.position));
+    batch.append(summary.owner.toRfc4122());
+}
+
+void EntityChangeFeed::flush() {
+    QHash<EntityItemID, EventType> changes;
+    std::vector<Summary> deletes;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        changes.swap(_pendingChanges);
+        deletes.swap(_pendingDeletes);
+    }
+    if (_numSubscribers == 0 || (changes.isEmpty() && deletes.empty())) {
+        return;
+    }
+
+    uint64_t numEvents = 0;
+    std::unique_ptr<QScriptEngine> scriptEngine;
+    QByteArray record;
+    _tree->withReadLock([&] {
+        for (auto change = changes.begin(); change != changes.end(); ++change) {
+            auto entity = _tree->findEntityByEntityItemID(change.key());
+            if (!entity) {
+                continue; // deleted since, which its delete says
+            }
+            Summary summary = summarize(*entity);
+
+            // the record is only encoded if a subscriber wants it, and then once for them all
+            bool hasRecord = false;
+            uint8_t encoding = 0;
+            for (auto& subscriber : _subscribers) {
+                if (!subscriber.isSubscribed || !subscriber.filter.matches(summary)) {
+                    continue;
+                }
+                appendEvent(subscriber.batch, change.value(), summary);
+                if (subscriber.filter.withProperties) {
+                    if (!hasRecord) {
+                        if (!scriptEngine) {
+                            scriptEngine.reset(new QScriptEngine());
+                        }
+                        encoding = EntityTree::encodeEntityRecord(entity, *scriptEngine, record);
+                        hasRecord = true;
+                    }
+                    uint32_t size = (uint32_t)record.size();
+                    subscriber.batch.append((char)encoding);
+                    subscriber.batch.append(reinterpret_cast<const char*>(&size), sizeof(size));
+                    subscriber.batch.append(record);
+                }
+                ++numEvents;
+            }
+        }
+    });
+
+    for (const auto& summary : deletes) {
+        for (auto& subscriber : _subscribers) {
+            if (subscriber.isSubscribed && subscriber.filter.matches(summary)) {
+                appendEvent(subscriber.batch, Deleted, summary);
+                ++numEvents;
+            }
+        }
+    }
+
+    for (auto subscriber = _subscribers.begin(); subscriber != _subscribers.end(); ++subscriber) {
+        if (subscriber->batch.isEmpty()) {
+            continue;
+        }
+        QWebSocket* socket = subscriber.key();
+        if (socket->bytesToWrite() > MAX_SUBSCRIBER_BACKLOG) {
+            qCWarning(entities) << "Entity change feed dropped" << socket->peerAddress() << "- too far behind";
+            subscriber->batch.clear();
+            socket->close(QWebSocketProtocol::CloseCodeTooMuchData);
+            continue;
+        }
+        socket->sendBinaryMessage(subscriber->batch);
+        subscriber->batch.clear();
+    }
+    _numEventsSent += numEvents;
+}
@@ -0,0 +1,116 @@
+//
+//  EntityChangeFeed.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityChangeFeed_h
+#define hifi_EntityChangeFeed_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+#include <QtNetwork/QHostAddress>
+
+#include <AABox.h>
+#include <EntityTree.h>
+#include <EntityTypes.h>
+
+class QWebSocket;
+class QWebSocketServer;
+
+// Streams the adds, edits and deletes of the entities to external tools over a WebSocket, so that analytics, moderation
+// and backup services can follow the domain's content without downloading the whole models file.
+//   A tool subscribes with a JSON text message, which it can send again to change its filter:
+//     { "token": <the server's changeFeedToken>,
+//       "region": { "center": [x, y, z], "dimensions": [x, y, z] }, "types": ["Model", ...], "owners": [<uuid>, ...],
+//       "properties": <true to be sent the entities' properties> }
+// with every filter optional. The owner of an avatar entity is its avatar, and of a domain entity its last editor.
+//   The changes are gathered from the tree's signals and sent every FLUSH_INTERVAL_MSECS, the edits to an entity in
+// the meantime coalesced into one event. Each batch is a binary message of events, little-endian:
+//     uint8 event type, 16 byte entity ID, uint64 usecs of the change, uint8 entity type, 3 float position,
+//     16 byte owner, and with properties (not for deletes): uint8 encoding, uint32 size, the entity's record as in the
+//     binary persist file (see EntityTree::encodeEntityRecord)
+class EntityChangeFeed : public QObject {
+    Q_OBJECT
+public:
+    enum EventType : uint8_t {
+        Added = 0,
+        Edited,
+        Deleted
+    };
+
+    static const int FLUSH_INTERVAL_MSECS { 50 };
+
+    EntityChangeFeed(EntityTreePointer tree, QObject* parent = nullptr);
+    ~EntityChangeFeed();
+
+    // \return false if the feed couldn't listen there
+    bool listen(const QHostAddress& address, quint16 port, const QString& accessToken);
+    void close();
+
+    int getNumSubscribers() const { return _numSubscribers; }
+    uint64_t getNumEventsSent() const { return _numEventsSent; }
+
+private slots:
+    void newConnection();
+    void subscriptionReceived(const QString& message);
+    void subscriberDisconnected();
+    void flush();
+
+private:
+    struct Summary {
+        EntityItemID id;
+        quint64 timestamp { 0 };
+        EntityTypes::EntityType type { EntityTypes::Unknown };
+        glm::vec3 position;
+        QUuid owner;
+    };
+
+    struct Filter {
+        bool hasRegion { false };
+        AABox region;
+        QSet<EntityTypes::EntityType> types;
+        QSet<QUuid> owners;
+        bool withProperties { false };
+
+        bool matches(const Summary& summary) const;
+    };
+
+    struct Subscriber {
+        bool isSubscribed { false };
+        Filter filter;
+        QByteArray batch;
+    };
+
+    // from the threads that change the tree, with it locked for writing, so they only note the change
+    void entityChanged(const EntityItemID& id, EventType type);
+    void entityDeleted(EntityItem* entity);
+
+    static Summary summarize(const EntityItem& entity);
+    static void appendEvent(QByteArray& batch, EventType type, const Summary& summary);
+
+    EntityTreePointer _tree;
+    QWebSocketServer* _server { nullptr };
+    QString _accessToken;
+    QHash<QWebSocket*, Subscriber> _subscribers;
+    std::atomic<int> _numSubscribers { 0 };
+    std::atomic<uint64_t> _numEventsSent { 0 };
+    QTimer _flushTimer;
+
+    std::mutex _pendingMutex;
+    QHash<EntityItemID, EventType> _pendingChanges;
+    std::vector<Summary> _pendingDeletes;
+};
+
+#endif // hifi_EntityChangeFeed_h
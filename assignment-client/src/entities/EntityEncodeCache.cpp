@@ -0,0 +1,146 @@
+//
+//  EntityEncodeCache.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodeCache.h"
+
+#include <algorithm>
+
+#include <EntityTreeElement.h>
+
+bool EntityEncodeCache::appendEntityData(const EntityItemPointer& entity, OctreePacketData* packetData,
+                                         EncodeBitstreamParams& params, bool destinationNodeCanGetAndSetPrivateUserData) {
+    Entry entry;
+    entry.entityID = entity->getEntityItemID();
+    entry.lastEdited = entity->getLastEdited();
+    entry.lastUpdated = entity->getLastUpdated();
+    entry.lastSimulated = entity->getLastSimulated();
+    entry.requestedProperties = entity->getEntityProperties(params);
+    entry.includesPrivateUserData = destinationNodeCanGetAndSetPrivateUserData;
+    entry.fitsInPacket = false;
+
+    bool wasCached = findEntry(entity.get(), entry, entry);
+
+    if (wasCached) {
+        if (!entry.fitsInPacket) {
+            ++_uncacheable;
+            return false;
+        }
+
+        if (entry.data.size() > packetData->getBytesAvailable()) {
+            // let the caller encode what fits of this entity, the rest follows in the next packet
+            return false;
+        }
+
+        ++_hits;
+    } else {
+        // encode into a scratch packet once and keep the bytes for every other viewer
+        // this also tracks the send for this viewer, just as a direct appendEntityData would have
+        static thread_local OctreePacketData scratchPacketData(false, MAX_OCTREE_PACKET_DATA_SIZE);
+        scratchPacketData.reset();
+
+        auto scratchExtraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+        auto appendState = entity->appendEntityData(&scratchPacketData, params, scratchExtraEncodeData,
+                                                    destinationNodeCanGetAndSetPrivateUserData);
+
+        entry.fitsInPacket = (appendState == OctreeElement::COMPLETED);
+        if (entry.fitsInPacket) {
+            entry.data = QByteArray((const char*)scratchPacketData.getUncompressedData(), scratchPacketData.getUncompressedSize());
+        }
+
+        storeEntry(entity.get(), entry);
+
+        if (!entry.fitsInPacket) {
+            ++_uncacheable;
+            return false;
+        }
+
+        ++_misses;
+
+        if (entry.data.size() > packetData->getBytesAvailable()) {
+            return false;
+        }
+    }
+
+    LevelDetails entityLevel = packetData->startLevel();
+    if (!packetData->appendRawData(entry.data)) {
+        packetData->discardLevel(entityLevel);
+        return false;
+    }
+    packetData->endLevel(entityLevel);
+
+    if (wasCached) {
+        params.trackSend(entity->getID(), entry.lastEdited);
+    }
+
+    return true;
+}
+
+bool EntityEncodeCache::findEntry(EntityItem* entity, const Entry& key, Entry& entry) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(entity);
+    if (it == _entries.end()) {
+        return false;
+    }
+
+    for (const auto& candidate : it->second) {
+        if (candidate.entityID == key.entityID && candidate.lastEdited == key.lastEdited
+            && candidate.lastUpdated == key.lastUpdated && candidate.lastSimulated == key.lastSimulated
+            && candidate.includesPrivateUserData == key.includesPrivateUserData
+            && candidate.requestedProperties == key.requestedProperties) {
+            entry = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void EntityEncodeCache::storeEntry(EntityItem* entity, Entry entry) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& entries = _entries[entity];
+
+    // anything encoded for an older version of this entity (or a previous entity at this address) is stale now,
+    // and another send thread may have raced us to encode this same variant
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&entry](const Entry& candidate) {
+        bool isStale = candidate.entityID != entry.entityID || candidate.lastEdited != entry.lastEdited
+            || candidate.lastUpdated != entry.lastUpdated || candidate.lastSimulated != entry.lastSimulated;
+        bool isSameVariant = candidate.includesPrivateUserData == entry.includesPrivateUserData
+            && candidate.requestedProperties == entry.requestedProperties;
+        return isStale || isSameVariant;
+    }), entries.end());
+
+    entries.push_back(std::move(entry));
+}
+
+void EntityEncodeCache::invalidate(EntityItem* entity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.erase(entity);
+}
+
+void EntityEncodeCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+}
+
+EntityEncodeCache::Stats EntityEncodeCache::getStats() const {
+    Stats stats;
+    stats.hits = _hits.load();
+    stats.misses = _misses.load();
+    stats.uncacheable = _uncacheable.load();
+    return stats;
+}
+
+size_t EntityEncodeCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
@@ -0,0 +1,73 @@
+//
+//  EntityEncodeCache.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodeCache_h
+#define hifi_EntityEncodeCache_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include <EntityItem.h>
+#include <OctreePacketData.h>
+
+// Holds the bytes EntityItem::appendEntityData produced for each entity at its current edit version, so that the
+// send threads of every viewer watching an entity copy the same encoding instead of each re-encoding it.
+// Entries are keyed by the requested property flags and whether private user data was included, and are dropped through
+// the tree's editingEntityPointer and deletingEntityPointer signals. Only whole entities are cached -
+// continuations of partially sent entities are always encoded directly.
+class EntityEncodeCache {
+public:
+    struct Stats {
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t uncacheable { 0 };
+    };
+
+    // appends the complete encoding of the entity to packetData, encoding it at most once per edit version
+    // returns false without touching packetData if the caller should encode the entity itself,
+    // either because it won't fit in the remaining space or it is too large to encode in one packet
+    bool appendEntityData(const EntityItemPointer& entity, OctreePacketData* packetData, EncodeBitstreamParams& params,
+                          bool destinationNodeCanGetAndSetPrivateUserData);
+
+    void invalidate(EntityItem* entity);
+    void clear();
+
+    Stats getStats() const;
+    size_t size() const;
+
+private:
+    struct Entry {
+        EntityItemID entityID;
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        EntityPropertyFlags requestedProperties;
+        bool includesPrivateUserData;
+        bool fitsInPacket;
+        QByteArray data;
+    };
+
+    bool findEntry(EntityItem* entity, const Entry& key, Entry& entry) const;
+    void storeEntry(EntityItem* entity, Entry entry);
+
+    mutable std::mutex _mutex;
+    std::unordered_map<EntityItem*, std::vector<Entry>> _entries;
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+    std::atomic<uint64_t> _uncacheable { 0 };
+};
+
+#endif // hifi_EntityEncodeCache_h
@@ -0,0 +1,197 @@
+//
+//  EntityPhysicsSimulator.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsSimulator.h"
+
+#include <EntityMotionState.h>
+#include <EntityScriptingInterface.h>
+#include <GLMHelpers.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <PhysicsHelpers.h>
+#include <Profile.h>
+#include <SimulationFlags.h>
+
+// the entities this far out of the region stay in the physics engine, but the clients simulate them
+const float REGION_MARGIN = 10.0f; // meters
+
+EntityPhysicsSimulator::EntityPhysicsSimulator(EntityTreePointer tree) :
+    _tree(tree)
+{
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &EntityPhysicsSimulator::update);
+}
+
+EntityPhysicsSimulator::~EntityPhysicsSimulator() {
+    stop();
+}
+
+void EntityPhysicsSimulator::start(const glm::vec3& center, float radius, uint32_t maxUpdatesPerSecond) {
+    if (isRunning()) {
+        stop();
+    }
+    _regionCenter = center;
+    _regionRadius = radius;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    Physics::setSessionUUID(nodeList->getSessionUUID());
+    _uuidChangedConnection = connect(nodeList.data(), &NodeList::uuidChanged, this, [](const QUuid& sessionUUID) {
+        Physics::setSessionUUID(sessionUUID);
+    });
+    EntityMotionState::setBaseBidPriority(SERVER_SIMULATION_PRIORITY);
+
+    _space = std::make_shared<workload::Space>();
+    workload::View view;
+    view.origin = center;
+    const float regionRadii[workload::Region::NUM_TRACKED_REGIONS] = { radius, radius + REGION_MARGIN, radius + 2.0f * REGION_MARGIN };
+    for (uint32_t i = 0; i < workload::Region::NUM_TRACKED_REGIONS; ++i) {
+        view.regionBackFronts[i] = glm::vec2(regionRadii[i]);
+    }
+    workload::View::updateRegionsFromBackFronts(view);
+    _space->setViews({ view });
+
+    ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine = std::make_shared<PhysicsEngine>(Vectors::ZERO);
+    _physicsEngine->init();
+
+    _entitySimulation = std::make_shared<PhysicalEntitySimulation>();
+    _entitySimulation->init(_tree, _physicsEngine, &_entityEditSender);
+    _entitySimulation->setWorkloadSpace(_space);
+    setMaxUpdatesPerSecond(maxUpdatesPerSecond);
+    _tree->setSimulation(_entitySimulation);
+
+    // the server scripts hear about the collisions of the simulated entities
+    connect(_entitySimulation.get(), &PhysicalEntitySimulation::entityCollisionWithEntity,
+            DependencyManager::get<EntityScriptingInterface>().data(), &EntityScriptingInterface::collisionWithEntity);
+    connect(_tree.get(), &EntityTree::addingEntity, this, &EntityPhysicsSimulator::addingEntity);
+
+    const int SIMULATION_INTERVAL_MSECS = (int)(MSECS_PER_SECOND / NUM_SUBSTEPS_PER_SECOND);
+    _timer.start(SIMULATION_INTERVAL_MSECS);
+}
+
+void EntityPhysicsSimulator::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    _timer.stop();
+    disconnect(_uuidChangedConnection);
+    disconnect(_tree.get(), &EntityTree::addingEntity, this, &EntityPhysicsSimulator::addingEntity);
+
+    // the owner of the tree sets its next simulation
+    _tree->setSimulation(nullptr);
+    _entitySimulation.reset();
+    _physicsEngine.reset();
+    _space.reset();
+    {
+        std::unique_lock<std::mutex> lock(_spaceLock);
+        _spaceUpdates.clear();
+        _entitiesToAddToSpace.clear();
+    }
+    EntityMotionState::setBaseBidPriority(VOLUNTEER_SIMULATION_PRIORITY);
+}
+
+void EntityPhysicsSimulator::setMaxUpdatesPerSecond(uint32_t maxUpdatesPerSecond) {
+    _entityEditSender.setPacketsPerSecond((int)maxUpdatesPerSecond);
+    if (_entitySimulation) {
+        _entitySimulation->setMaxOwnedUpdatesPerSecond(maxUpdatesPerSecond);
+    }
+}
+
+int32_t EntityPhysicsSimulator::getNumPhysicsObjects() const {
+    return _physicsEngine ? _physicsEngine->getNumCollisionObjects() : 0;
+}
+
+void EntityPhysicsSimulator::addingEntity(const EntityItemID& entityID) {
+    std::unique_lock<std::mutex> lock(_spaceLock);
+    _entitiesToAddToSpace.push_back(entityID);
+}
+
+void EntityPhysicsSimulator::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUpdate) {
+    std::unique_lock<std::mutex> lock(_spaceLock);
+    _spaceUpdates.emplace_back(proxyUpdate.first, proxyUpdate.second);
+}
+
+void EntityPhysicsSimulator::updateSpace() {
+    workload::Transaction transaction;
+    std::vector<EntityItemID> entitiesToAdd;
+    {
+        std::unique_lock<std::mutex> lock(_spaceLock);
+        transaction.update(_spaceUpdates);
+        _spaceUpdates.clear();
+        entitiesToAdd.swap(_entitiesToAddToSpace);
+    }
+
+    for (const auto& entityID : entitiesToAdd) {
+        auto entity = _tree->findEntityByEntityItemID(entityID);
+        if (!entity || entity->getSpaceIndex() != -1) {
+            continue;
+        }
+        // without a proxy the entity never gets a region, hence stays out of the physics engine
+        ShapeType shapeType = entity->getShapeType();
+        if (shapeType == SHAPE_TYPE_COMPOUND || shapeType == SHAPE_TYPE_SIMPLE_HULL ||
+                shapeType == SHAPE_TYPE_SIMPLE_COMPOUND || shapeType == SHAPE_TYPE_STATIC_MESH) {
+            continue;
+        }
+        auto spaceIndex = _space->allocateID();
+        workload::Sphere sphere(entity->getWorldPosition(), entity->getBoundingRadius());
+        SpatiallyNestablePointer nestable = std::static_pointer_cast<SpatiallyNestable>(entity);
+        transaction.reset(spaceIndex, sphere, workload::Owner(nestable));
+        entity->setSpaceIndex(spaceIndex);
+        connect(entity.get(), &EntityItem::spaceUpdate, this, &EntityPhysicsSimulator::handleSpaceUpdate, Qt::QueuedConnection);
+    }
+
+    std::vector<int32_t> staleProxies;
+    _tree->swapStaleProxies(staleProxies);
+    transaction.remove(staleProxies);
+
+    _space->enqueueTransaction(transaction);
+    _space->enqueueFrame();
+    _space->processTransactionQueue();
+
+    workload::Changes regionChanges;
+    _space->categorizeAndGetChanges(regionChanges);
+    for (const auto& change : regionChanges) {
+        auto nestable = _space->getOwner(change.proxyId).get<SpatiallyNestablePointer>();
+        if (nestable && nestable->getNestableType() == NestableType::Entity) {
+            _entitySimulation->changeEntity(std::static_pointer_cast<EntityItem>(nestable));
+        }
+    }
+}
+
+void EntityPhysicsSimulator::update() {
+    PROFILE_RANGE(simulation_physics, "EntityPhysicsSimulator");
+
+    updateSpace();
+    _entitySimulation->removeDeadEntities();
+    {
+        PhysicsEngine::Transaction transaction;
+        _entitySimulation->buildPhysicsTransaction(transaction);
+        _physicsEngine->processTransaction(transaction);
+        _entitySimulation->handleProcessedPhysicsTransaction(transaction);
+    }
+    _entitySimulation->applyDynamicChanges();
+
+    _tree->withWriteLock([&] {
+        _physicsEngine->stepSimulation();
+    });
+
+    if (_physicsEngine->hasOutgoingChanges()) {
+        auto& collisionEvents = _physicsEngine->getCollisionEvents();
+        _tree->withWriteLock([&] {
+            _entitySimulation->handleChangedMotionStates(_physicsEngine->getChangedMotionStates());
+            _entitySimulation->handleDeactivatedMotionStates(_physicsEngine->getDeactivatedMotionStates());
+        });
+        _entitySimulation->handleCollisionEvents(collisionEvents);
+    }
+
+    _entityEditSender.releaseQueuedMessages();
+    _entityEditSender.process();
+}
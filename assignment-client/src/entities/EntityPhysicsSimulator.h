@@ -0,0 +1,76 @@
+//
+//  EntityPhysicsSimulator.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsSimulator_h
+#define hifi_EntityPhysicsSimulator_h
+
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <EntityEditPacketSender.h>
+#include <EntityTree.h>
+#include <PhysicalEntitySimulation.h>
+#include <PhysicsEngine.h>
+#include <ShapeManager.h>
+#include <workload/Space.h>
+
+// Headless physics simulation of a spherical region of the domain, for an assignment client.
+// It bids for the dynamic entities of the region at SERVER_SIMULATION_PRIORITY, above the VOLUNTEER and RECRUIT bids
+// of the clients, so the unowned entities end up owned by this simulator and the clients just follow its updates.
+// The updates are spread over the steps to stay within maxUpdatesPerSecond, the longest waiting entities first.
+//
+// The entities whose collision shape needs their model (hulls, compounds and meshes) are left to the clients since the
+// models are not loaded here, and so are the actions and constraints.
+class EntityPhysicsSimulator : public QObject {
+    Q_OBJECT
+public:
+    EntityPhysicsSimulator(EntityTreePointer tree);
+    ~EntityPhysicsSimulator();
+
+    void start(const glm::vec3& center, float radius, uint32_t maxUpdatesPerSecond);
+    void stop();
+    bool isRunning() const { return _entitySimulation != nullptr; }
+    void setMaxUpdatesPerSecond(uint32_t maxUpdatesPerSecond);
+
+    const glm::vec3& getRegionCenter() const { return _regionCenter; }
+    float getRegionRadius() const { return _regionRadius; }
+    int32_t getNumPhysicsObjects() const;
+    const PhysicsEngine::ActivationStats& getActivationStats() const { return _physicsEngine->getActivationStats(); }
+
+private slots:
+    void update();
+    void addingEntity(const EntityItemID& entityID);
+    void handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUpdate);
+
+private:
+    void updateSpace();
+
+    EntityTreePointer _tree;
+    ShapeManager _shapeManager;
+    PhysicsEnginePointer _physicsEngine;
+    PhysicalEntitySimulationPointer _entitySimulation;
+    EntityEditPacketSender _entityEditSender;
+
+    workload::SpacePointer _space;
+    std::mutex _spaceLock;
+    workload::Transaction::Updates _spaceUpdates;
+    std::vector<EntityItemID> _entitiesToAddToSpace;
+
+    QTimer _timer;
+    QMetaObject::Connection _uuidChangedConnection;
+    glm::vec3 _regionCenter { 0.0f };
+    float _regionRadius { 0.0f };
+};
+
+#endif // hifi_EntityPhysicsSimulator_h
@@ -0,0 +1,63 @@
+//
+//  EntityPhysicsStateRelay.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsStateRelay.h"
+
+#include <algorithm>
+
+#include <QtCore/QHash>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// a viewer that falls further behind misses the older states, the newer ones and the full edits take over
+const quint64 MAX_PHYSICS_STATE_AGE = USECS_PER_SECOND;
+
+void EntityPhysicsStateRelay::add(const std::vector<EntityPhysicsState>& states, const QUuid& senderID) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_mutex);
+    while (!_entries.empty() && now - _entries.front().receivedAt > MAX_PHYSICS_STATE_AGE) {
+        _entries.pop_front();
+    }
+    for (const auto& state : states) {
+        _entries.push_back({ ++_lastIndex, now, senderID, state });
+    }
+}
+
+bool EntityPhysicsStateRelay::hasStatesAfter(uint64_t index) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _lastIndex > index;
+}
+
+uint64_t EntityPhysicsStateRelay::getStatesAfter(uint64_t index, const QUuid& viewerID,
+                                                 std::vector<EntityPhysicsState>& states) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_entries.empty() || _lastIndex <= index) {
+        return _lastIndex;
+    }
+
+    // the entries are in index order, the first to relay is at most that many entries from the back
+    size_t numAfter = (size_t)std::min<uint64_t>(_lastIndex - index, _entries.size());
+    QHash<EntityItemID, size_t> stateIndices;
+    for (auto itr = _entries.end() - numAfter; itr != _entries.end(); ++itr) {
+        if (itr->senderID == viewerID) {
+            continue;
+        }
+        auto stateIndex = stateIndices.find(itr->state.entityID);
+        if (stateIndex == stateIndices.end()) {
+            stateIndices.insert(itr->state.entityID, states.size());
+            states.push_back(itr->state);
+        } else {
+            states[stateIndex.value()] = itr->state;
+        }
+    }
+    return _lastIndex;
+}
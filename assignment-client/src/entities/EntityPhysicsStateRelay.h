@@ -0,0 +1,48 @@
+//
+//  EntityPhysicsStateRelay.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsStateRelay_h
+#define hifi_EntityPhysicsStateRelay_h
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include <EntityPhysicsState.h>
+
+// The physics states the entity-server applied in the last second, numbered in the order they came in, for the send
+// threads to relay to each viewer the ones after the last it was sent.
+class EntityPhysicsStateRelay {
+public:
+    void add(const std::vector<EntityPhysicsState>& states, const QUuid& senderID);
+
+    bool hasStatesAfter(uint64_t index) const;
+
+    // appends the latest state of each entity after index, except those from the viewer itself
+    // \return the index of the last state
+    uint64_t getStatesAfter(uint64_t index, const QUuid& viewerID, std::vector<EntityPhysicsState>& states) const;
+
+private:
+    struct Entry {
+        uint64_t index;
+        quint64 receivedAt;
+        QUuid senderID;
+        EntityPhysicsState state;
+    };
+
+    mutable std::mutex _mutex;
+    std::deque<Entry> _entries;
+    uint64_t _lastIndex { 0 };
+};
+
+#endif // hifi_EntityPhysicsStateRelay_h
@@ -11,6 +11,8 @@
 
 #include "EntityServer.h"
 
+#include <algorithm>
+
 #include <QtCore/QEventLoop>
 #include <QTimer>
 #include <QJsonArray>
@@ -60,6 +62,8 @@ EntityServer::EntityServer(ReceivedMessage& message) :
         PacketType::ChallengeOwnershipRequest,
         PacketType::ChallengeOwnershipReply },
         PacketReceiver::makeSourcedListenerReference<EntityServer>(this, &EntityServer::handleEntityPacket));
+    packetReceiver.registerListener(PacketType::EntityPhysicsState,
+        PacketReceiver::makeSourcedListenerReference<EntityServer>(this, &EntityServer::handleEntityPhysicsStatePacket));
 
     connect(&_dynamicDomainVerificationTimer, &QTimer::timeout, this, &EntityServer::startDynamicDomainVerification);
     _dynamicDomainVerificationTimer.setSingleShot(true);
@@ -80,6 +84,8 @@ void EntityServer::aboutToFinish() {
 
     DependencyManager::destroy<AssignmentDynamicFactory>();
 
+    _changeFeed.reset();
+
     OctreeServer::aboutToFinish();
 }
 
@@ -89,6 +95,51 @@ void EntityServer::handleEntityPacket(QSharedPointer<ReceivedMessage> message, S
     }
 }
 
+void EntityServer::handleEntityPhysicsStatePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    if (!tree || !senderNode) {
+        return;
+    }
+    const QUuid& senderID = senderNode->getUUID();
+
+    // resolve the states relative to a keyframe, and ack the keyframes
+    std::vector<EntityPhysicsState> states;
+    auto ackPacket = NLPacket::create(PacketType::EntityPhysicsStateAck);
+    EntityPhysicsState state;
+    while (state.read(*message)) {
+        auto& keyframes = _physicsStateKeyframes[state.entityID];
+        auto& keyframe = keyframes[state.sequence % NUM_PHYSICS_STATE_KEYFRAMES];
+        if (state.isKeyframe()) {
+            keyframe = { senderID, state.position, state.sequence };
+            if (ackPacket->bytesAvailableForWrite() < NUM_BYTES_RFC4122_UUID + (qint64)sizeof(uint8_t)) {
+                DependencyManager::get<NodeList>()->sendUnreliablePacket(*ackPacket, *senderNode);
+                ackPacket = NLPacket::create(PacketType::EntityPhysicsStateAck);
+            }
+            ackPacket->write(state.entityID.toRfc4122());
+            ackPacket->writePrimitive(state.sequence);
+        } else if (keyframe.senderID == senderID && keyframe.sequence == state.sequence) {
+            state.position += keyframe.position;
+            state.flags |= EntityPhysicsState::KEYFRAME;
+        } else {
+            // the keyframe was overwritten, the sender moves on to a new one with its next full edit
+            continue;
+        }
+        states.push_back(state);
+    }
+    if (ackPacket->getPayloadSize() > 0) {
+        DependencyManager::get<NodeList>()->sendUnreliablePacket(*ackPacket, *senderNode);
+    }
+
+    tree->applyPhysicsStates(states, senderID, usecTimestampNow());
+    for (const auto& appliedState : states) {
+        EntityItemPointer entity = tree->findEntityByEntityItemID(appliedState.entityID);
+        if (entity) {
+            _encodeCache.invalidate(entity.get());
+        }
+    }
+    _physicsStateRelay.add(states, senderID);
+}
+
 std::unique_ptr<OctreeQueryNode> EntityServer::createOctreeQueryNode() {
     return std::unique_ptr<OctreeQueryNode> { new EntityNodeData() };
 }
@@ -97,9 +148,18 @@ OctreePointer EntityServer::createTree() {
     EntityTreePointer tree = std::make_shared<EntityTree>(true);
     tree->createRootElement();
     tree->addNewlyCreatedHook(this);
+
+    // drop cached encodings as soon as an entity changes or is deleted, these fire on the thread doing the edit
+    connect(tree.get(), &EntityTree::editingEntityPointer, this, [this](const EntityItemPointer& entity) {
+        _encodeCache.invalidate(entity.get());
+    }, Qt::DirectConnection);
+    connect(tree.get(), &EntityTree::deletingEntityPointer, this, [this](EntityItem* entity) {
+        _encodeCache.invalidate(entity);
+    }, Qt::DirectConnection);
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
         simpleSimulation->setEntityTree(tree);
+        simpleSimulation->setParallelKinematicsEnabled(true);
         tree->setSimulation(simpleSimulation);
         _entitySimulation = simpleSimulation;
     }
@@ -128,7 +188,7 @@ void EntityServer::beforeRun() {
 void EntityServer::entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
 }
 
-// EntityServer will use the "special packets" to send list of recently deleted entities
+// EntityServer will use the "special packets" to send list of recently deleted entities, and to relay the physics states
 bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
     bool shouldSendDeletedEntities = false;
 
@@ -145,6 +205,10 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
                 qDebug() << "shouldSendDeletedEntities to node:" << node->getUUID() << "deletedEntitiesSentAt:" << deletedEntitiesSentAt << "elapsed:" << elapsed;
             }
         #endif
+
+        if (_physicsStateRelay.hasStatesAfter(nodeData->getLastPhysicsStateSent())) {
+            return true;
+        }
     }
 
     return shouldSendDeletedEntities;
@@ -156,6 +220,23 @@ bool EntityServer::hasSpecialPacketsToSend(const SharedNodePointer& node) {
 // for now this works and addresses the bug.
 int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) {
     int totalBytes = 0;
+    packetsSent = 0;
+
+    EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+    if (nodeData) {
+        EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+        if (tree->hasEntitiesDeletedSince(nodeData->getLastDeletedEntitiesSentAt())) {
+            totalBytes += sendDeletedEntities(node, queryNode, packetsSent);
+        }
+        totalBytes += sendPhysicsStates(node, packetsSent);
+    }
+
+    // TODO: caller is expecting a packetLength, what if we send more than one packet??
+    return totalBytes;
+}
+
+int EntityServer::sendDeletedEntities(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) {
+    int totalBytes = 0;
 
     EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
     if (nodeData) {
@@ -167,8 +248,6 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
         auto recentlyDeleted = tree->getRecentlyDeletedEntityIDs();
 
-        packetsSent = 0;
-
         // create a new special packet
         std::unique_ptr<NLPacket> deletesPacket = NLPacket::create(PacketType::EntityErase);
 
@@ -284,7 +363,52 @@ int EntityServer::sendSpecialPackets(const SharedNodePointer& node, OctreeQueryN
         }
     #endif
 
-    // TODO: caller is expecting a packetLength, what if we send more than one packet??
+    return totalBytes;
+}
+
+int EntityServer::sendPhysicsStates(const SharedNodePointer& node, int& packetsSent) {
+    EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+    std::vector<EntityPhysicsState> states;
+    nodeData->setLastPhysicsStateSent(_physicsStateRelay.getStatesAfter(nodeData->getLastPhysicsStateSent(), node->getUUID(), states));
+    // the mixers only follow the zones
+    if (states.empty() || (node->getType() != NodeType::Agent && node->getType() != NodeType::EntityScriptServer)) {
+        return 0;
+    }
+
+    {
+        // only to the viewers that were sent the entity, the others get its current state in full when they get to it
+        QReadLocker locker(&_viewerSendingStatsLock);
+        auto viewerStats = _viewerSendingStats.constFind(node->getUUID());
+        if (viewerStats == _viewerSendingStats.constEnd()) {
+            return 0;
+        }
+        states.erase(std::remove_if(states.begin(), states.end(), [&](const EntityPhysicsState& state) {
+            return !viewerStats->contains(state.entityID);
+        }), states.end());
+    }
+
+    int totalBytes = 0;
+    std::unique_ptr<NLPacket> statesPacket;
+    auto sendStatesPacket = [&] {
+        totalBytes += statesPacket->getDataSize();
+        packetsSent++;
+        DependencyManager::get<NodeList>()->sendPacket(std::move(statesPacket), *node);
+    };
+    for (const auto& state : states) {
+        if (statesPacket && state.getEncodedSize() > statesPacket->bytesAvailableForWrite()) {
+            sendStatesPacket();
+        }
+        if (!statesPacket) {
+            // the timestamp orders the states against the full updates of the same entities
+            statesPacket = NLPacket::create(PacketType::EntityPhysicsState);
+            OCTREE_PACKET_SENT_TIME now = usecTimestampNow();
+            statesPacket->writePrimitive(now);
+        }
+        state.write(*statesPacket);
+    }
+    if (statesPacket) {
+        sendStatesPacket();
+    }
     return totalBytes;
 }
 
@@ -304,6 +428,14 @@ void EntityServer::pruneDeletedEntities() {
         });
         tree->forgetEntitiesDeletedBefore(earliestLastDeletedEntitiesSent);
     }
+
+    for (auto itr = _physicsStateKeyframes.begin(); itr != _physicsStateKeyframes.end();) {
+        if (tree->findEntityByEntityItemID(itr.key())) {
+            ++itr;
+        } else {
+            itr = _physicsStateKeyframes.erase(itr);
+        }
+    }
 }
 
 void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectionObject) {
@@ -345,7 +477,43 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     } else {
         tree->setEntityScriptSourceWhitelist("");
     }
+
+    // "x,y,z,scale" of the cube this server takes new entities in, for a domain split between entity servers
+    QString ownedRegion;
+    tree->clearOwnedRegion();
+    if (readOptionString("ownedRegion", settingsSectionObject, ownedRegion) && !ownedRegion.isEmpty()) {
+        auto components = ownedRegion.split(',');
+        bool isValid = components.size() == 4;
+        float values[4];
+        for (int i = 0; isValid && i < 4; ++i) {
+            values[i] = components[i].trimmed().toFloat(&isValid);
+        }
+        if (isValid && values[3] > 0.0f) {
+            AACube region(glm::vec3(values[0], values[1], values[2]), values[3]);
+            tree->setOwnedRegion(region);
+            qDebug() << "Entity server owns region" << region;
+        } else {
+            qWarning() << "Ignoring invalid ownedRegion" << ownedRegion << "- expected x,y,z,scale";
+        }
+    }
     
+    // the WebSocket port external tools follow the entities' changes on, off by default; only on the local host unless
+    // another address is given
+    int changeFeedPort = 0;
+    if (readOptionInt("changeFeedPort", settingsSectionObject, changeFeedPort) && changeFeedPort > 0) {
+        QString changeFeedAddress = "127.0.0.1";
+        readOptionString("changeFeedAddress", settingsSectionObject, changeFeedAddress);
+        QString changeFeedToken;
+        readOptionString("changeFeedToken", settingsSectionObject, changeFeedToken);
+
+        if (!_changeFeed) {
+            _changeFeed = std::make_unique<EntityChangeFeed>(tree);
+        }
+        _changeFeed->listen(QHostAddress(changeFeedAddress), (quint16)changeFeedPort, changeFeedToken);
+    } else if (_changeFeed) {
+        _changeFeed->close();
+    }
+
     auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
     
     QString filterURL;
@@ -416,6 +584,36 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    auto encodeCacheStats = _encodeCache.getStats();
+    statsString += "<b>Entity Server Encode Cache Statistics</b>\r\n";
+    statsString += QString("           Cached entities... %1\r\n").arg(locale.toString((qulonglong)_encodeCache.size()));
+    statsString += QString("                      Hits... %1\r\n").arg(locale.toString((qulonglong)encodeCacheStats.hits));
+    statsString += QString("                    Misses... %1\r\n").arg(locale.toString((qulonglong)encodeCacheStats.misses));
+    statsString += QString("               Uncacheable... %1\r\n").arg(locale.toString((qulonglong)encodeCacheStats.uncacheable));
+    statsString += "\r\n\r\n";
+
+    if (_changeFeed) {
+        statsString += "<b>Entity Server Change Feed Statistics</b>\r\n";
+        statsString += QString("               Subscribers... %1\r\n").arg(locale.toString(_changeFeed->getNumSubscribers()));
+        statsString += QString("               Events sent... %1\r\n").arg(locale.toString((qulonglong)_changeFeed->getNumEventsSent()));
+        statsString += "\r\n\r\n";
+    }
+
+    if (DependencyManager::isSet<EntityEditFilters>()) {
+        auto filterStats = DependencyManager::get<EntityEditFilters>()->getFilterStats();
+        if (!filterStats.isEmpty()) {
+            statsString += "<b>Entity Server Edit Filter Statistics</b>\r\n";
+            for (const auto& stats : filterStats) {
+                statsString += (stats.entityID.isInvalidID() ? QString("domain") : stats.entityID.toString()) + " "
+                    + stats.fileName + "\r\n";
+                statsString += QString("                     Calls... %1\r\n").arg(locale.toString((qulonglong)stats.numCalls));
+                statsString += QString("     Average time per call... %1 usecs\r\n").arg(locale.toString((qulonglong)stats.averageTime));
+                statsString += QString("         Max time per call... %1 usecs\r\n").arg(locale.toString((qulonglong)stats.maxTime));
+            }
+            statsString += "\r\n\r\n";
+        }
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -16,12 +16,16 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <array>
 #include <memory>
 
 #include <EntityItem.h>
 #include <EntityTree.h>
 #include <SimpleEntitySimulation.h>
 
+#include "EntityChangeFeed.h"
+#include "EntityEncodeCache.h"
+#include "EntityPhysicsStateRelay.h"
 #include "EntityServerConsts.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
@@ -47,6 +51,9 @@ public:
     virtual PacketType getMyEditNackType() const override { return PacketType::EntityEditNack; }
     virtual QString getMyDomainSettingsKey() const override { return QString("entity_server_settings"); }
 
+    // shared by all send threads, so an entity edit is encoded once rather than once per viewer
+    EntityEncodeCache& getEncodeCache() { return _encodeCache; }
+
     // subclass may implement these method
     virtual void beforeRun() override;
     virtual bool hasSpecialPacketsToSend(const SharedNodePointer& node) override;
@@ -73,15 +80,31 @@ protected:
 
 private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleEntityPhysicsStatePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestFailed();
 
 private:
+    int sendDeletedEntities(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent);
+    int sendPhysicsStates(const SharedNodePointer& node, int& packetsSent);
+
     SimpleEntitySimulationPointer _entitySimulation;
+    EntityEncodeCache _encodeCache;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
 
     QReadWriteLock _viewerSendingStatsLock;
     QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 
+    // the last keyframes of the physics states of each entity, to resolve the states relative to them
+    static const size_t NUM_PHYSICS_STATE_KEYFRAMES = 8;
+    struct PhysicsStateKeyframe {
+        QUuid senderID;
+        glm::vec3 position { 0.0f };
+        uint8_t sequence { 0 };
+    };
+    QHash<EntityItemID, std::array<PhysicsStateKeyframe, NUM_PHYSICS_STATE_KEYFRAMES>> _physicsStateKeyframes;
+    EntityPhysicsStateRelay _physicsStateRelay;
+    std::unique_ptr<EntityChangeFeed> _changeFeed;
+
     static const int DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 45 * 60 * 1000;                    // 45m
     static const int DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = 60 * 60 * 1000;                    // 1h
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
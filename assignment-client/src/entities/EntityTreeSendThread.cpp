@@ -17,6 +17,13 @@
 
 #include "EntityServer.h"
 
+// how much of a second's budget a view can be sent at once, after it has been idle
+const float VIEW_BUDGET_BURST_SECONDS = 0.25f;
+
+// a moving client is also sent what its main view will see this far ahead, behind what it sees now
+const float PREDICTED_VIEW_SECONDS = 1.0f;
+const float PREDICTED_VIEW_WEIGHT = 0.25f;
+
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
@@ -102,16 +109,27 @@ void EntityTreeSendThread::preDistributionProcessing() {
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
     if (viewFrustumChanged || _traversal.finished()) {
-        EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-
+        // other send threads share this snapshot, and edits go ahead while we walk it
+        auto snapshot = std::static_pointer_cast<EntityTree>(_myServer->getOctree())->getTopologySnapshot();
 
         DiffTraversal::View newView;
         newView.viewFrustums = nodeData->getCurrentViews();
+        for (const auto& budget : nodeData->getCurrentViewBudgets()) {
+            newView.viewWeights.push_back(budget.priorityWeight);
+        }
+        glm::vec3 predictedOffset;
+        if (!newView.viewFrustums.empty() && nodeData->getPredictedViewOffset(PREDICTED_VIEW_SECONDS, predictedOffset)) {
+            ConicalViewFrustum predictedView = newView.viewFrustums[0];
+            predictedView.translate(predictedOffset);
+            newView.viewFrustums.push_back(predictedView);
+            newView.viewWeights.resize(newView.viewFrustums.size() - 1, 1.0f);
+            newView.viewWeights.push_back(PREDICTED_VIEW_WEIGHT);
+        }
 
         int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
         newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
         
-        startNewTraversal(newView, root, isFullScene);
+        startNewTraversal(newView, snapshot, isFullScene);
 
         // When the viewFrustum changed the sort order may be incorrect, so we re-sort
         // and also use the opportunity to cull anything no longer in view
@@ -127,22 +145,25 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
                 prevSendQueue.pop();
                 if (entity) {
                     float priority = PrioritizedEntity::DO_NOT_SEND;
+                    int viewIndex = -1;
 
                     if (forceRemove) {
                         priority = PrioritizedEntity::FORCE_REMOVE;
                     } else {
                         const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
+                        priority = view.computePriority(entity, &viewIndex);
                     }
 
                     if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
+                        _sendQueue.emplace(entity, priority, forceRemove, viewIndex);
                     }
                 }
             }
         }
     }
 
+    refillViewBudgets(nodeData->getCurrentViewBudgets());
+
     if (!_traversal.finished()) {
         quint64 startTime = usecTimestampNow();
 
@@ -225,10 +246,10 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
     return hasNewChild || hasNewDescendants;
 }
 
-void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot,
                                              bool forceFirstPass) {
 
-    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root, forceFirstPass);
+    DiffTraversal::Type type = _traversal.prepareNewTraversal(view, snapshot, forceFirstPass);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -248,10 +269,11 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                         return;
                     }
                     const auto& view = _traversal.getCurrentView();
-                    float priority = view.computePriority(entity);
+                    int viewIndex = -1;
+                    float priority = view.computePriority(entity, &viewIndex);
 
                     if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
+                        _sendQueue.emplace(entity, priority, false, viewIndex);
                     }
                 });
             });
@@ -266,11 +288,12 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                             return;
                         }
                         float priority = PrioritizedEntity::DO_NOT_SEND;
+                        int viewIndex = -1;
 
                         auto knownTimestamp = _knownState.find(entity.get());
                         if (knownTimestamp == _knownState.end()) {
                             const auto& view = _traversal.getCurrentView();
-                            priority = view.computePriority(entity);
+                            priority = view.computePriority(entity, &viewIndex);
 
                         } else if (entity->getLastEdited() > knownTimestamp->second ||
                                    entity->getLastChangedOnServer() > knownTimestamp->second) {
@@ -280,7 +303,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                         }
 
                         if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                            _sendQueue.emplace(entity, priority);
+                            _sendQueue.emplace(entity, priority, false, viewIndex);
                         }
                     });
                 }
@@ -295,11 +318,12 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                         return;
                     }
                     float priority = PrioritizedEntity::DO_NOT_SEND;
+                    int viewIndex = -1;
 
                     auto knownTimestamp = _knownState.find(entity.get());
                     if (knownTimestamp == _knownState.end()) {
                         const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
+                        priority = view.computePriority(entity, &viewIndex);
 
                     } else if (entity->getLastEdited() > knownTimestamp->second ||
                                entity->getLastChangedOnServer() > knownTimestamp->second) {
@@ -309,7 +333,7 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
                     }
 
                     if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
+                        _sendQueue.emplace(entity, priority, false, viewIndex);
                     }
                 });
             });
@@ -338,9 +362,13 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _packetData.appendValue(zeroByte); // colors
         if (params.includeExistsBits) {
             uint8_t childrenExistBits = 0;
-            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+            auto snapshot = _traversal.getSnapshot();
+            if (!snapshot) {
+                snapshot = std::static_pointer_cast<EntityTree>(_myServer->getOctree())->getTopologySnapshot();
+            }
+            const EntityTreeSnapshot::Element* root = snapshot->getRoot();
             for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
-                if (root->getChildAtIndex(i)) {
+                if (root && root->getChildAtIndex(i)) {
                     childrenExistBits += (1 << i);
                 }
             }
@@ -362,9 +390,17 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     nodeData->stats.encodeStarted();
     auto entityNode = _node.toStrongRef();
     auto entityNodeData = static_cast<EntityNodeData*>(entityNode->getLinkedData());
+    auto& encodeCache = static_cast<EntityServer*>(_myServer)->getEncodeCache();
     while(!_sendQueue.empty()) {
         PrioritizedEntity queuedItem = _sendQueue.top();
         EntityItemPointer entity = queuedItem.getEntity();
+        int viewIndex = queuedItem.getViewIndex();
+        if (entity && !queuedItem.shouldForceRemove() && isViewOverBudget(viewIndex)) {
+            // the view has been sent its share for now, so the other views' entities go ahead of it
+            _deferredEntities.push_back(queuedItem);
+            _sendQueue.pop();
+            continue;
+        }
         if (entity) {
             const QUuid& entityID = entity->getID();
             // Only send entities that match the jsonFilters, but keep track of everything we've tried to send so we don't try to send it again;
@@ -377,7 +413,20 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                // whole entities come from the encode cache shared with the other viewers' send threads,
+                // continuations of an entity that only partially fit in the previous packet are encoded directly
+                OctreeElement::AppendState appendEntityState = OctreeElement::NONE;
+                bool canGetAndSetPrivateUserData = entityNode->getCanGetAndSetPrivateUserData();
+                int bytesBefore = _packetData.getUncompressedByteOffset();
+                if (!_extraEncodeData->entities.contains(entity->getEntityItemID())
+                    && encodeCache.appendEntityData(entity, &_packetData, params, canGetAndSetPrivateUserData)) {
+                    appendEntityState = OctreeElement::COMPLETED;
+                } else {
+                    appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, canGetAndSetPrivateUserData);
+                }
+                if (viewIndex >= 0 && viewIndex < (int)_viewBytesAvailable.size() && _viewBytesPerSecond[viewIndex] > 0) {
+                    _viewBytesAvailable[viewIndex] -= (float)(_packetData.getUncompressedByteOffset() - bytesBefore);
+                }
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -401,6 +450,13 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _sendQueue.pop();
     }
     nodeData->stats.encodeStopped();
+    for (const auto& deferred : _deferredEntities) {
+        EntityItemPointer entity = deferred.getEntity();
+        if (entity && !_sendQueue.contains(entity.get())) {
+            _sendQueue.emplace(entity, deferred.getPriority(), deferred.shouldForceRemove(), deferred.getViewIndex());
+        }
+    }
+    _deferredEntities.clear();
     if (_sendQueue.empty()) {
         assert(_sendQueue.empty());
         params.stopReason = EncodeBitstreamParams::FINISHED;
@@ -418,6 +474,31 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
     return true;
 }
 
+void EntityTreeSendThread::refillViewBudgets(const OctreeQueryViewBudgets& budgets) {
+    uint64_t now = usecTimestampNow();
+    float elapsed = _lastViewBudgetRefill > 0 ? (float)(now - _lastViewBudgetRefill) / (float)USECS_PER_SECOND : 0.0f;
+    _lastViewBudgetRefill = now;
+
+    _viewBytesPerSecond.resize(budgets.size(), 0);
+    _viewBytesAvailable.resize(budgets.size(), 0.0f);
+    for (size_t i = 0; i < budgets.size(); ++i) {
+        uint32_t rate = budgets[i].maxBytesPerSecond;
+        float burst = VIEW_BUDGET_BURST_SECONDS * (float)rate;
+        if (rate != _viewBytesPerSecond[i]) {
+            // a new budget starts with a full burst
+            _viewBytesPerSecond[i] = rate;
+            _viewBytesAvailable[i] = burst;
+        } else {
+            _viewBytesAvailable[i] = std::min(_viewBytesAvailable[i] + elapsed * (float)rate, burst);
+        }
+    }
+}
+
+bool EntityTreeSendThread::isViewOverBudget(int viewIndex) const {
+    return viewIndex >= 0 && viewIndex < (int)_viewBytesPerSecond.size() &&
+        _viewBytesPerSecond[viewIndex] > 0 && _viewBytesAvailable[viewIndex] <= 0.0f;
+}
+
 void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity) {
     if (entity) {
         if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
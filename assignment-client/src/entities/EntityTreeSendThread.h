@@ -33,6 +33,7 @@ public:
 protected:
     bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) override;
+    bool traversalRequiresTreeLock() const override { return false; }
 
 private slots:
     void resetState(); // clears our known state forcing entities to appear unsent
@@ -42,7 +43,9 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
-    void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
+    void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeSnapshotPointer snapshot, bool forceFirstPass = false);
+    void refillViewBudgets(const OctreeQueryViewBudgets& budgets);
+    bool isViewOverBudget(int viewIndex) const;
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
@@ -53,6 +56,12 @@ private:
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
 
+    // the bytes each view with a budget of its own may still be sent, refilled at its rate up to a short burst
+    std::vector<uint32_t> _viewBytesPerSecond;
+    std::vector<float> _viewBytesAvailable;
+    uint64_t _lastViewBudgetRefill { 0 };
+    std::vector<PrioritizedEntity> _deferredEntities; // skipped while their view was over budget
+
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
     int32_t _numEntitiesOffset { 0 };
@@ -15,7 +15,7 @@
 #include <QtCore/QJsonObject>
 #include <QBuffer>
 #include <LogHandler.h>
-#include <MessagesClient.h>
+#include <NLPacketList.h>
 #include <NodeList.h>
 #include <udt/PacketHeaders.h>
 
@@ -35,20 +35,18 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    for (auto& channel : _channels) {
+        channel.subscribers.remove(killedNode->getUUID());
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
     auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
 
-    auto nodeList = DependencyManager::get<NodeList>();
+    // only the channel is needed, the rest of the message is passed on as it came
+    quint16 channelLength;
+    receivedMessage->readPrimitive(&channelLength);
+    QString channelName = QString::fromUtf8(receivedMessage->read(channelLength));
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
@@ -59,30 +57,42 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    Channel& channel = _channels[channelName];
+    QByteArray payload = receivedMessage->getMessage();
+    ++channel.messagesIn;
+    channel.bytesIn += payload.size();
+    if (_maxChannelMessagesPerSecond > 0 && channel.messagesThisSecond >= _maxChannelMessagesPerSecond) {
+        ++channel.messagesDropped;
+        return;
+    }
+    ++channel.messagesThisSecond;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (const auto& node : channel.subscribers) {
+        if (node->getActiveSocket()) {
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+            ++channel.messagesOut;
+            channel.bytesOut += payload.size();
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    _channelSubscribers[channel] << senderUUID;
+    _channels[channel].subscribers.insert(senderUUID, senderNode);
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
+    auto itr = _channels.find(channel);
+    if (itr != _channels.end()) {
+        itr->subscribers.remove(senderUUID);
     }
 }
 
@@ -90,15 +100,41 @@ void MessagesMixer::sendStatsPacket() {
     QJsonObject statsObject, messagesMixerObject;
 
     // add stats for each listerner
-    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+    for (const auto& node : *DependencyManager::get<NodeList>()->getNodeSnapshot()) {
         QJsonObject clientStats;
         clientStats[USERNAME_UUID_REPLACEMENT_STATS_KEY] = uuidStringWithoutCurlyBraces(node->getUUID());
         clientStats["outbound_kbps"] = node->getOutboundKbps();
         clientStats["inbound_kbps"] = node->getInboundKbps();
         messagesMixerObject[uuidStringWithoutCurlyBraces(node->getUUID())] = clientStats;
-    });
+    }
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for each channel with traffic or subscribers, and forget the others
+    QJsonObject channelsObject;
+    for (auto itr = _channels.begin(); itr != _channels.end();) {
+        Channel& channel = itr.value();
+        if (channel.subscribers.isEmpty() && channel.messagesIn == 0) {
+            itr = _channels.erase(itr);
+            continue;
+        }
+        QJsonObject channelStats;
+        channelStats["subscribers"] = channel.subscribers.size();
+        channelStats["messages_in"] = (double)channel.messagesIn;
+        channelStats["bytes_in"] = (double)channel.bytesIn;
+        channelStats["messages_out"] = (double)channel.messagesOut;
+        channelStats["bytes_out"] = (double)channel.bytesOut;
+        channelStats["messages_dropped"] = (double)channel.messagesDropped;
+        channelsObject[itr.key()] = channelStats;
+
+        channel.messagesIn = 0;
+        channel.bytesIn = 0;
+        channel.messagesOut = 0;
+        channel.bytesOut = 0;
+        channel.messagesDropped = 0;
+        ++itr;
+    }
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -127,10 +163,17 @@ void MessagesMixer::parseDomainServerSettings(const QJsonObject& domainSettings)
     const QString NODE_MESSAGES_PER_SECOND_KEY = "max_node_messages_per_second";
     QJsonValue maxMessagesPerSecondValue = messagesMixerGroupObject.value(NODE_MESSAGES_PER_SECOND_KEY);
     _maxMessagesPerSecond = maxMessagesPerSecondValue.toInt(DEFAULT_NODE_MESSAGES_PER_SECOND);
+
+    const QString CHANNEL_MESSAGES_PER_SECOND_KEY = "max_channel_messages_per_second";
+    QJsonValue maxChannelMessagesPerSecondValue = messagesMixerGroupObject.value(CHANNEL_MESSAGES_PER_SECOND_KEY);
+    _maxChannelMessagesPerSecond = maxChannelMessagesPerSecondValue.toInt(DEFAULT_CHANNEL_MESSAGES_PER_SECOND);
 }
 
 void MessagesMixer::processMaxMessagesContainer() {
     _allSubscribers.clear();
+    for (auto& channel : _channels) {
+        channel.messagesThisSecond = 0;
+    }
 }
 
 void MessagesMixer::startMaxMessagesProcessor() {
@@ -42,11 +42,25 @@ private slots:
     void processMaxMessagesContainer();
 
 private:
-    QHash<QString, QSet<QUuid>> _channelSubscribers;
+    struct Channel {
+        // the subscribers are held by node so that a message goes straight to them rather than through every node
+        QHash<QUuid, SharedNodePointer> subscribers;
+        int messagesThisSecond { 0 };
+
+        // since the last stats packet
+        quint64 messagesIn { 0 };
+        quint64 bytesIn { 0 };
+        quint64 messagesOut { 0 };
+        quint64 bytesOut { 0 };
+        quint64 messagesDropped { 0 };
+    };
+    QHash<QString, Channel> _channels;
     QHash<QUuid, int> _allSubscribers;
 
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
+    const int DEFAULT_CHANNEL_MESSAGES_PER_SECOND = 0; // unlimited
+    int _maxChannelMessagesPerSecond { 0 };
 
     QTimer* _maxMessagesTimer { nullptr };
 };
@@ -154,52 +154,53 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
         }
         
         const unsigned char* editData = nullptr;
-        
-        while (message->getBytesLeftToRead() > 0) {
 
-            editData = reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
+        // the work that only reads the tree, like running the edit filters, doesn't hold up its other readers
+        _myServer->getOctree()->prefilterEditPacket(*message, sendingNode);
 
-            int maxSize = message->getBytesLeftToRead();
+        // apply all the edits in the packet under one write lock, rather than locking the tree for each of them
+        quint64 startLock = usecTimestampNow();
+        _myServer->getOctree()->withWriteLock([&] {
+            quint64 startProcess = usecTimestampNow();
+            lockWaitTime = startProcess - startLock;
 
-            if (debugProcessPacket) {
-                qDebug() << " --- inside while loop ---";
-                qDebug() << "    maxSize=" << maxSize;
-                qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
-                       "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
-                       (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData,
-                        message->getPosition(), maxSize);
-            }
+            while (message->getBytesLeftToRead() > 0) {
+
+                editData = reinterpret_cast<const unsigned char*>(message->getRawMessage() + message->getPosition());
+
+                int maxSize = message->getBytesLeftToRead();
+
+                if (debugProcessPacket) {
+                    qDebug() << " --- inside while loop ---";
+                    qDebug() << "    maxSize=" << maxSize;
+                    qDebug("OctreeInboundPacketProcessor::processPacket() %hhu "
+                           "payload=%p payloadLength=%lld editData=%p payloadPosition=%lld maxSize=%d",
+                           (unsigned char)packetType, message->getRawMessage(), message->getSize(), editData,
+                            message->getPosition(), maxSize);
+                }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
+                int editDataBytesRead =
                     _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
-            quint64 endProcess = usecTimestampNow();
 
-            if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
-                    << "editDataBytesRead=" << editDataBytesRead;
-            }
+                if (debugProcessPacket) {
+                    qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
+                        << "editDataBytesRead=" << editDataBytesRead;
+                }
 
-            editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
+                editsInPacket++;
 
-            // skip to next edit record in the packet
-            message->seek(message->getPosition() + editDataBytesRead);
+                // skip to next edit record in the packet
+                message->seek(message->getPosition() + editDataBytesRead);
 
-            if (debugProcessPacket) {
-                qDebug() << "    editDataBytesRead=" << editDataBytesRead;
-                qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
-                qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
-            }
+                if (debugProcessPacket) {
+                    qDebug() << "    editDataBytesRead=" << editDataBytesRead;
+                    qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
+                    qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
+                }
 
-        }
+            }
+            processTime = usecTimestampNow() - startProcess;
+        });
 
         if (debugProcessPacket) {
             qDebug("OctreeInboundPacketProcessor::processPacket() DONE LOOPING FOR %hhu "
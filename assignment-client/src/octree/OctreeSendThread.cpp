@@ -363,9 +363,13 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
+    if (traversalRequiresTreeLock()) {
+        _myServer->getOctree()->withReadLock([&]{
+            traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
+        });
+    } else {
         traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-    });
+    }
 
     // Here's where we can/should allow the server to send other data...
     // send the environment packet
@@ -56,6 +56,9 @@ protected:
             bool viewFrustumChanged, bool isFullScene);
     virtual bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) = 0;
 
+    // subclasses that traverse a snapshot of the tree rather than the tree itself can send without the tree's read lock
+    virtual bool traversalRequiresTreeLock() const { return true; }
+
     OctreePacketData _packetData;
     QWeakPointer<Node> _node;
     OctreeServer* _myServer { nullptr };
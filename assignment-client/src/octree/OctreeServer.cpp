@@ -369,6 +369,9 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             statsString += QString("%1 File Load Took ").arg(getMyServerName());
             statsString += getFileLoadTime();
             statsString += "\r\n";
+            for (const auto& phase : getLoadPhases()) {
+                statsString += QString("    %1: %2 msecs\r\n").arg(phase.first).arg((double)phase.second / USECS_PER_MSEC);
+            }
 
             if (_persistFileDownload) {
                 statsString += QString("Persist file: <a href='%1'>Click to Download</a>\r\n").arg(PERSIST_FILE_DOWNLOAD_PATH);
@@ -378,6 +381,9 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
         } else {
             statsString += "Octree file not yet loaded...\r\n";
+            for (const auto& phase : getLoadPhases()) {
+                statsString += QString("    %1: %2 msecs\r\n").arg(phase.first).arg((double)phase.second / USECS_PER_MSEC);
+            }
         }
 
         statsString += "\r\n\r\n";
@@ -1049,7 +1055,8 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
-        _persistAsFileType = "json.gz";
+        // the entities are persisted in the binary format, JSON is still read and is used for the DS copy and downloads
+        _persistAsFileType = "bin";
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1144,7 +1151,12 @@ void OctreeServer::domainSettingsRequestComplete() {
             _persistAbsoluteFilePath.replace(ENTITY_PERSIST_EXTENSION, ENTITY_PERSIST_EXTENSION, Qt::CaseInsensitive);
         }
 
-        if (!QFile::exists(_persistAbsoluteFilePath)) {
+        // the persist thread saves alongside this path in the format it persists as
+        QString persistAsFilePath = _persistAbsoluteFilePath;
+        persistAsFilePath.replace(persistAsFilePath.length() - ENTITY_PERSIST_EXTENSION.length(),
+                                  ENTITY_PERSIST_EXTENSION.length(), "." + _persistAsFileType);
+
+        if (!QFile::exists(_persistAbsoluteFilePath) && !QFile::exists(persistAsFilePath)) {
             qDebug() << "Persist file does not exist, checking for existence of persist file next to application";
 
             static const QString OLD_DEFAULT_PERSIST_FILENAME = "resources/models.json.gz";
@@ -1439,6 +1451,14 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["uptime_seconds"] = getUptimeSeconds();
     statsArray1["persistFileLoadTime_seconds"] = getFileLoadTimeSeconds();
 
+    // where startup time went, in the order the phases ran
+    QJsonObject loadPhases;
+    int phaseNumber = 0;
+    for (const auto& phase : getLoadPhases()) {
+        loadPhases[QString("%1. %2_seconds").arg(++phaseNumber).arg(phase.first)] = (double)phase.second / USECS_PER_SECOND;
+    }
+    statsArray1["persistFileLoadPhases"] = loadPhases;
+
     // Octree Stats
     QJsonObject octreeStats;
     octreeStats["1. elementCount"] = (double)OctreeElement::getNodeCount();
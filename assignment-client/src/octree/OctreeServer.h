@@ -64,6 +64,7 @@ public:
     bool isInitialLoadComplete() const { return (_persistManager) ? _persistManager->isInitialLoadComplete() : true; }
     bool isPersistEnabled() const { return (_persistManager) ? true : false; }
     quint64 getLoadElapsedTime() const { return (_persistManager) ? _persistManager->getLoadElapsedTime() : 0; }
+    Octree::LoadPhases getLoadPhases() const { return (_persistManager) ? _persistManager->getLoadPhases() : Octree::LoadPhases(); }
     QString getPersistFilename() const { return (_persistManager) ? _persistManager->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistManager) ? _persistManager->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistManager) ? _persistManager->getPersistFileContents() : QByteArray(); }
@@ -13,6 +13,8 @@
 
 #include <mutex>
 
+#include <QtCore/QJsonArray>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
@@ -28,6 +30,7 @@
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
 #include <SoundCacheScriptingInterface.h>
+#include <StreamUtils.h>
 #include <UUID.h>
 #include <WebSocketServerClass.h>
 
@@ -82,7 +85,8 @@ EntityScriptServer::EntityScriptServer(ReceivedMessage& message) : ThreadedAssig
     DebugDraw::getInstance();
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
+    packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase,
+                                              PacketType::EntityPhysicsState },
                                             PacketReceiver::makeSourcedListenerReference<EntityScriptServer>(this, &EntityScriptServer::handleOctreePacket));
     packetReceiver.registerListener(PacketType::SelectedAudioFormat,
         PacketReceiver::makeUnsourcedListenerReference<EntityScriptServer>(this, &EntityScriptServer::handleSelectedAudioFormat));
@@ -130,7 +134,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        if (_entityScriptShards && _entityScriptShards->getEngineForEntity(entityID)->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -159,6 +163,9 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    handlePhysicsSimulationSettings(entityScriptServerSettings);
+    handleScriptEngineShardsSettings(entityScriptServerSettings);
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -174,8 +181,110 @@ void EntityScriptServer::handleSettings() {
                 .arg(_maxEntityPPS).arg(_entityPPSPerScript);
 }
 
+void EntityScriptServer::handlePhysicsSimulationSettings(const QJsonObject& entityScriptServerSettings) {
+    static const QString PHYSICS_SIMULATION_ENABLED_OPTION = "physics_simulation_enabled";
+    static const QString PHYSICS_SIMULATION_CENTER_OPTION = "physics_simulation_center";
+    static const QString PHYSICS_SIMULATION_RADIUS_OPTION = "physics_simulation_radius";
+    static const QString PHYSICS_SIMULATION_MAX_UPDATES_OPTION = "physics_simulation_max_updates_per_second";
+    static const float DEFAULT_PHYSICS_SIMULATION_RADIUS = 100.0f; // meters
+    static const int DEFAULT_PHYSICS_SIMULATION_MAX_UPDATES = 200;
+
+    auto tree = _entityViewer.getTree();
+    if (!tree || _shuttingDown) {
+        return;
+    }
+
+    bool enabled = entityScriptServerSettings[PHYSICS_SIMULATION_ENABLED_OPTION].toBool(false);
+    if (!enabled) {
+        if (_physicsSimulator && _physicsSimulator->isRunning()) {
+            qCDebug(entity_script_server) << "Stopping the entity physics simulation";
+            _physicsSimulator->stop();
+            tree->setSimulation(_entitySimulation);
+            // the entities of the region that have no server scripts are not wanted anymore
+            clear();
+            updateEntityQuery();
+        }
+        return;
+    }
+
+    glm::vec3 center { 0.0f };
+    QStringList centerComponents = entityScriptServerSettings[PHYSICS_SIMULATION_CENTER_OPTION].toString().split(",");
+    if (centerComponents.size() == 3) {
+        center = glm::vec3(centerComponents[0].trimmed().toFloat(), centerComponents[1].trimmed().toFloat(),
+                           centerComponents[2].trimmed().toFloat());
+    }
+    float radius = (float)entityScriptServerSettings[PHYSICS_SIMULATION_RADIUS_OPTION].toDouble(DEFAULT_PHYSICS_SIMULATION_RADIUS);
+    int maxUpdatesPerSecond = entityScriptServerSettings[PHYSICS_SIMULATION_MAX_UPDATES_OPTION].toInt(DEFAULT_PHYSICS_SIMULATION_MAX_UPDATES);
+    if (radius <= 0.0f || maxUpdatesPerSecond <= 0) {
+        qCWarning(entity_script_server) << "Ignoring the entity physics simulation settings, radius:" << radius
+                                        << "max updates per second:" << maxUpdatesPerSecond;
+        return;
+    }
+
+    if (_physicsSimulator && _physicsSimulator->isRunning() && _physicsSimulator->getRegionCenter() == center &&
+        _physicsSimulator->getRegionRadius() == radius) {
+        _physicsSimulator->setMaxUpdatesPerSecond((uint32_t)maxUpdatesPerSecond);
+        return;
+    }
+
+    qCDebug(entity_script_server) << "Starting the entity physics simulation, center:" << center << "radius:" << radius
+                                  << "max updates per second:" << maxUpdatesPerSecond;
+    if (!_physicsSimulator) {
+        _physicsSimulator = std::make_unique<EntityPhysicsSimulator>(tree);
+    }
+    _physicsSimulator->start(center, radius, (uint32_t)maxUpdatesPerSecond);
+
+    // start over so the entities of the region all arrive in the physics simulation
+    clear();
+    updateEntityQuery();
+}
+
+void EntityScriptServer::handleScriptEngineShardsSettings(const QJsonObject& entityScriptServerSettings) {
+    static const QString SCRIPT_ENGINE_SHARDS_OPTION = "script_engine_shards";
+    static const int MAX_SCRIPT_ENGINE_SHARDS = 32;
+
+    int numShards = glm::clamp(entityScriptServerSettings[SCRIPT_ENGINE_SHARDS_OPTION].toInt(1), 1, MAX_SCRIPT_ENGINE_SHARDS);
+    if (numShards == _numScriptEngineShards || _shuttingDown) {
+        return;
+    }
+
+    qCDebug(entity_script_server) << "Running the entity scripts in" << numShards << "script engines";
+    _numScriptEngineShards = numShards;
+
+    // start over so the entity scripts all load in their new shards
+    clear();
+}
+
+void EntityScriptServer::updateEntityQuery() {
+    // setup the JSON filter that asks for entities with a non-default serverScripts property
+    QJsonObject queryJSONParameters;
+    queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
+
+    // and, when simulating physics, for the physical entities of the simulated region
+    if (_physicsSimulator && _physicsSimulator->isRunning()) {
+        const glm::vec3& center = _physicsSimulator->getRegionCenter();
+        QJsonObject physicsRegion;
+        physicsRegion["center"] = QJsonArray({ center.x, center.y, center.z });
+        physicsRegion["radius"] = _physicsSimulator->getRegionRadius();
+        queryJSONParameters[EntityJSONQueryProperties::PHYSICS_REGION_PROPERTY] = physicsRegion;
+    }
+
+    QJsonObject queryFlags;
+
+    queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
+    queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
+
+    queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
+
+    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
+    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
+}
+
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    if (!_entityScriptShards) {
+        return;
+    }
+    int numRunningScripts = _entityScriptShards->getNumRunningEntityScripts();
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -236,7 +345,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entityScriptShards && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -250,7 +359,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entityScriptShards->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -281,32 +390,21 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
 
     _entityViewer.init();
-    
-    // setup the JSON filter that asks for entities with a non-default serverScripts property
-    QJsonObject queryJSONParameters;
-    queryJSONParameters[EntityJSONQueryProperties::SERVER_SCRIPTS_PROPERTY] = EntityQueryFilterSymbol::NonDefault;
-
-    QJsonObject queryFlags;
-
-    queryFlags[EntityJSONQueryProperties::INCLUDE_ANCESTORS_PROPERTY] = true;
-    queryFlags[EntityJSONQueryProperties::INCLUDE_DESCENDANTS_PROPERTY] = true;
-
-    queryJSONParameters[EntityJSONQueryProperties::FLAGS_PROPERTY] = queryFlags;
-    
-    // setup the JSON parameters so that OctreeQuery does not use a frustum and uses our JSON filter
-    _entityViewer.getOctreeQuery().setJSONParameters(queryJSONParameters);
+    updateEntityQuery();
 
     entityScriptingInterface->setEntityTree(_entityViewer.getTree());
 
     auto treePtr = _entityViewer.getTree();
     DependencyManager::set<AssignmentParentFinder>(treePtr);
+    // entity scripts search for entities far more often than the entities change
+    treePtr->setSpatialIndexEnabled(true);
 
     if (!_entitySimulation) {
         SimpleEntitySimulationPointer simpleSimulation { new SimpleEntitySimulation() };
@@ -444,8 +542,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(const QString& engineName) {
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
     auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
@@ -460,60 +557,83 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+
+    // the stats report which entity scripts take the time
+    newEngine->setProfilingEnabled(true);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+    scriptEngines->runScriptInitializers(newEngine);
+    newEngine->runInThread();
+    return newEngine;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+    std::vector<ScriptEnginePointer> engines;
+    for (int i = 0; i < _numScriptEngineShards; ++i) {
+        engines.push_back(createEntitiesScriptEngine(i == 0 ? engineName : QString("%1 shard %2").arg(engineName).arg(i)));
+    }
+
+    // the first engine drives the updates of the entity tree for all of them
+    connect(engines.front().data(), &ScriptEngine::update, this, [this] {
         _entityViewer.queryOctree();
         _entityViewer.getTree()->preUpdate();
         _entityViewer.getTree()->update();
     });
 
-    scriptEngines->runScriptInitializers(newEngine);
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
+    EntityScriptShardsPointer newShards { new EntityScriptShards(engines) };
+    auto newShardsSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newShards);
     // On the entity script server, these are the same
-    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
-    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
-
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
-    }
+    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newShardsSP);
+    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newShardsSP);
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    _entityScriptShards.swap(newShards);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+    // unload and stop the engines, which wind down together
+    if (_entityScriptShards) {
+        for (size_t i = 0; i < _entityScriptShards->getNumShards(); ++i) {
+            const auto& engine = _entityScriptShards->getEngine(i);
+            disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+            // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+            engine->unloadAllEntityScripts();
+            engine->stop();
+        }
+        for (size_t i = 0; i < _entityScriptShards->getNumShards(); ++i) {
+            _entityScriptShards->getEngine(i)->waitTillDoneRunning();
+        }
     }
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entityScriptShards) {
+        for (size_t i = 0; i < _entityScriptShards->getNumShards(); ++i) {
+            // disconnect all slots/signals from the script engine, except essential
+            _entityScriptShards->getEngine(i)->disconnectNonEssentialSignals();
+        }
     }
     _shuttingDown = true;
 
+    if (_physicsSimulator) {
+        _physicsSimulator->stop();
+        _physicsSimulator.reset();
+    }
+
     clear(); // always clear() on shutdown
 
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entityScriptShards.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -531,8 +651,8 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entityScriptShards) {
+        _entityScriptShards->getEngineForEntity(entityID)->unloadEntityScript(entityID, true);
     }
 }
 
@@ -543,25 +663,28 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entityScriptShards) {
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
+        const auto& scriptEngine = _entityScriptShards->getEngineForEntity(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = scriptEngine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                scriptEngine->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                scriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
 }
 
+static const int PROFILE_REPORT_SIZE = 20;
+
 void EntityScriptServer::sendStatsPacket() {
     QJsonObject statsObject;
 
@@ -573,13 +696,30 @@ void EntityScriptServer::sendStatsPacket() {
 
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+    const auto shards = _entityScriptShards;
+    if (shards) {
+        numberRunningScripts = shards->getNumRunningEntityScripts();
+        scriptEngineStats["number_shards"] = (int)shards->getNumShards();
+        // the latencies measured since the last stats
+        scriptEngineStats["shards"] = shards->getStats();
+        scriptEngineStats["profile"] = shards->getProfileReport(PROFILE_REPORT_SIZE);
+        shards->measureLatencies();
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
     statsObject["script_engine_stats"] = scriptEngineStats;
-    
+
+    QJsonObject physicsStats;
+    const bool isSimulatingPhysics = _physicsSimulator && _physicsSimulator->isRunning();
+    physicsStats["running"] = isSimulatingPhysics;
+    if (isSimulatingPhysics) {
+        const auto& activationStats = _physicsSimulator->getActivationStats();
+        physicsStats["number_physics_objects"] = _physicsSimulator->getNumPhysicsObjects();
+        physicsStats["number_active_bodies"] = activationStats.numActiveBodies;
+        physicsStats["number_sleeping_bodies"] = activationStats.numSleepingBodies;
+        physicsStats["number_budgeted_islands"] = activationStats.numBudgetedIslands;
+    }
+    statsObject["physics_stats"] = physicsStats;
+
 
     auto nodeList = DependencyManager::get<NodeList>();
     QJsonObject nodesObject;
@@ -636,6 +776,8 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
         _entityViewer.processDatagram(*message, senderNode);
     } else if (packetType == PacketType::EntityErase) {
         _entityViewer.processEraseMessage(*message, senderNode);
+    } else if (packetType == PacketType::EntityPhysicsState) {
+        _entityViewer.getTree()->processPhysicsStateMessage(*message, senderNode);
     }
 }
 
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityScriptServer_h
 #define hifi_EntityScriptServer_h
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -24,7 +25,9 @@
 #include <ScriptEngine.h>
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
+#include "../entities/EntityPhysicsSimulator.h"
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptShards.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -62,7 +65,12 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void handlePhysicsSimulationSettings(const QJsonObject& entityScriptServerSettings);
+    void handleScriptEngineShardsSettings(const QJsonObject& entityScriptServerSettings);
+    void updateEntityQuery();
+
+    void resetEntitiesScriptEngines();
+    ScriptEnginePointer createEntitiesScriptEngine(const QString& engineName);
     void clear();
     void shutdownScriptEngine();
 
@@ -76,10 +84,12 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    EntityScriptShardsPointer _entityScriptShards;
+    int _numScriptEngineShards { 1 };
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
+    std::unique_ptr<EntityPhysicsSimulator> _physicsSimulator;
 
     int _maxEntityPPS { DEFAULT_MAX_ENTITY_PPS };
     int _entityPPSPerScript { DEFAULT_ENTITY_PPS_PER_SCRIPT };
@@ -0,0 +1,80 @@
+//
+//  EntityScriptShards.cpp
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptShards.h"
+
+#include <SharedUtil.h>
+
+EntityScriptShards::EntityScriptShards(const std::vector<ScriptEnginePointer>& engines) {
+    _shards.reserve(engines.size());
+    for (const auto& engine : engines) {
+        _shards.push_back({ engine, std::make_shared<std::atomic<quint64>>(0) });
+    }
+}
+
+const ScriptEnginePointer& EntityScriptShards::getEngineForEntity(const EntityItemID& entityID) const {
+    return _shards[qHash(entityID) % _shards.size()].engine;
+}
+
+int EntityScriptShards::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& shard : _shards) {
+        numRunningScripts += shard.engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptShards::measureLatencies() {
+    quint64 now = usecTimestampNow();
+    for (const auto& shard : _shards) {
+        auto latency = shard.latency;
+        QMetaObject::invokeMethod(shard.engine.data(), [latency, now] {
+            *latency = usecTimestampNow() - now;
+        }, Qt::QueuedConnection);
+    }
+}
+
+QJsonObject EntityScriptShards::getStats() const {
+    QJsonObject stats;
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        QJsonObject shardStats;
+        shardStats["number_running_scripts"] = _shards[i].engine->getNumRunningEntityScripts();
+        shardStats["latency_usecs"] = (double)*_shards[i].latency;
+        shardStats["number_timers"] = _shards[i].engine->getNumTimers();
+        shardStats["timer_lateness_usecs"] = (double)_shards[i].engine->getAverageTimerLatenessUsecs();
+        shardStats["script_program_hits"] = _shards[i].engine->getNumEntityScriptProgramHits();
+        shardStats["script_program_misses"] = _shards[i].engine->getNumEntityScriptProgramMisses();
+        shardStats["script_parse_usecs_saved"] = (double)_shards[i].engine->getEntityScriptLintUsecsSaved();
+        stats[QString("shard_%1").arg(i)] = shardStats;
+    }
+    return stats;
+}
+
+QJsonArray EntityScriptShards::getProfileReport(int topN) const {
+    QJsonArray entries;
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        for (const auto& value : _shards[i].engine->getProfileReport(topN)) {
+            QJsonObject entry = value.toObject();
+            entry["shard"] = (int)i;
+            entries.push_back(entry);
+        }
+    }
+    return ScriptProfiler::getTopEntries(entries, topN);
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params, const QUuid& remoteCallerID) {
+    getEngineForEntity(entityID)->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+}
+
+QFuture<QVariant> EntityScriptShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    return getEngineForEntity(entityID)->getLocalEntityScriptDetails(entityID);
+}
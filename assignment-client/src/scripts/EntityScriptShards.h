@@ -0,0 +1,61 @@
+//
+//  EntityScriptShards.h
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptShards_h
+#define hifi_EntityScriptShards_h
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// The ScriptEngines that run the server entity scripts, each on its own thread, with the script of an entity in the
+// shard its ID hashes to. Entities.callEntityMethod reaches the shard of the entity through this provider, so the
+// scripts call each other across the shards as they did in one engine; only their global variables are not shared.
+//
+// The shards don't change once made, a new set replaces them when the entity scripts are reset.
+class EntityScriptShards : public EntitiesScriptEngineProvider {
+public:
+    EntityScriptShards(const std::vector<ScriptEnginePointer>& engines);
+
+    size_t getNumShards() const { return _shards.size(); }
+    const ScriptEnginePointer& getEngine(size_t index) const { return _shards[index].engine; }
+    const ScriptEnginePointer& getEngineForEntity(const EntityItemID& entityID) const;
+
+    int getNumRunningEntityScripts() const;
+
+    // times how long each shard takes to get to a queued call, which a slow script holds up
+    void measureLatencies();
+    QJsonObject getStats() const;
+    // the entity script calls that took the most time, over all the shards
+    QJsonArray getProfileReport(int topN) const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    struct Shard {
+        ScriptEnginePointer engine;
+        std::shared_ptr<std::atomic<quint64>> latency;
+    };
+
+    std::vector<Shard> _shards;
+};
+
+using EntityScriptShardsPointer = QSharedPointer<EntityScriptShards>;
+
+#endif // hifi_EntityScriptShards_h
@@ -13,6 +13,7 @@
 
 #include <QJsonDocument>
 #include <QDate>
+#include <QtCore/QBuffer>
 #include <QtCore/QLoggingCategory>
 
 #if !defined(__clang__) && defined(__GNUC__)
@@ -39,6 +40,9 @@ static const QString ASSETS_DIR { "/assets/" };
 static const QString MAPPINGS_FILE { "mappings.json" };
 static const QString ZIP_ASSETS_FOLDER { "files" };
 static const chrono::minutes MAX_REFRESH_TIME { 5 };
+// assets are copied in and out of the backups this much at a time rather than read whole, which for a large asset would
+// take as much memory as the asset
+static const qint64 COPY_CHUNK_SIZE { 1024 * 1024 };
 
 Q_DECLARE_LOGGING_CATEGORY(asset_backup)
 Q_LOGGING_CATEGORY(asset_backup, "hifi.asset-backup");
@@ -318,6 +322,11 @@ std::pair<bool, QString> AssetsBackupHandler::recoverBackup(const QString& backu
         auto assetNames = zipDir.entryList(QDir::Files);
         for (const auto& asset : assetNames) {
             if (AssetUtils::isValidHash(asset)) {
+                // the assets are stored by hash, so one already on disk is the same and needn't be unzipped again
+                if (_assetsOnDisk.find(asset) != end(_assetsOnDisk)) {
+                    continue;
+                }
+
                 if (!zip.setCurrentFile(zipDir.filePath(asset))) {
                     qCCritical(asset_backup) << "Failed to find" << asset << "while recovering backup";
                     qCCritical(asset_backup) << "    Error:" << zip.getZipError();
@@ -331,7 +340,7 @@ std::pair<bool, QString> AssetsBackupHandler::recoverBackup(const QString& backu
                     continue;
                 }
 
-                writeAssetFile(asset, zipFile.readAll());
+                writeAssetFile(asset, zipFile);
             }
         }
 
@@ -409,8 +418,12 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
             continue;
         }
-        zipFile.write(file.readAll());
+        bool success = copyInChunks(file, zipFile);
         zipFile.close();
+        if (!success) {
+            qCCritical(asset_backup) << "Could not write asset" << hash << "to zip file";
+            continue;
+        }
         if (zipFile.getZipError() != UNZ_OK) {
             qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
             continue;
@@ -500,7 +513,25 @@ void AssetsBackupHandler::downloadNextMissingFile() {
     assetRequest->start();
 }
 
+bool AssetsBackupHandler::copyInChunks(QIODevice& from, QIODevice& to) {
+    QByteArray chunk;
+    while (!from.atEnd()) {
+        chunk = from.read(COPY_CHUNK_SIZE);
+        if (chunk.isEmpty() || to.write(chunk) != chunk.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data) {
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return writeAssetFile(hash, buffer);
+}
+
+bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, QIODevice& data) {
     QDir assetsDir { _assetsDirectory };
     QFile file { assetsDir.filePath(hash) };
     if (!file.open(QFile::WriteOnly)) {
@@ -508,8 +539,7 @@ bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, cons
         return false;
     }
 
-    auto bytesWritten = file.write(data);
-    if (bytesWritten != data.size()) {
+    if (!copyInChunks(data, file)) {
         qCCritical(asset_backup) << "Could not write data to file" << file.fileName();
         file.remove();
         return false;
@@ -28,6 +28,18 @@
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// a public key fetched this recently isn't fetched again before a connection, and one fetched within the shorter time
+// isn't fetched again after a signature fails to verify with it either, so that a burst of connections doesn't turn into
+// a burst of metaverse lookups
+static const quint64 PUBLIC_KEY_TTL_USECS = 5 * 60 * USECS_PER_SECOND;
+static const quint64 PUBLIC_KEY_MIN_REFRESH_USECS = 10 * USECS_PER_SECOND;
+
+static const float STATS_AVERAGE_WEIGHT = 0.1f;
+
+static void updateAverageUsecs(float& average, quint64 usecs) {
+    average = (1.0f - STATS_AVERAGE_WEIGHT) * average + STATS_AVERAGE_WEIGHT * (float)usecs;
+}
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
@@ -60,6 +72,13 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         return;
     }
 
+    quint64 startUsecs = usecTimestampNow();
+    ++_numConnectRequests;
+    handleConnectRequest(message);
+    updateAverageUsecs(_averageConnectRequestUsecs, usecTimestampNow() - startUsecs);
+}
+
+void DomainGatekeeper::handleConnectRequest(QSharedPointer<ReceivedMessage> message) {
     QDataStream packetStream(message->getMessage());
 
     // read a NodeConnectionData object from the packet so we can pass around this data while we're inspecting it
@@ -378,6 +397,12 @@ void DomainGatekeeper::updateNodePermissions() {
                                               connectingAddr.getAddress(), hardwareAddress, machineFingerprint);
         }
 
+        if (node->getPermissions().permissions != userPerms.permissions) {
+            DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+            if (nodeData) {
+                nodeData->domainListEntryChanged();
+            }
+        }
         node->setPermissions(userPerms);
 
         if (!userPerms.can(NodePermissions::Permission::canConnectToDomain)) {
@@ -693,15 +718,16 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
                                            const SockAddr& senderSockAddr) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
-    KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
+    UserPublicKey userPublicKey = _userPublicKeys.value(lowerUsername);
 
-    QByteArray publicKeyArray = publicKeyPair.first;
-    bool isOptimisticKey = publicKeyPair.second;
+    QByteArray publicKeyArray = userPublicKey.key;
+    bool isOptimisticKey = userPublicKey.isOptimistic;
 
     const QUuid& connectionToken = _connectionTokenHash.value(lowerUsername);
 
     if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
         // if we do have a public key for the user, check for a signature match
+        quint64 verifyStartUsecs = usecTimestampNow();
 
         const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
 
@@ -719,6 +745,7 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
                                            reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
                                            usernameSignature.size(),
                                            rsaPublicKey);
+            updateAverageUsecs(_averageSignatureVerifyUsecs, usecTimestampNow() - verifyStartUsecs);
 
             if (decryptResult == 1) {
                 qDebug() << "Username signature matches for" << username;
@@ -815,9 +842,20 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
         // public-key request for this username is already flight, not rerequesting
         return;
     }
-    _inFlightPublicKeyRequests.insert(lowerUsername, isOptimistic);
 
-    // even if we have a public key for them right now, request a new one in case it has just changed
+    // a key fetched recently is most likely still current, unless it was an optimistic one that didn't verify
+    auto publicKey = _userPublicKeys.find(lowerUsername);
+    quint64 now = usecTimestampNow();
+    if (publicKey != _userPublicKeys.end() && !(publicKey->isOptimistic && !isOptimistic)
+            && now - publicKey->fetchedUsecs < (isOptimistic ? PUBLIC_KEY_TTL_USECS : PUBLIC_KEY_MIN_REFRESH_USECS)) {
+        ++_numPublicKeyRequestsSkipped;
+        return;
+    }
+
+    _inFlightPublicKeyRequests.insert(lowerUsername, { isOptimistic, now });
+    ++_numPublicKeyRequests;
+
+    // even if we have an older public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
     callbackParams.callbackReceiver = this;
     callbackParams.jsonCallbackMethod = "publicKeyJSONCallback";
@@ -848,7 +886,11 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
     QJsonObject jsonObject = QJsonDocument::fromJson(requestReply->readAll()).object();
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
 
-    bool isOptimisticKey = _inFlightPublicKeyRequests.take(username);
+    PublicKeyRequest publicKeyRequest = _inFlightPublicKeyRequests.take(username);
+    bool isOptimisticKey = publicKeyRequest.isOptimistic;
+    if (publicKeyRequest.requestedUsecs != 0) {
+        updateAverageUsecs(_averagePublicKeyRequestUsecs, usecTimestampNow() - publicKeyRequest.requestedUsecs);
+    }
 
     if (jsonObject["status"].toString() == "success" && !username.isEmpty()) {
         // pull the public key as a QByteArray from this response
@@ -860,7 +902,8 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
         _userPublicKeys[username.toLower()] =
             {
                 QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8()),
-                isOptimisticKey
+                isOptimisticKey,
+                usecTimestampNow()
             };
     }
 }
@@ -871,6 +914,23 @@ void DomainGatekeeper::publicKeyJSONErrorCallback(QNetworkReply* requestReply) {
     _inFlightPublicKeyRequests.remove(username);
 }
 
+QJsonObject DomainGatekeeper::getStatsJSON() const {
+    QJsonObject stats;
+    stats["connect_requests"] = (double)_numConnectRequests;
+    stats["connect_request_usecs"] = _averageConnectRequestUsecs;
+    stats["signature_verify_usecs"] = _averageSignatureVerifyUsecs;
+    stats["public_key_requests"] = (double)_numPublicKeyRequests;
+    stats["public_key_requests_cached"] = (double)_numPublicKeyRequestsSkipped;
+    stats["public_key_requests_in_flight"] = _inFlightPublicKeyRequests.size();
+    stats["public_key_request_usecs"] = _averagePublicKeyRequestUsecs;
+    stats["public_keys_cached"] = _userPublicKeys.size();
+    stats["group_membership_requests_in_flight"] = _inFlightGroupMembershipsRequests.size();
+    stats["domain_user_requests_in_flight"] = _inFlightDomainUserIdentityRequests.size();
+    stats["pending_assigned_nodes"] = (int)_pendingAssignedNodes.size();
+    stats["ice_peers"] = _icePeers.size();
+    return stats;
+}
+
 void DomainGatekeeper::sendProtocolMismatchConnectionDenial(const SockAddr& senderSockAddr) {
     QString protocolVersionError = "Protocol version mismatch - Domain version: " + QCoreApplication::applicationVersion();
 
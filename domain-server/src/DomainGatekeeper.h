@@ -18,6 +18,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtNetwork/QNetworkReply>
 #include <QtCore/QSharedPointer>
@@ -49,6 +50,9 @@ public:
     Node::LocalID findOrCreateLocalID(const QUuid& uuid);
 
     static void sendProtocolMismatchConnectionDenial(const SockAddr& senderSockAddr);
+
+    // the connect requests handled, the metaverse lookups in flight and how long each stage takes, for the stats page
+    QJsonObject getStatsJSON() const;
 public slots:
     void processConnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
@@ -80,6 +84,7 @@ private slots:
     void requestDomainUserFinished();
 
 private:
+    void handleConnectRequest(QSharedPointer<ReceivedMessage> message);
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
@@ -129,10 +134,18 @@ private:
     // we don't send back user signature decryption errors for those keys so that there isn't a thrasing of key re-generation
     // and connection refusal
 
-    using KeyFlagPair = QPair<QByteArray, bool>;
-
-    QHash<QString, KeyFlagPair> _userPublicKeys; // keep track of keys and flag them as optimistic or not
-    QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
+    struct UserPublicKey {
+        QByteArray key;
+        bool isOptimistic { false };
+        quint64 fetchedUsecs { 0 };
+    };
+    struct PublicKeyRequest {
+        bool isOptimistic { false };
+        quint64 requestedUsecs { 0 };
+    };
+
+    QHash<QString, UserPublicKey> _userPublicKeys; // keep track of keys and flag them as optimistic or not
+    QHash<QString, PublicKeyRequest> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
 
@@ -162,6 +175,14 @@ private:
     DomainUserIdentities _verifiedDomainUserIdentities;  // Verified domain users.
 
     QHash<QString, QStringList> _domainGroupMemberships;  // <domainUserName, [domainGroupName]>
+
+    // stats, the times being moving averages
+    quint64 _numConnectRequests { 0 };
+    quint64 _numPublicKeyRequests { 0 };
+    quint64 _numPublicKeyRequestsSkipped { 0 };
+    float _averageConnectRequestUsecs { 0.0f };
+    float _averageSignatureVerifyUsecs { 0.0f };
+    float _averagePublicKeyRequestUsecs { 0.0f };
 };
 
 
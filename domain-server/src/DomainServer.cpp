@@ -713,7 +713,7 @@ const QString DISABLED_AUTOMATIC_NETWORKING_VALUE = "disabled";
 
 
 
-bool DomainServer::isPacketVerified(const udt::Packet& packet) {
+bool DomainServer::isPacketVerified(udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
 
@@ -765,6 +765,7 @@ bool DomainServer::isPacketVerified(const udt::Packet& packet) {
 void DomainServer::setupNodeListAndAssignments() {
     const QString CUSTOM_LOCAL_PORT_OPTION = "metaverse.local_port";
     static const QString ENABLE_PACKET_AUTHENTICATION = "metaverse.enable_packet_verification";
+    static const QString ENABLE_PACKET_ENCRYPTION = "metaverse.enable_packet_encryption";
 
     QVariant localPortValue = _settingsManager.valueOrDefaultValueForKeyPath(CUSTOM_LOCAL_PORT_OPTION);
     int domainServerPort = localPortValue.toInt();
@@ -835,6 +836,10 @@ void DomainServer::setupNodeListAndAssignments() {
     bool isAuthEnabled = _settingsManager.valueOrDefaultValueForKeyPath(ENABLE_PACKET_AUTHENTICATION).toBool();
     nodeList->setAuthenticatePackets(isAuthEnabled);
 
+    // the nodes seal the packets between them rather than hash them, the domain list tells them which to do
+    bool isEncryptionEnabled = _settingsManager.valueOrDefaultValueForKeyPath(ENABLE_PACKET_ENCRYPTION).toBool();
+    nodeList->setPacketProtection(isEncryptionEnabled ? LimitedNodeList::AEADProtection : LimitedNodeList::HMACProtection);
+
     connect(nodeList.data(), &LimitedNodeList::nodeAdded, this, &DomainServer::nodeAdded);
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &DomainServer::nodeKilled);
     connect(nodeList.data(), &LimitedNodeList::localSockAddrChanged, this,
@@ -852,6 +857,8 @@ void DomainServer::setupNodeListAndAssignments() {
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processPathQueryPacket));
     packetReceiver.registerListener(PacketType::NodeJsonStats,
         PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeJSONStatsPacket));
+    packetReceiver.registerListener(PacketType::NodeTelemetry,
+        PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeTelemetryPacket));
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest,
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processNodeDisconnectRequestPacket));
     packetReceiver.registerListener(PacketType::AvatarZonePresence,
@@ -1246,12 +1253,20 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
-    // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    // the version of the domain list the node has, if any
+    quint64 knownDomainListVersion { 0 };
+    packetStream >> knownDomainListVersion;
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
 
+    // update this node's sockets in case they have changed
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+            || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        nodeData->domainListEntryChanged();
+    }
+
     if (!nodeData->hasCheckedIn()) {
         nodeData->setHasCheckedIn(true);
 
@@ -1274,7 +1289,8 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
-    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
+    sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false,
+                         knownDomainListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1350,13 +1366,15 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
     if (shouldReplicateNode(*newNode)) {
         qDebug() << "Setting node to replicated: " << newNode->getUUID();
         newNode->setIsReplicated(true);
+        nodeData->domainListEntryChanged();
     }
 
     // send out this node to our other connected nodes
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection) {
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr,
+                                        bool newConnection, quint64 knownDomainListVersion) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
@@ -1367,45 +1385,56 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
+    // a node that has a version of the list since which the nodes it is sent haven't changed only needs the entries that
+    // were added or changed after it, otherwise it gets them all
+    quint64 domainListVersion = DomainServerNodeData::getDomainListVersion();
+    bool isDelta = !newConnection && knownDomainListVersion != 0 && knownDomainListVersion <= domainListVersion
+        && knownDomainListVersion >= nodeData->getInterestVersion();
+
+    std::vector<SharedNodePointer> listNodes;
+    if (nodeData->getNodeInterestSet().size() > 0 && nodeData->isAuthenticated()) {
+        limitedNodeList->eachNode([this, node, isDelta, knownDomainListVersion, &listNodes](const SharedNodePointer& otherNode) {
+            if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                if (!isDelta || !otherNodeData || otherNodeData->getDomainListEntryVersion() > knownDomainListVersion) {
+                    listNodes.push_back(otherNode);
+                }
+            }
+        });
+    }
+
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getLocalID();
     extendedHeaderStream << node->getPermissions();
     extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
+    extendedHeaderStream << (quint8)limitedNodeList->getPacketProtection();
     extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    // the packets of a list can be lost or duplicated, so the node counts the entries it gets before it takes the version
+    extendedHeaderStream << domainListVersion;
+    extendedHeaderStream << (quint32)listNodes.size();
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
-
-    if (nodeInterestSet.size() > 0) {
-
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    // if this authenticated node has any interest types, send back those nodes as well
+    for (const auto& otherNode : listNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -2027,7 +2056,7 @@ void DomainServer::processOctreeDataRequestMessage(QSharedPointer<ReceivedMessag
     auto entityFilePath = getEntitiesFilePath();
 
     auto reply = NLPacketList::create(PacketType::OctreeDataFileReply, QByteArray(), true, true);
-    OctreeUtils::RawEntityData data;
+    OctreeUtils::RawOctreeData data;
     if (data.readOctreeDataInfoFromFile(entityFilePath)) {
         if (data.id == id && data.dataVersion <= dataVersion) {
             qCDebug(domain_server) << "ES has sufficient octree data, not sending data";
@@ -2059,6 +2088,13 @@ void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> pa
     }
 }
 
+void DomainServer::processNodeTelemetryPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    auto nodeData = static_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
+    if (nodeData && !nodeData->updateTelemetry(packetList->getMessage())) {
+        qCWarning(domain_server) << "Malformed telemetry from" << sendingNode->getUUID();
+    }
+}
+
 QJsonObject DomainServer::jsonForSocket(const SockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -2280,7 +2316,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     }
 
     if (connection->requestOperation() == QNetworkAccessManager::GetOperation) {
-        if (url.path() == "/assignments.json") {
+        if (url.path() == "/gatekeeper.json") {
+            // user is asking for the stats of the connect requests
+            QJsonDocument statsDocument(_gatekeeper.getStatsJSON());
+            connection->respond(HTTPConnection::StatusCode200, statsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+            return true;
+        } else if (url.path() == "/assignments.json") {
             // user is asking for json list of assignments
 
             // setup the JSON
@@ -3348,7 +3389,13 @@ void DomainServer::updateReplicatedNodes() {
                 qDebug() << "Setting node to replicated:"
                     << otherNode->getPermissions().getVerifiedUserName() << otherNode->getUUID();
             }
-            otherNode->setIsReplicated(shouldReplicate);
+            if (isReplicated != shouldReplicate) {
+                otherNode->setIsReplicated(shouldReplicate);
+                auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+                if (otherNodeData) {
+                    otherNodeData->domainListEntryChanged();
+                }
+            }
         }
     );
 }
@@ -299,7 +299,20 @@ bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const Q
         QString output = "";
         QTextStream outStream(&output);
 
-        nodeList->eachNode([this, &outStream](const SharedNodePointer& node) { generateMetricsForNode(outStream, node); });
+        QSet<QUuid> nodeIDs;
+        nodeList->eachNode([this, &outStream, &nodeIDs](const SharedNodePointer& node) {
+            generateMetricsForNode(outStream, node);
+            nodeIDs.insert(node->getUUID());
+        });
+
+        // forget the nodes that are gone
+        for (auto it = _renderedTelemetry.begin(); it != _renderedTelemetry.end();) {
+            if (nodeIDs.contains(it.key())) {
+                ++it;
+            } else {
+                it = _renderedTelemetry.erase(it);
+            }
+        }
 
         connection->respond(HTTPConnection::StatusCode200, output.toUtf8(), qPrintable(EXPORTER_MIME_TYPE));
         return true;
@@ -352,6 +365,56 @@ void DomainServerExporter::generateMetricsForNode(QTextStream& stream, const Sha
     stream << "###############################################################\n";
 
     generateMetricsFromJson(stream, nodeType, escapeName(nodeType), QHash<QString, QString>(), statsObject);
+
+    stream << getTelemetryMetricsForNode(node, escapeName(nodeType) + "_telemetry");
+}
+
+const QString& DomainServerExporter::getTelemetryMetricsForNode(const SharedNodePointer& node, const QString& path) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    RenderedTelemetry& rendered = _renderedTelemetry[node->getUUID()];
+    if (rendered.version == nodeData->getTelemetryVersion()) {
+        return rendered.text;
+    }
+    rendered.version = nodeData->getTelemetryVersion();
+    rendered.text.clear();
+
+    QTextStream stream(&rendered.text);
+    QString labels = QString("uuid=\"%1\"").arg(node->getUUID().toString(QUuid::WithoutBraces));
+    for (const auto& entry : nodeData->getTelemetry()) {
+        const NodeTelemetry::Metric& metric = entry.second;
+        QString metricName = path + "_" + escapeName(entry.first);
+
+        stream << "\n# HELP " << metricName << " " << entry.first << "\n";
+        switch (metric.type) {
+            case NodeTelemetry::Counter:
+                stream << "# TYPE " << metricName << " counter\n";
+                stream << metricName << "{" << labels << "} " << metric.value << "\n";
+                break;
+            case NodeTelemetry::Gauge:
+                stream << "# TYPE " << metricName << " gauge\n";
+                stream << metricName << "{" << labels << "} " << metric.value << "\n";
+                break;
+            case NodeTelemetry::Histogram: {
+                // one bucket per power of two, which is as fine as a dashboard needs
+                stream << "# TYPE " << metricName << " histogram\n";
+                const LatencyHistogram& histogram = metric.histogram;
+                uint64_t count = 0;
+                for (int i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i) {
+                    count += histogram.getBucketCount(i);
+                    if ((i + 1) % LatencyHistogram::SUB_BUCKETS_PER_OCTAVE == 0) {
+                        stream << metricName << "_bucket{" << labels << ",le=\"" << LatencyHistogram::bucketUpperBound(i)
+                               << "\"} " << count << "\n";
+                    }
+                }
+                stream << metricName << "_bucket{" << labels << ",le=\"+Inf\"} " << histogram.getCount() << "\n";
+                stream << metricName << "_sum{" << labels << "} " << histogram.getTotal() << "\n";
+                stream << metricName << "_count{" << labels << "} " << histogram.getCount() << "\n";
+                break;
+            }
+        }
+    }
+    stream.flush();
+    return rendered.text;
 }
 
 void DomainServerExporter::generateMetricsFromJson(QTextStream& stream,
@@ -21,6 +21,7 @@
 #include <QJsonObject>
 #include <QRegularExpression>
 #include <QHash>
+#include <QUuid>
 
 
 
@@ -50,6 +51,14 @@ private:
     QString escapeName(const QString &name);
     void generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node);
     void generateMetricsFromJson(QTextStream& stream, QString originalPath, QString path, QHash<QString, QString> labels, const QJsonObject& obj);
+    const QString& getTelemetryMetricsForNode(const SharedNodePointer& node, const QString& path);
+
+    // the telemetry of each node as last rendered, redone only when the node has sent more
+    struct RenderedTelemetry {
+        uint64_t version { 0 };
+        QString text;
+    };
+    QHash<QUuid, RenderedTelemetry> _renderedTelemetry;
 };
 
 #endif // DOMAINSERVEREXPORTER_H
@@ -20,9 +20,31 @@
 #include <udt/PacketHeaders.h>
 
 DomainServerNodeData::StringPairHash DomainServerNodeData::_overrideHash;
+quint64 DomainServerNodeData::_domainListVersion { 0 };
 
 DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
+    domainListEntryChanged();
+    _interestVersion = _domainListEntryVersion;
+}
+
+DomainServerNodeData::~DomainServerNodeData() {
+    // a node leaving changes the list too, so that the entries of a list before and after it aren't counted together
+    ++_domainListVersion;
+}
+
+void DomainServerNodeData::setIsAuthenticated(bool isAuthenticated) {
+    if (isAuthenticated != _isAuthenticated) {
+        _isAuthenticated = isAuthenticated;
+        _interestVersion = ++_domainListVersion;
+    }
+}
+
+void DomainServerNodeData::setNodeInterestSet(const NodeSet& nodeInterestSet) {
+    if (nodeInterestSet != _nodeInterestSet) {
+        _nodeInterestSet = nodeInterestSet;
+        _interestVersion = ++_domainListVersion;
+    }
 }
 
 void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
@@ -31,6 +53,11 @@ void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
     _statsJSONObject = overrideValuesIfNeeded(document.object());
 }
 
+bool DomainServerNodeData::updateTelemetry(const QByteArray& snapshot) {
+    ++_telemetryVersion;
+    return NodeTelemetry::accumulate(snapshot, _telemetry);
+}
+
 QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
     QJsonObject result;
     for (auto it = newStats.constBegin(); it != newStats.constEnd(); ++it) {
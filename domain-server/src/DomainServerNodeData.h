@@ -21,16 +21,23 @@
 #include <SockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
+#include <NodeTelemetry.h>
 #include <NodeType.h>
 
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
+    ~DomainServerNodeData();
 
     const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
 
     void updateJSONStats(QByteArray statsByteArray);
 
+    // the node's telemetry, accumulated over the snapshots it has sent, and a number that changes with it
+    const NodeTelemetry::Metrics& getTelemetry() const { return _telemetry; }
+    uint64_t getTelemetryVersion() const { return _telemetryVersion; }
+    bool updateTelemetry(const QByteArray& snapshot); // \return false if the snapshot is malformed
+
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
 
@@ -45,13 +52,13 @@ public:
     void setSendingSockAddr(const SockAddr& sendingSockAddr) { _sendingSockAddr = sendingSockAddr; }
     const SockAddr& getSendingSockAddr() { return _sendingSockAddr; }
 
-    void setIsAuthenticated(bool isAuthenticated) { _isAuthenticated = isAuthenticated; }
+    void setIsAuthenticated(bool isAuthenticated);
     bool isAuthenticated() const { return _isAuthenticated; }
 
     QHash<QUuid, QUuid>& getSessionSecretHash() { return _sessionSecretHash; }
 
     const NodeSet& getNodeInterestSet() const { return _nodeInterestSet; }
-    void setNodeInterestSet(const NodeSet& nodeInterestSet) { _nodeInterestSet = nodeInterestSet; }
+    void setNodeInterestSet(const NodeSet& nodeInterestSet);
     
     void setNodeVersion(const QString& nodeVersion) { _nodeVersion = nodeVersion; }
     const QString& getNodeVersion() { return _nodeVersion; }
@@ -76,6 +83,14 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the domain list is versioned so that a node that has a version of it need only be sent the entries changed since
+    static quint64 getDomainListVersion() { return _domainListVersion; }
+    // the version at which this node's entry in the domain list was added or last changed
+    quint64 getDomainListEntryVersion() const { return _domainListEntryVersion; }
+    void domainListEntryChanged() { _domainListEntryVersion = ++_domainListVersion; }
+    // the version at which the nodes this node is sent last changed, before which it needs the whole list
+    quint64 getInterestVersion() const { return _interestVersion; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -90,6 +105,9 @@ private:
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
     QJsonObject _statsJSONObject;
     static StringPairHash _overrideHash;
+
+    NodeTelemetry::Metrics _telemetry;
+    uint64_t _telemetryVersion { 0 };
     
     SockAddr _sendingSockAddr;
     bool _isAuthenticated = true;
@@ -103,6 +121,10 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    static quint64 _domainListVersion;
+    quint64 _domainListEntryVersion { 0 };
+    quint64 _interestVersion { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -34,21 +34,27 @@ EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString e
 }
 
 static const QString ENTITIES_BACKUP_FILENAME = "models.json.gz";
+static const qint64 ENTITIES_COPY_CHUNK_SIZE = 1024 * 1024;
 
 void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip) {
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
         QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
+        // the models file is gzipped already, so it is stored as is rather than compressed again
+        const int STORED_METHOD = 0;
+        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath),
+                          nullptr, 0, STORED_METHOD)) {
             qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
             return;
         }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
-            qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
-            return;
+        while (!entitiesFile.atEnd()) {
+            auto entityData = entitiesFile.read(ENTITIES_COPY_CHUNK_SIZE);
+            if (entityData.isEmpty() || zipFile.write(entityData) != entityData.size()) {
+                qCritical() << "Failed to write entities file to backup";
+                zipFile.close();
+                return;
+            }
         }
         zipFile.close();
         if (zipFile.getZipError() != UNZ_OK) {
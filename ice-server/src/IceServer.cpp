@@ -70,7 +70,22 @@ bool IceServer::packetVersionMatch(const udt::Packet& packet) {
     }
 }
 
+void IceServer::openWriteBatch() {
+    if (_isWriteBatchOpen) {
+        return;
+    }
+    _isWriteBatchOpen = true;
+    _serverSocket.openWriteBatch();
+
+    // the socket hands over all of the packets it read before this comes up
+    QMetaObject::invokeMethod(this, [this] {
+        _serverSocket.flushWriteBatch();
+        _isWriteBatchOpen = false;
+    }, Qt::QueuedConnection);
+}
+
 void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
+    openWriteBatch();
 
     auto nlPacket = NLPacket::fromBase(std::move(packet));
     
@@ -178,6 +193,11 @@ bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& pla
             // attempt to verify the signature for this heartbeat
             const auto rsaPublicKey = it->second.get();
 
+            auto signedHeartbeat = plaintext + signature;
+            if (rsaPublicKey && _lastVerifiedHeartbeats.value(domainID) == signedHeartbeat) {
+                return true;
+            }
+
             if (rsaPublicKey) {
                 auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
                 int verificationResult = RSA_verify(NID_sha256,
@@ -189,6 +209,7 @@ bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& pla
 
                 if (verificationResult == 1) {
                     // this is the only success case - we return true here to indicate that the heartbeat is verified
+                    _lastVerifiedHeartbeats[domainID] = signedHeartbeat;
                     return true;
                 } else {
                     qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
@@ -266,6 +287,7 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
 
                 if (rsaPublicKey) {
                     _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    _lastVerifiedHeartbeats.remove(domainID);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -312,6 +334,7 @@ void IceServer::clearInactivePeers() {
 
             // if we had a public key for this domain, remove it now
             _domainPublicKeys.erase(peer->getUUID());
+            _lastVerifiedHeartbeats.remove(peer->getUUID());
 
             // remove the peer object
             peerItem = _activePeers.erase(peerItem);
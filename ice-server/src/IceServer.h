@@ -45,6 +45,9 @@ private:
     bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
 
+    // the replies to the packets read together are queued and sent together once they have all been processed
+    void openWriteBatch();
+
     QUuid _id;
     udt::Socket _serverSocket;
 
@@ -56,6 +59,12 @@ private:
     DomainPublicKeyHash _domainPublicKeys;
 
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    // the plaintext and signature of the last heartbeat verified for each domain, which a domain whose sockets have not
+    // changed sends again each time, so that it is not verified again
+    QHash<QUuid, QByteArray> _lastVerifiedHeartbeats;
+
+    bool _isWriteBatchOpen { false };
 };
 
 #endif // hifi_IceServer_h
@@ -52,10 +52,12 @@
 #include <QProcessEnvironment>
 #include <QTemporaryDir>
 
+#include <tbb/task_group.h>
 
 #include <gl/QOpenGLContextWrapper.h>
 #include <gl/GLWindow.h>
 #include <gl/GLHelpers.h>
+#include <gl/GLShaders.h>
 
 #include <shared/FileUtils.h>
 #include <shared/QtHelpers.h>
@@ -93,8 +95,10 @@
 #include <FramebufferCache.h>
 #include <gpu/Batch.h>
 #include <gpu/Context.h>
+#include <image/TextureProcessing.h>
 #include <InfoView.h>
 #include <input-plugins/InputPlugin.h>
+#include <input-plugins/InputSampler.h>
 #include <controllers/UserInputMapper.h>
 #include <controllers/InputRecorder.h>
 #include <controllers/ScriptingInterface.h>
@@ -337,6 +341,8 @@ static const int ENTITY_SERVER_CONNECTION_TIMEOUT = 5000;
 static const int WATCHDOG_TIMER_TIMEOUT = 100;
 
 static const float INITIAL_QUERY_RADIUS = 10.0f;  // priority radius for entities before physics enabled
+static const float PREFETCH_QUERY_RADIUS = 20.0f;  // radius around a hinted destination whose entities are sent ahead
+static const float PREFETCH_QUERY_WEIGHT = 0.25f;
 
 static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStandardPaths::DesktopLocation);
 
@@ -344,6 +350,10 @@ Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTRE
 
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
+// how unbaked textures are compressed as they load, see image::CompressionQuality
+Setting::Handle<int> textureCompressionQuality{ "textureCompressionQuality", (int)image::CompressionQuality::Production };
+Setting::Handle<bool> gpuTextureCompression{ "gpuTextureCompression", true };
+
 static const QUrl AVATAR_INPUTS_BAR_QML = PathUtils::qmlUrl("AvatarInputsBar.qml");
 static const QUrl MIC_BAR_APPLICATION_QML = PathUtils::qmlUrl("hifi/audio/MicBarApplication.qml");
 static const QUrl BUBBLE_ICON_QML = PathUtils::qmlUrl("BubbleIcon.qml");
@@ -728,6 +738,7 @@ extern void saveInputPluginSettings(const InputPluginList& plugins);
 const QString TEST_SCRIPT_COMMAND{ "--testScript" };
 const QString TEST_QUIT_WHEN_FINISHED_OPTION{ "quitWhenFinished" };
 const QString TEST_RESULTS_LOCATION_COMMAND{ "--testResultsLocation" };
+const QString TEST_SCENE_COMMAND{ "--testScene" };
 
 bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     const char** constArgv = const_cast<const char**>(argv);
@@ -878,6 +889,9 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     DependencyManager::set<AudioClient>();
     DependencyManager::set<AudioScope>();
     DependencyManager::set<DeferredLightingEffect>();
+    image::setCompressionQuality((image::CompressionQuality)glm::clamp(textureCompressionQuality.get(),
+        (int)image::CompressionQuality::Fastest, (int)image::CompressionQuality::Highest));
+    image::setGPUCompressionEnabled(gpuTextureCompression.get());
     DependencyManager::set<TextureCache>();
     DependencyManager::set<MaterialCache>();
     DependencyManager::set<TextureCacheScriptingInterface>();
@@ -1055,6 +1069,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     _snapshotSound(nullptr),
     _sampleSound(nullptr)
 {
+    // read the persisted shader program binaries while the plugins, the window and the GL context are set up
+    gl::prefetchShaderCache();
 
     auto steamClient = PluginManager::getInstance()->getSteamClientPlugin();
     setProperty(hifi::properties::STEAM, (steamClient && steamClient->isRunning()));
@@ -1092,6 +1108,12 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
                 if (fileInfo.isDir() && fileInfo.isWritable()) {
                     TestScriptingInterface::getInstance()->setTestResultsLocation(path);
                 }
+            } else if (args.at(i) == TEST_SCENE_COMMAND) {
+                // A local scene for the test script to load, such as a snapshot of a domain to benchmark
+                QFileInfo fileInfo(args.at(i + 1));
+                if (fileInfo.isFile()) {
+                    TestScriptingInterface::getInstance()->setTestSceneLocation(fileInfo.absoluteFilePath());
+                }
             }
         }
     }
@@ -1613,6 +1635,11 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     connect(&_octreeProcessor, &OctreePacketProcessor::packetVersionMismatch, this, &Application::notifyPacketVersionMismatch);
     _entityEditSender.initialize(_enableProcessOctreeThread);
 
+    // sample the poses of the tracked devices between updates, for the hands to be late-latched before the avatar moves
+    _inputSampler = std::make_unique<InputSampler>(PluginManager::getInstance()->getInputPlugins(),
+                                                   DependencyManager::get<UserInputMapper>()->getPoseLatch());
+    _inputSampler->initialize(true, QThread::HighPriority);
+
     _idleLoopStdev.reset();
 
     // update before the first render
@@ -2358,6 +2385,29 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         properties["gpu_free_memory"] = (int)BYTES_TO_MB(gpu::Context::getFreeGPUMemSize());
         properties["gpu_frame_time"] = (float)(qApp->getGPUContext()->getFrameTimerGPUAverage());
         properties["batch_frame_time"] = (float)(qApp->getGPUContext()->getFrameTimerBatchAverage());
+
+        // the render jobs taking the most GPU time, leaving out the tasks holding them
+        {
+            static const size_t MAX_GPU_JOB_TIMES = 10;
+            auto gpuJobStats = getRenderEngine()->getGPUJobTimers()->getStats();
+            std::vector<const render::GPUJobTimers::Stats*> leafJobStats;
+            for (const auto& stats : gpuJobStats) {
+                if (!stats.isTask && stats.numSamples > 0) {
+                    leafJobStats.push_back(&stats);
+                }
+            }
+            std::sort(leafJobStats.begin(), leafJobStats.end(), [](const render::GPUJobTimers::Stats* a, const render::GPUJobTimers::Stats* b) {
+                return a->average > b->average;
+            });
+            QJsonObject gpuJobTimes;
+            for (size_t i = 0; i < leafJobStats.size() && i < MAX_GPU_JOB_TIMES; ++i) {
+                gpuJobTimes[QString::fromStdString(leafJobStats[i]->path)] = QJsonObject {
+                    { "average", leafJobStats[i]->average },
+                    { "percentile95", leafJobStats[i]->percentile95 },
+                };
+            }
+            properties["gpu_job_times"] = gpuJobTimes;
+        }
         properties["ideal_thread_count"] = QThread::idealThreadCount();
 
         auto hmdHeadPose = getHMDSensorPose();
@@ -2416,6 +2466,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     connect(this, &Application::applicationStateChanged, this, &Application::activeChanged);
     connect(_window, SIGNAL(windowMinimizedChanged(bool)), this, SLOT(windowMinimizedChanged(bool)));
     qCDebug(interfaceapp, "Startup time: %4.2f seconds.", (double)startupTimer.elapsed() / 1000.0);
+    PROFILE_INSTANT(startup, "Startup complete", "g", { { "seconds", (double)startupTimer.elapsed() / 1000.0 } });
 
     EntityTreeRenderer::setEntitiesShouldFadeFunction([this]() {
         SharedNodePointer entityServerNode = DependencyManager::get<NodeList>()->soloNodeOfType(NodeType::EntityServer);
@@ -2956,6 +3007,9 @@ Application::~Application() {
 
     _octreeProcessor.terminate();
     _entityEditSender.terminate();
+    if (_inputSampler) {
+        _inputSampler->terminate();
+    }
 
     if (auto steamClient = PluginManager::getInstance()->getSteamClientPlugin()) {
         steamClient->shutdown();
@@ -3045,6 +3099,7 @@ Application::~Application() {
 }
 
 void Application::initializeGL() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     qCDebug(interfaceapp) << "Created Display Window.";
 
 #ifdef DISABLE_QML
@@ -3115,6 +3170,19 @@ void Application::initializeGL() {
         chromiumFlags << "--disable-distance-field-text";
     }
 
+    // Web entities of the same site share a renderer process, rather than each starting one of their own
+    chromiumFlags << "--renderer-process-limit=4";
+#if defined(Q_OS_LINUX)
+    // Chromium only decodes video on the GPU through VA-API on Linux when asked to
+    chromiumFlags << "--enable-features=VaapiVideoDecoder";
+#endif
+
+    // Keep the flags set by the user, which come last so that they win
+    QString userChromiumFlags = QProcessEnvironment::systemEnvironment().value("QTWEBENGINE_CHROMIUM_FLAGS");
+    if (!userChromiumFlags.isEmpty()) {
+        chromiumFlags << userChromiumFlags;
+    }
+
     // Ensure all Qt webengine processes launched from us have the appropriate command line flags
     if (!chromiumFlags.empty()) {
         qputenv("QTWEBENGINE_CHROMIUM_FLAGS", chromiumFlags.join(' ').toLocal8Bit());
@@ -3154,6 +3222,7 @@ void Application::initializeGL() {
 }
 
 void Application::initializeDisplayPlugins() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     const auto& displayPlugins = PluginManager::getInstance()->getDisplayPlugins();
     Setting::Handle<QString> activeDisplayPluginSetting{ ACTIVE_DISPLAY_PLUGIN_SETTING_NAME, displayPlugins.at(0)->getName() };
     auto lastActiveDisplayPluginName = activeDisplayPluginSetting.get();
@@ -3212,6 +3281,7 @@ void Application::initializeDisplayPlugins() {
 }
 
 void Application::initializeRenderEngine() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     // FIXME: on low end systems os the shaders take up to 1 minute to compile, so we pause the deadlock watchdog thread.
     DeadlockWatchdogThread::withPause([&] {
         _graphicsEngine.initializeRender();
@@ -3254,6 +3324,7 @@ void Application::showLoginScreen() {
 static const QUrl AUTHORIZED_EXTERNAL_QML_SOURCE { "https://cdn.vircadia.com/community-apps/applications" };
 
 void Application::initializeUi() {
+    PROFILE_RANGE(startup, __FUNCTION__);
 
     // Allow remote QML content from trusted sources ONLY
     {
@@ -3452,8 +3523,15 @@ void Application::initializeUi() {
         }
     });
 
-    offscreenSurfaceCache->reserve(TabletScriptingInterface::QML, 1);
-    offscreenSurfaceCache->reserve(render::entities::WebEntityRenderer::QML, 2);
+    // they are built once startup is done, one per pass of the event loop, so that they don't delay the first frames
+    QTimer::singleShot(0, this, [] {
+        PROFILE_RANGE(startup, "reserveTabletSurface");
+        DependencyManager::get<OffscreenQmlSurfaceCache>()->reserve(TabletScriptingInterface::QML, 1);
+        QTimer::singleShot(0, qApp, [] {
+            PROFILE_RANGE(startup, "reserveWebSurfaces");
+            DependencyManager::get<OffscreenQmlSurfaceCache>()->reserve(render::entities::WebEntityRenderer::QML, 2);
+        });
+    });
 #endif
 
     flushMenuUpdates();
@@ -5362,8 +5440,13 @@ void Application::idle() {
     PerformanceWarning warn(showWarnings, "idle()");
 
     {
-        _gameWorkload.updateViews(_viewFrustum, getMyAvatar()->getHeadPosition());
-        _gameWorkload._engine->run();
+        workload::Views secondaryWorkloadViews;
+        {
+            QMutexLocker viewLocker(&_viewMutex);
+            secondaryWorkloadViews = _secondaryWorkloadViews;
+        }
+        // the workload itself runs in update(), alongside the stages that don't depend on it
+        _gameWorkload.updateViews(_viewFrustum, getMyAvatar()->getHeadPosition(), secondaryWorkloadViews);
     }
     {
         PerformanceTimer perfTimer("update");
@@ -5680,6 +5763,7 @@ QVector<EntityItemID> Application::pasteEntities(const QString& entityHostType,
 }
 
 void Application::init() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     // Make sure Login state is up to date
 #if !defined(DISABLE_QML)
     DependencyManager::get<DialogsManager>()->toggleLoginDialog();
@@ -6327,6 +6411,13 @@ void Application::updateSecondaryCameraViewFrustum() {
     secondaryViewFrustum.calculate();
 
     _conicalViews.push_back(secondaryViewFrustum);
+    _conicalViewBudgets.push_back({ camera->queryPriorityWeight, (uint32_t)std::max(camera->queryBytesPerSecond, 0) });
+
+    if (camera->workloadWeight > 0.0f) {
+        auto view = workload::View::evalFromFrustum(secondaryViewFrustum);
+        view.weight = camera->workloadWeight;
+        _secondaryWorkloadViews.push_back(view);
+    }
 }
 
 static bool domainLoadingInProgress = false;
@@ -6352,6 +6443,23 @@ void Application::tryToEnablePhysics() {
     }
 }
 
+// Adds the duration of a stage of Application::update to the FrameTimings while they are being recorded.
+class UpdateStageTimer {
+public:
+    UpdateStageTimer(FrameTimingsScriptingInterface& frameTimings, const char* stage) :
+        _frameTimings(frameTimings), _stage(stage), _start(frameTimings.isActive() ? usecTimestampNow() : 0) {}
+    ~UpdateStageTimer() {
+        if (_start != 0) {
+            _frameTimings.addStageValue(_stage, usecTimestampNow() - _start);
+        }
+    }
+
+private:
+    FrameTimingsScriptingInterface& _frameTimings;
+    const char* _stage;
+    uint64_t _start;
+};
+
 void Application::update(float deltaTime) {
     PROFILE_RANGE_EX(app, __FUNCTION__, 0xffff0000, (uint64_t)_graphicsEngine._renderFrameCount + 1);
 
@@ -6396,6 +6504,7 @@ void Application::update(float deltaTime) {
     auto myAvatar = getMyAvatar();
     {
         PerformanceTimer perfTimer("devices");
+        UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "devices");
         auto userInputMapper = DependencyManager::get<UserInputMapper>();
 
         controller::HmdAvatarAlignmentType hmdAvatarAlignmentType;
@@ -6422,6 +6531,9 @@ void Application::update(float deltaTime) {
             hmdAvatarAlignmentType
         };
 
+        // the poses sampled as the devices update, for the avatar's update to correct by where they have moved since
+        userInputMapper->latchFramePoses();
+
         InputPluginPointer keyboardMousePlugin;
         for(const auto& inputPlugin : PluginManager::getInstance()->getInputPlugins()) {
             if (inputPlugin->getName() == KeyboardMouseDevice::NAME) {
@@ -6574,17 +6686,38 @@ void Application::update(float deltaTime) {
     auto grabManager = DependencyManager::get<GrabManager>();
     grabManager->simulateGrabs();
 
-    // TODO: break these out into distinct perfTimers when they prove interesting
+    // The workload classifies the space on a worker while the picks and pointers are updated: it only changes the regions
+    // of entities and avatars, through the entity simulation and the workload space which are locked, and the simulation
+    // below, which acts on those regions, waits for it.
     {
-        PROFILE_RANGE(app, "PickManager");
-        PerformanceTimer perfTimer("pickManager");
-        DependencyManager::get<PickManager>()->update();
-    }
+        auto& frameTimings = _graphicsEngine._frameTimingsScriptingInterface;
+        uint64_t workloadTime = 0;
+        tbb::task_group updateStages;
+        updateStages.run([&] {
+            uint64_t start = usecTimestampNow();
+            _gameWorkload._engine->run();
+            workloadTime = usecTimestampNow() - start;
+        });
 
-    {
-        PROFILE_RANGE(app, "PointerManager");
-        PerformanceTimer perfTimer("pointerManager");
-        DependencyManager::get<PointerManager>()->update();
+        {
+            PROFILE_RANGE(app, "PickManager");
+            PerformanceTimer perfTimer("pickManager");
+            UpdateStageTimer stageTimer(frameTimings, "pickManager");
+            DependencyManager::get<PickManager>()->update();
+        }
+
+        {
+            PROFILE_RANGE(app, "PointerManager");
+            PerformanceTimer perfTimer("pointerManager");
+            UpdateStageTimer stageTimer(frameTimings, "pointerManager");
+            DependencyManager::get<PointerManager>()->update();
+        }
+
+        {
+            PerformanceTimer perfTimer("waitForWorkload");
+            updateStages.wait();
+        }
+        frameTimings.addStageValue("workload", workloadTime);
     }
 
     QSharedPointer<AvatarManager> avatarManager = DependencyManager::get<AvatarManager>();
@@ -6592,6 +6725,7 @@ void Application::update(float deltaTime) {
     {
         PROFILE_RANGE(simulation_physics, "Simulation");
         PerformanceTimer perfTimer("simulation");
+        UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "simulation");
 
         getEntities()->preUpdate();
         _entitySimulation->removeDeadEntities();
@@ -6604,6 +6738,14 @@ void Application::update(float deltaTime) {
             {
                 PROFILE_RANGE(simulation_physics, "Entities");
                 PhysicsEngine::Transaction transaction;
+                // the collision shapes around the avatar first, and those under it first of all while it has no floor
+                auto myAvatar = getMyAvatar();
+                bool needsSupport = !_physicsEnabled ||
+                    myAvatar->getCharacterController()->getState() == CharacterController::State::InAir;
+                _entitySimulation->setShapeBuildFocus(myAvatar->getWorldPosition(), myAvatar->getWorldVelocity(), needsSupport);
+                // all at once on arrival so the avatar gets its floor, then spread over the frames
+                const uint32_t MAX_PHYSICS_ADDS_PER_FRAME = 64;
+                _entitySimulation->setMaxPhysicsAddsPerStep(_physicsEnabled ? MAX_PHYSICS_ADDS_PER_FRAME : 0);
                 _entitySimulation->buildPhysicsTransaction(transaction);
                 _physicsEngine->processTransaction(transaction);
                 _entitySimulation->handleProcessedPhysicsTransaction(transaction);
@@ -6717,13 +6859,16 @@ void Application::update(float deltaTime) {
         {
             PROFILE_RANGE(simulation, "OtherAvatars");
             PerformanceTimer perfTimer("otherAvatars");
+            UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "otherAvatars");
             avatarManager->updateOtherAvatars(deltaTime);
         }
 
         {
             PROFILE_RANGE(simulation, "MyAvatar");
             PerformanceTimer perfTimer("MyAvatar");
+            UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "MyAvatar");
             qApp->updateMyAvatarLookAtPosition(deltaTime);
+            myAvatar->lateLatchControllerPoses();
             avatarManager->updateMyAvatar(deltaTime);
         }
     }
@@ -6732,6 +6877,11 @@ void Application::update(float deltaTime) {
     PerformanceWarning warn(showWarnings, "Application::update()");
 
     updateLOD(deltaTime);
+    if (!isThrottleRendering()) {
+        float targetFrameRate = std::min(getTargetRenderFrameRate(), (float)_refreshRateManager.getActiveRefreshRate());
+        _performanceManager.updateDynamicResolution(getGPUContext()->getFrameTimerGPUAverage(), targetFrameRate, deltaTime);
+    }
+    TestScriptingInterface::getInstance()->updateFrameTimings();
 
     if (!_loginDialogID.isNull()) {
         _loginStateManager.update(getMyAvatar()->getDominantHand(), _loginDialogID);
@@ -6741,6 +6891,7 @@ void Application::update(float deltaTime) {
     {
         PROFILE_RANGE_EX(app, "Overlays", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
         PerformanceTimer perfTimer("overlays");
+        UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "overlays");
         _overlays.update(deltaTime);
     }
 
@@ -6756,10 +6907,22 @@ void Application::update(float deltaTime) {
 
         _conicalViews.clear();
         _conicalViews.push_back(_viewFrustum);
+        _conicalViewBudgets = { OctreeQueryViewBudget() };
+        _secondaryWorkloadViews.clear();
         // TODO: Fix this by modeling the way the secondary camera works on how the main camera works
         // ie. Use a camera object stored in the game logic and informs the Engine on where the secondary
         // camera should be.
         updateSecondaryCameraViewFrustum();
+
+        _entityQueryViews = _conicalViews;
+        _entityQueryViewBudgets = _conicalViewBudgets;
+        glm::vec3 prefetchLocation;
+        if (getMyAvatar()->getPrefetchLocation(prefetchLocation)) {
+            ConicalViewFrustum prefetchView;
+            prefetchView.setPositionAndSimpleRadius(prefetchLocation, PREFETCH_QUERY_RADIUS);
+            _entityQueryViews.push_back(prefetchView);
+            _entityQueryViewBudgets.push_back({ PREFETCH_QUERY_WEIGHT, 0 });
+        }
     }
 
     quint64 now = usecTimestampNow();
@@ -6768,12 +6931,13 @@ void Application::update(float deltaTime) {
     {
         PROFILE_RANGE_EX(app, "QueryOctree", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
         PerformanceTimer perfTimer("queryOctree");
+        UpdateStageTimer stageTimer(_graphicsEngine._frameTimingsScriptingInterface, "queryOctree");
         QMutexLocker viewLocker(&_viewMutex);
 
         bool viewIsDifferentEnough = false;
-        if (_conicalViews.size() == _lastQueriedViews.size()) {
-            for (size_t i = 0; i < _conicalViews.size(); ++i) {
-                if (!_conicalViews[i].isVerySimilar(_lastQueriedViews[i])) {
+        if (_entityQueryViews.size() == _lastQueriedViews.size()) {
+            for (size_t i = 0; i < _entityQueryViews.size(); ++i) {
+                if (!_entityQueryViews[i].isVerySimilar(_lastQueriedViews[i])) {
                     viewIsDifferentEnough = true;
                     break;
                 }
@@ -6781,7 +6945,7 @@ void Application::update(float deltaTime) {
         } else {
             viewIsDifferentEnough = true;
         }
-
+        viewIsDifferentEnough = viewIsDifferentEnough || _entityQueryViewBudgets != _lastQueriedViewBudgets;
 
         // if it's been a while since our last query or the view has significantly changed then send a query, otherwise suppress it
         static const std::chrono::seconds MIN_PERIOD_BETWEEN_QUERIES { 3 };
@@ -6792,7 +6956,8 @@ void Application::update(float deltaTime) {
             }
             queryAvatars();
 
-            _lastQueriedViews = _conicalViews;
+            _lastQueriedViews = _entityQueryViews;
+            _lastQueriedViewBudgets = _entityQueryViewBudgets;
             _queryExpiry = now + MIN_PERIOD_BETWEEN_QUERIES;
         }
     }
@@ -6822,6 +6987,11 @@ void Application::update(float deltaTime) {
         avatarManager->postUpdate(deltaTime, getMain3DScene());
     }
 
+    {
+        PerformanceTimer perfTimer("modelBlender");
+        DependencyManager::get<ModelBlender>()->update();
+    }
+
     {
         PROFILE_RANGE_EX(app, "PostUpdateLambdas", 0xffff0000, (uint64_t)0);
         PerformanceTimer perfTimer("postUpdateLambdas");
@@ -6958,6 +7128,24 @@ void Application::updateRenderArgs(float deltaTime) {
                     eyeProjections[eye] = getActiveDisplayPlugin()->getEyeProjection(eye, baseProjection);
                 });
 
+                // Center each eye's foveation on the gaze when an eye tracker gives it, else on the lens's axis
+                auto& foveationCenters = appRenderArgs._renderArgs._foveationCenters;
+                controller::Pose eyePoses[2] = { myAvatar->getControllerPoseInAvatarFrame(controller::Action::LEFT_EYE),
+                                                 myAvatar->getControllerPoseInAvatarFrame(controller::Action::RIGHT_EYE) };
+                bool isGazeTracked = eyePoses[Left].isValid() && eyePoses[Right].isValid();
+                glm::quat worldToCamera = glm::inverse(_myCamera.getOrientation());
+                for_each_eye([&](Eye eye) {
+                    glm::vec4 center;
+                    if (isGazeTracked) {
+                        glm::vec3 gaze = worldToCamera * myAvatar->getWorldOrientation() * eyePoses[eye].rotation * Vectors::UNIT_Z;
+                        center = eyeProjections[eye] * glm::vec4(gaze, 0.0f);
+                    }
+                    if (!isGazeTracked || center.w <= 0.0f) {
+                        center = eyeProjections[eye] * glm::vec4(-Vectors::UNIT_Z, 0.0f);
+                    }
+                    foveationCenters[eye] = glm::clamp(glm::vec2(center) / center.w * 0.5f + 0.5f, 0.0f, 1.0f);
+                });
+
                 // Configure the type of display / stereo
                 appRenderArgs._renderArgs._displayMode = (isHMDMode() ? RenderArgs::STEREO_HMD : RenderArgs::STEREO_MONITOR);
             }
@@ -7002,6 +7190,10 @@ void Application::queryAvatars() {
             destinationBuffer += view.serialize(destinationBuffer);
         }
 
+        AvatarDataPacket::QueryCapabilities capabilities = AvatarDataPacket::QUERY_WANTS_COMPACT_JOINT_DATA;
+        memcpy(destinationBuffer, &capabilities, sizeof(capabilities));
+        destinationBuffer += sizeof(capabilities);
+
         avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
 
         DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket), NodeSet() << NodeType::AvatarMixer);
@@ -7092,7 +7284,7 @@ void Application::queryOctree(NodeType_t serverType, PacketType packetType) {
         static constexpr float MIN_LOD_ADJUST = -20.0f;
         _octreeQuery.setBoundaryLevelAdjust(MIN_LOD_ADJUST);
     } else {
-        _octreeQuery.setConicalViews(_conicalViews);
+        _octreeQuery.setConicalViews(_entityQueryViews, _entityQueryViewBudgets);
         auto lodManager = DependencyManager::get<LODManager>();
         _octreeQuery.setOctreeSizeScale(lodManager->getOctreeSizeScale());
         _octreeQuery.setBoundaryLevelAdjust(lodManager->getBoundaryLevelAdjust());
@@ -7315,6 +7507,10 @@ void Application::domainURLChanged(QUrl domainURL) {
     if (isServerlessMode()) {
         loadServerlessDomain(domainURL);
     }
+    // have the GPU backend prewarm the shader programs used the last time we were in this domain
+    if (auto gpuContext = _graphicsEngine.getGPUContext()) {
+        gpuContext->setShaderCacheScope(domainURL.host().toStdString());
+    }
     updateWindowTitle();
 }
 
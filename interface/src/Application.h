@@ -85,6 +85,7 @@
 #include "VisionSqueeze.h"
 
 class GLCanvas;
+class InputSampler;
 class MainWindow;
 class AssetUpload;
 class CompositorHelper;
@@ -653,7 +654,12 @@ private:
     ViewFrustum _displayViewFrustum;
 
     ConicalViewFrustums _conicalViews;
+    OctreeQueryViewBudgets _conicalViewBudgets; // how the entity server shares what it sends between the views
+    ConicalViewFrustums _entityQueryViews; // the views, with any the avatar is likely to go to, sent to the entity server
+    OctreeQueryViewBudgets _entityQueryViewBudgets;
     ConicalViewFrustums _lastQueriedViews; // last views used to query servers
+    OctreeQueryViewBudgets _lastQueriedViewBudgets;
+    workload::Views _secondaryWorkloadViews; // the secondary camera's, fed to the workload with the main views
 
     using SteadyClock = std::chrono::steady_clock;
     using TimePoint = SteadyClock::time_point;
@@ -696,6 +702,7 @@ private:
 
     OctreePacketProcessor _octreeProcessor;
     EntityEditPacketSender _entityEditSender;
+    std::unique_ptr<InputSampler> _inputSampler;
 
     StDev _idleLoopStdev;
     float _idleLoopMeasuredJitter;
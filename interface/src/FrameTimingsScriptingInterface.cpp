@@ -12,6 +12,7 @@
 
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
+    _stageValues.clear();
     DependencyManager::get<TextureCache>()->setUnusedResourceCacheSize(0);
     _values.reserve(8192);
     _active = true;
@@ -23,6 +24,12 @@ void FrameTimingsScriptingInterface::addValue(uint64_t value) {
     }
 }
 
+void FrameTimingsScriptingInterface::addStageValue(const QString& stage, uint64_t value) {
+    if (_active) {
+        _stageValues[stage].push_back(value);
+    }
+}
+
 void FrameTimingsScriptingInterface::finish() {
     _active = false;
     uint64_t total = 0;
@@ -51,3 +58,15 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+QVariantMap FrameTimingsScriptingInterface::getStageValues() const {
+    QVariantMap result;
+    for (auto itr = _stageValues.begin(); itr != _stageValues.end(); ++itr) {
+        QVariantList values;
+        for (quint64 v : itr.value()) {
+            values << QVariant(v);
+        }
+        result[itr.key()] = values;
+    }
+    return result;
+}
@@ -8,7 +8,10 @@
 
 #pragma once
 #include <stdint.h>
+#include <vector>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
 
 class FrameTimingsScriptingInterface : public QObject {
     Q_OBJECT
@@ -21,7 +24,11 @@ public:
     Q_INVOKABLE void addValue(uint64_t value);
     Q_INVOKABLE void finish();
     Q_INVOKABLE QVariantList getValues() const;
+    // the durations of each stage of Application::update, in usecs, by stage name
+    Q_INVOKABLE QVariantMap getStageValues() const;
 
+    bool isActive() const { return _active; }
+    void addStageValue(const QString& stage, uint64_t value);
 
     uint64_t getMax() const { return _max; }
     uint64_t getMin() const { return _min; }
@@ -30,6 +37,7 @@ public:
 
 protected:
     std::vector<uint64_t> _values;
+    QHash<QString, std::vector<uint64_t>> _stageValues;
     bool _active { false };
     uint64_t _max { 0 };
     uint64_t _min { 0 };
@@ -17,9 +17,21 @@
 #include "scripting/RenderScriptingInterface.h"
 #include "LODManager.h"
 
+// The resolution goes down to half of the viewport resolution scale, in steps of 5%
+static const int DYNAMIC_RESOLUTION_MAX_STEPS { 10 };
+static const float DYNAMIC_RESOLUTION_STEP { 0.05f };
+// The share of the frame period the GPU is kept to, leaving some for the compositor and for spikes
+static const float DYNAMIC_RESOLUTION_GPU_BUDGET { 0.85f };
+// The resolution is only raised once the GPU time is under this share of the budget, so that it doesn't oscillate
+static const float DYNAMIC_RESOLUTION_RAISE_THRESHOLD { 0.75f };
+// How long the GPU time average takes to show a change of resolution before the next; it is lowered faster than raised
+static const float DYNAMIC_RESOLUTION_LOWER_DELAY { 0.25f };
+static const float DYNAMIC_RESOLUTION_RAISE_DELAY { 1.0f };
+
 PerformanceManager::PerformanceManager()
 {
     setPerformancePreset((PerformancePreset) _performancePresetSetting.get());
+    _dynamicResolutionEnabled = _dynamicResolutionSetting.get();
 }
 
 void PerformanceManager::setupPerformancePresetSettings(bool evaluatePlatformTier) {
@@ -135,3 +147,50 @@ void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformanceP
         break;
     }
 }
+
+void PerformanceManager::setDynamicResolutionEnabled(bool enabled) {
+    if (_dynamicResolutionEnabled == enabled) {
+        return;
+    }
+    _dynamicResolutionEnabled = enabled;
+    _dynamicResolutionSetting.set(enabled);
+    if (!enabled) {
+        _dynamicResolutionSteps = 0;
+        _dynamicResolutionDelay = 0.0f;
+        RenderScriptingInterface::getInstance()->setDynamicResolutionScale(1.0f);
+    }
+}
+
+float PerformanceManager::getDynamicResolutionScale() const {
+    return 1.0f - (float)_dynamicResolutionSteps * DYNAMIC_RESOLUTION_STEP;
+}
+
+void PerformanceManager::updateDynamicResolution(float gpuTime, float targetFrameRate, float deltaTime) {
+    if (!_dynamicResolutionEnabled || gpuTime <= 0.0f || targetFrameRate <= 0.0f) {
+        return;
+    }
+
+    _dynamicResolutionDelay -= deltaTime;
+    if (_dynamicResolutionDelay > 0.0f) {
+        return;
+    }
+
+    float budget = DYNAMIC_RESOLUTION_GPU_BUDGET * (float)MSECS_PER_SECOND / targetFrameRate;
+    int steps = _dynamicResolutionSteps;
+    if (gpuTime > budget && steps < DYNAMIC_RESOLUTION_MAX_STEPS) {
+        // the GPU time goes about with the number of pixels, so with the square of the scale: go straight to the scale
+        // that should fit the budget, rather than a step at a time
+        float scale = getDynamicResolutionScale() * sqrtf(budget / gpuTime);
+        int wantedSteps = (int)ceilf((1.0f - scale) / DYNAMIC_RESOLUTION_STEP);
+        steps = std::min(DYNAMIC_RESOLUTION_MAX_STEPS, std::max(steps + 1, wantedSteps));
+        _dynamicResolutionDelay = DYNAMIC_RESOLUTION_LOWER_DELAY;
+    } else if (gpuTime < DYNAMIC_RESOLUTION_RAISE_THRESHOLD * budget && steps > 0) {
+        --steps;
+        _dynamicResolutionDelay = DYNAMIC_RESOLUTION_RAISE_DELAY;
+    } else {
+        return;
+    }
+
+    _dynamicResolutionSteps = steps;
+    RenderScriptingInterface::getInstance()->setDynamicResolutionScale(getDynamicResolutionScale());
+}
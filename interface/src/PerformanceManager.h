@@ -12,6 +12,7 @@
 #ifndef hifi_PerformanceManager_h
 #define hifi_PerformanceManager_h
 
+#include <atomic>
 #include <string>
 
 #include <SettingHandle.h>
@@ -39,10 +40,25 @@ public:
     void setPerformancePreset(PerformancePreset performancePreset);
     PerformancePreset getPerformancePreset() const;
 
+    // Dynamic resolution lowers the resolution of the main view, in steps, when the GPU time of the frames nears the frame
+    // period, and raises it again as the GPU time recovers, so the frame rate holds without the LOD dropping geometry.
+    // The view is upsampled to the display by the tone mapping's resample, after the antialiasing.
+    void setDynamicResolutionEnabled(bool enabled);
+    bool isDynamicResolutionEnabled() const { return _dynamicResolutionEnabled; }
+    float getDynamicResolutionScale() const;
+
+    // Once per frame on the main thread, with the average GPU time of the last frames in msecs
+    void updateDynamicResolution(float gpuTime, float targetFrameRate, float deltaTime);
+
 private:
     mutable ReadWriteLockable _performancePresetSettingLock;
     Setting::Handle<int> _performancePresetSetting { "performancePreset", PerformanceManager::PerformancePreset::UNKNOWN };
 
+    Setting::Handle<bool> _dynamicResolutionSetting { "dynamicResolution", false };
+    std::atomic<bool> _dynamicResolutionEnabled { false };
+    std::atomic<int> _dynamicResolutionSteps { 0 }; // how many steps the resolution is lowered
+    float _dynamicResolutionDelay { 0.0f }; // secs before the resolution may change again
+
     // The concrete performance preset changes
     void applyPerformancePreset(PerformanceManager::PerformancePreset performancePreset);
 };
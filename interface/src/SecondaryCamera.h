@@ -28,6 +28,9 @@ class SecondaryCameraJobConfig : public render::Task::Config { // Exposes second
     Q_PROPERTY(float farClipPlaneDistance MEMBER farClipPlaneDistance NOTIFY dirty)  // Secondary camera's far clip plane distance. In meters.
     Q_PROPERTY(bool mirrorProjection MEMBER mirrorProjection NOTIFY dirty)  // Flag to use attached mirror entity to build frustum for the mirror and set mirrored camera position/orientation.
     Q_PROPERTY(bool portalProjection MEMBER portalProjection NOTIFY dirty)  // Flag to use attached portal entity to build frustum for the portal and set portal camera position/orientation.
+    Q_PROPERTY(float workloadWeight MEMBER workloadWeight NOTIFY dirty)  // Scale of the workload regions around the secondary camera, relative to the main camera's. 0 adds no workload view.
+    Q_PROPERTY(float queryPriorityWeight MEMBER queryPriorityWeight NOTIFY dirty)  // Scale of the priority of the entities the entity server sends for the secondary camera, relative to the main camera's.
+    Q_PROPERTY(int queryBytesPerSecond MEMBER queryBytesPerSecond NOTIFY dirty)  // Most entity data the entity server sends a second for the secondary camera. 0 for no limit.
 public:
     QUuid attachedEntityId;
     QUuid portalEntranceEntityId;
@@ -40,6 +43,9 @@ public:
     int textureHeight { TextureCache::DEFAULT_SPECTATOR_CAM_HEIGHT };
     bool mirrorProjection { false };
     bool portalProjection { false };
+    float workloadWeight { 0.5f };
+    float queryPriorityWeight { 0.5f };
+    int queryBytesPerSecond { 0 };
 
     SecondaryCameraJobConfig() : render::Task::Config(false) {}
 signals:
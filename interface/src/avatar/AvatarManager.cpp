@@ -11,7 +11,9 @@
 
 #include "AvatarManager.h"
 
+#include <limits>
 #include <string>
+#include <thread>
 
 #include <QScriptEngine>
 
@@ -37,11 +39,14 @@
 #include <SettingHandle.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
+#include <AvatarImpostorStage.h>
+#include <TBBHelpers.h>
 #include <shared/ConicalViewFrustum.h>
 #include <ui/AvatarInputs.h>
 
 #include "Application.h"
 #include "InterfaceLogging.h"
+#include "LODManager.h"
 #include "Menu.h"
 #include "MyAvatar.h"
 #include "DebugDraw.h"
@@ -288,10 +293,27 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     const uint64_t MAX_UPDATE_HEROS_TIME_BUDGET = uint64_t(0.8 * MAX_UPDATE_AVATARS_TIME_BUDGET);
 
+    const size_t SIMULATION_BATCH_SIZE = std::max(1u, std::thread::hardware_concurrency());
+
     uint64_t updatePriorityExpiries[NumVariants] = { startTime + MAX_UPDATE_HEROS_TIME_BUDGET, startTime + MAX_UPDATE_AVATARS_TIME_BUDGET };
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
+    std::array<int, (int)Rig::AnimationLOD::NumLODs> numAvatarsPerAnimationLOD {};
+
+    const float lodHalfAngleTan = DependencyManager::get<LODManager>()->getLODHalfAngleTan();
+    // The avatars at the Low animation LOD are impostors once they are half the size of the Reduced threshold
+    const float IMPOSTOR_ANIMATION_LOD_SCALE = 0.5f * Rig::REDUCED_ANIMATION_LOD_SCALE;
+    const bool impostorsEnabled = _avatarImpostorsEnabled && _shouldRender && !_drawOtherAvatarSkeletons &&
+                                  qApp->getMain3DScene()->getStage<AvatarImpostorStage>();
+    int numImpostors = 0;
+    auto getViewDistance = [&views](const glm::vec3& position) {
+        float distance = std::numeric_limits<float>::max();
+        for (const auto& view : views) {
+            distance = std::min(distance, glm::distance(view.getPosition(), position));
+        }
+        return distance;
+    };
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
@@ -303,6 +325,33 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
         auto passExpiry = updatePriorityExpiries[p];
 
+        // The avatars are simulated in batches of about one per worker thread: their rigs are evaluated concurrently
+        // while all the steps touching shared state run on this thread, in priority order, before and after it.
+        // The time budget is checked before each avatar as it is added to a batch.
+        std::vector<std::pair<std::shared_ptr<OtherAvatar>, bool>> batch;
+        batch.reserve(SIMULATION_BATCH_SIZE);
+        auto simulateBatch = [&] {
+            tbb::parallel_for(size_t(0), batch.size(), [&](size_t i) {
+                batch[i].first->simulateJoints(deltaTime, batch[i].second);
+            });
+            for (const auto& entry : batch) {
+                const auto& avatar = entry.first;
+                avatar->postSimulate(deltaTime, entry.second);
+                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1 &&
+                    avatar->getSkeletonModel()->getRig().getAnimationLOD() == Rig::AnimationLOD::Full) {
+                    _myAvatar->addAvatarHandsToFlow(avatar);
+                }
+                if (_drawOtherAvatarSkeletons) {
+                    avatar->debugJointData();
+                }
+                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
+                avatar->updateRenderItem(renderTransaction);
+                avatar->updateSpaceProxy(workloadTransaction);
+                avatar->setLastRenderUpdateTime(startTime);
+            }
+            batch.clear();
+        };
+
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
             const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
@@ -334,23 +383,28 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
                 if (inView && avatar->hasNewJointData()) {
                     numAvatarsUpdated++;
                 }
+                float radius = avatar->getBoundingRadius();
+                float viewDistance = getViewDistance(avatar->getWorldPosition());
+                auto animationLOD = Rig::computeAnimationLOD(inView, radius, viewDistance, lodHalfAngleTan);
+                avatar->getSkeletonModel()->getRig().setAnimationLOD(animationLOD);
+                numAvatarsPerAnimationLOD[(int)animationLOD]++;
+                bool isImpostor = impostorsEnabled && animationLOD == Rig::AnimationLOD::Low &&
+                                  radius < viewDistance * lodHalfAngleTan * IMPOSTOR_ANIMATION_LOD_SCALE &&
+                                  avatar->getSkeletonModel()->isLoaded() && avatar->isInScene() &&
+                                  numImpostors < AvatarImpostorStage::MAX_IMPOSTORS;
+                avatar->setImpostor(isImpostor);
+                numImpostors += isImpostor ? 1 : 0;
                 auto transitStatus = avatar->_transit.update(deltaTime, avatar->_serverPosition, _transitConfig);
                 if (avatar->getIsNewAvatar() && (transitStatus == AvatarTransit::Status::START_TRANSIT ||
                                                  transitStatus == AvatarTransit::Status::ABORT_TRANSIT)) {
                     avatar->_transit.reset();
                     avatar->setIsNewAvatar(false);
                 }
-                avatar->simulate(deltaTime, inView);
-                if (avatar->getSkeletonModel()->isLoaded() && avatar->getWorkloadRegion() == workload::Region::R1) {
-                    _myAvatar->addAvatarHandsToFlow(avatar);
-                }
-                if (_drawOtherAvatarSkeletons) {
-                    avatar->debugJointData();
+                avatar->preSimulate(deltaTime, inView);
+                batch.emplace_back(avatar, inView);
+                if (batch.size() >= SIMULATION_BATCH_SIZE) {
+                    simulateBatch();
                 }
-                avatar->setEnableMeshVisible(!_drawOtherAvatarSkeletons);
-                avatar->updateRenderItem(renderTransaction);
-                avatar->updateSpaceProxy(workloadTransaction);
-                avatar->setLastRenderUpdateTime(startTime);
 
             } else {
                 // we've spent our time budget for this priority bucket
@@ -381,6 +435,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             }
         }
 
+        simulateBatch();
+
         if (p == kHero) {
             numHerosUpdated = numAvatarsUpdated;
         }
@@ -389,16 +445,45 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
+    updateAvatarImpostors(avatarMap);
 
     _space->enqueueTransaction(workloadTransaction);
 
     _numAvatarsUpdated = numAvatarsUpdated;
     _numAvatarsNotUpdated = numAvatarsNotUpdated;
     _numHeroAvatarsUpdated = numHerosUpdated;
+    _numAvatarsPerAnimationLOD = numAvatarsPerAnimationLOD;
 
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
 
+void AvatarManager::updateAvatarImpostors(const AvatarHash& avatarMap) {
+    auto impostorStage = qApp->getMain3DScene()->getStage<AvatarImpostorStage>();
+    if (!impostorStage) {
+        return;
+    }
+
+    // All the impostors, also the ones out of the time budget of this update
+    AvatarImpostorStage::Impostors impostors;
+    if (_shouldRender && _avatarImpostorsEnabled) {
+        for (const auto& avatarData : avatarMap) {
+            auto avatar = std::static_pointer_cast<Avatar>(avatarData);
+            if (avatar == _myAvatar || !avatar->isImpostor() || !avatar->isInScene() ||
+                (int)impostors.size() >= AvatarImpostorStage::MAX_IMPOSTORS) {
+                continue;
+            }
+            AvatarImpostorStage::Impostor impostor;
+            impostor.key = avatar->getRenderItemID();
+            render::metaFetchMetaSubItems(avatarData, impostor.itemIDs);
+            AABox bounds = avatar->getBounds();
+            impostor.center = bounds.calcCenter();
+            impostor.radius = 0.5f * glm::length(bounds.getDimensions());
+            impostors.push_back(std::move(impostor));
+        }
+    }
+    impostorStage->setImpostors(std::move(impostors));
+}
+
 void AvatarManager::postUpdate(float deltaTime, const render::ScenePointer& scene) {
     auto hashCopy = getHashCopy();
     AvatarHash::iterator avatarIterator = hashCopy.begin();
@@ -574,6 +659,7 @@ void AvatarManager::handleRemovedAvatar(const AvatarSharedPointer& removedAvatar
 
         const render::ScenePointer& scene = qApp->getMain3DScene();
         render::Transaction transaction;
+        avatar->releaseSkeletonModel(*_skeletonModelPool, transaction);
         avatar->removeFromScene(avatar, scene, transaction);
         scene->enqueueTransaction(transaction);
     } else {
@@ -585,7 +671,8 @@ void AvatarManager::handleRemovedAvatar(const AvatarSharedPointer& removedAvatar
         avatar->fadeOut(transaction, removalReason);
 
         workload::SpacePointer space = _space;
-        transaction.setTransitionFinishedOperator(avatar->getRenderItemID(), [space, avatar]() {
+        auto skeletonModelPool = _skeletonModelPool;
+        transaction.setTransitionFinishedOperator(avatar->getRenderItemID(), [space, skeletonModelPool, avatar]() {
             if (avatar->getLastFadeRequested() != render::Transition::Type::USER_LEAVE_DOMAIN) {
                 // The avatar is using another transition besides the fade-out transition, which means it is still in use.
                 // Deleting the avatar now could cause state issues, so abort deletion and show message.
@@ -593,6 +680,7 @@ void AvatarManager::handleRemovedAvatar(const AvatarSharedPointer& removedAvatar
             } else {
                 const render::ScenePointer& scene = qApp->getMain3DScene();
                 render::Transaction transaction;
+                avatar->releaseSkeletonModel(*skeletonModelPool, transaction);
                 avatar->removeFromScene(avatar, scene, transaction);
                 scene->enqueueTransaction(transaction);
 
@@ -635,6 +723,7 @@ void AvatarManager::clearOtherAvatars() {
 
 void AvatarManager::deleteAllAvatars() {
     _otherAvatarsToChangeInPhysics.clear();
+    _skeletonModelPool->clear();
     QReadLocker locker(&_hashLock);
     AvatarHash::iterator avatarIterator = _avatarHash.begin();
     while (avatarIterator != _avatarHash.end()) {
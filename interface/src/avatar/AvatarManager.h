@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarManager_h
 #define hifi_AvatarManager_h
 
+#include <array>
 #include <set>
 
 #include <QtCore/QHash>
@@ -102,6 +103,7 @@ public:
     void setSpace(workload::SpacePointer& space );
 
     std::shared_ptr<MyAvatar> getMyAvatar() { return _myAvatar; }
+    SkeletonModelPool& getSkeletonModelPool() { return *_skeletonModelPool; }
     glm::vec3 getMyAvatarPosition() const { return _myAvatar->getWorldPosition(); }
 
     /*@jsdoc 
@@ -116,6 +118,7 @@ public:
     int getNumAvatarsNotUpdated() const { return _numAvatarsNotUpdated; }
     int getNumHeroAvatars() const { return _numHeroAvatars; }
     int getNumHeroAvatarsUpdated() const { return _numHeroAvatarsUpdated; }
+    int getNumAvatarsAtAnimationLOD(Rig::AnimationLOD lod) const { return _numAvatarsPerAnimationLOD[(int)lod]; }
     float getAvatarSimulationTime() const { return _avatarSimulationTime; }
 
     void updateMyAvatar(float deltaTime);
@@ -270,6 +273,16 @@ public slots:
         _drawOtherAvatarSkeletons = isEnabled;
     }
 
+    /*@jsdoc
+    * Draws the distant avatars from captures of them instead of their meshes.
+    * @function AvatarManager.setEnableAvatarImpostors
+    * @param {boolean} enabled - <code>true</code> to draw the distant avatars as impostors, <code>false</code> to always
+    *     draw their meshes.
+    */
+    void setEnableAvatarImpostors(bool isEnabled) {
+        _avatarImpostorsEnabled = isEnabled;
+    }
+
 protected:
     AvatarSharedPointer addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer) override;
     DetailedMotionState* createDetailedMotionState(OtherAvatarPointer avatar, int32_t jointIndex);
@@ -289,6 +302,7 @@ private:
     void handleRemovedAvatar(const AvatarSharedPointer& removedAvatar,
                              KillAvatarReason removalReason = KillAvatarReason::NoReason) override;
     void handleTransitAnimations(AvatarTransit::Status status);
+    void updateAvatarImpostors(const AvatarHash& avatarMap);
 
     using SetOfOtherAvatars = std::set<OtherAvatarPointer>;
     SetOfOtherAvatars _otherAvatarsToChangeInPhysics;
@@ -303,6 +317,7 @@ private:
     int _numAvatarsNotUpdated { 0 };
     int _numHeroAvatars{ 0 };
     int _numHeroAvatarsUpdated{ 0 };
+    std::array<int, (int)Rig::AnimationLOD::NumLODs> _numAvatarsPerAnimationLOD {};
     float _avatarSimulationTime { 0.0f };
     bool _shouldRender { true };
     bool _myAvatarDataPacketsPaused { false };
@@ -310,8 +325,12 @@ private:
     mutable std::mutex _spaceLock;
     workload::SpacePointer _space;
 
+    // the models of the avatars that left, for the next ones with the same skeleton model URL
+    std::shared_ptr<SkeletonModelPool> _skeletonModelPool { std::make_shared<SkeletonModelPool>() };
+
     AvatarTransit::TransitConfig  _transitConfig;
     bool _drawOtherAvatarSkeletons { false };
+    bool _avatarImpostorsEnabled { true };
 };
 
 #endif // hifi_AvatarManager_h
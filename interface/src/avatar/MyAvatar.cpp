@@ -2742,6 +2742,26 @@ void MyAvatar::setControllerPoseInSensorFrame(controller::Action action, const c
     }
 }
 
+void MyAvatar::lateLatchControllerPoses() {
+    static const std::pair<controller::Action, controller::LatchedPoses::Channel> LATCHED_ACTIONS[] = {
+        { controller::Action::HEAD, controller::LatchedPoses::HEAD },
+        { controller::Action::LEFT_HAND, controller::LatchedPoses::LEFT_HAND },
+        { controller::Action::RIGHT_HAND, controller::LatchedPoses::RIGHT_HAND },
+    };
+
+    auto userInputMapper = DependencyManager::get<UserInputMapper>();
+    std::lock_guard<std::mutex> guard(_controllerPoseMapMutex);
+    for (const auto& latched : LATCHED_ACTIONS) {
+        auto iter = _controllerPoseMap.find(latched.first);
+        glm::mat4 correction;
+        // the poses are in sensor space, as the sampled ones are, so the device's motion applies to them as it is
+        if (iter != _controllerPoseMap.end() && iter->second.isValid() &&
+            userInputMapper->getLateLatchCorrection(latched.second, correction)) {
+            iter->second = iter->second.transform(correction);
+        }
+    }
+}
+
 controller::Pose MyAvatar::getControllerPoseInSensorFrame(controller::Action action) const {
     std::lock_guard<std::mutex> guard(_controllerPoseMapMutex);
     auto iter = _controllerPoseMap.find(action);
@@ -4397,6 +4417,24 @@ void MyAvatar::goToLocationAndEnableCollisions(const glm::vec3& position) { // S
     goToLocation(position);
     QMetaObject::invokeMethod(this, "setCollisionsEnabled", Qt::QueuedConnection, Q_ARG(bool, true));
 }
+void MyAvatar::prefetchLocation(const glm::vec3& position) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "prefetchLocation", Q_ARG(const glm::vec3&, position));
+        return;
+    }
+    const quint64 PREFETCH_HINT_DURATION = 5 * USECS_PER_SECOND;
+    _prefetchLocation = position;
+    _prefetchExpiry = usecTimestampNow() + PREFETCH_HINT_DURATION;
+}
+
+bool MyAvatar::getPrefetchLocation(glm::vec3& position) const {
+    if (usecTimestampNow() > _prefetchExpiry) {
+        return false;
+    }
+    position = _prefetchLocation;
+    return true;
+}
+
 bool MyAvatar::safeLanding(const glm::vec3& position) {
     // Considers all collision hull or non-collisionless primitive intersections on a vertical line through the point.
     // There needs to be a "landing" if:
@@ -6398,6 +6436,14 @@ float MyAvatar::getIKErrorOnLastSolve() const {
     return _skeletonModel->getRig().getIKErrorOnLastSolve();
 }
 
+int MyAvatar::getIKLoopsOnLastSolve() const {
+    return _skeletonModel->getRig().getIKLoopsOnLastSolve();
+}
+
+int MyAvatar::getIKTimeOnLastSolve() const {
+    return (int)_skeletonModel->getRig().getIKTimeOnLastSolve();
+}
+
 // thread-safe
 void MyAvatar::addHoldAction(AvatarActionHold* holdAction) {
     std::lock_guard<std::mutex> guard(_holdActionsMutex);
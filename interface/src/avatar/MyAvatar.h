@@ -1359,6 +1359,22 @@ public:
      */
     Q_INVOKABLE float getIKErrorOnLastSolve() const;
 
+    /*@jsdoc
+     * Gets the number of iterations of the most recent inverse kinematics (IK) solution. The solution stops iterating once
+     * the IK targets are reached or it gets no closer to them.
+     * @function MyAvatar.getIKLoopsOnLastSolve
+     * @returns {number} The number of IK iterations, <code>0</code> if the IK solution of the previous frame was reused
+     *     because its targets and starting pose were unchanged.
+     */
+    Q_INVOKABLE int getIKLoopsOnLastSolve() const;
+
+    /*@jsdoc
+     * Gets the time taken by the most recent inverse kinematics (IK) solution.
+     * @function MyAvatar.getIKTimeOnLastSolve
+     * @returns {number} The IK solution time, in microseconds.
+     */
+    Q_INVOKABLE int getIKTimeOnLastSolve() const;
+
     /*@jsdoc
      * Changes the user's avatar and associated descriptive name.
      * @function MyAvatar.useFullAvatarURL
@@ -1441,6 +1457,8 @@ public:
     void setResetMode(bool hasBeenReset) { _resetMode = hasBeenReset; }
 
     void setControllerPoseInSensorFrame(controller::Action action, const controller::Pose& pose);
+    // moves the head and hand poses to where the input thread last sampled their devices, since the devices updated
+    void lateLatchControllerPoses();
     controller::Pose getControllerPoseInSensorFrame(controller::Action action) const;
     controller::Pose getControllerPoseInWorldFrame(controller::Action action) const;
     controller::Pose getControllerPoseInAvatarFrame(controller::Action action) const;
@@ -1810,6 +1828,9 @@ public:
 
     bool isReadyForPhysics() const;
 
+    // the location last hinted with prefetchLocation, false once the hint has lapsed
+    bool getPrefetchLocation(glm::vec3& position) const;
+
     float computeStandingHeightMode(const controller::Pose& head);
     glm::quat computeAverageHeadRotation(const controller::Pose& head);
 
@@ -2127,6 +2148,14 @@ public slots:
      */
     void goToLocationAndEnableCollisions(const glm::vec3& newPosition);
 
+    /*@jsdoc
+     * Hints where the avatar is likely to go next, such as the target of a teleport being aimed, so that the entity server
+     * sends the entities around it ahead of arriving there, after those in view. The hint lapses after a few seconds.
+     * @function MyAvatar.prefetchLocation
+     * @param {Vec3} position - The likely destination, in world coordinates.
+     */
+    void prefetchLocation(const glm::vec3& position);
+
     /*@jsdoc
      * @function MyAvatar.safeLanding
      * @param {Vec3} position -The new position for the avatar, in world coordinates.
@@ -2935,6 +2964,8 @@ private:
     bool _goToFeetAjustment { false };
     glm::vec3 _goToPosition;
     glm::quat _goToOrientation;
+    glm::vec3 _prefetchLocation;
+    quint64 _prefetchExpiry { 0 };
 
     std::unordered_set<int> _headBoneSet;
     std::unordered_set<SpatiallyNestablePointer> _cauterizedChildrenOfHead;
@@ -14,6 +14,7 @@
 #include <AvatarLogging.h>
 
 #include "Application.h"
+#include "AvatarManager.h"
 #include "AvatarMotionState.h"
 #include "DetailedMotionState.h"
 #include "DebugDraw.h"
@@ -44,12 +45,63 @@ OtherAvatar::OtherAvatar(QThread* thread) : Avatar(thread) {
     // give the pointer to our head to inherited _headData variable from AvatarData
     _headData = new Head(this);
     _skeletonModel = std::make_shared<SkeletonModel>(this, nullptr);
+    connectSkeletonModel();
+}
+
+void OtherAvatar::connectSkeletonModel() {
     _skeletonModel->setLoadingPriority(OTHERAVATAR_LOADING_PRIORITY);
     connect(_skeletonModel.get(), &Model::setURLFinished, this, &Avatar::setModelURLFinished);
     connect(_skeletonModel.get(), &Model::rigReady, this, &Avatar::rigReady);
     connect(_skeletonModel.get(), &Model::rigReset, this, &Avatar::rigReset);
 }
 
+void OtherAvatar::setSkeletonModelURL(const QUrl& skeletonModelURL) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "setSkeletonModelURL", Q_ARG(const QUrl&, skeletonModelURL));
+        return;
+    }
+
+    // only a model that isn't loading or loaded yet, so it has nothing in the scene to remove
+    SkeletonModelPointer pooledModel;
+    if (!_skeletonModel->isLoaded() && _skeletonModel->getURL().isEmpty()) {
+        pooledModel = DependencyManager::get<AvatarManager>()->getSkeletonModelPool().acquire(skeletonModelURL);
+    }
+    if (pooledModel) {
+        disconnect(_skeletonModel.get(), nullptr, this, nullptr);
+        _skeletonModel = pooledModel;
+        _skeletonModel->setOwningAvatar(this);
+        connectSkeletonModel();
+    }
+
+    Avatar::setSkeletonModelURL(skeletonModelURL);
+
+    if (pooledModel && _skeletonModel->isLoaded()) {
+        // the model loaded for another avatar, its setURL() with the same URL does nothing
+        setModelURLFinished(true);
+        rigReady();
+    }
+}
+
+void OtherAvatar::releaseSkeletonModel(SkeletonModelPool& pool, render::Transaction& transaction) {
+    bool hasMaterials;
+    {
+        // the materials of the avatar are on its render items
+        std::lock_guard<std::mutex> lock(_materialsLock);
+        hasMaterials = !_materials.empty();
+    }
+    if (!_skeletonModel->isLoaded() || !_skeletonModel->isAddedToScene() || hasMaterials) {
+        return;
+    }
+
+    _skeletonModel->detachFromScene(transaction);
+    disconnect(_skeletonModel.get(), nullptr, this, nullptr);
+    _skeletonModel->setOwningAvatar(nullptr);
+    pool.release(_skeletonModel);
+
+    _skeletonModel = std::make_shared<SkeletonModel>(this, nullptr);
+    connectSkeletonModel();
+}
+
 OtherAvatar::~OtherAvatar() {
     removeOrb();
 }
@@ -250,7 +302,13 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
 
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
+    PerformanceTimer perfTimer("simulate");
+    preSimulate(deltaTime, inView);
+    simulateJoints(deltaTime, inView);
+    postSimulate(deltaTime, inView);
+}
 
+void OtherAvatar::preSimulate(float deltaTime, bool inView) {
     _globalPosition = _transit.isActive() ? _transit.getCurrentPosition() : _serverPosition;
     if (!hasParent()) {
         setLocalPosition(_globalPosition);
@@ -260,40 +318,57 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     if (inView) {
         _simulationInViewRate.increment();
     }
+}
 
-    PerformanceTimer perfTimer("simulate");
-    {
-        PROFILE_RANGE(simulation, "updateJoints");
-        if (inView) {
-            Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, true);
-
-                locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
-            } else {
-                head->simulate(deltaTime);
-                _skeletonModel->simulate(deltaTime, false);
+void OtherAvatar::simulateJoints(float deltaTime, bool inView) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    _jointsChanged = false;
+    if (inView) {
+        Head* head = getHead();
+        bool updateJoints = _hasNewJointData || _transit.isActive();
+        uint64_t now = usecTimestampNow();
+        if (updateJoints && _skeletonModel->getRig().getAnimationLOD() == Rig::AnimationLOD::Low) {
+            // the new joint data waits for the next update
+            const uint64_t LOW_LOD_UPDATE_PERIOD = (uint64_t)(USECS_PER_SECOND / Rig::LOW_ANIMATION_LOD_UPDATE_RATE);
+            updateJoints = now - _lastJointsUpdateTime >= LOW_LOD_UPDATE_PERIOD;
+        }
+        if (updateJoints) {
+            _lastJointsUpdateTime = now;
+            _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+            glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+            _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            _jointDataSimulationRate.increment();
+
+            head->simulate(deltaTime);
+            _skeletonModel->simulate(deltaTime, true);
+
+            _jointsChanged = true;
+            _hasNewJointData = false;
+
+            glm::vec3 headPosition = getWorldPosition();
+            if (!_skeletonModel->getHeadPosition(headPosition)) {
+                headPosition = getWorldPosition();
             }
-            head->setScale(getModelScale());
-            relayJointDataToChildren();
+            head->setPosition(headPosition);
         } else {
-            // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+            head->simulate(deltaTime);
             _skeletonModel->simulate(deltaTime, false);
         }
-        _skeletonModelSimulationRate.increment();
+        head->setScale(getModelScale());
+    } else {
+        // a non-full update is still required so that the position, rotation, scale and bounds of the skeletonModel are updated.
+        _skeletonModel->simulate(deltaTime, false);
+    }
+    _skeletonModelSimulationRate.increment();
+}
+
+void OtherAvatar::postSimulate(float deltaTime, bool inView) {
+    if (_jointsChanged) {
+        locationChanged(); // joints changed, so if there are any children, update them.
+        _jointsChanged = false;
+    }
+    if (inView) {
+        relayJointDataToChildren();
     }
 
     // update animation for display name fade in/out
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include <avatars-renderer/Avatar.h>
+#include <avatars-renderer/SkeletonModelPool.h>
 #include <workload/Space.h>
 
 #include "InterfaceLogging.h"
@@ -38,6 +39,12 @@ public:
     void updateOrbPosition();
     void removeOrb();
 
+    // takes a model from the AvatarManager's SkeletonModelPool when there is one for the URL
+    void setSkeletonModelURL(const QUrl& skeletonModelURL) override;
+    // Detaches the skeleton model from the scene into the transaction and hands it to the pool, with its render items.
+    // Call before removeFromScene(), the avatar is left with an empty model.
+    void releaseSkeletonModel(SkeletonModelPool& pool, render::Transaction& transaction);
+
     void setSpaceIndex(int32_t index);
     int32_t getSpaceIndex() const { return _spaceIndex; }
     void updateSpaceProxy(workload::Transaction& transaction) const;
@@ -64,10 +71,22 @@ public:
     void setCollisionWithOtherAvatarsFlags() override;
 
     void simulate(float deltaTime, bool inView) override;
+
+    // simulate() in three steps, so the rig evaluation of several avatars can run concurrently:
+    // preSimulate() and postSimulate() must run on the main thread, simulateJoints() only touches this avatar's
+    // rig, head and skeleton model and can run on any thread between them
+    void preSimulate(float deltaTime, bool inView);
+    void simulateJoints(float deltaTime, bool inView);
+    void postSimulate(float deltaTime, bool inView);
     void debugJointData() const;
     friend AvatarManager;
 
 protected:
+    void connectSkeletonModel();
+
+    bool _jointsChanged { false };
+    uint64_t _lastJointsUpdateTime { 0 };
+
     void handleChangedAvatarEntityData();
     void updateAttachedAvatarEntities();
     void onAddAttachedAvatarEntity(const QUuid& id);
@@ -24,7 +24,8 @@ OctreePacketProcessor::OctreePacketProcessor():
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     const PacketReceiver::PacketTypeList octreePackets =
-        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete };
+        { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase, PacketType::EntityQueryInitialResultsComplete,
+          PacketType::EntityPhysicsState };
     packetReceiver.registerDirectListenerForTypes(octreePackets,
         PacketReceiver::makeSourcedListenerReference<OctreePacketProcessor>(this, &OctreePacketProcessor::handleOctreePacket));
 }
@@ -92,7 +93,8 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
         return; // bail since piggyback version doesn't match
     }
 
-    if (packetType != PacketType::EntityQueryInitialResultsComplete) {
+    // the relayed physics states are out of the octree packet sequence
+    if (packetType != PacketType::EntityQueryInitialResultsComplete && packetType != PacketType::EntityPhysicsState) {
         qApp->trackIncomingOctreePacket(*message, sendingNode, wasStatsPacket);
     }
     
@@ -125,6 +127,15 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
             }
         } break;
 
+        case PacketType::EntityPhysicsState: {
+            if (DependencyManager::get<SceneScriptingInterface>()->shouldRenderEntities()) {
+                auto renderer = qApp->getEntities();
+                if (renderer) {
+                    renderer->getTree()->processPhysicsStateMessage(*message, sendingNode);
+                }
+            }
+        } break;
+
         case PacketType::EntityQueryInitialResultsComplete: {
             // Read sequence #
             OCTREE_PACKET_SEQUENCE completionNumber;
@@ -25,31 +25,66 @@ PickRay RayPick::getMathematicalPick() const {
     return PickRay(origin, direction);
 }
 
-PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
-    PickFilter searchFilter = getFilter();
+PickFilter RayPick::getEntitySearchFilter(const PickFilter& filter) {
+    PickFilter searchFilter = filter;
     if (DependencyManager::get<PickManager>()->getForceCoarsePicking()) {
         searchFilter.setFlag(PickFilter::COARSE, true);
         searchFilter.setFlag(PickFilter::PRECISE, false);
     }
+    return searchFilter;
+}
+
+PickResultPointer RayPick::makeEntityResult(const PickFilter& filter, const PickRay& pick, const EntityItemID& entityID,
+        float distance, const glm::vec3& surfaceNormal, const QVariantMap& extraInfo) {
+    IntersectionType type = IntersectionType::ENTITY;
+    if (filter.doesPickLocalEntities()) {
+        EntityPropertyFlags desiredProperties;
+        desiredProperties += PROP_ENTITY_HOST_TYPE;
+        if (DependencyManager::get<EntityScriptingInterface>()->getEntityProperties(entityID, desiredProperties).getEntityHostType() == entity::HostType::LOCAL) {
+            type = IntersectionType::LOCAL_ENTITY;
+        }
+    }
+    return std::make_shared<RayPickResult>(type, entityID, distance, pick.origin + distance * pick.direction, pick, surfaceNormal, extraInfo);
+}
 
+PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
     RayToEntityIntersectionResult entityRes =
-        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, searchFilter,
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, getEntitySearchFilter(getFilter()),
             getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
     if (entityRes.intersects) {
-        IntersectionType type = IntersectionType::ENTITY;
-        if (getFilter().doesPickLocalEntities()) {
-            EntityPropertyFlags desiredProperties;
-            desiredProperties += PROP_ENTITY_HOST_TYPE;
-            if (DependencyManager::get<EntityScriptingInterface>()->getEntityProperties(entityRes.entityID, desiredProperties).getEntityHostType() == entity::HostType::LOCAL) {
-                type = IntersectionType::LOCAL_ENTITY;
-            }
-        }
-        return std::make_shared<RayPickResult>(type, entityRes.entityID, entityRes.distance, entityRes.intersection, pick, entityRes.surfaceNormal, entityRes.extraInfo);
+        return makeEntityResult(getFilter(), pick, entityRes.entityID, entityRes.distance, entityRes.surfaceNormal, entityRes.extraInfo);
     } else {
         return std::make_shared<RayPickResult>(pick.toVariantMap());
     }
 }
 
+bool RayPick::getEntityIntersections(const std::vector<std::shared_ptr<Pick<PickRay>>>& picks, const std::vector<PickRay>& mathPicks,
+                                     std::vector<PickResultPointer>& results) {
+    std::vector<EntityTree::RayQuery> queries(picks.size());
+    for (size_t i = 0; i < picks.size(); i++) {
+        auto& query = queries[i];
+        query.origin = mathPicks[i].origin;
+        query.direction = mathPicks[i].direction;
+        query.searchFilter = getEntitySearchFilter(picks[i]->getFilter());
+        query.entityIdsToInclude = picks[i]->getIncludeItemsAs<EntityItemID>();
+        query.entityIdsToDiscard = picks[i]->getIgnoreItemsAs<EntityItemID>();
+    }
+
+    DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVectors(queries);
+
+    results.resize(picks.size());
+    for (size_t i = 0; i < picks.size(); i++) {
+        const auto& query = queries[i];
+        if (!query.entityID.isNull()) {
+            results[i] = makeEntityResult(picks[i]->getFilter(), mathPicks[i], query.entityID, query.distance,
+                query.surfaceNormal, query.extraInfo);
+        } else {
+            results[i] = std::make_shared<RayPickResult>(mathPicks[i].toVariantMap());
+        }
+    }
+    return true;
+}
+
 PickResultPointer RayPick::getAvatarIntersection(const PickRay& pick) {
     bool precisionPicking = !(getFilter().isCoarse() || DependencyManager::get<PickManager>()->getForceCoarsePicking());
     RayToAvatarIntersectionResult avatarRes = DependencyManager::get<AvatarManager>()->findRayIntersectionVector(pick, getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>(), precisionPicking);
@@ -96,6 +96,8 @@ public:
     PickResultPointer getEntityIntersection(const PickRay& pick) override;
     PickResultPointer getAvatarIntersection(const PickRay& pick) override;
     PickResultPointer getHUDIntersection(const PickRay& pick) override;
+    bool getEntityIntersections(const std::vector<std::shared_ptr<Pick<PickRay>>>& picks, const std::vector<PickRay>& mathPicks,
+                                std::vector<PickResultPointer>& results) override;
     Transform getResultTransform() const override;
 
     // These are helper functions for projecting and intersecting rays
@@ -106,6 +108,9 @@ public:
     static glm::vec2 projectOntoXZPlane(const glm::vec3& worldPos, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& dimensions, const glm::vec3& registrationPoint, bool unNoemalized);
 
 private:
+    static PickFilter getEntitySearchFilter(const PickFilter& filter);
+    static PickResultPointer makeEntityResult(const PickFilter& filter, const PickRay& pick, const EntityItemID& entityID,
+        float distance, const glm::vec3& surfaceNormal, const QVariantMap& extraInfo);
     static glm::vec3 intersectRayWithXYPlane(const glm::vec3& origin, const glm::vec3& direction, const glm::vec3& point, const glm::quat& rotation, const glm::vec3& registration);
 };
 
@@ -58,3 +58,16 @@ RefreshRateManager::UXMode PerformanceScriptingInterface::getUXMode() const {
 RefreshRateManager::RefreshRateRegime PerformanceScriptingInterface::getRefreshRateRegime() const {
     return qApp->getRefreshRateManager().getRefreshRateRegime();
 }
+
+void PerformanceScriptingInterface::setDynamicResolutionEnabled(bool enabled) {
+    qApp->getPerformanceManager().setDynamicResolutionEnabled(enabled);
+    emit settingsChanged();
+}
+
+bool PerformanceScriptingInterface::getDynamicResolutionEnabled() const {
+    return qApp->getPerformanceManager().isDynamicResolutionEnabled();
+}
+
+float PerformanceScriptingInterface::getDynamicResolutionScale() const {
+    return qApp->getPerformanceManager().getDynamicResolutionScale();
+}
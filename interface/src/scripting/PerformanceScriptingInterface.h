@@ -162,6 +162,29 @@ public slots:
      */
     RefreshRateManager::RefreshRateRegime getRefreshRateRegime() const;
 
+    /*@jsdoc
+     * Sets whether the resolution of the view is lowered when the GPU can't keep up with the refresh rate, and raised again 
+     * as it recovers. The view is scaled down to no less than half of {@link Render|Render.viewportResolutionScale}.
+     * @function Performance.setDynamicResolutionEnabled
+     * @param {boolean} enabled - <code>true</code> to scale the resolution with the GPU load, <code>false</code> to keep it 
+     *     fixed.
+     */
+    void setDynamicResolutionEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the resolution of the view is scaled with the GPU load.
+     * @function Performance.getDynamicResolutionEnabled
+     * @returns {boolean} <code>true</code> if the resolution is scaled with the GPU load, <code>false</code> if it's fixed.
+     */
+    bool getDynamicResolutionEnabled() const;
+
+    /*@jsdoc
+     * Gets the scale the dynamic resolution currently applies to {@link Render|Render.viewportResolutionScale}.
+     * @function Performance.getDynamicResolutionScale
+     * @returns {number} The dynamic resolution scale, between <code>0.5</code> and <code>1.0</code>.
+     */
+    float getDynamicResolutionScale() const;
+
 signals:
 
     /*@jsdoc
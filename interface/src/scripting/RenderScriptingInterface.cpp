@@ -39,6 +39,43 @@ void RenderScriptingInterface::loadSettings() {
     forceViewportResolutionScale(_viewportResolutionScale);
 }
 
+QVariantList RenderScriptingInterface::getGPUJobTimes() const {
+    QVariantList times;
+    for (const auto& stats : qApp->getRenderEngine()->getGPUJobTimers()->getStats()) {
+        QVariantList histogram;
+        for (auto count : stats.histogram) {
+            histogram.push_back(count);
+        }
+        QVariantMap time;
+        time["path"] = QString::fromStdString(stats.path);
+        time["isTask"] = stats.isTask;
+        time["samples"] = stats.numSamples;
+        time["average"] = stats.average;
+        time["median"] = stats.median;
+        time["percentile95"] = stats.percentile95;
+        time["max"] = stats.max;
+        time["histogram"] = histogram;
+        times.push_back(time);
+    }
+    return times;
+}
+
+QVariantList RenderScriptingInterface::getGPUJobTimeHistogramBounds() const {
+    QVariantList bounds;
+    for (auto bound : render::GPUJobTimers::HISTOGRAM_BOUNDS) {
+        bounds.push_back(bound);
+    }
+    return bounds;
+}
+
+bool RenderScriptingInterface::getGPUJobTimersEnabled() const {
+    return qApp->getRenderEngine()->getGPUJobTimers()->isEnabled();
+}
+
+void RenderScriptingInterface::setGPUJobTimersEnabled(bool enabled) {
+    qApp->getRenderEngine()->getGPUJobTimers()->setEnabled(enabled);
+}
+
 RenderScriptingInterface::RenderMethod RenderScriptingInterface::getRenderMethod() const {
     return (RenderMethod) _renderMethod;
 }
@@ -188,18 +225,41 @@ void RenderScriptingInterface::forceViewportResolutionScale(float scale) {
     _renderSettingLock.withWriteLock([&] {
         _viewportResolutionScale = (scale);
         _viewportResolutionScaleSetting.set(scale);
+        applyResolutionScale();
+    });
+}
 
-        auto renderConfig = qApp->getRenderEngine()->getConfiguration();
-        assert(renderConfig);
-        auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
-        // mainView can be null if we're rendering in forward mode
-        if (deferredView) {
-            deferredView->setProperty("resolutionScale", _viewportResolutionScale);
-        }
-        auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
-        // mainView can be null if we're rendering in forward mode
-        if (forwardView) {
-            forwardView->setProperty("resolutionScale", _viewportResolutionScale);
+void RenderScriptingInterface::setDynamicResolutionScale(float scale) {
+    if (scale <= 0.f) {
+        return;
+    }
+    _renderSettingLock.withWriteLock([&] {
+        if (_dynamicResolutionScale != scale) {
+            _dynamicResolutionScale = scale;
+            applyResolutionScale();
         }
     });
 }
+
+float RenderScriptingInterface::getDynamicResolutionScale() const {
+    return _renderSettingLock.resultWithReadLock<float>([&] {
+        return _dynamicResolutionScale;
+    });
+}
+
+void RenderScriptingInterface::applyResolutionScale() {
+    float resolutionScale = _viewportResolutionScale * _dynamicResolutionScale;
+
+    auto renderConfig = qApp->getRenderEngine()->getConfiguration();
+    assert(renderConfig);
+    auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
+    // mainView can be null if we're rendering in forward mode
+    if (deferredView) {
+        deferredView->setProperty("resolutionScale", resolutionScale);
+    }
+    auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
+    // mainView can be null if we're rendering in forward mode
+    if (forwardView) {
+        forwardView->setProperty("resolutionScale", resolutionScale);
+    }
+}
@@ -45,6 +45,10 @@ public:
 
     static RenderScriptingInterface* getInstance();
 
+    // A further scale of the viewport resolution, set each frame by PerformanceManager's dynamic resolution and not saved
+    void setDynamicResolutionScale(float scale);
+    float getDynamicResolutionScale() const;
+
     /*@jsdoc
      * <p>The rendering method is specified by the following values:</p>
      * <table>
@@ -84,6 +88,48 @@ public slots:
      */
     QObject* getConfig(const QString& name) { return qApp->getRenderEngine()->getConfiguration()->getConfig(name); }
 
+    /*@jsdoc
+     * Gets the GPU times of the rendering jobs over the last few hundred frames. Each job's time includes the times of
+     * the jobs it runs.
+     * @function Render.getGPUJobTimes
+     * @returns {Render.GPUJobTime[]} The times of the jobs, in the order they run.
+     */
+    /*@jsdoc
+     * The GPU time of a rendering job.
+     * @typedef {object} Render.GPUJobTime
+     * @property {string} path - The job's path, as {@link Render.getConfig} takes it.
+     * @property {boolean} isTask - <code>true</code> if the job is a task, whose time includes its jobs'.
+     * @property {number} samples - The number of frames timed.
+     * @property {number} average - The average time, in ms.
+     * @property {number} median - The median time, in ms.
+     * @property {number} percentile95 - The 95th percentile of the times, in ms.
+     * @property {number} max - The longest time, in ms.
+     * @property {number[]} histogram - The number of frames in each of the buckets bounded by
+     *     {@link Render.getGPUJobTimeHistogramBounds}, plus a last bucket for the longer times.
+     */
+    QVariantList getGPUJobTimes() const;
+
+    /*@jsdoc
+     * Gets the upper bounds of the buckets of the histograms of {@link Render.getGPUJobTimes}.
+     * @function Render.getGPUJobTimeHistogramBounds
+     * @returns {number[]} The bounds, in ms.
+     */
+    QVariantList getGPUJobTimeHistogramBounds() const;
+
+    /*@jsdoc
+     * Gets whether the GPU times of the rendering jobs are recorded.
+     * @function Render.getGPUJobTimersEnabled
+     * @returns {boolean} <code>true</code> if the jobs are timed, <code>false</code> if they aren't.
+     */
+    bool getGPUJobTimersEnabled() const;
+
+    /*@jsdoc
+     * Sets whether the GPU times of the rendering jobs are recorded.
+     * @function Render.setGPUJobTimersEnabled
+     * @param {boolean} enabled - <code>true</code> to time the jobs, <code>false</code> not to.
+     */
+    void setGPUJobTimersEnabled(bool enabled);
+
 
     /*@jsdoc
      * Gets the render method being used.
@@ -196,6 +242,7 @@ private:
     bool _ambientOcclusionEnabled{ false };
     AntialiasingConfig::Mode _antialiasingMode{ AntialiasingConfig::Mode::TAA };
     float _viewportResolutionScale{ 1.0f };
+    float _dynamicResolutionScale{ 1.0f };
 
     // Actual settings saved on disk
     Setting::Handle<int> _renderMethodSetting { "renderMethod", RENDER_FORWARD ? render::Args::RenderMethod::FORWARD : render::Args::RenderMethod::DEFERRED };
@@ -212,6 +259,9 @@ private:
     void forceAntialiasingMode(AntialiasingConfig::Mode mode);
     void forceViewportResolutionScale(float scale);
 
+    // Under the write lock
+    void applyResolutionScale();
+
     static std::once_flag registry_flag;
 };
 
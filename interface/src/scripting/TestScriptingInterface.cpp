@@ -7,15 +7,25 @@
 //
 #include "TestScriptingInterface.h"
 
+#include <algorithm>
+
 #include <QtCore/QCoreApplication>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTextStream>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QThread>
 
 #include <shared/FileUtils.h>
 #include <shared/QtHelpers.h>
 #include <DependencyManager.h>
+#include <gpu/Context.h>
+#include <GPUIdent.h>
 #include <MainWindow.h>
+#include <NumericalConstants.h>
 #include <OffscreenUi.h>
+#include <plugins/DisplayPlugin.h>
 #include <StatTracker.h>
 #include <Trace.h>
 
@@ -82,6 +92,31 @@ bool TestScriptingInterface::loadTestScene(QString scene) {
     return result;
 }
 
+bool TestScriptingInterface::loadTestSceneFile(QString sceneFile) {
+    if (QThread::currentThread() != thread()) {
+        bool result;
+        BLOCKING_INVOKE_METHOD(this, "loadTestSceneFile", Q_RETURN_ARG(bool, result), Q_ARG(QString, sceneFile));
+        return result;
+    }
+
+    QFileInfo sceneInfo(sceneFile);
+    if (!sceneInfo.exists()) {
+        qCWarning(trace_test) << "Test scene" << sceneFile << "does not exist";
+        return false;
+    }
+
+    // the assets of the snapshot sit beside it, as those of the scenes of loadTestScene sit beside theirs
+    QString assetsPath = sceneInfo.absolutePath() + "/" + sceneInfo.completeBaseName() + ".atp/";
+    DependencyManager::get<ResourceManager>()->setUrlPrefixOverride("atp:/", QUrl::fromLocalFile(assetsPath).toString());
+    auto tree = qApp->getEntities()->getTree();
+    auto treeIsClient = tree->getIsClient();
+    // Force the tree to accept the load regardless of permissions
+    tree->setIsClient(false);
+    auto result = tree->readFromURL(QUrl::fromLocalFile(sceneInfo.absoluteFilePath()).toString());
+    tree->setIsClient(treeIsClient);
+    return result;
+}
+
 bool TestScriptingInterface::startTracing(QString logrules) {
     if (!logrules.isEmpty()) {
         QLoggingCategory::setFilterRules(logrules);
@@ -144,6 +179,136 @@ void TestScriptingInterface::endTraceEvent(QString name) {
     tracing::traceEvent(trace_test(), name, tracing::DurationEnd);
 }
 
+void TestScriptingInterface::startFrameTimings() {
+    std::lock_guard<std::mutex> lock(_frameTimingsMutex);
+    _frameTimings.clear();
+    _lastFrameTimed = qApp->getRenderFrameCount();
+    _frameTimingsTimer.start();
+    _recordingFrameTimings = true;
+}
+
+void TestScriptingInterface::updateFrameTimings() {
+    std::lock_guard<std::mutex> lock(_frameTimingsMutex);
+    if (!_recordingFrameTimings) {
+        return;
+    }
+
+    // the application updates at least as often as it renders, so take one sample per frame rendered since the last
+    auto frame = qApp->getRenderFrameCount();
+    if (frame == _lastFrameTimed) {
+        return;
+    }
+    _lastFrameTimed = frame;
+
+    auto gpuContext = qApp->getGPUContext();
+    gpu::ContextStats gpuStats;
+    gpuContext->getFrameStats(gpuStats);
+
+    FrameTimings timings;
+    timings.frame = (uint32_t)frame;
+    timings.time = (float)_frameTimingsTimer.nsecsElapsed() / (float)NSECS_PER_MSEC;
+    timings.presentTime = qApp->getActiveDisplayPlugin()->getAveragePresentTime();
+    timings.engineRunTime = (float)qApp->getRenderEngine()->getConfiguration()->getCPURunTime();
+    timings.batchTime = (float)gpuContext->getFrameTimerBatchLatest();
+    timings.gpuTime = (float)gpuContext->getFrameTimerGPULatest();
+    timings.drawcalls = gpuStats._DSNumDrawcalls;
+    timings.apiDrawcalls = gpuStats._DSNumAPIDrawcalls;
+    timings.triangles = gpuStats._DSNumTriangles;
+    timings.pipelineChanges = gpuStats._PSNumSetPipelines;
+    _frameTimings.push_back(timings);
+}
+
+bool TestScriptingInterface::stopFrameTimings(QString filename) {
+    std::vector<FrameTimings> frameTimings;
+    {
+        std::lock_guard<std::mutex> lock(_frameTimingsMutex);
+        if (!_recordingFrameTimings) {
+            return false;
+        }
+        _recordingFrameTimings = false;
+        frameTimings.swap(_frameTimings);
+    }
+
+    QString path = FileUtils::replaceDateTimeTokens(filename);
+    if (QFileInfo(path).isRelative() && !_testResultsLocation.isEmpty()) {
+        path = QDir::cleanPath(_testResultsLocation + "/" + path);
+    } else {
+        path = FileUtils::computeDocumentPath(path);
+    }
+    if (!FileUtils::canCreateFile(path)) {
+        return false;
+    }
+
+    QByteArray data;
+    if (path.endsWith(".json", Qt::CaseInsensitive)) {
+        QJsonArray frames;
+        std::vector<float> cpuTimes;
+        std::vector<float> gpuTimes;
+        for (const auto& timings : frameTimings) {
+            QJsonObject frame;
+            frame["frame"] = (qint64)timings.frame;
+            frame["time"] = timings.time;
+            frame["presentTime"] = timings.presentTime;
+            frame["engineRunTime"] = timings.engineRunTime;
+            frame["batchTime"] = timings.batchTime;
+            frame["gpuTime"] = timings.gpuTime;
+            frame["drawcalls"] = (qint64)timings.drawcalls;
+            frame["apiDrawcalls"] = (qint64)timings.apiDrawcalls;
+            frame["triangles"] = (qint64)timings.triangles;
+            frame["pipelineChanges"] = (qint64)timings.pipelineChanges;
+            frames.append(frame);
+            cpuTimes.push_back(timings.engineRunTime);
+            gpuTimes.push_back(timings.gpuTime);
+        }
+
+        auto summarize = [](std::vector<float>& times) {
+            QJsonObject summary;
+            if (times.empty()) {
+                return summary;
+            }
+            std::sort(times.begin(), times.end());
+            float total = 0.0f;
+            for (auto time : times) {
+                total += time;
+            }
+            summary["average"] = total / (float)times.size();
+            summary["median"] = times[times.size() / 2];
+            summary["percentile99"] = times[(times.size() * 99) / 100];
+            summary["max"] = times.back();
+            return summary;
+        };
+
+        QJsonObject report;
+        report["gpu"] = GPUIdent::getInstance()->getName();
+        report["driver"] = GPUIdent::getInstance()->getDriver();
+        report["frameCount"] = (qint64)frameTimings.size();
+        if (!frameTimings.empty()) {
+            report["duration"] = frameTimings.back().time;
+        }
+        report["engineRunTime"] = summarize(cpuTimes);
+        report["gpuTime"] = summarize(gpuTimes);
+        report["frames"] = frames;
+        data = QJsonDocument(report).toJson();
+    } else {
+        QTextStream stream(&data);
+        stream << "frame,time,presentTime,engineRunTime,batchTime,gpuTime,drawcalls,apiDrawcalls,triangles,pipelineChanges\n";
+        for (const auto& timings : frameTimings) {
+            stream << timings.frame << "," << timings.time << "," << timings.presentTime << "," << timings.engineRunTime << ","
+                << timings.batchTime << "," << timings.gpuTime << "," << timings.drawcalls << "," << timings.apiDrawcalls << ","
+                << timings.triangles << "," << timings.pipelineChanges << "\n";
+        }
+        stream.flush();
+    }
+
+    QFile file(path);
+    if (!file.open(QFile::WriteOnly)) {
+        return false;
+    }
+    file.write(data);
+    file.close();
+    return true;
+}
+
 void TestScriptingInterface::savePhysicsSimulationStats(QString originalPath) {
     QString path = FileUtils::replaceDateTimeTokens(originalPath);
     path = FileUtils::computeDocumentPath(path);
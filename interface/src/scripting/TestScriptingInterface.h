@@ -11,6 +11,9 @@
 #define hifi_TestScriptingInterface_h
 
 #include <functional>
+#include <mutex>
+#include <vector>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QObject>
 
 class QScriptValue;
@@ -21,6 +24,10 @@ class TestScriptingInterface : public QObject {
 public:
     void setTestResultsLocation(const QString path) { _testResultsLocation = path; }
     const QString& getTestResultsLocation() { return _testResultsLocation;  };
+    void setTestSceneLocation(const QString path) { _testSceneLocation = path; }
+
+    // called by the application every update, to sample the latest frame rendered while the frame timings are recorded
+    void updateFrameTimings();
 
 public slots:
     static TestScriptingInterface* getInstance();
@@ -76,6 +83,23 @@ public slots:
     */
     bool loadTestScene(QString sceneFile);
 
+    /*@jsdoc
+    * Loads a scene from a local entities JSON file, such as an export of a domain, regardless of permissions. The
+    * <code>atp:/</code> URLs of the scene are looked up in the directory beside it named after the file with an
+    * <code>.atp</code> extension, so that a snapshot of a domain plays back without its asset server.
+    * @function Test.loadTestSceneFile
+    * @param {string} sceneFile - Path of the scene to load
+    * @returns {boolean} <code>true</code> if the scene loaded.
+    */
+    bool loadTestSceneFile(QString sceneFile);
+
+    /*@jsdoc
+    * Returns the scene file given on the command line with <code>--testScene</code>
+    * @function Test.getTestSceneLocation
+    * @returns {string} Path of the scene, empty if none was given
+    */
+    QString getTestSceneLocation() const { return _testSceneLocation; }
+
     /*@jsdoc
     * Clears all caches
     * @function Test.clear
@@ -114,6 +138,23 @@ public slots:
     */
     void endTraceEvent(QString name);
 
+    /*@jsdoc
+    * Start recording the timings of each frame rendered: the CPU time of the render engine, the time to record and to
+    * execute its batches on the GPU, the present time of the display, and the draw calls and triangles of the frame
+    * @function Test.startFrameTimings
+    */
+    void startFrameTimings();
+
+    /*@jsdoc
+    * Stop recording frame timings and write the recorded frames to a file, as CSV, or as JSON with a summary of the
+    * timings if the filename has a .json extension. A relative filename is taken from the test results location if one
+    * was given, else from the documents directory.
+    * @function Test.stopFrameTimings
+    * @param {string} filename - Name of file to save to
+    * @returns {bool} True if successful.
+    */
+    bool stopFrameTimings(QString filename);
+
     /*@jsdoc
      * Write detailed timing stats of next physics stepSimulation() to filename
      * @function Test.savePhysicsSimulationStats
@@ -178,8 +219,28 @@ public slots:
     Q_INVOKABLE bool isTextureLoadingComplete();
 
 private:
+    struct FrameTimings {
+        uint32_t frame { 0 };
+        float time { 0.0f }; // msec since the recording started
+        float presentTime { 0.0f }; // msec
+        float engineRunTime { 0.0f };
+        float batchTime { 0.0f };
+        float gpuTime { 0.0f };
+        uint32_t drawcalls { 0 };
+        uint32_t apiDrawcalls { 0 };
+        uint32_t triangles { 0 };
+        uint32_t pipelineChanges { 0 };
+    };
+
     bool waitForCondition(qint64 maxWaitMs, std::function<bool()> condition);
     QString _testResultsLocation;
+    QString _testSceneLocation;
+
+    std::mutex _frameTimingsMutex;
+    bool _recordingFrameTimings { false };
+    QElapsedTimer _frameTimingsTimer;
+    size_t _lastFrameTimed { 0 };
+    std::vector<FrameTimings> _frameTimings;
 };
 
 #endif  // hifi_TestScriptingInterface_h
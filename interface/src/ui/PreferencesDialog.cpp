@@ -129,6 +129,12 @@ void setupPreferences() {
         scaleSlider->setStep(0.02f);
         preferences->addPreference(scaleSlider);
     }
+    {
+        // Lower the resolution below the scale when the GPU falls behind
+        auto getter = []()->bool { return qApp->getPerformanceManager().isDynamicResolutionEnabled(); };
+        auto setter = [](bool value) { qApp->getPerformanceManager().setDynamicResolutionEnabled(value); };
+        preferences->addPreference(new CheckPreference(GRAPHICS_QUALITY, "Dynamic Resolution", getter, setter));
+    }
 
     // UI
     static const QString UI_CATEGORY { "User Interface" };
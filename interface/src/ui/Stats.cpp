@@ -130,6 +130,10 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
+    STAT_UPDATE(fullAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Full));
+    STAT_UPDATE(reducedAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Reduced));
+    STAT_UPDATE(lowAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Low));
+    STAT_UPDATE(frozenAnimationAvatarCount, avatarManager->getNumAvatarsAtAnimationLOD(Rig::AnimationLOD::Frozen));
     STAT_UPDATE(serverCount, (int)nodeList->size());
     STAT_UPDATE_FLOAT(renderrate, qApp->getRenderLoopRate(), 0.1f);
     RefreshRateManager& refreshRateManager = qApp->getRefreshRateManager();
@@ -288,6 +292,10 @@ void Stats::updateStats(bool force) {
         }
 
         STAT_UPDATE(entityPacketsInKbps, octreeServerCount ? totalEntityKbps / octreeServerCount : -1);
+        {
+            auto entities = qApp->getEntities();
+            STAT_UPDATE(entityTreeLockUsecs, entities ? (int)entities->getAverageReadBitstreamPerPacket() : -1);
+        }
 
         auto loadingRequests = ResourceCache::getLoadingRequests();
         STAT_UPDATE(downloads, loadingRequests.size());
@@ -460,6 +468,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
         STAT_UPDATE(numEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevNumEntityUpdates());
         STAT_UPDATE(numNeededEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevTotalNeededEntityUpdates());
+        STAT_UPDATE(entityUpdateTime, (float)DependencyManager::get<EntityTreeRenderer>()->getPrevEntityUpdateTime() /
+            (float)USECS_PER_MSEC);
     }
 
 
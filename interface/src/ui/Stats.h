@@ -96,6 +96,18 @@ private: \
  * @property {number} notUpdatedAvatarCount - The number of avatars in the domain, other than the client's, that weren't able 
  *     to be updated in the most recent game loop because there wasn't enough time to.
  *     <em>Read-only.</em>
+ * @property {number} fullAnimationAvatarCount - The number of avatars updated in the most recent game loop that got their
+ *     joints every frame and collided with the client's flow joints, being near.
+ *     <em>Read-only.</em>
+ * @property {number} reducedAnimationAvatarCount - The number of avatars updated in the most recent game loop that got their
+ *     joints every frame without flow collisions, being at mid range.
+ *     <em>Read-only.</em>
+ * @property {number} lowAnimationAvatarCount - The number of avatars updated in the most recent game loop that got their
+ *     joints at a reduced rate, being far away.
+ *     <em>Read-only.</em>
+ * @property {number} frozenAnimationAvatarCount - The number of avatars updated in the most recent game loop whose joints
+ *     weren't updated, being out of view.
+ *     <em>Read-only.</em>
  * @property {number} packetInCount - The number of packets being received from the domain server, in packets per second.
  *     <em>Read-only.</em>
  * @property {number} packetOutCount - The number of packets being sent to the domain server, in packets per second.
@@ -202,6 +214,9 @@ private: \
  *     second. (Multiply by the number of entity servers to get the total amount of data being received.)
  *     <code>-1</code> if not connected to an entity server.
  *     <em>Read-only.</em>
+ * @property {number} entityTreeLockUsecs - The average time the entity tree is locked to apply each entity packet that is
+ *     received, in microseconds.
+ *     <em>Read-only.</em>
  *
  * @property {number} downloads - The number of downloads in progress.
  *     <em>Read-only.</em>
@@ -252,6 +267,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} numNeededEntityUpdates - The total number of entity updates scheduled for last frame.
  *     <em>Read-only.</em>
+ * @property {number} entityUpdateTime - The time spent on entity updates last frame, in ms. Updates that don't fit in the
+ *     per-frame budget wait for the next frame.
+ *     <em>Read-only.</em>
  * @property {string} timingStats - Details of the average time (ms) spent in and number of calls made to different parts of 
  *     the code. Provided only if <code>timingExpanded</code> is <code>true</code>. Only the top 10 items are provided if 
  *     Developer &gt; Timing &gt; Performance Timer &gt; Only Display Top 10 is enabled.
@@ -488,6 +506,10 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
+    STATS_PROPERTY(int, fullAnimationAvatarCount, 0)
+    STATS_PROPERTY(int, reducedAnimationAvatarCount, 0)
+    STATS_PROPERTY(int, lowAnimationAvatarCount, 0)
+    STATS_PROPERTY(int, frozenAnimationAvatarCount, 0)
     STATS_PROPERTY(int, packetInCount, 0)
     STATS_PROPERTY(int, packetOutCount, 0)
     STATS_PROPERTY(float, mbpsIn, 0)
@@ -524,6 +546,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, audioNoiseGate, QString())
     STATS_PROPERTY(QVector2D, audioInjectors, QVector2D());
     STATS_PROPERTY(int, entityPacketsInKbps, 0)
+    STATS_PROPERTY(int, entityTreeLockUsecs, 0)
 
     STATS_PROPERTY(int, downloads, 0)
     STATS_PROPERTY(int, downloadLimit, 0)
@@ -549,6 +572,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(quint64, numEntityUpdates, 0)
     STATS_PROPERTY(quint64, numNeededEntityUpdates, 0)
+    STATS_PROPERTY(float, entityUpdateTime, 0)
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
@@ -816,6 +840,34 @@ signals:
      */
     void notUpdatedAvatarCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>fullAnimationAvatarCount</code> property changes.
+     * @function Stats.fullAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void fullAnimationAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>reducedAnimationAvatarCount</code> property changes.
+     * @function Stats.reducedAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void reducedAnimationAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>lowAnimationAvatarCount</code> property changes.
+     * @function Stats.lowAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void lowAnimationAvatarCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>frozenAnimationAvatarCount</code> property changes.
+     * @function Stats.frozenAnimationAvatarCountChanged
+     * @returns {Signal}
+     */
+    void frozenAnimationAvatarCountChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>packetInCount</code> property changes.
      * @function Stats.packetInCountChanged
@@ -1063,6 +1115,13 @@ signals:
      */
     void entityPacketsInKbpsChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>entityTreeLockUsecs</code> property changes.
+     * @function Stats.entityTreeLockUsecsChanged
+     * @returns {Signal}
+     */
+    void entityTreeLockUsecsChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>downloads</code> property changes.
      * @function Stats.downloadsChanged
@@ -1231,6 +1290,13 @@ signals:
      */
     void numNeededEntityUpdatesChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>entityUpdateTime</code> property changes.
+     * @function Stats.entityUpdateTimeChanged
+     * @returns {Signal}
+     */
+    void entityUpdateTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>timingStats</code> property changes.
      * @function Stats.timingStatsChanged
@@ -72,10 +72,13 @@ void GameWorkload::shutdown() {
     _engine.reset();
 }
 
-void GameWorkload::updateViews(const ViewFrustum& frustum, const glm::vec3& headPosition) {
+void GameWorkload::updateViews(const ViewFrustum& frustum, const glm::vec3& headPosition,
+                               const workload::Views& secondaryViews) {
     workload::Views views;
+    views.reserve(2 + secondaryViews.size());
     views.emplace_back(workload::View::evalFromFrustum(frustum, headPosition - frustum.getPosition()));
     views.emplace_back(workload::View::evalFromFrustum(frustum));
+    views.insert(views.end(), secondaryViews.begin(), secondaryViews.end());
     _engine->feedInput<WorkloadEngineBuilder::Inputs>(0, views);
 }
 
@@ -37,7 +37,9 @@ public:
             const PhysicalEntitySimulationPointer& simulation);
     void shutdown();
 
-    void updateViews(const ViewFrustum& frustum, const glm::vec3& headPosition);
+    // the secondary views, such as the secondary camera's, follow the head and camera views, each with its own weight
+    void updateViews(const ViewFrustum& frustum, const glm::vec3& headPosition,
+                     const workload::Views& secondaryViews = workload::Views());
     void updateSimulationTimings(const workload::Timings& timings);
 
     workload::EnginePointer _engine;
@@ -87,20 +87,23 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
         _poses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
     } else {
         // need to eval and blend between two children.
-        auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
-        auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        const auto& prevPoses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        const auto& nextPoses = _children[nextPoseIndex]->evaluate(animVars, context, dt, triggersOut);
 
         if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
             _poses.resize(prevPoses.size());
 
             if (_blendType == AnimBlendType_Normal) {
-                ::blend(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
+                _prevPoseBuffer.load(prevPoses);
+                _nextPoseBuffer.load(nextPoses);
+                ::blend(_prevPoseBuffer, _nextPoseBuffer, alpha, _blendedPoseBuffer);
+                _blendedPoseBuffer.store(_poses);
             } else if (_blendType == AnimBlendType_AddRelative) {
                 ::blendAdd(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
             } else if (_blendType == AnimBlendType_AddAbsolute) {
                 // convert prev from relative to absolute
-                AnimPoseVec absPrev = prevPoses;
-                _skeleton->convertRelativePosesToAbsolute(absPrev);
+                _prevPoseBuffer.load(prevPoses);
+                _skeleton->convertRelativePosesToAbsolute(_prevPoseBuffer);
 
                 // rotate the offset rotations from next into the parent relative frame of each joint.
                 AnimPoseVec relOffsetPoses;
@@ -112,7 +115,8 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
 
                     // convert from a rotation that happens in the absolute space of the joint
                     // into a rotation that happens in the relative space of the joint.
-                    pose.rot() = glm::inverse(absPrev[i].rot()) * pose.rot() * absPrev[i].rot();
+                    glm::quat absPrevRot = _prevPoseBuffer.getPose(i).rot();
+                    pose.rot() = glm::inverse(absPrevRot) * pose.rot() * absPrevRot;
 
                     relOffsetPoses.push_back(pose);
                 }
@@ -12,6 +12,7 @@
 #define hifi_AnimBlendLinear_h
 
 #include "AnimNode.h"
+#include "AnimPoseBuffer.h"
 
 // Linear blend between two AnimNodes.
 // the amount of blending is determined by the alpha parameter.
@@ -42,6 +43,9 @@ protected:
                                   size_t prevPoseIndex, size_t nextPoseIndex, float dt);
 
     AnimPoseVec _poses;
+    AnimPoseBuffer _prevPoseBuffer;
+    AnimPoseBuffer _nextPoseBuffer;
+    AnimPoseBuffer _blendedPoseBuffer;
 
     float _alpha;
     AnimBlendType _blendType;
@@ -89,23 +89,67 @@ void bakeAbsoluteDeltaAnim(std::vector<AnimPoseVec>& anim, const AnimPoseVec& ba
     }
 }
 
-static std::vector<AnimPoseVec> copyAndRetargetFromNetworkAnim(AnimationPointer networkAnim, AnimSkeleton::ConstPointer avatarSkeleton) {
-    ASSERT(networkAnim && networkAnim->isLoaded() && avatarSkeleton);
-    std::vector<AnimPoseVec> anim;
+static std::vector<AnimPoseBuffer> toPoseBuffers(const std::vector<AnimPoseVec>& anim) {
+    std::vector<AnimPoseBuffer> buffers;
+    buffers.reserve(anim.size());
+    for (const auto& poses : anim) {
+        buffers.emplace_back(poses);
+    }
+    return buffers;
+}
 
-    const HFMModel& animModel = networkAnim->getHFMModel();
-    AnimSkeleton animSkeleton(animModel);
-    const int animJointCount = animSkeleton.getNumJoints();
-    const int avatarJointCount = avatarSkeleton->getNumJoints();
+// What retargeting the frames of an animation onto the avatar skeleton needs, computed once per animation.
+// A compressed animation is kept to be sampled at any frame, instead of all the retargeted frames.
+class AnimClip::RetargetContext {
+public:
+    RetargetContext(const HFMModel& animModel, const QVector<HFMAnimationFrame>& animFrames, AnimSkeleton::ConstPointer avatarSkeleton);
+
+    hfm::CompressedAnimation::ConstPointer getCompressedAnimation() const { return _compressedAnimation; }
+
+    void retargetFrame(const HFMAnimationFrame& animFrame, AnimPoseVec& avatarPoses) const;
+
+    // the compressed animation at a fractional frame, retargeted
+    void sampleFrame(float frame, AnimPoseVec& avatarPoses);
+
+private:
+    const HFMModel& _animModel;
+    AnimSkeleton _animSkeleton;
+    AnimSkeleton::ConstPointer _avatarSkeleton;
+    hfm::CompressedAnimation::ConstPointer _compressedAnimation;
+
+    // from avatar joint indices to animation joint indices
+    std::vector<int> _avatarToAnimJointIndexMap;
+    std::vector<glm::vec3> _animZeroTranslations;
+    float _boneLengthScale { 1.0f };
+
+    HFMAnimationFrame _sampledFrame;
+};
+
+AnimClip::RetargetContext::RetargetContext(const HFMModel& animModel, const QVector<HFMAnimationFrame>& animFrames,
+                                           AnimSkeleton::ConstPointer avatarSkeleton) :
+    _animModel(animModel),
+    _animSkeleton(animModel),
+    _avatarSkeleton(avatarSkeleton),
+    _compressedAnimation(animModel.compressedAnimation)
+{
+    ASSERT(avatarSkeleton);
+    const AnimSkeleton& animSkeleton = _animSkeleton;
 
     // build a mapping from animation joint indices to avatar joint indices by matching joints with the same name.
-    std::vector<int> avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, *avatarSkeleton);
+    _avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, *avatarSkeleton);
 
-    const int animFrameCount = animModel.animationFrames.size();
-    anim.resize(animFrameCount);
+    // the translations are retargeted relative to the ones of the first frame
+    const int animJointCount = animSkeleton.getNumJoints();
+    if (_compressedAnimation) {
+        for (int i = 0; i < animJointCount; i++) {
+            _animZeroTranslations.push_back(_compressedAnimation->sampleTranslation(i, 0.0f));
+        }
+    } else if (!animFrames.isEmpty()) {
+        const auto& zeroTranslations = animFrames[0].translations;
+        _animZeroTranslations.assign(zeroTranslations.begin(), zeroTranslations.begin() + std::min(animJointCount, zeroTranslations.size()));
+    }
 
     // find the size scale factor for translation in the animation.
-    float boneLengthScale = 1.0f;
     const int avatarHipsIndex = avatarSkeleton->nameToJointIndex("Hips");
     const int animHipsIndex = animSkeleton.nameToJointIndex("Hips");
     if (avatarHipsIndex != -1 && animHipsIndex != -1) {
@@ -140,86 +184,114 @@ static std::vector<AnimPoseVec> copyAndRetargetFromNetworkAnim(AnimationPointer
             const float unitsRatio = 1.0f / (avatarUnitScale / animationUnitScale);
             const float parentScaleRatio = 1.0f / (avatarHipsParentScale / animHipsParentScale);
 
-            boneLengthScale = avatarToAnimationHeightRatio * unitsRatio * parentScaleRatio;
+            _boneLengthScale = avatarToAnimationHeightRatio * unitsRatio * parentScaleRatio;
         }
     }
+}
 
-    for (int frame = 0; frame < animFrameCount; frame++) {
-        const HFMAnimationFrame& animFrame = animModel.animationFrames[frame];
-        ASSERT(frame >= 0 && frame < (int)animModel.animationFrames.size());
+void AnimClip::RetargetContext::retargetFrame(const HFMAnimationFrame& animFrame, AnimPoseVec& avatarPoses) const {
+    const HFMModel& animModel = _animModel;
+    const AnimSkeleton& animSkeleton = _animSkeleton;
+    const AnimSkeleton::ConstPointer& avatarSkeleton = _avatarSkeleton;
+    const std::vector<int>& avatarToAnimJointIndexMap = _avatarToAnimJointIndexMap;
+    const int animJointCount = animSkeleton.getNumJoints();
+    const int avatarJointCount = avatarSkeleton->getNumJoints();
 
-        // extract the full rotations from the animFrame (including pre and post rotations from the animModel).
-        std::vector<glm::quat> animRotations;
-        animRotations.reserve(animJointCount);
-        for (int i = 0; i < animJointCount; i++) {
-            ASSERT(i >= 0 && i < (int)animModel.joints.size());
-            ASSERT(i >= 0 && i < (int)animFrame.rotations.size());
-            animRotations.push_back(animModel.joints[i].preRotation * animFrame.rotations[i] * animModel.joints[i].postRotation);
-        }
+    // extract the full rotations from the animFrame (including pre and post rotations from the animModel).
+    std::vector<glm::quat> animRotations;
+    animRotations.reserve(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        ASSERT(i >= 0 && i < (int)animModel.joints.size());
+        ASSERT(i >= 0 && i < (int)animFrame.rotations.size());
+        animRotations.push_back(animModel.joints[i].preRotation * animFrame.rotations[i] * animModel.joints[i].postRotation);
+    }
 
-        // convert rotations into absolute frame
-        animSkeleton.convertRelativeRotationsToAbsolute(animRotations);
-
-        // build absolute rotations for the avatar
-        std::vector<glm::quat> avatarRotations;
-        avatarRotations.reserve(avatarJointCount);
-        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
-            ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarToAnimJointIndexMap.size());
-            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
-            if (animJointIndex >= 0) {
-                // This joint is in both animation and avatar.
-                // Set the absolute rotation directly
-                ASSERT(animJointIndex >= 0 && animJointIndex < (int)animRotations.size());
-                avatarRotations.push_back(animRotations[animJointIndex]);
-            } else {
-                // This joint is NOT in the animation at all.
-                // Set it so that the default relative rotation remains unchanged.
-                glm::quat avatarRelativeDefaultRot = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex).rot();
-                glm::quat avatarParentAbsoluteRot;
-                int avatarParentJointIndex = avatarSkeleton->getParentIndex(avatarJointIndex);
-                if (avatarParentJointIndex >= 0) {
-                    ASSERT(avatarParentJointIndex >= 0 && avatarParentJointIndex < (int)avatarRotations.size());
-                    avatarParentAbsoluteRot = avatarRotations[avatarParentJointIndex];
-                }
-                avatarRotations.push_back(avatarParentAbsoluteRot * avatarRelativeDefaultRot);
+    // convert rotations into absolute frame
+    animSkeleton.convertRelativeRotationsToAbsolute(animRotations);
+
+    // build absolute rotations for the avatar
+    std::vector<glm::quat> avatarRotations;
+    avatarRotations.reserve(avatarJointCount);
+    for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+        ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarToAnimJointIndexMap.size());
+        int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+        if (animJointIndex >= 0) {
+            // This joint is in both animation and avatar.
+            // Set the absolute rotation directly
+            ASSERT(animJointIndex >= 0 && animJointIndex < (int)animRotations.size());
+            avatarRotations.push_back(animRotations[animJointIndex]);
+        } else {
+            // This joint is NOT in the animation at all.
+            // Set it so that the default relative rotation remains unchanged.
+            glm::quat avatarRelativeDefaultRot = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex).rot();
+            glm::quat avatarParentAbsoluteRot;
+            int avatarParentJointIndex = avatarSkeleton->getParentIndex(avatarJointIndex);
+            if (avatarParentJointIndex >= 0) {
+                ASSERT(avatarParentJointIndex >= 0 && avatarParentJointIndex < (int)avatarRotations.size());
+                avatarParentAbsoluteRot = avatarRotations[avatarParentJointIndex];
             }
+            avatarRotations.push_back(avatarParentAbsoluteRot * avatarRelativeDefaultRot);
         }
+    }
 
-        // convert avatar rotations into relative frame
-        avatarSkeleton->convertAbsoluteRotationsToRelative(avatarRotations);
-
-        ASSERT(frame >= 0 && frame < (int)anim.size());
-        anim[frame].reserve(avatarJointCount);
-        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
-            const AnimPose& avatarDefaultPose = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex);
-
-            // copy scale over from avatar default pose
-            glm::vec3 relativeScale = avatarDefaultPose.scale();
-
-            glm::vec3 relativeTranslation;
-            ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarToAnimJointIndexMap.size());
-            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
-            if (animJointIndex >= 0) {
-                // This joint is in both animation and avatar.
-                ASSERT(animJointIndex >= 0 && animJointIndex < (int)animFrame.translations.size());
-                const glm::vec3& animTrans = animFrame.translations[animJointIndex];
-
-                // retarget translation from animation to avatar
-                ASSERT(animJointIndex >= 0 && animJointIndex < (int)animModel.animationFrames[0].translations.size());
-                const glm::vec3& animZeroTrans = animModel.animationFrames[0].translations[animJointIndex];
-                relativeTranslation = avatarDefaultPose.trans() + boneLengthScale * (animTrans - animZeroTrans);
-            } else {
-                // This joint is NOT in the animation at all.
-                // preserve the default translation.
-                relativeTranslation = avatarDefaultPose.trans();
-            }
-
-            // build the final pose
-            ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarRotations.size());
-            anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+    // convert avatar rotations into relative frame
+    avatarSkeleton->convertAbsoluteRotationsToRelative(avatarRotations);
+
+    avatarPoses.clear();
+    avatarPoses.reserve(avatarJointCount);
+    for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+        const AnimPose& avatarDefaultPose = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex);
+
+        // copy scale over from avatar default pose
+        glm::vec3 relativeScale = avatarDefaultPose.scale();
+
+        glm::vec3 relativeTranslation;
+        ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarToAnimJointIndexMap.size());
+        int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+        if (animJointIndex >= 0) {
+            // This joint is in both animation and avatar.
+            ASSERT(animJointIndex >= 0 && animJointIndex < (int)animFrame.translations.size());
+            const glm::vec3& animTrans = animFrame.translations[animJointIndex];
+
+            // retarget translation from animation to avatar
+            ASSERT(animJointIndex >= 0 && animJointIndex < (int)_animZeroTranslations.size());
+            const glm::vec3& animZeroTrans = _animZeroTranslations[animJointIndex];
+            relativeTranslation = avatarDefaultPose.trans() + _boneLengthScale * (animTrans - animZeroTrans);
+        } else {
+            // This joint is NOT in the animation at all.
+            // preserve the default translation.
+            relativeTranslation = avatarDefaultPose.trans();
         }
+
+        // build the final pose
+        ASSERT(avatarJointIndex >= 0 && avatarJointIndex < (int)avatarRotations.size());
+        avatarPoses.push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+    }
+}
+
+void AnimClip::RetargetContext::sampleFrame(float frame, AnimPoseVec& avatarPoses) {
+    ASSERT(_compressedAnimation);
+    const int animJointCount = _compressedAnimation->getJointCount();
+    _sampledFrame.rotations.resize(animJointCount);
+    _sampledFrame.translations.resize(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        _sampledFrame.rotations[i] = _compressedAnimation->sampleRotation(i, frame);
+        _sampledFrame.translations[i] = _compressedAnimation->sampleTranslation(i, frame);
     }
+    retargetFrame(_sampledFrame, avatarPoses);
+}
+
+static std::vector<AnimPoseVec> copyAndRetargetFromNetworkAnim(AnimationPointer networkAnim, AnimSkeleton::ConstPointer avatarSkeleton) {
+    ASSERT(networkAnim && networkAnim->isLoaded() && avatarSkeleton);
 
+    // decodes the frames of a compressed animation
+    const QVector<HFMAnimationFrame>& animFrames = networkAnim->getFramesReference();
+    AnimClip::RetargetContext context(networkAnim->getHFMModel(), animFrames, avatarSkeleton);
+
+    std::vector<AnimPoseVec> anim(animFrames.size());
+    for (int frame = 0; frame < animFrames.size(); frame++) {
+        context.retargetFrame(animFrames[frame], anim[frame]);
+    }
     return anim;
 }
 
@@ -248,6 +320,11 @@ AnimClip::~AnimClip() {
 
 }
 
+// A non mirrored animation with compressed frames is sampled directly instead of retargeting all of its frames
+bool AnimClip::canSampleCompressedAnim() const {
+    return _blendType == AnimBlendType_Normal && !_mirrorFlag && _mirrorFlagVar.isEmpty();
+}
+
 const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
@@ -263,8 +340,17 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     // poll network anim to see if it's finished loading yet.
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            if (_networkAnim->getCompressedAnimation() && canSampleCompressedAnim()) {
+                // the context keeps the animation model, and its compressed frames
+                _compressedAnimModel = _networkAnim;
+                _retargetContext = std::make_unique<RetargetContext>(_networkAnim->getHFMModel(), QVector<HFMAnimationFrame>(), _skeleton);
+                _anim.clear();
+            } else {
+                // loading is complete, copy & retarget animation.
+                _retargetContext.reset();
+                _compressedAnimModel.reset();
+                _anim = toPoseBuffers(copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton));
+            }
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
@@ -278,7 +364,7 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
             // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+            auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
 
             // we no longer need the actual animation resource anymore.
             _networkAnim.reset();
@@ -293,15 +379,25 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
             auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
 
             if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
+                bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
             } else {
                 // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
+                bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
             }
+            _anim = toPoseBuffers(anim);
         }
     }
 
-    if (_anim.size()) {
+    if (_retargetContext && _mirrorFlag) {
+        // mirroring needs all the frames
+        _anim = toPoseBuffers(copyAndRetargetFromNetworkAnim(_compressedAnimModel, _skeleton));
+        _retargetContext.reset();
+        _compressedAnimModel.reset();
+    }
+
+    if (_retargetContext) {
+        sampleCompressedAnim();
+    } else if (_anim.size()) {
 
         // lazy creation of mirrored animation frames.
         if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
@@ -322,11 +418,12 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimPoseBuffer& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
+        const AnimPoseBuffer& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        ::blend(prevFrame, nextFrame, alpha, _blendedPoses);
+        _blendedPoses.store(_poses);
     }
 
     processOutputJoints(triggersOut);
@@ -334,6 +431,34 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     return _poses;
 }
 
+void AnimClip::sampleCompressedAnim() {
+    int prevIndex = (int)glm::floor(_frame);
+    int nextIndex;
+    if (_loopFlag && _frame >= _endFrame) {
+        nextIndex = (int)glm::ceil(_startFrame);
+    } else {
+        nextIndex = (int)glm::ceil(_frame);
+    }
+
+    int frameCount = _retargetContext->getCompressedAnimation()->getFrameCount();
+    prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
+    nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
+    float alpha = glm::fract(_frame);
+
+    if (nextIndex == prevIndex || nextIndex == prevIndex + 1) {
+        // the tracks interpolate between the frames
+        _retargetContext->sampleFrame((float)prevIndex + (nextIndex == prevIndex ? 0.0f : alpha), _poses);
+    } else {
+        // looping back to the start
+        _retargetContext->sampleFrame((float)prevIndex, _poses);
+        _prevPoses.load(_poses);
+        _retargetContext->sampleFrame((float)nextIndex, _poses);
+        _nextPoses.load(_poses);
+        ::blend(_prevPoses, _nextPoses, alpha, _blendedPoses);
+        _blendedPoses.store(_poses);
+    }
+}
+
 void AnimClip::setCurrentFrameInternal(float frame) {
     // because dt is 0, we should not encounter any triggers
     const float dt = 0.0f;
@@ -346,9 +471,11 @@ void AnimClip::buildMirrorAnim() {
 
     _mirrorAnim.clear();
     _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    AnimPoseVec relPoses;
+    for (auto& frame : _anim) {
+        frame.store(relPoses);
+        _skeleton->mirrorRelativePoses(relPoses);
+        _mirrorAnim.emplace_back(relPoses);
     }
 }
 
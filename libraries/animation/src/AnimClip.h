@@ -11,9 +11,11 @@
 #ifndef hifi_AnimClip_h
 #define hifi_AnimClip_h
 
+#include <memory>
 #include <string>
 #include "AnimationCache.h"
 #include "AnimNode.h"
+#include "AnimPoseBuffer.h"
 
 // Playback a single animation timeline.
 // url determines the location of the fbx file to use within this clip.
@@ -57,12 +59,17 @@ public:
 
     AnimBlendType getBlendType() const { return _blendType; };
 
+    class RetargetContext;
+
 protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
     void buildMirrorAnim();
 
+    bool canSampleCompressedAnim() const;
+    void sampleCompressedAnim();
+
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
@@ -71,9 +78,16 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // _anim[frame] holds the poses of all the joints
+    std::vector<AnimPoseBuffer> _anim;
+    std::vector<AnimPoseBuffer> _mirrorAnim;
+    AnimPoseBuffer _blendedPoses;
+
+    // set instead of _anim for a compressed animation, sampled at each evaluate()
+    std::unique_ptr<RetargetContext> _retargetContext;
+    AnimationPointer _compressedAnimModel;
+    AnimPoseBuffer _prevPoses;
+    AnimPoseBuffer _nextPoses;
 
     QString _url;
     float _startFrame;
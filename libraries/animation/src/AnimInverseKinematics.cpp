@@ -248,13 +248,21 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
 
     std::map<int, int> targetToChainMap;
 
-    float maxError = 0.0f;
-    int numLoops = 0;
+    // stop once the targets are reached or the error stops shrinking, after one more loop:
+    // the last one interpolates the joint chains that are changing type
     const int MAX_IK_LOOPS = 16;
-    while (numLoops < MAX_IK_LOOPS) {
+    const int MIN_IK_LOOPS = 2;
+    const float IK_CONVERGENCE_TOLERANCE = 0.001f; // geometry units
+    float maxError = FLT_MAX;
+    float prevMaxError = FLT_MAX;
+    int numLoops = 0;
+    bool lastLoop = false;
+    while (!lastLoop) {
         ++numLoops;
+        lastLoop = numLoops == MAX_IK_LOOPS ||
+            (numLoops > MIN_IK_LOOPS && (maxError < IK_CONVERGENCE_TOLERANCE || prevMaxError - maxError < IK_CONVERGENCE_TOLERANCE));
 
-        bool debug = context.getEnableDebugDrawIKChains() && numLoops == MAX_IK_LOOPS;
+        bool debug = context.getEnableDebugDrawIKChains() && lastLoop;
 
         // solve all targets
         for (size_t i = 0; i < targets.size(); i++) {
@@ -271,7 +279,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
         
         // on last iteration, interpolate jointChains, if necessary
-        if (numLoops == MAX_IK_LOOPS) {
+        if (lastLoop) {
             for (size_t i = 0; i < _prevJointChainInfoVec.size(); i++) {
                 targetToChainMap.insert(std::pair<int, int>(_prevJointChainInfoVec[i].target.getIndex(), (int)i));
                 if (_prevJointChainInfoVec[i].timer > 0.0f) {
@@ -336,6 +344,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
 
         // compute maxError
+        prevMaxError = maxError;
         maxError = 0.0f;
         for (size_t i = 0; i < targets.size(); i++) {
             if (targets[i].getType() == IKTarget::Type::RotationAndPosition || targets[i].getType() == IKTarget::Type::HmdHead ||
@@ -348,6 +357,7 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         }
     }
     _maxErrorOnLastSolve = maxError;
+    _numLoopsOnLastSolve = numLoops;
 
     // finally set the relative rotation of each tip to agree with absolute target rotation
     for (auto& target: targets) {
@@ -1070,7 +1080,18 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
 
                 preconditionRelativePosesToAvoidLimbLock(context, targets);
 
-                solve(context, targets, dt, jointChainInfoVec);
+                uint64_t solveStart = usecTimestampNow();
+                if (canReusePreviousSolve(targets)) {
+                    // same start and targets as the last solve, which gets the same result
+                    _relativePoses = _prevSolvedPoses;
+                    _numLoopsOnLastSolve = 0;
+                } else {
+                    _prevSolveTargets = targets;
+                    _prevSolveStartPoses = _relativePoses;
+                    solve(context, targets, dt, jointChainInfoVec);
+                    _prevSolvedPoses = _relativePoses;
+                }
+                _solveTimeOnLastSolve = usecTimestampNow() - solveStart;
             }
         }
 
@@ -1084,6 +1105,44 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
     return _relativePoses;
 }
 
+bool AnimInverseKinematics::canReusePreviousSolve(const std::vector<IKTarget>& targets) const {
+    const float TRANSLATION_EPSILON = 1.0e-4f; // geometry units
+    const float ROTATION_DOT_EPSILON = 1.0e-7f;
+    auto posesMatch = [&](const AnimPose& a, const AnimPose& b) {
+        return glm::length2(a.trans() - b.trans()) < TRANSLATION_EPSILON * TRANSLATION_EPSILON &&
+            1.0f - fabsf(glm::dot(a.rot(), b.rot())) < ROTATION_DOT_EPSILON;
+    };
+
+    if (_prevSolvedPoses.size() != _relativePoses.size() || _prevSolveStartPoses.size() != _relativePoses.size() ||
+        _prevSolveTargets.size() != targets.size() || _maxErrorOnLastSolve == FLT_MAX) {
+        return false;
+    }
+
+    // the joint chains that change type interpolate over several solves
+    for (const auto& chainInfo : _prevJointChainInfoVec) {
+        if (chainInfo.timer > 0.0f) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < targets.size(); i++) {
+        const IKTarget& target = targets[i];
+        const IKTarget& prevTarget = _prevSolveTargets[i];
+        if (target.getType() != prevTarget.getType() || target.getIndex() != prevTarget.getIndex() ||
+            target.getWeight() != prevTarget.getWeight() || target.getPoleVectorEnabled() != prevTarget.getPoleVectorEnabled() ||
+            target.getPoleVector() != prevTarget.getPoleVector() || !posesMatch(target.getPose(), prevTarget.getPose())) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < _relativePoses.size(); i++) {
+        if (!posesMatch(_relativePoses[i], _prevSolveStartPoses[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void AnimInverseKinematics::clearIKJointLimitHistory() {
     for (auto& pair : _constraints) {
         pair.second->clearHistory();
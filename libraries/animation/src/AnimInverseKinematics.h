@@ -58,6 +58,9 @@ public:
     void clearIKJointLimitHistory();
 
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
+    // 0 when the last solve reused the one before, its start poses and targets being the same
+    int getNumLoopsOnLastSolve() const { return _numLoopsOnLastSolve; }
+    uint64_t getSolveTimeOnLastSolve() const { return _solveTimeOnLastSolve; } // usecs
 
     /*@jsdoc
      * <p>Specifies the initial conditions of the IK solver.</p>
@@ -119,6 +122,7 @@ public:
 protected:
     void computeTargets(const AnimVariantMap& animVars, std::vector<IKTarget>& targets, const AnimPoseVec& underPoses);
     void solve(const AnimContext& context, const std::vector<IKTarget>& targets, float dt, JointChainInfoVec& jointChainInfoVec);
+    bool canReusePreviousSolve(const std::vector<IKTarget>& targets) const;
     void solveTargetWithCCD(const AnimContext& context, const IKTarget& target, const AnimPoseVec& absolutePoses,
                             bool debug, JointChainInfo& jointChainInfoOut) const;
     void solveTargetWithSpline(const AnimContext& context, const IKTarget& target, const AnimPoseVec& absolutePoses,
@@ -199,11 +203,18 @@ protected:
     int _rightHandIndex { -1 };
 
     float _maxErrorOnLastSolve { FLT_MAX };
+    int _numLoopsOnLastSolve { 0 };
+    uint64_t _solveTimeOnLastSolve { 0 };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
     QString _solutionSourceVar;
 
     JointChainInfoVec _prevJointChainInfoVec;
+
+    // the start poses, targets and result of the last solve
+    AnimPoseVec _prevSolveStartPoses;
+    std::vector<IKTarget> _prevSolveTargets;
+    AnimPoseVec _prevSolvedPoses;
 };
 
 #endif // hifi_AnimInverseKinematics_h
@@ -61,13 +61,16 @@ const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, const A
             auto& overPoses = _children[0]->overlay(animVars, context, dt, triggersOut, underPoses);
 
             if (underPoses.size() > 0 && underPoses.size() == overPoses.size()) {
-                _poses.resize(underPoses.size());
-                assert(_boneSetVec.size() == _poses.size());
+                assert(_boneSetVec.size() == underPoses.size());
 
-                for (size_t i = 0; i < _poses.size(); i++) {
-                    float alpha = _boneSetVec[i] * _alpha;
-                    ::blend(1, &underPoses[i], &overPoses[i], alpha, &_poses[i]);
+                _jointAlphas.resize(_boneSetVec.size());
+                for (size_t i = 0; i < _jointAlphas.size(); i++) {
+                    _jointAlphas[i] = _boneSetVec[i] * _alpha;
                 }
+                _underPoseBuffer.load(underPoses);
+                _overPoseBuffer.load(overPoses);
+                ::blend(_underPoseBuffer, _overPoseBuffer, _jointAlphas.data(), _blendedPoseBuffer);
+                _blendedPoseBuffer.store(_poses);
             }
         }
     }
@@ -12,6 +12,7 @@
 #define hifi_AnimOverlay_h
 
 #include "AnimNode.h"
+#include "AnimPoseBuffer.h"
 
 // Overlay the AnimPoses from one AnimNode on top of another AnimNode.
 // child[0] is overlayed on top of child[1].  The boneset is used
@@ -89,6 +90,10 @@ public:
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
     AnimPoseVec _poses;
+    AnimPoseBuffer _underPoseBuffer;
+    AnimPoseBuffer _overPoseBuffer;
+    AnimPoseBuffer _blendedPoseBuffer;
+    std::vector<float> _jointAlphas;
     BoneSet _boneSet;
     float _alpha;
     std::vector<float> _boneSetVec;
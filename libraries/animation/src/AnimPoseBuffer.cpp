@@ -0,0 +1,243 @@
+//
+//  AnimPoseBuffer.cpp
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <algorithm>
+#include <cassert>
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <emmintrin.h>
+#define HIFI_SSE2_POSE_BLENDING
+#endif
+
+static const float IDENTITY_CHANNEL_VALUES[AnimPoseBuffer::NUM_CHANNELS] = {
+    1.0f, 1.0f, 1.0f,       // scale
+    0.0f, 0.0f, 0.0f, 1.0f, // rot
+    0.0f, 0.0f, 0.0f        // trans
+};
+
+void AnimPoseBuffer::resize(size_t size) {
+    size_t paddedSize = (size + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+    for (int i = 0; i < NUM_CHANNELS; i++) {
+        auto& channel = _channels[i];
+        channel.resize(paddedSize, IDENTITY_CHANNEL_VALUES[i]);
+        // padding joints left over from a larger size
+        std::fill(channel.begin() + size, channel.end(), IDENTITY_CHANNEL_VALUES[i]);
+    }
+    _size = size;
+}
+
+void AnimPoseBuffer::zero() {
+    for (auto& channel : _channels) {
+        std::fill(channel.begin(), channel.begin() + _size, 0.0f);
+    }
+}
+
+void AnimPoseBuffer::load(const AnimPose* poses, size_t numPoses) {
+    resize(numPoses);
+    for (size_t i = 0; i < numPoses; i++) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPose* poses) const {
+    for (size_t i = 0; i < _size; i++) {
+        poses[i] = getPose(i);
+    }
+}
+
+void AnimPoseBuffer::store(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    store(poses.data());
+}
+
+AnimPose AnimPoseBuffer::getPose(size_t index) const {
+    assert(index < _size);
+    return AnimPose(glm::vec3(_channels[SCALE_X][index], _channels[SCALE_Y][index], _channels[SCALE_Z][index]),
+                    glm::quat(_channels[ROT_W][index], _channels[ROT_X][index], _channels[ROT_Y][index], _channels[ROT_Z][index]),
+                    glm::vec3(_channels[TRANS_X][index], _channels[TRANS_Y][index], _channels[TRANS_Z][index]));
+}
+
+void AnimPoseBuffer::setPose(size_t index, const AnimPose& pose) {
+    assert(index < _size);
+    _channels[SCALE_X][index] = pose.scale().x;
+    _channels[SCALE_Y][index] = pose.scale().y;
+    _channels[SCALE_Z][index] = pose.scale().z;
+    _channels[ROT_X][index] = pose.rot().x;
+    _channels[ROT_Y][index] = pose.rot().y;
+    _channels[ROT_Z][index] = pose.rot().z;
+    _channels[ROT_W][index] = pose.rot().w;
+    _channels[TRANS_X][index] = pose.trans().x;
+    _channels[TRANS_Y][index] = pose.trans().y;
+    _channels[TRANS_Z][index] = pose.trans().z;
+}
+
+static const AnimPoseBuffer::Channel LINEAR_CHANNELS[] = {
+    AnimPoseBuffer::SCALE_X, AnimPoseBuffer::SCALE_Y, AnimPoseBuffer::SCALE_Z,
+    AnimPoseBuffer::TRANS_X, AnimPoseBuffer::TRANS_Y, AnimPoseBuffer::TRANS_Z
+};
+
+#ifdef HIFI_SSE2_POSE_BLENDING
+
+namespace {
+    struct QuatLanes {
+        __m128 x, y, z, w;
+    };
+
+    inline QuatLanes loadRots(const AnimPoseBuffer& poses, size_t i) {
+        return { _mm_loadu_ps(poses.channel(AnimPoseBuffer::ROT_X) + i), _mm_loadu_ps(poses.channel(AnimPoseBuffer::ROT_Y) + i),
+                 _mm_loadu_ps(poses.channel(AnimPoseBuffer::ROT_Z) + i), _mm_loadu_ps(poses.channel(AnimPoseBuffer::ROT_W) + i) };
+    }
+
+    inline void storeRots(AnimPoseBuffer& poses, size_t i, const QuatLanes& q) {
+        _mm_storeu_ps(poses.channel(AnimPoseBuffer::ROT_X) + i, q.x);
+        _mm_storeu_ps(poses.channel(AnimPoseBuffer::ROT_Y) + i, q.y);
+        _mm_storeu_ps(poses.channel(AnimPoseBuffer::ROT_Z) + i, q.z);
+        _mm_storeu_ps(poses.channel(AnimPoseBuffer::ROT_W) + i, q.w);
+    }
+
+    inline __m128 dot(const QuatLanes& a, const QuatLanes& b) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)),
+                          _mm_add_ps(_mm_mul_ps(a.z, b.z), _mm_mul_ps(a.w, b.w)));
+    }
+
+    // b negated in the lanes where it is on the other side of a
+    inline QuatLanes alignTo(const QuatLanes& a, const QuatLanes& b) {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 flip = _mm_and_ps(dot(a, b), signMask);
+        return { _mm_xor_ps(b.x, flip), _mm_xor_ps(b.y, flip), _mm_xor_ps(b.z, flip), _mm_xor_ps(b.w, flip) };
+    }
+
+    inline __m128 lerp(__m128 a, __m128 b, __m128 alpha) {
+        return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), alpha));
+    }
+
+    inline QuatLanes normalize(const QuatLanes& q) {
+        // a full precision division, the reciprocal square root estimate drifts too much over the frames
+        __m128 invLength = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(dot(q, q)));
+        return { _mm_mul_ps(q.x, invLength), _mm_mul_ps(q.y, invLength), _mm_mul_ps(q.z, invLength), _mm_mul_ps(q.w, invLength) };
+    }
+
+    inline void blendLanes(const AnimPoseBuffer& a, const AnimPoseBuffer& b, __m128 alpha, AnimPoseBuffer& result, size_t i) {
+        for (auto channel : LINEAR_CHANNELS) {
+            __m128 value = lerp(_mm_loadu_ps(a.channel(channel) + i), _mm_loadu_ps(b.channel(channel) + i), alpha);
+            _mm_storeu_ps(result.channel(channel) + i, value);
+        }
+        QuatLanes aRot = loadRots(a, i);
+        QuatLanes bRot = alignTo(aRot, loadRots(b, i));
+        storeRots(result, i, normalize({ lerp(aRot.x, bRot.x, alpha), lerp(aRot.y, bRot.y, alpha),
+                                         lerp(aRot.z, bRot.z, alpha), lerp(aRot.w, bRot.w, alpha) }));
+    }
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    const __m128 alphaLanes = _mm_set1_ps(alpha);
+    for (size_t i = 0; i < a.paddedSize(); i += AnimPoseBuffer::LANE_COUNT) {
+        blendLanes(a, b, alphaLanes, result, i);
+    }
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    const size_t size = a.size();
+    for (size_t i = 0; i < a.paddedSize(); i += AnimPoseBuffer::LANE_COUNT) {
+        __m128 alphaLanes;
+        if (i + AnimPoseBuffer::LANE_COUNT <= size) {
+            alphaLanes = _mm_loadu_ps(alphas + i);
+        } else {
+            // alphas has no padding
+            alignas(16) float tail[AnimPoseBuffer::LANE_COUNT] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            std::copy(alphas + i, alphas + size, tail);
+            alphaLanes = _mm_load_ps(tail);
+        }
+        blendLanes(a, b, alphaLanes, result, i);
+    }
+}
+
+void accumulate(const AnimPoseBuffer& src, float weight, AnimPoseBuffer& result) {
+    assert(src.size() == result.size());
+    const __m128 weightLanes = _mm_set1_ps(weight);
+    for (size_t i = 0; i < src.paddedSize(); i += AnimPoseBuffer::LANE_COUNT) {
+        for (auto channel : LINEAR_CHANNELS) {
+            float* dest = result.channel(channel) + i;
+            _mm_storeu_ps(dest, _mm_add_ps(_mm_loadu_ps(dest), _mm_mul_ps(_mm_loadu_ps(src.channel(channel) + i), weightLanes)));
+        }
+        QuatLanes resultRot = loadRots(result, i);
+        QuatLanes srcRot = alignTo(resultRot, loadRots(src, i));
+        storeRots(result, i, { _mm_add_ps(resultRot.x, _mm_mul_ps(srcRot.x, weightLanes)),
+                               _mm_add_ps(resultRot.y, _mm_mul_ps(srcRot.y, weightLanes)),
+                               _mm_add_ps(resultRot.z, _mm_mul_ps(srcRot.z, weightLanes)),
+                               _mm_add_ps(resultRot.w, _mm_mul_ps(srcRot.w, weightLanes)) });
+    }
+}
+
+void normalizeRotations(AnimPoseBuffer& poses) {
+    for (size_t i = 0; i < poses.paddedSize(); i += AnimPoseBuffer::LANE_COUNT) {
+        storeRots(poses, i, normalize(loadRots(poses, i)));
+    }
+}
+
+#else
+
+static const AnimPoseBuffer::Channel ROT_CHANNELS[] = {
+    AnimPoseBuffer::ROT_X, AnimPoseBuffer::ROT_Y, AnimPoseBuffer::ROT_Z, AnimPoseBuffer::ROT_W
+};
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        // AnimPose::blend() goes from its argument to the pose
+        AnimPose pose = b.getPose(i);
+        pose.blend(a.getPose(i), alpha);
+        result.setPose(i, pose);
+    }
+}
+
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        AnimPose pose = b.getPose(i);
+        pose.blend(a.getPose(i), alphas[i]);
+        result.setPose(i, pose);
+    }
+}
+
+void accumulate(const AnimPoseBuffer& src, float weight, AnimPoseBuffer& result) {
+    assert(src.size() == result.size());
+    for (size_t i = 0; i < src.size(); i++) {
+        for (auto channel : LINEAR_CHANNELS) {
+            result.channel(channel)[i] += weight * src.channel(channel)[i];
+        }
+        float dot = 0.0f;
+        for (auto channel : ROT_CHANNELS) {
+            dot += result.channel(channel)[i] * src.channel(channel)[i];
+        }
+        float signedWeight = dot < 0.0f ? -weight : weight;
+        for (auto channel : ROT_CHANNELS) {
+            result.channel(channel)[i] += signedWeight * src.channel(channel)[i];
+        }
+    }
+}
+
+void normalizeRotations(AnimPoseBuffer& poses) {
+    for (size_t i = 0; i < poses.size(); i++) {
+        AnimPose pose = poses.getPose(i);
+        pose.rot() = glm::normalize(pose.rot());
+        poses.setPose(i, pose);
+    }
+}
+
+#endif
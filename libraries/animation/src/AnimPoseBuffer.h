@@ -0,0 +1,80 @@
+//
+//  AnimPoseBuffer.h
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer_h
+#define hifi_AnimPoseBuffer_h
+
+#include <array>
+#include <vector>
+
+#include "AnimPose.h"
+
+// Structure of arrays form of an AnimPoseVec: one array per scale, rotation and translation component,
+// so the blend kernels can work on four joints at a time.
+// The arrays are padded to a multiple of four joints, the padding joints are identity poses.
+class AnimPoseBuffer {
+public:
+    enum Channel {
+        SCALE_X = 0,
+        SCALE_Y,
+        SCALE_Z,
+        ROT_X,
+        ROT_Y,
+        ROT_Z,
+        ROT_W,
+        TRANS_X,
+        TRANS_Y,
+        TRANS_Z,
+        NUM_CHANNELS
+    };
+
+    static const size_t LANE_COUNT { 4 };
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(const AnimPoseVec& poses) { load(poses); }
+
+    size_t size() const { return _size; }
+    size_t paddedSize() const { return _channels[0].size(); }
+    bool empty() const { return _size == 0; }
+
+    // new joints are identity poses
+    void resize(size_t size);
+    // all the joints to zero, to accumulate() into
+    void zero();
+
+    void load(const AnimPose* poses, size_t numPoses);
+    void load(const AnimPoseVec& poses) { load(poses.data(), poses.size()); }
+    void store(AnimPose* poses) const;
+    void store(AnimPoseVec& poses) const;
+
+    AnimPose getPose(size_t index) const;
+    void setPose(size_t index, const AnimPose& pose);
+
+    float* channel(Channel channel) { return _channels[channel].data(); }
+    const float* channel(Channel channel) const { return _channels[channel].data(); }
+
+protected:
+    std::array<std::vector<float>, NUM_CHANNELS> _channels;
+    size_t _size { 0 };
+};
+
+// result = lerp(a, b, alpha) for the scales and translations, nlerp for the rotations, same as ::blend()
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+// same with an alpha per joint
+void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, const float* alphas, AnimPoseBuffer& result);
+
+// result += weight * src, the src rotations flipped to the side of the result ones first.
+// Call normalizeRotations() once all the poses are accumulated.
+void accumulate(const AnimPoseBuffer& src, float weight, AnimPoseBuffer& result);
+
+void normalizeRotations(AnimPoseBuffer& poses);
+
+#endif // hifi_AnimPoseBuffer_h
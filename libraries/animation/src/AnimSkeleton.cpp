@@ -141,6 +141,17 @@ void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     }
 }
 
+void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseBuffer& poses) const {
+    // each joint waits for its parent, only the poses composition itself could go wide
+    int lastIndex = std::min((int)poses.size(), _jointsSize);
+    for (int i = 0; i < lastIndex; ++i) {
+        int parentIndex = _parentIndices[i];
+        if (parentIndex != INVALID_JOINT_INDEX) {
+            poses.setPose(i, poses.getPose(parentIndex) * poses.getPose(i));
+        }
+    }
+}
+
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
     // poses start off absolute and leave in relative frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
@@ -17,6 +17,7 @@
 
 #include <FBXSerializer.h>
 #include "AnimPose.h"
+#include "AnimPoseBuffer.h"
 
 class AnimSkeleton {
 public:
@@ -55,6 +56,7 @@ public:
     AnimPose getAbsolutePose(int jointIndex, const AnimPoseVec& relativePoses) const;
 
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
+    void convertRelativePosesToAbsolute(AnimPoseBuffer& poses) const;
     void convertAbsolutePosesToRelative(AnimPoseVec& poses) const;
 
     void convertRelativeRotationsToAbsolute(std::vector<glm::quat>& rotations) const;
@@ -21,6 +21,7 @@
 
 #include "AnimationLogging.h"
 #include <FBXSerializer.h>
+#include <HFASerializer.h>
 
 int animationPointerMetaTypeId = qRegisterMetaType<AnimationPointer>();
 
@@ -74,6 +75,8 @@ void AnimationReader::run() {
             HFMModel::Pointer hfmModel;
             if (_url.path().toLower().endsWith(".fbx")) {
                 hfmModel = FBXSerializer().read(_data, QVariantHash(), _url.path());
+            } else if (_url.path().toLower().endsWith(".hfa")) {
+                hfmModel = HFASerializer().read(_data, QVariantHash(), _url.path());
             } else {
                 QString errorStr("usupported format");
                 emit onError(299, errorStr);
@@ -117,14 +120,25 @@ QVector<HFMAnimationFrame> Animation::getFrames() const {
         return result;
     }
     if (_hfmModel) {
-        return _hfmModel->animationFrames;
+        return getFramesReference();
     } else {
         return QVector<HFMAnimationFrame>();
     }
 }
 
 const QVector<HFMAnimationFrame>& Animation::getFramesReference() const {
-    return _hfmModel->animationFrames;
+    if (!_hfmModel->compressedAnimation) {
+        return _hfmModel->animationFrames;
+    }
+    std::lock_guard<std::mutex> lock(_decodedFramesMutex);
+    const auto& compressedAnimation = *_hfmModel->compressedAnimation;
+    if (_decodedFrames.size() != compressedAnimation.getFrameCount()) {
+        _decodedFrames.resize(compressedAnimation.getFrameCount());
+        for (int frame = 0; frame < _decodedFrames.size(); frame++) {
+            compressedAnimation.decodeFrame(frame, _decodedFrames[frame]);
+        }
+    }
+    return _decodedFrames;
 }
 
 void Animation::downloadFinished(const QByteArray& data) {
@@ -12,6 +12,8 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <mutex>
+
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 #include <QtScript/QScriptEngine>
@@ -65,8 +67,12 @@ public:
     
     Q_INVOKABLE QVector<HFMAnimationFrame> getFrames() const;
 
+    // The frames of a baked animation are decoded from its compressed animation on the first call
     const QVector<HFMAnimationFrame>& getFramesReference() const;
-    
+
+    // null unless the animation was baked, see hfm::CompressedAnimation
+    hfm::CompressedAnimation::ConstPointer getCompressedAnimation() const { return _hfmModel->compressedAnimation; }
+
 protected:
     virtual void downloadFinished(const QByteArray& data) override;
 
@@ -77,6 +83,9 @@ protected slots:
 private:
     
     HFMModel::Pointer _hfmModel;
+
+    mutable std::mutex _decodedFramesMutex;
+    mutable QVector<HFMAnimationFrame> _decodedFrames;
 };
 
 /// Reads geometry in a worker thread.
@@ -12,6 +12,11 @@
 #include "Rig.h"
 #include "AnimSkeleton.h"
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <emmintrin.h>
+#define HIFI_SSE2_FLOW_COLLISIONS
+#endif
+
 const std::map<QString, FlowPhysicsSettings> PRESET_FLOW_DATA = { { "hair", FlowPhysicsSettings() },
 { "skirt", FlowPhysicsSettings(true, 1.0f, DEFAULT_GRAVITY, 0.65f, 0.8f, 0.45f, 0.01f) },
 { "breast", FlowPhysicsSettings(true, 1.0f, DEFAULT_GRAVITY, 0.65f, 0.8f, 0.45f, 0.01f) } };
@@ -123,7 +128,7 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
     FlowThreadResults.resize(flowThread->_joints.size());
     for (size_t j = 0; j < _allCollisions.size(); j++) {
         FlowCollisionSphere &sphere = _allCollisions[j];
-        FlowCollisionResult rootCollision = sphere.computeSphereCollision(flowThread->_positions[0], flowThread->_radius);
+        FlowCollisionResult rootCollision = sphere.computeSphereCollision(flowThread->getPosition(0), flowThread->_radius);
         std::vector<FlowCollisionResult> collisionData = { rootCollision };
         bool tooFar = rootCollision._distance >(flowThread->_length + rootCollision._radius);
         FlowCollisionResult nextCollision;
@@ -131,7 +136,7 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
             if (sphere._isTouch) {
                 for (size_t i = 1; i < flowThread->_joints.size(); i++) {
                     auto prevCollision = collisionData[i - 1];
-                    nextCollision = _allCollisions[j].computeSphereCollision(flowThread->_positions[i], flowThread->_radius);
+                    nextCollision = _allCollisions[j].computeSphereCollision(flowThread->getPosition(i), flowThread->_radius);
                     collisionData.push_back(nextCollision);
                     if (prevCollision._offset > 0.0f) {
                         if (i == 1) {
@@ -140,7 +145,7 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
                     } else if (nextCollision._offset > 0.0f) {
                         FlowThreadResults[i].push_back(nextCollision);
                     } else {
-                        FlowCollisionResult segmentCollision = _allCollisions[j].checkSegmentCollision(flowThread->_positions[i - 1], flowThread->_positions[i], prevCollision, nextCollision);
+                        FlowCollisionResult segmentCollision = _allCollisions[j].checkSegmentCollision(flowThread->getPosition(i - 1), flowThread->getPosition(i), prevCollision, nextCollision);
                         if (segmentCollision._offset > 0) {
                             FlowThreadResults[i - 1].push_back(segmentCollision);
                             FlowThreadResults[i].push_back(segmentCollision);
@@ -148,13 +153,11 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
                     }
                 }
             } else {
-                if (rootCollision._offset > 0.0f) {
-                    FlowThreadResults[0].push_back(rootCollision);
-                }
-                for (size_t i = 1; i < flowThread->_joints.size(); i++) {
-                    nextCollision = _allCollisions[j].computeSphereCollision(flowThread->_positions[i], flowThread->_radius);
-                    if (nextCollision._offset > 0.0f) {
-                        FlowThreadResults[i].push_back(nextCollision);
+                // most joints are clear of most spheres, only the overlapping ones get a full collision result
+                findSphereOverlaps(sphere, *flowThread, _overlaps);
+                for (size_t i = 0; i < flowThread->_joints.size(); i++) {
+                    if (_overlaps[i]) {
+                        FlowThreadResults[i].push_back(sphere.computeSphereCollision(flowThread->getPosition(i), flowThread->_radius));
                     }
                 }
             }
@@ -168,6 +171,40 @@ std::vector<FlowCollisionResult> FlowCollisionSystem::checkFlowThreadCollisions(
     return results;
 };
 
+#ifdef HIFI_SSE2_FLOW_COLLISIONS
+
+void FlowCollisionSystem::findSphereOverlaps(const FlowCollisionSphere& sphere, const FlowThread& flowThread, std::vector<uint8_t>& overlaps) {
+    const size_t paddedSize = flowThread._positionsX.size();
+    overlaps.resize(paddedSize);
+    const __m128 centerX = _mm_set1_ps(sphere._position.x);
+    const __m128 centerY = _mm_set1_ps(sphere._position.y);
+    const __m128 centerZ = _mm_set1_ps(sphere._position.z);
+    // offset = sphereRadius - (distance - threadRadius) > 0
+    const __m128 radii = _mm_set1_ps(sphere._radius + flowThread._radius);
+    for (size_t i = 0; i < paddedSize; i += FlowThread::LANE_COUNT) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(flowThread._positionsX.data() + i), centerX);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(flowThread._positionsY.data() + i), centerY);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(flowThread._positionsZ.data() + i), centerZ);
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(distance, radii));
+        for (size_t lane = 0; lane < FlowThread::LANE_COUNT; lane++) {
+            overlaps[i + lane] = (mask >> lane) & 1;
+        }
+    }
+}
+
+#else
+
+void FlowCollisionSystem::findSphereOverlaps(const FlowCollisionSphere& sphere, const FlowThread& flowThread, std::vector<uint8_t>& overlaps) {
+    const size_t paddedSize = flowThread._positionsX.size();
+    overlaps.resize(paddedSize);
+    for (size_t i = 0; i < paddedSize; i++) {
+        overlaps[i] = sphere.computeSphereCollision(flowThread.getPosition(i), flowThread._radius)._offset > 0.0f;
+    }
+}
+
+#endif
+
 FlowCollisionSettings FlowCollisionSystem::getCollisionSettingsByJoint(int jointIndex) {
     for (auto &collision : _selfCollisions) {
         if (collision._jointIndex == jointIndex) {
@@ -371,14 +408,24 @@ void FlowThread::computeRecovery() {
 };
 
 void FlowThread::update(float deltaTime) {
-    _positions.clear();
     auto &firstJoint = _jointsPointer->at(_joints[0]);
     _radius = firstJoint._settings._radius;
     computeRecovery();
+    size_t paddedSize = (_joints.size() + LANE_COUNT - 1) / LANE_COUNT * LANE_COUNT;
+    _positionsX.resize(paddedSize);
+    _positionsY.resize(paddedSize);
+    _positionsZ.resize(paddedSize);
     for (size_t i = 0; i < _joints.size(); i++) {
         auto &joint = _jointsPointer->at(_joints[i]);
         joint.update(deltaTime);
-        _positions.push_back(joint._currentPosition);
+        _positionsX[i] = joint._currentPosition.x;
+        _positionsY[i] = joint._currentPosition.y;
+        _positionsZ[i] = joint._currentPosition.z;
+    }
+    for (size_t i = _joints.size(); i < paddedSize; i++) {
+        _positionsX[i] = _positionsX[i - 1];
+        _positionsY[i] = _positionsY[i - 1];
+        _positionsZ[i] = _positionsZ[i - 1];
     }
 };
 
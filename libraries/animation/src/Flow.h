@@ -138,6 +138,8 @@ public:
     FlowCollisionResult computeCollision(const std::vector<FlowCollisionResult> collisions);
 
     std::vector<FlowCollisionResult> checkFlowThreadCollisions(FlowThread* flowThread);
+    // overlaps[i] is set when the sphere overlaps the joint i of the thread, four joints at a time
+    static void findSphereOverlaps(const FlowCollisionSphere& sphere, const FlowThread& flowThread, std::vector<uint8_t>& overlaps);
 
     std::vector<FlowCollisionSphere>& getSelfCollisions() { return _selfCollisions; };
     std::vector<FlowCollisionSphere>& getSelfTouchCollisions() { return _selfTouchCollisions; };
@@ -157,6 +159,7 @@ protected:
     std::vector<FlowCollisionSphere> _othersCollisions;
     std::vector<FlowCollisionSphere> _selfTouchCollisions;
     std::vector<FlowCollisionSphere> _allCollisions;
+    std::vector<uint8_t> _overlaps;
     float _scale { 1.0f };
     bool _active { false };
 };
@@ -273,9 +276,15 @@ public:
     void computeJointRotations();
     void setRootFramePositions(const std::vector<glm::vec3>& rootFramePositions) { _rootFramePositions = rootFramePositions; }
     void setScale(float scale, bool initScale = false);
+    glm::vec3 getPosition(size_t index) const { return glm::vec3(_positionsX[index], _positionsY[index], _positionsZ[index]); }
+
+    static const size_t LANE_COUNT { 4 };
 
     std::vector<int> _joints;
-    std::vector<glm::vec3> _positions;
+    // the joint positions, one array per component padded to a multiple of LANE_COUNT with the last position
+    std::vector<float> _positionsX;
+    std::vector<float> _positionsY;
+    std::vector<float> _positionsZ;
     float _radius{ 0.0f };
     float _length{ 0.0f };
     std::map<int, FlowJoint>* _jointsPointer;
@@ -22,6 +22,7 @@
 #include <DebugDraw.h>
 #include <PerfStat.h>
 #include <ScriptValueUtils.h>
+#include <TBBHelpers.h>
 #include <shared/NsightHelpers.h>
 
 #include "AnimationLogging.h"
@@ -834,6 +835,36 @@ float Rig::getIKErrorOnLastSolve() const {
     return result;
 }
 
+int Rig::getIKLoopsOnLastSolve() const {
+    int result = 0;
+
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            auto ikNode = std::dynamic_pointer_cast<AnimInverseKinematics>(node);
+            if (ikNode) {
+                result = ikNode->getNumLoopsOnLastSolve();
+            }
+            return true;
+        });
+    }
+    return result;
+}
+
+uint64_t Rig::getIKTimeOnLastSolve() const {
+    uint64_t result = 0;
+
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            auto ikNode = std::dynamic_pointer_cast<AnimInverseKinematics>(node);
+            if (ikNode) {
+                result = ikNode->getSolveTimeOnLastSolve();
+            }
+            return true;
+        });
+    }
+    return result;
+}
+
 int Rig::getJointParentIndex(int childIndex) const {
     if (_animSkeleton && isIndexValid(childIndex)) {
         return _animSkeleton->getParentIndex(childIndex);
@@ -1732,16 +1763,33 @@ void Rig::updateAnimations(float deltaTime, const glm::mat4& rootTransform, cons
     applyOverridePoses();
 
     buildAbsoluteRigPoses(_internalPoseSet._relativePoses, _internalPoseSet._absolutePoses);    
-    _internalFlow.update(deltaTime, _internalPoseSet._relativePoses, _internalPoseSet._absolutePoses, _internalPoseSet._overrideFlags);
+
+    auto updateInternalFlow = [&] {
+        _internalFlow.update(deltaTime, _internalPoseSet._relativePoses, _internalPoseSet._absolutePoses, _internalPoseSet._overrideFlags);
+    };
+    auto updateNetworkFlow = [&] {
+        _networkFlow.update(deltaTime, _networkPoseSet._relativePoses, _networkPoseSet._absolutePoses, _internalPoseSet._overrideFlags);
+    };
 
     if (_sendNetworkNode) {
+        buildAbsoluteRigPoses(_networkPoseSet._relativePoses, _networkPoseSet._absolutePoses);
         if (_internalFlow.getActive() && !_networkFlow.getActive()) {
+            // the network flow starts from the updated internal one
+            updateInternalFlow();
             _networkFlow = _internalFlow;
+            updateNetworkFlow();
+        } else if (_concurrentFlowUpdates && _internalFlow.getActive() && _networkFlow.getActive()) {
+            // the flows only share the override flags, which they read
+            tbb::parallel_invoke(updateInternalFlow, updateNetworkFlow);
+        } else {
+            updateInternalFlow();
+            updateNetworkFlow();
+        }
+    } else {
+        updateInternalFlow();
+        if (_networkFlow.getActive()) {
+            _networkFlow.setActive(false);
         }
-        buildAbsoluteRigPoses(_networkPoseSet._relativePoses, _networkPoseSet._absolutePoses);
-        _networkFlow.update(deltaTime, _networkPoseSet._relativePoses, _networkPoseSet._absolutePoses, _internalPoseSet._overrideFlags);
-    } else if (_networkFlow.getActive()) {
-        _networkFlow.setActive(false);
     }
 
     // copy internal poses to external poses
@@ -2578,6 +2626,23 @@ int Rig::getOverrideJointCount() const {
     return count;
 }
 
+const float Rig::FULL_ANIMATION_LOD_SCALE = 16.0f;
+const float Rig::REDUCED_ANIMATION_LOD_SCALE = 4.0f;
+const float Rig::LOW_ANIMATION_LOD_UPDATE_RATE = 10.0f;
+
+Rig::AnimationLOD Rig::computeAnimationLOD(bool inView, float radius, float distance, float lodHalfAngleTan) {
+    if (!inView) {
+        return AnimationLOD::Frozen;
+    }
+    // the tangent of the apparent half angle, as LODManager::shouldRender() compares them
+    if (radius >= distance * lodHalfAngleTan * FULL_ANIMATION_LOD_SCALE) {
+        return AnimationLOD::Full;
+    } else if (radius >= distance * lodHalfAngleTan * REDUCED_ANIMATION_LOD_SCALE) {
+        return AnimationLOD::Reduced;
+    }
+    return AnimationLOD::Low;
+}
+
 bool Rig::getFlowActive() const {
     return _internalFlow.getActive();
 }
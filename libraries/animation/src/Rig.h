@@ -115,6 +115,21 @@ public:
         Seated
     };
 
+    // How much of the joints update a remote avatar gets, from its apparent size on screen
+    enum class AnimationLOD : uint8_t {
+        Full = 0,   // network poses every frame, hands colliding with my avatar's flow
+        Reduced,    // network poses every frame, no flow collisions
+        Low,        // network poses at LOW_ANIMATION_LOD_UPDATE_RATE
+        Frozen,     // out of view, no joints update
+        NumLODs
+    };
+    static const float FULL_ANIMATION_LOD_SCALE;
+    static const float REDUCED_ANIMATION_LOD_SCALE;
+    static const float LOW_ANIMATION_LOD_UPDATE_RATE;
+
+    // lodHalfAngleTan is the LODManager one, under which items aren't rendered, the tiers start at multiples of it
+    static AnimationLOD computeAnimationLOD(bool inView, float radius, float distance, float lodHalfAngleTan);
+
     Rig();
     virtual ~Rig();
 
@@ -155,6 +170,8 @@ public:
     float getMaxHipsOffsetLength() const;
 
     float getIKErrorOnLastSolve() const;
+    int getIKLoopsOnLastSolve() const;
+    uint64_t getIKTimeOnLastSolve() const; // usecs
 
     int getJointParentIndex(int childIndex) const;
 
@@ -249,6 +266,9 @@ public:
     const AnimContext::DebugStateMachineMap& getStateMachineMap() const { return _lastContext.getStateMachineMap(); }
     void initFlow(bool isActive);
     Flow& getFlow() { return _internalFlow; }
+    // the internal and network flows are independent simulations, by default they update on two threads
+    void setConcurrentFlowUpdates(bool concurrent) { _concurrentFlowUpdates = concurrent; }
+    bool getConcurrentFlowUpdates() const { return _concurrentFlowUpdates; }
 
     float getUnscaledEyeHeight() const;
     float getUnscaledHipsHeight() const;
@@ -257,6 +277,9 @@ public:
     int getOverrideJointCount() const;
     bool getFlowActive() const;
     bool getNetworkGraphActive() const;
+
+    void setAnimationLOD(AnimationLOD lod) { _animationLOD = lod; }
+    AnimationLOD getAnimationLOD() const { return _animationLOD; }
     void setDirectionalBlending(const QString& targetName, const glm::vec3& blendingTarget, const QString& alphaName, float alpha);
 
 signals:
@@ -485,6 +508,9 @@ protected:
     ControllerParameters _previousControllerParameters;
     Flow _internalFlow;
     Flow _networkFlow;
+    bool _concurrentFlowUpdates { true };
+
+    AnimationLOD _animationLOD { AnimationLOD::Full };
 };
 
 #endif /* defined(__hifi__Rig__) */
@@ -1396,9 +1396,6 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
         auto packetType = _shouldEchoToServer ? PacketType::MicrophoneAudioWithEcho : PacketType::MicrophoneAudioNoEcho;
         if (!audioGateOpen && !closedInLastBlock) {
             packetType = PacketType::SilentAudioFrame;
-            _silentOutbound.increment();
-        } else {
-            _audioOutbound.increment();
         }
 
         Transform audioTransform;
@@ -1408,10 +1405,21 @@ void AudioClient::handleAudioInput(QByteArray& audioBuffer) {
         QByteArray encodedBuffer;
         if (_encoder) {
             _encoder->encode(audioBuffer, encodedBuffer);
+
+            // the codec found nothing to send, so the mixer is told of silence and need not decode or mix this stream
+            if (_encoder->isSilentFrame(encodedBuffer)) {
+                packetType = PacketType::SilentAudioFrame;
+            }
         } else {
             encodedBuffer = audioBuffer;
         }
 
+        if (packetType == PacketType::SilentAudioFrame) {
+            _silentOutbound.increment();
+        } else {
+            _audioOutbound.increment();
+        }
+
         emitAudioPacket(encodedBuffer.data(), encodedBuffer.size(), _outgoingAvatarAudioSequenceNumber, _isStereoInput,
                         audioTransform, avatarBoundingBoxCorner, avatarBoundingBoxScale,
                         packetType, _selectedCodecName);
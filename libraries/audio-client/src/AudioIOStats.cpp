@@ -178,6 +178,18 @@ void AudioStatsInterface::updateLocalBuffers(const MovingMinMaxAvg<float>& input
     sentTimegapMsAvg(timegaps.getAverage() / USECS_PER_MSEC);
     sentTimegapMsMaxWindow(timegaps.getWindowMax() / USECS_PER_MSEC);
     sentTimegapMsAvgWindow(timegaps.getWindowAverage() / USECS_PER_MSEC);
+
+    updateLatency();
+}
+
+void AudioStatsInterface::updateLatency() {
+    inputLatencyMs(inputReadMsMax() + inputUnplayedMsMax());
+    networkLatencyMs(pingMs());
+    // the client's stream waits in the mixer's jitter buffer, then for the next mix
+    mixerLatencyMs((_mixer->framesAvailableAvg() + 1) * AudioConstants::NETWORK_FRAME_MSECS);
+    // the mixed stream waits in the client's jitter buffer, then in the output device's buffer
+    outputLatencyMs(_client->framesAvailableAvg() * AudioConstants::NETWORK_FRAME_MSECS + outputUnplayedMsMax());
+    latencyMs(inputLatencyMs() + networkLatencyMs() + mixerLatencyMs() + outputLatencyMs());
 }
 
 void AudioStatsInterface::updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats) {
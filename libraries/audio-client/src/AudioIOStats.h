@@ -267,6 +267,18 @@ class AudioStatsInterface : public QObject {
      * @property {number} sentTimegapMsMaxWindow - The recent maximum time between sending data packets to the audio mixer, in 
      *     ms.
      *     <em>Read-only.</em>
+     * @property {number} inputLatencyMs - The recent time microphone audio waits in the client before it is sent, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} networkLatencyMs - The time audio takes to the audio mixer and back, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} mixerLatencyMs - The time the client's audio waits in the audio mixer's buffer and mix, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} outputLatencyMs - The recent time mixed audio waits in the client before it is played, in ms.
+     *     <em>Read-only.</em>
+     * @property {number} latencyMs - The estimated time from the microphone through the audio mixer to the speakers: the sum 
+     *     of <code>inputLatencyMs</code>, <code>networkLatencyMs</code>, <code>mixerLatencyMs</code> and 
+     *     <code>outputLatencyMs</code>, in ms.
+     *     <em>Read-only.</em>
      */
 
     /*@jsdoc
@@ -338,6 +350,46 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(quint64, sentTimegapMsAvgWindow);
 
+    /*@jsdoc
+     * Triggered when the recent time microphone audio waits in the client before it is sent changes.
+     * @function AudioStats.inputLatencyMsChanged
+     * @param {number} inputLatencyMs - The recent time microphone audio waits in the client before it is sent, in ms.
+     * @returns {Signal}
+     */
+    AUDIO_PROPERTY(float, inputLatencyMs);
+
+    /*@jsdoc
+     * Triggered when the time audio takes to the audio mixer and back changes.
+     * @function AudioStats.networkLatencyMsChanged
+     * @param {number} networkLatencyMs - The time audio takes to the audio mixer and back, in ms.
+     * @returns {Signal}
+     */
+    AUDIO_PROPERTY(float, networkLatencyMs);
+
+    /*@jsdoc
+     * Triggered when the time the client's audio waits in the audio mixer's buffer and mix changes.
+     * @function AudioStats.mixerLatencyMsChanged
+     * @param {number} mixerLatencyMs - The time the client's audio waits in the audio mixer's buffer and mix, in ms.
+     * @returns {Signal}
+     */
+    AUDIO_PROPERTY(float, mixerLatencyMs);
+
+    /*@jsdoc
+     * Triggered when the recent time mixed audio waits in the client before it is played changes.
+     * @function AudioStats.outputLatencyMsChanged
+     * @param {number} outputLatencyMs - The recent time mixed audio waits in the client before it is played, in ms.
+     * @returns {Signal}
+     */
+    AUDIO_PROPERTY(float, outputLatencyMs);
+
+    /*@jsdoc
+     * Triggered when the estimated time from the microphone through the audio mixer to the speakers changes.
+     * @function AudioStats.latencyMsChanged
+     * @param {number} latencyMs - The estimated time from the microphone through the audio mixer to the speakers, in ms.
+     * @returns {Signal}
+     */
+    AUDIO_PROPERTY(float, latencyMs);
+
     Q_PROPERTY(AudioStreamStatsInterface* mixerStream READ getMixerStream NOTIFY mixerStreamChanged);
     Q_PROPERTY(AudioStreamStatsInterface* clientStream READ getClientStream NOTIFY clientStreamChanged);
 
@@ -353,8 +405,16 @@ public:
                             const MovingMinMaxAvg<float>& inputMsUnplayed,
                             const MovingMinMaxAvg<float>& outputMsUnplayed,
                             const MovingMinMaxAvg<quint64>& timegaps);
-    void updateMixerStream(const AudioStreamStats& stats) { _mixer->updateStream(stats); emit mixerStreamChanged(); }
-    void updateClientStream(const AudioStreamStats& stats) { _client->updateStream(stats); emit clientStreamChanged(); }
+    void updateMixerStream(const AudioStreamStats& stats) {
+        _mixer->updateStream(stats);
+        updateLatency();
+        emit mixerStreamChanged();
+    }
+    void updateClientStream(const AudioStreamStats& stats) {
+        _client->updateStream(stats);
+        updateLatency();
+        emit clientStreamChanged();
+    }
     void updateInjectorStreams(const QHash<QUuid, AudioStreamStats>& stats);
 
 signals:
@@ -384,6 +444,8 @@ signals:
 private:
     friend class AudioIOStats;
     AudioStatsInterface(QObject* parent);
+    // the latency by stage, from the local buffers and the jitter buffers of both streams
+    void updateLatency();
     AudioStreamStatsInterface* _client;
     AudioStreamStatsInterface* _mixer;
     QObject* _injectors;
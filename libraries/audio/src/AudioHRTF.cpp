@@ -15,6 +15,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include <memory>
+
 #include "AudioHRTFData.h"
 
 #if defined(_MSC_VER)
@@ -374,6 +376,57 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
     }
 }
 
+// N lane input, 4 channel output per lane (lanes interleaved with stride HRTF_BATCH)
+static void FIR_Nx4_SSE(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames) {
+
+    static_assert(HRTF_BATCH % 8 == 0, "HRTF_BATCH must be a multiple of 8");
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float* ps = &src[(i - HRTF_TAPS + 1) * HRTF_BATCH];     // process forwards
+
+        for (int j = 0; j < HRTF_BATCH; j += 8) {
+
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+            __m128 acc2 = _mm_setzero_ps();
+            __m128 acc3 = _mm_setzero_ps();
+            __m128 acc4 = _mm_setzero_ps();
+            __m128 acc5 = _mm_setzero_ps();
+            __m128 acc6 = _mm_setzero_ps();
+            __m128 acc7 = _mm_setzero_ps();
+
+            for (int k = 0; k < HRTF_TAPS; k++) {
+
+                int c = HRTF_TAPS - 1 - k;                          // process backwards
+
+                __m128 x0 = _mm_loadu_ps(&ps[k * HRTF_BATCH + j + 0]);
+                __m128 x1 = _mm_loadu_ps(&ps[k * HRTF_BATCH + j + 4]);
+
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(&coef[0][c][j + 0]), x0));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(&coef[0][c][j + 4]), x1));
+                acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(&coef[1][c][j + 0]), x0));
+                acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(&coef[1][c][j + 4]), x1));
+                acc4 = _mm_add_ps(acc4, _mm_mul_ps(_mm_loadu_ps(&coef[2][c][j + 0]), x0));
+                acc5 = _mm_add_ps(acc5, _mm_mul_ps(_mm_loadu_ps(&coef[2][c][j + 4]), x1));
+                acc6 = _mm_add_ps(acc6, _mm_mul_ps(_mm_loadu_ps(&coef[3][c][j + 0]), x0));
+                acc7 = _mm_add_ps(acc7, _mm_mul_ps(_mm_loadu_ps(&coef[3][c][j + 4]), x1));
+            }
+
+            float* pd = &dst[4 * i * HRTF_BATCH + j];
+
+            _mm_storeu_ps(&pd[0 * HRTF_BATCH + 0], acc0);
+            _mm_storeu_ps(&pd[0 * HRTF_BATCH + 4], acc1);
+            _mm_storeu_ps(&pd[1 * HRTF_BATCH + 0], acc2);
+            _mm_storeu_ps(&pd[1 * HRTF_BATCH + 4], acc3);
+            _mm_storeu_ps(&pd[2 * HRTF_BATCH + 0], acc4);
+            _mm_storeu_ps(&pd[2 * HRTF_BATCH + 4], acc5);
+            _mm_storeu_ps(&pd[3 * HRTF_BATCH + 0], acc6);
+            _mm_storeu_ps(&pd[3 * HRTF_BATCH + 4], acc7);
+        }
+    }
+}
+
 //
 // Runtime CPU dispatch
 //
@@ -382,6 +435,8 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
 
 void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_Nx4_AVX2(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames);
+void FIR_Nx4_AVX512(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
@@ -397,6 +452,15 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
 }
 
+static void FIR_Nx4(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames) {
+#ifndef STACK_PROTECTOR
+    static auto f = cpuSupportsAVX512() ? FIR_Nx4_AVX512 : (cpuSupportsAVX2() ? FIR_Nx4_AVX2 : FIR_Nx4_SSE);
+#else
+    static auto f = cpuSupportsAVX2() ? FIR_Nx4_AVX2 : FIR_Nx4_SSE;
+#endif
+    (*f)(src, dst, coef, numFrames); // dispatch
+}
+
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
     static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
     (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
@@ -484,6 +548,35 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
     }
 }
 
+// N lane input, 4 channel output per lane (lanes interleaved with stride HRTF_BATCH)
+static void FIR_Nx4(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float* ps = &src[(i - HRTF_TAPS + 1) * HRTF_BATCH];     // process forwards
+        float* pd = &dst[4 * i * HRTF_BATCH];
+
+        for (int j = 0; j < 4 * HRTF_BATCH; j++) {
+            pd[j] = 0.0f;
+        }
+
+        for (int k = 0; k < HRTF_TAPS; k++) {
+
+            int c = HRTF_TAPS - 1 - k;                          // process backwards
+
+            for (int j = 0; j < HRTF_BATCH; j++) {
+
+                float x = ps[k * HRTF_BATCH + j];
+
+                pd[0 * HRTF_BATCH + j] += coef[0][c][j] * x;
+                pd[1 * HRTF_BATCH + j] += coef[1][c][j] * x;
+                pd[2 * HRTF_BATCH + j] += coef[2][c][j] * x;
+                pd[3 * HRTF_BATCH + j] += coef[3][c][j] * x;
+            }
+        }
+    }
+}
+
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -1060,19 +1153,8 @@ static void setFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int dela
     }
 }
 
-void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
-                       float lpfDistance) {
-
-    assert(index >= 0);
-    assert(index < HRTF_TABLES);
-    assert(numFrames == HRTF_BLOCK);
-
-    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
-    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
-    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
-    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
-    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
-    int delay[4];                                           // 4-channel (interleaved)
+void AudioHRTF::updateFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                              int index, float azimuth, float distance, float gain, float lpfDistance) {
 
     // apply global and local gain adjustment
     gain *= _gainAdjust;
@@ -1100,6 +1182,9 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _distanceState = distance;
     _gainState = gain;
     _lpfState = lpf;
+}
+
+void AudioHRTF::updateInput(int16_t* input, float in[HRTF_TAPS + HRTF_BLOCK]) {
 
     // convert mono input to float
     for (int i = 0; i < HRTF_BLOCK; i++) {
@@ -1109,14 +1194,11 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
     memcpy(_firState, &in[HRTF_BLOCK], HRTF_TAPS * sizeof(float));
+}
 
-    // process old/new FIR
-    FIR_1x4(&in[HRTF_TAPS], 
-            &firBuffer[L0][HRTF_DELAY], 
-            &firBuffer[R0][HRTF_DELAY], 
-            &firBuffer[L1][HRTF_DELAY], 
-            &firBuffer[R1][HRTF_DELAY], 
-            firCoef, HRTF_BLOCK);
+void AudioHRTF::mixOutput(float firBuffer[4][HRTF_DELAY + HRTF_BLOCK], float bqCoef[5][8], int delay[4], float* output) {
+
+    ALIGN32 float bqBuffer[4 * HRTF_BLOCK];                 // 4-channel (interleaved)
 
     // delay state update
     memcpy(firBuffer[L0], _delayState[L0], HRTF_DELAY * sizeof(float));
@@ -1162,6 +1244,109 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _resetState = false;
 }
 
+void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
+                       float lpfDistance) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqCoef[5][8];                             // 4-channel (interleaved)
+    int delay[4];                                           // 4-channel (interleaved)
+
+    updateFilters(firCoef, bqCoef, delay, index, azimuth, distance, gain, lpfDistance);
+
+    updateInput(input, in);
+
+    // process old/new FIR
+    FIR_1x4(&in[HRTF_TAPS], 
+            &firBuffer[L0][HRTF_DELAY], 
+            &firBuffer[R0][HRTF_DELAY], 
+            &firBuffer[L1][HRTF_DELAY], 
+            &firBuffer[R1][HRTF_DELAY], 
+            firCoef, HRTF_BLOCK);
+
+    mixOutput(firBuffer, bqCoef, delay, output);
+}
+
+//
+// Work buffers for renderBatch, with sources interleaved so that the FIR vectorizes across them.
+// Too large for the stack, so they are allocated once per thread.
+//
+struct HRTFBatchBuffers {
+    ALIGN32 float in[(HRTF_TAPS + HRTF_BLOCK) * HRTF_BATCH];    // N-lane mono
+    ALIGN32 float firCoef[4][HRTF_TAPS][HRTF_BATCH];            // N-lane 4-channel
+    ALIGN32 float firOut[HRTF_BLOCK * 4 * HRTF_BATCH];          // N-lane 4-channel
+};
+
+void AudioHRTF::renderBatch(AudioHRTF* const* hrtfs, int16_t* const* inputs, const BatchParameters* params,
+                            float* output, int index, int numSources, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < HRTF_TABLES);
+    assert(numFrames == HRTF_BLOCK);
+
+    static thread_local std::unique_ptr<HRTFBatchBuffers> batchBuffers;
+    if (!batchBuffers) {
+        batchBuffers.reset(new HRTFBatchBuffers);
+    }
+    HRTFBatchBuffers& buffers = *batchBuffers;
+
+    ALIGN32 float in[HRTF_TAPS + HRTF_BLOCK];               // mono
+    ALIGN32 float firCoef[4][HRTF_TAPS];                    // 4-channel
+    ALIGN32 float firBuffer[4][HRTF_DELAY + HRTF_BLOCK];    // 4-channel
+    ALIGN32 float bqCoef[HRTF_BATCH][5][8];                 // N-lane 4-channel (interleaved)
+    int delay[HRTF_BATCH][4];                               // N-lane 4-channel (interleaved)
+
+    for (int base = 0; base < numSources; base += HRTF_BATCH) {
+
+        int numLanes = std::min(numSources - base, HRTF_BATCH);
+
+        // unused lanes are processed as silence
+        if (numLanes < HRTF_BATCH) {
+            memset(buffers.in, 0, sizeof(buffers.in));
+            memset(buffers.firCoef, 0, sizeof(buffers.firCoef));
+        }
+
+        // compute filters and update FIR state for each source, then interleave into lanes
+        for (int j = 0; j < numLanes; j++) {
+
+            AudioHRTF* hrtf = hrtfs[base + j];
+            const BatchParameters& p = params[base + j];
+
+            hrtf->updateFilters(firCoef, bqCoef[j], delay[j], index, p.azimuth, p.distance, p.gain, p.lpfDistance);
+            hrtf->updateInput(inputs[base + j], in);
+
+            for (int i = 0; i < HRTF_TAPS + HRTF_BLOCK; i++) {
+                buffers.in[i * HRTF_BATCH + j] = in[i];
+            }
+            for (int c = 0; c < 4; c++) {
+                for (int k = 0; k < HRTF_TAPS; k++) {
+                    buffers.firCoef[c][k][j] = firCoef[c][k];
+                }
+            }
+        }
+
+        // process old/new FIR for all sources
+        FIR_Nx4(&buffers.in[HRTF_TAPS * HRTF_BATCH], buffers.firOut, buffers.firCoef, HRTF_BLOCK);
+
+        // deinterleave, and finish each source
+        for (int j = 0; j < numLanes; j++) {
+
+            for (int c = 0; c < 4; c++) {
+                for (int i = 0; i < HRTF_BLOCK; i++) {
+                    firBuffer[c][HRTF_DELAY + i] = buffers.firOut[(4 * i + c) * HRTF_BATCH + j];
+                }
+            }
+
+            hrtfs[base + j]->mixOutput(firBuffer, bqCoef[j], delay[j], output);
+        }
+    }
+}
+
 void AudioHRTF::mixMono(int16_t* input, float* output, float gain, int numFrames) {
 
     assert(numFrames == HRTF_BLOCK);
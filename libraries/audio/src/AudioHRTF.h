@@ -24,6 +24,7 @@ static const int HRTF_TABLES = 25;      // number of HRTF subjects
 
 static const int HRTF_DELAY = 24;       // max ITD in samples (1.0ms at 24KHz)
 static const int HRTF_BLOCK = 240;      // block processing size
+static const int HRTF_BATCH = 16;       // sources processed in parallel by renderBatch
 
 static const float HRTF_GAIN = 1.0f;    // HRTF global gain adjustment
 
@@ -58,6 +59,24 @@ public:
     void render(int16_t* input, float* output, int index, float azimuth, float distance, float gain, int numFrames,
                 float lpfDistance = LPF_DISTANCE_REF);
 
+    //
+    // Batched render of many sources for one listener, equivalent to calling render() on each.
+    // Sources are processed HRTF_BATCH at a time, with the FIR convolution vectorized across sources.
+    //
+    // hrtfs: per-source filter state
+    // inputs: per-source mono input
+    // params: per-source parameters (see render)
+    // output: interleaved stereo mix buffer (accumulates into existing output)
+    //
+    struct BatchParameters {
+        float azimuth;
+        float distance;
+        float gain;
+        float lpfDistance { LPF_DISTANCE_REF };
+    };
+    static void renderBatch(AudioHRTF* const* hrtfs, int16_t* const* inputs, const BatchParameters* params,
+                            float* output, int index, int numSources, int numFrames);
+
     //
     // Non-spatialized direct mix (accumulates into existing output)
     //
@@ -111,6 +130,12 @@ private:
     AudioHRTF(const AudioHRTF&) = delete;
     AudioHRTF& operator=(const AudioHRTF&) = delete;
 
+    // render stages, shared by render and renderBatch
+    void updateFilters(float firCoef[4][HRTF_TAPS], float bqCoef[5][8], int delay[4],
+                       int index, float azimuth, float distance, float gain, float lpfDistance);
+    void updateInput(int16_t* input, float in[HRTF_TAPS + HRTF_BLOCK]);
+    void mixOutput(float firBuffer[4][HRTF_DELAY + HRTF_BLOCK], float bqCoef[5][8], int delay[4], float* output);
+
     // SIMD channel assignmentS
     enum Channel {
         L0, R0,
@@ -42,18 +42,28 @@ AudioInjectorState& operator|= (AudioInjectorState& lhs, AudioInjectorState rhs)
 AudioInjector::AudioInjector(SharedSoundPointer sound, const AudioInjectorOptions& injectorOptions) :
     _sound(sound),
     _audioData(sound->getAudioData()),
+    _stream(sound->createStream()),
     _options(injectorOptions)
 {
 }
 
 AudioInjector::AudioInjector(AudioDataPointer audioData, const AudioInjectorOptions& injectorOptions) :
     _audioData(audioData),
+    _stream(SoundStream::create(audioData)),
     _options(injectorOptions)
 {
 }
 
 AudioInjector::~AudioInjector() {}
 
+std::unique_ptr<SoundStream> AudioInjector::createStream() const {
+    return _sound ? _sound->createStream() : SoundStream::create(_audioData);
+}
+
+int AudioInjector::getNumBytes() const {
+    return _stream ? (int)(_stream->getNumSamples() * sizeof(AudioConstants::AudioSample)) : 0;
+}
+
 bool AudioInjector::stateHas(AudioInjectorState state) const {
     return resultWithReadLock<bool>([&] {
         return (_state & state) == state;
@@ -163,9 +173,11 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
 bool AudioInjector::injectLocally() {
     bool success = false;
     if (_localAudioInterface) {
-        if (_audioData->getNumBytes() > 0) {
+        if (getNumBytes() > 0) {
 
-            _localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(new AudioInjectorLocalBuffer(_audioData), &AudioInjectorLocalBuffer::deleteLater);
+            // the local buffer reads a stream of its own, on the local injector thread
+            _localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(new AudioInjectorLocalBuffer(createStream()),
+                                                                    &AudioInjectorLocalBuffer::deleteLater);
             _localBuffer->moveToThread(thread());
 
             _localBuffer->open(QIODevice::ReadOnly);
@@ -225,12 +237,12 @@ int64_t AudioInjector::injectNextFrame() {
 
     if (!_currentPacket) {
         if (_currentSendOffset < 0 ||
-            _currentSendOffset >= (int)_audioData->getNumBytes()) {
+            _currentSendOffset >= getNumBytes()) {
             _currentSendOffset = 0;
         }
 
         // make sure we actually have samples downloaded to inject
-        if (_audioData && _audioData->getNumSamples() > 0) {
+        if (getNumBytes() > 0) {
             _outgoingSequenceNumber = 0;
             _nextFrame = 0;
 
@@ -331,33 +343,42 @@ int64_t AudioInjector::injectNextFrame() {
     QByteArray decodedAudio;
 
     int totalBytesLeftToCopy = (options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
-    if (!options.loop) {
-        // If we aren't looping, let's make sure we don't read past the end
-        int bytesLeftToRead = _audioData->getNumBytes() - _currentSendOffset;
-        totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, bytesLeftToRead);
-    }
 
-    auto samples = _audioData->data();
     auto currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
-    auto samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
+    int samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
 
     using AudioConstants::AudioSample;
     decodedAudio.resize(totalBytesLeftToCopy);
     auto samplesOut = reinterpret_cast<AudioSample*>(decodedAudio.data());
 
-    //  Copy and Measure the loudness of this frame
+    // Read the frame from the sound (decoding it, if it is streamed), from its start again when looping
+    if (_stream->getPosition() != (uint32_t)currentSample) {
+        _stream->seek(currentSample);
+    }
+    int samplesCopied = _stream->read(samplesOut, samplesLeftToCopy);
+    while (options.loop && samplesCopied < samplesLeftToCopy) {
+        _stream->seek(0);
+        int samplesCopiedFromFront = _stream->read(samplesOut + samplesCopied, samplesLeftToCopy - samplesCopied);
+        if (samplesCopiedFromFront == 0) {
+            break;
+        }
+        samplesCopied += samplesCopiedFromFront;
+    }
+    bool isAtEnd = samplesCopied < samplesLeftToCopy || _stream->getPosition() >= _stream->getNumSamples();
+    if (!options.loop) {
+        // If we aren't looping, the last frame is the rest of the sound
+        decodedAudio.resize(samplesCopied * AudioConstants::SAMPLE_SIZE);
+    }
+
+    //  Measure the loudness of this frame
     withWriteLock([&] {
         _loudness = 0.0f;
-        for (int i = 0; i < samplesLeftToCopy; ++i) {
-            auto index = (currentSample + i) % _audioData->getNumSamples();
-            auto sample = samples[index];
-            samplesOut[i] = sample;
-            _loudness += abs(sample) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+        for (int i = 0; i < samplesCopied; ++i) {
+            _loudness += abs(samplesOut[i]) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
         }
-        _loudness /= (float)samplesLeftToCopy;
+        _loudness /= (float)std::max(samplesCopied, 1);
     });
-    _currentSendOffset = (_currentSendOffset + totalBytesLeftToCopy) %
-                         _audioData->getNumBytes();
+    _currentSendOffset = (int)(_stream->getPosition() * AudioConstants::SAMPLE_SIZE);
 
     // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
     // codec to use... possible through AbstractAudioInterface.
@@ -377,7 +398,7 @@ int64_t AudioInjector::injectNextFrame() {
         _outgoingSequenceNumber++;
     }
 
-    if (_currentSendOffset == 0 && !options.loop) {
+    if (isAtEnd && !options.loop) {
         finishNetworkInjection();
         return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
     }
@@ -397,7 +418,7 @@ int64_t AudioInjector::injectNextFrame() {
         // If we are falling behind by more frames than our threshold, let's skip the frames ahead
         qCDebug(audio)  << this << "injectNextFrame() skipping ahead, fell behind by " << (currentFrameBasedOnElapsedTime - _nextFrame) << " frames";
         _nextFrame = currentFrameBasedOnElapsedTime;
-        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (options.stereo ? 2 : 1) % _audioData->getNumBytes();
+        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (options.stereo ? 2 : 1) % getNumBytes();
     }
 
     int64_t playNextFrameAt = ++_nextFrame * AudioConstants::NETWORK_FRAME_USECS;
@@ -102,10 +102,15 @@ private:
     bool injectLocally();
     void sendStopInjectorPacket();
 
+    std::unique_ptr<SoundStream> createStream() const;
+    int getNumBytes() const;
+
     static AbstractAudioInterface* _localAudioInterface;
 
     const SharedSoundPointer _sound;
     AudioDataPointer _audioData;
+    // read by the network injection, which decodes a streamed sound as it goes
+    std::unique_ptr<SoundStream> _stream;
     AudioInjectorOptions _options;
     AudioInjectorState _state { AudioInjectorState::NotFinished };
     bool _hasSentFirstFrame { false };
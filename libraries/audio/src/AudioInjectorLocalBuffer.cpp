@@ -12,7 +12,12 @@
 #include "AudioInjectorLocalBuffer.h"
 
 AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(AudioDataPointer audioData) :
-    _audioData(audioData)
+    _stream(SoundStream::create(audioData))
+{
+}
+
+AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(std::unique_ptr<SoundStream> stream) :
+    _stream(std::move(stream))
 {
 }
 
@@ -34,53 +39,33 @@ bool AudioInjectorLocalBuffer::seek(qint64 pos) {
     }
 }
 
-qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
-    if (!_isStopped && _audioData) {
-        
-        // first copy to the end of the raw audio
-        int bytesToEnd = (int)_audioData->getNumBytes() - _currentOffset;
-        
-        int bytesRead = maxSize;
-        
-        if (maxSize > bytesToEnd) {
-            bytesRead = bytesToEnd;
-        }
-        
-        memcpy(data, _audioData->rawData() + _currentOffset, bytesRead);
-        
-        // now check if we are supposed to loop and if we can copy more from the beginning
-        if (_shouldLoop && maxSize != bytesRead) {
-            bytesRead += recursiveReadFromFront(data + bytesRead, maxSize - bytesRead);
-        } else {
-            _currentOffset += bytesRead;
-        }
-        
-        if (_shouldLoop && _currentOffset == (int)_audioData->getNumBytes()) {
-            _currentOffset = 0;
-        }
-        
-        return bytesRead;
-    } else {
-        return 0;
+void AudioInjectorLocalBuffer::setCurrentOffset(int currentOffset) {
+    if (_stream) {
+        _stream->seek(currentOffset / sizeof(SoundStream::AudioSample));
     }
 }
 
-qint64 AudioInjectorLocalBuffer::recursiveReadFromFront(char* data, qint64 maxSize) {
-    // see how much we can get in this pass
-    int bytesRead = maxSize;
-    
-    if (bytesRead > (int)_audioData->getNumBytes()) {
-        bytesRead = _audioData->getNumBytes();
-    }
-    
-    // copy that amount
-    memcpy(data, _audioData->rawData(), bytesRead);
-    
-    // check if we need to call ourselves again and pull from the front again
-    if (bytesRead < maxSize) {
-        return bytesRead + recursiveReadFromFront(data + bytesRead, maxSize - bytesRead);
+qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
+    if (!_isStopped && _stream) {
+        auto samples = reinterpret_cast<SoundStream::AudioSample*>(data);
+        int numSamples = (int)(maxSize / sizeof(SoundStream::AudioSample));
+        numSamples -= numSamples % _stream->getNumChannels();
+
+        // read to the end of the sound (decoding it, if it is streamed)
+        int numRead = _stream->read(samples, numSamples);
+
+        // now check if we are supposed to loop and if we can read more from the beginning
+        while (_shouldLoop && numRead < numSamples) {
+            _stream->seek(0);
+            int numReadFromFront = _stream->read(samples + numRead, numSamples - numRead);
+            if (numReadFromFront == 0) {
+                break;
+            }
+            numRead += numReadFromFront;
+        }
+
+        return numRead * sizeof(SoundStream::AudioSample);
     } else {
-        _currentOffset = bytesRead;
-        return bytesRead;
+        return 0;
     }
 }
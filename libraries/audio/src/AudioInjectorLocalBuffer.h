@@ -22,6 +22,7 @@ class AudioInjectorLocalBuffer : public QIODevice {
     Q_OBJECT
 public:
     AudioInjectorLocalBuffer(AudioDataPointer audioData);
+    AudioInjectorLocalBuffer(std::unique_ptr<SoundStream> stream);
     ~AudioInjectorLocalBuffer();
 
     void stop();
@@ -32,15 +33,12 @@ public:
     qint64 writeData(const char* data, qint64 maxSize) override { return 0; }
 
     void setShouldLoop(bool shouldLoop) { _shouldLoop = shouldLoop; }
-    void setCurrentOffset(int currentOffset) { _currentOffset = currentOffset; }
+    void setCurrentOffset(int currentOffset);
 
 private:
-    qint64 recursiveReadFromFront(char* data, qint64 maxSize);
-
-    AudioDataPointer _audioData;
+    std::unique_ptr<SoundStream> _stream;
     bool _shouldLoop { false };
     bool _isStopped { false };
-    int _currentOffset { 0 };
 };
 
 #endif // hifi_AudioInjectorLocalBuffer_h
@@ -192,7 +192,8 @@ AudioInjectorPointer AudioInjectorManager::playSound(const SharedSoundPointer& s
             const float pitch = glm::clamp(options.pitch, 1 / 16.0f, 16.0f);
             const int resampledRate = glm::round(SAMPLE_RATE / pitch);
 
-            auto audioData = sound->getAudioData();
+            // resampled whole, so a streamed sound is decoded whole too
+            auto audioData = sound->decodeAudioData();
             auto numChannels = audioData->getNumChannels();
             auto numFrames = audioData->getNumFrames();
 
@@ -191,6 +191,40 @@ int32_t LimiterImpl::envelope(int32_t attn) {
     return attn;
 }
 
+//
+// Peak detection of a block of interleaved stereo, ahead of the envelope which must run a frame at a time
+//
+static void peaklog2_2x1_scalar(float* input, int32_t* output, int numFrames) {
+    for (int n = 0; n < numFrames; n++) {
+        output[n] = peaklog2(&input[2*n+0], &input[2*n+1]);
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void peaklog2_2x1_AVX2(float* input, int32_t* output, int numFrames);
+
+static void peaklog2_2x1(float* input, int32_t* output, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? peaklog2_2x1_AVX2 : peaklog2_2x1_scalar;
+    (*f)(input, output, numFrames); // dispatch
+}
+
+#else
+
+static void peaklog2_2x1(float* input, int32_t* output, int numFrames) {
+    peaklog2_2x1_scalar(input, output, numFrames);
+}
+
+#endif
+
+static const int PEAK_BLOCK_FRAMES = 256;
+
 //
 // Limiter (mono)
 //
@@ -261,10 +295,16 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
+    int32_t peaks[PEAK_BLOCK_FRAMES];
+
     for (int n = 0; n < numFrames; n++) {
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+        // peak detect and convert to log2 domain, a block at a time
+        int blockIndex = n % PEAK_BLOCK_FRAMES;
+        if (blockIndex == 0) {
+            peaklog2_2x1(&input[2*n], peaks, MIN(numFrames - n, PEAK_BLOCK_FRAMES));
+        }
+        int32_t peak = peaks[blockIndex];
 
         // compute limiter attenuation
         int32_t attn = MAX(_threshold - peak, 0);
@@ -26,6 +26,8 @@ const int InboundAudioStream::MAX_FRAMES_OVER_DESIRED = 10;
 const int InboundAudioStream::WINDOW_STARVE_THRESHOLD = 3;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
+const int InboundAudioStream::JITTER_PERCENTILE_NUM_GAPS = 500; // 5s
+const float InboundAudioStream::JITTER_PERCENTILE = 0.99f;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
 
@@ -91,6 +93,7 @@ void InboundAudioStream::resetStats() {
     _lastPacketReceivedTime = 0;
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
     _timeGapStatsForDesiredReduction.reset();
+    _timeGapPercentileForDesiredCalc.reset();
     _starveHistory.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
@@ -148,7 +151,17 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
             // also result in allowing the codec to interpolate lost data. Then
             // fall through to the "on time" logic to actually handle this packet
             int packetsDropped = arrivalInfo._seqDiffFromExpected;
-            lostAudioData(packetsDropped);
+            bool isSilentPacket = message.getType() == PacketType::SilentAudioFrame
+                || message.getType() == PacketType::ReplicatedSilentAudioFrame;
+            if (packetsDropped > 0 && !isSilentPacket && codecInPacket == _selectedCodecName && _decoder) {
+                // the last of the lost frames may be recovered from what the codec carries of it in this packet
+                lostAudioData(packetsDropped - 1);
+                int preAudioPosition = message.getPosition();
+                recoverAudioData(message.readWithoutCopy(message.getBytesLeftToRead()));
+                message.seek(preAudioPosition);
+            } else {
+                lostAudioData(packetsDropped);
+            }
 
             // fall through to OnTime case
         }
@@ -267,6 +280,20 @@ int InboundAudioStream::lostAudioData(int numPackets) {
     return 0;
 }
 
+int InboundAudioStream::recoverAudioData(const QByteArray& nextPacketAfterStreamProperties) {
+    QByteArray decodedBuffer;
+
+    // see parseAudioData
+    QMutexLocker lock(&_decoderMutex);
+    if (_decoder) {
+        _decoder->recoverFrame(nextPacketAfterStreamProperties, decodedBuffer);
+    } else {
+        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * _numChannels);
+        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+    }
+    return _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
+}
+
 int InboundAudioStream::parseAudioData(const QByteArray& packetAfterStreamProperties) {
     QByteArray decodedBuffer;
 
@@ -505,13 +532,23 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
         }
 
         if (_dynamicJitterBufferEnabled) {
+            _timeGapPercentileForDesiredCalc.updatePercentile(gap);
+
             // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
-            // then reduce _desiredJitterBufferFrames to that number of frames.
+            // then reduce _desiredJitterBufferFrames toward that number of frames, a frame at a time so that the buffer
+            // drains smoothly rather than dropping frames all at once.
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
                 int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
                                                          / (float)AudioConstants::NETWORK_FRAME_USECS);
-                if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
-                    _desiredJitterBufferFrames = calculatedJitterBufferFrames;
+                // the gaps of the last few seconds are long enough that the stream is about to starve: grow now
+                // rather than waiting for the starves to pile up
+                int percentileJitterBufferFrames = ceilf((float)_timeGapPercentileForDesiredCalc.getValueAtPercentile()
+                                                         / (float)AudioConstants::NETWORK_FRAME_USECS);
+                if (percentileJitterBufferFrames > _desiredJitterBufferFrames) {
+                    _desiredJitterBufferFrames = percentileJitterBufferFrames;
+                    qCInfo(audiostream, "Set desired jitter frames to %d (percentile)", _desiredJitterBufferFrames);
+                } else if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
+                    _desiredJitterBufferFrames = std::max(calculatedJitterBufferFrames, _desiredJitterBufferFrames - 1);
                     qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
                 }
                 _timeGapStatsForDesiredReduction.clearNewStatsAvailableFlag();
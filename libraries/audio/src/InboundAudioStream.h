@@ -23,6 +23,7 @@
 
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
+#include "MovingPercentile.h"
 #include "SequenceNumberStats.h"
 #include "AudioStreamStats.h"
 #include "TimeWeightedAvg.h"
@@ -44,6 +45,8 @@ public:
     static const int WINDOW_STARVE_THRESHOLD;
     static const int WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES;
     static const int WINDOW_SECONDS_FOR_DESIRED_REDUCTION;
+    static const int JITTER_PERCENTILE_NUM_GAPS;
+    static const float JITTER_PERCENTILE;
     // unused (eradicated) settings
     static const bool USE_STDEV_FOR_JITTER;
     static const bool REPETITION_WITH_FADE;
@@ -137,6 +140,10 @@ protected:
     /// produces audio data for lost network packets.
     virtual int lostAudioData(int numPackets);
 
+    /// produces audio data for the network packet lost just before this one, from what the codec carries of it in this
+    /// one if anything.
+    virtual int recoverAudioData(const QByteArray& nextPacketAfterStreamProperties);
+
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
     
@@ -168,6 +175,8 @@ protected:
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
+    // a high percentile of the recent gaps, that the desired frames grow to ahead of the starves
+    MovingPercentile _timeGapPercentileForDesiredCalc { JITTER_PERCENTILE_NUM_GAPS, JITTER_PERCENTILE };
 
     RingBufferHistory<quint64> _starveHistory;
 
@@ -23,9 +23,9 @@
 
 InjectedAudioStream::InjectedAudioStream(const QUuid& streamIdentifier, bool isStereo, int numStaticJitterFrames) :
     PositionalAudioStream(PositionalAudioStream::Injector, isStereo, numStaticJitterFrames),
-    _streamIdentifier(streamIdentifier),
     _radius(0.0f),
-    _attenuationRatio(0) {} 
+    _attenuationRatio(0),
+    _streamIdentifier(streamIdentifier) {} 
 
 int InjectedAudioStream::parseStreamProperties(PacketType type,
                                                const QByteArray& packetAfterSeqNum,
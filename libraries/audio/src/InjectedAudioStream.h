@@ -27,6 +27,10 @@ public:
 
     virtual const QUuid& getStreamIdentifier() const override { return _streamIdentifier; }
 
+protected:
+    float _radius;
+    float _attenuationRatio;
+
 private:
     Q_DISABLE_COPY(InjectedAudioStream)
 
@@ -34,8 +38,6 @@ private:
     int parseStreamProperties(PacketType type, const QByteArray& packetAfterSeqNum, int& numAudioSamples) override;
 
     const QUuid _streamIdentifier;
-    float _radius;
-    float _attenuationRatio;
 };
 
 #endif // hifi_InjectedAudioStream_h
@@ -61,6 +61,26 @@ int MixedProcessedAudioStream::lostAudioData(int numPackets) {
     return 0;
 }
 
+int MixedProcessedAudioStream::recoverAudioData(const QByteArray& nextPacketAfterStreamProperties) {
+    QByteArray decodedBuffer;
+
+    // see parseAudioData
+    QMutexLocker lock(&_decoderMutex);
+    if (_decoder) {
+        _decoder->recoverFrame(nextPacketAfterStreamProperties, decodedBuffer);
+    } else {
+        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+    }
+    emit addedStereoSamples(decodedBuffer);
+
+    QByteArray outputBuffer;
+    emit processSamples(decodedBuffer, outputBuffer);
+
+    _ringBuffer.writeData(outputBuffer.data(), outputBuffer.size());
+    return 0;
+}
+
 int MixedProcessedAudioStream::parseAudioData(const QByteArray& packetAfterStreamProperties) {
     QByteArray decodedBuffer;
 
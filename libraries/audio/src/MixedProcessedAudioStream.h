@@ -36,6 +36,7 @@ protected:
     int writeDroppableSilentFrames(int silentFrames) override;
     int parseAudioData(const QByteArray& packetAfterStreamProperties) override;
     int lostAudioData(int numPackets) override;
+    int recoverAudioData(const QByteArray& nextPacketAfterStreamProperties) override;
 
 private:
     int networkToDeviceFrames(int networkFrames);
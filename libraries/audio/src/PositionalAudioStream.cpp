@@ -12,6 +12,7 @@
 #include "PositionalAudioStream.h"
 #include "SharedUtil.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include <QtCore/QDataStream>
@@ -42,6 +43,8 @@ PositionalAudioStream::PositionalAudioStream(PositionalAudioStream::Type type, b
 void PositionalAudioStream::resetStats() {
     _lastPopOutputTrailingLoudness = 0.0f;
     _lastPopOutputLoudness = 0.0f;
+    _lastPopOutputBandEnergies.fill(0.0f);
+    _lastPopOutputTrailingBandEnergies.fill(0.0f);
 }
 
 void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
@@ -71,6 +74,50 @@ void PositionalAudioStream::updateLastPopOutputLoudnessAndTrailingLoudness() {
     if (_lastPopOutputLoudness < _quietestTrailingFrameLoudness) {
         _quietestTrailingFrameLoudness = _lastPopOutputLoudness;
     }
+
+    updateLastPopOutputBandEnergies();
+}
+
+void PositionalAudioStream::updateLastPopOutputBandEnergies() {
+    // one-pole lowpass coefficients 1 - exp(-2*pi*fc/fs) for splits at 375Hz, 1.5kHz and 6kHz
+    static const float BAND_SPLIT_COEFS[NUM_BANDS - 1] = { 0.0935f, 0.3247f, 0.7921f };
+    // 100ms at one frame every 10ms
+    static const float TRAILING_BAND_RELEASE = 0.9f;
+    static const float SAMPLE_SCALE = 1.0f / AudioConstants::MAX_SAMPLE_VALUE;
+
+    _lastPopOutputBandEnergies.fill(0.0f);
+
+    if (!_lastPopOutput.isNull()) {
+        const int numChannels = _isStereo ? AudioConstants::STEREO : AudioConstants::MONO;
+        const int numFrameSamples = _ringBuffer.getNumFrameSamples();
+
+        // each band is the difference between two successive lowpasses
+        AudioRingBuffer::ConstIterator sampleAt = _lastPopOutput;
+        for (int i = 0; i < numFrameSamples; ++i) {
+            float* states = _bandSplitStates[i % numChannels];
+            float x = (float)*sampleAt * SAMPLE_SCALE;
+            ++sampleAt;
+
+            float lower = 0.0f;
+            for (int band = 0; band < NUM_BANDS - 1; ++band) {
+                states[band] += BAND_SPLIT_COEFS[band] * (x - states[band]);
+                float y = states[band] - lower;
+                _lastPopOutputBandEnergies[band] += y * y;
+                lower = states[band];
+            }
+            float y = x - lower;
+            _lastPopOutputBandEnergies[NUM_BANDS - 1] += y * y;
+        }
+
+        for (auto& energy : _lastPopOutputBandEnergies) {
+            energy /= numFrameSamples;
+        }
+    }
+
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        _lastPopOutputTrailingBandEnergies[band] = std::max(_lastPopOutputBandEnergies[band],
+                                                            _lastPopOutputTrailingBandEnergies[band] * TRAILING_BAND_RELEASE);
+    }
 }
 
 int PositionalAudioStream::parsePositionalData(const QByteArray& positionalByteArray) {
@@ -12,6 +12,8 @@
 #ifndef hifi_PositionalAudioStream_h
 #define hifi_PositionalAudioStream_h
 
+#include <array>
+
 #include <glm/gtx/quaternion.hpp>
 #include <AABox.h>
 
@@ -59,6 +61,13 @@ public:
     float getLastPopOutputLoudness() const { return _lastPopOutputLoudness; }
     float getQuietestFrameLoudness() const { return _quietestFrameLoudness; }
 
+    // energy of the last popped frame in a few broad bands, summed over channels, for the mixer's masking estimate
+    static const int NUM_BANDS = 4;
+    using BandEnergies = std::array<float, NUM_BANDS>;
+    const BandEnergies& getLastPopOutputBandEnergies() const { return _lastPopOutputBandEnergies; }
+    // the same, held at the peak and released over about 100ms, as a masked sound is still heard for a while
+    const BandEnergies& getLastPopOutputTrailingBandEnergies() const { return _lastPopOutputTrailingBandEnergies; }
+
     bool shouldLoopbackForNode() const { return _shouldLoopbackForNode; }
     bool isStereo() const { return _isStereo; }
 
@@ -88,6 +97,7 @@ protected:
 
 protected:
     void calculateIgnoreBox();
+    void updateLastPopOutputBandEnergies();
 
     Type _type;
     glm::vec3 _position;
@@ -107,6 +117,11 @@ protected:
     float _quietestFrameLoudness;
     int _frameCounter;
 
+    BandEnergies _lastPopOutputBandEnergies {};
+    BandEnergies _lastPopOutputTrailingBandEnergies {};
+    // one-pole lowpass states of the band splits, per channel
+    float _bandSplitStates[AudioConstants::STEREO][NUM_BANDS - 1] {};
+
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
 };
@@ -34,6 +34,10 @@
 #include "flump3dec.h"
 
 int audioDataPointerMetaTypeID = qRegisterMetaType<AudioDataPointer>("AudioDataPointer");
+int encodedSoundPointerMetaTypeID = qRegisterMetaType<EncodedSoundPointer>("EncodedSoundPointer");
+
+// sounds at least this long are decoded as they are played
+static const float STREAMED_SOUND_MIN_SECONDS = 30.0f;
 
 using AudioConstants::AudioSample;
 
@@ -78,6 +82,7 @@ void Sound::downloadFinished(const QByteArray& data) {
     // this is a QRunnable, will delete itself after it has finished running
     auto soundProcessor = new SoundProcessor(_self, data);
     connect(soundProcessor, &SoundProcessor::onSuccess, this, &Sound::soundProcessSuccess);
+    connect(soundProcessor, &SoundProcessor::onStreamed, this, &Sound::soundProcessStreamed);
     connect(soundProcessor, &SoundProcessor::onError, this, &Sound::soundProcessError);
     QThreadPool::globalInstance()->start(soundProcessor);
 }
@@ -91,6 +96,15 @@ void Sound::soundProcessSuccess(AudioDataPointer audioData) {
     emit ready();
 }
 
+void Sound::soundProcessStreamed(EncodedSoundPointer encodedSound) {
+    qCDebug(audio) << "Setting ready state for streamed sound file" << _url.fileName();
+
+    _encodedSound = std::move(encodedSound);
+    finishedLoading(true);
+
+    emit ready();
+}
+
 void Sound::soundProcessError(int error, QString str) {
     qCCritical(audio) << "Failed to process sound file: code =" << error << str;
     emit failed(QNetworkReply::UnknownContentError);
@@ -98,6 +112,40 @@ void Sound::soundProcessError(int error, QString str) {
 }
 
 
+int Sound::getReadyNumChannels() const {
+    if (_audioData) {
+        return _audioData->getNumChannels();
+    }
+    return _encodedSound ? _encodedSound->numChannels : 0;
+}
+
+float Sound::getDuration() const {
+    if (_audioData) {
+        return _audioData->getDuration();
+    }
+    return _encodedSound ? (float)_encodedSound->numFrames / _encodedSound->sampleRate : 0.0f;
+}
+
+std::unique_ptr<SoundStream> Sound::createStream() const {
+    if (_audioData) {
+        return SoundStream::create(_audioData);
+    }
+    if (_encodedSound) {
+        return SoundStream::create(_encodedSound);
+    }
+    return nullptr;
+}
+
+AudioDataPointer Sound::decodeAudioData() const {
+    if (!_encodedSound) {
+        return _audioData;
+    }
+    auto stream = SoundStream::create(_encodedSound);
+    std::vector<AudioSample> samples(stream->getNumSamples());
+    int numSamples = stream->read(samples.data(), (int)samples.size());
+    return AudioData::make(numSamples, stream->getNumChannels(), samples.data());
+}
+
 SoundProcessor::SoundProcessor(QWeakPointer<Resource> sound, QByteArray data) :
     _sound(sound),
     _data(data)
@@ -121,6 +169,20 @@ void SoundProcessor::run() {
     static const QString STEREO_RAW_EXTENSION = ".stereo.raw";
     QString fileType;
 
+    // long sounds are kept as they are, to be decoded as they are played
+    EncodedSoundPointer encodedSound;
+    if (fileName.endsWith(WAV_EXTENSION)) {
+        encodedSound = probeAsWav(_data);
+    } else if (fileName.endsWith(MP3_EXTENSION)) {
+        encodedSound = probeAsMP3(_data);
+    }
+    if (encodedSound && encodedSound->numFrames >= STREAMED_SOUND_MIN_SECONDS * encodedSound->sampleRate) {
+        qCDebug(audio) << "Streaming sound file" << fileName << "of" << encodedSound->numFrames / encodedSound->sampleRate
+                       << "seconds";
+        emit onStreamed(encodedSound);
+        return;
+    }
+
     QByteArray outputAudioByteArray;
     AudioProperties properties;
 
@@ -238,9 +300,9 @@ struct WAVEFormat {
     quint16     bitsPerSample;
 };
 
-// returns wavfile sample rate, used for resampling
-SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray& inputAudioByteArray,
-                                                               QByteArray& outputAudioByteArray) {
+// returns wavfile sample rate, used for resampling, and where its samples are
+SoundProcessor::AudioProperties SoundProcessor::parseWavHeader(const QByteArray& inputAudioByteArray,
+                                                               int& pcmOffset, int& pcmSize) {
     AudioProperties properties;
 
     // Create a data stream to analyze the data
@@ -320,11 +382,10 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray&
         waveStream.skipRawData(qFromLittleEndian<quint32>(data.size));  // next chunk
     }
 
-    // Read the "data" chunk
-    quint32 outputAudioByteArraySize = qFromLittleEndian<quint32>(data.size);
-    outputAudioByteArray.resize(outputAudioByteArraySize);
-    auto bytesRead = waveStream.readRawData(outputAudioByteArray.data(), outputAudioByteArraySize);
-    if (bytesRead != (int)outputAudioByteArraySize) {
+    // Find the "data" chunk
+    pcmOffset = (int)waveStream.device()->pos();
+    pcmSize = (int)qFromLittleEndian<quint32>(data.size);
+    if (pcmSize < 0 || pcmSize > inputAudioByteArray.size() - pcmOffset) {
         qCWarning(audio) << "Error reading WAV file";
         return AudioProperties();
     }
@@ -333,6 +394,37 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray&
     return properties;
 }
 
+// returns wavfile sample rate, used for resampling
+SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray& inputAudioByteArray,
+                                                               QByteArray& outputAudioByteArray) {
+    int pcmOffset = 0;
+    int pcmSize = 0;
+    AudioProperties properties = parseWavHeader(inputAudioByteArray, pcmOffset, pcmSize);
+    if (properties.sampleRate != 0) {
+        outputAudioByteArray = inputAudioByteArray.mid(pcmOffset, pcmSize);
+    }
+    return properties;
+}
+
+EncodedSoundPointer SoundProcessor::probeAsWav(const QByteArray& inputAudioByteArray) {
+    int pcmOffset = 0;
+    int pcmSize = 0;
+    AudioProperties properties = parseWavHeader(inputAudioByteArray, pcmOffset, pcmSize);
+    if (properties.sampleRate == 0) {
+        return nullptr;
+    }
+
+    auto encodedSound = std::make_shared<EncodedSound>();
+    encodedSound->data = inputAudioByteArray;
+    encodedSound->format = EncodedSound::PCM;
+    encodedSound->numChannels = properties.numChannels;
+    encodedSound->sampleRate = properties.sampleRate;
+    encodedSound->pcmOffset = pcmOffset;
+    encodedSound->pcmSize = pcmSize;
+    encodedSound->numFrames = pcmSize / (properties.numChannels * AudioConstants::SAMPLE_SIZE);
+    return encodedSound;
+}
+
 // returns MP3 sample rate, used for resampling
 SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray& inputAudioByteArray,
                                                                QByteArray& outputAudioByteArray) {
@@ -421,6 +513,55 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
     return properties;
 }
 
+EncodedSoundPointer SoundProcessor::probeAsMP3(const QByteArray& inputAudioByteArray) {
+    using namespace flump3dec;
+
+    Bit_stream_struc *bitstream = bs_new();
+    if (bitstream == nullptr) {
+        return nullptr;
+    }
+    mp3tl *decoder = mp3tl_new(bitstream, MP3TL_MODE_16BIT);
+    if (decoder == nullptr) {
+        bs_free(bitstream);
+        return nullptr;
+    }
+
+    auto encodedSound = std::make_shared<EncodedSound>();
+    encodedSound->data = inputAudioByteArray;
+    encodedSound->format = EncodedSound::MP3;
+
+    // count the frames as interpretAsMP3 decodes them, skipping over their data
+    bs_set_data(bitstream, (uint8_t*)inputAudioByteArray.data(), inputAudioByteArray.size());
+    int frameCount = 0;
+    Mp3TlRetcode result = mp3tl_skip_id3(decoder);
+    while (!(result == MP3TL_ERR_NO_SYNC || result == MP3TL_ERR_NEED_DATA)) {
+        mp3tl_sync(decoder);
+        const fr_header *header = nullptr;
+        result = mp3tl_decode_header(decoder, &header);
+        if (result == MP3TL_ERR_OK) {
+            if (frameCount++ == 0) {
+                encodedSound->sampleRate = header->sample_rate;
+                encodedSound->numChannels = header->channels;
+                result = mp3tl_skip_xing(decoder, header);
+            }
+            if (result == MP3TL_ERR_OK) {
+                result = mp3tl_skip_frame(decoder);
+                if (result == MP3TL_ERR_OK || result == MP3TL_ERR_BAD_FRAME) {
+                    encodedSound->numFrames += header->frame_samples;
+                }
+            }
+        }
+    }
+
+    mp3tl_free(decoder);
+    bs_free(bitstream);
+
+    if (encodedSound->numFrames == 0 || encodedSound->sampleRate == 0) {
+        return nullptr;
+    }
+    return encodedSound;
+}
+
 
 QScriptValue soundSharedPointerToScriptValue(QScriptEngine* engine, const SharedSoundPointer& in) {
     return engine->newQObject(new SoundScriptingInterface(in), QScriptEngine::ScriptOwnership);
@@ -21,11 +21,13 @@
 #include <ResourceCache.h>
 
 #include "AudioConstants.h"
+#include "SoundStream.h"
 
 class AudioData;
 using AudioDataPointer = std::shared_ptr<const AudioData>;
 
 Q_DECLARE_METATYPE(AudioDataPointer);
+Q_DECLARE_METATYPE(EncodedSoundPointer);
 
 // AudioData is designed to be immutable
 // All of its members and methods are const
@@ -62,15 +64,22 @@ class Sound : public Resource {
 
 public:
     Sound(const QUrl& url, bool isStereo = false, bool isAmbisonic = false);
-    Sound(const Sound& other) : Resource(other), _audioData(other._audioData), _numChannels(other._numChannels) {}
+    Sound(const Sound& other) : Resource(other), _audioData(other._audioData), _encodedSound(other._encodedSound),
+        _numChannels(other._numChannels) {}
 
-    bool isReady() const { return (bool)_audioData; }
+    bool isReady() const { return _audioData || _encodedSound; }
 
-    bool isStereo() const { return _audioData ? _audioData->isStereo() : false; }
-    bool isAmbisonic() const { return _audioData ? _audioData->isAmbisonic() : false; }
-    float getDuration() const { return _audioData ? _audioData->getDuration() : 0.0f; }
+    bool isStereo() const { return getReadyNumChannels() == 2; }
+    bool isAmbisonic() const { return getReadyNumChannels() == 4; }
+    float getDuration() const;
 
+    // a long sound is not decoded when it loads, but as it is played, and has no AudioData; createStream reads either
+    bool isStreamed() const { return (bool)_encodedSound; }
     AudioDataPointer getAudioData() const { return _audioData; }
+    std::unique_ptr<SoundStream> createStream() const;
+
+    // returns the decoded audio, decoding the whole of a streamed sound
+    AudioDataPointer decodeAudioData() const;
 
     int getNumChannels() const { return _numChannels; }
 
@@ -79,12 +88,16 @@ signals:
 
 protected slots:
     void soundProcessSuccess(AudioDataPointer audioData);
+    void soundProcessStreamed(EncodedSoundPointer encodedSound);
     void soundProcessError(int error, QString str);
     
 private:
     virtual void downloadFinished(const QByteArray& data) override;
 
+    int getReadyNumChannels() const;
+
     AudioDataPointer _audioData;
+    EncodedSoundPointer _encodedSound;
 
      // Only used for caching until the download has finished
     int _numChannels { 0 };
@@ -105,13 +118,19 @@ public:
 
     QByteArray downSample(const QByteArray& rawAudioByteArray,
                           AudioProperties properties);
+    AudioProperties parseWavHeader(const QByteArray& inputAudioByteArray, int& pcmOffset, int& pcmSize);
     AudioProperties interpretAsWav(const QByteArray& inputAudioByteArray,
                                    QByteArray& outputAudioByteArray);
     AudioProperties interpretAsMP3(const QByteArray& inputAudioByteArray,
                                    QByteArray& outputAudioByteArray);
 
+    // read the format and length of a file without decoding it, nullptr if it cannot be streamed
+    EncodedSoundPointer probeAsWav(const QByteArray& inputAudioByteArray);
+    EncodedSoundPointer probeAsMP3(const QByteArray& inputAudioByteArray);
+
 signals:
     void onSuccess(AudioDataPointer audioData);
+    void onStreamed(EncodedSoundPointer encodedSound);
     void onError(int error, QString str);
 
 private:
@@ -0,0 +1,238 @@
+//
+//  SoundStream.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AudioSRC.h"
+#include "Sound.h"
+
+#include "flump3dec.h"
+
+// the most samples per channel in an MP3 frame
+static const int MP3_FRAME_SAMPLES_MAX = 1152;
+// the frames of PCM resampled at a time
+static const int PCM_CHUNK_FRAMES = 1024;
+
+namespace {
+
+class AudioDataStream : public SoundStream {
+public:
+    AudioDataStream(AudioDataPointer audioData) : _audioData(audioData) {
+        _numChannels = audioData->getNumChannels();
+        _numSamples = audioData->getNumSamples();
+    }
+
+    int read(AudioSample* samples, int numSamples) override {
+        numSamples -= numSamples % _numChannels;
+        int numRead = std::min(numSamples, (int)(_numSamples - _position));
+        memcpy(samples, _audioData->data() + _position, numRead * sizeof(AudioSample));
+        _position += numRead;
+        return numRead;
+    }
+
+    void seek(uint32_t sample) override {
+        sample = std::min(sample, _numSamples);
+        _position = sample - sample % _numChannels;
+    }
+
+private:
+    AudioDataPointer _audioData;
+};
+
+}
+
+std::unique_ptr<SoundStream> SoundStream::create(AudioDataPointer audioData) {
+    return std::unique_ptr<SoundStream>(new AudioDataStream(audioData));
+}
+
+std::unique_ptr<SoundStream> SoundStream::create(EncodedSoundPointer encodedSound) {
+    return std::unique_ptr<SoundStream>(new EncodedSoundStream(encodedSound));
+}
+
+EncodedSoundStream::EncodedSoundStream(EncodedSoundPointer encodedSound) :
+    _sound(encodedSound)
+{
+    _numChannels = encodedSound->numChannels;
+    _numSamples = encodedSound->getNumSamples();
+    restart(0);
+}
+
+EncodedSoundStream::~EncodedSoundStream() {
+    freeMP3Decoder();
+}
+
+int EncodedSoundStream::read(AudioSample* samples, int numSamples) {
+    numSamples -= numSamples % _numChannels;
+
+    int numRead = 0;
+    while (numRead < numSamples) {
+        if (_bufferOffset == (int)_buffer.size()) {
+            // refill the buffer with the next chunk
+            if (!decodeSourceChunk()) {
+                break;
+            }
+            if (_resampler) {
+                int numSourceFrames = (int)_sourceSamples.size() / _numChannels;
+                _buffer.resize(_resampler->getMaxOutput(numSourceFrames) * _numChannels);
+                int numFrames = _resampler->render(_sourceSamples.data(), _buffer.data(), numSourceFrames);
+                _buffer.resize(numFrames * _numChannels);
+            } else {
+                _buffer.swap(_sourceSamples);
+            }
+            _bufferOffset = 0;
+            continue;
+        }
+
+        int numToCopy = std::min(numSamples - numRead, (int)_buffer.size() - _bufferOffset);
+        memcpy(samples + numRead, _buffer.data() + _bufferOffset, numToCopy * sizeof(AudioSample));
+        numRead += numToCopy;
+        _bufferOffset += numToCopy;
+    }
+
+    _position += numRead;
+    return numRead;
+}
+
+void EncodedSoundStream::seek(uint32_t sample) {
+    uint32_t frame = std::min(sample, _numSamples) / _numChannels;
+    restart((uint32_t)(((uint64_t)frame * _sound->sampleRate) / AudioConstants::SAMPLE_RATE));
+    _position = frame * _numChannels;
+}
+
+void EncodedSoundStream::restart(uint32_t sourceFrame) {
+    _buffer.clear();
+    _bufferOffset = 0;
+    _sourceSamples.clear();
+    _skipSourceFrames = 0;
+
+    // the filter history of the resampler belongs to the previous position
+    if (_sound->sampleRate != AudioConstants::SAMPLE_RATE) {
+        _resampler.reset(new AudioSRC(_sound->sampleRate, AudioConstants::SAMPLE_RATE, _numChannels));
+    }
+
+    if (_sound->format == EncodedSound::PCM) {
+        _nextSourceFrame = std::min(sourceFrame, _sound->numFrames);
+        return;
+    }
+
+    // MP3 frames can only be found from the start of the file
+    using namespace flump3dec;
+    freeMP3Decoder();
+    _bitstream = bs_new();
+    if (_bitstream) {
+        _decoder = mp3tl_new(_bitstream, MP3TL_MODE_16BIT);
+    }
+    if (!_decoder) {
+        freeMP3Decoder();
+        return;
+    }
+    bs_set_data(_bitstream, (const uint8_t*)_sound->data.constData(), _sound->data.size());
+    _mp3Result = mp3tl_skip_id3(_decoder);
+    _mp3FrameCount = 0;
+    _nextSourceFrame = 0;
+
+    // skip frames without decoding them until the target is within the next two, so that the frame before it is
+    // decoded and the bit reservoir of the frame it is in is filled
+    while (_nextSourceFrame + 2 * MP3_FRAME_SAMPLES_MAX <= sourceFrame && nextMP3Frame(false)) {}
+    _skipSourceFrames = sourceFrame - std::min(sourceFrame, _nextSourceFrame);
+}
+
+bool EncodedSoundStream::decodeSourceChunk() {
+    if (_sound->format == EncodedSound::PCM) {
+        uint32_t numFrames = std::min((uint32_t)PCM_CHUNK_FRAMES, _sound->numFrames - _nextSourceFrame);
+        if (numFrames == 0) {
+            return false;
+        }
+        auto pcm = reinterpret_cast<const AudioSample*>(_sound->data.constData() + _sound->pcmOffset) +
+            _nextSourceFrame * _numChannels;
+        _sourceSamples.assign(pcm, pcm + numFrames * _numChannels);
+        _nextSourceFrame += numFrames;
+        return true;
+    }
+
+    while (nextMP3Frame(true)) {
+        // drop what comes before the position of the last seek
+        int numFrames = (int)_sourceSamples.size() / _numChannels;
+        int numToSkip = (int)std::min(_skipSourceFrames, (uint32_t)numFrames);
+        _skipSourceFrames -= numToSkip;
+        if (numToSkip < numFrames) {
+            _sourceSamples.erase(_sourceSamples.begin(), _sourceSamples.begin() + numToSkip * _numChannels);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EncodedSoundStream::nextMP3Frame(bool shouldDecode) {
+    using namespace flump3dec;
+
+    if (!_decoder) {
+        return false;
+    }
+
+    // the same steps as SoundProcessor::interpretAsMP3, a frame at a time
+    while (!(_mp3Result == MP3TL_ERR_NO_SYNC || _mp3Result == MP3TL_ERR_NEED_DATA)) {
+
+        mp3tl_sync(_decoder);
+
+        const fr_header* header = nullptr;
+        _mp3Result = mp3tl_decode_header(_decoder, &header);
+        if (_mp3Result != MP3TL_ERR_OK) {
+            continue;
+        }
+
+        if (_mp3FrameCount++ == 0) {
+            // skip Xing header, if present
+            _mp3Result = mp3tl_skip_xing(_decoder, header);
+            if (_mp3Result != MP3TL_ERR_OK) {
+                continue;
+            }
+        }
+
+        int numFrameSamples = header->frame_samples;
+        if (shouldDecode && header->channels == _numChannels) {
+            _sourceSamples.resize(numFrameSamples * _numChannels);
+            _mp3Result = mp3tl_decode_frame(_decoder, (uint8_t*)_sourceSamples.data(),
+                                            (guint)(_sourceSamples.size() * sizeof(AudioSample)));
+        } else {
+            _mp3Result = mp3tl_skip_frame(_decoder);
+            if (shouldDecode) {
+                // a frame with other channels than the first is heard as silence
+                _sourceSamples.assign(numFrameSamples * _numChannels, 0);
+            }
+        }
+
+        // fill bad frames with silence
+        if (_mp3Result == MP3TL_ERR_BAD_FRAME && shouldDecode) {
+            std::fill(_sourceSamples.begin(), _sourceSamples.end(), 0);
+        }
+
+        if (_mp3Result == MP3TL_ERR_OK || _mp3Result == MP3TL_ERR_BAD_FRAME) {
+            _nextSourceFrame += numFrameSamples;
+            return true;
+        }
+    }
+    return false;
+}
+
+void EncodedSoundStream::freeMP3Decoder() {
+    if (_decoder) {
+        flump3dec::mp3tl_free(_decoder);
+        _decoder = nullptr;
+    }
+    if (_bitstream) {
+        flump3dec::bs_free(_bitstream);
+        _bitstream = nullptr;
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  SoundStream.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundStream_h
+#define hifi_SoundStream_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AudioConstants.h"
+
+class AudioData;
+class AudioSRC;
+
+namespace flump3dec {
+    struct Bit_stream_struc;
+    struct mp3tl;
+}
+
+// A sound kept as its downloaded file, to be decoded as it is played rather than all at once.
+// Like AudioData it is immutable, so that many streams can read it from any thread.
+struct EncodedSound {
+    enum Format {
+        PCM,
+        MP3
+    };
+
+    QByteArray data;
+    Format format { PCM };
+    int numChannels { 0 };
+    uint32_t sampleRate { 0 };
+
+    // the PCM samples in the data
+    int pcmOffset { 0 };
+    int pcmSize { 0 };
+
+    // at the sample rate of the file
+    uint32_t numFrames { 0 };
+
+    // at AudioConstants::SAMPLE_RATE
+    uint32_t getNumSamples() const {
+        return (uint32_t)(((uint64_t)numFrames * AudioConstants::SAMPLE_RATE) / sampleRate) * numChannels;
+    }
+};
+
+using EncodedSoundPointer = std::shared_ptr<const EncodedSound>;
+
+// Reads the interleaved samples of a sound in order, at AudioConstants::SAMPLE_RATE.
+// A stream has a position of its own and is used from one thread at a time.
+class SoundStream {
+public:
+    using AudioSample = AudioConstants::AudioSample;
+
+    static std::unique_ptr<SoundStream> create(std::shared_ptr<const AudioData> audioData);
+    static std::unique_ptr<SoundStream> create(EncodedSoundPointer encodedSound);
+
+    virtual ~SoundStream() {}
+
+    int getNumChannels() const { return _numChannels; }
+    uint32_t getNumSamples() const { return _numSamples; }
+    uint32_t getPosition() const { return _position; }
+
+    // reads whole frames, up to numSamples; fewer are only read at the end of the sound
+    virtual int read(AudioSample* samples, int numSamples) = 0;
+
+    // moves to the frame of this sample
+    virtual void seek(uint32_t sample) = 0;
+
+protected:
+    int _numChannels { 0 };
+    uint32_t _numSamples { 0 };
+    uint32_t _position { 0 };
+};
+
+// Decodes an EncodedSound a chunk at a time: a block of PCM or an MP3 frame, resampled into a buffer that holds no
+// more than that chunk.
+class EncodedSoundStream : public SoundStream {
+public:
+    EncodedSoundStream(EncodedSoundPointer encodedSound);
+    ~EncodedSoundStream();
+
+    int read(AudioSample* samples, int numSamples) override;
+    void seek(uint32_t sample) override;
+
+private:
+    // starts decoding again at this frame of the file
+    void restart(uint32_t sourceFrame);
+
+    // decodes the next chunk of the file into _sourceSamples, false at its end
+    bool decodeSourceChunk();
+    // decodes, or only skips, the next MP3 frame, false at the end
+    bool nextMP3Frame(bool shouldDecode);
+    void freeMP3Decoder();
+
+    EncodedSoundPointer _sound;
+    std::unique_ptr<AudioSRC> _resampler;
+
+    std::vector<AudioSample> _sourceSamples;
+    std::vector<AudioSample> _buffer;
+    int _bufferOffset { 0 };
+
+    uint32_t _nextSourceFrame { 0 };
+    // decoded frames to drop to reach the position of the last seek
+    uint32_t _skipSourceFrames { 0 };
+
+    flump3dec::Bit_stream_struc* _bitstream { nullptr };
+    flump3dec::mp3tl* _decoder { nullptr };
+    int _mp3Result { 0 };
+    int _mp3FrameCount { 0 };
+};
+
+#endif // hifi_SoundStream_h
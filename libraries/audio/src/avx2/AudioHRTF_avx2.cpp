@@ -87,6 +87,56 @@ void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3
     _mm256_zeroupper();
 }
 
+// N lane input, 4 channel output per lane (lanes interleaved with stride HRTF_BATCH)
+void FIR_Nx4_AVX2(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames) {
+
+    static_assert(HRTF_BATCH == 16, "HRTF_BATCH must be 16");
+
+    for (int i = 0; i < numFrames; i++) {
+
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        __m256 acc4 = _mm256_setzero_ps();
+        __m256 acc5 = _mm256_setzero_ps();
+        __m256 acc6 = _mm256_setzero_ps();
+        __m256 acc7 = _mm256_setzero_ps();
+
+        float* ps = &src[(i - HRTF_TAPS + 1) * HRTF_BATCH];     // process forwards
+
+        for (int k = 0; k < HRTF_TAPS; k++) {
+
+            int c = HRTF_TAPS - 1 - k;                          // process backwards
+
+            __m256 x0 = _mm256_loadu_ps(&ps[k * HRTF_BATCH + 0]);
+            __m256 x1 = _mm256_loadu_ps(&ps[k * HRTF_BATCH + 8]);
+
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[0][c][0]), x0, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[0][c][8]), x1, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[1][c][0]), x0, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[1][c][8]), x1, acc3);
+            acc4 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[2][c][0]), x0, acc4);
+            acc5 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[2][c][8]), x1, acc5);
+            acc6 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[3][c][0]), x0, acc6);
+            acc7 = _mm256_fmadd_ps(_mm256_loadu_ps(&coef[3][c][8]), x1, acc7);
+        }
+
+        float* pd = &dst[4 * i * HRTF_BATCH];
+
+        _mm256_storeu_ps(&pd[0 * HRTF_BATCH + 0], acc0);
+        _mm256_storeu_ps(&pd[0 * HRTF_BATCH + 8], acc1);
+        _mm256_storeu_ps(&pd[1 * HRTF_BATCH + 0], acc2);
+        _mm256_storeu_ps(&pd[1 * HRTF_BATCH + 8], acc3);
+        _mm256_storeu_ps(&pd[2 * HRTF_BATCH + 0], acc4);
+        _mm256_storeu_ps(&pd[2 * HRTF_BATCH + 8], acc5);
+        _mm256_storeu_ps(&pd[3 * HRTF_BATCH + 0], acc6);
+        _mm256_storeu_ps(&pd[3 * HRTF_BATCH + 8], acc7);
+    }
+
+    _mm256_zeroupper();
+}
+
 // 4 channel planar to interleaved
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
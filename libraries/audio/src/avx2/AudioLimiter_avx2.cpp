@@ -0,0 +1,84 @@
+//
+//  AudioLimiter_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include "../AudioDynamics.h"
+
+// high part of the signed 32x32-bit products
+static inline __m256i mulhi_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+//
+// Peak detection and -log2(x) of interleaved stereo, 8 frames at a time
+// Matches peaklog2(input0, input1) exactly
+//
+void peaklog2_2x1_AVX2(float* input, int32_t* output, int numFrames) {
+
+    const __m256i fabsMask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+    const __m256i lowMask = _mm256_set1_epi32(0x7fffffff);
+    const __m256i expnBias = _mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM);
+    const __m256i maxExpn = _mm256_set1_epi32(31);
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+
+        // max absolute value of each pair
+        __m256i u0 = _mm256_and_si256(_mm256_loadu_si256((__m256i*)&input[2*n + 0]), fabsMask);
+        __m256i u1 = _mm256_and_si256(_mm256_loadu_si256((__m256i*)&input[2*n + 8]), fabsMask);
+        u0 = _mm256_max_epi32(u0, _mm256_shuffle_epi32(u0, _MM_SHUFFLE(2,3,0,1)));
+        u1 = _mm256_max_epi32(u1, _mm256_shuffle_epi32(u1, _MM_SHUFFLE(2,3,0,1)));
+
+        // gather the even lanes back into frame order
+        __m256i peak = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(u0), _mm256_castsi256_ps(u1),
+                                                             _MM_SHUFFLE(2,0,2,0)));
+        peak = _mm256_permute4x64_epi64(peak, _MM_SHUFFLE(3,1,2,0));
+
+        // split into e and x - 1.0
+        __m256i e = _mm256_sub_epi32(expnBias, _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+        __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, IEEE754_EXPN_BITS), lowMask);
+
+        __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+        k = _mm256_add_epi32(k, _mm256_add_epi32(k, k));   // k * 3
+
+        // polynomial for log2(1+x) over x=[0,1]
+        const int* table = &log2Table[0][0];
+        __m256i c0 = _mm256_i32gather_epi32(table + 0, k, 4);
+        __m256i c1 = _mm256_i32gather_epi32(table + 1, k, 4);
+        __m256i c2 = _mm256_i32gather_epi32(table + 2, k, 4);
+
+        c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+        c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+
+        // reconstruct result in Q26
+        __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+        // saturate when e > 31 or e < 0
+        __m256i isNegative = _mm256_srai_epi32(e, 31);
+        __m256i isOutOfRange = _mm256_or_si256(isNegative, _mm256_cmpgt_epi32(e, maxExpn));
+        __m256i saturated = _mm256_andnot_si256(isNegative, lowMask);
+        result = _mm256_blendv_epi8(result, saturated, isOutOfRange);
+
+        _mm256_storeu_si256((__m256i*)&output[n], result);
+    }
+    for (; n < numFrames; n++) {
+        output[n] = peaklog2(&input[2*n + 0], &input[2*n + 1]);
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
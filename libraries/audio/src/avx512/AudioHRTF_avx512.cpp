@@ -87,4 +87,57 @@ void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* ds
     _mm256_zeroupper();
 }
 
+
+// N lane input, 4 channel output per lane (lanes interleaved with stride HRTF_BATCH)
+void FIR_Nx4_AVX512(float* src, float* dst, float coef[4][HRTF_TAPS][HRTF_BATCH], int numFrames) {
+
+    static_assert(HRTF_BATCH == 16, "HRTF_BATCH must be 16");
+    static_assert(HRTF_TAPS % 2 == 0, "HRTF_TAPS must be a multiple of 2");
+
+    for (int i = 0; i < numFrames; i++) {
+
+        __m512 acc0 = _mm512_setzero_ps();
+        __m512 acc1 = _mm512_setzero_ps();
+        __m512 acc2 = _mm512_setzero_ps();
+        __m512 acc3 = _mm512_setzero_ps();
+        __m512 acc4 = _mm512_setzero_ps();
+        __m512 acc5 = _mm512_setzero_ps();
+        __m512 acc6 = _mm512_setzero_ps();
+        __m512 acc7 = _mm512_setzero_ps();
+
+        float* ps = &src[(i - HRTF_TAPS + 1) * HRTF_BATCH];     // process forwards
+
+        for (int k = 0; k < HRTF_TAPS; k += 2) {
+
+            int c = HRTF_TAPS - 1 - k;                          // process backwards
+
+            __m512 x0 = _mm512_loadu_ps(&ps[(k+0) * HRTF_BATCH]);
+            acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[0][c-0]), x0, acc0);
+            acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[1][c-0]), x0, acc1);
+            acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[2][c-0]), x0, acc2);
+            acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[3][c-0]), x0, acc3);
+
+            __m512 x1 = _mm512_loadu_ps(&ps[(k+1) * HRTF_BATCH]);
+            acc4 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[0][c-1]), x1, acc4);
+            acc5 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[1][c-1]), x1, acc5);
+            acc6 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[2][c-1]), x1, acc6);
+            acc7 = _mm512_fmadd_ps(_mm512_loadu_ps(coef[3][c-1]), x1, acc7);
+        }
+
+        acc0 = _mm512_add_ps(acc0, acc4);
+        acc1 = _mm512_add_ps(acc1, acc5);
+        acc2 = _mm512_add_ps(acc2, acc6);
+        acc3 = _mm512_add_ps(acc3, acc7);
+
+        float* pd = &dst[4 * i * HRTF_BATCH];
+
+        _mm512_storeu_ps(&pd[0 * HRTF_BATCH], acc0);
+        _mm512_storeu_ps(&pd[1 * HRTF_BATCH], acc1);
+        _mm512_storeu_ps(&pd[2 * HRTF_BATCH], acc2);
+        _mm512_storeu_ps(&pd[3 * HRTF_BATCH], acc3);
+    }
+
+    _mm256_zeroupper();
+}
+
 #endif
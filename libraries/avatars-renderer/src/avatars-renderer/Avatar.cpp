@@ -56,8 +56,9 @@ const float Avatar::ATTACHMENT_LOADING_PRIORITY = OTHERAVATAR_LOADING_PRIORITY -
 
 namespace render {
     template <> const ItemKey payloadGetKey(const AvatarSharedPointer& avatar) {
-        ItemKey::Builder keyBuilder = ItemKey::Builder::opaqueShape().withTypeMeta().withTagBits(render::hifi::TAG_ALL_VIEWS).withMetaCullGroup();
         auto avatarPtr = static_pointer_cast<Avatar>(avatar);
+        auto tagBits = avatarPtr->isImpostor() ? render::hifi::TAG_SECONDARY_VIEW : render::hifi::TAG_ALL_VIEWS;
+        ItemKey::Builder keyBuilder = ItemKey::Builder::opaqueShape().withTypeMeta().withTagBits(tagBits).withMetaCullGroup();
         if (!avatarPtr->getEnableMeshVisible()) {
             keyBuilder.withInvisible();
         }
@@ -621,14 +622,13 @@ void Avatar::measureMotionDerivatives(float deltaTime) {
     }
 }
 
-void Avatar::metaBlendshapeOperator(render::ItemID renderItemID, int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                    const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs) {
+void Avatar::metaBlendshapeOperator(render::ItemID renderItemID, const BlendedVerticesPointer& blendedVertices,
+                                    const render::ItemIDs& subItemIDs) {
     render::Transaction transaction;
-    transaction.updateItem<AvatarData>(renderItemID, [blendshapeNumber, blendshapeOffsets, blendedMeshSizes,
-                                                       subItemIDs](AvatarData& avatar) {
+    transaction.updateItem<AvatarData>(renderItemID, [blendedVertices, subItemIDs](AvatarData& avatar) {
         auto avatarPtr = dynamic_cast<Avatar*>(&avatar);
         if (avatarPtr) {
-            avatarPtr->setBlendedVertices(blendshapeNumber, blendshapeOffsets, blendedMeshSizes, subItemIDs);
+            avatarPtr->setBlendedVertices(blendedVertices, subItemIDs);
         }
     });
     AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
@@ -644,7 +644,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
     _renderBound = getBounds();
     transaction.resetItem(_renderItemID, avatarPayloadPointer);
     using namespace std::placeholders;
-    _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
+    _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2));
     _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
     _skeletonModel->setGroupCulled(true);
     _skeletonModel->setCanCastShadow(true);
@@ -872,9 +872,12 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
     // fix them up in the scene
     render::Transaction transaction;
     if (_skeletonModel->isRenderable() && _skeletonModel->needsFixupInScene()) {
-        _skeletonModel->removeFromScene(scene, transaction);
+        // a model out of the scene is either new or from the SkeletonModelPool, with render items to reuse
+        if (_skeletonModel->isAddedToScene()) {
+            _skeletonModel->removeFromScene(scene, transaction);
+        }
         using namespace std::placeholders;
-        _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
+        _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2));
 
         _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
         _skeletonModel->setGroupCulled(true);
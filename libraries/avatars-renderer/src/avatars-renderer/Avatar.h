@@ -518,6 +518,10 @@ public:
     render::ItemID getRenderItemID() { return _renderItemID; }
     bool isMoving() const { return _moving; }
 
+    // An impostor is drawn from a capture in the main view, its meshes are only in the secondary views
+    void setImpostor(bool isImpostor) { _isImpostor = isImpostor; }
+    bool isImpostor() const { return _isImpostor; }
+
     void fadeIn(render::ScenePointer scene);
     void fadeOut(render::Transaction& transaction, KillAvatarReason reason);
     render::Transition::Type getLastFadeRequested() const;
@@ -673,6 +677,7 @@ protected:
     glm::quat _lastOrientation;
     glm::vec3 _worldUpDirection { Vectors::UP };
     bool _moving { false }; ///< set when position is changing
+    bool _isImpostor { false };
 
     // protected methods...
     bool isLookingAtMe(AvatarSharedPointer avatar) const;
@@ -757,8 +762,8 @@ protected:
 
     LoadingStatus _loadingStatus { LoadingStatus::NoModel };
 
-    static void metaBlendshapeOperator(render::ItemID renderItemID, int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                       const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs);
+    static void metaBlendshapeOperator(render::ItemID renderItemID, const BlendedVerticesPointer& blendedVertices,
+                                       const render::ItemIDs& subItemIDs);
 
     std::vector<MultiSphereShape> _multiSphereShapes;
     AABox _fitBoundingBox;
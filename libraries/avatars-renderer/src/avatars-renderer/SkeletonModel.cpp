@@ -93,6 +93,16 @@ void SkeletonModel::initJointStates() {
     emit skeletonLoaded();
 }
 
+void SkeletonModel::setOwningAvatar(Avatar* owningAvatar) {
+    _owningAvatar = owningAvatar;
+    if (_owningAvatar && isLoaded()) {
+        QVector<JointData> defaultJointData;
+        _rig.copyJointsIntoJointData(defaultJointData);
+        _owningAvatar->setRawJointData(defaultJointData);
+        _owningAvatar->rebuildCollisionShape();
+    }
+}
+
 glm::vec3 SkeletonModel::avoidCrossedEyes(const glm::vec3& lookAt) {
     // make sure lookAt is not too close to face (avoid crosseyes)
     glm::vec3 focusOffset = lookAt - _owningAvatar->getHead()->getEyePosition();
@@ -36,6 +36,9 @@ public:
 
     void initJointStates() override;
 
+    // Hands the model over to another avatar. A loaded model gives the avatar its default joints and collision shape.
+    void setOwningAvatar(Avatar* owningAvatar);
+
     void simulate(float deltaTime, bool fullUpdate = true) override;
     glm::vec3 avoidCrossedEyes(const glm::vec3& lookAt);
     void updateRig(float deltaTime, glm::mat4 parentTransform) override;
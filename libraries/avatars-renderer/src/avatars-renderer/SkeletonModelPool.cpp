@@ -0,0 +1,62 @@
+//
+//  SkeletonModelPool.cpp
+//  libraries/avatars-renderer/src/avatars-renderer
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SkeletonModelPool.h"
+
+#include <algorithm>
+
+const size_t SkeletonModelPool::MAX_MODELS_PER_URL { 4 };
+const size_t SkeletonModelPool::MAX_MODELS { 32 };
+
+void SkeletonModelPool::release(const SkeletonModelPointer& model) {
+    if (!model || !model->isLoaded() || model->isAddedToScene()) {
+        return;
+    }
+    const QUrl& url = model->getURL();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t sameURLCount = std::count_if(_models.begin(), _models.end(), [&](const SkeletonModelPointer& pooledModel) {
+        return pooledModel->getURL() == url;
+    });
+    if (sameURLCount >= MAX_MODELS_PER_URL) {
+        _models.erase(std::find_if(_models.begin(), _models.end(), [&](const SkeletonModelPointer& pooledModel) {
+            return pooledModel->getURL() == url;
+        }));
+    }
+    _models.push_back(model);
+    if (_models.size() > MAX_MODELS) {
+        _models.pop_front();
+    }
+}
+
+SkeletonModelPointer SkeletonModelPool::acquire(const QUrl& url) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the newest model, the least likely to go
+    auto it = std::find_if(_models.rbegin(), _models.rend(), [&](const SkeletonModelPointer& pooledModel) {
+        return pooledModel->getURL() == url;
+    });
+    if (it == _models.rend()) {
+        return SkeletonModelPointer();
+    }
+    SkeletonModelPointer model = *it;
+    _models.erase(std::next(it).base());
+    return model;
+}
+
+void SkeletonModelPool::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _models.clear();
+}
+
+size_t SkeletonModelPool::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _models.size();
+}
@@ -0,0 +1,45 @@
+//
+//  SkeletonModelPool.h
+//  libraries/avatars-renderer/src/avatars-renderer
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SkeletonModelPool_h
+#define hifi_SkeletonModelPool_h
+
+#include <list>
+#include <mutex>
+
+#include <QUrl>
+
+#include "SkeletonModel.h"
+
+// The loaded skeleton models of the avatars that left, for the next avatars with the same model URL.
+// A pooled model keeps its geometry, rig and render item payloads: adding it back to the scene only allocates
+// its render item IDs.
+class SkeletonModelPool {
+public:
+    static const size_t MAX_MODELS_PER_URL;
+    static const size_t MAX_MODELS;
+
+    // The model must be loaded, out of the scene and have no owning avatar.
+    // The oldest models go past MAX_MODELS_PER_URL or MAX_MODELS.
+    void release(const SkeletonModelPointer& model);
+
+    // A pooled model loaded from url, or null
+    SkeletonModelPointer acquire(const QUrl& url);
+
+    void clear();
+    size_t size() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::list<SkeletonModelPointer> _models; // oldest first
+};
+
+#endif // hifi_SkeletonModelPool_h
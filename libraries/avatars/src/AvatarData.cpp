@@ -12,6 +12,7 @@
 
 #include "AvatarData.h"
 
+#include <array>
 #include <cstdio>
 #include <cstring>
 #include <stdint.h>
@@ -55,6 +56,8 @@ using namespace std;
 const QString AvatarData::FRAME_NAME = "com.highfidelity.recording.AvatarData";
 
 static const int TRANSLATION_COMPRESSION_RADIX = 14;
+static const int PACKED_JOINT_SIZE = 6; // a six byte quat, or a translation in three two byte fixed point values
+static const int MAX_JOINTS_PER_PACKET = 255; // the joint count is sent in a byte
 static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
@@ -76,9 +79,30 @@ size_t AvatarDataPacket::maxJointDataSize(size_t numJoints) {
     totalSize += validityBitsSize; // Translations mask
     totalSize += sizeof(float); // maxTranslationDimension
     totalSize += numJoints * sizeof(SixByteTrans); // Translations
+    totalSize += 2 * sizeof(uint8_t); // bits per component, in CompactJointData
     return totalSize;
 }
 
+int AvatarDataPacket::compactRotationBits(float minRotationDOT) {
+    // with b bits a component's error is at most 1 / (sqrt(2) * (2^b - 1)), which is an angle of under 3.5 / 2^b,
+    // so pick the fewest bits that keep it within half of the smallest change that would be sent
+    const int MIN_ROTATION_BITS = 8;
+    const int MAX_ROTATION_BITS = 15;
+    const float MAX_ERROR_SCALE = 7.0f;
+    float minAngle = 2.0f * acosf(glm::clamp(minRotationDOT, 0.0f, 1.0f));
+    if (minAngle <= 0.0f) {
+        return MAX_ROTATION_BITS;
+    }
+    int bits = (int)ceilf(log2f(MAX_ERROR_SCALE / minAngle));
+    return glm::clamp(bits, MIN_ROTATION_BITS, MAX_ROTATION_BITS);
+}
+
+int AvatarDataPacket::compactTranslationBits(int rotationBits) {
+    const int MIN_TRANSLATION_BITS = 10;
+    const int MAX_TRANSLATION_BITS = 15;
+    return glm::clamp(rotationBits + 2, MIN_TRANSLATION_BITS, MAX_TRANSLATION_BITS);
+}
+
 size_t AvatarDataPacket::minJointDataSize(size_t numJoints) {
     const size_t validityBitsSize = calcBitVectorSize((int)numJoints);
 
@@ -679,25 +703,48 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     }
 
     QVector<JointData> jointData;
+    std::shared_ptr<const PackedJointData> packedJointData;
     if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
         QReadLocker readLock(&_jointDataLock);
         jointData = _jointData;
+        packedJointData = _packedJointData;
+    }
+    if (packedJointData && packedJointData->sourceJointData.constData() != jointData.constData()) {
+        // the joints have changed since they were packed
+        packedJointData.reset();
     }
     const int numJoints = jointData.size();
-    assert(numJoints <= 255);
+    assert(numJoints <= MAX_JOINTS_PER_PACKET);
     const int jointBitVectorSize = calcBitVectorSize(numJoints);
 
+    // the compact format adds a bit width byte ahead of the rotations and another ahead of the translations
+    const bool compactJoints = sendStatus.compactJoints;
+    const size_t compactJointsExtraSize = compactJoints ? 2 * sizeof(uint8_t) : 0;
+
     // include jointData if there is room for the most minimal section. i.e. no translations or rotations.
-    IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints)) {
+    IF_AVATAR_SPACE(PACKET_HAS_JOINT_DATA, AvatarDataPacket::minJointDataSize(numJoints) + compactJointsExtraSize) {
         // Minimum space required for another rotation joint -
         // size of joint + following translation bit-vector + translation scale:
-        const ptrdiff_t minSizeForJoint = sizeof(AvatarDataPacket::SixByteQuat) + jointBitVectorSize + sizeof(float);
+        const ptrdiff_t minSizeForJoint = sizeof(AvatarDataPacket::SixByteQuat) + jointBitVectorSize + sizeof(float) +
+            compactJointsExtraSize;
 
         auto startSection = destinationBuffer;
 
+        int rotationBits = 0;
+        int translationBits = 0;
+        if (compactJoints) {
+            includedFlags |= AvatarDataPacket::PACKET_HAS_COMPACT_JOINT_DATA;
+            float precisionDOT = distanceAdjust ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
+            rotationBits = AvatarDataPacket::compactRotationBits(precisionDOT);
+            translationBits = AvatarDataPacket::compactTranslationBits(rotationBits);
+        }
+
+        // the packed translations are relative to the largest over all joints, so only fit a first pass
+        const bool usePackedTranslations = packedJointData && sendStatus.translationsSent == 0;
+
         // compute maxTranslationDimension before we send any joint data.
-        float maxTranslationDimension = 0.001f;
-        for (int i = sendStatus.translationsSent; i < numJoints; ++i) {
+        float maxTranslationDimension = usePackedTranslations ? packedJointData->maxTranslationDimension : 0.001f;
+        for (int i = usePackedTranslations ? numJoints : sendStatus.translationsSent; i < numJoints; ++i) {
             const JointData& data = jointData[i];
             if (!data.translationIsDefaultPose) {
                 maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
@@ -719,6 +766,13 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
 
+        if (compactJoints) {
+            *destinationBuffer++ = (uint8_t)rotationBits;
+        }
+        // compact joints are bit packed from here, destinationBuffer is moved past them once they're all written
+        unsigned char* const jointStream = destinationBuffer;
+        int jointStreamBits = 0;
+
         // sentJointDataOut and lastSentJointData might be the same vector
         if (sentJointDataOut) {
             sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
@@ -728,22 +782,48 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
+        // the change tests and the six byte packing are done for all the remaining joints in one batch,
+        // the loops below pick from them
+        const int firstRotation = sendStatus.rotationsSent;
+        const bool testChanges = cullSmallChanges && !sendAll;
+        const bool batchPackRotations = !compactJoints && !packedJointData;
+        std::array<uint8_t, MAX_JOINTS_PER_PACKET> rotationChanged;
+        std::array<uint8_t, MAX_JOINTS_PER_PACKET * PACKED_JOINT_SIZE> packedRotations;
+        if (testChanges) {
+            findQuatsDifferingByDot(&joints[firstRotation].rotation, &lastSentJointData.constData()[firstRotation].rotation,
+                                    sizeof(JointData), numJoints - firstRotation, minRotationDOT, rotationChanged.data() + firstRotation);
+        }
+        if (batchPackRotations) {
+            packOrientationQuatsToSixBytes(packedRotations.data() + firstRotation * PACKED_JOINT_SIZE, &joints[firstRotation].rotation,
+                                           sizeof(JointData), numJoints - firstRotation);
+        }
+
         int i = sendStatus.rotationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
+            if (compactJoints) {
+                destinationBuffer = jointStream + calcBitVectorSize(jointStreamBits);
+            }
             if (packetEnd - destinationBuffer >= minSizeForJoint) {
                 if (!data.rotationIsDefaultPose) {
                     // The dot product for larger rotations is a lower number,
                     // so if the dot() is less than the value, then the rotation is a larger angle of rotation
                     if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
-                        || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
+                        || (cullSmallChanges && rotationChanged[i])) {
                         validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        if (compactJoints) {
+                            jointStreamBits += packOrientationQuatToBits(jointStream, jointStreamBits, data.rotation, rotationBits);
+                        } else {
+                            const char* packedRotation = batchPackRotations ?
+                                reinterpret_cast<const char*>(packedRotations.data()) : packedJointData->rotations.constData();
+                            memcpy(destinationBuffer, packedRotation + i * PACKED_JOINT_SIZE, PACKED_JOINT_SIZE);
+                            destinationBuffer += PACKED_JOINT_SIZE;
+                        }
 
                         if (sentJoints) {
                             sentJoints[i].rotation = data.rotation;
@@ -760,6 +840,9 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.rotationsSent = i;
+        if (compactJoints) {
+            destinationBuffer = jointStream + calcBitVectorSize(jointStreamBits);
+        }
 
         // joint translation data
         validityPosition = destinationBuffer;
@@ -775,24 +858,55 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         // write maxTranslationDimension
         AVATAR_MEMCPY(maxTranslationDimension);
 
+        if (compactJoints) {
+            *destinationBuffer++ = (uint8_t)translationBits;
+        }
+        unsigned char* const translationStream = destinationBuffer;
+        int translationStreamBits = 0;
+
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
+        const int firstTranslation = sendStatus.translationsSent;
+        const bool batchPackTranslations = !compactJoints && !usePackedTranslations;
+        std::array<uint8_t, MAX_JOINTS_PER_PACKET> translationChanged;
+        std::array<uint8_t, MAX_JOINTS_PER_PACKET * PACKED_JOINT_SIZE> packedTranslations;
+        if (testChanges) {
+            findVec3sDifferingByDistance(&joints[firstTranslation].translation, &lastSentJointData.constData()[firstTranslation].translation,
+                                         sizeof(JointData), numJoints - firstTranslation, minTranslation,
+                                         translationChanged.data() + firstTranslation);
+        }
+        if (batchPackTranslations) {
+            packFloatVec3sToSignedTwoByteFixed(packedTranslations.data() + firstTranslation * PACKED_JOINT_SIZE,
+                                               &joints[firstTranslation].translation, sizeof(JointData), numJoints - firstTranslation,
+                                               maxTranslationDimension, TRANSLATION_COMPRESSION_RADIX);
+        }
+
         i = sendStatus.translationsSent;
         for (; i < numJoints; ++i) {
             const JointData& data = joints[i];
             const JointData& last = lastSentJointData[i];
 
+            if (compactJoints) {
+                destinationBuffer = translationStream + calcBitVectorSize(translationStreamBits);
+            }
             // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
             if (packetEnd - destinationBuffer >= minSizeForJoint) {
                 if (!data.translationIsDefaultPose) {
                     if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
-                        || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
+                        || (cullSmallChanges && translationChanged[i])) {
                         validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        if (compactJoints) {
+                            translationStreamBits += packUnitVec3ToBits(translationStream, translationStreamBits,
+                                                                        data.translation / maxTranslationDimension, translationBits);
+                        } else {
+                            const char* packedTranslation = batchPackTranslations ?
+                                reinterpret_cast<const char*>(packedTranslations.data()) : packedJointData->translations.constData();
+                            memcpy(destinationBuffer, packedTranslation + i * PACKED_JOINT_SIZE, PACKED_JOINT_SIZE);
+                            destinationBuffer += PACKED_JOINT_SIZE;
+                        }
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -809,6 +923,9 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         }
         sendStatus.translationsSent = i;
+        if (compactJoints) {
+            destinationBuffer = translationStream + calcBitVectorSize(translationStreamBits);
+        }
 
         IF_AVATAR_SPACE(PACKET_HAS_GRAB_JOINTS, sizeof (AvatarDataPacket::FarGrabJoints)) {
             // the far-grab joints may range further than 3 meters, so we can't use packFloatVec3ToSignedTwoByteFixed etc
@@ -902,6 +1019,41 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 }
 
 // NOTE: This is never used in a "distanceAdjust" mode, so it's ok that it doesn't use a variable minimum rotation/translation
+void AvatarData::packJointDataForBroadcast() {
+    auto packedJointData = std::make_shared<PackedJointData>();
+    {
+        QReadLocker readLock(&_jointDataLock);
+        packedJointData->sourceJointData = _jointData;
+    }
+
+    const auto& jointData = packedJointData->sourceJointData;
+    const int numJoints = jointData.size();
+
+    // the same maxTranslationDimension toByteArray computes for a first pass
+    float maxTranslationDimension = 0.001f;
+    for (const auto& data : jointData) {
+        if (!data.translationIsDefaultPose) {
+            maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+        }
+    }
+    packedJointData->maxTranslationDimension = maxTranslationDimension;
+
+    packedJointData->rotations.resize(numJoints * PACKED_JOINT_SIZE);
+    packedJointData->translations.resize(numJoints * PACKED_JOINT_SIZE);
+    auto rotations = reinterpret_cast<unsigned char*>(packedJointData->rotations.data());
+    auto translations = reinterpret_cast<unsigned char*>(packedJointData->translations.data());
+    if (numJoints > 0) {
+        packOrientationQuatsToSixBytes(rotations, &jointData[0].rotation, sizeof(JointData), numJoints);
+        packFloatVec3sToSignedTwoByteFixed(translations, &jointData[0].translation, sizeof(JointData), numJoints,
+                                           maxTranslationDimension, TRANSLATION_COMPRESSION_RADIX);
+    }
+
+    QWriteLocker writeLock(&_jointDataLock);
+    _packedJointData = packedJointData;
+}
+
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
     QReadLocker readLock(&_jointDataLock);
@@ -997,6 +1149,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasJointData             = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
     bool hasJointDefaultPoseFlags = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS);
     bool hasGrabJoints            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS);
+    bool hasCompactJointData      = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_COMPACT_JOINT_DATA);
 
     quint64 now = usecTimestampNow();
 
@@ -1347,18 +1500,43 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
             }
         }
 
-        // each joint rotation is stored in 6 bytes.
+        int rotationBits = 0;
+        if (hasCompactJointData) {
+            PACKET_READ_CHECK(JointRotationBits, sizeof(uint8_t));
+            rotationBits = *sourceBuffer++;
+            if (rotationBits < 2 || rotationBits > 15) {
+                qCWarning(avatars) << "Malformed AvatarData packet: invalid joint rotation bits" << rotationBits;
+                return buffer.size();
+            }
+        }
+
+        // each joint rotation is stored in 6 bytes, or in 2 + 3 * rotationBits bits when compact.
         QWriteLocker writeLock(&_jointDataLock);
         _jointData.resize(numJoints);
 
         const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
-                _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
+        if (hasCompactJointData) {
+            int rotationStreamBits = numValidJointRotations * (2 + 3 * rotationBits);
+            PACKET_READ_CHECK(JointRotations, calcBitVectorSize(rotationStreamBits));
+            int bitOffset = 0;
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validRotations[i]) {
+                    bitOffset += unpackOrientationQuatFromBits(sourceBuffer, bitOffset, data.rotation, rotationBits);
+                    _hasNewJointData = true;
+                    data.rotationIsDefaultPose = false;
+                }
+            }
+            sourceBuffer += calcBitVectorSize(rotationStreamBits);
+        } else {
+            PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validRotations[i]) {
+                    sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                    _hasNewJointData = true;
+                    data.rotationIsDefaultPose = false;
+                }
             }
         }
 
@@ -1390,17 +1568,40 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
         sourceBuffer += sizeof(float);
 
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
-
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
+        if (hasCompactJointData) {
+            PACKET_READ_CHECK(JointTranslationBits, sizeof(uint8_t));
+            int translationBits = *sourceBuffer++;
+            if (translationBits < 2 || translationBits > 15) {
+                qCWarning(avatars) << "Malformed AvatarData packet: invalid joint translation bits" << translationBits;
+                return buffer.size();
+            }
+
+            int translationStreamBits = numValidJointTranslations * 3 * translationBits;
+            PACKET_READ_CHECK(JointTranslation, calcBitVectorSize(translationStreamBits));
+            int bitOffset = 0;
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validTranslations[i]) {
+                    bitOffset += unpackUnitVec3FromBits(sourceBuffer, bitOffset, data.translation, translationBits);
+                    data.translation *= maxTranslationDimension;
+                    _hasNewJointData = true;
+                    data.translationIsDefaultPose = false;
+                }
+            }
+            sourceBuffer += calcBitVectorSize(translationStreamBits);
+        } else {
+            // each joint translation component is stored in 6 bytes.
+            const int COMPRESSED_TRANSLATION_SIZE = 6;
+            PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validTranslations[i]) {
+                    sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                    data.translation *= maxTranslationDimension;
+                    _hasNewJointData = true;
+                    data.translationIsDefaultPose = false;
+                }
             }
         }
 
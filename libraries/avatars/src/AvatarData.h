@@ -206,8 +206,14 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 12;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 13;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 14;
+    const HasFlags PACKET_HAS_COMPACT_JOINT_DATA       = 1U << 15; // the JointData is in the CompactJointData format
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
+    // optional capability byte a client appends to its AvatarQuery after the view frustums, mixers that predate it
+    // ignore the trailing byte and clients that don't send it are never given the opt-in formats
+    using QueryCapabilities = uint8_t;
+    const QueryCapabilities QUERY_WANTS_COMPACT_JOINT_DATA = 1U << 0;
+
     using SixByteQuat = uint8_t[6];
     using SixByteTrans = uint8_t[6];
 
@@ -354,6 +360,25 @@ namespace AvatarDataPacket {
     size_t maxJointDataSize(size_t numJoints);
     size_t minJointDataSize(size_t numJoints);
 
+    /*
+    struct CompactJointData {
+        uint8_t numJoints;
+        uint8_t rotationValidityBits[ceil(numJoints / 8)];
+        uint8_t rotationBits;                                  // bits per smallest-three component, 8 to 15
+        bits rotation[numValidRotations];                      // 2 + 3 * rotationBits each, by packOrientationQuatToBits()
+                                                               // padded to a whole byte
+        uint8_t translationValidityBits[ceil(numJoints / 8)];
+        float maxTranslationDimension;
+        uint8_t translationBits;                               // bits per component, 10 to 15
+        bits translation[numValidTranslations];                // 3 * translationBits each, by packUnitVec3ToBits()
+                                                               // padded to a whole byte
+    };
+    */
+    // Only sent by the mixer to clients that ask for it in their AvatarQuery. The precision follows the distance based
+    // culling of joint changes, so a distant avatar's joints are sent with no more precision than a change would need.
+    int compactRotationBits(float minRotationDOT);
+    int compactTranslationBits(int rotationBits);
+
     /*
     struct JointDefaultPoseFlags {
        uint8_t numJoints;
@@ -385,6 +410,7 @@ namespace AvatarDataPacket {
         bool sendUUID { false };
         int rotationsSent { 0 };  // ie: index of next unsent joint
         int translationsSent { 0 };
+        bool compactJoints { false }; // the receiver understands CompactJointData
         operator bool() { return itemFlags == 0; }
     };
 }
@@ -628,6 +654,10 @@ public:
         AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
         QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr) const;
 
+    // Quantizes the current joint rotations and translations once so toByteArray can copy them for every viewer
+    // instead of packing them again per viewer. Any later change to the joints leaves them unused until called again.
+    void packJointDataForBroadcast();
+
     virtual void doneEncoding(bool cullSmallChanges);
 
     /// \return true if an error should be logged
@@ -1725,6 +1755,14 @@ protected:
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    struct PackedJointData {
+        QVector<JointData> sourceJointData; // shares _jointData's storage for as long as the joints are unchanged
+        float maxTranslationDimension { 0.0f };
+        QByteArray rotations; // six bytes per joint
+        QByteArray translations; // six bytes per joint, relative to maxTranslationDimension
+    };
+    std::shared_ptr<const PackedJointData> _packedJointData; // guarded by _jointDataLock
+
     // key state
     KeyState _keyState;
 
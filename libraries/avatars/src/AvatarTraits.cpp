@@ -40,7 +40,11 @@ namespace AvatarTraits {
     qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
                               TraitVersion traitVersion, const AvatarData& avatar) {
         // Call packer function
-        auto traitBinaryData = avatar.packTrait(traitType);
+        return packVersionedTrait(traitType, destination, traitVersion, avatar.packTrait(traitType));
+    }
+
+    qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
+                              TraitVersion traitVersion, const QByteArray& traitBinaryData) {
         auto traitBinaryDataSize = traitBinaryData.size();
 
         // Verify packed data
@@ -64,6 +64,9 @@ namespace AvatarTraits {
     qint64 packTrait(TraitType traitType, ExtendedIODevice& destination, const AvatarData& avatar);
     qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
                               TraitVersion traitVersion, const AvatarData& avatar);
+    // for trait data already packed by AvatarData::packTrait, e.g. once for all the destinations it goes to
+    qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
+                              TraitVersion traitVersion, const QByteArray& traitBinaryData);
 
     qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                              ExtendedIODevice& destination, AvatarData& avatar);
@@ -21,9 +21,14 @@
 
 #include <model-baker/Baker.h>
 #include <model-baker/PrepareJointsTask.h>
+#include <model-baker/OptimizeMeshesTask.h>
+#include <model-baker/BuildMeshLODsTask.h>
+#include <model-baker/BuildDracoMeshTask.h>
+#include <model-baker/BuildCollisionShapesTask.h>
 
 #include <FBXWriter.h>
 #include <FSTReader.h>
+#include <HFAWriter.h>
 
 #ifdef _WIN32
 #pragma warning( push )
@@ -217,6 +222,7 @@ void ModelBaker::bakeSourceCopy() {
 
     std::vector<hifi::ByteArray> dracoMeshes;
     std::vector<std::vector<hifi::ByteArray>> dracoMaterialLists; // Material order for per-mesh material lookup used by dracoMeshes
+    hfm::CollisionShapes collisionShapes;
 
     {
         auto serializer = DependencyManager::get<ModelFormatRegistry>()->getSerializerForMediaType(modelData, _modelURL, "");
@@ -241,6 +247,13 @@ void ModelBaker::bakeSourceCopy() {
         auto config = baker.getConfiguration();
         // Enable compressed draco mesh generation
         config->getJobConfig("BuildDracoMesh")->setEnabled(true);
+        // Reorder the meshes for the GPU, and keep that order through the draco compression
+        ((OptimizeMeshesConfig*)config->getJobConfig("OptimizeMeshes"))->passthrough = false;
+        ((BuildDracoMeshConfig*)config->getJobConfig("BuildDracoMesh"))->preserveOrder = true;
+        // Simplify the meshes into levels of detail for the renderer to draw from far away
+        ((BuildMeshLODsConfig*)config->getJobConfig("BuildMeshLODs"))->passthrough = false;
+        // Build the collision shapes now so that clients don't have to when the model first collides
+        config->getJobConfig("BuildCollisionShapes")->setEnabled(true);
         // Do not permit potentially lossy modification of joint data meant for runtime
         ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
     
@@ -257,6 +270,7 @@ void ModelBaker::bakeSourceCopy() {
         _materialMapping = baker.getMaterialMapping();
         dracoMeshes = baker.getDracoMeshes();
         dracoMaterialLists = baker.getDracoMaterialLists();
+        collisionShapes = baker.getCollisionShapes();
     }
 
     // Do format-specific baking
@@ -266,6 +280,20 @@ void ModelBaker::bakeSourceCopy() {
         return;
     }
 
+    outputBakedAnimation();
+
+    // Replace the collision shapes of a model baked before
+    for (int i = _rootNode.children.size() - 1; i >= 0; --i) {
+        if (_rootNode.children[i].name == "CollisionShapes") {
+            _rootNode.children.removeAt(i);
+        }
+    }
+    if (!collisionShapes.isEmpty()) {
+        FBXNode collisionShapesNode;
+        buildCollisionShapesNode(collisionShapesNode, collisionShapes);
+        _rootNode.children.push_back(collisionShapesNode);
+    }
+
     if (!_hfmModel->materials.isEmpty()) {
         _materialBaker = QSharedPointer<MaterialBaker>(
             new MaterialBaker(_modelURL.fileName(), true, _bakedOutputDir),
@@ -397,6 +425,38 @@ void ModelBaker::outputUnbakedFST() {
     }
 }
 
+void ModelBaker::outputBakedAnimation() {
+    // Output the animation of the model compressed, for the AnimationCache to sample instead of the frames of the model
+    if (_hfmModel->animationFrames.isEmpty()) {
+        return;
+    }
+
+    QByteArray animationData = HFAWriter::encodeHFA(*_hfmModel);
+    if (animationData.isEmpty()) {
+        handleWarning("Could not compress the animation of model " + _modelURL.toString());
+        return;
+    }
+
+    QString outputAnimationFilename = _modelURL.fileName();
+    auto extensionStart = outputAnimationFilename.indexOf(".");
+    if (extensionStart != -1) {
+        outputAnimationFilename.resize(extensionStart);
+    }
+    outputAnimationFilename += BAKED_ANIMATION_EXTENSION;
+    QString outputAnimationURL = _bakedOutputDir + "/" + outputAnimationFilename;
+
+    QFile animationOutputFile { outputAnimationURL };
+    if (!animationOutputFile.open(QIODevice::WriteOnly)) {
+        handleWarning("Failed to open file '" + outputAnimationURL + "' for writing");
+        return;
+    }
+    if (animationOutputFile.write(animationData) == -1) {
+        handleWarning("Failed to write to file '" + outputAnimationURL + "'");
+        return;
+    }
+    _outputFiles.push_back(outputAnimationURL);
+}
+
 void ModelBaker::outputBakedFST() {
     // Output FST file, copying over input mappings if available
     QString outputFSTFilename = !_mappingURL.isEmpty() ? _mappingURL.fileName() : _modelURL.fileName();
@@ -474,6 +534,49 @@ bool ModelBaker::buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dr
     return true;
 }
 
+static QVector<float> pointsToFloats(const QVector<glm::vec3>& points) {
+    QVector<float> floats;
+    floats.reserve(3 * points.size());
+    for (const glm::vec3& point : points) {
+        floats << point.x << point.y << point.z;
+    }
+    return floats;
+}
+
+void ModelBaker::buildCollisionShapesNode(FBXNode& collisionShapesNode, const hfm::CollisionShapes& collisionShapes) {
+    collisionShapesNode.name = "CollisionShapes";
+
+    FBXNode versionNode;
+    versionNode.name = "CollisionShapesVersion";
+    versionNode.properties.append(FBX_COLLISION_SHAPES_VERSION);
+    collisionShapesNode.children.append(versionNode);
+
+    for (const auto& hull : collisionShapes.hulls) {
+        FBXNode hullNode;
+        hullNode.name = "Hull";
+        hullNode.properties.append(QVariant::fromValue(pointsToFloats(hull)));
+        collisionShapesNode.children.append(hullNode);
+    }
+
+    if (!collisionShapes.triangleIndices.isEmpty()) {
+        FBXNode verticesNode;
+        verticesNode.name = "Vertices";
+        verticesNode.properties.append(QVariant::fromValue(pointsToFloats(collisionShapes.vertices)));
+        collisionShapesNode.children.append(verticesNode);
+
+        FBXNode triangleIndicesNode;
+        triangleIndicesNode.name = "TriangleIndices";
+        triangleIndicesNode.properties.append(QVariant::fromValue(collisionShapes.triangleIndices));
+        collisionShapesNode.children.append(triangleIndicesNode);
+
+        // FBX only compresses arrays, so the hierarchy is compressed here
+        FBXNode bvhNode;
+        bvhNode.name = "BVH";
+        bvhNode.properties.append(QVariant::fromValue(qCompress(collisionShapes.bvh)));
+        collisionShapesNode.children.append(bvhNode);
+    }
+}
+
 void ModelBaker::setWasAborted(bool wasAborted) {
     if (wasAborted != _wasAborted.load()) {
         Baker::setWasAborted(wasAborted);
@@ -35,6 +35,7 @@ static const QString FBX_EXTENSION { ".fbx" };
 static const QString BAKED_FBX_EXTENSION { ".baked.fbx" };
 static const QString OBJ_EXTENSION { ".obj" };
 static const QString GLTF_EXTENSION { ".gltf" };
+static const QString BAKED_ANIMATION_EXTENSION { ".hfa" };
 
 class ModelBaker : public Baker {
     Q_OBJECT
@@ -49,6 +50,7 @@ public:
     void initializeOutputDirs();
 
     bool buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList);
+    void buildCollisionShapesNode(FBXNode& collisionShapesNode, const hfm::CollisionShapes& collisionShapes);
     virtual void setWasAborted(bool wasAborted) override;
 
     QUrl getModelURL() const { return _modelURL; }
@@ -89,6 +91,7 @@ protected slots:
 private:
     void outputUnbakedFST();
     void outputBakedFST();
+    void outputBakedAnimation();
     void bakeMaterialMap();
 
     bool _hasBeenBaked { false };
@@ -18,6 +18,7 @@
 
 #include <image/TextureProcessing.h>
 #include <ktx/KTX.h>
+#include <ktx/Supercompression.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
 #include <SharedUtil.h>
@@ -30,6 +31,7 @@
 const QString BAKED_TEXTURE_KTX_EXT = ".ktx";
 const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
+const QString SUPERCOMPRESSED_KTX_SUFFIX = "_supercompressed.ktx";
 
 bool TextureBaker::_compressionEnabled = true;
 
@@ -205,6 +207,12 @@ void TextureBaker::processTexture() {
             }
             _outputFiles.push_back(filePath);
             meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+
+            auto supercompressedFileName = _baseFilename + "_" + name + SUPERCOMPRESSED_KTX_SUFFIX;
+            if (!writeSupercompressedKTX(*memKTX, supercompressedFileName)) {
+                return;
+            }
+            meta.supercompressedTextureTypes[memKTX->_header.getGLInternaFormat()] = supercompressedFileName;
         }
     }
 
@@ -241,6 +249,12 @@ void TextureBaker::processTexture() {
         }
         _outputFiles.push_back(filePath);
         meta.uncompressed = fileName;
+
+        auto supercompressedFileName = _baseFilename + SUPERCOMPRESSED_KTX_SUFFIX;
+        if (!writeSupercompressedKTX(*memKTX, supercompressedFileName)) {
+            return;
+        }
+        meta.supercompressedUncompressed = supercompressedFileName;
     } else {
         buffer.reset();
     }
@@ -261,6 +275,23 @@ void TextureBaker::processTexture() {
     setIsFinished(true);
 }
 
+bool TextureBaker::writeSupercompressedKTX(const ktx::KTX& ktx, const QString& fileName) {
+    QByteArray data = ktx::supercompress(ktx);
+    if (data.isNull()) {
+        handleError("Could not supercompress baked texture for " + _textureURL.toString());
+        return false;
+    }
+
+    auto filePath = _outputDirectory.absoluteFilePath(fileName);
+    QFile file { filePath };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+        handleError("Could not write supercompressed baked texture for " + _textureURL.toString());
+        return false;
+    }
+    _outputFiles.push_back(filePath);
+    return true;
+}
+
 void TextureBaker::setWasAborted(bool wasAborted) {
     Baker::setWasAborted(wasAborted);
 
@@ -27,6 +27,10 @@
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
+namespace ktx {
+    class KTX;
+}
+
 class TextureBaker : public Baker {
     Q_OBJECT
 
@@ -64,6 +68,8 @@ private slots:
 private:
     void loadTexture();
     void handleTextureNetworkReply();
+    // writes the supercompressed version of a baked KTX, false and reports the error if it can't
+    bool writeSupercompressedKTX(const ktx::KTX& ktx, const QString& fileName);
 
     QUrl _textureURL;
     QByteArray _originalTexture;
@@ -0,0 +1,86 @@
+//
+//  PoseLatch.h
+//  libraries/controllers/src/controllers
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_controllers_PoseLatch_h
+#define hifi_controllers_PoseLatch_h
+
+#include <atomic>
+
+#include "Pose.h"
+
+namespace controller {
+
+    // The raw poses of the tracked devices, in sensor space, as an input plugin reads them from its device
+    struct LatchedPoses {
+        enum Channel {
+            HEAD = 0,
+            LEFT_HAND,
+            RIGHT_HAND,
+
+            NUM_CHANNELS,
+        };
+
+        Pose poses[NUM_CHANNELS];
+        uint64_t timestamp { 0 }; // usecs
+
+        // the transform taking a pose of the device in an earlier sample to where the device is in this one, false if
+        // either sample has no pose for it
+        bool getCorrectionSince(const LatchedPoses& earlier, Channel channel, glm::mat4& correction) const {
+            const auto& from = earlier.poses[channel];
+            const auto& to = poses[channel];
+            if (!from.isValid() || !to.isValid()) {
+                return false;
+            }
+            correction = to.getMatrix() * glm::inverse(from.getMatrix());
+            return true;
+        }
+    };
+
+    // Publishes the poses sampled by the input thread to the threads that late-latch them, with a sequence lock: the one
+    // writer never waits, and a reader only retries in the rare case that a sample was published while it copied.
+    class PoseLatch {
+    public:
+        // only from the input thread
+        void publish(const LatchedPoses& poses) {
+            auto sequence = _sequence.load(std::memory_order_relaxed);
+            _sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            _poses = poses;
+            _sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        // from any thread
+        LatchedPoses latest() const {
+            LatchedPoses poses;
+            while (true) {
+                auto sequence = _sequence.load(std::memory_order_acquire);
+                if (sequence & 1) {
+                    continue;
+                }
+                poses = _poses;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (_sequence.load(std::memory_order_relaxed) == sequence) {
+                    return poses;
+                }
+            }
+        }
+
+        bool hasPublished() const { return _sequence.load(std::memory_order_acquire) > 0; }
+
+    private:
+        std::atomic<uint32_t> _sequence { 0 };
+        LatchedPoses _poses;
+    };
+
+}
+
+#endif // hifi_controllers_PoseLatch_h
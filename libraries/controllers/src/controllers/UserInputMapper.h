@@ -25,6 +25,7 @@
 
 #include "Forward.h"
 #include "Pose.h"
+#include "PoseLatch.h"
 #include "Input.h"
 #include "InputDevice.h"
 #include "DeviceProxy.h"
@@ -125,6 +126,16 @@ namespace controller {
         AxisValue getValue(const Input& input) const;
         Pose getPose(const Input& input) const;
 
+        // The device poses the input thread samples between updates, for the poses of an update to be corrected by
+        // where the devices have moved since, just before they are used
+        PoseLatch& getPoseLatch() { return _poseLatch; }
+        // keeps the latest sample as the one the devices' update is read from, before the devices are updated
+        void latchFramePoses() { _framePoses = _poseLatch.latest(); }
+        // the transform taking a pose read by the devices' update to where the device is now, false if there is none
+        bool getLateLatchCorrection(LatchedPoses::Channel channel, glm::mat4& correction) const {
+            return _poseLatch.latest().getCorrectionSince(_framePoses, channel, correction);
+        }
+
         // perform an action when the UserInputMapper mutex is acquired.
         using Locker = std::unique_lock<std::recursive_mutex>;
         template <typename F>
@@ -196,6 +207,9 @@ namespace controller {
 
         InputCalibrationData inputCalibrationData;
 
+        PoseLatch _poseLatch;
+        LatchedPoses _framePoses;
+
         mutable std::recursive_mutex _lock;
     };
 
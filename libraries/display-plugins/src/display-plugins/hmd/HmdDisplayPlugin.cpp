@@ -354,7 +354,15 @@ void HmdDisplayPlugin::updateFrameData() {
 glm::mat4 HmdDisplayPlugin::getViewCorrection() {
     if (_currentFrame) {
         auto batchPose = _currentFrame->pose;
-        return glm::inverse(_currentPresentFrameInfo.presentPose) * batchPose;
+        auto correction = glm::inverse(_currentPresentFrameInfo.presentPose) * batchPose;
+
+        auto rotation = glm::quat_cast(correction);
+        _lateLatchRotation.addSample(glm::degrees(2.0f * acosf(std::min(fabsf(rotation.w), 1.0f))));
+        _lateLatchTranslation.addSample(glm::length(vec3(correction[3])));
+        if (_currentFrame->beginTime > 0) {
+            _lateLatchAge.addSample((float)(usecTimestampNow() - _currentFrame->beginTime) / (float)USECS_PER_MSEC);
+        }
+        return correction;
     } else {
         return glm::mat4();
     }
@@ -494,6 +502,14 @@ float HmdDisplayPlugin::stutterRate() const {
     return _stutterRate.rate();
 }
 
+QJsonObject HmdDisplayPlugin::getHardwareStats() const {
+    QJsonObject hardwareStats;
+    hardwareStats["late_latch_rotation_deg"] = _lateLatchRotation.getAverage();
+    hardwareStats["late_latch_translation_m"] = _lateLatchTranslation.getAverage();
+    hardwareStats["late_latch_age_ms"] = _lateLatchAge.getAverage();
+    return hardwareStats;
+}
+
 float adjustVisionSqueezeRatioForDevice(float visionSqueezeRatio, float visionSqueezeDeviceLow, float visionSqueezeDeviceHigh) {
     if (visionSqueezeRatio <= 0.0f) {
         return 0.0f;
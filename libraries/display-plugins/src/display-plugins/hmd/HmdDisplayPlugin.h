@@ -12,6 +12,7 @@
 #include <array>
 
 #include <QtGlobal>
+#include <SimpleMovingAverage.h>
 #include <Transform.h>
 
 #include <gpu/Format.h>
@@ -45,6 +46,7 @@ public:
     }
 
     float stutterRate() const override;
+    QJsonObject getHardwareStats() const override;
 
     virtual bool onDisplayTextureReset() override { _clearPreviewFlag = true; return true; };
 
@@ -97,6 +99,13 @@ protected:
     FrameInfo _currentRenderFrameInfo;
     RateCounter<> _stutterRate;
 
+    // How far the head pose latched on the present thread, just before the frame's batches execute, moved the view from
+    // the pose the frame was recorded with, and how long after the recording began that latch came
+    static const int LATE_LATCH_AVERAGE_SAMPLES { 90 };
+    ThreadSafeMovingAverage<float, LATE_LATCH_AVERAGE_SAMPLES> _lateLatchRotation; // degrees
+    ThreadSafeMovingAverage<float, LATE_LATCH_AVERAGE_SAMPLES> _lateLatchTranslation; // meters
+    ThreadSafeMovingAverage<float, LATE_LATCH_AVERAGE_SAMPLES> _lateLatchAge; // msecs
+
     bool _disablePreview { true };
 
     class VisionSqueezeParameters {
@@ -349,12 +349,13 @@ void EntityTreeRenderer::reloadEntityScripts() {
     _nonPersistentEntitiesScriptEngine->unloadAllEntityScripts();
     _nonPersistentEntitiesScriptEngine->resetModuleCache();
 
+    _scriptsPreloading.clear();
     for (const auto& entry : _entitiesInScene) {
         const auto& renderer = entry.second;
         const auto& entity = renderer->getEntity();
         if (entity && !entity->getScript().isEmpty()) {
-            auto& scriptEngine = (entity->isLocalEntity() || entity->isMyAvatarEntity()) ? _persistentEntitiesScriptEngine : _nonPersistentEntitiesScriptEngine;
-            scriptEngine->loadEntityScript(entity->getEntityItemID(), resolveScriptURL(entity->getScript()), true);
+            entity->setScriptHasFinishedPreload(false);
+            _scriptsToPreload[entity->getEntityItemID()] = true;
         }
     }
 }
@@ -463,44 +464,70 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         }
     }
 
-    float expectedUpdateCost = _avgRenderableUpdateCost * _renderablesToUpdate.size();
     _prevTotalNeededEntityUpdates = _renderablesToUpdate.size();
-    if (expectedUpdateCost < MAX_UPDATE_RENDERABLES_TIME_BUDGET) {
-        // we expect to update all renderables within available time budget
-        PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
-        uint64_t updateStart = usecTimestampNow();
-        for (const auto& renderable : _renderablesToUpdate) {
+    _prevNumEntityUpdates = 0;
+
+    // the budget is hard: whatever does not fit waits for the next frame
+    uint64_t updateStart = usecTimestampNow();
+    uint64_t expiry = updateStart + MAX_UPDATE_RENDERABLES_TIME_BUDGET;
+
+    // renderables that only moved are cheap and lag visibly when deferred, so they go first
+    {
+        PROFILE_RANGE_EX(simulation_physics, "UpdateTransforms", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
+        PerformanceTimer perfTimer("transforms");
+        for (auto itr = _renderablesToUpdate.begin(); itr != _renderablesToUpdate.end();) {
+            const auto& renderable = *itr;
             assert(renderable); // only valid renderables are added to _renderablesToUpdate
+            if (!renderable->needsOnlyTransformUpdate()) {
+                ++itr;
+                continue;
+            }
+            if (usecTimestampNow() > expiry) {
+                break;
+            }
             renderable->updateInScene(scene, transaction);
+            itr = _renderablesToUpdate.erase(itr);
+            ++_prevNumEntityUpdates;
+        }
+    }
+
+    // then the rebuilds with the budget that is left
+    uint64_t rebuildStart = usecTimestampNow();
+    if (_renderablesToUpdate.empty() || rebuildStart > expiry) {
+        _prevEntityUpdateTime = rebuildStart - updateStart;
+        return;
+    }
+    PerformanceTimer perfTimer("rebuilds");
+    size_t numRebuilt = 0;
+    float expectedUpdateCost = _avgRenderableUpdateCost * _renderablesToUpdate.size();
+    if (rebuildStart + expectedUpdateCost < expiry) {
+        // we expect to update all renderables within available time budget
+        PROFILE_RANGE_EX(simulation_physics, "UpdateRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
+        for (auto itr = _renderablesToUpdate.begin(); itr != _renderablesToUpdate.end() && usecTimestampNow() <= expiry;) {
+            (*itr)->updateInScene(scene, transaction);
+            itr = _renderablesToUpdate.erase(itr);
+            ++numRebuilt;
         }
-        _prevNumEntityUpdates = _renderablesToUpdate.size();
-        size_t numRenderables = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
-        _renderablesToUpdate.clear();
-
-        // compute average per-renderable update cost
-        float cost = (float)(usecTimestampNow() - updateStart) / (float)(numRenderables);
-        const float BLEND = 0.1f;
-        _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
     } else {
         // we expect the cost to updating all renderables to exceed available time budget
         // so we first sort by priority and update in order until out of time
 
         class SortableRenderer: public PrioritySortUtil::Sortable {
         public:
-            SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
+            SortableRenderer(const EntityRendererPointer& renderer, uint8_t region) : _renderer(renderer), _region(region) { }
 
             glm::vec3 getPosition() const override { return _renderer->getEntity()->getWorldPosition(); }
             float getRadius() const override { return 0.5f * _renderer->getEntity()->getQueryAACube().getScale(); }
             uint64_t getTimestamp() const override { return _renderer->getUpdateTime(); }
 
             EntityRendererPointer getRenderer() const { return _renderer; }
+            uint8_t getRegion() const { return _region; }
         private:
             EntityRendererPointer _renderer;
+            uint8_t _region;
         };
 
         // prioritize and sort the renderables
-        uint64_t sortStart = usecTimestampNow();
-
         const auto& views = _viewState->getConicalViews();
         PrioritySortUtil::PriorityQueue<SortableRenderer> sortedRenderables(views);
         sortedRenderables.reserve(_renderablesToUpdate.size());
@@ -508,21 +535,25 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
             PROFILE_RANGE_EX(simulation_physics, "BuildSortedRenderables", 0xffff00ff, (uint64_t)_renderablesToUpdate.size());
             for (const auto& renderable : _renderablesToUpdate) {
                 assert(renderable); // only valid renderables are added to _renderablesToUpdate
-                sortedRenderables.push(SortableRenderer(renderable));
+                // our own entities come first, and those the workload has yet to sort are taken as near
+                uint8_t region = workload::Region::R1;
+                const auto& entity = renderable->getEntity();
+                if (!entity->isLocalEntity() && !entity->isMyAvatarEntity()) {
+                    region = _space->getRegion(entity->getSpaceIndex());
+                    if (region == workload::Region::UNKNOWN || region == workload::Region::INVALID) {
+                        region = workload::Region::R2;
+                    }
+                }
+                sortedRenderables.push(SortableRenderer(renderable, region));
             }
         }
         {
             PROFILE_RANGE_EX(simulation_physics, "SortAndUpdateRenderables", 0xffff00ff, sortedRenderables.size());
 
-            // compute remaining time budget
-            const auto& sortedRenderablesVector = sortedRenderables.getSortedVector();
-            uint64_t updateStart = usecTimestampNow();
-            uint64_t sortCost = updateStart - sortStart;
-            uint64_t timeBudget = MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET;
-            if (sortCost < MAX_UPDATE_RENDERABLES_TIME_BUDGET - MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET) {
-                timeBudget = MAX_UPDATE_RENDERABLES_TIME_BUDGET - sortCost;
-            }
-            uint64_t expiry = updateStart + timeBudget;
+            // nearer workload regions first, then by priority in view within each region
+            std::vector<SortableRenderer> sortedRenderablesVector = sortedRenderables.getSortedVector();
+            std::stable_sort(sortedRenderablesVector.begin(), sortedRenderablesVector.end(),
+                [](const SortableRenderer& a, const SortableRenderer& b) { return a.getRegion() < b.getRegion(); });
 
             // process the sorted renderables
             for (const auto& sortedRenderable : sortedRenderablesVector) {
@@ -532,16 +563,18 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
                 const auto& renderable = sortedRenderable.getRenderer();
                 renderable->updateInScene(scene, transaction);
                 _renderablesToUpdate.erase(renderable);
+                ++numRebuilt;
             }
-
-            // compute average per-renderable update cost
-            _prevNumEntityUpdates = sortedRenderables.size() - _renderablesToUpdate.size();
-            size_t numUpdated = _prevNumEntityUpdates + 1; // add one to avoid divide by zero
-            float cost = (float)(usecTimestampNow() - updateStart) / (float)(numUpdated);
-            const float BLEND = 0.1f;
-            _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
         }
     }
+    _prevNumEntityUpdates += numRebuilt;
+
+    // compute average per-renderable rebuild cost
+    uint64_t now = usecTimestampNow();
+    float cost = (float)(now - rebuildStart) / (float)(numRebuilt + 1); // add one to avoid divide by zero
+    const float BLEND = 0.1f;
+    _avgRenderableUpdateCost = (1.0f - BLEND) * _avgRenderableUpdateCost + BLEND * cost;
+    _prevEntityUpdateTime = now - updateStart;
 }
 
 void EntityTreeRenderer::preUpdate() {
@@ -593,6 +626,8 @@ void EntityTreeRenderer::update(bool simulate) {
             }
         }
 
+        preloadEntityScripts();
+
         if (simulate) {
             // Handle enter/leave entity logic
             checkEnterLeaveEntities();
@@ -616,50 +651,50 @@ void EntityTreeRenderer::handleSpaceUpdate(std::pair<int32_t, glm::vec4> proxyUp
 void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemID>& entitiesContainingAvatar) {
     float radius = 0.01f; // for now, assume 0.01 meter radius, because we actually check the point inside later
     QVector<QUuid> entityIDs;
+    std::vector<ZoneEntityItemPointer> zones;
 
     // find the entities near us
     // don't let someone else change our tree while we search
     _tree->withReadLock([&] {
         auto entityTree = std::static_pointer_cast<EntityTree>(_tree);
 
-        // FIXME - if EntityTree had a findEntitiesContainingPoint() this could theoretically be a little faster
+        // the zones come from the tree's zone index, which already checks the point is inside them
+        entityTree->findZonesContaining(_avatarPosition, zones, &_zoneCache);
         entityTree->evalEntitiesInSphere(_avatarPosition, radius, PickFilter(), entityIDs);
 
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
-        // create a list of entities that actually contain the avatar's position
+        // don't flag a scripted zone as containing the avatar until the script is loaded,
+        // so that the script is awake in time to receive the "entityEntity" call.
+        for (const auto& zone : zones) {
+            auto hasScript = !zone->getScript().isEmpty();
+            bool scriptHasLoaded = hasScript && zone->isScriptPreloadFinished();
+
+            // if this zone is visible, add it to our layered zones
+            if (zone->getVisible() && renderableIdForEntity(zone) != render::Item::INVALID_ITEM_ID) {
+                _layeredZones.emplace_back(zone);
+            }
+
+            if (!hasScript || scriptHasLoaded) {
+                entitiesContainingAvatar << zone->getEntityItemID();
+            }
+        }
+
+        // then the other entities that actually contain the avatar's position
         for (auto& entityID : entityIDs) {
             auto entity = entityTree->findEntityByID(entityID);
-            if (!entity) {
+            if (!entity || entity->getType() == EntityTypes::Zone) {
                 continue;
             }
 
-            auto isZone = entity->getType() == EntityTypes::Zone;
-            auto hasScript = !entity->getScript().isEmpty();
-
-            // only consider entities that are zones or have scripts, all other entities can
+            // only consider entities that have scripts, all other entities can
             // be ignored because they can't have events fired on them.
             // FIXME - this could be optimized further by determining if the script is loaded
             // and if it has either an enterEntity or leaveEntity method
-            //
-            // also, don't flag a scripted entity as containing the avatar until the script is loaded,
-            // so that the script is awake in time to receive the "entityEntity" call (even if the entity is a zone).
-            bool contains = false;
-            bool scriptHasLoaded = hasScript && entity->isScriptPreloadFinished();
-            if (isZone || scriptHasLoaded) {
-                contains = entity->contains(_avatarPosition);
-            }
-
-            if (contains) {
-                // if this entity is a zone and visible, add it to our layered zones
-                if (isZone && entity->getVisible() && renderableIdForEntity(entity) != render::Item::INVALID_ITEM_ID) {
-                    _layeredZones.emplace_back(std::dynamic_pointer_cast<ZoneEntityItem>(entity));
-                }
-
-                if ((!hasScript && isZone) || scriptHasLoaded) {
-                    entitiesContainingAvatar << entity->getEntityItemID();
-                }
+            bool scriptHasLoaded = !entity->getScript().isEmpty() && entity->isScriptPreloadFinished();
+            if (scriptHasLoaded && entity->contains(_avatarPosition)) {
+                entitiesContainingAvatar << entity->getEntityItemID();
             }
         }
 
@@ -1048,6 +1083,8 @@ void EntityTreeRenderer::mouseMoveEvent(QMouseEvent* event) {
 void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
     // If it's in a pending queue, remove it
     _entitiesToAdd.erase(entityID);
+    _scriptsToPreload.erase(entityID);
+    _scriptsPreloading.erase(entityID);
 
     auto itr = _entitiesInScene.find(entityID);
     if (_entitiesInScene.end() == itr) {
@@ -1116,15 +1153,91 @@ void EntityTreeRenderer::checkAndCallPreload(const EntityItemID& entityID, bool
                 scriptEngine->unloadEntityScript(entityID);
             }
             entity->scriptHasUnloaded();
+            _scriptsToPreload.erase(entityID);
+            _scriptsPreloading.erase(entityID);
         }
         if (shouldLoad) {
+            // the script is loaded by preloadEntityScripts(), with the script of the entity as it is by then
             entity->setScriptHasFinishedPreload(false);
-            scriptEngine->loadEntityScript(entityID, resolveScriptURL(scriptUrl), reload);
+            _scriptsToPreload[entityID] |= reload;
             entity->scriptHasPreloaded();
         }
     }
 }
 
+void EntityTreeRenderer::preloadEntityScripts() {
+    PROFILE_RANGE_EX(simulation_physics, "PreloadScripts", 0xffff00ff, (uint64_t)_scriptsToPreload.size());
+    PerformanceTimer perfTimer("preloadScripts");
+
+    // a script that fails to load never reports that it finished, so it stops counting against the limit after a while
+    const uint64_t MAX_SCRIPT_PRELOAD_USECS = 5 * USECS_PER_SECOND;
+    uint64_t now = usecTimestampNow();
+    auto tree = getTree();
+    for (auto itr = _scriptsPreloading.begin(); itr != _scriptsPreloading.end();) {
+        auto entity = tree->findEntityByEntityItemID(itr->first);
+        if (!entity || entity->isScriptPreloadFinished() || now - itr->second > MAX_SCRIPT_PRELOAD_USECS) {
+            itr = _scriptsPreloading.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    const size_t MAX_SCRIPTS_PRELOADING = 8;
+    if (_scriptsToPreload.empty() || _scriptsPreloading.size() >= MAX_SCRIPTS_PRELOADING) {
+        return;
+    }
+
+    struct ScriptToPreload {
+        EntityItemPointer entity;
+        bool reload;
+        uint8_t region;
+        float distance;
+    };
+    std::vector<ScriptToPreload> scriptsToPreload;
+    scriptsToPreload.reserve(_scriptsToPreload.size());
+    glm::vec3 avatarPosition = _viewState->getAvatarPosition();
+    for (auto itr = _scriptsToPreload.begin(); itr != _scriptsToPreload.end();) {
+        auto entity = tree->findEntityByEntityItemID(itr->first);
+        if (!entity || entity->getScript().isEmpty()) {
+            itr = _scriptsToPreload.erase(itr);
+            continue;
+        }
+        // our own entities don't wait, and those the workload has yet to sort are taken as near
+        uint8_t region = workload::Region::R1;
+        if (!entity->isLocalEntity() && !entity->isMyAvatarEntity()) {
+            region = _space->getRegion(entity->getSpaceIndex());
+            if (region == workload::Region::UNKNOWN || region == workload::Region::INVALID) {
+                region = workload::Region::R2;
+            }
+        }
+        if (region <= workload::Region::R2) {
+            scriptsToPreload.push_back({ entity, itr->second, region,
+                                         glm::distance(avatarPosition, entity->getWorldPosition()) });
+        }
+        ++itr;
+    }
+    std::sort(scriptsToPreload.begin(), scriptsToPreload.end(), [](const ScriptToPreload& a, const ScriptToPreload& b) {
+        return a.region < b.region || (a.region == b.region && a.distance < b.distance);
+    });
+
+    const uint64_t MAX_SCRIPT_PRELOAD_TIME_BUDGET = 1000; // usec
+    uint64_t expiry = usecTimestampNow() + MAX_SCRIPT_PRELOAD_TIME_BUDGET;
+    for (const auto& scriptToPreload : scriptsToPreload) {
+        if (_scriptsPreloading.size() >= MAX_SCRIPTS_PRELOADING || usecTimestampNow() > expiry) {
+            break;
+        }
+        const auto& entity = scriptToPreload.entity;
+        auto& scriptEngine = (entity->isLocalEntity() || entity->isMyAvatarEntity()) ? _persistentEntitiesScriptEngine : _nonPersistentEntitiesScriptEngine;
+        if (!scriptEngine) {
+            break;
+        }
+        EntityItemID entityID = entity->getEntityItemID();
+        scriptEngine->loadEntityScript(entityID, resolveScriptURL(entity->getScript()), scriptToPreload.reload);
+        _scriptsToPreload.erase(entityID);
+        _scriptsPreloading[entityID] = usecTimestampNow();
+    }
+}
+
 void EntityTreeRenderer::fadeOutRenderable(const EntityRendererPointer& renderable) {
     render::Transaction transaction;
     auto scene = _viewState->getMain3DScene();
@@ -140,6 +140,8 @@ public:
 
     size_t getPrevNumEntityUpdates() const { return _prevNumEntityUpdates; }
     size_t getPrevTotalNeededEntityUpdates() const { return _prevTotalNeededEntityUpdates; }
+    // usecs spent updating renderables last frame, within MAX_UPDATE_RENDERABLES_TIME_BUDGET but for the last update
+    uint64_t getPrevEntityUpdateTime() const { return _prevEntityUpdateTime; }
 
     bool shouldRenderModelEntityPlaceholders() const { return _shouldRenderModelEntityPlaceholders; }
 
@@ -188,6 +190,7 @@ private:
     void stopDomainAndNonOwnedEntities();
 
     void checkAndCallPreload(const EntityItemID& entityID, bool reload = false, bool unloadFirst = false);
+    void preloadEntityScripts();
 
     EntityItemID _currentHoverOverEntityID;
     EntityItemID _currentClickingOnEntityID;
@@ -250,16 +253,24 @@ private:
     };
 
     LayeredZones _layeredZones;
+    EntityTreeZoneIndex::Cache _zoneCache;
     uint64_t _lastZoneCheck { 0 };
     const uint64_t ZONE_CHECK_INTERVAL = USECS_PER_MSEC * 100; // ~10hz
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
     float _avgRenderableUpdateCost { 0.0f };
 
+    // the entity scripts waiting to be loaded, with whether to reload them, and those loading, with when they started;
+    // they are loaded a few at a time, nearest first, so that entering a domain does not hand the script engines every
+    // script at once, and those outside R2 wait until their entity comes closer
+    std::unordered_map<EntityItemID, bool> _scriptsToPreload;
+    std::unordered_map<EntityItemID, uint64_t> _scriptsPreloading;
+
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
     size_t _prevNumEntityUpdates { 0 };
     size_t _prevTotalNeededEntityUpdates { 0 };
+    uint64_t _prevEntityUpdateTime { 0 };
 
     std::unordered_set<EntityRendererPointer> _renderablesToUpdate;
     std::unordered_map<EntityItemID, EntityRendererPointer> _entitiesInScene;
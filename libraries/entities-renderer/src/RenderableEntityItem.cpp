@@ -410,6 +410,14 @@ bool EntityRenderer::needsRenderUpdateFromEntity(const EntityItemPointer& entity
     return false;
 }
 
+bool EntityRenderer::needsOnlyTransformUpdate() const {
+    if (isFading() || _prevIsTransparent != isTransparent()) {
+        return false;
+    }
+
+    return !_entity->needsRenderUpdate() && _entity->isVisuallyReady() && !_entity->needsZoneOcclusionUpdate();
+}
+
 void EntityRenderer::updateModelTransformAndBound(const EntityItemPointer& entity) {
     bool success = false;
     auto newModelTransform = getTransformToCenterWithMaybeOnlyLocalRotation(entity, success);
@@ -55,6 +55,9 @@ public:
 
     const uint64_t& getUpdateTime() const { return _updateTime; }
 
+    // Returns true if the pending update of the item only moves or resizes it, which is cheap compared to a rebuild
+    bool needsOnlyTransformUpdate() const;
+
     enum class Pipeline {
         SIMPLE,
         MATERIAL,
@@ -345,6 +345,49 @@ bool RenderableModelEntityItem::isReadyToComputeShape() const {
     return true;
 }
 
+// The transform from the model frame, where the baked static mesh has the triangles, to where computeShapeInfo() puts
+// those of the meshes.  There is one only when it's the same for every mesh and made of a scale, a rotation and a
+// translation, as the baked mesh is moved as a whole and Bullet can only scale it along its axes.
+static bool getBakedMeshTransform(const HFMModel& hfmModel, const QVector<glm::mat4>& localTransforms,
+                                  glm::vec3& scale, glm::quat& rotation, glm::vec3& translation) {
+    if (hfmModel.meshes.isEmpty() || localTransforms.size() != hfmModel.meshes.size()) {
+        return false;
+    }
+
+    const float MAX_TRANSFORM_ERROR = 1.0e-4f;
+    glm::mat4 transform = localTransforms[0] * glm::inverse(hfmModel.meshes[0].modelTransform);
+    for (int i = 1; i < hfmModel.meshes.size(); ++i) {
+        glm::mat4 meshTransform = localTransforms[i] * glm::inverse(hfmModel.meshes[i].modelTransform);
+        for (int column = 0; column < 4; ++column) {
+            glm::vec4 error = glm::abs(meshTransform[column] - transform[column]);
+            glm::vec4 tolerance = MAX_TRANSFORM_ERROR * glm::max(glm::abs(transform[column]), glm::vec4(1.0f));
+            if (glm::any(glm::greaterThan(error, tolerance))) {
+                return false;
+            }
+        }
+    }
+
+    const float MIN_SCALE = 1.0e-6f;
+    glm::mat3 linear = glm::mat3(transform);
+    for (int axis = 0; axis < 3; ++axis) {
+        scale[axis] = glm::length(linear[axis]);
+        if (scale[axis] < MIN_SCALE) {
+            return false;
+        }
+        linear[axis] /= scale[axis];
+    }
+    // what is left must be a rotation
+    if (fabsf(glm::dot(linear[0], linear[1])) > MAX_TRANSFORM_ERROR ||
+            fabsf(glm::dot(linear[1], linear[2])) > MAX_TRANSFORM_ERROR ||
+            fabsf(glm::dot(linear[2], linear[0])) > MAX_TRANSFORM_ERROR ||
+            glm::determinant(linear) < 0.0f) {
+        return false;
+    }
+    rotation = glm::quat_cast(linear);
+    translation = glm::vec3(transform[3]);
+    return true;
+}
+
 void RenderableModelEntityItem::computeShapeInfo(ShapeInfo& shapeInfo) {
     const uint32_t TRIANGLE_STRIDE = 3;
     const uint32_t QUAD_STRIDE = 4;
@@ -381,68 +424,73 @@ void RenderableModelEntityItem::computeShapeInfo(ShapeInfo& shapeInfo) {
 
         ShapeInfo::PointCollection& pointCollection = shapeInfo.getPointCollection();
         pointCollection.clear();
-        uint32_t i = 0;
-
-        // the way OBJ files get read, each section under a "g" line is its own meshPart.  We only expect
-        // to find one actual "mesh" (with one or more meshParts in it), but we loop over the meshes, just in case.
-        foreach (const HFMMesh& mesh, collisionGeometry.meshes) {
-            // each meshPart is a convex hull
-            foreach (const HFMMeshPart &meshPart, mesh.parts) {
-                pointCollection.push_back(QVector<glm::vec3>());
-                ShapeInfo::PointList& pointsInPart = pointCollection[i];
-
-                // run through all the triangles and (uniquely) add each point to the hull
-                uint32_t numIndices = (uint32_t)meshPart.triangleIndices.size();
-                // TODO: assert rather than workaround after we start sanitizing HFMMesh higher up
-                //assert(numIndices % TRIANGLE_STRIDE == 0);
-                numIndices -= numIndices % TRIANGLE_STRIDE; // WORKAROUND lack of sanity checking in FBXSerializer
-
-                for (uint32_t j = 0; j < numIndices; j += TRIANGLE_STRIDE) {
-                    glm::vec3 p0 = mesh.vertices[meshPart.triangleIndices[j]];
-                    glm::vec3 p1 = mesh.vertices[meshPart.triangleIndices[j + 1]];
-                    glm::vec3 p2 = mesh.vertices[meshPart.triangleIndices[j + 2]];
-                    if (!pointsInPart.contains(p0)) {
-                        pointsInPart << p0;
-                    }
-                    if (!pointsInPart.contains(p1)) {
-                        pointsInPart << p1;
-                    }
-                    if (!pointsInPart.contains(p2)) {
-                        pointsInPart << p2;
+        if (!collisionGeometry.collisionShapes.hulls.isEmpty()) {
+            // the hulls were baked along with the collision model
+            pointCollection = collisionGeometry.collisionShapes.hulls;
+        } else {
+            uint32_t i = 0;
+
+            // the way OBJ files get read, each section under a "g" line is its own meshPart.  We only expect
+            // to find one actual "mesh" (with one or more meshParts in it), but we loop over the meshes, just in case.
+            foreach (const HFMMesh& mesh, collisionGeometry.meshes) {
+                // each meshPart is a convex hull
+                foreach (const HFMMeshPart &meshPart, mesh.parts) {
+                    pointCollection.push_back(QVector<glm::vec3>());
+                    ShapeInfo::PointList& pointsInPart = pointCollection[i];
+
+                    // run through all the triangles and (uniquely) add each point to the hull
+                    uint32_t numIndices = (uint32_t)meshPart.triangleIndices.size();
+                    // TODO: assert rather than workaround after we start sanitizing HFMMesh higher up
+                    //assert(numIndices % TRIANGLE_STRIDE == 0);
+                    numIndices -= numIndices % TRIANGLE_STRIDE; // WORKAROUND lack of sanity checking in FBXSerializer
+
+                    for (uint32_t j = 0; j < numIndices; j += TRIANGLE_STRIDE) {
+                        glm::vec3 p0 = mesh.vertices[meshPart.triangleIndices[j]];
+                        glm::vec3 p1 = mesh.vertices[meshPart.triangleIndices[j + 1]];
+                        glm::vec3 p2 = mesh.vertices[meshPart.triangleIndices[j + 2]];
+                        if (!pointsInPart.contains(p0)) {
+                            pointsInPart << p0;
+                        }
+                        if (!pointsInPart.contains(p1)) {
+                            pointsInPart << p1;
+                        }
+                        if (!pointsInPart.contains(p2)) {
+                            pointsInPart << p2;
+                        }
                     }
-                }
 
-                // run through all the quads and (uniquely) add each point to the hull
-                numIndices = (uint32_t)meshPart.quadIndices.size();
-                // TODO: assert rather than workaround after we start sanitizing HFMMesh higher up
-                //assert(numIndices % QUAD_STRIDE == 0);
-                numIndices -= numIndices % QUAD_STRIDE; // WORKAROUND lack of sanity checking in FBXSerializer
-
-                for (uint32_t j = 0; j < numIndices; j += QUAD_STRIDE) {
-                    glm::vec3 p0 = mesh.vertices[meshPart.quadIndices[j]];
-                    glm::vec3 p1 = mesh.vertices[meshPart.quadIndices[j + 1]];
-                    glm::vec3 p2 = mesh.vertices[meshPart.quadIndices[j + 2]];
-                    glm::vec3 p3 = mesh.vertices[meshPart.quadIndices[j + 3]];
-                    if (!pointsInPart.contains(p0)) {
-                        pointsInPart << p0;
-                    }
-                    if (!pointsInPart.contains(p1)) {
-                        pointsInPart << p1;
-                    }
-                    if (!pointsInPart.contains(p2)) {
-                        pointsInPart << p2;
-                    }
-                    if (!pointsInPart.contains(p3)) {
-                        pointsInPart << p3;
+                    // run through all the quads and (uniquely) add each point to the hull
+                    numIndices = (uint32_t)meshPart.quadIndices.size();
+                    // TODO: assert rather than workaround after we start sanitizing HFMMesh higher up
+                    //assert(numIndices % QUAD_STRIDE == 0);
+                    numIndices -= numIndices % QUAD_STRIDE; // WORKAROUND lack of sanity checking in FBXSerializer
+
+                    for (uint32_t j = 0; j < numIndices; j += QUAD_STRIDE) {
+                        glm::vec3 p0 = mesh.vertices[meshPart.quadIndices[j]];
+                        glm::vec3 p1 = mesh.vertices[meshPart.quadIndices[j + 1]];
+                        glm::vec3 p2 = mesh.vertices[meshPart.quadIndices[j + 2]];
+                        glm::vec3 p3 = mesh.vertices[meshPart.quadIndices[j + 3]];
+                        if (!pointsInPart.contains(p0)) {
+                            pointsInPart << p0;
+                        }
+                        if (!pointsInPart.contains(p1)) {
+                            pointsInPart << p1;
+                        }
+                        if (!pointsInPart.contains(p2)) {
+                            pointsInPart << p2;
+                        }
+                        if (!pointsInPart.contains(p3)) {
+                            pointsInPart << p3;
+                        }
                     }
-                }
 
-                if (pointsInPart.size() == 0) {
-                    qCDebug(entitiesrenderer) << "Warning -- meshPart has no faces";
-                    pointCollection.pop_back();
-                    continue;
+                    if (pointsInPart.size() == 0) {
+                        qCDebug(entitiesrenderer) << "Warning -- meshPart has no faces";
+                        pointCollection.pop_back();
+                        continue;
+                    }
+                    ++i;
                 }
-                ++i;
             }
         }
 
@@ -497,6 +545,28 @@ void RenderableModelEntityItem::computeShapeInfo(ShapeInfo& shapeInfo) {
             return;
         }
 
+        const hfm::CollisionShapes& bakedShapes = hfmModel.collisionShapes;
+        glm::vec3 bakedMeshScale;
+        glm::quat bakedMeshRotation;
+        glm::vec3 bakedMeshTranslation;
+        if (type == SHAPE_TYPE_STATIC_MESH && !bakedShapes.triangleIndices.isEmpty() &&
+                getBakedMeshTransform(hfmModel, localTransforms, bakedMeshScale, bakedMeshRotation, bakedMeshTranslation)) {
+            // the mesh and its bvh were baked along with the model, so the ShapeFactory needn't build them
+            ShapeInfo::PointCollection& pointCollection = shapeInfo.getPointCollection();
+            pointCollection.clear();
+            pointCollection.push_back(bakedShapes.vertices);
+            shapeInfo.getTriangleIndices() = bakedShapes.triangleIndices;
+
+            Extents extents;
+            for (const glm::vec3& vertex : bakedShapes.vertices) {
+                extents.addPoint(bakedMeshRotation * (bakedMeshScale * vertex) + bakedMeshTranslation);
+            }
+            shapeInfo.setParams(type, 0.5f * extents.size(), getModelURL() + model->getSnapModelToRegistrationPoint());
+            shapeInfo.setBakedMesh(bakedShapes.bvh, bakedMeshScale, bakedMeshRotation, bakedMeshTranslation);
+            adjustShapeInfoByRegistration(shapeInfo, model->getSnapModelToRegistrationPoint());
+            return;
+        }
+
         std::vector<std::shared_ptr<const graphics::Mesh>> meshes;
         if (type == SHAPE_TYPE_SIMPLE_COMPOUND) {
             auto& hfmMeshes = _collisionGeometryResource->getHFMModel().meshes;
@@ -1105,9 +1175,8 @@ uint32_t ModelEntityRenderer::metaFetchMetaSubItems(ItemIDs& subItems) const {
     return 0;
 }
 
-void ModelEntityRenderer::handleBlendedVertices(int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                                const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs) {
-    setBlendedVertices(blendshapeNumber, blendshapeOffsets, blendedMeshSizes, subItemIDs);
+void ModelEntityRenderer::handleBlendedVertices(const BlendedVerticesPointer& blendedVertices, const render::ItemIDs& subItemIDs) {
+    setBlendedVertices(blendedVertices, subItemIDs);
 }
 
 void ModelEntityRenderer::removeFromScene(const ScenePointer& scene, Transaction& transaction) {
@@ -1302,6 +1371,8 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
 
     // Nothing else to do unless the model is loaded
     if (!model->isLoaded()) {
+        // keep its priority up to date as the avatar moves, so the models nearest to it load first
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         return;
     }
 
@@ -1366,7 +1437,7 @@ void ModelEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoint
             render::Item::Status::Getters statusGetters;
             makeStatusGetters(entity, statusGetters);
             using namespace std::placeholders;
-            model->addToScene(scene, transaction, statusGetters, std::bind(&ModelEntityRenderer::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
+            model->addToScene(scene, transaction, statusGetters, std::bind(&ModelEntityRenderer::metaBlendshapeOperator, _renderItemID, _1, _2));
             entity->bumpAncestorChainRenderableVersion();
             processMaterials();
         }
@@ -1544,11 +1615,11 @@ void ModelEntityRenderer::processMaterials() {
     }
 }
 
-void ModelEntityRenderer::metaBlendshapeOperator(render::ItemID renderItemID, int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                                 const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs) {
+void ModelEntityRenderer::metaBlendshapeOperator(render::ItemID renderItemID, const BlendedVerticesPointer& blendedVertices,
+                                                 const render::ItemIDs& subItemIDs) {
     render::Transaction transaction;
-    transaction.updateItem<PayloadProxyInterface>(renderItemID, [blendshapeNumber, blendshapeOffsets, blendedMeshSizes, subItemIDs](PayloadProxyInterface& self) {
-        self.handleBlendedVertices(blendshapeNumber, blendshapeOffsets, blendedMeshSizes, subItemIDs);
+    transaction.updateItem<PayloadProxyInterface>(renderItemID, [blendedVertices, subItemIDs](PayloadProxyInterface& self) {
+        self.handleBlendedVertices(blendedVertices, subItemIDs);
     });
     AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
 }
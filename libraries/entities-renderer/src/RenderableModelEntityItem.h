@@ -159,8 +159,7 @@ protected:
     void setKey(bool didVisualGeometryRequestSucceed, const ModelPointer& model);
     virtual ItemKey getKey() override;
     virtual uint32_t metaFetchMetaSubItems(ItemIDs& subItems) const override;
-    virtual void handleBlendedVertices(int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                       const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs) override;
+    virtual void handleBlendedVertices(const BlendedVerticesPointer& blendedVertices, const render::ItemIDs& subItemIDs) override;
 
     virtual bool needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const override;
     virtual void doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) override;
@@ -201,8 +200,8 @@ private:
     void processMaterials();
     bool _allProceduralMaterialsLoaded { false };
 
-    static void metaBlendshapeOperator(render::ItemID renderItemID, int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                       const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs);
+    static void metaBlendshapeOperator(render::ItemID renderItemID, const BlendedVerticesPointer& blendedVertices,
+                                       const render::ItemIDs& subItemIDs);
 };
 
 } } // namespace 
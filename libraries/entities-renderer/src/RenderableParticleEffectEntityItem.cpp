@@ -41,13 +41,23 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
 }
 
 struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
+    GpuParticle(const glm::vec3& basePositionIn, float spawnTimeIn, const glm::vec3& relativePositionIn, float seedIn,
+                const glm::vec3& velocityIn, const glm::vec3& accelerationIn) :
+        basePosition(basePositionIn), spawnTime(spawnTimeIn), relativePosition(relativePositionIn), seed(seedIn),
+        velocity(velocityIn), acceleration(accelerationIn) {}
+    glm::vec3 basePosition;
+    float spawnTime;
+    glm::vec3 relativePosition;
+    float seed;
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
 };
 
 using GpuParticles = std::vector<GpuParticle>;
 
+// Keeps the times of the simulation small enough for the float precision of the shader
+static const quint64 MAX_SIMULATION_TIME = 1000 * USECS_PER_SECOND;
+
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
     _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
@@ -57,10 +67,14 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
         // As we create the first ParticuleSystem entity, let s register its special shapePIpeline factory:
         CUSTOM_PIPELINE_NUMBER = render::ShapePipeline::registerCustomShapePipelineFactory(shapePipelineFactory);
         _vertexFormat = std::make_shared<Format>();
-        _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-            offsetof(GpuParticle, xyz), gpu::Stream::PER_INSTANCE);
-        _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-            offsetof(GpuParticle, uv), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC4F_XYZW,
+            offsetof(GpuParticle, basePosition), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC4F_XYZW,
+            offsetof(GpuParticle, relativePosition), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(GpuParticle, velocity), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TEXCOORD0, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(GpuParticle, acceleration), gpu::Stream::PER_INSTANCE);
     });
 }
 
@@ -122,8 +136,8 @@ void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEn
         }
     }
 
-    // Fill in Uniforms structure
-    ParticleUniforms particleUniforms;
+    // Fill in Uniforms structure, the color, emitter and time are set when rendering
+    auto& particleUniforms = _uniformBuffer.edit<ParticleUniforms>();
     particleUniforms.radius.start = _particleProperties.radius.range.start;
     particleUniforms.radius.middle = _particleProperties.radius.gradient.target;
     particleUniforms.radius.finish = _particleProperties.radius.range.finish;
@@ -134,8 +148,6 @@ void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEn
     particleUniforms.spin.spread = _particleProperties.spin.gradient.spread;
     particleUniforms.lifespan = _particleProperties.lifespan;
     particleUniforms.rotateWithEntity = _particleProperties.rotateWithEntity ? 1 : 0;
-    // Update particle uniforms
-    _uniformBuffer.edit<ParticleUniforms>() = particleUniforms;
 }
 
 ItemKey ParticleEffectEntityRenderer::getKey() {
@@ -206,7 +218,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarFinish = particleProperties.polar.finish;
 
     particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
+    particle.lifespan = particleProperties.lifespan;
 
     particle.relativePosition = glm::vec3(0.0f);
     particle.basePosition = baseTransform.getTranslation();
@@ -363,16 +375,29 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
 }
 
 void ParticleEffectEntityRenderer::stepSimulation() {
+    const auto now = usecTimestampNow();
     if (_lastSimulated == 0) {
-        _lastSimulated = usecTimestampNow();
+        _lastSimulated = now;
+        _simulationEpoch = now;
         return;
     }
 
-    const auto now = usecTimestampNow();
+    // Particles are emitted for at most a frame at a time, so that there is no burst when the entity comes back into view
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
+    if (now - _simulationEpoch > MAX_SIMULATION_TIME) {
+        float shift = (float)(now - _simulationEpoch) / (float)USECS_PER_SECOND;
+        _simulationEpoch = now;
+        for (auto& particle : _cpuParticles) {
+            particle.spawnTime -= shift;
+        }
+        _needsFullUpload = true;
+    }
+    const float time = (float)(now - _simulationEpoch) / (float)USECS_PER_SECOND;
+
     const auto& modelTransform = getModelTransform();
+    size_t numSpawned = 0;
     if (_emitting && _particleProperties.emitting() &&
         (_shapeType != SHAPE_TYPE_COMPOUND || (_geometryResource && _geometryResource->isLoaded()))) {
         uint64_t emitInterval = _particleProperties.emitIntervalUsecs();
@@ -384,6 +409,8 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                 }
                 // emit particle
                 _cpuParticles.push_back(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo));
+                _cpuParticles.back().spawnTime = time;
+                ++numSpawned;
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -395,39 +422,61 @@ void ParticleEffectEntityRenderer::stepSimulation() {
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration == 0)) {
+    while (_cpuParticles.size() > _particleProperties.maxParticles ||
+           (!_cpuParticles.empty() && time - _cpuParticles.front().spawnTime >= _cpuParticles.front().lifespan)) {
         _cpuParticles.pop_front();
     }
 
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
-    // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+    if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+        for (auto& particle : _cpuParticles) {
             if (_prevEmitterShouldTrail) {
                 particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
             }
             particle.basePosition = modelTransform.getTranslation();
         }
-        particle.expiration = particle.expiration >= interval ? particle.expiration - interval : 0;
-        particle.integrate(deltaTime);
+        _needsFullUpload = true;
     }
     _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
 
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [this, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (_particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
+    uploadParticles(numSpawned);
+
+    auto& particleUniforms = _uniformBuffer.edit<ParticleUniforms>();
+    particleUniforms.time = time;
+    particleUniforms.emitterPosition = modelTransform.getTranslation();
+    particleUniforms.emitterShouldTrail = _particleProperties.emission.shouldTrail ? 1 : 0;
+}
 
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+void ParticleEffectEntityRenderer::uploadParticles(size_t numSpawned) {
+    auto toGpuParticle = [](const CpuParticle& particle) {
+        return GpuParticle(particle.basePosition, particle.spawnTime, particle.relativePosition, particle.seed,
+                           particle.velocity, particle.acceleration);
+    };
+
+    size_t capacity = std::max<size_t>(_particleProperties.maxParticles, 1);
+    if (capacity != _ringCapacity) {
+        _ringCapacity = capacity;
+        _particleBuffer->resize(sizeof(GpuParticle) * capacity);
+        _needsFullUpload = true;
+    }
+
+    if (_needsFullUpload) {
+        _needsFullUpload = false;
+        static GpuParticles gpuParticles;
+        gpuParticles.clear();
+        gpuParticles.reserve(_cpuParticles.size());
+        std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), toGpuParticle);
+        if (!gpuParticles.empty()) {
+            _particleBuffer->setSubData(0, sizeof(GpuParticle) * gpuParticles.size(), (const gpu::Byte*)gpuParticles.data());
+        }
+        _ringHead = gpuParticles.size() % _ringCapacity;
+        return;
+    }
+
+    // Only the particles spawned since the last upload are written, over the oldest ones
+    numSpawned = std::min(numSpawned, _cpuParticles.size());
+    for (auto particle = _cpuParticles.end() - numSpawned; particle != _cpuParticles.end(); ++particle) {
+        _particleBuffer->setSubData<GpuParticle>(_ringHead, toGpuParticle(*particle));
+        _ringHead = (_ringHead + 1) % _ringCapacity;
     }
 }
 
@@ -436,7 +485,6 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
     stepSimulation();
 
     gpu::Batch& batch = *args->_batch;
@@ -459,11 +507,21 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
 
     batch.setUniformBuffer(0, _uniformBuffer);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
 
-    auto numParticles = _particleBuffer->getSize() / sizeof(GpuParticle);
+    // The live particles are the last ones written to the ring, which may wrap around its end
     static const size_t VERTEX_PER_PARTICLE = 4;
-    batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    size_t numParticles = _cpuParticles.size();
+    if (numParticles == 0 || _ringCapacity == 0) {
+        return;
+    }
+    size_t first = (_ringHead + _ringCapacity - numParticles) % _ringCapacity;
+    size_t numFirst = std::min(numParticles, _ringCapacity - first);
+    batch.setInputBuffer(0, _particleBuffer, first * sizeof(GpuParticle), sizeof(GpuParticle));
+    batch.drawInstanced((gpu::uint32)numFirst, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    if (numParticles > numFirst) {
+        batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
+        batch.drawInstanced((gpu::uint32)(numParticles - numFirst), gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+    }
 }
 
 void ParticleEffectEntityRenderer::fetchGeometryResource() {
@@ -42,22 +42,16 @@ private:
     using BufferView = gpu::BufferView;
 
     // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
+    // The state of a particle when it was spawned.  The vertex shader integrates its position from it, so the CPU only
+    // spawns and expires particles, and uploads the new ones to the ring of particles on the GPU.
     struct CpuParticle {
         float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
+        float spawnTime { 0.0f }; // seconds since _simulationEpoch
+        float lifespan { 0.0f };
         glm::vec3 basePosition;
         glm::vec3 relativePosition;
         glm::vec3 velocity;
         glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
     };
     using CpuParticles = std::deque<CpuParticle>;
 
@@ -76,7 +70,10 @@ private:
         InterpolationData<float> spin;
         float lifespan;
         int rotateWithEntity;
-        glm::vec2 spare;
+        int emitterShouldTrail;
+        float spare;
+        glm::vec3 emitterPosition;
+        float time; // seconds since _simulationEpoch
     };
 
     void computeTriangles(const hfm::Model& hfmModel);
@@ -92,6 +89,7 @@ private:
                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
                                       const TriangleInfo& triangleInfo);
     void stepSimulation();
+    void uploadParticles(size_t numSpawned);
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
@@ -100,8 +98,13 @@ private:
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
+    // the particles are written to the buffer as a ring of maxParticles, after the last one written
+    size_t _ringCapacity { 0 };
+    size_t _ringHead { 0 };
+    bool _needsFullUpload { true };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
+    quint64 _simulationEpoch { 0 };
 
     PulsePropertyGroup _pulseProperties;
     ShapeType _shapeType;
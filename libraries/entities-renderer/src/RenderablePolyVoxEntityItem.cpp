@@ -75,6 +75,7 @@
 #include "PhysicalEntitySimulation.h"
 
 const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
+const int MESH_CHUNK_SIZE = 16; // voxels along each side of a chunk of the mesh
 
 /*
   A PolyVoxEntity has several interdependent parts:
@@ -92,6 +93,10 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   _volDataDirty    -- does recomputeMesh need to be called?
   _shapeReady      -- are we ready to tell bullet our shape?
 
+  _volData is meshed in chunks of MESH_CHUNK_SIZE voxels and only the chunks whose voxels changed are re-extracted.  A
+  mesh or shape bake that sees _volDataDirty become true gives up early, and the state machine folds all the edits made
+  in the meantime into a single new bake.
+
 
   Here is a simplified diagram of the state machine implemented in RenderablePolyVoxEntityItem::update
 
@@ -896,6 +901,7 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        resetMeshChunks();
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -948,6 +954,7 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markMeshChunksDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -962,6 +969,36 @@ void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uin
     }
 }
 
+void RenderablePolyVoxEntityItem::resetMeshChunks() {
+    // called with the entity write-locked, after _volData is re-allocated.  The chunks share their boundary voxels, the
+    // same way the whole enclosing region of _volData would be extracted.
+    PolyVox::Vector3DInt32 upperCorner = _volData->getEnclosingRegion().getUpperCorner();
+    ivec3 upper(upperCorner.getX(), upperCorner.getY(), upperCorner.getZ());
+    _numMeshChunks = glm::max(ivec3(1), (upper + MESH_CHUNK_SIZE - 1) / MESH_CHUNK_SIZE);
+
+    // every chunk gets a version that no chunk mesh has been extracted from
+    _meshChunkVersions.assign(_numMeshChunks.x * _numMeshChunks.y * _numMeshChunks.z, _nextMeshChunkVersion++);
+}
+
+void RenderablePolyVoxEntityItem::markMeshChunksDirty(int x, int y, int z) {
+    // called with the entity write-locked.  x, y, z are in _volData coords.  A voxel changes the surface of every chunk
+    // within one voxel of it, because the extractors compute normals from the neighboring voxels.
+    if (_meshChunkVersions.empty()) {
+        return;
+    }
+    ivec3 v(x, y, z);
+    ivec3 low = glm::max(ivec3(0), (v - 2) / MESH_CHUNK_SIZE);
+    ivec3 high = glm::min(_numMeshChunks - 1, (v + 1) / MESH_CHUNK_SIZE);
+    uint64_t version = _nextMeshChunkVersion++;
+    for (int cz = low.z; cz <= high.z; cz++) {
+        for (int cy = low.y; cy <= high.y; cy++) {
+            for (int cx = low.x; cx <= high.x; cx++) {
+                _meshChunkVersions[(cz * _numMeshChunks.y + cy) * _numMeshChunks.x + cx] = version;
+            }
+        }
+    }
+}
+
 bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toValue) {
     // set a voxel without recompressing the voxel data.  This assumes that the caller has write-locked the entity.
     bool result = updateOnCount(v, toValue);
@@ -1200,6 +1237,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1220,6 +1258,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1240,6 +1279,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markMeshChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1289,40 +1329,107 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
     QtConcurrent::run([entity, voxelSurfaceStyle] {
-        graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
-
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        std::lock_guard<std::mutex> chunksLock(entity->_meshChunksMutex);
+        std::vector<MeshChunk>& chunks = entity->_meshChunks;
 
+        // re-extract the stale chunks, one at a time so that edits are not held off by a long read lock
+        bool superseded = false;
+        int numChunks = 0;
         entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+            numChunks = (int)entity->_meshChunkVersions.size();
+        });
+        if ((int)chunks.size() != numChunks) {
+            chunks.clear();
+            chunks.resize(numChunks);
+        }
+        for (int i = 0; i < numChunks && !superseded; i++) {
+            entity->withReadLock([&] {
+                if (entity->_volDataDirty) {
+                    // the voxels were edited since this bake started, another bake will follow
+                    superseded = true;
+                    return;
                 }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+                if ((int)entity->_meshChunkVersions.size() != numChunks) {
+                    // _volData was re-allocated, which marks it dirty
+                    superseded = true;
+                    return;
+                }
+                MeshChunk& chunk = chunks[i];
+                uint64_t version = entity->_meshChunkVersions[i];
+                if (chunk.version == version) {
+                    return;
                 }
+
+                PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
+                const ivec3& numMeshChunks = entity->_numMeshChunks;
+                PolyVox::Vector3DInt32 upperCorner = volData->getEnclosingRegion().getUpperCorner();
+                ivec3 chunkIndex(i % numMeshChunks.x, (i / numMeshChunks.x) % numMeshChunks.y,
+                                 i / (numMeshChunks.x * numMeshChunks.y));
+                ivec3 low = chunkIndex * MESH_CHUNK_SIZE;
+                ivec3 high = glm::min(low + MESH_CHUNK_SIZE,
+                                      ivec3(upperCorner.getX(), upperCorner.getY(), upperCorner.getZ()));
+                PolyVox::Region region(PolyVox::Vector3DInt32(low.x, low.y, low.z),
+                                       PolyVox::Vector3DInt32(high.x, high.y, high.z));
+
+                chunk.mesh.clear();
+                switch (voxelSurfaceStyle) {
+                    case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+                    case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                        PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &chunk.mesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                    case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+                    case PolyVoxEntityItem::SURFACE_CUBIC: {
+                        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                            (volData, region, &chunk.mesh);
+                        surfaceExtractor.execute();
+                        break;
+                    }
+                }
+                chunk.version = version;
+                chunk.lowCorner = low;
+            });
+        }
+
+        if (superseded) {
+            // the chunks extracted so far are kept, and the next bake only extracts the rest
+            entity->meshSuperseded();
+            return;
+        }
+
+        // stitch the chunks into one mesh.  The extractors make positions relative to the lower corner of their region.
+        size_t numIndices = 0;
+        size_t numVertices = 0;
+        for (const auto& chunk : chunks) {
+            numIndices += chunk.mesh.getIndices().size();
+            numVertices += chunk.mesh.getRawVertexData().size();
+        }
+        std::vector<uint32_t> vecIndices;
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        vecIndices.reserve(numIndices);
+        vecVertices.reserve(numVertices);
+        for (const auto& chunk : chunks) {
+            uint32_t baseVertex = (uint32_t)vecVertices.size();
+            for (uint32_t index : chunk.mesh.getIndices()) {
+                vecIndices.push_back(baseVertex + index);
             }
-        });
+            PolyVox::Vector3DFloat offset((float)chunk.lowCorner.x, (float)chunk.lowCorner.y, (float)chunk.lowCorner.z);
+            for (auto vertex : chunk.mesh.getRawVertexData()) {
+                vertex.setPosition(vertex.getPosition() + offset);
+                vecVertices.push_back(vertex);
+            }
+        }
 
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
+        graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
@@ -1367,6 +1474,15 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
     somethingChangedNotification();
 }
 
+void RenderablePolyVoxEntityItem::meshSuperseded() {
+    // this catches a recomputeMesh that gave up because of a newer edit.  The state machine sees _volDataDirty and
+    // starts another bake, which includes every edit made in the meantime.
+    withWriteLock([&] {
+        _state = PolyVoxState::BakingMeshFinished;
+        startUpdates();
+    });
+}
+
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
     // this creates a collision-shape for the physics engine.  The shape comes from
     // _volData for cubic extractors and from _mesh for marching-cube extractors
@@ -1385,6 +1501,20 @@ void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
 
     QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
+
+        bool superseded = false;
+        polyVoxEntity->withWriteLock([&] {
+            if (polyVoxEntity->_volDataDirty) {
+                // the mesh is already stale, skip this shape and keep the current one until the next bake
+                superseded = true;
+                polyVoxEntity->_state = PolyVoxState::BakingShapeFinished;
+                polyVoxEntity->startUpdates();
+            }
+        });
+        if (superseded) {
+            return;
+        }
+
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
         glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
@@ -13,10 +13,13 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/Raycast.h>
 
 #include <gpu/Forward.h>
@@ -120,12 +123,14 @@ public:
     QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
     void setMesh(graphics::MeshPointer mesh);
+    void meshSuperseded();
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData.get(); }
 
     uint8_t getVoxelInternal(const ivec3& v) const;
     bool setVoxelInternal(const ivec3& v, uint8_t toValue);
     void setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue);
+    void markMeshChunksDirty(int x, int y, int z);
 
     void compressVolumeDataFinished(const QByteArray& voxelData);
     void neighborXEdgeChanged() { withWriteLock([&] { _updateFromNeighborXEdge = true; }); startUpdates(); }
@@ -147,6 +152,7 @@ private:
     void stopUpdates();
 
     void recomputeMesh();
+    void resetMeshChunks();
     void cacheNeighbors();
     void copyUpperEdgesFromNeighbors();
     void tellNeighborsToRecopyEdges(bool force);
@@ -173,6 +179,20 @@ private:
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
     int _onCount; // how many non-zero voxels are in _volData
 
+    // The mesh is extracted in chunks of _volData so that an edit only re-extracts the chunks around the voxels it
+    // changed.  Each chunk has a version which changes with its voxels, and a chunk mesh is stale when it was
+    // extracted from another version.
+    struct MeshChunk {
+        uint64_t version { 0 };
+        ivec3 lowCorner { 0 }; // of the region the mesh was extracted from, in _volData coords
+        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> mesh;
+    };
+    ivec3 _numMeshChunks { 0 };
+    std::vector<uint64_t> _meshChunkVersions;
+    uint64_t _nextMeshChunkVersion { 1 };
+    std::mutex _meshChunksMutex;
+    std::vector<MeshChunk> _meshChunks; // guarded by _meshChunksMutex rather than the entity lock
+
     bool _neighborXNeedsUpdate { false };
     bool _neighborYNeedsUpdate { false };
     bool _neighborZNeedsUpdate { false };
@@ -8,7 +8,10 @@
 //
 
 #include "RenderableWebEntityItem.h"
+#include <algorithm>
 #include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 #include <QtCore/QTimer>
 #include <QtGui/QOpenGLContext>
@@ -48,8 +51,11 @@ static int MAX_WINDOW_SIZE = 4096;
 const float METERS_TO_INCHES = 39.3701f;
 static float OPAQUE_ALPHA_THRESHOLD = 0.99f;
 
-// If a web-view hasn't been rendered for 30 seconds, de-allocate the framebuffer
-static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
+// If a web-view hasn't been rendered for a second, it is out of view, so stop rendering its surface until it is seen again
+static uint64_t MAX_NO_RENDER_INTERVAL = USECS_PER_SECOND;
+
+// A web-view that spans this angle, in radians, or more renders at its full framerate, smaller or farther ones slower
+static const float FULL_RENDER_PRIORITY_ANGLE = 0.5f;
 
 static uint8_t YOUTUBE_MAX_FPS = 30;
 
@@ -57,6 +63,50 @@ static uint8_t YOUTUBE_MAX_FPS = 30;
 static std::atomic<uint32_t> _currentWebCount(0);
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
 
+// Of those, no more than 6 render at once.  When another one comes into view, the one rendered least recently is paused,
+// unless they were all rendered within the last frames, in which case the new one keeps showing its last frame.
+static const size_t MAX_LIVE_WEB_VIEWS = 6;
+static const uint64_t LIVE_WEB_VIEW_EVICTION_INTERVAL = USECS_PER_SECOND / 4;
+// How often a paused web-view in view tries to render again
+static const uint64_t RESUME_RETRY_INTERVAL = USECS_PER_SECOND;
+
+// The time each rendering HTML web-view was last rendered.  Renderers are only added and removed on the main thread,
+// where they are destroyed, and the times are updated from the render thread.
+static std::mutex _liveWebViewsMutex;
+static std::unordered_map<WebEntityRenderer*, uint64_t> _liveWebViews;
+
+// Returns false if there is no room for the renderer, else the renderer that must be paused to make room, if any
+static bool addLiveWebView(WebEntityRenderer* renderer, WebEntityRenderer*& rendererToPause) {
+    std::lock_guard<std::mutex> lock(_liveWebViewsMutex);
+    rendererToPause = nullptr;
+    uint64_t now = usecTimestampNow();
+    if (_liveWebViews.size() >= MAX_LIVE_WEB_VIEWS && _liveWebViews.count(renderer) == 0) {
+        auto leastRecent = std::min_element(_liveWebViews.begin(), _liveWebViews.end(), [](const auto& a, const auto& b) {
+            return a.second < b.second;
+        });
+        if (now - leastRecent->second < LIVE_WEB_VIEW_EVICTION_INTERVAL) {
+            return false;
+        }
+        rendererToPause = leastRecent->first;
+        _liveWebViews.erase(leastRecent);
+    }
+    _liveWebViews[renderer] = now;
+    return true;
+}
+
+static void touchLiveWebView(WebEntityRenderer* renderer, uint64_t now) {
+    std::lock_guard<std::mutex> lock(_liveWebViewsMutex);
+    auto found = _liveWebViews.find(renderer);
+    if (found != _liveWebViews.end()) {
+        found->second = now;
+    }
+}
+
+static void removeLiveWebView(WebEntityRenderer* renderer) {
+    std::lock_guard<std::mutex> lock(_liveWebViewsMutex);
+    _liveWebViews.erase(renderer);
+}
+
 static QTouchDevice _touchDevice;
 
 WebEntityRenderer::ContentType WebEntityRenderer::getContentType(const QString& urlString) {
@@ -92,6 +142,7 @@ WebEntityRenderer::WebEntityRenderer(const EntityItemPointer& entity) : Parent(e
 
     _timer.setInterval(MSECS_PER_SECOND);
     connect(&_timer, &QTimer::timeout, this, &WebEntityRenderer::onTimeout);
+    _timer.start();
 }
 
 WebEntityRenderer::~WebEntityRenderer() {
@@ -130,14 +181,58 @@ void WebEntityRenderer::onTimeout() {
     uint64_t lastRenderTime;
     if (!resultWithReadLock<bool>([&] {
         lastRenderTime = _lastRenderTime;
-        return (_lastRenderTime != 0 && (bool)_webSurface);
+        return (_lastRenderTime != 0 && (bool)_webSurface && !_isWebSurfacePaused);
     })) {
         return;
     }
 
     if (usecTimestampNow() - lastRenderTime > MAX_NO_RENDER_INTERVAL) {
-        destroyWebSurface();
+        pauseWebSurface();
+    }
+}
+
+void WebEntityRenderer::pauseWebSurface() {
+    withWriteLock([&] {
+        if (_webSurface && !_isWebSurfacePaused) {
+            _webSurface->pause();
+            _isWebSurfacePaused = true;
+        }
+    });
+    removeLiveWebView(this);
+}
+
+void WebEntityRenderer::resumeWebSurface() {
+    bool isHTML = false;
+    if (!resultWithReadLock<bool>([&] {
+        isHTML = _contentType == ContentType::HtmlContent;
+        return (bool)_webSurface && _isWebSurfacePaused;
+    })) {
+        return;
+    }
+
+    if (isHTML) {
+        WebEntityRenderer* rendererToPause = nullptr;
+        if (!addLiveWebView(this, rendererToPause)) {
+            return;
+        }
+        if (rendererToPause) {
+            rendererToPause->pauseWebSurface();
+        }
     }
+
+    withWriteLock([&] {
+        if (_webSurface) {
+            _webSurface->resume();
+            _isWebSurfacePaused = false;
+        }
+    });
+}
+
+float WebEntityRenderer::getRenderPriority(const glm::vec3& viewPosition) const {
+    glm::vec3 dimensions = _renderTransform.getScale();
+    float distance = glm::distance(viewPosition, _renderTransform.getTranslation());
+    float angle = std::max(dimensions.x, dimensions.y) / std::max(distance, EPSILON);
+    return std::min(angle / FULL_RENDER_PRIORITY_ANGLE, 1.0f);
 }
 
 void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
@@ -268,10 +363,22 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
 
 void WebEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("WebEntityRenderer::render");
+    uint64_t now = usecTimestampNow();
+    bool wantsResume = false;
     withWriteLock([&] {
-        _lastRenderTime = usecTimestampNow();
+        _lastRenderTime = now;
+        if (_isWebSurfacePaused && now - _lastResumeRequest > RESUME_RETRY_INTERVAL) {
+            _lastResumeRequest = now;
+            wantsResume = true;
+        }
     });
 
+    if (wantsResume) {
+        QMetaObject::invokeMethod(this, &WebEntityRenderer::resumeWebSurface);
+    } else {
+        touchLiveWebView(this, now);
+    }
+
     // Try to update the texture
     OffscreenQmlSurface::TextureAndFence newTextureAndFence;
     QSize windowSize;
@@ -283,6 +390,9 @@ void WebEntityRenderer::doRender(RenderArgs* args) {
 
         newTextureAvailable = _webSurface->fetchTexture(newTextureAndFence);
         windowSize = _webSurface->size();
+        if (args->_renderMode == RenderArgs::DEFAULT_RENDER_MODE) {
+            _webSurface->setRenderPriority(getRenderPriority(args->getViewFrustum().getPosition()));
+        }
         return true;
     })) {
         return;
@@ -340,7 +450,10 @@ void WebEntityRenderer::buildWebSurface(const EntityItemPointer& entity, const Q
     }
     WebEntityRenderer::acquireWebSurface(newSourceURL, isHTML, _webSurface, _cachedWebSurface);
     _fadeStartTime = usecTimestampNow();
-    _webSurface->resume();
+    // The surface starts rendering once the entity is in view, if there is room for it
+    _webSurface->pause();
+    _isWebSurfacePaused = true;
+    _lastResumeRequest = 0;
 
     _connections.push_back(QObject::connect(this, &WebEntityRenderer::scriptEventReceived, _webSurface.data(), &OffscreenQmlSurface::emitScriptEvent));
     _connections.push_back(QObject::connect(_webSurface.data(), &OffscreenQmlSurface::webEventReceived, this, &WebEntityRenderer::webEventReceived));
@@ -366,6 +479,7 @@ void WebEntityRenderer::destroyWebSurface() {
 
         _contentType = ContentType::NoContent;
     });
+    removeLiveWebView(this);
 }
 
 glm::vec2 WebEntityRenderer::getWindowSize(const TypedEntityPointer& entity) const {
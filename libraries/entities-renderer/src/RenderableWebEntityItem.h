@@ -72,6 +72,11 @@ protected:
 
 private:
     void onTimeout();
+    // called on the main thread
+    void pauseWebSurface();
+    void resumeWebSurface();
+    // how much the surface is worth rendering from a view, see OffscreenSurface::setRenderPriority
+    float getRenderPriority(const glm::vec3& viewPosition) const;
     void buildWebSurface(const EntityItemPointer& entity, const QString& newSourceURL);
     void destroyWebSurface();
     glm::vec2 getWindowSize(const TypedEntityPointer& entity) const;
@@ -106,6 +111,8 @@ private:
 
     QTimer _timer;
     uint64_t _lastRenderTime { 0 };
+    bool _isWebSurfacePaused { false };
+    uint64_t _lastResumeRequest { 0 };
 
     std::vector<QMetaObject::Connection> _connections;
 
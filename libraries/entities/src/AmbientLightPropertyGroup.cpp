@@ -124,6 +124,14 @@ EntityPropertyFlags AmbientLightPropertyGroup::getEntityProperties(EncodeBitstre
 
     return requestedProperties;
 }
+
+const EntityPropertyFlags& AmbientLightPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
     
 void AmbientLightPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params, 
     EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
@@ -340,6 +340,14 @@ EntityPropertyFlags AnimationPropertyGroup::getEntityProperties(EncodeBitstreamP
     return requestedProperties;
 }
 
+const EntityPropertyFlags& AnimationPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
+
 void AnimationPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                 EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                 EntityPropertyFlags& requestedProperties,
@@ -129,6 +129,14 @@ EntityPropertyFlags BloomPropertyGroup::getEntityProperties(EncodeBitstreamParam
 
     return requestedProperties;
 }
+
+const EntityPropertyFlags& BloomPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
     
 void BloomPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                             EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
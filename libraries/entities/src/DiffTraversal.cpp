@@ -15,9 +15,8 @@
 
 #include "EntityPriorityQueue.h"
 
-DiffTraversal::Waypoint::Waypoint(EntityTreeElementPointer& element) : _nextIndex(0) {
+DiffTraversal::Waypoint::Waypoint(const EntityTreeSnapshot::Element* element) : _element(element), _nextIndex(0) {
     assert(element);
-    _weakElement = element;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::VisibleElement& next,
@@ -29,22 +28,19 @@ void DiffTraversal::Waypoint::getNextVisibleElementFirstTime(DiffTraversal::Visi
         // we never bother checking for LOD culling, and
         // we can skip it if the content hasn't changed
         ++_nextIndex;
-        next.element = _weakElement.lock();
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
@@ -52,29 +48,25 @@ void DiffTraversal::Waypoint::getNextVisibleElementRepeat(
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element->getLastChangedContent() > lastTime) {
-            next.element = element;
+        if (_element->getLastChangedContent() > lastTime) {
+            next.element = _element;
             return;
         }
     }
     if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement &&
-                    nextElement->getLastChanged() > lastTime &&
-                    view.shouldTraverseElement(*nextElement)) {
-
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement &&
+                nextElement->getLastChanged() > lastTime &&
+                view.shouldTraverseElement(*nextElement)) {
+
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::VisibleElement& next,
@@ -82,23 +74,19 @@ void DiffTraversal::Waypoint::getNextVisibleElementDifferential(DiffTraversal::V
     if (_nextIndex == -1) {
         // root case is special
         ++_nextIndex;
-        EntityTreeElementPointer element = _weakElement.lock();
-        next.element = element;
+        next.element = _element;
         return;
     } else if (_nextIndex < NUMBER_OF_CHILDREN) {
-        EntityTreeElementPointer element = _weakElement.lock();
-        if (element) {
-            while (_nextIndex < NUMBER_OF_CHILDREN) {
-                EntityTreeElementPointer nextElement = element->getChildAtIndex(_nextIndex);
-                ++_nextIndex;
-                if (nextElement && view.shouldTraverseElement(*nextElement)) {
-                    next.element = nextElement;
-                    return;
-                }
+        while (_nextIndex < NUMBER_OF_CHILDREN) {
+            const EntityTreeSnapshot::Element* nextElement = _element->getChildAtIndex(_nextIndex);
+            ++_nextIndex;
+            if (nextElement && view.shouldTraverseElement(*nextElement)) {
+                next.element = nextElement;
+                return;
             }
         }
     }
-    next.element.reset();
+    next.element = nullptr;
 }
 
 bool DiffTraversal::View::usesViewFrustums() const {
@@ -109,7 +97,8 @@ bool DiffTraversal::View::isVerySimilar(const View& view) const {
     auto size = view.viewFrustums.size();
 
     if (view.lodScaleFactor != lodScaleFactor ||
-        viewFrustums.size() != size) {
+        viewFrustums.size() != size ||
+        view.viewWeights != viewWeights) {
         return false;
     }
 
@@ -121,7 +110,10 @@ bool DiffTraversal::View::isVerySimilar(const View& view) const {
     return true;
 }
 
-float DiffTraversal::View::computePriority(const EntityItemPointer& entity) const {
+float DiffTraversal::View::computePriority(const EntityItemPointer& entity, int* viewIndex) const {
+    if (viewIndex) {
+        *viewIndex = -1;
+    }
     if (!entity) {
         return PrioritizedEntity::DO_NOT_SEND;
     }
@@ -141,7 +133,8 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
 
     auto priority = PrioritizedEntity::DO_NOT_SEND;
 
-    for (const auto& frustum : viewFrustums) {
+    for (size_t i = 0; i < viewFrustums.size(); ++i) {
+        const auto& frustum = viewFrustums[i];
         auto position = center - frustum.getPosition(); // position of bounding sphere in view-frame
         float distance = glm::length(position); // distance to center of bounding sphere
 
@@ -153,16 +146,22 @@ float DiffTraversal::View::computePriority(const EntityItemPointer& entity) cons
         if (angularSize > lodScaleFactor * MIN_ENTITY_ANGULAR_DIAMETER &&
             frustum.intersects(position, distance, radius)) {
 
-            // use the angular size as priority
+            // use the angular size, weighted by the view, as priority
             // we compute the max priority for all frustums
-            priority = std::max(priority, angularSize);
+            float weightedSize = getViewWeight(i) * angularSize;
+            if (weightedSize > priority) {
+                priority = weightedSize;
+                if (viewIndex) {
+                    *viewIndex = (int)i;
+                }
+            }
         }
     }
 
     return priority;
 }
 
-bool DiffTraversal::View::shouldTraverseElement(const EntityTreeElement& element) const {
+bool DiffTraversal::View::shouldTraverseElement(const EntityTreeSnapshot::Element& element) const {
     if (!usesViewFrustums()) {
         return true;
     }
@@ -193,9 +192,9 @@ DiffTraversal::DiffTraversal() {
     _path.reserve(MIN_PATH_DEPTH);
 }
 
-DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root,
+DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot,
                                                        bool forceFirstPass) {
-    assert(root);
+    assert(snapshot && snapshot->getRoot());
     // there are three types of traversal:
     //
     //   (1) First = fresh view --> find all elements in view
@@ -216,6 +215,7 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     if (forceFirstPass || _completedView.startTime == 0 || _currentView.usesViewFrustums() != _completedView.usesViewFrustums()) {
         type = Type::First;
         _currentView.viewFrustums = view.viewFrustums;
+        _currentView.viewWeights = view.viewWeights;
         _currentView.lodScaleFactor = view.lodScaleFactor;
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementFirstTime(next, _currentView);
@@ -228,25 +228,29 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     } else {
         type = Type::Differential;
         _currentView.viewFrustums = view.viewFrustums;
+        _currentView.viewWeights = view.viewWeights;
         _currentView.lodScaleFactor = view.lodScaleFactor;
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementDifferential(next, _currentView, _completedView);
         };
     }
 
+    _snapshot = snapshot;
     _path.clear();
-    _path.push_back(DiffTraversal::Waypoint(root));
+    _path.push_back(DiffTraversal::Waypoint(_snapshot->getRoot()));
     // set root fork's index such that root element returned at getNextElement()
     _path.back().initRootNextIndex();
 
-    _currentView.startTime = usecTimestampNow();
+    // changes are compared against when the snapshot was taken rather than now,
+    // anything changed in between shows up in the next snapshot as newer than this
+    _currentView.startTime = _snapshot->getTimestamp();
 
     return type;
 }
 
 void DiffTraversal::getNextVisibleElement(DiffTraversal::VisibleElement& next) {
     if (_path.empty()) {
-        next.element.reset();
+        next.element = nullptr;
         return;
     }
     _getNextVisibleElementCallback(next);
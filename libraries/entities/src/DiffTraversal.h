@@ -14,16 +14,17 @@
 
 #include <shared/ConicalViewFrustum.h>
 
-#include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
 
-// DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
+// DiffTraversal traverses a snapshot of the tree and applies _scanElementCallback on elements it finds
+// the snapshot is held for the whole traversal, so it can be walked across several calls to traverse() with no lock
 class DiffTraversal {
 public:
     // VisibleElement is a struct identifying an element and how it intersected the view.
     // The intersection is used to optimize culling entities from the sendQueue.
     class VisibleElement {
     public:
-        EntityTreeElementPointer element;
+        const EntityTreeSnapshot::Element* element { nullptr };
     };
 
     // View is a struct with a ViewFrustum and LOD parameters
@@ -32,10 +33,13 @@ public:
         bool usesViewFrustums() const;
         bool isVerySimilar(const View& view) const;
 
-        bool shouldTraverseElement(const EntityTreeElement& element) const;
-        float computePriority(const EntityItemPointer& entity) const;
+        bool shouldTraverseElement(const EntityTreeSnapshot::Element& element) const;
+        // the highest of the entity's weighted priorities in the views, and the index of the view that gave it
+        float computePriority(const EntityItemPointer& entity, int* viewIndex = nullptr) const;
+        float getViewWeight(size_t index) const { return index < viewWeights.size() ? viewWeights[index] : 1.0f; }
 
         ConicalViewFrustums viewFrustums;
+        std::vector<float> viewWeights; // one for each frustum, which scales the priorities of its entities
         uint64_t startTime { 0 };
         float lodScaleFactor { 1.0f };
     };
@@ -43,7 +47,7 @@ public:
     // Waypoint is an bookmark in a "path" of waypoints during a traversal.
     class Waypoint {
     public:
-        Waypoint(EntityTreeElementPointer& element);
+        Waypoint(const EntityTreeSnapshot::Element* element);
 
         void getNextVisibleElementFirstTime(VisibleElement& next, const View& view);
         void getNextVisibleElementRepeat(VisibleElement& next, const View& view, uint64_t lastTime);
@@ -53,7 +57,7 @@ public:
         void initRootNextIndex() { _nextIndex = -1; }
 
     protected:
-        EntityTreeElementWeakPointer _weakElement;
+        const EntityTreeSnapshot::Element* _element;
         int8_t _nextIndex;
     };
 
@@ -61,9 +65,10 @@ public:
 
     DiffTraversal();
 
-    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
+    Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeSnapshotPointer snapshot, bool forceFirstPass = false);
 
     const View& getCurrentView() const { return _currentView; }
+    const EntityTreeSnapshotPointer& getSnapshot() const { return _snapshot; }
 
     uint64_t getStartOfCompletedTraversal() const { return _completedView.startTime; }
     bool finished() const { return _path.empty(); }
@@ -71,13 +76,15 @@ public:
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _snapshot.reset(); _completedView.startTime = 0; }
 
 private:
     void getNextVisibleElement(VisibleElement& next);
 
     View _currentView;
     View _completedView;
+    EntityTreeSnapshotPointer _snapshot;
     std::vector<Waypoint> _path;
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
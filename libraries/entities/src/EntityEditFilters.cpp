@@ -11,11 +11,86 @@
 
 #include "EntityEditFilters.h"
 
+#include <algorithm>
+
+#include <QThread>
 #include <QUrl>
 
 #include <ResourceManager.h>
 #include <shared/ScriptInitializerMixin.h>
 
+// the most engines a filter script is evaluated in, however many threads there are to filter with
+const int MAX_FILTER_ENGINES = 4;
+
+// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
+// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
+static bool hasCorrectSyntax(const QScriptProgram& program) {
+    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
+    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
+        const auto error = syntaxCheck.errorMessage();
+        const auto line = QString::number(syntaxCheck.errorLineNumber());
+        const auto column = QString::number(syntaxCheck.errorColumnNumber());
+        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
+        qCritical() << qPrintable(message);
+        return false;
+    }
+    return true;
+}
+static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
+    if (engine.hasUncaughtException()) {
+        const auto backtrace = engine.uncaughtExceptionBacktrace();
+        const auto exception = engine.uncaughtException().toString();
+        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
+        engine.clearExceptions();
+
+        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
+        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
+        if (!backtrace.empty()) {
+            static const auto lineSeparator = "\n    ";
+            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
+        }
+        qCritical() << qPrintable(message);
+        return true;
+    }
+    return false;
+}
+
+EntityEditFilters::FilterEngines::~FilterEngines() {
+    for (auto& engine : _engines) {
+        delete engine.engine;
+    }
+}
+
+void EntityEditFilters::FilterEngines::add(QScriptEngine* engine, QScriptValue filterFn) {
+    _engines.push_back({ engine, filterFn });
+    _idleEngines.clear();
+    for (auto& idleEngine : _engines) {
+        _idleEngines.push_back(&idleEngine);
+    }
+}
+
+EntityEditFilters::FilterEngines::Engine* EntityEditFilters::FilterEngines::acquire() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _engineReleased.wait(lock, [&] { return !_idleEngines.empty(); });
+    auto engine = _idleEngines.back();
+    _idleEngines.pop_back();
+    return engine;
+}
+
+void EntityEditFilters::FilterEngines::release(Engine* engine, quint64 filterTime) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _idleEngines.push_back(engine);
+    }
+    _engineReleased.notify_one();
+
+    _numCalls++;
+    _totalTime += filterTime;
+    quint64 maxTime = _maxTime;
+    while (filterTime > maxTime && !_maxTime.compare_exchange_weak(maxTime, filterTime)) {}
+}
+
+
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
     QList<EntityItemID> missingZones;
@@ -73,106 +148,140 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
-            auto specifiedProperties = propertiesIn.getChangedProperties();
-            propertiesIn.setDesiredProperties(specifiedProperties);
-            QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
-            propertiesIn.setDesiredProperties(oldProperties);
-
-            auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
-
-            QScriptValueList args;
-            args << inputValues;
-            args << filterType;
-
-            // get the current properties for then entity and include them for the filter call
-            if (existingEntity && filterData.wantsOriginalProperties) {
-                auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
-                QScriptValue currentValues = currentProperties.copyToScriptValue(filterData.engine, false, true, true);
-                args << currentValues;
+            auto filterEngine = filterData.engines->acquire();
+            quint64 startFilter = usecTimestampNow();
+            bool accepted = callFilter(filterData, *filterEngine, id, propertiesIn, propertiesOut, wasChanged, filterType,
+                existingEntity);
+            filterData.engines->release(filterEngine, usecTimestampNow() - startFilter);
+            if (!accepted) {
+                return false;
             }
+        }
+    }
+    // if we made it here, 
+    return true;
+}
 
+bool EntityEditFilters::callFilter(const FilterData& filterData, FilterEngines::Engine& filterEngine, const EntityItemID& zoneID,
+        EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged,
+        EntityTree::FilterType filterType, const EntityItemPointer& existingEntity) {
+    auto oldProperties = propertiesIn.getDesiredProperties();
+    auto specifiedProperties = propertiesIn.getChangedProperties();
+    propertiesIn.setDesiredProperties(specifiedProperties);
+    QScriptValue inputValues = propertiesIn.copyToScriptValue(filterEngine.engine, false, true, true);
+    propertiesIn.setDesiredProperties(oldProperties);
+
+    auto in = QJsonValue::fromVariant(inputValues.toVariant()); // grab json copy now, because the inputValues might be side effected by the filter.
+
+    QScriptValueList args;
+    args << inputValues;
+    args << filterType;
+
+    // get the current properties for then entity and include them for the filter call
+    if (existingEntity && filterData.wantsOriginalProperties) {
+        auto currentProperties = existingEntity->getProperties(filterData.includedOriginalProperties);
+        QScriptValue currentValues = currentProperties.copyToScriptValue(filterEngine.engine, false, true, true);
+        args << currentValues;
+    }
 
-            // get the zone properties
-            if (filterData.wantsZoneProperties) {
-                auto zoneEntity = _tree->findEntityByEntityItemID(id);
-                if (zoneEntity) {
-                    auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
-                    QScriptValue zoneValues = zoneProperties.copyToScriptValue(filterData.engine, false, true, true);
-
-                    if (filterData.wantsZoneBoundingBox) {
-                        bool success = true;
-                        AABox aaBox = zoneEntity->getAABox(success);
-                        if (success) {
-                            QScriptValue boundingBox = filterData.engine->newObject();
-                            QScriptValue bottomRightNear = vec3ToScriptValue(filterData.engine, aaBox.getCorner());
-                            QScriptValue topFarLeft = vec3ToScriptValue(filterData.engine, aaBox.calcTopFarLeft());
-                            QScriptValue center = vec3ToScriptValue(filterData.engine, aaBox.calcCenter());
-                            QScriptValue boundingBoxDimensions = vec3ToScriptValue(filterData.engine, aaBox.getDimensions());
-                            boundingBox.setProperty("brn", bottomRightNear);
-                            boundingBox.setProperty("tfl", topFarLeft);
-                            boundingBox.setProperty("center", center);
-                            boundingBox.setProperty("dimensions", boundingBoxDimensions);
-                            zoneValues.setProperty("boundingBox", boundingBox);
-                        }
-                    }
 
-                    // If this is an add or delete, or original properties weren't requested
-                    // there won't be original properties in the args, but zone properties need
-                    // to be the fourth parameter, so we need to pad the args accordingly
-                    int EXPECTED_ARGS = 3;
-                    if (args.length() < EXPECTED_ARGS) {
-                        args << QScriptValue();
-                    }
-                    assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
-                    args << zoneValues;
+    // get the zone properties
+    if (filterData.wantsZoneProperties) {
+        auto zoneEntity = _tree->findEntityByEntityItemID(zoneID);
+        if (zoneEntity) {
+            auto zoneProperties = zoneEntity->getProperties(filterData.includedZoneProperties);
+            QScriptValue zoneValues = zoneProperties.copyToScriptValue(filterEngine.engine, false, true, true);
+
+            if (filterData.wantsZoneBoundingBox) {
+                bool success = true;
+                AABox aaBox = zoneEntity->getAABox(success);
+                if (success) {
+                    QScriptValue boundingBox = filterEngine.engine->newObject();
+                    QScriptValue bottomRightNear = vec3ToScriptValue(filterEngine.engine, aaBox.getCorner());
+                    QScriptValue topFarLeft = vec3ToScriptValue(filterEngine.engine, aaBox.calcTopFarLeft());
+                    QScriptValue center = vec3ToScriptValue(filterEngine.engine, aaBox.calcCenter());
+                    QScriptValue boundingBoxDimensions = vec3ToScriptValue(filterEngine.engine, aaBox.getDimensions());
+                    boundingBox.setProperty("brn", bottomRightNear);
+                    boundingBox.setProperty("tfl", topFarLeft);
+                    boundingBox.setProperty("center", center);
+                    boundingBox.setProperty("dimensions", boundingBoxDimensions);
+                    zoneValues.setProperty("boundingBox", boundingBox);
                 }
             }
 
-            QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
-
-            if (filterData.uncaughtExceptions()) {
-                return false;
+            // If this is an add or delete, or original properties weren't requested
+            // there won't be original properties in the args, but zone properties need
+            // to be the fourth parameter, so we need to pad the args accordingly
+            int EXPECTED_ARGS = 3;
+            if (args.length() < EXPECTED_ARGS) {
+                args << QScriptValue();
             }
+            assert(args.length() == EXPECTED_ARGS); // we MUST have 3 args by now!
+            args << zoneValues;
+        }
+    }
 
-            if (result.isObject()) {
-                // make propertiesIn reflect the changes, for next filter...
-                propertiesIn.copyFromScriptValue(result, false);
+    QScriptValue result = filterEngine.filterFn.call(_nullObjectForFilter, args);
 
-                // and update propertiesOut too.  TODO: this could be more efficient...
-                propertiesOut.copyFromScriptValue(result, false);
-                // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
-                auto out = QJsonValue::fromVariant(result.toVariant());
-                wasChanged |= (in != out);
-            } else if (result.isBool()) {
+    if (hadUncaughtExceptions(*filterEngine.engine, filterData.engines->getFileName())) {
+        return false;
+    }
 
-                // if the filter returned false, then it's authoritative
-                if (!result.toBool()) {
-                    return false;
-                }
+    if (result.isObject()) {
+        // make propertiesIn reflect the changes, for next filter...
+        propertiesIn.copyFromScriptValue(result, false);
 
-                // otherwise, assume it wants to pass all properties
-                propertiesOut = propertiesIn;
-                wasChanged = false;
-                
-            } else {
-                return false;
-            }
+        // and update propertiesOut too.  TODO: this could be more efficient...
+        propertiesOut.copyFromScriptValue(result, false);
+        // Javascript objects are == only if they are the same object. To compare arbitrary values, we need to use JSON.
+        auto out = QJsonValue::fromVariant(result.toVariant());
+        wasChanged |= (in != out);
+    } else if (result.isBool()) {
+
+        // if the filter returned false, then it's authoritative
+        if (!result.toBool()) {
+            return false;
         }
+
+        // otherwise, assume it wants to pass all properties
+        propertiesOut = propertiesIn;
+        wasChanged = false;
+        
+    } else {
+        return false;
     }
-    // if we made it here, 
     return true;
 }
 
 void EntityEditFilters::removeFilter(EntityItemID entityID) {
+    // the engines go with the last edit still being filtered by them
     QWriteLocker writeLock(&_lock);
-    FilterData filterData = _filterDataMap.value(entityID);
-    if (filterData.valid()) {
-        delete filterData.engine;
-    }
     _filterDataMap.remove(entityID);
 }
 
+bool EntityEditFilters::hasFilters() {
+    QReadLocker readLock(&_lock);
+    return !_filterDataMap.isEmpty();
+}
+
+QVector<EntityEditFilters::FilterStats> EntityEditFilters::getFilterStats() {
+    QVector<FilterStats> result;
+    QReadLocker readLock(&_lock);
+    for (auto filterData = _filterDataMap.begin(); filterData != _filterDataMap.end(); ++filterData) {
+        FilterStats stats;
+        stats.entityID = filterData.key();
+        if (filterData.value().engines) {
+            const auto& engines = *filterData.value().engines;
+            stats.fileName = engines.getFileName();
+            stats.numCalls = engines.getNumCalls();
+            stats.averageTime = stats.numCalls == 0 ? 0 : engines.getTotalTime() / stats.numCalls;
+            stats.maxTime = engines.getMaxTime();
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
 void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
 
     QUrl scriptURL(filterURL);
@@ -215,37 +324,28 @@ void EntityEditFilters::addFilter(EntityItemID entityID, QString filterURL) {
     qDebug() << "script request sent for entity " << entityID;
 }
 
-// Copied from ScriptEngine.cpp. We should make this a class method for reuse.
-// Note: I've deliberately stopped short of using ScriptEngine instead of QScriptEngine, as that is out of project scope at this point.
-static bool hasCorrectSyntax(const QScriptProgram& program) {
-    const auto syntaxCheck = QScriptEngine::checkSyntax(program.sourceCode());
-    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
-        const auto error = syntaxCheck.errorMessage();
-        const auto line = QString::number(syntaxCheck.errorLineNumber());
-        const auto column = QString::number(syntaxCheck.errorColumnNumber());
-        const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, program.fileName(), line, column);
-        qCritical() << qPrintable(message);
-        return false;
+static QScriptEngine* createFilterEngine(const EntityItemID& entityID, const QString& urlString, const QString& scriptContents) {
+    QScriptEngine* engine = new QScriptEngine();
+    engine->setObjectName("filter:" + entityID.toString());
+    engine->setProperty("type", "edit_filter");
+    engine->setProperty("fileName", urlString);
+    engine->setProperty("entityID", entityID);
+    engine->globalObject().setProperty("Script", engine->newQObject(engine));
+    DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
+    engine->evaluate(scriptContents, urlString);
+    if (hadUncaughtExceptions(*engine, urlString)) {
+        delete engine;
+        return nullptr;
     }
-    return true;
-}
-static bool hadUncaughtExceptions(QScriptEngine& engine, const QString& fileName) {
-    if (engine.hasUncaughtException()) {
-        const auto backtrace = engine.uncaughtExceptionBacktrace();
-        const auto exception = engine.uncaughtException().toString();
-        const auto line = QString::number(engine.uncaughtExceptionLineNumber());
-        engine.clearExceptions();
 
-        static const QString SCRIPT_EXCEPTION_FORMAT = "[UncaughtException] %1 in %2:%3";
-        auto message = QString(SCRIPT_EXCEPTION_FORMAT).arg(exception, fileName, line);
-        if (!backtrace.empty()) {
-            static const auto lineSeparator = "\n    ";
-            message += QString("\n[Backtrace]%1%2").arg(lineSeparator, backtrace.join(lineSeparator));
-        }
-        qCritical() << qPrintable(message);
-        return true;
-    }
-    return false;
+    auto global = engine->globalObject();
+    auto entitiesObject = engine->newObject();
+    entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
+    entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
+    entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
+    entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
+    global.setProperty("Entities", entitiesObject);
+    return engine;
 }
 
 void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
@@ -257,58 +357,51 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
         qInfo() << "Downloaded script:" << scriptContents;
         QScriptProgram program(scriptContents, urlString);
         if (hasCorrectSyntax(program)) {
-            // create a QScriptEngine for this script
-            QScriptEngine* engine = new QScriptEngine();
-            engine->setObjectName("filter:" + entityID.toString());
-            engine->setProperty("type", "edit_filter");
-            engine->setProperty("fileName", urlString);
-            engine->setProperty("entityID", entityID);
-            engine->globalObject().setProperty("Script", engine->newQObject(engine));
-            DependencyManager::get<ScriptInitializers>()->runScriptInitializers(engine);
-            engine->evaluate(scriptContents, urlString);
-            if (!hadUncaughtExceptions(*engine, urlString)) {
-                // put the engine in the engine map (so we don't leak them, etc...)
+            // evaluate the script in as many engines as there may be threads filtering at once
+            int numEngines = std::max(1, std::min(QThread::idealThreadCount(), MAX_FILTER_ENGINES));
+            auto engines = std::make_shared<FilterEngines>(urlString);
+            for (int i = 0; i < numEngines; ++i) {
+                QScriptEngine* engine = createFilterEngine(entityID, urlString, scriptContents);
+                if (!engine) {
+                    break;
+                }
+                auto filterFn = engine->globalObject().property("filter");
+                engines->add(engine, filterFn);
+                if (!filterFn.isFunction()) {
+                    break;
+                }
+            }
+            if (!engines->isEmpty()) {
+                // put the engines in the engine map (so we don't leak them, etc...)
                 FilterData filterData;
-                filterData.engine = engine;
+                filterData.engines = engines;
                 filterData.rejectAll = false;
-                
-                // define the uncaughtException function
-                QScriptEngine& engineRef = *engine;
-                filterData.uncaughtExceptions = [&engineRef, urlString]() { return hadUncaughtExceptions(engineRef, urlString); };
-
-                // now get the filter function
-                auto global = engine->globalObject();
-                auto entitiesObject = engine->newObject();
-                entitiesObject.setProperty("ADD_FILTER_TYPE", EntityTree::FilterType::Add);
-                entitiesObject.setProperty("EDIT_FILTER_TYPE", EntityTree::FilterType::Edit);
-                entitiesObject.setProperty("PHYSICS_FILTER_TYPE", EntityTree::FilterType::Physics);
-                entitiesObject.setProperty("DELETE_FILTER_TYPE", EntityTree::FilterType::Delete);
-                global.setProperty("Entities", entitiesObject);
-                filterData.filterFn = global.property("filter");
-                if (!filterData.filterFn.isFunction()) {
+
+                auto filterFn = engines->getFilterFn();
+                if (!filterFn.isFunction()) {
                     qDebug() << "Filter function specified but not found. Will reject all edits for those without lock rights.";
-                    delete engine;
+                    filterData.engines.reset();
                     filterData.rejectAll=true;
                 }
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterAddValue = filterData.filterFn.property("wantsToFilterAdd");
+                QScriptValue wantsToFilterAddValue = filterFn.property("wantsToFilterAdd");
                 filterData.wantsToFilterAdd = wantsToFilterAddValue.isBool() ? wantsToFilterAddValue.toBool() : true;
 
                 // if the wantsToFilterEdit is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterEditValue = filterData.filterFn.property("wantsToFilterEdit");
+                QScriptValue wantsToFilterEditValue = filterFn.property("wantsToFilterEdit");
                 filterData.wantsToFilterEdit = wantsToFilterEditValue.isBool() ? wantsToFilterEditValue.toBool() : true;
 
                 // if the wantsToFilterPhysics is a boolean evaluate as a boolean, otherwise assume true
-                QScriptValue wantsToFilterPhysicsValue = filterData.filterFn.property("wantsToFilterPhysics");
+                QScriptValue wantsToFilterPhysicsValue = filterFn.property("wantsToFilterPhysics");
                 filterData.wantsToFilterPhysics = wantsToFilterPhysicsValue.isBool() ? wantsToFilterPhysicsValue.toBool() : true;
 
                 // if the wantsToFilterDelete is a boolean evaluate as a boolean, otherwise assume false
-                QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
+                QScriptValue wantsToFilterDeleteValue = filterFn.property("wantsToFilterDelete");
                 filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
 
                 // check to see if the filterFn has properties asking for Original props
-                QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
+                QScriptValue wantsOriginalPropertiesValue = filterFn.property("wantsOriginalProperties");
                 // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all original properties
                 //               false - no properties at all
@@ -329,7 +422,7 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 }
 
                 // check to see if the filterFn has properties asking for Zone props
-                QScriptValue wantsZonePropertiesValue = filterData.filterFn.property("wantsZoneProperties");
+                QScriptValue wantsZonePropertiesValue = filterFn.property("wantsZoneProperties");
                 // if the wantsZoneProperties is a boolean, or a string, or list of strings, then evaluate as follows:
                 //   - boolean - true  - include all Zone properties
                 //               false - no properties at all
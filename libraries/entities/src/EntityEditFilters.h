@@ -13,11 +13,16 @@
 
 #include <QObject>
 #include <QMap>
+#include <QVector>
 #include <QScriptValue>
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
-#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,8 +31,48 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    // A filter script evaluated in several engines, so that edits can be filtered on several threads at once; each engine
+    // is only ever used by one thread at a time.
+    class FilterEngines {
+    public:
+        struct Engine {
+            QScriptEngine* engine { nullptr };
+            QScriptValue filterFn;
+        };
+
+        FilterEngines(const QString& fileName) : _fileName(fileName) {}
+        ~FilterEngines();
+
+        void add(QScriptEngine* engine, QScriptValue filterFn);
+        bool isEmpty() const { return _engines.empty(); }
+        const QString& getFileName() const { return _fileName; }
+        QScriptValue getFilterFn() const { return _engines.empty() ? QScriptValue() : _engines[0].filterFn; }
+
+        // waits for an engine if all of them are in use
+        Engine* acquire();
+        void release(Engine* engine, quint64 filterTime);
+
+        quint64 getNumCalls() const { return _numCalls; }
+        quint64 getTotalTime() const { return _totalTime; }
+        quint64 getMaxTime() const { return _maxTime; }
+
+    private:
+        QString _fileName;
+        std::vector<Engine> _engines;
+
+        std::mutex _mutex;
+        std::condition_variable _engineReleased;
+        std::vector<Engine*> _idleEngines;
+
+        std::atomic<quint64> _numCalls { 0 };
+        std::atomic<quint64> _totalTime { 0 }; // usecs
+        std::atomic<quint64> _maxTime { 0 };
+    };
+    using FilterEnginesPointer = std::shared_ptr<FilterEngines>;
+
     struct FilterData {
-        QScriptValue filterFn;
+        // held by the edits being filtered as well, so that the engines outlive a filter removed meanwhile
+        FilterEnginesPointer engines;
         bool wantsOriginalProperties { false };
         bool wantsZoneProperties { false };
 
@@ -40,12 +85,18 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
-        std::function<bool()> uncaughtExceptions;
-        QScriptEngine* engine;
         bool rejectAll;
         
-        FilterData(): engine(nullptr), rejectAll(false) {};
-        bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
+        FilterData(): rejectAll(false) {};
+        bool valid() { return (rejectAll || (engines && !engines->isEmpty())); }
+    };
+
+    struct FilterStats {
+        EntityItemID entityID; // the zone's, or the null id for the domain's filter
+        QString fileName;
+        quint64 numCalls { 0 };
+        quint64 averageTime { 0 }; // usecs
+        quint64 maxTime { 0 };
     };
 
     EntityEditFilters() {};
@@ -54,9 +105,15 @@ public:
     void addFilter(EntityItemID entityID, QString filterURL);
     void removeFilter(EntityItemID entityID);
 
+    // true if any edit may need filtering
+    bool hasFilters();
+
+    // may be called from several threads at once, with the tree locked for reading
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, const EntityItemPointer& existingEntity);
 
+    QVector<FilterStats> getFilterStats();
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -65,6 +122,9 @@ private slots:
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    bool callFilter(const FilterData& filterData, FilterEngines::Engine& filterEngine, const EntityItemID& zoneID,
+                    EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged,
+                    EntityTree::FilterType filterType, const EntityItemPointer& existingEntity);
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
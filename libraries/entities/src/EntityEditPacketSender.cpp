@@ -28,12 +28,37 @@ EntityEditPacketSender::EntityEditPacketSender() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerDirectListener(PacketType::EntityEditNack,
         PacketReceiver::makeSourcedListenerReference<EntityEditPacketSender>(this, &EntityEditPacketSender::processEntityEditNackPacket));
+    packetReceiver.registerDirectListener(PacketType::EntityPhysicsStateAck,
+        PacketReceiver::makeSourcedListenerReference<EntityEditPacketSender>(this, &EntityEditPacketSender::processEntityPhysicsStateAckPacket));
 }
 
 void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     processNackPacket(*message, sendingNode);
 }
 
+void EntityEditPacketSender::processEntityPhysicsStateAckPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    // the acks are the entity IDs with the sequences of the keyframes the entity-server got
+    const qint64 NUM_BYTES_ACK = NUM_BYTES_RFC4122_UUID + sizeof(uint8_t);
+    std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+    while (message->getBytesLeftToRead() >= NUM_BYTES_ACK) {
+        EntityItemID entityID(QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID)));
+        uint8_t sequence;
+        message->readPrimitive(&sequence);
+
+        auto itr = _physicsStateKeyframes.find(entityID);
+        if (itr == _physicsStateKeyframes.end()) {
+            continue;
+        }
+        Keyframe& keyframe = itr->pending[sequence % NUM_PENDING_KEYFRAMES];
+        if (keyframe.isValid && keyframe.sequence == sequence) {
+            itr->acked = keyframe;
+            for (auto& pending : itr->pending) {
+                pending.isValid = false;
+            }
+        }
+    }
+}
+
 void EntityEditPacketSender::adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) {
     if (type == PacketType::EntityAdd || type == PacketType::EntityEdit || type == PacketType::EntityPhysics) {
         EntityItem::adjustEditPacketForClockSkew(buffer, clockSkew);
@@ -95,6 +120,112 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return;
     }
 
+    if (type == PacketType::EntityEdit) {
+        std::lock_guard<std::mutex> lock(_coalescedEditsMutex);
+        auto index = _coalescedEditIndices.find(entityItemID);
+        if (index == _coalescedEditIndices.end()) {
+            _coalescedEditIndices.insert(entityItemID, _coalescedEdits.size());
+            _coalescedEdits.push_back({ entityItemID, properties });
+        } else {
+            EntityItemProperties& coalescedProperties = _coalescedEdits[index.value()].properties;
+            coalescedProperties.merge(properties);
+            coalescedProperties.setLastEdited(properties.getLastEdited());
+        }
+        return;
+    }
+
+    queueCoalescedEdits();
+    encodeEditEntityMessage(type, entityItemID, properties);
+}
+
+void EntityEditPacketSender::releaseQueuedMessages() {
+    queueCoalescedEdits();
+    queuePhysicsStates();
+    OctreeEditPacketSender::releaseQueuedMessages();
+}
+
+bool EntityEditPacketSender::queuePhysicsState(EntityTreePointer entityTree, EntityPhysicsState& state) {
+    if (entityTree && entityTree->isServerlessMode()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+    PhysicsStateKeyframes& keyframes = _physicsStateKeyframes[state.entityID];
+
+    EntityPhysicsState record = state;
+    record.flags &= ~EntityPhysicsState::KEYFRAME;
+    if (keyframes.acked.isValid) {
+        record.sequence = keyframes.acked.sequence;
+        record.position = state.position - keyframes.acked.position;
+    }
+    if (!keyframes.acked.isValid || !record.canEncode()) {
+        // the entity-server doesn't have a keyframe yet, or the entity moved too far from it
+        record.flags |= EntityPhysicsState::KEYFRAME;
+        record.position = state.position;
+        if (!record.canEncode()) {
+            return false;
+        }
+        record.sequence = ++keyframes.lastSequence;
+        keyframes.pending[record.sequence % NUM_PENDING_KEYFRAMES] = { record.position, record.sequence, true };
+    }
+    record.quantize();
+
+    state.position = record.isKeyframe() ? record.position : keyframes.acked.position + record.position;
+    state.rotation = record.rotation;
+    state.velocity = record.velocity;
+    state.angularVelocity = record.angularVelocity;
+    _physicsStates.push_back(record);
+    return true;
+}
+
+void EntityEditPacketSender::resetPhysicsStateKeyframe(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+    _physicsStateKeyframes.remove(entityID);
+}
+
+void EntityEditPacketSender::queuePhysicsStates() {
+    std::vector<EntityPhysicsState> physicsStates;
+    {
+        std::lock_guard<std::mutex> lock(_physicsStatesMutex);
+        physicsStates.swap(_physicsStates);
+    }
+    if (physicsStates.empty()) {
+        return;
+    }
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer entityServer = nodeList->soloNodeOfType(NodeType::EntityServer);
+    if (!entityServer || !entityServer->getActiveSocket()) {
+        // the states are stale by the time there is a server, and the next keyframes take over
+        return;
+    }
+
+    // the states are packed many to a packet and not resent, the next ones take over
+    auto packet = NLPacket::create(PacketType::EntityPhysicsState);
+    for (const auto& state : physicsStates) {
+        if (state.getEncodedSize() > packet->bytesAvailableForWrite()) {
+            queuePacketForSending(entityServer, std::move(packet));
+            packet = NLPacket::create(PacketType::EntityPhysicsState);
+        }
+        state.write(*packet);
+    }
+    queuePacketForSending(entityServer, std::move(packet));
+}
+
+void EntityEditPacketSender::queueCoalescedEdits() {
+    std::vector<CoalescedEdit> coalescedEdits;
+    {
+        std::lock_guard<std::mutex> lock(_coalescedEditsMutex);
+        coalescedEdits.swap(_coalescedEdits);
+        _coalescedEditIndices.clear();
+    }
+    // queueOctreeEditMessage() packs these densely into shared packets
+    for (const auto& edit : coalescedEdits) {
+        encodeEditEntityMessage(PacketType::EntityEdit, edit.entityItemID, edit.properties);
+    }
+}
+
+void EntityEditPacketSender::encodeEditEntityMessage(PacketType type, const EntityItemID& entityItemID,
+                                                     const EntityItemProperties& properties) {
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
 
     if (type == PacketType::EntityAdd) {
@@ -152,6 +283,7 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
 }
 
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
+    queueCoalescedEdits();
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
@@ -161,6 +293,7 @@ void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityI
 }
 
 void EntityEditPacketSender::queueCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID) {
+    queueCoalescedEdits();
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityClone), 0);
 
     if (EntityItemProperties::encodeCloneEntityMessage(entityIDToClone, newEntityID, bufferOut)) {
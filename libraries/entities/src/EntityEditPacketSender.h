@@ -16,9 +16,12 @@
 
 #include <OctreeEditPacketSender.h>
 
+#include <array>
 #include <mutex>
+#include <vector>
 
 #include "EntityItem.h"
+#include "EntityPhysicsState.h"
 #include "AvatarData.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit voxel messages.
@@ -34,6 +37,8 @@ public:
     /// which voxel-server node or nodes the packet should be sent to. Can be called even before voxel servers are known, in
     /// which case up to MaxPendingMessages will be buffered and processed when voxel servers are known.
     /// NOTE: EntityItemProperties assumes that all distances are in meter units
+    /// EntityEdit messages are held until releaseQueuedMessages(), and those to the same entity merged into one, so a
+    /// script changing an entity many times a frame sends it once.
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
@@ -41,22 +46,60 @@ public:
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
     void queueCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID);
 
+    /// Queues the compact physics state of a domain entity this client simulates, in place of an EntityPhysics edit,
+    /// relative to the last keyframe of the entity the entity-server acked. The state is rounded to what the
+    /// entity-server decodes. Returns false if it can't be encoded, for a full edit instead.
+    bool queuePhysicsState(EntityTreePointer entityTree, EntityPhysicsState& state);
+    /// the next state of the entity is a keyframe
+    void resetPhysicsStateKeyframe(const EntityItemID& entityID);
+
     // My server type is the model server
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
 
+    virtual void releaseQueuedMessages() override;
+
 signals:
     void addingEntityWithCertificate(const QString& certificateID, const QString& placeName);
 
 public slots:
     void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processEntityPhysicsStateAckPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 private:
     friend class MyAvatar;
     void queueEditAvatarEntityMessage(EntityTreePointer entityTree, EntityItemID entityItemID);
 
 private:
+    void encodeEditEntityMessage(PacketType type, const EntityItemID& entityItemID, const EntityItemProperties& properties);
+    // queues the held edits, before any other message so that it can't overtake an edit queued ahead of it
+    void queueCoalescedEdits();
+    void queuePhysicsStates();
+
     std::mutex _mutex;
     AvatarData* _myAvatar { nullptr };
+
+    struct CoalescedEdit {
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+    };
+    std::mutex _coalescedEditsMutex;
+    std::vector<CoalescedEdit> _coalescedEdits; // in the order each entity was first edited
+    QHash<EntityItemID, size_t> _coalescedEditIndices;
+
+    static const size_t NUM_PENDING_KEYFRAMES = 4;
+    struct Keyframe {
+        glm::vec3 position { 0.0f };
+        uint8_t sequence { 0 };
+        bool isValid { false };
+    };
+    struct PhysicsStateKeyframes {
+        Keyframe acked;
+        std::array<Keyframe, NUM_PENDING_KEYFRAMES> pending; // sent, not acked yet, by sequence % NUM_PENDING_KEYFRAMES
+        uint8_t lastSequence { 0 };
+    };
+    std::mutex _physicsStatesMutex;
+    std::vector<EntityPhysicsState> _physicsStates;
+    QHash<EntityItemID, PhysicsStateKeyframes> _physicsStateKeyframes;
 };
 #endif // hifi_EntityEditPacketSender_h
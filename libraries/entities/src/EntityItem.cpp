@@ -13,6 +13,7 @@
 
 #include <QtCore/QObject>
 #include <QtEndian>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <NetworkingConstants.h>
 #include <MetaverseAPI.h>
@@ -41,6 +42,7 @@
 #include "EntityTree.h"
 #include "EntitySimulation.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "EntityPhysicsState.h"
 
 //#define WANT_DEBUG
 
@@ -302,10 +304,12 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         APPEND_ENTITY_PROPERTY(PROP_IGNORE_PICK_INTERSECTION, getIgnorePickIntersection());
         APPEND_ENTITY_PROPERTY(PROP_RENDER_WITH_ZONES, getRenderWithZones());
         APPEND_ENTITY_PROPERTY(PROP_BILLBOARD_MODE, (uint32_t)getBillboardMode());
-        withReadLock([&] {
-            _grabProperties.appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
-                propertyFlags, propertiesDidntFit, propertyCount, appendState);
-        });
+        if (_grabProperties.hasRequestedProperties(requestedProperties)) {
+            withReadLock([&] {
+                _grabProperties.appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
+                    propertyFlags, propertiesDidntFit, propertyCount, appendState);
+            });
+        }
 
         // Physics
         APPEND_ENTITY_PROPERTY(PROP_DENSITY, getDensity());
@@ -1008,6 +1012,31 @@ int EntityItem::readEntityDataFromBuffer(const unsigned char* data, int bytesLef
     return bytesRead;
 }
 
+void EntityItem::setPhysicsState(const EntityPhysicsState& state) {
+    setPosition(state.position);
+    setRotation(state.rotation);
+    setVelocity(state.velocity);
+    setAngularVelocity(state.angularVelocity);
+}
+
+bool EntityItem::updatePhysicsStateFromNetwork(const EntityPhysicsState& state, quint64 timestamp) {
+    // the states carry the values of the four properties together, hence their timestamps move together
+    QUuid myNodeID = DependencyManager::get<NodeList>()->getSessionUUID();
+    if (_simulationOwner.matchesValidID(myNodeID) || stillHasGrab() || timestamp <= _lastUpdatedPositionTimestamp) {
+        return false;
+    }
+    setPhysicsState(state);
+    _lastUpdatedPositionTimestamp = timestamp;
+    _lastUpdatedPositionValue = state.position;
+    _lastUpdatedRotationTimestamp = timestamp;
+    _lastUpdatedRotationValue = state.rotation;
+    _lastUpdatedVelocityTimestamp = timestamp;
+    _lastUpdatedVelocityValue = state.velocity;
+    _lastUpdatedAngularVelocityTimestamp = timestamp;
+    _lastUpdatedAngularVelocityValue = state.angularVelocity;
+    return true;
+}
+
 void EntityItem::debugDump() const {
     auto position = getWorldPosition();
     qCDebug(entities) << "EntityItem id:" << getEntityItemID();
@@ -2711,9 +2740,25 @@ bool EntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
 
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
     static const QString ENTITY_TYPE_PROPERTY = "type";
+    static const QString PHYSICS_REGION_PROPERTY = "physicsRegion";
 
+    // the physics region is an alternative to the other filters: the collidable entities in it match in any case
+    bool hasPhysicsRegion = false;
     foreach(const auto& property, jsonFilters.keys()) {
-        if (property == SERVER_SCRIPTS_PROPERTY && jsonFilters[property] == EntityQueryFilterSymbol::NonDefault) {
+        if (property == PHYSICS_REGION_PROPERTY) {
+            hasPhysicsRegion = true;
+            QJsonObject region = jsonFilters[property].toObject();
+            QJsonArray center = region["center"].toArray();
+            glm::vec3 regionCenter(center.at(0).toDouble(), center.at(1).toDouble(), center.at(2).toDouble());
+            float regionRadius = (float)region["radius"].toDouble();
+            if (shouldBePhysical() && !getCollisionless()) {
+                bool success;
+                AACube queryCube = getQueryAACube(success);
+                if (success && queryCube.touchesSphere(regionCenter, regionRadius)) {
+                    return true;
+                }
+            }
+        } else if (property == SERVER_SCRIPTS_PROPERTY && jsonFilters[property] == EntityQueryFilterSymbol::NonDefault) {
             // check if this entity has a non-default value for serverScripts
             if (_serverScripts != ENTITY_ITEM_DEFAULT_SERVER_SCRIPTS) {
                 return true;
@@ -2726,7 +2771,7 @@ bool EntityItem::matchesJSONFilters(const QJsonObject& jsonFilters) const {
     }
 
     // the json filter syntax did not match what we expected, return a match
-    return true;
+    return !hasPhysicsRegion;
 }
 
 quint64 EntityItem::getLastSimulated() const {
@@ -44,6 +44,7 @@ class EntityTreeElement;
 class EntityTreeElementExtraEncodeData;
 class EntityDynamicInterface;
 class EntityItemProperties;
+class EntityPhysicsState;
 class EntityTree;
 class btCollisionShape;
 typedef std::shared_ptr<EntityTree> EntityTreePointer;
@@ -152,6 +153,11 @@ public:
 
     int readEntityDataFromBuffer(const unsigned char* data, int bytesLeftToRead, ReadBitstreamToTreeParams& args);
 
+    // the compact physics state of an EntityPhysicsState packet: set as is on the entity-server, and on the clients
+    // under the rules of the physics properties in readEntityDataFromBuffer(), timestamped in local time
+    void setPhysicsState(const EntityPhysicsState& state);
+    bool updatePhysicsStateFromNetwork(const EntityPhysicsState& state, quint64 timestamp);
+
     virtual int readEntitySubclassDataFromBuffer(const unsigned char* data, int bytesLeftToRead,
                                                 ReadBitstreamToTreeParams& args,
                                                 EntityPropertyFlags& propertyFlags, bool overwriteLocalData,
@@ -18,6 +18,8 @@
 
 namespace EntityJSONQueryProperties {
     static const QString SERVER_SCRIPTS_PROPERTY = "serverScripts";
+    // { "center": [x, y, z], "radius": r }: also send the collidable entities touching this sphere
+    static const QString PHYSICS_REGION_PROPERTY = "physicsRegion";
     static const QString FLAGS_PROPERTY = "flags";
     static const QString INCLUDE_ANCESTORS_PROPERTY = "includeAncestors";
     static const QString INCLUDE_DESCENDANTS_PROPERTY = "includeDescendants";
@@ -29,6 +31,10 @@ public:
 
     quint64 getLastDeletedEntitiesSentAt() const { return _lastDeletedEntitiesSentAt; }
     void setLastDeletedEntitiesSentAt(quint64 sentAt) { _lastDeletedEntitiesSentAt = sentAt; }
+
+    // the index in the entity-server's relay of the last physics state considered for this node
+    uint64_t getLastPhysicsStateSent() const { return _lastPhysicsStateSent; }
+    void setLastPhysicsStateSent(uint64_t index) { _lastPhysicsStateSent = index; }
     
     // these can only be called from the OctreeSendThread for the given Node
     void insertSentFilteredEntity(const QUuid& entityID) { _sentFilteredEntities.insert(entityID); }
@@ -46,6 +52,7 @@ public:
 
 private:
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
+    uint64_t _lastPhysicsStateSent { 0 };
     QSet<QUuid> _sentFilteredEntities;
     QHash<QUuid, QSet<QUuid>> _flaggedExtraEntities;
     QHash<QUuid, QSet<QUuid>> _previousFlaggedExtraEntities;
@@ -0,0 +1,132 @@
+//
+//  EntityPhysicsState.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPhysicsState.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <GLMHelpers.h>
+#include <UUID.h>
+
+// the offsets from the keyframe in 1/2048 m, up to 16 m
+const int POSITION_OFFSET_RADIX = 11;
+// up to 128 m/s in 1/256 m/s
+const int VELOCITY_RADIX = 8;
+// up to 64 rad/s in 1/512 rad/s
+const int ANGULAR_VELOCITY_RADIX = 9;
+
+const int NUM_BYTES_HEADER = NUM_BYTES_RFC4122_UUID + 2 * sizeof(uint8_t);
+const int NUM_BYTES_FIXED_VEC3 = 3 * sizeof(int16_t);
+const int NUM_BYTES_ROTATION = 6;
+
+const int EntityPhysicsState::MAX_ENCODED_SIZE = NUM_BYTES_HEADER + sizeof(glm::vec3) + NUM_BYTES_ROTATION + 2 * NUM_BYTES_FIXED_VEC3;
+
+static bool fitsSignedTwoByteFixed(const glm::vec3& value, int radix) {
+    // the packing clamps to the int16_t range
+    const float MAX_VALUE = (float)std::numeric_limits<int16_t>::max() / (float)(1 << radix);
+    return glm::all(glm::lessThan(glm::abs(value), glm::vec3(MAX_VALUE)));
+}
+
+bool EntityPhysicsState::canEncode() const {
+    if (!isKeyframe() && !fitsSignedTwoByteFixed(position, POSITION_OFFSET_RADIX)) {
+        return false;
+    }
+    return isAtRest() ||
+        (fitsSignedTwoByteFixed(velocity, VELOCITY_RADIX) && fitsSignedTwoByteFixed(angularVelocity, ANGULAR_VELOCITY_RADIX));
+}
+
+int EntityPhysicsState::getEncodedSize() const {
+    int size = NUM_BYTES_HEADER + NUM_BYTES_ROTATION;
+    size += isKeyframe() ? (int)sizeof(glm::vec3) : NUM_BYTES_FIXED_VEC3;
+    if (!isAtRest()) {
+        size += 2 * NUM_BYTES_FIXED_VEC3;
+    }
+    return size;
+}
+
+void EntityPhysicsState::quantize() {
+    unsigned char buffer[MAX_ENCODED_SIZE];
+    int numBytes = encode(buffer);
+    decode(buffer, numBytes);
+}
+
+int EntityPhysicsState::encode(unsigned char* buffer) const {
+    unsigned char* dataAt = buffer;
+    QByteArray id = entityID.toRfc4122();
+    memcpy(dataAt, id.constData(), NUM_BYTES_RFC4122_UUID);
+    dataAt += NUM_BYTES_RFC4122_UUID;
+    *dataAt++ = flags;
+    *dataAt++ = sequence;
+
+    if (isKeyframe()) {
+        memcpy(dataAt, &position, sizeof(glm::vec3));
+        dataAt += sizeof(glm::vec3);
+    } else {
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, position, POSITION_OFFSET_RADIX);
+    }
+    dataAt += packOrientationQuatToSixBytes(dataAt, rotation);
+    if (!isAtRest()) {
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, velocity, VELOCITY_RADIX);
+        dataAt += packFloatVec3ToSignedTwoByteFixed(dataAt, angularVelocity, ANGULAR_VELOCITY_RADIX);
+    }
+    return (int)(dataAt - buffer);
+}
+
+int EntityPhysicsState::decode(const unsigned char* buffer, int numBytes) {
+    if (numBytes < NUM_BYTES_HEADER) {
+        return 0;
+    }
+    const unsigned char* dataAt = buffer;
+    entityID = QUuid::fromRfc4122(QByteArray::fromRawData((const char*)dataAt, NUM_BYTES_RFC4122_UUID));
+    dataAt += NUM_BYTES_RFC4122_UUID;
+    flags = *dataAt++;
+    sequence = *dataAt++;
+    if (numBytes < getEncodedSize()) {
+        return 0;
+    }
+
+    if (isKeyframe()) {
+        memcpy(&position, dataAt, sizeof(glm::vec3));
+        dataAt += sizeof(glm::vec3);
+    } else {
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, position, POSITION_OFFSET_RADIX);
+    }
+    dataAt += unpackOrientationQuatFromSixBytes(dataAt, rotation);
+    if (isAtRest()) {
+        velocity = glm::vec3(0.0f);
+        angularVelocity = glm::vec3(0.0f);
+    } else {
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, velocity, VELOCITY_RADIX);
+        dataAt += unpackFloatVec3FromSignedTwoByteFixed(dataAt, angularVelocity, ANGULAR_VELOCITY_RADIX);
+    }
+    return (int)(dataAt - buffer);
+}
+
+void EntityPhysicsState::write(NLPacket& packet) const {
+    unsigned char buffer[MAX_ENCODED_SIZE];
+    int numBytes = encode(buffer);
+    packet.write((const char*)buffer, numBytes);
+}
+
+bool EntityPhysicsState::read(ReceivedMessage& message) {
+    qint64 bytesLeft = message.getBytesLeftToRead();
+    if (bytesLeft < NUM_BYTES_HEADER) {
+        return false;
+    }
+    const unsigned char* dataAt = (const unsigned char*)message.getRawMessage() + message.getPosition();
+    int numBytes = decode(dataAt, (int)std::min(bytesLeft, (qint64)MAX_ENCODED_SIZE));
+    if (numBytes == 0) {
+        return false;
+    }
+    message.seek(message.getPosition() + numBytes);
+    return true;
+}
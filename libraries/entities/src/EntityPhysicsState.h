@@ -0,0 +1,63 @@
+//
+//  EntityPhysicsState.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPhysicsState_h
+#define hifi_EntityPhysicsState_h
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+#include "EntityItemID.h"
+
+// The compact physics state of an entity, sent many to an EntityPhysicsState packet by its simulation owner in place
+// of a full EntityPhysics edit while the entity moves, then relayed by the entity-server to the viewers that know it.
+//
+// A KEYFRAME carries the local position in full. The other states carry it as an offset, in 1/2048 m, from the keyframe
+// of the given sequence that the entity-server acked. The rotation goes as the smallest three in six bytes, and the
+// velocities in 16 bit fixed point unless the entity is AT_REST.
+class EntityPhysicsState {
+public:
+    enum Flags : uint8_t {
+        KEYFRAME = 0x01,
+        AT_REST = 0x02
+    };
+
+    EntityItemID entityID;
+    uint8_t flags { 0 };
+    uint8_t sequence { 0 }; // of the keyframe, or of the keyframe the position is relative to
+    glm::vec3 position { 0.0f };
+    glm::quat rotation;
+    glm::vec3 velocity { 0.0f };
+    glm::vec3 angularVelocity { 0.0f };
+
+    bool isKeyframe() const { return flags & KEYFRAME; }
+    bool isAtRest() const { return flags & AT_REST; }
+
+    /// \return false if the position offset or a velocity is out of range of the encoding
+    bool canEncode() const;
+    int getEncodedSize() const;
+
+    /// rounds the values to what the receivers decode
+    void quantize();
+
+    int encode(unsigned char* buffer) const;
+    int decode(const unsigned char* buffer, int numBytes);
+
+    void write(NLPacket& packet) const;
+    bool read(ReceivedMessage& message);
+
+    static const int MAX_ENCODED_SIZE;
+};
+
+#endif // hifi_EntityPhysicsState_h
@@ -24,11 +24,12 @@ public:
     static constexpr float FORCE_REMOVE { -1.0e5f };
     static constexpr float WHEN_IN_DOUBT_PRIORITY { 1.0f };
 
-    PrioritizedEntity(EntityItemPointer entity, float priority, bool forceRemove = false) : _weakEntity(entity), _rawEntityPointer(entity.get()), _priority(priority), _forceRemove(forceRemove) {}
+    PrioritizedEntity(EntityItemPointer entity, float priority, bool forceRemove = false, int viewIndex = -1) : _weakEntity(entity), _rawEntityPointer(entity.get()), _priority(priority), _forceRemove(forceRemove), _viewIndex((int8_t)viewIndex) {}
     EntityItemPointer getEntity() const { return _weakEntity.lock(); }
     EntityItem* getRawEntityPointer() const { return _rawEntityPointer; }
     float getPriority() const { return _priority; }
     bool shouldForceRemove() const { return _forceRemove; }
+    int getViewIndex() const { return _viewIndex; } // the view the entity is sent for, -1 for none
 
     class Compare {
     public:
@@ -41,6 +42,7 @@ private:
     EntityItem* _rawEntityPointer;
     float _priority;
     bool _forceRemove;
+    int8_t _viewIndex;
 };
 
 class EntityPriorityQueue {
@@ -59,9 +61,9 @@ public:
         return _entities.find(entity) != std::end(_entities);
     }
 
-    inline void emplace(const EntityItemPointer& entity, float priority, bool forceRemove = false) {
+    inline void emplace(const EntityItemPointer& entity, float priority, bool forceRemove = false, int viewIndex = -1) {
         assert(entity && !contains(entity.get()));
-        _queue.emplace(entity, priority, forceRemove);
+        _queue.emplace(entity, priority, forceRemove, viewIndex);
         _entities.insert(entity.get());
         assert(_queue.size() == _entities.size());
     }
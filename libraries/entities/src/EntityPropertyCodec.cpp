@@ -0,0 +1,173 @@
+//
+//  EntityPropertyCodec.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertyCodec.h"
+
+#include <array>
+
+#include <OctreePacketData.h>
+
+#include "EntityItemProperties.h"
+
+namespace {
+
+using Descriptors = std::array<EntityPropertyCodec::Descriptor, EntityPropertyCodec::LAST_PROPERTY + 1>;
+
+// V is the value to append, taken from properties; S is the setter that takes the T read back
+#define ENTITY_PROPERTY_CODEC(P, T, V, S)                                                       \
+    descriptors[P].encode = [](OctreePacketData* packetData, const EntityItemProperties& properties) { \
+        return packetData->appendValue(V);                                                      \
+    };                                                                                          \
+    descriptors[P].decode = [](const unsigned char* dataAt, EntityItemProperties& properties) { \
+        T fromBuffer;                                                                           \
+        int bytes = OctreePacketData::unpackDataFromBytes(dataAt, fromBuffer);                  \
+        properties.S(fromBuffer);                                                               \
+        return bytes;                                                                           \
+    };
+
+Descriptors makeDescriptors() {
+    Descriptors descriptors;
+
+    ENTITY_PROPERTY_CODEC(PROP_SIMULATION_OWNER, QByteArray, properties.getSimulationOwner().toByteArray(), setSimulationOwner);
+    ENTITY_PROPERTY_CODEC(PROP_PARENT_ID, QUuid, properties.getParentID(), setParentID);
+    ENTITY_PROPERTY_CODEC(PROP_PARENT_JOINT_INDEX, quint16, properties.getParentJointIndex(), setParentJointIndex);
+    ENTITY_PROPERTY_CODEC(PROP_VISIBLE, bool, properties.getVisible(), setVisible);
+    ENTITY_PROPERTY_CODEC(PROP_NAME, QString, properties.getName(), setName);
+    ENTITY_PROPERTY_CODEC(PROP_LOCKED, bool, properties.getLocked(), setLocked);
+    ENTITY_PROPERTY_CODEC(PROP_USER_DATA, QString, properties.getUserData(), setUserData);
+    ENTITY_PROPERTY_CODEC(PROP_PRIVATE_USER_DATA, QString, properties.getPrivateUserData(), setPrivateUserData);
+    ENTITY_PROPERTY_CODEC(PROP_HREF, QString, properties.getHref(), setHref);
+    ENTITY_PROPERTY_CODEC(PROP_DESCRIPTION, QString, properties.getDescription(), setDescription);
+    ENTITY_PROPERTY_CODEC(PROP_POSITION, glm::vec3, properties.getPosition(), setPosition);
+    ENTITY_PROPERTY_CODEC(PROP_DIMENSIONS, glm::vec3, properties.getDimensions(), setDimensions);
+    ENTITY_PROPERTY_CODEC(PROP_ROTATION, glm::quat, properties.getRotation(), setRotation);
+    ENTITY_PROPERTY_CODEC(PROP_REGISTRATION_POINT, glm::vec3, properties.getRegistrationPoint(), setRegistrationPoint);
+    ENTITY_PROPERTY_CODEC(PROP_CREATED, quint64, properties.getCreated(), setCreated);
+    ENTITY_PROPERTY_CODEC(PROP_LAST_EDITED_BY, QUuid, properties.getLastEditedBy(), setLastEditedBy);
+    // PROP_ENTITY_HOST_TYPE, PROP_OWNING_AVATAR_ID and PROP_VISIBLE_IN_SECONDARY_CAMERA are not sent over the wire
+    ENTITY_PROPERTY_CODEC(PROP_QUERY_AA_CUBE, AACube, properties.getQueryAACube(), setQueryAACube);
+    ENTITY_PROPERTY_CODEC(PROP_CAN_CAST_SHADOW, bool, properties.getCanCastShadow(), setCanCastShadow);
+    ENTITY_PROPERTY_CODEC(PROP_RENDER_LAYER, RenderLayer, (uint32_t)properties.getRenderLayer(), setRenderLayer);
+    ENTITY_PROPERTY_CODEC(PROP_PRIMITIVE_MODE, PrimitiveMode, (uint32_t)properties.getPrimitiveMode(), setPrimitiveMode);
+    ENTITY_PROPERTY_CODEC(PROP_IGNORE_PICK_INTERSECTION, bool, properties.getIgnorePickIntersection(),
+                          setIgnorePickIntersection);
+    ENTITY_PROPERTY_CODEC(PROP_RENDER_WITH_ZONES, QVector<QUuid>, properties.getRenderWithZones(), setRenderWithZones);
+    ENTITY_PROPERTY_CODEC(PROP_BILLBOARD_MODE, BillboardMode, (uint32_t)properties.getBillboardMode(), setBillboardMode);
+    // the grab group encodes its own properties
+
+    // Physics
+    ENTITY_PROPERTY_CODEC(PROP_DENSITY, float, properties.getDensity(), setDensity);
+    ENTITY_PROPERTY_CODEC(PROP_VELOCITY, glm::vec3, properties.getVelocity(), setVelocity);
+    ENTITY_PROPERTY_CODEC(PROP_ANGULAR_VELOCITY, glm::vec3, properties.getAngularVelocity(), setAngularVelocity);
+    ENTITY_PROPERTY_CODEC(PROP_GRAVITY, glm::vec3, properties.getGravity(), setGravity);
+    ENTITY_PROPERTY_CODEC(PROP_ACCELERATION, glm::vec3, properties.getAcceleration(), setAcceleration);
+    ENTITY_PROPERTY_CODEC(PROP_DAMPING, float, properties.getDamping(), setDamping);
+    ENTITY_PROPERTY_CODEC(PROP_ANGULAR_DAMPING, float, properties.getAngularDamping(), setAngularDamping);
+    ENTITY_PROPERTY_CODEC(PROP_RESTITUTION, float, properties.getRestitution(), setRestitution);
+    ENTITY_PROPERTY_CODEC(PROP_FRICTION, float, properties.getFriction(), setFriction);
+    ENTITY_PROPERTY_CODEC(PROP_LIFETIME, float, properties.getLifetime(), setLifetime);
+    ENTITY_PROPERTY_CODEC(PROP_COLLISIONLESS, bool, properties.getCollisionless(), setCollisionless);
+    ENTITY_PROPERTY_CODEC(PROP_COLLISION_MASK, uint16_t, properties.getCollisionMask(), setCollisionMask);
+    ENTITY_PROPERTY_CODEC(PROP_DYNAMIC, bool, properties.getDynamic(), setDynamic);
+    ENTITY_PROPERTY_CODEC(PROP_COLLISION_SOUND_URL, QString, properties.getCollisionSoundURL(), setCollisionSoundURL);
+    ENTITY_PROPERTY_CODEC(PROP_ACTION_DATA, QByteArray, properties.getActionData(), setActionData);
+
+    // Cloning
+    ENTITY_PROPERTY_CODEC(PROP_CLONEABLE, bool, properties.getCloneable(), setCloneable);
+    ENTITY_PROPERTY_CODEC(PROP_CLONE_LIFETIME, float, properties.getCloneLifetime(), setCloneLifetime);
+    ENTITY_PROPERTY_CODEC(PROP_CLONE_LIMIT, float, properties.getCloneLimit(), setCloneLimit);
+    ENTITY_PROPERTY_CODEC(PROP_CLONE_DYNAMIC, bool, properties.getCloneDynamic(), setCloneDynamic);
+    ENTITY_PROPERTY_CODEC(PROP_CLONE_AVATAR_ENTITY, bool, properties.getCloneAvatarEntity(), setCloneAvatarEntity);
+    ENTITY_PROPERTY_CODEC(PROP_CLONE_ORIGIN_ID, QUuid, properties.getCloneOriginID(), setCloneOriginID);
+
+    // Scripts
+    ENTITY_PROPERTY_CODEC(PROP_SCRIPT, QString, properties.getScript(), setScript);
+    ENTITY_PROPERTY_CODEC(PROP_SCRIPT_TIMESTAMP, quint64, properties.getScriptTimestamp(), setScriptTimestamp);
+    ENTITY_PROPERTY_CODEC(PROP_SERVER_SCRIPTS, QString, properties.getServerScripts(), setServerScripts);
+
+    // Certifiable Properties
+    ENTITY_PROPERTY_CODEC(PROP_ITEM_NAME, QString, properties.getItemName(), setItemName);
+    ENTITY_PROPERTY_CODEC(PROP_ITEM_DESCRIPTION, QString, properties.getItemDescription(), setItemDescription);
+    ENTITY_PROPERTY_CODEC(PROP_ITEM_CATEGORIES, QString, properties.getItemCategories(), setItemCategories);
+    ENTITY_PROPERTY_CODEC(PROP_ITEM_ARTIST, QString, properties.getItemArtist(), setItemArtist);
+    ENTITY_PROPERTY_CODEC(PROP_ITEM_LICENSE, QString, properties.getItemLicense(), setItemLicense);
+    ENTITY_PROPERTY_CODEC(PROP_LIMITED_RUN, quint32, properties.getLimitedRun(), setLimitedRun);
+    ENTITY_PROPERTY_CODEC(PROP_MARKETPLACE_ID, QString, properties.getMarketplaceID(), setMarketplaceID);
+    ENTITY_PROPERTY_CODEC(PROP_EDITION_NUMBER, quint32, properties.getEditionNumber(), setEditionNumber);
+    ENTITY_PROPERTY_CODEC(PROP_ENTITY_INSTANCE_NUMBER, quint32, properties.getEntityInstanceNumber(),
+                          setEntityInstanceNumber);
+    ENTITY_PROPERTY_CODEC(PROP_CERTIFICATE_ID, QString, properties.getCertificateID(), setCertificateID);
+    ENTITY_PROPERTY_CODEC(PROP_CERTIFICATE_TYPE, QString, properties.getCertificateType(), setCertificateType);
+    ENTITY_PROPERTY_CODEC(PROP_STATIC_CERTIFICATE_VERSION, quint32, properties.getStaticCertificateVersion(),
+                          setStaticCertificateVersion);
+
+    return descriptors;
+}
+
+#undef ENTITY_PROPERTY_CODEC
+
+const Descriptors& getDescriptors() {
+    static const Descriptors descriptors = makeDescriptors();
+    return descriptors;
+}
+
+}
+
+const EntityPropertyCodec::Descriptor& EntityPropertyCodec::getDescriptor(EntityPropertyList property) {
+    static const Descriptor NO_DESCRIPTOR;
+    if (property < FIRST_PROPERTY || property > LAST_PROPERTY) {
+        return NO_DESCRIPTOR;
+    }
+    return getDescriptors()[property];
+}
+
+void EntityPropertyCodec::appendToEditPacket(OctreePacketData* packetData, const EntityItemProperties& properties,
+                                             EntityPropertyList first, EntityPropertyList last,
+                                             const EntityPropertyFlags& requestedProperties,
+                                             EntityPropertyFlags& propertyFlags, EntityPropertyFlags& propertiesDidntFit,
+                                             int& propertyCount, OctreeElement::AppendState& appendState) {
+    const Descriptors& descriptors = getDescriptors();
+    int lastProperty = last < LAST_PROPERTY ? last : LAST_PROPERTY;
+    for (int property = requestedProperties.getNextProperty(first); property != -1 && property <= lastProperty;
+            property = requestedProperties.getNextProperty(property + 1)) {
+        Encoder encode = descriptors[property].encode;
+        if (!encode) {
+            continue;
+        }
+
+        LevelDetails propertyLevel = packetData->startLevel();
+        if (encode(packetData, properties)) {
+            propertyFlags |= (EntityPropertyList)property;
+            propertiesDidntFit -= (EntityPropertyList)property;
+            propertyCount++;
+            packetData->endLevel(propertyLevel);
+        } else {
+            packetData->discardLevel(propertyLevel);
+            appendState = OctreeElement::PARTIAL;
+        }
+    }
+}
+
+void EntityPropertyCodec::decodeFromEditPacket(const EntityPropertyFlags& propertyFlags, EntityPropertyList first,
+                                               EntityPropertyList last, const unsigned char*& dataAt,
+                                               int& processedBytes, EntityItemProperties& properties) {
+    const Descriptors& descriptors = getDescriptors();
+    int lastProperty = last < LAST_PROPERTY ? last : LAST_PROPERTY;
+    for (int property = propertyFlags.getNextProperty(first); property != -1 && property <= lastProperty;
+            property = propertyFlags.getNextProperty(property + 1)) {
+        Decoder decode = descriptors[property].decode;
+        if (decode) {
+            int bytes = decode(dataAt, properties);
+            dataAt += bytes;
+            processedBytes += bytes;
+        }
+    }
+}
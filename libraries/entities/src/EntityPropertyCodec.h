@@ -0,0 +1,56 @@
+//
+//  EntityPropertyCodec.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertyCodec_h
+#define hifi_EntityPropertyCodec_h
+
+#include <OctreeElement.h>
+
+#include "EntityPropertyFlags.h"
+
+class EntityItemProperties;
+class OctreePacketData;
+
+// Encodes and decodes the properties that every entity type sends in its edit packets, from a table with an entry for
+// each of their flags. Rather than testing the flag of every property in turn, encoding and decoding visit only the
+// flags that are set, and the entry of each is a function written for the type of its property.
+//   The properties go on the wire in flag order, as they did when each was appended by hand.
+class EntityPropertyCodec {
+public:
+    using Encoder = bool (*)(OctreePacketData* packetData, const EntityItemProperties& properties);
+    // returns the number of bytes read
+    using Decoder = int (*)(const unsigned char* dataAt, EntityItemProperties& properties);
+
+    struct Descriptor {
+        Encoder encode { nullptr };
+        Decoder decode { nullptr };
+    };
+
+    // the properties in the table; a flag in this range without an entry is either a group's or not sent
+    static const EntityPropertyList FIRST_PROPERTY = PROP_SIMULATION_OWNER;
+    static const EntityPropertyList LAST_PROPERTY = PROP_STATIC_CERTIFICATE_VERSION;
+
+    // appends the requested properties from first to last, in the manner of APPEND_ENTITY_PROPERTY
+    static void appendToEditPacket(OctreePacketData* packetData, const EntityItemProperties& properties,
+                                   EntityPropertyList first, EntityPropertyList last,
+                                   const EntityPropertyFlags& requestedProperties, EntityPropertyFlags& propertyFlags,
+                                   EntityPropertyFlags& propertiesDidntFit, int& propertyCount,
+                                   OctreeElement::AppendState& appendState);
+
+    // reads the properties from first to last that the packet has, in the manner of READ_ENTITY_PROPERTY_TO_PROPERTIES
+    static void decodeFromEditPacket(const EntityPropertyFlags& propertyFlags, EntityPropertyList first,
+                                     EntityPropertyList last, const unsigned char*& dataAt, int& processedBytes,
+                                     EntityItemProperties& properties);
+
+    static const Descriptor& getDescriptor(EntityPropertyList property);
+};
+
+#endif // hifi_EntityPropertyCodec_h
@@ -11,6 +11,10 @@
 
 #include "EntityScriptingInterface.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
 
@@ -791,104 +795,304 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     return finalResult;
 }
 
+namespace {
+
+// the properties getMultipleEntityPropertyArrays can pack, read straight from the entity under the tree lock
+struct PackedEntityProperty {
+    int numComponents;
+    std::function<void(const EntityItemPointer&, float*)> read;
+};
+
+void packVec3(float* values, const glm::vec3& v) {
+    values[0] = v.x;
+    values[1] = v.y;
+    values[2] = v.z;
+}
+
+void packQuat(float* values, const glm::quat& q) {
+    values[0] = q.x;
+    values[1] = q.y;
+    values[2] = q.z;
+    values[3] = q.w;
+}
+
+const QHash<QString, PackedEntityProperty>& getPackedEntityProperties() {
+    static const QHash<QString, PackedEntityProperty> PACKED_ENTITY_PROPERTIES {
+        { "position", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getWorldPosition()); } } },
+        { "rotation", { 4, [](const EntityItemPointer& entity, float* values) { packQuat(values, entity->getWorldOrientation()); } } },
+        { "velocity", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getWorldVelocity()); } } },
+        { "angularVelocity", { 3, [](const EntityItemPointer& entity, float* values) {
+            packVec3(values, entity->getWorldAngularVelocity());
+        } } },
+        { "localPosition", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getLocalPosition()); } } },
+        { "localRotation", { 4, [](const EntityItemPointer& entity, float* values) {
+            packQuat(values, entity->getLocalOrientation());
+        } } },
+        { "localVelocity", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getLocalVelocity()); } } },
+        { "dimensions", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getScaledDimensions()); } } },
+        { "registrationPoint", { 3, [](const EntityItemPointer& entity, float* values) {
+            packVec3(values, entity->getRegistrationPoint());
+        } } },
+        { "gravity", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getGravity()); } } },
+        { "acceleration", { 3, [](const EntityItemPointer& entity, float* values) { packVec3(values, entity->getAcceleration()); } } },
+        { "density", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getDensity(); } } },
+        { "friction", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getFriction(); } } },
+        { "restitution", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getRestitution(); } } },
+        { "damping", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getDamping(); } } },
+        { "angularDamping", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getAngularDamping(); } } },
+        { "lifetime", { 1, [](const EntityItemPointer& entity, float* values) { values[0] = entity->getLifetime(); } } }
+    };
+    return PACKED_ENTITY_PROPERTIES;
+}
+
+}
+
+QScriptValue EntityScriptingInterface::getMultipleEntityPropertyArrays(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_DESIRED_PROPERTIES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    QStringList desiredProperties;
+    QScriptValue desiredPropertiesArgument = context->argument(ARGUMENT_DESIRED_PROPERTIES);
+    if (desiredPropertiesArgument.isString()) {
+        desiredProperties.push_back(desiredPropertiesArgument.toString());
+    } else {
+        desiredProperties = qscriptvalue_cast<QStringList>(desiredPropertiesArgument);
+    }
+    return entityScriptingInterface->getMultipleEntityPropertyArraysInternal(engine, entityIDs, desiredProperties);
+}
+
+QScriptValue EntityScriptingInterface::getMultipleEntityPropertyArraysInternal(QScriptEngine* engine,
+                                                                              const QVector<QUuid>& entityIDs,
+                                                                              const QStringList& desiredProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    const auto& packedProperties = getPackedEntityProperties();
+    QVector<QString> names;
+    QVector<const PackedEntityProperty*> properties;
+    QVector<QByteArray> buffers;
+    for (const auto& name : desiredProperties) {
+        auto itr = packedProperties.find(name);
+        if (itr != packedProperties.end() && !names.contains(name)) {
+            names.push_back(name);
+            properties.push_back(&itr.value());
+            buffers.push_back(QByteArray(entityIDs.size() * itr->numComponents * (int)sizeof(float), 0));
+        }
+    }
+
+    const float MISSING_VALUE = std::numeric_limits<float>::quiet_NaN();
+    const auto readProperties = [&](int index, const EntityItemPointer& entity) {
+        for (int i = 0; i < properties.size(); ++i) {
+            int numComponents = properties[i]->numComponents;
+            float* values = reinterpret_cast<float*>(buffers[i].data()) + index * numComponents;
+            if (entity) {
+                properties[i]->read(entity, values);
+            } else {
+                std::fill(values, values + numComponents, MISSING_VALUE);
+            }
+        }
+    };
+
+    if (!properties.isEmpty()) {
+        if (_entityTree) {
+            // as getMultipleEntityProperties, let go of the lock now and then for the sake of the other threads
+            int i = 0;
+            const int lockAmount = 500;
+            int size = entityIDs.size();
+            while (i < size) {
+                _entityTree->withReadLock([&] {
+                    for (int j = 0; j < lockAmount && i < size; ++i, ++j) {
+                        readProperties(i, _entityTree->findEntityByEntityItemID(EntityItemID(entityIDs.at(i))));
+                    }
+                });
+            }
+        } else {
+            for (int i = 0; i < entityIDs.size(); ++i) {
+                readProperties(i, EntityItemPointer());
+            }
+        }
+    }
+
+    // the script engines convert a QByteArray to an ArrayBuffer, which the Float32Array is a view of
+    QScriptValue float32ArrayConstructor = engine->globalObject().property("Float32Array");
+    QScriptValue result = engine->newObject();
+    for (int i = 0; i < names.size(); ++i) {
+        QScriptValue buffer = engine->toScriptValue(buffers[i]);
+        if (float32ArrayConstructor.isFunction()) {
+            result.setProperty(names[i], float32ArrayConstructor.construct(QScriptValueList { buffer }));
+        } else {
+            const float* values = reinterpret_cast<const float*>(buffers[i].constData());
+            int numValues = buffers[i].size() / (int)sizeof(float);
+            QScriptValue array = engine->newArray(numValues);
+            for (int j = 0; j < numValues; ++j) {
+                array.setProperty(j, values[j]);
+            }
+            result.setProperty(names[i], array);
+        }
+    }
+    return result;
+}
+
 QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
+    return editMultipleEntitiesInternal({ id }, { scriptSideProperties }).at(0);
+}
+
+QScriptValue EntityScriptingInterface::editMultipleEntities(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTIES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    QScriptValue propertiesArgument = context->argument(ARGUMENT_PROPERTIES);
+    QVector<EntityItemProperties> properties;
+    if (propertiesArgument.isArray()) {
+        const quint32 length = propertiesArgument.property("length").toUInt32();
+        if (length != (quint32)entityIDs.size()) {
+            return context->throwError(QScriptContext::RangeError,
+                "Entities.editMultipleEntities: expected one set of properties per entity ID");
+        }
+        properties.resize(length);
+        for (quint32 i = 0; i < length; ++i) {
+            EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesArgument.property(i), properties[i]);
+        }
+    } else {
+        EntityItemProperties sharedProperties;
+        EntityItemPropertiesFromScriptValueHonorReadOnly(propertiesArgument, sharedProperties);
+        properties.fill(sharedProperties, entityIDs.size());
+    }
+
+    QVector<QUuid> results = entityScriptingInterface->editMultipleEntitiesInternal(entityIDs, properties);
+    QScriptValue resultsArray = engine->newArray(results.size());
+    for (int i = 0; i < results.size(); ++i) {
+        resultsArray.setProperty(i, results[i].isNull() ? engine->nullValue() : quuidToScriptValue(engine, results[i]));
+    }
+    return resultsArray;
+}
+
+QVector<QUuid> EntityScriptingInterface::editMultipleEntitiesInternal(const QVector<QUuid>& entityIDs,
+                                                                       QVector<EntityItemProperties> properties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    _activityTracking.editedEntityCount++;
+    const int numEdits = entityIDs.size();
+    _activityTracking.editedEntityCount += numEdits;
 
     const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
 
-    EntityItemProperties properties = scriptSideProperties;
-
-    EntityItemID entityID(id);
+    QVector<QUuid> results = entityIDs;
     if (!_entityTree) {
-        properties.setLastEditedBy(sessionID);
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-        return id;
+        for (int i = 0; i < numEdits; ++i) {
+            properties[i].setLastEditedBy(sessionID);
+            queueEntityMessage(PacketType::EntityEdit, EntityItemID(entityIDs[i]), properties[i]);
+        }
+        return results;
     }
 
-    EntityItemPointer entity(nullptr);
-    SimulationOwner simulationOwner;
+    struct Edit {
+        EntityItemID entityID;
+        EntityItemPointer entity;
+        SimulationOwner simulationOwner;
+        bool hasQueryAACubeRelatedChanges { false };
+        bool failed { false };
+    };
+    QVector<Edit> edits(numEdits);
+
     _entityTree->withReadLock([&] {
-        // make a copy of entity for local logic outside of tree lock
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
+        for (int i = 0; i < numEdits; ++i) {
+            auto& edit = edits[i];
+            edit.entityID = EntityItemID(entityIDs[i]);
+            // make a copy of entity for local logic outside of tree lock
+            edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+            if (!edit.entity) {
+                continue;
+            }
 
-        if (entity->isAvatarEntity() && !entity->isMyAvatarEntity()) {
-            // don't edit other avatar's avatarEntities
-            properties = EntityItemProperties();
-            return;
+            if (edit.entity->isAvatarEntity() && !edit.entity->isMyAvatarEntity()) {
+                // don't edit other avatar's avatarEntities
+                properties[i] = EntityItemProperties();
+                continue;
+            }
+            // make a copy of simulationOwner for local logic outside of tree lock
+            edit.simulationOwner = edit.entity->getSimulationOwner();
         }
-        // make a copy of simulationOwner for local logic outside of tree lock
-        simulationOwner = entity->getSimulationOwner();
     });
 
-    QString previousUserdata;
-    if (entity) {
-        if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
-            // if an entity is grabbed, the grab will override any position changes
-            properties.clearTransformOrVelocityChanges();
-        }
-        if (properties.hasSimulationRestrictedChanges()) {
-            if (_bidOnSimulationOwnership) {
-                // flag for simulation ownership, or upgrade existing ownership priority
-                // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
-                entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
-                if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
-                    // we own the simulation --> copy ALL restricted properties
-                    properties.copySimulationRestrictedProperties(entity);
-                } else {
-                    // we don't own the simulation but think we would like to
-
-                    uint8_t desiredPriority = entity->getScriptSimulationPriority();
-                    if (desiredPriority < simulationOwner.getPriority()) {
-                        // the priority at which we'd like to own it is not high enough
-                        // --> assume failure and clear all restricted property changes
-                        properties.clearSimulationRestrictedProperties();
+    for (int i = 0; i < numEdits; ++i) {
+        auto& edit = edits[i];
+        auto& entity = edit.entity;
+        auto& simulationOwner = edit.simulationOwner;
+        EntityItemProperties& editProperties = properties[i];
+
+        QString previousUserdata;
+        if (entity) {
+            if (editProperties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
+                // if an entity is grabbed, the grab will override any position changes
+                editProperties.clearTransformOrVelocityChanges();
+            }
+            if (editProperties.hasSimulationRestrictedChanges()) {
+                if (_bidOnSimulationOwnership) {
+                    // flag for simulation ownership, or upgrade existing ownership priority
+                    // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
+                    entity->upgradeScriptSimulationPriority(editProperties.computeSimulationBidPriority());
+                    if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
+                        // we own the simulation --> copy ALL restricted properties
+                        editProperties.copySimulationRestrictedProperties(entity);
                     } else {
-                        // the priority at which we'd like to own it is high enough to win.
-                        // --> assume success and copy ALL restricted properties
-                        properties.copySimulationRestrictedProperties(entity);
+                        // we don't own the simulation but think we would like to
+
+                        uint8_t desiredPriority = entity->getScriptSimulationPriority();
+                        if (desiredPriority < simulationOwner.getPriority()) {
+                            // the priority at which we'd like to own it is not high enough
+                            // --> assume failure and clear all restricted property changes
+                            editProperties.clearSimulationRestrictedProperties();
+                        } else {
+                            // the priority at which we'd like to own it is high enough to win.
+                            // --> assume success and copy ALL restricted properties
+                            editProperties.copySimulationRestrictedProperties(entity);
+                        }
                     }
+                } else if (!simulationOwner.getID().isNull()) {
+                    // someone owns this but not us
+                    // clear restricted properties
+                    editProperties.clearSimulationRestrictedProperties();
                 }
-            } else if (!simulationOwner.getID().isNull()) {
-                // someone owns this but not us
-                // clear restricted properties
-                properties.clearSimulationRestrictedProperties();
+                // clear the cached simulationPriority level
+                entity->upgradeScriptSimulationPriority(0);
             }
-            // clear the cached simulationPriority level
-            entity->upgradeScriptSimulationPriority(0);
-        }
 
-        // set these to make EntityItemProperties::getScalesWithParent() work correctly
-        entity::HostType entityHostType = entity->getEntityHostType();
-        properties.setEntityHostType(entityHostType);
-        if (entityHostType == entity::HostType::LOCAL) {
-            properties.setCollisionless(true);
-        }
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+            // set these to make EntityItemProperties::getScalesWithParent() work correctly
+            entity::HostType entityHostType = entity->getEntityHostType();
+            editProperties.setEntityHostType(entityHostType);
+            if (entityHostType == entity::HostType::LOCAL) {
+                editProperties.setCollisionless(true);
+            }
+            editProperties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        // make sure the properties has a type, so that the encode can know which properties to include
-        properties.setType(entity->getType());
+            // make sure the properties has a type, so that the encode can know which properties to include
+            editProperties.setType(entity->getType());
 
-        previousUserdata = entity->getUserData();
-    } else if (_bidOnSimulationOwnership) {
-        // bail when simulation participants don't know about entity
-        return QUuid();
-    }
-    // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
-    // How to check for this cheaply?
+            previousUserdata = entity->getUserData();
+        } else if (_bidOnSimulationOwnership) {
+            // bail when simulation participants don't know about entity
+            edit.failed = true;
+            continue;
+        }
+        // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
+        // How to check for this cheaply?
 
-    properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
-    synchronizeEditedGrabProperties(properties, previousUserdata);
-    properties.setLastEditedBy(sessionID);
+        editProperties = convertPropertiesFromScriptSemantics(editProperties, editProperties.getScalesWithParent());
+        synchronizeEditedGrabProperties(editProperties, previousUserdata);
+        editProperties.setLastEditedBy(sessionID);
+        edit.hasQueryAACubeRelatedChanges = editProperties.queryAACubeRelatedPropertyChanged();
+    }
 
     // done reading and modifying properties --> start write
-    bool updatedEntity = false;
     _entityTree->withWriteLock([&] {
-        updatedEntity = _entityTree->updateEntity(entityID, properties);
+        for (int i = 0; i < numEdits; ++i) {
+            if (!edits[i].failed) {
+                _entityTree->updateEntity(edits[i].entityID, properties[i]);
+            }
+        }
     });
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
@@ -900,27 +1104,34 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     //     return QUuid();
     // }
 
-    bool hasQueryAACubeRelatedChanges = properties.queryAACubeRelatedPropertyChanged();
     // done writing, send update
     _entityTree->withReadLock([&] {
-        // find the entity again: maybe it was removed since we last found it
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            uint64_t now = usecTimestampNow();
-            entity->setLastBroadcast(now);
+        uint64_t now = usecTimestampNow();
+        for (int i = 0; i < numEdits; ++i) {
+            auto& edit = edits[i];
+            if (edit.failed) {
+                continue;
+            }
+            // find the entity again: maybe it was removed since we last found it
+            edit.entity = _entityTree->findEntityByEntityItemID(edit.entityID);
+            if (!edit.entity) {
+                continue;
+            }
+            edit.entity->setLastBroadcast(now);
 
-            if (hasQueryAACubeRelatedChanges) {
-                properties.setQueryAACube(entity->getQueryAACube());
+            EntityItemProperties& editProperties = properties[i];
+            if (edit.hasQueryAACubeRelatedChanges) {
+                editProperties.setQueryAACube(edit.entity->getQueryAACube());
 
                 // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
                 // if they've changed.
-                entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                edit.entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
                     if (descendant->getNestableType() == NestableType::Entity) {
                         if (descendant->updateQueryAACube()) {
                             EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
                             EntityItemProperties newQueryCubeProperties;
                             newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                            newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                            newQueryCubeProperties.setLastEdited(editProperties.getLastEdited());
                             queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
                             entityDescendant->setLastBroadcast(now);
                         }
@@ -929,51 +1140,61 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
             }
         }
     });
-    if (!entity) {
-        if (hasQueryAACubeRelatedChanges) {
-            // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
-            // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
-            // This is because, on the script side, "position" is in world frame, but in the network
-            // protocol and in the internal data-structures, "position" is "relative to parent".
-            // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
-            if (properties.localPositionChanged()) {
-                properties.setPosition(properties.getLocalPosition());
-            }
-            if (properties.localRotationChanged()) {
-                properties.setRotation(properties.getLocalRotation());
-            }
-            if (properties.localVelocityChanged()) {
-                properties.setVelocity(properties.getLocalVelocity());
-            }
-            if (properties.localAngularVelocityChanged()) {
-                properties.setAngularVelocity(properties.getLocalAngularVelocity());
-            }
-            if (properties.localDimensionsChanged()) {
-                properties.setDimensions(properties.getLocalDimensions());
+
+    for (int i = 0; i < numEdits; ++i) {
+        auto& edit = edits[i];
+        if (edit.failed) {
+            results[i] = QUuid();
+            continue;
+        }
+        EntityItemProperties& editProperties = properties[i];
+        if (!edit.entity) {
+            if (edit.hasQueryAACubeRelatedChanges) {
+                // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
+                // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
+                // This is because, on the script side, "position" is in world frame, but in the network
+                // protocol and in the internal data-structures, "position" is "relative to parent".
+                // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
+                if (editProperties.localPositionChanged()) {
+                    editProperties.setPosition(editProperties.getLocalPosition());
+                }
+                if (editProperties.localRotationChanged()) {
+                    editProperties.setRotation(editProperties.getLocalRotation());
+                }
+                if (editProperties.localVelocityChanged()) {
+                    editProperties.setVelocity(editProperties.getLocalVelocity());
+                }
+                if (editProperties.localAngularVelocityChanged()) {
+                    editProperties.setAngularVelocity(editProperties.getLocalAngularVelocity());
+                }
+                if (editProperties.localDimensionsChanged()) {
+                    editProperties.setDimensions(editProperties.getLocalDimensions());
+                }
             }
-        }
-        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
-        // print a warning and don't send an edit packet to the entity-server.
-        QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
-        if (parentFinder) {
-            bool success;
-            auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
-            if (success) {
-                auto nestable = nestableWP.lock();
-                if (nestable) {
-                    NestableType nestableType = nestable->getNestableType();
-                    if (nestableType == NestableType::Avatar) {
-                        qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
-                        return QUuid(); // null script value to indicate failure
+            // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
+            // print a warning and don't send an edit packet to the entity-server.
+            QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
+            if (parentFinder) {
+                bool success;
+                auto nestableWP = parentFinder->find(entityIDs[i], success, static_cast<SpatialParentTree*>(_entityTree.get()));
+                if (success) {
+                    auto nestable = nestableWP.lock();
+                    if (nestable) {
+                        NestableType nestableType = nestable->getNestableType();
+                        if (nestableType == NestableType::Avatar) {
+                            qCWarning(entities) << "attempted edit on non-entity: " << entityIDs[i] << nestable->getName();
+                            results[i] = QUuid(); // null script value to indicate failure
+                            continue;
+                        }
                     }
                 }
             }
         }
+        // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
+        // to edit entities they know only by ID.
+        queueEntityMessage(PacketType::EntityEdit, edit.entityID, editProperties);
     }
-    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
-    // to edit entities they know only by ID.
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return results;
 }
 
 void EntityScriptingInterface::deleteEntity(const QUuid& id) {
@@ -1287,6 +1508,14 @@ RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionVecto
     return evalRayIntersectionWorker(ray, Octree::Lock, searchFilter, entityIdsToInclude, entityIdsToDiscard);
 }
 
+void EntityScriptingInterface::evalRayIntersectionVectors(std::vector<EntityTree::RayQuery>& queries) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    if (_entityTree) {
+        _entityTree->evalRayIntersections(queries, Octree::Lock);
+    }
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard) const {
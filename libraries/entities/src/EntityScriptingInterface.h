@@ -190,6 +190,7 @@ public:
 
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
+    void evalRayIntersectionVectors(std::vector<EntityTree::RayQuery>& queries);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
@@ -212,6 +213,59 @@ public:
     static QScriptValue getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine);
     QScriptValue getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties);
 
+    /*@jsdoc
+     * Gets numeric properties of multiple entities packed into typed arrays, one array per property with the values of the
+     * entities in the order of their IDs. This skips making an {@link Entities.EntityProperties} object per entity, so is
+     * much faster than {@link Entities.getMultipleEntityProperties|getMultipleEntityProperties} for many entities.
+     * <p>The properties that can be packed are <code>"position"</code>, <code>"rotation"</code>, <code>"velocity"</code>,
+     * <code>"angularVelocity"</code>, <code>"localPosition"</code>, <code>"localRotation"</code>,
+     * <code>"localVelocity"</code>, <code>"dimensions"</code>, <code>"registrationPoint"</code>, <code>"gravity"</code>,
+     * <code>"acceleration"</code>, <code>"density"</code>, <code>"friction"</code>, <code>"restitution"</code>,
+     * <code>"damping"</code>, <code>"angularDamping"</code> and <code>"lifetime"</code>. Other names are ignored.</p>
+     * @function Entities.getMultipleEntityPropertyArrays
+     * @param {Uuid[]} entityIDs - The IDs of the entities to get the properties of.
+     * @param {string[]|string} desiredProperties - The name or names of the properties to get.
+     * @returns {Object<string, Float32Array>} A <code>Float32Array</code> per property, with 3 values per entity for a 
+     *     {@link Vec3}, 4 (<code>x, y, z, w</code>) for a {@link Quat} and 1 for a number. The values of an entity that can't 
+     *     be found are <code>NaN</code>.
+     * @example <caption>Report the nearby entity that is highest.</caption>
+     * var SEARCH_RADIUS = 50; // meters
+     * var entityIDs = Entities.findEntities(MyAvatar.position, SEARCH_RADIUS);
+     * var positions = Entities.getMultipleEntityPropertyArrays(entityIDs, "position").position;
+     * var highest = -1;
+     * for (var i = 0; i < entityIDs.length; i++) {
+     *     if (highest === -1 || positions[3 * i + 1] > positions[3 * highest + 1]) {
+     *         highest = i;
+     *     }
+     * }
+     * print("Highest entity: " + (highest !== -1 ? entityIDs[highest] : "none"));
+     */
+    static QScriptValue getMultipleEntityPropertyArrays(QScriptContext* context, QScriptEngine* engine);
+    QScriptValue getMultipleEntityPropertyArraysInternal(QScriptEngine* engine, const QVector<QUuid>& entityIDs,
+                                                         const QStringList& desiredProperties);
+
+    /*@jsdoc
+     * Edits multiple entities. The entities are looked up and updated under one lock each, and their edits sent together, 
+     * which is much faster than calling {@link Entities.editEntity|editEntity} for each.
+     * @function Entities.editMultipleEntities
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Entities.EntityProperties|Entities.EntityProperties[]} properties - The properties to update, either the same 
+     *     for all the entities or one set per entity in the order of their IDs.
+     * @returns {Uuid[]} The ID of each entity, or <code>null</code> in place of one that couldn't be edited, as
+     *     {@link Entities.editEntity|editEntity} returns.
+     * @example <caption>Lift the nearby entities.</caption>
+     * var SEARCH_RADIUS = 10; // meters
+     * var entityIDs = Entities.findEntities(MyAvatar.position, SEARCH_RADIUS);
+     * var positions = Entities.getMultipleEntityPropertyArrays(entityIDs, "position").position;
+     * var edits = [];
+     * for (var i = 0; i < entityIDs.length; i++) {
+     *     edits.push({ position: { x: positions[3 * i], y: positions[3 * i + 1] + 1, z: positions[3 * i + 2] } });
+     * }
+     * Entities.editMultipleEntities(entityIDs, edits);
+     */
+    static QScriptValue editMultipleEntities(QScriptContext* context, QScriptEngine* engine);
+    QVector<QUuid> editMultipleEntitiesInternal(const QVector<QUuid>& entityIDs, QVector<EntityItemProperties> properties);
+
     QUuid addEntityInternal(const EntityItemProperties& properties, entity::HostType entityHostType);
 
 public slots:
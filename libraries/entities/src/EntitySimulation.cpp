@@ -11,6 +11,10 @@
 
 #include "EntitySimulation.h"
 
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentMap>
+
 #include <AACube.h>
 #include <Profile.h>
 
@@ -21,7 +25,10 @@ void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _entitiesToSort.clear();
         _simpleKinematicEntities.clear();
-        _changedEntities.clear();
+        {
+            std::lock_guard<std::mutex> changedLock(_changedEntitiesMutex);
+            _changedEntities.clear();
+        }
         _entitiesToUpdate.clear();
         _mortalEntities.clear();
         _nextExpiry = std::numeric_limits<uint64_t>::max();
@@ -170,21 +177,34 @@ void EntitySimulation::addEntity(EntityItemPointer entity) {
     entity->clearDirtyFlags();
 }
 
-void EntitySimulation::changeEntity(EntityItemPointer entity) {
+void EntitySimulation::addEntities(const std::vector<EntityItemPointer>& entities) {
     QMutexLocker lock(&_mutex);
+    for (const auto& entity : entities) {
+        assert(entity);
+        addEntityToInternalLists(entity);
+        entity->clearDirtyFlags();
+    }
+}
+
+void EntitySimulation::changeEntity(EntityItemPointer entity) {
     assert(entity);
+    std::lock_guard<std::mutex> changedLock(_changedEntitiesMutex);
     _changedEntities.insert(entity);
 }
 
 void EntitySimulation::processChangedEntities() {
     QMutexLocker lock(&_mutex);
-    PROFILE_RANGE_EX(simulation_physics, "processChangedEntities", 0xffff00ff, (uint64_t)_changedEntities.size());
-    for (auto& entity : _changedEntities) {
+    std::unordered_set<EntityItemPointer> changedEntities;
+    {
+        std::lock_guard<std::mutex> changedLock(_changedEntitiesMutex);
+        changedEntities.swap(_changedEntities);
+    }
+    PROFILE_RANGE_EX(simulation_physics, "processChangedEntities", 0xffff00ff, (uint64_t)changedEntities.size());
+    for (auto& entity : changedEntities) {
         if (entity->isSimulated()) {
             processChangedEntity(entity);
         }
     }
-    _changedEntities.clear();
 }
 
 void EntitySimulation::processChangedEntity(const EntityItemPointer& entity) {
@@ -217,7 +237,10 @@ void EntitySimulation::clearEntities() {
     QMutexLocker lock(&_mutex);
     _entitiesToSort.clear();
     _simpleKinematicEntities.clear();
-    _changedEntities.clear();
+    {
+        std::lock_guard<std::mutex> changedLock(_changedEntitiesMutex);
+        _changedEntities.clear();
+    }
     _allEntities.clear();
     _deadEntitiesToRemoveFromTree.clear();
     _entitiesToUpdate.clear();
@@ -225,12 +248,19 @@ void EntitySimulation::clearEntities() {
     _nextExpiry = std::numeric_limits<uint64_t>::max();
 }
 
-void EntitySimulation::moveSimpleKinematics(uint64_t now) {
-    PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
-    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
-    while (itemItr != _simpleKinematicEntities.end()) {
-        EntityItemPointer entity = *itemItr;
+namespace {
+    // below this many the threads cost more than they save
+    const int MIN_PARALLEL_KINEMATIC_ENTITIES = 256;
+    const int KINEMATIC_ENTITIES_PER_BATCH = 64;
+
+    enum class KinematicStep {
+        Moved,   // keep moving it and re-sort it
+        Stopped, // re-sort it one last time
+        Dropped  // stop moving it
+    };
 
+    // only touches the entity itself, and its ancestors when reading its world frame
+    KinematicStep stepSimpleKinematicEntity(const EntityItemPointer& entity, uint64_t now) {
         // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
         // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
         bool ancestryIsKnown;
@@ -243,21 +273,84 @@ void EntitySimulation::moveSimpleKinematics(uint64_t now) {
             if (ancestryIsKnown && !hasAvatarAncestor) {
                 entity->updateQueryAACube();
             }
+            return KinematicStep::Moved;
+        }
+        if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
+            // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
+            // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
+            entity->updateQueryAACube();
+            return KinematicStep::Stopped;
+        }
+        return KinematicStep::Dropped;
+    }
+}
+
+void EntitySimulation::moveSimpleKinematics(uint64_t now) {
+    PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+    if (_parallelKinematicsEnabled && _simpleKinematicEntities.size() >= MIN_PARALLEL_KINEMATIC_ENTITIES) {
+        moveSimpleKinematicsInParallel(now);
+        return;
+    }
+
+    SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
+    while (itemItr != _simpleKinematicEntities.end()) {
+        EntityItemPointer entity = *itemItr;
+        KinematicStep step = stepSimpleKinematicEntity(entity, now);
+        if (step != KinematicStep::Dropped) {
             _entitiesToSort.insert(entity);
+        }
+        if (step == KinematicStep::Moved) {
             ++itemItr;
         } else {
-            if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
-                // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
-                // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
-                entity->updateQueryAACube();
-                _entitiesToSort.insert(entity);
-            }
             // the entity is no longer non-physical-kinematic
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
 }
 
+void EntitySimulation::moveSimpleKinematicsInParallel(uint64_t now) {
+    // entities without a parent or children don't read or write each other, so those can be stepped at the same time;
+    // the others are stepped here one family member at a time as before
+    std::vector<EntityItemPointer> independentEntities;
+    std::vector<EntityItemPointer> relatedEntities;
+    independentEntities.reserve(_simpleKinematicEntities.size());
+    foreach (const EntityItemPointer& entity, _simpleKinematicEntities) {
+        if (entity->getParentID().isNull() && !entity->hasChildren()) {
+            independentEntities.push_back(entity);
+        } else {
+            relatedEntities.push_back(entity);
+        }
+    }
+
+    std::vector<KinematicStep> steps(independentEntities.size());
+    std::vector<size_t> batchStarts;
+    for (size_t start = 0; start < independentEntities.size(); start += KINEMATIC_ENTITIES_PER_BATCH) {
+        batchStarts.push_back(start);
+    }
+    QtConcurrent::blockingMap(batchStarts, [&](size_t start) {
+        size_t end = std::min(start + KINEMATIC_ENTITIES_PER_BATCH, independentEntities.size());
+        for (size_t i = start; i < end; ++i) {
+            steps[i] = stepSimpleKinematicEntity(independentEntities[i], now);
+        }
+    });
+
+    auto applyStep = [&](const EntityItemPointer& entity, KinematicStep step) {
+        if (step != KinematicStep::Dropped) {
+            _entitiesToSort.insert(entity);
+        }
+        if (step != KinematicStep::Moved) {
+            // the entity is no longer non-physical-kinematic
+            _simpleKinematicEntities.remove(entity);
+        }
+    };
+    for (size_t i = 0; i < independentEntities.size(); ++i) {
+        applyStep(independentEntities[i], steps[i]);
+    }
+    for (const auto& entity : relatedEntities) {
+        applyStep(entity, stepSimpleKinematicEntity(entity, now));
+    }
+}
+
 void EntitySimulation::processDeadEntities() {
     if (_deadEntitiesToRemoveFromTree.empty()) {
         return;
@@ -13,6 +13,7 @@
 #define hifi_EntitySimulation_h
 
 #include <limits>
+#include <mutex>
 #include <unordered_set>
 
 #include <QtCore/QObject>
@@ -64,6 +65,8 @@ public:
     /// \param entity pointer to EntityItem to be added
     /// \sideeffect sets relevant backpointers in entity, but maybe later when appropriate data structures are locked
     void addEntity(EntityItemPointer entity);
+    /// \param entities EntityItems to be added, as for addEntity() but locking once for all of them
+    void addEntities(const std::vector<EntityItemPointer>& entities);
 
     /// \param entity pointer to EntityItem that may have changed in a way that would affect its simulation
     /// call this whenever an entity was changed from some EXTERNAL event (NOT by the EntitySimulation itself)
@@ -73,6 +76,10 @@ public:
 
     void moveSimpleKinematics(uint64_t now);
 
+    /// moves the simple kinematic entities that have no parent or children on several threads, for simulations with
+    /// many of them; the tree is still re-sorted in one pass afterwards
+    void setParallelKinematicsEnabled(bool enabled) { _parallelKinematicsEnabled = enabled; }
+
     EntityTreePointer getEntityTree() { return _entityTree; }
 
     virtual void prepareEntityForDelete(EntityItemPointer entity);
@@ -98,14 +105,17 @@ protected:
 
 private:
     void moveSimpleKinematics();
+    void moveSimpleKinematicsInParallel(uint64_t now);
 
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
+    std::mutex _changedEntitiesMutex; // changeEntity() can be called while moving kinematic entities in parallel
     std::unordered_set<EntityItemPointer> _changedEntities; // all changes this frame
     SetOfEntities _allEntities; // tracks all entities added the simulation
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
     SetOfEntities _mortalEntities; // entities that have an expiry
     uint64_t _nextExpiry;
+    bool _parallelKinematicsEnabled { false };
 
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
@@ -11,8 +11,16 @@
 //
 
 #include "EntityTree.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <QtConcurrent/QtConcurrentMap>
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -29,6 +37,9 @@
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
+#include <OctreeBinaryFile.h>
+#include <OctreeEntitiesFileParser.h>
+#include <UUIDHasher.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -42,6 +53,12 @@
 #include "LogHandler.h"
 #include "EntityEditFilters.h"
 #include "EntityDynamicFactoryInterface.h"
+#include "ZoneEntityItem.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include <emmintrin.h>
+#define HIFI_SSE2_RAY_BATCH
+#endif
 
 static const quint64 DELETED_ENTITIES_EXTRA_USECS_TO_CONSIDER = USECS_PER_MSEC * 50;
 const float EntityTree::DEFAULT_MAX_TMP_ENTITY_LIFETIME = 60 * 60; // 1 hour
@@ -67,6 +84,28 @@ EntityTree::~EntityTree() {
     //eraseAllOctreeElements(false); // KEEP THIS
 }
 
+bool EntityTree::isInOwnedRegion(const EntityItemProperties& properties) const {
+    // a child is where its parent is, which is the parent's server's business
+    if (!_hasOwnedRegion || !properties.getParentID().isNull()) {
+        return true;
+    }
+    return _ownedRegion.contains(properties.getPosition());
+}
+
+bool EntityTree::isEditInOwnedRegion(const EntityItemPointer& entity, const EntityItemProperties& properties) const {
+    if (!_hasOwnedRegion || (!properties.positionChanged() && !properties.parentIDChanged())) {
+        return true;
+    }
+    QUuid parentID = properties.parentIDChanged() ? properties.getParentID() : entity->getParentID();
+    if (!parentID.isNull()) {
+        return true;
+    }
+    // a top-level entity's position is in the world frame
+    bool success;
+    glm::vec3 position = properties.positionChanged() ? properties.getPosition() : entity->getWorldPosition(success);
+    return _ownedRegion.contains(position);
+}
+
 void EntityTree::setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist) { 
     _entityScriptSourceWhitelist = entityScriptSourceWhitelist.split(',', Qt::SkipEmptyParts);
 }
@@ -94,8 +133,8 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
         QHash<EntityItemID, EntityItemPointer> savedEntities;
         // NOTE: lock the Tree first, then lock the _entityMap.
         // It should never be done the other way around.
-        QReadLocker locker(&_entityMapLock);
-        foreach(EntityItemPointer entity, _entityMap) {
+        QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.toHash();
+        foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
             if (element) {
                 element->cleanupDomainAndNonOwnedEntities();
@@ -112,7 +151,15 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
                 }
             }
         }
-        _entityMap.swap(savedEntities);
+        for (auto i = localMap.cbegin(); i != localMap.cend(); ++i) {
+            if (!savedEntities.contains(i.key())) {
+                _entityMap.remove(i.key());
+            }
+        }
+        _zoneIndex.clear();
+        foreach(EntityItemPointer entity, savedEntities) {
+            addToZoneIndex(entity);
+        }
     });
 
     resetClientEditStats();
@@ -139,8 +186,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     if (_simulation) {
         _simulation->clearEntities();
     }
-    QHash<EntityItemID, EntityItemPointer> localMap;
-    localMap.swap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.takeAll();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -158,6 +204,8 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    _spatialIndex.clear();
+    _zoneIndex.clear();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -304,7 +352,10 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
         addToNeedsParentFixupList(entity);
     }
 
+    addToZoneIndex(entity);
+
     _isDirty = true;
+    journalEntityChange(entity->getEntityItemID());
 
     // find and hook up any entities with this entity as a (previously) missing parent
     fixupNeedsParentFixups();
@@ -314,11 +365,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityID);
     if (!entity) {
         return false;
     }
@@ -371,6 +418,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                     emit editingEntityPointer(entity);
                 }
                 _isDirty = true;
+                journalEntityChange(entity->getEntityItemID());
             }
         }
     } else {
@@ -506,6 +554,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
 
         _isDirty = true;
+        journalEntityChange(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -585,6 +634,176 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     return result;
 }
 
+namespace {
+    // A placement key is the path of child indexes from the root to the element an entity belongs in, three bits a level
+    // from the top down. Sorting the keys, shallower first on equal keys, puts entities in Morton order with every
+    // element's entities ahead of its children's.
+    const int BITS_PER_LEVEL = 3;
+    const int MAX_PLACEMENT_KEY_LEVELS = 64 / BITS_PER_LEVEL;
+
+    int childIndexAt(uint64_t placementKey, int level) {
+        return (int)(placementKey >> (64 - BITS_PER_LEVEL * (level + 1))) & (NUMBER_OF_CHILDREN - 1);
+    }
+
+    struct BulkPlacement {
+        uint64_t key { 0 };
+        int levels { 0 };
+        AABox box;
+        EntityItemPointer entity;
+    };
+
+    // the same choice as EntityTreeElement::bestFitBounds() at each level, worked out from the cubes alone
+    void findPlacement(const AACube& rootCube, BulkPlacement& placement) {
+        glm::vec3 minPoint = glm::clamp(placement.box.getCorner(), (float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
+        glm::vec3 maxPoint = glm::clamp(placement.box.calcTopFarLeft(), (float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
+        glm::vec3 corner = rootCube.getCorner();
+        float scale = rootCube.getScale();
+
+        while (placement.levels < MAX_PLACEMENT_KEY_LEVELS) {
+            float childScale = scale / 2.0f;
+            if (childScale <= SMALLEST_REASONABLE_OCTREE_ELEMENT_SCALE) {
+                break;
+            }
+            glm::vec3 center = corner + glm::vec3(childScale);
+            glm::bvec3 minHalf = glm::greaterThan(minPoint, center);
+            if (minHalf != glm::greaterThan(maxPoint, center)) {
+                break; // the box straddles our children, so it belongs here
+            }
+
+            // as in OctreeElement::getMyChildContainingPoint(), x picks left, y top and z far
+            int childIndex = (minHalf.x ? 4 : 0) | (minHalf.y ? 2 : 0) | (minHalf.z ? 1 : 0);
+            placement.key |= (uint64_t)childIndex << (64 - BITS_PER_LEVEL * (placement.levels + 1));
+            corner += childScale * glm::vec3(minHalf);
+            scale = childScale;
+            ++placement.levels;
+        }
+    }
+}
+
+std::vector<EntityItemPointer> EntityTree::addEntitiesBulk(const std::vector<BulkEntity>& bulkEntities, bool isClone,
+                                                           const bool isImport) {
+    std::vector<EntityItemPointer> addedEntities;
+    if (bulkEntities.empty()) {
+        return addedEntities;
+    }
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (!nodeList) {
+        qCDebug(entities) << "EntityTree::addEntitiesBulk -- can't get NodeList";
+        return addedEntities;
+    }
+    bool canRez = !getIsClient() || nodeList->getThisNodeCanRez() || nodeList->getThisNodeCanRezTmp() ||
+        nodeList->getThisNodeCanRezCertified() || nodeList->getThisNodeCanRezTmpCertified() ||
+        _serverlessDomain || isClone || isImport;
+
+    // construct them all first, as addEntity() would
+    std::vector<BulkPlacement> placements;
+    placements.reserve(bulkEntities.size());
+    std::unordered_set<QUuid> entityIDs;
+    AACube rootCube = _rootElement->getAACube();
+    for (const auto& bulkEntity : bulkEntities) {
+        const EntityItemProperties& properties = bulkEntity.properties;
+        if (properties.getEntityHostType() == entity::HostType::DOMAIN && !canRez) {
+            continue;
+        }
+
+        // You should not call this on existing entities that are already part of the tree! Call updateEntity()
+        if (getContainingElement(bulkEntity.id) || !entityIDs.insert(bulkEntity.id).second) {
+            qCWarning(entities) << "EntityTree::addEntitiesBulk() on existing entity item with entityID=" << bulkEntity.id;
+            continue;
+        }
+
+        EntityItemPointer entity = EntityTypes::constructEntityItem(properties.getType(), bulkEntity.id, properties);
+        if (!entity) {
+            continue;
+        }
+        if (properties.getCreated() == UNKNOWN_CREATED_TIME) {
+            entity->recordCreationTime();
+        }
+
+        BulkPlacement placement;
+        bool success;
+        placement.box = entity->getQueryAACube(success).clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE);
+        placement.entity = entity;
+        findPlacement(rootCube, placement);
+        placements.push_back(placement);
+    }
+
+    std::sort(placements.begin(), placements.end(), [](const BulkPlacement& a, const BulkPlacement& b) {
+        return a.key < b.key || (a.key == b.key && a.levels < b.levels);
+    });
+
+    // the elements from the root to the last entity's, kept while the next entity's path shares them
+    std::vector<EntityTreeElementPointer> path { std::static_pointer_cast<EntityTreeElement>(_rootElement) };
+    path.front()->markWithChangedTime();
+    uint64_t pathKey = 0;
+    addedEntities.reserve(placements.size());
+    for (const auto& placement : placements) {
+        int sharedLevels = 0;
+        int pathLevels = (int)path.size() - 1;
+        while (sharedLevels < pathLevels && sharedLevels < placement.levels
+               && childIndexAt(pathKey, sharedLevels) == childIndexAt(placement.key, sharedLevels)) {
+            ++sharedLevels;
+        }
+        path.resize(sharedLevels + 1);
+        pathKey = placement.key;
+
+        while ((int)path.size() - 1 < placement.levels) {
+            int childIndex = childIndexAt(placement.key, (int)path.size() - 1);
+            EntityTreeElementPointer child = path.back()->getChildAtIndex(childIndex);
+            if (!child) {
+                child = std::static_pointer_cast<EntityTreeElement>(path.back()->addChildAtIndex(childIndex));
+            }
+            child->markWithChangedTime();
+            path.push_back(child);
+        }
+
+        // past the depth a key holds, or where rounding of the cubes disagrees, finish as AddEntityOperator would
+        EntityTreeElementPointer element = path.back();
+        while (!element->bestFitBounds(placement.box)) {
+            int childIndex = element->getMyChildContaining(placement.box);
+            if (childIndex == OctreeElement::CHILD_UNKNOWN) {
+                break;
+            }
+            EntityTreeElementPointer child = element->getChildAtIndex(childIndex);
+            if (!child) {
+                child = std::static_pointer_cast<EntityTreeElement>(element->addChildAtIndex(childIndex));
+            }
+            child->markWithChangedTime();
+            element = child;
+        }
+
+        addEntityMapEntry(placement.entity);
+        element->addEntityItem(placement.entity);
+        addedEntities.push_back(placement.entity);
+    }
+
+    // the same as postAddEntity(), a step at a time for all of them
+    if (getIsServer()) {
+        for (const auto& entity : addedEntities) {
+            addCertifiedEntityOnServer(entity);
+        }
+    }
+    if (_simulation) {
+        _simulation->addEntities(addedEntities);
+    }
+    for (const auto& entity : addedEntities) {
+        if (!entity->getParentID().isNull()) {
+            addToNeedsParentFixupList(entity);
+        }
+        addToZoneIndex(entity);
+        journalEntityChange(entity->getEntityItemID());
+    }
+    if (!addedEntities.empty()) {
+        _isDirty = true;
+    }
+    fixupNeedsParentFixups();
+    for (const auto& entity : addedEntities) {
+        emit addingEntity(entity->getEntityItemID());
+        emit addingEntityPointer(entity.get());
+    }
+    return addedEntities;
+}
+
 void EntityTree::emitEntityScriptChanging(const EntityItemID& entityItemID, bool reload) {
     emit entityScriptChanging(entityItemID, reload);
 }
@@ -686,11 +905,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
             std::vector<EntityItemPointer> entitiesToDelete;
             entitiesToDelete.reserve(ids.size());
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     recursivelyFilterAndCollectForDelete(entity, entitiesToDelete, force);
                 }
@@ -706,11 +921,7 @@ void EntityTree::deleteEntitiesByID(const std::vector<EntityItemID>& ids, bool f
         QUuid sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
         withWriteLock([&] {
             for (auto id : ids) {
-                EntityItemPointer entity;
-                {
-                    QReadLocker locker(&_entityMapLock);
-                    entity = _entityMap.value(id);
-                }
+                EntityItemPointer entity = _entityMap.value(id);
                 if (entity) {
                     if (entity->isDomainEntity()) {
                         // domain-entity deletes must round-trip through entity-server
@@ -745,6 +956,10 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
     for (auto entity : entities) {
         if (entity->getElement()) {
             theOperator.addEntityToDeleteList(entity);
+            journalEntityChange(entity->getEntityItemID(), true);
+            if (entity->getType() == EntityTypes::Zone) {
+                _zoneIndex.removeZone(entity->getEntityItemID());
+            }
             emit deletingEntity(entity->getID());
             emit deletingEntityPointer(entity.get());
         }
@@ -754,6 +969,9 @@ void EntityTree::deleteEntitiesByPointer(const std::vector<EntityItemPointer>& e
         recurseTreeWithOperator(&theOperator);
         processRemovedEntities(theOperator);
         _isDirty = true;
+
+        // don't let the send threads pick up a snapshot that still lists what was just deleted
+        std::atomic_store(&_topologySnapshot, EntityTreeSnapshotPointer());
     }
 }
 
@@ -875,6 +1093,184 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
     return args.entityID;
 }
 
+// The rays of a batched query in structure of arrays form, for the slab tests against the element cubes
+class RayBatch {
+public:
+    static const size_t LANE_COUNT = 4;
+
+    RayBatch(std::vector<EntityTree::RayQuery>& rayQueries, const glm::vec3& frustumPos) :
+        queries(rayQueries),
+        viewFrustumPos(frustumPos)
+    {
+        size_t numRays = queries.size();
+        originX.resize(numRays);
+        originY.resize(numRays);
+        originZ.resize(numRays);
+        invDirectionX.resize(numRays);
+        invDirectionY.resize(numRays);
+        invDirectionZ.resize(numRays);
+        distance.resize(numRays);
+        for (size_t i = 0; i < numRays; i++) {
+            auto& query = queries[i];
+            query.entityID = EntityItemID();
+            query.distance = FLT_MAX;
+            originX[i] = query.origin.x;
+            originY[i] = query.origin.y;
+            originZ[i] = query.origin.z;
+            // FLT_MAX rather than infinity so the axis parallel rays never make NaNs
+            invDirectionX[i] = query.direction.x == 0.0f ? FLT_MAX : 1.0f / query.direction.x;
+            invDirectionY[i] = query.direction.y == 0.0f ? FLT_MAX : 1.0f / query.direction.y;
+            invDirectionZ[i] = query.direction.z == 0.0f ? FLT_MAX : 1.0f / query.direction.z;
+            distance[i] = FLT_MAX;
+        }
+    }
+
+    std::vector<EntityTree::RayQuery>& queries;
+    glm::vec3 viewFrustumPos;
+    std::vector<float> originX;
+    std::vector<float> originY;
+    std::vector<float> originZ;
+    std::vector<float> invDirectionX;
+    std::vector<float> invDirectionY;
+    std::vector<float> invDirectionZ;
+    std::vector<float> distance;
+};
+
+#ifdef HIFI_SSE2_RAY_BATCH
+
+// hits gets the rays that enter the cube before their nearest intersection yet
+static void findCubeHits(const AACube& cube, const RayBatch& batch, const std::vector<uint32_t>& rays, std::vector<uint32_t>& hits) {
+    hits.clear();
+    const glm::vec3 minCorner = cube.getCorner();
+    const glm::vec3 maxCorner = minCorner + glm::vec3(cube.getScale());
+    const __m128 minX = _mm_set1_ps(minCorner.x);
+    const __m128 minY = _mm_set1_ps(minCorner.y);
+    const __m128 minZ = _mm_set1_ps(minCorner.z);
+    const __m128 maxX = _mm_set1_ps(maxCorner.x);
+    const __m128 maxY = _mm_set1_ps(maxCorner.y);
+    const __m128 maxZ = _mm_set1_ps(maxCorner.z);
+    const __m128 zero = _mm_setzero_ps();
+
+    const size_t numRays = rays.size();
+    for (size_t i = 0; i < numRays; i += RayBatch::LANE_COUNT) {
+        // the last lanes repeat the last ray
+        uint32_t lanes[RayBatch::LANE_COUNT];
+        for (size_t lane = 0; lane < RayBatch::LANE_COUNT; lane++) {
+            lanes[lane] = rays[std::min(i + lane, numRays - 1)];
+        }
+        auto gather = [&](const std::vector<float>& values) {
+            return _mm_setr_ps(values[lanes[0]], values[lanes[1]], values[lanes[2]], values[lanes[3]]);
+        };
+
+        const __m128 originX = gather(batch.originX);
+        const __m128 invDirectionX = gather(batch.invDirectionX);
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(minX, originX), invDirectionX);
+        __m128 t2 = _mm_mul_ps(_mm_sub_ps(maxX, originX), invDirectionX);
+        __m128 tNear = _mm_min_ps(t1, t2);
+        __m128 tFar = _mm_max_ps(t1, t2);
+
+        const __m128 originY = gather(batch.originY);
+        const __m128 invDirectionY = gather(batch.invDirectionY);
+        t1 = _mm_mul_ps(_mm_sub_ps(minY, originY), invDirectionY);
+        t2 = _mm_mul_ps(_mm_sub_ps(maxY, originY), invDirectionY);
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+        tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+
+        const __m128 originZ = gather(batch.originZ);
+        const __m128 invDirectionZ = gather(batch.invDirectionZ);
+        t1 = _mm_mul_ps(_mm_sub_ps(minZ, originZ), invDirectionZ);
+        t2 = _mm_mul_ps(_mm_sub_ps(maxZ, originZ), invDirectionZ);
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+        tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+
+        // the rays starting inside the cube enter it at zero
+        tNear = _mm_max_ps(tNear, zero);
+        int mask = _mm_movemask_ps(_mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmplt_ps(tNear, gather(batch.distance))));
+        for (size_t lane = 0; lane < RayBatch::LANE_COUNT && i + lane < numRays; lane++) {
+            if ((mask >> lane) & 1) {
+                hits.push_back(lanes[lane]);
+            }
+        }
+    }
+}
+
+#else
+
+static void findCubeHits(const AACube& cube, const RayBatch& batch, const std::vector<uint32_t>& rays, std::vector<uint32_t>& hits) {
+    hits.clear();
+    const glm::vec3 minCorner = cube.getCorner();
+    const glm::vec3 maxCorner = minCorner + glm::vec3(cube.getScale());
+    for (uint32_t ray : rays) {
+        glm::vec3 origin(batch.originX[ray], batch.originY[ray], batch.originZ[ray]);
+        glm::vec3 invDirection(batch.invDirectionX[ray], batch.invDirectionY[ray], batch.invDirectionZ[ray]);
+        glm::vec3 t1 = (minCorner - origin) * invDirection;
+        glm::vec3 t2 = (maxCorner - origin) * invDirection;
+        float tNear = glm::max(glm::compMax(glm::min(t1, t2)), 0.0f);
+        float tFar = glm::compMin(glm::max(t1, t2));
+        if (tNear <= tFar && tNear < batch.distance[ray]) {
+            hits.push_back(ray);
+        }
+    }
+}
+
+#endif
+
+static void evalRayIntersectionsInElement(const EntityTreeElementPointer& element, RayBatch& batch, const std::vector<uint32_t>& rays) {
+    std::vector<uint32_t> hits;
+    findCubeHits(element->getAACube(), batch, rays, hits);
+    if (hits.empty()) {
+        return;
+    }
+
+    for (uint32_t ray : hits) {
+        auto& query = batch.queries[ray];
+        OctreeElementPointer intersectedElement;
+        EntityItemID entityID = element->evalRayIntersection(query.origin, query.direction, batch.viewFrustumPos,
+            intersectedElement, query.distance, query.face, query.surfaceNormal, query.entityIdsToInclude,
+            query.entityIdsToDiscard, query.searchFilter, query.extraInfo);
+        if (!entityID.isNull()) {
+            query.entityID = entityID;
+            batch.distance[ray] = query.distance;
+        }
+    }
+
+    // the children nearer to the rays go first, so their intersections cull the farther ones
+    const auto& firstQuery = batch.queries[hits[0]];
+    std::vector<std::pair<float, EntityTreeElementPointer>> children;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        auto child = std::static_pointer_cast<EntityTreeElement>(element->getChildAtIndex(i));
+        if (child) {
+            float along = glm::dot(child->getAACube().calcCenter() - firstQuery.origin, firstQuery.direction);
+            children.emplace_back(along, child);
+        }
+    }
+    std::sort(children.begin(), children.end(), [](const std::pair<float, EntityTreeElementPointer>& a,
+                                                   const std::pair<float, EntityTreeElementPointer>& b) {
+        return a.first < b.first;
+    });
+    for (const auto& child : children) {
+        evalRayIntersectionsInElement(child.second, batch, hits);
+    }
+}
+
+void EntityTree::evalRayIntersections(std::vector<RayQuery>& queries, Octree::lockType lockType, bool* accurateResult) {
+    RayBatch batch(queries, BillboardModeHelpers::getPrimaryViewFrustumPosition());
+    std::vector<uint32_t> rays(queries.size());
+    std::iota(rays.begin(), rays.end(), 0);
+
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&] {
+        auto root = std::static_pointer_cast<EntityTreeElement>(getRoot());
+        if (root && !rays.empty()) {
+            evalRayIntersectionsInElement(root, batch, rays);
+        }
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult;
+    }
+}
+
 class ParabolaArgs {
 public:
     // Inputs
@@ -1007,10 +1403,51 @@ bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extra
     return false;
 }
 
+void EntityTree::setSpatialIndexEnabled(bool enabled) {
+    withWriteLock([&] {
+        _spatialIndexEnabled = enabled;
+        _spatialIndex.clear();
+        if (enabled) {
+            recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+                if (entityTreeElement->hasEntities()) {
+                    _spatialIndex.update(entityTreeElement);
+                }
+                return true;
+            });
+            qCDebug(entities) << "Spatial index enabled with" << _spatialIndex.size() << "elements";
+        }
+    });
+}
+
+void EntityTree::addToZoneIndex(const EntityItemPointer& entity) {
+    if (entity->getType() == EntityTypes::Zone) {
+        _zoneIndex.addZone(std::static_pointer_cast<ZoneEntityItem>(entity));
+    }
+}
+
+void EntityTree::evalElementsWithOperation(const EntityTreeSpatialIndex::CubeTest& test,
+                                           const RecurseOctreeOperation& operation, void* extraData) {
+    if (!_spatialIndexEnabled) {
+        recurseTreeWithOperation(operation, extraData);
+        return;
+    }
+
+    // the operation runs its own test again, which the elements found have passed, so it only evaluates their entities
+    std::vector<EntityTreeElementPointer> foundElements;
+    _spatialIndex.findElements(test, foundElements);
+    for (const auto& element : foundElements) {
+        operation(element, extraData);
+    }
+}
+
 // NOTE: assumes caller has handled locking
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
     FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
-    recurseTreeWithOperation(evalClosestEntityOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        glm::vec3 penetration;
+        return cube.findSpherePenetration(position, targetRadius, penetration);
+    }, evalClosestEntityOperation, &args);
     return args.closestEntity;
 }
 
@@ -1044,7 +1481,10 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        glm::vec3 penetration;
+        return cube.findSpherePenetration(center, radius, penetration);
+    }, evalInSphereOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1079,7 +1519,10 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        glm::vec3 penetration;
+        return cube.findSpherePenetration(center, radius, penetration);
+    }, evalInSphereWithTypeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1115,7 +1558,10 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        glm::vec3 penetration;
+        return cube.findSpherePenetration(center, radius, penetration);
+    }, evalInSphereWithNameOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1142,7 +1588,9 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    evalElementsWithOperation([&](const AACube& elementCube) {
+        return elementCube.touches(cube);
+    }, findInCubeOperation, &args);
     foundEntities.swap(args.entities);
 }
 
@@ -1170,7 +1618,9 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        return cube.touches(box);
+    }, findInBoxOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1199,7 +1649,9 @@ bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData
 void EntityTree::evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
     FindEntitiesInFrustumArgs args = { frustum, searchFilter, QVector<QUuid>() };
     // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInFrustumOperation, &args);
+    evalElementsWithOperation([&](const AACube& cube) {
+        return frustum.calculateCubeKeyholeIntersection(cube) != ViewFrustum::OUTSIDE;
+    }, findInFrustumOperation, &args);
     // swap the two lists of entity pointers instead of copy
     foundEntities.swap(args.entities);
 }
@@ -1210,11 +1662,7 @@ EntityItemPointer EntityTree::findEntityByID(const QUuid& id) const {
 }
 
 EntityItemPointer EntityTree::findEntityByEntityItemID(const EntityItemID& entityID) const {
-    EntityItemPointer foundEntity = nullptr;
-    {
-        QReadLocker locker(&_entityMapLock);
-        foundEntity = _entityMap.value(entityID);
-    }
+    EntityItemPointer foundEntity = _entityMap.value(entityID);
     if (foundEntity && !foundEntity->getElement()) {
         // special case to maintain legacy behavior:
         // if the entity is in the map but not in the tree
@@ -1410,6 +1858,90 @@ bool EntityTree::filterProperties(const EntityItemPointer& existingEntity, Entit
     return accepted;
 }
 
+void EntityTree::prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& senderNode) {
+    _prefilteredEdits.clear();
+
+    // clones are filtered with the properties of the entity they clone, which are read as they're applied
+    PacketType packetType = message.getType();
+    bool isAdd = packetType == PacketType::EntityAdd;
+    bool isPhysics = packetType == PacketType::EntityPhysics;
+    if (!getIsServer() || !(isAdd || isPhysics || packetType == PacketType::EntityEdit)) {
+        return;
+    }
+    // having (un)lock rights bypasses the filter, unless it's a physics result
+    if (!isPhysics && senderNode->isAllowedEditor()) {
+        return;
+    }
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    if (!entityEditFilters || !entityEditFilters->hasFilters()) {
+        return;
+    }
+
+    struct Edit {
+        const unsigned char* editData;
+        PrefilteredEdit prefiltered;
+        bool isValid { true };
+    };
+    std::vector<Edit> edits;
+    const unsigned char* editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+    int bytesLeft = message.getBytesLeftToRead();
+    while (bytesLeft > 0) {
+        Edit edit;
+        edit.editData = editData;
+        int processedBytes = 0;
+        if (!EntityItemProperties::decodeEntityEditPacket(editData, bytesLeft, processedBytes, edit.prefiltered.entityItemID,
+                                                          edit.prefiltered.properties) || processedBytes <= 0) {
+            // the rest are left to be filtered as they're applied
+            break;
+        }
+        edits.push_back(edit);
+        editData += processedBytes;
+        bytesLeft -= processedBytes;
+    }
+    if (edits.empty()) {
+        return;
+    }
+
+    // the filters only read the tree, so they run on the edits in parallel, each in an engine of its own
+    FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+    withReadLock([&] {
+        QtConcurrent::blockingMap(edits, [&](Edit& edit) {
+            auto& prefiltered = edit.prefiltered;
+            EntityItemPointer existingEntity;
+            if (!isAdd) {
+                existingEntity = findEntityByEntityItemID(prefiltered.entityItemID);
+                if (!existingEntity) {
+                    edit.isValid = false;
+                    return;
+                }
+            }
+            quint64 startFilter = usecTimestampNow();
+            prefiltered.allowed = filterProperties(existingEntity, prefiltered.properties, prefiltered.properties,
+                                                   prefiltered.wasChanged, filterType);
+            prefiltered.filterTime = usecTimestampNow() - startFilter;
+        });
+    });
+
+    for (auto& edit : edits) {
+        if (edit.isValid) {
+            _prefilteredEdits[edit.editData] = std::move(edit.prefiltered);
+        }
+    }
+}
+
+bool EntityTree::takePrefilteredEdit(const unsigned char* editData, const EntityItemID& entityItemID, PrefilteredEdit& edit) {
+    auto found = _prefilteredEdits.find(editData);
+    if (found == _prefilteredEdits.end()) {
+        return false;
+    }
+    bool isSameEdit = found->second.entityItemID == entityItemID;
+    if (isSameEdit) {
+        edit = std::move(found->second);
+    }
+    _prefilteredEdits.erase(found);
+    return isSameEdit;
+}
+
 void EntityTree::bumpTimestamp(EntityItemProperties& properties) { //fixme put class/header
     const quint64 LAST_EDITED_SERVERSIDE_BUMP = 1; // usec
     // also bump up the lastEdited time of the properties so that the interface that created this edit
@@ -1942,6 +2474,46 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
             }
 
+            bool allowed = false;
+            if (validEditPacket) {
+                startFilter = usecTimestampNow();
+                bool wasChanged = false;
+                // Having (un)lock rights bypasses the filter, unless it's a physics result.
+                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+                allowed = !isPhysics && senderNode->isAllowedEditor();
+                PrefilteredEdit prefiltered;
+                if (!allowed && takePrefilteredEdit(editData, entityItemID, prefiltered)) {
+                    // filtered before the tree was locked for writing
+                    allowed = prefiltered.allowed;
+                    wasChanged = prefiltered.wasChanged;
+                    properties = prefiltered.properties;
+                    _totalFilterTime += prefiltered.filterTime;
+                } else if (!allowed) {
+                    allowed = filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+                }
+                if (allowed && existingEntity && !isAdd && !isEditInOwnedRegion(existingEntity, properties)) {
+                    // even the editors can't move an entity where another server is in charge
+                    qCDebug(entities) << "User [" << senderNode->getUUID() << "] attempted to move entity ID:"
+                        << entityItemID << "outside the region of this server";
+                    allowed = false;
+                }
+                if (!allowed) {
+                    // the update failed and we need to convey that fact to the sender
+                    // our method is to re-assert the current properties and bump the lastEdited timestamp
+                    auto timestamp = properties.getLastEdited();
+                    properties = EntityItemProperties();
+                    properties.setLastEdited(timestamp);
+                }
+                if (!allowed || wasChanged) {
+                    bumpTimestamp(properties);
+                    // For now, free ownership on any modification.
+                    properties.clearSimulationOwner();
+                }
+                endFilter = usecTimestampNow();
+            }
+
+            // the server's limits apply after the filters, which see the edit as it was sent whether or not it was
+            // filtered ahead of time
             if (!isClone) {
                 if ((isAdd || properties.lifetimeChanged()) &&
                     ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
@@ -1965,25 +2537,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             // If we got a valid edit packet, then it could be a new entity or it could be an update to
             // an existing entity... handle appropriately
             if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
-
                 if (existingEntity && !isAdd) {
 
                     if (suppressDisallowedClientScript) {
@@ -2047,6 +2600,9 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                     } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
                         failedAdd = true;
                         qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+                    } else if (!isInOwnedRegion(properties)) {
+                        failedAdd = true;
+                        qCDebug(entities) << "User attempted to add entity ID:" << entityItemID << "outside the region of this server";
                     } else {
                         if (isClone) {
                             properties.convertToCloneProperties(entityIDToClone);
@@ -2391,6 +2947,36 @@ void EntityTree::forgetEntitiesDeletedBefore(quint64 sinceTime) {
     }
 }
 
+EntityTreeSnapshotPointer EntityTree::getTopologySnapshot() {
+    // the root's change time moves on whenever anything under it is added, moved or removed,
+    // so it's enough to tell whether the published snapshot is still current
+    quint64 version = 0;
+    withReadLock([&] {
+        if (_rootElement) {
+            version = _rootElement->getLastChanged();
+        }
+    });
+
+    auto snapshot = std::atomic_load(&_topologySnapshot);
+    if (snapshot && snapshot->getVersion() == version) {
+        return snapshot;
+    }
+
+    // only one reader re-takes it, the others waiting here pick up the one it publishes
+    std::lock_guard<std::mutex> lock(_topologySnapshotMutex);
+    snapshot = std::atomic_load(&_topologySnapshot);
+    if (snapshot && snapshot->getVersion() == version) {
+        return snapshot;
+    }
+
+    withReadLock([&] {
+        snapshot = EntityTreeSnapshot::create(std::static_pointer_cast<EntityTreeElement>(_rootElement));
+    });
+    std::atomic_store(&_topologySnapshot, snapshot);
+
+    return snapshot;
+}
+
 
 bool EntityTree::shouldEraseEntity(EntityItemID entityID, const SharedNodePointer& sourceNode) {
     EntityItemPointer existingEntity;
@@ -2421,6 +3007,59 @@ bool EntityTree::shouldEraseEntity(EntityItemID entityID, const SharedNodePointe
     return allowed;
 }
 
+void EntityTree::applyPhysicsStates(std::vector<EntityPhysicsState>& states, const QUuid& senderID, quint64 timestamp) {
+    MovingEntitiesOperator moveOperator;
+    quint64 now = usecTimestampNow();
+    withWriteLock([&] {
+        auto end = std::remove_if(states.begin(), states.end(), [&](const EntityPhysicsState& state) {
+            EntityItemPointer entity = findEntityByEntityItemID(state.entityID);
+            if (!entity || !entity->isDomainEntity() || !entity->getParentID().isNull()) {
+                return true;
+            }
+            if (getIsServer()) {
+                if (senderID.isNull() || entity->getSimulatorID() != senderID) {
+                    return true;
+                }
+                // like an EntityPhysics edit from the owner, though without a new lastEdited
+                entity->setSimulationOwnershipExpiry(now + MAX_INCOMING_SIMULATION_UPDATE_PERIOD);
+                entity->setPhysicsState(state);
+            } else if (!entity->updatePhysicsStateFromNetwork(state, timestamp)) {
+                return true;
+            }
+            if (entity->getDirtyFlags()) {
+                entityChanged(entity);
+            }
+            // the states only come for the entities without a parent, whose cube both ends work out the same
+            entity->updateQueryAACube();
+            moveOperator.addEntityToMoveList(entity, entity->getQueryAACube());
+            return false;
+        });
+        states.erase(end, states.end());
+
+        if (moveOperator.hasMovingEntities()) {
+            PerformanceTimer perfTimer("recurseTreeWithOperator");
+            recurseTreeWithOperator(&moveOperator);
+        }
+    });
+}
+
+int EntityTree::processPhysicsStateMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode) {
+    // NOTE: this is only called by the interface-client on receipt of the physics states the entity-server relays
+    assert(!getIsServer());
+    OCTREE_PACKET_SENT_TIME sentAt;
+    message.readPrimitive(&sentAt);
+    // in local time, to order the states against the lastEdited of the full updates
+    quint64 timestamp = glm::min((quint64)(sentAt - sourceNode->getClockSkewUsec()), usecTimestampNow());
+
+    std::vector<EntityPhysicsState> states;
+    EntityPhysicsState state;
+    while (state.read(message)) {
+        states.push_back(state);
+    }
+    applyPhysicsStates(states, sourceNode->getUUID(), timestamp);
+    return (int)message.getPosition();
+}
+
 int EntityTree::processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode) {
     // NOTE: this is only called by the interface-client on receipt of deleteEntity message from entity-server.
     // Which means this is a state synchronization message from the the entity-server.  It is saying
@@ -2538,11 +3177,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
 }
 
 EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& entityItemID)  /*const*/ {
-    EntityItemPointer entity;
-    {
-        QReadLocker locker(&_entityMapLock);
-        entity = _entityMap.value(entityItemID);
-    }
+    EntityItemPointer entity = _entityMap.value(entityItemID);
     if (entity) {
         return entity->getElement();
     }
@@ -2551,25 +3186,19 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
+    if (!_entityMap.insertIfAbsent(id, entity)) {
         qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
         assert(false);
         return;
     }
-    _entityMap.insert(id, entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
     _entityMap.remove(id);
 }
 
 void EntityTree::debugDumpMap() {
-    // QHash's are implicitly shared, so we make a shared copy and use that instead.
-    // This way we might be able to avoid both a lock and a true copy.
-    QHash<EntityItemID, EntityItemPointer> localMap(_entityMap);
+    QHash<EntityItemID, EntityItemPointer> localMap = _entityMap.toHash();
     qCDebug(entities) << "EntityTree::debugDumpMap() --------------------------";
     QHashIterator<EntityItemID, EntityItemPointer> i(localMap);
     while (i.hasNext()) {
@@ -3067,10 +3696,7 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
-bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
-    // These are needed to deal with older content (before adding inheritance modes)
-    int contentVersion = map["Version"].toInt();
-
+int EntityTree::readHeaderFromMap(const QVariantMap& map) {
     if (map.contains("Id")) {
         _persistID = map["Id"].toUuid();
     }
@@ -3089,6 +3715,13 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
         }
     }
 
+    // These are needed to deal with older content (before adding inheritance modes)
+    return map["Version"].toInt();
+}
+
+bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
+    int contentVersion = readHeaderFromMap(map);
+
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
     // to a QScriptValue, and then to EntityItemProperties.  These properties are used
@@ -3101,184 +3734,556 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
         return false;
     }
 
+    std::vector<BulkEntity> mapEntities(entitiesQList.size());
+    for (int i = 0; i < entitiesQList.size(); ++i) {
+        QVariantMap entityMap = entitiesQList[i].toMap();
+        readEntityFromMap(entityMap, contentVersion, scriptEngine, mapEntities[i]);
+    }
+
     QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = addEntitiesFromMaps(mapEntities, isImport, cloneIDs);
+    setCloneIDsFromOrigins(cloneIDs);
+    return success;
+}
 
+bool EntityTree::readFromEntitiesParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport) {
+    // entities are added a batch at a time as they are parsed, so only a batch is held at once
+    const size_t ENTITIES_PER_BULK_ADD = 1000;
+    QVariantMap header;
+    int contentVersion = 0;
+    int numEntities = 0;
+    QScriptEngine scriptEngine;
+    std::vector<BulkEntity> parsedEntities;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
     bool success = true;
-    foreach (QVariant entityVariant, entitiesQList) {
-        // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
-        QVariantMap entityMap = entityVariant.toMap();
 
-        // handle parentJointName for wearables
-        if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
-            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+    bool parsed = parser.parseEntities(header, [&](QJsonObject& entity) {
+        if (numEntities == 0) {
+            contentVersion = readHeaderFromMap(header);
+        }
+        ++numEntities;
+
+        QVariantMap entityMap = entity.toVariantMap();
+        if (!marketplaceID.isEmpty()) {
+            entityMap["marketplaceID"] = marketplaceID;
+        }
+        parsedEntities.emplace_back();
+        readEntityFromMap(entityMap, contentVersion, scriptEngine, parsedEntities.back());
+        if (parsedEntities.size() >= ENTITIES_PER_BULK_ADD) {
+            success = addEntitiesFromMaps(parsedEntities, isImport, cloneIDs) && success;
+            parsedEntities.clear();
+        }
+        return true;
+    });
+    success = addEntitiesFromMaps(parsedEntities, isImport, cloneIDs) && success;
+
+    if (!parsed) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        success = false;
+    } else if (numEntities == 0) {
+        // Empty map or invalidly formed file.
+        readHeaderFromMap(header);
+        return false;
+    }
+
+    setCloneIDsFromOrigins(cloneIDs);
+    return success;
+}
+
+void EntityTree::readEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine,
+                                   BulkEntity& bulkEntity) {
+    // QVariantMap --> QScriptValue --> EntityItemProperties --> Entity
+
+    // handle parentJointName for wearables
+    if (_myAvatar && entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+        QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+
+        entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+
+        qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
+            " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+    }
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemProperties& properties = bulkEntity.properties;
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        bulkEntity.id = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        bulkEntity.id = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        const QUuid myNodeID = nodeList->getSessionUUID();
+        properties.setOwningAvatarID(myNodeID);
+    }
 
-            entityMap["parentJointIndex"] = _myAvatar->getJointIndex(entityMap["parentJointName"].toString());
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
 
-            qCDebug(entities) << "Found parentJointName " << entityMap["parentJointName"].toString() <<
-                " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
         }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
 
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
         } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
         }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
             }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
         }
+    }
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
         }
+    }
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
+    if (contentVersion < (int)EntityVersion::AllBillboardMode) {
+        if (properties.getBillboardMode() != BillboardMode::NONE) {
+            properties.setRotation(glm::quat());
+        }
+    }
+
+}
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+bool EntityTree::addEntitiesFromMaps(const std::vector<BulkEntity>& bulkEntities, const bool isImport,
+                                     QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    auto addedEntities = addEntitiesBulk(bulkEntities, false, isImport);
+    for (const auto& entity : addedEntities) {
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    }
+
+    if (addedEntities.size() != bulkEntities.size()) {
+        qCDebug(entities) << "adding" << (bulkEntities.size() - addedEntities.size()) << "of" << bulkEntities.size()
+            << "entities failed";
+        return false;
+    }
+    return true;
+}
+
+void EntityTree::setCloneIDsFromOrigins(const QMap<QUuid, QVector<QUuid>>& cloneIDs) {
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+}
+
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
+
+    jsonString = theOperator.getJson();
+    return true;
+}
+
+namespace {
+    // how each entity is stored in the binary persist file and its journal
+    enum BinaryEntityEncoding : uint8_t {
+        EditPacketEncoding = 0, // EntityItemProperties::encodeEntityEditPacket() of all its properties
+        JSONEncoding = 1 // as in the JSON persist file, for the few entities the edit packet encoding can't hold
+    };
+
+    const int INITIAL_ENTITY_ENCODE_BUFFER_SIZE = 4 * 1024;
+    const int MAX_ENTITY_ENCODE_BUFFER_SIZE = 16 * 1024 * 1024;
+
+    // the edit packet encoding writes text and blobs with 16 bit lengths
+    bool fitsEditPacketEncoding(const EntityItemProperties& properties) {
+        const int MAX_ENCODED_STRING_SIZE = std::numeric_limits<uint16_t>::max();
+        for (const QString* string : { &properties.getUserData(), &properties.getPrivateUserData(), &properties.getScript(),
+                                       &properties.getServerScripts(), &properties.getText(), &properties.getMaterialData(),
+                                       &properties.getTextures(), &properties.getBlendshapeCoefficients(),
+                                       &properties.getDescription() }) {
+            if (string->size() * 3 > MAX_ENCODED_STRING_SIZE && string->toUtf8().size() > MAX_ENCODED_STRING_SIZE) {
+                return false;
             }
+        }
+        return properties.getVoxelData().size() <= MAX_ENCODED_STRING_SIZE
+            && properties.getActionData().size() <= MAX_ENCODED_STRING_SIZE;
+    }
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+    uint8_t encodeBinaryEntity(const EntityItemPointer& entity, QScriptEngine& scriptEngine, QByteArray& buffer) {
+        EntityItemProperties properties = entity->getProperties();
+        if (fitsEditPacketEncoding(properties)) {
+            for (int size = INITIAL_ENTITY_ENCODE_BUFFER_SIZE; size <= MAX_ENTITY_ENCODE_BUFFER_SIZE; size *= 2) {
+                buffer.resize(size);
+                EntityPropertyFlags didntFitProperties;
+                auto appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, entity->getEntityItemID(),
+                    properties, buffer, properties.getChangedProperties(), didntFitProperties);
+                if (appendState == OctreeElement::COMPLETED) {
+                    return EditPacketEncoding;
                 }
             }
+        }
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        QVariant entityVariant = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties).toVariant();
+        buffer = QJsonDocument::fromVariant(entityVariant).toJson(QJsonDocument::Compact);
+        return JSONEncoding;
+    }
+
+    // the script engine is only created when a JSON record needs it, as few entities are written that way
+    bool decodeBinaryEntity(const EntityItemID& entityItemID, uint8_t encoding, const char* data, int size,
+                            std::unique_ptr<QScriptEngine>& scriptEngine, EntityItemProperties& properties) {
+        if (encoding == EditPacketEncoding) {
+            int processedBytes = 0;
+            EntityItemID decodedID;
+            return EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(data), size,
+                processedBytes, decodedID, properties) && decodedID == entityItemID;
+        } else if (encoding == JSONEncoding) {
+            QVariantMap entityMap = QJsonDocument::fromJson(QByteArray::fromRawData(data, size)).toVariant().toMap();
+            if (!entityMap.isEmpty()) {
+                if (!scriptEngine) {
+                    scriptEngine.reset(new QScriptEngine());
+                }
+                EntityItemPropertiesFromScriptValueIgnoreReadOnly(variantMapToScriptValue(entityMap, *scriptEngine), properties);
+                return true;
             }
         }
+        return false;
+    }
+}
+
+uint8_t EntityTree::encodeEntityRecord(const EntityItemPointer& entity, QScriptEngine& scriptEngine, QByteArray& buffer) {
+    return encodeBinaryEntity(entity, scriptEngine, buffer);
+}
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+bool EntityTree::writeToBinaryFile(const QString& fileName, const OctreeElementPointer& element) {
+    QJsonObject metadata;
+    QJsonObject namedPaths;
+    for (const auto& namedPath : _namedPaths) {
+        namedPaths[namedPath.first] = namedPath.second;
+    }
+    metadata["Paths"] = namedPaths;
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
+    OctreeBinaryFile::Writer writer(expectedVersion(), _persistID, _persistDataVersion,
+                                    QJsonDocument(metadata).toJson(QJsonDocument::Compact));
+    QScriptEngine scriptEngine;
+    QByteArray buffer;
+    int numJSONEntities = 0;
+
+    withReadLock([&] {
+        recurseElementWithOperation(element ? element : _rootElement, [&](const OctreeElementPointer& treeElement, void*) {
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(treeElement);
+            entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+                if (!entity->isParentIDValid()) {
+                    return; // as for JSON, we weren't able to resolve a parent from _parentID, so don't save this entity
                 }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
+
+                uint8_t encoding = encodeBinaryEntity(entity, scriptEngine, buffer);
+                writer.addRecord(entity->getEntityItemID(), encoding, buffer);
+                if (encoding == JSONEncoding) {
+                    ++numJSONEntities;
                 }
+            });
+            return true;
+        }, nullptr);
+    });
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
+    if (numJSONEntities > 0) {
+        qCDebug(entities) << "Saved" << numJSONEntities << "of" << writer.getNumRecords() << "entities as JSON in" << fileName;
+    }
+    return writer.write(fileName);
+}
+
+bool EntityTree::readFromBinaryFile(const QString& fileName, const std::vector<OctreeJournal::Entry>& journalEntries) {
+    OctreeBinaryFile::Reader reader;
+    if (!reader.open(fileName)) {
+        qCritical() << "Cannot open binary entities file for reading:" << fileName;
+        return false;
+    }
+
+    // the edit packet encoding has no versioning of its own
+    if (reader.getVersion() != expectedVersion()) {
+        qCritical() << "Binary entities file" << fileName << "is from entity protocol version" << reader.getVersion()
+            << "not" << expectedVersion();
+        return false;
+    }
+
+    _persistID = reader.getID();
+    _persistDataVersion = reader.getDataVersion();
+
+    _namedPaths.clear();
+    QJsonObject namedPaths = QJsonDocument::fromJson(reader.getMetadata()).object()["Paths"].toObject();
+    for (auto it = namedPaths.begin(); it != namedPaths.end(); ++it) {
+        _namedPaths[it.key()] = it.value().toString();
+    }
+
+    // the last journal entry for an entity replaces what the snapshot has for it
+    std::unordered_map<QUuid, const OctreeJournal::Entry*> journaledEntities;
+    for (const auto& entry : journalEntries) {
+        if (entry.type != OctreeJournal::Checkpoint) {
+            journaledEntities[entry.id] = &entry;
         }
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    const QUuid sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+    quint64 decodeUsecs = 0;
+    quint64 insertUsecs = 0;
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+    auto addDecodedEntities = [&](std::vector<BulkEntity>& loadedEntities) {
+        for (auto& loadedEntity : loadedEntities) {
+            if (loadedEntity.properties.getEntityHostType() == entity::HostType::AVATAR) {
+                loadedEntity.properties.setOwningAvatarID(sessionID);
             }
         }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
+        quint64 insertStarted = usecTimestampNow();
+        auto addedEntities = addEntitiesBulk(loadedEntities);
+        insertUsecs += usecTimestampNow() - insertStarted;
+        if (addedEntities.size() != loadedEntities.size()) {
+            success = false;
         }
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+        for (const auto& entity : addedEntities) {
+            const QUuid& cloneOriginID = entity->getCloneOriginID();
+            if (!cloneOriginID.isNull()) {
+                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+            }
         }
+    };
+
+    struct DecodedChunk {
+        int index { 0 };
+        bool read { false };
+        bool decoded { true };
+        std::vector<BulkEntity> entities;
+    };
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+    // runs on the thread pool, the reader and journaledEntities are only read from
+    auto decodeChunk = [&](DecodedChunk& chunk) {
+        QByteArray buffer;
+        std::vector<OctreeBinaryFile::Record> records;
+        std::unique_ptr<QScriptEngine> scriptEngine;
+        chunk.read = reader.readChunk(chunk.index, buffer, records);
+        chunk.entities.reserve(records.size());
+        for (const auto& record : records) {
+            if (journaledEntities.find(record.id) != journaledEntities.end()) {
+                continue;
+            }
+            chunk.entities.emplace_back();
+            BulkEntity& loadedEntity = chunk.entities.back();
+            loadedEntity.id = EntityItemID(record.id);
+            if (!decodeBinaryEntity(loadedEntity.id, record.encoding, record.data, record.size, scriptEngine,
+                                    loadedEntity.properties)) {
+                qCDebug(entities) << "Unable to decode entity" << loadedEntity.id << "from" << fileName;
+                chunk.entities.pop_back();
+                chunk.decoded = false;
             }
         }
+    };
 
-        // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
-        if (contentVersion < (int)EntityVersion::AllBillboardMode) {
-            if (properties.getBillboardMode() != BillboardMode::NONE) {
-                properties.setRotation(glm::quat());
-            }
+    // A batch of chunks, one for each thread, is decoded across the thread pool while the batch before it is added to
+    // the tree here. Only the entities of two batches are held as properties at once.
+    const int numChunks = reader.getNumChunks();
+    const int chunksPerBatch = std::max(QThread::idealThreadCount(), 1);
+    std::vector<DecodedChunk> decodingChunks;
+    std::vector<DecodedChunk> decodedChunks;
+    QFuture<void> decoding;
+    auto startDecoding = [&](int firstChunk) {
+        decodingChunks.clear();
+        for (int chunk = firstChunk; chunk < std::min(firstChunk + chunksPerBatch, numChunks); ++chunk) {
+            decodingChunks.emplace_back();
+            decodingChunks.back().index = chunk;
         }
+        decoding = QtConcurrent::map(decodingChunks, decodeChunk);
+    };
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
-            success = false;
+    if (numChunks > 0) {
+        startDecoding(0);
+    }
+    for (int firstChunk = 0; firstChunk < numChunks; firstChunk += chunksPerBatch) {
+        // only the time spent waiting counts, the rest of the decoding overlaps the inserting
+        quint64 waitStarted = usecTimestampNow();
+        decoding.waitForFinished();
+        decodeUsecs += usecTimestampNow() - waitStarted;
+
+        decodedChunks.swap(decodingChunks);
+        if (firstChunk + chunksPerBatch < numChunks) {
+            startDecoding(firstChunk + chunksPerBatch);
         }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        std::vector<BulkEntity> batch;
+        for (auto& chunk : decodedChunks) {
+            if (!chunk.read) {
+                qCritical() << "Binary entities file" << fileName << "has a corrupt chunk" << chunk.index;
             }
+            success = success && chunk.read && chunk.decoded;
+            batch.insert(batch.end(), chunk.entities.begin(), chunk.entities.end());
+            chunk.entities.clear();
         }
+        addDecodedEntities(batch);
     }
 
-    for (const auto& entityID : cloneIDs.keys()) {
-        auto entity = findEntityByID(entityID);
-        if (entity) {
-            entity->setCloneIDs(cloneIDs.value(entityID));
+    // the few changes since the snapshot are decoded here
+    quint64 journalDecodeStarted = usecTimestampNow();
+    std::unique_ptr<QScriptEngine> scriptEngine;
+    std::vector<BulkEntity> journalBatch;
+    for (const auto& entry : journalEntries) {
+        auto journaledEntity = journaledEntities.find(entry.id);
+        if (journaledEntity == journaledEntities.end() || journaledEntity->second != &entry || entry.type != OctreeJournal::Upsert) {
+            continue;
+        }
+        journalBatch.emplace_back();
+        BulkEntity& loadedEntity = journalBatch.back();
+        loadedEntity.id = EntityItemID(entry.id);
+        if (!decodeBinaryEntity(loadedEntity.id, entry.encoding, entry.data.constData(), entry.data.size(), scriptEngine,
+                                loadedEntity.properties)) {
+            qCDebug(entities) << "Unable to decode entity" << loadedEntity.id << "from the journal of" << fileName;
+            journalBatch.pop_back();
+            success = false;
         }
     }
+    decodeUsecs += usecTimestampNow() - journalDecodeStarted;
+    addDecodedEntities(journalBatch);
+    if (!journaledEntities.empty()) {
+        qCDebug(entities) << "Applied changes to" << journaledEntities.size() << "entities from the journal";
+    }
+
+    setCloneIDsFromOrigins(cloneIDs);
 
+    addLoadPhase("decode", decodeUsecs);
+    addLoadPhase("insert", insertUsecs);
     return success;
 }
 
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
+bool EntityTree::appendChangesToJournal(OctreeJournal& journal) {
+    QSet<EntityItemID> changedEntities;
+    QSet<EntityItemID> deletedEntities;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        _journalChanges = true;
+        changedEntities.swap(_journalChangedEntities);
+        deletedEntities.swap(_journalDeletedEntities);
+    }
 
-    jsonString = theOperator.getJson();
+    for (const auto& entityID : deletedEntities) {
+        journal.append(OctreeJournal::Delete, entityID);
+    }
+
+    if (!changedEntities.isEmpty()) {
+        QScriptEngine scriptEngine;
+        QByteArray buffer;
+        withReadLock([&] {
+            for (const auto& entityID : changedEntities) {
+                EntityItemPointer entity = findEntityByEntityItemID(entityID);
+                if (entity) {
+                    uint8_t encoding = encodeBinaryEntity(entity, scriptEngine, buffer);
+                    journal.append(OctreeJournal::Upsert, entityID, encoding, buffer);
+                }
+            }
+        });
+    }
     return true;
 }
 
+void EntityTree::journalEntityChange(const EntityItemID& entityID, bool deleted) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    if (!_journalChanges) {
+        return;
+    }
+    if (deleted) {
+        _journalChangedEntities.remove(entityID);
+        _journalDeletedEntities.insert(entityID);
+    } else {
+        _journalDeletedEntities.remove(entityID);
+        _journalChangedEntities.insert(entityID);
+    }
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
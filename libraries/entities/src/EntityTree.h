@@ -12,21 +12,30 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <mutex>
+#include <unordered_map>
+
 #include <QSet>
 #include <QVector>
 
 #include <Octree.h>
 #include <SpatialParentFinder.h>
+#include <shared/ShardedHashMap.h>
 
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
+#include "EntityTreeSnapshot.h"
+#include "EntityTreeSpatialIndex.h"
+#include "EntityTreeZoneIndex.h"
 #include "DeleteEntityOperator.h"
+#include "EntityPhysicsState.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 class EntitySimulation;
+class QScriptEngine;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -64,6 +73,13 @@ public:
     void setEntityMaxTmpLifetime(float maxTmpEntityLifetime) { _maxTmpEntityLifetime = maxTmpEntityLifetime; }
     void setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist);
 
+    // the part of the domain this tree takes new entities in, when the domain is split between entity servers
+    void setOwnedRegion(const AACube& region) { _ownedRegion = region; _hasOwnedRegion = true; }
+    void clearOwnedRegion() { _hasOwnedRegion = false; }
+    bool isInOwnedRegion(const EntityItemProperties& properties) const;
+    // false if the edit moves the entity, or takes it off its parent, to outside the owned region
+    bool isEditInOwnedRegion(const EntityItemPointer& entity, const EntityItemProperties& properties) const;
+
     /// Implements our type specific root element factory
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
 
@@ -88,6 +104,7 @@ public:
     virtual PacketType expectedDataPacketType() const override { return PacketType::EntityData; }
     virtual bool handlesEditPacketType(PacketType packetType) const override;
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
+    virtual void prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& senderNode) override;
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -100,6 +117,27 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    // One ray of a batched intersection query, with its own filter and lists, and its result
+    class RayQuery {
+    public:
+        glm::vec3 origin;
+        glm::vec3 direction;
+        PickFilter searchFilter;
+        QVector<EntityItemID> entityIdsToInclude;
+        QVector<EntityItemID> entityIdsToDiscard;
+
+        EntityItemID entityID;
+        float distance { FLT_MAX };
+        BoxFace face { UNKNOWN_FACE };
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+    };
+
+    // Intersects all the rays in one traversal of the tree: each element is tested against four rays at a time and only
+    // the rays that enter it before their nearest intersection yet go down to its entities and children
+    void evalRayIntersections(std::vector<RayQuery>& queries, Octree::lockType lockType = Octree::TryLock,
+        bool* accurateResult = NULL);
+
     virtual EntityItemID evalParabolaIntersection(const PickParabola& parabola,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
         PickFilter searchFilter, OctreeElementPointer& element, glm::vec3& intersection,
@@ -120,6 +158,16 @@ public:
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
 
+    struct BulkEntity {
+        EntityItemID id;
+        EntityItemProperties properties;
+    };
+    // Adds many entities at once, for imports and loading persisted content. They are sorted in Morton order of the
+    // elements they belong in, so the tree is walked once and each element is reached, or created, once. The add hooks
+    // run after they're all in. Returns the entities added, entities addEntity() would refuse are skipped.
+    std::vector<EntityItemPointer> addEntitiesBulk(const std::vector<BulkEntity>& bulkEntities, bool isClone = false,
+                                                   const bool isImport = false);
+
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
 
@@ -145,6 +193,22 @@ public:
     void evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInFrustum(const ViewFrustum& frustum, PickFilter searchFilter, QVector<QUuid>& foundEntities);
 
+    // answers the evalClosestEntity() and evalEntitiesIn*() queries from an index of the elements holding entities,
+    // rather than by recursing the tree, for trees that are queried much more often than they change
+    void setSpatialIndexEnabled(bool enabled);
+    bool isSpatialIndexEnabled() const { return _spatialIndexEnabled; }
+    void updateSpatialIndex(const EntityTreeElementPointer& element) {
+        if (_spatialIndexEnabled) {
+            _spatialIndex.update(element);
+        }
+    }
+
+    // the zones whose shapes hold the point, smallest first; a cache is for one caller checking a point as it moves
+    void findZonesContaining(const glm::vec3& point, std::vector<ZoneEntityItemPointer>& zones,
+                             EntityTreeZoneIndex::Cache* cache = nullptr) const {
+        _zoneIndex.findZonesContaining(point, zones, cache);
+    }
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -163,7 +227,15 @@ public:
 
     void forgetEntitiesDeletedBefore(quint64 sinceTime);
 
+    // returns an immutable copy of the element topology that reflects every change made before it was taken,
+    // re-taking it only when the tree has changed since, so any number of readers can walk it without the tree lock
+    EntityTreeSnapshotPointer getTopologySnapshot();
+
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
+    // applies the compact physics states of the moving entities without a parent, on the entity-server the ones from the
+    // simulation owner of each entity, on a client the ones the entity-server relays, and drops the others from states
+    void applyPhysicsStates(std::vector<EntityPhysicsState>& states, const QUuid& senderID, quint64 timestamp);
+    int processPhysicsStateMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
     bool shouldEraseEntity(EntityItemID entityID, const SharedNodePointer& sourceNode);
 
@@ -197,7 +269,17 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual bool readFromEntitiesParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID = "",
+                                        const bool isImport = false) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToBinaryFile(const QString& fileName, const OctreeElementPointer& element) override;
+    virtual bool readFromBinaryFile(const QString& fileName,
+                                    const std::vector<OctreeJournal::Entry>& journalEntries = {}) override;
+    virtual bool appendChangesToJournal(OctreeJournal& journal) override;
+
+    // an entity's record as the binary persist file holds it, for other tools to read the same way
+    // \return its encoding: 0 for the edit packet encoding of all its properties, 1 for JSON when that can't hold them
+    static uint8_t encodeEntityRecord(const EntityItemPointer& entity, QScriptEngine& scriptEngine, QByteArray& buffer);
 
 
     glm::vec3 getContentsDimensions();
@@ -327,8 +409,11 @@ protected:
         _deletedEntityItemIDs << id;
     }
 
-    mutable QReadWriteLock _entityMapLock;
-    QHash<EntityItemID, EntityItemPointer> _entityMap;
+    // sharded so that the many threads looking entities up by ID don't all contend on one lock
+    ShardedHashMap<EntityItemID, EntityItemPointer> _entityMap;
+
+    std::mutex _topologySnapshotMutex; // serializes re-taking the snapshot, readers use std::atomic_load
+    EntityTreeSnapshotPointer _topologySnapshot;
 
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
@@ -374,8 +459,22 @@ protected:
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const;
+
+    // the edits of the packet being processed that went through the edit filters before the tree was locked for writing,
+    // by where they start in the packet; only used by the thread processing the edit packets
+    struct PrefilteredEdit {
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        bool allowed { true };
+        bool wasChanged { false };
+        quint64 filterTime { 0 }; // usecs
+    };
+    bool takePrefilteredEdit(const unsigned char* editData, const EntityItemID& entityItemID, PrefilteredEdit& edit);
+    std::unordered_map<const unsigned char*, PrefilteredEdit> _prefilteredEdits;
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
+    AACube _ownedRegion;
+    bool _hasOwnedRegion { false };
 
     MovingEntitiesOperator _entityMover;
     QHash<EntityItemID, EntityItemPointer> _entitiesToAdd;
@@ -403,6 +502,30 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    // reading JSON content, returns the content version
+    int readHeaderFromMap(const QVariantMap& map);
+    void readEntityFromMap(QVariantMap& entityMap, int contentVersion, QScriptEngine& scriptEngine, BulkEntity& bulkEntity);
+    bool addEntitiesFromMaps(const std::vector<BulkEntity>& bulkEntities, const bool isImport,
+                             QMap<QUuid, QVector<QUuid>>& cloneIDs);
+    void setCloneIDsFromOrigins(const QMap<QUuid, QVector<QUuid>>& cloneIDs);
+
+    // calls operation on each element the index has whose cube, and those of its ancestors, pass test, in the order
+    // recurseTreeWithOperation() would, or recurses the tree with it when there is no index
+    void evalElementsWithOperation(const EntityTreeSpatialIndex::CubeTest& test, const RecurseOctreeOperation& operation,
+                                   void* extraData);
+    bool _spatialIndexEnabled { false };
+    EntityTreeSpatialIndex _spatialIndex;
+
+    void addToZoneIndex(const EntityItemPointer& entity);
+    EntityTreeZoneIndex _zoneIndex;
+
+    // entities changed since the last appendChangesToJournal(), which starts the tracking
+    void journalEntityChange(const EntityItemID& entityID, bool deleted = false);
+    std::mutex _journalMutex;
+    bool _journalChanges { false };
+    QSet<EntityItemID> _journalChangedEntities;
+    QSet<EntityItemID> _journalDeletedEntities;
+
     // Return an AACube containing object and all its entity descendants
     AACube updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                          MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
@@ -716,6 +716,9 @@ void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
         _entityItems = savedEntities;
     });
     bumpChangedContent();
+    if (_myTree) {
+        _myTree->updateSpatialIndex(getThisPointer());
+    }
 }
 
 void EntityTreeElement::cleanupEntities() {
@@ -731,6 +734,9 @@ void EntityTreeElement::cleanupEntities() {
         _entityItems.clear();
     });
     bumpChangedContent();
+    if (_myTree) {
+        _myTree->updateSpatialIndex(getThisPointer());
+    }
 }
 
 bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion) {
@@ -746,6 +752,9 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
         assert(entity->_element.get() == this);
         entity->_element = NULL;
         bumpChangedContent();
+        if (_myTree) {
+            _myTree->updateSpatialIndex(getThisPointer());
+        }
         return true;
     }
     return false;
@@ -765,6 +774,9 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     });
     bumpChangedContent();
     entity->_element = getThisPointer();
+    if (_myTree) {
+        _myTree->updateSpatialIndex(getThisPointer());
+    }
 }
 
 // will average a "common reduced LOD view" from the the child elements...
@@ -0,0 +1,66 @@
+//
+//  EntityTreeSnapshot.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSnapshot.h"
+
+#include <SharedUtil.h>
+
+EntityTreeSnapshotPointer EntityTreeSnapshot::create(const EntityTreeElementPointer& root) {
+    std::shared_ptr<EntityTreeSnapshot> snapshot { new EntityTreeSnapshot() };
+    if (!root) {
+        return snapshot;
+    }
+
+    // writers are held off by the caller's read lock, so anything changed later is stamped at or after this time
+    snapshot->_timestamp = usecTimestampNow() - 1;
+    snapshot->_version = root->getLastChanged();
+
+    // breadth first, recording where each child lands so the pointers can be wired up once the vector is final
+    std::vector<EntityTreeElementPointer> sourceElements;
+    std::vector<std::array<int32_t, NUMBER_OF_CHILDREN>> childIndices;
+    sourceElements.push_back(root);
+
+    for (size_t i = 0; i < sourceElements.size(); ++i) {
+        std::array<int32_t, NUMBER_OF_CHILDREN> indices;
+        indices.fill(-1);
+
+        for (int child = 0; child < NUMBER_OF_CHILDREN; ++child) {
+            auto childElement = sourceElements[i]->getChildAtIndex(child);
+            if (childElement) {
+                indices[child] = (int32_t)sourceElements.size();
+                sourceElements.push_back(childElement);
+            }
+        }
+        childIndices.push_back(indices);
+    }
+
+    snapshot->_elements.resize(sourceElements.size());
+
+    for (size_t i = 0; i < sourceElements.size(); ++i) {
+        const auto& source = sourceElements[i];
+        auto& element = snapshot->_elements[i];
+
+        element._cube = source->getAACube();
+        element._lastChanged = source->getLastChanged();
+        element._lastChangedContent = source->getLastChangedContent();
+
+        source->forEachEntity([&](const EntityItemPointer& entity) {
+            element._entities.push_back(entity);
+        });
+
+        for (int child = 0; child < NUMBER_OF_CHILDREN; ++child) {
+            int32_t index = childIndices[i][child];
+            element._children[child] = index == -1 ? nullptr : &snapshot->_elements[index];
+        }
+    }
+
+    return snapshot;
+}
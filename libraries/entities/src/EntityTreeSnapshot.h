@@ -0,0 +1,84 @@
+//
+//  EntityTreeSnapshot.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSnapshot_h
+#define hifi_EntityTreeSnapshot_h
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <AACube.h>
+
+#include "EntityTreeElement.h"
+
+class EntityTreeSnapshot;
+using EntityTreeSnapshotPointer = std::shared_ptr<const EntityTreeSnapshot>;
+
+// An immutable copy of the element topology of an EntityTree: element cubes, change times, children and the entities
+// each element held when it was taken. It can be walked without the tree lock, which lets the entity server's send
+// threads traverse in parallel while edits go ahead. Readers keep the version they started with alive through their
+// shared pointer, the tree publishes a new one once it has changed (see EntityTree::getTopologySnapshot).
+// The entities themselves are the live items, only which element holds them is frozen. They are held weakly, so an entity
+// deleted after the snapshot was taken is skipped rather than kept alive and sent again after its delete.
+class EntityTreeSnapshot {
+public:
+    class Element {
+    public:
+        const AACube& getAACube() const { return _cube; }
+        quint64 getLastChanged() const { return _lastChanged; }
+        uint64_t getLastChangedContent() const { return _lastChangedContent; }
+        bool hasContent() const { return !_entities.empty(); }
+
+        const Element* getChildAtIndex(int index) const { return _children[index]; }
+
+        template <typename F>
+        void forEachEntity(F f) const {
+            for (const auto& weakEntity : _entities) {
+                EntityItemPointer entity = weakEntity.lock();
+                if (entity) {
+                    f(entity);
+                }
+            }
+        }
+
+    private:
+        friend class EntityTreeSnapshot;
+
+        AACube _cube;
+        quint64 _lastChanged { 0 };
+        uint64_t _lastChangedContent { 0 };
+        std::array<const Element*, NUMBER_OF_CHILDREN> _children {};
+        std::vector<EntityItemWeakPointer> _entities;
+    };
+
+    // copies the subtree under root, the caller must hold the tree's read lock
+    static EntityTreeSnapshotPointer create(const EntityTreeElementPointer& root);
+
+    const Element* getRoot() const { return _elements.empty() ? nullptr : &_elements.front(); }
+
+    // the root's change time when this was taken, which changes whenever anything a traversal could see changes
+    quint64 getVersion() const { return _version; }
+
+    // no change made after this time is reflected here, traversals of this snapshot use it as their start time
+    uint64_t getTimestamp() const { return _timestamp; }
+
+    size_t getNumElements() const { return _elements.size(); }
+
+private:
+    EntityTreeSnapshot() = default;
+
+    std::vector<Element> _elements;
+    quint64 _version { 0 };
+    uint64_t _timestamp { 0 };
+};
+
+#endif // hifi_EntityTreeSnapshot_h
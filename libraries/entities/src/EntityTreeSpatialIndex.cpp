@@ -0,0 +1,117 @@
+//
+//  EntityTreeSpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeSpatialIndex.h"
+
+#include <cmath>
+
+#include <OctreeConstants.h>
+
+EntityTreeSpatialIndex::Cell EntityTreeSpatialIndex::cellOf(const EntityTreeElementPointer& element) {
+    const AACube& cube = element->getAACube();
+    float scale = cube.getScale();
+    glm::vec3 corner = cube.getCorner() + glm::vec3((float)HALF_TREE_SCALE);
+    return { (uint32_t)std::lround(corner.x / scale), (uint32_t)std::lround(corner.y / scale),
+             (uint32_t)std::lround(corner.z / scale) };
+}
+
+void EntityTreeSpatialIndex::addToAncestors(int level, Cell cell, int delta) {
+    for (int ancestorLevel = level - 1; ancestorLevel >= 0; --ancestorLevel) {
+        cell = { cell.x >> 1, cell.y >> 1, cell.z >> 1 };
+        Level& ancestors = _levels[ancestorLevel];
+        Node& ancestor = ancestors[cell];
+        ancestor.numElementsBelow += delta;
+        if (ancestor.numElementsBelow == 0 && !ancestor.hasEntities) {
+            ancestors.erase(cell);
+        }
+    }
+}
+
+void EntityTreeSpatialIndex::update(const EntityTreeElementPointer& element) {
+    int level = element->getLevel() - 1;
+    Cell cell = cellOf(element);
+
+    if (element->hasEntities()) {
+        if ((int)_levels.size() <= level) {
+            _levels.resize(level + 1);
+        }
+        Node& node = _levels[level][cell];
+        node.element = element;
+        if (!node.hasEntities) {
+            node.hasEntities = true;
+            ++_size;
+            addToAncestors(level, cell, 1);
+        }
+    } else if (level < (int)_levels.size()) {
+        Level& elements = _levels[level];
+        auto found = elements.find(cell);
+        if (found != elements.end() && found->second.hasEntities) {
+            auto indexedElement = found->second.element.lock();
+            if (!indexedElement || indexedElement == element) {
+                found->second.element.reset();
+                found->second.hasEntities = false;
+                if (found->second.numElementsBelow == 0) {
+                    elements.erase(found);
+                }
+                --_size;
+                addToAncestors(level, cell, -1);
+            }
+        }
+    }
+}
+
+void EntityTreeSpatialIndex::clear() {
+    _levels.clear();
+    _size = 0;
+}
+
+void EntityTreeSpatialIndex::findElements(const CubeTest& test, std::vector<EntityTreeElementPointer>& foundElements) const {
+    if (_levels.empty()) {
+        return;
+    }
+    const Cell ROOT_CELL { 0, 0, 0 };
+    auto root = _levels[0].find(ROOT_CELL);
+    if (root != _levels[0].end()) {
+        findElements(0, ROOT_CELL, root->second, test, foundElements);
+    }
+}
+
+void EntityTreeSpatialIndex::findElements(int level, const Cell& cell, const Node& node, const CubeTest& test,
+                                          std::vector<EntityTreeElementPointer>& foundElements) const {
+    // the same cube OctreeElement::calculateAACube() gives the element, the corners are exact at every level
+    float scale = (float)TREE_SCALE / (float)(1ULL << level);
+    glm::vec3 corner = glm::vec3((float)cell.x, (float)cell.y, (float)cell.z) * scale - glm::vec3((float)HALF_TREE_SCALE);
+    if (!test(AACube(corner, scale))) {
+        return;
+    }
+
+    if (node.hasEntities) {
+        EntityTreeElementPointer element = node.element.lock();
+        if (element) {
+            foundElements.push_back(element);
+        }
+    }
+
+    int childLevel = level + 1;
+    if (node.numElementsBelow == 0 || childLevel >= (int)_levels.size()) {
+        return;
+    }
+    // children in index order, as in OctreeElement::getMyChildContaining()
+    const Level& children = _levels[childLevel];
+    for (uint32_t childIndex = 0; childIndex < (uint32_t)NUMBER_OF_CHILDREN; ++childIndex) {
+        Cell childCell { (cell.x << 1) | ((childIndex >> 2) & 1), (cell.y << 1) | ((childIndex >> 1) & 1),
+                         (cell.z << 1) | (childIndex & 1) };
+        auto child = children.find(childCell);
+        if (child != children.end()) {
+            findElements(childLevel, childCell, child->second, test, foundElements);
+        }
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  EntityTreeSpatialIndex.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeSpatialIndex_h
+#define hifi_EntityTreeSpatialIndex_h
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <AACube.h>
+
+#include "EntityTreeElement.h"
+
+// An index of the tree elements that hold entities, so spatial queries needn't recurse the whole tree. Each level of
+// the octree is a regular grid, so a cell is keyed by its level and its position in that grid, and every cell on the
+// way down to an element with entities is kept along with how many such elements are below it. A query walks only
+// those cells, in the same order and with the same cube test as recurseTreeWithOperation(), without taking any
+// element locks or visiting the empty branches of the tree. It only narrows down which elements to look in, the
+// caller still runs the same element and entity tests as when recursing the tree, so the results are the same.
+//
+// It is only changed with the tree's write lock held and only read with its read lock held, which every caller of
+// EntityTree::evalEntitiesIn*() already has, so it needs no lock of its own.
+class EntityTreeSpatialIndex {
+public:
+    using CubeTest = std::function<bool(const AACube& cube)>;
+
+    // adds the element if it has entities, otherwise removes it
+    void update(const EntityTreeElementPointer& element);
+    void clear();
+    size_t size() const { return _size; }
+
+    // the indexed elements whose cube, and the cubes of all their ancestors, pass the test, in the order
+    // recurseTreeWithOperation() would reach them
+    void findElements(const CubeTest& test, std::vector<EntityTreeElementPointer>& foundElements) const;
+
+private:
+    struct Cell {
+        uint32_t x;
+        uint32_t y;
+        uint32_t z;
+
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+
+    struct CellHash {
+        size_t operator()(const Cell& cell) const {
+            return std::hash<uint64_t>()(((uint64_t)cell.x * 73856093) ^ ((uint64_t)cell.y * 19349663) ^
+                                         ((uint64_t)cell.z * 83492791));
+        }
+    };
+
+    struct Node {
+        EntityTreeElementWeakPointer element;
+        bool hasEntities { false };
+        int numElementsBelow { 0 };
+    };
+
+    using Level = std::unordered_map<Cell, Node, CellHash>;
+
+    static Cell cellOf(const EntityTreeElementPointer& element);
+    void addToAncestors(int level, Cell cell, int delta);
+    void findElements(int level, const Cell& cell, const Node& node, const CubeTest& test,
+                      std::vector<EntityTreeElementPointer>& foundElements) const;
+
+    std::vector<Level> _levels;
+    size_t _size { 0 };
+};
+
+#endif // hifi_EntityTreeSpatialIndex_h
@@ -0,0 +1,214 @@
+//
+//  EntityTreeZoneIndex.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeZoneIndex.h"
+
+#include <algorithm>
+
+#include "ZoneEntityItem.h"
+
+const float EntityTreeZoneIndex::MAX_SAFE_RADIUS = 10.0f;
+
+// the zones a leaf of the hierarchy holds, at most
+const int MAX_LEAF_SIZE = 4;
+
+static float distanceToBox(const AABox& box, const glm::vec3& point) {
+    glm::vec3 outside = glm::max(glm::max(box.getMinimumPoint() - point, point - box.getMaximumPoint()), glm::vec3(0.0f));
+    return glm::length(outside);
+}
+
+static float distanceToBoxBoundary(const AABox& box, const glm::vec3& point) {
+    if (!box.contains(point)) {
+        return distanceToBox(box, point);
+    }
+    glm::vec3 toMinimum = point - box.getMinimumPoint();
+    glm::vec3 toMaximum = box.getMaximumPoint() - point;
+    glm::vec3 nearest = glm::min(toMinimum, toMaximum);
+    return std::min(nearest.x, std::min(nearest.y, nearest.z));
+}
+
+void EntityTreeZoneIndex::addZone(const ZoneEntityItemPointer& zone) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _zones[zone->getEntityItemID()] = zone;
+    ++_zonesGeneration;
+}
+
+void EntityTreeZoneIndex::removeZone(const EntityItemID& id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_zones.erase(id) > 0) {
+        ++_zonesGeneration;
+    }
+}
+
+void EntityTreeZoneIndex::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _zones.clear();
+    _hierarchy.reset();
+    ++_zonesGeneration;
+}
+
+size_t EntityTreeZoneIndex::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _zones.size();
+}
+
+uint64_t EntityTreeZoneIndex::getGeneration() const {
+    // both only go up, so their sum changes whenever either does
+    return _zonesGeneration + ZoneEntityItem::getBoundsChangeCount();
+}
+
+EntityTreeZoneIndex::HierarchyPointer EntityTreeZoneIndex::getHierarchy(uint64_t generation) const {
+    // held while rebuilding, so that the threads looking zones up at once don't all rebuild it
+    if (_hierarchy && _hierarchyGeneration == generation) {
+        return _hierarchy;
+    }
+
+    auto hierarchy = std::make_shared<Hierarchy>();
+    hierarchy->entries.reserve(_zones.size());
+    for (const auto& entry : _zones) {
+        auto zone = entry.second.lock();
+        if (!zone) {
+            continue;
+        }
+        bool success;
+        AABox box = zone->getAABox(success);
+        if (success) {
+            hierarchy->entries.push_back({ box, zone->getVolumeEstimate(), entry.first, zone });
+        }
+    }
+    if (!hierarchy->entries.empty()) {
+        hierarchy->nodes.reserve(2 * hierarchy->entries.size());
+        hierarchy->build(0, (int)hierarchy->entries.size());
+    }
+    _hierarchy = hierarchy;
+    _hierarchyGeneration = generation;
+    return _hierarchy;
+}
+
+int EntityTreeZoneIndex::Hierarchy::build(int first, int count) {
+    int index = (int)nodes.size();
+    nodes.emplace_back();
+    AABox box;
+    for (int i = first; i < first + count; ++i) {
+        box += entries[i].box;
+    }
+    nodes[index].box = box;
+
+    if (count <= MAX_LEAF_SIZE) {
+        nodes[index].first = first;
+        nodes[index].count = count;
+        return index;
+    }
+
+    // split at the median of the centers along the longest side
+    const glm::vec3& dimensions = box.getDimensions();
+    int axis = dimensions.x > dimensions.y ? (dimensions.x > dimensions.z ? 0 : 2) : (dimensions.y > dimensions.z ? 1 : 2);
+    int half = count / 2;
+    std::nth_element(entries.begin() + first, entries.begin() + first + half, entries.begin() + first + count,
+        [axis](const Entry& a, const Entry& b) {
+            return a.box.calcCenter()[axis] < b.box.calcCenter()[axis];
+        });
+    int left = build(first, half);
+    int right = build(first + half, count - half);
+    nodes[index].left = left;
+    nodes[index].right = right;
+    return index;
+}
+
+void EntityTreeZoneIndex::Hierarchy::findBoxesContaining(int index, const glm::vec3& point,
+                                                         std::vector<const Entry*>& found) const {
+    const Node& node = nodes[index];
+    if (!node.box.contains(point)) {
+        return;
+    }
+    if (node.count > 0) {
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            if (entries[i].box.contains(point)) {
+                found.push_back(&entries[i]);
+            }
+        }
+        return;
+    }
+    findBoxesContaining(node.left, point, found);
+    findBoxesContaining(node.right, point, found);
+}
+
+void EntityTreeZoneIndex::Hierarchy::findNearestBoundary(int index, const glm::vec3& point, float& nearest) const {
+    const Node& node = nodes[index];
+    // the boxes of a node are all inside its box, so from outside it none is nearer than it is
+    if (!node.box.contains(point) && distanceToBox(node.box, point) >= nearest) {
+        return;
+    }
+    if (node.count > 0) {
+        for (int i = node.first; i < node.first + node.count; ++i) {
+            nearest = std::min(nearest, distanceToBoxBoundary(entries[i].box, point));
+        }
+        return;
+    }
+    findNearestBoundary(node.left, point, nearest);
+    findNearestBoundary(node.right, point, nearest);
+}
+
+void EntityTreeZoneIndex::findZonesContaining(const glm::vec3& point, std::vector<ZoneEntityItemPointer>& zones,
+                                              Cache* cache) const {
+    zones.clear();
+
+    uint64_t generation = getGeneration();
+    if (cache && cache->generation == generation && glm::distance(point, cache->center) < cache->safeRadius) {
+        // no zone's box was crossed since, so only the shapes need testing again
+        for (const auto& candidate : cache->candidates) {
+            auto zone = candidate.lock();
+            if (zone && zone->contains(point)) {
+                zones.push_back(zone);
+            }
+        }
+        return;
+    }
+
+    HierarchyPointer hierarchy;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        generation = getGeneration();
+        hierarchy = getHierarchy(generation);
+    }
+    if (!hierarchy || hierarchy->nodes.empty()) {
+        if (cache) {
+            cache->generation = generation;
+            cache->center = point;
+            cache->safeRadius = MAX_SAFE_RADIUS;
+            cache->candidates.clear();
+        }
+        return;
+    }
+
+    std::vector<const Entry*> found;
+    hierarchy->findBoxesContaining(0, point, found);
+    // sorted on volume and ID, so that different clients layer zones of the same volume the same way
+    std::sort(found.begin(), found.end(), [](const Entry* a, const Entry* b) {
+        return a->volume < b->volume || (a->volume == b->volume && a->id < b->id);
+    });
+
+    if (cache) {
+        cache->generation = generation;
+        cache->center = point;
+        cache->safeRadius = MAX_SAFE_RADIUS;
+        hierarchy->findNearestBoundary(0, point, cache->safeRadius);
+        cache->candidates.clear();
+    }
+    for (const auto* entry : found) {
+        if (cache) {
+            cache->candidates.push_back(entry->zone);
+        }
+        if (entry->zone->contains(point)) {
+            zones.push_back(entry->zone);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+//
+//  EntityTreeZoneIndex.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeZoneIndex_h
+#define hifi_EntityTreeZoneIndex_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <AABox.h>
+
+#include "EntityItemID.h"
+
+class ZoneEntityItem;
+using ZoneEntityItemPointer = std::shared_ptr<ZoneEntityItem>;
+using ZoneEntityItemWeakPointer = std::weak_ptr<ZoneEntityItem>;
+
+// A bounding volume hierarchy of the zones of a tree, so finding the zones around a point doesn't search every entity
+// near it. It is rebuilt on the next lookup after a zone is added, removed, moved or resized, which is rare next to how
+// often the avatars are checked against the zones.
+//   A Cache remembers, for whoever looks up a moving point, the zones whose boxes hold the point and how far it can go
+// before crossing the box of any zone. While it stays that close and no zone changes, a lookup only tests the point
+// against the shapes of those few zones.
+class EntityTreeZoneIndex {
+public:
+    struct Cache {
+        uint64_t generation { 0 };
+        glm::vec3 center;
+        float safeRadius { 0.0f };
+        std::vector<ZoneEntityItemWeakPointer> candidates;
+    };
+
+    // how far a cached lookup can be reused, at most, to bound the search for the nearest box
+    static const float MAX_SAFE_RADIUS;
+
+    void addZone(const ZoneEntityItemPointer& zone);
+    void removeZone(const EntityItemID& id);
+    void clear();
+    size_t size() const;
+
+    // the zones whose shapes hold the point, smallest first, as a LayeredZone sorts them
+    void findZonesContaining(const glm::vec3& point, std::vector<ZoneEntityItemPointer>& zones, Cache* cache = nullptr) const;
+
+private:
+    struct Entry {
+        AABox box;
+        float volume;
+        EntityItemID id;
+        ZoneEntityItemPointer zone;
+    };
+
+    struct Node {
+        AABox box;
+        int left { -1 };
+        int right { -1 };
+        int first { 0 };
+        int count { 0 }; // > 0 for a leaf
+    };
+
+    struct Hierarchy {
+        std::vector<Entry> entries;
+        std::vector<Node> nodes;
+
+        int build(int first, int count);
+        void findBoxesContaining(int node, const glm::vec3& point, std::vector<const Entry*>& found) const;
+        void findNearestBoundary(int node, const glm::vec3& point, float& nearest) const;
+    };
+    using HierarchyPointer = std::shared_ptr<const Hierarchy>;
+
+    uint64_t getGeneration() const;
+    HierarchyPointer getHierarchy(uint64_t generation) const;
+
+    mutable std::mutex _mutex;
+    std::unordered_map<EntityItemID, ZoneEntityItemWeakPointer> _zones;
+    std::atomic<uint64_t> _zonesGeneration { 1 };
+    mutable HierarchyPointer _hierarchy;
+    mutable uint64_t _hierarchyGeneration { 0 };
+};
+
+#endif // hifi_EntityTreeZoneIndex_h
@@ -92,10 +92,12 @@ void GizmoEntityItem::appendSubclassData(OctreePacketData* packetData, EncodeBit
     bool successPropertyFits = true;
 
     APPEND_ENTITY_PROPERTY(PROP_GIZMO_TYPE, (uint32_t)getGizmoType());
-    withReadLock([&] {
-        _ringProperties.appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
-            propertyFlags, propertiesDidntFit, propertyCount, appendState);
-    });
+    if (_ringProperties.hasRequestedProperties(requestedProperties)) {
+        withReadLock([&] {
+            _ringProperties.appendSubclassData(packetData, params, entityTreeElementExtraEncodeData, requestedProperties,
+                propertyFlags, propertiesDidntFit, propertyCount, appendState);
+        });
+    }
 }
 
 bool GizmoEntityItem::supportsDetailedIntersection() const {
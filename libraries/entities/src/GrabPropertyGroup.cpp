@@ -299,6 +299,14 @@ EntityPropertyFlags GrabPropertyGroup::getEntityProperties(EncodeBitstreamParams
     return requestedProperties;
 }
 
+const EntityPropertyFlags& GrabPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
+
 void GrabPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                            EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                            EntityPropertyFlags& requestedProperties,
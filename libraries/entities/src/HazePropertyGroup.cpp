@@ -306,6 +306,14 @@ EntityPropertyFlags HazePropertyGroup::getEntityProperties(EncodeBitstreamParams
 
     return requestedProperties;
 }
+
+const EntityPropertyFlags& HazePropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
     
 void HazePropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                 EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
@@ -194,6 +194,14 @@ EntityPropertyFlags KeyLightPropertyGroup::getEntityProperties(EncodeBitstreamPa
 
     return requestedProperties;
 }
+
+const EntityPropertyFlags& KeyLightPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
     
 void KeyLightPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params, 
                                 EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
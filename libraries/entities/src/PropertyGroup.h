@@ -56,7 +56,16 @@ public:
     virtual bool setProperties(const EntityItemProperties& properties) = 0;
 
     virtual EntityPropertyFlags getEntityProperties(EncodeBitstreamParams& params) const = 0;
-        
+
+    // all the properties in the group, built once per group type
+    virtual const EntityPropertyFlags& getGroupProperties() const = 0;
+
+    // false if none of the group's properties are requested, so encoding can skip the whole group rather than
+    // checking each of its properties in turn
+    bool hasRequestedProperties(const EntityPropertyFlags& requestedProperties) const {
+        return requestedProperties.intersects(getGroupProperties());
+    }
+
     virtual void appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params, 
                                     EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                     EntityPropertyFlags& requestedProperties,
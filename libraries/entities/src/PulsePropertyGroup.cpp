@@ -206,6 +206,14 @@ EntityPropertyFlags PulsePropertyGroup::getEntityProperties(EncodeBitstreamParam
     return requestedProperties;
 }
 
+const EntityPropertyFlags& PulsePropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
+
 void PulsePropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                            EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                            EntityPropertyFlags& requestedProperties,
@@ -401,6 +401,14 @@ EntityPropertyFlags RingGizmoPropertyGroup::getEntityProperties(EncodeBitstreamP
     return requestedProperties;
 }
 
+const EntityPropertyFlags& RingGizmoPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
+
 void RingGizmoPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                            EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                            EntityPropertyFlags& requestedProperties,
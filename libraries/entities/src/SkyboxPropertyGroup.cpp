@@ -120,6 +120,14 @@ EntityPropertyFlags SkyboxPropertyGroup::getEntityProperties(EncodeBitstreamPara
     
     return requestedProperties;
 }
+
+const EntityPropertyFlags& SkyboxPropertyGroup::getGroupProperties() const {
+    static const EntityPropertyFlags groupProperties = [this] {
+        EncodeBitstreamParams params;
+        return getEntityProperties(params);
+    }();
+    return groupProperties;
+}
     
 void SkyboxPropertyGroup::appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params, 
                                 EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
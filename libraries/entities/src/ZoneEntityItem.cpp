@@ -24,6 +24,7 @@
 
 bool ZoneEntityItem::_zonesArePickable = false;
 bool ZoneEntityItem::_drawZoneBoundaries = false;
+std::atomic<uint64_t> ZoneEntityItem::_boundsChangeCount { 0 };
 
 
 const ShapeType ZoneEntityItem::DEFAULT_SHAPE_TYPE = SHAPE_TYPE_BOX;
@@ -224,17 +225,27 @@ void ZoneEntityItem::appendSubclassData(OctreePacketData* packetData, EncodeBits
     APPEND_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, getCompoundShapeURL());
 
     withReadLock([&] {
-        _keyLightProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
-            propertyFlags, propertiesDidntFit, propertyCount, appendState);
-        _ambientLightProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
+        if (_keyLightProperties.hasRequestedProperties(requestedProperties)) {
+            _keyLightProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
+                propertyFlags, propertiesDidntFit, propertyCount, appendState);
+        }
+        if (_ambientLightProperties.hasRequestedProperties(requestedProperties)) {
+            _ambientLightProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
+                propertyFlags, propertiesDidntFit, propertyCount, appendState);
+        }
+        if (_skyboxProperties.hasRequestedProperties(requestedProperties)) {
+            _skyboxProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
+                propertyFlags, propertiesDidntFit, propertyCount, appendState);
+        }
+    });
+    if (_hazeProperties.hasRequestedProperties(requestedProperties)) {
+        _hazeProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
             propertyFlags, propertiesDidntFit, propertyCount, appendState);
-        _skyboxProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
+    }
+    if (_bloomProperties.hasRequestedProperties(requestedProperties)) {
+        _bloomProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
             propertyFlags, propertiesDidntFit, propertyCount, appendState);
-    });
-    _hazeProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
-        propertyFlags, propertiesDidntFit, propertyCount, appendState);
-    _bloomProperties.appendSubclassData(packetData, params, modelTreeElementExtraEncodeData, requestedProperties,
-        propertyFlags, propertiesDidntFit, propertyCount, appendState);
+    }
 
     APPEND_ENTITY_PROPERTY(PROP_FLYING_ALLOWED, getFlyingAllowed());
     APPEND_ENTITY_PROPERTY(PROP_GHOSTING_ALLOWED, getGhostingAllowed());
@@ -340,6 +351,16 @@ bool ZoneEntityItem::findDetailedParabolaIntersection(const glm::vec3& origin, c
     return _zonesArePickable;
 }
 
+void ZoneEntityItem::locationChanged(bool tellPhysics, bool tellChildren) {
+    EntityItem::locationChanged(tellPhysics, tellChildren);
+    ++_boundsChangeCount;
+}
+
+void ZoneEntityItem::dimensionsChanged() {
+    EntityItem::dimensionsChanged();
+    ++_boundsChangeCount;
+}
+
 bool ZoneEntityItem::contains(const glm::vec3& point) const {
     GeometryResource::Pointer resource = _shapeResource;
     if (getShapeType() == SHAPE_TYPE_COMPOUND && resource) {
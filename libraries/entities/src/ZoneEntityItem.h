@@ -12,6 +12,8 @@
 #ifndef hifi_ZoneEntityItem_h
 #define hifi_ZoneEntityItem_h
 
+#include <atomic>
+
 #include <ComponentMode.h>
 #include <model-networking/ModelCache.h>
 
@@ -63,6 +65,12 @@ public:
     virtual ShapeType getShapeType() const override;
     bool shouldBePhysical() const override { return false; }
 
+    void locationChanged(bool tellPhysics = true, bool tellChildren = true) override;
+    void dimensionsChanged() override;
+
+    // counts the moves and resizes of all the zones, for the zone indexes to know when their boxes are out of date
+    static uint64_t getBoundsChangeCount() { return _boundsChangeCount; }
+
     QString getCompoundShapeURL() const;
     virtual void setCompoundShapeURL(const QString& url);
 
@@ -172,6 +180,7 @@ protected:
 
     static bool _drawZoneBoundaries;
     static bool _zonesArePickable;
+    static std::atomic<uint64_t> _boundsChangeCount;
 
     void fetchCollisionGeometryResource();
     GeometryResource::Pointer _shapeResource;
@@ -2,13 +2,19 @@
 
 #include "GLLogging.h"
 
+#include <future>
+#include <mutex>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonValue>
 #include <QtCore/QJsonObject>
+#include <QtCore/QJsonArray>
+#include <QtCore/QSaveFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QCryptographicHash>
 
 #include <shared/FileUtils.h>
+#include <Profile.h>
 
 using namespace gl;
 
@@ -436,18 +442,39 @@ const QString& getShaderCacheFile() {
 static const char* SHADER_JSON_TYPE_KEY = "type";
 static const char* SHADER_JSON_SOURCE_KEY = "source";
 static const char* SHADER_JSON_DATA_KEY = "data";
+// hashes are base64, so these never collide with them
+static const char* SHADER_JSON_DRIVER_KEY = "_driver";
+static const char* SHADER_JSON_SCOPES_KEY = "_scopes";
+
+struct PersistedShaderCache {
+    std::string driverKey;
+    ShaderCache binaries;
+    ShaderCacheScopes scopes;
+};
 
-void gl::loadShaderCache(ShaderCache& cache) {
+static void readShaderCache(PersistedShaderCache& cache) {
 #if !defined(DISABLE_QML)
+    PROFILE_RANGE(startup, "readShaderCache");
     QString shaderCacheFile = getShaderCacheFile();
     if (QFileInfo(shaderCacheFile).exists()) {
         QString json = FileUtils::readFile(shaderCacheFile);
         auto root = QJsonDocument::fromJson(json.toUtf8()).object();
+        cache.driverKey = root[SHADER_JSON_DRIVER_KEY].toString().toStdString();
+        auto scopesObject = root[SHADER_JSON_SCOPES_KEY].toObject();
+        for (const auto& scope : scopesObject.keys()) {
+            auto& hashes = cache.scopes[scope.toStdString()];
+            for (const auto& hash : scopesObject[scope].toArray()) {
+                hashes.insert(hash.toString().toStdString());
+            }
+        }
         for (const auto& qhash : root.keys()) {
+            if (qhash.startsWith('_')) {
+                continue;
+            }
             auto programObject = root[qhash].toObject();
             QByteArray qbinary = QByteArray::fromBase64(programObject[SHADER_JSON_DATA_KEY].toString().toUtf8());
             std::string hash = qhash.toStdString();
-            auto& cachedShader = cache[hash];
+            auto& cachedShader = cache.binaries[hash];
             cachedShader.binary.resize(qbinary.size());
             memcpy(cachedShader.binary.data(), qbinary.data(), qbinary.size());
             cachedShader.format = (GLenum)programObject[SHADER_JSON_TYPE_KEY].toInt();
@@ -457,7 +484,54 @@ void gl::loadShaderCache(ShaderCache& cache) {
 #endif
 }
 
-void gl::saveShaderCache(const ShaderCache& cache) {
+static std::mutex shaderCachePrefetchMutex;
+static std::future<PersistedShaderCache> shaderCachePrefetch;
+
+std::string gl::getShaderCacheDriverKey() {
+    auto getString = [](GLenum name) {
+        auto value = reinterpret_cast<const char*>(glGetString(name));
+        return std::string(value ? value : "");
+    };
+    return getString(GL_VENDOR) + "|" + getString(GL_RENDERER) + "|" + getString(GL_VERSION);
+}
+
+void gl::prefetchShaderCache() {
+    std::lock_guard<std::mutex> lock(shaderCachePrefetchMutex);
+    if (!shaderCachePrefetch.valid()) {
+        shaderCachePrefetch = std::async(std::launch::async, [] {
+            PersistedShaderCache cache;
+            readShaderCache(cache);
+            return cache;
+        });
+    }
+}
+
+void gl::loadShaderCache(const std::string& driverKey, ShaderCache& cache, ShaderCacheScopes& scopes) {
+    std::future<PersistedShaderCache> prefetch;
+    {
+        std::lock_guard<std::mutex> lock(shaderCachePrefetchMutex);
+        prefetch = std::move(shaderCachePrefetch);
+    }
+    PersistedShaderCache persisted;
+    if (prefetch.valid()) {
+        persisted = prefetch.get();
+    } else {
+        readShaderCache(persisted);
+    }
+
+    // The binaries of another driver or GPU would all fail to load, and the programs they were used by may differ
+    if (persisted.driverKey != driverKey) {
+        if (!persisted.binaries.empty()) {
+            qCDebug(glLogging) << "Discarding the shader cache of" << persisted.driverKey.c_str();
+        }
+        return;
+    }
+    cache = std::move(persisted.binaries);
+    scopes = std::move(persisted.scopes);
+}
+
+void gl::saveShaderCache(const std::string& driverKey, const ShaderCache& cache, const ShaderCacheScopes& scopes) {
+    PROFILE_RANGE(render_gpu, "saveShaderCache");
     QByteArray json;
     {
         QVariantMap variantMap;
@@ -471,15 +545,30 @@ void gl::saveShaderCache(const ShaderCache& cache) {
             qentry[SHADER_JSON_DATA_KEY] = QByteArray{ binary.data(), (int)binary.size() }.toBase64();
             variantMap[key.c_str()] = qentry;
         }
+        QVariantMap scopesMap;
+        for (const auto& scope : scopes) {
+            QVariantList hashes;
+            for (const auto& hash : scope.second) {
+                // only the programs that can be prewarmed
+                if (cache.count(hash) != 0) {
+                    hashes.push_back(QString(hash.c_str()));
+                }
+            }
+            scopesMap[scope.first.c_str()] = hashes;
+        }
+        variantMap[SHADER_JSON_SCOPES_KEY] = scopesMap;
+        variantMap[SHADER_JSON_DRIVER_KEY] = QString(driverKey.c_str());
         json = QJsonDocument::fromVariant(variantMap).toJson(QJsonDocument::Indented);
     }
 
     if (!json.isEmpty()) {
         QString shaderCacheFile = getShaderCacheFile();
-        QFile saveFile(shaderCacheFile);
-        saveFile.open(QFile::WriteOnly | QFile::Text | QFile::Truncate);
+        QSaveFile saveFile(shaderCacheFile);
+        saveFile.open(QFile::WriteOnly | QFile::Text);
         saveFile.write(json);
-        saveFile.close();
+        if (!saveFile.commit()) {
+            qCWarning(glLogging) << "Failed to write the shader cache" << shaderCacheFile;
+        }
     }
 }
 
@@ -90,10 +90,18 @@ struct CachedShader {
 };
 
 using ShaderCache = std::unordered_map<std::string, CachedShader>;
+// The hashes of the programs used under each scope, such as a domain, so that they can be prewarmed on the next visit
+using ShaderCacheScopes = std::unordered_map<std::string, std::unordered_set<std::string>>;
 
 std::string getShaderHash(const std::string& shaderSource);
-void loadShaderCache(ShaderCache& cache);
-void saveShaderCache(const ShaderCache& cache);
+// Identifies the driver and GPU of the current context; binaries persisted under another key are discarded on load
+std::string getShaderCacheDriverKey();
+// Starts reading the persisted program binaries on a worker thread, so that they are ready by the time the backend
+// loads them; call it early during startup, before the GL context is created
+void prefetchShaderCache();
+void loadShaderCache(const std::string& driverKey, ShaderCache& cache, ShaderCacheScopes& scopes);
+// Thread-safe, the file is replaced atomically so that it can be written from a worker thread
+void saveShaderCache(const std::string& driverKey, const ShaderCache& cache, const ShaderCacheScopes& scopes);
 
 #ifdef SEPARATE_PROGRAM
 bool compileShader(GLenum shaderDomain,
@@ -77,6 +77,8 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
     (&::gpu::gl::GLBackend::do_endQuery),
     (&::gpu::gl::GLBackend::do_getQuery),
 
+    (&::gpu::gl::GLBackend::do_readFramebuffer),
+
     (&::gpu::gl::GLBackend::do_resetStages),
 
     (&::gpu::gl::GLBackend::do_disableContextViewCorrection),
@@ -285,6 +287,7 @@ void GLBackend::shutdown() {
         glDeleteFramebuffers(1, &_mipGenerationFramebufferId);
         _mipGenerationFramebufferId = 0;
     }
+    killReadbacks();
     killInput();
     killTransform();
     killTextureManagementStage();
@@ -995,6 +998,7 @@ void GLBackend::recycle() const {
     }
     
     _textureManagement._transferEngine->manageMemory();
+    updateShaderBinaryCache();
 }
 
 void GLBackend::setCameraCorrection(const Mat4& correction, const Mat4& prevRenderView, bool reset) {
@@ -13,6 +13,7 @@
 
 #include <assert.h>
 #include <functional>
+#include <future>
 #include <memory>
 #include <bitset>
 #include <queue>
@@ -29,6 +30,7 @@
 #include <gpu/Context.h>
 
 #include "GLShared.h"
+#include "GLBufferRing.h"
 
 // Different versions for the stereo drawcall
 // Current preferred is  "instanced" which draw the shape twice but instanced and rely on clipping plane to draw left/right side only
@@ -132,6 +134,8 @@ public:
 
     void syncProgram(const gpu::ShaderPointer& program) override;
 
+    void setShaderCacheScope(const std::string& scope) override;
+
     // This is the ugly "download the pixels to sysmem for taking a snapshot"
     // Just avoid using it, it's ugly and will break performances
     virtual void downloadFramebuffer(const FramebufferPointer& srcFramebuffer,
@@ -206,6 +210,9 @@ public:
     virtual void do_endQuery(const Batch& batch, size_t paramOffset) final;
     virtual void do_getQuery(const Batch& batch, size_t paramOffset) final;
 
+    // Readback section
+    virtual void do_readFramebuffer(const Batch& batch, size_t paramOffset) final;
+
     // Reset stages
     virtual void do_resetStages(const Batch& batch, size_t paramOffset) final;
 
@@ -427,6 +434,13 @@ protected:
         GLuint _cameraBuffer{ 0 };
         GLuint _drawCallInfoBuffer{ 0 };
         GLuint _objectBufferTexture{ 0 };
+        // Where the backends that can stream the transforms of a batch write them, rather than into the buffers above
+        mutable GLBufferRing _streamRing;
+        // The buffer and offset the cameras of the batch are in, or 0 for the start of _cameraBuffer
+        mutable GLuint _currentCameraBuffer{ 0 };
+        mutable size_t _currentCameraBufferOffset{ 0 };
+        // The buffer the offsets of the draw call infos of the named calls are in
+        mutable GLuint _currentDrawCallInfoBuffer{ 0 };
         size_t _cameraUboSize{ 0 };
         bool _viewIsCamera{ false };
         bool _skybox{ false };
@@ -443,6 +457,7 @@ protected:
         bool _invalidViewport{ false };
 
         bool _enabledDrawcallInfoBuffer{ false };
+        bool _drawCallInfoStereo{ false }; // whether the draw call info rate was last set for stereo
 
         using Pair = std::pair<size_t, size_t>;
         using List = std::list<Pair>;
@@ -582,20 +597,49 @@ protected:
         uint32_t _rangeQueryDepth{ 0 };
     } _queryStage;
 
+    // Hands the readbacks whose pixels the gpu has copied to their handlers, in the order they were read
+    void resolveReadbacks();
+    void killReadbacks();
+    struct ReadbackStageState {
+        struct Pending {
+            ReadbackPointer _readback;
+            Element _format;
+            Vec2u _size;
+            GLuint _buffer { 0 };
+            GLsync _fence { 0 };
+        };
+        std::list<Pending> _pending;
+        std::vector<GLuint> _freeBuffers;
+    } _readbackStage;
+
     void resetStages();
 
     // Stores cached binary versions of the shaders for quicker startup on subsequent runs
     // Note that shaders in the cache can still fail to load due to hardware or driver
     // changes that invalidate the cached binary, in which case we fall back on compiling
     // the source again
+    // The cache is keyed by the driver and GPU, and saved on a worker thread a while after new programs were linked.
+    // The programs used under each scope (the domain being visited) are recorded, and the ones with a cached binary
+    // are built a few per frame when the scope is set again, ahead of their first use
     struct ShaderBinaryCache {
         std::mutex _mutex;
         std::vector<GLint> _formats;
+        std::string _driverKey;
         std::unordered_map<std::string, ::gl::CachedShader> _binaries;
-    } _shaderBinaryCache;
+        ::gl::ShaderCacheScopes _scopes;
+        std::string _scope;
+        std::vector<std::string> _toPrewarm;
+        std::unordered_map<std::string, GLuint> _prewarmed;
+        bool _isDirty { false };
+        quint64 _lastSave { 0 };
+        std::future<void> _pendingSave;
+    };
+    mutable ShaderBinaryCache _shaderBinaryCache;
 
     virtual void initShaderBinaryCache();
     virtual void killShaderBinaryCache();
+    // prewarms the programs of the scope and saves the cache when due, called once per frame
+    void updateShaderBinaryCache() const;
 
     struct TextureManagementStageState {
         bool _sparseCapable{ false };
@@ -11,6 +11,7 @@
 #include "GLBackend.h"
 #include "GLShared.h"
 #include "GLFramebuffer.h"
+#include "GLTexelFormat.h"
 
 #include <QtGui/QImage>
 
@@ -204,3 +205,95 @@ void GLBackend::downloadFramebuffer(const FramebufferPointer& srcFramebuffer, co
 
     (void) CHECK_GL_ERROR();
 }
+
+void GLBackend::do_readFramebuffer(const Batch& batch, size_t paramOffset) {
+    resolveReadbacks();
+
+    auto framebuffer = batch._framebuffers.get(batch._params[paramOffset]._uint);
+    Vec4i region;
+    for (auto i = 0; i < 4; ++i) {
+        region[i] = batch._params[paramOffset + 1 + i]._int;
+    }
+    auto readback = batch._readbacks.get(batch._params[paramOffset + 5]._uint);
+    if (!framebuffer || !readback || !framebuffer->getRenderBuffer(0) || region.x < 0 || region.y < 0 ||
+        region.z <= 0 || region.w <= 0 || (int)framebuffer->getWidth() < (region.x + region.z) ||
+        (int)framebuffer->getHeight() < (region.y + region.w)) {
+        qCWarning(gpugllogging) << "GLBackend::do_readFramebuffer : the framebuffer has no color buffer covering the region to read";
+        return;
+    }
+
+    ReadbackStageState::Pending pending;
+    pending._readback = readback;
+    pending._format = framebuffer->getRenderBuffer(0)->getTexelFormat();
+    pending._size = Vec2u(region.z, region.w);
+    GLTexelFormat texelFormat = GLTexelFormat::evalGLTexelFormat(pending._format);
+
+    auto& freeBuffers = _readbackStage._freeBuffers;
+    if (freeBuffers.empty()) {
+        glGenBuffers(1, &pending._buffer);
+    } else {
+        pending._buffer = freeBuffers.back();
+        freeBuffers.pop_back();
+    }
+
+    // the pixels are copied into the buffer once the gpu has drawn them, without waiting for it here
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pending._buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)pending._size.x * pending._size.y * pending._format.getSize(), nullptr, GL_STREAM_READ);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, getFramebufferID(framebuffer));
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(region.x, region.y, region.z, region.w, texelFormat.format, texelFormat.type, nullptr);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    pending._fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _readbackStage._pending.push_back(pending);
+
+    (void) CHECK_GL_ERROR();
+}
+
+void GLBackend::resolveReadbacks() {
+    auto& pendings = _readbackStage._pending;
+    while (!pendings.empty()) {
+        auto& pending = pendings.front();
+        GLenum status = glClientWaitSync(pending._fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+
+        if (status != GL_WAIT_FAILED) {
+            size_t size = (size_t)pending._size.x * pending._size.y * pending._format.getSize();
+            Readback::Pixels pixels(size);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pending._buffer);
+            const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)size, GL_MAP_READ_BIT);
+            if (mapped) {
+                memcpy(pixels.data(), mapped, size);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            if (mapped) {
+                pending._readback->triggerReturnHandler(pending._format, pending._size, std::move(pixels));
+            }
+        }
+
+        glDeleteSync(pending._fence);
+        _readbackStage._freeBuffers.push_back(pending._buffer);
+        pendings.pop_front();
+    }
+
+    (void) CHECK_GL_ERROR();
+}
+
+void GLBackend::killReadbacks() {
+    for (auto& pending : _readbackStage._pending) {
+        glDeleteSync(pending._fence);
+        glDeleteBuffers(1, &pending._buffer);
+    }
+    _readbackStage._pending.clear();
+    auto& freeBuffers = _readbackStage._freeBuffers;
+    if (!freeBuffers.empty()) {
+        glDeleteBuffers((GLsizei)freeBuffers.size(), freeBuffers.data());
+        freeBuffers.clear();
+    }
+}
@@ -8,6 +8,8 @@
 #include "GLBackend.h"
 #include "GLShader.h"
 #include <gl/GLShaders.h>
+#include <Profile.h>
+#include <SharedUtil.h>
 
 using namespace gpu;
 using namespace gpu::gl;
@@ -105,16 +107,24 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
         auto hash = ::gl::getShaderHash(programSource);
 
         CachedShader cachedBinary;
+        GLuint glprogram = 0;
         {
             Lock shaderCacheLock{ _shaderBinaryCache._mutex };
-            if (_shaderBinaryCache._binaries.count(hash) != 0) {
+            if (!_shaderBinaryCache._scope.empty() && _shaderBinaryCache._scopes[_shaderBinaryCache._scope].insert(hash).second) {
+                _shaderBinaryCache._isDirty = true;
+            }
+            auto prewarmed = _shaderBinaryCache._prewarmed.find(hash);
+            if (prewarmed != _shaderBinaryCache._prewarmed.end()) {
+                glprogram = prewarmed->second;
+                _shaderBinaryCache._prewarmed.erase(prewarmed);
+                ++gpuBinaryShadersLoaded;
+            } else if (_shaderBinaryCache._binaries.count(hash) != 0) {
                 cachedBinary = _shaderBinaryCache._binaries[hash];
             }
         }
 
-        GLuint glprogram = 0;
         // If we have a cached binary program, try to load it instead of compiling the individual shaders
-        if (cachedBinary) {
+        if (0 == glprogram && cachedBinary) {
             glprogram = ::gl::buildProgram(cachedBinary);
             if (0 != glprogram) {
                 ++gpuBinaryShadersLoaded;
@@ -122,6 +132,7 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
                 cachedBinary = CachedShader();
                 std::unique_lock<std::mutex> shaderCacheLock{ _shaderBinaryCache._mutex };
                 _shaderBinaryCache._binaries.erase(hash);
+                _shaderBinaryCache._isDirty = true;
             }
         }
 
@@ -159,6 +170,7 @@ GLShader* GLBackend::compileBackendProgram(const Shader& program, const Shader::
                 cachedBinary.source = programSource;
                 std::unique_lock<std::mutex> shaderCacheLock{ _shaderBinaryCache._mutex };
                 _shaderBinaryCache._binaries[hash] = cachedBinary;
+                _shaderBinaryCache._isDirty = true;
             }
         }
 
@@ -397,10 +409,77 @@ void GLBackend::initShaderBinaryCache() {
         _shaderBinaryCache._formats.resize(numBinFormats);
         glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, _shaderBinaryCache._formats.data());
     }
-    ::gl::loadShaderCache(_shaderBinaryCache._binaries);
+    _shaderBinaryCache._driverKey = ::gl::getShaderCacheDriverKey();
+    ::gl::loadShaderCache(_shaderBinaryCache._driverKey, _shaderBinaryCache._binaries, _shaderBinaryCache._scopes);
+    _shaderBinaryCache._lastSave = usecTimestampNow();
 }
 
 void GLBackend::killShaderBinaryCache() {
-    ::gl::saveShaderCache(_shaderBinaryCache._binaries);
+    if (_shaderBinaryCache._pendingSave.valid()) {
+        _shaderBinaryCache._pendingSave.wait();
+    }
+    Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+    for (const auto& prewarmed : _shaderBinaryCache._prewarmed) {
+        glDeleteProgram(prewarmed.second);
+    }
+    _shaderBinaryCache._prewarmed.clear();
+    ::gl::saveShaderCache(_shaderBinaryCache._driverKey, _shaderBinaryCache._binaries, _shaderBinaryCache._scopes);
 }
 
+void GLBackend::setShaderCacheScope(const std::string& scope) {
+    Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+    if (scope == _shaderBinaryCache._scope) {
+        return;
+    }
+    _shaderBinaryCache._scope = scope;
+    _shaderBinaryCache._toPrewarm.clear();
+    auto scopeHashes = _shaderBinaryCache._scopes.find(scope);
+    if (scopeHashes != _shaderBinaryCache._scopes.end()) {
+        for (const auto& hash : scopeHashes->second) {
+            if (_shaderBinaryCache._binaries.count(hash) != 0 && _shaderBinaryCache._prewarmed.count(hash) == 0) {
+                _shaderBinaryCache._toPrewarm.push_back(hash);
+            }
+        }
+    }
+}
+
+void GLBackend::updateShaderBinaryCache() const {
+    // Building a program from its binary is much cheaper than compiling it, but not free
+    static const size_t MAX_PREWARMED_PROGRAMS_PER_FRAME = 8;
+    // New programs come in bursts, such as when a domain loads, so wait for the burst to be over
+    static const quint64 SAVE_INTERVAL_USECS = 30 * USECS_PER_SECOND;
+
+    Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+    if (!_shaderBinaryCache._toPrewarm.empty()) {
+        PROFILE_RANGE(render_gpu_gl, "prewarmShaderBinaries");
+        size_t numPrewarmed = 0;
+        while (!_shaderBinaryCache._toPrewarm.empty() && numPrewarmed < MAX_PREWARMED_PROGRAMS_PER_FRAME) {
+            auto hash = _shaderBinaryCache._toPrewarm.back();
+            _shaderBinaryCache._toPrewarm.pop_back();
+            auto cachedBinary = _shaderBinaryCache._binaries.find(hash);
+            if (cachedBinary == _shaderBinaryCache._binaries.end() || _shaderBinaryCache._prewarmed.count(hash) != 0) {
+                continue;
+            }
+            GLuint glprogram = ::gl::buildProgram(cachedBinary->second);
+            if (0 != glprogram) {
+                _shaderBinaryCache._prewarmed[hash] = glprogram;
+            } else {
+                _shaderBinaryCache._binaries.erase(cachedBinary);
+                _shaderBinaryCache._isDirty = true;
+            }
+            ++numPrewarmed;
+        }
+    }
+
+    auto now = usecTimestampNow();
+    if (_shaderBinaryCache._isDirty && (now - _shaderBinaryCache._lastSave) > SAVE_INTERVAL_USECS &&
+        !(_shaderBinaryCache._pendingSave.valid() &&
+          _shaderBinaryCache._pendingSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready)) {
+        _shaderBinaryCache._isDirty = false;
+        _shaderBinaryCache._lastSave = now;
+        _shaderBinaryCache._pendingSave = std::async(std::launch::async,
+            [driverKey = _shaderBinaryCache._driverKey, binaries = _shaderBinaryCache._binaries, scopes = _shaderBinaryCache._scopes] {
+                ::gl::saveShaderCache(driverKey, binaries, scopes);
+            });
+    }
+}
@@ -77,6 +77,7 @@ void GLBackend::killTransform() {
     glDeleteBuffers(1, &_transform._cameraBuffer);
     glDeleteBuffers(1, &_transform._drawCallInfoBuffer);
     glDeleteTextures(1, &_transform._objectBufferTexture);
+    _transform._streamRing.destroy();
 }
 
 void GLBackend::syncTransformStateCache() {
@@ -169,7 +170,9 @@ void GLBackend::TransformStageState::update(size_t commandIndex, const StereoSta
 void GLBackend::TransformStageState::bindCurrentCamera(int eye) const {
     if (_currentCameraOffset != INVALID_OFFSET) {
         static_assert(slot::buffer::Buffer::CameraTransform >= MAX_NUM_UNIFORM_BUFFERS, "TransformCamera may overlap pipeline uniform buffer slots. Invalidate uniform buffer slot cache for safety (call _uniform._buffers[TRANSFORM_CAMERA_SLOT].reset()).");
-        glBindBufferRange(GL_UNIFORM_BUFFER, slot::buffer::Buffer::CameraTransform, _cameraBuffer, _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
+        GLuint cameraBuffer = _currentCameraBuffer ? _currentCameraBuffer : _cameraBuffer;
+        glBindBufferRange(GL_UNIFORM_BUFFER, slot::buffer::Buffer::CameraTransform, cameraBuffer,
+                          _currentCameraBufferOffset + _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
     }
 }
 
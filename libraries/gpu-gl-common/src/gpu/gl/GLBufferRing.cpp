@@ -0,0 +1,89 @@
+//
+//  GLBufferRing.cpp
+//  libraries/gpu-gl-common/src/gpu/gl
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "GLBufferRing.h"
+
+using namespace gpu;
+using namespace gpu::gl;
+
+void GLBufferRing::create(size_t regionSize, size_t alignment) {
+    destroy();
+#if !defined(USE_GLES)
+    if (!GLAD_GL_VERSION_4_4) {
+        return;
+    }
+    _alignment = std::max<size_t>(alignment, 1);
+    _regionSize = ((regionSize + _alignment - 1) / _alignment) * _alignment;
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GLsizeiptr size = (GLsizeiptr)(_regionSize * REGION_COUNT);
+    glGenBuffers(1, &_buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer);
+    glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+    _mapped = (uint8_t*)glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    if (!_mapped) {
+        qCWarning(gpugllogging) << "GLBufferRing::create : could not map a buffer of" << size << "bytes";
+        destroy();
+        return;
+    }
+    _region = 0;
+    _head = 0;
+#endif
+    (void)CHECK_GL_ERROR();
+}
+
+void GLBufferRing::destroy() {
+    for (auto& fence : _fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+    if (_buffer) {
+        if (_mapped) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            _mapped = nullptr;
+        }
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+}
+
+uint8_t* GLBufferRing::allocate(size_t size, size_t& offset) {
+    if (!_mapped || size == 0 || size > _regionSize) {
+        return nullptr;
+    }
+    if (_head + size > _regionSize) {
+        nextRegion();
+    }
+    offset = _region * _regionSize + _head;
+    _head += ((size + _alignment - 1) / _alignment) * _alignment;
+    return _mapped + offset;
+}
+
+void GLBufferRing::nextRegion() {
+    // What reads the region left is all issued already
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _region = (_region + 1) % REGION_COUNT;
+    _head = 0;
+
+    auto& fence = _fences[_region];
+    if (fence) {
+        static const GLuint64 TIMEOUT = 1000000000ULL;
+        GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT);
+        while (status == GL_TIMEOUT_EXPIRED) {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT);
+        }
+        glDeleteSync(fence);
+        fence = 0;
+    }
+}
@@ -0,0 +1,51 @@
+//
+//  GLBufferRing.h
+//  libraries/gpu-gl-common/src/gpu/gl
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#ifndef hifi_gpu_gl_GLBufferRing_h
+#define hifi_gpu_gl_GLBufferRing_h
+
+#include "GLShared.h"
+
+namespace gpu { namespace gl {
+
+// A buffer mapped once and for all for writing, split into regions which the gpu reads while the next ones are written.
+// Once the writes move past a region, a fence marks when the gpu is done with what it was given from there, and the
+// region is only written again once the gpu got past that fence.
+class GLBufferRing {
+public:
+    static const int REGION_COUNT = 3;
+
+    // Needs buffer storage, from OpenGL 4.4, isValid() is false without it
+    void create(size_t regionSize, size_t alignment);
+    // Must be called, with the context current, before the ring goes
+    void destroy();
+
+    bool isValid() const { return _buffer != 0; }
+    GLuint getBuffer() const { return _buffer; }
+
+    // Reserves size bytes in the current region and returns where they are mapped, with offset set to where they are in
+    // the buffer, or returns nullptr if they are more than a region holds
+    uint8_t* allocate(size_t size, size_t& offset);
+
+private:
+    void nextRegion();
+
+    GLuint _buffer { 0 };
+    uint8_t* _mapped { nullptr };
+    size_t _regionSize { 0 };
+    size_t _alignment { 1 };
+    int _region { 0 };
+    size_t _head { 0 };
+    GLsync _fences[REGION_COUNT] {};
+};
+
+} }
+
+#endif
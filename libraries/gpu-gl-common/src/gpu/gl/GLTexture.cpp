@@ -244,6 +244,7 @@ TransferJob::TransferJob(const Texture& texture,
         _transferSize = bytesPerLine * lines;
     }
 
+    Backend::texturePendingGPUTransferCount.increment();
     Backend::texturePendingGPUTransferMemSize.update(0, _transferSize);
 
     if (_transferSize > GLVariableAllocationSupport::MAX_TRANSFER_SIZE) {
@@ -261,11 +262,21 @@ TransferJob::TransferJob(const Texture& texture,
         }
     };
 
-    _transferLambda = [=](const TexturePointer& texture) {
+    _transferLambda = [=](const TexturePointer& texture, GLBufferRing* stagingRing) {
         if (_mipData) {
             auto gltexture = Backend::getGPUObject<GLTexture>(*texture);
-            gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
-                type, _mipData->size(), _mipData->readData());
+            size_t stagingOffset = 0;
+            uint8_t* staging = stagingRing ? stagingRing->allocate(_mipData->size(), stagingOffset) : nullptr;
+            if (staging) {
+                memcpy(staging, _mipData->readData(), _mipData->size());
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, stagingRing->getBuffer());
+                gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
+                    type, _mipData->size(), reinterpret_cast<const void*>(stagingOffset));
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            } else {
+                gltexture->copyMipFaceLinesFromTexture(targetMip, face, transferDimensions, lineOffset, internalFormat, format,
+                    type, _mipData->size(), _mipData->readData());
+            }
             _mipData.reset();
         } else {
             qCWarning(gpugllogging) << "Transfer failed because mip could not be retrieved from texture "
@@ -275,9 +286,12 @@ TransferJob::TransferJob(const Texture& texture,
 }
 
 TransferJob::TransferJob(uint16_t sourceMip, const std::function<void()>& transferLambda) :
-    _sourceMip(sourceMip), _bufferingRequired(false), _transferLambda([=](const TexturePointer&) { transferLambda(); }) {}
+    _sourceMip(sourceMip), _bufferingRequired(false), _transferLambda([=](const TexturePointer&, GLBufferRing*) { transferLambda(); }) {
+    Backend::texturePendingGPUTransferCount.increment();
+}
 
 TransferJob::~TransferJob() {
+    Backend::texturePendingGPUTransferCount.decrement();
     Backend::texturePendingGPUTransferMemSize.update(_transferSize, 0);
 }
 
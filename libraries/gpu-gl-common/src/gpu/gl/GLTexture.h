@@ -69,13 +69,14 @@ public:
     using Pointer = std::shared_ptr<TransferJob>;
     using Queue = std::queue<Pointer>;
     using Lambda = std::function<void(const TexturePointer&)>;
+    using TransferLambda = std::function<void(const TexturePointer&, GLBufferRing*)>;
 private:
     Texture::PixelsPointer _mipData;
     size_t _transferOffset{ 0 };
     size_t _transferSize{ 0 };
     uint16_t _sourceMip{ 0 };
     bool _bufferingRequired{ true };
-    Lambda _transferLambda{ [](const TexturePointer&) {} };
+    TransferLambda _transferLambda{ [](const TexturePointer&, GLBufferRing*) {} };
     Lambda _bufferingLambda{ [](const TexturePointer&) {} };
 public:
     TransferJob(const TransferJob& other) = delete;
@@ -86,7 +87,9 @@ public:
     const size_t& size() const { return _transferSize; }
     bool bufferingRequired() const { return _bufferingRequired; }
     void buffer(const TexturePointer& texture) { _bufferingLambda(texture); }
-    void transfer(const TexturePointer& texture) { _transferLambda(texture); }
+    // The buffered data gets copied into the staging ring, when there is one and it has room for it, for the gpu to
+    // pull the texels from there rather than the driver copying them out of the cpu memory before returning
+    void transfer(const TexturePointer& texture, GLBufferRing* stagingRing = nullptr) { _transferLambda(texture, stagingRing); }
 };
 
 using TransferJobPointer = std::shared_ptr<TransferJob>;
@@ -102,10 +105,16 @@ public:
 
     void sanityCheck() const;
     uint16 populatedMip() const { return _populatedMip; }
-    bool canPromote() const { return _allocatedMip > _minAllocatedMip; }
+    bool canPromote() const { return _allocatedMip > getMinPromotionMip(); }
     bool canDemote() const { return _allocatedMip < _maxAllocatedMip; }
     bool hasPendingTransfers() const { return _populatedMip > _allocatedMip; }
 
+    // the finest mip the renderer has wanted lately, see gpu::Texture::getDesiredMip()
+    void setDesiredMip(uint16 desiredMip) { _desiredMip = desiredMip; }
+    // promoting past the desired mip would only take memory for texels no one sees
+    uint16 getMinPromotionMip() const { return std::max(_minAllocatedMip, std::min(_desiredMip, _maxAllocatedMip)); }
+    bool isAllocatedPastDesiredMip() const { return _allocatedMip < std::min(_desiredMip, _maxAllocatedMip); }
+
     virtual size_t promote() = 0;
     virtual size_t demote() = 0;
 
@@ -136,6 +145,8 @@ protected:
     // The lowest (highest resolution) mip that we will support, relative to the number
     // of mips in the gpu::Texture object
     uint16 _minAllocatedMip { 0 };
+    // The mip the renderer wants, relative to the number of mips in the gpu::Texture object
+    uint16 _desiredMip { 0 };
 };
 
 class GLTexture : public GLObject<Texture> {
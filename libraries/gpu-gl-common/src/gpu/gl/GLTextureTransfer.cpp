@@ -23,6 +23,7 @@
 #define THREADED_TEXTURE_BUFFERING 1
 #define MAX_AUTO_FRACTION_OF_TOTAL_MEMORY 0.8f
 #define AUTO_RESERVE_TEXTURE_MEMORY MB_TO_BYTES(64)
+#define MAX_TRANSFER_BYTES_PER_FRAME MB_TO_BYTES(16)
 
 static const size_t DEFAULT_ALLOWED_TEXTURE_MEMORY = MB_TO_BYTES(DEFAULT_ALLOWED_TEXTURE_MEMORY_MB);
 
@@ -116,6 +117,10 @@ private:
     // This contains a map of all textures to queues of pending transfer jobs.  While in the transfer state, this map is used to
     // populate the _activeBufferQueue up to the limit specified in GLVariableAllocationTexture::MAX_BUFFER_SIZE
     TransferMap _pendingTransfersMap;
+    // Persistently mapped pixel unpack buffer the transfers stage their texels through, so the upload calls return
+    // without the driver copying the texels first, with fences keeping the regions the gpu still reads from untouched
+    GLBufferRing _stagingRing;
+    bool _stagingRingCreated{ false };
 };
 
 }}  // namespace gpu::gl
@@ -164,12 +169,14 @@ void GLTextureTransferEngineDefault::shutdown() {
         _transferThread = nullptr;
     }
 #endif
+    _stagingRing.destroy();
 }
 
 void GLTextureTransferEngineDefault::manageMemory() {
     PROFILE_RANGE(render_gpu_gl, __FUNCTION__);
     // reset the count used to limit the number of textures created per frame
     resetFrameTextureCreated();
+    Backend::textureFrameGPUTransferMemSize.set(0);
     // Determine the current memory management state.  It will be either idle (no work to do),
     // undersubscribed (need to do more allocation) or transfer (need to upload content from the
     // backing store to the GPU
@@ -220,9 +227,10 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         vartexture->sanityCheck();
+        vartexture->setDesiredMip(texture->updateDesiredMip());
 
         // Track how much the texture thinks it should be using
-        idealMemoryAllocation += texture->evalTotalSize();
+        idealMemoryAllocation += texture->evalTotalSize(std::min(texture->getDesiredMip(), texture->getMaxMip()));
         // Track how much we're actually using
         totalVariableMemoryAllocation += gltexture->size();
         if (!gltexture->_gpuObject.getImportant() && vartexture->canDemote()) {
@@ -237,7 +245,9 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     }
 
     Backend::textureResourceIdealGPUMemSize.set(idealMemoryAllocation);
-    size_t unallocated = idealMemoryAllocation - totalVariableMemoryAllocation;
+    // textures allocated past the mip they're wanted at can take more than the ideal
+    size_t unallocated = idealMemoryAllocation > totalVariableMemoryAllocation ?
+        idealMemoryAllocation - totalVariableMemoryAllocation : 0;
     float pressure = 0;
 
     if (useAvailableGlMemory) {
@@ -322,8 +332,15 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
     processActiveBufferQueue();
 #endif
 
+    if (!_stagingRingCreated) {
+        _stagingRingCreated = true;
+        _stagingRing.create(GLVariableAllocationSupport::MAX_TRANSFER_SIZE, 4);
+    }
+
     // Take any tasks which have completed buffering and process them, uploading the buffered
-    // data to the GPU.  Drains the _activeTransferQueue
+    // data to the GPU.  Drains the _activeTransferQueue, up to MAX_TRANSFER_BYTES_PER_FRAME so that
+    // many textures finishing their buffering at once don't all land in the same frame
+    size_t transferredBytes = 0;
     {
         ActiveTransferQueue activeTransferQueue;
         {
@@ -331,20 +348,28 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
             activeTransferQueue.swap(_activeTransferQueue);
         }
 
-        while (!activeTransferQueue.empty()) {
+        while (!activeTransferQueue.empty() && transferredBytes < MAX_TRANSFER_BYTES_PER_FRAME) {
             const auto& activeTransferJob = activeTransferQueue.front();
             const auto& texturePointer = activeTransferJob.first;
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texturePointer);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             const auto& tranferJob = activeTransferJob.second;
             if (tranferJob->sourceMip() < vargltexture->populatedMip()) {
-                tranferJob->transfer(texturePointer);
+                transferredBytes += tranferJob->size();
+                tranferJob->transfer(texturePointer, _stagingRing.isValid() ? &_stagingRing : nullptr);
             }
             // The pop_front MUST be the last call since all of these varaibles in scope are
             // references that will be invalid after the pop
             activeTransferQueue.pop_front();
         }
+
+        // What is left over the budget goes back ahead of what got buffered since, to keep the jobs in order
+        if (!activeTransferQueue.empty()) {
+            Lock lock(_bufferMutex);
+            _activeTransferQueue.splice(_activeTransferQueue.begin(), activeTransferQueue);
+        }
     }
+    Backend::textureFrameGPUTransferMemSize.set(transferredBytes);
 
     // If we have no more work in any of the structures, reset the memory state to idle to
     // force reconstruction of the _pendingTransfersMap if necessary
@@ -504,29 +529,37 @@ void GLTextureTransferEngineDefault::processPromotes() {
 }
 
 void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+    // Demote the textures allocated past the mip they're wanted at first, as they lose nothing anyone sees, then
+    // the rest, largest first
+    ImmediateWorkQueue pastDesiredQueue;
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         if (!gltexture->_gpuObject.getImportant() && vargltexture->canDemote()) {
-            demoteQueue.push({ texture, (float)gltexture->size() });
+            if (vargltexture->isAllocatedPastDesiredMip()) {
+                pastDesiredQueue.push({ texture, (float)gltexture->size() });
+            } else {
+                demoteQueue.push({ texture, (float)gltexture->size() });
+            }
         }
     }
 
     size_t relieved = 0;
-    while (!demoteQueue.empty() && relieved < reliefRequired) {
-        {
-            const auto& target = demoteQueue.top();
-            const auto& texture = target.first;
-            GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
-            auto oldSize = gltexture->size();
-            GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            vargltexture->demote();
-            auto newSize = gltexture->size();
-            relieved += (oldSize - newSize);
+    for (auto queue : { &pastDesiredQueue, &demoteQueue }) {
+        while (!queue->empty() && relieved < reliefRequired) {
+            {
+                const auto& target = queue->top();
+                const auto& texture = target.first;
+                GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
+                auto oldSize = gltexture->size();
+                GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+                vargltexture->demote();
+                auto newSize = gltexture->size();
+                relieved += (oldSize - newSize);
+            }
+            queue->pop();
         }
-        demoteQueue.pop();
     }
 }
 
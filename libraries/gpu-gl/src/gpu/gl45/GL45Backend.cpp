@@ -187,7 +187,8 @@ void GL45Backend::do_multiDrawIndexedIndirect(const Batch& batch, size_t paramOf
     GLenum mode = gl::PRIMITIVE_TO_GL[(Primitive)batch._params[paramOffset + 1]._uint];
     GLenum indexType = gl::ELEMENT_TYPE_TO_GL[_input._indexBufferType];
     glMultiDrawElementsIndirect(mode, indexType, reinterpret_cast<GLvoid*>(_input._indirectBufferOffset), commandCount, (GLsizei)_input._indirectBufferStride);
-    _stats._DSNumDrawcalls += commandCount;
+    // in stereo the commands draw an instance per eye, which updateTransform gives the same draw call info
+    _stats._DSNumDrawcalls += (isStereo() ? 2 : 1) * commandCount;
     _stats._DSNumAPIDrawcalls++;
     (void)CHECK_GL_ERROR();
 }
@@ -13,6 +13,9 @@
 using namespace gpu;
 using namespace gpu::gl45;
 
+// Enough for the transforms of about 30000 objects per region
+static const size_t TRANSFORM_RING_REGION_SIZE = 4 * 1024 * 1024;
+
 void GL45Backend::initTransform() {
     GLuint transformBuffers[3];
     glCreateBuffers(3, transformBuffers);
@@ -27,41 +30,95 @@ void GL45Backend::initTransform() {
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += UNIFORM_BUFFER_OFFSET_ALIGNMENT;
     }
+
+    // The ring's allocations get bound as uniform, storage and texture buffers
+    GLint storageAlignment = 1;
+    GLint textureAlignment = 1;
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &textureAlignment);
+    size_t alignment = (size_t)std::max(UNIFORM_BUFFER_OFFSET_ALIGNMENT, std::max(storageAlignment, textureAlignment));
+    _transform._streamRing.create(TRANSFORM_RING_REGION_SIZE, alignment);
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
     // FIXME not thread safe
     static std::vector<uint8_t> bufferData;
+    auto& ring = _transform._streamRing;
+
+    // The batch's data goes straight into the ring when it fits in there, or else through the buffers of each kind
+    _transform._currentCameraBuffer = _transform._cameraBuffer;
+    _transform._currentCameraBufferOffset = 0;
     if (!_transform._cameras.empty()) {
-        bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
+        size_t size = _transform._cameraUboSize * _transform._cameras.size();
+        size_t offset = 0;
+        uint8_t* data = ring.allocate(size, offset);
+        if (data) {
+            _transform._currentCameraBuffer = ring.getBuffer();
+            _transform._currentCameraBufferOffset = offset;
+        } else {
+            bufferData.resize(size);
+            data = bufferData.data();
+        }
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            memcpy(data + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+        }
+        if (data == bufferData.data()) {
+            glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
         }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
     }
 
-    if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+    GLuint objectBuffer = _transform._objectBuffer;
+    size_t objectOffset = 0;
+    size_t objectSize = batch._objects.size() * sizeof(Batch::TransformObject);
+    if (objectSize) {
+        uint8_t* data = ring.allocate(objectSize, objectOffset);
+        if (data) {
+            memcpy(data, batch._objects.data(), objectSize);
+            objectBuffer = ring.getBuffer();
+        } else {
+            glNamedBufferData(_transform._objectBuffer, objectSize, batch._objects.data(), GL_STREAM_DRAW);
+            objectOffset = 0;
+        }
     }
 
     if (!batch._namedData.empty()) {
-        bufferData.clear();
+        size_t size = 0;
         for (auto& data : batch._namedData) {
-            auto currentSize = bufferData.size();
-            auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
-            bufferData.resize(currentSize + bytesToCopy);
-            memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
-            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
+            size += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+        }
+        size_t offset = 0;
+        uint8_t* ringData = ring.allocate(size, offset);
+        if (!ringData) {
+            bufferData.resize(size);
+        }
+        uint8_t* data = ringData ? ringData : bufferData.data();
+        size_t currentSize = 0;
+        for (auto& namedData : batch._namedData) {
+            auto bytesToCopy = namedData.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+            memcpy(data + currentSize, namedData.second.drawCallInfos.data(), bytesToCopy);
+            _transform._drawCallInfoOffsets[namedData.first] = (GLvoid*)(ringData ? offset + currentSize : currentSize);
+            currentSize += bytesToCopy;
+        }
+        _transform._currentDrawCallInfoBuffer = ringData ? ring.getBuffer() : _transform._drawCallInfoBuffer;
+        if (!ringData) {
+            glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
     }
 
 #ifdef GPU_SSBO_TRANSFORM_OBJECT
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    if (objectSize) {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, objectBuffer, objectOffset, objectSize);
+    } else {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + slot::texture::ObjectTransforms);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (objectSize) {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, objectBuffer, objectOffset, objectSize);
+    } else {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -89,15 +146,24 @@ void GL45Backend::updateTransform(const Batch& batch) {
             glVertexAttribBinding(gpu::Stream::DRAW_CALL_INFO, gpu::Stream::DRAW_CALL_INFO);
 #ifdef GPU_STEREO_DRAWCALL_INSTANCED
             glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, (isStereo() ? 2 : 1));
+            _transform._drawCallInfoStereo = isStereo();
 #else
             glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, 1);
 #endif
             _transform._enabledDrawcallInfoBuffer = true;
         }
+#ifdef GPU_STEREO_DRAWCALL_INSTANCED
+        // Stereo can be turned off and back on while the buffer stays enabled, and the instances of both eyes of an
+        // indirect draw only read the info of their command while its rate is halved
+        if (_transform._drawCallInfoStereo != isStereo()) {
+            glVertexBindingDivisor(gpu::Stream::DRAW_CALL_INFO, (isStereo() ? 2 : 1));
+            _transform._drawCallInfoStereo = isStereo();
+        }
+#endif
         // NOTE: A stride of zero in BindVertexBuffer signifies that all elements are sourced from the same location,
         //       so we must provide a stride.
         //       This is in contrast to VertexAttrib*Pointer, where a zero signifies tightly-packed elements.
-        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
+        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._currentDrawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
     }
 
     (void)CHECK_GL_ERROR();
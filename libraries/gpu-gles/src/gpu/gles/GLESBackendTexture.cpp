@@ -467,7 +467,7 @@ size_t GLESVariableAllocationTexture::promote() {
     Q_ASSERT(_allocatedMip > 0);
 
     uint16_t targetAllocatedMip = _allocatedMip - std::min<uint16_t>(_allocatedMip, 2);
-    targetAllocatedMip = std::max<uint16_t>(_minAllocatedMip, targetAllocatedMip);
+    targetAllocatedMip = std::max<uint16_t>(getMinPromotionMip(), targetAllocatedMip);
 
     GLuint oldId = _id;
     auto oldSize = _size;
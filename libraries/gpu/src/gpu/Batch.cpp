@@ -90,6 +90,7 @@ void Batch::clear() {
     _pipelines.clear();
     _profileRanges.clear();
     _queries.clear();
+    _readbacks.clear();
     _swapChains.clear();
     _streamFormats.clear();
     _textures.clear();
@@ -452,6 +453,17 @@ void Batch::getQuery(const QueryPointer& query) {
     _params.emplace_back(_queries.cache(query));
 }
 
+void Batch::readFramebuffer(const FramebufferPointer& framebuffer, const Vec4i& region, const ReadbackPointer& readback) {
+    ADD_COMMAND(readFramebuffer);
+
+    _params.emplace_back(_framebuffers.cache(framebuffer));
+    _params.emplace_back(region.x);
+    _params.emplace_back(region.y);
+    _params.emplace_back(region.z);
+    _params.emplace_back(region.w);
+    _params.emplace_back(_readbacks.cache(readback));
+}
+
 void Batch::resetStages() {
     ADD_COMMAND(resetStages);
 }
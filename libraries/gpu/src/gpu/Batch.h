@@ -21,6 +21,7 @@
 #include "Framebuffer.h"
 #include "Pipeline.h"
 #include "Query.h"
+#include "Readback.h"
 #include "Stream.h"
 #include "Texture.h"
 #include "Transform.h"
@@ -234,6 +235,9 @@ public:
     void endQuery(const QueryPointer& query);
     void getQuery(const QueryPointer& query);
 
+    // Copies the region of the framebuffer's first color buffer for the readback's handler, once the gpu has drawn it
+    void readFramebuffer(const FramebufferPointer& framebuffer, const Vec4i& region, const ReadbackPointer& readback);
+
     // Reset the stage caches and states
     void resetStages();
 
@@ -336,6 +340,8 @@ public:
         COMMAND_endQuery,
         COMMAND_getQuery,
 
+        COMMAND_readFramebuffer,
+
         COMMAND_resetStages,
 
         COMMAND_disableContextViewCorrection,
@@ -461,6 +467,7 @@ public:
     typedef Cache<FramebufferPointer>::Vector FramebufferCaches;
     typedef Cache<SwapChainPointer>::Vector SwapChainCaches;
     typedef Cache<QueryPointer>::Vector QueryCaches;
+    typedef Cache<ReadbackPointer>::Vector ReadbackCaches;
     typedef Cache<std::string>::Vector StringCaches;
     typedef Cache<std::function<void()>>::Vector LambdaCache;
 
@@ -517,6 +524,7 @@ public:
     FramebufferCaches _framebuffers;
     SwapChainCaches _swapChains;
     QueryCaches _queries;
+    ReadbackCaches _readbacks;
     LambdaCache _lambdas;
     StringCaches _profileRanges;
     StringCaches _names;
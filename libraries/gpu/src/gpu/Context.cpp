@@ -12,6 +12,7 @@
 #include "Context.h"
 
 #include <shared/GlobalAppProperties.h>
+#include <SharedUtil.h>
 
 #include "Frame.h"
 #include "GPULogging.h"
@@ -72,19 +73,37 @@ const std::string& Context::getBackendVersion() const {
     return _backend->getVersion();
 }
 
+void Context::setShaderCacheScope(const std::string& scope) {
+    if (_backend) {
+        _backend->setShaderCacheScope(scope);
+    }
+}
+
 void Context::beginFrame(const glm::mat4& renderView, const glm::mat4& renderPose) {
     assert(!_frameActive);
     _frameActive = true;
     _currentFrame = std::make_shared<Frame>();
     _currentFrame->pose = renderPose;
     _currentFrame->view = renderView;
+    _currentFrame->beginTime = usecTimestampNow();
 
     if (!_frameRangeTimer) {
         _frameRangeTimer = std::make_shared<RangeTimer>("gpu::Context::Frame");
     }
 }
 
+static thread_local std::vector<BatchPointer>* threadBatches { nullptr };
+
+std::vector<BatchPointer>* Context::setThreadBatches(std::vector<BatchPointer>* batches) {
+    std::swap(threadBatches, batches);
+    return batches;
+}
+
 void Context::appendFrameBatch(const BatchPointer& batch) {
+    if (threadBatches) {
+        threadBatches->push_back(batch);
+        return;
+    }
     if (!_frameActive) {
         qWarning() << "Batch executed outside of frame boundaries";
         return;
@@ -217,6 +236,20 @@ double Context::getFrameTimerBatchAverage() const {
     return 0.0;
 }
 
+double Context::getFrameTimerGPULatest() const {
+    if (_frameRangeTimer) {
+        return _frameRangeTimer->getGPULatest();
+    }
+    return 0.0;
+}
+
+double Context::getFrameTimerBatchLatest() const {
+    if (_frameRangeTimer) {
+        return _frameRangeTimer->getBatchLatest();
+    }
+    return 0.0;
+}
+
 const Backend::TransformCamera& Backend::TransformCamera::recomputeDerived(const Transform& xformView) const {
     _projectionInverse = glm::inverse(_projection);
 
@@ -281,6 +314,7 @@ ContextMetricSize  Backend::textureExternalGPUMemSize;
 
 ContextMetricCount Backend::texturePendingGPUTransferCount;
 ContextMetricSize  Backend::texturePendingGPUTransferMemSize;
+ContextMetricSize  Backend::textureFrameGPUTransferMemSize;
 
 ContextMetricSize  Backend::textureResourcePopulatedGPUMemSize;
 ContextMetricSize  Backend::textureResourceIdealGPUMemSize;
@@ -341,6 +375,10 @@ Size Context::getTexturePendingGPUTransferMemSize() {
     return Backend::texturePendingGPUTransferMemSize.getValue();
 }
 
+Size Context::getTextureFrameGPUTransferMemSize() {
+    return Backend::textureFrameGPUTransferMemSize.getValue();
+}
+
 Size Context::getTextureResourcePopulatedGPUMemSize() {
     return Backend::textureResourcePopulatedGPUMemSize.getValue();
 }
@@ -70,6 +70,12 @@ public:
 
     virtual bool supportedTextureFormat(const gpu::Element& format) = 0;
 
+    // Whether the multiDrawIndirect and multiDrawIndexedIndirect commands are drawn, rather than ignored
+    virtual bool supportsMultiDrawIndirect() const { return false; }
+
+    // Thread-safe, see Context::setShaderCacheScope
+    virtual void setShaderCacheScope(const std::string& scope) {}
+
     // Shared header between C++ and GLSL
 #include "TransformCamera_shared.slh"
 
@@ -115,6 +121,8 @@ public:
 
     static ContextMetricCount texturePendingGPUTransferCount;
     static ContextMetricSize texturePendingGPUTransferMemSize;
+    // The texels the texture transfers uploaded over the last frame
+    static ContextMetricSize textureFrameGPUTransferMemSize;
     static ContextMetricSize textureResourcePopulatedGPUMemSize;
     static ContextMetricSize textureResourceIdealGPUMemSize;
 
@@ -160,10 +168,19 @@ public:
     void shutdown();
     const std::string& getBackendVersion() const;
 
+    // Thread-safe. Names what is being rendered, such as the domain being visited, so that the backend records the
+    // programs used under it and prepares them ahead of their first use the next time the same scope is set
+    void setShaderCacheScope(const std::string& scope);
+
     void beginFrame(const glm::mat4& renderView = glm::mat4(), const glm::mat4& renderPose = glm::mat4());
     void appendFrameBatch(const BatchPointer& batch);
     FramePointer endFrame();
 
+    // While a thread has a list of batches set, the batches it appends go to that list rather than to the frame, so that
+    // batches recorded on several threads at once can be appended to the frame afterwards, in a deterministic order.
+    // Returns the list set before.
+    static std::vector<BatchPointer>* setThreadBatches(std::vector<BatchPointer>* batches);
+
     static BatchPointer acquireBatch(const char* name = nullptr);
     static void releaseBatch(Batch* batch);
 
@@ -232,6 +249,10 @@ public:
     double getFrameTimerGPUAverage() const;
     double getFrameTimerBatchAverage() const;
 
+    // The times of the latest frame timed, a few frames behind the one being recorded as the GPU queries lag
+    double getFrameTimerGPULatest() const;
+    double getFrameTimerBatchLatest() const;
+
     static Size getFreeGPUMemSize();
     static Size getUsedGPUMemSize();
 
@@ -252,6 +273,7 @@ public:
 
     static uint32_t getTexturePendingGPUTransferCount();
     static Size getTexturePendingGPUTransferMemSize();
+    static Size getTextureFrameGPUTransferMemSize();
 
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
@@ -68,6 +68,8 @@ namespace gpu {
     class Query;
     using QueryPointer = std::shared_ptr<Query>;
     using Queries = std::vector<QueryPointer>;
+    class Readback;
+    using ReadbackPointer = std::shared_ptr<Readback>;
     class Resource;
     class Buffer;
     using BufferPointer = std::shared_ptr<Buffer>;
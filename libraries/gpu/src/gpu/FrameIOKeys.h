@@ -177,6 +177,8 @@ constexpr const char*  COMMAND_NAMES[] = {
     "endQuery",
     "getQuery",
 
+    "readFramebuffer",
+
     "resetStages",
 
     "disableContextViewCorrection",
@@ -42,14 +42,20 @@ void Query::triggerReturnHandler(uint64_t queryResult, uint64_t batchElapsedTime
 }
 
 
-RangeTimer::RangeTimer(const std::string& name) :
-    _name(name) {
+RangeTimer::RangeTimer(const std::string& name, const SampleHandler& sampleHandler) :
+    _name(name),
+    _sampleHandler(sampleHandler) {
     for (int i = 0; i < QUERY_QUEUE_SIZE; i++) {
         _timerQueries.push_back(std::make_shared<gpu::Query>([this] (const Query& query) {
             _tailIndex++;
 
-            _movingAverageGPU.addSample(query.getGPUElapsedTime());
-            _movingAverageBatch.addSample(query.getBatchElapsedTime());
+            _latestGPU = query.getGPUElapsedTime();
+            _latestBatch = query.getBatchElapsedTime();
+            _movingAverageGPU.addSample(_latestGPU);
+            _movingAverageBatch.addSample(_latestBatch);
+            if (_sampleHandler) {
+                _sampleHandler(_latestGPU, _latestBatch);
+            }
         }, _name));
     }
 }
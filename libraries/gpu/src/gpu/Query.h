@@ -59,24 +59,34 @@ namespace gpu {
     // The result is always a late average of the time spent for that same task a few cycles ago.
     class RangeTimer {
     public:
-        RangeTimer(const std::string& name);
+        // called with each range's times in msecs as it comes back, for a caller keeping more than the average
+        using SampleHandler = std::function<void(double gpuTime, double batchTime)>;
+
+        RangeTimer(const std::string& name, const SampleHandler& sampleHandler = SampleHandler());
         void begin(gpu::Batch& batch);
         void end(gpu::Batch& batch);
         
         double getGPUAverage() const;
         double getBatchAverage() const;
 
+        // the times of the latest range to come back, rather than the average of the last few
+        double getGPULatest() const { return _latestGPU; }
+        double getBatchLatest() const { return _latestBatch; }
+
     protected:
         
         static const int QUERY_QUEUE_SIZE { 4 };
 
         const std::string _name;
+        const SampleHandler _sampleHandler;
         gpu::Queries _timerQueries;
         int _headIndex = -1;
         int _tailIndex = -1;
 
         MovingAverage<double, QUERY_QUEUE_SIZE * 2> _movingAverageGPU;
         MovingAverage<double, QUERY_QUEUE_SIZE * 2> _movingAverageBatch;
+        double _latestGPU { 0.0 };
+        double _latestBatch { 0.0 };
 
         int rangeIndex(int index) const { return (index % QUERY_QUEUE_SIZE); }
     };
@@ -0,0 +1,29 @@
+//
+//  Readback.cpp
+//  libraries/gpu/src/gpu
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "Readback.h"
+
+using namespace gpu;
+
+Readback::Readback(const Handler& returnHandler, const std::string& name) :
+    _returnHandler(returnHandler),
+    _name(name)
+{
+}
+
+void Readback::triggerReturnHandler(const Element& format, const Vec2u& size, Pixels&& pixels) {
+    _format = format;
+    _size = size;
+    _pixels = std::move(pixels);
+
+    if (_returnHandler) {
+        _returnHandler(*this);
+    }
+}
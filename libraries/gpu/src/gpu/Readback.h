@@ -0,0 +1,57 @@
+//
+//  Readback.h
+//  libraries/gpu/src/gpu
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_Readback_h
+#define hifi_gpu_Readback_h
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Format.h"
+
+namespace gpu {
+
+    // The pixels of a region of a framebuffer, copied by Batch::readFramebuffer() without waiting for the gpu to be done
+    // drawing them: like a Query, the handler gets them a frame or more later, on the thread executing the batches.
+    class Readback {
+    public:
+        using Handler = std::function<void(const Readback&)>;
+        using Pixels = std::vector<Byte>;
+
+        Readback(const Handler& returnHandler, const std::string& name = "gpu::readback");
+
+        const std::string& getName() const { return _name; }
+
+        // The element format of the color buffer read, and the size of the region
+        const Element& getFormat() const { return _format; }
+        const Vec2u& getSize() const { return _size; }
+        // Rows of getSize().x pixels, from the bottom of the region up
+        const Pixels& getPixels() const { return _pixels; }
+
+        // Only for gpu::Context
+        void triggerReturnHandler(const Element& format, const Vec2u& size, Pixels&& pixels);
+
+    protected:
+        Handler _returnHandler;
+
+        const std::string _name;
+        Element _format;
+        Vec2u _size { 0 };
+        Pixels _pixels;
+    };
+
+    typedef std::shared_ptr<Readback> ReadbackPointer;
+
+};
+
+#endif
@@ -660,20 +660,6 @@ void SphericalHarmonics::assignPreset(int p) {
 }
 
 // Originial code for the Spherical Harmonics taken from "Sun and Black Cat- Igor Dykhta (igor dykhta email) � 2007-2014 "
-void sphericalHarmonicsAdd(float * result, int order, const float * inputA, const float * inputB) {
-   const int numCoeff = order * order;
-   for(int i=0; i < numCoeff; i++) {
-      result[i] = inputA[i] + inputB[i];
-   }
-}
-
-void sphericalHarmonicsScale(float * result, int order, const float * input, float scale) {
-   const int numCoeff = order * order;
-   for(int i=0; i < numCoeff; i++) {
-      result[i] = input[i] * scale;
-   }
-}
-
 void sphericalHarmonicsEvaluateDirection(float * result, int order,  const glm::vec3 & dir) {
    // calculate coefficients for first 3 bands of spherical harmonics
    double P_0_0 = 0.282094791773878140;
@@ -703,22 +689,34 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
 
     const uint sqOrder = order*order;
 
+    // how the texels are read is decided once for the texture, rather than for every texel
+    glm::vec3 (*unpackFunc)(uint32) = nullptr;
+    float linearFromSRGB[256];
+    if (target != gpu::BackendTarget::GLES32) {
+        switch (cubeTexture.getStoredMipFormat().getSemantic()) {
+        case gpu::R11G11B10:
+            unpackFunc = glm::unpackF2x11_1x10;
+            break;
+        case gpu::RGB9E5:
+            unpackFunc = glm::unpackF3x9_E1x5;
+            break;
+        default:
+            assert(false);
+            return false;
+        }
+    } else {
+        for (int i = 0; i < 256; ++i) {
+            linearFromSRGB[i] = powf((float)i / 255.0f, 2.2f);
+        }
+    }
+
     // allocate memory for calculations
     output.resize(sqOrder);
-    std::vector<float> resultR(sqOrder);
-    std::vector<float> resultG(sqOrder);
-    std::vector<float> resultB(sqOrder);
+    std::vector<glm::vec3> result(sqOrder, glm::vec3(0.0f));
 
     // initialize values
     float fWt = 0.0f;
-    for(uint i=0; i < sqOrder; i++) {
-        output[i] = glm::vec3(0.0f);
-        resultR[i] = 0.0f;
-        resultG[i] = 0;
-        resultB[i] = 0;
-    }
     std::vector<float> shBuff(sqOrder);
-    std::vector<float> shBuffB(sqOrder);
 
     // We trade accuracy for speed by breaking the image into 32x32 parts
     // and approximating the distance for all the pixels in each part to be
@@ -812,67 +810,42 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 // calculate coefficients of spherical harmonics for current direction
                 sphericalHarmonicsEvaluateDirection(shBuff.data(), order, dir);
 
-                // index of texel in texture
-
                 // get color from texture
                 glm::vec3 color{ 0.0f, 0.0f, 0.0f };
 
-                if (target != gpu::BackendTarget::GLES32) {
-                    auto mipFormat = cubeTexture.getStoredMipFormat();
-                    std::function<glm::vec3(uint32)> unpackFunc;
-                    switch (mipFormat.getSemantic()) {
-                    case gpu::R11G11B10:
-                        unpackFunc = glm::unpackF2x11_1x10;
-                        break;
-                    case gpu::RGB9E5:
-                        unpackFunc = glm::unpackF3x9_E1x5;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                    }
+                if (unpackFunc) {
                     auto data32 = reinterpret_cast<const uint32*>(data);
-                    for (int i = 0; i < stride; ++i) {
-                        for (int j = 0; j < stride; ++j) {
-                            int k = (int)(x + i - halfStride + (y + j - halfStride) * width);
-                            color += unpackFunc(data32[k]);
+                    for (int j = 0; j < stride; ++j) {
+                        const uint32* row = data32 + (x - halfStride) + (y + j - halfStride) * width;
+                        for (int i = 0; i < stride; ++i) {
+                            color += unpackFunc(row[i]);
                         }
                     }
                 } else {
-                    // BGRA -> RGBA
+                    // BGRA -> RGBA, through the table rather than a pow() per channel
                     const int NUM_COMPONENTS_PER_PIXEL = 4;
-                    for (int i = 0; i < stride; ++i) {
-                        for (int j = 0; j < stride; ++j) {
-                            int k = NUM_COMPONENTS_PER_PIXEL * (int)(x + i - halfStride + (y + j - halfStride) * width);
-                            color += glm::pow(glm::vec3(data[k + 2], data[k + 1], data[k]) / 255.0f, glm::vec3(2.2f));
+                    for (int j = 0; j < stride; ++j) {
+                        const Byte* row = data + NUM_COMPONENTS_PER_PIXEL * ((x - halfStride) + (y + j - halfStride) * width);
+                        for (int i = 0; i < stride; ++i) {
+                            const Byte* pixel = row + NUM_COMPONENTS_PER_PIXEL * i;
+                            color += glm::vec3(linearFromSRGB[pixel[2]], linearFromSRGB[pixel[1]], linearFromSRGB[pixel[0]]);
                         }
                     }
                 }
 
-
                 // scale color and add to previously accumulated coefficients
-                // red
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), color.r * fDiffSolid);
-                sphericalHarmonicsAdd(resultR.data(), order, resultR.data(), shBuffB.data());
-                // green
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), color.g * fDiffSolid);
-                sphericalHarmonicsAdd(resultG.data(), order, resultG.data(), shBuffB.data());
-                // blue
-                sphericalHarmonicsScale(shBuffB.data(), order, shBuff.data(), color.b * fDiffSolid);
-                sphericalHarmonicsAdd(resultB.data(), order, resultB.data(), shBuffB.data());
+                const glm::vec3 weightedColor = color * fDiffSolid;
+                for (uint i = 0; i < sqOrder; ++i) {
+                    result[i] += weightedColor * shBuff[i];
+                }
             }
         }
     }
 
-    // final scale for coefficients
+    // final scale for coefficients, and save result
     const float fNormProj = (4.0f * glm::pi<float>()) / (fWt * (float)(stride * stride));
-    sphericalHarmonicsScale(resultR.data(), order, resultR.data(), fNormProj);
-    sphericalHarmonicsScale(resultG.data(), order, resultG.data(), fNormProj);
-    sphericalHarmonicsScale(resultB.data(), order, resultB.data(), fNormProj);
-
-    // save result
     for(uint i=0; i < sqOrder; i++) {
-        output[i] = glm::vec3(resultR[i], resultG[i], resultB[i]);
+        output[i] = result[i] * fNormProj;
     }
 
     return true;
@@ -937,6 +910,43 @@ bool Texture::incremementMinMip(uint16 count) {
     return setMinMip(_minMip + count);
 }
 
+void Texture::requestMip(uint16 mip) {
+    uint16 requestedMip = _requestedMip.load();
+    while (mip < requestedMip && !_requestedMip.compare_exchange_weak(requestedMip, mip)) {
+    }
+}
+
+void Texture::requestMipForSize(float pixels) {
+    float texels = (float)std::max(_width, _height);
+    if (pixels <= 0.0f || pixels >= texels) {
+        requestMip(0);
+        return;
+    }
+    float mip = floorf(log2f(texels / pixels));
+    requestMip((uint16)std::min(mip, (float)_maxMipLevel));
+}
+
+uint16 Texture::updateDesiredMip() {
+    // about two seconds at 60 fps
+    static const uint16 FRAMES_BEFORE_COARSER_MIP = 120;
+
+    uint16 requestedMip = _requestedMip.exchange(NO_MIP_REQUEST);
+    if (requestedMip == NO_MIP_REQUEST) {
+        return _desiredMip;
+    }
+
+    // until first seen, a texture wants all of its mips, that's no reason to load them before going coarser
+    if (!_hasMipRequests || requestedMip <= _desiredMip) {
+        _hasMipRequests = true;
+        _framesWantingCoarserMip = 0;
+        _desiredMip = requestedMip;
+    } else if (++_framesWantingCoarserMip >= FRAMES_BEFORE_COARSER_MIP) {
+        _framesWantingCoarserMip = 0;
+        _desiredMip = requestedMip;
+    }
+    return _desiredMip;
+}
+
 Vec3u Texture::evalMipDimensions(uint16 level) const { 
     auto dimensions = getDimensions();
     dimensions >>= level; 
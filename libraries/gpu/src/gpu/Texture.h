@@ -355,7 +355,8 @@ public:
 
         void reset() override { }
 
-        // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle)
+        // Don't keep files open forever.  We close them at the beginning of each frame (GLBackend::recycle), the mips
+        // getMipFace handed out keep their file mapped until they are released after upload
         static void releaseOpenKtxFiles();
 
     protected:
@@ -579,6 +580,18 @@ public:
     bool getImportant() const { return _important; }
     void setImportant(bool important) { _important = important; }
 
+    // Mip demand, reported by the renderer each frame from how many pixels the texture covers on screen. The backend
+    // collects the reports once a frame with updateDesiredMip(), and the finest mip reported is the one worth having
+    // resident and, for a streamed texture, worth fetching. A texture no one reports on wants all of its mips.
+    static const uint16 NO_MIP_REQUEST = 0xFFFF;
+    void requestMip(uint16 mip);
+    // the mip whose texels are about the size of the pixels of a draw covering that many pixels across the screen
+    void requestMipForSize(float pixels);
+    // Takes the requests since the last call, a finer mip is wanted straight away but a coarser one only once it's
+    // the finest requested for a while, so textures don't go back and forth as the view changes
+    uint16 updateDesiredMip();
+    uint16 getDesiredMip() const { return _desiredMip; }
+
     const GPUObjectPointer gpuObject {};
 
     ExternalUpdates getUpdates() const;
@@ -643,6 +656,11 @@ protected:
     bool _isIrradianceValid = false;
     bool _defined = false;
     bool _important = false;
+
+    std::atomic<uint16> _requestedMip { NO_MIP_REQUEST };
+    std::atomic<uint16> _desiredMip { 0 };
+    uint16 _framesWantingCoarserMip { 0 };
+    bool _hasMipRequests { false };
    
     static TexturePointer create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, uint16 numMips, const Sampler& sampler);
 
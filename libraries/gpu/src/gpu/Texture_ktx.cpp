@@ -274,8 +274,13 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     if (!storageView) {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
+        return storageView;
     }
-    return storageView->toMemoryStorage();
+
+    // The view keeps the mapped file alive until the mip is uploaded and the view released, rather than copying the mip to
+    // memory.  Transfers get their mips from the buffering thread, so the pages are read in here and not on upload.
+    storageView->prefetch();
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -26,19 +26,26 @@ Mesh::Mesh(const Mesh& mesh) :
     _vertexBuffer(mesh._vertexBuffer),
     _attributeBuffers(mesh._attributeBuffers),
     _indexBuffer(mesh._indexBuffer),
-    _partBuffer(mesh._partBuffer) {
+    _partBuffer(mesh._partBuffer),
+    _lodIndexBuffer(mesh._lodIndexBuffer),
+    _lods(mesh._lods),
+    _poolAllocations(mesh._poolAllocations) {
 }
 
 Mesh::~Mesh() {
 }
 
-void Mesh::setVertexFormatAndStream(const gpu::Stream::FormatPointer& vf, const gpu::BufferStreamPointer& vbs) {
+void Mesh::setVertexFormatAndStream(const gpu::Stream::FormatPointer& vf, const gpu::BufferStreamPointer& vbs, gpu::Size size) {
     _vertexFormat = vf;
     _vertexStream = (*vbs);
 
     auto attrib = _vertexFormat->getAttribute(gpu::Stream::POSITION);
-    _vertexBuffer = BufferView(vbs->getBuffers()[attrib._channel], vbs->getOffsets()[attrib._channel], vbs->getBuffers()[attrib._channel]->getSize(),
-        (gpu::uint16) vbs->getStrides()[attrib._channel], attrib._element);
+    const auto& buffer = vbs->getBuffers()[attrib._channel];
+    auto offset = vbs->getOffsets()[attrib._channel];
+    if (size == 0) {
+        size = buffer->getSize() - offset;
+    }
+    _vertexBuffer = BufferView(buffer, offset, size, (gpu::uint16) vbs->getStrides()[attrib._channel], attrib._element);
 }
 
 void Mesh::setVertexBuffer(const BufferView& buffer) {
@@ -108,6 +115,11 @@ void Mesh::setPartBuffer(const BufferView& buffer) {
     _partBuffer = buffer;
 }
 
+void Mesh::setLODs(const BufferView& indexBuffer, const LODs& lods) {
+    _lodIndexBuffer = indexBuffer;
+    _lods = lods;
+}
+
 Box Mesh::evalPartBound(int partNum) const {
     Box box;
     if (partNum < _partBuffer.getNum<Part>()) {
@@ -28,6 +28,9 @@ typedef glm::vec3 Vec3;
 class Mesh;
 using MeshPointer = std::shared_ptr< Mesh >;
 
+class GeometryBufferAllocation;
+using GeometryBufferAllocationPointer = std::shared_ptr< GeometryBufferAllocation >;
+
 
 class Mesh {
 public:
@@ -60,7 +63,8 @@ public:
     const BufferView getAttributeBuffer(int attrib) const;
 
     // Force vertex stream and Vertex format
-    void setVertexFormatAndStream(const gpu::Stream::FormatPointer& vf, const gpu::BufferStreamPointer& vbs);
+    // the vertices span size bytes of the position's buffer, or all of it from their offset on if size is 0
+    void setVertexFormatAndStream(const gpu::Stream::FormatPointer& vf, const gpu::BufferStreamPointer& vbs, gpu::Size size = 0);
 
     // Stream format
     const gpu::Stream::FormatPointer getVertexFormat() const { return _vertexFormat; }
@@ -125,6 +129,25 @@ public:
 
     static gpu::Primitive topologyToPrimitive(Topology topo) { return static_cast<gpu::Primitive>(topo); }
 
+    // Simplified version of the parts, drawn in their place when too small on screen for the difference to show.  It has
+    // a part for each of the mesh's, indexing the same vertices through the LOD index buffer.
+    class LOD {
+    public:
+        // how far its surface may be from the full detail one, in the units of the vertices
+        float _error { 0.0f };
+        std::vector<Part> _parts;
+    };
+    using LODs = std::vector<LOD>;
+
+    // the levels of detail, from the least simplified to the most
+    void setLODs(const BufferView& indexBuffer, const LODs& lods);
+    const BufferView& getLODIndexBuffer() const { return _lodIndexBuffer; }
+    const LODs& getLODs() const { return _lods; }
+
+    // The ranges of a GeometryBufferPool the vertices and indices were moved to, kept for as long as the mesh is
+    void setPoolAllocations(const std::vector<GeometryBufferAllocationPointer>& allocations) { _poolAllocations = allocations; }
+    bool isPooled() const { return !_poolAllocations.empty(); }
+
     // create a copy of this mesh after passing its vertices, normals, and indexes though the provided functions
     MeshPointer map(std::function<glm::vec3(glm::vec3)> vertexFunc,
                     std::function<glm::vec3(glm::vec3)> colorFunc,
@@ -154,6 +177,11 @@ protected:
 
     BufferView _partBuffer;
 
+    BufferView _lodIndexBuffer;
+    LODs _lods;
+
+    std::vector<GeometryBufferAllocationPointer> _poolAllocations;
+
     void evalVertexFormat();
     void evalVertexStream();
 
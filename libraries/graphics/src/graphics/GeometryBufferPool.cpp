@@ -0,0 +1,197 @@
+//
+//  GeometryBufferPool.cpp
+//  libraries/graphics/src/graphics
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GeometryBufferPool.h"
+
+#include <algorithm>
+
+using namespace graphics;
+
+static gpu::Size alignUp(gpu::Size offset, gpu::Size alignment) {
+    return ((offset + alignment - 1) / alignment) * alignment;
+}
+
+GeometryBufferAllocation::GeometryBufferAllocation(const BlockPointer& block, gpu::Size offset, gpu::Size size) :
+    _block(block),
+    _offset(offset),
+    _size(size) {
+}
+
+GeometryBufferAllocation::~GeometryBufferAllocation() {
+    _block->release(_offset, _size);
+}
+
+const gpu::BufferPointer& GeometryBufferAllocation::getBuffer() const {
+    return _block->getBuffer();
+}
+
+GeometryBufferAllocation::Block::Block(gpu::Size size) :
+    _buffer(std::make_shared<gpu::Buffer>()),
+    _size(size) {
+    // sized once, as resizing would send the whole buffer to the GPU again
+    _buffer->resize(size);
+    _freeRanges[0] = size;
+}
+
+bool GeometryBufferAllocation::Block::allocate(gpu::Size size, gpu::Size alignment, gpu::Size& offset) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto range = _freeRanges.begin(); range != _freeRanges.end(); ++range) {
+        gpu::Size rangeOffset = range->first;
+        gpu::Size rangeEnd = range->first + range->second;
+        gpu::Size alignedOffset = alignUp(rangeOffset, alignment);
+        if (alignedOffset + size > rangeEnd) {
+            continue;
+        }
+
+        _freeRanges.erase(range);
+        if (alignedOffset > rangeOffset) {
+            _freeRanges[rangeOffset] = alignedOffset - rangeOffset;
+        }
+        if (alignedOffset + size < rangeEnd) {
+            _freeRanges[alignedOffset + size] = rangeEnd - (alignedOffset + size);
+        }
+        _numBytesUsed += size;
+        ++_numAllocations;
+        offset = alignedOffset;
+        return true;
+    }
+    return false;
+}
+
+void GeometryBufferAllocation::Block::release(gpu::Size offset, gpu::Size size) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _numBytesUsed -= size;
+    --_numAllocations;
+
+    // merge with the free ranges on either side, the padding of an alignment included
+    auto next = _freeRanges.lower_bound(offset);
+    if (next != _freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = _freeRanges.erase(next);
+    }
+    if (next != _freeRanges.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            return;
+        }
+    }
+    _freeRanges[offset] = size;
+}
+
+gpu::Size GeometryBufferAllocation::Block::getNumBytesUsed() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numBytesUsed;
+}
+
+uint32_t GeometryBufferAllocation::Block::getNumAllocations() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numAllocations;
+}
+
+GeometryBufferAllocationPointer GeometryBufferPool::allocate(Kind kind, gpu::Size size, gpu::Size alignment) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& blocks = _blocks[kind];
+
+    gpu::Size offset = 0;
+    for (const auto& block : blocks) {
+        if (block->allocate(size, alignment, offset)) {
+            return std::make_shared<GeometryBufferAllocation>(block, offset, size);
+        }
+    }
+
+    // the blocks that emptied since their models went, bar one, go before another is made
+    bool keptEmptyBlock = false;
+    blocks.erase(std::remove_if(blocks.begin(), blocks.end(), [&](const BlockPointer& block) {
+        if (block->getNumAllocations() > 0) {
+            return false;
+        }
+        if (!keptEmptyBlock && block->getSize() >= _blockSize) {
+            keptEmptyBlock = true;
+            return false;
+        }
+        return true;
+    }), blocks.end());
+
+    // a mesh larger than a block gets one of its own
+    auto block = std::make_shared<GeometryBufferAllocation::Block>(std::max(_blockSize, alignUp(size, alignment)));
+    blocks.push_back(block);
+    block->allocate(size, alignment, offset);
+    return std::make_shared<GeometryBufferAllocation>(block, offset, size);
+}
+
+bool GeometryBufferPool::adopt(const MeshPointer& mesh) {
+    if (!mesh || mesh->isPooled() || !mesh->hasVertexData() || mesh->getNumAttributes() > 0) {
+        return false;
+    }
+
+    // baked meshes interleave all their attributes in a single stream
+    const auto& vertexStream = mesh->getVertexStream();
+    if (vertexStream.getNumBuffers() != 1) {
+        return false;
+    }
+    const auto& vertexBuffer = vertexStream.getBuffers()[0];
+    gpu::Size vertexOffset = vertexStream.getOffsets()[0];
+    gpu::Size vertexStride = vertexStream.getStrides()[0];
+    gpu::Size vertexSize = (gpu::Size)mesh->getNumVertices() * vertexStride;
+    if (!vertexBuffer || vertexStride == 0 || vertexSize == 0 || vertexOffset + vertexSize > vertexBuffer->getSize()) {
+        return false;
+    }
+
+    const auto& indexBuffer = mesh->getIndexBuffer();
+    if (!indexBuffer._buffer || indexBuffer._element.getType() != gpu::UINT32 || indexBuffer._size == 0) {
+        return false;
+    }
+
+    std::vector<GeometryBufferAllocationPointer> allocations;
+
+    // the vertices start on a multiple of their stride, so that a draw can find them with a base vertex
+    auto vertices = allocate(VERTICES, vertexSize, vertexStride);
+    vertices->getBuffer()->setSubData(vertices->getOffset(), vertexSize, vertexBuffer->getData() + vertexOffset);
+    auto pooledStream = std::make_shared<gpu::BufferStream>();
+    pooledStream->addBuffer(vertices->getBuffer(), vertices->getOffset(), vertexStride);
+    mesh->setVertexFormatAndStream(mesh->getVertexFormat(), pooledStream, vertexSize);
+    allocations.push_back(vertices);
+
+    auto copyIndices = [&](const BufferView& view) {
+        auto indices = allocate(INDICES, view._size, sizeof(uint32_t));
+        indices->getBuffer()->setSubData(indices->getOffset(), view._size, view._buffer->getData() + view._offset);
+        allocations.push_back(indices);
+        return BufferView(indices->getBuffer(), indices->getOffset(), view._size, view._stride, view._element);
+    };
+
+    mesh->setIndexBuffer(copyIndices(indexBuffer));
+    const auto& lodIndexBuffer = mesh->getLODIndexBuffer();
+    if (lodIndexBuffer._buffer && lodIndexBuffer._size > 0) {
+        mesh->setLODs(copyIndices(lodIndexBuffer), mesh->getLODs());
+    }
+
+    mesh->setPoolAllocations(allocations);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_numMeshesAdopted;
+    return true;
+}
+
+GeometryBufferPool::Stats GeometryBufferPool::getStats() const {
+    Stats stats;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& blocks : _blocks) {
+        for (const auto& block : blocks) {
+            ++stats.numBlocks;
+            stats.numAllocations += block->getNumAllocations();
+            stats.numBytesReserved += block->getSize();
+            stats.numBytesUsed += block->getNumBytesUsed();
+        }
+    }
+    stats.numMeshesAdopted = _numMeshesAdopted;
+    return stats;
+}
@@ -0,0 +1,120 @@
+//
+//  GeometryBufferPool.h
+//  libraries/graphics/src/graphics
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_graphics_GeometryBufferPool_h
+#define hifi_graphics_GeometryBufferPool_h
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gpu/Buffer.h>
+
+#include "Geometry.h"
+
+namespace graphics {
+
+// A range of one of the buffers of a GeometryBufferPool, given back to the pool when the last mesh holding it goes.
+class GeometryBufferAllocation {
+public:
+    class Block;
+    using BlockPointer = std::shared_ptr<Block>;
+
+    GeometryBufferAllocation(const BlockPointer& block, gpu::Size offset, gpu::Size size);
+    ~GeometryBufferAllocation();
+
+    GeometryBufferAllocation(const GeometryBufferAllocation&) = delete;
+    GeometryBufferAllocation& operator=(const GeometryBufferAllocation&) = delete;
+
+    const gpu::BufferPointer& getBuffer() const;
+    gpu::Size getOffset() const { return _offset; }
+    gpu::Size getSize() const { return _size; }
+
+private:
+    BlockPointer _block;
+    gpu::Size _offset;
+    gpu::Size _size;
+};
+
+// Suballocates the vertices and indices of meshes from a few large gpu::Buffers, one set for vertices and one for indices,
+// instead of a pair of buffers for each mesh. The meshes keep their own vertex formats and indices: adopting a mesh
+// moves its data into the pool and points its views at their ranges, so that the meshes of a pool are bound once and
+// their parts drawn with the offsets of their ranges. Freed ranges merge with their neighbours, so the blocks don't
+// fragment as models come and go.
+//   Thread-safe, but a mesh should be adopted on the thread that records the batches drawing it, as the buffers'
+// updates are.
+class GeometryBufferPool {
+public:
+    static const gpu::Size DEFAULT_BLOCK_SIZE = 16 * 1024 * 1024;
+
+    enum Kind {
+        VERTICES = 0,
+        INDICES,
+
+        NUM_KINDS,
+    };
+
+    struct Stats {
+        uint32_t numBlocks { 0 };
+        uint32_t numAllocations { 0 };
+        gpu::Size numBytesReserved { 0 };
+        gpu::Size numBytesUsed { 0 };
+        uint32_t numMeshesAdopted { 0 };
+    };
+
+    explicit GeometryBufferPool(gpu::Size blockSize = DEFAULT_BLOCK_SIZE) : _blockSize(blockSize) {}
+
+    // moves the vertices and indices of a mesh into the pool, false if the mesh can't be (it is already in a pool, or
+    // its vertices are not in a single stream)
+    bool adopt(const MeshPointer& mesh);
+
+    // a range of size bytes, starting at a multiple of alignment
+    GeometryBufferAllocationPointer allocate(Kind kind, gpu::Size size, gpu::Size alignment);
+
+    Stats getStats() const;
+
+private:
+    using BlockPointer = GeometryBufferAllocation::BlockPointer;
+
+    const gpu::Size _blockSize;
+
+    mutable std::mutex _mutex;
+    std::vector<BlockPointer> _blocks[NUM_KINDS];
+    uint32_t _numMeshesAdopted { 0 };
+};
+
+class GeometryBufferAllocation::Block {
+public:
+    Block(gpu::Size size);
+
+    // the offset of the range, or false if the block has no room for it
+    bool allocate(gpu::Size size, gpu::Size alignment, gpu::Size& offset);
+    void release(gpu::Size offset, gpu::Size size);
+
+    const gpu::BufferPointer& getBuffer() const { return _buffer; }
+    gpu::Size getSize() const { return _size; }
+    gpu::Size getNumBytesUsed() const;
+    uint32_t getNumAllocations() const;
+
+private:
+    const gpu::BufferPointer _buffer;
+    const gpu::Size _size;
+
+    mutable std::mutex _mutex;
+    std::map<gpu::Size, gpu::Size> _freeRanges; // size by offset
+    gpu::Size _numBytesUsed { 0 };
+    uint32_t _numAllocations { 0 };
+};
+
+}
+
+#endif // hifi_graphics_GeometryBufferPool_h
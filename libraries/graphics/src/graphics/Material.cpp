@@ -10,6 +10,8 @@
 //
 #include "Material.h"
 
+#include <cstring>
+
 #include "TextureMap.h"
 
 #include <Transform.h>
@@ -283,6 +285,15 @@ void MultiMaterial::calculateMaterialInfo() const {
     }
 }
 
+void MultiMaterial::requestTextureMips(float pixels) const {
+    auto textures = _textureTable->getTextures();
+    for (auto const &texture : textures) {
+        if (texture && texture->getUsageType() == gpu::TextureUsageType::RESOURCE) {
+            texture->requestMipForSize(pixels);
+        }
+    }
+}
+
 void MultiMaterial::resetReferenceTexturesAndMaterials() {
     _referenceTextures.clear();
     _referenceMaterials.clear();
@@ -296,6 +307,20 @@ void MultiMaterial::addReferenceMaterial(const std::function<graphics::MaterialP
     _referenceMaterials.emplace_back(materialOperator, materialOperator());
 }
 
+bool MultiMaterial::hasSameContent(const MultiMaterial& other) const {
+    if (this == &other) {
+        return true;
+    }
+    if (_contentHash != other._contentHash || _cullFaceMode != other._cullFaceMode) {
+        return false;
+    }
+    // the schema is all 32 bit values, without padding
+    if (memcmp(&_schemaBuffer.get<Schema>(), &other._schemaBuffer.get<Schema>(), sizeof(Schema)) != 0) {
+        return false;
+    }
+    return _textureTable->getTextures() == other._textureTable->getTextures();
+}
+
 bool MultiMaterial::anyReferenceMaterialsOrTexturesChanged() const {
     for (auto textureOperatorPair : _referenceTextures) {
         if (textureOperatorPair.first() != textureOperatorPair.second) {
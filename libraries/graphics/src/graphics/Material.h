@@ -541,6 +541,8 @@ public:
     gpu::BufferView& getSchemaBuffer() { return _schemaBuffer; }
     graphics::MaterialKey getMaterialKey() const { return graphics::MaterialKey(_schemaBuffer.get<graphics::MultiMaterial::Schema>()._key); }
     const gpu::TextureTablePointer& getTextureTable() const { return _textureTable; }
+    // reports to the material's textures that they're drawn this many pixels across, see gpu::Texture::requestMip()
+    void requestTextureMips(float pixels) const;
 
     void setCullFaceMode(graphics::MaterialKey::CullFaceMode cullFaceMode) { _cullFaceMode = cullFaceMode; }
     graphics::MaterialKey::CullFaceMode getCullFaceMode() const { return _cullFaceMode; }
@@ -551,6 +553,13 @@ public:
 
     bool shouldUpdate() const { return !_initialized || _needsUpdate || _texturesLoading || anyReferenceMaterialsOrTexturesChanged(); }
 
+    // A hash of the schema and textures as of the last update: multi-materials with the same one bind the same state,
+    // whichever materials they were made of
+    void setContentHash(size_t contentHash) { _contentHash = contentHash; }
+    size_t getContentHash() const { return _contentHash; }
+    // whether the two bind the same schema, textures and cull face mode, as of their last updates
+    bool hasSameContent(const MultiMaterial& other) const;
+
     int getTextureCount() const { calculateMaterialInfo(); return _textureCount; }
     size_t getTextureSize()  const { calculateMaterialInfo(); return _textureSize; }
     bool hasTextureInfo() const { return _hasCalculatedTextureInfo; }
@@ -566,6 +575,7 @@ private:
     bool _needsUpdate { false };
     bool _texturesLoading { false };
     bool _initialized { false };
+    size_t _contentHash { 0 };
 
     mutable size_t _textureSize { 0 };
     mutable int _textureCount { 0 };
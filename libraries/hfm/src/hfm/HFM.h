@@ -27,6 +27,8 @@
 
 #include <image/ColorChannel.h>
 
+#include "HFMCompressedAnimation.h"
+
 #if defined(Q_OS_ANDROID)
 #define HFM_PACK_NORMALS 0
 #else
@@ -63,6 +65,12 @@ static const int DRACO_ATTRIBUTE_MATERIAL_ID = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTE
 static const int DRACO_ATTRIBUTE_TEX_COORD_1 = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 1;
 static const int DRACO_ATTRIBUTE_ORIGINAL_INDEX = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 2;
 
+// The draco metadata entries holding the simplified levels of detail of a mesh: how many there are, then for each level
+// its error and, for each material of the mesh's MaterialList, the point indices of its triangles
+static const char* const DRACO_METADATA_LOD_COUNT = "hifi.lodCount";
+static const char* const DRACO_METADATA_LOD_ERROR = "hifi.lod%1.error";
+static const char* const DRACO_METADATA_LOD_INDICES = "hifi.lod%1.material%2";
+
 // High Fidelity Model namespace
 namespace hfm {
 
@@ -155,6 +163,9 @@ public:
     QVector<int> quadIndices; // original indices from the FBX mesh
     QVector<int> quadTrianglesIndices; // original indices from the FBX mesh of the quad converted as triangles
     QVector<int> triangleIndices; // original indices from the FBX mesh
+    // the triangles of each simplified level of detail, one list for both the quad triangles and the triangles, from the
+    // least simplified to the most
+    QVector<QVector<int>> lodTriangleIndices;
 
     QString materialID;
 };
@@ -250,6 +261,9 @@ public:
 
     QVector<Blendshape> blendshapes;
 
+    // for each level of detail of the parts, how far its surface may be from the full detail one, in the units of the vertices
+    QVector<float> lodErrors;
+
     unsigned int meshIndex; // the order the meshes appeared in the object file
 
     graphics::MeshPointer _mesh;
@@ -281,6 +295,22 @@ public:
     {}
 };
 
+/// Collision shapes baked along with a model, for the clients to use instead of building them from its meshes.
+class CollisionShapes {
+public:
+    // the points of the convex hull of each mesh part with faces, in the frame of its mesh's vertices, for the model to
+    // collide as a compound of hulls
+    QVector<QVector<glm::vec3>> hulls;
+
+    // the triangles of all of the meshes, in the model frame, for the model to collide as a static mesh, along with the
+    // bounding volume hierarchy Bullet serialized over them (see BakedBVH.h)
+    QVector<glm::vec3> vertices;
+    QVector<int32_t> triangleIndices;
+    QByteArray bvh;
+
+    bool isEmpty() const { return hulls.isEmpty() && triangleIndices.isEmpty(); }
+};
+
 class FlowData {
 public:
     FlowData() {};
@@ -317,6 +347,8 @@ public:
     Extents meshExtents;
 
     QVector<AnimationFrame> animationFrames;
+    // set instead of the frames when the model was read from a baked animation, see Animation::getFrames()
+    CompressedAnimation::ConstPointer compressedAnimation;
 
     int getJointIndex(const QString& name) const { return jointIndices.value(name) - 1; }
     QStringList getJointNames() const;
@@ -340,6 +372,7 @@ public:
     QMap<int, glm::quat> jointRotationOffsets;
     std::vector<ShapeVertices> shapeVertices;
     FlowData flowData;
+    CollisionShapes collisionShapes;
 
     void debugDump();
 };
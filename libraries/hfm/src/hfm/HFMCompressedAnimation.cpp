@@ -0,0 +1,293 @@
+//
+//  HFMCompressedAnimation.cpp
+//  libraries/hfm/src/hfm
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMCompressedAnimation.h"
+
+#include <algorithm>
+
+#include <GLMHelpers.h>
+
+#include "HFM.h"
+
+using namespace hfm;
+
+const float CompressedAnimation::DEFAULT_ROTATION_TOLERANCE = 0.002f;
+const int CompressedAnimation::MAX_FRAME_COUNT = 0xffff;
+
+// Bounds the cost of the key reduction on long still tracks
+static const int MAX_KEY_GAP = 256;
+static const float QUANTIZED_RANGE = (float)0xffff;
+
+static float rotationDistance(const glm::quat& a, const glm::quat& b) {
+    return 2.0f * acosf(glm::min(1.0f, fabsf(glm::dot(a, b))));
+}
+
+static glm::quat interpolateRotation(const glm::quat& a, const glm::quat& b, float alpha) {
+    glm::quat bTemp = glm::dot(a, b) < 0.0f ? -b : b;
+    return glm::normalize(glm::lerp(a, bTemp, alpha));
+}
+
+// The frames to keep so interpolating the quantized values between them stays within tolerance of the original ones
+template <typename T, typename Interpolate, typename Distance>
+static std::vector<uint16_t> reduceKeys(const std::vector<T>& quantized, const std::vector<T>& original, float tolerance,
+                                        Interpolate interpolate, Distance distance) {
+    const int count = (int)original.size();
+    std::vector<uint16_t> keyFrames { 0 };
+    int start = 0;
+    while (start < count - 1) {
+        int end = start + 1;
+        while (end + 1 < count && end + 1 - start <= MAX_KEY_GAP) {
+            int candidate = end + 1;
+            bool fits = true;
+            for (int frame = start + 1; frame < candidate && fits; frame++) {
+                float alpha = (float)(frame - start) / (float)(candidate - start);
+                fits = distance(interpolate(quantized[start], quantized[candidate], alpha), original[frame]) <= tolerance;
+            }
+            if (!fits) {
+                break;
+            }
+            end = candidate;
+        }
+        keyFrames.push_back((uint16_t)end);
+        start = end;
+    }
+    return keyFrames;
+}
+
+CompressedAnimation::Pointer CompressedAnimation::compress(const QVector<AnimationFrame>& frames, float rotationTolerance,
+                                                           float translationTolerance) {
+    const int frameCount = frames.size();
+    if (frameCount == 0 || frameCount > MAX_FRAME_COUNT) {
+        return Pointer();
+    }
+    const int jointCount = frames[0].rotations.size();
+    for (const auto& frame : frames) {
+        if (frame.rotations.size() != jointCount || frame.translations.size() != jointCount) {
+            return Pointer();
+        }
+    }
+
+    auto animation = std::make_shared<CompressedAnimation>();
+    animation->_frameCount = frameCount;
+    animation->_rotationTracks.resize(jointCount);
+    animation->_translationTracks.resize(jointCount);
+
+    std::vector<glm::quat> rotations(frameCount);
+    std::vector<glm::quat> quantizedRotations(frameCount);
+    std::vector<glm::vec3> translations(frameCount);
+    std::vector<glm::vec3> quantizedTranslations(frameCount);
+    std::vector<uint8_t> packedRotations(frameCount * ROTATION_KEY_SIZE);
+    std::vector<uint16_t> packedTranslations(frameCount * 3);
+
+    for (int joint = 0; joint < jointCount; joint++) {
+        auto& rotationTrack = animation->_rotationTracks[joint];
+        for (int frame = 0; frame < frameCount; frame++) {
+            rotations[frame] = frames[frame].rotations[joint];
+            packOrientationQuatToSixBytes(&packedRotations[frame * ROTATION_KEY_SIZE], rotations[frame]);
+            unpackOrientationQuatFromSixBytes(&packedRotations[frame * ROTATION_KEY_SIZE], quantizedRotations[frame]);
+        }
+        rotationTrack.keyFrames = reduceKeys(quantizedRotations, rotations, rotationTolerance, interpolateRotation, rotationDistance);
+        for (auto keyFrame : rotationTrack.keyFrames) {
+            auto key = packedRotations.begin() + keyFrame * ROTATION_KEY_SIZE;
+            rotationTrack.keys.insert(rotationTrack.keys.end(), key, key + ROTATION_KEY_SIZE);
+        }
+
+        auto& translationTrack = animation->_translationTracks[joint];
+        glm::vec3 minimum = frames[0].translations[joint];
+        glm::vec3 maximum = minimum;
+        for (int frame = 0; frame < frameCount; frame++) {
+            translations[frame] = frames[frame].translations[joint];
+            minimum = glm::min(minimum, translations[frame]);
+            maximum = glm::max(maximum, translations[frame]);
+        }
+        translationTrack.minimum = minimum;
+        translationTrack.extent = maximum - minimum;
+        for (int frame = 0; frame < frameCount; frame++) {
+            for (int i = 0; i < 3; i++) {
+                float extent = translationTrack.extent[i];
+                float normalized = extent > 0.0f ? (translations[frame][i] - minimum[i]) / extent : 0.0f;
+                packedTranslations[frame * 3 + i] = (uint16_t)glm::round(glm::clamp(normalized, 0.0f, 1.0f) * QUANTIZED_RANGE);
+            }
+            quantizedTranslations[frame] = minimum + translationTrack.extent *
+                glm::vec3(packedTranslations[frame * 3], packedTranslations[frame * 3 + 1], packedTranslations[frame * 3 + 2]) / QUANTIZED_RANGE;
+        }
+        translationTrack.keyFrames = reduceKeys(quantizedTranslations, translations, translationTolerance,
+            [](const glm::vec3& a, const glm::vec3& b, float alpha) { return glm::mix(a, b, alpha); },
+            [](const glm::vec3& a, const glm::vec3& b) { return glm::distance(a, b); });
+        for (auto keyFrame : translationTrack.keyFrames) {
+            auto key = packedTranslations.begin() + keyFrame * 3;
+            translationTrack.keys.insert(translationTrack.keys.end(), key, key + 3);
+        }
+
+        // the bounds actually reached, with the quantization
+        for (int frame = 0; frame < frameCount; frame++) {
+            rotationTrack.error = glm::max(rotationTrack.error, rotationDistance(animation->sampleRotation(joint, (float)frame), rotations[frame]));
+            translationTrack.error = glm::max(translationTrack.error,
+                glm::distance(animation->sampleTranslation(joint, (float)frame), translations[frame]));
+        }
+    }
+
+    return animation;
+}
+
+static void writeKeyFrames(QDataStream& out, const std::vector<uint16_t>& keyFrames) {
+    out << (quint32)keyFrames.size();
+    for (auto keyFrame : keyFrames) {
+        out << (quint16)keyFrame;
+    }
+}
+
+static bool readKeyFrames(QDataStream& in, int frameCount, std::vector<uint16_t>& keyFrames) {
+    quint32 keyCount = 0;
+    in >> keyCount;
+    if (keyCount == 0 || keyCount > (quint32)frameCount) {
+        return false;
+    }
+    keyFrames.resize(keyCount);
+    for (auto& keyFrame : keyFrames) {
+        quint16 value;
+        in >> value;
+        keyFrame = value;
+    }
+    // sampling relies on the keys going from the first frame to the last one
+    return keyFrames.front() == 0 && keyFrames.back() == frameCount - 1 && std::is_sorted(keyFrames.begin(), keyFrames.end());
+}
+
+void CompressedAnimation::write(QDataStream& out) const {
+    out << (qint32)_frameCount << (qint32)getJointCount();
+    for (const auto& track : _rotationTracks) {
+        out << track.error;
+        writeKeyFrames(out, track.keyFrames);
+        out.writeRawData(reinterpret_cast<const char*>(track.keys.data()), (int)track.keys.size());
+    }
+    for (const auto& track : _translationTracks) {
+        out << track.minimum.x << track.minimum.y << track.minimum.z;
+        out << track.extent.x << track.extent.y << track.extent.z;
+        out << track.error;
+        writeKeyFrames(out, track.keyFrames);
+        for (auto key : track.keys) {
+            out << (quint16)key;
+        }
+    }
+}
+
+CompressedAnimation::Pointer CompressedAnimation::read(QDataStream& in) {
+    qint32 frameCount = 0;
+    qint32 jointCount = 0;
+    in >> frameCount >> jointCount;
+    if (in.status() != QDataStream::Ok || frameCount <= 0 || frameCount > MAX_FRAME_COUNT || jointCount < 0) {
+        return Pointer();
+    }
+
+    auto animation = std::make_shared<CompressedAnimation>();
+    animation->_frameCount = frameCount;
+    animation->_rotationTracks.resize(jointCount);
+    animation->_translationTracks.resize(jointCount);
+    for (auto& track : animation->_rotationTracks) {
+        in >> track.error;
+        if (!readKeyFrames(in, frameCount, track.keyFrames)) {
+            return Pointer();
+        }
+        track.keys.resize(track.keyFrames.size() * ROTATION_KEY_SIZE);
+        if (in.readRawData(reinterpret_cast<char*>(track.keys.data()), (int)track.keys.size()) != (int)track.keys.size()) {
+            return Pointer();
+        }
+    }
+    for (auto& track : animation->_translationTracks) {
+        in >> track.minimum.x >> track.minimum.y >> track.minimum.z;
+        in >> track.extent.x >> track.extent.y >> track.extent.z;
+        in >> track.error;
+        if (!readKeyFrames(in, frameCount, track.keyFrames)) {
+            return Pointer();
+        }
+        track.keys.resize(track.keyFrames.size() * 3);
+        for (auto& key : track.keys) {
+            quint16 value;
+            in >> value;
+            key = value;
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return Pointer();
+    }
+    return animation;
+}
+
+void CompressedAnimation::findSegment(const std::vector<uint16_t>& keyFrames, float frame, size_t& key, float& alpha) {
+    // the last key with a frame not after the sampled one
+    auto next = std::upper_bound(keyFrames.begin(), keyFrames.end(), frame,
+                                 [](float frame, uint16_t keyFrame) { return frame < (float)keyFrame; });
+    if (next == keyFrames.begin()) {
+        key = 0;
+        alpha = 0.0f;
+    } else if (next == keyFrames.end()) {
+        key = keyFrames.size() - 1;
+        alpha = 0.0f;
+    } else {
+        key = (next - keyFrames.begin()) - 1;
+        alpha = (frame - (float)keyFrames[key]) / (float)(*next - keyFrames[key]);
+    }
+}
+
+glm::quat CompressedAnimation::decodeRotation(const RotationTrack& track, size_t key) {
+    glm::quat rotation;
+    unpackOrientationQuatFromSixBytes(&track.keys[key * ROTATION_KEY_SIZE], rotation);
+    return rotation;
+}
+
+glm::vec3 CompressedAnimation::decodeTranslation(const TranslationTrack& track, size_t key) {
+    const uint16_t* values = &track.keys[key * 3];
+    return track.minimum + track.extent * glm::vec3(values[0], values[1], values[2]) / QUANTIZED_RANGE;
+}
+
+glm::quat CompressedAnimation::sampleRotation(int jointIndex, float frame) const {
+    const auto& track = _rotationTracks[jointIndex];
+    size_t key;
+    float alpha;
+    findSegment(track.keyFrames, frame, key, alpha);
+    if (alpha == 0.0f) {
+        return decodeRotation(track, key);
+    }
+    return interpolateRotation(decodeRotation(track, key), decodeRotation(track, key + 1), alpha);
+}
+
+glm::vec3 CompressedAnimation::sampleTranslation(int jointIndex, float frame) const {
+    const auto& track = _translationTracks[jointIndex];
+    size_t key;
+    float alpha;
+    findSegment(track.keyFrames, frame, key, alpha);
+    if (alpha == 0.0f) {
+        return decodeTranslation(track, key);
+    }
+    return glm::mix(decodeTranslation(track, key), decodeTranslation(track, key + 1), alpha);
+}
+
+void CompressedAnimation::decodeFrame(int frame, AnimationFrame& result) const {
+    const int jointCount = getJointCount();
+    result.rotations.resize(jointCount);
+    result.translations.resize(jointCount);
+    for (int joint = 0; joint < jointCount; joint++) {
+        result.rotations[joint] = sampleRotation(joint, (float)frame);
+        result.translations[joint] = sampleTranslation(joint, (float)frame);
+    }
+}
+
+size_t CompressedAnimation::getByteSize() const {
+    size_t size = sizeof(CompressedAnimation);
+    for (const auto& track : _rotationTracks) {
+        size += sizeof(RotationTrack) + track.keyFrames.size() * sizeof(uint16_t) + track.keys.size();
+    }
+    for (const auto& track : _translationTracks) {
+        size += sizeof(TranslationTrack) + (track.keyFrames.size() + track.keys.size()) * sizeof(uint16_t);
+    }
+    return size;
+}
@@ -0,0 +1,91 @@
+//
+//  HFMCompressedAnimation.h
+//  libraries/hfm/src/hfm
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMCompressedAnimation_h
+#define hifi_HFMCompressedAnimation_h
+
+#include <memory>
+#include <vector>
+
+#include <QDataStream>
+#include <QVector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace hfm {
+
+class AnimationFrame;
+
+// The joint rotations and translations of an animation, one track per joint and channel.
+// Each track only keeps the frames that linear interpolation can't rebuild within its tolerance,
+// with the rotations packed in six bytes and the translations quantized to 16 bits in the track's bounds.
+// The tracks are sampled directly, at any frame.
+class CompressedAnimation {
+public:
+    using Pointer = std::shared_ptr<CompressedAnimation>;
+    using ConstPointer = std::shared_ptr<const CompressedAnimation>;
+
+    static const float DEFAULT_ROTATION_TOLERANCE; // radians
+    static const int MAX_FRAME_COUNT;
+
+    // translationTolerance is in the units of the animation's translations.
+    // Returns null if there are no frames or more than MAX_FRAME_COUNT.
+    static Pointer compress(const QVector<AnimationFrame>& frames, float rotationTolerance, float translationTolerance);
+
+    // Returns null if the stream doesn't hold a valid animation
+    static Pointer read(QDataStream& in);
+    void write(QDataStream& out) const;
+
+    int getFrameCount() const { return _frameCount; }
+    int getJointCount() const { return (int)_rotationTracks.size(); }
+
+    // frame is clamped to [0, frameCount - 1]
+    glm::quat sampleRotation(int jointIndex, float frame) const;
+    glm::vec3 sampleTranslation(int jointIndex, float frame) const;
+
+    void decodeFrame(int frame, AnimationFrame& result) const;
+
+    // The largest error of the track's samples at the original frames, radians or translation units
+    float getRotationError(int jointIndex) const { return _rotationTracks[jointIndex].error; }
+    float getTranslationError(int jointIndex) const { return _translationTracks[jointIndex].error; }
+
+    size_t getByteSize() const;
+
+protected:
+    static const int ROTATION_KEY_SIZE { 6 };
+
+    struct RotationTrack {
+        std::vector<uint16_t> keyFrames;
+        std::vector<uint8_t> keys; // ROTATION_KEY_SIZE bytes per key
+        float error { 0.0f };
+    };
+
+    struct TranslationTrack {
+        glm::vec3 minimum { 0.0f };
+        glm::vec3 extent { 0.0f };
+        std::vector<uint16_t> keyFrames;
+        std::vector<uint16_t> keys; // 3 per key
+        float error { 0.0f };
+    };
+
+    static void findSegment(const std::vector<uint16_t>& keyFrames, float frame, size_t& key, float& alpha);
+    static glm::quat decodeRotation(const RotationTrack& track, size_t key);
+    static glm::vec3 decodeTranslation(const TranslationTrack& track, size_t key);
+
+    int _frameCount { 0 };
+    std::vector<RotationTrack> _rotationTracks;
+    std::vector<TranslationTrack> _translationTracks;
+};
+
+};
+
+#endif // hifi_HFMCompressedAnimation_h
@@ -0,0 +1,114 @@
+//
+//  ImageConversion_avx2.cpp
+//  libraries/image/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include <glm/glm.hpp>
+
+namespace image {
+
+static const float R11G11B10F_MIN_VALUE = 6.10e-5f;
+static const float R11G11B10F_MAX_VALUE = 6.50e4f;
+static const float MAX_COLOR_VALUE = 255.0f;
+
+// puts the pixels of [0, 2, 4, 6, 1, 3, 5, 7], as packing two pixels per register leaves them, back in order
+static inline __m256i unpackPixelOrder(__m256i pixels) {
+    return _mm256_permutevar8x32_epi32(pixels, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+size_t argb32ToFloat_AVX2(const uint32_t* source, glm::vec4* output, size_t count) {
+    const __m256 maxColor = _mm256_set1_ps(MAX_COLOR_VALUE);
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m256i bgra = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(source + i)));
+        __m256 color = _mm256_cvtepi32_ps(bgra);
+        color = _mm256_shuffle_ps(color, color, _MM_SHUFFLE(3, 0, 1, 2));
+        _mm256_storeu_ps(&output[i].x, _mm256_div_ps(color, maxColor));
+    }
+    return i;
+}
+
+static inline __m256i floatToBGRA32(const glm::vec4* pixels) {
+    const __m256 maxColor = _mm256_set1_ps(MAX_COLOR_VALUE);
+    __m256 color = _mm256_mul_ps(_mm256_loadu_ps(&pixels->x), maxColor);
+    color = _mm256_min_ps(_mm256_max_ps(color, _mm256_setzero_ps()), maxColor);
+    return _mm256_shuffle_epi32(_mm256_cvttps_epi32(color), _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+size_t floatToARGB32_AVX2(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i low = _mm256_packs_epi32(floatToBGRA32(source + i), floatToBGRA32(source + i + 2));
+        __m256i high = _mm256_packs_epi32(floatToBGRA32(source + i + 4), floatToBGRA32(source + i + 6));
+        _mm256_storeu_si256((__m256i*)(output + i), unpackPixelOrder(_mm256_packus_epi16(low, high)));
+    }
+    return i;
+}
+
+// packs the two pixels of RGBA floats in a register, each element as its channel of glm::packF2x11_1x10(), with the
+// pixel's value then in every element of its half
+static inline __m256i packR11G11B10F(const glm::vec4* pixels) {
+    const __m256i shift = _mm256_setr_epi32(17, 17, 18, 0, 17, 17, 18, 0);
+    const __m256i exponentMask = _mm256_setr_epi32(0x7c0, 0x7c0, 0x3e0, 0, 0x7c0, 0x7c0, 0x3e0, 0);
+    const __m256i mantissaMask = _mm256_setr_epi32(0x3f, 0x3f, 0x1f, 0, 0x3f, 0x3f, 0x1f, 0);
+    const __m256i channelShift = _mm256_setr_epi32(0, 11, 22, 0, 0, 11, 22, 0);
+
+    // values below the smallest normal become 0, NaN stay NaN as min returns its second operand for them
+    __m256 value = _mm256_loadu_ps(&pixels->x);
+    value = _mm256_andnot_ps(_mm256_cmp_ps(value, _mm256_set1_ps(R11G11B10F_MIN_VALUE), _CMP_LT_OQ), value);
+    value = _mm256_min_ps(_mm256_set1_ps(R11G11B10F_MAX_VALUE), value);
+
+    __m256i bits = _mm256_castps_si256(value);
+    __m256i exponent = _mm256_sub_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7f800000)), _mm256_set1_epi32(0x38000000));
+    exponent = _mm256_and_si256(_mm256_srlv_epi32(exponent, shift), exponentMask);
+    __m256i mantissa = _mm256_and_si256(_mm256_srlv_epi32(bits, shift), mantissaMask);
+    __m256i packed = _mm256_or_si256(exponent, mantissa);
+
+    __m256i isZero = _mm256_castps_si256(_mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    __m256i isNaN = _mm256_castps_si256(_mm256_cmp_ps(value, value, _CMP_UNORD_Q));
+    packed = _mm256_andnot_si256(isZero, packed);
+    packed = _mm256_blendv_epi8(packed, _mm256_or_si256(exponentMask, mantissaMask), isNaN);
+    packed = _mm256_sllv_epi32(packed, channelShift);
+
+    packed = _mm256_or_si256(packed, _mm256_shuffle_epi32(packed, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm256_or_si256(packed, _mm256_shuffle_epi32(packed, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+size_t floatToR11G11B10F_AVX2(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i packed = _mm256_blend_epi32(packR11G11B10F(source + i), packR11G11B10F(source + i + 2), 0x22);
+        packed = _mm256_blend_epi32(packed, packR11G11B10F(source + i + 4), 0x44);
+        packed = _mm256_blend_epi32(packed, packR11G11B10F(source + i + 6), 0x88);
+        _mm256_storeu_si256((__m256i*)(output + i), unpackPixelOrder(packed));
+    }
+    return i;
+}
+
+size_t channelToRed_AVX2(uint32_t* pixels, size_t count, int shift) {
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    const __m256i channelMask = _mm256_set1_epi32(0xff);
+    const __m256i opaque = _mm256_set1_epi32((int)0xff000000);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i value = _mm256_srl_epi32(_mm256_loadu_si256((const __m256i*)(pixels + i)), shiftCount);
+        value = _mm256_and_si256(value, channelMask);
+        _mm256_storeu_si256((__m256i*)(pixels + i), _mm256_or_si256(_mm256_slli_epi32(value, 16), opaque));
+    }
+    return i;
+}
+
+}
+
+#endif
@@ -506,6 +506,25 @@ glm::vec4 CubeMap::fetchLod(const glm::vec3& dir, float lod) const {
 struct CubeMap::GGXSamples {
     float invTotalWeight;
     std::vector<glm::vec4> points;
+
+    // the mips each point is fetched from, worked out once for all the texels rather than for every fetch
+    struct Lod {
+        gpu::uint16 loLevel;
+        gpu::uint16 hiLevel;
+        float lodFrac;
+    };
+    std::vector<Lod> lods;
+
+    void computeLods(gpu::uint16 mipCount) {
+        lods.resize(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            float lod = glm::clamp<float>(points[i].w, 0.0f, mipCount - 1);
+            auto& sampleLod = lods[i];
+            sampleLod.loLevel = (gpu::uint16)std::floor(lod);
+            sampleLod.hiLevel = (gpu::uint16)std::ceil(lod);
+            sampleLod.lodFrac = lod - (float)sampleLod.loLevel;
+        }
+    }
 };
 
 // All the GGX convolution code is inspired from:
@@ -577,6 +596,12 @@ void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProc
 
     params.points.reserve(MAX_SAMPLE_COUNT);
 
+    std::vector<ConstMip> mips;
+    mips.reserve(mipCount);
+    for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
+        mips.emplace_back(mipLevel, this);
+    }
+
     for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
         // This is the inverse code found in LightAmbient.slh in getMipLevelFromRoughness
         float levelAlpha = float(mipLevel) / (mipCount - ROUGHNESS_1_MIP_RESOLUTION);
@@ -593,17 +618,19 @@ void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProc
 
         params.points.resize(sampleCount);
         generateGGXSamples(params, mipRoughness, _width);
+        params.computeLods(mipCount);
 
-        for (int face = 0; face < 6; face++) {
-            convolveMipFaceForGGX(params, output, mipLevel, face, abortProcessing);
-            if (abortProcessing.load()) {
-                return;
-            }
+        // the faces at the same time, so that the smaller mips keep all the cores busy too
+        tbb::parallel_for(0, 6, [&](int face) {
+            convolveMipFaceForGGX(params, mips, output, mipLevel, face, abortProcessing);
+        });
+        if (abortProcessing.load()) {
+            return;
         }
     }
 }
 
-void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output, gpu::uint16 mipLevel, int face, const std::atomic<bool>& abortProcessing) const {
+void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, const std::vector<ConstMip>& mips, CubeMap& output, gpu::uint16 mipLevel, int face, const std::atomic<bool>& abortProcessing) const {
     const glm::vec3* faceNormals = FACE_NORMALS + face * 4;
     const glm::vec3 deltaYNormalLo = faceNormals[2] - faceNormals[0];
     const glm::vec3 deltaYNormalHi = faceNormals[3] - faceNormals[1];
@@ -630,13 +657,13 @@ void CubeMap::convolveMipFaceForGGX(const GGXSamples& samples, CubeMap& output,
                 // Interpolate normal for this pixel
                 const glm::vec3 normal = glm::normalize(normalXLo + deltaXNormal * xAlpha);
 
-                outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples);
+                outputFacePixels[x + y * outputLineStride] = computeConvolution(normal, samples, mips);
             }
         }
     });
 }
 
-glm::vec4 CubeMap::computeConvolution(const glm::vec3& N, const GGXSamples& samples) const {
+glm::vec4 CubeMap::computeConvolution(const glm::vec3& N, const GGXSamples& samples, const std::vector<ConstMip>& mips) const {
     // from tangent-space vector to world-space
     glm::vec3 bitangent = std::abs(N.z) < 0.999f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
     glm::vec3 tangent = glm::normalize(glm::cross(bitangent, N));
@@ -647,12 +674,22 @@ glm::vec4 CubeMap::computeConvolution(const glm::vec3& N, const GGXSamples& samp
 
     for (size_t i = 0; i < sampleCount; ++i) {
         const auto& sample = samples.points[i];
+        const auto& sampleLod = samples.lods[i];
         glm::vec3 L(sample.x, sample.y, sample.z);
         float NdotL = L.z;
-        float mipLevel = sample.w;
         // Now back to world space
         L = tangent * L.x + bitangent * L.y + N * L.z;
-        prefilteredColor += fetchLod(L, mipLevel) * NdotL;
+
+        int face;
+        glm::vec2 uv;
+        getFaceUV(L, &face, &uv);
+        glm::vec4 color = mips[sampleLod.loLevel].fetch(face, uv);
+        // most samples of the sharper mips are from a single mip
+        if (sampleLod.lodFrac > 0.0f) {
+            glm::vec4 hiColor = mips[sampleLod.hiLevel].fetch(face, uv);
+            color += (hiColor - color) * sampleLod.lodFrac;
+        }
+        prefilteredColor += color * NdotL;
     }
     prefilteredColor = prefilteredColor * samples.invTotalWeight;
     prefilteredColor.a = 1.0f;
@@ -1,6 +1,7 @@
 #include "Image.h"
 #include "ImageLogging.h"
 #include "TextureProcessing.h"
+#include "ImageConversion.h"
 
 #include <nvtt/nvtt.h>
 
@@ -182,6 +183,15 @@ Image Image::getConvertedToFormat(Format newFormat) const {
                 convertToPackedFromFloat(newImage.editBits(), _dims.x, _dims.y, getBytesPerLineCount(), gpu::Element::COLOR_R11G11B10, _floatData.data(), _dims.x);
                 break;
 
+            case Format_ARGB32:
+            {
+                const auto& kernels = getConversionKernels();
+                for (int y = 0; y < _dims.y; y++) {
+                    kernels.floatToARGB32(_floatData.data() + y * _dims.x, reinterpret_cast<uint32_t*>(newImage.editScanLine(y)), _dims.x);
+                }
+                break;
+            }
+
             default:
             {
                 FloatPixels::const_iterator srcIt = _floatData.begin();
@@ -202,15 +212,9 @@ Image Image::getConvertedToFormat(Format newFormat) const {
         assert(newImage.hasFloatFormat());
 
         if (newFormat == Format_RGBAF) {
-            FloatPixels::iterator dstIt = newImage._floatData.begin();
-
+            const auto& kernels = getConversionKernels();
             for (int y = 0; y < _dims.y; y++) {
-                auto line = (const QRgb*)getScanLine(y);
-                for (int x = 0; x < _dims.x; x++) {
-                    QRgb pixel = line[x];
-                    *dstIt = glm::vec4(qRed(pixel), qGreen(pixel), qBlue(pixel), qAlpha(pixel)) / MAX_COLOR_VALUE;
-                    dstIt++;
-                }
+                kernels.argb32ToFloat((const uint32_t*)getScanLine(y), newImage._floatData.data() + y * _dims.x, _dims.x);
             }
         } else {
             auto packFunc = getHDRPackingFunction();
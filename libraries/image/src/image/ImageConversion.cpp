@@ -0,0 +1,345 @@
+//
+//  ImageConversion.cpp
+//  libraries/image/src/image
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageConversion.h"
+
+#include <algorithm>
+
+#include <glm/gtc/packing.hpp>
+
+#include <CPUDetect.h>
+
+#if defined(ARCH_X86)
+#include <smmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define IMAGE_CONVERSION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace image {
+
+// See https://www.khronos.org/opengl/wiki/Small_Float_Formats for these values
+static const float R11G11B10F_MIN_VALUE = 6.10e-5f;
+static const float R11G11B10F_MAX_VALUE = 6.50e4f;
+static const float MAX_COLOR_VALUE = 255.0f;
+
+// where the channel is in a QRgb
+static int getChannelShift(ColorChannel channel) {
+    switch (channel) {
+        case ColorChannel::GREEN:
+            return 8;
+        case ColorChannel::BLUE:
+            return 0;
+        case ColorChannel::ALPHA:
+            return 24;
+        case ColorChannel::RED:
+        default:
+            return 16;
+    }
+}
+
+//
+// Scalar reference code
+//
+
+static void argb32ToFloatScalar(const uint32_t* source, glm::vec4* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t pixel = source[i];
+        output[i] = glm::vec4((pixel >> 16) & 0xff, (pixel >> 8) & 0xff, pixel & 0xff, pixel >> 24) / MAX_COLOR_VALUE;
+    }
+}
+
+static void floatToARGB32Scalar(const glm::vec4* source, uint32_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        glm::ivec4 color = glm::clamp(source[i] * MAX_COLOR_VALUE, 0.0f, MAX_COLOR_VALUE);
+        output[i] = ((uint32_t)color.a << 24) | ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | (uint32_t)color.b;
+    }
+}
+
+static float clampSmallFloat(float value) {
+    // below the smallest normal any value would unpack wrong
+    value = value < R11G11B10F_MIN_VALUE ? 0.0f : value;
+    return std::min(value, R11G11B10F_MAX_VALUE);
+}
+
+static void floatToR11G11B10FScalar(const glm::vec4* source, uint32_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec4& color = source[i];
+        output[i] = glm::packF2x11_1x10(glm::vec3(clampSmallFloat(color.r), clampSmallFloat(color.g), clampSmallFloat(color.b)));
+    }
+}
+
+static void channelToRedScalar(uint32_t* pixels, size_t count, ColorChannel channel) {
+    int shift = getChannelShift(channel);
+    for (size_t i = 0; i < count; ++i) {
+        pixels[i] = 0xff000000 | (((pixels[i] >> shift) & 0xff) << 16);
+    }
+}
+
+static const ConversionKernels SCALAR_KERNELS {
+    "scalar", argb32ToFloatScalar, floatToARGB32Scalar, floatToR11G11B10FScalar, channelToRedScalar
+};
+
+#if defined(ARCH_X86)
+
+//
+// SSE4.1 code, built for SSE4.1 whatever the rest of the library targets and only called once the CPU is known to
+// support it
+//
+
+#if defined(__GNUC__)
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define TARGET_SSE41
+#endif
+
+TARGET_SSE41 static void argb32ToFloatSSE41(const uint32_t* source, glm::vec4* output, size_t count) {
+    const __m128 maxColor = _mm_set1_ps(MAX_COLOR_VALUE);
+    for (size_t i = 0; i < count; ++i) {
+        __m128 bgra = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128((int)source[i])));
+        __m128 rgba = _mm_shuffle_ps(bgra, bgra, _MM_SHUFFLE(3, 0, 1, 2));
+        _mm_storeu_ps(&output[i].x, _mm_div_ps(rgba, maxColor));
+    }
+}
+
+TARGET_SSE41 static inline __m128i floatToBGRA32SSE41(const glm::vec4& pixel) {
+    const __m128 maxColor = _mm_set1_ps(MAX_COLOR_VALUE);
+    __m128 color = _mm_mul_ps(_mm_loadu_ps(&pixel.x), maxColor);
+    color = _mm_min_ps(_mm_max_ps(color, _mm_setzero_ps()), maxColor);
+    return _mm_shuffle_epi32(_mm_cvttps_epi32(color), _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+TARGET_SSE41 static void floatToARGB32SSE41(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i low = _mm_packs_epi32(floatToBGRA32SSE41(source[i]), floatToBGRA32SSE41(source[i + 1]));
+        __m128i high = _mm_packs_epi32(floatToBGRA32SSE41(source[i + 2]), floatToBGRA32SSE41(source[i + 3]));
+        _mm_storeu_si128((__m128i*)(output + i), _mm_packus_epi16(low, high));
+    }
+    floatToARGB32Scalar(source + i, output + i, count - i);
+}
+
+TARGET_SSE41 static inline __m128 clampSmallFloatSSE41(__m128 value) {
+    // as clampSmallFloat(), the second operand of min is the one returned for NaN, so they stay NaN
+    value = _mm_andnot_ps(_mm_cmplt_ps(value, _mm_set1_ps(R11G11B10F_MIN_VALUE)), value);
+    return _mm_min_ps(_mm_set1_ps(R11G11B10F_MAX_VALUE), value);
+}
+
+// the bits of one channel of glm::packF2x11_1x10(), packed straight from the float's bits as glm does
+TARGET_SSE41 static inline __m128i packSmallFloatSSE41(__m128 value, int mantissaBits) {
+    __m128i shift = _mm_cvtsi32_si128(23 - mantissaBits);
+    __m128i bits = _mm_castps_si128(value);
+    __m128i exponent = _mm_sub_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x7f800000)), _mm_set1_epi32(0x38000000));
+    exponent = _mm_and_si128(_mm_srl_epi32(exponent, shift), _mm_set1_epi32(0x1f << mantissaBits));
+    __m128i mantissa = _mm_and_si128(_mm_srl_epi32(bits, shift), _mm_set1_epi32((1 << mantissaBits) - 1));
+    __m128i packed = _mm_or_si128(exponent, mantissa);
+
+    __m128i isZero = _mm_castps_si128(_mm_cmpeq_ps(value, _mm_setzero_ps()));
+    __m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(value, value));
+    packed = _mm_andnot_si128(isZero, packed);
+    return _mm_blendv_epi8(packed, _mm_set1_epi32((1 << (mantissaBits + 5)) - 1), isNaN);
+}
+
+TARGET_SSE41 static void floatToR11G11B10FSSE41(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 red = _mm_loadu_ps(&source[i].x);
+        __m128 green = _mm_loadu_ps(&source[i + 1].x);
+        __m128 blue = _mm_loadu_ps(&source[i + 2].x);
+        __m128 alpha = _mm_loadu_ps(&source[i + 3].x);
+        _MM_TRANSPOSE4_PS(red, green, blue, alpha);
+
+        __m128i packed = packSmallFloatSSE41(clampSmallFloatSSE41(red), 6);
+        packed = _mm_or_si128(packed, _mm_slli_epi32(packSmallFloatSSE41(clampSmallFloatSSE41(green), 6), 11));
+        packed = _mm_or_si128(packed, _mm_slli_epi32(packSmallFloatSSE41(clampSmallFloatSSE41(blue), 5), 22));
+        _mm_storeu_si128((__m128i*)(output + i), packed);
+    }
+    floatToR11G11B10FScalar(source + i, output + i, count - i);
+}
+
+TARGET_SSE41 static void channelToRedSSE41(uint32_t* pixels, size_t count, ColorChannel channel) {
+    __m128i shift = _mm_cvtsi32_si128(getChannelShift(channel));
+    const __m128i channelMask = _mm_set1_epi32(0xff);
+    const __m128i opaque = _mm_set1_epi32((int)0xff000000);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i value = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128((const __m128i*)(pixels + i)), shift), channelMask);
+        _mm_storeu_si128((__m128i*)(pixels + i), _mm_or_si128(_mm_slli_epi32(value, 16), opaque));
+    }
+    channelToRedScalar(pixels + i, count - i, channel);
+}
+
+static const ConversionKernels SSE41_KERNELS {
+    "sse4.1", argb32ToFloatSSE41, floatToARGB32SSE41, floatToR11G11B10FSSE41, channelToRedSSE41
+};
+
+//
+// AVX2 code, in avx2/ImageConversion_avx2.cpp. Each converts as many whole blocks of pixels as there are and returns
+// how many that was, the rest are left to the scalar code.
+//
+
+size_t argb32ToFloat_AVX2(const uint32_t* source, glm::vec4* output, size_t count);
+size_t floatToARGB32_AVX2(const glm::vec4* source, uint32_t* output, size_t count);
+size_t floatToR11G11B10F_AVX2(const glm::vec4* source, uint32_t* output, size_t count);
+size_t channelToRed_AVX2(uint32_t* pixels, size_t count, int shift);
+
+static void argb32ToFloatAVX2(const uint32_t* source, glm::vec4* output, size_t count) {
+    size_t converted = argb32ToFloat_AVX2(source, output, count);
+    argb32ToFloatScalar(source + converted, output + converted, count - converted);
+}
+
+static void floatToARGB32AVX2(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t converted = floatToARGB32_AVX2(source, output, count);
+    floatToARGB32Scalar(source + converted, output + converted, count - converted);
+}
+
+static void floatToR11G11B10FAVX2(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t converted = floatToR11G11B10F_AVX2(source, output, count);
+    floatToR11G11B10FScalar(source + converted, output + converted, count - converted);
+}
+
+static void channelToRedAVX2(uint32_t* pixels, size_t count, ColorChannel channel) {
+    size_t converted = channelToRed_AVX2(pixels, count, getChannelShift(channel));
+    channelToRedScalar(pixels + converted, count - converted, channel);
+}
+
+static const ConversionKernels AVX2_KERNELS {
+    "avx2", argb32ToFloatAVX2, floatToARGB32AVX2, floatToR11G11B10FAVX2, channelToRedAVX2
+};
+
+#elif defined(IMAGE_CONVERSION_NEON)
+
+//
+// NEON code, which every AArch64 CPU has
+//
+
+static void argb32ToFloatNEON(const uint32_t* source, glm::vec4* output, size_t count) {
+    const float32x4_t maxColor = vdupq_n_f32(MAX_COLOR_VALUE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // each QRgb is stored as B, G, R, A bytes
+        uint8x8x4_t bgra = vld4_u8(reinterpret_cast<const uint8_t*>(source + i));
+        uint16x8_t red = vmovl_u8(bgra.val[2]);
+        uint16x8_t green = vmovl_u8(bgra.val[1]);
+        uint16x8_t blue = vmovl_u8(bgra.val[0]);
+        uint16x8_t alpha = vmovl_u8(bgra.val[3]);
+
+        float32x4x4_t rgba;
+        rgba.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(red))), maxColor);
+        rgba.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(green))), maxColor);
+        rgba.val[2] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(blue))), maxColor);
+        rgba.val[3] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(alpha))), maxColor);
+        vst4q_f32(&output[i].x, rgba);
+
+        rgba.val[0] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(red))), maxColor);
+        rgba.val[1] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(green))), maxColor);
+        rgba.val[2] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(blue))), maxColor);
+        rgba.val[3] = vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(alpha))), maxColor);
+        vst4q_f32(&output[i + 4].x, rgba);
+    }
+    argb32ToFloatScalar(source + i, output + i, count - i);
+}
+
+static inline uint32x4_t floatToColorNEON(float32x4_t value) {
+    const float32x4_t maxColor = vdupq_n_f32(MAX_COLOR_VALUE);
+    value = vminq_f32(vmaxq_f32(vmulq_f32(value, maxColor), vdupq_n_f32(0.0f)), maxColor);
+    return vcvtq_u32_f32(value);
+}
+
+static void floatToARGB32NEON(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x4_t rgba = vld4q_f32(&source[i].x);
+        uint32x4_t pixels = vshlq_n_u32(floatToColorNEON(rgba.val[3]), 24);
+        pixels = vorrq_u32(pixels, vshlq_n_u32(floatToColorNEON(rgba.val[0]), 16));
+        pixels = vorrq_u32(pixels, vshlq_n_u32(floatToColorNEON(rgba.val[1]), 8));
+        pixels = vorrq_u32(pixels, floatToColorNEON(rgba.val[2]));
+        vst1q_u32(output + i, pixels);
+    }
+    floatToARGB32Scalar(source + i, output + i, count - i);
+}
+
+static inline float32x4_t clampSmallFloatNEON(float32x4_t value) {
+    // vminq_f32 returns NaN if either is, so they stay NaN as in clampSmallFloat()
+    uint32x4_t isSmall = vcltq_f32(value, vdupq_n_f32(R11G11B10F_MIN_VALUE));
+    value = vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(value), isSmall));
+    return vminq_f32(value, vdupq_n_f32(R11G11B10F_MAX_VALUE));
+}
+
+static inline uint32x4_t packSmallFloatNEON(float32x4_t value, int mantissaBits) {
+    int32x4_t shift = vdupq_n_s32(mantissaBits - 23);
+    uint32x4_t bits = vreinterpretq_u32_f32(value);
+    uint32x4_t exponent = vsubq_u32(vandq_u32(bits, vdupq_n_u32(0x7f800000)), vdupq_n_u32(0x38000000));
+    exponent = vandq_u32(vshlq_u32(exponent, shift), vdupq_n_u32(0x1f << mantissaBits));
+    uint32x4_t mantissa = vandq_u32(vshlq_u32(bits, shift), vdupq_n_u32((1 << mantissaBits) - 1));
+    uint32x4_t packed = vorrq_u32(exponent, mantissa);
+
+    uint32x4_t isZero = vceqq_f32(value, vdupq_n_f32(0.0f));
+    uint32x4_t isNaN = vmvnq_u32(vceqq_f32(value, value));
+    packed = vbicq_u32(packed, isZero);
+    return vbslq_u32(isNaN, vdupq_n_u32((1 << (mantissaBits + 5)) - 1), packed);
+}
+
+static void floatToR11G11B10FNEON(const glm::vec4* source, uint32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x4_t rgba = vld4q_f32(&source[i].x);
+        uint32x4_t packed = packSmallFloatNEON(clampSmallFloatNEON(rgba.val[0]), 6);
+        packed = vorrq_u32(packed, vshlq_n_u32(packSmallFloatNEON(clampSmallFloatNEON(rgba.val[1]), 6), 11));
+        packed = vorrq_u32(packed, vshlq_n_u32(packSmallFloatNEON(clampSmallFloatNEON(rgba.val[2]), 5), 22));
+        vst1q_u32(output + i, packed);
+    }
+    floatToR11G11B10FScalar(source + i, output + i, count - i);
+}
+
+static void channelToRedNEON(uint32_t* pixels, size_t count, ColorChannel channel) {
+    int32x4_t shift = vdupq_n_s32(-getChannelShift(channel));
+    const uint32x4_t channelMask = vdupq_n_u32(0xff);
+    const uint32x4_t opaque = vdupq_n_u32(0xff000000);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        uint32x4_t value = vandq_u32(vshlq_u32(vld1q_u32(pixels + i), shift), channelMask);
+        vst1q_u32(pixels + i, vorrq_u32(vshlq_n_u32(value, 16), opaque));
+    }
+    channelToRedScalar(pixels + i, count - i, channel);
+}
+
+static const ConversionKernels NEON_KERNELS {
+    "neon", argb32ToFloatNEON, floatToARGB32NEON, floatToR11G11B10FNEON, channelToRedNEON
+};
+
+#endif
+
+const ConversionKernels& getScalarConversionKernels() {
+    return SCALAR_KERNELS;
+}
+
+std::vector<const ConversionKernels*> getSupportedConversionKernels() {
+    std::vector<const ConversionKernels*> kernels { &SCALAR_KERNELS };
+#if defined(ARCH_X86)
+    if (cpuSupportsSSE41()) {
+        kernels.push_back(&SSE41_KERNELS);
+    }
+    if (cpuSupportsAVX2()) {
+        kernels.push_back(&AVX2_KERNELS);
+    }
+#elif defined(IMAGE_CONVERSION_NEON)
+    kernels.push_back(&NEON_KERNELS);
+#endif
+    return kernels;
+}
+
+const ConversionKernels& getConversionKernels() {
+    static const ConversionKernels& kernels = *getSupportedConversionKernels().back();
+    return kernels;
+}
+
+}
@@ -0,0 +1,54 @@
+//
+//  ImageConversion.h
+//  libraries/image/src/image
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_image_ImageConversion_h
+#define hifi_image_ImageConversion_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "ColorChannel.h"
+
+namespace image {
+
+// Kernels converting rows of pixels between the formats textures go through while being processed. Every set of
+// kernels gives exactly the same pixels as the scalar one, the vectorized ones just get there faster.
+struct ConversionKernels {
+    const char* name;
+
+    // QRgb pixels to floats, as glm::vec4(qRed(), qGreen(), qBlue(), qAlpha()) / 255
+    void (*argb32ToFloat)(const uint32_t* source, glm::vec4* output, size_t count);
+
+    // floats to QRgb pixels, as qRgba() of glm::clamp(color * 255, 0, 255) truncated
+    void (*floatToARGB32)(const glm::vec4* source, uint32_t* output, size_t count);
+
+    // floats to R11G11B10F, dropping alpha, as the HDR packing function: values below the smallest normal become 0 and
+    // those above 65000 are clamped to it
+    void (*floatToR11G11B10F)(const glm::vec4* source, uint32_t* output, size_t count);
+
+    // moves one channel of QRgb pixels to red, with green and blue 0 and alpha opaque
+    void (*channelToRed)(uint32_t* pixels, size_t count, ColorChannel channel);
+};
+
+const ConversionKernels& getScalarConversionKernels();
+
+// the fastest kernels the CPU supports, picked the first time it's called
+const ConversionKernels& getConversionKernels();
+
+// every set of kernels the CPU supports, the scalar ones first, for testing them against each other
+std::vector<const ConversionKernels*> getSupportedConversionKernels();
+
+}
+
+#endif // hifi_image_ImageConversion_h
@@ -11,6 +11,10 @@
 
 #include "TextureProcessing.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -23,6 +27,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -30,6 +35,7 @@
 #endif
 #include "ImageLogging.h"
 #include "CubeMap.h"
+#include "ImageConversion.h"
 
 using namespace gpu;
 
@@ -73,6 +79,56 @@ glm::uvec2 rectifySize(const glm::uvec2& size) {
     return { rectifyDimension(size.x), rectifyDimension(size.y) };
 }
 
+static std::atomic<CompressionQuality> compressionQuality { CompressionQuality::Production };
+static std::atomic<bool> gpuCompressionEnabled { true };
+
+void setCompressionQuality(CompressionQuality quality) {
+    compressionQuality = quality;
+}
+
+CompressionQuality getCompressionQuality() {
+    return compressionQuality;
+}
+
+void setGPUCompressionEnabled(bool enabled) {
+    gpuCompressionEnabled = enabled;
+}
+
+bool isGPUCompressionEnabled() {
+    return gpuCompressionEnabled;
+}
+
+#if defined(NVTT_API)
+static nvtt::Quality getNVTTQuality() {
+    switch (getCompressionQuality()) {
+        case CompressionQuality::Fastest:
+            return nvtt::Quality_Fastest;
+        case CompressionQuality::Normal:
+            return nvtt::Quality_Normal;
+        case CompressionQuality::Highest:
+            return nvtt::Quality_Highest;
+        case CompressionQuality::Production:
+        default:
+            return nvtt::Quality_Production;
+    }
+}
+
+// the effort Etc2Comp puts into each block, from 0 to 100
+static float getETCEffort() {
+    switch (getCompressionQuality()) {
+        case CompressionQuality::Fastest:
+            return 0.0f;
+        case CompressionQuality::Normal:
+            return 0.5f;
+        case CompressionQuality::Highest:
+            return 40.0f;
+        case CompressionQuality::Production:
+        default:
+            return 1.0f;
+    }
+}
+#endif
+
 const QStringList getSupportedFormats() {
     auto formats = QImageReader::supportedImageFormats();
     QStringList stringFormats;
@@ -306,35 +362,10 @@ void mapToRedChannel(Image& image, ColorChannel sourceChannel) {
         image = image.getConvertedToFormat(Image::Format_ARGB32);
     }
 
+    // Dump the source channel in the red channel, ignore the rest
+    const auto& kernels = getConversionKernels();
     for (glm::uint32 i = 0; i < image.getHeight(); i++) {
-        QRgb* pixel = reinterpret_cast<QRgb*>(image.editScanLine(i));
-        // Past end pointer
-        QRgb* lineEnd = pixel + image.getWidth();
-
-        // Transfer channel data from source to target
-        for (; pixel < lineEnd; pixel++) {
-            int colorValue;
-            switch (sourceChannel) {
-            case ColorChannel::RED:
-                colorValue = qRed(*pixel);
-                break;
-            case ColorChannel::GREEN:
-                colorValue = qGreen(*pixel);
-                break;
-            case ColorChannel::BLUE:
-                colorValue = qBlue(*pixel);
-                break;
-            case ColorChannel::ALPHA:
-                colorValue = qAlpha(*pixel);
-                break;
-            default:
-                colorValue = qRed(*pixel);
-                break;
-            }
-
-            // Dump the color in the red channel, ignore the rest
-            *pixel = qRgba(colorValue, 0, 0, 255);
-        }
+        kernels.channelToRed(reinterpret_cast<uint32_t*>(image.editScanLine(i)), image.getWidth(), sourceChannel);
     }
 }
 
@@ -421,6 +452,18 @@ Image processSourceImage(Image&& srcImage, bool cubemap, BackendTarget target) {
 }
 
 #if defined(NVTT_API)
+// The storage of a texture isn't thread-safe, and the faces and mips of one are compressed on several threads at once
+static std::mutex mipAssignmentMutex;
+
+static void assignMip(gpu::Texture* texture, int face, int mipLevel, size_t size, const gpu::Byte* data) {
+    std::lock_guard<std::mutex> lock(mipAssignmentMutex);
+    if (face >= 0) {
+        texture->assignStoredMipFace(mipLevel, face, size, data);
+    } else {
+        texture->assignStoredMip(mipLevel, size, data);
+    }
+}
+
 struct OutputHandler : public nvtt::OutputHandler {
     OutputHandler(gpu::Texture* texture, int face) : _texture(texture), _face(face) {}
 
@@ -440,11 +483,7 @@ struct OutputHandler : public nvtt::OutputHandler {
     }
 
     virtual void endImage() override {
-        if (_face >= 0) {
-            _texture->assignStoredMipFace(_miplevel, _face, _size, static_cast<const gpu::Byte*>(_data));
-        } else {
-            _texture->assignStoredMip(_miplevel, _size, static_cast<const gpu::Byte*>(_data));
-        }
+        assignMip(_texture, _face, _miplevel, _size, static_cast<const gpu::Byte*>(_data));
         free(_data);
         _data = nullptr;
     }
@@ -501,23 +540,60 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// Spreads the tasks nvtt splits the compression of a mip into, a few blocks each, over TBB's threads
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
+
+// Compresses the surface and, when building mips, the mip chain below it. The chain is built first, which is only box
+// filtering, so that the levels can then be compressed at the same time, each with its own compressor and output
+// handler. Keeping the whole chain takes about a third more memory than the surface alone.
+template <typename Compressor>
+void compressMips(const nvtt::Surface& surface, int face, int baseMipLevel, bool buildMips,
+                  const nvtt::CompressionOptions& compressionOptions,
+                  const std::function<nvtt::OutputHandler*()>& createOutputHandler, const std::atomic<bool>& abortProcessing) {
+    std::vector<nvtt::Surface> mips { surface };
+    if (buildMips) {
+        while (mips.back().canMakeNextMipmap() && !abortProcessing.load()) {
+            nvtt::Surface nextMip = mips.back();
+            nextMip.buildNextMipmap(nvtt::MipmapFilter_Box);
+            mips.push_back(nextMip);
+        }
+    }
+
+    tbb::parallel_for(0, (int)mips.size(), [&](int level) {
+        if (abortProcessing.load()) {
+            return;
+        }
+
+        std::unique_ptr<nvtt::OutputHandler> outputHandler { createOutputHandler() };
+        nvtt::OutputOptions outputOptions;
+        outputOptions.setOutputHeader(false);
+        outputOptions.setOutputHandler(outputHandler.get());
+        MyErrorHandler errorHandler;
+        outputOptions.setErrorHandler(&errorHandler);
+
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        Compressor compressor;
+        compressor.setTaskDispatcher(&dispatcher);
+        compressor.enableCudaAcceleration(isGPUCompressionEnabled());
+
+        compressor.compress(mips[level], face, baseMipLevel + level, compressionOptions, outputOptions);
+        mips[level] = nvtt::Surface();
+    });
+}
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
@@ -545,6 +621,15 @@ void convertToPackedFromFloat(unsigned char* output, int width, int height, size
     const glm::vec4* sourceIt;
     auto packFunc = getHDRPackingFunction(outputFormat);
 
+    if (outputFormat == gpu::Element::COLOR_R11G11B10) {
+        const auto& kernels = getConversionKernels();
+        for (auto lineNb = 0; lineNb < height; lineNb++) {
+            kernels.floatToR11G11B10F(source + lineNb * srcLinePixelStride,
+                                      reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride), width);
+        }
+        return;
+    }
+
     srcLinePixelStride -= width;
     sourceIt = source;
     for (auto lineNb = 0; lineNb < height; lineNb++) {
@@ -564,7 +649,7 @@ nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture
     auto outputFormat = outputTexture->getStoredMipFormat();
     bool useNVTT = false;
 
-    compressionOptions.setQuality(nvtt::Quality_Production);
+    compressionOptions.setQuality(getNVTTQuality());
 
     if (outputFormat == gpu::Element::COLOR_COMPRESSED_BCX_HDR_RGB) {
         useNVTT = true;
@@ -604,35 +689,22 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     const int width = localCopy.getWidth();
     const int height = localCopy.getHeight();
 
-    nvtt::OutputOptions outputOptions;
-    outputOptions.setOutputHeader(false);
-
     nvtt::CompressionOptions compressionOptions;
-    std::unique_ptr<nvtt::OutputHandler> outputHandler{ getNVTTCompressionOutputHandler(texture, face, compressionOptions) };
-
-    MyErrorHandler errorHandler;
-    outputOptions.setErrorHandler(&errorHandler);
-    nvtt::Context context;
-    int mipLevel = baseMipLevel;
-
-    outputOptions.setOutputHandler(outputHandler.get());
+    if (!std::unique_ptr<nvtt::OutputHandler>(getNVTTCompressionOutputHandler(texture, face, compressionOptions))) {
+        return;
+    }
 
     nvtt::Surface surface;
     surface.setImage(nvtt::InputFormat_RGBA_32F, width, height, 1, localCopy.getBits());
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
+    localCopy = Image();
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
-    context.setTaskDispatcher(&dispatcher);
-
-    context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-    if (buildMips) {
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        }
-    }
+    // each mip gets its own handler, the packed float ones keep state between writes
+    compressMips<nvtt::Context>(surface, face, baseMipLevel, buildMips, compressionOptions, [&] {
+        nvtt::CompressionOptions mipCompressionOptions;
+        return getNVTTCompressionOutputHandler(texture, face, mipCompressionOptions);
+    }, abortProcessing);
 }
 
 void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarget target, int baseMipLevel, bool buildMips, const std::atomic<bool>& abortProcessing, int face) {
@@ -642,7 +714,6 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
     const int width = localCopy.getWidth(), height = localCopy.getHeight();
     auto mipFormat = texture->getStoredMipFormat();
-    int mipLevel = baseMipLevel;
 
     if (target != BackendTarget::GLES32) {
         if (localCopy.getFormat() != Image::Format_ARGB32) {
@@ -676,7 +747,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         inputOptions.setRoundMode(roundMode);
 
         nvtt::CompressionOptions compressionOptions;
-        compressionOptions.setQuality(nvtt::Quality_Production);
+        compressionOptions.setQuality(getNVTTQuality());
 
         if (mipFormat == gpu::Element::COLOR_COMPRESSED_BCX_SRGB) {
             compressionOptions.setFormat(nvtt::Format_BC1);
@@ -752,23 +823,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
             return;
         }
 
-        nvtt::OutputOptions outputOptions;
-        outputOptions.setOutputHeader(false);
-        OutputHandler outputHandler(texture, face);
-        outputOptions.setOutputHandler(&outputHandler);
-        MyErrorHandler errorHandler;
-        outputOptions.setErrorHandler(&errorHandler);
-
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
-
-        context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-        if (buildMips) {
-            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-                context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
-            }
-        }
+        compressMips<nvtt::Compressor>(surface, face, baseMipLevel, buildMips, compressionOptions, [&] {
+            return new OutputHandler(texture, face);
+        }, abortProcessing);
     } else {
         int numMips = 1;
     
@@ -806,8 +863,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         }
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
-        const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        const float effort = getETCEffort();
+        // etc2comp spreads the blocks of each mip over its own threads
+        const int numEncodeThreads = std::max(1, (int)std::thread::hardware_concurrency());
         int encodingTime;
 
         if (localCopy.getFormat() != Image::Format_RGBAF) {
@@ -824,11 +882,7 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
 
         for (int i = 0; i < numMips; i++) {
             if (mipMaps[i].paucEncodingBits.get()) {
-                if (face >= 0) {
-                    texture->assignStoredMipFace(i+baseMipLevel, face, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
-                } else {
-                    texture->assignStoredMip(i + baseMipLevel, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
-                }
+                assignMip(texture, face, i + baseMipLevel, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
             }
         }
 
@@ -1491,11 +1545,16 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
         output.applyGamma(1.0f/2.2f);
     }
 
-    for (int face = 0; face < 6; face++) {
-        for (gpu::uint16 mipLevel = 0; mipLevel < output.getMipCount(); mipLevel++) {
-            convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+    // every face and mip is compressed on its own
+    int mipCount = output.getMipCount();
+    tbb::parallel_for(0, 6 * mipCount, [&](int faceAndMip) {
+        if (abortProcessing.load()) {
+            return;
         }
-    }
+        int face = faceAndMip / mipCount;
+        gpu::uint16 mipLevel = (gpu::uint16)(faceAndMip % mipCount);
+        convertToTexture(texture, output.getFaceImage(mipLevel, face), target, abortProcessing, face, mipLevel);
+    });
 }
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
@@ -1600,11 +1659,13 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             // Performs and convolution AND mip map generation
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
         } else {
-            // Create mip maps and compress to final format in one go
-            for (uint8 face = 0; face < faces.size(); ++face) {
-                // Force building the mip maps right now on CPU if we are convolving for GGX later on
+            // Create mip maps and compress to final format in one go, the faces at the same time
+            tbb::parallel_for(0, (int)faces.size(), [&](int face) {
+                if (abortProcessing.load()) {
+                    return;
+                }
                 convertToTextureWithMips(theTexture.get(), std::move(faces[face]), target, abortProcessing, face);
-            }
+            });
         }
     }
 
@@ -122,6 +122,23 @@ gpu::TexturePointer processCubeTextureColorFromImage(Image&& srcImage, const std
 
 const QStringList getSupportedFormats();
 
+// How much time is spent finding the best encoding of each block when textures are compressed, and of their mips when
+// they are only converted. Faster settings trade some quality for taking less time to load unbaked textures.
+enum class CompressionQuality {
+    Fastest = 0,
+    Normal,
+    Production,
+    Highest
+};
+
+void setCompressionQuality(CompressionQuality quality);
+CompressionQuality getCompressionQuality();
+
+// Whether textures are compressed on the GPU, through nvtt's CUDA encoders, when nvtt was built with them and there is
+// a GPU that can run them. nvtt compresses on the CPU otherwise, and for the formats it has no GPU encoder for.
+void setGPUCompressionEnabled(bool enabled);
+bool isGPUCompressionEnabled();
+
 std::pair<gpu::TexturePointer, glm::ivec2> processImage(std::shared_ptr<QIODevice> content, const std::string& url, ColorChannel sourceChannel,
                                                         int maxNumPixels, TextureUsage::Type textureType,
                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
@@ -0,0 +1,46 @@
+//
+//  InputSampler.cpp
+//  input-plugins/src/input-plugins
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "InputSampler.h"
+
+#include <QtCore/QThread>
+
+#include <SharedUtil.h>
+
+#include "InputPlugin.h"
+
+InputSampler::InputSampler(const InputPluginList& plugins, controller::PoseLatch& latch) :
+    _plugins(plugins),
+    _latch(latch) {
+}
+
+bool InputSampler::process() {
+    quint64 start = usecTimestampNow();
+
+    controller::LatchedPoses poses;
+    bool sampled = false;
+    for (const auto& plugin : _plugins) {
+        if (plugin->isActive() && plugin->sampleLatchedPoses(poses)) {
+            sampled = true;
+        }
+    }
+    if (sampled) {
+        poses.timestamp = start;
+        _latch.publish(poses);
+    }
+
+    quint64 elapsed = usecTimestampNow() - start;
+    quint64 interval = _sampleInterval;
+    if (elapsed < interval) {
+        QThread::usleep(interval - elapsed);
+    }
+    return isStillRunning();
+}
@@ -0,0 +1,44 @@
+//
+//  InputSampler.h
+//  input-plugins/src/input-plugins
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_InputSampler_h
+#define hifi_InputSampler_h
+
+#include <algorithm>
+#include <atomic>
+
+#include <GenericThread.h>
+#include <NumericalConstants.h>
+#include <controllers/PoseLatch.h>
+#include <plugins/Forward.h>
+
+// Samples the poses of the tracked devices at device rate on a thread of its own, and publishes them to a PoseLatch.
+// The input plugins still update at frame rate on the main thread, where their inputs go through the mappings; the
+// sampled poses let the main loop correct the poses of the frame by where the devices moved since, so that hand
+// tracking doesn't lag behind by however long the main thread took to get to the avatar.
+class InputSampler : public GenericThread {
+    Q_OBJECT
+public:
+    static const int DEFAULT_SAMPLE_RATE { 500 }; // Hz, faster than the devices' own tracking updates
+
+    InputSampler(const InputPluginList& plugins, controller::PoseLatch& latch);
+
+    void setSampleRate(int rate) { _sampleInterval = USECS_PER_SECOND / std::max(rate, 1); }
+
+    bool process() override;
+
+private:
+    const InputPluginList _plugins;
+    controller::PoseLatch& _latch;
+    std::atomic<quint64> _sampleInterval { USECS_PER_SECOND / DEFAULT_SAMPLE_RATE };
+};
+
+#endif // hifi_InputSampler_h
@@ -47,6 +47,19 @@ bool TextureMeta::deserialize(const QByteArray& data, TextureMeta* meta) {
             }
         }
     }
+    if (root.contains("supercompressedUncompressed")) {
+        meta->supercompressedUncompressed = root["supercompressedUncompressed"].toString();
+    }
+    if (root.contains("supercompressed")) {
+        auto supercompressed = root["supercompressed"].toObject();
+        for (auto it = supercompressed.constBegin(); it != supercompressed.constEnd(); it++) {
+            khronos::gl::texture::InternalFormat format;
+            auto formatName = it.key().toLatin1();
+            if (khronos::gl::texture::fromString(formatName.constData(), &format)) {
+                meta->supercompressedTextureTypes[format] = it.value().toString();
+            }
+        }
+    }
     if (root.contains("version")) {
         meta->version = root["version"].toInt();
     }
@@ -63,9 +76,20 @@ QByteArray TextureMeta::serialize() {
         const char* name = khronos::gl::texture::toString(kv.first);
         compressed[name] = kv.second.toString();
     }
+    QJsonObject supercompressed;
+    for (auto kv : supercompressedTextureTypes) {
+        const char* name = khronos::gl::texture::toString(kv.first);
+        supercompressed[name] = kv.second.toString();
+    }
     root["original"] = original.toString();
     root["uncompressed"] = uncompressed.toString();
     root["compressed"] = compressed;
+    if (!supercompressedUncompressed.isEmpty()) {
+        root["supercompressedUncompressed"] = supercompressedUncompressed.toString();
+    }
+    if (!supercompressed.isEmpty()) {
+        root["supercompressed"] = supercompressed;
+    }
     root["version"] = KTX_VERSION;
     doc.setObject(root);
 
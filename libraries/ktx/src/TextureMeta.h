@@ -38,6 +38,9 @@ struct TextureMeta {
     QUrl original;
     QUrl uncompressed;
     std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> availableTextureTypes;
+    // the same textures as supercompressed KTXs (see ktx/Supercompression.h), which older clients can't read
+    QUrl supercompressedUncompressed;
+    std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> supercompressedTextureTypes;
     uint16_t version { 0 };
 };
 
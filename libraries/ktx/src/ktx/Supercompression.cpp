@@ -0,0 +1,146 @@
+//
+//  Supercompression.cpp
+//  libraries/ktx/src/ktx
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Supercompression.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QDebug>
+
+namespace ktx {
+    static KeyValues::const_iterator findKey(const KeyValues& keyValues, const std::string& key) {
+        return std::find_if(keyValues.begin(), keyValues.end(), [&](const KeyValue& keyValue) {
+            return keyValue._key == key;
+        });
+    }
+
+    bool isSupercompressed(const KeyValues& keyValues) {
+        auto found = findKey(keyValues, HIFI_SUPERCOMPRESSION_KEY);
+        return found != keyValues.end() &&
+            std::string(found->_value.begin(), found->_value.end()) == SUPERCOMPRESSION_ZLIB;
+    }
+
+    SupercompressedLevels getSupercompressedLevels(const KeyValues& keyValues) {
+        if (!isSupercompressed(keyValues)) {
+            return SupercompressedLevels();
+        }
+        auto found = findKey(keyValues, HIFI_SUPERCOMPRESSED_LEVELS_KEY);
+        if (found == keyValues.end() || found->_value.empty() || found->_value.size() % sizeof(SupercompressedLevel) != 0) {
+            qWarning() << "Supercompressed KTX has no valid level index";
+            return SupercompressedLevels();
+        }
+
+        // the value bytes needn't be aligned for the struct, so copy them out
+        SupercompressedLevels levels(found->_value.size() / sizeof(SupercompressedLevel));
+        memcpy(levels.data(), found->_value.data(), found->_value.size());
+
+        uint64_t expectedOffset = 0;
+        for (const auto& level : levels) {
+            if (level.byteOffset != expectedOffset || level.byteLength == 0 ||
+                level.byteLength > std::numeric_limits<uint32_t>::max() ||
+                level.uncompressedByteLength > std::numeric_limits<uint32_t>::max()) {
+                qWarning() << "Supercompressed KTX has a malformed level index";
+                return SupercompressedLevels();
+            }
+            expectedOffset += IMAGE_SIZE_WIDTH + evalPaddedSize(level.byteLength);
+        }
+        return levels;
+    }
+
+    KeyValues removeSupercompressionKeys(const KeyValues& keyValues) {
+        KeyValues result;
+        for (const auto& keyValue : keyValues) {
+            if (keyValue._key != HIFI_SUPERCOMPRESSION_KEY && keyValue._key != HIFI_SUPERCOMPRESSED_LEVELS_KEY) {
+                result.push_back(keyValue);
+            }
+        }
+        return result;
+    }
+
+    size_t evalSupercompressedStorageSize(const Header& header, const SupercompressedLevels& levels) {
+        size_t size = KTX_HEADER_SIZE + header.bytesOfKeyValueData;
+        if (!levels.empty()) {
+            size += levels.back().byteOffset + IMAGE_SIZE_WIDTH + evalPaddedSize(levels.back().byteLength);
+        }
+        return size;
+    }
+
+    QByteArray supercompress(const KTX& ktx, int compressionLevel) {
+        const auto& header = ktx.getHeader();
+        const Byte* texels = ktx.getTexelsData();
+        if (!texels || isSupercompressed(ktx._keyValues) || ktx._images.size() != header.getNumberOfLevels()) {
+            qWarning() << "Can only supercompress a plain KTX with all its mips";
+            return QByteArray();
+        }
+        size_t texelsSize = ktx.getTexelsDataSize();
+
+        SupercompressedLevels levels;
+        std::vector<QByteArray> levelsData;
+        uint64_t byteOffset = 0;
+        for (const auto& image : ktx._images) {
+            size_t start = image._imageOffset + IMAGE_SIZE_WIDTH;
+            if (start + image._imageSize > texelsSize) {
+                qWarning() << "KTX mip data runs past the end of its storage";
+                return QByteArray();
+            }
+            // the faces of a level are contiguous, so they are deflated together as the client fetches them
+            QByteArray levelData = qCompress(texels + start, (int)image._imageSize, compressionLevel);
+            if (levelData.isEmpty()) {
+                return QByteArray();
+            }
+
+            SupercompressedLevel level;
+            level.byteOffset = byteOffset;
+            level.byteLength = (uint64_t)levelData.size();
+            level.uncompressedByteLength = image._imageSize;
+            byteOffset += IMAGE_SIZE_WIDTH + evalPaddedSize(level.byteLength);
+            levels.push_back(level);
+            levelsData.push_back(levelData);
+        }
+
+        KeyValues keyValues = ktx._keyValues;
+        keyValues.emplace_back(HIFI_SUPERCOMPRESSION_KEY, SUPERCOMPRESSION_ZLIB);
+        keyValues.emplace_back(HIFI_SUPERCOMPRESSED_LEVELS_KEY, (uint32_t)(levels.size() * sizeof(SupercompressedLevel)),
+                               reinterpret_cast<const Byte*>(levels.data()));
+
+        Header supercompressedHeader = header;
+        supercompressedHeader.bytesOfKeyValueData = KeyValue::serializedKeyValuesByteSize(keyValues);
+
+        QByteArray result((int)evalSupercompressedStorageSize(supercompressedHeader, levels), 0);
+        Byte* dest = reinterpret_cast<Byte*>(result.data());
+        memcpy(dest, &supercompressedHeader, sizeof(Header));
+        KTX::writeKeyValues(dest + KTX_HEADER_SIZE, supercompressedHeader.bytesOfKeyValueData, keyValues);
+
+        Byte* destTexels = dest + KTX_HEADER_SIZE + supercompressedHeader.bytesOfKeyValueData;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            // unlike a plain KTX the imageSize is that of the whole deflated level, not of one face
+            uint32_t imageSize = (uint32_t)levels[i].byteLength;
+            memcpy(destTexels + levels[i].byteOffset, &imageSize, IMAGE_SIZE_WIDTH);
+            memcpy(destTexels + levels[i].byteOffset + IMAGE_SIZE_WIDTH, levelsData[i].constData(), imageSize);
+        }
+        return result;
+    }
+
+    QByteArray decompressLevel(const Byte* data, size_t size, const SupercompressedLevel& level) {
+        if (size != level.byteLength) {
+            qWarning() << "Supercompressed KTX level is" << size << "bytes, expected" << level.byteLength;
+            return QByteArray();
+        }
+        QByteArray result = qUncompress(data, (int)size);
+        if ((uint64_t)result.size() != level.uncompressedByteLength) {
+            qWarning() << "Supercompressed KTX level inflated to" << result.size() << "bytes, expected"
+                       << level.uncompressedByteLength;
+            return QByteArray();
+        }
+        return result;
+    }
+}
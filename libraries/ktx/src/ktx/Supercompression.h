@@ -0,0 +1,67 @@
+//
+//  Supercompression.h
+//  libraries/ktx/src/ktx
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ktx_Supercompression_h
+#define hifi_ktx_Supercompression_h
+
+#include <QtCore/QByteArray>
+
+#include "KTX.h"
+
+/*
+
+A supercompressed KTX keeps the header and key values of the KTX it's made from, so the header describes the texture
+as the GPU gets it, but each mip level's image data (all its faces) is deflated on its own, and its imageSize is the
+size of that deflated data. Much like the level index of KTX2, a key value lists where each level is in the file, so
+the levels can still be fetched one range request at a time, from the lowest resolution up:
+
+    hifi.supercompression        "zlib"
+    hifi.supercompressedLevels   SupercompressedLevel[numberOfMipmapLevels]
+
+Readers that don't know about these keys see a KTX whose image sizes don't match its header, and fail to load it, so
+the baker writes supercompressed KTXs next to the plain ones rather than in their place.
+
+*/
+
+namespace ktx {
+    const std::string HIFI_SUPERCOMPRESSION_KEY { "hifi.supercompression" };
+    const std::string HIFI_SUPERCOMPRESSED_LEVELS_KEY { "hifi.supercompressedLevels" };
+    const std::string SUPERCOMPRESSION_ZLIB { "zlib" };
+
+    struct SupercompressedLevel {
+        // from the start of the image region to the level's imageSize, as ImageHeader::_imageOffset
+        uint64_t byteOffset { 0 };
+        // the deflated data following the imageSize, without padding
+        uint64_t byteLength { 0 };
+        uint64_t uncompressedByteLength { 0 };
+    };
+    using SupercompressedLevels = std::vector<SupercompressedLevel>;
+
+    bool isSupercompressed(const KeyValues& keyValues);
+
+    // the level index of a supercompressed KTX, empty if it isn't one or the index is malformed
+    SupercompressedLevels getSupercompressedLevels(const KeyValues& keyValues);
+
+    // the key values without the supercompression ones, for the KTX once its levels are inflated
+    KeyValues removeSupercompressionKeys(const KeyValues& keyValues);
+
+    // the size of the whole supercompressed KTX described by the header's key value size and the level index
+    size_t evalSupercompressedStorageSize(const Header& header, const SupercompressedLevels& levels);
+
+    // the supercompressed version of a KTX holding all its mips, a null array if it can't be made
+    QByteArray supercompress(const KTX& ktx, int compressionLevel = -1);
+
+    // inflates a level's data, a null array if it's corrupt or doesn't inflate to the expected size
+    QByteArray decompressLevel(const Byte* data, size_t size, const SupercompressedLevel& level);
+}
+
+#endif // hifi_ktx_Supercompression_h
@@ -107,6 +107,10 @@ TextureCache::TextureCache() {
 #endif
     setUnusedResourceCacheSize(0);
     setObjectName("TextureCache");
+
+    static const int MIP_DEMAND_CHECK_INTERVAL_MSECS = 500;
+    connect(&_mipDemandTimer, &QTimer::timeout, this, &TextureCache::checkMipDemand);
+    _mipDemandTimer.start(MIP_DEMAND_CHECK_INTERVAL_MSECS);
 }
 
 TextureCache::~TextureCache() {
@@ -699,15 +703,74 @@ void NetworkTexture::startRequestForNextMipLevel() {
     }
 
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
-    if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
-        _ktxResourceState = PENDING_MIP_REQUEST;
+    if (_lowestRequestedMipLevel >= _lowestKnownPopulatedMip) {
+        return;
+    }
+    // only fetch the mips the renderer has wanted lately, the rest wait until it's seen closer
+    if (std::max(_lowestRequestedMipLevel, texture->getDesiredMip()) >= _lowestKnownPopulatedMip) {
+        auto textureCache = DependencyManager::get<TextureCache>();
+        if (textureCache) {
+            textureCache->waitForMipDemand(_self, texture, _lowestKnownPopulatedMip);
+        }
+        return;
+    }
+
+    _ktxResourceState = PENDING_MIP_REQUEST;
+
+    init(false);
+    float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
+    setLoadPriority(this, priority);
+    _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
+    TextureCache::attemptRequest(self);
+}
+
+void TextureCache::waitForMipDemand(const QWeakPointer<Resource>& resource, const gpu::TexturePointer& texture,
+                                    uint16_t populatedMip) {
+    std::lock_guard<std::mutex> lock(_mipDemandWaitersMutex);
+    _mipDemandWaiters.push_back({ resource, texture, populatedMip });
+}
+
+void TextureCache::checkMipDemand() {
+    std::vector<QSharedPointer<Resource>> wanted;
+    {
+        std::lock_guard<std::mutex> lock(_mipDemandWaitersMutex);
+        auto end = std::remove_if(_mipDemandWaiters.begin(), _mipDemandWaiters.end(), [&](const MipDemandWaiter& waiter) {
+            auto resource = waiter.resource.lock();
+            auto texture = waiter.texture.lock();
+            if (!resource || !texture) {
+                return true;
+            }
+            if (texture->getDesiredMip() < waiter.populatedMip) {
+                wanted.push_back(resource);
+                return true;
+            }
+            return false;
+        });
+        _mipDemandWaiters.erase(end, _mipDemandWaiters.end());
+    }
+
+    for (const auto& resource : wanted) {
+        QMetaObject::invokeMethod(resource.data(), "startRequestForNextMipLevel");
+    }
+}
 
-        init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
-        setLoadPriority(this, priority);
-        _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
-        TextureCache::attemptRequest(self);
+void NetworkTexture::preemptRequest() {
+    auto self = _self.lock();
+    if (!self || !canPreemptRequest()) {
+        return;
     }
+
+    PROFILE_ASYNC_END(resource, "Resource:" + getType(), QString::number(_requestID));
+
+    _ktxMipRequest->disconnect(this);
+    _ktxMipRequest->deleteLater();
+    _ktxMipRequest = nullptr;
+    _ktxMipLevelRangeInFlight = { NULL_MIP_LEVEL, NULL_MIP_LEVEL };
+
+    // the mip is asked for again once there's room for it, without stopping another request in turn
+    _ktxResourceState = PENDING_MIP_REQUEST;
+    TextureCache::requestCompleted(_self);
+    TextureCache::attemptRequest(self, false);
 }
 
 // Load mips in the range [low, high] (inclusive)
@@ -736,6 +799,15 @@ void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
         _ktxMipRequest->setByteRange(range);
 
         connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxInitialDataRequestFinished);
+    } else if (!_supercompressedLevels.empty()) {
+        // the levels are deflated to different sizes, so the ranges come from the level index
+        auto imagesStart = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData + ktx::IMAGE_SIZE_WIDTH;
+        ByteRange range;
+        range.fromInclusive = imagesStart + _supercompressedLevels[low].byteOffset;
+        range.toExclusive = imagesStart + _supercompressedLevels[high].byteOffset + _supercompressedLevels[high].byteLength;
+        _ktxMipRequest->setByteRange(range);
+
+        connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxMipRequestFinished);
     } else {
         ByteRange range;
         range.fromInclusive = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData
@@ -836,8 +908,10 @@ void NetworkTexture::ktxMipRequestFinished() {
             auto data = _ktxMipRequest->getData();
             auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
+            bool isSupercompressed = mipLevel < _supercompressedLevels.size();
+            auto supercompressedLevel = isSupercompressed ? _supercompressedLevels[mipLevel] : ktx::SupercompressedLevel();
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture, isSupercompressed, supercompressedLevel] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -857,7 +931,16 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                auto mipData = data;
+                if (isSupercompressed) {
+                    mipData = ktx::decompressLevel(reinterpret_cast<const ktx::Byte*>(data.data()), data.size(), supercompressedLevel);
+                    if (mipData.isNull()) {
+                        qCWarning(materialnetworking) << url << "has a corrupt supercompressed mip" << mipLevel;
+                        return;
+                    }
+                }
+
+                texture->assignStoredMip(mipLevel, mipData.size(), reinterpret_cast<const uint8_t*>(mipData.data()));
 
                 // If mip level assigned above is still unavailable, then we assume future requests will also fail.
                 auto minMipLevel = texture->minAvailableMipLevel();
@@ -956,6 +1039,8 @@ void NetworkTexture::handleFinishedInitialLoad() {
         QMetaObject::invokeMethod(resource.data(), "setOriginalDescriptor",
             Q_ARG(ktx::KTXDescriptor*, originalKtxDescriptor));
 
+        auto supercompressedLevels = ktx::getSupercompressedLevels(keyValues);
+
         // Create bare ktx in memory
         auto found = std::find_if(keyValues.begin(), keyValues.end(), [](const ktx::KeyValue& val) -> bool {
             return val._key.compare(gpu::SOURCE_HASH_KEY) == 0;
@@ -994,7 +1079,8 @@ void NetworkTexture::handleFinishedInitialLoad() {
         }
 
         if (!textureAndSize.first) {
-            auto memKtx = ktx::KTX::createBare(*header, keyValues);
+            // the cached ktx holds the inflated levels, so it's a plain one
+            auto memKtx = ktx::KTX::createBare(*header, ktx::removeSupercompressionKeys(keyValues));
             if (!memKtx) {
                 qWarning() << " Ktx could not be created, bailing";
                 QMetaObject::invokeMethod(resource.data(), "setImage",
@@ -1024,20 +1110,46 @@ void NetworkTexture::handleFinishedInitialLoad() {
             textureAndSize.first->setKtxBacking(file);
             textureAndSize.first->setSource(filename);
 
-            auto& images = originalKtxDescriptor->images;
-            size_t imageSizeRemaining = ktxHighMipData.size();
-            const uint8_t* ktxData = reinterpret_cast<const uint8_t*>(ktxHighMipData.data());
-            ktxData += ktxHighMipData.size();
-            // TODO Move image offset calculation to ktx ImageDescriptor
-            for (int level = static_cast<int>(images.size()) - 1; level >= 0; --level) {
-                auto& image = images[level];
-                if (image._imageSize > imageSizeRemaining) {
-                    break;
+            if (!supercompressedLevels.empty()) {
+                // the data is the tail of the file, so the levels wholly in it are found from the level index
+                size_t fileSize = ktx::evalSupercompressedStorageSize(*header, supercompressedLevels);
+                size_t imagesStart = ktx::KTX_HEADER_SIZE + header->bytesOfKeyValueData + ktx::IMAGE_SIZE_WIDTH;
+                size_t tailSize = ktxHighMipData.size();
+                if (tailSize <= fileSize) {
+                    size_t tailStart = fileSize - tailSize;
+                    const uint8_t* ktxData = reinterpret_cast<const uint8_t*>(ktxHighMipData.data());
+                    for (int level = static_cast<int>(supercompressedLevels.size()) - 1; level >= 0; --level) {
+                        auto& supercompressedLevel = supercompressedLevels[level];
+                        size_t levelStart = imagesStart + supercompressedLevel.byteOffset;
+                        if (levelStart < tailStart) {
+                            break;
+                        }
+                        auto mipData = ktx::decompressLevel(ktxData + (levelStart - tailStart), supercompressedLevel.byteLength,
+                                                            supercompressedLevel);
+                        if (mipData.isNull()) {
+                            qCWarning(materialnetworking) << url << "has a corrupt supercompressed mip" << level;
+                            break;
+                        }
+                        textureAndSize.first->assignStoredMip(static_cast<gpu::uint16>(level), mipData.size(),
+                                                              reinterpret_cast<const uint8_t*>(mipData.data()));
+                    }
+                }
+            } else {
+                auto& images = originalKtxDescriptor->images;
+                size_t imageSizeRemaining = ktxHighMipData.size();
+                const uint8_t* ktxData = reinterpret_cast<const uint8_t*>(ktxHighMipData.data());
+                ktxData += ktxHighMipData.size();
+                // TODO Move image offset calculation to ktx ImageDescriptor
+                for (int level = static_cast<int>(images.size()) - 1; level >= 0; --level) {
+                    auto& image = images[level];
+                    if (image._imageSize > imageSizeRemaining) {
+                        break;
+                    }
+                    ktxData -= image._imageSize;
+                    textureAndSize.first->assignStoredMip(static_cast<gpu::uint16>(level), image._imageSize, ktxData);
+                    ktxData -= ktx::IMAGE_SIZE_WIDTH;
+                    imageSizeRemaining -= (image._imageSize + ktx::IMAGE_SIZE_WIDTH);
                 }
-                ktxData -= image._imageSize;
-                textureAndSize.first->assignStoredMip(static_cast<gpu::uint16>(level), image._imageSize, ktxData);
-                ktxData -= ktx::IMAGE_SIZE_WIDTH;
-                imageSizeRemaining -= (image._imageSize + ktx::IMAGE_SIZE_WIDTH);
             }
 
             // We replace the texture with the one stored in the cache.  This deals with the possible race condition of two different
@@ -1079,33 +1191,43 @@ void NetworkTexture::loadMetaContent(const QByteArray& content) {
     }
 
     auto& backend = DependencyManager::get<TextureCache>()->getGPUContext()->getBackend();
-    for (auto pair : meta.availableTextureTypes) {
-        gpu::Element elFormat;
-
-        if (gpu::Texture::getCompressedFormat(pair.first, elFormat)) {
-            if (backend->supportedTextureFormat(elFormat)) {
-                auto url = pair.second;
-                if (url.fileName().endsWith(TEXTURE_META_EXTENSION)) {
-                    continue;
-                }
+    // the supercompressed KTXs are smaller to download, and inflate to the same texture as the plain ones, but local
+    // files are read whole as plain KTXs
+    bool useSupercompressed = !isLocalUrl(_activeUrl);
+    static const std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> NO_TEXTURE_TYPES;
+    const auto& supercompressedTextureTypes = useSupercompressed ? meta.supercompressedTextureTypes : NO_TEXTURE_TYPES;
+    const auto& availableTextureTypes = meta.availableTextureTypes;
+    for (auto textureTypes : { &supercompressedTextureTypes, &availableTextureTypes }) {
+        for (auto pair : *textureTypes) {
+            gpu::Element elFormat;
+
+            if (gpu::Texture::getCompressedFormat(pair.first, elFormat)) {
+                if (backend->supportedTextureFormat(elFormat)) {
+                    auto url = pair.second;
+                    if (url.fileName().endsWith(TEXTURE_META_EXTENSION)) {
+                        continue;
+                    }
 
-                _currentlyLoadingResourceType = ResourceType::KTX;
-                _activeUrl = _activeUrl.resolved(url);
-                auto textureCache = DependencyManager::get<TextureCache>();
-                auto self = _self.lock();
-                if (!self) {
+                    _currentlyLoadingResourceType = ResourceType::KTX;
+                    _activeUrl = _activeUrl.resolved(url);
+                    auto textureCache = DependencyManager::get<TextureCache>();
+                    auto self = _self.lock();
+                    if (!self) {
+                        return;
+                    }
+                    QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
                     return;
                 }
-                QMetaObject::invokeMethod(this, "attemptRequest", Qt::QueuedConnection);
-                return;
             }
         }
     }
 
 #ifndef Q_OS_ANDROID
-    if (!meta.uncompressed.isEmpty()) {
+    auto uncompressed = useSupercompressed && !meta.supercompressedUncompressed.isEmpty() ? meta.supercompressedUncompressed
+                                                                                         : meta.uncompressed;
+    if (!uncompressed.isEmpty()) {
         _currentlyLoadingResourceType = ResourceType::KTX;
-        _activeUrl = _activeUrl.resolved(meta.uncompressed);
+        _activeUrl = _activeUrl.resolved(uncompressed);
 
         auto textureCache = DependencyManager::get<TextureCache>();
         auto self = _self.lock();
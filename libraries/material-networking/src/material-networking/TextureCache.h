@@ -19,6 +19,7 @@
 #include <QColor>
 #include <QMetaEnum>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
@@ -26,6 +27,7 @@
 #include <image/ColorChannel.h>
 #include <image/TextureProcessing.h>
 #include <ktx/KTX.h>
+#include <ktx/Supercompression.h>
 #include <TextureMeta.h>
 
 #include <gpu/Context.h>
@@ -69,10 +71,15 @@ public:
 
     void refresh() override;
 
-    Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor) { _originalKtxDescriptor.reset(descriptor); }
+    Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor) {
+        _originalKtxDescriptor.reset(descriptor);
+        _supercompressedLevels = ktx::getSupercompressedLevels(descriptor->keyValues);
+    }
 
     void setExtra(void* extra) override;
 
+    bool canPreemptRequest() const override { return _ktxResourceState == REQUESTING_MIP && _ktxMipRequest; }
+
 signals:
     void networkTextureCreated(const QWeakPointer<NetworkTexture>& self);
 
@@ -80,6 +87,9 @@ public slots:
     void ktxInitialDataRequestFinished();
     void ktxMipRequestFinished();
 
+protected slots:
+    void preemptRequest() override;
+
 protected:
     void makeRequest() override;
     void makeLocalRequest();
@@ -143,6 +153,8 @@ private:
     // in its key/value data, and so will not match up with the original, causing
     // mip offsets to change.
     ktx::KTXDescriptorPointer _originalKtxDescriptor;
+    // the level index of the source url when it's a supercompressed KTX, whose levels are inflated as they arrive
+    ktx::SupercompressedLevels _supercompressedLevels;
 
     int _width { 0 };
     int _height { 0 };
@@ -217,6 +229,9 @@ protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
 
+private slots:
+    void checkMipDemand();
+
 private:
     friend class ImageReader;
     friend class NetworkTexture;
@@ -237,6 +252,18 @@ private:
     std::unordered_map<std::string, std::pair<std::weak_ptr<gpu::Texture>, glm::ivec2>> _texturesByHashes;
     std::mutex _texturesByHashesMutex;
 
+    // Streamed textures with more mips to fetch that aren't wanted for now, they go on fetching once the renderer
+    // wants finer mips than they have
+    struct MipDemandWaiter {
+        QWeakPointer<Resource> resource;
+        std::weak_ptr<gpu::Texture> texture;
+        uint16_t populatedMip;
+    };
+    void waitForMipDemand(const QWeakPointer<Resource>& resource, const gpu::TexturePointer& texture, uint16_t populatedMip);
+    std::vector<MipDemandWaiter> _mipDemandWaiters;
+    std::mutex _mipDemandWaitersMutex;
+    QTimer _mipDemandTimer;
+
     gpu::TexturePointer _permutationNormalTexture;
     gpu::TexturePointer _whiteTexture;
     gpu::TexturePointer _grayTexture;
@@ -13,6 +13,8 @@
 
 #include "BakerTypes.h"
 #include "ModelMath.h"
+#include "OptimizeMeshesTask.h"
+#include "BuildMeshLODsTask.h"
 #include "BuildGraphicsMeshTask.h"
 #include "CalculateMeshNormalsTask.h"
 #include "CalculateMeshTangentsTask.h"
@@ -20,6 +22,7 @@
 #include "CalculateBlendshapeTangentsTask.h"
 #include "PrepareJointsTask.h"
 #include "BuildDracoMeshTask.h"
+#include "BuildCollisionShapesTask.h"
 #include "ParseFlowDataTask.h"
 
 namespace baker {
@@ -127,7 +130,7 @@ namespace baker {
     class BakerEngineBuilder {
     public:
         using Input = VaryingSet3<hfm::Model::Pointer, hifi::VariantHash, hifi::URL>;
-        using Output = VaryingSet5<hfm::Model::Pointer, MaterialMapping, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
+        using Output = VaryingSet6<hfm::Model::Pointer, MaterialMapping, std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>, hfm::CollisionShapes>;
         using JobModel = Task::ModelIO<BakerEngineBuilder, Input, Output>;
         void build(JobModel& model, const Varying& input, Varying& output) {
             const auto& hfmModelIn = input.getN<Input>(0);
@@ -136,12 +139,19 @@ namespace baker {
 
             // Split up the inputs from hfm::Model
             const auto modelPartsIn = model.addJob<GetModelPartsTask>("GetModelParts", hfmModelIn);
-            const auto meshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
+            const auto modelMeshesIn = modelPartsIn.getN<GetModelPartsTask::Output>(0);
             const auto url = modelPartsIn.getN<GetModelPartsTask::Output>(1);
             const auto meshIndicesToModelNames = modelPartsIn.getN<GetModelPartsTask::Output>(2);
-            const auto blendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
+            const auto modelBlendshapesPerMeshIn = modelPartsIn.getN<GetModelPartsTask::Output>(3);
             const auto jointsIn = modelPartsIn.getN<GetModelPartsTask::Output>(4);
 
+            // Reorder the mesh triangles and vertices for the GPU, before anything else is derived from them
+            const auto optimizeMeshesInputs = OptimizeMeshesTask::Input(modelMeshesIn, modelBlendshapesPerMeshIn).asVarying();
+            const auto optimizedMeshesOut = model.addJob<OptimizeMeshesTask>("OptimizeMeshes", optimizeMeshesInputs);
+            const auto optimizedMeshes = optimizedMeshesOut.getN<OptimizeMeshesTask::Output>(0);
+            const auto blendshapesPerMeshIn = optimizedMeshesOut.getN<OptimizeMeshesTask::Output>(1);
+            const auto meshesIn = model.addJob<BuildMeshLODsTask>("BuildMeshLODs", optimizedMeshes);
+
             // Calculate normals and tangents for meshes and blendshapes if they do not exist
             // Note: Normals are never calculated here for OBJ models. OBJ files optionally define normals on a per-face basis, so for consistency normals are calculated beforehand in OBJSerializer.
             const auto normalsPerMesh = model.addJob<CalculateMeshNormalsTask>("CalculateMeshNormals", meshesIn);
@@ -178,6 +188,10 @@ namespace baker {
             const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
             const auto materialList = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(2);
 
+            // Build the collision shapes for the clients not to have to
+            // NOTE: This task is disabled by default and must be enabled through configuration
+            const auto collisionShapes = model.addJob<BuildCollisionShapesTask>("BuildCollisionShapes", meshesIn);
+
             // Parse flow data
             const auto flowData = model.addJob<ParseFlowDataTask>("ParseFlowData", mapping);
 
@@ -189,7 +203,7 @@ namespace baker {
             const auto buildModelInputs = BuildModelTask::Input(hfmModelIn, meshesOut, jointsOut, jointRotationOffsets, jointIndices, flowData).asVarying();
             const auto hfmModelOut = model.addJob<BuildModelTask>("BuildModel", buildModelInputs);
 
-            output = Output(hfmModelOut, materialMapping, dracoMeshes, dracoErrors, materialList);
+            output = Output(hfmModelOut, materialMapping, dracoMeshes, dracoErrors, materialList, collisionShapes);
         }
     };
 
@@ -227,4 +241,8 @@ namespace baker {
     std::vector<std::vector<hifi::ByteArray>> Baker::getDracoMaterialLists() const {
         return _engine->getOutput().get<BakerEngineBuilder::Output>().get4();
     }
+
+    const hfm::CollisionShapes& Baker::getCollisionShapes() const {
+        return _engine->getOutput().get<BakerEngineBuilder::Output>().get5();
+    }
 };
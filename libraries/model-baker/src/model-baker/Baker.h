@@ -36,6 +36,8 @@ namespace baker {
         std::vector<bool> getDracoErrors() const;
         // This is a ByteArray and not a std::string because the character sequence can contain the null character (particularly for FBX materials)
         std::vector<std::vector<hifi::ByteArray>> getDracoMaterialLists() const;
+        // Empty unless BuildCollisionShapes was enabled
+        const hfm::CollisionShapes& getCollisionShapes() const;
 
     protected:
         EnginePointer _engine;
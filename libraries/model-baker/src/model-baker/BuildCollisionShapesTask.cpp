@@ -0,0 +1,132 @@
+//
+//  BuildCollisionShapesTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BuildCollisionShapesTask.h"
+
+#include <algorithm>
+
+#include <LinearMath/btConvexHullComputer.h>
+
+#include <BakedBVH.h>
+
+#include "ModelBakerLogging.h"
+
+// the points of the convex hull around the vertices a part's faces use, or none if it has no faces
+static QVector<glm::vec3> buildPartHull(const hfm::Mesh& mesh, const hfm::MeshPart& part) {
+    // the same faces the clients build compound shapes from
+    std::vector<bool> isUsed(mesh.vertices.size(), false);
+    QVector<glm::vec3> points;
+    for (const auto* indices : { &part.triangleIndices, &part.quadIndices }) {
+        for (int index : *indices) {
+            if (index >= 0 && index < mesh.vertices.size() && !isUsed[index]) {
+                isUsed[index] = true;
+                points.push_back(mesh.vertices[index]);
+            }
+        }
+    }
+    if (points.isEmpty()) {
+        return points;
+    }
+
+    // the points inside the hull make no difference to it
+    btConvexHullComputer hullComputer;
+    hullComputer.compute(&points[0].x, sizeof(glm::vec3), points.size(), 0.0f, 0.0f);
+    if (hullComputer.vertices.size() == 0) {
+        return points;
+    }
+    QVector<glm::vec3> hull;
+    hull.reserve(hullComputer.vertices.size());
+    for (int i = 0; i < hullComputer.vertices.size(); ++i) {
+        const btVector3& vertex = hullComputer.vertices[i];
+        hull.push_back(glm::vec3(vertex.getX(), vertex.getY(), vertex.getZ()));
+    }
+    return hull;
+}
+
+void BuildCollisionShapesTask::configure(const Config& config) {
+    _maxStaticMeshVertices = config.maxStaticMeshVertices;
+}
+
+void BuildCollisionShapesTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    output = hfm::CollisionShapes();
+
+    std::vector<QVector<QVector<glm::vec3>>> hullsPerMesh(meshes.size());
+    baker::runPerMesh(context, meshes.size(), [&](size_t i) {
+        const hfm::Mesh& mesh = meshes[i];
+        for (const hfm::MeshPart& part : mesh.parts) {
+            QVector<glm::vec3> hull = buildPartHull(mesh, part);
+            if (!hull.isEmpty()) {
+                hullsPerMesh[i].push_back(hull);
+            }
+        }
+    });
+    for (const auto& hulls : hullsPerMesh) {
+        output.hulls += hulls;
+    }
+
+    // The triangles of all of the meshes, where the model puts them, in a single static mesh
+    int vertexCount = 0;
+    for (const hfm::Mesh& mesh : meshes) {
+        vertexCount += mesh.vertices.size();
+    }
+    if (vertexCount > _maxStaticMeshVertices) {
+        qCDebug(model_baker) << "BuildCollisionShapesTask: Skipped the static mesh of" << vertexCount << "vertices";
+        return;
+    }
+    // only the vertices the triangles use, as the clients index them with 16 bits when there are few triangles
+    auto& vertices = output.vertices;
+    auto& triangleIndices = output.triangleIndices;
+    for (const hfm::Mesh& mesh : meshes) {
+        int meshVertexCount = mesh.vertices.size();
+        std::vector<int32_t> vertexIndices(meshVertexCount, -1);
+        for (const hfm::MeshPart& part : mesh.parts) {
+            for (const auto* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+                int indexCount = indices->size() - indices->size() % 3;
+                for (int i = 0; i < indexCount; i += 3) {
+                    const int* triangle = indices->constData() + i;
+                    if (std::any_of(triangle, triangle + 3, [&](int index) { return index < 0 || index >= meshVertexCount; })) {
+                        continue;
+                    }
+                    for (int j = 0; j < 3; ++j) {
+                        int32_t& vertexIndex = vertexIndices[triangle[j]];
+                        if (vertexIndex == -1) {
+                            vertexIndex = vertices.size();
+                            vertices.push_back(glm::vec3(mesh.modelTransform * glm::vec4(mesh.vertices[triangle[j]], 1.0f)));
+                        }
+                        triangleIndices.push_back(vertexIndex);
+                    }
+                }
+            }
+        }
+    }
+    if (triangleIndices.isEmpty()) {
+        vertices.clear();
+        return;
+    }
+
+    // Build the bounding volume hierarchy the clients would, then serialize it
+    btIndexedMesh indexedMesh;
+    indexedMesh.m_numTriangles = triangleIndices.size() / 3;
+    indexedMesh.m_triangleIndexBase = reinterpret_cast<const unsigned char*>(triangleIndices.constData());
+    indexedMesh.m_triangleIndexStride = 3 * sizeof(int32_t);
+    indexedMesh.m_numVertices = vertices.size();
+    indexedMesh.m_vertexBase = reinterpret_cast<const unsigned char*>(vertices.constData());
+    indexedMesh.m_vertexStride = sizeof(glm::vec3);
+    indexedMesh.m_indexType = PHY_INTEGER;
+    indexedMesh.m_vertexType = PHY_FLOAT;
+    btTriangleIndexVertexArray meshInterface;
+    meshInterface.addIndexedMesh(indexedMesh, PHY_INTEGER);
+
+    const bool USE_QUANTIZED_AABB_COMPRESSION = true;
+    btBvhTriangleMeshShape shape(&meshInterface, USE_QUANTIZED_AABB_COMPRESSION);
+    output.bvh = BakedBVH::serialize(*shape.getOptimizedBvh());
+}
@@ -0,0 +1,49 @@
+//
+//  BuildCollisionShapesTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BuildCollisionShapesTask_h
+#define hifi_BuildCollisionShapesTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+#include "MeshJobs.h"
+
+// BuildCollisionShapesTask is disabled by default. ModelBaker enables it so baked models come with the collision shapes
+// the clients would otherwise build from their meshes when they first collide.
+class BuildCollisionShapesConfig : public baker::MeshJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(int maxStaticMeshVertices MEMBER maxStaticMeshVertices)
+public:
+    BuildCollisionShapesConfig() : baker::MeshJobConfig(false) {}
+
+    // bigger models collide as boxes rather than static meshes, so there is no point in baking them one
+    int maxStaticMeshVertices { 1000000 };
+};
+
+// Builds the convex hull of each mesh part, for the model to be used as a compound collision shape, and the bounding
+// volume hierarchy over all of its triangles, for it to collide as a static mesh
+class BuildCollisionShapesTask {
+public:
+    using Config = BuildCollisionShapesConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = hfm::CollisionShapes;
+    using JobModel = baker::Job::ModelIO<BuildCollisionShapesTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    int _maxStaticMeshVertices { 1000000 };
+};
+
+#endif // hifi_BuildCollisionShapesTask_h
@@ -51,7 +51,59 @@ std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     return materialList;
 }
 
-std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList) {
+// The levels of detail index the vertices of the hfm::Mesh, which the draco mesh merges into points where all their
+// attributes, the material included, are the same.  So they are mapped to the points through the faces of each material.
+// Returns false if a level uses a vertex the full detail faces don't, which can't be mapped.
+bool addLODMetadata(draco::Mesh& dracoMesh, const hfm::Mesh& mesh, const std::vector<hifi::ByteArray>& materialList) {
+    std::unique_ptr<draco::GeometryMetadata> metadata(new draco::GeometryMetadata());
+    metadata->AddEntryInt(DRACO_METADATA_LOD_COUNT, mesh.lodErrors.size());
+    for (int lod = 0; lod < mesh.lodErrors.size(); lod++) {
+        metadata->AddEntryDouble(QString(DRACO_METADATA_LOD_ERROR).arg(lod).toStdString(), mesh.lodErrors[lod]);
+    }
+
+    std::vector<int32_t> pointIndices(mesh.vertices.size());
+    for (size_t materialID = 0; materialID < materialList.size(); materialID++) {
+        // the faces were added in this order by createDracoMesh
+        std::fill(pointIndices.begin(), pointIndices.end(), -1);
+        std::vector<const hfm::MeshPart*> materialParts;
+        uint32_t face = 0;
+        for (const auto& part : mesh.parts) {
+            bool isMaterialPart = QVariant(part.materialID).toByteArray() == materialList[materialID];
+            if (isMaterialPart) {
+                materialParts.push_back(&part);
+            }
+            for (const auto* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+                for (int i = 0; (i + 2) < indices->size(); i += 3) {
+                    if (isMaterialPart) {
+                        const auto& dracoFace = dracoMesh.face(draco::FaceIndex(face));
+                        for (int k = 0; k < 3; k++) {
+                            pointIndices[(*indices)[i + k]] = dracoFace[k].value();
+                        }
+                    }
+                    face++;
+                }
+            }
+        }
+
+        for (int lod = 0; lod < mesh.lodErrors.size(); lod++) {
+            std::vector<int32_t> lodPointIndices;
+            for (const auto* part : materialParts) {
+                for (int index : part->lodTriangleIndices.value(lod)) {
+                    if (index < 0 || index >= (int)pointIndices.size() || pointIndices[index] < 0) {
+                        return false;
+                    }
+                    lodPointIndices.push_back(pointIndices[index]);
+                }
+            }
+            metadata->AddEntryIntArray(QString(DRACO_METADATA_LOD_INDICES).arg(lod).arg(materialID).toStdString(), lodPointIndices);
+        }
+    }
+
+    dracoMesh.AddMetadata(std::move(metadata));
+    return true;
+}
+
+std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList, bool includeLODs) {
     Q_ASSERT(normals.size() == 0 || (int)normals.size() == mesh.vertices.size());
     Q_ASSERT(mesh.colors.size() == 0 || mesh.colors.size() == mesh.vertices.size());
     Q_ASSERT(mesh.texCoords.size() == 0 || mesh.texCoords.size() == mesh.vertices.size());
@@ -200,6 +252,10 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     if (needsOriginalIndices) {
         dracoMesh->attribute(originalIndexAttributeID)->set_unique_id(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
     }
+
+    if (includeLODs && !mesh.lodErrors.isEmpty() && !addLODMetadata(*dracoMesh, mesh, materialList)) {
+        qCWarning(model_baker) << "Failed to map the levels of detail of a mesh to its draco points. The mesh will have none.";
+    }
     
     return std::make_tuple(std::move(dracoMesh), false);
 }
@@ -208,6 +264,10 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
 void BuildDracoMeshTask::configure(const Config& config) {
     _encodeSpeed = config.encodeSpeed;
     _decodeSpeed = config.decodeSpeed;
+    _preserveOrder = config.preserveOrder;
+    _positionQuantizationBits = config.positionQuantizationBits;
+    _texCoordQuantizationBits = config.texCoordQuantizationBits;
+    _normalQuantizationBits = config.normalQuantizationBits;
 }
 
 void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -221,38 +281,42 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
+    dracoBytesPerMesh.resize(meshes.size());
     // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
+    // So a bool reference to an element doesn't work, nor does writing different elements from different threads
+    std::vector<char> dracoErrors(meshes.size(), false);
+    materialLists.resize(meshes.size());
+    baker::runPerMesh(context, meshes.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& normals = baker::safeGet(normalsPerMesh, i);
         const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
+        auto& dracoBytes = dracoBytesPerMesh[i];
+        materialLists[i] = createMaterialList(mesh);
+        const auto& materialList = materialLists[i];
 
         bool dracoError;
         std::unique_ptr<draco::Mesh> dracoMesh;
-        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
+        // only sequential encoding keeps the points the levels of detail index
+        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList, _preserveOrder);
+        dracoErrors[i] = dracoError;
 
         if (dracoMesh) {
             draco::Encoder encoder;
 
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, _positionQuantizationBits);
+            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, _texCoordQuantizationBits);
+            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, _normalQuantizationBits);
             encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
+            if (_preserveOrder) {
+                encoder.SetEncodingMethod(draco::MESH_SEQUENTIAL_ENCODING);
+            }
 
             draco::EncoderBuffer buffer;
             encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
 
             dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
         }
-    }
+    });
+    dracoErrorsPerMesh.assign(dracoErrors.begin(), dracoErrors.end());
 #endif // not Q_OS_ANDROID
 }
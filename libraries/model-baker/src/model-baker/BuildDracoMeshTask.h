@@ -17,17 +17,28 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 // BuildDracoMeshTask is disabled by default
-class BuildDracoMeshConfig : public baker::JobConfig {
+class BuildDracoMeshConfig : public baker::MeshJobConfig {
     Q_OBJECT
     Q_PROPERTY(int encodeSpeed MEMBER encodeSpeed)
     Q_PROPERTY(int decodeSpeed MEMBER decodeSpeed)
+    Q_PROPERTY(bool preserveOrder MEMBER preserveOrder)
+    Q_PROPERTY(int positionQuantizationBits MEMBER positionQuantizationBits)
+    Q_PROPERTY(int texCoordQuantizationBits MEMBER texCoordQuantizationBits)
+    Q_PROPERTY(int normalQuantizationBits MEMBER normalQuantizationBits)
 public:
-    BuildDracoMeshConfig() : baker::JobConfig(false) {}
+    BuildDracoMeshConfig() : baker::MeshJobConfig(false) {}
 
     int encodeSpeed { 0 };
     int decodeSpeed { 5 };
+    // encode the triangles and vertices sequentially, in the order OptimizeMeshes left them, rather than in the order
+    // edgebreaker compresses best. The levels of detail index the points, so they are only kept with this.
+    bool preserveOrder { false };
+    int positionQuantizationBits { 14 };
+    int texCoordQuantizationBits { 12 };
+    int normalQuantizationBits { 10 };
 };
 
 class BuildDracoMeshTask {
@@ -43,6 +54,10 @@ public:
 protected:
     int _encodeSpeed { 0 };
     int _decodeSpeed { 5 };
+    bool _preserveOrder { false };
+    int _positionQuantizationBits { 14 };
+    int _texCoordQuantizationBits { 12 };
+    int _normalQuantizationBits { 10 };
 };
 
 #endif // hifi_BuildDracoMeshTask_h
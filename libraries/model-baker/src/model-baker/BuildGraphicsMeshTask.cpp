@@ -11,6 +11,8 @@
 
 #include "BuildGraphicsMeshTask.h"
 
+#include <algorithm>
+
 #include <glm/gtc/packing.hpp>
 
 #include <LogHandler.h>
@@ -366,6 +368,29 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         return;
     }
 
+    // The levels of detail index the same vertices from a buffer of their own, so the mesh's parts stay as they were for
+    // picking, collisions and scripts
+    int lodCount = hfmMesh.lodErrors.size();
+    bool hasLODs = lodCount > 0 && std::all_of(hfmMesh.parts.cbegin(), hfmMesh.parts.cend(), [&](const HFMMeshPart& part) {
+        return part.lodTriangleIndices.size() == lodCount;
+    });
+    if (hasLODs) {
+        std::vector<uint32_t> lodIndices;
+        graphics::Mesh::LODs lods(lodCount);
+        for (int lod = 0; lod < lodCount; lod++) {
+            lods[lod]._error = hfmMesh.lodErrors[lod];
+            foreach(const HFMMeshPart& part, hfmMesh.parts) {
+                const auto& partIndices = part.lodTriangleIndices[lod];
+                lods[lod]._parts.emplace_back((graphics::Index)lodIndices.size(), (graphics::Index)partIndices.size(), 0, graphics::Mesh::TRIANGLES);
+                lodIndices.insert(lodIndices.end(), partIndices.cbegin(), partIndices.cend());
+            }
+        }
+        if (!lodIndices.empty()) {
+            auto lodIndexBuffer = std::make_shared<gpu::Buffer>(lodIndices.size() * sizeof(uint32_t), (const gpu::Byte*)lodIndices.data());
+            graphicsMesh->setLODs(gpu::BufferView(lodIndexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ)), lods);
+        }
+    }
+
     graphicsMesh->evalPartBound(0);
 
     graphicsMeshPointer = graphicsMesh;
@@ -380,11 +405,12 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
-    int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(meshes.size());
+    baker::runPerMesh(context, meshes.size(), [&](size_t meshIndex) {
+        int i = (int)meshIndex;
         auto& graphicsMesh = graphicsMeshes[i];
-        
+
+
         // Try to create the graphics::Mesh
         buildGraphicsMesh(meshes[i], graphicsMesh, baker::safeGet(normalsPerMesh, i), baker::safeGet(tangentsPerMesh, i));
 
@@ -395,5 +421,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
@@ -17,13 +17,16 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 class BuildGraphicsMeshTask {
 public:
     using Input = baker::VaryingSet5<std::vector<hfm::Mesh>, hifi::URL, baker::MeshIndicesToModelNames, baker::NormalsPerMesh, baker::TangentsPerMesh>;
     using Output = std::vector<graphics::MeshPointer>;
-    using JobModel = baker::Job::ModelIO<BuildGraphicsMeshTask, Input, Output>;
+    using Config = baker::MeshJobConfig;
+    using JobModel = baker::Job::ModelIO<BuildGraphicsMeshTask, Input, Output, Config>;
 
+    void configure(const Config& config) {}
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
@@ -0,0 +1,32 @@
+//
+//  BuildMeshLODsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BuildMeshLODsTask.h"
+
+#include "MeshSimplification.h"
+
+void BuildMeshLODsTask::configure(const Config& config) {
+    _passthrough = config.passthrough;
+    _lodCount = config.lodCount;
+    _triangleRatio = config.triangleRatio;
+    _maxError = config.maxError;
+}
+
+void BuildMeshLODsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    output = input;
+    if (_passthrough) {
+        return;
+    }
+
+    baker::runPerMesh(context, output.size(), [&](size_t i) {
+        baker::buildMeshLODs(output[i], _lodCount, _triangleRatio, _maxError);
+    });
+}
@@ -0,0 +1,57 @@
+//
+//  BuildMeshLODsTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BuildMeshLODsTask_h
+#define hifi_BuildMeshLODsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+#include "MeshJobs.h"
+
+// The property "passthrough", enabled by default, lets the meshes flow to the output with the levels of detail they were
+// loaded with, if any. ModelBaker disables it so baked models have levels of detail to draw from far away.
+class BuildMeshLODsConfig : public baker::MeshJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool passthrough MEMBER passthrough)
+    Q_PROPERTY(int lodCount MEMBER lodCount)
+    Q_PROPERTY(float triangleRatio MEMBER triangleRatio)
+    Q_PROPERTY(float maxError MEMBER maxError)
+public:
+    bool passthrough { true };
+    int lodCount { 3 };
+    // of the triangles of the level before, how many each level keeps
+    float triangleRatio { 0.5f };
+    // how far the surface of a level may move from the full detail one, relative to the size of the mesh
+    float maxError { 0.05f };
+};
+
+// Simplifies the parts of each mesh into levels of detail, drawn in their place when far enough for the difference not to
+// show
+class BuildMeshLODsTask {
+public:
+    using Config = BuildMeshLODsConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = std::vector<hfm::Mesh>;
+    using JobModel = baker::Job::ModelIO<BuildMeshLODsTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    bool _passthrough { true };
+    int _lodCount { 3 };
+    float _triangleRatio { 0.5f };
+    float _maxError { 0.05f };
+};
+
+#endif // hifi_BuildMeshLODsTask_h
@@ -14,14 +14,17 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 // Calculate blendshape normals if not already present in the blendshape
 class CalculateBlendshapeNormalsTask {
 public:
     using Input = baker::VaryingSet2<baker::BlendshapesPerMesh, std::vector<hfm::Mesh>>;
     using Output = std::vector<baker::NormalsPerBlendshape>;
-    using JobModel = baker::Job::ModelIO<CalculateBlendshapeNormalsTask, Input, Output>;
+    using Config = baker::MeshJobConfig;
+    using JobModel = baker::Job::ModelIO<CalculateBlendshapeNormalsTask, Input, Output, Config>;
 
+    void configure(const Config& config) {}
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
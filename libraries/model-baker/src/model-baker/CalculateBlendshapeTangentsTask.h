@@ -14,14 +14,17 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 // Calculate blendshape tangents if not already present in the blendshape
 class CalculateBlendshapeTangentsTask {
 public:
     using Input = baker::VaryingSet3<std::vector<baker::NormalsPerBlendshape>, baker::BlendshapesPerMesh, std::vector<hfm::Mesh>>;
     using Output = std::vector<baker::TangentsPerBlendshape>;
-    using JobModel = baker::Job::ModelIO<CalculateBlendshapeTangentsTask, Input, Output>;
+    using Config = baker::MeshJobConfig;
+    using JobModel = baker::Job::ModelIO<CalculateBlendshapeTangentsTask, Input, Output, Config>;
 
+    void configure(const Config& config) {}
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
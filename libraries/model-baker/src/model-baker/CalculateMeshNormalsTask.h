@@ -16,14 +16,17 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 // Calculate mesh normals if not already present in the mesh
 class CalculateMeshNormalsTask {
 public:
     using Input = std::vector<hfm::Mesh>;
     using Output = baker::NormalsPerMesh;
-    using JobModel = baker::Job::ModelIO<CalculateMeshNormalsTask, Input, Output>;
+    using Config = baker::MeshJobConfig;
+    using JobModel = baker::Job::ModelIO<CalculateMeshNormalsTask, Input, Output, Config>;
 
+    void configure(const Config& config) {}
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
@@ -16,6 +16,7 @@
 
 #include "Engine.h"
 #include "BakerTypes.h"
+#include "MeshJobs.h"
 
 // Calculate mesh tangents if not already present in the mesh
 class CalculateMeshTangentsTask {
@@ -24,8 +25,10 @@ public:
 
     using Input = baker::VaryingSet2<baker::NormalsPerMesh, std::vector<hfm::Mesh>>;
     using Output = baker::TangentsPerMesh;
-    using JobModel = baker::Job::ModelIO<CalculateMeshTangentsTask, Input, Output>;
+    using Config = baker::MeshJobConfig;
+    using JobModel = baker::Job::ModelIO<CalculateMeshTangentsTask, Input, Output, Config>;
 
+    void configure(const Config& config) {}
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 };
 
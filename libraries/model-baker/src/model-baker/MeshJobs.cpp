@@ -0,0 +1,59 @@
+//
+//  MeshJobs.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshJobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <TBBHelpers.h>
+
+namespace baker {
+
+    void MeshJobConfig::setMeshStats(int meshCount, double msMeshesRunTime, double msSlowestMeshRunTime) {
+        _meshCount = meshCount;
+        _msMeshesRunTime = msMeshesRunTime;
+        _msSlowestMeshRunTime = msSlowestMeshRunTime;
+    }
+
+    void runPerMesh(const BakeContextPointer& context, size_t meshCount, const std::function<void(size_t meshIndex)>& meshJob) {
+        auto config = context ? dynamic_cast<MeshJobConfig*>(context->jobConfig.get()) : nullptr;
+        bool parallel = !config || config->parallel;
+
+        std::vector<std::chrono::nanoseconds> runTimes(meshCount);
+        auto timedMeshJob = [&](size_t meshIndex) {
+            auto startTime = std::chrono::high_resolution_clock::now();
+            meshJob(meshIndex);
+            runTimes[meshIndex] = std::chrono::high_resolution_clock::now() - startTime;
+        };
+
+        if (parallel && meshCount > 1) {
+            tbb::parallel_for((size_t)0, meshCount, timedMeshJob);
+        } else {
+            for (size_t i = 0; i < meshCount; ++i) {
+                timedMeshJob(i);
+            }
+        }
+
+        if (config) {
+            std::chrono::nanoseconds totalRunTime { 0 };
+            std::chrono::nanoseconds slowestRunTime { 0 };
+            for (const auto& runTime : runTimes) {
+                totalRunTime += runTime;
+                slowestRunTime = std::max(slowestRunTime, runTime);
+            }
+            config->setMeshStats((int)meshCount, std::chrono::duration<double, std::milli>(totalRunTime).count(),
+                std::chrono::duration<double, std::milli>(slowestRunTime).count());
+        }
+    }
+
+};
@@ -0,0 +1,54 @@
+//
+//  MeshJobs.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_MeshJobs_h
+#define hifi_baker_MeshJobs_h
+
+#include <functional>
+
+#include "Engine.h"
+
+namespace baker {
+
+    // Config of the jobs doing the same work for each mesh of a model, independently of the other meshes, so the meshes
+    // can be spread across worker threads.  After each run it has the time spent on the meshes, summed and for the
+    // slowest one, next to the job's cpuRunTime.
+    class MeshJobConfig : public JobConfig {
+        Q_OBJECT
+        Q_PROPERTY(bool parallel MEMBER parallel)
+        Q_PROPERTY(int meshCount READ getMeshCount NOTIFY newStats())
+        Q_PROPERTY(double meshesRunTime READ getMeshesRunTime NOTIFY newStats()) //ms
+        Q_PROPERTY(double slowestMeshRunTime READ getSlowestMeshRunTime NOTIFY newStats()) //ms
+    public:
+        MeshJobConfig() = default;
+        MeshJobConfig(bool enabled) : JobConfig(enabled) {}
+
+        bool parallel { true };
+
+        int getMeshCount() const { return _meshCount; }
+        double getMeshesRunTime() const { return _msMeshesRunTime; }
+        double getSlowestMeshRunTime() const { return _msSlowestMeshRunTime; }
+        void setMeshStats(int meshCount, double msMeshesRunTime, double msSlowestMeshRunTime);
+
+    private:
+        int _meshCount { 0 };
+        double _msMeshesRunTime { 0.0 };
+        double _msSlowestMeshRunTime { 0.0 };
+    };
+
+    // Runs meshJob for each mesh index, in parallel unless the running job's MeshJobConfig says otherwise, and records
+    // their timings in that config.  meshJob must only write the outputs of its own mesh, so they should all be sized
+    // beforehand.
+    void runPerMesh(const BakeContextPointer& context, size_t meshCount, const std::function<void(size_t meshIndex)>& meshJob);
+
+};
+
+#endif // hifi_baker_MeshJobs_h
@@ -0,0 +1,396 @@
+//
+//  MeshOptimization.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshOptimization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace baker {
+
+    static const float CACHE_DECAY_POWER = 1.5f;
+    static const float LAST_TRIANGLE_SCORE = 0.75f;
+    static const float VALENCE_BOOST_SCALE = 2.0f;
+    static const float VALENCE_BOOST_POWER = 0.5f;
+
+    // how much a vertex is worth drawing next: more if it's still in the cache, and more if few triangles are left to use
+    // it, so that no vertex is left behind with a lone triangle to be transformed again later
+    static float calculateVertexScore(int cachePosition, int remainingTriangles) {
+        if (remainingTriangles == 0) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // the vertices of the last triangle get a fixed score, or the next triangle would always be its neighbour,
+                // drawing strips rather than fans
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                const float scaler = 1.0f / (OPTIMIZED_VERTEX_CACHE_SIZE - 3);
+                score = powf(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+        return score + VALENCE_BOOST_SCALE * powf((float)remainingTriangles, -VALENCE_BOOST_POWER);
+    }
+
+    static bool isTriangleList(const QVector<int>& indices, int vertexCount) {
+        if (indices.size() % 3 != 0) {
+            return false;
+        }
+        return std::all_of(indices.cbegin(), indices.cend(), [vertexCount](int index) {
+            return index >= 0 && index < vertexCount;
+        });
+    }
+
+    bool optimizeVertexCache(QVector<int>& indices, int vertexCount) {
+        // a single triangle has nothing to reorder
+        if (indices.size() < 6 || !isTriangleList(indices, vertexCount)) {
+            return false;
+        }
+        const int triangleCount = indices.size() / 3;
+
+        // the triangles using each vertex, one vertex after the other, with those already drawn moved past the remaining ones
+        std::vector<int> remainingTriangles(vertexCount, 0);
+        for (int index : indices) {
+            remainingTriangles[index]++;
+        }
+        std::vector<int> triangleOffsets(vertexCount + 1, 0);
+        std::partial_sum(remainingTriangles.cbegin(), remainingTriangles.cend(), triangleOffsets.begin() + 1);
+        std::vector<int> vertexTriangles(indices.size());
+        {
+            std::vector<int> nextOffsets(triangleOffsets.cbegin(), triangleOffsets.cend() - 1);
+            for (int i = 0; i < indices.size(); i++) {
+                vertexTriangles[nextOffsets[indices[i]]++] = i / 3;
+            }
+        }
+
+        std::vector<float> vertexScores(vertexCount);
+        for (int v = 0; v < vertexCount; v++) {
+            vertexScores[v] = calculateVertexScore(-1, remainingTriangles[v]);
+        }
+        std::vector<float> triangleScores(triangleCount);
+        for (int t = 0; t < triangleCount; t++) {
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+        }
+        std::vector<char> drawn(triangleCount, false);
+
+        QVector<int> optimized;
+        optimized.reserve(indices.size());
+        std::vector<int> cache;
+        std::vector<int> newCache;
+        cache.reserve(OPTIMIZED_VERTEX_CACHE_SIZE + 3);
+        newCache.reserve(OPTIMIZED_VERTEX_CACHE_SIZE + 3);
+
+        int bestTriangle = (int)(std::max_element(triangleScores.cbegin(), triangleScores.cend()) - triangleScores.cbegin());
+        int nextUndrawnTriangle = 0;
+        for (int drawnCount = 0; drawnCount < triangleCount; drawnCount++) {
+            if (bestTriangle < 0) {
+                // nothing left around the cached vertices, so carry on from the next triangle of the original order rather
+                // than searching them all, which would make the whole reordering quadratic
+                while (drawn[nextUndrawnTriangle]) {
+                    nextUndrawnTriangle++;
+                }
+                bestTriangle = nextUndrawnTriangle;
+            }
+            const int triangle = bestTriangle;
+            drawn[triangle] = true;
+
+            newCache.clear();
+            for (int k = 0; k < 3; k++) {
+                int vertex = indices[triangle * 3 + k];
+                optimized.push_back(vertex);
+                if (std::find(newCache.cbegin(), newCache.cend(), vertex) == newCache.cend()) {
+                    newCache.push_back(vertex);
+                }
+
+                auto begin = vertexTriangles.begin() + triangleOffsets[vertex];
+                auto end = begin + remainingTriangles[vertex];
+                std::iter_swap(std::find(begin, end, triangle), end - 1);
+                remainingTriangles[vertex]--;
+            }
+            const auto triangleVerticesEnd = newCache.cbegin() + newCache.size();
+            for (int vertex : cache) {
+                if (std::find(newCache.cbegin(), triangleVerticesEnd, vertex) == triangleVerticesEnd) {
+                    newCache.push_back(vertex);
+                }
+            }
+
+            // the vertices pushed past the end of the cache lose their cache score too
+            for (int i = 0; i < (int)newCache.size(); i++) {
+                int vertex = newCache[i];
+                int cachePosition = i < OPTIMIZED_VERTEX_CACHE_SIZE ? i : -1;
+                vertexScores[vertex] = calculateVertexScore(cachePosition, remainingTriangles[vertex]);
+            }
+
+            bestTriangle = -1;
+            float bestScore = -1.0f;
+            for (int vertex : newCache) {
+                for (int i = triangleOffsets[vertex]; i < triangleOffsets[vertex] + remainingTriangles[vertex]; i++) {
+                    int t = vertexTriangles[i];
+                    float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+                    triangleScores[t] = score;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            if ((int)newCache.size() > OPTIMIZED_VERTEX_CACHE_SIZE) {
+                newCache.resize(OPTIMIZED_VERTEX_CACHE_SIZE);
+            }
+            std::swap(cache, newCache);
+        }
+
+        indices.swap(optimized);
+        return true;
+    }
+
+    // Runs through the vertices of an index list as a FIFO cache of cacheSize vertices would, calling onTriangle with each
+    // triangle's index and how many of its vertices missed the cache
+    template <typename F>
+    static void simulateVertexCache(const QVector<int>& indices, int cacheSize, F onTriangle) {
+        if (indices.isEmpty()) {
+            return;
+        }
+        const int vertexCount = *std::max_element(indices.cbegin(), indices.cend()) + 1;
+        // a vertex is in the cache while fewer than cacheSize vertices have been loaded since it was
+        std::vector<int> loadTimes(std::max(vertexCount, 0), -cacheSize - 1);
+        int loadCount = 0;
+        for (int t = 0; t < indices.size() / 3; t++) {
+            int misses = 0;
+            for (int k = 0; k < 3; k++) {
+                int vertex = indices[t * 3 + k];
+                if (vertex < 0 || loadCount - loadTimes[vertex] > cacheSize) {
+                    if (vertex >= 0) {
+                        loadTimes[vertex] = loadCount;
+                    }
+                    loadCount++;
+                    misses++;
+                }
+            }
+            onTriangle(t, misses);
+        }
+    }
+
+    float calculateACMR(const QVector<int>& indices, int cacheSize) {
+        const int triangleCount = indices.size() / 3;
+        if (triangleCount == 0) {
+            return 0.0f;
+        }
+        int totalMisses = 0;
+        simulateVertexCache(indices, cacheSize, [&](int, int misses) {
+            totalMisses += misses;
+        });
+        return (float)totalMisses / (float)triangleCount;
+    }
+
+    void optimizeOverdraw(QVector<int>& indices, const QVector<glm::vec3>& vertices) {
+        if (!isTriangleList(indices, vertices.size())) {
+            return;
+        }
+
+        // the runs start where the cache reordering had to jump to a triangle none of whose vertices were cached
+        std::vector<int> runStarts;
+        simulateVertexCache(indices, OPTIMIZED_VERTEX_CACHE_SIZE, [&](int triangle, int misses) {
+            if (misses == 3) {
+                runStarts.push_back(triangle);
+            }
+        });
+        if (runStarts.size() < 2) {
+            return;
+        }
+        const int triangleCount = indices.size() / 3;
+        runStarts.push_back(triangleCount);
+
+        struct Run {
+            int start;
+            int end;
+            glm::vec3 centroid;
+            glm::vec3 normal;
+            float area;
+            float sortKey;
+        };
+        std::vector<Run> runs;
+        runs.reserve(runStarts.size() - 1);
+        glm::vec3 meshCentroid { 0.0f };
+        float meshArea = 0.0f;
+        for (size_t i = 0; i + 1 < runStarts.size(); i++) {
+            Run run { runStarts[i], runStarts[i + 1], glm::vec3(0.0f), glm::vec3(0.0f), 0.0f, 0.0f };
+            for (int t = run.start; t < run.end; t++) {
+                const auto& p0 = vertices[indices[t * 3]];
+                const auto& p1 = vertices[indices[t * 3 + 1]];
+                const auto& p2 = vertices[indices[t * 3 + 2]];
+                glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+                float area = glm::length(normal) * 0.5f;
+                run.centroid += (p0 + p1 + p2) * (area / 3.0f);
+                run.normal += normal;
+                run.area += area;
+            }
+            meshCentroid += run.centroid;
+            meshArea += run.area;
+            if (run.area > 0.0f) {
+                run.centroid /= run.area;
+            }
+            runs.push_back(run);
+        }
+        if (meshArea > 0.0f) {
+            meshCentroid /= meshArea;
+        }
+
+        // the further out a run is along its normal, the more likely it is to hide the others, so it's drawn first
+        for (auto& run : runs) {
+            float normalLength = glm::length(run.normal);
+            run.sortKey = normalLength > 0.0f ? glm::dot(run.centroid - meshCentroid, run.normal / normalLength) : 0.0f;
+        }
+        std::stable_sort(runs.begin(), runs.end(), [](const Run& a, const Run& b) {
+            return a.sortKey > b.sortKey;
+        });
+
+        QVector<int> sorted;
+        sorted.reserve(indices.size());
+        for (const auto& run : runs) {
+            for (int i = run.start * 3; i < run.end * 3; i++) {
+                sorted.push_back(indices[i]);
+            }
+        }
+        indices.swap(sorted);
+    }
+
+    template <typename T>
+    static void reorderValues(QVector<T>& values, const std::vector<int>& oldIndices) {
+        if (values.isEmpty()) {
+            return;
+        }
+        const int valuesPerVertex = values.size() / (int)oldIndices.size();
+        QVector<T> reordered;
+        reordered.reserve(values.size());
+        for (int oldIndex : oldIndices) {
+            for (int k = 0; k < valuesPerVertex; k++) {
+                reordered.push_back(values[oldIndex * valuesPerVertex + k]);
+            }
+        }
+        values.swap(reordered);
+    }
+
+    static void remapIndices(QVector<int>& indices, const std::vector<int>& newIndices) {
+        for (auto& index : indices) {
+            if (index >= 0 && index < (int)newIndices.size()) {
+                index = newIndices[index];
+            }
+        }
+    }
+
+    bool optimizeVertexFetch(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes) {
+        const int vertexCount = mesh.vertices.size();
+        if (vertexCount == 0) {
+            return false;
+        }
+        auto hasValuePerVertex = [vertexCount](int size) {
+            return size == 0 || size == vertexCount;
+        };
+        if (!hasValuePerVertex(mesh.normals.size()) || !hasValuePerVertex(mesh.tangents.size()) ||
+            !hasValuePerVertex(mesh.colors.size()) || !hasValuePerVertex(mesh.texCoords.size()) ||
+            !hasValuePerVertex(mesh.texCoords1.size()) || !hasValuePerVertex(mesh.originalIndices.size())) {
+            return false;
+        }
+        if (mesh.clusterIndices.size() != mesh.clusterWeights.size() || mesh.clusterIndices.size() % vertexCount != 0) {
+            return false;
+        }
+        auto isInRange = [vertexCount](int index) {
+            return index >= 0 && index < vertexCount;
+        };
+        for (const auto& part : mesh.parts) {
+            if (!std::all_of(part.quadIndices.cbegin(), part.quadIndices.cend(), isInRange) ||
+                !std::all_of(part.quadTrianglesIndices.cbegin(), part.quadTrianglesIndices.cend(), isInRange) ||
+                !std::all_of(part.triangleIndices.cbegin(), part.triangleIndices.cend(), isInRange)) {
+                return false;
+            }
+            for (const auto& lodIndices : part.lodTriangleIndices) {
+                if (!std::all_of(lodIndices.cbegin(), lodIndices.cend(), isInRange)) {
+                    return false;
+                }
+            }
+        }
+
+        std::vector<int> newIndices(vertexCount, -1);
+        int nextIndex = 0;
+        auto number = [&](const QVector<int>& indices) {
+            for (int index : indices) {
+                if (newIndices[index] < 0) {
+                    newIndices[index] = nextIndex++;
+                }
+            }
+        };
+        // in the order BuildGraphicsMesh lays out the indices
+        for (const auto& part : mesh.parts) {
+            number(part.quadTrianglesIndices);
+            number(part.triangleIndices);
+            number(part.quadIndices);
+        }
+        bool isReordered = false;
+        for (int v = 0; v < vertexCount; v++) {
+            if (newIndices[v] < 0) {
+                newIndices[v] = nextIndex++;
+            }
+            isReordered = isReordered || newIndices[v] != v;
+        }
+        if (!isReordered) {
+            return false;
+        }
+
+        std::vector<int> oldIndices(vertexCount);
+        for (int v = 0; v < vertexCount; v++) {
+            oldIndices[newIndices[v]] = v;
+        }
+        reorderValues(mesh.vertices, oldIndices);
+        reorderValues(mesh.normals, oldIndices);
+        reorderValues(mesh.tangents, oldIndices);
+        reorderValues(mesh.colors, oldIndices);
+        reorderValues(mesh.texCoords, oldIndices);
+        reorderValues(mesh.texCoords1, oldIndices);
+        reorderValues(mesh.clusterIndices, oldIndices);
+        reorderValues(mesh.clusterWeights, oldIndices);
+        reorderValues(mesh.originalIndices, oldIndices);
+
+        for (auto& part : mesh.parts) {
+            remapIndices(part.quadIndices, newIndices);
+            remapIndices(part.quadTrianglesIndices, newIndices);
+            remapIndices(part.triangleIndices, newIndices);
+            for (auto& lodIndices : part.lodTriangleIndices) {
+                remapIndices(lodIndices, newIndices);
+            }
+        }
+        for (auto& blendshape : mesh.blendshapes) {
+            remapIndices(blendshape.indices, newIndices);
+        }
+        for (auto& blendshape : blendshapes) {
+            remapIndices(blendshape.indices, newIndices);
+        }
+        return true;
+    }
+
+    void optimizeMesh(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes, bool reduceOverdraw) {
+        const int vertexCount = mesh.vertices.size();
+        for (auto& part : mesh.parts) {
+            if (optimizeVertexCache(part.quadTrianglesIndices, vertexCount) && reduceOverdraw) {
+                optimizeOverdraw(part.quadTrianglesIndices, mesh.vertices);
+            }
+            if (optimizeVertexCache(part.triangleIndices, vertexCount) && reduceOverdraw) {
+                optimizeOverdraw(part.triangleIndices, mesh.vertices);
+            }
+        }
+        optimizeVertexFetch(mesh, blendshapes);
+    }
+
+};
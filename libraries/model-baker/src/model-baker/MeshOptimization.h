@@ -0,0 +1,50 @@
+//
+//  MeshOptimization.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_MeshOptimization_h
+#define hifi_baker_MeshOptimization_h
+
+#include <vector>
+
+#include <hfm/HFM.h>
+
+namespace baker {
+
+    // the number of vertices the vertex cache reordering expects the GPU's post-transform cache to hold
+    const int OPTIMIZED_VERTEX_CACHE_SIZE = 32;
+
+    // Reorders the triangles of an index list so that they reuse the vertices recently transformed by the GPU, after Tom
+    // Forsyth's "Linear-Speed Vertex Cache Optimisation".  Lists with an index outside of [0, vertexCount) or a partial
+    // triangle are left as they are.  Returns whether the list was reordered.
+    bool optimizeVertexCache(QVector<int>& indices, int vertexCount);
+
+    // Reorders the runs of triangles an index list already optimized for the vertex cache starts afresh, so the ones
+    // facing out of the mesh are drawn first and hide the ones behind them, after Sander et al.'s "Fast Triangle
+    // Reordering for Vertex Locality and Reduced Overdraw".  Triangles keep their order within a run, so the cache hit
+    // rate stays the same.
+    void optimizeOverdraw(QVector<int>& indices, const QVector<glm::vec3>& vertices);
+
+    // The average number of vertices transformed per triangle with a FIFO cache of cacheSize vertices, 3 at worst and
+    // 0.5 at best for large meshes
+    float calculateACMR(const QVector<int>& indices, int cacheSize = OPTIMIZED_VERTEX_CACHE_SIZE);
+
+    // Renumbers the vertices of a mesh in the order its parts first use them, so the GPU fetches them sequentially, and
+    // moves every per-vertex attribute and every index referring to them, the blendshapes' included.  Vertices no part
+    // uses keep their order after the used ones.  Meshes whose attributes don't all have one value per vertex are left
+    // as they are.  Returns whether the vertices were renumbered.
+    bool optimizeVertexFetch(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes);
+
+    // All of the above, each part's triangles first, then its vertices
+    void optimizeMesh(hfm::Mesh& mesh, std::vector<hfm::Blendshape>& blendshapes, bool reduceOverdraw);
+
+};
+
+#endif // hifi_baker_MeshOptimization_h
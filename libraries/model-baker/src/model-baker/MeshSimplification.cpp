@@ -0,0 +1,349 @@
+//
+//  MeshSimplification.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplification.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+#include "MeshOptimization.h"
+
+namespace baker {
+
+    // meshes with fewer triangles are cheap enough to draw as they are
+    static const int MIN_LOD_TRIANGLE_COUNT = 256;
+    // a level must have at most this much of the indices of the one before to be worth having
+    static const float MAX_LOD_INDEX_RATIO = 0.8f;
+
+    // The sum of the squared distances to a set of planes, each weighted by the area of its triangle
+    class Quadric {
+    public:
+        void addPlane(const glm::dvec3& normal, double distance, double weight) {
+            _a2 += weight * normal.x * normal.x;
+            _ab += weight * normal.x * normal.y;
+            _ac += weight * normal.x * normal.z;
+            _ad += weight * normal.x * distance;
+            _b2 += weight * normal.y * normal.y;
+            _bc += weight * normal.y * normal.z;
+            _bd += weight * normal.y * distance;
+            _c2 += weight * normal.z * normal.z;
+            _cd += weight * normal.z * distance;
+            _d2 += weight * distance * distance;
+            _weight += weight;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            _a2 += other._a2; _ab += other._ab; _ac += other._ac; _ad += other._ad;
+            _b2 += other._b2; _bc += other._bc; _bd += other._bd;
+            _c2 += other._c2; _cd += other._cd;
+            _d2 += other._d2;
+            _weight += other._weight;
+            return *this;
+        }
+
+        double getWeight() const { return _weight; }
+
+        double evalSquaredDistance(const glm::dvec3& p) const {
+            double result = _a2 * p.x * p.x + 2.0 * _ab * p.x * p.y + 2.0 * _ac * p.x * p.z + 2.0 * _ad * p.x +
+                _b2 * p.y * p.y + 2.0 * _bc * p.y * p.z + 2.0 * _bd * p.y +
+                _c2 * p.z * p.z + 2.0 * _cd * p.z +
+                _d2;
+            // it's a sum of squares, apart from rounding
+            return std::max(result, 0.0);
+        }
+
+    private:
+        double _a2 { 0.0 }, _ab { 0.0 }, _ac { 0.0 }, _ad { 0.0 };
+        double _b2 { 0.0 }, _bc { 0.0 }, _bd { 0.0 };
+        double _c2 { 0.0 }, _cd { 0.0 };
+        double _d2 { 0.0 };
+        double _weight { 0.0 };
+    };
+
+    struct Collapse {
+        int from;
+        int to;
+        // the mean of the squared distances the surface around the collapsed vertices moves
+        double cost;
+    };
+
+    static uint64_t makeEdgeKey(int a, int b) {
+        return a < b ? ((uint64_t)a << 32) | (uint32_t)b : ((uint64_t)b << 32) | (uint32_t)a;
+    }
+
+    // the vertices that can't move: those sharing their position with another vertex, which are on a seam of the other
+    // attributes, and those on an edge that doesn't have exactly two triangles
+    static std::vector<char> findLockedVertices(const QVector<int>& indices, const QVector<glm::vec3>& vertices) {
+        std::vector<char> locked(vertices.size(), false);
+
+        std::vector<int> byPosition(vertices.size());
+        std::iota(byPosition.begin(), byPosition.end(), 0);
+        auto isBefore = [&](int a, int b) {
+            const auto& p = vertices[a];
+            const auto& q = vertices[b];
+            return p.x < q.x || (p.x == q.x && (p.y < q.y || (p.y == q.y && p.z < q.z)));
+        };
+        std::sort(byPosition.begin(), byPosition.end(), isBefore);
+        for (size_t i = 1; i < byPosition.size(); i++) {
+            if (vertices[byPosition[i]] == vertices[byPosition[i - 1]]) {
+                locked[byPosition[i]] = true;
+                locked[byPosition[i - 1]] = true;
+            }
+        }
+
+        std::unordered_map<uint64_t, int> edgeTriangleCounts;
+        edgeTriangleCounts.reserve(indices.size());
+        for (int i = 0; i < indices.size(); i += 3) {
+            for (int k = 0; k < 3; k++) {
+                edgeTriangleCounts[makeEdgeKey(indices[i + k], indices[i + (k + 1) % 3])]++;
+            }
+        }
+        for (const auto& edge : edgeTriangleCounts) {
+            if (edge.second != 2) {
+                locked[edge.first >> 32] = true;
+                locked[edge.first & 0xffffffff] = true;
+            }
+        }
+        return locked;
+    }
+
+    static glm::dvec3 evalTriangleNormal(const glm::dvec3& p0, const glm::dvec3& p1, const glm::dvec3& p2) {
+        return glm::cross(p1 - p0, p2 - p0);
+    }
+
+    static int removeDegenerateTriangles(QVector<int>& indices) {
+        int kept = 0;
+        for (int i = 0; i < indices.size(); i += 3) {
+            int a = indices[i];
+            int b = indices[i + 1];
+            int c = indices[i + 2];
+            if (a != b && b != c && c != a) {
+                indices[kept++] = a;
+                indices[kept++] = b;
+                indices[kept++] = c;
+            }
+        }
+        indices.resize(kept);
+        return kept;
+    }
+
+    QVector<int> simplifyTriangles(const QVector<int>& indices, const QVector<glm::vec3>& vertices, int targetIndexCount,
+                                   float maxError, float* error) {
+        if (error) {
+            *error = 0.0f;
+        }
+        const int vertexCount = vertices.size();
+        bool isTriangleList = indices.size() % 3 == 0 && std::all_of(indices.cbegin(), indices.cend(), [&](int index) {
+            return index >= 0 && index < vertexCount;
+        });
+        if (!isTriangleList || indices.size() <= targetIndexCount) {
+            return indices;
+        }
+
+        QVector<int> result = indices;
+        removeDegenerateTriangles(result);
+        const std::vector<char> locked = findLockedVertices(result, vertices);
+
+        std::vector<glm::dvec3> positions(vertexCount);
+        for (int v = 0; v < vertexCount; v++) {
+            positions[v] = glm::dvec3(vertices[v]);
+        }
+        std::vector<Quadric> quadrics(vertexCount);
+        for (int i = 0; i < result.size(); i += 3) {
+            const auto& p0 = positions[result[i]];
+            glm::dvec3 normal = evalTriangleNormal(p0, positions[result[i + 1]], positions[result[i + 2]]);
+            double doubleArea = glm::length(normal);
+            if (doubleArea > 0.0) {
+                normal /= doubleArea;
+                for (int k = 0; k < 3; k++) {
+                    quadrics[result[i + k]].addPlane(normal, -glm::dot(normal, p0), doubleArea * 0.5);
+                }
+            }
+        }
+
+        const double maxCost = (double)maxError * (double)maxError;
+        double worstCost = 0.0;
+        std::vector<Collapse> collapses;
+        std::vector<int> triangleOffsets(vertexCount + 1);
+        std::vector<int> vertexTriangles;
+        std::vector<char> touched(vertexCount);
+
+        // Each pass collapses the cheapest edges it can, at most one per vertex, so the costs it sorted stay true
+        while (result.size() > targetIndexCount) {
+            auto evalCost = [&](int from, int to) {
+                Quadric quadric = quadrics[from];
+                quadric += quadrics[to];
+                double weight = quadric.getWeight();
+                return weight > 0.0 ? quadric.evalSquaredDistance(positions[to]) / weight : 0.0;
+            };
+            collapses.clear();
+            for (int i = 0; i < result.size(); i += 3) {
+                for (int k = 0; k < 3; k++) {
+                    int a = result[i + k];
+                    int b = result[i + (k + 1) % 3];
+                    // each edge is seen from both of its triangles, so only take it from one of them
+                    if (a > b) {
+                        continue;
+                    }
+                    Collapse collapse { -1, -1, std::numeric_limits<double>::max() };
+                    if (!locked[a]) {
+                        collapse = { a, b, evalCost(a, b) };
+                    }
+                    if (!locked[b]) {
+                        double cost = evalCost(b, a);
+                        if (cost < collapse.cost) {
+                            collapse = { b, a, cost };
+                        }
+                    }
+                    if (collapse.from >= 0 && collapse.cost <= maxCost) {
+                        collapses.push_back(collapse);
+                    }
+                }
+            }
+            if (collapses.empty()) {
+                break;
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                return a.cost < b.cost;
+            });
+
+            std::fill(triangleOffsets.begin(), triangleOffsets.end(), 0);
+            for (int index : result) {
+                triangleOffsets[index + 1]++;
+            }
+            std::partial_sum(triangleOffsets.cbegin(), triangleOffsets.cend(), triangleOffsets.begin());
+            vertexTriangles.resize(result.size());
+            {
+                std::vector<int> nextOffsets(triangleOffsets.cbegin(), triangleOffsets.cend() - 1);
+                for (int i = 0; i < result.size(); i++) {
+                    vertexTriangles[nextOffsets[result[i]]++] = i / 3;
+                }
+            }
+
+            std::fill(touched.begin(), touched.end(), false);
+            int indexCount = result.size();
+            int collapseCount = 0;
+            for (const auto& collapse : collapses) {
+                if (indexCount <= targetIndexCount) {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to]) {
+                    continue;
+                }
+
+                // the triangles around the collapsed vertex that don't disappear mustn't flip over
+                bool flips = false;
+                int removedTriangles = 0;
+                for (int i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1] && !flips; i++) {
+                    int t = vertexTriangles[i] * 3;
+                    int a = result[t];
+                    int b = result[t + 1];
+                    int c = result[t + 2];
+                    if (a == collapse.to || b == collapse.to || c == collapse.to) {
+                        removedTriangles++;
+                        continue;
+                    }
+                    glm::dvec3 normal = evalTriangleNormal(positions[a], positions[b], positions[c]);
+                    auto moved = [&](int vertex) {
+                        return positions[vertex == collapse.from ? collapse.to : vertex];
+                    };
+                    glm::dvec3 movedNormal = evalTriangleNormal(moved(a), moved(b), moved(c));
+                    flips = glm::dot(normal, movedNormal) <= 0.0;
+                }
+                if (flips) {
+                    continue;
+                }
+
+                for (int i = triangleOffsets[collapse.from]; i < triangleOffsets[collapse.from + 1]; i++) {
+                    int t = vertexTriangles[i] * 3;
+                    for (int k = 0; k < 3; k++) {
+                        if (result[t + k] == collapse.from) {
+                            result[t + k] = collapse.to;
+                        }
+                    }
+                }
+                quadrics[collapse.to] += quadrics[collapse.from];
+                touched[collapse.from] = true;
+                touched[collapse.to] = true;
+                indexCount -= removedTriangles * 3;
+                worstCost = std::max(worstCost, collapse.cost);
+                collapseCount++;
+            }
+
+            removeDegenerateTriangles(result);
+            if (collapseCount == 0) {
+                break;
+            }
+        }
+
+        if (error) {
+            *error = (float)sqrt(worstCost);
+        }
+        return result;
+    }
+
+    void buildMeshLODs(hfm::Mesh& mesh, int lodCount, float triangleRatio, float maxError) {
+        mesh.lodErrors.clear();
+        for (auto& part : mesh.parts) {
+            part.lodTriangleIndices.clear();
+        }
+
+        std::vector<QVector<int>> partIndices;
+        int indexCount = 0;
+        for (const auto& part : mesh.parts) {
+            partIndices.push_back(part.quadTrianglesIndices + part.triangleIndices);
+            indexCount += partIndices.back().size();
+        }
+        if (indexCount / 3 < MIN_LOD_TRIANGLE_COUNT || mesh.vertices.isEmpty()) {
+            return;
+        }
+
+        glm::vec3 minimum = mesh.vertices[0];
+        glm::vec3 maximum = mesh.vertices[0];
+        for (const auto& vertex : mesh.vertices) {
+            minimum = glm::min(minimum, vertex);
+            maximum = glm::max(maximum, vertex);
+        }
+        const float maxDistance = maxError * glm::length(maximum - minimum);
+
+        int previousIndexCount = indexCount;
+        float previousError = 0.0f;
+        float ratio = 1.0f;
+        for (int lod = 0; lod < lodCount; lod++) {
+            ratio *= triangleRatio;
+            std::vector<QVector<int>> lodIndices;
+            int lodIndexCount = 0;
+            float lodError = previousError;
+            for (const auto& indices : partIndices) {
+                int targetIndexCount = std::max(3, (int)(indices.size() * ratio) / 3 * 3);
+                float error;
+                lodIndices.push_back(simplifyTriangles(indices, mesh.vertices, targetIndexCount, maxDistance, &error));
+                optimizeVertexCache(lodIndices.back(), mesh.vertices.size());
+                lodIndexCount += lodIndices.back().size();
+                lodError = std::max(lodError, error);
+            }
+            if (lodIndexCount > previousIndexCount * MAX_LOD_INDEX_RATIO) {
+                break;
+            }
+
+            for (size_t i = 0; i < lodIndices.size(); i++) {
+                mesh.parts[(int)i].lodTriangleIndices.push_back(lodIndices[i]);
+            }
+            mesh.lodErrors.push_back(lodError);
+            previousIndexCount = lodIndexCount;
+            previousError = lodError;
+        }
+    }
+
+};
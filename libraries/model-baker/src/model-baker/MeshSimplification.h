@@ -0,0 +1,34 @@
+//
+//  MeshSimplification.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_MeshSimplification_h
+#define hifi_baker_MeshSimplification_h
+
+#include <hfm/HFM.h>
+
+namespace baker {
+
+    // Simplifies a list of triangles by collapsing its edges, the cheapest first by Garland and Heckbert's quadric error
+    // metric, until at most targetIndexCount indices are left or any further collapse would move the surface more than
+    // maxError.  Vertices are collapsed onto one another rather than moved, so the result indexes the same vertices.
+    // Vertices on the border of the triangles, or on attribute seams where vertices share a position, are kept so the
+    // surface doesn't tear.  error, if given, gets how far the surface moved.
+    QVector<int> simplifyTriangles(const QVector<int>& indices, const QVector<glm::vec3>& vertices, int targetIndexCount,
+                                   float maxError, float* error = nullptr);
+
+    // Fills the lodTriangleIndices of the mesh's parts and its lodErrors with up to lodCount levels of detail, each keeping
+    // about triangleRatio of the triangles of the one before.  maxError is relative to the size of the mesh.  Levels
+    // stop where they no longer get much simpler, and meshes too small to be worth it get none.
+    void buildMeshLODs(hfm::Mesh& mesh, int lodCount, float triangleRatio, float maxError);
+
+};
+
+#endif // hifi_baker_MeshSimplification_h
@@ -0,0 +1,34 @@
+//
+//  OptimizeMeshesTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OptimizeMeshesTask.h"
+
+#include "MeshOptimization.h"
+
+void OptimizeMeshesTask::configure(const Config& config) {
+    _passthrough = config.passthrough;
+    _reduceOverdraw = config.reduceOverdraw;
+}
+
+void OptimizeMeshesTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    auto& meshesOut = output.edit0();
+    auto& blendshapesPerMeshOut = output.edit1();
+    meshesOut = input.get0();
+    blendshapesPerMeshOut = input.get1();
+    if (_passthrough) {
+        return;
+    }
+
+    blendshapesPerMeshOut.resize(meshesOut.size());
+    baker::runPerMesh(context, meshesOut.size(), [&](size_t i) {
+        baker::optimizeMesh(meshesOut[i], blendshapesPerMeshOut[i], _reduceOverdraw);
+    });
+}
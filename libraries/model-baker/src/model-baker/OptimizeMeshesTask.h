@@ -0,0 +1,49 @@
+//
+//  OptimizeMeshesTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OptimizeMeshesTask_h
+#define hifi_OptimizeMeshesTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+#include "MeshJobs.h"
+
+// The property "passthrough", enabled by default, lets the meshes flow to the output unmodified, as reordering them
+// isn't worth the time when loading a model. ModelBaker disables it so baked models are drawn from optimized meshes.
+class OptimizeMeshesConfig : public baker::MeshJobConfig {
+    Q_OBJECT
+    Q_PROPERTY(bool passthrough MEMBER passthrough)
+    Q_PROPERTY(bool reduceOverdraw MEMBER reduceOverdraw)
+public:
+    bool passthrough { true };
+    bool reduceOverdraw { true };
+};
+
+// Reorders the triangles of each mesh part for the vertex cache and overdraw, then the vertices of each mesh in the
+// order they are drawn, remapping the blendshapes' vertex indices to match
+class OptimizeMeshesTask {
+public:
+    using Config = OptimizeMeshesConfig;
+    using Input = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using Output = baker::VaryingSet2<std::vector<hfm::Mesh>, baker::BlendshapesPerMesh>;
+    using JobModel = baker::Job::ModelIO<OptimizeMeshesTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    bool _passthrough { true };
+    bool _reduceOverdraw { true };
+};
+
+#endif // hifi_OptimizeMeshesTask_h
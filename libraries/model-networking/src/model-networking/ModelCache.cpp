@@ -331,8 +331,10 @@ void GeometryResource::setGeometryDefinition(HFMModel::Pointer hfmModel, const M
     std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
     std::shared_ptr<GeometryMeshParts> parts = std::make_shared<GeometryMeshParts>();
     int meshID = 0;
+    auto& geometryBufferPool = DependencyManager::get<ModelCache>()->getGeometryBufferPool();
     for (const HFMMesh& mesh : _hfmModel->meshes) {
-        // Copy mesh pointers
+        // Move the vertices and indices into the shared buffers, then copy mesh pointers
+        geometryBufferPool.adopt(mesh._mesh);
         meshes->emplace_back(mesh._mesh);
         int partID = 0;
         for (const HFMMeshPart& part : mesh.parts) {
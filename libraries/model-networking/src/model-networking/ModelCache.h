@@ -18,6 +18,7 @@
 #include <ResourceCache.h>
 
 #include <graphics/Asset.h>
+#include <graphics/GeometryBufferPool.h>
 
 #include "FBXSerializer.h"
 #include <procedural/ProceduralMaterialCache.h>
@@ -136,6 +137,7 @@ public:
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
+    void setLoadPriority(const QPointer<QObject>& owner, float priority) { if (_resource) { _resource->setLoadPriority(owner, priority); } }
 
 private:
     void startWatching();
@@ -170,6 +172,9 @@ public:
                                                                  GeometryMappingPair(QUrl(), QVariantHash()),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    // the shared buffers the meshes of the loaded models are drawn from
+    graphics::GeometryBufferPool& getGeometryBufferPool() { return _geometryBufferPool; }
+
 protected:
     friend class GeometryResource;
 
@@ -180,6 +185,7 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+    graphics::GeometryBufferPool _geometryBufferPool;
 };
 
 class MeshPart {
@@ -33,6 +33,9 @@ static const int32_t FBX_PROPERTY_COMPRESSED_FLAG = 1;
 // The version of the FBX node containing the draco mesh. See also: DRACO_MESH_VERSION in HFM.h
 static const int FBX_DRACO_MESH_VERSION = 2;
 
+// The version of the FBX node containing the baked collision shapes of the model
+static const int FBX_COLLISION_SHAPES_VERSION = 1;
+
 class FBXNode;
 using FBXNodeList = QList<FBXNode>;
 
@@ -11,6 +11,8 @@
 
 #include "FBXSerializer.h"
 
+#include <algorithm>
+
 #include <QBuffer>
 
 #include <glm/gtc/quaternion.hpp>
@@ -384,6 +386,52 @@ HFMLight extractLight(const FBXNode& object) {
     return light;
 }
 
+static QVector<glm::vec3> floatsToPoints(const QVector<float>& floats) {
+    QVector<glm::vec3> points;
+    points.reserve(floats.size() / 3);
+    for (int i = 0; i + 2 < floats.size(); i += 3) {
+        points.push_back(glm::vec3(floats[i], floats[i + 1], floats[i + 2]));
+    }
+    return points;
+}
+
+// the collision shapes ModelBaker put in the model, or none if they are from another version or don't make sense
+hfm::CollisionShapes extractCollisionShapes(const FBXNode& object, const QString& url) {
+    hfm::CollisionShapes collisionShapes;
+    int version = -1;
+    foreach (const FBXNode& subobject, object.children) {
+        if (subobject.name == "CollisionShapesVersion" && !subobject.properties.isEmpty()) {
+            version = subobject.properties.at(0).toInt();
+        } else if (subobject.name == "Hull") {
+            QVector<glm::vec3> hull = floatsToPoints(FBXSerializer::getFloatVector(subobject));
+            if (!hull.isEmpty()) {
+                collisionShapes.hulls.push_back(hull);
+            }
+        } else if (subobject.name == "Vertices") {
+            collisionShapes.vertices = floatsToPoints(FBXSerializer::getFloatVector(subobject));
+        } else if (subobject.name == "TriangleIndices") {
+            collisionShapes.triangleIndices = FBXSerializer::getIntVector(subobject);
+        } else if (subobject.name == "BVH" && !subobject.properties.isEmpty()) {
+            collisionShapes.bvh = qUncompress(subobject.properties.at(0).toByteArray());
+        }
+    }
+    if (version != FBX_COLLISION_SHAPES_VERSION) {
+        return hfm::CollisionShapes();
+    }
+
+    auto& indices = collisionShapes.triangleIndices;
+    int vertexCount = collisionShapes.vertices.size();
+    bool isStaticMeshValid = indices.size() % 3 == 0 &&
+        std::all_of(indices.cbegin(), indices.cend(), [&](int32_t index) { return index >= 0 && index < vertexCount; });
+    if (!isStaticMeshValid) {
+        qCWarning(modelformat) << "Ignoring the malformed baked static mesh collision shape of" << url;
+        collisionShapes.vertices.clear();
+        indices.clear();
+        collisionShapes.bvh.clear();
+    }
+    return collisionShapes;
+}
+
 hifi::ByteArray fileOnUrl(const hifi::ByteArray& filepath, const QString& url) {
     // in order to match the behaviour when loading models from remote URLs
     // we assume that all external textures are right beside the loaded model
@@ -1100,6 +1148,8 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
 #endif
             }
+        } else if (child.name == "CollisionShapes") {
+            hfmModel.collisionShapes = extractCollisionShapes(child, url);
         } else if (child.name == "Connections") {
             static const QVariant OO = hifi::ByteArray("OO");
             static const QVariant OP = hifi::ByteArray("OP");
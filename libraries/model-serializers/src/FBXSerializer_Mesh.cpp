@@ -509,6 +509,41 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 part.triangleIndices.append(dracoFace[1].value());
                 part.triangleIndices.append(dracoFace[2].value());
             }
+
+            // the levels of detail the baker simplified the parts into, which index the points by material as the parts do
+            const draco::GeometryMetadata* metadata = dracoMesh->GetMetadata();
+            int32_t lodCount = 0;
+            if (metadata && metadata->GetEntryInt(DRACO_METADATA_LOD_COUNT, &lodCount) && lodCount > 0) {
+                auto& mesh = data.extracted.mesh;
+                bool isValid = true;
+                for (int lod = 0; lod < lodCount && isValid; lod++) {
+                    double error;
+                    isValid = metadata->GetEntryDouble(QString(DRACO_METADATA_LOD_ERROR).arg(lod).toStdString(), &error);
+                    mesh.lodErrors.push_back((float)error);
+                }
+                for (auto it = materialTextureParts.cbegin(); it != materialTextureParts.cend() && isValid; ++it) {
+                    HFMMeshPart& part = mesh.parts[it.value() - 1];
+                    for (int lod = 0; lod < lodCount && isValid; lod++) {
+                        std::vector<int32_t> lodIndices;
+                        metadata->GetEntryIntArray(QString(DRACO_METADATA_LOD_INDICES).arg(lod).arg(it.key().first).toStdString(), &lodIndices);
+                        isValid = lodIndices.size() % 3 == 0;
+                        QVector<int> lodTriangleIndices;
+                        lodTriangleIndices.reserve((int)lodIndices.size());
+                        for (int32_t index : lodIndices) {
+                            isValid = isValid && index >= 0 && index < (int32_t)numVertices;
+                            lodTriangleIndices.append(index);
+                        }
+                        part.lodTriangleIndices.append(lodTriangleIndices);
+                    }
+                }
+                if (!isValid) {
+                    qCWarning(modelformat) << "Ignoring the malformed levels of detail of a draco mesh";
+                    mesh.lodErrors.clear();
+                    for (auto& part : mesh.parts) {
+                        part.lodTriangleIndices.clear();
+                    }
+                }
+            }
         }
     }
 
@@ -12,6 +12,7 @@
 #include "GLTFSerializer.h"
 
 #include <QtCore/QBuffer>
+#include <QtCore/QtEndian>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
 #include <QtCore/qjsondocument.h>
@@ -33,6 +34,9 @@
 #include <PathUtils.h>
 #include <image/ColorChannel.h>
 #include <BlendshapeConstants.h>
+#include <TBBHelpers.h>
+
+#include <draco/compression/decode.h>
 
 #include "FBXSerializer.h"
 
@@ -148,26 +152,31 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4;
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
-
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+    // a GLB is a 12 byte header then chunks, each its length, its type and its data padded to 4 bytes
+    const int GLB_HEADER_SIZE = 12;
+    const int GLB_CHUNK_HEADER_SIZE = 8;
+    const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    hifi::ByteArray jsonChunk;
+    int chunkStart = GLB_HEADER_SIZE;
+    while (chunkStart + GLB_CHUNK_HEADER_SIZE <= data.size()) {
+        quint32 chunkLength = qFromLittleEndian<quint32>(data.constData() + chunkStart);
+        quint32 chunkType = qFromLittleEndian<quint32>(data.constData() + chunkStart + 4);
+        int chunkDataStart = chunkStart + GLB_CHUNK_HEADER_SIZE;
+        if (chunkLength > (quint32)(data.size() - chunkDataStart)) {
+            qWarning(modelformat) << "GLB chunk runs past the end of the file for model " << _url;
+            break;
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        // the chunks are read where they are in the data rather than copied out of it
+        hifi::ByteArray chunk = hifi::ByteArray::fromRawData(data.constData() + chunkDataStart, (int)chunkLength);
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isNull()) {
+            jsonChunk = chunk;
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isNull()) {
+            _glbBinary = chunk;
+        }
+        chunkStart = chunkDataStart + (int)((chunkLength + 3) & ~3u);
     }
     return jsonChunk;
 }
@@ -386,6 +395,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
 
     _file.bufferviews.push_back(bufferview);
@@ -539,6 +549,22 @@ bool GLTFSerializer::addMesh(const QJsonObject& object) {
                     }
                 }
 
+                QJsonObject jsExtensions;
+                QJsonObject jsDraco;
+                if (getObjectVal(jsPrimitive, "extensions", jsExtensions, primitive.defined) &&
+                    getObjectVal(jsExtensions, "KHR_draco_mesh_compression", jsDraco, primitive.defined)) {
+                    getIntVal(jsDraco, "bufferView", primitive.draco.bufferView, primitive.draco.defined);
+                    QJsonObject jsDracoAttributes;
+                    if (getObjectVal(jsDraco, "attributes", jsDracoAttributes, primitive.draco.defined)) {
+                        foreach(const QString & attrKey, jsDracoAttributes.keys()) {
+                            int attrVal;
+                            getIntVal(jsDracoAttributes, attrKey, attrVal, primitive.draco.attributes.defined);
+                            primitive.draco.attributes.values.insert(attrKey, attrVal);
+                        }
+                    }
+                    primitive.defined["draco"] = primitive.draco.defined["bufferView"];
+                }
+
                 QJsonArray jsTargets;
                 if (getObjectArrayVal(jsPrimitive, "targets", jsTargets, primitive.defined)) {
                     foreach(const QJsonValue & tar, jsTargets) {
@@ -657,6 +683,12 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
 
     bool success = setAsset(jsFile);
     if (success) {
+        foreach(const QJsonValue & extension, jsFile.value("extensionsRequired").toArray()) {
+            if (extension.toString() != "KHR_draco_mesh_compression") {
+                qWarning(modelformat) << "Unsupported glTF extension" << extension.toString() << "is required by model " << _url;
+            }
+        }
+
         QJsonArray accessors;
         if (getObjectArrayVal(jsFile, "accessors", accessors, _file.defined)) {
             foreach(const QJsonValue & accVal, accessors) {
@@ -773,10 +805,159 @@ bool GLTFSerializer::parseGLTF(const hifi::ByteArray& data) {
                 }
             }
         }
+
+        if (success) {
+            decodeDracoPrimitives();
+        }
     }
     return success;
 }
 
+static int getAccessorTypeComponentCount(int accessorType) {
+    switch (accessorType) {
+        case GLTFAccessorType::SCALAR:
+            return 1;
+        case GLTFAccessorType::VEC2:
+            return 2;
+        case GLTFAccessorType::VEC3:
+            return 3;
+        case GLTFAccessorType::VEC4:
+            return 4;
+        case GLTFAccessorType::MAT2:
+            return 4;
+        case GLTFAccessorType::MAT3:
+            return 9;
+        case GLTFAccessorType::MAT4:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+int GLTFSerializer::addDecodedBufferView(const hifi::ByteArray& blob) {
+    GLTFBuffer buffer;
+    buffer.byteLength = blob.size();
+    buffer.blob = blob;
+    buffer.defined["byteLength"] = true;
+    buffer.defined["blob"] = true;
+    _file.buffers.push_back(buffer);
+
+    GLTFBufferView bufferview;
+    bufferview.buffer = _file.buffers.size() - 1;
+    bufferview.byteLength = blob.size();
+    bufferview.target = 0;
+    bufferview.defined["buffer"] = true;
+    bufferview.defined["byteLength"] = true;
+    _file.bufferviews.push_back(bufferview);
+
+    return _file.bufferviews.size() - 1;
+}
+
+static void setDecodedAccessor(GLTFAccessor& accessor, int bufferView, int componentType, int count) {
+    accessor.bufferView = bufferView;
+    accessor.byteOffset = 0;
+    accessor.componentType = componentType;
+    accessor.count = count;
+    accessor.normalized = false;
+    accessor.defined["bufferView"] = true;
+    accessor.defined["byteOffset"] = false;
+    accessor.defined["sparse"] = false;
+}
+
+// The accessors of draco compressed primitives have no data of their own, so the primitives are decoded into new buffer
+// views and the accessors pointed at those, for buildGeometry to read like any others.
+void GLTFSerializer::decodeDracoPrimitives() {
+    std::vector<GLTFMeshPrimitive*> dracoPrimitives;
+    for (auto& mesh : _file.meshes) {
+        for (auto& primitive : mesh.primitives) {
+            if (primitive.defined.value("draco")) {
+                dracoPrimitives.push_back(&primitive);
+            }
+        }
+    }
+    if (dracoPrimitives.empty()) {
+        return;
+    }
+
+    // decoding is most of the work, and each primitive is decoded on its own
+    std::vector<std::unique_ptr<draco::Mesh>> dracoMeshes(dracoPrimitives.size());
+    const auto& bufferviews = _file.bufferviews;
+    const auto& buffers = _file.buffers;
+    tbb::parallel_for((size_t)0, dracoPrimitives.size(), [&](size_t i) {
+        int bufferViewIndex = dracoPrimitives[i]->draco.bufferView;
+        if (bufferViewIndex < 0 || bufferViewIndex >= bufferviews.size()) {
+            return;
+        }
+        const GLTFBufferView& bufferview = bufferviews[bufferViewIndex];
+        if (bufferview.buffer < 0 || bufferview.buffer >= buffers.size()) {
+            return;
+        }
+        const hifi::ByteArray& blob = buffers[bufferview.buffer].blob;
+        if (bufferview.byteOffset < 0 || bufferview.byteLength <= 0 || bufferview.byteLength > blob.size() - bufferview.byteOffset) {
+            return;
+        }
+
+        draco::Decoder decoder;
+        draco::DecoderBuffer decoderBuffer;
+        decoderBuffer.Init(blob.constData() + bufferview.byteOffset, bufferview.byteLength);
+        std::unique_ptr<draco::Mesh> dracoMesh(new draco::Mesh());
+        if (decoder.DecodeBufferToGeometry(&decoderBuffer, dracoMesh.get()).ok()) {
+            dracoMeshes[i] = std::move(dracoMesh);
+        }
+    });
+
+    for (size_t i = 0; i < dracoPrimitives.size(); ++i) {
+        GLTFMeshPrimitive& primitive = *dracoPrimitives[i];
+        const auto& dracoMesh = dracoMeshes[i];
+        if (!dracoMesh) {
+            qWarning(modelformat) << "Failed to decode draco compressed primitive for model " << _url;
+            continue;
+        }
+
+        if (primitive.defined.value("indices") && primitive.indices >= 0 && primitive.indices < _file.accessors.size()) {
+            int indexCount = (int)dracoMesh->num_faces() * 3;
+            hifi::ByteArray blob(indexCount * (int)sizeof(uint32_t), Qt::Uninitialized);
+            uint32_t* indices = reinterpret_cast<uint32_t*>(blob.data());
+            for (uint32_t face = 0; face < dracoMesh->num_faces(); ++face) {
+                const auto& dracoFace = dracoMesh->face(draco::FaceIndex(face));
+                for (int corner = 0; corner < 3; ++corner) {
+                    *indices++ = dracoFace[corner].value();
+                }
+            }
+            setDecodedAccessor(_file.accessors[primitive.indices], addDecodedBufferView(blob),
+                               GLTFAccessorComponentType::UNSIGNED_INT, indexCount);
+        }
+
+        foreach(const QString & key, primitive.draco.attributes.values.keys()) {
+            int accessorIdx = primitive.attributes.values.value(key, -1);
+            auto attribute = dracoMesh->GetAttributeByUniqueId(primitive.draco.attributes.values[key]);
+            if (accessorIdx < 0 || accessorIdx >= _file.accessors.size() || !attribute) {
+                qWarning(modelformat) << "Draco compressed attribute" << key << "is missing for model " << _url;
+                continue;
+            }
+
+            GLTFAccessor& accessor = _file.accessors[accessorIdx];
+            const int MAX_DRACO_COMPONENTS = 4;
+            int componentCount = getAccessorTypeComponentCount(accessor.type);
+            if (componentCount == 0 || componentCount > MAX_DRACO_COMPONENTS) {
+                qWarning(modelformat) << "Invalid accessor type on draco compressed attribute" << key << "for model " << _url;
+                continue;
+            }
+
+            // values are decoded as floats whatever the accessor had, readArray converts them as it would the originals
+            int pointCount = (int)dracoMesh->num_points();
+            hifi::ByteArray blob(pointCount * componentCount * (int)sizeof(float), Qt::Uninitialized);
+            float* values = reinterpret_cast<float*>(blob.data());
+            for (int point = 0; point < pointCount; ++point) {
+                float value[MAX_DRACO_COMPONENTS];
+                attribute->ConvertValue<float, MAX_DRACO_COMPONENTS>(attribute->mapped_index(draco::PointIndex(point)), value);
+                memcpy(values + point * componentCount, value, componentCount * sizeof(float));
+            }
+            setDecodedAccessor(accessor, addDecodedBufferView(blob), GLTFAccessorComponentType::FLOAT, pointCount);
+        }
+    }
+}
+
 glm::mat4 GLTFSerializer::getModelTransform(const GLTFNode& node) {
     glm::mat4 tmat = glm::mat4(1.0);
 
@@ -1809,7 +1990,10 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int offset = imagesBufferview.byteOffset;
             int length = imagesBufferview.byteLength;
 
-            fbxtex.content = _glbBinary.mid(offset, length);
+            // the texture outlives the data being read, so it gets a copy rather than a view
+            if (offset >= 0 && length >= 0 && length <= _glbBinary.size() - offset) {
+                fbxtex.content = hifi::ByteArray(_glbBinary.constData() + offset, length);
+            }
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1892,89 +2076,71 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                            QVector<L>& outarray, int accessorType, bool normalized) {
-
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
-    int bufferCount = 0;
-    switch (accessorType) {
-    case GLTFAccessorType::SCALAR:
-        bufferCount = 1;
-        break;
-    case GLTFAccessorType::VEC2:
-        bufferCount = 2;
-        break;
-    case GLTFAccessorType::VEC3:
-        bufferCount = 3;
-        break;
-    case GLTFAccessorType::VEC4:
-        bufferCount = 4;
-        break;
-    case GLTFAccessorType::MAT2:
-        bufferCount = 4;
-        break;
-    case GLTFAccessorType::MAT3:
-        bufferCount = 9;
-        break;
-    case GLTFAccessorType::MAT4:
-        bufferCount = 16;
-        break;
-    default:
+    int bufferCount = getAccessorTypeComponentCount(accessorType);
+    if (bufferCount == 0) {
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
         return false;
     }
 
+    size_t elementSize = sizeof(T) * bufferCount;
+    size_t stride = byteStride > 0 ? (size_t)byteStride : elementSize;
+    if (count < 0 || byteOffset < 0 ||
+        (count > 0 && (size_t)byteOffset + stride * (count - 1) + elementSize > (size_t)bin.size())) {
+        return false;
+    }
+    const char* source = bin.constData() + byteOffset;
+    int outputStart = outarray.size();
+
+    // glTF data is little endian like every platform we run on, so tightly packed values of the output type are copied as
+    // they are, and only the others are converted one by one
+    if (std::is_same<T, L>::value && !normalized && stride == elementSize) {
+        outarray.resize(outputStart + count * bufferCount);
+        memcpy(outarray.data() + outputStart, source, elementSize * count);
+        return true;
+    }
+
     float scale = 1.0f;  // Normalized output values should always be floats.
     if (normalized) {
         scale = (float)(std::numeric_limits<T>::max)();
     }
 
+    outarray.reserve(outputStart + count * bufferCount);
     for (int i = 0; i < count; ++i) {
+        const char* element = source + stride * i;
         for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                if (normalized) {
-                    outarray.push_back(std::max((float)value / scale, -1.0f));
-                } else {
-                    outarray.push_back(value);
-                }
+            T value;
+            memcpy(&value, element + sizeof(T) * j, sizeof(T));
+            if (normalized) {
+                outarray.push_back(std::max((float)value / scale, -1.0f));
             } else {
-                blobstream.setDevice(nullptr);
-                return false;
+                outarray.push_back(value);
             }
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                                 QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
 
     switch (componentType) {
     case GLTFAccessorComponentType::BYTE: {}
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     }
     return false;
@@ -1990,7 +2156,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, bufferview.byteStride, accessor.count, outarray, accessor.type,
                                  accessor.componentType, accessor.normalized);
     } else {
         for (int i = 0; i < accessor.count; ++i) {
@@ -2009,7 +2175,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
+            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset, 0,
                                      accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType, false);
             if (success) {
@@ -2020,7 +2186,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
+                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset, 0,
                                          accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType,
                                          accessor.normalized);
 
@@ -131,12 +131,29 @@ struct GLTFMeshPrimitiveAttr {
     }
 };
 
+// KHR_draco_mesh_compression, the attributes map the primitive's attributes to draco attribute IDs
+struct GLTFMeshPrimitiveDraco {
+    int bufferView;
+    GLTFMeshPrimitiveAttr attributes;
+    QMap<QString, bool> defined;
+    void dump() {
+        if (defined["bufferView"]) {
+            qCDebug(modelformat) << "bufferView: " << bufferView;
+        }
+        if (defined["attributes"]) {
+            qCDebug(modelformat) << "attributes: ";
+            attributes.dump();
+        }
+    }
+};
+
 struct GLTFMeshPrimitive {
     GLTFMeshPrimitiveAttr attributes;
     int indices;
     int material;
     int mode{ GLTFMeshPrimitivesRenderingMode::TRIANGLES };
     QVector<GLTFMeshPrimitiveAttr> targets;
+    GLTFMeshPrimitiveDraco draco;
     QMap<QString, bool> defined;
     void dump() {
         if (defined["attributes"]) {
@@ -156,6 +173,10 @@ struct GLTFMeshPrimitive {
             qCDebug(modelformat) << "targets: ";
             foreach(auto t, targets) t.dump();
         }
+        if (defined["draco"]) {
+            qCDebug(modelformat) << "draco: ";
+            draco.dump();
+        }
     }
 };
 
@@ -206,6 +227,7 @@ struct GLTFBufferView {
     int buffer; //required
     int byteLength; //required
     int byteOffset { 0 };
+    int byteStride { 0 };
     int target;
     QMap<QString, bool> defined;
     void dump() {
@@ -218,6 +240,9 @@ struct GLTFBufferView {
         if (defined["byteOffset"]) {
             qCDebug(modelformat) << "byteOffset: " << byteOffset;
         }
+        if (defined["byteStride"]) {
+            qCDebug(modelformat) << "byteStride: " << byteStride;
+        }
         if (defined["target"]) {
             qCDebug(modelformat) << "target: " << target;
         }
@@ -770,6 +795,7 @@ public:
 private:
     GLTFFile _file;
     hifi::URL _url;
+    // the BIN chunk of a GLB, not a copy but a view of the data given to read(), so only valid while reading
     hifi::ByteArray _glbBinary;
 
     glm::mat4 getModelTransform(const GLTFNode& node);
@@ -778,6 +804,8 @@ private:
 
     bool buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url);
     bool parseGLTF(const hifi::ByteArray& data);
+    void decodeDracoPrimitives();
+    int addDecodedBufferView(const hifi::ByteArray& blob);
 
     bool getStringVal(const QJsonObject& object, const QString& fieldname,
                       QString& value, QMap<QString, bool>&  defined);
@@ -831,11 +859,11 @@ private:
     bool readBinary(const QString& url, hifi::ByteArray& outdata);
 
     template<typename T, typename L>
-    bool readArray(const hifi::ByteArray& bin, int byteOffset, int count,
+    bool readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                    QVector<L>& outarray, int accessorType, bool normalized);
 
     template<typename T>
-    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
+    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                         QVector<T>& outarray, int accessorType, int componentType, bool normalized);
 
     template <typename T>
@@ -0,0 +1,112 @@
+//
+//  HFASerializer.cpp
+//  libraries/model-serializers/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFASerializer.h"
+
+#include <cstring>
+
+#include <QDataStream>
+
+#include <hfm/ModelFormatLogging.h>
+
+const char HFASerializer::MAGIC[4] = { 'H', 'F', 'A', '0' };
+const quint32 HFASerializer::VERSION = 1;
+
+static void readVec3(QDataStream& in, glm::vec3& value) {
+    in >> value.x >> value.y >> value.z;
+}
+
+static void readQuat(QDataStream& in, glm::quat& value) {
+    in >> value.x >> value.y >> value.z >> value.w;
+}
+
+static void readMat4(QDataStream& in, glm::mat4& value) {
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            in >> value[column][row];
+        }
+    }
+}
+
+MediaType HFASerializer::getMediaType() const {
+    MediaType mediaType("hfa");
+    mediaType.extensions.push_back("hfa");
+    mediaType.fileSignatures.emplace_back(std::string(MAGIC, sizeof(MAGIC)), 0);
+    return mediaType;
+}
+
+std::unique_ptr<hfm::Serializer::Factory> HFASerializer::getFactory() const {
+    return std::make_unique<hfm::Serializer::SimpleFactory<HFASerializer>>();
+}
+
+HFMModel::Pointer HFASerializer::read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url) {
+    QDataStream in(data);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    char magic[sizeof(MAGIC)];
+    quint32 version = 0;
+    if (in.readRawData(magic, sizeof(MAGIC)) != sizeof(MAGIC) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        qCWarning(modelformat) << "HFASerializer::read not a baked animation" << url;
+        return HFMModel::Pointer();
+    }
+    in >> version;
+    if (version != VERSION) {
+        qCWarning(modelformat) << "HFASerializer::read unsupported version" << version << url;
+        return HFMModel::Pointer();
+    }
+
+    auto hfmModel = std::make_shared<HFMModel>();
+    hfmModel->originalURL = url.toString();
+    readMat4(in, hfmModel->offset);
+
+    qint32 jointCount = 0;
+    in >> jointCount;
+    if (jointCount < 0) {
+        return HFMModel::Pointer();
+    }
+    hfmModel->joints.resize(jointCount);
+    for (int i = 0; i < jointCount; i++) {
+        auto& joint = hfmModel->joints[i];
+        qint32 parentIndex;
+        in >> joint.name >> parentIndex >> joint.isSkeletonJoint;
+        joint.parentIndex = parentIndex;
+        readVec3(in, joint.translation);
+        readMat4(in, joint.preTransform);
+        readQuat(in, joint.preRotation);
+        readQuat(in, joint.rotation);
+        readQuat(in, joint.postRotation);
+        readMat4(in, joint.postTransform);
+        hfmModel->jointIndices.insert(joint.name, i + 1);
+    }
+
+    qint32 rotationOffsetCount = 0;
+    in >> rotationOffsetCount;
+    for (int i = 0; i < rotationOffsetCount; i++) {
+        qint32 jointIndex;
+        glm::quat rotationOffset;
+        in >> jointIndex;
+        readQuat(in, rotationOffset);
+        hfmModel->jointRotationOffsets.insert(jointIndex, rotationOffset);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(modelformat) << "HFASerializer::read truncated joints" << url;
+        return HFMModel::Pointer();
+    }
+
+    hfmModel->compressedAnimation = hfm::CompressedAnimation::read(in);
+    if (!hfmModel->compressedAnimation || hfmModel->compressedAnimation->getJointCount() != jointCount) {
+        qCWarning(modelformat) << "HFASerializer::read invalid animation" << url;
+        return HFMModel::Pointer();
+    }
+    return hfmModel;
+}
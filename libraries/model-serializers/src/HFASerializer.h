@@ -0,0 +1,30 @@
+//
+//  HFASerializer.h
+//  libraries/model-serializers/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFASerializer_h
+#define hifi_HFASerializer_h
+
+#include <hfm/HFMSerializer.h>
+
+// A baked animation: the joints and the offset of the model it came from, then its hfm::CompressedAnimation.
+// The model read has the compressed animation instead of the animation frames.
+class HFASerializer : public HFMSerializer {
+public:
+    static const char MAGIC[4];
+    static const quint32 VERSION;
+
+    MediaType getMediaType() const override;
+    std::unique_ptr<hfm::Serializer::Factory> getFactory() const override;
+
+    HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
+};
+
+#endif // hifi_HFASerializer_h
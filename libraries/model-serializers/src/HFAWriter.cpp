@@ -0,0 +1,78 @@
+//
+//  HFAWriter.cpp
+//  libraries/model-serializers/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFAWriter.h"
+
+#include <QDataStream>
+
+#include <GLMHelpers.h>
+
+#include "HFASerializer.h"
+
+const float HFAWriter::DEFAULT_TRANSLATION_TOLERANCE = 0.0005f;
+
+static void writeVec3(QDataStream& out, const glm::vec3& value) {
+    out << value.x << value.y << value.z;
+}
+
+static void writeQuat(QDataStream& out, const glm::quat& value) {
+    out << value.x << value.y << value.z << value.w;
+}
+
+static void writeMat4(QDataStream& out, const glm::mat4& value) {
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            out << value[column][row];
+        }
+    }
+}
+
+QByteArray HFAWriter::encodeHFA(const HFMModel& hfmModel, float rotationTolerance, float translationTolerance) {
+    // the translations are in the units of the model
+    const float EPSILON = 0.0001f;
+    float unitScale = extractScale(hfmModel.offset).y;
+    if (unitScale > EPSILON) {
+        translationTolerance /= unitScale;
+    }
+    auto compressedAnimation = hfm::CompressedAnimation::compress(hfmModel.animationFrames, rotationTolerance, translationTolerance);
+    if (!compressedAnimation || compressedAnimation->getJointCount() != hfmModel.joints.size()) {
+        return QByteArray();
+    }
+
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    out.writeRawData(HFASerializer::MAGIC, sizeof(HFASerializer::MAGIC));
+    out << HFASerializer::VERSION;
+    writeMat4(out, hfmModel.offset);
+
+    out << (qint32)hfmModel.joints.size();
+    for (const auto& joint : hfmModel.joints) {
+        out << joint.name << (qint32)joint.parentIndex << joint.isSkeletonJoint;
+        writeVec3(out, joint.translation);
+        writeMat4(out, joint.preTransform);
+        writeQuat(out, joint.preRotation);
+        writeQuat(out, joint.rotation);
+        writeQuat(out, joint.postRotation);
+        writeMat4(out, joint.postTransform);
+    }
+
+    out << (qint32)hfmModel.jointRotationOffsets.size();
+    for (auto it = hfmModel.jointRotationOffsets.cbegin(); it != hfmModel.jointRotationOffsets.cend(); ++it) {
+        out << (qint32)it.key();
+        writeQuat(out, it.value());
+    }
+
+    compressedAnimation->write(out);
+    return data;
+}
@@ -0,0 +1,31 @@
+//
+//  HFAWriter.h
+//  libraries/model-serializers/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFAWriter_h
+#define hifi_HFAWriter_h
+
+#include <QByteArray>
+
+#include <hfm/HFM.h>
+
+class HFAWriter {
+public:
+    // The largest error of the translations, in meters
+    static const float DEFAULT_TRANSLATION_TOLERANCE;
+
+    // The animation frames of the model compressed, along with its joints, see HFASerializer.
+    // Returns an empty array if the model has no animation or too many frames.
+    static QByteArray encodeHFA(const HFMModel& hfmModel,
+                                float rotationTolerance = hfm::CompressedAnimation::DEFAULT_ROTATION_TOLERANCE,
+                                float translationTolerance = DEFAULT_TRANSLATION_TOLERANCE);
+};
+
+#endif // hifi_HFAWriter_h
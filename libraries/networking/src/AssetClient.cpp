@@ -14,10 +14,13 @@
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QRegExp>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
 #include <QtScript/QScriptEngine>
-#include <QtNetwork/QNetworkDiskCache>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
 
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
@@ -25,6 +28,7 @@
 #include "AssetRequest.h"
 #include "AssetUpload.h"
 #include "AssetUtils.h"
+#include "ContentNetworkCache.h"
 #include "MappingRequest.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
@@ -51,10 +55,37 @@ AssetClient::AssetClient() {
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetReply), true);
     packetReceiver.registerListener(PacketType::AssetUploadReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadReply));
+    packetReceiver.registerListener(PacketType::AssetUploadChunksReply,
+        PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadChunksReply));
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
             this, &AssetClient::handleNodeClientConnectionReset);
+
+    if (DependencyManager::isSet<NodeList>()) {
+        auto& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
+        connect(&domainHandler, &DomainHandler::settingsReceived, this, &AssetClient::handleDomainSettingsReceived);
+        connect(&domainHandler, &DomainHandler::disconnectedFromDomain, this, &AssetClient::handleDisconnectedFromDomain);
+    }
+}
+
+void AssetClient::handleDomainSettingsReceived(const QJsonObject& domainSettingsObject) {
+    static const QString ASSET_SERVER_SETTINGS_KEY = "asset_server";
+    static const QString HTTP_URL_OPTION = "http_url";
+
+    QUrl httpAssetURL { domainSettingsObject[ASSET_SERVER_SETTINGS_KEY].toObject()[HTTP_URL_OPTION].toString() };
+    if (httpAssetURL.isValid() && (httpAssetURL.scheme() == "http" || httpAssetURL.scheme() == "https")) {
+        if (httpAssetURL != _httpAssetURL) {
+            qCDebug(asset_client) << "Fetching assets over HTTP from" << httpAssetURL;
+        }
+        _httpAssetURL = httpAssetURL;
+    } else {
+        _httpAssetURL.clear();
+    }
+}
+
+void AssetClient::handleDisconnectedFromDomain() {
+    _httpAssetURL.clear();
 }
 
 void AssetClient::initCaching() {
@@ -71,14 +102,13 @@ void AssetClient::initCaching() {
 #endif
             _cacheDir = !cachePath.isEmpty() ? cachePath : "interfaceCache";
         }
-        QNetworkDiskCache* cache = new QNetworkDiskCache();
-        cache->setMaximumCacheSize(MAXIMUM_CACHE_SIZE);
-        cache->setCacheDirectory(_cacheDir);
+        static const QString CONTENT_CACHE_DIRECTORY = "contentCache";
+        auto cache = new ContentNetworkCache(QDir(_cacheDir).filePath(CONTENT_CACHE_DIRECTORY), MAXIMUM_CACHE_SIZE);
         networkAccessManager.setCache(cache);
-        qInfo() << "ResourceManager disk cache setup at" << _cacheDir
+        qInfo() << "ResourceManager disk cache setup at" << cache->cacheDirectory()
                  << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
     } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache());
+        auto cache = qobject_cast<ContentNetworkCache*>(networkAccessManager.cache());
         qInfo() << "ResourceManager disk cache already setup at" << cache->cacheDirectory()
                 << "(size:" << cache->maximumCacheSize() / BYTES_PER_GIGABYTES << "GB)";
     }
@@ -103,7 +133,7 @@ MiniPromise::Promise AssetClient::cacheInfoRequestAsync(MiniPromise::Promise def
     if (QThread::currentThread() != thread()) {
         QMetaObject::invokeMethod(this, "cacheInfoRequestAsync", Q_ARG(MiniPromise::Promise, deferred));
     } else {
-        auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+        auto cache = qobject_cast<ContentNetworkCache*>(NetworkAccessManager::getInstance().cache());
         if (cache) {
             deferred->resolve({
                 { "cacheDirectory", cache->cacheDirectory() },
@@ -296,7 +326,7 @@ void AssetClient::cacheInfoRequest(QObject* reciever, QString slot) {
     }
 
 
-    if (auto* cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache())) {
+    if (auto* cache = qobject_cast<ContentNetworkCache*>(NetworkAccessManager::getInstance().cache())) {
         QMetaObject::invokeMethod(reciever, slot.toStdString().data(), Qt::QueuedConnection,
                                   Q_ARG(QString, cache->cacheDirectory()),
                                   Q_ARG(qint64, cache->cacheSize()),
@@ -444,13 +474,28 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
         return false;
     }
 
+    auto messageID = ++_currentID;
+
+    if (_httpAssetURL.isValid()) {
+        requestAssetOverHTTP(messageID, hash, start, end, callback, progressCallback);
+        return messageID;
+    }
+
+    if (requestAssetOverATP(messageID, hash, start, end, callback, progressCallback)) {
+        return messageID;
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+    return INVALID_MESSAGE_ID;
+}
+
+bool AssetClient::requestAssetOverATP(MessageID messageID, const QString& hash, AssetUtils::DataOffset start,
+                                      AssetUtils::DataOffset end, ReceivedAssetCallback callback,
+                                      ProgressCallback progressCallback) {
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
     if (assetServer) {
-
-        auto messageID = ++_currentID;
-
         auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(start) + sizeof(end);
         auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
 
@@ -466,12 +511,70 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
         if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
             _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
 
-            return messageID;
+            return true;
         }
     }
+    return false;
+}
 
-    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
-    return INVALID_MESSAGE_ID;
+void AssetClient::requestAssetOverHTTP(MessageID messageID, const QString& hash, AssetUtils::DataOffset start,
+                                       AssetUtils::DataOffset end, ReceivedAssetCallback callback,
+                                       ProgressCallback progressCallback) {
+    QUrl url = _httpAssetURL;
+    url.setPath(url.path().remove(QRegExp("/+$")) + "/hash/" + hash);
+
+    QNetworkRequest request { url };
+    request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    // AssetRequest caches what it gets by its atp: URL
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+
+    // the same ranges as AssetGet: start inclusive, end exclusive, a negative start counting back from the end
+    bool isRange = start != 0 || end != 0;
+    if (start < 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(start));
+    } else if (isRange && end == 0) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(start) + "-");
+    } else if (isRange) {
+        request.setRawHeader("Range", "bytes=" + QByteArray::number(start) + "-" + QByteArray::number(end - 1));
+    }
+
+    qCDebug(asset_client) << "Requesting data from" << start << "to" << end << "of" << hash << "from" << url;
+
+    QNetworkReply* reply = NetworkAccessManager::getInstance().get(request);
+    _pendingHTTPRequests[messageID] = reply;
+
+    connect(reply, &QNetworkReply::downloadProgress, this, [progressCallback](qint64 bytesReceived, qint64 bytesTotal) {
+        progressCallback(bytesReceived, bytesTotal);
+    });
+    connect(reply, &QNetworkReply::finished, this,
+            [this, reply, messageID, hash, start, end, isRange, callback, progressCallback] {
+        reply->deleteLater();
+        if (_pendingHTTPRequests.erase(messageID) == 0) {
+            return; // cancelled
+        }
+
+        const int HTTP_STATUS_OK = 200;
+        const int HTTP_STATUS_PARTIAL_CONTENT = 206;
+        const int HTTP_STATUS_NOT_FOUND = 404;
+        const int HTTP_STATUS_RANGE_NOT_SATISFIABLE = 416;
+        int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+        if (reply->error() == QNetworkReply::NoError
+            && (status == HTTP_STATUS_PARTIAL_CONTENT || (status == HTTP_STATUS_OK && !isRange))) {
+            callback(true, AssetUtils::AssetServerError::NoError, reply->readAll());
+        } else if (status == HTTP_STATUS_NOT_FOUND) {
+            callback(true, AssetUtils::AssetServerError::AssetNotFound, QByteArray());
+        } else if (status == HTTP_STATUS_RANGE_NOT_SATISFIABLE) {
+            callback(true, AssetUtils::AssetServerError::InvalidByteRange, QByteArray());
+        } else {
+            // the HTTP endpoint or the CDN in front of it isn't working, the asset-server itself may still be
+            qCWarning(asset_client) << "Failed to get" << hash << "over HTTP:" << status << reply->errorString()
+                << "- requesting it from the asset-server";
+            if (!requestAssetOverATP(messageID, hash, start, end, callback, progressCallback)) {
+                callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+            }
+        }
+    });
 }
 
 MessageID AssetClient::getAssetInfo(const QString& hash, GetInfoCallback callback) {
@@ -578,16 +681,22 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     callbacks.message = message;
 
 
-    auto weakNode = senderNode.toWeakRef();
-    connect(message.data(), &ReceivedMessage::progress, this, [this, weakNode, messageID, length](qint64 size) {
-        handleProgressCallback(weakNode, messageID, size, length);
-    });
-    connect(message.data(), &ReceivedMessage::completed, this, [this, weakNode, messageID, length]() {
-        handleCompleteCallback(weakNode, messageID, length);
-    });
+    // only a message that was incomplete when it arrived signals its progress
+    auto notifier = message->getNotifier();
+    if (notifier) {
+        auto weakNode = senderNode.toWeakRef();
+        connect(notifier, &ReceivedMessageNotifier::progress, this, [this, weakNode, messageID, length](qint64 size) {
+            handleProgressCallback(weakNode, messageID, size, length);
+        });
+        connect(notifier, &ReceivedMessageNotifier::completed, this, [this, weakNode, messageID, length]() {
+            handleCompleteCallback(weakNode, messageID, length);
+        });
+    }
 
     if (message->isComplete()) {
-        disconnect(message.data(), nullptr, this, nullptr);
+        if (notifier) {
+            disconnect(notifier, nullptr, this, nullptr);
+        }
 
         if (length != message->getBytesLeftToRead()) {
             callbacks.completeCallback(false, error, QByteArray());
@@ -866,6 +975,14 @@ bool AssetClient::cancelGetAssetInfoRequest(MessageID id) {
 bool AssetClient::cancelGetAssetRequest(MessageID id) {
     Q_ASSERT(QThread::currentThread() == thread());
 
+    auto httpRequestIt = _pendingHTTPRequests.find(id);
+    if (httpRequestIt != _pendingHTTPRequests.end()) {
+        QNetworkReply* reply = httpRequestIt->second;
+        _pendingHTTPRequests.erase(httpRequestIt);
+        reply->abort();
+        return true;
+    }
+
     // Search through each pending mapping request for id `id`
     for (auto& kv : _pendingRequests) {
         auto& messageCallbackMap = kv.second;
@@ -873,9 +990,9 @@ bool AssetClient::cancelGetAssetRequest(MessageID id) {
         if (requestIt != messageCallbackMap.end()) {
 
             auto& message = requestIt->second.message;
-            if (message) {
+            if (message && message->getNotifier()) {
                 // disconnect from all signals emitting from the pending message
-                disconnect(message.data(), nullptr, this, nullptr);
+                disconnect(message->getNotifier(), nullptr, this, nullptr);
             }
 
             messageCallbackMap.erase(requestIt);
@@ -895,6 +1012,11 @@ bool AssetClient::cancelUploadAssetRequest(MessageID id) {
             return true;
         }
     }
+    for (auto& kv : _pendingChunkedUploads) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -965,6 +1087,122 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     }
 }
 
+MessageID AssetClient::uploadAssetInChunks(const QByteArray& data, UploadResultCallback callback) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    if (assetServer) {
+        ChunkedUploadData upload;
+        upload.data = data;
+        upload.fileHash = AssetUtils::hashData(data);
+        upload.chunks = AssetUtils::chunkData(data.constData(), data.size());
+        upload.callback = callback;
+
+        auto messageID = ++_currentID;
+        if (sendAssetChunks(assetServer, messageID, upload, {})) {
+            _pendingChunkedUploads[assetServer][messageID] = std::move(upload);
+            return messageID;
+        }
+    }
+
+    callback(false, AssetUtils::AssetServerError::NoError, QString());
+    return INVALID_MESSAGE_ID;
+}
+
+bool AssetClient::sendAssetChunks(const SharedNodePointer& assetServer, MessageID messageID, const ChunkedUploadData& upload,
+                                  const std::vector<uint32_t>& chunksToSend) {
+    auto packetList = NLPacketList::create(PacketType::AssetUploadChunks, QByteArray(), true, true);
+
+    // the first message only asks which chunks are missing, the second sends them
+    auto operation = upload.isSendingChunks ? AssetUtils::UploadMissingChunks : AssetUtils::QueryMissingChunks;
+    packetList->writePrimitive(messageID);
+    packetList->writePrimitive(operation);
+    packetList->write(upload.fileHash);
+    packetList->writePrimitive((uint64_t)upload.data.size());
+
+    packetList->writePrimitive((uint32_t)upload.chunks.size());
+    for (const auto& chunk : upload.chunks) {
+        packetList->write(chunk.hash);
+        packetList->writePrimitive(chunk.size);
+    }
+
+    if (upload.isSendingChunks) {
+        packetList->writePrimitive((uint32_t)chunksToSend.size());
+        for (auto index : chunksToSend) {
+            const auto& chunk = upload.chunks[index];
+            packetList->writePrimitive(index);
+            packetList->write(upload.data.constData() + chunk.offset, chunk.size);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+}
+
+void AssetClient::handleAssetUploadChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    auto messageMapIt = _pendingChunkedUploads.find(senderNode);
+    if (messageMapIt == _pendingChunkedUploads.end()) {
+        return;
+    }
+    auto& messageCallbackMap = messageMapIt->second;
+    auto requestIt = messageCallbackMap.find(messageID);
+    if (requestIt == messageCallbackMap.end()) {
+        return;
+    }
+    auto& upload = requestIt->second;
+
+    if (!error && !upload.isSendingChunks) {
+        // the server answered which chunks it's missing, send those
+        uint32_t numMissingChunks = 0;
+        message->readPrimitive(&numMissingChunks);
+        std::vector<uint32_t> missingChunks;
+        missingChunks.reserve(numMissingChunks);
+        for (uint32_t i = 0; i < numMissingChunks; ++i) {
+            uint32_t index;
+            if (message->readPrimitive(&index) != sizeof(index) || index >= upload.chunks.size()) {
+                error = AssetUtils::AssetServerError::FileOperationFailed;
+                break;
+            }
+            missingChunks.push_back(index);
+        }
+
+        if (!error) {
+            qCDebug(asset_client) << "Uploading" << missingChunks.size() << "of" << upload.chunks.size()
+                << "chunks the asset server doesn't have";
+            upload.isSendingChunks = true;
+            if (sendAssetChunks(senderNode, messageID, upload, missingChunks)) {
+                return;
+            }
+            auto callback = upload.callback;
+            messageCallbackMap.erase(requestIt);
+            callback(false, AssetUtils::AssetServerError::NoError, QString());
+            return;
+        }
+    }
+
+    QString hashString;
+    if (error) {
+        qCWarning(asset_client) << "Error uploading file to asset server in chunks";
+    } else {
+        hashString = message->read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+        qCDebug(asset_client) << "Successfully uploaded asset to asset-server in chunks - SHA256 hash is " << hashString;
+    }
+
+    auto callback = upload.callback;
+    messageCallbackMap.erase(requestIt);
+    callback(true, error, hashString);
+}
+
 void AssetClient::handleNodeKilled(SharedNodePointer node) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -983,6 +1221,17 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    {
+        auto messageMapIt = _pendingChunkedUploads.find(node);
+        if (messageMapIt != _pendingChunkedUploads.end()) {
+            auto uploads = std::move(messageMapIt->second);
+            messageMapIt->second.clear();
+            for (const auto& value : uploads) {
+                value.second.callback(false, AssetUtils::AssetServerError::NoError, "");
+            }
+        }
+    }
 }
 
 void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
@@ -1005,9 +1254,9 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
         if (messageMapIt != _pendingRequests.end()) {
             for (const auto& value : messageMapIt->second) {
                 auto& message = value.second.message;
-                if (message) {
+                if (message && message->getNotifier()) {
                     // Disconnect from all signals emitting from the pending message
-                    disconnect(message.data(), nullptr, this, nullptr);
+                    disconnect(message->getNotifier(), nullptr, this, nullptr);
                 }
 
                 value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
@@ -15,9 +15,12 @@
 #include <QStandardItemModel>
 #include <QtQml/QJSEngine>
 #include <QString>
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
 
 #include <map>
+#include <vector>
 
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
@@ -37,6 +40,7 @@ class RenameMappingRequest;
 class SetBakingEnabledRequest;
 class AssetRequest;
 class AssetUpload;
+class QNetworkReply;
 
 struct AssetInfo {
     QString hash;
@@ -79,10 +83,14 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadChunksReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
 
+    void handleDomainSettingsReceived(const QJsonObject& domainSettingsObject);
+    void handleDisconnectedFromDomain();
+
 private:
     MessageID getAssetMapping(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
     MessageID getAllAssetMappings(MappingOperationCallback callback);
@@ -95,6 +103,14 @@ private:
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
+    // Uploads the data as content-defined chunks, first asking the asset server which chunks none of its files has,
+    // then sending only those. The server puts the file together and checks it against its hash.
+    MessageID uploadAssetInChunks(const QByteArray& data, UploadResultCallback callback);
+
+    bool requestAssetOverATP(MessageID messageID, const QString& hash, AssetUtils::DataOffset start,
+                             AssetUtils::DataOffset end, ReceivedAssetCallback callback, ProgressCallback progressCallback);
+    void requestAssetOverHTTP(MessageID messageID, const QString& hash, AssetUtils::DataOffset start,
+                              AssetUtils::DataOffset end, ReceivedAssetCallback callback, ProgressCallback progressCallback);
 
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
@@ -106,6 +122,17 @@ private:
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    struct ChunkedUploadData {
+        QByteArray data;
+        QByteArray fileHash;
+        std::vector<AssetUtils::DataChunk> chunks;
+        UploadResultCallback callback;
+        bool isSendingChunks { false };
+    };
+
+    bool sendAssetChunks(const SharedNodePointer& assetServer, MessageID messageID, const ChunkedUploadData& upload,
+                         const std::vector<uint32_t>& chunksToSend);
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
@@ -117,6 +144,11 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, ChunkedUploadData>> _pendingChunkedUploads;
+    std::unordered_map<MessageID, QNetworkReply*> _pendingHTTPRequests;
+
+    // where the domain says its asset files can be fetched over HTTP(S), empty if it doesn't
+    QUrl _httpAssetURL;
 
     QString _cacheDir;
 
@@ -12,6 +12,7 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QThread>
 
@@ -25,6 +26,11 @@
 
 static int requestID = 0;
 
+// the last part, asked for before the asset's size is known, is all of any asset up to this size
+static const int64_t LAST_PART_SIZE = 1024 * 1024;
+static const int64_t MIN_PART_SIZE = 1024 * 1024;
+static const int64_t MAX_NUM_PARALLEL_PARTS = 4;
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -34,10 +40,7 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
 }
 
 AssetRequest::~AssetRequest() {
-    auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelPendingRequests();
 }
 
 void AssetRequest::start() {
@@ -75,64 +78,248 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestPart(_byteRange);
+        return;
+    }
+
+    // the size and the last part at once, so a small asset takes no longer than asking for all of it
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
-    auto hash = _hash;
+    auto messageID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+        handleAssetInfoReply(responseReceived, serverError, info);
+    });
+    // unless it couldn't be sent, and the asset is already being asked for in one part
+    if (_state == WaitingForData && _parts.empty()) {
+        _assetInfoRequestID = messageID;
+        requestPart({ -LAST_PART_SIZE, 0 });
+    }
+}
+
+AssetRequest::Error AssetRequest::getError(bool responseReceived, AssetUtils::AssetServerError serverError) {
+    if (!responseReceived) {
+        return NetworkError;
+    }
+    switch (serverError) {
+        case AssetUtils::AssetServerError::NoError:
+            return NoError;
+        case AssetUtils::AssetServerError::AssetNotFound:
+            return NotFound;
+        case AssetUtils::AssetServerError::InvalidByteRange:
+            return InvalidByteRange;
+        case AssetUtils::AssetServerError::ServerBusy:
+            // retried later like any other network error
+            return NetworkError;
+        default:
+            return UnknownError;
+    }
+}
+
+void AssetRequest::requestPart(const ByteRange& byteRange) {
+    size_t index = _parts.size();
+    _parts.push_back({ byteRange });
 
-    _assetRequestID = assetClient->getAsset(_hash, _byteRange.fromInclusive, _byteRange.toExclusive,
-        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto hash = _hash;
 
+    auto messageID = assetClient->getAsset(_hash, byteRange.fromInclusive, byteRange.toExclusive,
+        [this, that, hash, index](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
         if (!that) {
-            qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
+            qCWarning(asset_client) << "Got reply for dead asset request " << hash;
             // If the request is dead, return
             return;
         }
-        _assetRequestID = INVALID_MESSAGE_ID;
-
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
-        } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
-
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
-
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
-            }
-        }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
-        }
-        
-        _state = Finished;
-        emit finished(this);
-    }, [this, that](qint64 totalReceived, qint64 total) {
+        handlePartReply(index, responseReceived, serverError, data);
+    }, [this, that, index](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
             return;
         }
-        emit progress(totalReceived, total);
+        if (_byteRange.isSet()) {
+            emit progress(totalReceived, total);
+            return;
+        }
+        _parts[index].received = totalReceived;
+        emitPartsProgress();
     });
+
+    // a request that can't be sent is finished before it returns
+    if (_state == WaitingForData && index < _parts.size() && !_parts[index].isFinished) {
+        _parts[index].messageID = messageID;
+    }
+}
+
+void AssetRequest::handlePartReply(size_t index, bool responseReceived, AssetUtils::AssetServerError serverError,
+                                   const QByteArray& data) {
+    if (_state != WaitingForData || index >= _parts.size()) {
+        return;
+    }
+    Part& part = _parts[index];
+    part.messageID = INVALID_MESSAGE_ID;
+    part.isFinished = true;
+
+    Error error = getError(responseReceived, serverError);
+    if (error != NoError) {
+        finish(error);
+        return;
+    }
+
+    if (_byteRange.isSet()) {
+        _data = data;
+        _totalReceived += data.size();
+        emit progress(_totalReceived, data.size());
+        finish(NoError);
+        return;
+    }
+
+    part.received = data.size();
+    if (!part.byteRange.isSet()) {
+        _assetSize = data.size();
+        _data = data;
+        finishIfComplete();
+        return;
+    } else if (part.byteRange.fromInclusive < 0) {
+        // the last part is the whole asset when there's less of it than was asked for
+        if (data.size() < -part.byteRange.fromInclusive || _assetSize == data.size()) {
+            _assetSize = data.size();
+            _data = data;
+            finishIfComplete();
+            return;
+        }
+        if (_assetSize < 0) {
+            part.data = data;
+            return;
+        }
+        memcpy(_data.data() + _assetSize - data.size(), data.constData(), data.size());
+    } else if (data.size() == part.byteRange.size() && part.byteRange.toExclusive <= _data.size()) {
+        memcpy(_data.data() + part.byteRange.fromInclusive, data.constData(), data.size());
+    } else {
+        finish(SizeVerificationFailed);
+        return;
+    }
+    emitPartsProgress();
+    finishIfComplete();
+}
+
+void AssetRequest::handleAssetInfoReply(bool responseReceived, AssetUtils::AssetServerError serverError,
+                                        const AssetInfo& info) {
+    if (_state != WaitingForData || _assetSize >= 0) {
+        // the last part already turned out to be all of it
+        return;
+    }
+
+    Error error = getError(responseReceived, serverError);
+    if (error == NotFound) {
+        finish(error);
+        return;
+    }
+    if (error != NoError || info.size < 0) {
+        // the last part may still be all of it, or else the whole asset is asked for in one go
+        qCDebug(asset_client) << "Couldn't get the size of" << _hash << "- requesting it in one part";
+        cancelPendingRequests();
+        _parts.clear();
+        requestPart(ByteRange());
+        return;
+    }
+
+    _assetSize = info.size;
+    requestRemainingParts();
+}
+
+void AssetRequest::requestRemainingParts() {
+    // the last part is done with the asset's size, the rest is split between parts asked for at once
+    _data = QByteArray((int)_assetSize, Qt::Uninitialized);
+
+    int64_t lastPartSize = std::min(_assetSize, LAST_PART_SIZE);
+    for (auto& part : _parts) {
+        if (part.isFinished && !part.data.isNull()) {
+            memcpy(_data.data() + _assetSize - part.data.size(), part.data.constData(), part.data.size());
+            part.data = QByteArray();
+        }
+    }
+
+    int64_t remaining = _assetSize - lastPartSize;
+    if (remaining > 0) {
+        int64_t numParts = std::min(MAX_NUM_PARALLEL_PARTS, std::max<int64_t>(1, remaining / MIN_PART_SIZE));
+        int64_t partSize = (remaining + numParts - 1) / numParts;
+        for (int64_t from = 0; from < remaining && _state == WaitingForData; from += partSize) {
+            requestPart({ from, std::min(from + partSize, remaining) });
+        }
+
+        qCDebug(asset_client) << "Requesting" << _hash << "in" << _parts.size() << "parts";
+    }
+    finishIfComplete();
+}
+
+void AssetRequest::emitPartsProgress() {
+    qint64 totalReceived = 0;
+    qint64 total = 0;
+    for (const auto& part : _parts) {
+        totalReceived += part.received;
+        total += part.byteRange.fromInclusive < 0 ? -part.byteRange.fromInclusive : part.byteRange.size();
+    }
+    if (_assetSize >= 0) {
+        total = _assetSize;
+    }
+    _totalReceived = totalReceived;
+    emit progress(totalReceived, total);
+}
+
+void AssetRequest::finishIfComplete() {
+    if (_state != WaitingForData || _assetSize < 0) {
+        return;
+    }
+    for (const auto& part : _parts) {
+        if (!part.isFinished) {
+            return;
+        }
+    }
+
+    if (AssetUtils::hashData(_data).toHex() != _hash) {
+        // the hash of the received data does not match what we expect, so we return an error
+        finish(HashVerificationFailed);
+        return;
+    }
+
+    _totalReceived = _data.size();
+    emit progress(_totalReceived, _data.size());
+    AssetUtils::saveToCache(getUrl(), _data);
+    finish(NoError);
+}
+
+void AssetRequest::finish(Error error) {
+    _error = error;
+    cancelPendingRequests();
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        _data = QByteArray();
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelPendingRequests() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (!assetClient) {
+        return;
+    }
+    if (_assetInfoRequestID != INVALID_MESSAGE_ID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+    }
+    for (auto& part : _parts) {
+        if (part.messageID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(part.messageID);
+            part.messageID = INVALID_MESSAGE_ID;
+        }
+    }
 }
 
 
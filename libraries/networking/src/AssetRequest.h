@@ -12,6 +12,8 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,14 +64,39 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    // A whole asset is fetched as byte ranges at the same time, so one slow stream doesn't hold up the rest. The
+    // last part is asked for straight away along with the asset's size, and is all of it when the asset is small.
+    struct Part {
+        ByteRange byteRange;
+        MessageID messageID { INVALID_MESSAGE_ID };
+        qint64 received { 0 };
+        bool isFinished { false };
+        // only kept for the last part, when it arrives before the asset's size is known
+        QByteArray data;
+    };
+
+    static Error getError(bool responseReceived, AssetUtils::AssetServerError serverError);
+
+    void requestPart(const ByteRange& byteRange);
+    void handlePartReply(size_t index, bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data);
+    void handleAssetInfoReply(bool responseReceived, AssetUtils::AssetServerError serverError, const AssetInfo& info);
+    // the asset's size is known, so the buffer can be allocated and the rest of the parts asked for
+    void requestRemainingParts();
+    void emitPartsProgress();
+    void finishIfComplete();
+    void finish(Error error);
+    void cancelPendingRequests();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
     uint64_t _totalReceived { 0 };
     QString _hash;
     QByteArray _data;
-    int _numPendingRequests { 0 };
-    MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    std::vector<Part> _parts;
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    // -1 until the asset-server says
+    int64_t _assetSize { -1 };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
@@ -81,33 +81,58 @@ void AssetUpload::start() {
         qCDebug(asset_client) << "Attempting to upload" << _filename << "to asset-server.";
     }
     
-    assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash){
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else {
-            switch (error) {
-                case AssetUtils::AssetServerError::NoError:
-                    _error = NoError;
-                    break;
-                case AssetUtils::AssetServerError::AssetTooLarge:
-                    _error = TooLarge;
-                    break;
-                case AssetUtils::AssetServerError::PermissionDenied:
-                    _error = PermissionDenied;
-                    break;
-                case AssetUtils::AssetServerError::FileOperationFailed:
-                    _error = ServerFileError;
-                    break;
-                default:
-                    _error = FileOpenError;
-                    break;
+    if ((uint64_t)_data.size() >= AssetUtils::MIN_CHUNKED_UPLOAD_SIZE) {
+        assetClient->uploadAssetInChunks(_data, [this](bool responseReceived, AssetUtils::AssetServerError error,
+                                                       const QString& hash) {
+            // the chunks the server said it had may have been deleted since, send the whole file then
+            if (responseReceived && error == AssetUtils::AssetServerError::FileOperationFailed) {
+                qCDebug(asset_client) << "Chunked upload failed, uploading the whole file";
+                DependencyManager::get<AssetClient>()->uploadAsset(_data, [this](bool responseReceived,
+                                                                                 AssetUtils::AssetServerError error,
+                                                                                 const QString& hash) {
+                    handleUploadResult(responseReceived, error, hash);
+                });
+                return;
             }
+            handleUploadResult(responseReceived, error, hash);
+        });
+    } else {
+        assetClient->uploadAsset(_data, [this](bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+            handleUploadResult(responseReceived, error, hash);
+        });
+    }
+}
+
+void AssetUpload::handleUploadResult(bool responseReceived, AssetUtils::AssetServerError error, const QString& hash) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else {
+        switch (error) {
+            case AssetUtils::AssetServerError::NoError:
+                _error = NoError;
+                break;
+            case AssetUtils::AssetServerError::AssetTooLarge:
+                _error = TooLarge;
+                break;
+            case AssetUtils::AssetServerError::PermissionDenied:
+                _error = PermissionDenied;
+                break;
+            case AssetUtils::AssetServerError::FileOperationFailed:
+                _error = ServerFileError;
+                break;
+            case AssetUtils::AssetServerError::ServerBusy:
+                // nothing wrong with the upload, it can be tried again
+                _error = NetworkError;
+                break;
+            default:
+                _error = FileOpenError;
+                break;
         }
-        
-        if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
-            AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
-        }
-        
-        emit finished(this, hash);
-    });
+    }
+
+    if (_error == NoError && hash == AssetUtils::hashData(_data).toHex()) {
+        AssetUtils::saveToCache(AssetUtils::getATPUrl(hash), _data);
+    }
+
+    emit finished(this, hash);
 }
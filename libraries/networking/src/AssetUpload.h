@@ -18,6 +18,8 @@
 
 #include <cstdint>
 
+#include "AssetUtils.h"
+
 // You should be able to upload an asset from any thread, and handle the responses in a safe way
 // on your own thread. Everything should happen on AssetClient's thread, the caller should
 // receive events by connecting to signals on an object that lives on AssetClient's threads.
@@ -52,6 +54,8 @@ signals:
     void progress(uint64_t totalReceived, uint64_t total);
     
 private:
+    void handleUploadResult(bool responseReceived, AssetUtils::AssetServerError error, const QString& hash);
+
     QString _filename;
     QByteArray _data;
     Error _error;
@@ -11,6 +11,7 @@
 
 #include "AssetUtils.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <QtCore/QCryptographicHash>
@@ -63,6 +64,56 @@ QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
 
+namespace {
+    // The chunks are between 16 and 256 KB, and about 80 KB on average
+    const size_t MIN_CHUNK_SIZE = 16 * 1024;
+    const size_t MAX_CHUNK_SIZE = 256 * 1024;
+    const uint64_t CHUNK_BOUNDARY_MASK = 0xFFFFull << 48;
+
+    // the table of the gear rolling hash, the values only have to look random and never change
+    struct GearTable {
+        uint64_t values[256];
+
+        GearTable() {
+            uint64_t state = 0x9E3779B97F4A7C15ull;
+            for (auto& value : values) {
+                // splitmix64
+                state += 0x9E3779B97F4A7C15ull;
+                uint64_t z = state;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                value = z ^ (z >> 31);
+            }
+        }
+    };
+}
+
+std::vector<DataChunk> chunkData(const char* data, size_t size) {
+    static const GearTable GEAR;
+
+    std::vector<DataChunk> chunks;
+    size_t start = 0;
+    while (start < size) {
+        size_t end = std::min(size, start + MAX_CHUNK_SIZE);
+        size_t cut = end;
+
+        // the hash only depends on the last 64 bytes, so the cuts follow the content wherever it moves to
+        uint64_t hash = 0;
+        for (size_t i = start + MIN_CHUNK_SIZE; i < end; ++i) {
+            hash = (hash << 1) + GEAR.values[(uint8_t)data[i]];
+            if ((hash & CHUNK_BOUNDARY_MASK) == 0) {
+                cut = i + 1;
+                break;
+            }
+        }
+
+        auto chunkSize = (uint32_t)(cut - start);
+        chunks.push_back({ hashData(QByteArray::fromRawData(data + start, chunkSize)), start, chunkSize });
+        start = cut;
+    }
+    return chunks;
+}
+
 QByteArray loadFromCache(const QUrl& url) {
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
 
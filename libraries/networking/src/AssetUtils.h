@@ -15,6 +15,7 @@
 #include <cstdint>
 
 #include <map>
+#include <vector>
 
 #include <QtCore/QByteArray>
 #include <QtCore/QUrl>
@@ -46,7 +47,8 @@ enum AssetServerError : uint8_t {
     MappingOperationFailed,
     FileOperationFailed,
     NoAssetServer,
-    LostConnection
+    LostConnection,
+    ServerBusy
 };
 
 enum AssetMappingOperationType : uint8_t {
@@ -58,6 +60,11 @@ enum AssetMappingOperationType : uint8_t {
     SetBakingEnabled
 };
 
+enum ChunkedUploadOperation : uint8_t {
+    QueryMissingChunks = 0,
+    UploadMissingChunks
+};
+
 enum BakingStatus {
     Irrelevant,
     NotBaked,
@@ -81,6 +88,20 @@ AssetHash extractAssetHash(const QString& input);
 
 QByteArray hashData(const QByteArray& data);
 
+// Files of at least this size are uploaded as chunks, so the chunks the asset-server already has aren't sent again
+const uint64_t MIN_CHUNKED_UPLOAD_SIZE = 1024 * 1024;
+
+struct DataChunk {
+    QByteArray hash; // SHA-256, not hex encoded
+    uint64_t offset;
+    uint32_t size;
+};
+
+// Splits data into chunks cut where its content says, so that an edit only changes the chunks around it and
+// not the position of every chunk after it. The same data is always split the same way, on the client and the
+// asset-server alike.
+std::vector<DataChunk> chunkData(const char* data, size_t size);
+
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
 
@@ -0,0 +1,276 @@
+//
+//  ContentNetworkCache.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentNetworkCache.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include "AssetUtils.h"
+#include "NetworkingConstants.h"
+#include "NetworkLogging.h"
+
+namespace {
+    const QString CONTENT_DIRECTORY = "content";
+    const QString INDEX_DIRECTORY = "urls";
+    const std::string CONTENT_FILE_EXTENSION = "blob";
+    const QString INDEX_FILE_EXTENSION = ".url";
+
+    // bump whenever the index files change in a way older ones can't be read as
+    const quint32 INDEX_FILE_VERSION = 1;
+
+    QUrl cleanUrl(const QUrl& url) {
+        return url.adjusted(QUrl::RemovePassword | QUrl::RemoveFragment);
+    }
+
+    cache::FileCache::Key contentKey(const QByteArray& data) {
+        return AssetUtils::hashData(data).toHex().toStdString();
+    }
+}
+
+ContentNetworkCache::ContentNetworkCache(const QString& cacheDirectory, qint64 maximumCacheSize, QObject* parent) :
+    QAbstractNetworkCache(parent),
+    _cacheDirectory(QDir(cacheDirectory).absolutePath()),
+    _indexDirectory(QDir(_cacheDirectory).filePath(INDEX_DIRECTORY)),
+    _maximumCacheSize(maximumCacheSize)
+{
+    QDir().mkpath(_indexDirectory);
+
+    _contentFiles = std::make_shared<cache::FileCache>(QDir(_cacheDirectory).filePath(CONTENT_DIRECTORY).toStdString(),
+                                                       CONTENT_FILE_EXTENSION);
+    _contentFiles->initialize();
+    _contentFiles->setMaxSize((size_t)maximumCacheSize);
+}
+
+ContentNetworkCache::~ContentNetworkCache() {
+    for (auto device : _pendingInserts.keys()) {
+        delete device;
+    }
+}
+
+QString ContentNetworkCache::getIndexFilePath(const QUrl& url) const {
+    auto urlHash = QCryptographicHash::hash(cleanUrl(url).toEncoded(), QCryptographicHash::Sha1).toHex();
+    return QDir(_indexDirectory).filePath(QString::fromLatin1(urlHash) + INDEX_FILE_EXTENSION);
+}
+
+bool ContentNetworkCache::readIndexFile(const QUrl& url, QNetworkCacheMetaData& metaData, Key& key) const {
+    QFile file(getIndexFilePath(url));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    quint32 version;
+    QByteArray keyData;
+    stream >> version;
+    if (version != INDEX_FILE_VERSION) {
+        return false;
+    }
+    stream >> keyData >> metaData;
+    if (stream.status() != QDataStream::Ok || metaData.url() != cleanUrl(url)) {
+        return false;
+    }
+    key = keyData.toStdString();
+    return true;
+}
+
+bool ContentNetworkCache::writeIndexFile(const QNetworkCacheMetaData& metaData, const Key& key) const {
+    QSaveFile file(getIndexFilePath(metaData.url()));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << INDEX_FILE_VERSION << QByteArray::fromStdString(key) << metaData;
+    if (stream.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+bool ContentNetworkCache::findContent(const QUrl& url, QNetworkCacheMetaData& metaData, Key& key) const {
+    if (readIndexFile(url, metaData, key)) {
+        if (_contentFiles->getFile(key)) {
+            return true;
+        }
+        // the content was evicted since, so the index file is no use anymore
+        QFile::remove(getIndexFilePath(url));
+    }
+
+    // content is stored by hash, so an atp: URL naming a hash finds it however it was fetched
+    QString hash = url.path();
+    if (url.scheme() == URL_SCHEME_ATP && AssetUtils::isValidHash(hash)) {
+        key = hash.toLower().toStdString();
+        if (_contentFiles->getFile(key)) {
+            metaData = QNetworkCacheMetaData();
+            metaData.setUrl(cleanUrl(url));
+            metaData.setSaveToDisk(true);
+            metaData.setExpirationDate(QDateTime()); // content named by its hash never expires
+            return true;
+        }
+    }
+    return false;
+}
+
+QByteArray ContentNetworkCache::readContent(const Key& key) {
+    auto file = _contentFiles->getFile(key);
+    if (!file) {
+        return QByteArray();
+    }
+
+    QFile contentFile(QString::fromStdString(file->getFilepath()));
+    if (!contentFile.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QByteArray content = contentFile.readAll();
+
+    if (_verifiedContent.find(key) == _verifiedContent.end()) {
+        if (contentKey(content) != key) {
+            qCWarning(networking) << "Cached content" << key.c_str() << "doesn't match its hash, removing it";
+            file.reset();
+            _contentFiles->removeFile(key);
+            return QByteArray();
+        }
+        _verifiedContent.insert(key);
+    }
+    return content;
+}
+
+QNetworkCacheMetaData ContentNetworkCache::metaData(const QUrl& url) {
+    QNetworkCacheMetaData metaData;
+    Key key;
+    if (!findContent(url, metaData, key)) {
+        return QNetworkCacheMetaData();
+    }
+    return metaData;
+}
+
+void ContentNetworkCache::updateMetaData(const QNetworkCacheMetaData& metaData) {
+    QNetworkCacheMetaData oldMetaData;
+    Key key;
+    if (findContent(metaData.url(), oldMetaData, key)) {
+        QNetworkCacheMetaData newMetaData = metaData;
+        newMetaData.setUrl(cleanUrl(metaData.url()));
+        writeIndexFile(newMetaData, key);
+    }
+}
+
+QIODevice* ContentNetworkCache::data(const QUrl& url) {
+    QNetworkCacheMetaData metaData;
+    Key key;
+    if (!findContent(url, metaData, key)) {
+        return nullptr;
+    }
+
+    QByteArray content = readContent(key);
+    if (content.isNull()) {
+        QFile::remove(getIndexFilePath(url));
+        return nullptr;
+    }
+
+    // the caller owns the device
+    auto buffer = new QBuffer();
+    buffer->setData(content);
+    buffer->open(QIODevice::ReadOnly);
+    return buffer;
+}
+
+bool ContentNetworkCache::remove(const QUrl& url) {
+    QUrl cleanedUrl = cleanUrl(url);
+    for (auto i = _pendingInserts.begin(); i != _pendingInserts.end();) {
+        if (i.value().url() == cleanedUrl) {
+            delete i.key();
+            i = _pendingInserts.erase(i);
+        } else {
+            ++i;
+        }
+    }
+
+    // the content stays, other URLs may map to it, and it's evicted like the rest once unused
+    return QFile::remove(getIndexFilePath(url));
+}
+
+qint64 ContentNetworkCache::cacheSize() const {
+    return (qint64)_contentFiles->getSizeTotalFiles();
+}
+
+QIODevice* ContentNetworkCache::prepare(const QNetworkCacheMetaData& metaData) {
+    if (!metaData.isValid() || !metaData.url().isValid() || !metaData.saveToDisk()) {
+        return nullptr;
+    }
+
+    for (const auto& header : metaData.rawHeaders()) {
+        if (header.first.toLower() == "content-length" && header.second.toLongLong() > _maximumCacheSize) {
+            return nullptr;
+        }
+    }
+
+    QNetworkCacheMetaData pendingMetaData = metaData;
+    pendingMetaData.setUrl(cleanUrl(metaData.url()));
+
+    // owned by the cache, until passed back to insert() or remove()
+    auto buffer = new QBuffer();
+    buffer->open(QIODevice::ReadWrite);
+    _pendingInserts.insert(buffer, pendingMetaData);
+    return buffer;
+}
+
+void ContentNetworkCache::insert(QIODevice* device) {
+    auto pending = _pendingInserts.find(device);
+    if (pending == _pendingInserts.end()) {
+        qCWarning(networking) << "ContentNetworkCache::insert called with a device it didn't prepare";
+        return;
+    }
+    QNetworkCacheMetaData metaData = pending.value();
+    _pendingInserts.erase(pending);
+
+    QByteArray content = static_cast<QBuffer*>(device)->data();
+    delete device;
+
+    Key key = contentKey(content);
+    QString hash = metaData.url().path();
+    if (metaData.url().scheme() == URL_SCHEME_ATP && AssetUtils::isValidHash(hash) && hash.toLower().toStdString() != key) {
+        qCWarning(networking) << "Not caching" << metaData.url() << "its content doesn't match its hash";
+        return;
+    }
+
+    // identical content is already there when it was fetched before under another URL
+    if (!_contentFiles->getFile(key)) {
+        if (!_contentFiles->writeFile(content.constData(), cache::FileCache::Metadata(key, content.size()))) {
+            return;
+        }
+    }
+    _verifiedContent.insert(key);
+
+    if (!writeIndexFile(metaData, key)) {
+        qCWarning(networking) << "Failed to write the cache index file for" << metaData.url();
+    }
+}
+
+void ContentNetworkCache::clear() {
+    for (auto device : _pendingInserts.keys()) {
+        delete device;
+    }
+    _pendingInserts.clear();
+
+    QDir indexDirectory(_indexDirectory);
+    for (const auto& fileName : indexDirectory.entryList({ "*" + INDEX_FILE_EXTENSION }, QDir::Files)) {
+        indexDirectory.remove(fileName);
+    }
+    _contentFiles->wipe();
+    _verifiedContent.clear();
+}
@@ -0,0 +1,75 @@
+//
+//  ContentNetworkCache.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContentNetworkCache_h
+#define hifi_ContentNetworkCache_h
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+#include <QtCore/QHash>
+#include <QtNetwork/QAbstractNetworkCache>
+
+#include <shared/FileCache.h>
+
+// The disk cache behind the network access managers, used in place of QNetworkDiskCache. Response bodies are stored
+// once each in a cache::FileCache keyed by the SHA-256 of their content, and each URL only keeps a small index file
+// with its metadata and the hash of its body. So the same content fetched from different URLs, or from different
+// domains, is only stored once, an atp: URL naming a hash is found whatever URL the content was first fetched from,
+// and content read back from disk is checked against its hash before it is used.
+class ContentNetworkCache : public QAbstractNetworkCache {
+    Q_OBJECT
+public:
+    ContentNetworkCache(const QString& cacheDirectory, qint64 maximumCacheSize, QObject* parent = nullptr);
+    ~ContentNetworkCache();
+
+    const QString& cacheDirectory() const { return _cacheDirectory; }
+    qint64 maximumCacheSize() const { return _maximumCacheSize; }
+
+    QNetworkCacheMetaData metaData(const QUrl& url) override;
+    void updateMetaData(const QNetworkCacheMetaData& metaData) override;
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    qint64 cacheSize() const override;
+
+    QIODevice* prepare(const QNetworkCacheMetaData& metaData) override;
+    void insert(QIODevice* device) override;
+
+public slots:
+    void clear() override;
+
+private:
+    using Key = cache::FileCache::Key;
+
+    QString getIndexFilePath(const QUrl& url) const;
+    bool readIndexFile(const QUrl& url, QNetworkCacheMetaData& metaData, Key& key) const;
+    bool writeIndexFile(const QNetworkCacheMetaData& metaData, const Key& key) const;
+
+    // the key of the stored content a URL maps to, an atp: URL naming a hash maps to that content even without an
+    // index file
+    bool findContent(const QUrl& url, QNetworkCacheMetaData& metaData, Key& key) const;
+    // the stored content, or a null array if it isn't there or doesn't match its hash
+    QByteArray readContent(const Key& key);
+
+    QString _cacheDirectory;
+    QString _indexDirectory;
+    qint64 _maximumCacheSize;
+
+    std::shared_ptr<cache::FileCache> _contentFiles;
+    // content already checked against its hash since it was loaded
+    std::unordered_set<Key> _verifiedContent;
+
+    // the devices handed out by prepare(), until they are inserted or removed
+    QHash<QIODevice*, QNetworkCacheMetaData> _pendingInserts;
+};
+
+#endif // hifi_ContentNetworkCache_h
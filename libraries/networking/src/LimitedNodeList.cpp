@@ -12,6 +12,7 @@
 
 #include "LimitedNodeList.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
@@ -38,6 +39,7 @@
 #include "NetworkLogging.h"
 #include "udt/Packet.h"
 #include "HMACAuth.h"
+#include "PacketCipher.h"
 
 #if defined(Q_OS_WIN)
 #include <winsock.h>
@@ -115,6 +117,9 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
 
+    // set our handleShardPacket method as the handler for packets read by receive shards
+    _nodeSocket.setShardPacketHandler(std::bind(&LimitedNodeList::handleShardPacket, this, _1));
+
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
 
@@ -247,7 +252,7 @@ const WebRTCSocket* LimitedNodeList::getWebRTCSocket() {
 }
 #endif
 
-bool LimitedNodeList::isPacketVerifiedWithSource(const udt::Packet& packet, Node* sourceNode) {
+bool LimitedNodeList::isPacketVerifiedWithSource(udt::Packet& packet, Node* sourceNode) {
     // We track bandwidth when doing packet verification to avoid needing to do a node lookup
     // later when we already do it in packetSourceAndHashMatchAndTrackBandwidth. A node lookup
     // incurs a lock, so it is ideal to avoid needing to do it 2+ times for each packet
@@ -255,6 +260,18 @@ bool LimitedNodeList::isPacketVerifiedWithSource(const udt::Packet& packet, Node
     return packetVersionMatch(packet) && packetSourceAndHashMatchAndTrackBandwidth(packet, sourceNode);
 }
 
+bool LimitedNodeList::setCongestionControl(const QString& name) {
+    auto ccFactory = udt::createCongestionControlFactory(name.toStdString());
+    if (!ccFactory) {
+        qCWarning(networking) << "Unknown congestion control" << name << "- keeping the current one";
+        return false;
+    }
+
+    _nodeSocket.setCongestionControlFactory(std::move(ccFactory));
+    qCDebug(networking) << "New connections will use" << name << "congestion control";
+    return true;
+}
+
 bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
@@ -304,7 +321,7 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
     }
 }
 
-bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode) {
+bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(udt::Packet& packet, Node* sourceNode) {
 
     PacketType headerType = NLPacket::typeInHeader(packet);
 
@@ -363,7 +380,22 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
             bool verificationEnabled = !(isDomainServer() && PacketTypeEnum::getDomainIgnoredVerificationPackets().contains(headerType))
                 && _useAuthentication;
 
-            if (verifiedPacket && verificationEnabled) {
+            if (verifiedPacket && verificationEnabled && _packetProtection == AEADProtection) {
+                auto sourceNodeCipher = sourceNode->getPacketCipher();
+
+                if (!sourceNodeCipher || !NLPacket::openPayload(packet, *sourceNodeCipher)) {
+                    static QMultiMap<QUuid, PacketType> openDebugSuppressMap;
+
+                    if (!openDebugSuppressMap.contains(sourceID, headerType)) {
+                        qCDebug(networking) << "Packet could not be opened on" << headerType << "- Sender" << sourceID;
+                        qCDebug(networking) << "Packet len:" << packet.getDataSize();
+
+                        openDebugSuppressMap.insert(sourceID, headerType);
+                    }
+
+                    return false;
+                }
+            } else if (verifiedPacket && verificationEnabled) {
 
                 QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
                 QByteArray expectedHash;
@@ -403,6 +435,37 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     return false;
 }
 
+bool LimitedNodeList::handleShardPacket(std::unique_ptr<udt::Packet>& packet) {
+    PacketType headerType = NLPacket::typeInHeader(*packet);
+
+    // leave anything unusual, including version mismatches that need reporting, to the node list thread
+    if (NLPacket::versionInHeader(*packet) != versionForPacketType(headerType)
+        || PacketTypeEnum::getNonSourcedPackets().contains(headerType)) {
+        return false;
+    }
+
+    SharedNodePointer sourceNode = nodeWithLocalID(NLPacket::sourceIDInHeader(*packet));
+    if (!sourceNode || !packetSourceAndHashMatchAndTrackBandwidth(*packet, sourceNode.data())) {
+        return false;
+    }
+
+    if (_packetReceiver->shouldDropPackets()) {
+        packet.reset();
+        return true;
+    }
+
+    auto listener = _shardListeners.value(headerType);
+    if (listener) {
+        auto nlPacket = NLPacket::fromBase(std::move(packet));
+        listener(QSharedPointer<ReceivedMessage>::create(*nlPacket), sourceNode);
+    } else {
+        // the PacketReceiver hands the packet over to its listener's thread
+        _packetReceiver->handleVerifiedPacket(std::move(packet));
+    }
+
+    return true;
+}
+
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
@@ -415,6 +478,22 @@ void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAut
     }
 }
 
+bool LimitedNodeList::shouldSealPacket(const NLPacket& packet, const PacketCipher* packetCipher) const {
+    return _useAuthentication && _packetProtection == AEADProtection && packetCipher
+        && !PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())
+        && !PacketTypeEnum::getNonVerifiedPackets().contains(packet.getType());
+}
+
+bool LimitedNodeList::sealPacket(NLPacket& packet, PacketCipher& packetCipher) {
+    packet.writeSourceID(getSessionLocalID());
+
+    if (!packet.sealPayload(packetCipher)) {
+        HIFI_FCDEBUG(networking(), "Could not seal packet of type" << packet.getType());
+        return false;
+    }
+    return true;
+}
+
 static const qint64 ERROR_SENDING_PACKET_BYTES = -1;
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode) {
@@ -424,11 +503,12 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const Node&
         return 0;
     }
 
-    return sendUnreliablePacket(packet, *destinationNode.getActiveSocket(), destinationNode.getAuthenticateHash());
+    return sendUnreliablePacket(packet, *destinationNode.getActiveSocket(), destinationNode.getAuthenticateHash(),
+                                destinationNode.getPacketCipher());
 }
 
 qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const SockAddr& sockAddr,
-        HMACAuth* hmacAuth) {
+        HMACAuth* hmacAuth, PacketCipher* packetCipher) {
     Q_ASSERT(!packet.isPartOfMessage());
     Q_ASSERT_X(!packet.isReliable(), "LimitedNodeList::sendUnreliablePacket",
                "Trying to send a reliable packet unreliably.");
@@ -443,6 +523,16 @@ qint64 LimitedNodeList::sendUnreliablePacket(const NLPacket& packet, const SockA
         }
     }
 
+    if (shouldSealPacket(packet, packetCipher)) {
+        // the caller keeps its packet, and may send it on to other nodes, so it is a copy that gets sealed
+        auto sealedPacket = NLPacket::createCopy(packet);
+        if (!sealPacket(*sealedPacket, *packetCipher)) {
+            return ERROR_SENDING_PACKET_BYTES;
+        }
+
+        return _nodeSocket.writePacket(*sealedPacket, sockAddr);
+    }
+
     fillPacketHeader(packet, hmacAuth);
 
     return _nodeSocket.writePacket(packet, sockAddr);
@@ -453,7 +543,8 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
     auto activeSocket = destinationNode.getActiveSocket();
 
     if (activeSocket) {
-        return sendPacket(std::move(packet), *activeSocket, destinationNode.getAuthenticateHash());
+        return sendPacket(std::move(packet), *activeSocket, destinationNode.getAuthenticateHash(),
+                          destinationNode.getPacketCipher());
     } else {
         qCDebug(networking) << "LimitedNodeList::sendPacket called without active socket for node" << destinationNode << "- not sending";
         return ERROR_SENDING_PACKET_BYTES;
@@ -461,8 +552,18 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
 }
 
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const SockAddr& sockAddr,
-                                   HMACAuth* hmacAuth) {
+                                   HMACAuth* hmacAuth, PacketCipher* packetCipher) {
     Q_ASSERT(!packet->isPartOfMessage());
+
+    // the packet is ours, so it is sealed in place rather than copied, and then only needs its source ID
+    if (shouldSealPacket(*packet, packetCipher)) {
+        if (!sealPacket(*packet, *packetCipher)) {
+            return ERROR_SENDING_PACKET_BYTES;
+        }
+        hmacAuth = nullptr;
+        packetCipher = nullptr;
+    }
+
     if (packet->isReliable()) {
         fillPacketHeader(*packet, hmacAuth);
 
@@ -471,7 +572,7 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const SockA
 
         return size;
     } else {
-        auto size = sendUnreliablePacket(*packet, sockAddr, hmacAuth);
+        auto size = sendUnreliablePacket(*packet, sockAddr, hmacAuth, packetCipher);
         if (size < 0) {
             auto now = usecTimestampNow();
             if (now - _sendErrorStatsTime > ERROR_STATS_PERIOD_US) {
@@ -495,13 +596,14 @@ qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetLi
     if (activeSocket) {
         qint64 bytesSent = 0;
         auto connectionHash = destinationNode.getAuthenticateHash();
+        auto connectionCipher = destinationNode.getPacketCipher();
 
         // close the last packet in the list
         packetList.closeCurrentPacket();
 
         while (!packetList._packets.empty()) {
             bytesSent += sendPacket(packetList.takeFront<NLPacket>(), *activeSocket,
-                connectionHash);
+                connectionHash, connectionCipher);
         }
         return bytesSent;
     } else {
@@ -512,14 +614,14 @@ qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetLi
 }
 
 qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetList, const SockAddr& sockAddr,
-                                                          HMACAuth* hmacAuth) {
+                                                          HMACAuth* hmacAuth, PacketCipher* packetCipher) {
     qint64 bytesSent = 0;
 
     // close the last packet in the list
     packetList.closeCurrentPacket();
 
     while (!packetList._packets.empty()) {
-        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, hmacAuth);
+        bytesSent += sendPacket(packetList.takeFront<NLPacket>(), sockAddr, hmacAuth, packetCipher);
     }
 
     return bytesSent;
@@ -543,9 +645,16 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
         // close the last packet in the list
         packetList->closeCurrentPacket();
 
+        auto packetCipher = destinationNode.getPacketCipher();
         for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
             NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
-            fillPacketHeader(*nlPacket, destinationNode.getAuthenticateHash());
+            if (shouldSealPacket(*nlPacket, packetCipher)) {
+                if (!sealPacket(*nlPacket, *packetCipher)) {
+                    return ERROR_SENDING_PACKET_BYTES;
+                }
+            } else {
+                fillPacketHeader(*nlPacket, destinationNode.getAuthenticateHash());
+            }
         }
 
         return _nodeSocket.writePacketList(std::move(packetList), *activeSocket);
@@ -568,7 +677,8 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
     auto& destinationSockAddr = (overridenSockAddr.isNull()) ? *destinationNode.getActiveSocket()
                                                              : overridenSockAddr;
 
-    return sendPacket(std::move(packet), destinationSockAddr, destinationNode.getAuthenticateHash());
+    return sendPacket(std::move(packet), destinationSockAddr, destinationNode.getAuthenticateHash(),
+                      destinationNode.getPacketCipher());
 }
 
 int LimitedNodeList::updateNodeWithDataFromPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -594,6 +704,48 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
     return node->getLinkedData();
 }
 
+NodeSnapshot::NodeSnapshot(std::vector<SharedNodePointer> nodes) :
+    _nodes(std::move(nodes))
+{
+    std::stable_sort(_nodes.begin(), _nodes.end(), [](const SharedNodePointer& a, const SharedNodePointer& b) {
+        return a->getType() < b->getType();
+    });
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        if (_typeStarts.empty() || _typeStarts.back().first != _nodes[i]->getType()) {
+            _typeStarts.push_back({ _nodes[i]->getType(), i });
+        }
+    }
+}
+
+NodeSnapshot::Range NodeSnapshot::ofType(NodeType_t nodeType) const {
+    for (size_t i = 0; i < _typeStarts.size(); ++i) {
+        if (_typeStarts[i].first == nodeType) {
+            size_t end = (i + 1 < _typeStarts.size()) ? _typeStarts[i + 1].second : _nodes.size();
+            return { _nodes.cbegin() + _typeStarts[i].second, _nodes.cbegin() + end };
+        }
+    }
+    return { _nodes.cend(), _nodes.cend() };
+}
+
+NodeSnapshotPointer LimitedNodeList::getNodeSnapshot() const {
+    if (_isNodeSnapshotDirty) {
+        std::lock_guard<std::mutex> snapshotLock(_nodeSnapshotMutex);
+        // nodes are inserted under the read lock, and flag the snapshot dirty once they are in the hash, so any node
+        // inserted while this copies the hash flags it again for the next call
+        if (_isNodeSnapshotDirty.exchange(false)) {
+            std::vector<SharedNodePointer> nodes;
+            {
+                QReadLocker readLock(&_nodeMutex);
+                nodes.reserve(_nodeHash.size());
+                std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes),
+                               [](const NodeHash::value_type& it) { return it.second; });
+            }
+            std::atomic_store(&_nodeSnapshot, NodeSnapshotPointer(std::make_shared<NodeSnapshot>(std::move(nodes))));
+        }
+    }
+    return std::atomic_load(&_nodeSnapshot);
+}
+
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
     QReadLocker readLocker(&_nodeMutex);
 
@@ -626,6 +778,7 @@ void LimitedNodeList::eraseAllNodes(QString reason) {
         }
         _localIDMap.clear();
         _nodeHash.clear();
+        _isNodeSnapshotDirty = true;
     }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
@@ -651,6 +804,7 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
             QWriteLocker writeLocker(&_nodeMutex);
             _localIDMap.unsafe_erase(matchingNode->getLocalID());
             _nodeHash.unsafe_erase(matchingNode->getUUID());
+            _isNodeSnapshotDirty = true;
         }
 
         handleNodeKill(matchingNode, newConnectionID);
@@ -711,6 +865,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
                 QWriteLocker writeLocker(&_nodeMutex);
                 _localIDMap.unsafe_erase(node->getLocalID());
                 _nodeHash.unsafe_erase(node->getUUID());
+                _isNodeSnapshotDirty = true;
             }
             handleNodeKill(node);
         }
@@ -755,6 +910,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         // insert the new node and release our read lock
         _nodeHash.insert({ newNode->getUUID(), newNodePointer });
         _localIDMap.insert({ localID, newNodePointer });
+        _isNodeSnapshotDirty = true;
     }
 
     qCDebug(networking) << "Added" << *newNode;
@@ -921,6 +1077,7 @@ void LimitedNodeList::removeSilentNodes() {
             // call the NodeHash erase to get rid of this node
             _localIDMap.unsafe_erase(node->getLocalID());
             it = _nodeHash.unsafe_erase(it);
+            _isNodeSnapshotDirty = true;
 
             killedNodes.insert(node);
         } else {
@@ -15,10 +15,13 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #ifndef _WIN32
 #include <unistd.h> // not on windows, not needed for mac or windows
@@ -75,6 +78,35 @@ const ConnectionID INITIAL_CONNECTION_ID { 0 };
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
+// An immutable list of the nodes, grouped by type, published by the LimitedNodeList after the nodes are added or removed.
+// It is walked without a lock and without touching the reference counts of the nodes, and keeps its nodes alive, so a
+// node killed since it was published is still in it.
+class NodeSnapshot {
+public:
+    using const_iterator = std::vector<SharedNodePointer>::const_iterator;
+
+    struct Range {
+        const_iterator first;
+        const_iterator second;
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return second; }
+    };
+
+    NodeSnapshot(std::vector<SharedNodePointer> nodes);
+
+    const_iterator begin() const { return _nodes.cbegin(); }
+    const_iterator end() const { return _nodes.cend(); }
+    size_t size() const { return _nodes.size(); }
+
+    Range ofType(NodeType_t nodeType) const;
+
+private:
+    std::vector<SharedNodePointer> _nodes;
+    // the type and the first index of each group of nodes of a type
+    std::vector<std::pair<NodeType_t, size_t>> _typeStarts;
+};
+using NodeSnapshotPointer = std::shared_ptr<const NodeSnapshot>;
+
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -118,6 +150,13 @@ public:
     };
     Q_ENUM(ConnectReason);
 
+    // how the packets between two nodes are protected, chosen by the domain server for all of its nodes
+    enum PacketProtection : quint8 {
+        HMACProtection = 0, // authenticated with an HMAC of the payload
+        AEADProtection // encrypted and authenticated with AES-GCM
+    };
+    Q_ENUM(PacketProtection);
+
     QUuid getSessionUUID() const;
     void setSessionUUID(const QUuid& sessionUUID);
     Node::LocalID getSessionLocalID() const;
@@ -154,17 +193,19 @@ public:
     // use sendUnreliablePacket to send an unreliable packet (that you do not need to move)
     // either to a node (via its active socket) or to a manual sockaddr
     qint64 sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode);
-    qint64 sendUnreliablePacket(const NLPacket& packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
+    qint64 sendUnreliablePacket(const NLPacket& packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr,
+        PacketCipher* packetCipher = nullptr);
 
     // use sendPacket to send a moved unreliable or reliable NL packet to a node's active socket or manual sockaddr
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
-    qint64 sendPacket(std::unique_ptr<NLPacket> packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
+    qint64 sendPacket(std::unique_ptr<NLPacket> packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr,
+        PacketCipher* packetCipher = nullptr);
 
     // use sendUnreliableUnorderedPacketList to unreliably send separate packets from the packet list
     // either to a node's active socket or to a manual sockaddr
     qint64 sendUnreliableUnorderedPacketList(NLPacketList& packetList, const Node& destinationNode);
     qint64 sendUnreliableUnorderedPacketList(NLPacketList& packetList, const SockAddr& sockAddr,
-        HMACAuth* hmacAuth = nullptr);
+        HMACAuth* hmacAuth = nullptr, PacketCipher* packetCipher = nullptr);
 
     // use sendPacketList to send reliable packet lists (ordered or unordered) to a node's active socket
     // or to a manual sock addr
@@ -212,10 +253,14 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
+    // The nodes as of the last time they were added or removed, rebuilt here if they have been since. Iterating it takes
+    // no lock, so it is what the mixers walk each frame.
+    NodeSnapshotPointer getNodeSnapshot() const;
+
+    // Cede control of iteration over the node snapshot (e.g. for use by thread pools)
     // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    //   The snapshot is shared by all the threads of a pool without holding a lock,
+    //   so a dying node taking the write lock does not wait on the iteration
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
@@ -224,29 +269,17 @@ public:
         quint64 start, endTransform, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
-
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        // only waits on the lock when the nodes have changed since the last snapshot
+        auto nodes = getNodeSnapshot();
+        endTransform = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endTransform - start);
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(nodes->begin(), nodes->end());
         endFunctor = usecTimestampNow();
         if (functorOut) {
             *functorOut = (endFunctor - endTransform);
@@ -315,16 +348,37 @@ public:
     void flagTimeForConnectionStep(ConnectionStep connectionStep);
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
+    NetworkSocket::DatagramStats sampleDatagramStats() { return _nodeSocket.sampleDatagramStats(); }
+
+    // unreliable packets sent from this thread in between are written with as few system calls as possible
+    void openSendBatch() { _nodeSocket.openWriteBatch(); }
+    void flushSendBatch() { _nodeSocket.flushWriteBatch(); }
+
+    // inbound traffic is read with this many sockets and threads, sharded by the source address of each peer
+    void setNumReceiveShards(int numShards) { _nodeSocket.setNumReceiveShards(numShards); }
+    int getNumReceiveShards() const { return _nodeSocket.getNumReceiveShards(); }
+
+    // unreliable packets of a type with a shard listener skip the PacketReceiver and go straight to the listener,
+    // on whichever thread read them - listeners must be thread-safe and registered before the shards are started
+    using ShardListener = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+    void registerShardListener(PacketType type, ShardListener listener) { _shardListeners[type] = listener; }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // selects the congestion control ("vegas" or "bbr") for connections created from now on, false if unknown
+    bool setCongestionControl(const QString& name);
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
-    bool isPacketVerifiedWithSource(const udt::Packet& packet, Node* sourceNode = nullptr);
-    bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
+    // opens the payload of a sealed packet in place
+    bool isPacketVerifiedWithSource(udt::Packet& packet, Node* sourceNode = nullptr);
+    bool isPacketVerified(udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
+    // only applies while packets are authenticated
+    void setPacketProtection(PacketProtection protection) { _packetProtection = protection; }
+    PacketProtection getPacketProtection() const { return _packetProtection; }
 
     void setFlagTimeForConnectionStep(bool flag) { _flagTimeForConnectionStep = flag; }
     bool isFlagTimeForConnectionStep() { return _flagTimeForConnectionStep; }
@@ -426,7 +480,8 @@ protected:
 
     void setLocalSocket(const SockAddr& sockAddr);
 
-    bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
+    bool packetSourceAndHashMatchAndTrackBandwidth(udt::Packet& packet, Node* sourceNode = nullptr);
+    bool handleShardPacket(std::unique_ptr<udt::Packet>& packet);
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
     void handleNodeKill(const SharedNodePointer& node, ConnectionID newConnectionID = NULL_CONNECTION_ID);
@@ -445,13 +500,20 @@ protected:
 
     NodeHash _nodeHash;
     mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    // set after each change to _nodeHash, so the next getNodeSnapshot rebuilds the snapshot
+    mutable std::atomic<bool> _isNodeSnapshotDirty { true };
+    // orders the rebuilds, so that an older snapshot is never published over a newer one
+    mutable std::mutex _nodeSnapshotMutex;
+    mutable NodeSnapshotPointer _nodeSnapshot;
     udt::Socket _nodeSocket;
+    QHash<PacketType, ShardListener> _shardListeners;
     QUdpSocket* _dtlsSocket { nullptr };
     SockAddr _localSockAddr;
     SockAddr _publicSockAddr;
     SockAddr _stunSockAddr { SocketType::UDP, STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    PacketProtection _packetProtection { HMACProtection };
 
     PacketReceiver* _packetReceiver;
 
@@ -490,6 +552,9 @@ private slots:
 
 private:
     void fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth = nullptr);
+    bool shouldSealPacket(const NLPacket& packet, const PacketCipher* packetCipher) const;
+    // writes the source ID and seals the packet in place of fillPacketHeader
+    bool sealPacket(NLPacket& packet, PacketCipher& packetCipher);
 
     mutable QReadWriteLock _sessionUUIDLock;
     QUuid _sessionUUID;
@@ -13,6 +13,7 @@
 #include "NLPacket.h"
 
 #include "HMACAuth.h"
+#include "PacketCipher.h"
 
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = PacketTypeEnum::getNonSourcedPackets().contains(type);
@@ -35,7 +36,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const SockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -90,7 +91,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -228,3 +229,32 @@ void NLPacket::writeVerificationHash(HMACAuth& hmacAuth) const {
     
     memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
 }
+
+bool NLPacket::sealPayload(PacketCipher& cipher) {
+    Q_ASSERT(!PacketTypeEnum::getNonSourcedPackets().contains(_type) &&
+             !PacketTypeEnum::getNonVerifiedPackets().contains(_type));
+    static_assert(PacketCipher::NUM_BYTES_OVERHEAD == NUM_BYTES_MD5_HASH,
+                  "The nonce salt, counter and tag should fit where the verification hash goes");
+
+    // the type, version and source ID are authenticated along with the payload
+    auto headerOffset = Packet::totalHeaderSize(isPartOfMessage());
+    int associatedDataLength = sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_LOCALID;
+    auto offset = headerOffset + associatedDataLength + NUM_BYTES_MD5_HASH;
+
+    return cipher.seal(_sourceID, _packet.get() + headerOffset, associatedDataLength,
+                       _packet.get() + offset, (int)(getDataSize() - offset),
+                       _packet.get() + headerOffset + associatedDataLength);
+}
+
+bool NLPacket::openPayload(udt::Packet& packet, PacketCipher& cipher) {
+    auto headerOffset = Packet::totalHeaderSize(packet.isPartOfMessage());
+    int associatedDataLength = sizeof(PacketType) + sizeof(PacketVersion) + NUM_BYTES_LOCALID;
+    auto offset = headerOffset + associatedDataLength + NUM_BYTES_MD5_HASH;
+    if (packet.getDataSize() < offset) {
+        return false;
+    }
+
+    return cipher.open(sourceIDInHeader(packet), packet.getData() + headerOffset, associatedDataLength,
+                       packet.getData() + offset, (int)(packet.getDataSize() - offset),
+                       packet.getData() + headerOffset + associatedDataLength);
+}
@@ -18,6 +18,7 @@
 #include "udt/Packet.h"
 
 class HMACAuth;
+class PacketCipher;
 
 /// @addtogroup Networking
 /// @{
@@ -36,6 +37,7 @@ class HMACAuth;
 ///     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
 ///     |                                                               |
 ///     |                 MD5 Verification - 16 bytes                   |  Only if a verified packet.
+///     |       or AES-GCM nonce counter (4 bytes) and tag (12 bytes)     |  Payload encrypted if sealed.
 ///     |                                                               |
 ///     |                                                               |
 ///     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -58,7 +60,7 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                         const SockAddr& senderSockAddr);
 
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -91,10 +93,16 @@ public:
     void writeSourceID(LocalID sourceID) const;
     void writeVerificationHash(HMACAuth& hmacAuth) const;
 
+    // encrypts the payload in place and writes its nonce counter and tag in place of the verification hash,
+    // the source ID must have been written
+    bool sealPayload(PacketCipher& cipher);
+    // decrypts the payload of a received sealed packet in place, false if it was not sealed with this cipher
+    static bool openPayload(udt::Packet& packet, PacketCipher& cipher);
+
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    NLPacket(udt::PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
@@ -12,6 +12,7 @@
 
 #include "Node.h"
 
+#include <algorithm>
 #include <cstring>
 #include <stdio.h>
 
@@ -164,6 +165,7 @@ void Node::addIgnoredNode(const QUuid& otherNodeID) {
         // add the session UUID to the set of ignored ones for this listening node
         if (std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNodeID) == _ignoredNodeIDs.end()) {
             _ignoredNodeIDs.push_back(otherNodeID);
+            ++_ignoredNodeIDsVersion;
         }
     } else {
         qCWarning(networking) << "Node::addIgnoredNode called with null ID or ID of ignoring node.";
@@ -180,6 +182,7 @@ void Node::removeIgnoredNode(const QUuid& otherNodeID) {
         auto it = std::remove(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNodeID);
         if (it != _ignoredNodeIDs.end()) {
             _ignoredNodeIDs.erase(it);
+            ++_ignoredNodeIDsVersion;
         }
     } else {
         qCWarning(networking) << "Node::removeIgnoredNode called with null ID or ID of ignoring node.";
@@ -193,6 +196,16 @@ bool Node::isIgnoringNodeWithID(const QUuid& nodeID) const {
     return std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), nodeID) != _ignoredNodeIDs.end();
 }
 
+Node::IgnoredNodeIDs Node::getSortedIgnoredNodeIDs() const {
+    IgnoredNodeIDs sortedIDs;
+    {
+        QReadLocker lock { &_ignoredNodeIDSetLock };
+        sortedIDs = _ignoredNodeIDs;
+    }
+    std::sort(sortedIDs.begin(), sortedIDs.end());
+    return sortedIDs;
+}
+
 QDataStream& operator<<(QDataStream& out, const Node& node) {
     out << node._type;
     out << node._uuid;
@@ -242,9 +255,13 @@ void Node::setConnectionSecret(const QUuid& connectionSecret) {
     if (!_authenticateHash) {
         _authenticateHash.reset(new HMACAuth());
     }
+    if (!_packetCipher) {
+        _packetCipher.reset(new PacketCipher());
+    }
 
     _connectionSecret = connectionSecret;
     _authenticateHash->setKey(_connectionSecret);
+    _packetCipher->setKey(_connectionSecret);
 }
 
 void Node::updateStats(Stats stats) {
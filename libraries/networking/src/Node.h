@@ -13,6 +13,7 @@
 #ifndef hifi_Node_h
 #define hifi_Node_h
 
+#include <atomic>
 #include <memory>
 #include <ostream>
 #include <stdint.h>
@@ -36,6 +37,7 @@
 #include "MovingPercentile.h"
 #include "NodePermissions.h"
 #include "HMACAuth.h"
+#include "PacketCipher.h"
 #include "udt/ConnectionStats.h"
 #include "NumericalConstants.h"
 
@@ -63,6 +65,7 @@ public:
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
     void setConnectionSecret(const QUuid& connectionSecret);
     HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
+    PacketCipher* getPacketCipher() const { return _packetCipher.get(); }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
     void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
@@ -97,6 +100,11 @@ public:
     using IgnoredNodeIDs = std::vector<QUuid>;
     const IgnoredNodeIDs& getIgnoredNodeIDs() const { return _ignoredNodeIDs; }
 
+    // bumped on each change to the ignored node IDs, so that a mixer knows when to take a new copy of them
+    uint32_t getIgnoredNodeIDsVersion() const { return _ignoredNodeIDsVersion; }
+    // a sorted copy of the ignored node IDs, for a lookup with std::binary_search
+    IgnoredNodeIDs getSortedIgnoredNodeIDs() const;
+
     friend QDataStream& operator<<(QDataStream& out, const Node& node);
     friend QDataStream& operator>>(QDataStream& in, Node& node);
 
@@ -115,6 +123,7 @@ private:
 
     QUuid _connectionSecret;
     std::unique_ptr<HMACAuth> _authenticateHash { nullptr };
+    std::unique_ptr<PacketCipher> _packetCipher { nullptr };
     std::unique_ptr<NodeData> _linkedData;
     bool _isReplicated { false };
     int _pingMs;
@@ -126,6 +135,7 @@ private:
 
     IgnoredNodeIDs _ignoredNodeIDs;
     mutable QReadWriteLock _ignoredNodeIDSetLock;
+    std::atomic<uint32_t> _ignoredNodeIDsVersion { 0 };
     std::vector<QString> _replicatedUsernames { };
 
     Stats _stats;
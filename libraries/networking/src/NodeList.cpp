@@ -203,6 +203,21 @@ qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
     return sendStats(statsObject, _domainHandler.getSockAddr());
 }
 
+qint64 NodeList::sendTelemetryToDomainServer(QByteArray snapshot) {
+    if (thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(this, "sendTelemetryToDomainServer", Qt::QueuedConnection,
+                                  Q_ARG(QByteArray, snapshot));
+        return 0;
+    }
+
+    // reliable and ordered, as each snapshot only holds the changes since the one before
+    auto telemetryPacketList = NLPacketList::create(PacketType::NodeTelemetry, QByteArray(), true, true);
+    telemetryPacketList->write(snapshot);
+
+    sendPacketList(std::move(telemetryPacketList), _domainHandler.getSockAddr());
+    return 0;
+}
+
 void NodeList::timePingReply(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
     PingType_t pingType;
 
@@ -318,6 +333,11 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    // the next domain list we get is the whole of it
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _pendingDomainListNodes.clear();
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -522,6 +542,8 @@ void NodeList::sendDomainServerCheckIn() {
                 }
             }
 
+        } else {
+            packetStream << _domainListVersion;
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -747,6 +769,10 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool isAuthenticated;
     packetStream >> isAuthenticated;
 
+    // are the packets between nodes sealed or hashed?
+    quint8 packetProtection;
+    packetStream >> packetProtection;
+
     qint64 now = qint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
 
     quint64 connectRequestTimestamp;
@@ -761,6 +787,13 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // the version of the list, and how many entries it has across its packets
+    quint64 domainListVersion;
+    packetStream >> domainListVersion;
+
+    quint32 numDomainListNodes;
+    packetStream >> numDomainListNodes;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -856,10 +889,21 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
 
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
+    setPacketProtection(packetProtection == AEADProtection ? AEADProtection : HMACProtection);
+
+    if (domainListVersion != _pendingDomainListVersion) {
+        _pendingDomainListVersion = domainListVersion;
+        _pendingDomainListNodes.clear();
+    }
 
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        _pendingDomainListNodes.insert(parseNodeFromPacketStream(packetStream));
+    }
+
+    // only once every entry of the list is in do we have its version
+    if ((quint32)_pendingDomainListNodes.size() >= numDomainListNodes) {
+        _domainListVersion = domainListVersion;
     }
 }
 
@@ -879,7 +923,7 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     removeDelayedAdd(nodeUUID);
 }
 
-void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
+QUuid NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     NewNodeInfo info;
 
     SocketType publicSocketType, localSocketType;
@@ -903,6 +947,8 @@ void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
     }
 
     addNewNode(info);
+
+    return info.uuid;
 }
 
 void NodeList::sendAssignment(Assignment& assignment) {
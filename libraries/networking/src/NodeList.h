@@ -60,6 +60,7 @@ public:
 
     Q_INVOKABLE qint64 sendStats(QJsonObject statsObject, SockAddr destination);
     Q_INVOKABLE qint64 sendStatsToDomainServer(QJsonObject statsObject);
+    Q_INVOKABLE qint64 sendTelemetryToDomainServer(QByteArray snapshot); // a NodeTelemetry snapshot
 
     DomainHandler& getDomainHandler() { return _domainHandler; }
 
@@ -169,7 +170,7 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
-    void parseNodeFromPacketStream(QDataStream& packetStream);
+    QUuid parseNodeFromPacketStream(QDataStream& packetStream);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
 
@@ -183,6 +184,12 @@ private:
     QTimer _keepAlivePingTimer;
     bool _requestsDomainListData { false };
 
+    // the version of the domain list we have, sent with each request so that the domain-server need only send what
+    // changed since, and the entries of the version we are getting
+    quint64 _domainListVersion { 0 };
+    quint64 _pendingDomainListVersion { 0 };
+    QSet<QUuid> _pendingDomainListNodes;
+
     bool _sendDomainServerCheckInEnabled { true };
     bool _domainPortAutoDiscovery { true };
 
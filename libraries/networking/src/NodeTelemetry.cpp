@@ -0,0 +1,172 @@
+//
+//  NodeTelemetry.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeTelemetry.h"
+
+#include <QtCore/QDataStream>
+
+std::mutex NodeTelemetry::_mutex;
+NodeTelemetry::Metrics NodeTelemetry::_metrics;
+
+const int MAX_NAME_LENGTH = 255;
+
+NodeTelemetry::Metric& NodeTelemetry::getMetric(const QString& name, MetricType type) {
+    Metric& metric = _metrics[name];
+    if (metric.type != type) {
+        // a name is only ever used for one type, but if not the last use wins
+        metric = Metric();
+        metric.type = type;
+    }
+    return metric;
+}
+
+void NodeTelemetry::recordValue(const QString& name, uint64_t value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    getMetric(name, Histogram).histogram.record(value);
+}
+
+void NodeTelemetry::mergeHistogram(const QString& name, const LatencyHistogram& histogram) {
+    if (histogram.getCount() == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    getMetric(name, Histogram).histogram += histogram;
+}
+
+void NodeTelemetry::addToCounter(const QString& name, uint64_t increase) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    getMetric(name, Counter).value += (double)increase;
+}
+
+void NodeTelemetry::setGauge(const QString& name, double value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    getMetric(name, Gauge).value = value;
+}
+
+void NodeTelemetry::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _metrics.clear();
+}
+
+QByteArray NodeTelemetry::takeSnapshot() {
+    QByteArray snapshot;
+    QDataStream stream(&snapshot, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // counters and histograms with nothing new are left out, gauges are always sent
+    quint16 numMetrics = 0;
+    for (const auto& entry : _metrics) {
+        const Metric& metric = entry.second;
+        if ((metric.type == Counter && metric.value > 0.0) || (metric.type == Histogram && metric.histogram.getCount() > 0) ||
+            metric.type == Gauge) {
+            ++numMetrics;
+        }
+    }
+    if (numMetrics == 0) {
+        return QByteArray();
+    }
+    stream << numMetrics;
+
+    for (auto& entry : _metrics) {
+        Metric& metric = entry.second;
+        if ((metric.type == Counter && metric.value <= 0.0) ||
+            (metric.type == Histogram && metric.histogram.getCount() == 0)) {
+            continue;
+        }
+
+        QByteArray name = entry.first.toUtf8().left(MAX_NAME_LENGTH);
+        stream << (quint8)metric.type << (quint8)name.size();
+        stream.writeRawData(name.constData(), name.size());
+
+        switch (metric.type) {
+            case Counter:
+                stream << (quint64)metric.value;
+                metric.value = 0.0;
+                break;
+            case Gauge:
+                stream << metric.value;
+                break;
+            case Histogram: {
+                const LatencyHistogram& histogram = metric.histogram;
+                quint16 numBuckets = 0;
+                for (int i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i) {
+                    if (histogram.getBucketCount(i) > 0) {
+                        ++numBuckets;
+                    }
+                }
+                stream << (quint64)histogram.getTotal() << (quint64)histogram.getMax() << numBuckets;
+                for (int i = 0; i < LatencyHistogram::NUM_BUCKETS; ++i) {
+                    if (histogram.getBucketCount(i) > 0) {
+                        stream << (quint16)i << (quint32)histogram.getBucketCount(i);
+                    }
+                }
+                metric.histogram.reset();
+                break;
+            }
+        }
+    }
+    return snapshot;
+}
+
+bool NodeTelemetry::accumulate(const QByteArray& snapshot, Metrics& metrics) {
+    QDataStream stream(snapshot);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    quint16 numMetrics = 0;
+    stream >> numMetrics;
+    for (int i = 0; i < numMetrics && stream.status() == QDataStream::Ok; ++i) {
+        quint8 type = 0;
+        quint8 nameLength = 0;
+        stream >> type >> nameLength;
+        QByteArray name(nameLength, Qt::Uninitialized);
+        if (stream.readRawData(name.data(), nameLength) != nameLength || type > Histogram) {
+            return false;
+        }
+
+        Metric& metric = metrics[QString::fromUtf8(name)];
+        if (metric.type != type) {
+            metric = Metric();
+            metric.type = (MetricType)type;
+        }
+
+        switch (metric.type) {
+            case Counter: {
+                quint64 increase = 0;
+                stream >> increase;
+                metric.value += (double)increase;
+                break;
+            }
+            case Gauge:
+                stream >> metric.value;
+                break;
+            case Histogram: {
+                quint64 total = 0;
+                quint64 max = 0;
+                quint16 numBuckets = 0;
+                stream >> total >> max >> numBuckets;
+                for (int j = 0; j < numBuckets && stream.status() == QDataStream::Ok; ++j) {
+                    quint16 bucket = 0;
+                    quint32 count = 0;
+                    stream >> bucket >> count;
+                    if (bucket >= LatencyHistogram::NUM_BUCKETS) {
+                        return false;
+                    }
+                    metric.histogram.addToBucket(bucket, count);
+                }
+                metric.histogram.addToTotals(total, max);
+                break;
+            }
+        }
+    }
+    return stream.status() == QDataStream::Ok;
+}
@@ -0,0 +1,68 @@
+//
+//  NodeTelemetry.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTelemetry_h
+#define hifi_NodeTelemetry_h
+
+#include <map>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <shared/LatencyHistogram.h>
+
+// The performance figures an assignment client sends the domain server alongside its JSON stats, typed and already
+// aggregated where they are measured, so the domain server merges them without parsing and the exporter serves them
+// as histograms rather than as the last value seen.
+//   Each snapshot holds what changed since the one before, little-endian:
+//     uint16 number of metrics, then for each: uint8 type, uint8 name length, the name in UTF-8, and
+//       Counter: uint64 increase
+//       Gauge: double value
+//       Histogram: uint64 total, uint64 max, uint16 number of non-empty buckets, then for each uint16 bucket, uint32 count
+// with the buckets those of a LatencyHistogram.
+class NodeTelemetry {
+public:
+    enum MetricType : uint8_t {
+        Counter = 0,
+        Gauge,
+        Histogram
+    };
+
+    struct Metric {
+        MetricType type { Counter };
+        double value { 0.0 }; // the count of a counter, the value of a gauge
+        LatencyHistogram histogram;
+    };
+    using Metrics = std::map<QString, Metric>;
+
+    // from any thread of the process
+    static void recordValue(const QString& name, uint64_t value);
+    static void mergeHistogram(const QString& name, const LatencyHistogram& histogram);
+    static void addToCounter(const QString& name, uint64_t increase);
+    static void setGauge(const QString& name, double value);
+
+    // the changes since the last snapshot and the gauges, empty if there is nothing to send
+    static QByteArray takeSnapshot();
+
+    // adds a snapshot to the metrics it follows on from, \return false if it is malformed
+    static bool accumulate(const QByteArray& snapshot, Metrics& metrics);
+
+    static void reset();
+
+private:
+    static Metric& getMetric(const QString& name, MetricType type);
+
+    static std::mutex _mutex;
+    static Metrics _metrics;
+};
+
+#endif // hifi_NodeTelemetry_h
@@ -0,0 +1,152 @@
+//
+//  PacketCipher.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCipher.h"
+
+#include <cstring>
+#include <limits>
+
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+
+#include <QtCore/QUuid>
+
+#include "NetworkLogging.h"
+
+namespace {
+    // keeps the key of a pair of nodes apart from the HMAC key derived from the same secret
+    const char KEY_DERIVATION_LABEL[] = "vircadia packet cipher";
+}
+
+PacketCipher::PacketCipher() :
+    _sealContext(EVP_CIPHER_CTX_new()),
+    _openContext(EVP_CIPHER_CTX_new())
+{
+}
+
+PacketCipher::~PacketCipher() {
+    EVP_CIPHER_CTX_free(_sealContext);
+    EVP_CIPHER_CTX_free(_openContext);
+}
+
+bool PacketCipher::setKey(const QUuid& connectionSecret) {
+    QByteArray keyMaterial(KEY_DERIVATION_LABEL, sizeof(KEY_DERIVATION_LABEL) - 1);
+    keyMaterial.append(connectionSecret.toRfc4122());
+
+    // the key is the start of the digest
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(reinterpret_cast<const unsigned char*>(keyMaterial.constData()), keyMaterial.size(), digest);
+
+    std::lock_guard<std::mutex> sealLock(_sealLock);
+    std::lock_guard<std::mutex> openLock(_openLock);
+
+    // expand the key schedule once, later packets only set their nonce
+    bool success =
+        EVP_EncryptInit_ex(_sealContext, EVP_aes_128_gcm(), nullptr, nullptr, nullptr) &&
+        EVP_CIPHER_CTX_ctrl(_sealContext, EVP_CTRL_GCM_SET_IVLEN, NUM_BYTES_NONCE, nullptr) &&
+        EVP_EncryptInit_ex(_sealContext, nullptr, nullptr, digest, nullptr) &&
+        EVP_DecryptInit_ex(_openContext, EVP_aes_128_gcm(), nullptr, nullptr, nullptr) &&
+        EVP_CIPHER_CTX_ctrl(_openContext, EVP_CTRL_GCM_SET_IVLEN, NUM_BYTES_NONCE, nullptr) &&
+        EVP_DecryptInit_ex(_openContext, nullptr, nullptr, digest, nullptr);
+
+    memset(digest, 0, sizeof(digest));
+
+    if (!success) {
+        qCWarning(networking) << "PacketCipher could not set up its AES-GCM contexts";
+    }
+
+    // the key may well be one that this or an earlier cipher already sealed with,
+    // so the counter only starts over along with a new salt
+    uint32_t salt = 0;
+    if (success && RAND_bytes(reinterpret_cast<unsigned char*>(&salt), sizeof(salt)) != 1) {
+        qCWarning(networking) << "PacketCipher could not draw a nonce salt";
+        success = false;
+    }
+
+    _salt = salt;
+    _nextCounter = 0;
+    _hasKey = success;
+    return success;
+}
+
+void PacketCipher::makeNonce(uint16_t senderID, uint32_t salt, uint32_t counter, unsigned char* nonce) {
+    memset(nonce, 0, NUM_BYTES_NONCE);
+    memcpy(nonce, &senderID, sizeof(senderID));
+    memcpy(nonce + NUM_BYTES_NONCE - sizeof(counter) - sizeof(salt), &salt, sizeof(salt));
+    memcpy(nonce + NUM_BYTES_NONCE - sizeof(counter), &counter, sizeof(counter));
+}
+
+bool PacketCipher::seal(uint16_t senderID, const char* associatedData, int associatedDataLength,
+                        char* data, int dataLength, char* overhead) {
+    if (!_hasKey) {
+        return false;
+    }
+
+    uint64_t counter = _nextCounter++;
+    if (counter > std::numeric_limits<uint32_t>::max()) {
+        static std::atomic<bool> hasWarned { false };
+        if (!hasWarned.exchange(true)) {
+            qCWarning(networking) << "PacketCipher nonces exhausted - dropping packets until the connection secret changes";
+        }
+        return false;
+    }
+
+    uint32_t salt = _salt;
+    uint32_t packetCounter = (uint32_t)counter;
+    unsigned char nonce[NUM_BYTES_NONCE];
+    makeNonce(senderID, salt, packetCounter, nonce);
+
+    auto dataBytes = reinterpret_cast<unsigned char*>(data);
+    int length = 0;
+
+    std::lock_guard<std::mutex> lock(_sealLock);
+    bool success =
+        EVP_EncryptInit_ex(_sealContext, nullptr, nullptr, nullptr, nonce) &&
+        EVP_EncryptUpdate(_sealContext, nullptr, &length,
+                          reinterpret_cast<const unsigned char*>(associatedData), associatedDataLength) &&
+        EVP_EncryptUpdate(_sealContext, dataBytes, &length, dataBytes, dataLength) &&
+        EVP_EncryptFinal_ex(_sealContext, dataBytes + length, &length) &&
+        EVP_CIPHER_CTX_ctrl(_sealContext, EVP_CTRL_GCM_GET_TAG, NUM_BYTES_TAG,
+                            overhead + NUM_BYTES_SALT + NUM_BYTES_COUNTER);
+
+    memcpy(overhead, &salt, NUM_BYTES_SALT);
+    memcpy(overhead + NUM_BYTES_SALT, &packetCounter, NUM_BYTES_COUNTER);
+    return success;
+}
+
+bool PacketCipher::open(uint16_t senderID, const char* associatedData, int associatedDataLength,
+                        char* data, int dataLength, const char* overhead) {
+    if (!_hasKey) {
+        return false;
+    }
+
+    uint32_t salt;
+    memcpy(&salt, overhead, NUM_BYTES_SALT);
+    uint32_t packetCounter;
+    memcpy(&packetCounter, overhead + NUM_BYTES_SALT, NUM_BYTES_COUNTER);
+    unsigned char nonce[NUM_BYTES_NONCE];
+    makeNonce(senderID, salt, packetCounter, nonce);
+
+    unsigned char tag[NUM_BYTES_TAG];
+    memcpy(tag, overhead + NUM_BYTES_SALT + NUM_BYTES_COUNTER, NUM_BYTES_TAG);
+
+    auto dataBytes = reinterpret_cast<unsigned char*>(data);
+    int length = 0;
+
+    std::lock_guard<std::mutex> lock(_openLock);
+    return EVP_DecryptInit_ex(_openContext, nullptr, nullptr, nullptr, nonce) &&
+        EVP_DecryptUpdate(_openContext, nullptr, &length,
+                          reinterpret_cast<const unsigned char*>(associatedData), associatedDataLength) &&
+        EVP_DecryptUpdate(_openContext, dataBytes, &length, dataBytes, dataLength) &&
+        EVP_CIPHER_CTX_ctrl(_openContext, EVP_CTRL_GCM_SET_TAG, NUM_BYTES_TAG, tag) &&
+        EVP_DecryptFinal_ex(_openContext, dataBytes + length, &length) > 0;
+}
@@ -0,0 +1,71 @@
+//
+//  PacketCipher.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCipher_h
+#define hifi_PacketCipher_h
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <QtCore/QtGlobal>
+
+class QUuid;
+
+// Seals and opens packet payloads with AES-128-GCM, keyed from the connection secret of a pair of nodes.
+// The key schedule is set up once per secret and kept in the OpenSSL contexts, which use AES-NI and carry-less
+// multiplication where the CPU has them, so that a packet only costs setting its nonce and one pass over its payload.
+//   The nonce is the local ID of the sender, a random salt drawn each time the cipher is keyed and a counter of its
+// sealed packets, so that the two nodes of a pair, which share the key, never reuse a nonce, and neither does a node
+// that is removed and added again under the same secret, whose new cipher starts its counter over with a new salt.
+// The salt and the counter go out with each packet. A cipher refuses to seal once its counter is exhausted.
+//   To make room for the salt where the verification hash goes the tag is 64 bits, which GCM allows for packets
+// as short as these.
+class PacketCipher {
+public:
+    static const int NUM_BYTES_KEY = 16;
+    static const int NUM_BYTES_NONCE = 12;
+    static const int NUM_BYTES_SALT = sizeof(uint32_t);
+    static const int NUM_BYTES_COUNTER = sizeof(uint32_t);
+    static const int NUM_BYTES_TAG = 8;
+    // the salt, the counter and the tag take the place of the HMAC in the verification hash of the header
+    static const int NUM_BYTES_OVERHEAD = NUM_BYTES_SALT + NUM_BYTES_COUNTER + NUM_BYTES_TAG;
+
+    PacketCipher();
+    ~PacketCipher();
+
+    bool setKey(const QUuid& connectionSecret);
+
+    // encrypts the data in place and writes the salt, the counter and the tag of the packet to overhead,
+    // false if the cipher has no key or its counter is exhausted
+    bool seal(uint16_t senderID, const char* associatedData, int associatedDataLength,
+              char* data, int dataLength, char* overhead);
+
+    // decrypts the data in place, false if it or its associated data did not come sealed by this key from senderID
+    bool open(uint16_t senderID, const char* associatedData, int associatedDataLength,
+              char* data, int dataLength, const char* overhead);
+
+private:
+    Q_DISABLE_COPY(PacketCipher)
+
+    static void makeNonce(uint16_t senderID, uint32_t salt, uint32_t counter, unsigned char* nonce);
+
+    std::mutex _sealLock;
+    struct evp_cipher_ctx_st* _sealContext;
+    std::mutex _openLock;
+    struct evp_cipher_ctx_st* _openContext;
+
+    std::atomic<bool> _hasKey { false };
+    std::atomic<uint32_t> _salt { 0 };
+    std::atomic<uint64_t> _nextCounter { 0 };
+};
+
+#endif // hifi_PacketCipher_h
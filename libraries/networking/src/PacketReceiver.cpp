@@ -141,9 +141,9 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
         return;
     }
 
-    // setup an NLPacket from the packet we were passed
+    // setup an NLPacket from the packet we were passed, the message reads from it without copying its payload
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -157,8 +157,10 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
-        if (!message->isComplete()) {
+        if (nlPacket->getPacketPosition() == NLPacket::ONLY) {
+            message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
+        } else {
+            message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);  // Handler may handle first message packet immediately when it arrives.
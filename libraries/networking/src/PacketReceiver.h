@@ -69,6 +69,7 @@ public:
     PacketReceiver& operator=(const PacketReceiver&) = delete;
 
     void setShouldDropPackets(bool shouldDropPackets) { _shouldDropPackets = shouldDropPackets; }
+    bool shouldDropPackets() const { return _shouldDropPackets; }
 
     // If deliverPending is false, ReceivedMessage will only be delivered once all packets for the message have
     // been received. If deliverPending is true, ReceivedMessage will be delivered as soon as the first packet
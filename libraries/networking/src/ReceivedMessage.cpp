@@ -45,6 +45,28 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
+    if (!_isComplete) {
+        _notifier = std::make_unique<ReceivedMessageNotifier>();
+    }
+}
+
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet) :
+    _numPackets(1),
+    _sourceID(packet->getSourceID()),
+    _packetType(packet->getType()),
+    _packetVersion(packet->getVersion()),
+    _senderSockAddr(packet->getSenderSockAddr()),
+    _isComplete(true)
+{
+    Q_ASSERT_X(packet->getPacketPosition() == NLPacket::ONLY, "ReceivedMessage::ReceivedMessage",
+               "Only a single-packet message can reference its packet");
+
+    _firstPacketReceiveTime = duration_cast<microseconds>(packet->getReceiveTime().time_since_epoch()).count();
+
+    // nothing is appended to a complete message, so its head can reference the same payload
+    _data = QByteArray::fromRawData(packet->getPayload() + packet->pos(), packet->bytesLeftToRead());
+    _headData = QByteArray::fromRawData(_data.constData(), std::min(_data.size(), HEAD_DATA_SIZE));
+    _packet = std::move(packet);
 }
 
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
@@ -64,7 +86,9 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
 void ReceivedMessage::setFailed() {
     _failed = true;
     _isComplete = true;
-    emit completed();
+    if (_notifier) {
+        emit _notifier->completed();
+    }
 }
 
 void ReceivedMessage::appendPacket(NLPacket& packet) {
@@ -79,7 +103,7 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
     _data.append(packet.getPayload(), packet.getPayloadSize());
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
-        emit progress(getSize());
+        emit _notifier->progress(getSize());
     }
 
     auto packetPosition = packet.getPacketPosition();
@@ -90,7 +114,7 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     if (packetPosition == NLPacket::PacketPosition::LAST) {
         _isComplete = true;
-        emit completed();
+        emit _notifier->completed();
     }
 }
 
@@ -118,17 +142,17 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    return detached(_data, _position, size);
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = detached(_data, _position, size);
     _position += size;
     return data;
 }
 
 QByteArray ReceivedMessage::readHead(qint64 size) {
-    auto data = _headData.mid(_position, size);
+    auto data = detached(_headData, _position, size);
     _position += size;
     return data;
 }
@@ -152,7 +176,11 @@ QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
     return data;
 }
 
-void ReceivedMessage::onComplete() {
-    _isComplete = true;
-    emit completed();
+QByteArray ReceivedMessage::detached(const QByteArray& data, qint64 position, qint64 size) const {
+    auto result = data.mid(position, size);
+    if (_packet) {
+        // mid can hand back the raw data itself
+        result.detach();
+    }
+    return result;
 }
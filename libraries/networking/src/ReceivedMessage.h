@@ -18,18 +18,29 @@
 #include <QtCore/QSharedPointer>
 
 #include <atomic>
+#include <memory>
 
 #include "NLPacketList.h"
 
-class ReceivedMessage : public QObject {
+// Signals the progress of a message that arrives in several packets.  Messages that fit in one packet, which are nearly
+// all of them, go without so that they are not QObjects.
+class ReceivedMessageNotifier : public QObject {
     Q_OBJECT
+signals:
+    void progress(qint64 size);
+    void completed();
+};
+
+class ReceivedMessage {
 public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    // Takes the packet of a single-packet message and reads from its buffer rather than from a copy of its payload.
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const SockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
+    QByteArray getMessage() const { return detached(_data, 0, _data.size()); }
     const char* getRawMessage() const { return _data.constData(); }
 
     PacketType getType() const { return _packetType; }
@@ -83,14 +94,15 @@ public:
 
     template<typename T> qint64 readHeadPrimitive(T* data);
 
-signals:
-    void progress(qint64 size);
-    void completed();
-
-private slots:
-    void onComplete();
+    // Null unless the message was incomplete when it was created.
+    ReceivedMessageNotifier* getNotifier() const { return _notifier.get(); }
 
 private:
+    // A copy of part of data that does not reference the packet, which the caller could keep longer than the message.
+    QByteArray detached(const QByteArray& data, qint64 position, qint64 size) const;
+
+    // for a message made from a single packet, _data and _headData reference its payload
+    std::unique_ptr<NLPacket> _packet;
     QByteArray _data;
     QByteArray _headData;
 
@@ -105,6 +117,8 @@ private:
 
     std::atomic<bool> _isComplete { true };  
     std::atomic<bool> _failed { false };
+
+    std::unique_ptr<ReceivedMessageNotifier> _notifier;
 };
 
 Q_DECLARE_METATYPE(ReceivedMessage*)
@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -29,13 +30,66 @@
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+bool ResourceCacheSharedItems::isLowerPriority(const PendingRequest& a, const PendingRequest& b) {
+    if (a.isFile != b.isFile) {
+        return b.isFile;
+    }
+    if (a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return a.order > b.order;
+}
+
+QString ResourceCacheSharedItems::getHostKey(const QUrl& url) {
+    if (url.scheme() == HIFI_URL_SCHEME_HTTP || url.scheme() == HIFI_URL_SCHEME_HTTPS) {
+        return url.host() + ":" + QString::number(url.port(url.scheme() == HIFI_URL_SCHEME_HTTPS ? 443 : 80));
+    }
+    return QString();
+}
+
+uint32_t ResourceCacheSharedItems::getLoadingRequestsCount(const QString& host) const {
+    uint32_t count = 0;
+    for (const auto& request : _loadingRequests) {
+        if (request.host == host) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+bool ResourceCacheSharedItems::isHostFull(const QString& host) const {
+    return !host.isEmpty() && getLoadingRequestsCount(host) >= _requestLimitPerHost;
+}
+
+void ResourceCacheSharedItems::pushPendingRequest(const QSharedPointer<Resource>& resource) {
+    _pendingRequests.push_back({ resource, resource->getLoadPriority(), resource->getURL().scheme() == HIFI_URL_SCHEME_FILE,
+                                 _nextPendingOrder++ });
+    std::push_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
+}
+
+void ResourceCacheSharedItems::updatePendingPriorities() {
+    // priorities change all the time as owners move or go away, so they're read again when a request is picked
+    // after any of them changed, rather than moving each request in the heap as it changes
+    for (auto& request : _pendingRequests) {
+        auto resource = request.resource.lock();
+        request.priority = resource ? resource->getLoadPriority() : -FLT_MAX;
+    }
+    std::make_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    QString host = getHostKey(locked->getURL());
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && !isHostFull(host)) {
+        _loadingRequests.append({ resource, host });
         return true;
     } else {
-        _pendingRequests.append(resource);
+        pushPendingRequest(locked);
         return false;
     }
 }
@@ -50,12 +104,22 @@ uint32_t ResourceCacheSharedItems::getRequestLimit() const {
     return _requestLimit;
 }
 
+void ResourceCacheSharedItems::setRequestLimitPerHost(uint32_t limit) {
+    Lock lock(_mutex);
+    _requestLimitPerHost = limit;
+}
+
+uint32_t ResourceCacheSharedItems::getRequestLimitPerHost() const {
+    Lock lock(_mutex);
+    return _requestLimitPerHost;
+}
+
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _pendingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -66,15 +130,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return (uint32_t)_pendingRequests.size();
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -95,7 +159,7 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto request = _loadingRequests.at(i).resource;
         // Clear our resource and any freed resources
         if (!request || request.data() == resource.data()) {
             _loadingRequests.removeAt(i);
@@ -106,47 +170,114 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
     QSharedPointer<Resource> highestResource;
     Lock lock(_mutex);
 
-    bool currentHighestIsFile = false;
+    if (_pendingPrioritiesChanged.exchange(false)) {
+        updatePendingPriorities();
+    }
+
+    // requests for hosts that already have all the requests they're allowed wait for the next free slot
+    std::vector<PendingRequest> hostFullRequests;
+    while (!_pendingRequests.empty()) {
+        std::pop_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
+        PendingRequest request = _pendingRequests.back();
+        _pendingRequests.pop_back();
 
-    for (int i = 0; i < _pendingRequests.size();) {
         // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
+        auto resource = request.resource.lock();
         if (!resource) {
-            _pendingRequests.removeAt(i);
             continue;
         }
-
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        if (isHostFull(getHostKey(resource->getURL()))) {
+            hostFullRequests.push_back(request);
+            continue;
         }
-        i++;
+        highestResource = resource;
+        break;
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    for (const auto& request : hostFullRequests) {
+        _pendingRequests.push_back(request);
+        std::push_heap(_pendingRequests.begin(), _pendingRequests.end(), isLowerPriority);
     }
 
     return highestResource;
 }
 
+QSharedPointer<Resource> ResourceCacheSharedItems::getRequestToPreempt(const QSharedPointer<Resource>& pendingRequest) {
+    Lock lock(_mutex);
+
+    // only a request whose slot the pending one could take
+    QString host = getHostKey(pendingRequest->getURL());
+    bool isFull = (uint32_t)_loadingRequests.size() >= _requestLimit;
+    bool hostFull = isHostFull(host);
+    if (!isFull && !hostFull) {
+        return QSharedPointer<Resource>();
+    }
+
+    float lowestPriority = pendingRequest->getLoadPriority();
+    LoadingRequest* lowestRequest = nullptr;
+    QSharedPointer<Resource> lowestResource;
+    for (auto& request : _loadingRequests) {
+        if (request.preempted || (hostFull && request.host != host)) {
+            continue;
+        }
+        auto resource = request.resource.lock();
+        if (!resource || !resource->canPreemptRequest()) {
+            continue;
+        }
+        float priority = resource->getLoadPriority();
+        if (priority < lowestPriority) {
+            lowestPriority = priority;
+            lowestRequest = &request;
+            lowestResource = resource;
+        }
+    }
+
+    if (lowestRequest) {
+        lowestRequest->preempted = true;
+    }
+    return lowestResource;
+}
+
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
     _loadingRequests.clear();
 }
 
+ResourceCacheSharedItems::ResourceCacheSharedItems() {
+    qint64 totalMemory = (qint64)getTotalPhysicalMemory();
+    if (totalMemory > 0) {
+        _unusedResourcesBudget = glm::clamp(totalMemory / UNUSED_RESOURCES_BUDGET_MEMORY_DIVISOR, MIN_UNUSED_RESOURCES_BUDGET,
+                                            MAX_UNUSED_MAX_SIZE);
+    }
+}
+
+void ResourceCacheSharedItems::addCache(ResourceCache* cache) {
+    Lock lock(_mutex);
+    if (!_caches.contains(cache)) {
+        _caches.append(cache);
+    }
+}
+
+void ResourceCacheSharedItems::removeCache(ResourceCache* cache) {
+    Lock lock(_mutex);
+    _caches.removeAll(cache);
+}
+
+QList<ResourceCache*> ResourceCacheSharedItems::getCaches() const {
+    Lock lock(_mutex);
+    return _caches;
+}
+
+void ResourceCacheSharedItems::advanceEvictionClock(double priority) {
+    double clock = _evictionClock;
+    while (priority > clock && !_evictionClock.compare_exchange_weak(clock, priority)) {
+    }
+}
+
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
     _resourceCache = resourceCache;
     connect(&(*_resourceCache), &ResourceCache::dirty,
@@ -262,6 +393,9 @@ ResourceCache::ResourceCache(QObject* parent) : QObject(parent) {
 }
 
 ResourceCache::~ResourceCache() {
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->removeCache(this);
+    }
     clearUnusedResources();
 }
 
@@ -287,7 +421,7 @@ void ResourceCache::clearATPAssets() {
         QWriteLocker locker(&_unusedResourcesLock);
         for (auto& resource : _unusedResources.values()) {
             if (resource->getURL().scheme() == URL_SCHEME_ATP) {
-                _unusedResources.remove(resource->getLRUKey());
+                _unusedResources.remove(getUnusedResourceKey(resource));
                 _unusedResourcesSize -= resource->getBytes();
             }
         }
@@ -344,9 +478,11 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
     sharedItems->setRequestLimit(limit);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, the pending requests left may all be for hosts at their limit
     while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -419,11 +555,21 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
     }
     reserveUnusedResource(resource->getBytes());
 
+    // the resources slowest to load again, per byte they take, are kept the longest
+    double evictionClock = 0.0;
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        // caches can be set up before the shared items, so they join the shared budget once they have resources in it
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        sharedItems->addCache(this);
+        evictionClock = sharedItems->getEvictionClock();
+    }
+    double megabytes = (double)resource->getBytes() / BYTES_PER_MEGABYTES;
+    resource->setEvictionPriority(evictionClock + resource->getReloadTime() / megabytes);
     resource->setLRUKey(++_lastLRUKey);
 
     {
         QWriteLocker locker(&_unusedResourcesLock);
-        _unusedResources.insert(resource->getLRUKey(), resource);
+        _unusedResources.insert(getUnusedResourceKey(resource), resource);
         _unusedResourcesSize += resource->getBytes();
     }
 
@@ -432,8 +578,10 @@ void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource)
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
     QWriteLocker locker(&_unusedResourcesLock);
-    if (_unusedResources.contains(resource->getLRUKey())) {
-        _unusedResources.remove(resource->getLRUKey());
+    auto key = getUnusedResourceKey(resource);
+    auto it = _unusedResources.find(key);
+    if (it != _unusedResources.end() && it.value() == resource) {
+        _unusedResources.erase(it);
         _unusedResourcesSize -= resource->getBytes();
 
         locker.unlock();
@@ -441,23 +589,69 @@ void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resourc
     }
 }
 
+ResourceCache::UnusedResourceKey ResourceCache::getUnusedResourceKey(const QSharedPointer<Resource>& resource) {
+    return { resource->getEvictionPriority(), resource->getLRUKey() };
+}
+
 void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
-        // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
+    // make room within this cache's own limit
+    while (_unusedResourcesSize + resourceSize > _unusedResourcesMaxSize && evictUnusedResource()) {
+    }
 
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
+    if (!DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        return;
+    }
 
-        locker.unlock();
-        removeResource(it.value()->getURL(), it.value()->getExtraHash(), size);
-        locker.relock();
+    // then within the budget all the caches share, evicting whichever of their resources is cheapest to lose
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    while (true) {
+        qint64 totalSize = resourceSize;
+        ResourceCache* evictingCache = nullptr;
+        double lowestPriority = std::numeric_limits<double>::max();
+        for (auto cache : sharedItems->getCaches()) {
+            totalSize += cache->_unusedResourcesSize;
+            double priority = cache->getLowestEvictionPriority();
+            if (priority < lowestPriority) {
+                lowestPriority = priority;
+                evictingCache = cache;
+            }
+        }
 
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
+        if (totalSize <= sharedItems->getUnusedResourcesBudget() || !evictingCache ||
+            !evictingCache->evictUnusedResource()) {
+            break;
+        }
+        if (evictingCache != this) {
+            evictingCache->resetUnusedResourceCounter();
+        }
+    }
+}
+
+bool ResourceCache::evictUnusedResource() {
+    QWriteLocker locker(&_unusedResourcesLock);
+    if (_unusedResources.empty()) {
+        return false;
+    }
+
+    auto it = _unusedResources.begin();
+    QSharedPointer<Resource> resource = it.value();
+    _unusedResources.erase(it);
+    auto size = resource->getBytes();
+    _unusedResourcesSize -= size;
+    locker.unlock();
+
+    if (DependencyManager::isSet<ResourceCacheSharedItems>()) {
+        DependencyManager::get<ResourceCacheSharedItems>()->advanceEvictionClock(resource->getEvictionPriority());
     }
+
+    resource->setCache(nullptr);
+    removeResource(resource->getURL(), resource->getExtraHash(), size);
+    return true;
+}
+
+double ResourceCache::getLowestEvictionPriority() {
+    QReadLocker locker(&_unusedResourcesLock);
+    return _unusedResources.empty() ? std::numeric_limits<double>::max() : _unusedResources.firstKey().first;
 }
 
 void ResourceCache::clearUnusedResources() {
@@ -530,7 +724,7 @@ uint32_t ResourceCache::getLoadingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount();
 }
 
-bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
+bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource, bool allowPreemption) {
     Q_ASSERT(!resource.isNull());
 
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
@@ -538,6 +732,12 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
         resource->makeRequest();
         return true;
     }
+
+    // rather than wait behind a less important range request, stop it so it can resume once there's room again
+    auto preempted = allowPreemption ? sharedItems->getRequestToPreempt(resource) : QSharedPointer<Resource>();
+    if (preempted) {
+        QMetaObject::invokeMethod(preempted.data(), "preemptRequest", Qt::QueuedConnection);
+    }
     return false;
 }
 
@@ -546,9 +746,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, the pending requests left may all be for hosts at their limit
     while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -606,7 +808,11 @@ void Resource::ensureLoading() {
 
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
-        _loadPriorities.insert(owner, priority);
+        auto found = _loadPriorities.find(owner);
+        if (found == _loadPriorities.end() || found.value() != priority) {
+            _loadPriorities.insert(owner, priority);
+            loadPrioritiesChanged();
+        }
     }
 }
 
@@ -618,11 +824,21 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    loadPrioritiesChanged();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
-    if (!_failedToLoad) {
-        _loadPriorities.remove(owner);
+    if (!_failedToLoad && _loadPriorities.remove(owner) > 0) {
+        loadPrioritiesChanged();
+    }
+}
+
+void Resource::loadPrioritiesChanged() {
+    // only a queued request needs reordering
+    if (_startedLoading && !_request) {
+        if (auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>()) {
+            sharedItems->pendingPrioritiesChanged();
+        }
     }
 }
 
@@ -776,6 +992,24 @@ void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTota
     _bytesTotal = bytesTotal;
 }
 
+float Resource::getReloadTime() const {
+    // rough latencies and throughputs of loading from a local file, the disk cache and the network
+    const float LOCAL_LATENCY = 0.001f;
+    const float LOCAL_THROUGHPUT = 500.0f * BYTES_PER_MEGABYTES;
+    const float DISK_CACHE_LATENCY = 0.005f;
+    const float DISK_CACHE_THROUGHPUT = 200.0f * BYTES_PER_MEGABYTES;
+    const float NETWORK_LATENCY = 0.25f;
+    const float NETWORK_THROUGHPUT = 5.0f * BYTES_PER_MEGABYTES;
+
+    auto scheme = _url.scheme();
+    if (scheme == HIFI_URL_SCHEME_FILE || scheme == URL_SCHEME_QRC || scheme == URL_SCHEME_DATA) {
+        return LOCAL_LATENCY + (float)_bytes / LOCAL_THROUGHPUT;
+    } else if (_loadedFromCache) {
+        return DISK_CACHE_LATENCY + (float)_bytes / DISK_CACHE_THROUGHPUT;
+    }
+    return NETWORK_LATENCY + (float)_bytes / NETWORK_THROUGHPUT;
+}
+
 void Resource::handleReplyFinished() {
     if (!_request || _request != sender()) {
         // This can happen in the edge case that a request is timed out, but a `finished` signal is emitted before it is deleted.
@@ -800,6 +1034,7 @@ void Resource::handleReplyFinished() {
 
     auto result = _request->getResult();
     if (result == ResourceRequest::Success) {
+        _loadedFromCache = _request->loadedFromCache();
 
         auto relativePathURL = _request->getRelativePathUrl();
         if (!relativePathURL.isEmpty()) {
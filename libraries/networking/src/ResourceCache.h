@@ -13,7 +13,10 @@
 #define hifi_ResourceCache_h
 
 #include <atomic>
+#include <limits>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -40,6 +43,7 @@ class QNetworkReply;
 class QTimer;
 
 class Resource;
+class ResourceCache;
 
 static const qint64 BYTES_PER_MEGABYTES = 1024 * 1024;
 static const qint64 BYTES_PER_GIGABYTES = 1024 * BYTES_PER_MEGABYTES;
@@ -55,6 +59,10 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+// the unused resources of all the caches together are kept to a share of the physical memory
+static const qint64 UNUSED_RESOURCES_BUDGET_MEMORY_DIVISOR = 8;
+static const qint64 MIN_UNUSED_RESOURCES_BUDGET = 128 * BYTES_PER_MEGABYTES;
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
@@ -70,21 +78,72 @@ public:
     void removeRequest(QWeakPointer<Resource> doneRequest);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
+    void setRequestLimitPerHost(uint32_t limit);
+    uint32_t getRequestLimitPerHost() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getPendingRequestsCount() const;
     QList<QSharedPointer<Resource>> getLoadingRequests() const;
     uint32_t getLoadingRequestsCount() const;
+    /// Returns a loading request of lower priority than the pending one that can be stopped to give it its slot, if any.
+    QSharedPointer<Resource> getRequestToPreempt(const QSharedPointer<Resource>& pendingRequest);
+    /// Marks the pending requests to be reordered, as their load priorities changed.
+    void pendingPrioritiesChanged() { _pendingPrioritiesChanged = true; }
     void clear();
 
+    /// The caches whose unused resources share the budget.
+    void addCache(ResourceCache* cache);
+    void removeCache(ResourceCache* cache);
+    QList<ResourceCache*> getCaches() const;
+
+    /// How many bytes of unused resources all the caches together can keep, by default a share of the physical memory.
+    void setUnusedResourcesBudget(qint64 budget) { _unusedResourcesBudget = budget; }
+    qint64 getUnusedResourcesBudget() const { return _unusedResourcesBudget; }
+
+    /// The eviction priority of the last unused resource evicted, which the priority of those added next starts from,
+    /// so the longer a resource goes unused the more likely it is to be evicted.
+    double getEvictionClock() const { return _evictionClock; }
+    void advanceEvictionClock(double priority);
+
 private:
-    ResourceCacheSharedItems() = default;
+    ResourceCacheSharedItems();
+
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        float priority;
+        bool isFile;
+        uint64_t order;
+    };
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        QString host;
+        bool preempted { false };
+    };
+
+    // the pending requests are a heap with local files first, then the highest load priority, then the oldest
+    static bool isLowerPriority(const PendingRequest& a, const PendingRequest& b);
+    // requests are only limited per host for http(s), for other schemes this is empty
+    static QString getHostKey(const QUrl& url);
+
+    void pushPendingRequest(const QSharedPointer<Resource>& resource);
+    void updatePendingPriorities();
+    uint32_t getLoadingRequestsCount(const QString& host) const;
+    bool isHostFull(const QString& host) const;
 
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    std::vector<PendingRequest> _pendingRequests;
+    QList<LoadingRequest> _loadingRequests;
+    uint64_t _nextPendingOrder { 0 };
+    std::atomic<bool> _pendingPrioritiesChanged { false };
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
+    const uint32_t DEFAULT_REQUEST_LIMIT_PER_HOST = 6;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+    uint32_t _requestLimitPerHost { DEFAULT_REQUEST_LIMIT_PER_HOST };
+
+    QList<ResourceCache*> _caches;
+    std::atomic<qint64> _unusedResourcesBudget { DEFAULT_UNUSED_MAX_SIZE };
+    std::atomic<double> _evictionClock { 0.0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -266,9 +325,10 @@ protected:
     void addUnusedResource(const QSharedPointer<Resource>& resource);
     void removeUnusedResource(const QSharedPointer<Resource>& resource);
 
-    /// Attempt to load a resource if requests are below the limit, otherwise queue the resource for loading
+    /// Attempt to load a resource if requests are below the limit, otherwise queue the resource for loading, stopping a
+    /// less important request that can be resumed later if allowed to
     /// \return true if the resource began loading, otherwise false if the resource is in the pending queue
-    static bool attemptRequest(QSharedPointer<Resource> resource);
+    static bool attemptRequest(QSharedPointer<Resource> resource, bool allowPreemption = true);
     static void requestCompleted(QWeakPointer<Resource> resource);
     static bool attemptHighestPriorityRequest();
 
@@ -276,7 +336,14 @@ private:
     friend class Resource;
     friend class ScriptableResourceCache;
 
+    using UnusedResourceKey = std::pair<double, int>;
+
     void reserveUnusedResource(qint64 resourceSize);
+    static UnusedResourceKey getUnusedResourceKey(const QSharedPointer<Resource>& resource);
+    /// Evicts the unused resource with the lowest eviction priority, false if there are none.
+    bool evictUnusedResource();
+    /// The lowest eviction priority of the unused resources, or the largest double if there are none.
+    double getLowestEvictionPriority();
     void removeResource(const QUrl& url, size_t extraHash, qint64 size = 0);
 
     void resetTotalResourceCounter();
@@ -291,8 +358,8 @@ private:
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
 
-    // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
+    // Cached resources, the ones cheapest to lose first: by eviction priority, then least recently used
+    QMap<UnusedResourceKey, QSharedPointer<Resource>> _unusedResources;
     QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
     qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
 
@@ -420,6 +487,13 @@ public:
     /// Returns the key last used to identify this resource in the unused map.
     int getLRUKey() const { return _lruKey; }
 
+    /// Returns the eviction priority this resource was given when last added to the unused map: the eviction clock then,
+    /// plus how long loading it again would take per megabyte.
+    double getEvictionPriority() const { return _evictionPriority; }
+
+    /// Estimates how long loading the resource again would take, in seconds, from where it would be loaded from.
+    virtual float getReloadTime() const;
+
     /// Makes sure that the resource has started loading.
     void ensureLoading();
 
@@ -435,6 +509,9 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Checks whether the request in flight can be stopped, to be queued again, to make room for a more important one.
+    virtual bool canPreemptRequest() const { return false; }
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -497,6 +574,10 @@ signals:
 protected slots:
     void attemptRequest();
 
+    /// Stops the request in flight and queues it again. Only called when canPreemptRequest() is true, overrides should
+    /// call ResourceCache::requestCompleted and ResourceCache::attemptRequest like a finished request would.
+    virtual void preemptRequest() {}
+
 protected:
     virtual void init(bool resetLoaded = true);
 
@@ -559,14 +640,18 @@ private:
     friend class ScriptableResource;
 
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
+    void setEvictionPriority(double evictionPriority) { _evictionPriority = evictionPriority; }
 
     void retry();
     void reinsert();
+    void loadPrioritiesChanged();
 
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
 
     int _lruKey{ 0 };
+    double _evictionPriority { 0.0 };
+    bool _loadedFromCache { false };
     QTimer* _replyTimer{ nullptr };
     unsigned int _attempts{ 0 };
     static const int MAX_ATTEMPTS = 8;
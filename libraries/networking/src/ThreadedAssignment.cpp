@@ -22,6 +22,8 @@
 
 #include <platform/Platform.h>
 #include "NetworkLogging.h"
+#include "NodeTelemetry.h"
+#include "udt/PacketBufferPool.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -104,6 +106,30 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
 
     // stop sending stats if we disconnect
     connect(&nodeList->getDomainHandler(), &DomainHandler::disconnectedFromDomain, &_statsTimer, &QTimer::stop);
+
+    // pick up the socket settings for this assignment type whenever the domain sends us settings
+    connect(&nodeList->getDomainHandler(), &DomainHandler::settingsReceived, this, &ThreadedAssignment::applyNetworkingSettings);
+}
+
+void ThreadedAssignment::applyNetworkingSettings(const QJsonObject& domainSettingsObject) {
+    // "networking": { "congestion_control": { "default": "vegas", "asset_server": "bbr", ... } }
+    // where the per-type keys are the lower-case, underscored node type names
+    static const QString NETWORKING_SETTINGS_KEY = "networking";
+    static const QString CONGESTION_CONTROL_KEY = "congestion_control";
+    static const QString DEFAULT_KEY = "default";
+
+    auto congestionControlObject = domainSettingsObject[NETWORKING_SETTINGS_KEY].toObject()[CONGESTION_CONTROL_KEY].toObject();
+    if (congestionControlObject.isEmpty()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    QString typeKey = NodeType::getNodeTypeName(nodeList->getOwnerType()).toLower().replace(' ', '_');
+
+    QString congestionControl = congestionControlObject[typeKey].toString(congestionControlObject[DEFAULT_KEY].toString());
+    if (!congestionControl.isEmpty()) {
+        nodeList->setCongestionControl(congestionControl);
+    }
 }
 
 void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObject) {
@@ -119,6 +145,21 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
+    auto datagramStats = nodeList->sampleDatagramStats();
+    ioStats["datagrams_per_read_call"] = datagramStats.readCalls > 0 ?
+        (float)datagramStats.datagramsRead / datagramStats.readCalls : 0.0f;
+    ioStats["datagrams_per_write_call"] = datagramStats.writeCalls > 0 ?
+        (float)datagramStats.datagramsWritten / datagramStats.writeCalls : 0.0f;
+
+    auto bufferPoolStats = udt::PacketBufferPool::getStats();
+    QJsonObject bufferPool;
+    bufferPool["allocations"] = (double)bufferPoolStats.allocations;
+    bufferPool["misses"] = (double)bufferPoolStats.misses;
+    bufferPool["oversized"] = (double)bufferPoolStats.oversized;
+    bufferPool["pooled"] = (double)bufferPoolStats.pooled;
+    bufferPool["outstanding"] = (double)bufferPoolStats.outstanding;
+    ioStats["packet_buffer_pool"] = bufferPool;
+
     statsObject["io_stats"] = ioStats;
 
     QJsonObject assignmentStats;
@@ -127,6 +168,25 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     statsObject["assignmentStats"] = assignmentStats;
 
     nodeList->sendStatsToDomainServer(statsObject);
+
+    // the connections' figures of the last second, one sample per node
+    int numNodes = 0;
+    nodeList->eachNode([&numNodes](const SharedNodePointer& node) {
+        NodeTelemetry::recordValue("node_inbound_kbps", (uint64_t)node->getInboundKbps());
+        NodeTelemetry::recordValue("node_outbound_kbps", (uint64_t)node->getOutboundKbps());
+        const auto& connectionStats = node->getConnectionStats();
+        NodeTelemetry::recordValue("node_send_queue_depth_packets", (uint64_t)std::max(connectionStats.sendQueueDepth, 0));
+        NodeTelemetry::recordValue("node_rtt_usecs", (uint64_t)std::max(connectionStats.rtt, 0));
+        ++numNodes;
+    });
+    NodeTelemetry::setGauge("nodes", numNodes);
+    NodeTelemetry::setGauge("inbound_kbps", nodeList->getInboundKbps());
+    NodeTelemetry::setGauge("outbound_kbps", nodeList->getOutboundKbps());
+
+    QByteArray telemetry = NodeTelemetry::takeSnapshot();
+    if (!telemetry.isEmpty()) {
+        nodeList->sendTelemetryToDomainServer(telemetry);
+    }
 }
 
 void ThreadedAssignment::sendStatsPacket() {
@@ -54,6 +54,7 @@ protected slots:
 
 private slots:
     void checkInWithDomainServerOrExit();
+    void applyNetworkingSettings(const QJsonObject& domainSettingsObject);
 };
 
 typedef QSharedPointer<ThreadedAssignment> SharedAssignmentPointer;
@@ -0,0 +1,335 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2/ln(2), the smallest gain that can double the delivery rate every round trip
+static const double BBR_HIGH_GAIN = 2.885;
+static const double BBR_PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+static const double BBR_PACING_GAIN_CYCLE[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int BBR_PACING_GAIN_CYCLE_LENGTH = sizeof(BBR_PACING_GAIN_CYCLE) / sizeof(BBR_PACING_GAIN_CYCLE[0]);
+
+static const int BBR_BANDWIDTH_FILTER_ROUNDS = 10;
+static const auto BBR_MIN_RTT_WINDOW = seconds(10);
+static const auto BBR_PROBE_RTT_DURATION = milliseconds(200);
+
+// the pipe is considered full once three rounds pass without the bandwidth estimate growing by 25%
+static const double BBR_FULL_BANDWIDTH_GROWTH = 1.25;
+static const int BBR_FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int BBR_INITIAL_WINDOW_PACKETS = 10;
+static const int BBR_MIN_WINDOW_PACKETS = 4;
+
+static const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+BBRCC::BBRCC() :
+    _pacingGain(BBR_HIGH_GAIN),
+    _windowGain(BBR_HIGH_GAIN)
+{
+    // no pacing until we have a first bandwidth sample, the window alone limits the initial burst
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = BBR_INITIAL_WINDOW_PACKETS;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    bool wasDuplicateACK = (ack == previousAck);
+
+    _isRoundStart = false;
+
+    // the min RTT filter expiring both lets the next sample replace it and triggers ProbeRTT below
+    _minRTTExpired = _minRTT != -1 && receiveTime > _minRTTTimestamp + BBR_MIN_RTT_WINDOW;
+
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& packetTime){
+        return packetTime.sequenceNumber == ack;
+    });
+
+    if (!wasDuplicateACK && it != _sentPacketDatas.end()) {
+        // the RTT sample is only unambiguous if none of the packets covered by this ACK were re-sent
+        bool canBeUsedForRTT = std::none_of(_sentPacketDatas.begin(), it + 1, [](SentPacketData& sentPacketData) {
+            return sentPacketData.wasResent;
+        });
+
+        SentPacketData newestAcked = *it;
+        int numNewlyDelivered = (int)std::distance(_sentPacketDatas.begin(), it) + 1;
+
+        // remove all sent packet data up to this sequence number
+        _sentPacketDatas.erase(_sentPacketDatas.begin(), it + 1);
+
+        _delivered += numNewlyDelivered;
+        _deliveredTime = receiveTime;
+
+        // a round trip ends when a packet sent after the previous round ended is ACKed
+        if (newestAcked.delivered >= _nextRoundDelivered) {
+            _nextRoundDelivered = _delivered;
+            ++_roundCount;
+            _isRoundStart = true;
+        }
+
+        if (canBeUsedForRTT) {
+            updateRTT((int)duration_cast<microseconds>(receiveTime - newestAcked.timePoint).count(), receiveTime);
+        }
+
+        // delivery rate over the interval between sending the newest ACKed packet and receiving its ACK
+        auto interval = duration_cast<microseconds>(receiveTime - newestAcked.deliveredTime).count();
+        if (interval > 0) {
+            updateBandwidth((double)(_delivered - newestAcked.delivered) * USECS_PER_SECOND / interval);
+        }
+    }
+
+    if (_isRoundStart) {
+        checkFullPipe();
+    }
+
+    updateMode(receiveTime);
+    updateControlParameters();
+
+    // BBR does not treat loss as a congestion signal, but lost packets still need a timely re-send
+    ++_numACKSinceFastRetransmit;
+    if (wasDuplicateACK || _numACKSinceFastRetransmit < 3) {
+        return needsFastRetransmit(ack, wasDuplicateACK);
+    } else {
+        _duplicateACKCount = 0;
+    }
+
+    return false;
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now) {
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+
+    rtt = std::max(1, std::min(rtt, MAX_RTT_SAMPLE_MICROSECONDS));
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        // same Jacobson estimate as TCPVegasCC, only used for the re-transmit timeout
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    if (_minRTT == -1 || rtt <= _minRTT || _minRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::updateBandwidth(double deliveryRate) {
+    // windowed max filter over the last BBR_BANDWIDTH_FILTER_ROUNDS round trips
+    while (!_bandwidthSamples.empty() && _bandwidthSamples.back().second <= deliveryRate) {
+        _bandwidthSamples.pop_back();
+    }
+    _bandwidthSamples.emplace_back(_roundCount, deliveryRate);
+
+    while (_bandwidthSamples.front().first + BBR_BANDWIDTH_FILTER_ROUNDS <= _roundCount) {
+        _bandwidthSamples.pop_front();
+    }
+
+    _bottleneckBandwidth = _bandwidthSamples.front().second;
+}
+
+void BBRCC::checkFullPipe() {
+    if (_isPipeFull) {
+        return;
+    }
+
+    if (_bottleneckBandwidth >= _fullBandwidth * BBR_FULL_BANDWIDTH_GROWTH) {
+        // still growing, keep probing
+        _fullBandwidth = _bottleneckBandwidth;
+        _fullBandwidthRounds = 0;
+    } else if (++_fullBandwidthRounds >= BBR_FULL_BANDWIDTH_ROUNDS) {
+        _isPipeFull = true;
+    }
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now) {
+    int inFlight = (int)_sentPacketDatas.size();
+
+    switch (_mode) {
+        case Mode::Startup:
+            if (_isPipeFull) {
+                _mode = Mode::Drain;
+                _pacingGain = 1.0 / BBR_HIGH_GAIN;
+                _windowGain = BBR_HIGH_GAIN;
+            }
+            break;
+        case Mode::Drain:
+            // handled below, so that startup can hand over to drain and on to probing in a single ACK
+            break;
+        case Mode::ProbeBandwidth: {
+            // move through the gain cycle once per min RTT, the drain phase can end early once the queue is gone
+            bool shouldAdvance = _minRTT != -1 && now - _cycleStart > microseconds(_minRTT);
+            if (_pacingGain < 1.0 && inFlight <= bandwidthDelayProduct(1.0)) {
+                shouldAdvance = true;
+            }
+
+            if (shouldAdvance) {
+                _cycleIndex = (_cycleIndex + 1) % BBR_PACING_GAIN_CYCLE_LENGTH;
+                _cycleStart = now;
+                _pacingGain = BBR_PACING_GAIN_CYCLE[_cycleIndex];
+            }
+            break;
+        }
+        case Mode::ProbeRTT:
+            if (_probeRTTDoneTime == p_high_resolution_clock::time_point()) {
+                // wait until the window has drained to the minimum before starting the probe
+                if (inFlight <= BBR_MIN_WINDOW_PACKETS) {
+                    _probeRTTDoneTime = now + BBR_PROBE_RTT_DURATION;
+                    _probeRTTRoundDone = false;
+                    _nextRoundDelivered = _delivered;
+                }
+            } else {
+                if (_isRoundStart) {
+                    _probeRTTRoundDone = true;
+                }
+
+                if (_probeRTTRoundDone && now > _probeRTTDoneTime) {
+                    _minRTTTimestamp = now;
+                    _congestionWindowSize = std::max(_congestionWindowSize, _priorWindowSize);
+
+                    if (_isPipeFull) {
+                        _mode = Mode::ProbeBandwidth;
+                        _cycleStart = now;
+                        _pacingGain = BBR_PACING_GAIN_CYCLE[_cycleIndex];
+                        _windowGain = BBR_PROBE_BANDWIDTH_WINDOW_GAIN;
+                    } else {
+                        _mode = Mode::Startup;
+                        _pacingGain = BBR_HIGH_GAIN;
+                        _windowGain = BBR_HIGH_GAIN;
+                    }
+                }
+            }
+            break;
+    }
+
+    if (_mode == Mode::Drain && inFlight <= bandwidthDelayProduct(1.0)) {
+        // the queue built during startup is gone, start cycling around the estimated bandwidth
+        // starting at a random phase other than the probing one so connections don't probe in lockstep
+        _mode = Mode::ProbeBandwidth;
+        _cycleIndex = 2 + (int)(_delivered % (BBR_PACING_GAIN_CYCLE_LENGTH - 2));
+        _cycleStart = now;
+        _pacingGain = BBR_PACING_GAIN_CYCLE[_cycleIndex];
+        _windowGain = BBR_PROBE_BANDWIDTH_WINDOW_GAIN;
+    }
+
+    if (_minRTTExpired && _mode != Mode::ProbeRTT) {
+        // we haven't seen a new min RTT in a while, drain the queue to re-measure the propagation delay
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _windowGain = 1.0;
+        _priorWindowSize = _congestionWindowSize;
+        _probeRTTDoneTime = p_high_resolution_clock::time_point();
+        _probeRTTRoundDone = false;
+    }
+}
+
+void BBRCC::updateControlParameters() {
+    if (_bottleneckBandwidth > 0.0) {
+        // pace at the gain-adjusted bottleneck bandwidth, respecting any maximum bandwidth set on the connection
+        setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, BBR_MIN_WINDOW_PACKETS);
+    } else if (_minRTT != -1 && _bottleneckBandwidth > 0.0) {
+        int targetWindowSize = bandwidthDelayProduct(_windowGain);
+
+        if (_isPipeFull) {
+            _congestionWindowSize = targetWindowSize;
+        } else {
+            // never shrink the window while still searching for the bottleneck
+            _congestionWindowSize = std::max(_congestionWindowSize, targetWindowSize);
+        }
+    }
+
+    _congestionWindowSize = std::max(BBR_MIN_WINDOW_PACKETS, std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT));
+}
+
+int BBRCC::bandwidthDelayProduct(double gain) const {
+    if (_minRTT == -1 || _bottleneckBandwidth <= 0.0) {
+        return BBR_INITIAL_WINDOW_PACKETS;
+    }
+
+    return (int)std::ceil(gain * _bottleneckBandwidth * _minRTT / USECS_PER_SECOND);
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK) {
+    // we may need to re-send ackNum + 1 if it has been more than our estimated timeout since it was sent
+    auto nextIt = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& packetTime){
+        return packetTime.sequenceNumber == ack + 1;
+    });
+
+    if (nextIt != _sentPacketDatas.end()) {
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - nextIt->timePoint).count();
+
+        if (sinceSend >= estimatedTimeout()) {
+            _numACKSinceFastRetransmit = 0;
+            return true;
+        }
+    }
+
+    static const int FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    ++_duplicateACKCount;
+
+    if (wasDuplicateACK && _duplicateACKCount == FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _numACKSinceFastRetransmit = 0;
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing is in flight, so the next delivery rate interval starts now rather than at the last ACK
+        // this keeps idle periods from dragging the bandwidth estimate down
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.emplace_back(seqNum, timePoint, _delivered, _deliveredTime);
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketInfo){
+        return sentPacketInfo.sequenceNumber == seqNum;
+    });
+
+    // re-sent packets can't be used for RTT samples since we won't know which send the ACK is for
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
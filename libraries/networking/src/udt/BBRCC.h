@@ -0,0 +1,119 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <deque>
+#include <vector>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Bottleneck bandwidth and round-trip propagation time congestion control, modelled on BBR v1
+// (https://queue.acm.org/detail.cfm?id=3022184).
+// Instead of backing off on delay growth like TCPVegasCC, it builds a model of the path from delivery rate
+// and minimum RTT samples, paces at the estimated bottleneck bandwidth and caps the window at a small multiple
+// of the bandwidth-delay product. This keeps long, slightly lossy paths full where Vegas would stall.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override {};
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+    virtual int estimatedBandwidth() const override { return (int)_bottleneckBandwidth; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup,
+        Drain,
+        ProbeBandwidth,
+        ProbeRTT
+    };
+
+    struct SentPacketData {
+        SentPacketData(SequenceNumber seqNum, p_high_resolution_clock::time_point tPoint,
+                       int64_t delivered, p_high_resolution_clock::time_point deliveredTime) :
+            sequenceNumber(seqNum), timePoint(tPoint), delivered(delivered), deliveredTime(deliveredTime) {};
+
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        int64_t delivered; // value of _delivered when this packet was sent
+        p_high_resolution_clock::time_point deliveredTime; // value of _deliveredTime when this packet was sent
+        bool wasResent { false };
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now);
+    void updateBandwidth(double deliveryRate);
+    void checkFullPipe();
+    void updateMode(p_high_resolution_clock::time_point now);
+    void updateControlParameters();
+    bool needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK);
+
+    int bandwidthDelayProduct(double gain) const;
+
+    using PacketTimeList = std::vector<SentPacketData>;
+    PacketTimeList _sentPacketDatas; // sent packets awaiting an ACK, in send order
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _windowGain;
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+
+    int64_t _delivered { 0 }; // Number of packets ACKed during the connection
+    p_high_resolution_clock::time_point _deliveredTime; // Time at which _delivered was last increased
+
+    int64_t _roundCount { 0 }; // Number of round trips since the connection started
+    int64_t _nextRoundDelivered { 0 }; // _delivered value that marks the end of the current round trip
+    bool _isRoundStart { false };
+
+    using BandwidthSample = std::pair<int64_t, double>; // round count, packets per second
+    std::deque<BandwidthSample> _bandwidthSamples; // monotonic deque for the windowed max bandwidth filter
+    double _bottleneckBandwidth { 0.0 }; // Windowed max delivery rate, in packets per second
+
+    int _minRTT { -1 }; // Windowed min RTT, in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+    bool _minRTTExpired { false };
+
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT, used for the retransmit timeout
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    double _fullBandwidth { 0.0 }; // Bandwidth at the last time it grew by at least BBR_FULL_BANDWIDTH_GROWTH
+    int _fullBandwidthRounds { 0 }; // Rounds without significant bandwidth growth
+    bool _isPipeFull { false };
+
+    int _cycleIndex { 0 }; // Position in the ProbeBandwidth pacing gain cycle
+    p_high_resolution_clock::time_point _cycleStart;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    bool _probeRTTRoundDone { false };
+    int _priorWindowSize { 0 }; // Window to restore once ProbeRTT completes
+
+    int _numACKSinceFastRetransmit { 3 }; // Number of ACKs received since fast re-transmit, default avoids immediate re-transmit
+    int _duplicateACKCount { 0 }; // Counter for duplicate ACKs received
+};
+
+}
+
+#endif // hifi_BBRCC_h
@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <PortableHighResolutionClock.h>
@@ -49,6 +50,9 @@ public:
 
     virtual int estimatedTimeout() const = 0;
 
+    // estimated bottleneck bandwidth of the path, in packets per second, or 0 if this controller doesn't model it
+    virtual int estimatedBandwidth() const { return 0; }
+
 protected:
     void setMSS(int mss) { _mss = mss; }
     virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) = 0;
@@ -80,6 +84,9 @@ public:
     virtual ~CongestionControlFactory() {}
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
+
+// returns a factory for the named congestion control ("vegas" or "bbr"), or nullptr if the name is unknown
+std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const std::string& name);
     
 }
 
@@ -41,8 +41,8 @@ Connection::Connection(Socket* parentSocket, SockAddr destination, std::unique_p
     Q_ASSERT_X(_congestionControl, "Connection::Connection", "Must be called with a valid CongestionControl object");
     _congestionControl->init();
 
-    // Setup packets
-    static const int ACK_PACKET_PAYLOAD_BYTES = sizeof(SequenceNumber);
+    // Setup packets, an ACK is followed by the newest loss ranges
+    static const int ACK_PACKET_PAYLOAD_BYTES = sizeof(SequenceNumber) * (1 + 2 * MAX_SACK_RANGES);
     static const int HANDSHAKE_ACK_PAYLOAD_BYTES = sizeof(SequenceNumber);
 
     _ackPacket = ControlPacket::create(ControlPacket::ACK, ACK_PACKET_PAYLOAD_BYTES);
@@ -68,21 +68,11 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+    if (auto sendQueue = std::move(_sendQueue)) {
+        // tell the send queue to stop, once this returns the scheduler is done with it and it can be deleted
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
-
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -147,11 +137,19 @@ void Connection::queueTimeout() {
 
 void Connection::sendReliablePacket(std::unique_ptr<Packet> packet) {
     Q_ASSERT_X(packet->isReliable(), "Connection::send", "Trying to send an unreliable packet reliably.");
+    if (packet->getSendPriority() == Packet::SendPriority::High) {
+        _stats.recordSentHighPriorityPackets(1, (int)packet->getWireSize());
+    } else {
+        _stats.recordSentBulkPackets(1, (int)packet->getWireSize());
+    }
     getSendQueue().queuePacket(std::move(packet));
 }
 
 void Connection::sendReliablePacketList(std::unique_ptr<PacketList> packetList) {
     Q_ASSERT_X(packetList->isReliable(), "Connection::send", "Trying to send an unreliable packet reliably.");
+    // packet lists are always bulk, their packets go out in order with the rest of the message
+    _stats.recordSentBulkPackets((int)packetList->getNumPackets(),
+        (int)(packetList->getDataSize() + packetList->getNumPackets() * UDP_IPV4_HEADER_SIZE));
     getSendQueue().queuePacketList(std::move(packetList));
 }
 
@@ -201,8 +199,13 @@ void Connection::recordRetransmission(int wireSize, int payloadSize,
     _congestionControl->onPacketReSent(wireSize, seqNum, timePoint);
 }
 
-void Connection::recordSentUnreliablePackets(int wireSize, int payloadSize) {
+void Connection::recordSentUnreliablePackets(int wireSize, int payloadSize, Packet::SendPriority priority) {
     _stats.recordUnreliableSentPackets(payloadSize, wireSize);
+    if (priority == Packet::SendPriority::High) {
+        _stats.recordSentHighPriorityPackets(1, wireSize);
+    } else {
+        _stats.recordSentBulkPackets(1, wireSize);
+    }
 }
 
 void Connection::recordReceivedUnreliablePackets(int wireSize, int payloadSize) {
@@ -220,6 +223,13 @@ void Connection::sendACK() {
     // pack in the ACK number
     _ackPacket->writePrimitive(nextACKNumber);
 
+    // for the first few ACKs after new losses, list the newest loss ranges so that the sender re-sends them right away
+    // (a selective ACK) - the repeats make up for lost ACKs, the sender ignores ranges it has already been told about
+    if (_numSACKsToSend > 0 && !_lossList.isEmpty()) {
+        --_numSACKsToSend;
+        _lossList.writeNewest(*_ackPacket, MAX_SACK_RANGES);
+    }
+
     // have the socket send off our packet
     _parentSocket->writeBasePacket(*_ackPacket, _destination);
     
@@ -262,6 +272,7 @@ bool Connection::processReceivedSequenceNumber(SequenceNumber sequenceNumber, in
         } else {
             _lossList.append(_lastReceivedSequenceNumber + 1, sequenceNumber - 1);
         }
+        _numSACKsToSend = SACK_REPEATS;
     }
     
     bool wasDuplicate = false;
@@ -346,6 +357,20 @@ void Connection::processACK(ControlPacketPointer controlPacket) {
         getSendQueue().ack(ack);
     }
 
+    // re-send the loss ranges listed after the ACK, if any
+    auto currentSequenceNumber = getSendQueue().getCurrentSequenceNumber();
+    while (controlPacket->bytesLeftToRead() >= (qint64)(2 * sizeof(SequenceNumber))) {
+        SequenceNumber first;
+        SequenceNumber last;
+        controlPacket->readPrimitive(&first);
+        controlPacket->readPrimitive(&last);
+
+        if (ack < first && first <= last && last <= currentSequenceNumber) {
+            getSendQueue().selectiveNAK(first, last);
+            _stats.record(ConnectionStats::Stats::ReceivedSACKRange);
+        }
+    }
+
     // give this ACK to the congestion control and update the send queue parameters
     updateCongestionControlAndSendQueue([this, ack, &controlPacket] {
         if (_congestionControl->onACK(ack, controlPacket->getReceiveTime())) {
@@ -413,6 +438,7 @@ void Connection::resetReceiveState() {
     
     // clear the loss list
     _lossList.clear();
+    _numSACKsToSend = 0;
     
     // clear any pending received messages
     for (auto& pendingMessage : _pendingReceivedMessages) {
@@ -438,6 +464,12 @@ void Connection::updateCongestionControlAndSendQueue(std::function<void ()> cong
     // record connection stats
     _stats.recordPacketSendPeriod(_congestionControl->_packetSendPeriod);
     _stats.recordCongestionWindowSize(_congestionControl->_congestionWindowSize);
+
+    static const double USECS_PER_SECOND = 1000000.0;
+    double packetSendPeriod = _congestionControl->_packetSendPeriod;
+    _stats.recordPacingRate(packetSendPeriod > 0.0 ? (int)(USECS_PER_SECOND / packetSendPeriod) : 0);
+    _stats.recordEstimatedBandwidth(_congestionControl->estimatedBandwidth());
+    _stats.recordSendQueueDepth(sendQueue.getNumQueuedPackets());
 }
 
 void PendingReceivedMessage::enqueuePacket(std::unique_ptr<Packet> packet) {
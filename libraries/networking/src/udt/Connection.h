@@ -50,6 +50,9 @@ class Connection : public QObject {
     Q_OBJECT
 public:
     using ControlPacketPointer = std::unique_ptr<ControlPacket>;
+
+    static const int MAX_SACK_RANGES = 8; // loss ranges listed after an ACK
+    static const int SACK_REPEATS = 3; // ACKs that list the loss ranges after new losses
     
     Connection(Socket* parentSocket, SockAddr destination, std::unique_ptr<CongestionControl> congestionControl);
     virtual ~Connection();
@@ -74,7 +77,7 @@ public:
     void sendHandshakeRequest();
     bool hasReceivedHandshake() const { return _hasReceivedHandshake; }
     
-    void recordSentUnreliablePackets(int wireSize, int payloadSize);
+    void recordSentUnreliablePackets(int wireSize, int payloadSize, Packet::SendPriority priority);
     void recordReceivedUnreliablePackets(int wireSize, int payloadSize);
     void setDestinationAddress(const SockAddr& destination);
 
@@ -116,6 +119,7 @@ private:
     MessageNumber _lastMessageNumber { 0 };
 
     LossList _lossList; // List of all missing packets
+    int _numSACKsToSend { 0 }; // how many more ACKs list the newest loss ranges
     SequenceNumber _lastReceivedSequenceNumber; // The largest sequence number received from the peer
     SequenceNumber _lastReceivedACK; // The last ACK received
     
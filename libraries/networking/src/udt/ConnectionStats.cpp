@@ -82,6 +82,16 @@ void ConnectionStats::recordUnreliableReceivedPackets(int payload, int total) {
     _currentSample.receivedUnreliableBytes += total;
 }
 
+void ConnectionStats::recordSentHighPriorityPackets(int numPackets, int total) {
+    _currentSample.sentHighPriorityPackets += numPackets;
+    _currentSample.sentHighPriorityBytes += total;
+}
+
+void ConnectionStats::recordSentBulkPackets(int numPackets, int total) {
+    _currentSample.sentBulkPackets += numPackets;
+    _currentSample.sentBulkBytes += total;
+}
+
 void ConnectionStats::recordCongestionWindowSize(int sample) {
     _currentSample.congestionWindowSize = sample;
 }
@@ -90,6 +100,18 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordPacingRate(int sample) {
+    _currentSample.pacingRate = sample;
+}
+
+void ConnectionStats::recordSendQueueDepth(int sample) {
+    _currentSample.sendQueueDepth = sample;
+}
+
+void ConnectionStats::recordEstimatedBandwidth(int sample) {
+    _currentSample.estimatedBandwith = sample;
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -97,6 +119,7 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     HIFI_LOG_EVENT(SentACK)
     HIFI_LOG_EVENT(ReceivedACK)
     HIFI_LOG_EVENT(ProcessedACK)
+    HIFI_LOG_EVENT(ReceivedSACKRange)
     ;
 #undef HIFI_LOG_EVENT
 
@@ -106,6 +129,10 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Sent high priority packets: " << stats.sentHighPriorityPackets;
+    debug << "\n     Sent bulk packets: " << stats.sentBulkPackets;
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     Pacing rate (P/s): " << stats.pacingRate;
+    debug << "\n     Est. bottleneck bandwidth (P/s): " << stats.estimatedBandwith << "\n";
     return debug;
 }
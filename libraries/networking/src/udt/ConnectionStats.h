@@ -25,6 +25,7 @@ public:
             SentACK,
             ReceivedACK,
             ProcessedACK,
+            ReceivedSACKRange, // a loss range listed after an ACK, re-sent without waiting for a timeout
             
             NumEvents
         };
@@ -60,14 +61,22 @@ public:
         uint64_t receivedUnreliableUtilBytes { 0 };
         uint64_t sentUnreliableBytes { 0 };
         uint64_t receivedUnreliableBytes { 0 };
+
+        // packets handed to the socket by send priority, reliable and unreliable together
+        uint32_t sentHighPriorityPackets { 0 };
+        uint64_t sentHighPriorityBytes { 0 };
+        uint32_t sentBulkPackets { 0 };
+        uint64_t sentBulkBytes { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
         int receiveRate { 0 };
-        int estimatedBandwith { 0 };
+        int estimatedBandwith { 0 }; // bottleneck bandwidth estimated by the congestion control, in packets per second
         int rtt { 0 };
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+        int pacingRate { 0 }; // packets per second allowed by the packet send period, 0 when not pacing
+        int sendQueueDepth { 0 }; // packets queued and not yet sent
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
         Stats() { events.fill(0); }
@@ -91,8 +100,14 @@ public:
     void recordUnreliableSentPackets(int payload, int total);
     void recordUnreliableReceivedPackets(int payload, int total);
 
+    void recordSentHighPriorityPackets(int numPackets, int total);
+    void recordSentBulkPackets(int numPackets, int total);
+
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+    void recordPacingRate(int sample);
+    void recordSendQueueDepth(int sample);
+    void recordEstimatedBandwidth(int sample);
     
 private:
     Stats _currentSample;
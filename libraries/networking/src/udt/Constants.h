@@ -29,6 +29,7 @@ namespace udt {
     static const int WEBRTC_SEND_BUFFER_SIZE_BYTES = 1048576;
     static const int WEBRTC_RECEIVE_BUFFER_SIZE_BYTES = 1048576;
     static const int DEFAULT_SYN_INTERVAL_USECS = 10 * 1000;
+    static const int MAX_DATAGRAMS_PER_BATCH = 64;
 
     
     // Header constants
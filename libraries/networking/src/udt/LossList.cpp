@@ -17,90 +17,98 @@ using namespace udt;
 using namespace std;
 
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(_lossList.empty() || (_lossList.rbegin()->second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
-    if (getLength() > 0 && _lossList.back().second + 1 == seq) {
-        ++_lossList.back().second;
+    if (getLength() > 0 && _lossList.rbegin()->second + 1 == seq) {
+        ++_lossList.rbegin()->second;
     } else {
-        _lossList.push_back(make_pair(seq, seq));
+        _lossList.emplace_hint(_lossList.end(), seq, seq);
     }
     _length += 1;
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(_lossList.empty() || (_lossList.rbegin()->second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
                "LossList::append(SequenceNumber, SequenceNumber)", "Range start greater than range end");
 
-    if (getLength() > 0 && _lossList.back().second + 1 == start) {
-        _lossList.back().second = end;
+    if (getLength() > 0 && _lossList.rbegin()->second + 1 == start) {
+        _lossList.rbegin()->second = end;
     } else {
-        _lossList.push_back(make_pair(start, end));
+        _lossList.emplace_hint(_lossList.end(), start, end);
     }
     _length += seqlen(start, end);
 }
 
+LossList::Ranges::iterator LossList::findRange(SequenceNumber seq) {
+    // the last range that starts at or before seq
+    auto it = _lossList.upper_bound(seq);
+    if (it == _lossList.begin()) {
+        return _lossList.end();
+    }
+    --it;
+    return seq <= it->second ? it : _lossList.end();
+}
+
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
-    
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
-    
-    if (it == _lossList.end() || end < it->first) {
-        // No overlap, simply insert
-        _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
-    } else {
-        // If it starts before segment, extend segment
-        if (start < it->first) {
-            _length += seqlen(start, it->first - 1);
-            it->first = start;
+
+    // the first range that overlaps or touches the new one
+    auto it = _lossList.lower_bound(start);
+    if (it != _lossList.begin()) {
+        auto previous = std::prev(it);
+        if (previous->second + 1 >= start) {
+            it = previous;
         }
-        
-        // If it ends after segment, extend segment
-        if (end > it->second) {
-            _length += seqlen(it->second + 1, end);
-            it->second = end;
+    }
+
+    // merge every range that overlaps or touches the new one into it
+    while (it != _lossList.end() && it->first <= end + 1) {
+        if (it->first < start) {
+            start = it->first;
         }
-        
-        auto it2 = it;
-        ++it2;
-        // For all ranges touching the current range
-        while (it2 != _lossList.end() && it->second >= it2->first - 1) {
-            // extend current range if necessary
-            if (it->second < it2->second) {
-                _length += seqlen(it->second + 1, it2->second);
-                it->second = it2->second;
-            }
-            
-            // Remove overlapping range
-            _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+        if (it->second > end) {
+            end = it->second;
         }
+        _length -= seqlen(it->first, it->second);
+        it = _lossList.erase(it);
+    }
+
+    _lossList.emplace_hint(it, start, end);
+    _length += seqlen(start, end);
+}
+
+bool LossList::contains(SequenceNumber seq) const {
+    auto it = _lossList.upper_bound(seq);
+    if (it == _lossList.begin()) {
+        return false;
     }
+    --it;
+    return seq <= it->second;
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
-        if (it->first == it->second) {
+    if (it != _lossList.end()) {
+        auto first = it->first;
+        auto last = it->second;
+
+        if (first == last) {
             _lossList.erase(it);
-        } else if (seq == it->first) {
-            ++it->first;
-        } else if (seq == it->second) {
+        } else if (seq == first) {
+            // the start is the key of the range, so it is re-inserted
+            it = _lossList.erase(it);
+            _lossList.emplace_hint(it, seq + 1, last);
+        } else if (seq == last) {
             --it->second;
         } else {
-            auto temp = it->second;
             it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            _lossList.emplace_hint(std::next(it), seq + 1, last);
         }
         _length -= 1;
         
@@ -115,50 +123,38 @@ bool LossList::remove(SequenceNumber seq) {
 void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
-    // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
-    
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
+
+    // the first range sharing sequence numbers, if any
+    auto it = _lossList.lower_bound(start);
+    if (it != _lossList.begin()) {
+        auto previous = std::prev(it);
+        if (start <= previous->second) {
+            it = previous;
         }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
+    }
+
+    while (it != _lossList.end() && it->first <= end) {
+        auto first = it->first;
+        auto last = it->second;
+        _length -= seqlen(first, last);
+        it = _lossList.erase(it);
+
+        // keep what lies outside of the removed range
+        if (first < start) {
+            _lossList.emplace_hint(it, first, start - 1);
+            _length += seqlen(first, start - 1);
+        }
+        if (end < last) {
+            _lossList.emplace_hint(it, end + 1, last);
+            _length += seqlen(end + 1, last);
+            break;
         }
     }
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return _lossList.begin()->first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
@@ -182,3 +178,15 @@ void LossList::write(ControlPacket& packet, int maxPairs) {
         }
     }
 }
+
+void LossList::writeNewest(ControlPacket& packet, int maxPairs) {
+    auto it = _lossList.end();
+    for (int i = 0; i < maxPairs && it != _lossList.begin(); ++i) {
+        --it;
+    }
+
+    for (; it != _lossList.end(); ++it) {
+        packet.writePrimitive(it->first);
+        packet.writePrimitive(it->second);
+    }
+}
@@ -12,39 +12,51 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <map>
 
 #include "SequenceNumber.h"
 
 namespace udt {
 
 class ControlPacket;
-    
+
+// The missing sequence numbers, as disjoint ranges ordered by their start, so that lookups, inserts and removes take
+// O(log n) in the number of ranges however lossy the link.  Adjacent and overlapping ranges are merged.
 class LossList {
 public:
     LossList() {}
     
     void clear() { _length = 0; _lossList.clear(); }
     
-    // must always add at the end - faster than insert
+    // must always add at the end - constant time
     void append(SequenceNumber seq);
     void append(SequenceNumber start, SequenceNumber end);
     
-    // inserts anywhere - MUCH slower
+    // inserts anywhere
     void insert(SequenceNumber start, SequenceNumber end);
     
     bool remove(SequenceNumber seq);
     void remove(SequenceNumber start, SequenceNumber end);
     
     int getLength() const { return _length; }
+    int getNumRanges() const { return (int)_lossList.size(); }
     bool isEmpty() const { return _length == 0; }
+    bool contains(SequenceNumber seq) const;
     SequenceNumber getFirstSequenceNumber() const;
     SequenceNumber popFirstSequenceNumber();
     
+    // writes the first ranges, as pairs of first and last sequence numbers
     void write(ControlPacket& packet, int maxPairs = -1);
-    
+    // writes the last ranges (the newest losses), oldest first
+    void writeNewest(ControlPacket& packet, int maxPairs);
+
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Ranges = std::map<SequenceNumber, SequenceNumber>; // first -> last sequence number of each range
+
+    // the range that contains seq, or end
+    Ranges::iterator findRange(SequenceNumber seq);
+
+    Ranges _lossList;
     int _length { 0 };
 };
     
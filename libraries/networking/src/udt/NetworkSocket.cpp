@@ -8,7 +8,36 @@
 
 #include "NetworkSocket.h"
 
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+#include <errno.h>
+#include <string.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <QtCore/QSocketNotifier>
+#endif
+
 #include "../NetworkLogging.h"
+#include "Constants.h"
+
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+using udt::MAX_DATAGRAMS_PER_BATCH;
+
+// large enough for any datagram we send; anything bigger is truncated and dropped
+static const int RECEIVE_BUFFER_SIZE = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+
+// recvmmsg() state for the currently bound UDP socket
+struct NetworkSocket::BatchedRead {
+    QSocketNotifier* notifier { nullptr };
+    bool isSupported { true };
+
+    udt::PacketBuffer buffers[MAX_DATAGRAMS_PER_BATCH];
+    mmsghdr messages[MAX_DATAGRAMS_PER_BATCH];
+    iovec vectors[MAX_DATAGRAMS_PER_BATCH];
+    sockaddr_in addresses[MAX_DATAGRAMS_PER_BATCH];
+};
+#endif
 
 
 NetworkSocket::NetworkSocket(QObject* parent) :
@@ -33,6 +62,9 @@ NetworkSocket::NetworkSocket(QObject* parent) :
 #endif
 }
 
+NetworkSocket::~NetworkSocket() {
+}
+
 
 void NetworkSocket::setSocketOption(SocketType socketType, QAbstractSocket::SocketOption option, const QVariant& value) {
     switch (socketType) {
@@ -68,6 +100,9 @@ void NetworkSocket::bind(SocketType socketType, const QHostAddress& address, qui
     switch (socketType) {
     case SocketType::UDP:
         _udpSocket.bind(address, port);
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+        resetBatchedRead();
+#endif
         break;
 #if defined(WEBRTC_DATA_CHANNELS)
     case SocketType::WebRTC:
@@ -79,10 +114,57 @@ void NetworkSocket::bind(SocketType socketType, const QHostAddress& address, qui
     }
 }
 
+bool NetworkSocket::bindShared(const QHostAddress& address, quint16 port) {
+#if defined(UDT_BATCHED_DATAGRAM_IO) && defined(SO_REUSEPORT)
+    bool isIPv4 = false;
+    quint32 ipv4Address = address.toIPv4Address(&isIPv4);
+    if (!isIPv4) {
+        qCWarning(networking) << "Cannot share a UDP port on non-IPv4 address" << address;
+        return false;
+    }
+
+    int socketDescriptor = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketDescriptor == -1) {
+        qCWarning(networking) << "Cannot create shared UDP socket - errno" << errno;
+        return false;
+    }
+
+    int reusePort = 1;
+    sockaddr_in bindAddress;
+    memset(&bindAddress, 0, sizeof(bindAddress));
+    bindAddress.sin_family = AF_INET;
+    bindAddress.sin_addr.s_addr = htonl(ipv4Address);
+    bindAddress.sin_port = htons(port);
+
+    if (setsockopt(socketDescriptor, SOL_SOCKET, SO_REUSEPORT, &reusePort, sizeof(reusePort)) == -1
+        || ::bind(socketDescriptor, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) == -1) {
+        qCWarning(networking) << "Cannot bind shared UDP socket to port" << port << "- errno" << errno;
+        ::close(socketDescriptor);
+        return false;
+    }
+
+    // QUdpSocket takes ownership of the descriptor
+    if (!_udpSocket.setSocketDescriptor(socketDescriptor, QAbstractSocket::BoundState)) {
+        qCWarning(networking) << "Cannot adopt shared UDP socket -" << _udpSocket.errorString();
+        ::close(socketDescriptor);
+        return false;
+    }
+
+    resetBatchedRead();
+    return true;
+#else
+    bind(SocketType::UDP, address, port);
+    return _udpSocket.state() == QAbstractSocket::BoundState;
+#endif
+}
+
 void NetworkSocket::abort(SocketType socketType) {
     switch (socketType) {
     case SocketType::UDP:
         _udpSocket.abort();
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+        resetBatchedRead();
+#endif
         break;
 #if defined(WEBRTC_DATA_CHANNELS)
     case SocketType::WebRTC:
@@ -130,6 +212,8 @@ qint64 NetworkSocket::writeDatagram(const QByteArray& datagram, const SockAddr&
     case SocketType::UDP:
         // WEBRTC TODO: The Qt documentation says that the following call shouldn't be used if the UDP socket is connected!!!
         // https://doc.qt.io/qt-5/qudpsocket.html#writeDatagram
+        ++_datagramsWritten;
+        ++_writeCalls;
         return _udpSocket.writeDatagram(datagram, sockAddr.getAddress(), sockAddr.getPort());
 #if defined(WEBRTC_DATA_CHANNELS)
     case SocketType::WebRTC:
@@ -196,6 +280,8 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
         || _pendingDatagramSizeSocketType == SocketType::Unknown && _lastSocketTypeRead == SocketType::WebRTC) {
         _lastSocketTypeRead = SocketType::UDP;
         _pendingDatagramSizeSocketType = SocketType::Unknown;
+        ++_datagramsRead;
+        ++_readCalls;
         if (sockAddr) {
             sockAddr->setType(SocketType::UDP);
             return _udpSocket.readDatagram(data, maxSize, sockAddr->getAddressPointer(), sockAddr->getPortPointer());
@@ -213,6 +299,8 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
         }
     }
 #else
+    ++_datagramsRead;
+    ++_readCalls;
     if (sockAddr) {
         sockAddr->setType(SocketType::UDP);
         return _udpSocket.readDatagram(data, maxSize, sockAddr->getAddressPointer(), sockAddr->getPortPointer());
@@ -223,6 +311,254 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
 }
 
 
+bool NetworkSocket::hasBatchedDatagramIO() {
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+    return true;
+#else
+    return false;
+#endif
+}
+
+int NetworkSocket::readDatagrams(std::vector<ReceivedDatagram>& datagrams) {
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+    if (!_batchedRead || !_batchedRead->isSupported) {
+        return -1;
+    }
+
+    auto& batch = *_batchedRead;
+    for (int i = 0; i < MAX_DATAGRAMS_PER_BATCH; ++i) {
+        // replace the buffers handed out by the previous read
+        if (!batch.buffers[i]) {
+            batch.buffers[i] = udt::PacketBufferPool::allocate(RECEIVE_BUFFER_SIZE);
+        }
+        batch.vectors[i].iov_base = batch.buffers[i].get();
+        batch.vectors[i].iov_len = RECEIVE_BUFFER_SIZE;
+
+        auto& header = batch.messages[i].msg_hdr;
+        memset(&header, 0, sizeof(header));
+        header.msg_name = &batch.addresses[i];
+        header.msg_namelen = sizeof(batch.addresses[i]);
+        header.msg_iov = &batch.vectors[i];
+        header.msg_iovlen = 1;
+        batch.messages[i].msg_len = 0;
+    }
+
+    int numRead;
+    do {
+        numRead = recvmmsg(_udpSocket.socketDescriptor(), batch.messages, MAX_DATAGRAMS_PER_BATCH, MSG_DONTWAIT, nullptr);
+    } while (numRead < 0 && errno == EINTR);
+    ++_readCalls;
+
+    if (numRead < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+        if (errno == ENOSYS) {
+            // e.g. blocked by a seccomp filter - use the Qt socket from now on
+            qCWarning(networking) << "recvmmsg() is not available, reading datagrams one at a time";
+            batch.isSupported = false;
+        }
+        return -1;
+    }
+
+    int numDatagrams = 0;
+    for (int i = 0; i < numRead; ++i) {
+        const auto& message = batch.messages[i];
+        if ((message.msg_hdr.msg_flags & MSG_TRUNC) || message.msg_hdr.msg_namelen != sizeof(sockaddr_in)
+            || batch.addresses[i].sin_family != AF_INET) {
+            continue;
+        }
+
+        ReceivedDatagram datagram;
+        datagram.data = std::move(batch.buffers[i]);
+        datagram.size = message.msg_len;
+        datagram.sockAddr = SockAddr(SocketType::UDP, QHostAddress(ntohl(batch.addresses[i].sin_addr.s_addr)),
+                                     ntohs(batch.addresses[i].sin_port));
+        datagrams.push_back(std::move(datagram));
+        ++numDatagrams;
+    }
+    _datagramsRead += numRead;
+
+    return numDatagrams;
+#else
+    Q_UNUSED(datagrams);
+    return -1;
+#endif
+}
+
+int NetworkSocket::writeDatagrams(const std::vector<std::pair<QByteArray, SockAddr>>& datagrams,
+                                  std::vector<qint64>& bytesWritten) {
+    int numSent = 0;
+    size_t next = 0;
+    bytesWritten.assign(datagrams.size(), -1);
+
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+    mmsghdr messages[MAX_DATAGRAMS_PER_BATCH];
+    iovec vectors[MAX_DATAGRAMS_PER_BATCH];
+    sockaddr_in addresses[MAX_DATAGRAMS_PER_BATCH];
+
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+    while (socketDescriptor != -1 && next < datagrams.size()) {
+        // gather the next run of IPv4 UDP datagrams
+        int numMessages = 0;
+        size_t end = next;
+        while (end < datagrams.size() && numMessages < MAX_DATAGRAMS_PER_BATCH) {
+            const auto& datagram = datagrams[end];
+            bool isIPv4 = false;
+            quint32 address = datagram.second.getAddress().toIPv4Address(&isIPv4);
+            if (datagram.second.getType() != SocketType::UDP || !isIPv4) {
+                break;
+            }
+
+            memset(&addresses[numMessages], 0, sizeof(sockaddr_in));
+            addresses[numMessages].sin_family = AF_INET;
+            addresses[numMessages].sin_addr.s_addr = htonl(address);
+            addresses[numMessages].sin_port = htons(datagram.second.getPort());
+
+            vectors[numMessages].iov_base = const_cast<char*>(datagram.first.constData());
+            vectors[numMessages].iov_len = datagram.first.size();
+
+            auto& header = messages[numMessages].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = &addresses[numMessages];
+            header.msg_namelen = sizeof(sockaddr_in);
+            header.msg_iov = &vectors[numMessages];
+            header.msg_iovlen = 1;
+
+            ++numMessages;
+            ++end;
+        }
+
+        if (numMessages == 0) {
+            if (writeWebRTCDatagrams(datagrams, next, bytesWritten, numSent)) {
+                continue;
+            }
+
+            // not something sendmmsg() can send - let writeDatagram() handle it
+            bytesWritten[next] = writeDatagram(datagrams[next].first, datagrams[next].second);
+            if (bytesWritten[next] >= 0) {
+                ++numSent;
+            }
+            ++next;
+            continue;
+        }
+
+        int numWritten;
+        do {
+            numWritten = sendmmsg(socketDescriptor, messages, numMessages, 0);
+        } while (numWritten < 0 && errno == EINTR);
+        ++_writeCalls;
+
+        if (numWritten <= 0) {
+            // leave the rest to the Qt socket, which reports the error
+            break;
+        }
+
+        for (int i = 0; i < numWritten; ++i) {
+            bytesWritten[next + i] = datagrams[next + i].first.size();
+        }
+        _datagramsWritten += numWritten;
+        numSent += numWritten;
+        next += numWritten;
+    }
+#endif
+
+    while (next < datagrams.size()) {
+        if (writeWebRTCDatagrams(datagrams, next, bytesWritten, numSent)) {
+            continue;
+        }
+
+        bytesWritten[next] = writeDatagram(datagrams[next].first, datagrams[next].second);
+        if (bytesWritten[next] >= 0) {
+            ++numSent;
+        }
+        ++next;
+    }
+
+    return numSent;
+}
+
+bool NetworkSocket::writeWebRTCDatagrams(const std::vector<std::pair<QByteArray, SockAddr>>& datagrams, size_t& next,
+                                         std::vector<qint64>& bytesWritten, int& numSent) {
+#if defined(WEBRTC_DATA_CHANNELS)
+    size_t end = next;
+    while (end < datagrams.size() && datagrams[end].second.getType() == SocketType::WebRTC) {
+        ++end;
+    }
+    if (end == next) {
+        return false;
+    }
+
+    int numRunSent = _webrtcSocket.writeDatagrams(&datagrams[next], (int)(end - next));
+    if (numRunSent == (int)(end - next)) {
+        for (size_t i = next; i < end; ++i) {
+            bytesWritten[i] = datagrams[i].first.size();
+        }
+    }
+    numSent += numRunSent;
+    next = end;
+    return true;
+#else
+    Q_UNUSED(datagrams);
+    Q_UNUSED(next);
+    Q_UNUSED(bytesWritten);
+    Q_UNUSED(numSent);
+    return false;
+#endif
+}
+
+int NetworkSocket::readWebRTCDatagrams(std::vector<ReceivedDatagram>& datagrams) {
+#if defined(WEBRTC_DATA_CHANNELS)
+    std::vector<WebRTCSocket::Datagram> received;
+    int numRead = _webrtcSocket.readDatagrams(received);
+    for (auto& datagram : received) {
+        ReceivedDatagram receivedDatagram;
+        receivedDatagram.data = std::move(datagram.data);
+        receivedDatagram.size = datagram.size;
+        receivedDatagram.sockAddr = datagram.address;
+        datagrams.push_back(std::move(receivedDatagram));
+    }
+    return numRead;
+#else
+    Q_UNUSED(datagrams);
+    return 0;
+#endif
+}
+
+NetworkSocket::DatagramStats NetworkSocket::sampleDatagramStats() {
+    DatagramStats stats;
+    stats.datagramsRead = _datagramsRead.exchange(0);
+    stats.readCalls = _readCalls.exchange(0);
+    stats.datagramsWritten = _datagramsWritten.exchange(0);
+    stats.writeCalls = _writeCalls.exchange(0);
+    return stats;
+}
+
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+void NetworkSocket::resetBatchedRead() {
+    if (_batchedRead && _batchedRead->notifier) {
+        delete _batchedRead->notifier;
+        _batchedRead->notifier = nullptr;
+    }
+
+    auto socketDescriptor = _udpSocket.socketDescriptor();
+    if (socketDescriptor == -1) {
+        return;
+    }
+
+    if (!_batchedRead) {
+        _batchedRead.reset(new BatchedRead());
+    }
+
+    // QUdpSocket only signals readyRead again once its own readDatagram() is called, so watch the descriptor
+    // ourselves while datagrams are read with recvmmsg()
+    disconnect(&_udpSocket, &QUdpSocket::readyRead, this, &NetworkSocket::readyRead);
+    _batchedRead->notifier = new QSocketNotifier(socketDescriptor, QSocketNotifier::Read, this);
+    connect(_batchedRead->notifier, SIGNAL(activated(int)), this, SIGNAL(readyRead()));
+}
+#endif
+
+
 QAbstractSocket::SocketState NetworkSocket::state(SocketType socketType) const {
     switch (socketType) {
     case SocketType::UDP:
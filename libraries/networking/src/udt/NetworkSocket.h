@@ -9,6 +9,10 @@
 #ifndef vircadia_NetworkSocket_h
 #define vircadia_NetworkSocket_h
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <QObject>
 #include <QUdpSocket>
 
@@ -17,10 +21,16 @@
 #include "../SockAddr.h"
 #include "../NodeType.h"
 #include "../SocketType.h"
+#include "PacketBufferPool.h"
 #if defined(WEBRTC_DATA_CHANNELS)
 #include "../webrtc/WebRTCSocket.h"
 #endif
 
+#if defined(Q_OS_LINUX)
+// UDP datagrams are read and written in batches with recvmmsg() and sendmmsg().
+#define UDT_BATCHED_DATAGRAM_IO
+#endif
+
 /// @addtogroup Networking
 /// @{
 
@@ -31,10 +41,27 @@ class NetworkSocket : public QObject {
 
 public:
 
+    /// @brief A UDP datagram read by readDatagrams().
+    struct ReceivedDatagram {
+        udt::PacketBuffer data;
+        qint64 size { 0 };
+        SockAddr sockAddr;
+    };
+
+    /// @brief Numbers of datagrams transferred and of system calls used to transfer them.
+    struct DatagramStats {
+        quint64 datagramsRead { 0 };
+        quint64 readCalls { 0 };
+        quint64 datagramsWritten { 0 };
+        quint64 writeCalls { 0 };
+    };
+
     /// @brief Constructs a new NetworkSocket object.
     /// @param parent Qt parent object.
     NetworkSocket(QObject* parent);
 
+    ~NetworkSocket();
+
 
     /// @brief Set the value of a UDP or WebRTC socket option.
     /// @param socketType The type of socket for which to set the option value.
@@ -54,6 +81,14 @@ public:
     /// @param address The address to bind to.
     /// @param port The port to bind to.
     void bind(SocketType socketType, const QHostAddress& address, quint16 port = 0);
+
+    /// @brief Binds the UDP socket so that other sockets may bind the same port and share its inbound traffic.
+    /// @details Uses <code>SO_REUSEPORT</code> where it's available, in which case the system picks the socket for each
+    /// datagram from its source address. Elsewhere this is a regular bind.
+    /// @param address The address to bind to.
+    /// @param port The port to bind to.
+    /// @return <code>true</code> if the socket was bound, <code>false</code> if it wasn't.
+    bool bindShared(const QHostAddress& address, quint16 port);
     
     /// @brief Immediately closes and resets the socket.
     /// @param socketType The type of socket to close and reset.
@@ -102,6 +137,38 @@ public:
     /// @return The number of bytes if successfully read, otherwise <code>-1</code>.
     qint64 readDatagram(char* data, qint64 maxSize, SockAddr* sockAddr = nullptr);
 
+
+    /// @brief Gets whether UDP datagrams can be read and written in batches on this platform.
+    /// @return <code>true</code> if readDatagrams() and writeDatagrams() use a single system call per batch,
+    /// <code>false</code> if they aren't available.
+    static bool hasBatchedDatagramIO();
+
+    /// @brief Reads as many pending UDP datagrams as possible, up to a batch, with a single system call.
+    /// @details Only available if hasBatchedDatagramIO(). WebRTC datagrams must still be read with readDatagram().
+    /// @param datagrams The vector to append the datagrams read to.
+    /// @return The number of datagrams read, <code>0</code> if there were none pending, or <code>-1</code> if there
+    /// was an error.
+    int readDatagrams(std::vector<ReceivedDatagram>& datagrams);
+
+    /// @brief Takes all of the WebRTC datagrams waiting to be read, without copying them.
+    /// @details The WebRTC socket reads its datagrams into packet buffers as they arrive.
+    /// @param datagrams The vector to append the datagrams read to.
+    /// @return The number of datagrams read.
+    int readWebRTCDatagrams(std::vector<ReceivedDatagram>& datagrams);
+
+    /// @brief Sends UDP datagrams with as few system calls as possible.
+    /// @details Falls back to writeDatagram() for each datagram if batched writes aren't available or fail.
+    /// @param datagrams The datagrams to send, with their destination addresses.
+    /// @param bytesWritten Set to the number of bytes written for each datagram, or <code>-1</code> if it wasn't sent. A
+    /// run of WebRTC datagrams that weren't all sent is reported as not sent.
+    /// @return The number of datagrams successfully sent.
+    int writeDatagrams(const std::vector<std::pair<QByteArray, SockAddr>>& datagrams, std::vector<qint64>& bytesWritten);
+
+    /// @brief Gets and resets the counts of datagrams and system calls since the previous call.
+    /// @return The UDP datagram counts.
+    DatagramStats sampleDatagramStats();
+
+
     
     /// @brief Gets the state of the UDP or WebRTC socket.
     /// @param socketType The type of socket for which to get the state.
@@ -154,6 +221,22 @@ private:
     QObject* _parent;
 
     QUdpSocket _udpSocket;
+
+    // sends the run of WebRTC datagrams starting at next, if there is one, and moves next past it
+    bool writeWebRTCDatagrams(const std::vector<std::pair<QByteArray, SockAddr>>& datagrams, size_t& next,
+                              std::vector<qint64>& bytesWritten, int& numSent);
+
+#if defined(UDT_BATCHED_DATAGRAM_IO)
+    void resetBatchedRead();
+
+    struct BatchedRead;
+    std::unique_ptr<BatchedRead> _batchedRead;
+#endif
+
+    std::atomic<quint64> _datagramsRead { 0 };
+    std::atomic<quint64> _readCalls { 0 };
+    std::atomic<quint64> _datagramsWritten { 0 };
+    std::atomic<quint64> _writeCalls { 0 };
 #if defined(WEBRTC_DATA_CHANNELS)
     WebRTCSocket _webrtcSocket;
 #endif
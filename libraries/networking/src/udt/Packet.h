@@ -81,7 +81,7 @@ public:
     };
 
     static std::unique_ptr<Packet> create(qint64 size = -1, bool isReliable = false, bool isPartOfMessage = false);
-    static std::unique_ptr<Packet> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    static std::unique_ptr<Packet> fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     // Provided for convenience, try to limit use
     static std::unique_ptr<Packet> createCopy(const Packet& other);
@@ -97,6 +97,12 @@ public:
     bool isReliable() const { return _isReliable; }
     void setReliable(bool reliable) { _isReliable = reliable; }
 
+    // Local to the sender, not written to the wire. High priority packets (e.g. hero avatar data) leave ahead of the
+    // bulk packets already waiting in the same send queue or write batch.
+    enum class SendPriority : uint8_t { Bulk, High };
+    SendPriority getSendPriority() const { return _sendPriority; }
+    void setSendPriority(SendPriority priority) { _sendPriority = priority; }
+
     ObfuscationLevel getObfuscationLevel() const { return _obfuscationLevel; }
     SequenceNumber getSequenceNumber() const { return _sequenceNumber; }
     MessageNumber getMessageNumber() const { return _messageNumber; }
@@ -109,7 +115,7 @@ public:
 
 protected:
     Packet(qint64 size, bool isReliable = false, bool isPartOfMessage = false);
-    Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     Packet(const Packet& other);
     Packet(Packet&& other);
@@ -132,6 +138,7 @@ private:
     mutable MessageNumber _messageNumber { 0 };
     mutable PacketPosition _packetPosition { PacketPosition::ONLY };
     mutable MessagePartNumber _messagePartNumber { 0 };
+    SendPriority _sendPriority { SendPriority::Bulk };
 };
 
 } // namespace udt
@@ -0,0 +1,177 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include "Constants.h"
+
+using namespace udt;
+
+namespace {
+    const qint64 SIZE_CLASSES[PacketBufferPool::NUM_SIZE_CLASSES] = { 128, 512, MAX_PACKET_SIZE_WITH_UDP_HEADER };
+
+    // buffers a thread keeps for itself, per size class, before giving a batch back to the depot
+    const size_t THREAD_CACHE_SIZE = 64;
+    const size_t TRANSFER_BATCH_SIZE = THREAD_CACHE_SIZE / 2;
+
+    // beyond this many spare buffers per size class, freed buffers go back to the heap
+    const size_t MAX_DEPOT_SIZE = 8192;
+
+    struct Depot {
+        std::mutex mutex;
+        std::vector<char*> buffers;
+    };
+
+    // never destroyed, so that buffers released during static destruction still have somewhere to go
+    Depot* depots() {
+        static Depot* depots = new Depot[PacketBufferPool::NUM_SIZE_CLASSES];
+        return depots;
+    }
+
+    std::atomic<quint64> allocations { 0 };
+    std::atomic<quint64> misses { 0 };
+    std::atomic<quint64> oversized { 0 };
+    std::atomic<qint64> outstanding { 0 };
+
+    void giveToDepot(int sizeClass, std::vector<char*>& buffers, size_t count) {
+        auto& depot = depots()[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        while (count-- > 0 && !buffers.empty()) {
+            if (depot.buffers.size() < MAX_DEPOT_SIZE) {
+                depot.buffers.push_back(buffers.back());
+            } else {
+                delete[] buffers.back();
+            }
+            buffers.pop_back();
+        }
+    }
+
+    void takeFromDepot(int sizeClass, std::vector<char*>& buffers, size_t count) {
+        auto& depot = depots()[sizeClass];
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        while (count-- > 0 && !depot.buffers.empty()) {
+            buffers.push_back(depot.buffers.back());
+            depot.buffers.pop_back();
+        }
+    }
+
+    thread_local bool threadCacheDestroyed { false };
+
+    struct ThreadCache {
+        ThreadCache() {
+            for (auto& buffers : buffersByClass) {
+                buffers.reserve(THREAD_CACHE_SIZE + 1);
+            }
+        }
+
+        ~ThreadCache() {
+            for (int i = 0; i < PacketBufferPool::NUM_SIZE_CLASSES; ++i) {
+                giveToDepot(i, buffersByClass[i], buffersByClass[i].size());
+            }
+            threadCacheDestroyed = true;
+        }
+
+        std::vector<char*> buffersByClass[PacketBufferPool::NUM_SIZE_CLASSES];
+    };
+
+    // returns nullptr while the thread is exiting, in which case the depot is used directly
+    ThreadCache* threadCache() {
+        if (threadCacheDestroyed) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache;
+        return &cache;
+    }
+}
+
+int PacketBufferPool::sizeClassFor(qint64 size) {
+    for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+        if (size <= SIZE_CLASSES[i]) {
+            return i;
+        }
+    }
+    return HEAP;
+}
+
+qint64 PacketBufferPool::sizeOfClass(int sizeClass) {
+    return (sizeClass >= 0 && sizeClass < NUM_SIZE_CLASSES) ? SIZE_CLASSES[sizeClass] : 0;
+}
+
+PacketBufferPool::Buffer PacketBufferPool::allocate(qint64 size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    int sizeClass = sizeClassFor(size);
+    if (sizeClass == HEAP) {
+        oversized.fetch_add(1, std::memory_order_relaxed);
+        misses.fetch_add(1, std::memory_order_relaxed);
+        return Buffer(new char[size], Deleter());
+    }
+
+    outstanding.fetch_add(1, std::memory_order_relaxed);
+
+    char* buffer = nullptr;
+    std::vector<char*> single;
+    auto cache = threadCache();
+    auto& buffers = cache ? cache->buffersByClass[sizeClass] : single;
+    if (buffers.empty()) {
+        takeFromDepot(sizeClass, buffers, cache ? TRANSFER_BATCH_SIZE : 1);
+    }
+    if (!buffers.empty()) {
+        buffer = buffers.back();
+        buffers.pop_back();
+    } else {
+        misses.fetch_add(1, std::memory_order_relaxed);
+        buffer = new char[SIZE_CLASSES[sizeClass]];
+    }
+
+    return Buffer(buffer, Deleter(sizeClass));
+}
+
+void PacketBufferPool::Deleter::operator()(char* buffer) const {
+    if (sizeClass == HEAP) {
+        delete[] buffer;
+        return;
+    }
+
+    outstanding.fetch_sub(1, std::memory_order_relaxed);
+
+    auto cache = threadCache();
+    if (!cache) {
+        std::vector<char*> single { buffer };
+        giveToDepot(sizeClass, single, 1);
+        return;
+    }
+
+    auto& buffers = cache->buffersByClass[sizeClass];
+    buffers.push_back(buffer);
+    if (buffers.size() > THREAD_CACHE_SIZE) {
+        giveToDepot(sizeClass, buffers, TRANSFER_BATCH_SIZE);
+    }
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+    stats.allocations = allocations.load(std::memory_order_relaxed);
+    stats.misses = misses.load(std::memory_order_relaxed);
+    stats.oversized = oversized.load(std::memory_order_relaxed);
+    stats.outstanding = (quint64)std::max<qint64>(outstanding.load(std::memory_order_relaxed), 0);
+
+    for (int i = 0; i < NUM_SIZE_CLASSES; ++i) {
+        auto& depot = depots()[i];
+        std::lock_guard<std::mutex> lock(depot.mutex);
+        stats.pooled += depot.buffers.size();
+    }
+    return stats;
+}
@@ -0,0 +1,72 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+namespace udt {
+
+// Recycles packet buffers instead of going back to the heap for every packet.
+//
+// Buffers come in a few size classes up to a full datagram. Each thread keeps a small cache per class, so a thread
+// that allocates and frees packets doesn't contend with anyone. Buffers freed on another thread than the one that
+// allocated them (e.g. received on the socket thread, released on a mixer thread) reach the allocating side through
+// a shared depot, moved in batches.
+class PacketBufferPool {
+public:
+    static const int NUM_SIZE_CLASSES = 3;
+    static const int HEAP = -1;
+
+    // returns a buffer to the pool it came from, or to the heap
+    struct Deleter {
+        Deleter() = default;
+        Deleter(int sizeClass) : sizeClass(sizeClass) {}
+        // buffers from new char[] convert to heap buffers, so existing std::unique_ptr<char[]> callers still work
+        Deleter(const std::default_delete<char[]>&) {}
+
+        void operator()(char* buffer) const;
+
+        int sizeClass { HEAP };
+    };
+
+    using Buffer = std::unique_ptr<char[], Deleter>;
+
+    struct Stats {
+        quint64 allocations { 0 };  // buffers handed out
+        quint64 misses { 0 };       // of which had to be allocated from the heap
+        quint64 oversized { 0 };    // of which were too large for any size class
+        quint64 pooled { 0 };       // buffers sitting in the shared depot
+        quint64 outstanding { 0 };  // pooled-class buffers currently in use
+    };
+
+    // returns an uninitialized buffer of at least size bytes
+    static Buffer allocate(qint64 size);
+
+    // returns the smallest size class that holds size bytes, or HEAP
+    static int sizeClassFor(qint64 size);
+    static qint64 sizeOfClass(int sizeClass);
+
+    // counters are cumulative except for pooled and outstanding
+    static Stats getStats();
+};
+
+using PacketBuffer = PacketBufferPool::Buffer;
+
+} // namespace udt
+
+#endif // hifi_PacketBufferPool_h
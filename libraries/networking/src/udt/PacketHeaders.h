@@ -140,6 +140,11 @@ public:
         StopInjector,
         AvatarZonePresence,
         WebRTCSignaling,
+        AssetUploadChunks,
+        AssetUploadChunksReply,
+        EntityPhysicsState,
+        EntityPhysicsStateAck,
+        NodeTelemetry,
         NUM_PACKET_TYPE
     };
 
@@ -159,6 +164,7 @@ public:
     const static QSet<PacketTypeEnum::Value> getNonVerifiedPackets() {
         const static QSet<PacketTypeEnum::Value> NON_VERIFIED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::NodeJsonStats
+            << PacketTypeEnum::Value::NodeTelemetry
             << PacketTypeEnum::Value::EntityQuery
             << PacketTypeEnum::Value::OctreeDataNack
             << PacketTypeEnum::Value::EntityEditNack
@@ -199,7 +205,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
-            << PacketTypeEnum::Value::AssetUpload;
+            << PacketTypeEnum::Value::AssetUpload
+            << PacketTypeEnum::Value::AssetUploadChunks;
         return DOMAIN_SOURCED_PACKETS;
     }
 
@@ -207,7 +214,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
-            << PacketTypeEnum::Value::AssetUploadReply;
+            << PacketTypeEnum::Value::AssetUploadReply
+            << PacketTypeEnum::Value::AssetUploadChunksReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
 };
@@ -307,14 +315,17 @@ enum class EntityQueryPacketVersion: PacketVersion {
     ConnectionIdentifier = 20,
     RemovedJurisdictions = 21,
     MultiFrustumQuery = 22,
-    ConicalFrustums = 23
+    ConicalFrustums = 23,
+    ViewBudgets
 };
 
 enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ServerBusyReplies,
+    ChunkedUploads
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -374,7 +385,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    HasDomainListVersion
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -397,7 +409,9 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    HasDomainListVersion,
+    HasPacketProtection
 };
 
 enum class AudioVersion : PacketVersion {
@@ -29,8 +29,8 @@ MessageNumber PacketQueue::getNextMessageNumber() {
 bool PacketQueue::isEmpty() const {
     LockGuard locker(_packetsLock);
 
-    // Only the main channel and it is empty
-    return _channels.size() == 1 && _channels.front()->empty();
+    // Only the main channel, and it and the high priority channel are empty
+    return _channels.size() == 1 && _channels.front()->empty() && _highPriorityChannel.empty();
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
@@ -40,6 +40,14 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
         return PacketPointer();
     }
 
+    // high priority packets go first, without taking a turn from the other channels
+    if (!_highPriorityChannel.empty()) {
+        auto packet = std::move(_highPriorityChannel.front());
+        _highPriorityChannel.pop_front();
+        --_numPackets;
+        return packet;
+    }
+
     // handle the case where we are looking at the first channel and it is empty
     if (_currentChannel == _channels.begin() && (*_currentChannel)->empty()) {
         ++_currentChannel;
@@ -55,6 +63,7 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
     // Take front packet
     auto packet = std::move(channel->front());
     channel->pop_front();
+    --_numPackets;
 
     // Remove now empty channel (Don't remove the main channel)
     if (channel->empty() && _currentChannel != _channels.begin()) {
@@ -81,7 +90,12 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
 
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    if (packet->getSendPriority() == Packet::SendPriority::High) {
+        _highPriorityChannel.push_back(std::move(packet));
+    } else {
+        _channels.front()->push_back(std::move(packet));
+    }
+    ++_numPackets;
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -92,4 +106,5 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
     LockGuard locker(_packetsLock);
     _channels.emplace_back(new std::list<PacketPointer>());
     _channels.back()->swap(packetList->_packets);
+    _numPackets += (int)_channels.back()->size();
 }
@@ -12,6 +12,7 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
+#include <atomic>
 #include <list>
 #include <vector>
 #include <memory>
@@ -41,6 +42,8 @@ public:
     
     bool isEmpty() const;
     PacketPointer takePacket();
+
+    int getNumPackets() const { return _numPackets; } // waiting to be sent, in all channels
     
     Mutex& getLock() { return _packetsLock; }
 
@@ -53,6 +56,8 @@ private:
     
     mutable Mutex _packetsLock; // Protects the packets to be sent.
     Channels _channels; // One channel per packet list + Main channel
+    RawChannel _highPriorityChannel; // single packets that are taken before any channel
+    std::atomic<int> _numPackets { 0 };
 
     Channels::iterator _currentChannel;
     unsigned int _channelsVisitedCount { 0 };
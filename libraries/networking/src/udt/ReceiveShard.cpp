@@ -0,0 +1,76 @@
+//
+//  ReceiveShard.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceiveShard.h"
+
+#if defined(Q_OS_LINUX)
+#include <poll.h>
+#endif
+
+#include "../NetworkLogging.h"
+#include "Constants.h"
+#include "NetworkSocket.h"
+#include "Socket.h"
+
+using namespace udt;
+
+// how often a shard waiting for datagrams checks whether it should stop
+static const int STOP_CHECK_INTERVAL_MSECS = 100;
+
+ReceiveShard::ReceiveShard(Socket& socket, int index, quint16 port) :
+    _socket(socket),
+    _index(index),
+    _port(port)
+{
+    setObjectName(QString("ReceiveShard%1").arg(index));
+}
+
+void ReceiveShard::stop() {
+    _stop = true;
+    wait();
+}
+
+void ReceiveShard::run() {
+#if defined(Q_OS_LINUX)
+    // the socket is created here so that it belongs to this thread
+    NetworkSocket networkSocket(nullptr);
+    if (!networkSocket.bindShared(QHostAddress::AnyIPv4, _port)) {
+        qCWarning(networking) << "Receive shard" << _index << "could not bind to port" << _port;
+        return;
+    }
+
+    pollfd descriptor;
+    descriptor.fd = (int)networkSocket.socketDescriptor(SocketType::UDP);
+    descriptor.events = POLLIN;
+
+    std::vector<NetworkSocket::ReceivedDatagram> datagrams;
+    datagrams.reserve(MAX_DATAGRAMS_PER_BATCH);
+
+    while (!_stop) {
+        descriptor.revents = 0;
+        if (poll(&descriptor, 1, STOP_CHECK_INTERVAL_MSECS) <= 0) {
+            continue;
+        }
+
+        int numRead;
+        while ((numRead = networkSocket.readDatagrams(datagrams)) > 0) {
+            _socket.processShardDatagrams(*this, datagrams, p_high_resolution_clock::now());
+            datagrams.clear();
+        }
+
+        if (numRead < 0) {
+            // closing our socket hands this shard's peers over to the other sockets on the port
+            qCWarning(networking) << "Receive shard" << _index << "could not read datagrams, stopping";
+            break;
+        }
+    }
+#endif
+}
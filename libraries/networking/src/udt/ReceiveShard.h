@@ -0,0 +1,48 @@
+//
+//  ReceiveShard.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ReceiveShard_h
+#define hifi_ReceiveShard_h
+
+#include <atomic>
+
+#include <QtCore/QThread>
+
+namespace udt {
+
+class Socket;
+
+// Reads a share of the inbound UDP traffic for a Socket on its own thread, from a second socket bound to the same port.
+// The system hashes each peer to one of the sockets, so all of the packets from a peer are read by the same shard.
+class ReceiveShard : public QThread {
+public:
+    ReceiveShard(Socket& socket, int index, quint16 port);
+
+    int getIndex() const { return _index; }
+    quint16 getPort() const { return _port; }
+
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    Socket& _socket;
+    const int _index;
+    const quint16 _port;
+    std::atomic<bool> _stop { false };
+};
+
+} // namespace udt
+
+#endif // hifi_ReceiveShard_h
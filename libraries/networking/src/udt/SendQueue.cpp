@@ -13,12 +13,6 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
-
-#include <QtCore/QCoreApplication>
-#include <QtCore/QDateTime>
-#include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -28,13 +22,7 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
-#include "../UserActivityLogger.h"
 #include "Socket.h"
-#include <Trace.h>
-#include <Profile.h>
-#include <ThreadHelpers.h>
-
-#include "../NetworkLogging.h"
 
 using namespace udt;
 using namespace std::chrono;
@@ -66,6 +54,14 @@ private:
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
+// the most packets sent in one service, so that one busy queue does not hold up the others on its thread
+static const int MAX_PACKETS_PER_SERVICE = 32;
+// how far behind its send period a queue may catch up in a burst, after it was serviced late
+static const auto MAX_PACING_LAG = milliseconds(5);
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, SockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -73,21 +69,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, SockAddr destinatio
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread();
-    QString name = "Networking: SendQueue " + destination.objectName();
-    thread->setObjectName(name); // Name thread for easier debug
-
-    connect(thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-
-    thread->start();
+    // the queue keeps the thread of its connection, its work is done on the threads of the socket's scheduler
+    queue->_scheduler->add(queue.get());
 
     return queue;
 }
@@ -96,52 +79,53 @@ SendQueue::SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequen
                      MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) :
     _packets(currentMessageNumber),
     _socket(socket),
+    _scheduler(&socket->getSendQueueScheduler()),
     _destination(dest)
 {
     // set our member variables from current sequence number
     _currentSequenceNumber = currentSequenceNumber;
     _atomicCurrentSequenceNumber = uint32_t(_currentSequenceNumber);
     _lastACKSequenceNumber = uint32_t(_currentSequenceNumber);
+    _lastSelectiveNAK = _currentSequenceNumber;
 
     _hasReceivedHandshakeACK = hasReceivedHandshakeACK;
 }
 
 SendQueue::~SendQueue() {
+    _scheduler->remove(this);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // wake the queue in case it is waiting for packets
+    wake();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
+    // wake the queue in case it is waiting for packets
+    wake();
+}
+
+void SendQueue::wake() {
+    if (_state != State::Stopped) {
+        _scheduler->wake(this);
     }
 }
 
 void SendQueue::stop() {
-    
     _state = State::Stopped;
-    
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+
+    // once this returns the queue is not being serviced, and never will be again
+    _scheduler->remove(this);
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
-    _lastPacketSentAt = std::chrono::high_resolution_clock::now();
+    _lastPacketSentAt = p_high_resolution_clock::now();
+
+    std::lock_guard<std::mutex> destinationLocker(_destinationLock);
     return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _destination);
 }
     
@@ -164,12 +148,17 @@ void SendQueue::ack(SequenceNumber ack) {
         if (!_naks.isEmpty() && _naks.getFirstSequenceNumber() <= ack) {
             _naks.remove(_naks.getFirstSequenceNumber(), ack);
         }
+
+        // keep the selective NAKs within reach of the sequence numbers in flight
+        if (_lastSelectiveNAK < ack) {
+            _lastSelectiveNAK = ack;
+        }
     }
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting with a full congestion window
+    wake();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -178,35 +167,51 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue in case it is waiting for losses to re-send
+    wake();
 }
 
-void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
+void SendQueue::selectiveNAK(SequenceNumber first, SequenceNumber last) {
+    {
+        std::lock_guard<std::mutex> nakLocker(_naksLock);
+
+        // the receiver repeats its newest loss ranges in a few ACKs, only re-send what it has not listed before
+        if (first <= _lastSelectiveNAK) {
+            first = _lastSelectiveNAK + 1;
+        }
+        SequenceNumber lastACK { (uint32_t) _lastACKSequenceNumber };
+        if (first <= lastACK) {
+            first = lastACK + 1;
+        }
+        if (last < first) {
+            return;
+        }
+
+        _naks.insert(first, last);
+        _lastSelectiveNAK = last;
     }
+
+    // wake the queue so it re-sends the losses
+    wake();
+}
+
+void SendQueue::sendHandshake() {
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+
+    std::lock_guard<std::mutex> destinationLocker(_destinationLock);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // start sending right away rather than at the next handshake re-send
+    wake();
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -250,40 +255,34 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueueScheduler::TimePoint SendQueue::service(SendQueueScheduler::TimePoint now) {
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
+        return SendQueueScheduler::NEVER;
     }
-    
     _state = State::Running;
-    
-    // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+    // Wait for handshake to be complete, no packets will be sent until we have received the handshake ACK
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeAt) {
+            sendHandshake();
+            _nextHandshakeAt = now + HANDSHAKE_RESEND_INTERVAL;
+            _nextPacketTimestamp = now;
+        }
+        // Once the handshake ACK is received we are woken up, otherwise it's going to be time to re-send a handshake.
+        return _nextHandshakeAt;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    // we were serviced late, send the packets that are due in a burst but don't fall too far behind
+    _nextPacketTimestamp = std::max(_nextPacketTimestamp, now - MAX_PACING_LAG);
+
+    for (int numPackets = 0; numPackets < MAX_PACKETS_PER_SERVICE; ++numPackets) {
+        if (_packetSendPeriod > 0 && _nextPacketTimestamp > now) {
+            // come back when the next packet is due
+            return _nextPacketTimestamp;
+        }
 
-    while (_state == State::Running) {
         bool attemptedToSendPacket = maybeResendPacket();
-        
+
         // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
         // (this is according to the current flow window size) then we send out a new packet
         auto newPacketCount = 0;
@@ -291,72 +290,25 @@ void SendQueue::run() {
             newPacketCount = maybeSendNewPacket();
             attemptedToSendPacket = (newPacketCount > 0);
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+
+        if (!attemptedToSendPacket) {
+            return waitForWork(now);
         }
 
+        _idleSince = _timeoutAt = p_high_resolution_clock::time_point();
+
         if (_packetSendPeriod > 0) {
             // push the next packet timestamp forwards by the current packet send period
             auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
-
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+            _nextPacketTimestamp += microseconds(nextPacketDelta);
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
-
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
-
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
-            }
-            
-            std::this_thread::sleep_for(timeToSleep);
+            // we use _nextPacketTimestamp so that we don't fall behind, never to wait for longer than nextPacketDelta
+            _nextPacketTimestamp = std::min(_nextPacketTimestamp, now + microseconds(nextPacketDelta));
         }
     }
+
+    // let the other queues of this thread go before we send more
+    return now;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -467,88 +419,80 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+SendQueueScheduler::TimePoint SendQueue::waitForWork(SendQueueScheduler::TimePoint now) {
+    // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
+    using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
+    DoubleLock doubleLock(_packets.getLock(), _naksLock);
+    DoubleLock::Lock locker(doubleLock);
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // something was queued since we looked
+        return now;
+    }
+
+    // The packets queue and loss list mutexes are now both locked and they're both empty
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        _timeoutAt = p_high_resolution_clock::time_point();
+        if (_idleSince == p_high_resolution_clock::time_point()) {
+            _idleSince = now;
+        }
 
+        if (now - _idleSince >= EMPTY_QUEUES_INACTIVE_TIMEOUT) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+            qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+                << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                << "seconds and receiver has ACKed all packets."
+                << "The queue is now inactive and will be stopped.";
 #endif
+            locker.unlock();
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
-
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
+            // Deactivate queue
+            deactivate();
+            return SendQueueScheduler::NEVER;
         }
+
+        // new packets wake us up before then
+        return _idleSince + EMPTY_QUEUES_INACTIVE_TIMEOUT;
     }
-    
-    return false;
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout
+    // (plus the sync interval to allow the client to respond) has elapsed
+    _idleSince = p_high_resolution_clock::time_point();
+
+    auto estimatedTimeout = microseconds(_estimatedTimeout);
+
+    // Clamp timeout beween 10 ms and 5 s
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    if (_timeoutAt == p_high_resolution_clock::time_point()) {
+        _timeoutAt = now + estimatedTimeout;
+    }
+
+    // we are stuck if we've waited for the estimated timeout or it has been that long since the last time we sent a
+    // packet, and the client has yet to ACK some sent packets (we know there is nothing to send or re-send)
+    if ((now >= _timeoutAt || now - _lastPacketSentAt > estimatedTimeout)
+        && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+
+        // Note that thanks to the DoubleLock we have the _naksLock right now
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+        _timeoutAt = p_high_resolution_clock::time_point();
+
+        // we have the lock again - time to unlock it
+        locker.unlock();
+
+        emit timeout();
+
+        // re-send the losses right away
+        return now;
+    }
+
+    // an ACK or new packets wake us up before then
+    return _timeoutAt;
 }
 
 void SendQueue::deactivate() {
@@ -563,5 +507,6 @@ bool SendQueue::isFlowWindowFull() const {
 }
 
 void SendQueue::updateDestinationAddress(SockAddr newAddress) {
+    std::lock_guard<std::mutex> destinationLocker(_destinationLock);
     _destination = newAddress;
 }
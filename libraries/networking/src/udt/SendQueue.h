@@ -14,7 +14,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -32,6 +31,7 @@
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
 #include "LossList.h"
+#include "SendQueueScheduler.h"
 
 namespace udt {
     
@@ -40,7 +40,10 @@ class ControlPacket;
 class Packet;
 class PacketList;
 class Socket;
-    
+
+// Sends the reliable packets of a Connection, paced and windowed by its congestion control.  Its work is done in
+// service, called by the SendQueueScheduler of the socket whenever the queue said it would next have work or was given
+// some, so that the queues of all connections share a few threads.
 class SendQueue : public QObject {
     Q_OBJECT
     
@@ -62,6 +65,7 @@ public:
 
     SequenceNumber getCurrentSequenceNumber() const { return SequenceNumber(_atomicCurrentSequenceNumber); }
     MessageNumber getCurrentMessageNumber() const { return _packets.getCurrentMessageNumber(); }
+    int getNumQueuedPackets() const { return _packets.getNumPackets(); }
     
     void setFlowWindowSize(int flowWindowSize) { _flowWindowSize = flowWindowSize; }
     
@@ -69,12 +73,16 @@ public:
     void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
-    
+
+    // Called by the scheduler, never by two threads at once: sends what is due and returns when to be called again.
+    SendQueueScheduler::TimePoint service(SendQueueScheduler::TimePoint now);
+
 public slots:
     void stop();
     
     void ack(SequenceNumber ack);
     void fastRetransmit(SequenceNumber ack);
+    void selectiveNAK(SequenceNumber first, SequenceNumber last); // a loss range the receiver listed after an ACK
     void handshakeACK();
     void updateDestinationAddress(SockAddr newAddress);
 
@@ -85,24 +93,23 @@ signals:
     void queueInactive();
 
     void timeout();
-    
-private slots:
-    void run();
-    
+
 private:
     Q_DISABLE_COPY_MOVE(SendQueue)
     SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     
     void sendHandshake();
-    
+    void wake();
+
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
     
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    // with nothing to send right now, waits for an ACK, a timeout or inactivity, and returns when to check again
+    SendQueueScheduler::TimePoint waitForWork(SendQueueScheduler::TimePoint now);
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -113,6 +120,8 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+    SendQueueScheduler* _scheduler { nullptr }; // Scheduler of the socket that services this queue
+    std::mutex _destinationLock; // Protects the destination, which changes on the connection thread
     SockAddr _destination; // Destination addr
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
@@ -129,18 +138,20 @@ private:
     
     mutable std::mutex _naksLock; // Protects the naks list.
     LossList _naks; // Sequence numbers of packets to resend
+    SequenceNumber _lastSelectiveNAK; // The highest sequence number the receiver listed as lost, protected by _naksLock
     
     mutable QReadWriteLock _sentLock; // Protects the sent packet list
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    // only touched by service
+    p_high_resolution_clock::time_point _lastPacketSentAt;
+    p_high_resolution_clock::time_point _nextHandshakeAt; // when to re-send the handshake
+    p_high_resolution_clock::time_point _nextPacketTimestamp; // when the next packet is due, by the send period
+    p_high_resolution_clock::time_point _idleSince; // since when everything sent was ACKed and there is nothing left
+    p_high_resolution_clock::time_point _timeoutAt; // when to give up waiting on ACKs and re-send the unACKed packets
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
@@ -0,0 +1,149 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QString>
+
+#include <ThreadHelpers.h>
+
+#include "SendQueue.h"
+
+using namespace udt;
+
+const SendQueueScheduler::TimePoint SendQueueScheduler::NEVER = SendQueueScheduler::TimePoint::max();
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) :
+    _numThreads(std::max(1, numThreads))
+{
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _condition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_threads.empty()) {
+        for (int i = 0; i < _numThreads; ++i) {
+            _threads.emplace_back(&SendQueueScheduler::run, this, i);
+        }
+    }
+
+    schedule(queue, _queues[queue], p_high_resolution_clock::now());
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    // a thread servicing the queue looks it up again once it is done, and does not reschedule it if it is gone
+    _serviceFinished.wait(lock, [&] { return !it->second.isServicing; });
+    _queues.erase(it);
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _queues.find(queue);
+    if (it == _queues.end()) {
+        return;
+    }
+
+    auto& state = it->second;
+    if (state.isServicing) {
+        // the queue might have looked for work before it was given this, service it again right after
+        state.wakeRequested = true;
+        return;
+    }
+
+    auto now = p_high_resolution_clock::now();
+    if (state.due > now) {
+        schedule(queue, state, now);
+    }
+}
+
+void SendQueueScheduler::schedule(SendQueue* queue, QueueState& state, TimePoint due) {
+    state.due = due;
+    ++state.ticket;
+    if (due != NEVER) {
+        _entries.push({ due, queue, state.ticket });
+        _condition.notify_one();
+    }
+}
+
+void SendQueueScheduler::run(int index) {
+    setThreadName(QString("Networking: SendQueue %1").arg(index).toStdString());
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_stop) {
+        // drop the entries of queues that were removed or rescheduled
+        while (!_entries.empty()) {
+            const auto& top = _entries.top();
+            auto it = _queues.find(top.queue);
+            if (it != _queues.end() && !it->second.isServicing && it->second.ticket == top.ticket) {
+                break;
+            }
+            _entries.pop();
+        }
+
+        if (_entries.empty()) {
+            _condition.wait(lock);
+            continue;
+        }
+
+        auto now = p_high_resolution_clock::now();
+        auto due = _entries.top().due;
+        if (due > now) {
+            // an earlier entry or a stop wakes us up
+            _condition.wait_until(lock, due);
+            continue;
+        }
+
+        SendQueue* queue = _entries.top().queue;
+        _entries.pop();
+
+        auto& state = _queues[queue];
+        state.isServicing = true;
+        state.wakeRequested = false;
+        state.due = NEVER;
+
+        lock.unlock();
+        auto nextDue = queue->service(now);
+        lock.lock();
+
+        // the state is still there, remove waits for this service to finish
+        auto it = _queues.find(queue);
+        it->second.isServicing = false;
+        if (it->second.wakeRequested) {
+            nextDue = std::min(nextDue, p_high_resolution_clock::now());
+        }
+        schedule(queue, it->second, nextDue);
+
+        _serviceFinished.notify_all();
+    }
+}
@@ -0,0 +1,84 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+// Services the SendQueues of every reliable connection of a Socket from a small pool of threads, rather than one thread
+// per connection.  Each queue is serviced when it says it next has work: its next paced packet, its handshake re-send or
+// its timeout.  A queue is only ever serviced by one thread at a time.
+class SendQueueScheduler {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    // a queue that returns NEVER is only serviced again once it is woken
+    static const TimePoint NEVER;
+    static const int DEFAULT_NUM_THREADS = 2;
+
+    SendQueueScheduler(int numThreads = DEFAULT_NUM_THREADS);
+    ~SendQueueScheduler();
+
+    // thread-safe, the queue is serviced as soon as a thread is free
+    void add(SendQueue* queue);
+    // thread-safe, returns once no thread is servicing the queue, after which it is never serviced again
+    void remove(SendQueue* queue);
+    // thread-safe, services the queue as soon as possible, for when it was given work
+    void wake(SendQueue* queue);
+
+private:
+    struct Entry {
+        TimePoint due;
+        SendQueue* queue;
+        uint64_t ticket; // the entry is stale once the queue was rescheduled with another ticket
+    };
+    struct Later {
+        bool operator()(const Entry& a, const Entry& b) const { return a.due > b.due; }
+    };
+    struct QueueState {
+        uint64_t ticket { 0 };
+        TimePoint due { NEVER };
+        bool isServicing { false };
+        bool wakeRequested { false };
+    };
+
+    void schedule(SendQueue* queue, QueueState& state, TimePoint due); // with _mutex locked
+    void run(int index);
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::condition_variable _serviceFinished;
+    std::priority_queue<Entry, std::vector<Entry>, Later> _entries; // guarded by _mutex
+    std::unordered_map<SendQueue*, QueueState> _queues; // guarded by _mutex
+    bool _stop { false }; // guarded by _mutex
+
+    const int _numThreads;
+    std::vector<std::thread> _threads; // started with the first queue
+};
+
+} // namespace udt
+
+#endif // hifi_SendQueueScheduler_h
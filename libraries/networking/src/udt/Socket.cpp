@@ -12,6 +12,8 @@
 
 #include "Socket.h"
 
+#include <iterator>
+
 #ifdef Q_OS_ANDROID
 #include <sys/socket.h>
 #endif
@@ -39,6 +41,19 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+namespace {
+    // unreliable datagrams queued by the calling thread between openWriteBatch() and flushWriteBatch()
+    struct WriteBatch {
+        Socket* socket { nullptr };
+        int depth { 0 };
+        std::vector<std::pair<QByteArray, SockAddr>> datagrams;
+        size_t numHighPriority { 0 }; // the high priority datagrams are kept at the front
+        std::vector<qint64> bytesWritten; // the result for each datagram when they are sent
+    };
+
+    thread_local WriteBatch writeBatch;
+}
+
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
@@ -58,8 +73,28 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
 }
 
+Socket::~Socket() {
+    for (auto& shard : _receiveShards) {
+        shard->stop();
+    }
+}
+
 void Socket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
-    _networkSocket.bind(socketType, address, port);
+    if (socketType == SocketType::UDP && _shareReceivePort) {
+        if (!_networkSocket.bindShared(address, port)) {
+            _networkSocket.bind(socketType, address, port);
+        }
+    } else {
+        _networkSocket.bind(socketType, address, port);
+    }
+
+    if (socketType == SocketType::UDP && !_receiveShards.empty()
+        && _networkSocket.localPort(socketType) != _receiveShards.front()->getPort()) {
+        // move the shards over to the new port
+        int numShards = getNumReceiveShards();
+        setNumReceiveShards(1);
+        setNumReceiveShards(numShards);
+    }
 
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes(socketType);
@@ -155,13 +190,14 @@ qint64 Socket::writePacket(const Packet& packet, const SockAddr& sockAddr) {
     auto connection = findOrCreateConnection(sockAddr, true);
     if (connection) {
         connection->recordSentUnreliablePackets(packet.getWireSize(),
-                                                packet.getPayloadSize());
+                                                packet.getPayloadSize(),
+                                                packet.getSendPriority());
     }
 
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
 
-    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr);
+    return writeDatagram(packet.getData(), packet.getDataSize(), sockAddr, packet.getSendPriority());
 }
 
 qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const SockAddr& sockAddr) {
@@ -209,9 +245,11 @@ qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const Soc
 
     // Unreliable and Unordered
     qint64 totalBytesSent = 0;
+    openWriteBatch();
     while (!packetList->_packets.empty()) {
         totalBytesSent += writePacket(packetList->takeFront<Packet>(), sockAddr);
     }
+    flushWriteBatch();
     return totalBytesSent;
 }
 
@@ -240,11 +278,11 @@ void Socket::writeReliablePacketList(PacketList* packetList, const SockAddr& soc
 #endif
 }
 
-qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sockAddr) {
-    return writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
+qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sockAddr, Packet::SendPriority priority) {
+    return writeDatagram(QByteArray::fromRawData(data, size), sockAddr, priority);
 }
 
-qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr, Packet::SendPriority priority) {
     auto socketType = sockAddr.getType();
 
     // don't attempt to write the datagram if we're unbound.  Just drop it.
@@ -254,8 +292,30 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAdd
         qCDebug(networking) << "Attempt to writeDatagram when in unbound state to" << sockAddr;
         return -1;
     }
+
+    if (writeBatch.socket == this && socketType == SocketType::UDP && NetworkSocket::hasBatchedDatagramIO()) {
+        // the datagram may point into a packet that doesn't outlive this call, so take a deep copy
+        QByteArray copy(datagram.constData(), datagram.size());
+        if (priority == Packet::SendPriority::High) {
+            writeBatch.datagrams.emplace(writeBatch.datagrams.begin() + writeBatch.numHighPriority, std::move(copy), sockAddr);
+            ++writeBatch.numHighPriority;
+        } else {
+            writeBatch.datagrams.emplace_back(std::move(copy), sockAddr);
+        }
+        if ((int)writeBatch.datagrams.size() >= MAX_DATAGRAMS_PER_BATCH) {
+            writeBatchedDatagrams();
+        }
+        // nothing has been sent yet
+        return 0;
+    }
+
     qint64 bytesWritten = _networkSocket.writeDatagram(datagram, sockAddr);
+    checkWriteResult(bytesWritten, sockAddr);
+    return bytesWritten;
+}
 
+void Socket::checkWriteResult(qint64 bytesWritten, const SockAddr& sockAddr) {
+    auto socketType = sockAddr.getType();
     int pending = _networkSocket.bytesToWrite(socketType, sockAddr);
     if (bytesWritten < 0 || pending) {
         int wsaError = 0;
@@ -278,8 +338,38 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAdd
             HIFI_FCDEBUG(networking(), errorString.toLatin1().constData());
         }
     }
+}
 
-    return bytesWritten;
+void Socket::writeBatchedDatagrams() {
+    _networkSocket.writeDatagrams(writeBatch.datagrams, writeBatch.bytesWritten);
+    for (size_t i = 0; i < writeBatch.datagrams.size(); ++i) {
+        checkWriteResult(writeBatch.bytesWritten[i], writeBatch.datagrams[i].second);
+    }
+    writeBatch.datagrams.clear();
+    writeBatch.numHighPriority = 0;
+}
+
+void Socket::openWriteBatch() {
+    if (writeBatch.socket == nullptr) {
+        writeBatch.socket = this;
+    }
+    if (writeBatch.socket == this) {
+        ++writeBatch.depth;
+    }
+}
+
+void Socket::flushWriteBatch() {
+    if (writeBatch.socket != this) {
+        return;
+    }
+
+    if (--writeBatch.depth == 0) {
+        if (!writeBatch.datagrams.empty()) {
+            writeBatchedDatagrams();
+        }
+        writeBatch.numHighPriority = 0;
+        writeBatch.socket = nullptr;
+    }
 }
 
 Connection* Socket::findOrCreateConnection(const SockAddr& sockAddr, bool filterCreate) {
@@ -383,6 +473,47 @@ void Socket::readPendingDatagrams() {
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
     int packetSizeWithHeader = -1;
 
+    // the WebRTC datagrams are already in packet buffers, take all of them at once
+    if (_networkSocket.readWebRTCDatagrams(_receivedDatagrams) > 0) {
+        _readyReadBackupTimer->start();
+
+        auto receiveTime = p_high_resolution_clock::now();
+        for (auto& datagram : _receivedDatagrams) {
+            _lastPacketSizeRead = datagram.size;
+            _lastPacketSockAddr = datagram.sockAddr;
+
+            if (datagram.size > 0) {
+                processDatagram(std::move(datagram.data), datagram.size, datagram.sockAddr, receiveTime);
+            }
+        }
+        _receivedDatagrams.clear();
+    }
+
+    // drain the UDP socket in batches where we can
+    int numRead = 0;
+    while (system_clock::now() <= abortTime && (numRead = _networkSocket.readDatagrams(_receivedDatagrams)) > 0) {
+        // we're reading packets so re-start the readyRead backup timer
+        _readyReadBackupTimer->start();
+
+        // grab a time point we can mark as the receive time of these packets
+        auto receiveTime = p_high_resolution_clock::now();
+
+        for (auto& datagram : _receivedDatagrams) {
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = datagram.size;
+            _lastPacketSockAddr = datagram.sockAddr;
+
+            if (datagram.size > 0) {
+                processDatagram(std::move(datagram.data), datagram.size, datagram.sockAddr, receiveTime);
+            }
+        }
+        _receivedDatagrams.clear();
+
+        if (numRead < MAX_DATAGRAMS_PER_BATCH) {
+            break;
+        }
+    }
+
     while (_networkSocket.hasPendingDatagrams() &&
            (packetSizeWithHeader = _networkSocket.pendingDatagramSize()) != -1) {
         if (system_clock::now() > abortTime) {
@@ -406,7 +537,7 @@ void Socket::readPendingDatagrams() {
         SockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
@@ -421,74 +552,229 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
+void Socket::processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    BasePacketHandler unfilteredHandler;
+    bool isUnfiltered = false;
+    {
+        Lock unfilteredHandlersLock(_unfilteredHandlersMutex);
+        auto it = _unfilteredHandlers.find(senderSockAddr);
         if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+            isUnfiltered = true;
+            unfilteredHandler = it->second;
+        }
+    }
 
-            continue;
+    if (isUnfiltered) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (unfilteredHandler) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            unfilteredHandler(std::move(basePacket));
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
+        processPacket(std::move(packet));
+    }
+}
+
+void Socket::processPacket(std::unique_ptr<Packet> packet) {
+    const SockAddr& senderSockAddr = packet->getSenderSockAddr();
+
+    // save the sequence number in case this is the packet that sticks readyRead
+    _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+    // call our verification operator to see if this packet is verified
+    if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (packet->isReliable()) {
+            // if this was a reliable packet then signal the matching connection with the sequence number
+
+            if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                          packet->getDataSize(),
+                                                                          packet->getPayloadSize())) {
+                // the connection could not be created or indicated that we should not continue processing this packet
+#ifdef UDT_CONNECTION_DEBUG
+                qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                    << ", type" << NLPacket::typeInHeader(*packet);
+#endif
+                return;
+            }
+        } else if (connection) {
+            connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                        packet->getPayloadSize());
+        }
+
+        if (packet->isPartOfMessage()) {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
             if (connection) {
-                connection->processControl(move(controlPacket));
+                connection->queueReceivedMessagePacket(std::move(packet));
             }
+        } else if (_packetHandler) {
+            // call the verified packet callback to let it handle this packet
+            _packetHandler(std::move(packet));
+        }
+    }
+}
+
+void Socket::setNumReceiveShards(int numShards) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setNumReceiveShards", Q_ARG(int, numShards));
+        return;
+    }
+
+    numShards = std::max(numShards, 1);
+#if !defined(Q_OS_LINUX)
+    if (numShards > 1) {
+        qCWarning(networking) << "Receive shards are not supported on this platform - using a single socket";
+        numShards = 1;
+    }
+#endif
+
+    if (numShards == getNumReceiveShards()) {
+        return;
+    }
+
+    for (auto& shard : _receiveShards) {
+        shard->stop();
+    }
+    _receiveShards.clear();
+
+    // handle whatever the shards left for us before dropping their queues
+    for (int i = 0; i < (int)_shardQueues.size(); ++i) {
+        processForwardedDatagrams(i);
+    }
+    _shardQueues.clear();
+
+    if (numShards == 1) {
+        qCDebug(networking) << "Reading UDP datagrams with a single socket";
+        return;
+    }
+
+    // every socket on the port must share it, including ours
+    if (!_shareReceivePort) {
+        _shareReceivePort = true;
+        rebind(SocketType::UDP);
+    }
+
+    quint16 port = _networkSocket.localPort(SocketType::UDP);
+    if (_networkSocket.state(SocketType::UDP) != QAbstractSocket::BoundState || port == 0) {
+        qCWarning(networking) << "Cannot start receive shards without a bound UDP socket";
+        return;
+    }
+
+    // the handlers must be in place before the shards start calling them
+    for (int i = 0; i < numShards - 1; ++i) {
+        _shardQueues.emplace_back(new ShardQueue());
+        _receiveShards.emplace_back(new ReceiveShard(*this, i, port));
+    }
+    for (auto& shard : _receiveShards) {
+        shard->start();
+    }
+
+    qCDebug(networking) << "Reading UDP port" << port << "with" << numShards << "receive shards";
+}
+
+void Socket::processShardDatagrams(ReceiveShard& shard, std::vector<NetworkSocket::ReceivedDatagram>& datagrams,
+                                   p_high_resolution_clock::time_point receiveTime) {
+    static const uint32_t SOCKET_THREAD_BITS = CONTROL_BIT_MASK | RELIABILITY_BIT_MASK | MESSAGE_BIT_MASK;
+
+    std::vector<ForwardedDatagram> forwarded;
 
+    for (auto& datagram : datagrams) {
+        if (datagram.size < (qint64)sizeof(uint32_t)) {
+            continue;
+        }
+
+        // control packets, reliable packets and messages need the Connection, which lives on the socket thread
+        bool isForSocketThread = !_shardPacketHandler ||
+            (*reinterpret_cast<uint32_t*>(datagram.data.get()) & SOCKET_THREAD_BITS);
+        if (!isForSocketThread) {
+            Lock unfilteredHandlersLock(_unfilteredHandlersMutex);
+            isForSocketThread = _unfilteredHandlers.find(datagram.sockAddr) != _unfilteredHandlers.end();
+        }
+
+        ForwardedDatagram forwardedDatagram;
+        if (isForSocketThread) {
+            forwardedDatagram.data = std::move(datagram.data);
+            forwardedDatagram.size = datagram.size;
+            forwardedDatagram.sockAddr = datagram.sockAddr;
+            forwardedDatagram.receiveTime = receiveTime;
         } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            auto packet = Packet::fromReceivedPacket(std::move(datagram.data), datagram.size, datagram.sockAddr);
             packet->setReceiveTime(receiveTime);
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+            if (_shardPacketHandler(packet)) {
+                continue;
+            }
+            forwardedDatagram.packet = std::move(packet);
+        }
+        forwarded.push_back(std::move(forwardedDatagram));
+    }
+
+    if (forwarded.empty()) {
+        return;
+    }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+    auto& queue = *_shardQueues[shard.getIndex()];
+    bool wasEmpty;
+    {
+        Lock queueLock(queue.mutex);
+        wasEmpty = queue.datagrams.empty();
+        std::move(forwarded.begin(), forwarded.end(), std::back_inserter(queue.datagrams));
+    }
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+    // the socket thread takes the whole queue at once, so it only needs a nudge when the queue was empty
+    if (wasEmpty) {
+        QMetaObject::invokeMethod(this, "processForwardedDatagrams", Qt::QueuedConnection, Q_ARG(int, shard.getIndex()));
+    }
+}
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
-#ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
-#endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
-
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
-            }
+void Socket::processForwardedDatagrams(int shardIndex) {
+    if (shardIndex >= (int)_shardQueues.size()) {
+        // the shard was stopped after it queued this call
+        return;
+    }
+
+    std::vector<ForwardedDatagram> datagrams;
+    {
+        auto& queue = *_shardQueues[shardIndex];
+        Lock queueLock(queue.mutex);
+        datagrams.swap(queue.datagrams);
+    }
+
+    for (auto& datagram : datagrams) {
+        if (datagram.packet) {
+            processPacket(std::move(datagram.packet));
+        } else {
+            processDatagram(std::move(datagram.data), datagram.size, datagram.sockAddr, datagram.receiveTime);
         }
     }
 }
@@ -502,6 +788,9 @@ void Socket::connectToSendSignal(const SockAddr& destinationAddr, QObject* recei
 }
 
 void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory) {
+    // connections are created under this lock, existing connections keep the congestion control they were made with
+    Lock connectionsLock(_connectionsHashMutex);
+
     // swap the current unique_ptr for the new factory
     _ccFactory.swap(ccFactory);
 }
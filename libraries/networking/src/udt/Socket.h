@@ -27,6 +27,8 @@
 #include "TCPVegasCC.h"
 #include "Connection.h"
 #include "NetworkSocket.h"
+#include "ReceiveShard.h"
+#include "SendQueueScheduler.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -39,13 +41,15 @@ class Packet;
 class PacketList;
 class SequenceNumber;
 
-using PacketFilterOperator = std::function<bool(const Packet&)>;
+// may modify the packet, to open its payload
+using PacketFilterOperator = std::function<bool(Packet&)>;
 using ConnectionCreationFilterOperator = std::function<bool(const SockAddr&)>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
 using PacketHandler = std::function<void(std::unique_ptr<Packet>)>;
 using MessageHandler = std::function<void(std::unique_ptr<Packet>)>;
 using MessageFailureHandler = std::function<void(SockAddr, udt::Packet::MessageNumber)>;
+using ShardPacketHandler = std::function<bool(std::unique_ptr<Packet>&)>;
 
 class Socket : public QObject {
     Q_OBJECT
@@ -57,16 +61,21 @@ public:
     using StatsVector = std::vector<std::pair<SockAddr, ConnectionStats::Stats>>;
  
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort(SocketType socketType) const { return _networkSocket.localPort(socketType); }
     
     // Simple functions writing to the socket with no processing
+    // they return the bytes written, or -1 on error - but 0 for a datagram queued in an open write batch, whose
+    // send errors are reported when the batch is flushed
     qint64 writeBasePacket(const BasePacket& packet, const SockAddr& sockAddr);
     qint64 writePacket(const Packet& packet, const SockAddr& sockAddr);
     qint64 writePacket(std::unique_ptr<Packet> packet, const SockAddr& sockAddr);
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const SockAddr& sockAddr);
-    qint64 writeDatagram(const char* data, qint64 size, const SockAddr& sockAddr);
-    qint64 writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr);
+    qint64 writeDatagram(const char* data, qint64 size, const SockAddr& sockAddr,
+                         Packet::SendPriority priority = Packet::SendPriority::Bulk);
+    qint64 writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr,
+                         Packet::SendPriority priority = Packet::SendPriority::Bulk);
     
     void bind(SocketType socketType, const QHostAddress& address, quint16 port = 0);
     void rebind(SocketType socketType, quint16 port);
@@ -76,11 +85,15 @@ public:
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
+
+    // called on the receive shard threads with unreliable data packets, returns true if it took the packet
+    // packets it leaves are handled on the socket thread as usual
+    void setShardPacketHandler(ShardPacketHandler handler) { _shardPacketHandler = handler; }
     void setConnectionCreationFilterOperator(ConnectionCreationFilterOperator filterOperator)
         { _connectionCreationFilterOperator = filterOperator; }
     
     void addUnfilteredHandler(const SockAddr& senderSockAddr, BasePacketHandler handler)
-        { _unfilteredHandlers[senderSockAddr] = handler; }
+        { Lock lock(_unfilteredHandlersMutex); _unfilteredHandlers[senderSockAddr] = handler; }
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
@@ -89,6 +102,22 @@ public:
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
     
     StatsVector sampleStatsForAllConnections();
+    NetworkSocket::DatagramStats sampleDatagramStats() { return _networkSocket.sampleDatagramStats(); }
+
+    // while a write batch is open on the calling thread, unreliable UDP datagrams are queued
+    // and sent together by flushWriteBatch() - batches may be nested
+    // high priority datagrams are sent ahead of the bulk ones queued before them
+    void openWriteBatch();
+    void flushWriteBatch();
+
+    int getNumReceiveShards() const { return (int)_receiveShards.size() + 1; }
+
+    // services the send queues of the reliable connections
+    SendQueueScheduler& getSendQueueScheduler() { return _sendQueueScheduler; }
+
+    // called by the receive shards with the datagrams they read
+    void processShardDatagrams(ReceiveShard& shard, std::vector<NetworkSocket::ReceivedDatagram>& datagrams,
+                               p_high_resolution_clock::time_point receiveTime);
 
 #if defined(WEBRTC_DATA_CHANNELS)
     const WebRTCSocket* getWebRTCSocket();
@@ -106,16 +135,25 @@ public slots:
     void clearConnections();
     void handleRemoteAddressChange(SockAddr previousAddress, SockAddr currentAddress);
 
+    // reads inbound UDP traffic with this many sockets and threads, sharded by source address (Linux only)
+    void setNumReceiveShards(int numShards);
+
 private slots:
     void readPendingDatagrams();
     void checkForReadyReadBackup();
+    void processForwardedDatagrams(int shardIndex);
 
     void handleSocketError(SocketType socketType, QAbstractSocket::SocketError socketError);
     void handleStateChanged(SocketType socketType, QAbstractSocket::SocketState socketState);
 
 private:
     void setSystemBufferSizes(SocketType socketType);
+    void processDatagram(PacketBuffer buffer, qint64 size, const SockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+    void processPacket(std::unique_ptr<Packet> packet);
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
+    void checkWriteResult(qint64 bytesWritten, const SockAddr& sockAddr);
+    void writeBatchedDatagrams();
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const SockAddr& destination);
@@ -131,13 +169,18 @@ private:
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
+    ShardPacketHandler _shardPacketHandler;
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
     Mutex _unreliableSequenceNumbersMutex;
     Mutex _connectionsHashMutex;
+    Mutex _unfilteredHandlersMutex;
 
     std::unordered_map<SockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<SockAddr, SequenceNumber> _unreliableSequenceNumbers;
+
+    // declared before the connections, so that it outlives their send queues
+    SendQueueScheduler _sendQueueScheduler;
     std::unordered_map<SockAddr, std::unique_ptr<Connection>> _connectionsHash;
 
     QTimer* _readyReadBackupTimer { nullptr };
@@ -148,6 +191,25 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    std::vector<NetworkSocket::ReceivedDatagram> _receivedDatagrams;
+
+    // datagrams read by a receive shard that must be handled on the socket thread, in the order they arrived
+    struct ForwardedDatagram {
+        PacketBuffer data;
+        qint64 size { 0 };
+        SockAddr sockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+        std::unique_ptr<Packet> packet;
+    };
+    struct ShardQueue {
+        Mutex mutex;
+        std::vector<ForwardedDatagram> datagrams;
+    };
+
+    std::vector<std::unique_ptr<ReceiveShard>> _receiveShards;
+    std::vector<std::unique_ptr<ShardQueue>> _shardQueues;
+    bool _shareReceivePort { false };
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     SockAddr _lastPacketSockAddr;
@@ -185,7 +185,8 @@ void WDCDataChannelObserver::OnMessage(const DataBuffer& buffer) {
 
 WDCConnection::WDCConnection(WebRTCDataChannels* parent, const QString& dataChannelID) :
     _parent(parent),
-    _dataChannelID(dataChannelID)
+    _dataChannelID(dataChannelID),
+    _address(WebRTCDataChannels::addressFromDataChannelID(dataChannelID))
 {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WDCConnection::WDCConnection() :" << dataChannelID;
@@ -370,24 +371,29 @@ void WDCConnection::onDataChannelMessageReceived(const DataBuffer& buffer) {
     qCDebug(networking_webrtc) << "WDCConnection::onDataChannelMessageReceived()";
 #endif
 
-    auto byteArray = QByteArray(buffer.data.data<char>(), (int)buffer.data.size());
+    auto data = buffer.data.data<char>();
+    auto size = (qint64)buffer.data.size();
+    ++_messagesReceived;
+    _bytesReceived += size;
 
     // Echo message back to sender.
-    if (byteArray.startsWith("echo:")) {
+    const char ECHO_PREFIX[] = "echo:";
+    const int ECHO_PREFIX_LENGTH = sizeof(ECHO_PREFIX) - 1;
+    if (size >= ECHO_PREFIX_LENGTH && memcmp(data, ECHO_PREFIX, ECHO_PREFIX_LENGTH) == 0) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Echo message back";
 #endif
-        auto addressParts = _dataChannelID.split(":");
-        if (addressParts.length() != 2) {
+        if (_address.isNull()) {
             qCWarning(networking_webrtc) << "Invalid dataChannelID:" << _dataChannelID;
             return;
         }
-        auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-        _parent->sendDataMessage(address, byteArray);  // Use parent method to exercise the code stack.
+        // Use parent method to exercise the code stack.
+        _parent->sendDataMessage(_address, QByteArray(data, (int)size));
         return;
     }
 
-    _parent->emitDataMessage(_dataChannelID, byteArray);
+    // The message is only copied once, by the handler into the buffer of the packet it becomes.
+    _parent->emitDataMessage(_address, data, size);
 }
 
 qint64 WDCConnection::getBufferedAmount() const {
@@ -410,13 +416,42 @@ bool WDCConnection::sendDataMessage(const DataBuffer& buffer) {
     if (!_dataChannel || _dataChannel->state() == DataChannelInterface::kClosing 
             || _dataChannel->state() == DataChannelInterface::kClosed) {
         // Data channel may have been closed while message to send was being prepared.
+        ++_messagesDropped;
         return false;
-    } else if (_dataChannel->buffered_amount() + buffer.size() > MAX_WEBRTC_BUFFER_SIZE) {
+    }
+
+    qint64 bufferedAmount = _dataChannel->buffered_amount();
+    if (bufferedAmount + (qint64)buffer.size() > MAX_WEBRTC_BUFFER_SIZE) {
         // Don't send, otherwise the data channel will be closed.
-        qCDebug(networking_webrtc) << "WebRTC send buffer overflow";
+        if (_messagesDropped++ == 0) {
+            qCDebug(networking_webrtc) << "WebRTC send buffer overflow on data channel" << _dataChannelID;
+        }
+        return false;
+    }
+
+    auto maxBufferedAmount = _maxBufferedAmount.load();
+    while (bufferedAmount > maxBufferedAmount && !_maxBufferedAmount.compare_exchange_weak(maxBufferedAmount, bufferedAmount)) {
+    }
+
+    if (!_dataChannel->Send(buffer)) {
+        ++_messagesDropped;
         return false;
     }
-    return _dataChannel->Send(buffer);
+    ++_messagesSent;
+    _bytesSent += buffer.size();
+    return true;
+}
+
+WebRTCDataChannelStats WDCConnection::getStats() const {
+    WebRTCDataChannelStats stats;
+    stats.messagesSent = _messagesSent;
+    stats.bytesSent = _bytesSent;
+    stats.messagesReceived = _messagesReceived;
+    stats.bytesReceived = _bytesReceived;
+    stats.messagesDropped = _messagesDropped;
+    stats.bufferedAmount = getBufferedAmount();
+    stats.maxBufferedAmount = _maxBufferedAmount;
+    return stats;
 }
 
 void WDCConnection::closePeerConnection() {
@@ -480,21 +515,23 @@ WebRTCDataChannels::~WebRTCDataChannels() {
 
 void WebRTCDataChannels::reset() {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::reset() :" << _connectionsByID.count();
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::reset() :" << _connectionsByAddress.count();
 #endif
-    QHashIterator<QString, WDCConnection*> i(_connectionsByID);
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    QHashIterator<SockAddr, WDCConnection*> i(_connectionsByAddress);
     while (i.hasNext()) {
         i.next();
         delete i.value();
     }
-    _connectionsByID.clear();
+    _connectionsByAddress.clear();
 }
 
 void WebRTCDataChannels::onDataChannelOpened(WDCConnection* connection, const QString& dataChannelID) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::onDataChannelOpened() :" << dataChannelID;
 #endif
-    _connectionsByID.insert(dataChannelID, connection);
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    _connectionsByAddress.insert(connection->getAddress(), connection);
 }
 
 void WebRTCDataChannels::onSignalingMessage(const QJsonObject& message) {
@@ -519,12 +556,18 @@ void WebRTCDataChannels::onSignalingMessage(const QJsonObject& message) {
     _nodeType = to;
 
     // Find or create a connection.
+    // Connections are only created on this thread, but the lock isn't held while creating one because that waits on the
+    // WebRTC signaling thread, which takes the lock when a data channel opens.
+    auto address = addressFromDataChannelID(from);
     WDCConnection* connection;
-    if (_connectionsByID.contains(from)) {
-        connection = _connectionsByID.value(from);
-    } else {
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        connection = _connectionsByAddress.value(address);
+    }
+    if (!connection) {
         connection = new WDCConnection(this, from);
-        _connectionsByID.insert(from, connection);
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _connectionsByAddress.insert(address, connection);
     }
 
     // Set the remote description and reply with an answer.
@@ -554,48 +597,82 @@ void WebRTCDataChannels::sendSignalingMessage(const QJsonObject& message) {
     emit signalingMessage(message);
 }
 
-void WebRTCDataChannels::emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray) {
+void WebRTCDataChannels::emitDataMessage(const SockAddr& address, const char* data, qint64 size) {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::emitDataMessage() :" << dataChannelID << byteArray.toHex()
-        << byteArray.length();
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::emitDataMessage() :" << address << size;
 #endif
-    auto addressParts = dataChannelID.split(":");
-    if (addressParts.length() != 2) {
-        qCWarning(networking_webrtc) << "Invalid dataChannelID:" << dataChannelID;
+    if (address.isNull()) {
+        qCWarning(networking_webrtc) << "Invalid WebRTC data channel address";
         return;
     }
-    auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-    emit dataMessage(address, byteArray);
+    if (_dataMessageHandler) {
+        _dataMessageHandler(address, data, size);
+    }
 }
 
 bool WebRTCDataChannels::sendDataMessage(const SockAddr& destination, const QByteArray& byteArray) {
-    auto dataChannelID = destination.toShortString();
+    std::pair<QByteArray, SockAddr> message(byteArray, destination);
+    return sendDataMessages(&message, 1) == 1;
+}
+
+int WebRTCDataChannels::sendDataMessages(const std::pair<QByteArray, SockAddr>* messages, int numMessages) {
+    int numSent = 0;
+
+    // Holding the lock keeps the connections from being deleted while they send.
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    WDCConnection* connection = nullptr;
+    const SockAddr* connectionAddress = nullptr;
+    for (int i = 0; i < numMessages; ++i) {
+        const auto& message = messages[i];
+        if (!connectionAddress || *connectionAddress != message.second) {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::sendDataMessage() :" << dataChannelID;
+            qCDebug(networking_webrtc) << "WebRTCDataChannels::sendDataMessages() :" << message.second;
 #endif
+            connection = _connectionsByAddress.value(message.second);
+            connectionAddress = &message.second;
+            if (!connection) {
+                qCWarning(networking_webrtc) << "Could not find WebRTC data channel to send message on!";
+            }
+        }
+        if (!connection) {
+            continue;
+        }
 
-    if (!_connectionsByID.contains(dataChannelID)) {
-        qCWarning(networking_webrtc) << "Could not find WebRTC data channel to send message on!";
-        return false;
+        // Copy straight into the buffer the data channel keeps, rather than through a std::string.
+        DataBuffer buffer(rtc::CopyOnWriteBuffer(message.first.constData(), message.first.size()), true);
+        if (connection->sendDataMessage(buffer)) {
+            ++numSent;
+        }
     }
-
-    auto connection = _connectionsByID.value(dataChannelID);
-    DataBuffer buffer(byteArray.toStdString(), true);
-    return connection->sendDataMessage(buffer);
+    return numSent;
 }
 
 qint64 WebRTCDataChannels::getBufferedAmount(const SockAddr& address) const {
-    auto dataChannelID = address.toShortString();
-    if (!_connectionsByID.contains(dataChannelID)) {
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    auto connection = _connectionsByAddress.value(address);
+    if (!connection) {
 #ifdef WEBRTC_DEBUG
-        qCDebug(networking_webrtc) << "WebRTCDataChannels::getBufferedAmount() : Channel doesn't exist:" << dataChannelID;
+        qCDebug(networking_webrtc) << "WebRTCDataChannels::getBufferedAmount() : Channel doesn't exist:" << address;
 #endif
         return 0;
     }
-    auto connection = _connectionsByID.value(dataChannelID);
     return connection->getBufferedAmount();
 }
 
+WebRTCDataChannelStats WebRTCDataChannels::getStats(const SockAddr& address) const {
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    auto connection = _connectionsByAddress.value(address);
+    return connection ? connection->getStats() : WebRTCDataChannelStats();
+}
+
+SockAddr WebRTCDataChannels::addressFromDataChannelID(const QString& dataChannelID) {
+    auto addressParts = dataChannelID.split(":");
+    if (addressParts.length() != 2) {
+        return SockAddr();
+    }
+    return SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
+}
+
 rtc::scoped_refptr<PeerConnectionInterface> WebRTCDataChannels::createPeerConnection(
         const std::shared_ptr<WDCPeerConnectionObserver> peerConnectionObserver) {
 #ifdef WEBRTC_DEBUG
@@ -643,7 +720,10 @@ void WebRTCDataChannels::closePeerConnectionNow(WDCConnection* connection) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Dispose of connection for channel:" << connection->getDataChannelID();
 #endif
-    _connectionsByID.remove(connection->getDataChannelID());
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _connectionsByAddress.remove(connection->getAddress());
+    }
     delete connection;
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Disposed of connection";
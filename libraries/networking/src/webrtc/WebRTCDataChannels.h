@@ -14,6 +14,10 @@
 #if defined(WEBRTC_DATA_CHANNELS)
 
 
+#include <atomic>
+#include <functional>
+#include <mutex>
+
 #include <QObject>
 #include <QHash>
 
@@ -31,6 +35,17 @@ class WDCConnection;
 /// @addtogroup Networking
 /// @{
 
+/// @brief The flow of messages on a WebRTC data channel.
+struct WebRTCDataChannelStats {
+    quint64 messagesSent { 0 };
+    quint64 bytesSent { 0 };
+    quint64 messagesReceived { 0 };
+    quint64 bytesReceived { 0 };
+    quint64 messagesDropped { 0 };  ///< Not sent because the channel was closing or its send buffer was full.
+    qint64 bufferedAmount { 0 };  ///< Bytes waiting to be sent.
+    qint64 maxBufferedAmount { 0 };  ///< The most bytes seen waiting to be sent.
+};
+
 /// @brief A WebRTC session description observer.
 class WDCSetSessionDescriptionObserver : public webrtc::SetSessionDescriptionObserver {
 public:
@@ -144,6 +159,10 @@ public:
     /// @return The data channel ID.
     QString getDataChannelID() const { return _dataChannelID; }
 
+    /// @brief Gets the data channel address, parsed once from the data channel ID.
+    /// @return The data channel address.
+    const SockAddr& getAddress() const { return _address; }
+
 
     /// @brief Sets the remote session description received from the remote client via the signaling channel.
     /// @param description The remote session description.
@@ -190,16 +209,31 @@ public:
 
 
     /// @brief Sends a message on the WebRTC data channel.
+    /// @details Thread-safe.
     /// @param buffer The message to send.
     /// @return `true` if the message was sent, otherwise `false`.
     bool sendDataMessage(const webrtc::DataBuffer& buffer);
 
+    /// @brief Gets the flow statistics of the WebRTC data channel.
+    /// @details Thread-safe.
+    /// @return The flow statistics of the WebRTC data channel.
+    WebRTCDataChannelStats getStats() const;
+
     /// @brief Closes the WebRTC peer connection.
     void closePeerConnection();
     
 private:
     WebRTCDataChannels* _parent;
     QString _dataChannelID;
+    SockAddr _address;
+
+    // Updated on the WebRTC threads and whichever thread sends.
+    std::atomic<quint64> _messagesSent { 0 };
+    std::atomic<quint64> _bytesSent { 0 };
+    std::atomic<quint64> _messagesReceived { 0 };
+    std::atomic<quint64> _bytesReceived { 0 };
+    std::atomic<quint64> _messagesDropped { 0 };
+    std::atomic<qint64> _maxBufferedAmount { 0 };
 
     rtc::scoped_refptr<WDCSetSessionDescriptionObserver> _setSessionDescriptionObserver { nullptr };
     rtc::scoped_refptr<WDCCreateSessionDescriptionObserver> _createSessionDescriptionObserver { nullptr };
@@ -227,11 +261,20 @@ private:
 /// A WebRTC data channel is identified by the IP address and port of the client WebSocket that was used when opening the data
 /// channel - this is considered to be the WebRTC data channel's address. The IP address and port of the actual WebRTC
 /// connection is not used.
+///
+/// Messages received are handed to the DataMessageHandler on the WebRTC thread that received them, without a trip through
+/// the Qt event loop. Messages may be sent from any thread.
 class WebRTCDataChannels : public QObject {
     Q_OBJECT
 
 public:
 
+    /// @brief Handles a data message received from an Interface client, on a WebRTC thread.
+    /// @param address The address of the signaling WebSocket that the client used to connect.
+    /// @param data The Vircadia protocol message, only valid for the duration of the call.
+    /// @param size The size of the message.
+    using DataMessageHandler = std::function<void(const SockAddr& address, const char* data, qint64 size)>;
+
     /// @brief Constructs a new WebRTCDataChannels object.
     /// @param parent The parent Qt object.
     WebRTCDataChannels(QObject* parent);
@@ -247,6 +290,11 @@ public:
 
     /// @brief Immediately closes all connections and resets the socket.
     void reset();
+
+    /// @brief Sets the handler of data messages received from Interface clients.
+    /// @details Must be set before any data channel opens.
+    /// @param handler The handler, called on the WebRTC thread that received the message.
+    void setDataMessageHandler(DataMessageHandler handler) { _dataMessageHandler = handler; }
     
     /// @brief Handles a WebRTC data channel opening.
     /// @param connection The WebRTC data channel connection.
@@ -257,22 +305,44 @@ public:
     /// @param message The WebRTC signaling message to send.
     void sendSignalingMessage(const QJsonObject& message);
 
-    /// @brief Emits a dataMessage received from the Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
-    /// @param byteArray The data message received.
-    void emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray);
+    /// @brief Hands a data message received from the Interface client to the DataMessageHandler.
+    /// @param address The address of the signaling WebSocket that the client used to connect.
+    /// @param data The data message received.
+    /// @param size The size of the data message.
+    void emitDataMessage(const SockAddr& address, const char* data, qint64 size);
 
     /// @brief Sends a data message to an Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
+    /// @details Thread-safe.
+    /// @param destination The address of the signaling WebSocket that the client used to connect.
     /// @param message The data message to send.
     /// @return `true` if the data message was sent, otherwise `false`.
     bool sendDataMessage(const SockAddr& destination, const QByteArray& message);
 
+    /// @brief Sends data messages to Interface clients, looking up each destination's data channel once per run of
+    /// messages to it.
+    /// @details Thread-safe.
+    /// @param messages The data messages to send, with their destinations.
+    /// @param numMessages The number of data messages to send.
+    /// @return The number of data messages sent.
+    int sendDataMessages(const std::pair<QByteArray, SockAddr>* messages, int numMessages);
+
     /// @brief Gets the number of bytes waiting to be sent on a data channel.
+    /// @details Thread-safe.
     /// @param address The address of the signaling WebSocket that the client used to connect.
     /// @return The number of bytes waiting to be sent on the data channel.
     qint64 getBufferedAmount(const SockAddr& address) const;
 
+    /// @brief Gets the flow statistics of a data channel.
+    /// @details Thread-safe.
+    /// @param address The address of the signaling WebSocket that the client used to connect.
+    /// @return The flow statistics of the data channel, all zero if there is no such data channel.
+    WebRTCDataChannelStats getStats(const SockAddr& address) const;
+
+    /// @brief Gets the address of a data channel from its ID.
+    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
+    /// @return The data channel address, null if the ID is invalid.
+    static SockAddr addressFromDataChannelID(const QString& dataChannelID);
+
     /// @brief Creates a new WebRTC peer connection for connecting to an Interface client.
     /// @param peerConnectionObserver An observer to monitor the WebRTC peer connection.
     /// @return The new WebRTC peer connection.
@@ -304,12 +374,6 @@ signals:
     /// @param message The WebRTC signaling message to send.
     void signalingMessage(const QJsonObject& message);
 
-    /// @brief A WebRTC data message received from the Interface client.
-    /// @details This message is for handling at a higher level in the Vircadia protocol.
-    /// @param address The address of the signaling WebSocket that the client used to connect.
-    /// @param byteArray The Vircadia protocol message.
-    void dataMessage(const SockAddr& address, const QByteArray& byteArray);
-
     /// @brief Signals that the peer connection for a WebRTC data channel should be closed.
     /// @details Used by {@link WebRTCDataChannels.closePeerConnection}.
     /// @param connection The WebRTC data channel connection.
@@ -327,9 +391,13 @@ private:
 
     rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> _peerConnectionFactory { nullptr };
 
-    QHash<QString, WDCConnection*> _connectionsByID;  // <client data channel ID, WDCConnection>
-    // The client's WebSocket IP and port is used as the data channel ID to uniquely identify each.
-    // The WebSocket IP address and port is formatted as "n.n.n.n:n", the same as used in WebRTCSignalingServer.
+    DataMessageHandler _dataMessageHandler;
+
+    mutable std::mutex _connectionsMutex;  // Guards _connectionsByAddress, which the WebRTC and sending threads use.
+    QHash<SockAddr, WDCConnection*> _connectionsByAddress;  // <client data channel address, WDCConnection>
+    // The client's WebSocket IP and port is used as the data channel address to uniquely identify each.
+    // The data channel ID is the WebSocket IP address and port formatted as "n.n.n.n:n", the same as used in
+    // WebRTCSignalingServer.
 };
 
 
@@ -24,8 +24,10 @@ WebRTCSocket::WebRTCSocket(QObject* parent) :
     connect(this, &WebRTCSocket::onSignalingMessage, &_dataChannels, &WebRTCDataChannels::onSignalingMessage);
     connect(&_dataChannels, &WebRTCDataChannels::signalingMessage, this, &WebRTCSocket::sendSignalingMessage);
 
-    // Route received data channel messages.
-    connect(&_dataChannels, &WebRTCDataChannels::dataMessage, this, &WebRTCSocket::onDataChannelReceivedMessage);
+    // Route received data channel messages, straight from the WebRTC thread that receives them.
+    _dataChannels.setDataMessageHandler([this](const SockAddr& source, const char* data, qint64 size) {
+        onDataChannelReceivedMessage(source, data, size);
+    });
 }
 
 void WebRTCSocket::setSocketOption(QAbstractSocket::SocketOption option, const QVariant& value) {
@@ -87,44 +89,76 @@ qint64 WebRTCSocket::writeDatagram(const QByteArray& datagram, const SockAddr& d
     return -1;
 }
 
+int WebRTCSocket::writeDatagrams(const std::pair<QByteArray, SockAddr>* datagrams, int numDatagrams) {
+    clearError();
+    int numSent = _dataChannels.sendDataMessages(datagrams, numDatagrams);
+    if (numSent < numDatagrams) {
+        setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to write datagram");
+    }
+    return numSent;
+}
+
 qint64 WebRTCSocket::bytesToWrite(const SockAddr& destination) const {
     return _dataChannels.getBufferedAmount(destination);
 }
 
 
 bool WebRTCSocket::hasPendingDatagrams() const {
-    return _receivedQueue.length() > 0;
+    std::lock_guard<std::mutex> lock(_receivedMutex);
+    return !_receivedQueue.empty();
 }
 
 qint64 WebRTCSocket::pendingDatagramSize() const {
-    if (_receivedQueue.length() > 0) {
-        return _receivedQueue.head().second.length();
+    std::lock_guard<std::mutex> lock(_receivedMutex);
+    if (!_receivedQueue.empty()) {
+        return _receivedQueue.front().size;
     }
     return -1;
 }
 
 qint64 WebRTCSocket::readDatagram(char* data, qint64 maxSize, QHostAddress* address, quint16* port) {
     clearError();
-    if (_receivedQueue.length() > 0) {
-        auto datagram = _receivedQueue.dequeue();
-        auto length = std::min((qint64)datagram.second.length(), maxSize);
-
-        if (data) {
-            memcpy(data, datagram.second.constData(), length);
+    Datagram datagram;
+    {
+        std::lock_guard<std::mutex> lock(_receivedMutex);
+        _isReadyReadPending = false;
+        if (_receivedQueue.empty()) {
+            setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to read datagram");
+            return -1;
         }
+        datagram = std::move(_receivedQueue.front());
+        _receivedQueue.pop_front();
+    }
 
-        if (address) {
-            *address = datagram.first.getAddress();
-        }
+    auto length = std::min(datagram.size, maxSize);
 
-        if (port) {
-            *port = datagram.first.getPort();
-        }
+    if (data) {
+        memcpy(data, datagram.data.get(), length);
+    }
 
-        return length;
+    if (address) {
+        *address = datagram.address.getAddress();
     }
-    setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to read datagram");
-    return -1;
+
+    if (port) {
+        *port = datagram.address.getPort();
+    }
+
+    return length;
+}
+
+int WebRTCSocket::readDatagrams(std::vector<Datagram>& datagrams) {
+    std::deque<Datagram> received;
+    {
+        std::lock_guard<std::mutex> lock(_receivedMutex);
+        _isReadyReadPending = false;
+        received.swap(_receivedQueue);
+    }
+
+    for (auto& datagram : received) {
+        datagrams.push_back(std::move(datagram));
+    }
+    return (int)received.size();
 }
 
 
@@ -147,9 +181,24 @@ void WebRTCSocket::clearError() {
 }
 
 
-void WebRTCSocket::onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message) {
-    _receivedQueue.enqueue(QPair<SockAddr, QByteArray>(source, message));
-    emit readyRead();
+void WebRTCSocket::onDataChannelReceivedMessage(const SockAddr& source, const char* data, qint64 size) {
+    Datagram datagram;
+    datagram.data = udt::PacketBufferPool::allocate(size);
+    memcpy(datagram.data.get(), data, size);
+    datagram.size = size;
+    datagram.address = source;
+
+    bool isReadyReadNeeded;
+    {
+        std::lock_guard<std::mutex> lock(_receivedMutex);
+        _receivedQueue.push_back(std::move(datagram));
+        isReadyReadNeeded = !_isReadyReadPending.exchange(true);
+    }
+
+    // Queued to the socket's thread; the reader takes everything that arrives before it runs.
+    if (isReadyReadNeeded) {
+        emit readyRead();
+    }
 }
 
 #endif // WEBRTC_DATA_CHANNELS
@@ -13,11 +13,16 @@
 
 #if defined(WEBRTC_DATA_CHANNELS)
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 #include <QAbstractSocket>
 #include <QObject>
-#include <QQueue>
 
 #include "WebRTCDataChannels.h"
+#include "../udt/PacketBufferPool.h"
 
 /// @addtogroup Networking
 /// @{
@@ -28,11 +33,21 @@
 /// @details A WebRTC data channel is identified by the IP address and port of the client WebSocket that was used when opening
 /// the data channel - this is considered to be the WebRTC data channel's address. The IP address and port of the actual WebRTC
 /// connection is not used.
+///
+/// Messages received are copied into packet buffers on the WebRTC thread that receives them and queued, and readyRead is only
+/// emitted when the queue goes from read to unread, so that a busy data channel doesn't cost an event per message.
 class WebRTCSocket : public QObject {
     Q_OBJECT
 
 public:
 
+    /// @brief A datagram received, in a buffer that can become a packet's.
+    struct Datagram {
+        udt::PacketBuffer data;
+        qint64 size { 0 };
+        SockAddr address;
+    };
+
     /// @brief Constructs a new WebRTCSocket object.
     /// @param parent Qt parent object.
     WebRTCSocket(QObject* parent);
@@ -91,6 +106,12 @@ public:
     /// @return The number of bytes if successfully sent, otherwise <code>-1</code>.
     qint64 writeDatagram(const QByteArray& datagram, const SockAddr& destination);
 
+    /// @brief Sends datagrams, looking up each destination's data channel once per run of datagrams to it.
+    /// @param datagrams The datagrams to send, with their destination WebRTC data channel addresses.
+    /// @param numDatagrams The number of datagrams to send.
+    /// @return The number of datagrams successfully sent.
+    int writeDatagrams(const std::pair<QByteArray, SockAddr>* datagrams, int numDatagrams);
+
     /// @brief Gets the number of bytes waiting to be written.
     /// @param destination The destination WebRTC data channel address.
     /// @return The number of bytes waiting to be written.
@@ -113,6 +134,16 @@ public:
     /// @return The number of bytes read on success; <code>-1</code> if reading unsuccessful.
     qint64 readDatagram(char* data, qint64 maxSize, QHostAddress* address = nullptr, quint16* port = nullptr);
 
+    /// @brief Takes all of the datagrams waiting to be read, without copying them.
+    /// @param datagrams The vector to append the datagrams to.
+    /// @return The number of datagrams taken.
+    int readDatagrams(std::vector<Datagram>& datagrams);
+
+    /// @brief Gets the flow statistics of a WebRTC data channel.
+    /// @param address The WebRTC data channel address.
+    /// @return The flow statistics of the data channel.
+    WebRTCDataChannelStats getDataChannelStats(const SockAddr& address) const { return _dataChannels.getStats(address); }
+
 
     /// @brief Gets the type of error that last occurred.
     /// @return The type of error that last occurred.
@@ -122,14 +153,6 @@ public:
     /// @return The description of the error that last occurred.
     QString errorString() const;
 
-public slots:
-
-    /// @brief Handles the WebRTC data channel receiving a message.
-    /// @details Queues the message to be read via readDatagram.
-    /// @param source The WebRTC data channel that the message was received on.
-    /// @param message The message that was received.
-    void onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message);
-
 signals:
 
     /// @brief Emitted when the state of the socket changes.
@@ -153,11 +176,20 @@ private:
     void setError(QAbstractSocket::SocketError errorType, QString errorString);
     void clearError();
 
+    /// @brief Handles the WebRTC data channel receiving a message.
+    /// @details Called on a WebRTC thread. Queues the message to be read via readDatagram or readDatagrams.
+    /// @param source The WebRTC data channel that the message was received on.
+    /// @param data The message that was received.
+    /// @param size The size of the message.
+    void onDataChannelReceivedMessage(const SockAddr& source, const char* data, qint64 size);
+
     WebRTCDataChannels _dataChannels;
 
     bool _isBound { false };
 
-    QQueue<QPair<SockAddr, QByteArray>> _receivedQueue;  // Messages received are queued for reading from the "socket".
+    mutable std::mutex _receivedMutex;
+    std::deque<Datagram> _receivedQueue;  // Messages received are queued for reading from the "socket".
+    std::atomic<bool> _isReadyReadPending { false };  // Set from a readyRead until the queue is next read.
 
     QAbstractSocket::SocketError _lastErrorType { QAbstractSocket::UnknownSocketError };
     QString _lastErrorString;
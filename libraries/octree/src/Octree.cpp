@@ -16,6 +16,7 @@
 #include <cmath>
 #include <fstream> // to load voxels from file
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDebug>
 #include <QEventLoop>
@@ -52,7 +53,7 @@
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -676,6 +677,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".bin")) {
+        return readFromBinaryFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -700,13 +705,15 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
         qCritical() << "Cannot open gzipped json file for reading: " << qFileName;
         return false;
     }
-    QByteArray compressedJsonData = file.readAll();
     QByteArray jsonData;
+    QBuffer jsonBuffer(&jsonData);
+    jsonBuffer.open(QIODevice::WriteOnly);
 
-    if (!gunzip(compressedJsonData, jsonData)) {
+    if (!gunzip(file, jsonBuffer)) {
         qCritical() << "json File not in gzip format: " << qFileName;
         return false;
     }
+    jsonBuffer.close();
 
     QDataStream jsonStream(jsonData);
     QUrl relativeURL = QUrl::fromLocalFile(qFileName).adjusted(QUrl::RemoveFilename);
@@ -866,13 +873,18 @@ bool Octree::readJSONFromStream(
         jsonBuffer += QByteArray(rawData, got);
     }
 
+    delete[] rawData;
+
     OctreeEntitiesFileParser octreeParser;
     octreeParser.setRelativeURL(relativeURL);
     octreeParser.setEntitiesString(jsonBuffer);
+    return readFromEntitiesParser(octreeParser, marketplaceID, isImport);
+}
 
+bool Octree::readFromEntitiesParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport) {
     QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
-        qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
+    if (!parser.parseEntities(asMap)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
         return false;
     }
 
@@ -880,9 +892,7 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap, isImport);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -896,6 +906,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToBinaryFile(qFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -979,14 +991,23 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
     QByteArray jsonDataForFile;
-    if (!toJSON(&jsonDataForFile, element, doGzip)) {
+    if (!toJSON(&jsonDataForFile, element, false)) {
         return false;
     }
 
     QSaveFile persistFile(fileName);
     bool success = false;
     if (persistFile.open(QIODevice::WriteOnly)) {
-        if (persistFile.write(jsonDataForFile) != -1) {
+        // compressed straight into the file, rather than into a copy of it first
+        bool written;
+        if (doGzip) {
+            QBuffer jsonBuffer(&jsonDataForFile);
+            jsonBuffer.open(QIODevice::ReadOnly);
+            written = gzip(jsonBuffer, persistFile, -1);
+        } else {
+            written = persistFile.write(jsonDataForFile) != -1;
+        }
+        if (written) {
             success = persistFile.commit();
             if (!success) {
                 qCritical() << "Failed to commit to JSON save file:" << persistFile.errorString();
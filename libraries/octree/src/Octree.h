@@ -15,6 +15,8 @@
 #include <memory>
 #include <set>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
@@ -26,6 +28,7 @@
 
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
+#include "OctreeJournal.h"
 #include "OctreePacketData.h"
 #include "OctreeSceneStats.h"
 #include "OctreeUtils.h"
@@ -33,6 +36,7 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeEntitiesFileParser;
 class OctreePacketData;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
@@ -136,6 +140,9 @@ public:
     virtual PacketType expectedDataPacketType() const { return PacketType::Unknown; }
     virtual PacketVersion expectedVersion() const { return versionForPacketType(expectedDataPacketType()); }
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
+    // called with a packet of edits before the tree is locked for writing to apply them, for the work on them that only
+    // reads the tree; the message is left at the same position
+    virtual void prefilterEditPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -213,6 +220,8 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    // the binary persist format (see OctreeBinaryFile), trees that don't have one return false
+    virtual bool writeToBinaryFile(const QString& fileName, const OctreeElementPointer& element) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -222,6 +231,14 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    // the parser has the JSON contents, trees that can read it as it is parsed override this
+    virtual bool readFromEntitiesParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID = "",
+                                        const bool isImport = false);
+    // loads a binary snapshot with the journal of changes since it applied on top
+    virtual bool readFromBinaryFile(const QString& fileName,
+                                    const std::vector<OctreeJournal::Entry>& journalEntries = {}) { return false; }
+    // adds the changes made since the last call to the journal, trees that don't journal their changes return false
+    virtual bool appendChangesToJournal(OctreeJournal& journal) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -260,7 +277,12 @@ public:
     virtual quint64 getAverageFilterTime() const { return 0; }
 
     void incrementPersistDataVersion() { _persistDataVersion++; }
+    const QUuid& getPersistID() const { return _persistID; }
+    int getPersistDataVersion() const { return _persistDataVersion; }
 
+    // how long each stage of the last load took in usecs, for trees that load in stages
+    using LoadPhases = std::vector<std::pair<QString, quint64>>;
+    LoadPhases takeLoadPhases() { LoadPhases phases; phases.swap(_loadPhases); return phases; }
 
 protected:
     void deleteOctalCodeFromTreeRecursion(const OctreeElementPointer& element, void* extraData);
@@ -277,6 +299,9 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
+    void addLoadPhase(const QString& name, quint64 usecs) { _loadPhases.emplace_back(name, usecs); }
+    LoadPhases _loadPhases;
+
     bool _isDirty;
     bool _shouldReaverage;
 
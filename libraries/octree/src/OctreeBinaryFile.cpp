@@ -0,0 +1,245 @@
+//
+//  OctreeBinaryFile.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryFile.h"
+
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+
+#include <Gzip.h>
+
+#include "OctreeLogging.h"
+
+using namespace OctreeBinaryFile;
+
+namespace {
+    // records are gathered until a chunk holds about this much, so a chunk decodes quickly on its own
+    const int TARGET_CHUNK_SIZE = 256 * 1024;
+    // faster than the default level, persisting often matters more than the last few percent
+    const int CHUNK_COMPRESSION_LEVEL = 3;
+
+    const int UUID_SIZE = 16;
+    const int HEADER_SIZE = 4 + 4 + 1 + 1 + 2 + UUID_SIZE + 4 + 4 + 4 + 4;
+    const int CHUNK_INFO_SIZE = 8 + 4 + 4 + 4;
+    const int RECORD_INDEX_ENTRY_SIZE = UUID_SIZE + 4 + 4 + 1 + 3;
+
+    template <typename T>
+    void appendValue(QByteArray& buffer, T value) {
+        T littleEndian = qToLittleEndian(value);
+        buffer.append(reinterpret_cast<const char*>(&littleEndian), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(const char*& data) {
+        T value = qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data));
+        data += sizeof(T);
+        return value;
+    }
+}
+
+Writer::Writer(uint8_t version, const QUuid& id, int dataVersion, const QByteArray& metadata, Compression compression) :
+    _version(version),
+    _id(id),
+    _dataVersion(dataVersion),
+    _metadata(metadata),
+    _compression(compression)
+{
+}
+
+void Writer::addRecord(const QUuid& id, uint8_t encoding, const QByteArray& data) {
+    _chunkIndex.append(id.toRfc4122());
+    appendValue<uint32_t>(_chunkIndex, (uint32_t)_chunkRecords.size());
+    appendValue<uint32_t>(_chunkIndex, (uint32_t)data.size());
+    appendValue<uint8_t>(_chunkIndex, encoding);
+    _chunkIndex.append(3, '\0');
+
+    _chunkRecords.append(data);
+    ++_chunkNumRecords;
+    ++_numRecords;
+
+    if (_chunkIndex.size() + _chunkRecords.size() >= TARGET_CHUNK_SIZE) {
+        finishChunk();
+    }
+}
+
+void Writer::finishChunk() {
+    if (_chunkNumRecords == 0) {
+        return;
+    }
+
+    Chunk chunk;
+    chunk.data = _chunkIndex + _chunkRecords;
+    chunk.uncompressedSize = (uint32_t)chunk.data.size();
+    chunk.numRecords = _chunkNumRecords;
+    _chunks.push_back(chunk);
+
+    _chunkIndex.clear();
+    _chunkRecords.clear();
+    _chunkNumRecords = 0;
+}
+
+bool Writer::write(const QString& fileName) {
+    finishChunk();
+
+    // compressing here rather than as records are added keeps it out of any lock held while adding them
+    if (_compression == GzipCompression) {
+        for (auto& chunk : _chunks) {
+            QByteArray compressed;
+            gzip(chunk.data, compressed, CHUNK_COMPRESSION_LEVEL);
+            chunk.data = compressed;
+        }
+    }
+
+    QByteArray header;
+    header.append(MAGIC);
+    appendValue<uint32_t>(header, FORMAT_VERSION);
+    appendValue<uint8_t>(header, _version);
+    appendValue<uint8_t>(header, _compression);
+    appendValue<uint16_t>(header, 0);
+    header.append(_id.toRfc4122());
+    appendValue<int32_t>(header, _dataVersion);
+    appendValue<uint32_t>(header, _numRecords);
+    appendValue<uint32_t>(header, (uint32_t)_chunks.size());
+    appendValue<uint32_t>(header, (uint32_t)_metadata.size());
+    header.append(_metadata);
+
+    uint64_t chunkOffset = header.size() + _chunks.size() * CHUNK_INFO_SIZE;
+    for (const auto& chunk : _chunks) {
+        appendValue<uint64_t>(header, chunkOffset);
+        appendValue<uint32_t>(header, (uint32_t)chunk.data.size());
+        appendValue<uint32_t>(header, chunk.uncompressedSize);
+        appendValue<uint32_t>(header, chunk.numRecords);
+        chunkOffset += chunk.data.size();
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCritical() << "Failed to open binary octree file for writing:" << fileName << file.errorString();
+        return false;
+    }
+
+    bool success = file.write(header) == header.size();
+    for (const auto& chunk : _chunks) {
+        success = success && file.write(chunk.data) == chunk.data.size();
+    }
+    if (!success) {
+        qCritical() << "Failed to write binary octree file:" << fileName << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        qCritical() << "Failed to commit binary octree file:" << fileName << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool Reader::open(const QString& fileName) {
+    if (!isBinaryFile(fileName)) {
+        return false;
+    }
+
+    _storage = std::make_shared<storage::FileStorage>(fileName);
+    if (!(*_storage) || _storage->size() < (size_t)HEADER_SIZE) {
+        qCWarning(octree) << "Unable to map binary octree file" << fileName;
+        return false;
+    }
+
+    const char* data = reinterpret_cast<const char*>(_storage->data());
+    const char* end = data + _storage->size();
+    data += MAGIC.size();
+
+    uint32_t formatVersion = readValue<uint32_t>(data);
+    if (formatVersion > FORMAT_VERSION) {
+        qCWarning(octree) << "Binary octree file" << fileName << "has unknown format version" << formatVersion;
+        return false;
+    }
+    _version = readValue<uint8_t>(data);
+    _compression = (Compression)readValue<uint8_t>(data);
+    data += sizeof(uint16_t);
+    _id = QUuid::fromRfc4122(QByteArray::fromRawData(data, UUID_SIZE));
+    data += UUID_SIZE;
+    _dataVersion = readValue<int32_t>(data);
+    _numRecords = readValue<uint32_t>(data);
+    uint32_t numChunks = readValue<uint32_t>(data);
+    uint32_t metadataSize = readValue<uint32_t>(data);
+
+    if ((uint64_t)(end - data) < (uint64_t)metadataSize + (uint64_t)numChunks * CHUNK_INFO_SIZE) {
+        qCWarning(octree) << "Binary octree file" << fileName << "is truncated";
+        return false;
+    }
+    _metadata = QByteArray(data, metadataSize);
+    data += metadataSize;
+
+    _chunks.resize(numChunks);
+    for (auto& chunk : _chunks) {
+        chunk.offset = readValue<uint64_t>(data);
+        chunk.compressedSize = readValue<uint32_t>(data);
+        chunk.uncompressedSize = readValue<uint32_t>(data);
+        chunk.numRecords = readValue<uint32_t>(data);
+        if (chunk.offset + chunk.compressedSize > _storage->size()) {
+            qCWarning(octree) << "Binary octree file" << fileName << "is truncated";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Reader::readChunk(int index, QByteArray& buffer, std::vector<Record>& records) const {
+    records.clear();
+    if (index < 0 || index >= (int)_chunks.size()) {
+        return false;
+    }
+
+    const ChunkInfo& chunk = _chunks[index];
+    auto compressed = QByteArray::fromRawData(reinterpret_cast<const char*>(_storage->data()) + chunk.offset,
+                                              (int)chunk.compressedSize);
+    if (_compression == GzipCompression) {
+        if (!gunzip(compressed, buffer)) {
+            return false;
+        }
+    } else {
+        buffer = QByteArray(compressed.constData(), compressed.size());
+    }
+
+    if ((uint32_t)buffer.size() != chunk.uncompressedSize
+        || (uint64_t)buffer.size() < (uint64_t)chunk.numRecords * RECORD_INDEX_ENTRY_SIZE) {
+        return false;
+    }
+
+    const char* recordsStart = buffer.constData() + chunk.numRecords * RECORD_INDEX_ENTRY_SIZE;
+    const uint64_t recordsSize = buffer.size() - chunk.numRecords * RECORD_INDEX_ENTRY_SIZE;
+    const char* entry = buffer.constData();
+    records.resize(chunk.numRecords);
+    for (auto& record : records) {
+        record.id = QUuid::fromRfc4122(QByteArray::fromRawData(entry, UUID_SIZE));
+        entry += UUID_SIZE;
+        uint32_t offset = readValue<uint32_t>(entry);
+        uint32_t size = readValue<uint32_t>(entry);
+        record.encoding = readValue<uint8_t>(entry);
+        entry += 3;
+
+        if ((uint64_t)offset + size > recordsSize) {
+            records.clear();
+            return false;
+        }
+        record.data = recordsStart + offset;
+        record.size = (int)size;
+    }
+    return true;
+}
+
+bool OctreeBinaryFile::isBinaryFile(const QString& fileName) {
+    QFile file(fileName);
+    return file.open(QIODevice::ReadOnly) && file.read(MAGIC.size()) == MAGIC;
+}
@@ -0,0 +1,124 @@
+//
+//  OctreeBinaryFile.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeBinaryFile_h
+#define hifi_OctreeBinaryFile_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include <shared/Storage.h>
+
+// The container of the binary persist format: a header naming the data version and owner, then records grouped
+// into separately compressed chunks. Each chunk starts with an index of the ids and offsets of its records, so a
+// reader can find a record, or skip a chunk, without decoding any records. What a record holds is up to the tree;
+// the entity tree stores each entity in the same encoding as its edit packets.
+//
+//     header:      magic, format version, data packet version, compression, id, data version, record and chunk
+//                  counts, metadata size and metadata
+//     chunk table: for each chunk, its file offset, compressed and uncompressed sizes and record count
+//     chunks:      each one compressed on its own, holding a record index then the records
+//
+// All integers are little endian.
+namespace OctreeBinaryFile {
+
+    const QByteArray MAGIC { "VOBF" };
+    const uint32_t FORMAT_VERSION = 1;
+
+    enum Compression : uint8_t {
+        NoCompression = 0,
+        GzipCompression = 1
+    };
+
+    struct Record {
+        QUuid id;
+        uint8_t encoding { 0 }; // what the tree wrote the record as
+        const char* data { nullptr };
+        int size { 0 };
+    };
+
+    class Writer {
+    public:
+        Writer(uint8_t version, const QUuid& id, int dataVersion, const QByteArray& metadata,
+               Compression compression = GzipCompression);
+
+        void addRecord(const QUuid& id, uint8_t encoding, const QByteArray& data);
+
+        // compresses the chunks and saves the file in one go, replacing what was there
+        bool write(const QString& fileName);
+
+        uint32_t getNumRecords() const { return _numRecords; }
+
+    private:
+        struct Chunk {
+            QByteArray data;
+            uint32_t uncompressedSize;
+            uint32_t numRecords;
+        };
+
+        void finishChunk();
+
+        uint8_t _version;
+        QUuid _id;
+        int _dataVersion;
+        QByteArray _metadata;
+        Compression _compression;
+
+        QByteArray _chunkIndex;
+        QByteArray _chunkRecords;
+        uint32_t _chunkNumRecords { 0 };
+
+        std::vector<Chunk> _chunks;
+        uint32_t _numRecords { 0 };
+    };
+
+    // Maps the file and reads only its header and chunk table until a chunk is asked for.
+    class Reader {
+    public:
+        bool open(const QString& fileName);
+
+        uint8_t getVersion() const { return _version; }
+        const QUuid& getID() const { return _id; }
+        int getDataVersion() const { return _dataVersion; }
+        const QByteArray& getMetadata() const { return _metadata; }
+        uint32_t getNumRecords() const { return _numRecords; }
+        int getNumChunks() const { return (int)_chunks.size(); }
+
+        // decompresses one chunk into buffer, the records point into it and are valid until it changes
+        bool readChunk(int index, QByteArray& buffer, std::vector<Record>& records) const;
+
+    private:
+        struct ChunkInfo {
+            uint64_t offset;
+            uint32_t compressedSize;
+            uint32_t uncompressedSize;
+            uint32_t numRecords;
+        };
+
+        storage::StoragePointer _storage;
+        uint8_t _version { 0 };
+        Compression _compression { NoCompression };
+        QUuid _id;
+        int _dataVersion { -1 };
+        QByteArray _metadata;
+        uint32_t _numRecords { 0 };
+        std::vector<ChunkInfo> _chunks;
+    };
+
+    // true if the file starts like a binary persist file
+    bool isBinaryFile(const QString& fileName);
+}
+
+#endif // hifi_OctreeBinaryFile_h
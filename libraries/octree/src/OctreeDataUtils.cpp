@@ -20,13 +20,17 @@
 #include <QFile>
 
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromMap(const QVariantMap& map) {
+    readHeader(map);
+    readSubclassData(map);
+    return true;
+}
+
+void OctreeUtils::RawOctreeData::readHeader(const QVariantMap& map) {
     if (map.contains("Id") && map.contains("DataVersion") && map.contains("Version")) {
         id = map["Id"].toUuid();
         dataVersion = map["DataVersion"].toInt();
         version = map["Version"].toInt();
     }
-    readSubclassData(map);
-    return true;
 }
 
 bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
@@ -35,15 +39,17 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromData(QByteArray data) {
         data = jsonData;
     }
 
+    // the entities go straight to the subclass, if it keeps them, rather than through a map of them all
     OctreeEntitiesFileParser jsonParser;
     jsonParser.setEntitiesString(data);
-    QVariantMap entitiesMap;
-    if (!jsonParser.parseEntities(entitiesMap)) {
+    QVariantMap header;
+    if (!jsonParser.parseEntities(header, getSubclassEntityReader())) {
         qCritical() << "Can't parse Entities JSON: " << jsonParser.getErrorString().c_str();
         return false;
     }
 
-    return readOctreeDataInfoFromMap(entitiesMap);
+    readHeader(header);
+    return true;
 }
 
 // Reads octree file and parses it into a RawOctreeData object.
@@ -100,6 +106,14 @@ void OctreeUtils::RawEntityData::readSubclassData(const QVariantMap& root) {
     variantEntityData = root["Entities"].toList();
 }
 
+OctreeEntitiesFileParser::EntityCallback OctreeUtils::RawEntityData::getSubclassEntityReader() {
+    variantEntityData.clear();
+    return [this](QJsonObject& entity) {
+        variantEntityData.append(entity);
+        return true;
+    };
+}
+
 void OctreeUtils::RawEntityData::writeSubclassData(QByteArray& root) const {
     root += "  \"Entities\": [";
     for (auto entityIter = variantEntityData.begin(); entityIter != variantEntityData.end(); ++entityIter) {
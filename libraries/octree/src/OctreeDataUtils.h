@@ -17,6 +17,8 @@
 #include <QUuid>
 #include <QJsonArray>
 
+#include "OctreeEntitiesFileParser.h"
+
 namespace OctreeUtils {
 
 using Version = int64_t;
@@ -40,9 +42,16 @@ public:
     QByteArray toByteArray();
     QByteArray toGzippedByteArray();
 
+    // only the subclasses that keep the entities parse them
     bool readOctreeDataInfoFromData(QByteArray data);
     bool readOctreeDataInfoFromFile(QString path);
     bool readOctreeDataInfoFromMap(const QVariantMap& map);
+
+protected:
+    virtual OctreeEntitiesFileParser::EntityCallback getSubclassEntityReader() { return nullptr; }
+
+private:
+    void readHeader(const QVariantMap& map);
 };
 
 class RawEntityData : public RawOctreeData {
@@ -52,6 +61,9 @@ public:
     void writeSubclassData(QByteArray& root) const override;
 
     QVariantList variantEntityData;
+
+protected:
+    OctreeEntitiesFileParser::EntityCallback getSubclassEntityReader() override;
 };
 
 }
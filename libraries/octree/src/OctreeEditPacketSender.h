@@ -37,7 +37,7 @@ public:
     /// interval to ensure that the packets are actually sent. Can be called even before servers are known, in
     /// which case  up to MaxPendingMessages of the released messages will be buffered and actually released when
     /// servers are known.
-    void releaseQueuedMessages();
+    virtual void releaseQueuedMessages();
 
     /// are we in sending mode. If we're not in sending mode then all packets and messages will be ignored and
     /// not queued and not sent
@@ -12,6 +12,7 @@
 
 #include "OctreeEntitiesFileParser.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cctype>
 
@@ -39,6 +40,18 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    QVariantList entitiesValue;
+    bool success = parseEntities(parsedEntities, [&](QJsonObject& entity) {
+        entitiesValue.append(entity);
+        return true;
+    });
+    if (success) {
+        parsedEntities["Entities"] = std::move(entitiesValue);
+    }
+    return success;
+}
+
+bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities, const EntityCallback& entityCallback) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -49,6 +62,10 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
     bool gotId = false;
     bool gotVersion = false;
 
+    // the entities are read once the rest is, since older content needs the version to be read correctly
+    int entitiesPosition = 0;
+    int entitiesLine = 0;
+
     int token = nextToken();
 
     while (true) {
@@ -86,12 +103,25 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            if (nextToken() != '[') {
+                _errorString = "Entities entry is not an array";
                 return false;
             }
+            entitiesPosition = _position;
+            entitiesLine = _line;
 
-            parsedEntities["Entities"] = std::move(entitiesValue);
+            if (nextToken() != '{') {
+                _errorString = "Entity array item is not an object";
+                return false;
+            }
+            int matchingBracket = findMatchingBrace('[', ']');
+            if (matchingBracket < 0) {
+                _errorString = "Unterminated entities array";
+                return false;
+            }
+            const char* contents = _entitiesContents.constData();
+            _line += (int)std::count(contents + _position, contents + matchingBracket, '\n');
+            _position = matchingBracket;
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -170,6 +200,12 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
         return false;
     }
 
+    if (gotEntities && entityCallback) {
+        _position = entitiesPosition;
+        _line = entitiesLine;
+        return readEntitiesArray(entityCallback);
+    }
+
     return true;
 }
 
@@ -214,12 +250,7 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
-    if (nextToken() != '[') {
-        _errorString = "Entities entry is not an array";
-        return false;
-    }
-
+bool OctreeEntitiesFileParser::readEntitiesArray(const EntityCallback& entityCallback) {
     while (true) {
         if (nextToken() != '{') {
             _errorString = "Entity array item is not an object";
@@ -326,7 +357,11 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             }
         }
 
-        entitiesArray.append(entityObject);
+        if (!entityCallback(entityObject)) {
+            _errorString = "Entity not accepted";
+            return false;
+        }
+        _line += (int)std::count(_entitiesContents.constData() + _position, _entitiesContents.constData() + matchingBrace, '\n');
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
@@ -339,19 +374,20 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
     return true;
 }
 
-int OctreeEntitiesFileParser::findMatchingBrace() const {
+int OctreeEntitiesFileParser::findMatchingBrace(char openBrace, char closeBrace) const {
     int index = _position;
     int nestCount = 1;
     while (index < _entitiesLength && nestCount != 0) {
-        switch (_entitiesContents[index++]) {
-        case '{':
+        char c = _entitiesContents[index++];
+        if (c == openBrace) {
             ++nestCount;
-            break;
-
-        case '}':
+            continue;
+        } else if (c == closeBrace) {
             --nestCount;
-            break;
+            continue;
+        }
 
+        switch (c) {
         case '"':
             // Skip string
             while (index < _entitiesLength) {
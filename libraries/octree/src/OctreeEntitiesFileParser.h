@@ -14,23 +14,33 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    // return false to stop parsing
+    using EntityCallback = std::function<bool(QJsonObject& entity)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
     bool parseEntities(QVariantMap& parsedEntities);
+    // Reads everything but the entities into header, then hands the entities to entityCallback one at a time as
+    // they are parsed, rather than collecting them. The header is complete before the first entity. Without a
+    // callback the entities are skipped over unparsed.
+    bool parseEntities(QVariantMap& header, const EntityCallback& entityCallback);
     std::string getErrorString() const;
 
 private:
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
-    int findMatchingBrace() const;
+    bool readEntitiesArray(const EntityCallback& entityCallback);
+    int findMatchingBrace(char openBrace = '{', char closeBrace = '}') const;
 
     QByteArray _entitiesContents;
     QUrl _relativeURL;
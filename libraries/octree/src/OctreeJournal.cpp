@@ -0,0 +1,173 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <cstring>
+
+#include <QtCore/QtEndian>
+
+#include "OctreeLogging.h"
+
+const QByteArray OctreeJournal::MAGIC { "VOJL" };
+
+namespace {
+    const int UUID_SIZE = 16;
+    const int HEADER_SIZE = 4 + 4 + 1 + 3 + UUID_SIZE + 4;
+    const int ENTRY_HEADER_SIZE = 4 + 1 + 1 + 2 + UUID_SIZE;
+    const int CHECKSUM_OFFSET = 4 + 1 + 1;
+
+    template <typename T>
+    void appendValue(QByteArray& buffer, T value) {
+        T littleEndian = qToLittleEndian(value);
+        buffer.append(reinterpret_cast<const char*>(&littleEndian), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(const char* data) {
+        return qFromLittleEndian<T>(reinterpret_cast<const uchar*>(data));
+    }
+
+    QByteArray makeHeader(uint8_t version, const QUuid& id, int dataVersion) {
+        QByteArray header;
+        header.append(OctreeJournal::MAGIC);
+        appendValue<uint32_t>(header, OctreeJournal::FORMAT_VERSION);
+        appendValue<uint8_t>(header, version);
+        header.append(3, '\0');
+        header.append(id.toRfc4122());
+        appendValue<int32_t>(header, dataVersion);
+        return header;
+    }
+
+    // over the whole entry with its checksum zeroed
+    quint16 entryChecksum(const char* entry, int size) {
+        QByteArray copy(entry, size);
+        copy[CHECKSUM_OFFSET] = '\0';
+        copy[CHECKSUM_OFFSET + 1] = '\0';
+        return qChecksum(copy.constData(), (uint)copy.size());
+    }
+}
+
+bool OctreeJournal::open(const QString& fileName, uint8_t version, const QUuid& id, int dataVersion, bool keepEntries) {
+    if (_file.isOpen()) {
+        _file.close();
+    }
+    _pending.clear();
+    _file.setFileName(fileName);
+
+    const QByteArray header = makeHeader(version, id, dataVersion);
+    if (keepEntries && _file.open(QIODevice::ReadWrite)) {
+        const QByteArray contents = _file.readAll();
+        if (contents.startsWith(header)) {
+            // new entries go after the last complete one
+            int end = readEntries(contents, nullptr);
+            if (_file.resize(end) && _file.seek(end)) {
+                return true;
+            }
+        }
+        _file.close();
+    }
+
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Failed to open octree journal" << fileName << _file.errorString();
+        return false;
+    }
+    return _file.write(header) == header.size() && _file.flush();
+}
+
+void OctreeJournal::append(EntryType type, const QUuid& id, uint8_t encoding, const QByteArray& data) {
+    int entryStart = _pending.size();
+    appendValue<uint32_t>(_pending, (uint32_t)data.size());
+    appendValue<uint8_t>(_pending, type);
+    appendValue<uint8_t>(_pending, encoding);
+    appendValue<uint16_t>(_pending, 0);
+    _pending.append(id.toRfc4122());
+    _pending.append(data);
+
+    quint16 checksum = qToLittleEndian(entryChecksum(_pending.constData() + entryStart, _pending.size() - entryStart));
+    memcpy(_pending.data() + entryStart + CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+}
+
+void OctreeJournal::appendCheckpoint(int dataVersion) {
+    QByteArray data;
+    appendValue<int32_t>(data, dataVersion);
+    append(Checkpoint, QUuid(), 0, data);
+}
+
+bool OctreeJournal::flush() {
+    if (!_file.isOpen()) {
+        return false;
+    }
+    if (_pending.isEmpty()) {
+        return true;
+    }
+
+    bool success = _file.write(_pending) == _pending.size() && _file.flush();
+    _pending.clear();
+    if (!success) {
+        qCWarning(octree) << "Failed to write octree journal" << _file.fileName() << _file.errorString();
+    }
+    return success;
+}
+
+bool OctreeJournal::read(const QString& fileName, uint8_t version, const QUuid& id, int dataVersion,
+                         std::vector<Entry>& entries, int& checkpointDataVersion) {
+    entries.clear();
+    checkpointDataVersion = dataVersion;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QByteArray contents = file.readAll();
+    if (!contents.startsWith(makeHeader(version, id, dataVersion))) {
+        qCDebug(octree) << "Octree journal" << fileName << "doesn't follow the current snapshot, ignoring it";
+        return false;
+    }
+
+    int end = readEntries(contents, &entries);
+    for (const auto& entry : entries) {
+        if (entry.type == Checkpoint && entry.data.size() == sizeof(int32_t)) {
+            checkpointDataVersion = readValue<int32_t>(entry.data.constData());
+        }
+    }
+    if (end < contents.size()) {
+        qCWarning(octree) << "Octree journal" << fileName << "ends in an incomplete entry, dropped"
+            << contents.size() - end << "bytes";
+    }
+    return true;
+}
+
+int OctreeJournal::readEntries(const QByteArray& contents, std::vector<Entry>* entries) {
+    int position = HEADER_SIZE;
+    while (position + ENTRY_HEADER_SIZE <= contents.size()) {
+        const char* entryData = contents.constData() + position;
+        uint32_t dataSize = readValue<uint32_t>(entryData);
+        if ((uint64_t)position + ENTRY_HEADER_SIZE + dataSize > (uint64_t)contents.size()) {
+            break;
+        }
+        int entrySize = ENTRY_HEADER_SIZE + (int)dataSize;
+        if (readValue<uint16_t>(entryData + CHECKSUM_OFFSET) != entryChecksum(entryData, entrySize)) {
+            break;
+        }
+
+        if (entries) {
+            Entry entry;
+            entry.type = (EntryType)readValue<uint8_t>(entryData + 4);
+            entry.encoding = readValue<uint8_t>(entryData + 5);
+            entry.id = QUuid::fromRfc4122(QByteArray::fromRawData(entryData + CHECKSUM_OFFSET + 2, UUID_SIZE));
+            entry.data = QByteArray(entryData + ENTRY_HEADER_SIZE, (int)dataSize);
+            entries->push_back(entry);
+        }
+        position += entrySize;
+    }
+    return position;
+}
@@ -0,0 +1,76 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+// An append-only log of the changes made to a tree since its last binary snapshot (see OctreeBinaryFile), so that
+// persisting a few changes doesn't rewrite the whole snapshot. Loading applies the journal on top of the snapshot
+// it follows; a journal following any other snapshot is ignored.
+//
+//     header:  magic, format version, data packet version, and the id and data version of the snapshot
+//     entries: size, type, encoding, checksum, id, then the data
+//
+// An entry cut short by a crash, and anything after it, is dropped when the journal is read.
+class OctreeJournal {
+public:
+    enum EntryType : uint8_t {
+        Upsert = 0, // the whole of a new or changed element
+        Delete = 1,
+        Checkpoint = 2 // the tree was persisted as this data version
+    };
+
+    struct Entry {
+        EntryType type { Upsert };
+        QUuid id;
+        uint8_t encoding { 0 }; // what the tree wrote the data as
+        QByteArray data;
+    };
+
+    static const QByteArray MAGIC;
+    static const uint32_t FORMAT_VERSION = 1;
+
+    // starts a journal following the snapshot with this id and data version, or, when keepEntries is set and the
+    // file already follows that snapshot, carries on appending to it
+    bool open(const QString& fileName, uint8_t version, const QUuid& id, int dataVersion, bool keepEntries = false);
+    bool isOpen() const { return _file.isOpen(); }
+
+    void append(EntryType type, const QUuid& id, uint8_t encoding = 0, const QByteArray& data = QByteArray());
+    void appendCheckpoint(int dataVersion);
+
+    // writes the entries appended since the last flush
+    bool flush();
+
+    // the size of the journal including any entries not yet flushed
+    qint64 size() const { return _file.size() + _pending.size(); }
+
+    // reads the entries of a journal following the given snapshot, checkpointDataVersion is left as the data version
+    // of the last checkpoint. Returns false if the file is missing or follows another snapshot.
+    static bool read(const QString& fileName, uint8_t version, const QUuid& id, int dataVersion,
+                     std::vector<Entry>& entries, int& checkpointDataVersion);
+
+private:
+    // returns where the last complete entry ends
+    static int readEntries(const QByteArray& contents, std::vector<Entry>* entries);
+
+    QFile _file;
+    QByteArray _pending;
+};
+
+#endif // hifi_OctreeJournal_h
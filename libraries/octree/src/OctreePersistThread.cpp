@@ -18,6 +18,7 @@
 #include <fstream>
 #include <time.h>
 
+#include <QBuffer>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
@@ -32,13 +33,19 @@
 #include <PerfStat.h>
 #include <PathUtils.h>
 #include <Gzip.h>
+#include <NodeTelemetry.h>
 
+#include "OctreeBinaryFile.h"
 #include "OctreeLogging.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
 
 constexpr std::chrono::seconds OctreePersistThread::DEFAULT_PERSIST_INTERVAL { 30 };
 constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
+constexpr std::chrono::seconds TIME_BETWEEN_JOURNAL_FLUSHES { 1 };
+
+// the snapshot is rewritten once the journal is half its size, but not for less than this
+constexpr qint64 MIN_JOURNAL_SIZE_TO_COMPACT_BYTES { 1000 * 1000 };
 
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
@@ -58,6 +65,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = _filename + ".journal";
 }
 
 void OctreePersistThread::start() {
@@ -72,15 +80,45 @@ void OctreePersistThread::start() {
 
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
+    // the persist file may still be in an older format
+    _currentFilename = findMostRecentFileExtension(_filename, PERSIST_EXTENSIONS);
+
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
-        QByteArray jsonData(file.readAll());
-        file.close();
-        if (!gunzip(jsonData, _cachedJSONData)) {
-            _cachedJSONData = jsonData;
+    qCDebug(octree) << "Reading octree data from" << _currentFilename;
+    QFile file(_currentFilename);
+    if (OctreeBinaryFile::isBinaryFile(_currentFilename)) {
+        // only the header is needed here, the entities are decoded when the tree loads
+        OctreeBinaryFile::Reader reader;
+        if (reader.open(_currentFilename) && reader.getVersion() == _tree->expectedVersion()) {
+            // changes journaled since the snapshot was written make the data as new as their last checkpoint
+            _journalBaseDataVersion = reader.getDataVersion();
+            if (_persistAsFileType == "bin" && OctreeJournal::read(_journalFilename, _tree->expectedVersion(), reader.getID(),
+                                                                   _journalBaseDataVersion, _journalEntries, _journalDataVersion)) {
+                qCDebug(octree) << "Octree journal has" << _journalEntries.size() << "entries since the snapshot";
+            }
+
+            qCDebug(octree) << "Current octree data: ID(" << reader.getID() << ") DataVersion(" << _journalDataVersion << ")";
+            packet->writePrimitive(true);
+            auto id = reader.getID().toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(_journalDataVersion);
+        } else {
+            // can't be decoded by this version, ask the DS for its copy instead
+            qCWarning(octree) << "Octree data in" << _currentFilename << "is from another version";
+            _hasStaleBinaryFile = true;
+            packet->writePrimitive(false);
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
+        // decompressed straight from the file, rather than holding its compressed copy as well
+        QBuffer jsonBuffer(&_cachedJSONData);
+        jsonBuffer.open(QIODevice::WriteOnly);
+        bool wasGzipped = gunzip(file, jsonBuffer);
+        jsonBuffer.close();
+        if (!wasGzipped) {
+            file.seek(0);
+            _cachedJSONData = file.readAll();
         }
+        file.close();
 
         if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
             qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
@@ -94,12 +132,13 @@ void OctreePersistThread::start() {
             packet->writePrimitive(false);
         }
     } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
+        qCWarning(octree) << "Couldn't access file" << _currentFilename << file.errorString();
         packet->writePrimitive(false);
     }
 
     qCDebug(octree) << "Sending OctreeDataFileRequest to DS";
     nodeList->sendPacket(std::move(packet), domainHandler.getSockAddr());
+    _loadRequested = usecTimestampNow();
 }
 
 void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessage> message) {
@@ -108,6 +147,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         return;
     }
 
+    addLoadPhase("domain server reply", usecTimestampNow() - _loadRequested);
+
     bool includesNewData;
     message->readPrimitive(&includesNewData);
     QByteArray replacementData;
@@ -115,24 +156,34 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     bool hasValidOctreeData { false };
     if (includesNewData) {
         _cachedJSONData.clear();
+        _journalEntries.clear();
         replacementData = message->readAll();
         replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        hasValidOctreeData = data.readOctreeDataInfoFromFile(_currentFilename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
-        OctreeUtils::RawEntityData data;
-        qCDebug(octree) << "Reading octree data from" << _filename;
+        if (_hasStaleBinaryFile) {
+            // keep the file we couldn't read rather than persisting over it
+            backupCurrentFile();
+        }
+
+        OctreeUtils::RawOctreeData data;
+        qCDebug(octree) << "Reading octree data from" << _currentFilename;
         if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
             hasValidOctreeData = true;
             if (data.id.isNull()) {
                 qCDebug(octree) << "Current octree data has a null id, updating";
-                data.resetIdAndVersion();
 
-                QFile file(_filename);
+                // only rewriting the file needs the entities
+                OctreeUtils::RawEntityData rawEntityData;
+                rawEntityData.readOctreeDataInfoFromData(_cachedJSONData);
+                rawEntityData.resetIdAndVersion();
+
+                QFile file(_currentFilename);
                 if (file.open(QIODevice::WriteOnly)) {
-                    auto entityData = data.toGzippedByteArray();
+                    auto entityData = rawEntityData.toGzippedByteArray();
                     file.write(entityData);
                     file.close();
                 } else {
@@ -154,13 +205,26 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
+        quint64 readStarted = usecTimestampNow();
+        if (!_journalEntries.empty()) {
+            persistentFileRead = _tree->readFromBinaryFile(_currentFilename, _journalEntries);
+            _tree->setOctreeVersionInfo(_tree->getPersistID(), _journalDataVersion);
+        } else if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
         } else {
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
+        addLoadPhase("read", usecTimestampNow() - readStarted);
+
+        // the stages the tree read in, all part of the read above
+        for (const auto& phase : _tree->takeLoadPhases()) {
+            addLoadPhase("read: " + phase.first, phase.second);
+        }
+
+        quint64 pruneStarted = usecTimestampNow();
         _tree->pruneTree();
+        addLoadPhase("prune", usecTimestampNow() - pruneStarted);
     });
 
     _cachedJSONData.clear();
@@ -187,6 +251,18 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
                 << " setChildAtIndexTime=" << OctreeElement::getSetChildAtIndexTime() << " perSet=" << usecPerSet;
     }
 
+    if (_persistAsFileType == "bin") {
+        // carry on with the journal we loaded, otherwise start one following what was loaded
+        quint64 journalStarted = usecTimestampNow();
+        bool keepEntries = !_journalEntries.empty();
+        int baseDataVersion = keepEntries ? _journalBaseDataVersion : _tree->getPersistDataVersion();
+        _journaling = _journal.open(_journalFilename, _tree->expectedVersion(), _tree->getPersistID(), baseDataVersion, keepEntries)
+            && _tree->appendChangesToJournal(_journal);
+        _journalEntries.clear();
+        _lastJournalFlush = std::chrono::steady_clock::now();
+        addLoadPhase("open journal", usecTimestampNow() - journalStarted);
+    }
+
     _initialLoadComplete = true;
 
     // Since we just loaded the persistent file, we can consider ourselves as having just persisted
@@ -201,11 +277,21 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     emit loadCompleted();
 }
 
+Octree::LoadPhases OctreePersistThread::getLoadPhases() const {
+    std::lock_guard<std::mutex> lock(_loadPhasesMutex);
+    return _loadPhases;
+}
+
+void OctreePersistThread::addLoadPhase(const QString& name, quint64 usecs) {
+    qCDebug(octree) << "Octree load phase" << name << "took" << usecs << "usecs";
+    std::lock_guard<std::mutex> lock(_loadPhasesMutex);
+    _loadPhases.emplace_back(name, usecs);
+}
 
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || _persistAsFileType == "bin") {
         return "application/zip";
     }
     return "";
@@ -214,7 +300,11 @@ QString OctreePersistThread::getPersistFileMimeType() const {
 void OctreePersistThread::replaceData(QByteArray data) {
     backupCurrentFile();
 
-    QFile currentFile { _filename };
+    // the DS always sends gzipped JSON, it is converted to the persist format the next time the tree is saved
+    _currentFilename = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + ".json.gz";
+    backupCurrentFile();
+
+    QFile currentFile { _currentFilename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
         qDebug() << "Wrote replacement data";
@@ -226,10 +316,10 @@ void OctreePersistThread::replaceData(QByteArray data) {
 // Return true if current file is backed up successfully or doesn't exist.
 bool OctreePersistThread::backupCurrentFile() {
     // first take the current models file and move it to a different filename, appended with the timestamp
-    QFile currentFile { _filename };
+    QFile currentFile { _currentFilename };
     if (currentFile.exists()) {
         static const QString FILENAME_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
-        auto backupFileName = _filename + ".backup." + QDateTime::currentDateTime().toString(FILENAME_TIMESTAMP_FORMAT);
+        auto backupFileName = _currentFilename + ".backup." + QDateTime::currentDateTime().toString(FILENAME_TIMESTAMP_FORMAT);
 
         if (currentFile.rename(backupFileName)) {
             qDebug() << "Moved previous models file to" << backupFileName;
@@ -252,6 +342,11 @@ void OctreePersistThread::process() {
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
         persist();
+    } else if (_journaling && now - _lastJournalFlush > TIME_BETWEEN_JOURNAL_FLUSHES) {
+        // keeps what a crash can lose to about a second, without waiting for the next persist
+        _lastJournalFlush = now;
+        _tree->appendChangesToJournal(_journal);
+        _journal.flush();
     }
 
     QTimer::singleShot(TIME_BETWEEN_PROCESSING.count(), this, &OctreePersistThread::process);
@@ -265,6 +360,12 @@ void OctreePersistThread::aboutToFinish() {
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (_persistAsFileType == "bin") {
+        // the binary format is only for persisting, downloads stay gzipped JSON like the DS copy
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
+
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -313,12 +414,40 @@ void OctreePersistThread::persist() {
 
         _tree->incrementPersistDataVersion();
 
-        qCDebug(octree) << "Saving Octree data to:" << _filename;
-        if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
-            _tree->clearDirtyBit(); // tree is clean after saving
-            qCDebug(octree) << "DONE persisting Octree data to" << _filename;
-        } else {
-            qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+        // the changes go in the journal until it has grown enough compared to the snapshot to be worth compacting
+        bool saveSnapshot = !_journaling || _currentFilename != _filename
+            || _journal.size() > std::max(MIN_JOURNAL_SIZE_TO_COMPACT_BYTES, QFileInfo(_filename).size() / 2);
+        auto start = usecTimestampNow();
+        if (!saveSnapshot) {
+            _lastJournalFlush = std::chrono::steady_clock::now();
+            _tree->appendChangesToJournal(_journal);
+            _journal.appendCheckpoint(_tree->getPersistDataVersion());
+            if (_journal.flush()) {
+                _tree->clearDirtyBit(); // tree is clean once its changes are journaled
+                NodeTelemetry::recordValue("persist_journal_usecs", usecTimestampNow() - start);
+                qCDebug(octree) << "DONE journaling Octree changes to" << _journalFilename;
+            } else {
+                saveSnapshot = true;
+            }
+        }
+
+        if (saveSnapshot) {
+            qCDebug(octree) << "Saving Octree data to:" << _filename;
+            start = usecTimestampNow();
+            if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
+                _tree->clearDirtyBit(); // tree is clean after saving
+                _currentFilename = _filename;
+                NodeTelemetry::recordValue("persist_snapshot_usecs", usecTimestampNow() - start);
+                qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+
+                // changes made while saving are still tracked by the tree, they go in the new journal
+                if (_journaling) {
+                    _journaling = _journal.open(_journalFilename, _tree->expectedVersion(), _tree->getPersistID(),
+                                                _tree->getPersistDataVersion());
+                }
+            } else {
+                qCWarning(octree) << "Failed to persist Octree data to" << _filename;
+            }
         }
 
         sendLatestEntityDataToDS();
@@ -14,6 +14,8 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <mutex>
+
 #include <QString>
 #include <QtCore/QSharedPointer>
 #include <GenericThread.h>
@@ -41,6 +43,8 @@ public:
 
     bool isInitialLoadComplete() const { return _initialLoadComplete; }
     quint64 getLoadElapsedTime() const { return _loadTimeUSecs; }
+    // the stages of startup finished so far and how long each took, in usecs
+    Octree::LoadPhases getLoadPhases() const;
 
     QString getPersistFilename() const { return _filename; }
     QString getPersistFileMimeType() const;
@@ -66,20 +70,36 @@ protected:
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
+    void addLoadPhase(const QString& name, quint64 usecs);
+
 private:
     OctreePointer _tree;
     QString _filename;
+    QString _currentFilename; // the newest persist file, which may not yet be in the format being persisted as
     std::chrono::milliseconds _persistInterval;
     std::chrono::steady_clock::time_point _lastPersistCheck;
     bool _initialLoadComplete;
 
     quint64 _loadTimeUSecs;
+    quint64 _loadRequested { 0 };
+    mutable std::mutex _loadPhasesMutex;
+    Octree::LoadPhases _loadPhases;
 
     bool _debugTimestampNow;
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+    bool _hasStaleBinaryFile { false };
+
+    // changes between snapshots, only when persisting as the binary format
+    QString _journalFilename;
+    OctreeJournal _journal;
+    bool _journaling { false };
+    std::chrono::steady_clock::time_point _lastJournalFlush;
+    std::vector<OctreeJournal::Entry> _journalEntries; // read at start, until the tree has loaded
+    int _journalBaseDataVersion { 0 };
+    int _journalDataVersion { 0 };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -11,6 +11,7 @@
 #include "OctreeProcessor.h"
 
 #include <stdint.h>
+#include <vector>
 
 #include <glm/glm.hpp>
 
@@ -96,10 +97,10 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
 
         const QUuid& sourceUUID = sourceNode->getUUID();
 
-        int subsection = 1;
-
+        // decode the sections of the packet before taking the tree lock, so that the lock is only held to apply them
+        std::vector<QByteArray> sections;
+        quint64 startUncompress = usecTimestampNow();
         bool error = false;
-
         while (message.getBytesLeftToRead() > 0 && !error) {
             if (packetIsCompressed) {
                 if (message.getBytesLeftToRead() > (qint64) sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE)) {
@@ -113,59 +114,67 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
             }
 
             if (sectionLength) {
-                // ask the VoxelTree to read the bitstream into the tree
-                ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL,
-                                               sourceUUID, sourceNode);
-                quint64 startUncompress, startLock = usecTimestampNow();
-                quint64 startReadBitsteam, endReadBitsteam;
-                // FIXME STUTTER - there may be an opportunity to bump this lock outside of the
-                // loop to reduce the amount of locking/unlocking we're doing
-                _tree->withWriteLock([&] {
-                    startUncompress = usecTimestampNow();
-
-                    OctreePacketData packetData(packetIsCompressed);
-                    packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
-                        sectionLength);
-                    if (extraDebugging) {
-                        qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
-                            "Got Packet Section color:" << packetIsColored <<
-                            "compressed:" << packetIsCompressed <<
-                            "sequence: " << sequence <<
-                            "flight: " << flightTime << " usec" <<
-                            "size:" << message.getSize() <<
-                            "data:" << message.getBytesLeftToRead() <<
-                            "subsection:" << subsection <<
-                            "sectionLength:" << sectionLength <<
-                            "uncompressed:" << packetData.getUncompressedSize();
+                const char* sectionData = message.getRawMessage() + message.getPosition();
+                if (packetIsCompressed) {
+                    sections.push_back(qUncompress(reinterpret_cast<const uchar*>(sectionData), sectionLength));
+                } else {
+                    sections.push_back(QByteArray(sectionData, sectionLength));
+                }
+
+                if (extraDebugging) {
+                    qCDebug(octree) << "OctreeProcessor::processDatagram() ... "
+                        "Got Packet Section color:" << packetIsColored <<
+                        "compressed:" << packetIsCompressed <<
+                        "sequence: " << sequence <<
+                        "flight: " << flightTime << " usec" <<
+                        "size:" << message.getSize() <<
+                        "data:" << message.getBytesLeftToRead() <<
+                        "subsection:" << sections.size() <<
+                        "sectionLength:" << sectionLength <<
+                        "uncompressed:" << sections.back().size();
+                }
+
+                // seek forwards in packet
+                message.seek(message.getPosition() + sectionLength);
+            }
+        }
+        quint64 startLock = usecTimestampNow();
+        totalUncompress = startLock - startUncompress;
+
+        // then apply them all under a single write lock
+        if (!sections.empty()) {
+            quint64 startReadBitsteam, endReadBitsteam;
+            _tree->withWriteLock([&] {
+                startReadBitsteam = usecTimestampNow();
+                for (const auto& section : sections) {
+                    if (section.isEmpty()) {
+                        continue;
                     }
 
+                    // ask the VoxelTree to read the bitstream into the tree
+                    ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL, sourceUUID, sourceNode);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* START _tree->readBitstreamToTree()...";
                     }
-                    startReadBitsteam = usecTimestampNow();
-                    _tree->readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
-                    endReadBitsteam = usecTimestampNow();
+                    _tree->readBitstreamToTree(reinterpret_cast<const unsigned char*>(section.constData()),
+                                               section.size(), args);
                     if (extraDebugging) {
                         qCDebug(octree) << "OctreeProcessor::processDatagram() ******* END _tree->readBitstreamToTree()...";
                     }
-                });
-
-                // seek forwards in packet
-                message.seek(message.getPosition() + sectionLength);
 
-                elementsPerPacket += args.elementsPerPacket;
-                entitiesPerPacket += args.entitiesPerPacket;
+                    elementsPerPacket += args.elementsPerPacket;
+                    entitiesPerPacket += args.entitiesPerPacket;
 
-                _elementsInLastWindow += args.elementsPerPacket;
-                _entitiesInLastWindow += args.entitiesPerPacket;
-
-                totalWaitingForLock += (startUncompress - startLock);
-                totalUncompress += (startReadBitsteam - startUncompress);
-                totalReadBitsteam += (endReadBitsteam - startReadBitsteam);
+                    _elementsInLastWindow += args.elementsPerPacket;
+                    _entitiesInLastWindow += args.entitiesPerPacket;
+                }
+                endReadBitsteam = usecTimestampNow();
+            });
 
-            }
-            subsection++;
+            totalWaitingForLock = startReadBitsteam - startLock;
+            totalReadBitsteam = endReadBitsteam - startReadBitsteam;
         }
+
         _elementsPerPacket.updateAverage(elementsPerPacket);
         _entitiesPerPacket.updateAverage(entitiesPerPacket);
 
@@ -55,6 +55,7 @@ public:
 
     float getAverageWaitLockPerPacket() const { return _waitLockPerPacket.getAverage(); }
     float getAverageUncompressPerPacket() const { return _uncompressPerPacket.getAverage(); }
+    // usecs the tree is write-locked for each packet, the sections of which are uncompressed before the lock is taken
     float getAverageReadBitstreamPerPacket() const { return _readBitstreamPerPacket.getAverage(); }
 
     OCTREE_PACKET_SEQUENCE getLastOctreeMessageSequence() const { return _lastOctreeMessageSequence; }
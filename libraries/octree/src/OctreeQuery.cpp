@@ -45,8 +45,14 @@ int OctreeQuery::getBroadcastData(unsigned char* destinationBuffer) {
         memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
         destinationBuffer += sizeof(numFrustums);
 
-        for (const auto& view : _conicalViews) {
-            destinationBuffer += view.serialize(destinationBuffer);
+        for (size_t i = 0; i < _conicalViews.size(); ++i) {
+            destinationBuffer += _conicalViews[i].serialize(destinationBuffer);
+
+            const auto& budget = _viewBudgets[i];
+            memcpy(destinationBuffer, &budget.priorityWeight, sizeof(budget.priorityWeight));
+            destinationBuffer += sizeof(budget.priorityWeight);
+            memcpy(destinationBuffer, &budget.maxBytesPerSecond, sizeof(budget.maxBytesPerSecond));
+            destinationBuffer += sizeof(budget.maxBytesPerSecond);
         }
     }
     
@@ -123,10 +129,20 @@ int OctreeQuery::parseData(ReceivedMessage& message) {
     {
         QMutexLocker lock(&_conicalViewsLock);
         _conicalViews.clear();
+        _viewBudgets.clear();
         for (int i = 0; i < numFrustums; ++i) {
             ConicalViewFrustum view;
             sourceBuffer += view.deserialize(sourceBuffer);
             _conicalViews.push_back(view);
+
+            OctreeQueryViewBudget budget;
+            memcpy(&budget.priorityWeight, sourceBuffer, sizeof(budget.priorityWeight));
+            sourceBuffer += sizeof(budget.priorityWeight);
+            memcpy(&budget.maxBytesPerSecond, sourceBuffer, sizeof(budget.maxBytesPerSecond));
+            sourceBuffer += sizeof(budget.maxBytesPerSecond);
+            // the weights scale the priorities, which must stay positive
+            budget.priorityWeight = glm::clamp(budget.priorityWeight, MIN_VIEW_PRIORITY_WEIGHT, MAX_VIEW_PRIORITY_WEIGHT);
+            _viewBudgets.push_back(budget);
         }
     }
 
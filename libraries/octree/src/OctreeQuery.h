@@ -15,11 +15,30 @@
 #include <QtCore/QJsonObject>
 #include <QtCore/QReadWriteLock>
 
+#include <vector>
+
 #include <NodeData.h>
 #include <shared/ConicalViewFrustum.h>
 
 #include "OctreeConstants.h"
 
+// How a view of the query shares what the server sends: entities are sent in order of their angular size in a view times
+// the view's weight, and a view with a budget of its own is sent no more than that many bytes a second, so that a
+// secondary camera doesn't hold up the main view
+struct OctreeQueryViewBudget {
+    float priorityWeight { 1.0f };
+    uint32_t maxBytesPerSecond { 0 }; // 0 to share the query's packets with no limit of its own
+
+    bool operator==(const OctreeQueryViewBudget& other) const {
+        return priorityWeight == other.priorityWeight && maxBytesPerSecond == other.maxBytesPerSecond;
+    }
+    bool operator!=(const OctreeQueryViewBudget& other) const { return !(*this == other); }
+};
+using OctreeQueryViewBudgets = std::vector<OctreeQueryViewBudget>;
+
+const float MIN_VIEW_PRIORITY_WEIGHT = 0.01f;
+const float MAX_VIEW_PRIORITY_WEIGHT = 100.0f;
+
 class OctreeQuery : public NodeData {
     Q_OBJECT
 
@@ -34,9 +53,14 @@ public:
     int parseData(ReceivedMessage& message) override;
 
     bool hasConicalViews() const { QMutexLocker lock(&_conicalViewsLock); return !_conicalViews.empty(); }
-    void setConicalViews(ConicalViewFrustums views)
-        { QMutexLocker lock(&_conicalViewsLock); _conicalViews = views; }
-    void clearConicalViews() { QMutexLocker lock(&_conicalViewsLock); _conicalViews.clear(); }
+    // the views without a budget get the default one
+    void setConicalViews(ConicalViewFrustums views, OctreeQueryViewBudgets budgets = OctreeQueryViewBudgets()) {
+        QMutexLocker lock(&_conicalViewsLock);
+        _conicalViews = views;
+        _viewBudgets = budgets;
+        _viewBudgets.resize(_conicalViews.size());
+    }
+    void clearConicalViews() { QMutexLocker lock(&_conicalViewsLock); _conicalViews.clear(); _viewBudgets.clear(); }
 
     // getters/setters for JSON filter
     QJsonObject getJSONParameters() { QReadLocker locker { &_jsonParametersLock }; return _jsonParameters; }
@@ -67,6 +91,7 @@ public slots:
 protected:
     mutable QMutex _conicalViewsLock;
     ConicalViewFrustums _conicalViews;
+    OctreeQueryViewBudgets _viewBudgets; // one for each view
 
     // octree server sending items
     int _maxQueryPPS = DEFAULT_MAX_OCTREE_PPS;
@@ -167,6 +167,16 @@ bool OctreeQueryNode::updateCurrentViewFrustum() {
             _currentConicalViews = _conicalViews;
             currentViewFrustumChanged = true;
         }
+
+        if (currentViewFrustumChanged && !_currentConicalViews.empty()) {
+            updateViewVelocity(_currentConicalViews[0].getPosition());
+        }
+
+        // a view that changed weight or budget changes the order its entities are sent in
+        if (_viewBudgets != _currentViewBudgets) {
+            _currentViewBudgets = _viewBudgets;
+            currentViewFrustumChanged = true;
+        }
     }
 
     // Also check for LOD changes from the client
@@ -196,6 +206,38 @@ bool OctreeQueryNode::updateCurrentViewFrustum() {
     return currentViewFrustumChanged;
 }
 
+void OctreeQueryNode::updateViewVelocity(const glm::vec3& position) {
+    // a jump faster than this is a teleport, which says nothing of where the view goes next
+    const float MAX_VIEW_SPEED = 50.0f; // meters per second
+    const float VELOCITY_BLEND = 0.5f;
+
+    quint64 now = usecTimestampNow();
+    if (_lastViewMoveTime > 0 && now > _lastViewMoveTime) {
+        float dt = (float)(now - _lastViewMoveTime) / (float)USECS_PER_SECOND;
+        glm::vec3 velocity = (position - _lastViewPosition) / dt;
+        if (glm::length(velocity) > MAX_VIEW_SPEED) {
+            _viewVelocity = glm::vec3(0.0f);
+        } else {
+            _viewVelocity = glm::mix(_viewVelocity, velocity, VELOCITY_BLEND);
+        }
+    }
+    _lastViewPosition = position;
+    _lastViewMoveTime = now;
+}
+
+bool OctreeQueryNode::getPredictedViewOffset(float seconds, glm::vec3& offset) const {
+    // the client queries again when its view moves a few meters, so a view that hasn't moved in a while has stopped
+    const quint64 MAX_VIEW_MOVE_AGE = 2 * USECS_PER_SECOND;
+    // closer than this, the current view already covers the predicted one
+    const float MIN_PREDICTED_OFFSET = 5.0f; // meters
+
+    if (_lastViewMoveTime == 0 || usecTimestampNow() - _lastViewMoveTime > MAX_VIEW_MOVE_AGE) {
+        return false;
+    }
+    offset = _viewVelocity * seconds;
+    return glm::length(offset) > MIN_PREDICTED_OFFSET;
+}
+
 void OctreeQueryNode::setViewSent(bool viewSent) {
     _viewSent = viewSent;
     if (viewSent) {
@@ -50,11 +50,16 @@ public:
     OctreeElementExtraEncodeData extraEncodeData;
 
     const ConicalViewFrustums& getCurrentViews() const { return _currentConicalViews; }
+    const OctreeQueryViewBudgets& getCurrentViewBudgets() const { return _currentViewBudgets; }
 
     // These are not classic setters because they are calculating and maintaining state
     // which is set asynchronously through the network receive
     bool updateCurrentViewFrustum();
 
+    // where the main view is expected to have moved in the given time, from how it moved between the last queries;
+    // false if it isn't moving, or hasn't been seen to for a while
+    bool getPredictedViewOffset(float seconds, glm::vec3& offset) const;
+
     bool getViewSent() const { return _viewSent; }
     void setViewSent(bool viewSent);
 
@@ -87,6 +92,8 @@ public:
     void setShouldForceFullScene(bool shouldForceFullScene) { _shouldForceFullScene = shouldForceFullScene; }
 
 private:
+    void updateViewVelocity(const glm::vec3& position);
+
     bool _viewSent { false };
     std::unique_ptr<NLPacket> _octreePacket;
     bool _octreePacketWaiting;
@@ -96,6 +103,12 @@ private:
     quint64 _firstSuppressedPacket { usecTimestampNow() };
 
     ConicalViewFrustums _currentConicalViews;
+    OctreeQueryViewBudgets _currentViewBudgets;
+
+    // the motion of the main view between the queries that moved it
+    glm::vec3 _lastViewPosition;
+    quint64 _lastViewMoveTime { 0 };
+    glm::vec3 _viewVelocity;
     bool _viewFrustumChanging { false };
     bool _viewFrustumJustStoppedChanging { true };
 
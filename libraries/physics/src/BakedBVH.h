@@ -0,0 +1,84 @@
+//
+//  BakedBVH.h
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakedBVH_h
+#define hifi_BakedBVH_h
+
+#include <cstring>
+
+#include <QByteArray>
+
+#include <btBulletDynamicsCommon.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+
+// The quantized bounding volume hierarchy of a static mesh, baked along with its model so the clients needn't build
+// it.  Bullet serializes a btOptimizedBvh "in place", as it is in memory, so it can only be deserialized by the same
+// Bullet build on the same kind of platform: the Header describing those comes first.
+namespace BakedBVH {
+
+    const uint32_t VERSION = 1;
+    // Bullet wants the serialized data aligned for SIMD
+    const size_t ALIGNMENT = 16;
+
+    struct Header {
+        uint32_t version { VERSION };
+        uint32_t bulletVersion { BT_BULLET_VERSION };
+        uint32_t pointerSize { sizeof(void*) };
+        uint32_t scalarSize { sizeof(btScalar) };
+        uint32_t bvhSize { sizeof(btOptimizedBvh) };
+        uint32_t dataSize { 0 };
+
+        bool isCompatible() const {
+            Header native;
+            return version == native.version && bulletVersion == native.bulletVersion &&
+                pointerSize == native.pointerSize && scalarSize == native.scalarSize && bvhSize == native.bvhSize;
+        }
+    };
+
+    inline QByteArray serialize(const btOptimizedBvh& bvh) {
+        Header header;
+        header.dataSize = bvh.calculateSerializeBufferSize();
+        void* data = btAlignedAlloc(header.dataSize, ALIGNMENT);
+        QByteArray serialized;
+        if (bvh.serializeInPlace(data, header.dataSize, false)) {
+            serialized.resize((int)(sizeof(Header) + header.dataSize));
+            memcpy(serialized.data(), &header, sizeof(Header));
+            memcpy(serialized.data() + sizeof(Header), data, header.dataSize);
+        }
+        btAlignedFree(data);
+        return serialized;
+    }
+
+    // Copies the bvh out of serialized into an aligned buffer, which the caller frees with btAlignedFree() once done with
+    // the bvh, and returns it, or nullptr if serialized is from another platform or truncated.
+    inline btOptimizedBvh* deserialize(const QByteArray& serialized, void*& buffer) {
+        buffer = nullptr;
+        Header header;
+        if ((size_t)serialized.size() < sizeof(Header)) {
+            return nullptr;
+        }
+        memcpy(&header, serialized.constData(), sizeof(Header));
+        if (!header.isCompatible() || (size_t)serialized.size() != sizeof(Header) + header.dataSize) {
+            return nullptr;
+        }
+        buffer = btAlignedAlloc(header.dataSize, ALIGNMENT);
+        memcpy(buffer, serialized.constData() + sizeof(Header), header.dataSize);
+        btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.dataSize, false);
+        if (!bvh) {
+            btAlignedFree(buffer);
+            buffer = nullptr;
+        }
+        return bvh;
+    }
+
+};
+
+#endif // hifi_BakedBVH_h
@@ -0,0 +1,62 @@
+//
+//  BulletTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BulletTaskScheduler.h"
+
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+
+#include <algorithm>
+#include <thread>
+
+#include <TBBHelpers.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
+#include <LinearMath/btQuickprof.h>
+
+BulletTaskScheduler::BulletTaskScheduler() : btITaskScheduler("TBB") {
+    setNumThreads(getMaxNumThreads());
+}
+
+BulletTaskScheduler::~BulletTaskScheduler() {
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const {
+    return std::max(1, std::min((int)std::thread::hardware_concurrency(), (int)BT_MAX_THREAD_COUNT));
+}
+
+void BulletTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::max(1, std::min(numThreads, getMaxNumThreads()));
+    _arena = std::make_unique<tbb::task_arena>(_numThreads);
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor_TBB");
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+            body.forLoop(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+    });
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum_TBB");
+    btScalar sum = btScalar(0);
+    _arena->execute([&] {
+        sum = tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), btScalar(0),
+            [&](const tbb::blocked_range<int>& range, btScalar partialSum) {
+                return partialSum + body.sumLoop(range.begin(), range.end());
+            }, std::plus<btScalar>(), tbb::simple_partitioner());
+    });
+    return sum;
+}
+
+#endif // HIFI_MULTITHREADED_PHYSICS
@@ -0,0 +1,46 @@
+//
+//  BulletTaskScheduler.h
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BulletTaskScheduler_h
+#define hifi_BulletTaskScheduler_h
+
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+
+#include <memory>
+
+#include <LinearMath/btThreads.h>
+
+namespace tbb {
+    class task_arena;
+}
+
+// Runs the parallel loops of Bullet's multithreaded world on the TBB worker threads, in an arena capped
+// to the number of threads Bullet can index.
+class BulletTaskScheduler : public btITaskScheduler {
+public:
+    BulletTaskScheduler();
+    ~BulletTaskScheduler();
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    std::unique_ptr<tbb::task_arena> _arena;
+    int _numThreads { 1 };
+};
+
+#endif // HIFI_MULTITHREADED_PHYSICS
+
+#endif // hifi_BulletTaskScheduler_h
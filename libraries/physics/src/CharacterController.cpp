@@ -11,6 +11,8 @@
 
 #include "CharacterController.h"
 
+#include <mutex>
+
 #include <AvatarConstants.h>
 #include <NumericalConstants.h>
 #include <PhysicsCollisionGroups.h>
@@ -23,6 +25,13 @@
 const float STUCK_PENETRATION = -0.05f; // always negative into the object.
 const float STUCK_IMPULSE = 500.0f;
 
+// the cached support is checked again after this many substeps even if nothing changed
+const uint32_t MAX_CACHED_SUPPORT_SUBSTEPS = 30;
+// the character and its floor count as unmoved within these tolerances
+const btScalar SUPPORT_CACHE_MAX_DISPLACEMENT = 0.001f; // meters
+const btScalar SUPPORT_CACHE_MIN_ROTATION_DOT = 0.99999f;
+const btScalar SUPPORT_CACHE_MAX_SPEED = 0.01f; // meters per second
+
 
 const btVector3 LOCAL_UP_AXIS(0.0f, 1.0f, 0.0f);
 static bool _appliedStuckRecoveryStrategy = false;
@@ -36,8 +45,11 @@ static TemporaryPairwiseCollisionFilter _pairwiseFilter;
 bool applyPairwiseFilter(btManifoldPoint& cp,
         const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0,
         const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) {
-    static int32_t numCalls = 0;
-    ++numCalls;
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+    // the narrowphase, hence this callback, runs on the task scheduler threads
+    static std::mutex filterMutex;
+    std::lock_guard<std::mutex> lock(filterMutex);
+#endif
     // This callback is ONLY called on objects with btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK flag
     // and the flagged object will always be sorted to Obj0.  Hence the "other" is always Obj1.
     const btCollisionObject* other = colObj1Wrap->m_collisionObject;
@@ -123,6 +135,8 @@ CharacterController::CharacterController(const FollowTimePerType& followTimeRema
     _followLinearDisplacement = btVector3(0, 0, 0);
     _followAngularDisplacement = btQuaternion::getIdentity();
     _hasSupport = false;
+    _floorObjectTransform.setIdentity();
+    _supportCacheBodyTransform.setIdentity();
 
     _pendingFlags = PENDING_FLAG_UPDATE_SHAPE;
 
@@ -152,6 +166,8 @@ bool CharacterController::needsAddition() const {
 }
 
 void CharacterController::removeFromWorld() {
+    invalidateSupportCache();
+    _floorObject = nullptr;
     if (_inWorld) {
         if (_rigidBody) {
             _physicsEngine->getDynamicsWorld()->removeRigidBody(_rigidBody);
@@ -214,8 +230,6 @@ void CharacterController::addToWorld() {
 bool CharacterController::checkForSupport(btCollisionWorld* collisionWorld) {
     bool pushing = _targetVelocity.length2() > FLT_EPSILON;
 
-    btDispatcher* dispatcher = collisionWorld->getDispatcher();
-    int numManifolds = dispatcher->getNumManifolds();
     bool hasFloor = false;
     bool probablyStuck = _isStuck && _appliedStuckRecoveryStrategy;
 
@@ -226,55 +240,53 @@ bool CharacterController::checkForSupport(btCollisionWorld* collisionWorld) {
     float strongestImpulse = 0.0f;
 
     _netCollisionImpulse = btVector3(0.0f, 0.0f, 0.0f);
-    for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
-        if (_rigidBody == contactManifold->getBody1() || _rigidBody == contactManifold->getBody0()) {
-            bool characterIsFirst = _rigidBody == contactManifold->getBody0();
-            int numContacts = contactManifold->getNumContacts();
-            int stepContactIndex = -1;
-            bool stepValid = true;
-            float highestStep = _minStepHeight;
-            for (int j = 0; j < numContacts; j++) {
-                // check for "floor"
-                btManifoldPoint& contact = contactManifold->getContactPoint(j);
-                btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
-                btVector3 normal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
-                btScalar hitHeight = _halfHeight + _radius + pointOnCharacter.dot(_currentUp);
-
-                float distance = contact.getDistance();
-                if (distance < deepestDistance) {
-                    deepestDistance = distance;
-                }
-                float impulse = contact.getAppliedImpulse();
-                _netCollisionImpulse += impulse * normal;
-                if (impulse > strongestImpulse) {
-                    strongestImpulse = impulse;
-                }
+    // the manifolds of the character were gathered by preStep
+    for (auto contactManifold : _contactManifolds) {
+        bool characterIsFirst = _rigidBody == contactManifold->getBody0();
+        int numContacts = contactManifold->getNumContacts();
+        int stepContactIndex = -1;
+        bool stepValid = true;
+        float highestStep = _minStepHeight;
+        for (int j = 0; j < numContacts; j++) {
+            // check for "floor"
+            btManifoldPoint& contact = contactManifold->getContactPoint(j);
+            btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
+            btVector3 normal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
+            btScalar hitHeight = _halfHeight + _radius + pointOnCharacter.dot(_currentUp);
+
+            float distance = contact.getDistance();
+            if (distance < deepestDistance) {
+                deepestDistance = distance;
+            }
+            float impulse = contact.getAppliedImpulse();
+            _netCollisionImpulse += impulse * normal;
+            if (impulse > strongestImpulse) {
+                strongestImpulse = impulse;
+            }
 
-                if (hitHeight < _maxStepHeight && normal.dot(_currentUp) > _minFloorNormalDotUp) {
+            if (hitHeight < _maxStepHeight && normal.dot(_currentUp) > _minFloorNormalDotUp) {
+                hasFloor = true;
+            }
+            if (stepValid && pushing && _targetVelocity.dot(normal) < 0.0f) {
+                // remember highest step obstacle
+                if (!_stepUpEnabled || hitHeight > _maxStepHeight) {
+                    // this manifold is invalidated by point that is too high
+                    stepValid = false;
+                } else if (hitHeight > highestStep && normal.dot(_targetVelocity) < 0.0f ) {
+                    highestStep = hitHeight;
+                    stepContactIndex = j;
                     hasFloor = true;
                 }
-                if (stepValid && pushing && _targetVelocity.dot(normal) < 0.0f) {
-                    // remember highest step obstacle
-                    if (!_stepUpEnabled || hitHeight > _maxStepHeight) {
-                        // this manifold is invalidated by point that is too high
-                        stepValid = false;
-                    } else if (hitHeight > highestStep && normal.dot(_targetVelocity) < 0.0f ) {
-                        highestStep = hitHeight;
-                        stepContactIndex = j;
-                        hasFloor = true;
-                    }
-                }
-            }
-            if (stepValid && stepContactIndex > -1 && highestStep > _stepHeight) {
-                // remember step info for later
-                btManifoldPoint& contact = contactManifold->getContactPoint(stepContactIndex);
-                btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
-                _stepNormal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
-                _stepHeight = highestStep;
-                _stepPoint = rotation * pointOnCharacter; // rotate into world-frame
             }
         }
+        if (stepValid && stepContactIndex > -1 && highestStep > _stepHeight) {
+            // remember step info for later
+            btManifoldPoint& contact = contactManifold->getContactPoint(stepContactIndex);
+            btVector3 pointOnCharacter = characterIsFirst ? contact.m_localPointA : contact.m_localPointB; // object-local-frame
+            _stepNormal = characterIsFirst ? contact.m_normalWorldOnB : -contact.m_normalWorldOnB; // points toward character
+            _stepHeight = highestStep;
+            _stepPoint = rotation * pointOnCharacter; // rotate into world-frame
+        }
     }
 
     // If there's deep penetration and big impulse we're probably stuck.
@@ -315,12 +327,88 @@ bool CharacterController::checkForSupport(btCollisionWorld* collisionWorld) {
     return hasFloor;
 }
 
+static bool isSameTransform(const btTransform& a, const btTransform& b) {
+    return (a.getOrigin() - b.getOrigin()).length2() < SUPPORT_CACHE_MAX_DISPLACEMENT * SUPPORT_CACHE_MAX_DISPLACEMENT &&
+        fabsf(a.getRotation().dot(b.getRotation())) > SUPPORT_CACHE_MIN_ROTATION_DOT;
+}
+
+void CharacterController::setSupportCachingEnabled(bool enabled) {
+    _supportCachingEnabled = enabled;
+    invalidateSupportCache();
+}
+
+void CharacterController::gatherContactManifolds(btCollisionWorld* collisionWorld) {
+    _contactManifolds.clear();
+    _contactSignature = 0;
+    btDispatcher* dispatcher = collisionWorld->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++) {
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+        if (_rigidBody == contactManifold->getBody1() || _rigidBody == contactManifold->getBody0()) {
+            _contactManifolds.push_back(contactManifold);
+            // a sum so the order of the manifolds doesn't matter
+            const btCollisionObject* other = _rigidBody == contactManifold->getBody0() ? contactManifold->getBody1() : contactManifold->getBody0();
+            _contactSignature += (uint64_t)(uintptr_t)other * (uint64_t)(contactManifold->getNumContacts() + 1);
+        }
+    }
+}
+
+bool CharacterController::isInContactWith(const btCollisionObject* object) const {
+    for (auto contactManifold : _contactManifolds) {
+        if (contactManifold->getBody0() == object || contactManifold->getBody1() == object) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CharacterController::canUseCachedSupport() const {
+    if (!_supportCachingEnabled || !_supportCacheValid || _numCachedSupportSubsteps >= MAX_CACHED_SUPPORT_SUBSTEPS ||
+            _contactSignature != _supportCacheSignature || _targetVelocity.length2() > FLT_EPSILON) {
+        return false;
+    }
+    btVector3 velocity = _rigidBody->getLinearVelocity() - _parentVelocity;
+    if (velocity.length2() > SUPPORT_CACHE_MAX_SPEED * SUPPORT_CACHE_MAX_SPEED ||
+            !isSameTransform(_rigidBody->getWorldTransform(), _supportCacheBodyTransform)) {
+        return false;
+    }
+    // the floor object is alive while it has a manifold with the character, which the signature guarantees
+    return !_floorObject || (isInContactWith(_floorObject) && isSameTransform(_floorObject->getWorldTransform(), _floorObjectTransform));
+}
+
+void CharacterController::updateSupportCache() {
+    btVector3 velocity = _rigidBody->getLinearVelocity() - _parentVelocity;
+    _supportCacheValid = _supportCachingEnabled && _hasSupport && !_isStuck && _targetVelocity.length2() <= FLT_EPSILON &&
+        velocity.length2() <= SUPPORT_CACHE_MAX_SPEED * SUPPORT_CACHE_MAX_SPEED;
+    if (_supportCacheValid) {
+        _supportCacheBodyTransform = _rigidBody->getWorldTransform();
+        _supportCacheSignature = _contactSignature;
+        if (_floorObject) {
+            _floorObjectTransform = _floorObject->getWorldTransform();
+        }
+    }
+    _numCachedSupportSubsteps = 0;
+}
+
+void CharacterController::invalidateSupportCache() {
+    _supportCacheValid = false;
+    _useCachedSupport = false;
+}
+
 void CharacterController::updateAction(btCollisionWorld* collisionWorld, btScalar deltaTime) {
     preStep(collisionWorld);
     playerStep(collisionWorld, deltaTime);
 }
 
 void CharacterController::preStep(btCollisionWorld* collisionWorld) {
+    gatherContactManifolds(collisionWorld);
+    _useCachedSupport = canUseCachedSupport();
+    if (_useCachedSupport) {
+        // at rest on the same floor with the same contacts: the floor distance hasn't changed
+        ++_numCachedSupportSubsteps;
+        return;
+    }
+
     // trace a ray straight down to see if we're standing on the ground
     const btTransform& transform = _rigidBody->getWorldTransform();
 
@@ -332,12 +420,28 @@ void CharacterController::preStep(btCollisionWorld* collisionWorld) {
     btScalar rayLength = _radius + FLOOR_PROXIMITY_THRESHOLD;
     btVector3 rayEnd = rayStart - rayLength * _currentUp;
 
+    if (_supportCachingEnabled && _floorObject && isInContactWith(_floorObject)) {
+        // still touching the known floor: testing the ray against it alone is much cheaper than through the world
+        btCollisionWorld::ClosestRayResultCallback floorCallback(rayStart, rayEnd);
+        btTransform rayFrom(btQuaternion::getIdentity(), rayStart);
+        btTransform rayTo(btQuaternion::getIdentity(), rayEnd);
+        btCollisionWorld::rayTestSingle(rayFrom, rayTo, const_cast<btCollisionObject*>(_floorObject),
+            _floorObject->getCollisionShape(), _floorObject->getWorldTransform(), floorCallback);
+        if (floorCallback.hasHit()) {
+            _floorDistance = rayLength * floorCallback.m_closestHitFraction - _radius;
+            return;
+        }
+    }
+
     // scan down for nearby floor
     ClosestNotMe rayCallback(_rigidBody);
     rayCallback.m_closestHitFraction = 1.0f;
     collisionWorld->rayTest(rayStart, rayEnd, rayCallback);
     if (rayCallback.hasHit()) {
         _floorDistance = rayLength * rayCallback.m_closestHitFraction - _radius;
+        _floorObject = rayCallback.m_collisionObject;
+    } else {
+        _floorObject = nullptr;
     }
 }
 
@@ -346,7 +450,10 @@ const btScalar MIN_TARGET_SPEED_SQUARED = MIN_TARGET_SPEED * MIN_TARGET_SPEED;
 
 void CharacterController::playerStep(btCollisionWorld* collisionWorld, btScalar dt) {
     _stepHeight = _minStepHeight; // clears memory of last step obstacle
-    _hasSupport = checkForSupport(collisionWorld);
+    if (!_useCachedSupport) {
+        _hasSupport = checkForSupport(collisionWorld);
+        updateSupportCache();
+    }
     btVector3 velocity = _rigidBody->getLinearVelocity() - _parentVelocity;
     computeNewVelocity(dt, velocity);
 
@@ -921,6 +1028,7 @@ void CharacterController::updateState() {
     if (_pendingFlags & PENDING_FLAG_RECOMPUTE_FLYING) {
          SET_STATE(CharacterController::State::Hover, "recomputeFlying");
          _hasSupport = false;
+         invalidateSupportCache();
          _stepHeight = _minStepHeight; // clears memory of last step obstacle
          _pendingFlags &= ~PENDING_FLAG_RECOMPUTE_FLYING;
     }
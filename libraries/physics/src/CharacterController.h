@@ -162,6 +162,12 @@ public:
 
     void resetStuckCounter() { _numStuckSubsteps = 0; }
 
+    // While the avatar rests on the same support with the same contacts the results of the last full support check are
+    // reused, and while it stands on a known floor the floor ray is tested against that object only.  Any change of
+    // the contacts, or a motion of the avatar or of its floor, falls back to the full checks.
+    void setSupportCachingEnabled(bool enabled);
+    bool isSupportCachingEnabled() const { return _supportCachingEnabled; }
+
 protected:
 #ifdef DEBUG_STATE_CHANGE
     void setState(State state, const char* reason);
@@ -173,6 +179,11 @@ protected:
     void updateCurrentGravity();
     void updateUpAxis(const glm::quat& rotation);
     bool checkForSupport(btCollisionWorld* collisionWorld);
+    void gatherContactManifolds(btCollisionWorld* collisionWorld);
+    bool isInContactWith(const btCollisionObject* object) const;
+    bool canUseCachedSupport() const;
+    void updateSupportCache();
+    void invalidateSupportCache();
 
 protected:
     struct CharacterMotor {
@@ -253,6 +264,19 @@ protected:
     bool _collisionless { false };
 
     btScalar _scaleFactor { 1.0f };
+
+    // the manifolds of the character this substep, and a signature of their objects and contact counts
+    std::vector<btPersistentManifold*> _contactManifolds;
+    uint64_t _contactSignature { 0 };
+    // the object under the floor ray, only used while the character touches it
+    const btCollisionObject* _floorObject { nullptr };
+    btTransform _floorObjectTransform;
+    btTransform _supportCacheBodyTransform;
+    uint64_t _supportCacheSignature { 0 };
+    uint32_t _numCachedSupportSubsteps { 0 };
+    bool _supportCacheValid { false };
+    bool _useCachedSupport { false };
+    bool _supportCachingEnabled { true };
 };
 
 #endif // hifi_CharacterController_h
@@ -28,6 +28,8 @@
 const uint8_t LOOPS_FOR_SIMULATION_ORPHAN = 50;
 const quint64 USECS_BETWEEN_OWNERSHIP_BIDS = USECS_PER_SECOND / 5;
 
+uint8_t EntityMotionState::_baseBidPriority { VOLUNTEER_SIMULATION_PRIORITY };
+
 
 EntityMotionState::EntityMotionState(btCollisionShape* shape, EntityItemPointer entity) :
     ObjectMotionState(nullptr),
@@ -290,6 +292,8 @@ void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
 
 
 const uint8_t MAX_NUM_INACTIVE_UPDATES = 20;
+// a full edit goes out at least this often, for the entity-server to persist the state and restart the keyframes
+const uint8_t MAX_PHYSICS_STATES_BETWEEN_EDITS = 20;
 
 bool EntityMotionState::remoteSimulationOutOfSync(uint32_t simulationStep) {
     // NOTE: this method is only ever called when the entity simulation is locally owned
@@ -515,6 +519,16 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
 
     updateSendVelocities();
 
+    EntityEditPacketSender* entityPacketSender = static_cast<EntityEditPacketSender*>(packetSender);
+    if (sendPhysicsState(entityPacketSender)) {
+        _lastStep = step;
+        _lastSendStep = step;
+        _bumpedPriority = 0;
+        return;
+    }
+    entityPacketSender->resetPhysicsStateKeyframe(_entity->getID());
+    _numPhysicsStatesSinceEdit = 0;
+
     // remember _serverFoo data for local prediction of server state
     Transform localTransform;
     _entity->getLocalTransformAndVelocities(localTransform, _serverVelocity, _serverAngularVelocity);
@@ -571,7 +585,6 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     }
 
     EntityItemID id(_entity->getID());
-    EntityEditPacketSender* entityPacketSender = static_cast<EntityEditPacketSender*>(packetSender);
 
     EntityTreeElementPointer element = _entity->getElement();
     EntityTreePointer tree = element ? element->getTree() : nullptr;
@@ -602,6 +615,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     });
 
     _lastStep = step;
+    _lastSendStep = step;
 
     // after sending a bid/update we clear _bumpedPriority
     // which might get promoted again next frame (after local script or simulation interaction)
@@ -609,6 +623,56 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     _bumpedPriority = 0;
 }
 
+bool EntityMotionState::canSendPhysicsState() const {
+    // the compact state carries neither the acceleration, the action data, the query cubes of the children nor the
+    // ownership changes, and the entity-server only works out the query cube of the entities without a parent
+    if (!_entity->isDomainEntity() || _numInactiveUpdates > 0 || _entity->getScriptSimulationPriority() != 0 ||
+            _entity->dynamicDataNeedsTransmit() || !_entity->getParentID().isNull() || _entity->hasChildren() ||
+            _entity->getAcceleration() != _serverAcceleration ||
+            _numPhysicsStatesSinceEdit >= MAX_PHYSICS_STATES_BETWEEN_EDITS) {
+        return false;
+    }
+    uint8_t newPriority = glm::max(computeFinalBidPriority(), YIELD_SIMULATION_PRIORITY);
+    return newPriority == _entity->getSimulationPriority() ||
+        (newPriority == VOLUNTEER_SIMULATION_PRIORITY && _entity->getSimulationPriority() == RECRUIT_SIMULATION_PRIORITY);
+}
+
+bool EntityMotionState::sendPhysicsState(EntityEditPacketSender* packetSender) {
+    if (!canSendPhysicsState()) {
+        return false;
+    }
+
+    EntityPhysicsState state;
+    state.entityID = _entity->getID();
+    Transform localTransform;
+    _entity->getLocalTransformAndVelocities(localTransform, state.velocity, state.angularVelocity);
+    state.position = localTransform.getTranslation();
+    state.rotation = localTransform.getRotation();
+    if (state.velocity == Vectors::ZERO && state.angularVelocity == Vectors::ZERO) {
+        state.flags |= EntityPhysicsState::AT_REST;
+    }
+
+    EntityTreeElementPointer element = _entity->getElement();
+    EntityTreePointer tree = element ? element->getTree() : nullptr;
+    if (!packetSender->queuePhysicsState(tree, state)) {
+        return false;
+    }
+
+    // the extrapolation error is measured against what the others decode
+    _serverPosition = state.position;
+    _serverRotation = state.rotation;
+    _serverVelocity = state.velocity;
+    _serverAngularVelocity = state.angularVelocity;
+    // the entity-server works out the same cube
+    _entity->updateQueryAACube();
+
+    quint64 now = usecTimestampNow();
+    _entity->setSimulationOwnershipExpiry(now + MAX_OUTGOING_SIMULATION_UPDATE_PERIOD);
+    _entity->setLastBroadcast(now); // for debug/physics status icons
+    ++_numPhysicsStatesSinceEdit;
+    return true;
+}
+
 uint32_t EntityMotionState::getIncomingDirtyFlags() const {
     uint32_t dirtyFlags = 0;
     if (_body && _entity) {
@@ -748,7 +812,7 @@ bool EntityMotionState::shouldSendBid() const {
     return _body->isActive()
         && (_region == workload::Region::R1)
         && _ownershipState != EntityMotionState::OwnershipState::Unownable
-        && glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
+        && glm::max(glm::max(_baseBidPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) >= _entity->getSimulationPriority()
         && !_entity->getLocked()
         && (!_body->isStaticOrKinematicObject() || _entity->stillHasMyGrab());
 }
@@ -764,7 +828,7 @@ void EntityMotionState::setRigidBody(btRigidBody* body) {
 
 uint8_t EntityMotionState::computeFinalBidPriority() const {
     return (_region == workload::Region::R1) ?
-        glm::max(glm::max(VOLUNTEER_SIMULATION_PRIORITY, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
+        glm::max(glm::max(_baseBidPriority, _bumpedPriority), _entity->getScriptSimulationPriority()) : 0;
 }
 
 bool EntityMotionState::isLocallyOwned() const {
@@ -19,6 +19,8 @@
 
 #include "ObjectMotionState.h"
 
+class EntityEditPacketSender;
+
 
 // From the MotionState's perspective:
 //      Inside = physics simulation
@@ -99,6 +101,10 @@ public:
     void setRegion(uint8_t region);
     void saveKinematicState(btScalar timeStep) override;
 
+    // the lowest priority of the ownership bids: VOLUNTEER for the clients, higher for a simulator that owns a region
+    static void setBaseBidPriority(uint8_t priority) { _baseBidPriority = priority; }
+    static uint8_t getBaseBidPriority() { return _baseBidPriority; }
+
 protected:
     void setRigidBody(btRigidBody* body) override;
 
@@ -110,6 +116,8 @@ protected:
     void clearOwnershipState();
     void updateServerPhysicsVariables();
     bool remoteSimulationOutOfSync(uint32_t simulationStep);
+    bool canSendPhysicsState() const;
+    bool sendPhysicsState(EntityEditPacketSender* packetSender);
 
     void slaveBidPriority(); // computeNewBidPriority() with value stored in _entity
 
@@ -149,15 +157,19 @@ protected:
     float _measuredDeltaTime;
     uint32_t _lastMeasureStep;
     uint32_t _lastStep; // last step of server extrapolation
+    uint32_t _lastSendStep { 0 };
 
     OwnershipState _ownershipState { OwnershipState::NotLocallyOwned };
     uint8_t _loopsWithoutOwner;
     mutable uint8_t _accelerationNearlyGravityCount;
     uint8_t _numInactiveUpdates { 1 };
+    uint8_t _numPhysicsStatesSinceEdit { 0 };
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
 
     bool isServerlessMode();
+
+    static uint8_t _baseBidPriority;
 };
 
 #endif // hifi_EntityMotionState_h
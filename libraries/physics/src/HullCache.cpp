@@ -0,0 +1,177 @@
+//
+//  HullCache.cpp
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HullCache.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+#include <QtCore/QThreadPool>
+
+#include <HashKey.h>
+#include <PathUtils.h>
+
+#include "PhysicsLogging.h"
+
+const quint32 HULL_CACHE_FILE_VERSION = 1;
+const QString HULL_CACHE_FILE_EXTENSION = ".hulls";
+const size_t MAX_HULLS_IN_MEMORY = 256;
+const int MAX_HULL_CACHE_FILES = 4096;
+const quint32 MAX_HULLS_PER_SHAPE = 1 << 16;
+
+// the shapes whose half extents are within a step of 2^(1/16), about 4%, share their hulls
+const float SCALE_BUCKETS_PER_OCTAVE = 16.0f;
+// the points of the fingerprint are compared in 1/1024 of the half extents
+const float FINGERPRINT_RESOLUTION = 1024.0f;
+const int32_t NUM_FINGERPRINT_POINTS_PER_LIST = 8;
+
+HullCache& HullCache::getInstance() {
+    static HullCache instance;
+    return instance;
+}
+
+HullCache::HullCache() {
+    _directory = PathUtils::getAppLocalDataPath() + "hulls/";
+    QDir().mkpath(_directory);
+
+    // the oldest files go when there are too many
+    QString directory = _directory;
+    QThreadPool::globalInstance()->start([directory] {
+        QDir dir(directory);
+        QFileInfoList files = dir.entryInfoList({ "*" + HULL_CACHE_FILE_EXTENSION }, QDir::Files, QDir::Time);
+        for (int i = MAX_HULL_CACHE_FILES; i < files.size(); ++i) {
+            QFile::remove(files[i].absoluteFilePath());
+        }
+    });
+}
+
+uint64_t HullCache::computeKey(const ShapeInfo& info) {
+    ShapeType type = info.getType();
+    if (type != SHAPE_TYPE_COMPOUND && type != SHAPE_TYPE_SIMPLE_HULL && type != SHAPE_TYPE_SIMPLE_COMPOUND) {
+        return 0;
+    }
+    QString url = info.getURL().toString();
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    if (url.isEmpty() || pointCollection.isEmpty()) {
+        return 0;
+    }
+
+    HashKey::Hasher hasher;
+    hasher.hashUint64((uint64_t)type);
+    QByteArray urlBytes = url.toUtf8();
+    hasher.hashUint64((uint64_t)qChecksum(urlBytes.data(), urlBytes.size()));
+
+    glm::vec3 halfExtents = info.getHalfExtents();
+    glm::vec3 scaleBucket = glm::round(glm::log2(halfExtents) * SCALE_BUCKETS_PER_OCTAVE);
+    hasher.hashVec3(scaleBucket);
+
+    // a few points of each list tell apart the different contents at the same url
+    hasher.hashUint64((uint64_t)pointCollection.size());
+    for (const auto& points : pointCollection) {
+        int32_t numPoints = (int32_t)points.size();
+        hasher.hashUint64((uint64_t)numPoints);
+        int32_t step = std::max(1, numPoints / NUM_FINGERPRINT_POINTS_PER_LIST);
+        for (int32_t i = 0; i < numPoints; i += step) {
+            hasher.hashVec3(glm::round(points[i] / halfExtents * FINGERPRINT_RESOLUTION));
+        }
+    }
+    if (type == SHAPE_TYPE_SIMPLE_COMPOUND) {
+        hasher.hashUint64((uint64_t)info.getTriangleIndices().size());
+    }
+    return hasher.getHash64();
+}
+
+QString HullCache::getFilePath(uint64_t key) const {
+    return _directory + QString::number(key, 16) + HULL_CACHE_FILE_EXTENSION;
+}
+
+bool HullCache::find(uint64_t key, Hulls& hulls) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto itr = _hulls.find(key);
+        if (itr != _hulls.end()) {
+            hulls = itr->second;
+            return true;
+        }
+    }
+    if (read(key, hulls)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        insertInMemory(key, hulls);
+        return true;
+    }
+    return false;
+}
+
+void HullCache::insert(uint64_t key, const Hulls& hulls) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        insertInMemory(key, hulls);
+    }
+
+    QString filePath = getFilePath(key);
+    QThreadPool::globalInstance()->start([filePath, hulls] {
+        QSaveFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            return;
+        }
+        QDataStream stream(&file);
+        stream << HULL_CACHE_FILE_VERSION << (quint32)hulls.size();
+        for (const auto& hull : hulls) {
+            stream << hull.margin << (quint32)hull.points.size();
+            for (const auto& point : hull.points) {
+                stream << point.x << point.y << point.z;
+            }
+        }
+        if (!file.commit()) {
+            qCDebug(physics) << "HullCache failed to write" << filePath;
+        }
+    });
+}
+
+bool HullCache::read(uint64_t key, Hulls& hulls) const {
+    QFile file(getFilePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    quint32 version;
+    quint32 numHulls;
+    stream >> version >> numHulls;
+    if (version != HULL_CACHE_FILE_VERSION || numHulls == 0 || numHulls > MAX_HULLS_PER_SHAPE) {
+        return false;
+    }
+    hulls.resize(numHulls);
+    for (auto& hull : hulls) {
+        quint32 numPoints;
+        stream >> hull.margin >> numPoints;
+        if (numPoints == 0 || numPoints > (quint32)MAX_HULL_POINTS) {
+            return false;
+        }
+        hull.points.resize(numPoints);
+        for (auto& point : hull.points) {
+            stream >> point.x >> point.y >> point.z;
+        }
+    }
+    if (stream.status() != QDataStream::Ok) {
+        hulls.clear();
+        return false;
+    }
+    return true;
+}
+
+void HullCache::insertInMemory(uint64_t key, const Hulls& hulls) {
+    if (_hulls.size() >= MAX_HULLS_IN_MEMORY) {
+        // the disk still has them
+        _hulls.clear();
+    }
+    _hulls[key] = hulls;
+}
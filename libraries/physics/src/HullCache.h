@@ -0,0 +1,59 @@
+//
+//  HullCache.h
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HullCache_h
+#define hifi_HullCache_h
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <QtCore/QString>
+
+#include <ShapeInfo.h>
+
+// Keeps the convex hulls the ShapeFactory reduces from the points of the models (COMPOUND, SIMPLE_HULL and
+// SIMPLE_COMPOUND shapes) in memory and in the local data directory, so the entities that use the same model and the
+// later sessions skip the reduction.
+//
+// The hulls are keyed by the model url, the shape type, a fingerprint of the model points and a bucket of the
+// shape's half extents, and are stored in units of the half extents: the shapes within the same bucket share them.
+class HullCache {
+public:
+    class Hull {
+    public:
+        float margin { 0.0f };
+        std::vector<glm::vec3> points;
+    };
+    using Hulls = std::vector<Hull>;
+
+    static HullCache& getInstance();
+
+    /// \return the key of the hulls of the shape, or zero if they can't be cached
+    static uint64_t computeKey(const ShapeInfo& info);
+
+    bool find(uint64_t key, Hulls& hulls);
+    void insert(uint64_t key, const Hulls& hulls);
+
+private:
+    HullCache();
+
+    QString getFilePath(uint64_t key) const;
+    bool read(uint64_t key, Hulls& hulls) const;
+    void insertInMemory(uint64_t key, const Hulls& hulls);
+
+    std::mutex _mutex;
+    std::unordered_map<uint64_t, Hulls> _hulls;
+    QString _directory;
+};
+
+#endif // hifi_HullCache_h
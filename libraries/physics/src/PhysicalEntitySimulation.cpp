@@ -12,12 +12,30 @@
 
 #include "PhysicalEntitySimulation.h"
 
+#include <algorithm>
+#include <unordered_map>
+
+#include <glm/gtx/norm.hpp>
+
 #include <Profile.h>
 
 #include "PhysicsHelpers.h"
 #include "PhysicsLogging.h"
 #include "ShapeManager.h"
 
+// the shape builds are ordered by distance to the focus, in decimeters, up to this distance
+const float MAX_SHAPE_BUILD_PRIORITY_DISTANCE = 1000.0f; // meters
+const float SHAPE_BUILD_PRIORITY_PER_METER = 10.0f;
+// the shapes this close to the focus can support the avatar
+const float SHAPE_BUILD_SUPPORT_DISTANCE = 4.0f; // meters
+const int32_t SHAPE_BUILD_SUPPORT_PRIORITY_BOOST = (int32_t)(MAX_SHAPE_BUILD_PRIORITY_DISTANCE * SHAPE_BUILD_PRIORITY_PER_METER) + 1;
+// the pending shape builds are prioritized again when the focus moves this far
+const float SHAPE_BUILD_FOCUS_CHANGE_DISTANCE = 2.0f; // meters
+// the R3 shapes are built ahead for where the focus will be this much later, when it moves at least this fast
+const float SHAPE_PREWARM_LOOKAHEAD = 2.0f; // seconds
+const float MIN_SHAPE_PREWARM_SPEED = 0.5f; // meters per second
+const size_t MAX_SHAPE_PREWARMS_PER_STEP = 2;
+
 
 PhysicalEntitySimulation::PhysicalEntitySimulation() {
 }
@@ -59,14 +77,18 @@ void PhysicalEntitySimulation::addEntityToInternalLists(EntityItemPointer entity
             _simpleKinematicEntities.insert(entity);
         }
     }
+    updateShapePrewarmCandidate(entity, region);
 }
 
 void PhysicalEntitySimulation::removeEntityFromInternalLists(EntityItemPointer entity) {
     _entitiesToAddToPhysics.remove(entity);
+    _entitiesToPrewarm.remove(entity);
     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
     if (motionState) {
         removeOwnershipData(motionState);
         _entitiesToRemoveFromPhysics.insert(entity);
+    } else {
+        cancelShapeRequest(entity);
     }
     if (entity->isDead() && entity->getElement()) {
         _deadEntitiesToRemoveFromTree.insert(entity);
@@ -158,16 +180,19 @@ void PhysicalEntitySimulation::processChangedEntity(const EntityItemPointer& ent
             _simpleKinematicEntities.erase(itr);
         }
     } else if (canBeKinematic && entity->isMovingRelativeToParent()) {
+        cancelShapeRequest(entity);
         SetOfEntities::iterator itr = _simpleKinematicEntities.find(entity);
         if (itr == _simpleKinematicEntities.end()) {
             _simpleKinematicEntities.insert(entity);
         }
     } else {
+        cancelShapeRequest(entity);
         SetOfEntities::iterator itr = _simpleKinematicEntities.find(entity);
         if (itr != _simpleKinematicEntities.end()) {
             _simpleKinematicEntities.erase(itr);
         }
     }
+    updateShapePrewarmCandidate(entity, region);
 }
 
 void PhysicalEntitySimulation::processDeadEntities() {
@@ -226,8 +251,13 @@ void PhysicalEntitySimulation::clearEntities() {
     // clear all other lists specific to this derived class
     _entitiesToRemoveFromPhysics.clear();
     _entitiesToAddToPhysics.clear();
+    _entitiesToPrewarm.clear();
     _incomingChanges.clear();
     _entitiesToDeleteLater.clear();
+    for (const auto& shapeRequest : _shapeRequests) {
+        ObjectMotionState::getShapeManager()->cancelShapeBuild(shapeRequest.shapeHash);
+    }
+    _shapeRequests.clear();
 
     EntitySimulation::clearEntities();
 }
@@ -259,9 +289,123 @@ void PhysicalEntitySimulation::removeDeadEntities() {
 }
 // end EntitySimulation overrides
 
+void PhysicalEntitySimulation::setShapeBuildFocus(const glm::vec3& position, const glm::vec3& velocity, bool needsSupport) {
+    _shapeBuildFocus = position;
+    _shapeBuildFocusVelocity = velocity;
+    if (needsSupport != _shapeBuildFocusNeedsSupport ||
+        glm::distance2(position, _lastShapeBuildFocus) > SHAPE_BUILD_FOCUS_CHANGE_DISTANCE * SHAPE_BUILD_FOCUS_CHANGE_DISTANCE) {
+        _shapeBuildFocusNeedsSupport = needsSupport;
+        _lastShapeBuildFocus = position;
+        _shapeBuildFocusChanged = true;
+    }
+}
+
+int32_t PhysicalEntitySimulation::computeShapeBuildPriority(const EntityItemPointer& entity) const {
+    float distance = glm::distance(entity->getWorldPosition(), _shapeBuildFocus) - entity->getBoundingRadius();
+    distance = glm::clamp(distance, 0.0f, MAX_SHAPE_BUILD_PRIORITY_DISTANCE);
+    int32_t priority = -(int32_t)(distance * SHAPE_BUILD_PRIORITY_PER_METER);
+    if (_shapeBuildFocusNeedsSupport && distance < SHAPE_BUILD_SUPPORT_DISTANCE) {
+        priority += SHAPE_BUILD_SUPPORT_PRIORITY_BOOST;
+    }
+    return priority;
+}
+
+void PhysicalEntitySimulation::updateShapeBuildPriorities() {
+    if (!_shapeBuildFocusChanged) {
+        return;
+    }
+    _shapeBuildFocusChanged = false;
+    // several requests may wait for the same shape: it goes with its most urgent one
+    std::unordered_map<uint64_t, int32_t> priorities;
+    for (const auto& shapeRequest : _shapeRequests) {
+        int32_t priority = computeShapeBuildPriority(shapeRequest.entity);
+        auto itr = priorities.find(shapeRequest.shapeHash);
+        if (itr == priorities.end()) {
+            priorities[shapeRequest.shapeHash] = priority;
+        } else {
+            itr->second = std::max(itr->second, priority);
+        }
+    }
+    for (const auto& entry : priorities) {
+        ObjectMotionState::getShapeManager()->setShapeBuildPriority(entry.first, entry.second);
+    }
+}
+
+void PhysicalEntitySimulation::cancelShapeRequest(const EntityItemPointer& entity) {
+    if (_shapeRequests.size() > 0) {
+        ShapeRequests::iterator requestItr = _shapeRequests.find(ShapeRequest(entity));
+        if (requestItr != _shapeRequests.end()) {
+            ObjectMotionState::getShapeManager()->cancelShapeBuild(requestItr->shapeHash);
+            _shapeRequests.erase(requestItr);
+        }
+    }
+}
+
+void PhysicalEntitySimulation::updateShapePrewarmCandidate(const EntityItemPointer& entity, uint8_t region) {
+    if (region == workload::Region::R3 && !entity->getPhysicsInfo() && entity->shouldBePhysical()) {
+        _entitiesToPrewarm.insert(entity);
+    } else {
+        _entitiesToPrewarm.remove(entity);
+    }
+}
+
+void PhysicalEntitySimulation::prewarmShapes() {
+    if (_entitiesToPrewarm.empty() ||
+            glm::length2(_shapeBuildFocusVelocity) < MIN_SHAPE_PREWARM_SPEED * MIN_SHAPE_PREWARM_SPEED) {
+        return;
+    }
+    PROFILE_RANGE(simulation_physics, "PrewarmShapes");
+
+    // the candidates the focus is heading to, the nearest to where it will be first
+    glm::vec3 predictedFocus = _shapeBuildFocus + _shapeBuildFocusVelocity * SHAPE_PREWARM_LOOKAHEAD;
+    std::vector<std::pair<float, EntityItemPointer>> candidates;
+    SetOfEntities::iterator entityItr = _entitiesToPrewarm.begin();
+    while (entityItr != _entitiesToPrewarm.end()) {
+        EntityItemPointer entity = (*entityItr);
+        if (entity->isDead() || entity->getPhysicsInfo() ||
+                _space->getRegion(entity->getSpaceIndex()) != workload::Region::R3) {
+            entityItr = _entitiesToPrewarm.erase(entityItr);
+            continue;
+        }
+        glm::vec3 position = entity->getWorldPosition();
+        float predictedDistance2 = glm::distance2(position, predictedFocus);
+        if (predictedDistance2 < glm::distance2(position, _shapeBuildFocus) && entity->isReadyToComputeShape()) {
+            candidates.emplace_back(predictedDistance2, entity);
+        }
+        ++entityItr;
+    }
+    size_t numPrewarms = std::min(candidates.size(), MAX_SHAPE_PREWARMS_PER_STEP);
+    std::partial_sort(candidates.begin(), candidates.begin() + numPrewarms, candidates.end(),
+        [](const std::pair<float, EntityItemPointer>& a, const std::pair<float, EntityItemPointer>& b) {
+            return a.first < b.first;
+        });
+
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    for (size_t i = 0; i < numPrewarms; ++i) {
+        const EntityItemPointer& entity = candidates[i].second;
+        _entitiesToPrewarm.remove(entity);
+        ShapeInfo shapeInfo;
+        entity->computeShapeInfo(shapeInfo);
+        if (shapeManager->hasShapeWithKey(shapeInfo.getHash())) {
+            continue;
+        }
+        // after all the shapes wanted now; a built shape is released right away but the ShapeManager keeps it a while
+        int32_t priority = computeShapeBuildPriority(entity) - SHAPE_BUILD_SUPPORT_PRIORITY_BOOST;
+        const btCollisionShape* shape = shapeManager->getShape(shapeInfo, priority);
+        if (shape) {
+            shapeManager->releaseShape(shape);
+        }
+    }
+}
+
 void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     // this lambda for when we decide to actually build the motionState
+    uint32_t numAdds = 0;
+    auto hasAddBudget = [&] {
+        return _maxPhysicsAddsPerStep == 0 || numAdds < _maxPhysicsAddsPerStep;
+    };
     auto buildMotionState = [&](btCollisionShape* shape, EntityItemPointer entity) {
+        ++numAdds;
         EntityMotionState* motionState = new EntityMotionState(shape, entity);
         entity->setPhysicsInfo(static_cast<void*>(motionState));
         motionState->setRegion(_space->getRegion(entity->getSpaceIndex()));
@@ -279,6 +423,11 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
             EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
             if (!motionState) {
                 // this is an ADD because motionState doesn't exist yet
+                if (!hasAddBudget()) {
+                    // the shape is kept for the next steps
+                    ++requestItr;
+                    continue;
+                }
                 btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShapeByKey(requestItr->shapeHash));
                 if (shape) {
                     // shape is ready at last!
@@ -298,7 +447,8 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                            computeShapeBuildPriority(entity)));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -328,16 +478,24 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
         }
     }
 
-    SetOfEntities::iterator entityItr = _entitiesToAddToPhysics.begin();
-    while (entityItr != _entitiesToAddToPhysics.end()) {
-        EntityItemPointer entity = (*entityItr);
+    // with a budget the adds nearest to the focus go first and the others wait for the next steps
+    std::vector<EntityItemPointer> entitiesToAdd(_entitiesToAddToPhysics.begin(), _entitiesToAddToPhysics.end());
+    if (_maxPhysicsAddsPerStep > 0 && entitiesToAdd.size() > _maxPhysicsAddsPerStep) {
+        std::sort(entitiesToAdd.begin(), entitiesToAdd.end(), [&](const EntityItemPointer& a, const EntityItemPointer& b) {
+            return glm::distance2(a->getWorldPosition(), _shapeBuildFocus) < glm::distance2(b->getWorldPosition(), _shapeBuildFocus);
+        });
+    }
+    for (const auto& entity : entitiesToAdd) {
+        if (!hasAddBudget()) {
+            break;
+        }
         if (entity->isDead()) {
             prepareEntityForDelete(entity);
-            entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            _entitiesToAddToPhysics.remove(entity);
             continue;
         }
         if (entity->getPhysicsInfo()) {
-            entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            _entitiesToAddToPhysics.remove(entity);
             continue;
         }
         if (!entity->shouldBePhysical()) {
@@ -348,19 +506,18 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                     _simpleKinematicEntities.insert(entity);
                 }
             }
-            entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            _entitiesToAddToPhysics.remove(entity);
             continue;
         }
 
         uint8_t region = _space->getRegion(entity->getSpaceIndex());
         if (region == workload::Region::UNKNOWN) {
             // the workload hasn't categorized it yet --> skip for later
-            ++entityItr;
             continue;
         }
         if (region > workload::Region::R2) {
             // not in physical zone --> remove from list
-            entityItr = _entitiesToAddToPhysics.erase(entityItr);
+            _entitiesToAddToPhysics.remove(entity);
             continue;
         }
 
@@ -372,7 +529,8 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                    computeShapeBuildPriority(entity)));
                 if (shape) {
                     buildMotionState(shape, entity);
                 } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
@@ -383,10 +541,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                     // failed to build shape --> will not be added
                 }
             }
-            entityItr = _entitiesToAddToPhysics.erase(entityItr);
-        } else {
-            // skip for later
-            ++entityItr;
+            _entitiesToAddToPhysics.remove(entity);
         }
     }
 }
@@ -400,18 +555,14 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
             transaction.objectsToRemove.push_back(motionState);
             _incomingChanges.remove(motionState);
         }
-        if (_shapeRequests.size() > 0) {
-            ShapeRequest shapeRequest(entity);
-            ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
-            if (requestItr != _shapeRequests.end()) {
-                _shapeRequests.erase(requestItr);
-            }
-        }
+        cancelShapeRequest(entity);
     }
     _entitiesToRemoveFromPhysics.clear();
 
     // entities to add
+    updateShapeBuildPriorities();
     buildMotionStatesForEntitiesThatNeedThem();
+    prewarmShapes();
 
     // motionStates with changed entities: delete, add, or change
     for (auto& object : _incomingChanges) {
@@ -435,7 +586,8 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
                     ShapeInfo shapeInfo;
                     object->_entity->computeShapeInfo(shapeInfo);
                     uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo,
+                        computeShapeBuildPriority(object->_entity)));
                     if (shape) {
                         object->setShape(shape);
                         handledFlags |= Simulation::DIRTY_SHAPE;
@@ -629,6 +781,7 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
         return;
     }
     PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_owned.size());
+    std::vector<EntityMotionState*> updates;
     uint32_t i = 0;
     while (i < _owned.size()) {
         if (!_owned[i]->isLocallyOwned()) {
@@ -640,11 +793,32 @@ void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
             _owned.remove(i);
         } else {
             if (_owned[i]->shouldSendUpdate(numSubsteps)) {
-                _owned[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                updates.push_back(_owned[i]);
             }
             ++i;
         }
     }
+
+    if (_maxOwnedUpdatesPerSecond > 0) {
+        // the budget accumulates with the steps, up to a tenth of a second worth of updates
+        const float MAX_BUDGET_DURATION = 0.1f; // seconds
+        float maxBudget = glm::max(1.0f, (float)_maxOwnedUpdatesPerSecond * MAX_BUDGET_DURATION);
+        float elapsed = (float)(numSubsteps - _lastOwnedUpdateBudgetStep) / (float)NUM_SUBSTEPS_PER_SECOND;
+        _lastOwnedUpdateBudgetStep = numSubsteps;
+        _ownedUpdateBudget = glm::min(_ownedUpdateBudget + elapsed * (float)_maxOwnedUpdatesPerSecond, maxBudget);
+
+        size_t numUpdates = glm::min(updates.size(), (size_t)_ownedUpdateBudget);
+        if (numUpdates < updates.size()) {
+            // the others stay out of sync and try again next step
+            std::partial_sort(updates.begin(), updates.begin() + numUpdates, updates.end(),
+                [](const EntityMotionState* a, const EntityMotionState* b) { return a->_lastSendStep < b->_lastSendStep; });
+            updates.resize(numUpdates);
+        }
+        _ownedUpdateBudget -= (float)numUpdates;
+    }
+    for (auto state : updates) {
+        state->sendUpdate(_entityPacketSender, numSubsteps);
+    }
 }
 
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
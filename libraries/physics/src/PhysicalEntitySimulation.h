@@ -59,6 +59,21 @@ public:
     void init(EntityTreePointer tree, PhysicsEnginePointer engine, EntityEditPacketSender* packetSender);
     void setWorkloadSpace(const workload::SpacePointer space) { _space = space; }
 
+    // When non-zero the updates of the owned entities are spread over the steps so no more than this many go out
+    // per second: the entities that waited the longest since their last update go first.
+    void setMaxOwnedUpdatesPerSecond(uint32_t maxUpdatesPerSecond) { _maxOwnedUpdatesPerSecond = maxUpdatesPerSecond; }
+
+    // The static mesh shapes nearest to this position are built first, and the ones that could be under the avatar
+    // go before all others when it needs a floor: on arrival, before physics is enabled, or while falling.
+    // The shapes of the R3 entities the focus is heading to are built ahead, a few per step, so they are ready when
+    // those entities enter the physics region.
+    void setShapeBuildFocus(const glm::vec3& position, const glm::vec3& velocity, bool needsSupport);
+
+    // When non-zero no more than this many entities are added to physics per step: the ones nearest to the shape build
+    // focus go first and the others wait, so crossing a region boundary doesn't add hundreds of objects in one frame.
+    void setMaxPhysicsAddsPerStep(uint32_t maxAdds) { _maxPhysicsAddsPerStep = maxAdds; }
+    int32_t getNumPendingPhysicsAdds() const { return _entitiesToAddToPhysics.size(); }
+
     void addDynamic(EntityDynamicPointer dynamic) override;
     void removeDynamic(const QUuid dynamicID) override;
     void applyDynamicChanges() override;
@@ -101,6 +116,11 @@ public:
 
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    int32_t computeShapeBuildPriority(const EntityItemPointer& entity) const;
+    void updateShapeBuildPriorities();
+    void cancelShapeRequest(const EntityItemPointer& entity);
+    void updateShapePrewarmCandidate(const EntityItemPointer& entity, uint8_t region);
+    void prewarmShapes();
 
     class ShapeRequest {
     public:
@@ -118,6 +138,13 @@ private:
 
     using ShapeRequests = std::set<ShapeRequest>;
     ShapeRequests _shapeRequests;
+    glm::vec3 _shapeBuildFocus { 0.0f };
+    glm::vec3 _shapeBuildFocusVelocity { 0.0f };
+    glm::vec3 _lastShapeBuildFocus { 0.0f };
+    bool _shapeBuildFocusNeedsSupport { false };
+    bool _shapeBuildFocusChanged { false };
+    SetOfEntities _entitiesToPrewarm; // R3 entities whose shapes may be built ahead
+    uint32_t _maxPhysicsAddsPerStep { 0 };
 
     PhysicsEnginePointer _physicsEngine = nullptr;
     EntityEditPacketSender* _entityPacketSender = nullptr;
@@ -135,6 +162,10 @@ private:
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
+
+    uint32_t _maxOwnedUpdatesPerSecond { 0 };
+    float _ownedUpdateBudget { 0.0f };
+    uint32_t _lastOwnedUpdateBudgetStep { 0 };
 };
 
 
@@ -11,10 +11,14 @@
 
 #include "PhysicsEngine.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <functional>
+#include <unordered_map>
 
 #include <QFile>
 
+#include <NumericalConstants.h>
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
@@ -26,6 +30,7 @@
 #include "PhysicsDebugDraw.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
+#include "ShapeManager.h"
 
 PhysicsEngine::PhysicsEngine(const glm::vec3& offset) :
         _originOffset(offset),
@@ -37,18 +42,33 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionConfig;
     delete _collisionDispatcher;
     delete _broadphaseFilter;
-    delete _constraintSolver;
     delete _dynamicsWorld;
+    delete _constraintSolver;
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+    delete _constraintSolverMt;
+#endif
     delete _ghostPairCallback;
 }
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
         _collisionConfig = new btDefaultCollisionConfiguration();
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+        // the islands are solved and the narrowphase is run on the TBB workers, one solver per thread
+        _taskScheduler = std::make_unique<BulletTaskScheduler>();
+        btSetTaskScheduler(_taskScheduler.get());
+        _collisionDispatcher = new btCollisionDispatcherMt(_collisionConfig);
+        _broadphaseFilter = new btDbvtBroadphase();
+        auto solverPool = new btConstraintSolverPoolMt(_taskScheduler->getNumThreads());
+        _constraintSolver = solverPool;
+        _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, solverPool, _constraintSolverMt, _collisionConfig);
+#else
         _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
         _constraintSolver = new btSequentialImpulseConstraintSolver;
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+#endif
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -302,6 +322,13 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
+    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
+    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
+    _clock.reset();
+    stepSimulation(btMin(dt, MAX_TIMESTEP));
+}
+
+void PhysicsEngine::stepSimulation(float timeStep) {
     CProfileManager::Reset();
     BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
@@ -310,10 +337,7 @@ void PhysicsEngine::stepSimulation() {
     // (3) synchronize outgoing motion states
     // (4) send outgoing packets
 
-    const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
-    float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
-    _clock.reset();
-    float timeStep = btMin(dt, MAX_TIMESTEP);
+    enforceActivationBudget();
 
     auto onSubStep = [this]() {
         this->updateContactMap();
@@ -331,6 +355,135 @@ void PhysicsEngine::stepSimulation() {
     }
 }
 
+void PhysicsEngine::enforceActivationBudget() {
+    BT_PROFILE("enforceActivationBudget");
+
+    // The islands are the ones Bullet built on the previous step: the bodies of an island sleep and wake together.
+    // Bodies never solved yet have no island and always stay active.
+    class Island {
+    public:
+        int tag { -1 };
+        int32_t numBodies { 0 };
+        float priority { 0.0f }; // smaller goes first
+        bool isActive { false };
+        bool mustStayActive { false };
+        bool budgeted { false };
+    };
+    std::vector<Island> islands;
+    std::unordered_map<int, size_t> islandIndices;
+
+    const float OWNED_ISLAND_DISTANCE_SCALE = 0.25f;
+    btVector3 avatarPosition(0.0f, 0.0f, 0.0f);
+    bool hasAvatar = false;
+    if (_myAvatarController && _myAvatarController->getCollisionObject()) {
+        avatarPosition = _myAvatarController->getCollisionObject()->getWorldTransform().getOrigin();
+        hasAvatar = true;
+    }
+
+    ActivationStats stats;
+    int32_t numUnsolvedBodies = 0;
+    const btCollisionObjectArray& objects = _dynamicsWorld->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (!body || body->isStaticOrKinematicObject()) {
+            continue;
+        }
+        if (body->getIslandTag() < 0) {
+            if (body->isActive()) {
+                ++numUnsolvedBodies;
+            } else {
+                ++stats.numSleepingBodies;
+            }
+            continue;
+        }
+        auto found = islandIndices.find(body->getIslandTag());
+        if (found == islandIndices.end()) {
+            found = islandIndices.emplace(body->getIslandTag(), islands.size()).first;
+            islands.emplace_back();
+            islands.back().tag = body->getIslandTag();
+            islands.back().priority = FLT_MAX;
+        }
+        Island& island = islands[found->second];
+        ++island.numBodies;
+        if (!body->isActive()) {
+            continue;
+        }
+        island.isActive = true;
+
+        ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getUserPointer());
+        if (!motionState || body->getActivationState() == DISABLE_DEACTIVATION) {
+            // MyAvatar, or a body that Bullet would never let sleep
+            island.mustStayActive = true;
+            continue;
+        }
+        float distance = hasAvatar ? (body->getWorldTransform().getOrigin() - avatarPosition).length() : 0.0f;
+        if (motionState->isLocallyOwned()) {
+            distance *= OWNED_ISLAND_DISTANCE_SCALE;
+        }
+        island.priority = std::min(island.priority, distance);
+    }
+
+    int32_t numActiveBodies = numUnsolvedBodies;
+    for (const auto& island : islands) {
+        if (island.isActive) {
+            numActiveBodies += island.numBodies;
+        }
+    }
+
+    if (_maxActiveBodies > 0 && numActiveBodies > _maxActiveBodies) {
+        // the island tag breaks the ties so the same world always keeps the same islands
+        std::vector<Island*> activeIslands;
+        for (auto& island : islands) {
+            if (island.isActive) {
+                activeIslands.push_back(&island);
+            }
+        }
+        std::sort(activeIslands.begin(), activeIslands.end(), [](const Island* a, const Island* b) {
+            if (a->mustStayActive != b->mustStayActive) {
+                return a->mustStayActive;
+            }
+            if (a->priority != b->priority) {
+                return a->priority < b->priority;
+            }
+            return a->tag < b->tag;
+        });
+
+        int32_t budget = _maxActiveBodies - numUnsolvedBodies;
+        for (auto island : activeIslands) {
+            if (island->mustStayActive || island->numBodies <= budget) {
+                budget -= island->numBodies;
+            } else {
+                // keep filling the budget with the smaller islands further down
+                island->budgeted = true;
+                island->isActive = false;
+                ++stats.numBudgetedIslands;
+            }
+        }
+
+        for (int i = 0; i < objects.size(); ++i) {
+            btRigidBody* body = btRigidBody::upcast(objects[i]);
+            if (body && !body->isStaticOrKinematicObject() && body->isActive() && body->getIslandTag() >= 0 &&
+                    islands[islandIndices[body->getIslandTag()]].budgeted) {
+                body->setActivationState(ISLAND_SLEEPING);
+                body->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
+                body->setAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
+            }
+        }
+    }
+
+    stats.numActiveBodies = numUnsolvedBodies;
+    for (const auto& island : islands) {
+        if (island.isActive) {
+            stats.numActiveBodies += island.numBodies;
+            ++stats.numActiveIslands;
+        } else {
+            stats.numSleepingBodies += island.numBodies;
+            ++stats.numSleepingIslands;
+        }
+    }
+    _activationStats = stats;
+}
+
 class CProfileOperator {
 public:
     CProfileOperator() {}
@@ -397,6 +550,24 @@ protected:
 };
 
 void PhysicsEngine::harvestPerformanceStats() {
+    PROFILE_COUNTER(simulation_physics, "physicsBodies", {
+        { "active", _activationStats.numActiveBodies },
+        { "sleeping", _activationStats.numSleepingBodies }
+    });
+    PROFILE_COUNTER(simulation_physics, "physicsIslands", {
+        { "active", _activationStats.numActiveIslands },
+        { "sleeping", _activationStats.numSleepingIslands },
+        { "budgeted", _activationStats.numBudgetedIslands }
+    });
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    if (shapeManager) {
+        PROFILE_COUNTER(simulation_physics, "shapeBuilds", {
+            { "pending", shapeManager->getNumPendingShapeBuilds() },
+            { "latencyMsecs", (float)shapeManager->getAverageShapeBuildLatency() / (float)USECS_PER_MSEC },
+            { "canceled", shapeManager->getShapeBuildCancelCount() }
+        });
+    }
+
     // unfortunately the full context names get too long for our stats presentation format
     //QString contextName = PerformanceTimer::getContextName(); // TODO: how to show full context name?
     QString contextName("...");
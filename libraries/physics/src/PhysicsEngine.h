@@ -19,7 +19,12 @@
 #include <QUuid>
 #include <btBulletDynamicsCommon.h>
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#endif
 
+#include "BulletTaskScheduler.h"
 #include "BulletUtil.h"
 #include "ContactInfo.h"
 #include "ObjectMotionState.h"
@@ -108,7 +113,20 @@ public:
 
     void processTransaction(Transaction& transaction);
 
+    static const int32_t DEFAULT_MAX_ACTIVE_BODIES = 512;
+
+    class ActivationStats {
+    public:
+        int32_t numActiveBodies { 0 };
+        int32_t numSleepingBodies { 0 };
+        int32_t numActiveIslands { 0 };
+        int32_t numSleepingIslands { 0 };
+        int32_t numBudgetedIslands { 0 }; // put to sleep by the active body budget this step
+    };
+
     void stepSimulation();
+    // steps by the given time rather than by the time since the last step, as the headless benchmarks do
+    void stepSimulation(float timeStep);
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -139,6 +157,11 @@ public:
 
     void dumpNextStats() { _dumpNextStats = true; }
 
+    /// \param maxActiveBodies the number of dynamic bodies simulated per step, zero for no limit
+    void setMaxActiveBodies(int32_t maxActiveBodies) { _maxActiveBodies = maxActiveBodies; }
+    int32_t getMaxActiveBodies() const { return _maxActiveBodies; }
+    const ActivationStats& getActivationStats() const { return _activationStats; }
+
     EntityDynamicPointer getDynamicByID(const QUuid& dynamicID) const;
     bool addDynamic(EntityDynamicPointer dynamic);
     void removeDynamic(const QUuid dynamicID);
@@ -168,11 +191,18 @@ private:
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
 
+    /// \brief puts to sleep the islands over the active body budget, the farthest from MyAvatar and not owned first
+    void enforceActivationBudget();
+
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolver = NULL;
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+    btConstraintSolver* _constraintSolverMt = NULL;
+    std::unique_ptr<BulletTaskScheduler> _taskScheduler;
+#endif
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -189,6 +219,8 @@ private:
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int32_t _maxActiveBodies { DEFAULT_MAX_ACTIVE_BODIES };
+    ActivationStats _activationStats;
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
@@ -12,10 +12,13 @@
 #include "ShapeFactory.h"
 
 #include <glm/gtx/norm.hpp>
+#include <BulletCollision/CollisionShapes/btScaledBvhTriangleMeshShape.h>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
+#include "BakedBVH.h"
 #include "BulletUtil.h"
+#include "HullCache.h"
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
@@ -27,7 +30,19 @@ public:
         assert(_dataArray);
     }
 
+    // uses a bvh baked over the same triangles instead of building one, and owns the buffer it was deserialized into
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+        assert(_dataArray);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the bvh was deserialized in place, so it goes with its buffer
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -47,6 +62,7 @@ public:
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -198,6 +214,82 @@ btConvexHullShape* createConvexHull(const ShapeInfo::PointList& points) {
     return hull;
 }
 
+// util method
+void createSimpleCompoundHulls(const ShapeInfo& info, std::vector<btConvexHullShape*>& hulls) {
+    const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
+    const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    uint32_t numIndices = triangleIndices.size();
+    uint32_t numMeshes = info.getNumSubShapes();
+    const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
+    if (numMeshes == 0 || numIndices <= MIN_NUM_SIMPLE_COMPOUND_INDICES) {
+        return;
+    }
+    uint32_t i = 0;
+    for (auto& points : pointCollection) {
+        // build a hull around each part
+        while (i < numIndices) {
+            ShapeInfo::PointList hullPoints;
+            hullPoints.reserve(points.size());
+            while (i < numIndices) {
+                int32_t j = triangleIndices[i];
+                ++i;
+                if (j == END_OF_MESH_PART) {
+                    // end of part
+                    break;
+                }
+                hullPoints.push_back(points[j]);
+            }
+            if (hullPoints.size() > 0) {
+                btConvexHullShape* hull = createConvexHull(hullPoints);
+                if (hull) {
+                    hulls.push_back(hull);
+                }
+            }
+
+            assert(i < numIndices);
+            if (triangleIndices[i] == END_OF_MESH) {
+                // end of mesh
+                ++i;
+                break;
+            }
+        }
+    }
+}
+
+// util method: the hulls are cached in units of the half extents of their shape
+HullCache::Hulls getHullsForCache(const std::vector<btConvexHullShape*>& hulls, const glm::vec3& halfExtents) {
+    HullCache::Hulls cachedHulls;
+    cachedHulls.reserve(hulls.size());
+    for (auto hull : hulls) {
+        HullCache::Hull cachedHull;
+        cachedHull.margin = hull->getMargin();
+        int32_t numPoints = hull->getNumPoints();
+        const btVector3* points = hull->getUnscaledPoints();
+        cachedHull.points.reserve(numPoints);
+        for (int32_t i = 0; i < numPoints; ++i) {
+            cachedHull.points.push_back(bulletToGLM(points[i]) / halfExtents);
+        }
+        cachedHulls.push_back(cachedHull);
+    }
+    return cachedHulls;
+}
+
+// util method
+void createConvexHullsFromCache(const HullCache::Hulls& cachedHulls, const glm::vec3& halfExtents,
+                                std::vector<btConvexHullShape*>& hulls) {
+    hulls.reserve(cachedHulls.size());
+    for (const auto& cachedHull : cachedHulls) {
+        // the points were reduced and corrected for the margin when the hull was first built
+        btConvexHullShape* hull = new btConvexHullShape();
+        hull->setMargin(cachedHull.margin);
+        for (const auto& point : cachedHull.points) {
+            hull->addPoint(glmToBullet(point * halfExtents), false);
+        }
+        hull->recalcLocalAabb();
+        hulls.push_back(hull);
+    }
+}
+
 // util method
 btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     assert(info.getType() == SHAPE_TYPE_STATIC_MESH); // should only get here for mesh shapes
@@ -270,6 +362,36 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
+// util method
+btCollisionShape* createBakedStaticMesh(const ShapeInfo& info, btTriangleIndexVertexArray* dataArray) {
+    btBvhTriangleMeshShape* mesh = nullptr;
+    void* bvhBuffer = nullptr;
+    btOptimizedBvh* bvh = BakedBVH::deserialize(info.getBakedBVH(), bvhBuffer);
+    if (bvh) {
+        mesh = new StaticMeshShape(dataArray, bvh, bvhBuffer);
+    } else {
+        // baked on another kind of platform, so build it after all
+        mesh = new StaticMeshShape(dataArray);
+    }
+
+    // the triangles are as the model has them, so move them where the shape has them
+    btCollisionShape* shape = mesh;
+    const float MIN_RELATIVE_SCALE_ERROR = 0.0001f;
+    glm::vec3 scale = info.getBakedMeshScale();
+    if (glm::any(glm::greaterThan(glm::abs(scale - glm::vec3(1.0f)), glm::vec3(MIN_RELATIVE_SCALE_ERROR)))) {
+        shape = new btScaledBvhTriangleMeshShape(mesh, glmToBullet(scale));
+    }
+    const float MIN_ROTATION_DOT = 0.99999f;
+    glm::vec3 translation = info.getBakedMeshTranslation();
+    glm::quat rotation = info.getBakedMeshRotation();
+    if (glm::length2(translation) > MIN_SHAPE_OFFSET * MIN_SHAPE_OFFSET || fabsf(rotation.w) < MIN_ROTATION_DOT) {
+        auto compound = new btCompoundShape();
+        compound->addChildShape(btTransform(glmToBullet(rotation), glmToBullet(translation)), shape);
+        shape = compound;
+    }
+    return shape;
+}
+
 const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
@@ -353,80 +475,50 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         }
         break;
         case SHAPE_TYPE_COMPOUND:
-        case SHAPE_TYPE_SIMPLE_HULL: {
-            const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
-            uint32_t numSubShapes = info.getNumSubShapes();
-            if (numSubShapes == 1) {
-                if (!pointCollection.isEmpty()) {
-                    shape = createConvexHull(pointCollection[0]);
-                }
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND: {
+            std::vector<btConvexHullShape*> hulls;
+            uint64_t cacheKey = HullCache::computeKey(info);
+            HullCache::Hulls cachedHulls;
+            if (cacheKey != 0 && HullCache::getInstance().find(cacheKey, cachedHulls)) {
+                createConvexHullsFromCache(cachedHulls, info.getHalfExtents(), hulls);
             } else {
+                if (type == SHAPE_TYPE_SIMPLE_COMPOUND) {
+                    createSimpleCompoundHulls(info, hulls);
+                } else {
+                    for (const ShapeInfo::PointList& hullPoints : info.getPointCollection()) {
+                        btConvexHullShape* hull = createConvexHull(hullPoints);
+                        if (hull) {
+                            hulls.push_back(hull);
+                        }
+                    }
+                }
+                if (cacheKey != 0 && !hulls.empty()) {
+                    HullCache::getInstance().insert(cacheKey, getHullsForCache(hulls, info.getHalfExtents()));
+                }
+            }
+
+            if (hulls.size() == 1 && (type == SHAPE_TYPE_SIMPLE_COMPOUND || info.getNumSubShapes() == 1)) {
+                shape = hulls[0];
+            } else if (!hulls.empty()) {
                 auto compound = new btCompoundShape();
                 btTransform trans;
                 trans.setIdentity();
-                foreach (const ShapeInfo::PointList& hullPoints, pointCollection) {
-                    btConvexHullShape* hull = createConvexHull(hullPoints);
+                for (auto hull : hulls) {
                     compound->addChildShape(trans, hull);
                 }
                 shape = compound;
             }
         }
         break;
-        case SHAPE_TYPE_SIMPLE_COMPOUND: {
-            const ShapeInfo::PointCollection& pointCollection = info.getPointCollection();
-            const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
-            uint32_t numIndices = triangleIndices.size();
-            uint32_t numMeshes = info.getNumSubShapes();
-            const uint32_t MIN_NUM_SIMPLE_COMPOUND_INDICES = 2; // END_OF_MESH_PART + END_OF_MESH
-            if (numMeshes > 0 && numIndices > MIN_NUM_SIMPLE_COMPOUND_INDICES) {
-                uint32_t i = 0;
-                std::vector<btConvexHullShape*> hulls;
-                for (auto& points : pointCollection) {
-                    // build a hull around each part
-                    while (i < numIndices) {
-                        ShapeInfo::PointList hullPoints;
-                        hullPoints.reserve(points.size());
-                        while (i < numIndices) {
-                            int32_t j = triangleIndices[i];
-                            ++i;
-                            if (j == END_OF_MESH_PART) {
-                                // end of part
-                                break;
-                            }
-                            hullPoints.push_back(points[j]);
-                        }
-                        if (hullPoints.size() > 0) {
-                            btConvexHullShape* hull = createConvexHull(hullPoints);
-                            hulls.push_back(hull);
-                        }
-
-                        assert(i < numIndices);
-                        if (triangleIndices[i] == END_OF_MESH) {
-                            // end of mesh
-                            ++i;
-                            break;
-                        }
-                    }
-                }
-                uint32_t numHulls = (uint32_t)hulls.size();
-                if (numHulls == 1) {
-                    shape = hulls[0];
-                } else {
-                    auto compound = new btCompoundShape();
-                    btTransform trans;
-                    trans.setIdentity();
-                    for (auto hull : hulls) {
-                        compound->addChildShape(trans, hull);
-                    }
-                    shape = compound;
-                }
-            }
-        }
-        break;
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
             if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
+                if (info.hasBakedMesh()) {
+                    shape = createBakedStaticMesh(info, dataArray);
+                } else {
+                    shape = new StaticMeshShape(dataArray);
+                }
             }
         }
         break;
@@ -472,13 +564,17 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
         const int numChildShapes = compoundShape->getNumChildShapes();
         for (int i = 0; i < numChildShapes; i ++) {
             btCollisionShape* childShape = compoundShape->getChildShape(i);
-            if (childShape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE) {
+            if (childShape->getShapeType() == (int)COMPOUND_SHAPE_PROXYTYPE ||
+                    childShape->getShapeType() == (int)SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
                 // recurse
                 ShapeFactory::deleteShape(childShape);
             } else {
                 delete childShape;
             }
         }
+    } else if (nonConstShape->getShapeType() == (int)SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+        // the scaled shape doesn't own the mesh it scales
+        delete static_cast<btScaledBvhTriangleMeshShape*>(nonConstShape)->getChildShape();
     }
     delete nonConstShape;
 }
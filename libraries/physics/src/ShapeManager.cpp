@@ -11,19 +11,38 @@
 
 #include "ShapeManager.h"
 
+#include <algorithm>
+
 #include <glm/gtx/norm.hpp>
-#include <QThreadPool>
+#include <QThread>
 
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 const int MAX_RING_SIZE = 256;
+const int MAX_SHAPE_WORKER_THREADS = 2;
 
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
+    // a few dedicated threads so the mesh shapes don't wait behind the other users of the global pool
+    _workerPool.setMaxThreadCount(std::max(1, std::min(MAX_SHAPE_WORKER_THREADS, QThread::idealThreadCount() / 2)));
 }
 
 ShapeManager::~ShapeManager() {
+    // the workers that have not run yet are dropped and the others are done, but their results will never be accepted
+    for (auto& pending : _pendingMeshShapes) {
+        _workerPool.tryTake(pending.worker);
+    }
+    _workerPool.waitForDone();
+    for (auto& pending : _pendingMeshShapes) {
+        if (pending.worker->shape) {
+            ShapeFactory::deleteShape(pending.worker->shape);
+        }
+        delete pending.worker;
+    }
+    _pendingMeshShapes.clear();
+
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
@@ -36,7 +55,7 @@ ShapeManager::~ShapeManager() {
     }
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, int32_t buildPriority) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,17 +66,18 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (info.getType() == SHAPE_TYPE_STATIC_MESH && !info.hasBakedMesh()) {
+        // building the bvh of a mesh takes a while, so it is done on another thread, unless it was baked with the model
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
+        auto itr = std::find_if(_pendingMeshShapes.begin(), _pendingMeshShapes.end(),
+                                [&](const PendingShape& pending) { return pending.key == hash; });
         if (itr == _pendingMeshShapes.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
             if (!worker) {
@@ -69,9 +89,15 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+            _pendingMeshShapes.emplace_back(hash, worker, buildPriority, usecTimestampNow());
+            _workerPool.start(worker, buildPriority);
+        } else {
+            // we're still waiting for the shape to be created on another thread, but it is wanted once more
+            ++itr->numRequests;
+            if (buildPriority > itr->priority) {
+                setShapeBuildPriority(hash, buildPriority);
+            }
         }
-        // else we're still waiting for the shape to be created on another thread
     } else {
         shape = ShapeFactory::createShapeFromInfo(info);
         if (shape) {
@@ -206,9 +232,53 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
     return false;
 }
 
+void ShapeManager::setShapeBuildPriority(uint64_t key, int32_t buildPriority) {
+    auto itr = std::find_if(_pendingMeshShapes.begin(), _pendingMeshShapes.end(),
+                            [&](const PendingShape& pending) { return pending.key == key; });
+    if (itr == _pendingMeshShapes.end() || itr->priority == buildPriority) {
+        return;
+    }
+    // the pool orders its queue on start() so the worker is queued again, unless it is already running
+    if (_workerPool.tryTake(itr->worker)) {
+        _workerPool.start(itr->worker, buildPriority);
+    }
+    itr->priority = buildPriority;
+}
+
+void ShapeManager::cancelShapeBuild(uint64_t key) {
+    auto itr = std::find_if(_pendingMeshShapes.begin(), _pendingMeshShapes.end(),
+                            [&](const PendingShape& pending) { return pending.key == key; });
+    if (itr == _pendingMeshShapes.end() || --itr->numRequests > 0) {
+        return;
+    }
+    // once running the worker can't be stopped: its shape will be an orphan
+    if (_workerPool.tryTake(itr->worker)) {
+        ShapeFactory::Worker* worker = itr->worker;
+        *itr = _pendingMeshShapes.back();
+        _pendingMeshShapes.pop_back();
+        recycleWorker(worker);
+        ++_shapeBuildCancelCount;
+    }
+}
+
+void ShapeManager::recycleWorker(ShapeFactory::Worker* worker) {
+    disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
+
+    if (_deadWorker) {
+        // delete the previous deadWorker manually
+        delete _deadWorker;
+    }
+    // save this dead worker for later
+    worker->shapeInfo.clear();
+    worker->shape = nullptr;
+    _deadWorker = worker;
+}
+
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
+    uint64_t hash = worker->shapeInfo.getHash();
+    auto itr = std::find_if(_pendingMeshShapes.begin(), _pendingMeshShapes.end(),
+                            [&](const PendingShape& pending) { return pending.key == hash; });
     if (itr == _pendingMeshShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
@@ -216,6 +286,12 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
             ShapeFactory::deleteShape(worker->shape);
         }
     } else {
+        // the latency from the request to the delivery, averaged over the last few builds
+        const uint64_t LATENCY_AVERAGING_WEIGHT = 8;
+        uint64_t latency = usecTimestampNow() - itr->requestTime;
+        _averageShapeBuildLatency = _averageShapeBuildLatency == 0 ? latency :
+            ((LATENCY_AVERAGING_WEIGHT - 1) * _averageShapeBuildLatency + latency) / LATENCY_AVERAGING_WEIGHT;
+
         // clear pending status
         *itr = _pendingMeshShapes.back();
         _pendingMeshShapes.pop_back();
@@ -268,15 +344,6 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
             _orphans.push_back(KeyExpiry(newRef.key, newExpiry));
         }
     }
-    disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-
-    if (_deadWorker) {
-        // delete the previous deadWorker manually
-        delete _deadWorker;
-    }
-    // save this dead worker for later
-    worker->shapeInfo.clear();
-    worker->shape = nullptr;
-    _deadWorker = worker;
+    recycleWorker(worker);
     ++_workDeliveryCount;
 }
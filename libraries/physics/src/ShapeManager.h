@@ -17,6 +17,7 @@
 #include <vector>
 
 #include <QObject>
+#include <QtCore/QThreadPool>
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
@@ -46,6 +47,10 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// The static mesh shapes that were not baked with their model take a while to build so they are built on the
+// ShapeManager's own worker threads: the requests with the higher build priority go first, the priority of a
+// request can change while it waits for a worker, and a request nobody wants anymore is dropped before it starts.
 
 
 class ShapeManager : public QObject {
@@ -55,8 +60,8 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
-    const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \return pointer to shape, or nullptr while the shape is being built on a worker thread
+    const btCollisionShape* getShape(const ShapeInfo& info, int32_t buildPriority = 0);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -74,12 +79,23 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
+    /// changes the priority of a shape build that is still waiting for a worker
+    void setShapeBuildPriority(uint64_t key, int32_t buildPriority);
+    /// drops one request for a shape build, the build is canceled once no request is left and if it hasn't started
+    void cancelShapeBuild(uint64_t key);
+
+    // shape build stats
+    int32_t getNumPendingShapeBuilds() const { return (int32_t)_pendingMeshShapes.size(); }
+    uint64_t getAverageShapeBuildLatency() const { return _averageShapeBuildLatency; } // usecs
+    uint32_t getShapeBuildCancelCount() const { return _shapeBuildCancelCount; }
+
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
 private:
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
+    void recycleWorker(ShapeFactory::Worker* worker);
 
     class ShapeReference {
     public:
@@ -89,6 +105,16 @@ private:
         ShapeReference() : refCount(0), shape(nullptr) {}
     };
 
+    class PendingShape {
+    public:
+        PendingShape(uint64_t k, ShapeFactory::Worker* w, int32_t p, uint64_t t) : key(k), worker(w), priority(p), requestTime(t) {}
+        uint64_t key;
+        ShapeFactory::Worker* worker;
+        int32_t priority;
+        uint64_t requestTime; // usecs
+        int32_t numRequests { 1 };
+    };
+
     using TimePoint = std::chrono::time_point<std::chrono::steady_clock>;
     class KeyExpiry {
     public:
@@ -100,13 +126,16 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<PendingShape> _pendingMeshShapes;
     std::vector<KeyExpiry> _orphans;
     ShapeFactory::Worker* _deadWorker { nullptr };
+    QThreadPool _workerPool;
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+    uint64_t _averageShapeBuildLatency { 0 };
+    uint32_t _shapeBuildCancelCount { 0 };
 };
 
 #endif // hifi_ShapeManager_h
@@ -21,6 +21,16 @@
 
 #include "Profile.h"
 
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
+        btDispatcher* dispatcher,
+        btBroadphaseInterface* pairCache,
+        btConstraintSolverPoolMt* constraintSolverPool,
+        btConstraintSolver* constraintSolverMt,
+        btCollisionConfiguration* collisionConfiguration)
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, constraintSolverPool, constraintSolverMt, collisionConfiguration) {
+}
+#else
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
@@ -28,6 +38,7 @@ ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btCollisionConfiguration* collisionConfiguration)
     :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
 }
+#endif
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
                                                                btScalar fixedTimeStep, SubStepCallback onSubStep) {
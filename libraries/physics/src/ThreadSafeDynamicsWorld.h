@@ -20,6 +20,9 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#endif
 
 #include "ObjectMotionState.h"
 
@@ -27,15 +30,32 @@
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// The multithreaded world solves the islands and runs the narrowphase in parallel on the btITaskScheduler,
+// the motion states are still synchronized on the calling thread.
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+using ThreadSafeDynamicsWorldBase = btDiscreteDynamicsWorldMt;
+#else
+using ThreadSafeDynamicsWorldBase = btDiscreteDynamicsWorld;
+#endif
+
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public ThreadSafeDynamicsWorldBase {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+    ThreadSafeDynamicsWorld(
+            btDispatcher* dispatcher,
+            btBroadphaseInterface* pairCache,
+            btConstraintSolverPoolMt* constraintSolverPool,
+            btConstraintSolver* constraintSolverMt,
+            btCollisionConfiguration* collisionConfiguration);
+#else
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
             btConstraintSolver* constraintSolver,
             btCollisionConfiguration* collisionConfiguration);
+#endif
 
     int getNumSubsteps() const { return _numSubsteps; }
     int stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps = 1,
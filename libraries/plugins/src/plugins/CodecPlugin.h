@@ -16,6 +16,9 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // whether a frame from encode() carries no audio, when the codec leaves out silence, so that it need not be sent
+    virtual bool isSilentFrame(const QByteArray& encodedBuffer) const { return false; }
 };
 
 class Decoder {
@@ -24,6 +27,10 @@ public:
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
 
     virtual void lostFrame(QByteArray& decodedBuffer) = 0;
+
+    // the frame lost just before nextEncodedBuffer, from what the codec carries of it in the next frame if anything,
+    // else as lostFrame(); nextEncodedBuffer is still to be decoded after
+    virtual void recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) { lostFrame(decodedBuffer); }
 };
 
 class CodecPlugin : public Plugin {
@@ -15,6 +15,7 @@
 
 namespace controller {
     struct InputCalibrationData;
+    struct LatchedPoses;
 }
 
 class InputPlugin : public Plugin {
@@ -22,6 +23,11 @@ public:
     virtual void pluginFocusOutEvent() = 0;
     virtual void pluginUpdate(float deltaTime, const controller::InputCalibrationData& inputCalibrationData) = 0;
 
+    // Called on the input thread, many times a frame, to read the latest raw poses of the devices the plugin tracks in
+    // sensor space; false if the plugin has none. It runs alongside pluginUpdate, so it must only make thread-safe
+    // calls to the device and not touch the state pluginUpdate keeps.
+    virtual bool sampleLatchedPoses(controller::LatchedPoses& poses) { return false; }
+
     // Some input plugins are comprised of multiple subdevices (SDL2, for instance).
     // If an input plugin is only a single device, it will only return it's primary name.
     virtual QStringList getSubdeviceNames() { return { getName() }; };
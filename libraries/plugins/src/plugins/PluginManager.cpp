@@ -13,6 +13,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QDebug>
 #include <QtCore/QPluginLoader>
+#include <QtConcurrent/QtConcurrentMap>
 #include <shared/QtHelpers.h>
 
 //#define HIFI_PLUGINMANAGER_DEBUG
@@ -21,6 +22,7 @@
 #endif
 
 #include <DependencyManager.h>
+#include <Profile.h>
 #include <UserActivityLogger.h>
 #include <QThreadPool>
 
@@ -122,10 +124,25 @@ int PluginManager::instantiate() {
                 }
             }
 
+            // reading the metadata of a plugin opens and scans its file, so the candidates are read concurrently; they are
+            // still loaded one after the other on this thread, in order, since loading runs their static initializers
+            QList<QSharedPointer<QPluginLoader>> loaders;
             for (auto plugin : candidates) {
+                loaders.push_back(QSharedPointer<QPluginLoader>::create(pluginPath + plugin));
+            }
+            QList<QJsonObject> metaData;
+            {
+                PROFILE_RANGE(startup, "readPluginMetaData");
+                metaData = QtConcurrent::blockingMapped<QList<QJsonObject>>(loaders,
+                    [](const QSharedPointer<QPluginLoader>& loader) { return loader->metaData(); });
+            }
+
+            PROFILE_RANGE(startup, "loadPlugins");
+            for (int i = 0; i < candidates.size(); ++i) {
+                const auto& plugin = candidates[i];
+                const auto& loader = loaders[i];
                 qCDebug(plugins) << "Attempting plugin" << qPrintable(plugin);
-                auto loader = QSharedPointer<QPluginLoader>::create(pluginPath + plugin);
-                const QJsonObject pluginMetaData = loader->metaData();
+                const QJsonObject& pluginMetaData = metaData[i];
 #if defined(HIFI_PLUGINMANAGER_DEBUG)
                 QJsonDocument metaDataDoc(pluginMetaData);
                 qCInfo(plugins) << "Metadata for " << qPrintable(plugin) << ": " << QString(metaDataDoc.toJson());
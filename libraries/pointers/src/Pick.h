@@ -228,6 +228,13 @@ public:
     virtual PickResultPointer getAvatarIntersection(const T& pick) = 0;
     virtual PickResultPointer getHUDIntersection(const T& pick) = 0;
 
+    // Intersects the entities with the mathematical picks of several picks of this type at once, filling results in the same
+    // order.  Returns false if this type doesn't batch them, in which case each pick gets its own getEntityIntersection.
+    virtual bool getEntityIntersections(const std::vector<std::shared_ptr<Pick<T>>>& picks, const std::vector<T>& mathPicks,
+                                        std::vector<PickResultPointer>& results) {
+        return false;
+    }
+
     QVariantMap toVariantMap() const override {
         QVariantMap properties = PickQuery::toVariantMap();
 
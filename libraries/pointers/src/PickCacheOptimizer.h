@@ -9,6 +9,7 @@
 #define hifi_PickCacheOptimizer_h
 
 #include <unordered_map>
+#include <vector>
 
 #include "Pick.h"
 
@@ -45,6 +46,9 @@ protected:
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
+    // Intersects the entities with all the enabled picks in one query when the pick type supports it, and caches the results
+    // so the update finds them.  Returns the number of intersections computed.
+    int batchEntityIntersections(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, PickCache& cache);
 };
 
 template<typename T>
@@ -66,11 +70,53 @@ void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const P
     }
 }
 
+template<typename T>
+int PickCacheOptimizer<T>::batchEntityIntersections(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, PickCache& cache) {
+    std::vector<std::shared_ptr<Pick<T>>> batchPicks;
+    std::vector<T> mathPicks;
+    std::vector<PickCacheKey> keys;
+    std::unordered_map<T, std::unordered_map<PickCacheKey, bool>> batched;
+    for (auto& entry : picks) {
+        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(entry.second);
+        if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f ||
+            !(pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities())) {
+            continue;
+        }
+        T mathematicalPick = pick->getMathematicalPick();
+        if (!mathematicalPick) {
+            continue;
+        }
+        PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        bool& isBatched = batched[mathematicalPick][entityKey];
+        if (!isBatched) {
+            isBatched = true;
+            batchPicks.push_back(pick);
+            mathPicks.push_back(mathematicalPick);
+            keys.push_back(entityKey);
+        }
+    }
+
+    // a single pick gains nothing from the batch
+    const size_t MIN_BATCH_SIZE = 2;
+    std::vector<PickResultPointer> entityResults;
+    if (batchPicks.size() < MIN_BATCH_SIZE || !batchPicks[0]->getEntityIntersections(batchPicks, mathPicks, entityResults)) {
+        return 0;
+    }
+    for (size_t i = 0; i < entityResults.size(); i++) {
+        if (entityResults[i]) {
+            cache[mathPicks[i]][keys[i]] = entityResults[i]->doesIntersect() ?
+                entityResults[i] : batchPicks[i]->getDefaultResult(mathPicks[i].toVariantMap());
+        }
+    }
+    return (int)entityResults.size();
+}
+
 template<typename T>
 QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
         uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
     QVector3D numIntersectionsComputed;
     PickCache results;
+    numIntersectionsComputed[0] += batchEntityIntersections(picks, results);
     const uint32_t INVALID_PICK_ID = 0;
     auto itr = picks.begin();
     if (nextToUpdate != INVALID_PICK_ID) {
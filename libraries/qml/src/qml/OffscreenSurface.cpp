@@ -293,6 +293,10 @@ void OffscreenSurface::setMaxFps(uint8_t maxFps) {
     _sharedObject->setMaxFps(maxFps);
 }
 
+void OffscreenSurface::setRenderPriority(float priority) {
+    _sharedObject->setRenderPriority(priority);
+}
+
 void OffscreenSurface::load(const QUrl& qmlSource, QQuickItem* parent, const QJSValue& callback) {
     loadFromQml(qmlSource, parent, callback);
 }
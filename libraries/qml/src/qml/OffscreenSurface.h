@@ -64,6 +64,10 @@ public:
     void clearCache();
 
     void setMaxFps(uint8_t maxFps);
+    // Thread-safe. From 1 for a surface the user is looking at, the default, down to 0 for a far or peripheral one.
+    // Scales the framerate of the surface down, and below 1 the surface is skipped while the render budget that all
+    // the surfaces share is spent
+    void setRenderPriority(float priority);
     // Optional values for event handling
     void setProxyWindow(QWindow* window);
     void setMouseTranslator(const MouseTranslator& mouseTranslator) { _mouseTranslator = mouseTranslator; }
@@ -37,6 +37,18 @@
 // This has the effect of capping the framerate at 200
 static const int MIN_TIMER_MS = 5;
 
+// Rendering a surface blocks the main thread while its scene graph is polished and synced. All the surfaces together
+// get this much main thread time in each interval, past which only the surfaces with the full priority render until
+// the next interval.
+static const uint64_t RENDER_BUDGET_INTERVAL_USECS = USECS_PER_SECOND / 60;
+static const uint64_t RENDER_BUDGET_USECS = 4 * USECS_PER_MSEC;
+// A surface with no priority still renders at this framerate, so that it does not freeze
+static const float MIN_PRIORITY_FPS = 2.0f;
+
+// Only touched from the main thread, where the render timers of all the surfaces fire
+static uint64_t renderBudgetIntervalStart { 0 };
+static uint64_t renderBudgetSpent { 0 };
+
 using namespace hifi::qml;
 using namespace hifi::qml::impl;
 
@@ -348,6 +360,11 @@ void SharedObject::setMaxFps(uint8_t maxFps) {
     _maxFps = maxFps;
 }
 
+void SharedObject::setRenderPriority(float priority) {
+    QMutexLocker locker(&_mutex);
+    _renderPriority = std::min(std::max(priority, 0.0f), 1.0f);
+}
+
 bool SharedObject::preRender(bool sceneGraphSync) {
 #ifndef DISABLE_QML
     QMutexLocker lock(&_mutex);
@@ -465,6 +482,8 @@ void SharedObject::onRender() {
         return;
     }
 
+    auto start = usecTimestampNow();
+
     if (_syncRequested) {
         _renderControl->polishItems();
         QMutexLocker lock(&_mutex);
@@ -476,6 +495,7 @@ void SharedObject::onRender() {
         QCoreApplication::postEvent(_renderObject, new OffscreenEvent(OffscreenEvent::Render));
     }
     _renderRequested = false;
+    renderBudgetSpent += usecTimestampNow() - start;
 #endif
 }
 
@@ -495,12 +515,22 @@ void SharedObject::onTimer() {
         if (!_maxFps) {
             return;
         }
-        auto minRenderInterval = USECS_PER_SECOND / _maxFps;
-        auto lastInterval = usecTimestampNow() - _lastRenderTime;
+        auto now = usecTimestampNow();
+        float fps = std::max(MIN_PRIORITY_FPS, _renderPriority * (float)_maxFps);
+        auto minRenderInterval = (uint64_t)((float)USECS_PER_SECOND / fps);
+        auto lastInterval = now - _lastRenderTime;
         // Don't exceed the framerate limit
         if (lastInterval < minRenderInterval) {
             return;
         }
+
+        if (now - renderBudgetIntervalStart > RENDER_BUDGET_INTERVAL_USECS) {
+            renderBudgetIntervalStart = now;
+            renderBudgetSpent = 0;
+        }
+        if (_renderPriority < 1.0f && renderBudgetSpent > RENDER_BUDGET_USECS) {
+            return;
+        }
     }
 
 #ifndef DISABLE_QML
@@ -53,6 +53,7 @@ public:
     QSize getSize() const;
     void setSize(const QSize& size);
     void setMaxFps(uint8_t maxFps);
+    void setRenderPriority(float priority);
 
     QQuickWindow* getWindow() { return _quickWindow; }
     QQuickItem* getRootItem() { return _rootItem; }
@@ -110,6 +111,7 @@ private:
     uint64_t _lastRenderTime { 0 };
     QSize _size { 100, 100 };
     uint8_t _maxFps { 60 };
+    float _renderPriority { 1.0f };
 
     bool _renderRequested { false };
     bool _syncRequested { false };
@@ -14,10 +14,13 @@
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
 
+#include <algorithm>
+
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 #include <QtCore/QBuffer>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 
 using namespace recording;
 
@@ -55,12 +58,15 @@ float Clip::position() const {
 }
 
 // FIXME move to frame?
-bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
+// Appends the frame to the index, if there is one
+bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true, PointerFrameHeaderList* index = nullptr) {
     if (frame.type == Frame::TYPE_INVALID) {
         qWarning() << "Attempting to write invalid frame";
         return true;
     }
 
+    auto frameOffset = output.pos();
+
     auto written = output.write((char*)&(frame.type), sizeof(FrameType));
     if (written != sizeof(FrameType)) {
         return false;
@@ -87,11 +93,104 @@ bool writeFrame(QIODevice& output, const Frame& frame, bool compressed = true) {
             return false;
         }
     }
+
+    if (index) {
+        PointerFrameHeader header;
+        header.type = frame.type;
+        header.timeOffset = frame.timeOffset;
+        header.size = dataSize;
+        header.fileOffset = frameOffset + PointerClip::MINIMUM_FRAME_SIZE;
+        index->push_back(header);
+    }
     return true;
 }
 
+// The offsets in the index are those in the output, start is the offset of the clip in it
+// Encodes the data of the frames of a clip of FRAME_ENCODING_DELTAS, given in order
+class FrameDataEncoder {
+public:
+    QByteArray encode(const Frame& frame);
+
+private:
+    struct TypeState {
+        bool hasCodec { false };
+        FrameCodec::Pointer codec;
+        QByteArray lastData; // the data of the frame before, when the next can be a delta from it
+        int framesSinceKeyframe { 0 };
+    };
+    QHash<FrameType, TypeState> _types;
+};
+
+QByteArray FrameDataEncoder::encode(const Frame& frame) {
+    auto& state = _types[frame.type];
+    if (!state.hasCodec) {
+        state.codec = Frame::createFrameCodec(frame.type);
+        state.hasCodec = true;
+    }
+
+    if (state.codec) {
+        QByteArray encoded = state.codec->encode(frame.data);
+        if (!encoded.isEmpty()) {
+            // the next frame can't be a delta from the data the codec gives back
+            state.lastData.clear();
+            return encoded.prepend((char)Clip::CodecFrameData);
+        }
+    }
+
+    QByteArray result = qCompress(frame.data).prepend((char)Clip::KeyFrameData);
+    bool isKeyframe = true;
+    if (!frame.data.isEmpty() && frame.data.size() == state.lastData.size() &&
+            state.framesSinceKeyframe < Clip::MAX_FRAMES_BETWEEN_KEYFRAMES) {
+        QByteArray delta = frame.data;
+        auto deltaData = delta.data();
+        auto lastData = state.lastData.constData();
+        for (int i = 0; i < delta.size(); ++i) {
+            deltaData[i] ^= lastData[i];
+        }
+        delta = qCompress(delta).prepend((char)Clip::DeltaFrameData);
+        if (delta.size() < result.size()) {
+            result = delta;
+            isKeyframe = false;
+        }
+    }
+
+    state.framesSinceKeyframe = isKeyframe ? 0 : state.framesSinceKeyframe + 1;
+    state.lastData = frame.data;
+    return result;
+}
+
+bool writeFrameIndex(QIODevice& output, const PointerFrameHeaderList& index, qint64 start) {
+    quint64 indexOffset = output.pos() - start;
+    for (size_t first = 0; first < index.size(); first += PointerClip::MAX_FRAME_INDEX_ENTRIES_PER_FRAME) {
+        auto last = std::min(index.size(), first + PointerClip::MAX_FRAME_INDEX_ENTRIES_PER_FRAME);
+        QByteArray entries;
+        entries.reserve((int)(last - first) * PointerClip::FRAME_INDEX_ENTRY_SIZE);
+        for (size_t i = first; i < last; ++i) {
+            const auto& header = index[i];
+            entries.append((const char*)&(header.type), sizeof(FrameType));
+            entries.append((const char*)&(header.timeOffset), sizeof(Frame::Time));
+            entries.append((const char*)&(header.size), sizeof(FrameSize));
+            quint64 fileOffset = header.fileOffset - start;
+            entries.append((const char*)&fileOffset, sizeof(quint64));
+        }
+        if (!writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, entries }), false)) {
+            return false;
+        }
+    }
+
+    uint32_t entryCount = (uint32_t)index.size();
+    uint32_t magic = PointerClip::FRAME_INDEX_MAGIC;
+    QByteArray trailer;
+    trailer.append((const char*)&indexOffset, sizeof(quint64));
+    trailer.append((const char*)&entryCount, sizeof(uint32_t));
+    trailer.append((const char*)&magic, sizeof(uint32_t));
+    return writeFrame(output, Frame({ Frame::TYPE_INDEX, 0, trailer }), false);
+}
+
 const QString Clip::FRAME_TYPE_MAP = QStringLiteral("frameTypes");
 const QString Clip::FRAME_COMREPSSION_FLAG = QStringLiteral("compressed");
+const QString Clip::FRAME_ENCODING = QStringLiteral("frameEncoding");
+const QString Clip::FRAME_CODEC_MAP = QStringLiteral("frameCodecs");
 
 bool Clip::write(QIODevice& output) {
     auto frameTypes = Frame::getFrameTypes();
@@ -100,22 +199,46 @@ bool Clip::write(QIODevice& output) {
         frameTypeObj[frameTypeName] = frameTypes[frameTypeName];
     }
 
+    auto frameTypeNames = Frame::getFrameTypeNames();
+    auto frameCodecs = Frame::getFrameCodecNames();
+    QJsonObject frameCodecObj;
+    for (auto itr = frameCodecs.begin(); itr != frameCodecs.end(); ++itr) {
+        frameCodecObj[frameTypeNames[itr.key()]] = itr.value();
+    }
+
     QJsonObject rootObject;
     rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
     // Always mark new files as compressed
     rootObject.insert(FRAME_COMREPSSION_FLAG, true);
+    rootObject.insert(FRAME_ENCODING, FRAME_ENCODING_DELTAS);
+    rootObject.insert(FRAME_CODEC_MAP, frameCodecObj);
     QByteArray headerFrameData = QJsonDocument(rootObject).toBinaryData();
+
+    // Index the frames if we can tell where they are, so that readers don't need to scan for them
+    PointerFrameHeaderList index;
+    auto indexPointer = output.isSequential() ? nullptr : &index;
+    auto start = output.pos();
+
     // Never compress the header frame
-    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false)) {
+    if (!writeFrame(output, Frame({ Frame::TYPE_HEADER, 0, headerFrameData }), false, indexPointer)) {
         return false;
     }
 
     seek(0);
 
+    FrameDataEncoder encoder;
     for (auto frame = nextFrame(); frame; frame = nextFrame()) {
-        if (!writeFrame(output, *frame)) {
+        Frame encodedFrame;
+        encodedFrame.type = frame->type;
+        encodedFrame.timeOffset = frame->timeOffset;
+        encodedFrame.data = encoder.encode(*frame);
+        if (!writeFrame(output, encodedFrame, false, indexPointer)) {
             return false;
         }
     }
+
+    if (indexPointer) {
+        return writeFrameIndex(output, index, start);
+    }
     return true;
 }
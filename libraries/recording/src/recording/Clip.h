@@ -56,6 +56,19 @@ public:
     
     static const QString FRAME_TYPE_MAP;
     static const QString FRAME_COMREPSSION_FLAG;
+    static const QString FRAME_ENCODING;
+    static const QString FRAME_CODEC_MAP;
+
+    // Clips of FRAME_ENCODING_DELTAS start the data of each frame with a FrameDataEncoding.  Frames are mostly stored
+    // as the changes from the frame of their type before, with a whole frame at least every MAX_FRAMES_BETWEEN_KEYFRAMES
+    // so that a seek never has to go far back, or with the codec of their type if there is one.
+    static const int FRAME_ENCODING_DELTAS = 1;
+    static const int MAX_FRAMES_BETWEEN_KEYFRAMES = 100;
+    enum FrameDataEncoding : uint8_t {
+        KeyFrameData = 0, // the compressed frame
+        DeltaFrameData, // the compressed XOR of the frame with the frame of its type before, which has the same size
+        CodecFrameData // the frame encoded by the FrameCodec of its type
+    };
 
 protected:
     friend class WrapperClip;
@@ -71,6 +71,7 @@ private:
 
 static Registry<FrameType, QString> frameTypes;
 static QMap<FrameType, Frame::Handler> handlerMap;
+static QMap<FrameType, QPair<QString, Frame::CodecFactory>> codecMap;
 using Mutex = std::mutex;
 using Locker = std::unique_lock<Mutex>;
 static Mutex mutex;
@@ -162,3 +163,36 @@ void Frame::handleFrame(const Frame::ConstPointer& frame) {
     }
     handler(frame);
 }
+
+void Frame::registerFrameCodec(const QString& frameTypeName, const QString& codecName, CodecFactory factory) {
+    auto frameType = registerFrameType(frameTypeName);
+    Locker lock(mutex);
+    codecMap[frameType] = { codecName, factory };
+}
+
+QString Frame::getFrameCodecName(FrameType type) {
+    Locker lock(mutex);
+    return codecMap.value(type).first;
+}
+
+FrameCodec::Pointer Frame::createFrameCodec(FrameType type) {
+    CodecFactory factory;
+    {
+        Locker lock(mutex);
+        auto iterator = codecMap.find(type);
+        if (iterator == codecMap.end()) {
+            return FrameCodec::Pointer();
+        }
+        factory = iterator->second;
+    }
+    return factory();
+}
+
+QMap<FrameType, QString> Frame::getFrameCodecNames() {
+    Locker lock(mutex);
+    QMap<FrameType, QString> result;
+    for (auto itr = codecMap.begin(); itr != codecMap.end(); ++itr) {
+        result[itr.key()] = itr->first;
+    }
+    return result;
+}
@@ -36,6 +36,8 @@ struct FrameHeader {
 
     static const FrameType TYPE_INVALID = 0xFFFF;
     static const FrameType TYPE_HEADER = 0x0;
+    // the frame index at the end of a clip file, never handed out by a clip
+    static const FrameType TYPE_INDEX = 0xFFF0;
 
     static Time secondsToFrameTime(float seconds);
     static float frameTimeToSeconds(Time frameTime);
@@ -53,11 +55,27 @@ struct FrameHeader {
         : type(type), timeOffset(timeOffset) { }
 };
 
+// Stores the data of the frames of one type in clips in a form of its own, such as audio with an audio codec.
+// A codec can keep state from one frame to the next: a clip has a codec per type, and gives it the frames of the type
+// in order, calling reset first when it skips some.
+class FrameCodec {
+public:
+    using Pointer = std::shared_ptr<FrameCodec>;
+
+    virtual ~FrameCodec() {}
+
+    // an empty result stores the frame without the codec
+    virtual QByteArray encode(const QByteArray& data) = 0;
+    virtual QByteArray decode(const QByteArray& encoded) = 0;
+    virtual void reset() {}
+};
+
 struct Frame : public FrameHeader {
 public:
     using Pointer = std::shared_ptr<Frame>;
     using ConstPointer = std::shared_ptr<const Frame>;
     using Handler = std::function<void(Frame::ConstPointer frame)>;
+    using CodecFactory = std::function<FrameCodec::Pointer()>;
 
     QByteArray data;
 
@@ -73,6 +91,13 @@ public:
     static QMap<QString, FrameType> getFrameTypes();
     static QMap<FrameType, QString> getFrameTypeNames();
     static void handleFrame(const ConstPointer& frame);
+
+    // clips store the frames of the type with the codec from now on, and can read the frames stored with one of the
+    // same name
+    static void registerFrameCodec(const QString& frameTypeName, const QString& codecName, CodecFactory factory);
+    static QString getFrameCodecName(FrameType type);
+    static FrameCodec::Pointer createFrameCodec(FrameType type);
+    static QMap<FrameType, QString> getFrameCodecNames();
 };
 
 }
@@ -9,8 +9,13 @@
 #include "FileClip.h"
 
 #include <algorithm>
+#include <mutex>
 
 #include <QtCore/QDebug>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 
 #include <Finally.h>
 
@@ -21,21 +26,115 @@
 
 using namespace recording;
 
-FileClip::FileClip(const QString& fileName) : _file(fileName) {
-    auto size = _file.size();
+// The mapping of a file, and the frames found in it, shared by the clips of the file
+class FileClip::Mapping {
+public:
+    using Pointer = std::shared_ptr<Mapping>;
+
+    // the mapping of the file as it is now, shared with the clips that have it open
+    static Pointer get(const QString& fileName);
+
+    ~Mapping();
+
+    uchar* data { nullptr };
+    size_t size { 0 };
+
+    // set by the first clip of the file, guarded by mutex
+    std::mutex mutex;
+    bool isParsed { false };
+    std::vector<PointerFrameHeader> frames;
+    QJsonDocument header;
+    bool compressed { true };
+    int encoding { 0 };
+    std::vector<uint32_t> previousOfType;
+
+private:
+    QFile _file;
+};
+
+FileClip::Mapping::Pointer FileClip::Mapping::get(const QString& fileName) {
+    static std::mutex mappingsMutex;
+    static QHash<QString, std::weak_ptr<Mapping>> mappings;
+
+    // a file that was written again since it was mapped gets a new mapping
+    QFileInfo fileInfo(fileName);
+    QString key = fileInfo.canonicalFilePath() + "|" + QString::number(fileInfo.size()) + "|" +
+        QString::number(fileInfo.lastModified().toMSecsSinceEpoch());
+
+    std::lock_guard<std::mutex> lock(mappingsMutex);
+    auto mapping = mappings.value(key).lock();
+    if (mapping) {
+        return mapping;
+    }
+
+    // forget the files that are no longer open
+    for (auto itr = mappings.begin(); itr != mappings.end();) {
+        if (itr.value().expired()) {
+            itr = mappings.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    mapping = std::make_shared<Mapping>();
+    mapping->_file.setFileName(fileName);
+    auto size = mapping->_file.size();
     qDebug(recordingLog) << "Opening file of size: " << size;
-    bool opened = _file.open(QIODevice::ReadOnly);
-    if (!opened) {
+    if (!mapping->_file.open(QIODevice::ReadOnly)) {
         qCWarning(recordingLog) << "Unable to open file " << fileName;
+        return Pointer();
+    }
+
+    // clips only read from the mapping, so its pages can be shared with other processes that have the file open
+    mapping->data = mapping->_file.map(0, size);
+    if (!mapping->data) {
+        qCWarning(recordingLog) << "Unable to map file " << fileName;
+        return Pointer();
+    }
+    mapping->size = size;
+    mappings.insert(key, mapping);
+    return mapping;
+}
+
+FileClip::Mapping::~Mapping() {
+    if (data) {
+        _file.unmap(data);
+    }
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
+
+FileClip::FileClip(const QString& fileName) : _fileName(fileName) {
+    auto mapping = Mapping::get(fileName);
+    if (!mapping) {
         return;
     }
-    auto mappedFile = _file.map(0, size, QFile::MapPrivateOption);
-    init(mappedFile, size);
+
+    std::lock_guard<std::mutex> lock(mapping->mutex);
+    if (mapping->isParsed) {
+        _data = mapping->data;
+        _size = mapping->size;
+        _frames = mapping->frames;
+        _header = mapping->header;
+        _compressed = mapping->compressed;
+        _encoding = mapping->encoding;
+        _previousOfType = mapping->previousOfType;
+    } else {
+        init(mapping->data, mapping->size);
+        mapping->frames = _frames;
+        mapping->header = _header;
+        mapping->compressed = _compressed;
+        mapping->encoding = _encoding;
+        mapping->previousOfType = _previousOfType;
+        mapping->isParsed = true;
+    }
+    _storage = mapping;
 }
 
 
 QString FileClip::getName() const {
-    return _file.fileName();
+    return _fileName;
 }
 
 
@@ -59,9 +158,5 @@ bool FileClip::write(const QString& fileName, Clip::Pointer clip) {
 
 FileClip::~FileClip() {
     Locker lock(_mutex);
-    _file.unmap(_data);
-    if (_file.isOpen()) {
-        _file.close();
-    }
     reset();
 }
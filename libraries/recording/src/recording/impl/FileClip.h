@@ -12,10 +12,12 @@
 
 #include "PointerClip.h"
 
-#include <QtCore/QFile>
+#include <QtCore/QString>
 
 namespace recording {
 
+// A clip read from a file mapped into memory.  The clips of the same file share its mapping and the frames it was
+// parsed into, so that many clips replaying one recording cost about as much as one.
 class FileClip : public PointerClip {
 public:
     using Pointer = std::shared_ptr<FileClip>;
@@ -28,7 +30,9 @@ public:
     static bool write(const QString& filePath, Clip::Pointer clip);
 
 private:
-    QFile _file;
+    class Mapping;
+
+    QString _fileName;
 };
 
 }
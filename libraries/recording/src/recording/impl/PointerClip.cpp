@@ -25,6 +25,11 @@ using namespace recording;
 
 using FrameTranslationMap = QMap<FrameType, FrameType>;
 
+// A frame whose data refers to the storage of its clip.  A handler that keeps the data past the frame must copy it.
+struct StoredFrame : public Frame {
+    std::shared_ptr<const void> storage;
+};
+
 FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
     FrameTranslationMap results;
     auto headerObj = doc.object();
@@ -74,11 +79,90 @@ PointerFrameHeaderList parseFrameHeaders(uchar* const start, const size_t& size)
     return results;
 }
 
+// Reads the frame headers from the frame index at the end of the data, if there is a valid one
+bool readFrameIndex(uchar* const start, const size_t& size, PointerFrameHeaderList& results) {
+    static const size_t TRAILER_FRAME_SIZE = PointerClip::MINIMUM_FRAME_SIZE + PointerClip::FRAME_INDEX_TRAILER_SIZE;
+    if (size < TRAILER_FRAME_SIZE) {
+        return false;
+    }
+
+    auto end = start + size;
+    auto trailer = end - PointerClip::FRAME_INDEX_TRAILER_SIZE;
+    uint32_t magic;
+    memcpy(&magic, end - sizeof(uint32_t), sizeof(uint32_t));
+    if (magic != PointerClip::FRAME_INDEX_MAGIC) {
+        return false;
+    }
+
+    FrameType trailerType;
+    FrameSize trailerSize;
+    memcpy(&trailerType, end - TRAILER_FRAME_SIZE, sizeof(FrameType));
+    memcpy(&trailerSize, trailer - sizeof(FrameSize), sizeof(FrameSize));
+    if (trailerType != Frame::TYPE_INDEX || trailerSize != PointerClip::FRAME_INDEX_TRAILER_SIZE) {
+        return false;
+    }
+
+    quint64 indexOffset;
+    uint32_t entryCount;
+    memcpy(&indexOffset, trailer, sizeof(quint64));
+    memcpy(&entryCount, trailer + sizeof(quint64), sizeof(uint32_t));
+    auto indexEnd = end - TRAILER_FRAME_SIZE;
+    if (indexOffset > (quint64)(indexEnd - start)) {
+        return false;
+    }
+
+    PointerFrameHeaderList parsed;
+    parsed.reserve(entryCount);
+    auto current = start + indexOffset;
+    while (current < indexEnd) {
+        if (indexEnd - current < PointerClip::MINIMUM_FRAME_SIZE) {
+            return false;
+        }
+        FrameType type;
+        FrameSize frameSize;
+        memcpy(&type, current, sizeof(FrameType));
+        memcpy(&frameSize, current + sizeof(FrameType) + sizeof(Frame::Time), sizeof(FrameSize));
+        current += PointerClip::MINIMUM_FRAME_SIZE;
+        if (type != Frame::TYPE_INDEX || frameSize % PointerClip::FRAME_INDEX_ENTRY_SIZE != 0 || indexEnd - current < frameSize) {
+            return false;
+        }
+
+        for (auto entry = current; entry < current + frameSize; entry += PointerClip::FRAME_INDEX_ENTRY_SIZE) {
+            PointerFrameHeader header;
+            auto field = entry;
+            memcpy(&(header.type), field, sizeof(FrameType));
+            field += sizeof(FrameType);
+            memcpy(&(header.timeOffset), field, sizeof(Frame::Time));
+            field += sizeof(Frame::Time);
+            memcpy(&(header.size), field, sizeof(FrameSize));
+            field += sizeof(FrameSize);
+            memcpy(&(header.fileOffset), field, sizeof(quint64));
+            if (header.fileOffset < (quint64)PointerClip::MINIMUM_FRAME_SIZE || header.fileOffset > indexOffset ||
+                    indexOffset - header.fileOffset < header.size) {
+                return false;
+            }
+            parsed.push_back(header);
+        }
+        current += frameSize;
+    }
+
+    if (parsed.size() != entryCount) {
+        return false;
+    }
+    results.swap(parsed);
+    qDebug(recordingLog) << "Read frame index of " << results.size() << " frames";
+    return true;
+}
+
 void PointerClip::reset() {
     _frames.clear();
     _data = nullptr;
     _size = 0;
     _header = QJsonDocument();
+    _encoding = 0;
+    _previousOfType.clear();
+    _decodedTypes.clear();
+    _storage.reset();
 }
 
 void PointerClip::init(uchar* data, size_t size) {
@@ -87,7 +171,10 @@ void PointerClip::init(uchar* data, size_t size) {
     _data = data;
     _size = size;
 
-    auto parsedFrameHeaders = parseFrameHeaders(data, size);
+    PointerFrameHeaderList parsedFrameHeaders;
+    if (!readFrameIndex(data, size, parsedFrameHeaders)) {
+        parsedFrameHeaders = parseFrameHeaders(data, size);
+    }
     // Verify that at least one frame exists and that the first frame is a header
     if (0 == parsedFrameHeaders.size()) {
         qWarning() << "No frames found, invalid file";
@@ -97,8 +184,7 @@ void PointerClip::init(uchar* data, size_t size) {
 
     // Grab the file header
     {
-        auto fileHeaderFrameHeader = *parsedFrameHeaders.begin();
-        parsedFrameHeaders.pop_front();
+        auto fileHeaderFrameHeader = parsedFrameHeaders.front();
         if (fileHeaderFrameHeader.type != Frame::TYPE_HEADER) {
             qWarning() << "Missing header frame, invalid file";
             reset();
@@ -112,6 +198,7 @@ void PointerClip::init(uchar* data, size_t size) {
     // Check for compression
     {
         _compressed = _header.object()[FRAME_COMREPSSION_FLAG].toBool();
+        _encoding = _header.object()[FRAME_ENCODING].toInt();
     }
 
     // Find the type enum translation map and fix up the frame headers
@@ -123,9 +210,26 @@ void PointerClip::init(uchar* data, size_t size) {
             return;
         }
 
+        // Leave out the frames stored with a codec we don't have
+        if (_encoding == FRAME_ENCODING_DELTAS) {
+            auto frameTypeNames = Frame::getFrameTypeNames();
+            auto frameCodecObj = _header.object()[FRAME_CODEC_MAP].toObject();
+            for (auto itr = translationMap.begin(); itr != translationMap.end();) {
+                auto frameTypeName = frameTypeNames.value(itr.value());
+                auto codecName = frameCodecObj[frameTypeName].toString();
+                if (!codecName.isEmpty() && Frame::getFrameCodecName(itr.value()) != codecName) {
+                    qCWarning(recordingLog) << "Skipping frames of" << frameTypeName << "stored with unavailable codec" << codecName;
+                    itr = translationMap.erase(itr);
+                } else {
+                    ++itr;
+                }
+            }
+        }
+
         // Update the loaded headers with the frame data
-        _frames.reserve(parsedFrameHeaders.size());
-        for (auto& frameHeader : parsedFrameHeaders) {
+        _frames.reserve(parsedFrameHeaders.size() - 1);
+        for (auto itr = parsedFrameHeaders.begin() + 1; itr != parsedFrameHeaders.end(); ++itr) {
+            auto& frameHeader = *itr;
             if (!translationMap.contains(frameHeader.type)) {
                 continue;
             }
@@ -134,22 +238,120 @@ void PointerClip::init(uchar* data, size_t size) {
         }
     }
 
+    // Link the frames to the frames of their type before, that they can be the changes from
+    if (_encoding == FRAME_ENCODING_DELTAS) {
+        QHash<FrameType, uint32_t> lastOfType;
+        _previousOfType.reserve(_frames.size());
+        for (uint32_t i = 0; i < (uint32_t)_frames.size(); ++i) {
+            _previousOfType.push_back(lastOfType.value(_frames[i].type, NO_FRAME));
+            lastOfType[_frames[i].type] = i;
+        }
+    }
+}
+
+QByteArray PointerClip::decodeFrameData(size_t frameIndex) const {
+    auto& state = _decodedTypes[_frames[frameIndex].type];
+    if (state.hasData && state.lastFrame == frameIndex) {
+        return state.lastData;
+    }
+
+    // Go back to the keyframe, or the frame decoded last, that the frame is the changes from
+    std::vector<size_t> frameIndices;
+    for (size_t index = frameIndex;;) {
+        frameIndices.push_back(index);
+        const auto& header = _frames[index];
+        if (header.size == 0 || _data[header.fileOffset] != DeltaFrameData) {
+            break;
+        }
+        auto previous = _previousOfType[index];
+        if (previous == NO_FRAME || (state.hasData && state.lastFrame == previous)) {
+            break;
+        }
+        index = previous;
+    }
+
+    // Then decode forward from there
+    for (auto itr = frameIndices.rbegin(); itr != frameIndices.rend(); ++itr) {
+        auto index = *itr;
+        const auto& header = _frames[index];
+        QByteArray result;
+        if (header.size > 0) {
+            auto data = _data + header.fileOffset + 1;
+            int size = header.size - 1;
+            switch (_data[header.fileOffset]) {
+                case KeyFrameData:
+                    result = qUncompress(data, size);
+                    break;
+
+                case DeltaFrameData: {
+                    bool hasPrevious = state.hasData && state.lastFrame == _previousOfType[index];
+                    result = qUncompress(data, size);
+                    if (hasPrevious && result.size() == state.lastData.size()) {
+                        auto resultData = result.data();
+                        auto previousData = state.lastData.constData();
+                        for (int i = 0; i < result.size(); ++i) {
+                            resultData[i] ^= previousData[i];
+                        }
+                    } else {
+                        qCWarning(recordingLog) << "Invalid delta frame" << index;
+                        result.clear();
+                    }
+                    break;
+                }
+
+                case CodecFrameData:
+                    if (!state.hasCodec) {
+                        state.codec = Frame::createFrameCodec(header.type);
+                        state.hasCodec = true;
+                    }
+                    if (state.codec) {
+                        if (state.lastCodecFrame != _previousOfType[index]) {
+                            state.codec->reset();
+                        }
+                        result = state.codec->decode(QByteArray::fromRawData(reinterpret_cast<const char*>(data), size));
+                        state.lastCodecFrame = (uint32_t)index;
+                    }
+                    break;
+
+                default:
+                    qCWarning(recordingLog) << "Unknown encoding of frame" << index;
+                    break;
+            }
+        }
+        state.hasData = true;
+        state.lastFrame = index;
+        state.lastData = result;
+    }
+    return state.lastData;
 }
 
 // Internal only function, needs no locking
 FrameConstPointer PointerClip::readFrame(size_t frameIndex) const {
     FramePointer result;
     if (frameIndex < _frames.size()) {
-        result = std::make_shared<Frame>();
         const auto& header = _frames[frameIndex];
-        result->type = header.type;
-        result->timeOffset = header.timeOffset;
-        if (header.size) {
-            result->data.insert(0, reinterpret_cast<char*>(_data)+header.fileOffset, header.size);
-            if (_compressed) {
-                result->data = qUncompress(result->data);
+        auto frameData = reinterpret_cast<const char*>(_data) + header.fileOffset;
+        if (_encoding == FRAME_ENCODING_DELTAS) {
+            result = std::make_shared<Frame>();
+            result->data = decodeFrameData(frameIndex);
+        } else if (_storage && !_compressed) {
+            // refer to the data where it is, and keep it alive for as long as the frame is
+            auto frame = std::make_shared<StoredFrame>();
+            frame->storage = _storage;
+            frame->data = QByteArray::fromRawData(frameData, header.size);
+            result = frame;
+        } else {
+            result = std::make_shared<Frame>();
+            if (header.size) {
+                if (_compressed) {
+                    result->data = qUncompress(reinterpret_cast<const uchar*>(frameData), header.size);
+                } else {
+                    result->data = QByteArray(frameData, header.size);
+                }
             }
         }
+        result->type = header.type;
+        result->timeOffset = header.timeOffset;
     }
     return result;
 }
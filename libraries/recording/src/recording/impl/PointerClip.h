@@ -13,7 +13,9 @@
 #include "ArrayClip.h"
 
 #include <mutex>
+#include <vector>
 
+#include <QtCore/QHash>
 #include <QtCore/QJsonDocument>
 
 #include "../Frame.h"
@@ -27,7 +29,7 @@ struct PointerFrameHeader : public FrameHeader {
     quint64 fileOffset;
 };
 
-using PointerFrameHeaderList = std::list<PointerFrameHeader>;
+using PointerFrameHeaderList = std::vector<PointerFrameHeader>;
 
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
@@ -44,6 +46,17 @@ public:
 
     // FIXME move to frame?
     static const qint64 MINIMUM_FRAME_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize);
+
+    // The frame index at the end of a clip file lets a clip be opened without scanning all of its frames. It is stored
+    // as uncompressed Frame::TYPE_INDEX frames, which readers that don't know it drop as frames of an unknown type:
+    // entries of FRAME_INDEX_ENTRY_SIZE bytes (type, time offset, size and offset of the frame data) in as many frames
+    // as needed, then a trailer frame whose data, the last FRAME_INDEX_TRAILER_SIZE bytes of the file, holds the offset
+    // of the first index frame, the number of entries and FRAME_INDEX_MAGIC.
+    static const uint32_t FRAME_INDEX_MAGIC = 0x58444946; // "FIDX"
+    static const int FRAME_INDEX_ENTRY_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(FrameSize) + sizeof(quint64);
+    static const int FRAME_INDEX_TRAILER_SIZE = sizeof(quint64) + sizeof(uint32_t) + sizeof(uint32_t);
+    static const int MAX_FRAME_INDEX_ENTRIES_PER_FRAME = 4000;
+
 protected:
     void reset() override;
     virtual FrameConstPointer readFrame(size_t index) const override;
@@ -51,6 +64,27 @@ protected:
     uchar* _data { nullptr };
     size_t _size { 0 };
     bool _compressed { true };
+    int _encoding { 0 };
+    // for clips of FRAME_ENCODING_DELTAS, the index of the frame of the same type before each frame
+    std::vector<uint32_t> _previousOfType;
+    // keeps _data alive; when set, uncompressed frames refer to _data instead of copying it, and hold on to it
+    std::shared_ptr<const void> _storage;
+
+private:
+    static const uint32_t NO_FRAME = (uint32_t)-1;
+
+    QByteArray decodeFrameData(size_t frameIndex) const;
+
+    // what was decoded last of a frame type, for clips of FRAME_ENCODING_DELTAS
+    struct DecodedType {
+        bool hasData { false };
+        size_t lastFrame { 0 };
+        QByteArray lastData;
+        bool hasCodec { false };
+        FrameCodec::Pointer codec;
+        uint32_t lastCodecFrame { NO_FRAME };
+    };
+    mutable QHash<FrameType, DecodedType> _decodedTypes;
 };
 
 }
@@ -0,0 +1,258 @@
+//
+//  AvatarImpostorEffect.cpp
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarImpostorEffect.h"
+
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <gpu/Context.h>
+#include <graphics/ShaderConstants.h>
+#include <render/DrawTask.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+#include "StencilMaskPass.h"
+
+namespace ru {
+    using render_utils::slot::texture::Texture;
+    using render_utils::slot::buffer::Buffer;
+}
+
+namespace gr {
+    using graphics::slot::texture::Texture;
+    using graphics::slot::buffer::Buffer;
+}
+
+using namespace render;
+
+extern void initForwardPipelines(ShapePlumber& plumber);
+
+// The view direction of the captures is picked so the avatar up is the world up, unless seen from right above or below
+static glm::vec3 getCaptureUp(const glm::vec3& direction) {
+    const float MAX_VERTICAL_DIRECTION = 0.99f;
+    return fabsf(direction.y) > MAX_VERTICAL_DIRECTION ? Vectors::UNIT_Z : Vectors::UNIT_Y;
+}
+
+CaptureAvatarImpostors::CaptureAvatarImpostors() :
+    _shapePlumber(std::make_shared<ShapePlumber>())
+{
+    initForwardPipelines(*_shapePlumber);
+}
+
+void CaptureAvatarImpostors::configure(const Config& config) {
+    _maxCapturesPerFrame = config.maxCapturesPerFrame;
+    _recapturePeriod = (uint64_t)(config.recapturePeriod * USECS_PER_SECOND);
+    _recaptureCosAngle = cosf(glm::radians(config.recaptureAngle));
+}
+
+void CaptureAvatarImpostors::run(const RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    auto stage = args->_scene->getStage<AvatarImpostorStage>();
+    if (!stage) {
+        return;
+    }
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    const auto impostors = stage->getImpostors();
+    stage->releaseUnusedCells(impostors);
+    if (impostors.empty()) {
+        stage->_numDrawnImpostors = 0;
+        config->setStats(0, 0);
+        return;
+    }
+
+    if (!stage->_atlasFramebuffer) {
+        const auto sampler = gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_LINEAR, gpu::Sampler::WRAP_CLAMP);
+        auto colorTexture = gpu::Texture::createRenderBuffer(gpu::Element::COLOR_SRGBA_32, AvatarImpostorStage::ATLAS_SIZE,
+                                                             AvatarImpostorStage::ATLAS_SIZE, gpu::Texture::SINGLE_MIP, sampler);
+        const auto depthFormat = gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::DEPTH_STENCIL);
+        auto depthTexture = gpu::Texture::createRenderBuffer(depthFormat, AvatarImpostorStage::ATLAS_SIZE,
+                                                             AvatarImpostorStage::ATLAS_SIZE, gpu::Texture::SINGLE_MIP, sampler);
+        stage->_atlasFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("avatarImpostorAtlas"));
+        stage->_atlasFramebuffer->setRenderBuffer(0, colorTexture);
+        stage->_atlasFramebuffer->setDepthStencilBuffer(depthTexture, depthFormat);
+        stage->_drawBuffer = std::make_shared<gpu::Buffer>();
+    }
+
+    const auto now = usecTimestampNow();
+    const auto viewPosition = args->getViewFrustum().getPosition();
+
+    // Pick the impostors to capture this frame, the ones never captured first
+    struct Capture {
+        const AvatarImpostorStage::Impostor* impostor;
+        AvatarImpostorStage::Cell* cell;
+        glm::vec3 direction;
+    };
+    std::vector<Capture> captures;
+    for (const auto& impostor : impostors) {
+        auto cell = stage->findOrAllocateCell(impostor.key);
+        if (!cell) {
+            continue;
+        }
+        auto direction = impostor.center - viewPosition;
+        float distance = glm::length(direction);
+        direction = distance > EPSILON ? direction / distance : Vectors::UNIT_NEG_Z;
+        if (!cell->isCaptured || now - cell->captureTime > _recapturePeriod ||
+            glm::dot(direction, cell->captureDirection) < _recaptureCosAngle) {
+            captures.push_back({ &impostor, cell, direction });
+        }
+    }
+    if ((int)captures.size() > _maxCapturesPerFrame) {
+        std::partial_sort(captures.begin(), captures.begin() + _maxCapturesPerFrame, captures.end(),
+                          [](const Capture& a, const Capture& b) { return a.cell->captureTime < b.cell->captureTime; });
+        captures.resize(_maxCapturesPerFrame);
+    }
+
+    if (!captures.empty()) {
+        const auto& lightingModel = inputs.get0();
+        const auto& lightFrame = inputs.get1();
+
+        gpu::doInBatch("CaptureAvatarImpostors::run", args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+
+            batch.enableStereo(false);
+            batch.setFramebuffer(stage->_atlasFramebuffer);
+
+            // Same lighting as the forward pass
+            auto lightStage = args->_scene->getStage<LightStage>();
+            if (lightStage) {
+                auto keySunLight = lightStage->getCurrentKeyLight(*lightFrame);
+                if (keySunLight) {
+                    batch.setUniformBuffer(gr::Buffer::KeyLight, keySunLight->getLightSchemaBuffer());
+                }
+                auto keyAmbiLight = lightStage->getCurrentAmbientLight(*lightFrame);
+                if (keyAmbiLight) {
+                    batch.setUniformBuffer(gr::Buffer::AmbientLight, keyAmbiLight->getAmbientSchemaBuffer());
+                    if (keyAmbiLight->getAmbientMap()) {
+                        batch.setResourceTexture(ru::Texture::Skybox, keyAmbiLight->getAmbientMap());
+                    }
+                }
+            }
+            batch.setUniformBuffer(ru::Buffer::LightModel, lightingModel->getParametersBuffer());
+            batch.setResourceTexture(ru::Texture::AmbientFresnel, lightingModel->getAmbientFresnelLUT());
+
+            ItemBounds items;
+            for (auto& capture : captures) {
+                const auto& impostor = *capture.impostor;
+
+                auto viewport = stage->getCellViewport(capture.cell->index);
+                batch.setViewportTransform(viewport);
+                batch.setStateScissorRect(viewport);
+                batch.clearFramebuffer(gpu::Framebuffer::BUFFER_COLOR0 | gpu::Framebuffer::BUFFER_DEPTH | gpu::Framebuffer::BUFFER_STENCIL,
+                                       glm::vec4(0.0f), 1.0f, 0, true);
+
+                // An orthographic view of the avatar bounding sphere, from the direction it is seen from
+                const float radius = impostor.radius;
+                auto eye = impostor.center - capture.direction * (2.0f * radius);
+                batch.setProjectionTransform(glm::ortho(-radius, radius, -radius, radius, radius, 3.0f * radius));
+                batch.setViewTransform(Transform(glm::inverse(glm::lookAt(eye, impostor.center, getCaptureUp(capture.direction)))));
+                batch.setModelTransform(Transform());
+
+                items.clear();
+                for (auto id : impostor.itemIDs) {
+                    if (args->_scene->isAllocatedID(id)) {
+                        const auto& item = args->_scene->getItem(id);
+                        if (item.exist()) {
+                            items.emplace_back(id, item.getBound(args));
+                        }
+                    }
+                }
+                renderShapes(renderContext, _shapePlumber, items);
+
+                capture.cell->captureDirection = capture.direction;
+                capture.cell->captureTime = now;
+                capture.cell->isCaptured = true;
+            }
+
+            args->_batch = nullptr;
+        });
+    }
+
+    // The billboards of the captured impostors: the bounding sphere then the texcoord rect of the cell
+    std::vector<glm::vec4> drawData;
+    drawData.reserve(2 * impostors.size());
+    for (const auto& impostor : impostors) {
+        auto cell = stage->findOrAllocateCell(impostor.key);
+        if (cell && cell->isCaptured) {
+            drawData.emplace_back(impostor.center, impostor.radius);
+            drawData.push_back(stage->getCellTexcoordRect(cell->index));
+        }
+    }
+    stage->_drawBuffer->setData(drawData.size() * sizeof(glm::vec4), (const gpu::Byte*)drawData.data());
+    stage->_numDrawnImpostors = (int)(drawData.size() / 2);
+
+    config->setStats((int)impostors.size(), (int)captures.size());
+}
+
+gpu::PipelinePointer DrawAvatarImpostors::_pipeline;
+gpu::PipelinePointer DrawAvatarImpostors::_forwardPipeline;
+
+void DrawAvatarImpostors::run(const RenderContextPointer& renderContext, const glm::vec2& jitter) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    // The avatars are only impostors in the main view
+    if (args->_renderMode == RenderArgs::SECONDARY_CAMERA_RENDER_MODE) {
+        return;
+    }
+    auto stage = args->_scene->getStage<AvatarImpostorStage>();
+    if (!stage || stage->_numDrawnImpostors == 0) {
+        return;
+    }
+
+    auto& pipeline = _forward ? _forwardPipeline : _pipeline;
+    if (!pipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(_forward ? shader::render_utils::program::avatarImpostor_forward
+                                                                         : shader::render_utils::program::avatarImpostor);
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(true, true, gpu::LESS_EQUAL);
+        state->setCullMode(gpu::State::CULL_NONE);
+        PrepareStencil::testMaskDrawShape(*state);
+        pipeline = gpu::Pipeline::create(program, state);
+    }
+
+    gpu::doInBatch("DrawAvatarImpostors::run", args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+
+        batch.setViewportTransform(args->_viewport);
+        batch.setStateScissorRect(args->_viewport);
+
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+        batch.setProjectionTransform(projMat);
+        batch.setProjectionJitter(jitter.x, jitter.y);
+        batch.setViewTransform(viewMat);
+        batch.setModelTransform(Transform());
+
+        batch.setPipeline(pipeline);
+        batch.setResourceBuffer(0, stage->_drawBuffer);
+        batch.setResourceTexture(0, stage->_atlasFramebuffer->getRenderBuffer(0));
+
+        static const int NUM_VERTICES_PER_IMPOSTOR = 6;
+        batch.draw(gpu::TRIANGLES, NUM_VERTICES_PER_IMPOSTOR * stage->_numDrawnImpostors, 0);
+
+        batch.setResourceBuffer(0, nullptr);
+        batch.setResourceTexture(0, nullptr);
+
+        args->_batch = nullptr;
+    });
+}
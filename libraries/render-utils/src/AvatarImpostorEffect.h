@@ -0,0 +1,90 @@
+//
+//  AvatarImpostorEffect.h
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_utils_AvatarImpostorEffect_h
+#define hifi_render_utils_AvatarImpostorEffect_h
+
+#include <render/Engine.h>
+#include <render/ShapePipeline.h>
+
+#include "LightingModel.h"
+#include "LightStage.h"
+#include "AvatarImpostorStage.h"
+
+class CaptureAvatarImpostorsConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(int maxCapturesPerFrame MEMBER maxCapturesPerFrame NOTIFY dirty)
+    Q_PROPERTY(float recapturePeriod MEMBER recapturePeriod NOTIFY dirty)
+    Q_PROPERTY(float recaptureAngle MEMBER recaptureAngle NOTIFY dirty)
+    Q_PROPERTY(int numImpostors READ getNumImpostors NOTIFY statsChanged)
+    Q_PROPERTY(int numCaptures READ getNumCaptures NOTIFY statsChanged)
+public:
+    CaptureAvatarImpostorsConfig() : render::Job::Config() {}
+
+    int getNumImpostors() const { return numImpostors; }
+    int getNumCaptures() const { return numCaptures; }
+    void setStats(int impostors, int captures) {
+        numImpostors = impostors;
+        numCaptures = captures;
+        emit statsChanged();
+    }
+
+    int maxCapturesPerFrame { 16 };
+    float recapturePeriod { 1.0f }; // seconds
+    float recaptureAngle { 15.0f }; // degrees
+
+signals:
+    void dirty();
+    void statsChanged();
+
+protected:
+    int numImpostors { 0 };
+    int numCaptures { 0 };
+};
+
+// Renders the impostors of the AvatarImpostorStage in their atlas cell, seen from the current view, with the forward pipelines.
+// The least recently captured ones go first, up to maxCapturesPerFrame, and an impostor is captured again once
+// it is older than recapturePeriod or seen from more than recaptureAngle away from its capture.
+class CaptureAvatarImpostors {
+public:
+    using Inputs = render::VaryingSet2<LightingModelPointer, LightStage::FramePointer>;
+    using Config = CaptureAvatarImpostorsConfig;
+    using JobModel = render::Job::ModelI<CaptureAvatarImpostors, Inputs, Config>;
+
+    CaptureAvatarImpostors();
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+protected:
+    render::ShapePlumberPointer _shapePlumber;
+    int _maxCapturesPerFrame { 16 };
+    uint64_t _recapturePeriod { 0 }; // usecs
+    float _recaptureCosAngle { 1.0f };
+};
+
+// Draws the captured impostors as billboards, in the deferred buffer or the forward framebuffer
+class DrawAvatarImpostors {
+public:
+    using JobModel = render::Job::ModelI<DrawAvatarImpostors, glm::vec2>;
+
+    DrawAvatarImpostors(bool forward = false) : _forward(forward) {}
+
+    void run(const render::RenderContextPointer& renderContext, const glm::vec2& jitter);
+
+protected:
+    static gpu::PipelinePointer _pipeline;
+    static gpu::PipelinePointer _forwardPipeline;
+
+    bool _forward;
+};
+
+#endif // hifi_render_utils_AvatarImpostorEffect_h
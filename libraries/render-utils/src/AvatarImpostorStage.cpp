@@ -0,0 +1,85 @@
+//
+//  AvatarImpostorStage.cpp
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarImpostorStage.h"
+
+#include <unordered_set>
+
+std::string AvatarImpostorStage::_stageName { "AVATAR_IMPOSTOR_STAGE" };
+const int AvatarImpostorStage::ATLAS_SIZE { 2048 };
+const int AvatarImpostorStage::CELL_SIZE { 64 };
+const int AvatarImpostorStage::MAX_IMPOSTORS { (ATLAS_SIZE / CELL_SIZE) * (ATLAS_SIZE / CELL_SIZE) };
+
+void AvatarImpostorStage::setImpostors(Impostors impostors) {
+    std::lock_guard<std::mutex> lock(_impostorsMutex);
+    _impostors.swap(impostors);
+}
+
+AvatarImpostorStage::Impostors AvatarImpostorStage::getImpostors() const {
+    std::lock_guard<std::mutex> lock(_impostorsMutex);
+    return _impostors;
+}
+
+glm::vec4 AvatarImpostorStage::getCellTexcoordRect(int index) const {
+    const int CELLS_PER_ROW = ATLAS_SIZE / CELL_SIZE;
+    const float CELL_TEXCOORD_SIZE = (float)CELL_SIZE / (float)ATLAS_SIZE;
+    return glm::vec4((float)(index % CELLS_PER_ROW) * CELL_TEXCOORD_SIZE, (float)(index / CELLS_PER_ROW) * CELL_TEXCOORD_SIZE,
+                     CELL_TEXCOORD_SIZE, CELL_TEXCOORD_SIZE);
+}
+
+glm::ivec4 AvatarImpostorStage::getCellViewport(int index) const {
+    const int CELLS_PER_ROW = ATLAS_SIZE / CELL_SIZE;
+    return glm::ivec4((index % CELLS_PER_ROW) * CELL_SIZE, (index / CELLS_PER_ROW) * CELL_SIZE, CELL_SIZE, CELL_SIZE);
+}
+
+AvatarImpostorStage::Cell* AvatarImpostorStage::findOrAllocateCell(render::ItemID key) {
+    auto found = _cells.find(key);
+    if (found != _cells.end()) {
+        return &found->second;
+    }
+
+    int index;
+    if (!_freeCells.empty()) {
+        index = _freeCells.back();
+        _freeCells.pop_back();
+    } else if ((int)_cells.size() < MAX_IMPOSTORS) {
+        index = (int)_cells.size();
+    } else {
+        return nullptr;
+    }
+    Cell& cell = _cells[key];
+    cell.index = index;
+    return &cell;
+}
+
+void AvatarImpostorStage::releaseUnusedCells(const Impostors& impostors) {
+    std::unordered_set<render::ItemID> usedKeys;
+    for (const auto& impostor : impostors) {
+        usedKeys.insert(impostor.key);
+    }
+    for (auto it = _cells.begin(); it != _cells.end();) {
+        if (usedKeys.find(it->first) != usedKeys.end()) {
+            ++it;
+        } else {
+            _freeCells.push_back(it->second.index);
+            it = _cells.erase(it);
+        }
+    }
+}
+
+AvatarImpostorStageSetup::AvatarImpostorStageSetup() {}
+
+void AvatarImpostorStageSetup::run(const render::RenderContextPointer& renderContext) {
+    auto stage = renderContext->_scene->getStage(AvatarImpostorStage::getName());
+    if (!stage) {
+        renderContext->_scene->resetStage(AvatarImpostorStage::getName(), std::make_shared<AvatarImpostorStage>());
+    }
+}
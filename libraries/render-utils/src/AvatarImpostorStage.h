@@ -0,0 +1,89 @@
+//
+//  AvatarImpostorStage.h
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_utils_AvatarImpostorStage_h
+#define hifi_render_utils_AvatarImpostorStage_h
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <gpu/Framebuffer.h>
+#include <render/Stage.h>
+#include <render/Item.h>
+#include <render/Engine.h>
+
+// The distant avatars drawn as a textured quad instead of their meshes.
+// The application sets the impostors of the frame, CaptureAvatarImpostors renders the avatars in the cells of an atlas
+// and DrawAvatarImpostors draws one billboard per captured impostor.
+class AvatarImpostorStage : public render::Stage {
+public:
+    static std::string _stageName;
+    static const std::string& getName() { return _stageName; }
+
+    static const int ATLAS_SIZE;
+    static const int CELL_SIZE;
+    static const int MAX_IMPOSTORS;
+
+    class Impostor {
+    public:
+        render::ItemID key { render::Item::INVALID_ITEM_ID }; // the same across the frames, the avatar meta item
+        render::ItemIDs itemIDs; // the items rendered in the capture
+        glm::vec3 center { 0.0f };
+        float radius { 0.0f };
+    };
+    using Impostors = std::vector<Impostor>;
+
+    // Thread safe, called by the application once per frame
+    void setImpostors(Impostors impostors);
+    Impostors getImpostors() const;
+
+    // The render thread state of the impostors, only touched by the impostor jobs
+    class Cell {
+    public:
+        int index { 0 };
+        glm::vec3 captureDirection { 0.0f };
+        uint64_t captureTime { 0 };
+        bool isCaptured { false };
+    };
+
+    glm::vec4 getCellTexcoordRect(int index) const;
+    glm::ivec4 getCellViewport(int index) const;
+
+    // Returns null when the atlas is full
+    Cell* findOrAllocateCell(render::ItemID key);
+    // Frees the cells of the keys not in the impostors
+    void releaseUnusedCells(const Impostors& impostors);
+
+    gpu::FramebufferPointer _atlasFramebuffer;
+    gpu::BufferPointer _drawBuffer;
+    int _numDrawnImpostors { 0 };
+
+protected:
+    mutable std::mutex _impostorsMutex;
+    Impostors _impostors;
+
+    std::unordered_map<render::ItemID, Cell> _cells;
+    std::vector<int> _freeCells;
+};
+using AvatarImpostorStagePointer = std::shared_ptr<AvatarImpostorStage>;
+
+class AvatarImpostorStageSetup {
+public:
+    using JobModel = render::Job::Model<AvatarImpostorStageSetup>;
+
+    AvatarImpostorStageSetup();
+    void run(const render::RenderContextPointer& renderContext);
+};
+
+#endif
@@ -26,6 +26,8 @@ public:
     void updateTransformForCauterizedMesh(const Transform& modelTransform, const Model::MeshState& meshState, bool useDualQuaternionSkinning);
 
     void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const override;
+    // the transform depends on the render mode, in bindTransform()
+    bool getIndirectDraw(RenderArgs* args, render::IndirectDraw& draw) override { return false; }
 
     void setEnableCauterization(bool enableCauterization) { _enableCauterization = enableCauterization; }
 
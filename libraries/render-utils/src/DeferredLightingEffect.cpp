@@ -115,7 +115,7 @@ static void loadLightProgram(int programId, bool lightVolume, gpu::PipelinePoint
     state->setColorWriteMask(true, true, true, false);
 
     if (lightVolume) {
-        PrepareStencil::testShape(*state);
+        PrepareStencil::testShapeNotFoveated(*state);
        
         state->setCullMode(gpu::State::CULL_BACK);
         //state->setCullMode(gpu::State::CULL_FRONT);
@@ -126,8 +126,8 @@ static void loadLightProgram(int programId, bool lightVolume, gpu::PipelinePoint
         state->setBlendFunction(true, gpu::State::ONE, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
 
     } else {
-        // Stencil test all the light passes for objects pixels only, not the background
-        PrepareStencil::testShape(*state);
+        // Stencil test all the light passes for objects pixels only, not the background nor the pixels left to the foveation fill
+        PrepareStencil::testShapeNotFoveated(*state);
 
         state->setCullMode(gpu::State::CULL_BACK);
         // additive blending
@@ -0,0 +1,106 @@
+//
+//  FoveationPass.cpp
+//  render-utils/src/
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FoveationPass.h"
+
+#include <gpu/Context.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+#include "StencilMaskPass.h"
+
+void FoveationMask::configure(const Config& config) {
+    _foveated = config.foveated;
+    _radius = config.radius;
+}
+
+void FoveationMask::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
+    RenderArgs* args = renderContext->args;
+
+    outputs = false;
+    if (!_foveated || args->_displayMode != RenderArgs::STEREO_HMD || args->_takingSnapshot || !inputs) {
+        return;
+    }
+
+    if (!_pipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::foveation_drawMask);
+        gpu::StatePointer state = std::make_shared<gpu::State>();
+        state->setDepthTest(gpu::State::DepthTest(false, false));
+        state->setColorWriteMask(gpu::State::WRITE_NONE);
+        PrepareStencil::testShapeDrawFoveated(*state);
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+
+    auto& parameters = _parameters.edit();
+    parameters._viewport = glm::vec4(args->_viewport);
+    parameters._centers = glm::vec4(args->_foveationCenters[0], args->_foveationCenters[1]);
+    parameters._radius = _radius;
+    parameters._isStereo = args->isStereo() ? 1 : 0;
+
+    gpu::doInBatch("FoveationMask::run", args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        batch.setFramebuffer(inputs->getDeferredFramebuffer());
+        batch.setViewportTransform(args->_viewport);
+        batch.setPipeline(_pipeline);
+        batch.setUniformBuffer(render_utils::slot::buffer::FoveationParams, _parameters);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+    });
+
+    outputs = true;
+}
+
+void FoveationFill::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
+    RenderArgs* args = renderContext->args;
+
+    const auto& isFoveated = inputs.get0();
+    const auto& deferredFramebuffer = inputs.get1();
+    const auto& linearDepthFramebuffer = inputs.get2();
+    if (!isFoveated || !deferredFramebuffer || !linearDepthFramebuffer) {
+        return;
+    }
+
+    auto lightingFramebuffer = deferredFramebuffer->getLightingFramebuffer();
+    auto frameSize = lightingFramebuffer->getSize();
+    if (!_sourceFramebuffer || _sourceFramebuffer->getSize() != frameSize) {
+        auto lightingTexture = deferredFramebuffer->getLightingTexture();
+        auto sourceTexture = gpu::TexturePointer(gpu::Texture::createRenderBuffer(lightingTexture->getTexelFormat(), frameSize.x, frameSize.y,
+                                                 gpu::Texture::SINGLE_MIP, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT)));
+        _sourceFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("foveationSource"));
+        _sourceFramebuffer->setRenderBuffer(0, sourceTexture);
+    }
+
+    if (!_pipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::foveation_fill);
+        gpu::StatePointer state = std::make_shared<gpu::State>();
+        state->setDepthTest(gpu::State::DepthTest(false, false));
+        PrepareStencil::testShapeFoveated(*state);
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+
+    gpu::doInBatch("FoveationFill::run", args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        // the fill reads the lit pixels from a copy, as it writes over the lighting
+        gpu::Vec4i frameRect(0, 0, frameSize.x, frameSize.y);
+        batch.blit(lightingFramebuffer, frameRect, _sourceFramebuffer, frameRect);
+
+        batch.setFramebuffer(lightingFramebuffer);
+        batch.setViewportTransform(args->_viewport);
+        batch.setPipeline(_pipeline);
+        batch.setResourceTexture(render_utils::slot::texture::FoveationColor, _sourceFramebuffer->getRenderBuffer(0));
+        batch.setResourceTexture(render_utils::slot::texture::FoveationDepth, linearDepthFramebuffer->getLinearDepthTexture());
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+
+        batch.setResourceTexture(render_utils::slot::texture::FoveationColor, nullptr);
+        batch.setResourceTexture(render_utils::slot::texture::FoveationDepth, nullptr);
+    });
+}
@@ -0,0 +1,71 @@
+//
+//  FoveationPass.h
+//  render-utils/src/
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FoveationPass_h
+#define hifi_FoveationPass_h
+
+#include <render/Engine.h>
+#include <gpu/Pipeline.h>
+
+#include "DeferredFramebuffer.h"
+#include "SurfaceGeometryPass.h"
+
+// Shades the periphery of each eye's view at half rate in an HMD, where the lenses blur it anyway: after the opaque
+// geometry, the mask marks every other 2x2 quad outside a radius around each eye's center (the gaze, when tracked) in
+// the stencil, the deferred lighting skips them, and the fill rebuilds them from the quads around them.
+class FoveationMaskConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool foveated MEMBER foveated NOTIFY dirty)
+    Q_PROPERTY(float radius MEMBER radius NOTIFY dirty)
+
+public:
+    bool foveated { false };
+
+    // of the full rate region around each eye's center, as a fraction of the eye's view height
+    float radius { 0.3f };
+
+signals:
+    void dirty();
+};
+
+class FoveationMask {
+public:
+    using Inputs = DeferredFramebufferPointer;
+    using Outputs = bool; // whether any pixels were left to the fill
+    using Config = FoveationMaskConfig;
+    using JobModel = render::Job::ModelIO<FoveationMask, Inputs, Outputs, Config>;
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
+
+private:
+#include "Foveation_shared.slh"
+    using ParametersBuffer = gpu::StructBuffer<FoveationParameters>;
+
+    gpu::PipelinePointer _pipeline;
+    ParametersBuffer _parameters;
+    bool _foveated { false };
+    float _radius { 0.3f };
+};
+
+class FoveationFill {
+public:
+    using Inputs = render::VaryingSet3<bool, DeferredFramebufferPointer, LinearDepthFramebufferPointer>;
+    using JobModel = render::Job::ModelI<FoveationFill, Inputs>;
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+private:
+    gpu::PipelinePointer _pipeline;
+    gpu::FramebufferPointer _sourceFramebuffer;
+};
+
+#endif // hifi_FoveationPass_h
@@ -259,12 +259,47 @@ void LightStage::Shadow::setKeylightCascadeFrustum(unsigned int cascadeIndex, co
     const auto viewMaxCascadeShadowDistance = std::min(viewFrustum.getFarClip(), cascade.getMaxDistance());
     const auto viewMaxShadowDistance = _cascades.back().getMaxDistance();
 
-    const Transform shadowView{ cascade._frustum->getView()};
-    const Transform shadowViewInverse{ shadowView.getInverseMatrix() };
-
     auto nearCorners = viewFrustum.getCorners(viewMinCascadeShadowDistance);
     auto farCorners = viewFrustum.getCorners(viewMaxCascadeShadowDistance);
 
+    if (_staticCastersCached) {
+        const vec3 corners[8] = { nearCorners.bottomLeft, nearCorners.bottomRight, nearCorners.topLeft, nearCorners.topRight,
+            farCorners.bottomLeft, farCorners.bottomRight, farCorners.topLeft, farCorners.topRight };
+        vec3 center{ 0.0f };
+        for (const auto& corner : corners) {
+            center += corner;
+        }
+        center /= 8.0f;
+        float radius = 0.0f;
+        for (const auto& corner : corners) {
+            radius = glm::max(radius, glm::distance(center, corner));
+        }
+        // The slice only changes shape with the view's projection, round its radius so that it doesn't jitter as it turns
+        const float RADIUS_STEP = 0.25f;
+        radius = glm::ceil(radius / RADIUS_STEP) * RADIUS_STEP;
+
+        const int SNAP_DIVISIONS = 8;
+        const float snapStep = 2.0f * radius / SNAP_DIVISIONS;
+        const auto orientation = cascade._frustum->getOrientation();
+        vec3 lightSpaceCenter = glm::inverse(orientation) * center;
+        lightSpaceCenter = glm::floor(lightSpaceCenter / snapStep) * snapStep;
+        const vec3 snappedCenter = orientation * lightSpaceCenter;
+
+        const auto lightDirection = glm::normalize(_light->getDirection());
+        cascade._frustum->setPosition(snappedCenter - (nearDepth + farDepth) * lightDirection);
+        glm::mat4 ortho = glm::ortho<float>(-radius, radius, -radius, radius, nearDepth, nearDepth + farDepth + radius);
+        cascade._frustum->setProjection(ortho);
+        cascade._frustum->calculate();
+
+        const Transform shadowView{ cascade._frustum->getView() };
+        auto& schema = _schemaBuffer.edit<Schema>();
+        schema.cascades[cascadeIndex].reprojection = _biasMatrix * ortho * shadowView.getInverseMatrix();
+        return;
+    }
+
+    const Transform shadowView{ cascade._frustum->getView()};
+    const Transform shadowViewInverse{ shadowView.getInverseMatrix() };
+
     vec3 min{ shadowViewInverse.transform(nearCorners.bottomLeft) };
     vec3 max{ min };
     // Expand keylight frustum  to fit view frustum
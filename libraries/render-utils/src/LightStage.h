@@ -95,6 +95,17 @@ public:
 
         const graphics::LightPointer& getLight() const { return _light; }
 
+        // When the static casters are cached, the cascade frustums are fit around the bounding sphere of their view slice
+        // and snapped to a grid in light space, so that they stay the same from one frame to the next until the view
+        // moves past a grid step
+        void setStaticCastersCached(bool cached) { _staticCastersCached = cached; }
+        bool areStaticCastersCached() const { return _staticCastersCached; }
+
+        // Past the first cascade, a blendshape moves the surface by little more than a shadow map texel, so clearing this
+        // only skins the deformed casters there, trading their exact shadow for the cost of the blendshapes
+        void setFarCascadeBlendshapesEnabled(bool enabled) { _farCascadeBlendshapesEnabled = enabled; }
+        bool areFarCascadeBlendshapesEnabled() const { return _farCascadeBlendshapesEnabled; }
+
         gpu::TexturePointer map;
 #include "Shadows_shared.slh"
         class Schema : public ShadowParameters {
@@ -111,6 +122,8 @@ public:
 
         graphics::LightPointer _light;
         float _maxDistance{ 0.0f };
+        bool _staticCastersCached{ false };
+        bool _farCascadeBlendshapesEnabled{ true };
         Cascades _cascades;
 
         UniformBufferView _schemaBuffer = nullptr;
@@ -11,6 +11,8 @@
 
 #include "MeshPartPayload.h"
 
+#include <glm/gtx/component_wise.hpp>
+
 #include <BillboardMode.h>
 #include <PerfStat.h>
 #include <DualQuaternion.h>
@@ -88,6 +90,14 @@ void ModelMeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::
         auto vertexFormat = _drawMesh->getVertexFormat();
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
         _localBound = _drawMesh->evalPartBound(partIndex);
+
+        _drawLODs.clear();
+        for (const auto& lod : _drawMesh->getLODs()) {
+            if (partIndex < (int)lod._parts.size()) {
+                _drawLODs.push_back({ lod._error, lod._parts[partIndex] });
+            }
+        }
+        _lodLevel = std::min(_lodLevel, (int)_drawLODs.size());
     }
 }
 
@@ -180,7 +190,8 @@ void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& modelT
 }
 
 void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
-    batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+    const auto& indexBuffer = _lodLevel > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer();
+    batch.setIndexBuffer(indexBuffer);
     batch.setInputFormat((_drawMesh->getVertexFormat()));
     if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
@@ -188,6 +199,15 @@ void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
     batch.setInputStream(0, _drawMesh->getVertexStream());
 }
 
+void ModelMeshPartPayload::bindPooledMesh(gpu::Batch& batch, uint32_t baseVertex) {
+    const auto& indexBuffer = _lodLevel > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer();
+    batch.setIndexBuffer(gpu::UINT32, indexBuffer._buffer, 0);
+    batch.setInputFormat((_drawMesh->getVertexFormat()));
+    const auto& vertexStream = _drawMesh->getVertexStream();
+    auto stride = vertexStream.getStrides()[0];
+    batch.setInputBuffer(0, vertexStream.getBuffers()[0], baseVertex * stride, stride);
+}
+
 void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const {
     if (_clusterBuffer) {
         batch.setUniformBuffer(graphics::slot::buffer::Skinning, _clusterBuffer);
@@ -196,7 +216,8 @@ void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& tra
 }
 
 void ModelMeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+    const auto& part = getDrawnPart();
+    batch.drawIndexed(gpu::TRIANGLES, part._numIndices, part._startIndex);
 }
 
 void ModelMeshPartPayload::updateKey(const render::ItemKey& key) {
@@ -306,6 +327,66 @@ Item::Bound ModelMeshPartPayload::getBound(RenderArgs* args) const {
     return worldBound;
 }
 
+float ModelMeshPartPayload::evalProjectedSize(RenderArgs* args, const Transform& parentTransform) const {
+    auto worldBound = _adjustedLocalBound;
+    worldBound.transform(parentTransform);
+
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    float radius = 0.5f * glm::length(worldBound.getDimensions());
+    float distance = glm::distance(worldBound.calcCenter(), viewFrustum.getPosition());
+    // the whole view, or more, when seen from up close or inside
+    float viewHeight = (float)args->_viewport.w;
+    if (distance <= radius) {
+        return viewHeight;
+    }
+    float pixelsPerRadian = viewHeight / glm::radians(viewFrustum.getFieldOfView());
+    return pixelsPerRadian * 2.0f * atanf(radius / distance);
+}
+
+// LODManager grows the angle below which items are culled to keep to its frame rate targets, and the levels of detail
+// follow it: a level is drawn while its error is at most this fraction of that angle on screen
+static const float LOD_ERROR_PER_CULL_SIZE = 0.25f;
+// errors smaller than a pixel never show, whatever the angle
+static const float MIN_LOD_ERROR_PIXELS = 1.0f;
+// a part only moves to a more simplified level once its error is this much under the limit, so that it doesn't flicker
+// between two levels at the limit
+static const float LOD_HYSTERESIS = 1.5f;
+
+void ModelMeshPartPayload::updateLOD(RenderArgs* args, const Transform& parentTransform, const Transform& modelTransform) {
+    if (_drawLODs.empty()) {
+        return;
+    }
+
+    auto worldBound = _adjustedLocalBound;
+    worldBound.transform(parentTransform);
+
+    const ViewFrustum& viewFrustum = args->getViewFrustum();
+    float radius = 0.5f * glm::length(worldBound.getDimensions());
+    float distance = glm::distance(worldBound.calcCenter(), viewFrustum.getPosition()) - radius;
+    if (distance <= 0.0f || !viewFrustum.isPerspective()) {
+        _lodLevel = 0;
+        return;
+    }
+
+    float pixelsPerRadian = (float)args->_viewport.w / glm::radians(viewFrustum.getFieldOfView());
+    float maxErrorPixels = glm::max(MIN_LOD_ERROR_PIXELS,
+                                    LOD_ERROR_PER_CULL_SIZE * pixelsPerRadian * 2.0f * atanf(args->_lodAngleHalfTan));
+    // the errors are in the units of the vertices, the nearest of which are at least the distance away
+    float errorToPixels = pixelsPerRadian * glm::compMax(glm::abs(modelTransform.getScale())) / distance;
+    auto getErrorPixels = [&](int level) {
+        return level > 0 ? _drawLODs[level - 1]._error * errorToPixels : 0.0f;
+    };
+
+    int lodLevel = _lodLevel;
+    while (lodLevel > 0 && getErrorPixels(lodLevel) > maxErrorPixels) {
+        lodLevel--;
+    }
+    while (lodLevel < (int)_drawLODs.size() && getErrorPixels(lodLevel + 1) * LOD_HYSTERESIS <= maxErrorPixels) {
+        lodLevel++;
+    }
+    _lodLevel = lodLevel;
+}
+
 ShapeKey ModelMeshPartPayload::getShapeKey() const {
     return _shapeKey;
 }
@@ -326,6 +407,11 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     Transform modelTransform = transform.worldTransform(_localTransform);
     bindTransform(batch, modelTransform, args->_renderMode);
 
+    // shadows and the other passes draw the level the main view picked
+    if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        updateLOD(args, transform, modelTransform);
+    }
+
     //Bind the index buffer and vertex buffer and Blend shapes if needed
     bindMesh(batch);
 
@@ -351,6 +437,9 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
         if (RenderPipelines::bindMaterials(_drawMaterials, batch, args->_renderMode, args->_enableTexturing)) {
             args->_details._materialSwitches++;
         }
+        if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE && args->_enableTexturing) {
+            _drawMaterials.requestTextureMips(evalProjectedSize(args, transform));
+        }
     }
 
     // Draw!
@@ -360,7 +449,100 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     }
 
     const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += getDrawnPart()._numIndices / INDICES_PER_TRIANGLE;
+}
+
+// what a multi-material's draws merge on: the hash of its content once that's up to date, otherwise its only material or
+// itself, which are never taken for a content hash
+static bool isMaterialContentKeyed(const graphics::MultiMaterial& materials) {
+    return !materials.shouldUpdate() && materials.getContentHash() != 0;
+}
+
+static const void* getMaterialIdentity(const graphics::MultiMaterial& materials) {
+    return materials.size() == 1 ? (const void*)materials.top().material.get() : (const void*)&materials;
+}
+
+// the bindState of a model mesh part: its mesh, or the pool's vertex buffer, its index buffer, the pooled vertex format
+// and its multi-material
+static bool modelMeshPartDrawsMatch(const render::IndirectDraw& draw, const render::IndirectDraw& other) {
+    if (draw.bindState[0] != other.bindState[0] || draw.bindState[1] != other.bindState[1]) {
+        return false;
+    }
+
+    auto format = static_cast<const gpu::Stream::Format*>(draw.bindState[2]);
+    auto otherFormat = static_cast<const gpu::Stream::Format*>(other.bindState[2]);
+    if (format != otherFormat && (!format || !otherFormat || format->getKey() != otherFormat->getKey())) {
+        return false;
+    }
+
+    auto& materials = *static_cast<const graphics::MultiMaterial*>(draw.bindState[3]);
+    auto& otherMaterials = *static_cast<const graphics::MultiMaterial*>(other.bindState[3]);
+    bool contentKeyed = isMaterialContentKeyed(materials);
+    if (contentKeyed != isMaterialContentKeyed(otherMaterials)) {
+        return false;
+    }
+    return contentKeyed ? materials.hasSameContent(otherMaterials) :
+        getMaterialIdentity(materials) == getMaterialIdentity(otherMaterials);
+}
+
+bool ModelMeshPartPayload::getIndirectDraw(RenderArgs* args, render::IndirectDraw& draw) {
+    // deformed and procedural parts set up more than their transform for each draw
+    if (!args || !_drawMesh || _cauterized || _isSkinned || _isBlendShaped || _shapeKey.hasOwnPipeline()) {
+        return false;
+    }
+
+    Transform transform = _parentTransform;
+    transform.setRotation(BillboardModeHelpers::getBillboardRotation(transform.getTranslation(), transform.getRotation(), _billboardMode,
+        args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE ? BillboardModeHelpers::getPrimaryViewFrustumPosition() : args->getViewFrustum().getPosition()));
+    draw.transform = transform.worldTransform(_localTransform);
+
+    if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE) {
+        updateLOD(args, transform, draw.transform);
+        if (args->_enableTexturing) {
+            _drawMaterials.requestTextureMips(evalProjectedSize(args, transform));
+        }
+    }
+
+    // the copies of a model share its meshes, and parts with the same schema and textures draw alike whichever
+    // materials they were given
+    bool contentKeyed = isMaterialContentKeyed(_drawMaterials);
+    size_t material = contentKeyed ? _drawMaterials.getContentHash() : (size_t)getMaterialIdentity(_drawMaterials);
+    const auto& indexBuffer = _lodLevel > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer();
+    const auto& part = getDrawnPart();
+    draw.numIndices = (uint32_t)part._numIndices;
+    draw.batchKey = 0;
+    draw.matches = modelMeshPartDrawsMatch;
+
+    auto renderMode = args->_renderMode;
+    bool enableTexturing = args->_enableTexturing;
+    if (_drawMesh->isPooled()) {
+        // the meshes of the pool share its buffers, so the parts of any of them with the same layout and material are
+        // drawn from the same bind, at the offsets of their meshes
+        const auto& vertexStream = _drawMesh->getVertexStream();
+        std::hash_combine(draw.batchKey, vertexStream.getBuffers()[0].get(), indexBuffer._buffer.get(),
+                          _drawMesh->getVertexFormat()->getKey(), contentKeyed, material);
+        draw.bindState = { vertexStream.getBuffers()[0].get(), indexBuffer._buffer.get(), _drawMesh->getVertexFormat().get(),
+                           &_drawMaterials };
+        draw.startIndex = (uint32_t)(indexBuffer._offset / sizeof(uint32_t) + part._startIndex);
+        draw.baseVertex = (uint32_t)(vertexStream.getOffsets()[0] / vertexStream.getStrides()[0]);
+        draw.bind = [this, renderMode, enableTexturing](gpu::Batch& batch, uint32_t baseVertex) {
+            bindPooledMesh(batch, baseVertex);
+            RenderPipelines::bindMaterials(_drawMaterials, batch, renderMode, enableTexturing);
+        };
+    } else {
+        std::hash_combine(draw.batchKey, _drawMesh.get(), indexBuffer._buffer.get(), contentKeyed, material);
+        draw.bindState = { _drawMesh.get(), indexBuffer._buffer.get(), nullptr, &_drawMaterials };
+        draw.startIndex = (uint32_t)part._startIndex;
+        draw.baseVertex = 0;
+        draw.bind = [this, renderMode, enableTexturing](gpu::Batch& batch, uint32_t baseVertex) {
+            bindMesh(batch);
+            RenderPipelines::bindMaterials(_drawMaterials, batch, renderMode, enableTexturing);
+        };
+    }
+
+    const int INDICES_PER_TRIANGLE = 3;
+    args->_details._trianglesRendered += part._numIndices / INDICES_PER_TRIANGLE;
+    return true;
 }
 
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
@@ -377,8 +559,8 @@ bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUui
     return true;
 }
 
-void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes) {
-    if (_meshIndex < blendedMeshSizes.length() && blendedMeshSizes.at(_meshIndex) == _meshNumVertices) {
+void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const std::vector<int>& blendedMeshSizes) {
+    if (_meshIndex < (int)blendedMeshSizes.size() && blendedMeshSizes[_meshIndex] == _meshNumVertices) {
         auto blendshapeBuffer = blendshapeBuffers.find(_meshIndex);
         if (blendshapeBuffer != blendshapeBuffers.end()) {
             _meshBlendshapeBuffer = blendshapeBuffer->second;
@@ -426,4 +608,11 @@ template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Poin
     }
     return false;
 }
+
+template <> bool payloadGetIndirectDraw(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args, IndirectDraw& draw) {
+    if (payload) {
+        return payload->getIndirectDraw(args, draw);
+    }
+    return false;
+}
 }
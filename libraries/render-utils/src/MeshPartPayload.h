@@ -37,6 +37,8 @@ public:
 
     // ModelMeshPartPayload functions to perform render
     void bindMesh(gpu::Batch& batch);
+    // binds the whole of the buffers of a pooled mesh, for draws that locate their vertices with a base vertex
+    void bindPooledMesh(gpu::Batch& batch, uint32_t baseVertex);
     virtual void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const;
     void drawCall(gpu::Batch& batch) const;
 
@@ -48,6 +50,8 @@ public:
     render::Item::Bound getBound(RenderArgs* args) const;
     render::ShapeKey getShapeKey() const;
     void render(RenderArgs* args);
+    // what render() would draw, for the parts drawn with nothing of their own but their transform
+    virtual bool getIndirectDraw(RenderArgs* args, render::IndirectDraw& draw);
 
     size_t getVerticesCount() const { return _drawMesh ? _drawMesh->getNumVertices() : 0; }
     size_t getMaterialTextureSize() { return _drawMaterials.getTextureSize(); }
@@ -63,16 +67,28 @@ public:
     void addMaterial(graphics::MaterialLayer material) { _drawMaterials.push(material); }
     void removeMaterial(graphics::MaterialPointer material) { _drawMaterials.remove(material); }
 
-    void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes);
+    void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const std::vector<int>& blendedMeshSizes);
 
     static bool enableMaterialProceduralShaders;
 
 private:
     void initCache(const ModelPointer& model, int shapeID);
+    // how many pixels the part covers across the view, for picking the texture mips worth having
+    float evalProjectedSize(RenderArgs* args, const Transform& parentTransform) const;
+    // picks the most simplified level of detail whose error doesn't show from the view
+    void updateLOD(RenderArgs* args, const Transform& parentTransform, const Transform& modelTransform);
+    const graphics::Mesh::Part& getDrawnPart() const { return _lodLevel > 0 ? _drawLODs[_lodLevel - 1]._part : _drawPart; }
 
     int _meshIndex;
     std::shared_ptr<const graphics::Mesh> _drawMesh;
     graphics::Mesh::Part _drawPart;
+    struct DrawLOD {
+        float _error;
+        graphics::Mesh::Part _part;
+    };
+    std::vector<DrawLOD> _drawLODs;
+    // 0 for the full detail part, or 1 + the level of detail drawn in its place
+    int _lodLevel { 0 };
     graphics::MultiMaterial _drawMaterials;
 
     gpu::BufferPointer _clusterBuffer;
@@ -107,6 +123,7 @@ namespace render {
     template <> const ShapeKey shapeGetShapeKey(const ModelMeshPartPayload::Pointer& payload);
     template <> void payloadRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args);
     template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
+    template <> bool payloadGetIndirectDraw(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args, IndirectDraw& draw);
 }
 
 #endif // hifi_MeshPartPayload_h
@@ -12,21 +12,23 @@
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
 
-void MetaModelPayload::setBlendedVertices(int blendNumber, const QVector<BlendshapeOffset>& blendshapeOffsets, const QVector<int>& blendedMeshSizes, const render::ItemIDs& subRenderItems) {
+void MetaModelPayload::setBlendedVertices(const BlendedVerticesPointer& blendedVertices, const render::ItemIDs& subRenderItems) {
     PROFILE_RANGE(render, __FUNCTION__);
-    if (blendNumber < _appliedBlendNumber) {
+    if (!blendedVertices || blendedVertices->blendNumber < _appliedBlendNumber) {
         return;
     }
-    _appliedBlendNumber = blendNumber;
+    _appliedBlendNumber = blendedVertices->blendNumber;
+    const auto& blendshapeOffsets = blendedVertices->offsets;
+    const auto& blendedMeshSizes = blendedVertices->meshSizes;
 
     // We have fewer meshes than before.  Invalidate everything
-    if (blendedMeshSizes.length() < (int)_blendshapeBuffers.size()) {
+    if (blendedMeshSizes.size() < _blendshapeBuffers.size()) {
         _blendshapeBuffers.clear();
     }
 
     int index = 0;
-    for (int i = 0; i < blendedMeshSizes.size(); i++) {
-        int numVertices = blendedMeshSizes.at(i);
+    for (int i = 0; i < (int)blendedMeshSizes.size(); i++) {
+        int numVertices = blendedMeshSizes[i];
 
         // This mesh isn't blendshaped
         if (numVertices == 0) {
@@ -37,9 +39,9 @@ void MetaModelPayload::setBlendedVertices(int blendNumber, const QVector<Blendsh
         const auto& buffer = _blendshapeBuffers.find(i);
         const auto blendShapeBufferSize = numVertices * sizeof(BlendshapeOffset);
         if (buffer == _blendshapeBuffers.end()) {
-            _blendshapeBuffers[i] = std::make_shared<gpu::Buffer>(blendShapeBufferSize, (gpu::Byte*) blendshapeOffsets.constData() + index * sizeof(BlendshapeOffset), blendShapeBufferSize);
+            _blendshapeBuffers[i] = std::make_shared<gpu::Buffer>(blendShapeBufferSize, (const gpu::Byte*)(blendshapeOffsets.data() + index) * sizeof(BlendshapeOffset), blendShapeBufferSize);
         } else {
-            buffer->second->setData(blendShapeBufferSize, (gpu::Byte*) blendshapeOffsets.constData() + index * sizeof(BlendshapeOffset));
+            buffer->second->setData(blendShapeBufferSize, (const gpu::Byte*)(blendshapeOffsets.data() + index) * sizeof(BlendshapeOffset));
         }
 
         index += numVertices;
@@ -47,8 +49,8 @@ void MetaModelPayload::setBlendedVertices(int blendNumber, const QVector<Blendsh
 
     render::Transaction transaction;
     for (auto& id : subRenderItems) {
-        transaction.updateItem<ModelMeshPartPayload>(id, [this, blendedMeshSizes](ModelMeshPartPayload& data) {
-            data.setBlendshapeBuffer(_blendshapeBuffers, blendedMeshSizes);
+        transaction.updateItem<ModelMeshPartPayload>(id, [this, blendedVertices](ModelMeshPartPayload& data) {
+            data.setBlendshapeBuffer(_blendshapeBuffers, blendedVertices->meshSizes);
         });
     }
     AbstractViewStateInterface::instance()->getMain3DScene()->enqueueTransaction(transaction);
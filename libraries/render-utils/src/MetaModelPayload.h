@@ -19,7 +19,7 @@
 
 class MetaModelPayload {
 public:
-    void setBlendedVertices(int blendNumber, const QVector<BlendshapeOffset>& blendshapeOffsets, const QVector<int>& blendedMeshSizes, const render::ItemIDs& subRenderItems);
+    void setBlendedVertices(const BlendedVerticesPointer& blendedVertices, const render::ItemIDs& subRenderItems);
 
 private:
     std::unordered_map<int, gpu::BufferPointer> _blendshapeBuffers;
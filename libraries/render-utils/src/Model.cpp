@@ -11,8 +11,9 @@
 
 #include "Model.h"
 
+#include <thread>
+
 #include <QMetaType>
-#include <QRunnable>
 #include <QThreadPool>
 
 #include <glm/gtx/transform.hpp>
@@ -1073,6 +1074,8 @@ bool Model::addToScene(const render::ScenePointer& scene,
                        render::Item::Status::Getters& statusGetters,
                        BlendShapeOperator modelBlendshapeOperator) {
 
+    // payloads kept by detachFromScene() already have their mapped materials
+    bool reusedRenderItems = !_addedToScene && !_modelMeshRenderItems.empty();
     if (!_addedToScene && isLoaded()) {
         updateGeometry();
         updateClusterMatrices();
@@ -1109,7 +1112,9 @@ bool Model::addToScene(const render::ScenePointer& scene,
     }
 
     if (somethingAdded) {
-        applyMaterialMapping();
+        if (!reusedRenderItems) {
+            applyMaterialMapping();
+        }
         _addedToScene = true;
         updateRenderItems();
         _needsFixupInScene = false;
@@ -1119,15 +1124,19 @@ bool Model::addToScene(const render::ScenePointer& scene,
 }
 
 void Model::removeFromScene(const render::ScenePointer& scene, render::Transaction& transaction) {
+    detachFromScene(transaction);
+    _modelMeshRenderItems.clear();
+    _modelMeshMaterialNames.clear();
+    _modelMeshRenderItemShapes.clear();
+    _priorityMap.clear();
+}
+
+void Model::detachFromScene(render::Transaction& transaction) {
     foreach (auto item, _modelMeshRenderItemsMap.keys()) {
         transaction.removeItem(item);
     }
     _modelMeshRenderItemIDs.clear();
     _modelMeshRenderItemsMap.clear();
-    _modelMeshRenderItems.clear();
-    _modelMeshMaterialNames.clear();
-    _modelMeshRenderItemShapes.clear();
-    _priorityMap.clear();
 
     _addedToScene = false;
 
@@ -1305,6 +1314,15 @@ void Model::setURL(const QUrl& url) {
     onInvalidate();
 }
 
+void Model::setLoadingPriority(float priority) {
+    if (priority != _loadingPriority) {
+        _loadingPriority = priority;
+        if (!isLoaded()) {
+            _renderWatcher.setLoadPriority(this, priority);
+        }
+    }
+}
+
 void Model::loadURLFinished(bool success) {
     if (!success) {
         _visualGeometryRequestFailed = true;
@@ -1848,34 +1866,15 @@ static void packBlendshapeOffsets(BlendshapeOffsetUnpacked* unpacked, Blendshape
 static auto& packBlendshapeOffsets = packBlendshapeOffsets_ref;
 #endif
 
-class Blender : public QRunnable {
-public:
-
-    Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients);
-
-    virtual void run() override;
-
-private:
-    ModelPointer _model;
-    HFMModel::ConstPointer _hfmModel;
-    int _blendNumber;
-    QVector<float> _blendshapeCoefficients;
-};
-
-Blender::Blender(ModelPointer model, HFMModel::ConstPointer hfmModel, int blendNumber, const QVector<float>& blendshapeCoefficients) :
-    _model(model),
-    _hfmModel(hfmModel),
-    _blendNumber(blendNumber),
-    _blendshapeCoefficients(blendshapeCoefficients) {
-}
+// Blends the blendshapes of a model into its blended vertices, on a worker thread
+static void blendModel(const ModelBlend& blend) {
+    DETAILED_PROFILE_RANGE(simulation_animation, __FUNCTION__);
+    const HFMModel& hfmModel = *blend.hfmModel;
+    BlendedVertices& blendedVertices = *blend.blendedVertices;
 
-void Blender::run() {
-    DETAILED_PROFILE_RANGE_EX(simulation_animation, __FUNCTION__, 0xFFFF0000, 0, { { "url", _model->getURL().toString() } });
     int numBlendshapeOffsets = 0;  // number of offsets required for all meshes.
     int maxBlendshapeOffsets = 0;  // number of offsets in the largest mesh.
-    int numMeshes = 0;  // number of meshes in this model.
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
-        numMeshes++;
+    for (auto meshIter = hfmModel.meshes.cbegin(); meshIter != hfmModel.meshes.cend(); ++meshIter) {
         if (meshIter->blendshapes.isEmpty()) {
             continue;
         }
@@ -1884,32 +1883,32 @@ void Blender::run() {
         maxBlendshapeOffsets = std::max(maxBlendshapeOffsets, numVertsInMesh);
     }
 
-    // allocate the required sizes
-    QVector<int> blendedMeshSizes;
-    blendedMeshSizes.reserve(numMeshes);
+    // the buffers keep their capacity from one blend of the model to the next
+    blendedVertices.meshSizes.clear();
+    blendedVertices.meshSizes.reserve(hfmModel.meshes.size());
+    blendedVertices.offsets.resize(numBlendshapeOffsets);
 
-    QVector<BlendshapeOffset> packedBlendshapeOffsets;
-    packedBlendshapeOffsets.resize(numBlendshapeOffsets);
-
-    QVector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
-    unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    thread_local std::vector<BlendshapeOffsetUnpacked> unpackedBlendshapeOffsets;
+    if ((int)unpackedBlendshapeOffsets.size() < maxBlendshapeOffsets) {
+        unpackedBlendshapeOffsets.resize(maxBlendshapeOffsets);    // reuse for all meshes
+    }
 
     int offset = 0;
-    for (auto meshIter = _hfmModel->meshes.cbegin(); meshIter != _hfmModel->meshes.cend(); ++meshIter) {
+    for (auto meshIter = hfmModel.meshes.cbegin(); meshIter != hfmModel.meshes.cend(); ++meshIter) {
         if (meshIter->blendshapes.isEmpty()) {
-            blendedMeshSizes.push_back(0);
+            blendedVertices.meshSizes.push_back(0);
             continue;
         }
         int numVertsInMesh = meshIter->vertices.size();
-        blendedMeshSizes.push_back(numVertsInMesh);
+        blendedVertices.meshSizes.push_back(numVertsInMesh);
 
         // initialize offsets to zero
         memset(unpackedBlendshapeOffsets.data(), 0, numVertsInMesh * sizeof(BlendshapeOffsetUnpacked));
 
         // for each blendshape in this mesh, accumulate the offsets into unpackedBlendshapeOffsets.
         const float NORMAL_COEFFICIENT_SCALE = 0.01f;
-        for (int i = 0, n = qMin(_blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
-            float vertexCoefficient = _blendshapeCoefficients.at(i);
+        for (int i = 0, n = qMin(blend.blendshapeCoefficients.size(), meshIter->blendshapes.size()); i < n; i++) {
+            float vertexCoefficient = blend.blendshapeCoefficients.at(i);
             const float EPSILON = 0.0001f;
             if (vertexCoefficient < EPSILON) {
                 continue;
@@ -1931,34 +1930,42 @@ void Blender::run() {
 
         // convert unpackedBlendshapeOffsets into packedBlendshapeOffsets for the gpu.
         auto unpacked = unpackedBlendshapeOffsets.data();
-        auto packed = packedBlendshapeOffsets.data() + offset;
+        auto packed = blendedVertices.offsets.data() + offset;
         packBlendshapeOffsets(unpacked, packed, numVertsInMesh);
 
         offset += numVertsInMesh;
     }
     Q_ASSERT(offset == numBlendshapeOffsets);
-
-    // post the result to the ModelBlender, which will dispatch to the model if still alive
-    QMetaObject::invokeMethod(DependencyManager::get<ModelBlender>().data(), "setBlendedVertices",
-                              Q_ARG(ModelPointer, _model), Q_ARG(int, _blendNumber),
-                              Q_ARG(QVector<BlendshapeOffset>, packedBlendshapeOffsets),
-                              Q_ARG(QVector<int>, blendedMeshSizes));
 }
 
-bool Model::maybeStartBlender() {
-    if (isLoaded()) {
-        QThreadPool::globalInstance()->start(new Blender(getThisPointer(), getGeometry()->getConstHFMModelPointer(),
-                                                         ++_blendNumber, _blendshapeCoefficients));
-        return true;
+bool Model::startBlend(ModelBlend& blend) {
+    if (!isLoaded()) {
+        return false;
     }
-    return false;
+
+    // The model blends into its two buffers in turn. The render side holds the last one until its transaction is
+    // processed, if it holds the other one still the blend goes to a new buffer.
+    auto& blendedVertices = _blendedVertices[_blendNumber % _blendedVertices.size()];
+    if (!blendedVertices || blendedVertices.use_count() > 1) {
+        blendedVertices = std::make_shared<BlendedVertices>();
+    }
+    blendedVertices->blendNumber = ++_blendNumber;
+
+    blend.model = getThisPointer();
+    blend.hfmModel = getGeometry()->getConstHFMModelPointer();
+    blend.blendshapeCoefficients = _blendshapeCoefficients;
+    blend.blendedVertices = blendedVertices;
+    return true;
 }
 
-ModelBlender::ModelBlender() :
-    _pendingBlenders(0) {
+ModelBlender::ModelBlender() {
 }
 
 ModelBlender::~ModelBlender() {
+    // the batch blends into _batch
+    while (_batchRunning.load(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
 }
 
 void ModelBlender::noteRequiresBlend(ModelPointer model) {
@@ -1967,41 +1974,52 @@ void ModelBlender::noteRequiresBlend(ModelPointer model) {
         _modelsRequiringBlendsQueue.push(model);
         _modelsRequiringBlendsSet.insert(model);
     }
+}
 
-    if (_pendingBlenders < QThread::idealThreadCount()) {
-        while (!_modelsRequiringBlendsQueue.empty()) {
-            auto weakPtr = _modelsRequiringBlendsQueue.front();
-            _modelsRequiringBlendsQueue.pop();
-            _modelsRequiringBlendsSet.erase(weakPtr);
-            ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                return;
-            }
-        }
+void ModelBlender::update() {
+    PROFILE_RANGE(simulation_animation, __FUNCTION__);
+
+    // the models noted during a batch wait for it to finish
+    if (_batchRunning.load(std::memory_order_acquire)) {
+        return;
     }
-}
 
-void ModelBlender::setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes) {
-    if (model) {
-        auto blendshapeOperator = model->getModelBlendshapeOperator();
-        if (blendshapeOperator) {
-            blendshapeOperator(blendNumber, blendshapeOffsets, blendedMeshSizes, model->fetchRenderItemIDs());
+    // hand the blends of the last batch to the render items of their models
+    for (const auto& blend : _batch) {
+        ModelPointer model = blend.model.lock();
+        if (model) {
+            auto blendshapeOperator = model->getModelBlendshapeOperator();
+            if (blendshapeOperator) {
+                blendshapeOperator(blend.blendedVertices, model->fetchRenderItemIDs());
+            }
         }
     }
+    _batch.clear();
 
     {
         Lock lock(_mutex);
-        _pendingBlenders--;
         while (!_modelsRequiringBlendsQueue.empty()) {
             auto weakPtr = _modelsRequiringBlendsQueue.front();
             _modelsRequiringBlendsQueue.pop();
             _modelsRequiringBlendsSet.erase(weakPtr);
             ModelPointer nextModel = weakPtr.lock();
-            if (nextModel && nextModel->maybeStartBlender()) {
-                _pendingBlenders++;
-                break;
+            ModelBlend blend;
+            if (nextModel && nextModel->startBlend(blend)) {
+                _batch.push_back(std::move(blend));
             }
         }
     }
+
+    if (_batch.empty()) {
+        return;
+    }
+
+    // one job for all the blends of the frame
+    _batchRunning.store(true, std::memory_order_relaxed);
+    QThreadPool::globalInstance()->start([this] {
+        tbb::parallel_for((size_t)0, _batch.size(), [this](size_t i) {
+            blendModel(_batch[i]);
+        });
+        _batchRunning.store(false, std::memory_order_release);
+    });
 }
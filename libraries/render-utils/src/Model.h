@@ -17,6 +17,8 @@
 #include <QUrl>
 #include <QMutex>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -77,7 +79,15 @@ struct SortedTriangleSet {
     int subMeshIndex;
 };
 
-using BlendShapeOperator = std::function<void(int, const QVector<BlendshapeOffset>&, const QVector<int>&, const render::ItemIDs&)>;
+using BlendShapeOperator = std::function<void(const BlendedVerticesPointer&, const render::ItemIDs&)>;
+
+// The blend of the blendshapes of a model, which the ModelBlender runs along with the others of the frame
+struct ModelBlend {
+    ModelWeakPointer model;
+    HFMModel::ConstPointer hfmModel;
+    QVector<float> blendshapeCoefficients;
+    std::shared_ptr<BlendedVertices> blendedVertices;
+};
 
 /// A generic 3D model displaying geometry loaded from a URL.
 class Model : public QObject, public std::enable_shared_from_this<Model>, public scriptable::ModelProvider {
@@ -152,6 +162,8 @@ public:
                     render::Item::Status::Getters& statusGetters,
                     BlendShapeOperator modelBlendshapeOperator = nullptr);
     void removeFromScene(const render::ScenePointer& scene, render::Transaction& transaction);
+    // removes the render items but keeps their payloads and materials, adding the model back only allocates the item IDs
+    void detachFromScene(render::Transaction& transaction);
     bool isRenderable() const;
 
     void updateRenderItemsKey(const render::ScenePointer& scene);
@@ -162,7 +174,7 @@ public:
     AABox getRenderableMeshBound() const;
     const render::ItemIDs& fetchRenderItemIDs() const;
 
-    bool maybeStartBlender();
+    bool startBlend(ModelBlend& blend);
 
     bool isLoaded() const { return (bool)_renderGeometry && _renderGeometry->isHFMModelLoaded(); }
     bool isAddedToScene() const { return _addedToScene; }
@@ -287,7 +299,8 @@ public:
     // returns 'true' if needs fullUpdate after geometry change
     virtual bool updateGeometry();
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    // also updates the priority of the geometry if it's still loading
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -443,6 +456,7 @@ protected:
     QVector<float> _blendshapeCoefficients;
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber { 0 };
+    std::array<std::shared_ptr<BlendedVertices>, 2> _blendedVertices;
 
     mutable QRecursiveMutex _mutex;
 
@@ -517,7 +531,6 @@ private:
 
 Q_DECLARE_METATYPE(ModelPointer)
 Q_DECLARE_METATYPE(Geometry::WeakPointer)
-Q_DECLARE_METATYPE(BlendshapeOffset)
 
 /// Handle management of pending models that need blending
 class ModelBlender : public QObject, public Dependency {
@@ -529,10 +542,13 @@ public:
     /// Adds the specified model to the list requiring vertex blends.
     void noteRequiresBlend(ModelPointer model);
 
+    /// Hands the blends done since the last call to the models, then starts the blends of the models noted since as one
+    /// batch. Called once per frame, on the main thread.
+    void update();
+
     bool shouldComputeBlendshapes() { return _computeBlendshapes; }
 
 public slots:
-    void setBlendedVertices(ModelPointer model, int blendNumber, QVector<BlendshapeOffset> blendshapeOffsets, QVector<int> blendedMeshSizes);
     void setComputeBlendshapes(bool computeBlendshapes) { _computeBlendshapes = computeBlendshapes; }
 
 private:
@@ -544,9 +560,12 @@ private:
 
     std::queue<ModelWeakPointer> _modelsRequiringBlendsQueue;
     std::set<ModelWeakPointer, std::owner_less<ModelWeakPointer>> _modelsRequiringBlendsSet;
-    int _pendingBlenders;
     Mutex _mutex;
 
+    // the blends of the running batch, only touched by the main thread while it isn't running
+    std::vector<ModelBlend> _batch;
+    std::atomic<bool> _batchRunning { false };
+
     bool _computeBlendshapes { true };
 };
 
@@ -0,0 +1,227 @@
+//
+//  OcclusionCulling.cpp
+//  libraries/render-utils/src/
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "OcclusionCulling.h"
+
+#include <cstring>
+#include <limits>
+
+#include <gpu/Context.h>
+#include <shaders/Shaders.h>
+
+#include "render-utils/ShaderConstants.h"
+
+namespace ru {
+    using render_utils::slot::texture::Texture;
+    using render_utils::slot::buffer::Buffer;
+}
+
+// The size in pixels of the tiles of the depth, must match FOOTPRINT in surfaceGeometry_makeOcclusionDepth.slf
+const int OCCLUSION_DEPTH_FOOTPRINT = 16;
+// The number of frames a depth is still tested against while no newer one is read back
+const int MAX_OCCLUSION_DEPTH_AGE = 4;
+// Boxes any closer to the eye of the depth than this are never occluded
+const float MIN_OCCLUSION_DEPTH = 0.01f;
+
+void OcclusionDepth::update(const gpu::Readback& readback, const glm::ivec2& viewportSize, const glm::mat4& viewProjection) {
+    const auto& size = readback.getSize();
+    const auto& pixels = readback.getPixels();
+    if (readback.getFormat().getSize() != sizeof(float) || pixels.size() != (size_t)size.x * size.y * sizeof(float)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _incomingDepth.resize((size_t)size.x * size.y);
+    memcpy(_incomingDepth.data(), pixels.data(), pixels.size());
+    _incomingSize = glm::ivec2(size);
+    _incomingViewportSize = viewportSize;
+    _incomingViewProjection = viewProjection;
+    _hasIncoming = true;
+}
+
+bool OcclusionDepth::prepare() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_hasIncoming) {
+            _age++;
+            return !_levels.empty() && _age <= MAX_OCCLUSION_DEPTH_AGE;
+        }
+
+        _levels.resize(1);
+        _levels[0].swap(_incomingDepth);
+        _levelSizes = { _incomingSize };
+        _viewportSize = glm::vec2(_incomingViewportSize);
+        _viewProjection = _incomingViewProjection;
+        _hasIncoming = false;
+        _age = 0;
+    }
+
+    // Each level keeps the farthest depth of the 2 by 2 tiles of the one before, down to a single tile
+    glm::ivec2 size = _levelSizes.back();
+    while (size.x > 1 || size.y > 1) {
+        const auto& previous = _levels.back();
+        glm::ivec2 nextSize = (size + glm::ivec2(1)) / 2;
+        std::vector<float> next((size_t)nextSize.x * nextSize.y);
+        for (int y = 0; y < nextSize.y; ++y) {
+            int y0 = 2 * y;
+            int y1 = std::min(y0 + 1, size.y - 1);
+            for (int x = 0; x < nextSize.x; ++x) {
+                int x0 = 2 * x;
+                int x1 = std::min(x0 + 1, size.x - 1);
+                next[y * nextSize.x + x] = std::max(std::max(previous[y0 * size.x + x0], previous[y0 * size.x + x1]),
+                                                    std::max(previous[y1 * size.x + x0], previous[y1 * size.x + x1]));
+            }
+        }
+        _levels.push_back(std::move(next));
+        _levelSizes.push_back(nextSize);
+        size = nextSize;
+    }
+    return true;
+}
+
+bool OcclusionDepth::isOccluded(const AABox& box) const {
+    glm::vec2 minPos(std::numeric_limits<float>::max());
+    glm::vec2 maxPos(-std::numeric_limits<float>::max());
+    float nearestDepth = std::numeric_limits<float>::max();
+    for (int i = BOTTOM_LEFT_NEAR; i <= TOP_LEFT_FAR; ++i) {
+        glm::vec4 clipPos = _viewProjection * glm::vec4(box.getVertex((BoxVertex)i), 1.0f);
+        // The linear depth is the w of the clip position
+        if (clipPos.w < MIN_OCCLUSION_DEPTH) {
+            return false;
+        }
+        glm::vec2 ndcPos = glm::vec2(clipPos) / clipPos.w;
+        minPos = glm::min(minPos, ndcPos);
+        maxPos = glm::max(maxPos, ndcPos);
+        nearestDepth = std::min(nearestDepth, clipPos.w);
+    }
+    if (minPos.x < -1.0f || minPos.y < -1.0f || maxPos.x > 1.0f || maxPos.y > 1.0f) {
+        return false;
+    }
+
+    // Test against the finest level where the box covers up to 2 by 2 tiles
+    glm::vec2 ndcToTiles = _viewportSize * (0.5f / (float)OCCLUSION_DEPTH_FOOTPRINT);
+    glm::ivec2 minTile = glm::ivec2((minPos + glm::vec2(1.0f)) * ndcToTiles);
+    glm::ivec2 maxTile = glm::ivec2((maxPos + glm::vec2(1.0f)) * ndcToTiles);
+    size_t level = 0;
+    while (level + 1 < _levels.size() && (maxTile.x - minTile.x > 1 || maxTile.y - minTile.y > 1)) {
+        minTile >>= 1;
+        maxTile >>= 1;
+        ++level;
+    }
+    const auto& depth = _levels[level];
+    const auto& size = _levelSizes[level];
+    minTile = glm::min(minTile, size - glm::ivec2(1));
+    maxTile = glm::min(maxTile, size - glm::ivec2(1));
+
+    float farthestDepth = 0.0f;
+    for (int y = minTile.y; y <= maxTile.y; ++y) {
+        for (int x = minTile.x; x <= maxTile.x; ++x) {
+            farthestDepth = std::max(farthestDepth, depth[y * size.x + x]);
+        }
+    }
+    return nearestDepth > farthestDepth;
+}
+
+void BuildOcclusionDepth::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    RenderArgs* args = renderContext->args;
+
+    // The linear depth of both eyes side by side doesn't reproject with a single view
+    if (args->isStereo()) {
+        return;
+    }
+
+    const auto& frameTransform = inputs.get0();
+    const auto& linearDepthFramebuffer = inputs.get1();
+    auto linearDepthTexture = linearDepthFramebuffer->getLinearDepthTexture();
+    if (!linearDepthTexture) {
+        return;
+    }
+
+    glm::ivec2 viewportSize(args->_viewport.z, args->_viewport.w);
+    glm::ivec2 size = (viewportSize + glm::ivec2(OCCLUSION_DEPTH_FOOTPRINT - 1)) / OCCLUSION_DEPTH_FOOTPRINT;
+    if (!_framebuffer || _framebuffer->getSize() != gpu::Vec2u(size)) {
+        auto occlusionDepthTexture = gpu::Texture::createRenderBuffer(gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::RED), size.x, size.y,
+            gpu::Texture::SINGLE_MIP, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT, gpu::Sampler::WRAP_CLAMP));
+        _framebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("occlusionDepth"));
+        _framebuffer->setRenderBuffer(0, occlusionDepthTexture);
+    }
+
+    const auto& viewFrustum = args->getViewFrustum();
+    glm::mat4 viewProjection = viewFrustum.getProjection() * glm::inverse(viewFrustum.getView());
+    auto occlusionDepth = _occlusionDepth;
+    auto readback = std::make_shared<gpu::Readback>([occlusionDepth, viewportSize, viewProjection](const gpu::Readback& readback) {
+        occlusionDepth->update(readback, viewportSize, viewProjection);
+    }, "occlusionDepth");
+
+    auto framebuffer = _framebuffer;
+    auto pipeline = getPipeline();
+    gpu::doInBatch("BuildOcclusionDepth::run", args->_context, [=](gpu::Batch& batch) {
+        PROFILE_RANGE_BATCH(batch, "BuildOcclusionDepth");
+
+        batch.enableStereo(false);
+
+        batch.setProjectionTransform(glm::mat4());
+        batch.resetViewTransform();
+        batch.setModelTransform(Transform());
+
+        batch.setUniformBuffer(ru::Buffer::DeferredFrameTransform, frameTransform->getFrameTransformBuffer());
+
+        batch.setViewportTransform(glm::ivec4(0, 0, size));
+        batch.setFramebuffer(framebuffer);
+        batch.setPipeline(pipeline);
+        batch.setResourceTexture(ru::Texture::SurfaceGeometryDepth, linearDepthTexture);
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+        batch.setResourceTexture(ru::Texture::SurfaceGeometryDepth, nullptr);
+
+        batch.readFramebuffer(framebuffer, gpu::Vec4i(0, 0, size), readback);
+    });
+}
+
+const gpu::PipelinePointer& BuildOcclusionDepth::getPipeline() {
+    if (!_pipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::surfaceGeometry_makeOcclusionDepth);
+
+        // Every tile, including those of the background the linear depth keeps as far away, gets drawn
+        gpu::StatePointer state = std::make_shared<gpu::State>();
+        state->setColorWriteMask(true, false, false, false);
+
+        _pipeline = gpu::Pipeline::create(program, state);
+    }
+    return _pipeline;
+}
+
+void CullOccludedItems::configure(const Config& config) {
+    _skipCulling = config.skipCulling;
+}
+
+void CullOccludedItems::run(const render::RenderContextPointer& renderContext, const render::ItemBounds& inItems, render::ItemBounds& outItems) {
+    assert(renderContext->args);
+    RenderArgs* args = renderContext->args;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    if (_skipCulling || args->isStereo() || !_occlusionDepth->prepare()) {
+        outItems = inItems;
+        config->numTested = 0;
+        config->numCulled = 0;
+        return;
+    }
+
+    outItems.clear();
+    outItems.reserve(inItems.size());
+    for (const auto& item : inItems) {
+        if (!_occlusionDepth->isOccluded(item.bound)) {
+            outItems.emplace_back(item);
+        }
+    }
+    config->numTested = (int)inItems.size();
+    config->numCulled = (int)(inItems.size() - outItems.size());
+}
@@ -0,0 +1,106 @@
+//
+//  OcclusionCulling.h
+//  libraries/render-utils/src/
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OcclusionCulling_h
+#define hifi_OcclusionCulling_h
+
+#include <mutex>
+
+#include <gpu/Readback.h>
+
+#include "SurfaceGeometryPass.h"
+
+// OcclusionDepth is the farthest linear depth of the opaque surfaces drawn a frame or more ago, in tiles of the view,
+// read back from the gpu and reduced into a max pyramid on the cpu.
+class OcclusionDepth {
+public:
+    // Called by the readback's handler, on the thread executing the batches, with the view-projection it was drawn with
+    void update(const gpu::Readback& readback, const glm::ivec2& viewportSize, const glm::mat4& viewProjection);
+
+    // Builds the pyramid of the latest depth read back, once per frame before testing boxes against it.
+    // Returns false while there is no depth recent enough to test against.
+    bool prepare();
+
+    // True only if the box projects, with the view-projection of the depth, entirely within the view and behind the
+    // farthest depth it covers.  Boxes it didn't see, or that straddle its near plane, are never occluded.
+    bool isOccluded(const AABox& box) const;
+
+protected:
+    std::mutex _mutex;
+    std::vector<float> _incomingDepth;
+    glm::ivec2 _incomingSize { 0 };
+    glm::ivec2 _incomingViewportSize { 0 };
+    glm::mat4 _incomingViewProjection;
+    bool _hasIncoming { false };
+
+    std::vector<std::vector<float>> _levels;
+    std::vector<glm::ivec2> _levelSizes;
+    glm::vec2 _viewportSize { 0.0f };
+    glm::mat4 _viewProjection;
+    int _age { 0 };
+};
+
+using OcclusionDepthPointer = std::shared_ptr<OcclusionDepth>;
+
+// Downsamples the linear depth of the frame into tiles keeping their farthest depth, and reads it back for the
+// OcclusionDepth to cull the following frames with.
+class BuildOcclusionDepth {
+public:
+    using Inputs = render::VaryingSet2<DeferredFrameTransformPointer, LinearDepthFramebufferPointer>;
+    using JobModel = render::Job::ModelI<BuildOcclusionDepth, Inputs>;
+
+    BuildOcclusionDepth(const OcclusionDepthPointer& occlusionDepth) : _occlusionDepth(occlusionDepth) {}
+
+    void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
+
+private:
+    const gpu::PipelinePointer& getPipeline();
+
+    OcclusionDepthPointer _occlusionDepth;
+    gpu::FramebufferPointer _framebuffer;
+    gpu::PipelinePointer _pipeline;
+};
+
+class CullOccludedItemsConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(int numTested READ getNumTested NOTIFY dirty)
+    Q_PROPERTY(int numCulled READ getNumCulled NOTIFY dirty)
+    Q_PROPERTY(bool skipCulling MEMBER skipCulling NOTIFY dirty)
+public:
+    int getNumTested() const { return numTested; }
+    int getNumCulled() const { return numCulled; }
+
+    int numTested { 0 };
+    int numCulled { 0 };
+    bool skipCulling { false };
+
+signals:
+    void dirty();
+};
+
+// Removes the items hidden behind the OcclusionDepth.  The depth lags a frame or more behind, so an item that an
+// occluder moving out of its way uncovers can show up that much late.
+class CullOccludedItems {
+public:
+    using Config = CullOccludedItemsConfig;
+    using JobModel = render::Job::ModelIO<CullOccludedItems, render::ItemBounds, render::ItemBounds, Config>;
+
+    CullOccludedItems(const OcclusionDepthPointer& occlusionDepth) : _occlusionDepth(occlusionDepth) {}
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext, const render::ItemBounds& inItems, render::ItemBounds& outItems);
+
+private:
+    OcclusionDepthPointer _occlusionDepth;
+    bool _skipCulling { false };
+};
+
+#endif // hifi_OcclusionCulling_h
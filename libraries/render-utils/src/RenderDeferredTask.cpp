@@ -55,6 +55,9 @@
 #include "DrawHaze.h"
 #include "BloomEffect.h"
 #include "HighlightEffect.h"
+#include "OcclusionCulling.h"
+#include "AvatarImpostorEffect.h"
+#include "FoveationPass.h"
 
 #include <sstream>
 
@@ -158,16 +161,28 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     // draw a stencil mask in hidden regions of the framebuffer.
     task.addJob<PrepareStencil>("PrepareStencil", scaledPrimaryFramebuffer);
 
+    // Skip the opaque objects hidden behind the depth of the previous frames
+    auto occlusionDepth = std::make_shared<OcclusionDepth>();
+    const auto visibleOpaques = task.addJob<CullOccludedItems>("CullOccludedOpaques", opaques, occlusionDepth);
+
     // Render opaque objects in DeferredBuffer
-    const auto opaqueInputs = DrawStateSortDeferred::Inputs(opaques, lightingModel, jitter).asVarying();
+    const auto opaqueInputs = DrawStateSortDeferred::Inputs(visibleOpaques, lightingModel, jitter).asVarying();
     task.addJob<DrawStateSortDeferred>("DrawOpaqueDeferred", opaqueInputs, shapePlumber);
+    task.addJob<DrawAvatarImpostors>("DrawAvatarImpostors", jitter);
 
     // Opaque all rendered
 
+    // Leave half the pixels of the eyes' periphery out of the lighting, in an HMD
+    const auto isFoveated = task.addJob<FoveationMask>("FoveationMask", deferredFramebuffer);
+
     // Linear Depth Pass
     const auto linearDepthPassInputs = LinearDepthPass::Inputs(deferredFrameTransform, deferredFramebuffer).asVarying();
     const auto linearDepthPassOutputs = task.addJob<LinearDepthPass>("LinearDepth", linearDepthPassInputs);
     const auto linearDepthTarget = linearDepthPassOutputs.getN<LinearDepthPass::Outputs>(0);
+
+    // Read back the depth for the occlusion culling of the next frames
+    const auto buildOcclusionDepthInputs = BuildOcclusionDepth::Inputs(deferredFrameTransform, linearDepthTarget).asVarying();
+    task.addJob<BuildOcclusionDepth>("BuildOcclusionDepth", buildOcclusionDepthInputs, occlusionDepth);
     
     // Curvature pass
     const auto surfaceGeometryPassInputs = SurfaceGeometryPass::Inputs(deferredFrameTransform, deferredFramebuffer, linearDepthTarget).asVarying();
@@ -201,6 +216,9 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     const auto deferredLightingInputs = RenderDeferred::Inputs(deferredFrameTransform, deferredFramebuffer, extraDeferredBuffer, lightingModel, lightClusters, lightFrame, shadowFrame, hazeFrame).asVarying();
     task.addJob<RenderDeferred>("RenderDeferred", deferredLightingInputs);
 
+    const auto foveationFillInputs = FoveationFill::Inputs(isFoveated, deferredFramebuffer, linearDepthTarget).asVarying();
+    task.addJob<FoveationFill>("FoveationFill", foveationFillInputs);
+
     // Similar to light stage, background stage has been filled by several potential render items and resolved for the frame in this job
     const auto backgroundInputs = DrawBackgroundStage::Inputs(lightingModel, backgroundFrame, hazeFrame).asVarying();
     task.addJob<DrawBackgroundStage>("DrawBackgroundDeferred", backgroundInputs);
@@ -563,7 +581,7 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         args->_globalShapeKey = globalKey._flags.to_ulong();
 
         if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey, _mergeDraws);
         } else {
             renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
         }
@@ -63,6 +63,7 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool mergeDraws MEMBER mergeDraws NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -72,6 +73,8 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    // draw the state sorted shapes sharing buffers and material with one multiDrawIndexedIndirect
+    bool mergeDraws{ true };
 
 signals:
     void numDrawnChanged();
@@ -95,6 +98,7 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _mergeDraws = config.mergeDraws;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +106,7 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _mergeDraws;
 };
 
 class SetSeparateDeferredDepthBuffer {
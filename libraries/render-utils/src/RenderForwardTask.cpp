@@ -33,6 +33,8 @@
 #include "TextureCache.h"
 #include "RenderCommonTask.h"
 #include "RenderHUDLayerTask.h"
+#include "DeferredLightingEffect.h"
+#include "AvatarImpostorEffect.h"
 
 namespace ru {
     using render_utils::slot::texture::Texture;
@@ -114,8 +116,14 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     // Prepare deferred, generate the shared Deferred Frame Transform. Only valid with the scaled frame buffer
     const auto deferredFrameTransform = task.addJob<GenerateDeferredFrameTransform>("DeferredFrameTransform");
 
+    // Cluster the local lights in a froxel grid, the forward shading looks them up per fragment from there.
+    // There is no linear depth in forward, the clustering doesn't need it.
+    const auto nullLinearDepth = Varying(LinearDepthFramebufferPointer());
+    const auto lightClusteringPassInputs = LightClusteringPass::Input(deferredFrameTransform, lightingModel, lightFrame, nullLinearDepth).asVarying();
+    const auto lightClusters = task.addJob<LightClusteringPass>("LightClustering", lightClusteringPassInputs);
+
     // Prepare Forward Framebuffer pass 
-    const auto prepareForwardInputs = PrepareForward::Inputs(scaledPrimaryFramebuffer, lightFrame).asVarying();
+    const auto prepareForwardInputs = PrepareForward::Inputs(scaledPrimaryFramebuffer, lightFrame, lightClusters).asVarying();
     task.addJob<PrepareForward>("PrepareForward", prepareForwardInputs);
 
     // draw a stencil mask in hidden regions of the framebuffer.
@@ -124,6 +132,8 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     // Draw opaques forward
     const auto opaqueInputs = DrawForward::Inputs(opaques, lightingModel, hazeFrame).asVarying();
     task.addJob<DrawForward>("DrawOpaques", opaqueInputs, shapePlumber, true);
+    const auto nullJitter = Varying(glm::vec2(0.0f, 0.0f));
+    task.addJob<DrawAvatarImpostors>("DrawAvatarImpostors", nullJitter, true);
 
     // Similar to light stage, background stage has been filled by several potential render items and resolved for the frame in this job
     const auto backgroundInputs = DrawBackgroundStage::Inputs(lightingModel, backgroundFrame, hazeFrame).asVarying();
@@ -134,7 +144,6 @@ void RenderForwardTask::build(JobModel& task, const render::Varying& input, rend
     task.addJob<DrawForward>("DrawTransparents", transparentInputs, shapePlumber, false);
 
      // Layered
-    const auto nullJitter = Varying(glm::vec2(0.0f, 0.0f));
     const auto inFrontOpaquesInputs = DrawLayered3D::Inputs(inFrontOpaque, lightingModel, hazeFrame, nullJitter).asVarying();
     const auto inFrontTransparentsInputs = DrawLayered3D::Inputs(inFrontTransparent, lightingModel, hazeFrame, nullJitter).asVarying();
     task.addJob<DrawLayered3D>("DrawInFrontOpaque", inFrontOpaquesInputs, true);
@@ -209,6 +218,7 @@ void PrepareForward::run(const RenderContextPointer& renderContext, const Inputs
 
     auto primaryFramebuffer = inputs.get0();
     auto lightStageFrame = inputs.get1();
+    auto lightClusters = inputs.get2();
 
     gpu::doInBatch("RenderForward::Draw::run", args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
@@ -244,6 +254,10 @@ void PrepareForward::run(const RenderContextPointer& renderContext, const Inputs
                 batch.setResourceTexture(ru::Texture::Skybox, keyAmbiLight->getAmbientMap());
             }
         }
+
+        if (lightClusters) {
+            DeferredLightingEffect::setupLocalLightsBatch(batch, lightClusters);
+        }
     });
 }
 
@@ -290,7 +304,8 @@ void DrawForward::run(const RenderContextPointer& renderContext, const Inputs& i
 
         // Render items
         if (_opaquePass) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, -1, globalKey);
+            // as the deferred opaques, the shapes sharing buffers and material are drawn together, for both eyes at once
+            renderStateSortShapes(renderContext, _shapePlumber, inItems, -1, globalKey, true);
         } else {
             renderShapes(renderContext, _shapePlumber, inItems, -1, globalKey);
         }
@@ -16,6 +16,7 @@
 #include <render/RenderFetchCullSortTask.h>
 #include "AssembleLightingStageTask.h"
 #include "LightingModel.h"
+#include "LightClusters.h"
 
 class RenderForwardTaskConfig : public render::Task::Config {
     Q_OBJECT
@@ -79,7 +80,7 @@ private:
 
 class PrepareForward {
 public:
-    using Inputs = render::VaryingSet2 <gpu::FramebufferPointer, LightStage::FramePointer>;
+    using Inputs = render::VaryingSet3<gpu::FramebufferPointer, LightStage::FramePointer, LightClustersPointer>;
     using JobModel = render::Job::ModelI<PrepareForward, Inputs>;
 
     void run(const render::RenderContextPointer& renderContext,
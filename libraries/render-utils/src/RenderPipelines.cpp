@@ -20,6 +20,7 @@
 #include <shaders/Shaders.h>
 #include <graphics/ShaderConstants.h>
 #include <procedural/ReferenceMaterial.h>
+#include <RegisteredMetaTypes.h>
 
 #include "render-utils/ShaderConstants.h"
 #include "StencilMaskPass.h"
@@ -769,6 +770,19 @@ void RenderPipelines::updateMultiMaterial(graphics::MultiMaterial& multiMaterial
 
     schema._key = (uint32_t)schemaKey._flags.to_ulong();
     schemaBuffer.edit<graphics::MultiMaterial::Schema>() = schema;
+
+    // the schema is all 32 bit values, without padding
+    size_t contentHash = 0;
+    const uint32_t* schemaWords = reinterpret_cast<const uint32_t*>(&schema);
+    for (size_t i = 0; i < sizeof(schema) / sizeof(uint32_t); i++) {
+        std::hash_combine(contentHash, schemaWords[i]);
+    }
+    for (const auto& texture : drawMaterialTextures->getTextures()) {
+        std::hash_combine(contentHash, texture.get());
+    }
+    std::hash_combine(contentHash, (int)multiMaterial.getCullFaceMode());
+    multiMaterial.setContentHash(contentHash);
+
     multiMaterial.setNeedsUpdate(false);
     multiMaterial.setInitialized();
 }
@@ -11,6 +11,8 @@
 
 #include "RenderShadowTask.h"
 
+#include <mutex>
+
 #include <gpu/Context.h>
 
 #include <ViewFrustum.h>
@@ -29,6 +31,8 @@
 
 #include "FadeEffect.h"
 
+#include <shaders/Shaders.h>
+
 // These values are used for culling the objects rendered in the shadow map
 // but are readjusted afterwards
 #define SHADOW_FRUSTUM_NEAR 1.0f
@@ -88,6 +92,7 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
     };
 
     CascadeBoxes cascadeSceneBBoxes;
+    render::Varying cascadeShadowItems[SHADOW_CASCADE_MAX_COUNT];
 
     for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
         char jobName[64];
@@ -103,17 +108,21 @@ void RenderShadowTask::build(JobModel& task, const render::Varying& input, rende
         const auto cullInputs = CullShadowBounds::Inputs(sortedShapes, shadowFilter, antiFrustum, currentKeyLight, cascadeSetupOutput.getN<RenderShadowCascadeSetup::Outputs>(2)).asVarying();
         sprintf(jobName, "CullShadowCascade%d", i);
         const auto culledShadowItemsAndBounds = task.addJob<CullShadowBounds>(jobName, cullInputs);
-
-        // GPU jobs: Render to shadow map
-        sprintf(jobName, "RenderShadowMap%d", i);
-        const auto shadowInputs = RenderShadowMap::Inputs(culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(0),
-            culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1), shadowFrame).asVarying();
-        task.addJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i);
         sprintf(jobName, "ShadowCascadeTeardown%d", i);
         task.addJob<RenderShadowCascadeTeardown>(jobName, shadowFilter);
 
+        cascadeShadowItems[i] = culledShadowItemsAndBounds;
         cascadeSceneBBoxes[i] = culledShadowItemsAndBounds.getN<CullShadowBounds::Outputs>(1);
     }
+
+    // GPU jobs: Render to shadow maps, each cascade to its own so they can record at once
+    for (auto i = 0; i < SHADOW_CASCADE_MAX_COUNT; i++) {
+        char jobName[64];
+        sprintf(jobName, "RenderShadowMap%d", i);
+        const auto shadowInputs = RenderShadowMap::Inputs(cascadeShadowItems[i].getN<CullShadowBounds::Outputs>(0),
+            cascadeShadowItems[i].getN<CullShadowBounds::Outputs>(1), shadowFrame).asVarying();
+        task.addConcurrentJob<RenderShadowMap>(jobName, shadowInputs, shapePlumber, i);
+    }
     task.addJob<RenderShadowTeardown>("ShadowTeardown", setupOutput);
 
 
@@ -203,6 +212,73 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
     }
 }
 
+void RenderShadowMap::renderCasters(const render::RenderContextPointer& renderContext, const render::ShapeBounds& inShapes) {
+    RenderArgs* args = renderContext->args;
+
+    const std::vector<ShapeKey::Builder> keys = {
+        ShapeKey::Builder(), ShapeKey::Builder().withFade(),
+        ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
+        ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
+        ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
+        ShapeKey::Builder().withDeformed().withOwnPipeline(), ShapeKey::Builder().withDeformed().withOwnPipeline().withFade(),
+        ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline().withFade(),
+    };
+    std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
+
+    const int OWN_PIPELINE_INDEX = 6;
+    for (const auto& items : inShapes) {
+        int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
+        if (items.first.isDeformed()) {
+            index += 2;
+            if (items.first.isDualQuatSkinned()) {
+                index += 2;
+            }
+        }
+
+        if (items.first.isFaded()) {
+            index += 1;
+        }
+
+        sortedShapeKeys[index].push_back(items.first);
+    }
+
+    // Render non-withOwnPipeline things
+    for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
+        auto& shapeKeys = sortedShapeKeys[i];
+        if (shapeKeys.size() > 0) {
+            const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
+            args->_shapePipeline = shapePipeline;
+            for (const auto& key : shapeKeys) {
+                renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+            }
+        }
+    }
+
+    // Render withOwnPipeline things
+    for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
+        auto& shapeKeys = sortedShapeKeys[i];
+        if (shapeKeys.size() > 0) {
+            args->_shapePipeline = nullptr;
+            for (const auto& key : shapeKeys) {
+                args->_itemShapeKey = key._flags.to_ulong();
+                renderShapes(renderContext, _shapePlumber, inShapes.at(key));
+            }
+        }
+    }
+
+    args->_shapePipeline = nullptr;
+}
+
+const gpu::PipelinePointer& RenderShadowMap::getCopyStaticDepthPipeline() {
+    if (!_copyStaticDepthPipeline) {
+        gpu::ShaderPointer program = gpu::Shader::createProgram(shader::render_utils::program::shadow_copyCachedDepth);
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(true, true, gpu::ALWAYS);
+        _copyStaticDepthPipeline = gpu::Pipeline::create(program, state);
+    }
+    return _copyStaticDepthPipeline;
+}
+
 void RenderShadowMap::run(const render::RenderContextPointer& renderContext, const Inputs& inputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -216,6 +292,7 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
         shadow = shadowFrame->_objects.front();
     }
     if (!shadow || _cascadeIndex >= shadow->getCascadeCount()) {
+        _staticCastersValid = false;
         return;
     }
 
@@ -223,16 +300,82 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     auto& fbo = cascade.framebuffer;
 
     RenderArgs* args = renderContext->args;
-    auto adjustedShadowFrustum = args->getViewFrustum();
-
-    // Adjust the frustum near and far depths based on the rendered items bounding box to have
-    // the minimal Z range.
-    adjustNearFar(inShapeBounds, adjustedShadowFrustum);
-    // Reapply the frustum as it has been adjusted
-    shadow->setCascadeFrustum(_cascadeIndex, adjustedShadowFrustum);
-    args->popViewFrustum();
+    auto adjustedShadowFrustum = *cascade.getFrustum();
+    const bool cacheStaticCasters = shadow->areStaticCastersCached();
+
+    if (!cacheStaticCasters) {
+        _staticCastersValid = false;
+
+        // Adjust the frustum near and far depths based on the rendered items bounding box to have
+        // the minimal Z range.
+        adjustNearFar(inShapeBounds, adjustedShadowFrustum);
+        // Reapply the frustum as it has been adjusted, the cascades share the buffer of the shadow's schema
+        {
+            static std::mutex cascadeFrustumMutex;
+            std::lock_guard<std::mutex> lock(cascadeFrustumMutex);
+            shadow->setCascadeFrustum(_cascadeIndex, adjustedShadowFrustum);
+        }
+    }
     args->pushViewFrustum(adjustedShadowFrustum);
 
+    // The deformed casters pay their skinning again in each cascade, spare them the blendshapes past the first if asked to
+    const bool enableBlendshape = args->_enableBlendshape;
+    if (_cascadeIndex > 0 && !shadow->areFarCascadeBlendshapesEnabled()) {
+        args->_enableBlendshape = false;
+    }
+
+    // The cached cascades keep their depth range, the static casters depths wouldn't match otherwise. Split their casters
+    // in the static ones, drawn in the cache, and the ones that move, deform or fade, drawn each frame.
+    ShapeBounds staticShapes;
+    ShapeBounds dynamicShapes;
+    bool renderStaticCasters = false;
+    if (cacheStaticCasters) {
+        auto& scene = renderContext->_scene;
+        size_t staticCastersHash = 0;
+        for (const auto& items : inShapes) {
+            if (items.first.hasOwnPipeline() || items.first.isDeformed() || items.first.isFaded()) {
+                dynamicShapes.insert(items);
+                continue;
+            }
+            for (const auto& item : items.second) {
+                const auto itemKey = scene->getItem(item.id).getKey();
+                if (itemKey.isStatic() && !itemKey.isDeformed()) {
+                    staticShapes[items.first].push_back(item);
+                    // The same casters in any order
+                    staticCastersHash += std::hash<ItemID>()(item.id) * 0x9E3779B97F4A7C15ull + 1;
+                } else {
+                    dynamicShapes[items.first].push_back(item);
+                }
+            }
+        }
+
+        const auto& view = adjustedShadowFrustum.getView();
+        const auto& projection = adjustedShadowFrustum.getProjection();
+        bool staticCastersChanged = false;
+        for (const auto& bound : scene->getChangedStaticItemBounds()) {
+            if (adjustedShadowFrustum.boxIntersectsFrustum(bound)) {
+                staticCastersChanged = true;
+                break;
+            }
+        }
+
+        if (!_staticFramebuffer) {
+            auto depthFormat = gpu::Element(gpu::SCALAR, gpu::FLOAT, gpu::DEPTH);
+            auto depthTexture = gpu::Texture::createRenderBuffer(depthFormat, fbo->getWidth(), fbo->getHeight(), gpu::Texture::SINGLE_MIP,
+                gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_POINT));
+            _staticFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create("Shadowmap Static Casters"));
+            _staticFramebuffer->setDepthBuffer(depthTexture, depthFormat);
+            _staticCastersValid = false;
+        }
+
+        renderStaticCasters = !_staticCastersValid || staticCastersChanged || staticCastersHash != _staticCastersHash ||
+            view != _staticView || projection != _staticProjection;
+        _staticCastersValid = true;
+        _staticCastersHash = staticCastersHash;
+        _staticView = view;
+        _staticProjection = projection;
+    }
+
     gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
         batch.enableStereo(false);
@@ -241,74 +384,44 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
         batch.setViewportTransform(viewport);
         batch.setStateScissorRect(viewport);
 
-        batch.setFramebuffer(fbo);
-        batch.clearDepthFramebuffer(1.0, false);
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+
+        if (cacheStaticCasters) {
+            if (renderStaticCasters) {
+                batch.setFramebuffer(_staticFramebuffer);
+                batch.clearDepthFramebuffer(1.0, false);
+                batch.setProjectionTransform(projMat);
+                batch.setViewTransform(viewMat, false);
+                renderCasters(renderContext, staticShapes);
+            }
 
-        if (!inShapeBounds.isNull()) {
-            glm::mat4 projMat;
-            Transform viewMat;
-            args->getViewFrustum().evalProjectionMatrix(projMat);
-            args->getViewFrustum().evalViewTransform(viewMat);
+            batch.setFramebuffer(fbo);
+            batch.setPipeline(getCopyStaticDepthPipeline());
+            batch.setResourceTexture(0, _staticFramebuffer->getDepthStencilBuffer());
+            batch.draw(gpu::TRIANGLE_STRIP, 4);
+            batch.setResourceTexture(0, nullptr);
 
             batch.setProjectionTransform(projMat);
             batch.setViewTransform(viewMat, false);
+            renderCasters(renderContext, dynamicShapes);
+        } else {
+            batch.setFramebuffer(fbo);
+            batch.clearDepthFramebuffer(1.0, false);
 
-            const std::vector<ShapeKey::Builder> keys = {
-                ShapeKey::Builder(), ShapeKey::Builder().withFade(),
-                ShapeKey::Builder().withDeformed(), ShapeKey::Builder().withDeformed().withFade(),
-                ShapeKey::Builder().withDeformed().withDualQuatSkinned(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withFade(),
-                ShapeKey::Builder().withOwnPipeline(), ShapeKey::Builder().withOwnPipeline().withFade(),
-                ShapeKey::Builder().withDeformed().withOwnPipeline(), ShapeKey::Builder().withDeformed().withOwnPipeline().withFade(),
-                ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline(), ShapeKey::Builder().withDeformed().withDualQuatSkinned().withOwnPipeline().withFade(),
-            };
-            std::vector<std::vector<ShapeKey>> sortedShapeKeys(keys.size());
-
-            const int OWN_PIPELINE_INDEX = 6;
-            for (const auto& items : inShapes) {
-                int index = items.first.hasOwnPipeline() ? OWN_PIPELINE_INDEX : 0;
-                if (items.first.isDeformed()) {
-                    index += 2;
-                    if (items.first.isDualQuatSkinned()) {
-                        index += 2;
-                    }
-                }
-
-                if (items.first.isFaded()) {
-                    index += 1;
-                }
-
-                sortedShapeKeys[index].push_back(items.first);
-            }
-
-            // Render non-withOwnPipeline things
-            for (size_t i = 0; i < OWN_PIPELINE_INDEX; i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    const auto& shapePipeline = _shapePlumber->pickPipeline(args, keys[i]);
-                    args->_shapePipeline = shapePipeline;
-                    for (const auto& key : shapeKeys) {
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
-                }
-            }
-
-            // Render withOwnPipeline things
-            for (size_t i = OWN_PIPELINE_INDEX; i < keys.size(); i++) {
-                auto& shapeKeys = sortedShapeKeys[i];
-                if (shapeKeys.size() > 0) {
-                    args->_shapePipeline = nullptr;
-                    for (const auto& key : shapeKeys) {
-                        args->_itemShapeKey = key._flags.to_ulong();
-                        renderShapes(renderContext, _shapePlumber, inShapes.at(key));
-                    }
-                }
+            if (!inShapeBounds.isNull()) {
+                batch.setProjectionTransform(projMat);
+                batch.setViewTransform(viewMat, false);
+                renderCasters(renderContext, inShapes);
             }
-
-            args->_shapePipeline = nullptr;
         }
 
         args->_batch = nullptr;
     });
+    args->_enableBlendshape = enableBlendshape;
+    args->popViewFrustum();
 }
 
 RenderShadowSetup::RenderShadowSetup() :
@@ -328,6 +441,8 @@ void RenderShadowSetup::configure(const Config& config) {
     slopeBias3 = config.slopeBias3;
     biasInput = config.biasInput;
     maxDistance = config.maxDistance;
+    cacheStaticCasters = config.cacheStaticCasters;
+    farCascadeBlendshapes = config.farCascadeBlendshapes;
 }
 
 void RenderShadowSetup::calculateBiases(float biasInput) {
@@ -389,6 +504,8 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
         _globalShadowObject = std::make_shared<LightStage::Shadow>(currentKeyLight, SHADOW_CASCADE_MAX_COUNT);
     }
     _globalShadowObject->setLight(currentKeyLight);
+    _globalShadowObject->setStaticCastersCached(cacheStaticCasters);
+    _globalShadowObject->setFarCascadeBlendshapesEnabled(farCascadeBlendshapes);
     _globalShadowObject->setKeylightFrustum(args->getViewFrustum(), SHADOW_FRUSTUM_NEAR, SHADOW_FRUSTUM_FAR);
 
     // Update our biases and maxDistance from the light or config
@@ -443,8 +560,10 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
         auto cascadeRight = glm::dot(farBottomRight, cascadeFrustum->getRight());
         auto cascadeTop = glm::dot(farTopLeft, cascadeFrustum->getUp());
         auto cascadeBottom = glm::dot(farBottomRight, cascadeFrustum->getUp());
-        auto cascadeNear = cascadeFrustum->getNearClip();
-        auto cascadeFar = cascadeFrustum->getFarClip();
+        // The cached cascades are each snapped around their own center, not along the first cascade
+        auto cascadeDepthOffset = glm::dot(cascadeFrustum->getPosition() - frustumPosition, firstCascadeFrustum->getDirection());
+        auto cascadeNear = cascadeFrustum->getNearClip() + cascadeDepthOffset;
+        auto cascadeFar = cascadeFrustum->getFarClip() + cascadeDepthOffset;
         left = glm::min(left, cascadeLeft);
         right = glm::max(right, cascadeRight);
         bottom = glm::min(bottom, cascadeBottom);
@@ -495,7 +614,9 @@ void RenderShadowCascadeSetup::run(const render::RenderContextPointer& renderCon
             texelSize *= minTexelCount;
             cullFunctor._minSquareSize = texelSize * texelSize;
 
-            output.edit1() = cascadeFrustum;
+            // Cached cascades keep all their static casters, even those a nearer cascade covers, as which ones are
+            // changes as the view moves
+            output.edit1() = globalShadow->areStaticCastersCached() ? ViewFrustumPointer() : cascadeFrustum;
 
         } else {
             output.edit0() = ItemFilter::Builder::nothing();
@@ -35,6 +35,19 @@ public:
 protected:
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+
+    void renderCasters(const render::RenderContextPointer& renderContext, const render::ShapeBounds& inShapes);
+
+    // When the shadow caches its static casters, they are rendered here, only again once the cascade frustum, the set of
+    // static casters or one of them changed, and copied in the cascade before the dynamic casters render on top
+    gpu::FramebufferPointer _staticFramebuffer;
+    gpu::PipelinePointer _copyStaticDepthPipeline;
+    glm::mat4 _staticView;
+    glm::mat4 _staticProjection;
+    size_t _staticCastersHash { 0 };
+    bool _staticCastersValid { false };
+
+    const gpu::PipelinePointer& getCopyStaticDepthPipeline();
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -87,6 +100,8 @@ class RenderShadowSetupConfig : public render::Job::Config {
     Q_PROPERTY(float slopeBias3 MEMBER slopeBias3 NOTIFY dirty)
     Q_PROPERTY(float biasInput MEMBER biasInput NOTIFY dirty)
     Q_PROPERTY(float maxDistance MEMBER maxDistance NOTIFY dirty)
+    Q_PROPERTY(bool cacheStaticCasters MEMBER cacheStaticCasters NOTIFY dirty)
+    Q_PROPERTY(bool farCascadeBlendshapes MEMBER farCascadeBlendshapes NOTIFY dirty)
 
 public:
     // Set to > 0 to experiment with these values
@@ -100,6 +115,10 @@ public:
     float slopeBias3 { 0.0f };
     float biasInput { 0.0f };
     float maxDistance { 0.0f };
+    // Render the casters that neither move nor deform in cached shadow maps, redrawn only when they change
+    bool cacheStaticCasters { false };
+    // Evaluate the blendshapes of the deformed casters in all the cascades, clear to only do so in the first one
+    bool farCascadeBlendshapes { true };
 
 signals:
     void dirty();
@@ -138,6 +157,8 @@ private:
     float slopeBias3;
     float biasInput;
     float maxDistance;
+    bool cacheStaticCasters;
+    bool farCascadeBlendshapes;
 
     void setConstantBias(int cascadeIndex, float value);
     void setSlopeBias(int cascadeIndex, float value);
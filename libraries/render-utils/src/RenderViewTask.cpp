@@ -14,6 +14,8 @@
 #include "RenderCommonTask.h"
 #include "RenderDeferredTask.h"
 #include "RenderForwardTask.h"
+#include "RenderHifi.h"
+#include "AvatarImpostorEffect.h"
 
 void RenderShadowsAndDeferredTask::build(JobModel& task, const render::Varying& input, render::Varying& output, render::CullFunctor cullFunctor, uint8_t tagBits, uint8_t tagMask) {
     task.addJob<SetRenderMethod>("SetRenderMethodTask", render::Args::DEFERRED);
@@ -46,6 +48,13 @@ void RenderViewTask::build(JobModel& task, const render::Varying& input, render:
     // Assemble the lighting stages current frames
     const auto lightingStageFramesAndZones = task.addJob<AssembleLightingStageTask>("AssembleStages", items);
 
+    // The distant avatars are only impostors in the main view, capture them before it draws
+    if (tagBits == render::hifi::TAG_MAIN_VIEW) {
+        const auto lightFrame = lightingStageFramesAndZones.get<AssembleLightingStageTask::Output>().get0()[0];
+        const auto captureImpostorsInputs = CaptureAvatarImpostors::Inputs(lightingModel, lightFrame).asVarying();
+        task.addJob<CaptureAvatarImpostors>("CaptureAvatarImpostors", captureImpostorsInputs);
+    }
+
 #ifndef Q_OS_ANDROID
         const auto deferredForwardIn = DeferredForwardSwitchJob::Input(items, lightingModel, lightingStageFramesAndZones).asVarying();
         task.addJob<DeferredForwardSwitchJob>("DeferredForwardSwitch", deferredForwardIn, cullFunctor, tagBits, tagMask);
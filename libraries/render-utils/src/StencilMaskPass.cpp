@@ -141,6 +141,25 @@ void PrepareStencil::testShape(gpu::State& state) {
         gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP));
 }
 
+// Pass if this area WAS marked as SHAPE but NOT as FOVEATED
+// (see: FoveationPass.cpp)
+void PrepareStencil::testShapeNotFoveated(gpu::State& state) {
+    state.setStencilTest(true, 0x00, gpu::State::StencilTest(STENCIL_SHAPE, STENCIL_SHAPE | STENCIL_FOVEATED, gpu::EQUAL,
+        gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP));
+}
+
+// Pass if this area WAS marked as SHAPE and as FOVEATED
+void PrepareStencil::testShapeFoveated(gpu::State& state) {
+    state.setStencilTest(true, 0x00, gpu::State::StencilTest(STENCIL_SHAPE | STENCIL_FOVEATED, STENCIL_SHAPE | STENCIL_FOVEATED, gpu::EQUAL,
+        gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP));
+}
+
+// Pass if this area WAS marked as SHAPE, write to FOVEATED if it passes
+void PrepareStencil::testShapeDrawFoveated(gpu::State& state) {
+    state.setStencilTest(true, STENCIL_FOVEATED, gpu::State::StencilTest(STENCIL_SHAPE | STENCIL_FOVEATED, STENCIL_SHAPE, gpu::EQUAL,
+        gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_KEEP, gpu::State::STENCIL_OP_REPLACE));
+}
+
 // Pass if this area was NOT marked as MASK, write to SHAPE if it passes
 void PrepareStencil::testMaskDrawShape(gpu::State& state) {
     state.setStencilTest(true, STENCIL_SHAPE, gpu::State::StencilTest(STENCIL_MASK | STENCIL_SHAPE, STENCIL_MASK, gpu::NOT_EQUAL,
@@ -48,6 +48,7 @@ public:
     static const gpu::int8 STENCIL_MASK =       1 << 0;
     static const gpu::int8 STENCIL_SHAPE =      1 << 1;
     static const gpu::int8 STENCIL_NO_AA =      1 << 2;
+    static const gpu::int8 STENCIL_FOVEATED =   1 << 3;
 
     static void drawMask(gpu::State& state);
     static void drawBackground(gpu::State& state);
@@ -55,6 +56,9 @@ public:
     static void testNoAA(gpu::State& state);
     static void testBackground(gpu::State& state);
     static void testShape(gpu::State& state);
+    static void testShapeNotFoveated(gpu::State& state);
+    static void testShapeFoveated(gpu::State& state);
+    static void testShapeDrawFoveated(gpu::State& state);
     static void testMaskDrawShape(gpu::State& state);
     static void testMaskDrawShapeNoAA(gpu::State& state);
 
@@ -122,6 +122,11 @@
 #define RENDER_UTILS_BUFFER_BLOOM_PARAMS 1
 #define RENDER_UTILS_TEXTURE_BLOOM_COLOR 0
 
+// Foveation
+#define RENDER_UTILS_BUFFER_FOVEATION_PARAMS 0
+#define RENDER_UTILS_TEXTURE_FOVEATION_COLOR 0
+#define RENDER_UTILS_TEXTURE_FOVEATION_DEPTH 1
+
 // SDF Text rendering
 #define RENDER_UTILS_TEXTURE_TEXT_FONT 0
 #define RENDER_UTILS_UNIFORM_TEXT_COLOR 0
@@ -159,6 +164,7 @@ enum Buffer {
     SurfaceGeometryParams = RENDER_UTILS_BUFFER_SG_PARAMS,
     BlurParams = RENDER_UTILS_BUFFER_BLUR_PARAMS,
     BloomParams = RENDER_UTILS_BUFFER_BLOOM_PARAMS,
+    FoveationParams = RENDER_UTILS_BUFFER_FOVEATION_PARAMS,
     ToneMappingParams = RENDER_UTILS_BUFFER_TM_PARAMS,
     ShadowParams = RENDER_UTILS_BUFFER_SHADOW_PARAMS,
     DebugDeferredParams = RENDER_UTILS_BUFFER_DEBUG_DEFERRED_PARAMS,
@@ -199,6 +205,8 @@ enum Texture {
     BlurSource = RENDER_UTILS_TEXTURE_BLUR_SOURCE,
     BlurDepth = RENDER_UTILS_TEXTURE_BLUR_DEPTH,
     BloomColor = RENDER_UTILS_TEXTURE_BLOOM_COLOR,
+    FoveationColor = RENDER_UTILS_TEXTURE_FOVEATION_COLOR,
+    FoveationDepth = RENDER_UTILS_TEXTURE_FOVEATION_DEPTH,
     ToneMappingColor = RENDER_UTILS_TEXTURE_TM_COLOR,
     TextFont = RENDER_UTILS_TEXTURE_TEXT_FONT,
     AmbientFresnel = RENDER_UTILS_TEXTURE_AMBIENT_FRESNEL,
@@ -1,10 +1,13 @@
 #include "Font.h"
 
+#include <algorithm>
+
 #include <QFile>
 #include <QImage>
 #include <QNetworkReply>
 
 #include <ColorUtils.h>
+#include <RegisteredMetaTypes.h>
 
 #include <StreamHelpers.h>
 #include <shaders/Shaders.h>
@@ -21,6 +24,9 @@ static std::mutex fontMutex;
 
 std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> Font::_pipelines;
 gpu::Stream::FormatPointer Font::_format;
+gpu::BufferPointer Font::_quadIndices;
+uint32_t Font::_quadIndicesCount { 0 };
+const size_t Font::MIN_LAYOUT_PURGE_SIZE;
 
 struct TextureVertex {
     glm::vec2 pos;
@@ -235,6 +241,7 @@ void Font::read(QIODevice& in) {
     }
 
     _glyphs.clear();
+    _layouts.clear();
     glm::vec2 imageSize = toGlm(image.size());
     foreach(Glyph g, glyphs) {
         // Adjust the pixel texture coordinates into UV coordinates,
@@ -312,16 +319,87 @@ inline QuadBuilder adjustedQuadBuilderForAlignmentMode(const Glyph& glyph, glm::
     return QuadBuilder(glyph, advance, scale, enlargeForShadows);
 }
 
-void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
-                         TextAlignment alignment) {
-    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indexCount = 0;
-    int numVertices = 0;
+size_t Font::LayoutKey::Hash::operator()(const LayoutKey& key) const {
+    size_t hash = qHash(key.string);
+    std::hash_combine(hash, key.origin.x, key.origin.y, key.bounds.x, key.bounds.y, key.scale, (int)key.alignment,
+                      key.enlargeForShadows);
+    return hash;
+}
+
+Font::LayoutPointer Font::getLayout(const LayoutKey& key) {
+    auto cached = _layouts.find(key);
+    if (cached != _layouts.end()) {
+        auto layout = cached->second.lock();
+        if (layout) {
+            return layout;
+        }
+    }
+
+    auto layout = buildLayout(key);
+    _layouts[key] = layout;
+
+    // forget the layouts no text uses anymore, once there are twice as many as there were after the last time
+    if (_layouts.size() >= _layoutPurgeSize) {
+        for (auto it = _layouts.begin(); it != _layouts.end();) {
+            if (it->second.expired()) {
+                it = _layouts.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        _layoutPurgeSize = std::max(MIN_LAYOUT_PURGE_SIZE, 2 * _layouts.size());
+    }
+    return layout;
+}
+
+const gpu::BufferPointer& Font::getQuadIndices(uint32_t quadCount) {
+    if (quadCount > _quadIndicesCount) {
+        _quadIndicesCount = std::max(2 * _quadIndicesCount, quadCount);
 
-    drawInfo.string = str;
-    drawInfo.bounds = bounds;
-    drawInfo.origin = origin;
+        // Sam's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v3 };
+        // Triangle tri2 = { v1, v2, v3 };
+        // NOTE: Random guy on the internet's recommended triangle slices
+        // Triangle tri1 = { v0, v1, v2 };
+        // Triangle tri2 = { v2, v3, v0 };
+
+        // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
+        // Additionally, you want to ensure that the shared side vertices are used sequentially
+        // to improve cache locality
+        //
+        //  2 -- 3
+        //  |    |
+        //  |    |
+        //  0 -- 1
+        //
+        //  { 0, 1, 2 } -> { 2, 1, 3 }
+        std::vector<uint32_t> indices(_quadIndicesCount * NUMBER_OF_INDICES_PER_QUAD);
+        for (uint32_t quad = 0; quad < _quadIndicesCount; quad++) {
+            uint32_t verticesOffset = quad * VERTICES_PER_QUAD;
+            uint32_t* quadIndices = indices.data() + quad * NUMBER_OF_INDICES_PER_QUAD;
+            quadIndices[0] = verticesOffset + 0;
+            quadIndices[1] = verticesOffset + 1;
+            quadIndices[2] = verticesOffset + 2;
+            quadIndices[3] = verticesOffset + 2;
+            quadIndices[4] = verticesOffset + 1;
+            quadIndices[5] = verticesOffset + 3;
+        }
+        // a new buffer rather than a resize, as the batches already recorded still draw from the old one
+        _quadIndices = std::make_shared<gpu::Buffer>(indices.size() * sizeof(uint32_t), (const gpu::Byte*)indices.data());
+    }
+    return _quadIndices;
+}
+
+Font::LayoutPointer Font::buildLayout(const LayoutKey& key) {
+    const QString& str = key.string;
+    const glm::vec2& origin = key.origin;
+    const glm::vec2& bounds = key.bounds;
+    float scale = key.scale;
+    bool enlargeForShadows = key.enlargeForShadows;
+    TextAlignment alignment = key.alignment;
+
+    auto layout = std::make_shared<Layout>();
+    layout->verticesBuffer = std::make_shared<gpu::Buffer>();
 
     float enlargedBoundsX = bounds.x - 0.5f * DOUBLE_MAX_OFFSET_PIXELS * float(enlargeForShadows);
     float rightEdge = origin.x + enlargedBoundsX;
@@ -399,38 +477,12 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
     }
 
     // The quadBuilders is backwards now because we looped over the glyphs backwards to adjust their alignment
-    for (int i = quadBuilders.size() - 1; i >= 0; i--) {
-        quint16 verticesOffset = numVertices;
-        drawInfo.verticesBuffer->append(quadBuilders[i]);
-        numVertices += VERTICES_PER_QUAD;
-
-        // Sam's recommended triangle slices
-        // Triangle tri1 = { v0, v1, v3 };
-        // Triangle tri2 = { v1, v2, v3 };
-        // NOTE: Random guy on the internet's recommended triangle slices
-        // Triangle tri1 = { v0, v1, v2 };
-        // Triangle tri2 = { v2, v3, v0 };
-
-        // The problem here being that the 4 vertices are { ll, lr, ul, ur }, a Z pattern
-        // Additionally, you want to ensure that the shared side vertices are used sequentially
-        // to improve cache locality
-        //
-        //  2 -- 3
-        //  |    |
-        //  |    |
-        //  0 -- 1
-        //
-        //  { 0, 1, 2 } -> { 2, 1, 3 }
-        quint16 indices[NUMBER_OF_INDICES_PER_QUAD];
-        indices[0] = verticesOffset + 0;
-        indices[1] = verticesOffset + 1;
-        indices[2] = verticesOffset + 2;
-        indices[3] = verticesOffset + 2;
-        indices[4] = verticesOffset + 1;
-        indices[5] = verticesOffset + 3;
-        drawInfo.indicesBuffer->append(sizeof(indices), (const gpu::Byte*)indices);
-        drawInfo.indexCount += NUMBER_OF_INDICES_PER_QUAD;
+    std::reverse(quadBuilders.begin(), quadBuilders.end());
+    if (!quadBuilders.empty()) {
+        layout->verticesBuffer->append(quadBuilders);
     }
+    layout->quadCount = (uint32_t)quadBuilders.size();
+    return layout;
 }
 
 void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
@@ -443,13 +495,20 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     int textEffect = (int)effect;
     const int SHADOW_EFFECT = (int)TextEffect::SHADOW_EFFECT;
 
-    // If we're switching to or from shadow effect mode, we need to rebuild the vertices
-    if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != _alignment ||
+    // If we're switching to or from shadow effect mode, we need other vertices
+    if (!drawInfo.layout || str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != drawInfo.alignment ||
             (drawInfo.params.effect != textEffect && (textEffect == SHADOW_EFFECT || drawInfo.params.effect == SHADOW_EFFECT)) ||
-            (textEffect == SHADOW_EFFECT && scale != _scale)) {
-        _scale = scale;
-        _alignment = alignment;
-        buildVertices(drawInfo, str, origin, bounds, scale, textEffect == SHADOW_EFFECT, alignment);
+            (textEffect == SHADOW_EFFECT && scale != drawInfo.scale)) {
+        drawInfo.string = str;
+        drawInfo.bounds = bounds;
+        drawInfo.origin = origin;
+        drawInfo.scale = scale;
+        drawInfo.alignment = alignment;
+        bool enlargeForShadows = textEffect == SHADOW_EFFECT;
+        drawInfo.layout = getLayout({ str, origin, bounds, enlargeForShadows ? scale : 0.0f, alignment, enlargeForShadows });
+    }
+    if (drawInfo.layout->quadCount == 0) {
+        return;
     }
 
     setupGPU();
@@ -475,9 +534,9 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
 
     batch.setPipeline(_pipelines[std::make_tuple(color.a < 1.0f, unlit, forward)]);
     batch.setInputFormat(_format);
-    batch.setInputBuffer(0, drawInfo.verticesBuffer, 0, _format->getChannels().at(0)._stride);
+    batch.setInputBuffer(0, drawInfo.layout->verticesBuffer, 0, _format->getChannels().at(0)._stride);
     batch.setResourceTexture(render_utils::slot::texture::TextFont, _texture);
     batch.setUniformBuffer(0, drawInfo.paramsBuffer, 0, sizeof(DrawParams));
-    batch.setIndexBuffer(gpu::UINT16, drawInfo.indicesBuffer, 0);
-    batch.drawIndexed(gpu::TRIANGLES, drawInfo.indexCount, 0);
+    batch.setIndexBuffer(gpu::UINT32, getQuadIndices(drawInfo.layout->quadCount), 0);
+    batch.drawIndexed(gpu::TRIANGLES, drawInfo.layout->quadCount * NUMBER_OF_INDICES_PER_QUAD, 0);
 }
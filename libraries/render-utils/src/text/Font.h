@@ -10,6 +10,8 @@
 #ifndef hifi_Font_h
 #define hifi_Font_h
 
+#include <unordered_map>
+
 #include <QObject>
 
 #include "Glyph.h"
@@ -42,15 +44,22 @@ public:
         vec3 _spare;
     };
 
-    struct DrawInfo {
+    // The quads of a string laid out in a box, shared by all that draw the same string in the same way
+    struct Layout {
         gpu::BufferPointer verticesBuffer { nullptr };
-        gpu::BufferPointer indicesBuffer { nullptr };
+        uint32_t quadCount { 0 };
+    };
+    using LayoutPointer = std::shared_ptr<const Layout>;
+
+    struct DrawInfo {
+        LayoutPointer layout { nullptr };
         gpu::BufferPointer paramsBuffer { nullptr };
-        uint32_t indexCount;
 
         QString string;
         glm::vec2 origin;
         glm::vec2 bounds;
+        float scale { 0.0f };
+        TextAlignment alignment { TextAlignment::LEFT };
         DrawParams params;
     };
 
@@ -76,11 +85,30 @@ private:
     QStringList splitLines(const QString& str) const;
     glm::vec2 computeTokenExtent(const QString& str) const;
 
+    struct LayoutKey {
+        QString string;
+        glm::vec2 origin;
+        glm::vec2 bounds;
+        float scale; // only matters to the enlarged quads of shadows, 0 otherwise
+        TextAlignment alignment;
+        bool enlargeForShadows;
+
+        bool operator==(const LayoutKey& other) const {
+            return string == other.string && origin == other.origin && bounds == other.bounds && scale == other.scale &&
+                alignment == other.alignment && enlargeForShadows == other.enlargeForShadows;
+        }
+
+        struct Hash {
+            size_t operator()(const LayoutKey& key) const;
+        };
+    };
+
     const Glyph& getGlyph(const QChar& c) const;
-    void buildVertices(DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
-                       TextAlignment alignment);
+    LayoutPointer getLayout(const LayoutKey& key);
+    LayoutPointer buildLayout(const LayoutKey& key);
 
     void setupGPU();
+    static const gpu::BufferPointer& getQuadIndices(uint32_t quadCount);
 
     // maps characters to cached glyph info
     // HACK... the operator[] const for QHash returns a
@@ -97,16 +125,21 @@ private:
     float _descent { 0.0f };
     float _spaceWidth { 0.0f };
 
-    float _scale { 0.0f };
-    TextAlignment _alignment;
-
     bool _loaded { true };
 
+    // the layouts in use, so that the texts that say the same thing lay it out once
+    static const size_t MIN_LAYOUT_PURGE_SIZE = 64;
+    std::unordered_map<LayoutKey, std::weak_ptr<const Layout>, LayoutKey::Hash> _layouts;
+    size_t _layoutPurgeSize { MIN_LAYOUT_PURGE_SIZE };
+
     gpu::TexturePointer _texture;
     gpu::BufferStreamPointer _stream;
 
     static std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> _pipelines;
     static gpu::Stream::FormatPointer _format;
+    // every quad is indexed alike, so all the strings share one buffer long enough for the longest
+    static gpu::BufferPointer _quadIndices;
+    static uint32_t _quadIndicesCount;
 };
 
 #endif
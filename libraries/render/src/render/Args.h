@@ -143,6 +143,9 @@ namespace render {
         bool _takingSnapshot { false };
         StencilMaskMode _stencilMaskMode { StencilMaskMode::NONE };
         std::function<void(gpu::Batch&)> _stencilMaskOperator;
+
+        // where each eye's full rate shading is centered, in [0, 1] over the eye's half of the viewport
+        glm::vec2 _foveationCenters[2] { { 0.5f, 0.5f }, { 0.5f, 0.5f } };
     };
 
 }
@@ -12,10 +12,12 @@
 #include "DrawTask.h"
 
 #include <algorithm>
+#include <atomic>
 #include <assert.h>
 
 #include <LogHandler.h>
 #include <PerfStat.h>
+#include <RegisteredMetaTypes.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
 #include <shaders/Shaders.h>
@@ -80,11 +82,131 @@ void render::renderShapes(const RenderContextPointer& renderContext,
     }
 }
 
+static const size_t INDIRECT_COMMAND_BUFFER = 0;
+
+// The named calls the draws of a pipeline bucket are merged into, by the key they merge under. Draws whose keys collide
+// without them matching each get a call of their own, and each bucket drawn gets its own names, since matching draws
+// are only looked for within the bucket.
+struct MergedCall {
+    IndirectDraw draw;
+    std::string name;
+};
+using MergedCalls = std::unordered_map<size_t, std::vector<MergedCall>>;
+
+// Finds the call the draw merges into, or adds one for it if it's the first of them. \return true if the call is new
+static std::string getMergedCallPrefix(const char* kind, const ShapePipelinePointer& shapePipeline) {
+    static std::atomic<uint64_t> bucketsDrawn { 0 };
+    return kind + std::to_string(std::hash<ShapePipelinePointer>()(shapePipeline)) + "_" + std::to_string(bucketsDrawn++) + "_";
+}
+
+template <typename F>
+static bool findMergedCall(MergedCalls& calls, size_t key, const IndirectDraw& draw, F canMerge, const std::string& prefix,
+                           std::string& name) {
+    auto& candidates = calls[key];
+    for (const auto& call : candidates) {
+        if (canMerge(call.draw)) {
+            name = call.name;
+            return false;
+        }
+    }
+    name = prefix + std::to_string(key) + "_" + std::to_string(candidates.size());
+    candidates.push_back({ draw, name });
+    return true;
+}
+
+// Renders the shapes of a pipeline bucket, merging the draws of the ones with the same batchKey into a single
+// multiDrawIndexedIndirect.  The merged draws go through the batch's named calls, which record a transform per draw
+// and give the draws their own with the baseInstance of their commands.  In stereo each command draws two instances,
+// one per eye, which the backend's instanced stereo gives the same transform by halving the rate of the draw infos.
+static void renderIndirectShapes(RenderArgs* args, const ShapeKey& key, const std::vector<Item>& items, bool isStereo) {
+    auto& batch = *(args->_batch);
+    const auto shapePipeline = args->_shapePipeline;
+    const std::string callPrefix = getMergedCallPrefix("indirect_shapes_", shapePipeline);
+    MergedCalls mergedCalls;
+    std::string callName;
+
+    IndirectDraw draw;
+    for (auto& item : items) {
+        if (!item.getIndirectDraw(args, draw)) {
+            shapePipeline->prepareShapeItem(args, key, item);
+            item.render(args);
+            continue;
+        }
+
+        auto canMerge = [&](const IndirectDraw& other) { return draw.canMergeWith(other); };
+        gpu::Batch::NamedBatchData::Function function;
+        if (findMergedCall(mergedCalls, draw.batchKey, draw, canMerge, callPrefix, callName)) {
+            function = [args, shapePipeline, bind = draw.bind](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+                batch.setPipeline(shapePipeline->pipeline);
+                shapePipeline->prepare(batch, args);
+                bind(batch, 0);
+                batch.setIndirectBuffer(data.buffers[INDIRECT_COMMAND_BUFFER], 0, sizeof(gpu::Batch::DrawIndexedIndirectCommand));
+                batch.multiDrawIndexedIndirect((uint32_t)data.count(), gpu::TRIANGLES);
+            };
+        }
+
+        const auto& commandBuffer = batch.getNamedBuffer(callName, INDIRECT_COMMAND_BUFFER);
+        gpu::Batch::DrawIndexedIndirectCommand command;
+        command._count = draw.numIndices;
+        command._instanceCount = isStereo ? 2 : 1;
+        command._firstIndex = draw.startIndex;
+        command._baseVertex = draw.baseVertex;
+        command._baseInstance = (uint32_t)(commandBuffer->getSize() / sizeof(gpu::Batch::DrawIndexedIndirectCommand));
+        commandBuffer->append(command);
+
+        batch.setModelTransform(draw.transform);
+        batch.setupNamedCalls(callName, function);
+    }
+}
+
+// Renders the shapes of a pipeline bucket, drawing the ones with the same batchKey and the same part of their buffers as
+// instances of a single drawIndexedInstanced.  Like the GeometryCache shape instances, the instances go through the
+// batch's named calls, which record a transform per instance, so this works on every backend and in stereo.
+static void renderInstancedShapes(RenderArgs* args, const ShapeKey& key, const std::vector<Item>& items) {
+    auto& batch = *(args->_batch);
+    const auto shapePipeline = args->_shapePipeline;
+    const std::string callPrefix = getMergedCallPrefix("instanced_shapes_", shapePipeline);
+    MergedCalls mergedCalls;
+    std::string callName;
+
+    IndirectDraw draw;
+    for (auto& item : items) {
+        if (!item.getIndirectDraw(args, draw)) {
+            shapePipeline->prepareShapeItem(args, key, item);
+            item.render(args);
+            continue;
+        }
+
+        size_t instanceKey = draw.batchKey;
+        std::hash_combine(instanceKey, draw.startIndex, draw.numIndices, draw.baseVertex);
+        auto canMerge = [&](const IndirectDraw& other) {
+            return draw.canMergeWith(other) && draw.startIndex == other.startIndex && draw.numIndices == other.numIndices &&
+                draw.baseVertex == other.baseVertex;
+        };
+        gpu::Batch::NamedBatchData::Function function;
+        if (findMergedCall(mergedCalls, instanceKey, draw, canMerge, callPrefix, callName)) {
+            function = [args, shapePipeline, bind = draw.bind, numIndices = draw.numIndices, startIndex = draw.startIndex,
+                        baseVertex = draw.baseVertex](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+                batch.setPipeline(shapePipeline->pipeline);
+                shapePipeline->prepare(batch, args);
+                bind(batch, baseVertex);
+                batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, numIndices, startIndex);
+            };
+        }
+
+        batch.setModelTransform(draw.transform);
+        batch.setupNamedCalls(callName, function);
+    }
+}
+
 void render::renderStateSortShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey, bool mergeDraws) {
     auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
+    bool indirectDraws = mergeDraws && args->_context->getBackend()->supportsMultiDrawIndirect();
+    bool isStereo = args->isStereo() && args->_batch->isStereoEnabled();
+
     int numItemsToDraw = (int)inItems.size();
     if (maxDrawnItems != -1) {
         numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
@@ -125,6 +247,15 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
             continue;
         }
         args->_itemShapeKey = pipelineKey._flags.to_ulong();
+        // faded shapes set up their fade for each draw
+        if (mergeDraws && !pipelineKey.isFaded()) {
+            if (indirectDraws) {
+                renderIndirectShapes(args, pipelineKey, bucket, isStereo);
+            } else {
+                renderInstancedShapes(args, pipelineKey, bucket);
+            }
+            continue;
+        }
         for (auto& item : bucket) {
             args->_shapePipeline->prepareShapeItem(args, pipelineKey, item);
             item.render(args);
@@ -18,7 +18,10 @@ namespace render {
 
 void renderItems(const RenderContextPointer& renderContext, const ItemBounds& inItems, int maxDrawnItems = -1);
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
-void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+// With mergeDraws, the shapes of a pipeline that share their buffers and material are drawn together by a
+// multiDrawIndexedIndirect, in a single pass for both eyes in stereo, when the backend supports it, otherwise the ones
+// also drawing the same part of those buffers are drawn as instances of a drawIndexedInstanced.
+void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey(), bool mergeDraws = false);
 
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
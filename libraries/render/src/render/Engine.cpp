@@ -36,8 +36,66 @@ public:
     }
 };
 
+task::JobContextPointer RenderContext::fork() const {
+    if (!concurrentJobs || !args) {
+        return nullptr;
+    }
+    auto fork = std::make_shared<RenderContext>();
+    fork->_forkArgs = std::make_shared<RenderArgs>(*args);
+    fork->_forkArgs->_batch = nullptr;
+    fork->_forkArgs->_details = RenderDetails();
+    fork->args = fork->_forkArgs.get();
+    fork->_scene = _scene;
+    fork->gpuJobTimers = gpuJobTimers;
+    return fork;
+}
+
+void RenderContext::runFork(const std::function<void()>& run) {
+    auto threadBatches = gpu::Context::setThreadBatches(&_forkBatches);
+    run();
+    gpu::Context::setThreadBatches(threadBatches);
+}
+
+static void addItemDetails(RenderDetails::Item& item, const RenderDetails::Item& other) {
+    item._considered += other._considered;
+    item._outOfView += other._outOfView;
+    item._tooSmall += other._tooSmall;
+    item._rendered += other._rendered;
+}
+
+void RenderContext::join(const std::vector<task::JobContextPointer>& forks) {
+    // The batches go to the frame in the order of the jobs, whichever finished first
+    for (const auto& jobFork : forks) {
+        auto fork = std::static_pointer_cast<RenderContext>(jobFork);
+        for (const auto& batch : fork->_forkBatches) {
+            args->_context->appendFrameBatch(batch);
+        }
+        fork->_forkBatches.clear();
+
+        const auto& details = fork->args->_details;
+        args->_details._materialSwitches += details._materialSwitches;
+        args->_details._trianglesRendered += details._trianglesRendered;
+        addItemDetails(args->_details._item, details._item);
+        addItemDetails(args->_details._shadow, details._shadow);
+        addItemDetails(args->_details._other, details._other);
+    }
+}
+
+void RenderContext::beginJob(task::JobConcept& job) {
+    if (gpuJobTimers && args) {
+        gpuJobTimers->begin(job, args->_context);
+    }
+}
+
+void RenderContext::endJob(task::JobConcept& job) {
+    if (gpuJobTimers && args) {
+        gpuJobTimers->end(job, args->_context);
+    }
+}
+
 RenderEngine::RenderEngine() : Engine(EngineTask::JobModel::create("Engine"), std::make_shared<RenderContext>())
 {
+    _context->gpuJobTimers = std::make_shared<GPUJobTimers>();
 }
 
 void RenderEngine::load() {
@@ -17,6 +17,7 @@
 #include <gpu/Batch.h>
 #include <task/Task.h>
 
+#include "GPUJobTimers.h"
 #include "Scene.h"
 
 namespace render {
@@ -30,6 +31,24 @@ namespace render {
 
         RenderArgs* args;
         ScenePointer _scene;
+
+        // Lets the jobs added with addConcurrentJob record their batches at once, each with a copy of the args, as long
+        // as the items they render can be rendered from several threads
+        bool concurrentJobs { false };
+
+        // Times the GPU work of each job, if set
+        GPUJobTimersPointer gpuJobTimers;
+
+        task::JobContextPointer fork() const override;
+        void runFork(const std::function<void()>& run) override;
+        void join(const std::vector<task::JobContextPointer>& forks) override;
+
+        void beginJob(task::JobConcept& job) override;
+        void endJob(task::JobConcept& job) override;
+
+    protected:
+        std::shared_ptr<RenderArgs> _forkArgs;
+        std::vector<gpu::BatchPointer> _forkBatches;
     };
     using RenderContextPointer = std::shared_ptr<RenderContext>;
 
@@ -98,6 +117,9 @@ namespace render {
         // acces the RenderContext
         RenderContextPointer getRenderContext() const { return _context; }
 
+        // The GPU times of the jobs, for the stats and scripts
+        const GPUJobTimersPointer& getGPUJobTimers() const { return _context->gpuJobTimers; }
+
     protected:
     };
     using EnginePointer = std::shared_ptr<RenderEngine>;
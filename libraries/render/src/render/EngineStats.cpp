@@ -45,6 +45,7 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
 
     config->texturePendingGPUTransferCount = gpu::Context::getTexturePendingGPUTransferCount();
     config->texturePendingGPUTransferSize = gpu::Context::getTexturePendingGPUTransferMemSize();
+    config->textureFrameGPUTransferSize = gpu::Context::getTextureFrameGPUTransferMemSize();
 
     config->textureResourcePopulatedGPUMemSize = gpu::Context::getTextureResourcePopulatedGPUMemSize();
 
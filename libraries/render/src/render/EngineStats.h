@@ -45,6 +45,7 @@ namespace render {
 
         Q_PROPERTY(quint32 texturePendingGPUTransferCount MEMBER texturePendingGPUTransferCount NOTIFY newStats)
         Q_PROPERTY(qint64 texturePendingGPUTransferSize MEMBER texturePendingGPUTransferSize NOTIFY newStats)
+        Q_PROPERTY(qint64 textureFrameGPUTransferSize MEMBER textureFrameGPUTransferSize NOTIFY newStats)
         Q_PROPERTY(qint64 textureResourcePopulatedGPUMemSize MEMBER textureResourcePopulatedGPUMemSize NOTIFY newStats)
 
         Q_PROPERTY(quint32 frameAPIDrawcallCount MEMBER frameAPIDrawcallCount NOTIFY newStats)
@@ -85,6 +86,7 @@ namespace render {
         qint64 textureResourceGPUMemSize { 0 };
         qint64 textureExternalGPUMemSize { 0 };
         qint64 texturePendingGPUTransferSize { 0 };
+        qint64 textureFrameGPUTransferSize { 0 };
         qint64 textureResourcePopulatedGPUMemSize { 0 };
 
         quint32 frameAPIDrawcallCount{ 0 };
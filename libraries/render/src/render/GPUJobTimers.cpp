@@ -0,0 +1,134 @@
+//
+//  GPUJobTimers.cpp
+//  render/src/render
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GPUJobTimers.h"
+
+#include <algorithm>
+
+#include <gpu/Context.h>
+#include <task/Task.h>
+
+using namespace render;
+
+const std::array<float, 7> GPUJobTimers::HISTOGRAM_BOUNDS {{ 0.05f, 0.1f, 0.25f, 0.5f, 1.0f, 2.0f, 4.0f }};
+
+GPUJobTimers::GPUJobTimers() {
+#if defined(Q_OS_MAC)
+    _enabled = false;
+#else
+    _enabled = true;
+#endif
+}
+
+// the job's path through the configs, from the engine down
+static std::string getJobPath(task::JobConcept& job) {
+    std::string path = job.getName();
+    auto config = job.getConfiguration();
+    for (QObject* parent = config ? config->parent() : nullptr; parent; parent = parent->parent()) {
+        if (!parent->objectName().isEmpty()) {
+            path = parent->objectName().toStdString() + "." + path;
+        }
+    }
+    return path;
+}
+
+GPUJobTimers::TimerPointer GPUJobTimers::getTimer(task::JobConcept& job) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& timer = _timers[&job];
+    if (!timer) {
+        timer = std::make_shared<Timer>();
+        timer->path = getJobPath(job);
+        timer->isTask = job.getConfiguration() && job.getConfiguration()->isTask();
+        // the timers live as long as the engine, so their queries hold them by pointer, as a RangeTimer's queries hold it
+        Timer* rawTimer = timer.get();
+        timer->rangeTimer = std::make_shared<gpu::RangeTimer>(timer->path, [this, rawTimer](double gpuTime, double batchTime) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            rawTimer->samples[rawTimer->nextSample] = (float)gpuTime;
+            rawTimer->nextSample = (rawTimer->nextSample + 1) % HISTORY_SIZE;
+            if (rawTimer->numSamples < HISTORY_SIZE) {
+                ++rawTimer->numSamples;
+            }
+        });
+        _timersInOrder.push_back(timer);
+    }
+    return timer;
+}
+
+void GPUJobTimers::begin(task::JobConcept& job, const gpu::ContextPointer& context) {
+    if (!_enabled || !context) {
+        return;
+    }
+    auto config = job.getConfiguration();
+    if (config && !config->isEnabled()) {
+        return;
+    }
+
+    auto timer = getTimer(job);
+    timer->begun = true;
+    gpu::doInBatch("GPUJobTimers::begin", context, [&](gpu::Batch& batch) {
+        timer->rangeTimer->begin(batch);
+    });
+}
+
+void GPUJobTimers::end(task::JobConcept& job, const gpu::ContextPointer& context) {
+    TimerPointer timer;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _timers.find(&job);
+        if (found == _timers.end() || !found->second->begun) {
+            return;
+        }
+        timer = found->second;
+    }
+
+    timer->begun = false;
+    gpu::doInBatch("GPUJobTimers::end", context, [&](gpu::Batch& batch) {
+        timer->rangeTimer->end(batch);
+    });
+}
+
+std::vector<GPUJobTimers::Stats> GPUJobTimers::getStats() const {
+    std::vector<Stats> result;
+    std::vector<float> samples;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    result.reserve(_timersInOrder.size());
+    for (const auto& timer : _timersInOrder) {
+        Stats stats;
+        stats.path = timer->path;
+        stats.isTask = timer->isTask;
+        stats.numSamples = (uint32_t)timer->numSamples;
+        if (timer->numSamples > 0) {
+            samples.assign(timer->samples.begin(), timer->samples.begin() + timer->numSamples);
+            float total = 0.0f;
+            for (auto sample : samples) {
+                total += sample;
+                auto bound = std::lower_bound(HISTOGRAM_BOUNDS.begin(), HISTOGRAM_BOUNDS.end(), sample);
+                ++stats.histogram[bound - HISTOGRAM_BOUNDS.begin()];
+            }
+            stats.average = total / (float)samples.size();
+            std::sort(samples.begin(), samples.end());
+            stats.median = samples[samples.size() / 2];
+            stats.percentile95 = samples[(samples.size() * 95) / 100];
+            stats.max = samples.back();
+        }
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void GPUJobTimers::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& timer : _timersInOrder) {
+        timer->numSamples = 0;
+        timer->nextSample = 0;
+    }
+}
@@ -0,0 +1,95 @@
+//
+//  GPUJobTimers.h
+//  render/src/render
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_GPUJobTimers_h
+#define hifi_render_GPUJobTimers_h
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gpu/Forward.h>
+#include <gpu/Query.h>
+
+namespace task {
+    class JobConcept;
+}
+
+namespace render {
+
+    // Times the GPU work of every job the render engine runs, each with a gpu::RangeTimer begun before the job's batches
+    // and ended after them. The timers' queries are only read once the GPU has them, a few frames later, so timing
+    // never stalls a frame; the times of the last frames of each job are kept for percentiles and a histogram.
+    //   The jobs' ranges nest, a task's holding its jobs', which the backends time with timestamps (except on macOS,
+    // where only the outermost range is timed, so the timers start disabled there).
+    class GPUJobTimers {
+    public:
+        static const size_t HISTORY_SIZE { 256 };
+
+        // the upper bounds of the histogram's buckets in msecs, the last bucket taking the rest
+        static const std::array<float, 7> HISTOGRAM_BOUNDS;
+        static const size_t HISTOGRAM_SIZE { 8 };
+
+        struct Stats {
+            std::string path; // the job's config path, as Render.getConfig takes it
+            bool isTask { false }; // whose time includes its jobs'
+            uint32_t numSamples { 0 };
+            float average { 0.0f }; // msecs, over the samples kept
+            float median { 0.0f };
+            float percentile95 { 0.0f };
+            float max { 0.0f };
+            std::array<uint32_t, HISTOGRAM_SIZE> histogram {};
+        };
+
+        GPUJobTimers();
+
+        void setEnabled(bool enabled) { _enabled = enabled; }
+        bool isEnabled() const { return _enabled; }
+
+        // called around the run of each job, on the thread recording its batches
+        void begin(task::JobConcept& job, const gpu::ContextPointer& context);
+        void end(task::JobConcept& job, const gpu::ContextPointer& context);
+
+        // the stats of every job that has been timed, in the order they were first run
+        std::vector<Stats> getStats() const;
+
+        // forgets the times recorded so far
+        void reset();
+
+    private:
+        struct Timer {
+            std::string path;
+            bool isTask { false };
+            gpu::RangeTimerPointer rangeTimer;
+            std::array<float, HISTORY_SIZE> samples;
+            size_t numSamples { 0 };
+            size_t nextSample { 0 };
+            bool begun { false };
+        };
+        using TimerPointer = std::shared_ptr<Timer>;
+
+        TimerPointer getTimer(task::JobConcept& job);
+
+        std::atomic<bool> _enabled;
+
+        mutable std::mutex _mutex;
+        std::unordered_map<const task::JobConcept*, TimerPointer> _timers;
+        std::vector<TimerPointer> _timersInOrder;
+    };
+    using GPUJobTimersPointer = std::shared_ptr<GPUJobTimers>;
+
+}
+
+#endif // hifi_render_GPUJobTimers_h
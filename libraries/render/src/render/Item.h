@@ -12,6 +12,7 @@
 #ifndef hifi_render_Item_h
 #define hifi_render_Item_h
 
+#include <array>
 #include <atomic>
 #include <bitset>
 #include <map>
@@ -335,6 +336,32 @@ class ItemBound {
 // many Item Bounds in a vector
 using ItemBounds = std::vector<ItemBound>;
 
+// What a shape draws, when all that changes from one of its draws to the next are the transform and the range of indices:
+// the shapes of a pipeline with the same batchKey share their buffers and material, so the bind() of any one of them
+// sets up the draws of all of them, to be merged into a single multiDrawIndexedIndirect.
+//   Shapes whose vertices are at different places of a shared buffer give where theirs start as baseVertex. The bind
+// then offsets the vertices by the baseVertex it is given, for the draws that can't take one of their own.
+//   The batchKey only hashes what the draws bind, so two draws with the same one are only merged if they also have the
+// same matches function and it finds that they bind the same: it compares in full the objects they give as bindState.
+class IndirectDraw {
+public:
+    using BindFunction = std::function<void(gpu::Batch& batch, uint32_t baseVertex)>;
+    using MatchFunction = bool (*)(const IndirectDraw& draw, const IndirectDraw& other);
+
+    bool canMergeWith(const IndirectDraw& other) const {
+        return batchKey == other.batchKey && matches == other.matches && matches && matches(*this, other);
+    }
+
+    size_t batchKey { 0 };
+    MatchFunction matches { nullptr };
+    std::array<const void*, 4> bindState {};
+    Transform transform;
+    uint32_t numIndices { 0 };
+    uint32_t startIndex { 0 };
+    uint32_t baseVertex { 0 };
+    BindFunction bind;
+};
+
 // Item is the proxy to a bounded "object" in the scene
 // An item is described by its Key
 class Item {
@@ -440,6 +467,8 @@ public:
 
         virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const = 0;
 
+        virtual bool getIndirectDraw(RenderArgs* args, IndirectDraw& draw) = 0;
+
         ~PayloadInterface() {}
 
         // Status interface is local to the base class
@@ -493,6 +522,10 @@ public:
 
     bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const { return _payload->passesZoneOcclusionTest(containingZones); }
 
+    // Indirect Draw Interface
+    // Instead of render(), for the shapes that can be drawn along with others
+    bool getIndirectDraw(RenderArgs* args, IndirectDraw& draw) const { return _payload->getIndirectDraw(args, draw); }
+
     // Access the status
     const StatusPointer& getStatus() const { return _payload->getStatus(); }
 
@@ -547,6 +580,11 @@ template <class T> uint32_t metaFetchMetaSubItems(const std::shared_ptr<T>& payl
 // Allows payloads to determine if they should render or not, based on the zones that contain the current camera
 template <class T> bool payloadPassesZoneOcclusionTest(const std::shared_ptr<T>& payloadData, const std::unordered_set<QUuid>& containingZones) { return true; }
 
+// Indirect Draw Interface
+// Allows shapes to describe their draw rather than render it, so that their pipeline can merge it with the draws of the
+// other shapes using the same buffers and material.  Returning false falls back to payloadRender.
+template <class T> bool payloadGetIndirectDraw(const std::shared_ptr<T>& payloadData, RenderArgs* args, IndirectDraw& draw) { return false; }
+
 // THe Payload class is the real Payload to be used
 // THis allow anything to be turned into a Payload as long as the required interface functions are available
 // When creating a new kind of payload from a new "stuff" class then you need to create specialized version for "stuff"
@@ -573,6 +611,8 @@ public:
 
     virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const override { return payloadPassesZoneOcclusionTest<T>(_data, containingZones); }
 
+    virtual bool getIndirectDraw(RenderArgs* args, IndirectDraw& draw) override { return payloadGetIndirectDraw<T>(_data, args, draw); }
+
 protected:
     DataPointer _data;
 
@@ -630,8 +670,7 @@ public:
     virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const = 0;
 
     // FIXME: this isn't the best place for this since it's only used for ModelEntities, but currently all Entities use PayloadProxyInterface
-    virtual void handleBlendedVertices(int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
-                                       const QVector<int>& blendedMeshSizes, const render::ItemIDs& subItemIDs) {};
+    virtual void handleBlendedVertices(const BlendedVerticesPointer& blendedVertices, const render::ItemIDs& subItemIDs) {};
 };
 
 template <> const ItemKey payloadGetKey(const PayloadProxyInterface::Pointer& payload);
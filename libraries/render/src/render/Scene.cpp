@@ -12,6 +12,7 @@
 
 #include <numeric>
 #include <gpu/Batch.h>
+#include <SharedUtil.h>
 #include "Logging.h"
 #include "TransitionStage.h"
 #include "HighlightStage.h"
@@ -230,7 +231,7 @@ uint32_t Scene::enqueueFrame() {
 }
 
  
-void Scene::processTransactionQueue() {
+void Scene::processTransactionQueue(float timeBudgetMsecs) {
     PROFILE_RANGE(render, __FUNCTION__);
 
     static TransactionFrames queuedFrames;
@@ -239,10 +240,24 @@ void Scene::processTransactionQueue() {
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
         queuedFrames.swap(_transactionFrames);
     }
+    _changedStaticItemBounds.clear();
+
+    // go through the queue of frames and process them, at least one per call, and as many as fit in the budget if any
+    const quint64 startTime = usecTimestampNow();
+    const quint64 budgetUsecs = (quint64)(timeBudgetMsecs * USECS_PER_MSEC);
+    auto frame = queuedFrames.begin();
+    while (frame != queuedFrames.end()) {
+        processTransactionFrame(*frame);
+        ++frame;
+        if (budgetUsecs > 0 && (usecTimestampNow() - startTime) >= budgetUsecs) {
+            break;
+        }
+    }
 
-    // go through the queue of frames and process them
-    for (auto& frame : queuedFrames) {
-        processTransactionFrame(frame);
+    // The frames left over the budget go back ahead of the ones enqueued since, to be processed next time in order
+    if (frame != queuedFrames.end()) {
+        std::unique_lock<std::mutex> lock(_transactionFramesMutex);
+        _transactionFrames.insert(_transactionFrames.begin(), std::make_move_iterator(frame), std::make_move_iterator(queuedFrames.end()));
     }
 
     queuedFrames.clear();
@@ -291,12 +306,17 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
 }
 
 void Scene::resetItems(const Transaction::Resets& transactions) {
+    // The payloads are reset one after the other: the renderers' updates share caches, such as the GeometryCache IDs and
+    // vertices, that aren't synchronized
     for (auto& reset : transactions) {
         // Access the true item
         auto itemId = std::get<0>(reset);
         auto& item = _items[itemId];
         auto oldKey = item.getKey();
         auto oldCell = item.getCell();
+        if (oldKey.isSpatial()) {
+            addChangedStaticItemBound(oldKey, item.getBound(nullptr));
+        }
 
         // Reset the item with a new payload
         item.resetPayload(std::get<1>(reset));
@@ -305,7 +325,9 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
         // Update the item's container
         assert((oldKey.isSpatial() == newKey.isSpatial()) || oldKey._flags.none());
         if (newKey.isSpatial()) {
-            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), itemId, newKey);
+            auto bound = item.getBound(nullptr);
+            addChangedStaticItemBound(newKey, bound);
+            auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, itemId, newKey);
             item.resetCell(newCell, newKey.isSmall());
         } else {
             _masterNonspatialSet.insert(itemId);
@@ -322,6 +344,7 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 
         // Remove the item
         if (oldKey.isSpatial()) {
+            addChangedStaticItemBound(oldKey, item.getBound(nullptr));
             _masterSpatialTree.removeItem(oldCell, oldKey, removedID);
         } else {
             _masterNonspatialSet.erase(removedID);
@@ -336,6 +359,7 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 }
 
 void Scene::updateItems(const Transaction::Updates& transactions) {
+    // Serially too, for the same reason as the resets
     for (auto& update : transactions) {
         auto updateID = std::get<0>(update);
         if (updateID == Item::INVALID_ITEM_ID) {
@@ -353,22 +377,30 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
         // Good to go, deal with the update
         auto oldCell = item.getCell();
         auto oldKey = item.getKey();
+        if (oldKey.isSpatial()) {
+            addChangedStaticItemBound(oldKey, item.getBound(nullptr));
+        }
 
         // Update the item
         item.update(std::get<1>(update));
         auto newKey = item.getKey();
+        Item::Bound bound;
+        if (newKey.isSpatial()) {
+            bound = item.getBound(nullptr);
+            addChangedStaticItemBound(newKey, bound);
+        }
 
         // Update the item's container
         if (oldKey.isSpatial() == newKey.isSpatial()) {
             if (newKey.isSpatial()) {
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             }
         } else {
             if (newKey.isSpatial()) {
                 _masterNonspatialSet.erase(updateID);
 
-                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, item.getBound(nullptr), updateID, newKey);
+                auto newCell = _masterSpatialTree.resetItem(oldCell, oldKey, bound, updateID, newKey);
                 item.resetCell(newCell, newKey.isSmall());
             } else {
                 _masterSpatialTree.removeItem(oldCell, oldKey, updateID);
@@ -156,7 +156,8 @@ public:
     uint32_t enqueueFrame();
 
     // Process the pending transactions queued
-    void processTransactionQueue();
+    // With a time budget, the frames of transactions left once it is spent wait for the next call, at least one is processed
+    void processTransactionQueue(float timeBudgetMsecs = 0.0f);
 
     // Access a particular selection (empty if doesn't exist)
     // Thread safe
@@ -181,6 +182,10 @@ public:
     // Access non-spatialized items (layered objects, backgrounds)
     const ItemIDSet& getNonspatialSet() const { return _masterNonspatialSet; }
 
+    // The bounds, from before and after, of the static spatial items (neither dynamic nor deformed) that the last
+    // processTransactionQueue reset, updated or removed
+    const std::vector<AABox>& getChangedStaticItemBounds() const { return _changedStaticItemBounds; }
+
     // Access a particular Stage (empty if doesn't exist)
     // Thread safe
     StagePointer getStage(const Stage::Name& name) const;
@@ -217,6 +222,13 @@ protected:
     Item::Vector _items;
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
+    std::vector<AABox> _changedStaticItemBounds;
+
+    void addChangedStaticItemBound(const ItemKey& key, const AABox& bound) {
+        if (key.isSpatial() && key.isStatic() && !key.isDeformed()) {
+            _changedStaticItemBounds.push_back(bound);
+        }
+    }
 
     void resetItems(const Transaction::Resets& transactions);
     void resetTransitionFinishedOperator(const Transaction::TransitionFinishedOperators& transactions);
@@ -14,8 +14,9 @@
 using namespace render;
 
 void PerformSceneTransaction::configure(const Config& config) {
+    _timeBudgetMs = config.timeBudgetMs;
 }
 
 void PerformSceneTransaction::run(const RenderContextPointer& renderContext) {
-    renderContext->_scene->processTransactionQueue();
+    renderContext->_scene->processTransactionQueue(_timeBudgetMs);
 }
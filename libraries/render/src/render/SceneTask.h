@@ -18,7 +18,11 @@ namespace render {
 
     class PerformSceneTransactionConfig : public Job::Config {
         Q_OBJECT
+        Q_PROPERTY(float timeBudgetMs MEMBER timeBudgetMs NOTIFY dirty)
     public:
+        // Time spent processing the transactions per frame past which the rest waits for the next frame, 0 for no limit
+        float timeBudgetMs { 4.0f };
+
     signals:
         void dirty();
 
@@ -33,6 +37,7 @@ namespace render {
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext);
     protected:
+        float _timeBudgetMs { 4.0f };
     };
 
 
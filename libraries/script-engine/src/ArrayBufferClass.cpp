@@ -174,6 +174,15 @@ void ArrayBufferClass::fromScriptValue(const QScriptValue& object, QByteArray& b
         // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
         if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(object.data())) {
             byteArray = *buffer;
+        } else if (QByteArray* viewBuffer = qscriptvalue_cast<QByteArray*>(object.property(BUFFER_PROPERTY_NAME).data())) {
+            // TypedArray or DataView instance: a view of the whole buffer shares it, a view of part of it copies the part
+            int byteOffset = object.property(BYTE_OFFSET_PROPERTY_NAME).toInt32();
+            int byteLength = object.property(BYTE_LENGTH_PROPERTY_NAME).toInt32();
+            if (byteOffset == 0 && byteLength == viewBuffer->size()) {
+                byteArray = *viewBuffer;
+            } else {
+                byteArray = viewBuffer->mid(byteOffset, byteLength);
+            }
         }
     }
 }
@@ -16,6 +16,8 @@
 
 #include <QDebug>
 
+#include <RegisteredMetaTypes.h>
+
 #include "ScriptEngineLogging.h"
 #include "ScriptEngine.h"
 
@@ -139,3 +141,116 @@ glm::quat Quat::cancelOutRollAndPitch(const glm::quat& q) {
 glm::quat Quat::cancelOutRoll(const glm::quat& q) {
     return ::cancelOutRoll(q);
 }
+
+namespace {
+
+glm::quat quatArgument(QScriptContext* context, int index) {
+    glm::quat q;
+    quatFromScriptValue(context->argument(index), q);
+    return q;
+}
+
+bool hasArguments(QScriptContext* context, int count) {
+    if (context->argumentCount() < count) {
+        context->throwError(QScriptContext::TypeError,
+            QString("Quat: expected %1 arguments, got %2").arg(count).arg(context->argumentCount()));
+        return false;
+    }
+    return true;
+}
+
+QScriptValue nativeMultiply(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return quatToScriptValue(engine, quatArgument(context, 0) * quatArgument(context, 1));
+}
+
+QScriptValue nativeInverse(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return quatToScriptValue(engine, glm::inverse(quatArgument(context, 0)));
+}
+
+QScriptValue nativeNormalize(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return quatToScriptValue(engine, glm::normalize(quatArgument(context, 0)));
+}
+
+QScriptValue nativeConjugate(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return quatToScriptValue(engine, glm::conjugate(quatArgument(context, 0)));
+}
+
+QScriptValue nativeGetForward(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, quatArgument(context, 0) * Vectors::FRONT);
+}
+
+QScriptValue nativeGetRight(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, quatArgument(context, 0) * Vectors::RIGHT);
+}
+
+QScriptValue nativeGetUp(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, quatArgument(context, 0) * Vectors::UP);
+}
+
+QScriptValue nativeAngleAxis(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    glm::vec3 axis;
+    vec3FromScriptValue(context->argument(1), axis);
+    return quatToScriptValue(engine, glm::angleAxis(glm::radians((float)context->argument(0).toNumber()), axis));
+}
+
+QScriptValue nativeSlerp(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 3)) {
+        return QScriptValue();
+    }
+    return quatToScriptValue(engine,
+        glm::slerp(quatArgument(context, 0), quatArgument(context, 1), (float)context->argument(2).toNumber()));
+}
+
+QScriptValue nativeDot(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return QScriptValue(glm::dot(quatArgument(context, 0), quatArgument(context, 1)));
+}
+
+}
+
+void Quat::installNativeFunctions(QScriptEngine* engine) {
+    QScriptValue library = engine->globalObject().property("Quat");
+    if (!library.isQObject()) {
+        return;
+    }
+    QScriptValue natives = engine->newObject();
+    natives.setPrototype(library);
+    natives.setProperty("multiply", engine->newFunction(nativeMultiply, 2));
+    natives.setProperty("inverse", engine->newFunction(nativeInverse, 1));
+    natives.setProperty("normalize", engine->newFunction(nativeNormalize, 1));
+    natives.setProperty("conjugate", engine->newFunction(nativeConjugate, 1));
+    natives.setProperty("getForward", engine->newFunction(nativeGetForward, 1));
+    natives.setProperty("getFront", engine->newFunction(nativeGetForward, 1));
+    natives.setProperty("getRight", engine->newFunction(nativeGetRight, 1));
+    natives.setProperty("getUp", engine->newFunction(nativeGetUp, 1));
+    natives.setProperty("angleAxis", engine->newFunction(nativeAngleAxis, 2));
+    natives.setProperty("slerp", engine->newFunction(nativeSlerp, 3));
+    natives.setProperty("dot", engine->newFunction(nativeDot, 2));
+    engine->globalObject().setProperty("Quat", natives);
+}
@@ -59,6 +59,10 @@ class Quat : public QObject, protected QScriptable {
     Q_OBJECT
     Q_PROPERTY(glm::quat IDENTITY READ IDENTITY CONSTANT)
 
+public:
+    // the same as Vec3::installNativeFunctions, for the global Quat
+    static void installNativeFunctions(QScriptEngine* engine);
+
 public slots:
 
     /*@jsdoc
@@ -14,13 +14,18 @@
 #include <QtScript/QScriptValue>
 #include <QtWidgets/QFileDialog>
 
+#include <mutex>
+
 #include <shared/QtHelpers.h>
 #include <AssetClient.h>
 #include <AssetUpload.h>
+#include <AudioConstants.h>
 #include <BuildInfo.h>
 #include <NumericalConstants.h>
 #include <PathUtils.h>
 #include <Transform.h>
+#include <plugins/CodecPlugin.h>
+#include <plugins/PluginManager.h>
 #include <recording/Deck.h>
 #include <recording/Recorder.h>
 #include <recording/Clip.h>
@@ -32,10 +37,87 @@
 using namespace recording;
 
 static const QString HFR_EXTENSION = "hfr";
+static const QString RECORDED_AUDIO_CODEC_NAME = "opus";
+
+// Stores the audio frames of recordings with the Opus codec, at a small fraction of the size of their samples.
+// An encoded frame starts with its number of channels, as the frames of a recording are mono or stereo depending on
+// the input device.
+class RecordedAudioCodec : public FrameCodec {
+public:
+    RecordedAudioCodec(const CodecPluginPointer& plugin) : _plugin(plugin) {}
+    ~RecordedAudioCodec() { reset(); }
+
+    QByteArray encode(const QByteArray& data) override {
+        int numChannels;
+        if (data.size() == AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL) {
+            numChannels = AudioConstants::MONO;
+        } else if (data.size() == AudioConstants::NETWORK_FRAME_BYTES_STEREO) {
+            numChannels = AudioConstants::STEREO;
+        } else {
+            return QByteArray();
+        }
+
+        auto& encoder = _encoders[numChannels - 1];
+        if (!encoder) {
+            encoder = _plugin->createEncoder(AudioConstants::SAMPLE_RATE, numChannels);
+        }
+        QByteArray encoded;
+        encoder->encode(data, encoded);
+        return encoded.prepend((char)numChannels);
+    }
+
+    QByteArray decode(const QByteArray& encoded) override {
+        int numChannels = encoded.isEmpty() ? 0 : encoded[0];
+        if (numChannels != AudioConstants::MONO && numChannels != AudioConstants::STEREO) {
+            return QByteArray();
+        }
+
+        auto& decoder = _decoders[numChannels - 1];
+        if (!decoder) {
+            decoder = _plugin->createDecoder(AudioConstants::SAMPLE_RATE, numChannels);
+        }
+        QByteArray decoded;
+        decoder->decode(encoded.mid(1), decoded);
+        return decoded;
+    }
+
+    void reset() override {
+        for (auto& encoder : _encoders) {
+            if (encoder) {
+                _plugin->releaseEncoder(encoder);
+                encoder = nullptr;
+            }
+        }
+        for (auto& decoder : _decoders) {
+            if (decoder) {
+                _plugin->releaseDecoder(decoder);
+                decoder = nullptr;
+            }
+        }
+    }
+
+private:
+    CodecPluginPointer _plugin;
+    Encoder* _encoders[AudioConstants::STEREO] { nullptr, nullptr };
+    Decoder* _decoders[AudioConstants::STEREO] { nullptr, nullptr };
+};
 
 RecordingScriptingInterface::RecordingScriptingInterface() {
     _player = DependencyManager::get<Deck>();
     _recorder = DependencyManager::get<Recorder>();
+
+    // new recordings store their audio with the codec, and recordings that have it can only be played with it
+    static std::once_flag registerAudioCodec;
+    std::call_once(registerAudioCodec, [] {
+        for (const auto& plugin : PluginManager::getInstance()->getCodecPlugins()) {
+            if (plugin->getName() == RECORDED_AUDIO_CODEC_NAME) {
+                Frame::registerFrameCodec(AudioConstants::getAudioFrameName(), RECORDED_AUDIO_CODEC_NAME, [plugin] {
+                    return std::make_shared<RecordedAudioCodec>(plugin);
+                });
+                break;
+            }
+        }
+    });
 }
 
 bool RecordingScriptingInterface::isPlaying() const {
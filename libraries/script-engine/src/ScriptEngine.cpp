@@ -12,9 +12,11 @@
 #include "ScriptEngine.h"
 
 #include <chrono>
+#include <limits>
 #include <thread>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
 #include <QtCore/QTimer>
@@ -223,7 +225,7 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
+    _timerTick(new QTimer(this)),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
@@ -254,6 +256,10 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
         }
     }, Qt::DirectConnection);
 
+    _timerTick->setSingleShot(true);
+    _timerTick->setTimerType(Qt::PreciseTimer);
+    connect(_timerTick, &QTimer::timeout, this, &ScriptEngine::timerFired);
+
     setProcessEventsInterval(MSECS_PER_SECOND);
     if (isEntityServerScript()) {
         qCDebug(scriptengine) << "isEntityServerScript() -- limiting maxRetries to 1";
@@ -742,8 +748,13 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    registerFunction("Entities", "getMultipleEntityPropertyArrays", EntityScriptingInterface::getMultipleEntityPropertyArrays);
+    registerFunction("Entities", "editMultipleEntities", EntityScriptingInterface::editMultipleEntities);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
+    // the most called math of each skips the QObject method call
+    Quat::installNativeFunctions(this);
+    Vec3::installNativeFunctions(this);
     registerGlobalObject("Mat4", &_mat4Library);
     registerGlobalObject("Uuid", &_uuidLibrary);
     registerGlobalObject("Messages", DependencyManager::get<MessagesClient>().data());
@@ -1298,6 +1309,7 @@ void ScriptEngine::run() {
                 auto preUpdate = clock::now();
                 {
                     PROFILE_RANGE(script, "ScriptUpdate");
+                    ScriptProfiler::Scope profile(_profiler, EntityItemID(), "update", "Script.update");
                     emit update(deltaTime);
                 }
                 auto postUpdate = clock::now();
@@ -1349,30 +1361,25 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
+    QList<ScriptTimerWheel::TimerID> timerIDs = _timers.keys();
     int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
+    for (auto timerID : timerIDs) {
         qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
+        stopTimer(timerID);
     }
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
+     // We could maintain a separate map of entityID => timers, but someone will have to prove to me that it's worth the complexity. -HRS
+    QVector<ScriptTimerWheel::TimerID> toDelete;
+    for (auto i = _timers.cbegin(); i != _timers.cend(); ++i) {
+        if (i.value().callback.definingEntityIdentifier != entityID) {
             continue;
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
+        toDelete << i.key(); // don't delete while we're iterating. save it.
     }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    for (auto timerID : toDelete) { // now reap 'em
+        stopTimer(timerID);
     }
 
 }
@@ -1427,6 +1434,10 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
+static quint64 timerWheelMsecsNow() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+}
+
 void ScriptEngine::timerFired() {
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
@@ -1436,50 +1447,79 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    quint64 now = timerWheelMsecsNow();
+    std::vector<ScriptTimerWheel::Expiry> expired;
+    _timerWheel.advance(now, expired);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
-
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
-    }
-}
+    for (const auto& expiry : expired) {
+        // an earlier callback may have stopped it
+        auto timer = _timers.find(expiry.first);
+        if (timer == _timers.end()) {
+            continue;
+        }
+        CallbackData timerData = timer->callback;
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+        if (timer->isSingleShot) {
+            // this timer is done, we can kill it
+            _timerHandles.remove(timer->handle);
+            delete timer->handle;
+            _timers.erase(timer);
+        } else {
+            // like a QTimer, an interval that fell behind skips the calls it missed rather than catching up
+            quint64 interval = std::max(timer->intervalMS, 1);
+            quint64 nextDue = expiry.second + interval;
+            _timerWheel.insert(expiry.first, nextDue > now ? nextDue : now + interval, now);
+        }
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+        const quint64 LATENESS_SMOOTHING = 8;
+        quint64 latenessUsecs = (now - std::min(expiry.second, now)) * USECS_PER_MSEC;
+        _averageTimerLatenessUsecs = (_averageTimerLatenessUsecs * (LATENESS_SMOOTHING - 1) + latenessUsecs) / LATENESS_SMOOTHING;
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, __FUNCTION__);
+            ScriptProfiler::Scope profile(_profiler, timerData.definingEntityIdentifier, "timer", timerData.function);
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
-
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+    _numTimers = _timers.size();
+    scheduleTimerTick();
+}
 
+void ScriptEngine::scheduleTimerTick() {
+    quint64 nextTick = _timerWheel.getNextTick();
+    if (nextTick == std::numeric_limits<quint64>::max()) {
+        _timerTick->stop();
+        return;
+    }
+    quint64 now = timerWheelMsecsNow();
+    int delay = nextTick > now ? (int)std::min(nextTick - now, (quint64)std::numeric_limits<int>::max()) : 0;
+    // restarting the tick registers it with the event loop again, so leave it when it's due sooner anyway
+    if (!_timerTick->isActive() || _timerTick->remainingTime() > delay) {
+        _timerTick->start(delay);
+    }
+}
 
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    // add the timer to the map and the wheel, and make sure the wheel ticks in time for it
+    ScriptTimerWheel::TimerID timerID = ++_lastTimerID;
+    ScriptTimer timer = { { function, currentEntityIdentifier, currentSandboxURL }, std::max(intervalMS, 0), isSingleShot,
+                          new QObject(this) };
+    _timers.insert(timerID, timer);
+    _timerHandles.insert(timer.handle, timerID);
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    quint64 now = timerWheelMsecsNow();
+    _timerWheel.insert(timerID, now + timer.intervalMS, now);
+    _numTimers = _timers.size();
+    scheduleTimerTick();
+    return timer.handle;
 }
 
 QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
@@ -1502,13 +1542,19 @@ QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
+void ScriptEngine::stopTimer(ScriptTimerWheel::TimerID timerID) {
+    auto timer = _timers.find(timerID);
+    if (timer != _timers.end()) {
+        _timerHandles.remove(timer->handle);
+        delete timer->handle;
+        _timers.erase(timer);
+        _timerWheel.remove(timerID);
+        _numTimers = _timers.size();
+        if (_timerWheel.isEmpty()) {
+            _timerTick->stop();
+        }
     } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+        qCDebug(scriptengine) << "stopTimer -- not in _timers" << timerID;
     }
 }
 
@@ -2085,6 +2131,7 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
+            ScriptProfiler::Scope profile(_profiler, handler.definingEntityIdentifier, eventName, handler.function);
             callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
         }
     }
@@ -2330,23 +2377,44 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         return;
     }
 
-    // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
-    if (syntaxError.isError()) {
-        auto message = syntaxError.property("formatted").toString();
-        if (message.isEmpty()) {
-            message = syntaxError.toString();
+    // the inline scripts all have the same file name, so the contents tell them apart
+    QCryptographicHash programHash(QCryptographicHash::Sha1);
+    programHash.addData(fileName.toUtf8());
+    programHash.addData(contents.toUtf8());
+    const QByteArray programKey = programHash.result();
+
+    QScriptProgram program;
+    // a lookup makes the program the most recently used
+    auto cachedProgram = _entityScriptPrograms.object(programKey);
+    if (cachedProgram) {
+        program = cachedProgram->program;
+        ++_numEntityScriptProgramHits;
+        _entityScriptLintUsecsSaved += cachedProgram->lintUsecs;
+    } else {
+        ++_numEntityScriptProgramMisses;
+
+        // SYNTAX ERRORS
+        quint64 lintStart = usecTimestampNow();
+        auto syntaxError = lintScript(contents, fileName);
+        quint64 lintUsecs = usecTimestampNow() - lintStart;
+        if (syntaxError.isError()) {
+            auto message = syntaxError.property("formatted").toString();
+            if (message.isEmpty()) {
+                message = syntaxError.toString();
+            }
+            setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            syntaxError.setProperty("detail", entityID.toString());
+            emit unhandledException(syntaxError);
+            return;
         }
-        setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        syntaxError.setProperty("detail", entityID.toString());
-        emit unhandledException(syntaxError);
-        return;
-    }
-    QScriptProgram program { contents, fileName };
-    if (program.isNull()) {
-        setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(makeError("program.isNull"));
-        return; // done processing script
+        program = QScriptProgram { contents, fileName };
+        if (program.isNull()) {
+            setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+            emit unhandledException(makeError("program.isNull"));
+            return; // done processing script
+        }
+        // many different inline scripts could pile up, so this drops the least recently used once the cache is full
+        _entityScriptPrograms.insert(programKey, new EntityScriptProgram { program, lintUsecs });
     }
 
     if (isURL) {
@@ -2499,11 +2567,19 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         lastModified = (quint64)QFileInfo(file).lastModified().toMSecsSinceEpoch();
     }
 
+    // the program is evaluated directly rather than through evaluate(), so bail here as it would on shutdown
+    QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
+    if (!scriptEngines || scriptEngines->isStopped()) {
+        return;
+    }
+
     // THE ACTUAL EVALUATION AND CONSTRUCTION
     QScriptValue entityScriptConstructor, entityScriptObject;
     QUrl sandboxURL = currentSandboxURL.isEmpty() ? scriptOrURL : currentSandboxURL;
     auto initialization = [&]{
-        entityScriptConstructor = evaluate(contents, fileName);
+        // the program was linted above, and keeps what it compiled for the next copies of the script
+        entityScriptConstructor = BaseScriptEngine::evaluate(program);
+        maybeEmitUncaughtException("evaluate");
         entityScriptObject = entityScriptConstructor.construct();
 
         if (hasUncaughtException()) {
@@ -2512,7 +2588,10 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         }
     };
 
-    doWithEnvironment(entityID, sandboxURL, initialization);
+    {
+        ScriptProfiler::Scope profile(_profiler, entityID, "load", isURL ? scriptOrURL : QString("(inline)"));
+        doWithEnvironment(entityID, sandboxURL, initialization);
+    }
 
     if (entityScriptObject.isError()) {
         auto exception = entityScriptObject;
@@ -2626,6 +2705,7 @@ void ScriptEngine::unloadAllEntityScripts(bool blockingCall) {
     {
         QWriteLocker locker{ &_entityScriptsLock };
         _entityScripts.clear();
+        _entityScriptPrograms.clear();
     }
     emit entityScriptDetailsUpdated();
 
@@ -2757,6 +2837,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
 
             QScriptValue oldData = this->globalObject().property("Script").property("remoteCallerID");
             this->globalObject().property("Script").setProperty("remoteCallerID", remoteCallerID.toString()); // Make the remoteCallerID available to javascript as a global.
+            ScriptProfiler::Scope profile(_profiler, entityID, "method", methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
             this->globalObject().property("Script").setProperty("remoteCallerID", oldData);
         }
@@ -2795,6 +2876,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
+            ScriptProfiler::Scope profile(_profiler, entityID, "method", methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
@@ -2834,6 +2916,7 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
+            ScriptProfiler::Scope profile(_profiler, entityID, "method", methodName);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QCache>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -48,6 +49,8 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptProfiler.h"
+#include "ScriptTimerWheel.h"
 #include "ScriptUUID.h"
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
@@ -71,6 +74,14 @@ public:
     QUrl definingSandboxURL;
 };
 
+class ScriptTimer {
+public:
+    CallbackData callback;
+    int intervalMS;
+    bool isSingleShot;
+    QObject* handle; // what the script holds on to, the timer runs from the wheel
+};
+
 class DeferredLoadEntity {
 public:
     EntityItemID entityID;
@@ -508,7 +519,7 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(_timerHandles.value(timer, 0)); }
 
     /*@jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
@@ -523,7 +534,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(_timerHandles.value(timer, 0)); }
 
     /*@jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -690,6 +701,19 @@ public:
     void scriptPrintedMessage(const QString& message);
     void clearDebugLogWindow();
     int getNumRunningEntityScripts() const;
+    int getNumTimers() const { return _numTimers; }
+    // a moving average of how late the timers are called, which a busy script thread makes worse
+    quint64 getAverageTimerLatenessUsecs() const { return _averageTimerLatenessUsecs; }
+
+    // times the calls into the scripts by entity and function, see ScriptProfiler
+    void setProfilingEnabled(bool enabled) { _profiler.setEnabled(enabled); }
+    bool isProfilingEnabled() const { return _profiler.isEnabled(); }
+    QJsonArray getProfileReport(int topN) const { return _profiler.getReport(topN); }
+
+    // how often an entity script was found already compiled, and the parse time that saved
+    int getNumEntityScriptProgramHits() const { return _numEntityScriptProgramHits; }
+    int getNumEntityScriptProgramMisses() const { return _numEntityScriptProgramMisses; }
+    quint64 getEntityScriptLintUsecsSaved() const { return _entityScriptLintUsecsSaved; }
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
@@ -936,6 +960,7 @@ protected:
 
     QString logException(const QScriptValue& exception);
     void timerFired();
+    void scheduleTimerTick();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -944,7 +969,7 @@ protected:
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
     QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    void stopTimer(ScriptTimerWheel::TimerID timerID);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -974,11 +999,31 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+    // the timers of the script all run from the one tick of the wheel
+    QHash<ScriptTimerWheel::TimerID, ScriptTimer> _timers;
+    QHash<QObject*, ScriptTimerWheel::TimerID> _timerHandles; // only looked up, a handle may be gone by the time it's cleared
+    ScriptTimerWheel _timerWheel;
+    QTimer* _timerTick;
+    ScriptTimerWheel::TimerID _lastTimerID { 0 };
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<quint64> _averageTimerLatenessUsecs { 0 };
+    ScriptProfiler _profiler;
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     EntityScriptContentAvailableMap _contentAvailableQueue;
+    // the entity scripts that passed the syntax check, by the hash of their file name and contents, so the many copies of
+    // a script are linted and compiled once, with how long the lint took to tell the time saved. The least recently used
+    // are dropped once there are MAX_ENTITY_SCRIPT_PROGRAMS.
+    struct EntityScriptProgram {
+        QScriptProgram program;
+        quint64 lintUsecs;
+    };
+    static const int MAX_ENTITY_SCRIPT_PROGRAMS { 1000 };
+    QCache<QByteArray, EntityScriptProgram> _entityScriptPrograms { MAX_ENTITY_SCRIPT_PROGRAMS };
+    std::atomic<int> _numEntityScriptProgramHits { 0 };
+    std::atomic<int> _numEntityScriptProgramMisses { 0 };
+    std::atomic<quint64> _entityScriptLintUsecsSaved { 0 };
 
     bool _isThreaded { false };
     qint64 _lastUpdate;
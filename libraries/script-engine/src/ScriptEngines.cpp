@@ -9,11 +9,13 @@
 #include "ScriptEngines.h"
 
 #include <QtCore/QStandardPaths>
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 
 #include <QtWidgets/QApplication>
 
 #include <shared/QtHelpers.h>
+#include <NumericalConstants.h>
 #include <SettingHandle.h>
 #include <UserActivityLogger.h>
 #include <PathUtils.h>
@@ -142,6 +144,7 @@ void ScriptEngines::addScriptEngine(ScriptEnginePointer engine) {
     if (!_isStopped) {
         QMutexLocker locker(&_allScriptsMutex);
         _allKnownScriptEngines.insert(engine);
+        engine->setProfilingEnabled(_isProfilingEnabled);
     }
 }
 
@@ -271,6 +274,8 @@ QVariantList ScriptEngines::getLocal() {
  * @property {string} name - The script's file name.
  * @property {string} path - The script's path and file name &mdash; excluding the scheme if a local file.
  * @property {string} url - The full URL of the script &mdash; including the scheme if a local file.
+ * @property {number} timers - The number of timers the script has running.
+ * @property {number} timerLateness - How late the script's timers are called, on average, in ms.
  */
 QVariantList ScriptEngines::getRunning() {
     QVariantList result;
@@ -293,11 +298,56 @@ QVariantList ScriptEngines::getRunning() {
         resultNode.insert("path", displayURLString);
         resultNode.insert("url", normalizeScriptURL(runningScript).toString());
         resultNode.insert("local", runningScriptURL.isLocalFile());
+        auto scriptEngine = getScriptEngine(runningScriptURL);
+        if (scriptEngine) {
+            resultNode.insert("timers", scriptEngine->getNumTimers());
+            resultNode.insert("timerLateness", (double)scriptEngine->getAverageTimerLatenessUsecs() / USECS_PER_MSEC);
+        }
         result.append(resultNode);
     }
     return result;
 }
 
+void ScriptEngines::setProfilingEnabled(bool enabled) {
+    QMutexLocker locker(&_allScriptsMutex);
+    _isProfilingEnabled = enabled;
+    for (const auto& engine : _allKnownScriptEngines) {
+        engine->setProfilingEnabled(enabled);
+    }
+}
+
+/*@jsdoc
+ * A call into a script, over the last 10 to 20 seconds.
+ * @typedef {object} ScriptDiscoveryService.ProfileEntry
+ * @property {string} script - The file name of the script, or the name of the entity script engine.
+ * @property {Uuid} [entity_id] - The entity whose script made the call, if any.
+ * @property {string} kind - <code>"timer"</code>, <code>"method"</code>, <code>"load"</code>, <code>"update"</code> 
+ *     or the name of the entity event.
+ * @property {string} function - The name of the function, entity method or entity script.
+ * @property {number} calls - The number of calls.
+ * @property {number} total_usecs - The time spent in the calls, in microseconds.
+ * @property {number} self_usecs - The time spent in the calls less the time spent in other calls they made, in 
+ *     microseconds.
+ * @property {number} max_usecs - The time spent in the longest call, in microseconds.
+ */
+QVariantList ScriptEngines::getProfileReport(int topN) {
+    return getProfileEntries(topN).toVariantList();
+}
+
+QJsonArray ScriptEngines::getProfileEntries(int topN) {
+    QJsonArray entries;
+    QMutexLocker locker(&_allScriptsMutex);
+    for (const auto& engine : _allKnownScriptEngines) {
+        const QString script = engine->getFilename();
+        for (const auto& value : engine->getProfileReport(topN)) {
+            QJsonObject entry = value.toObject();
+            entry["script"] = script;
+            entries.push_back(entry);
+        }
+    }
+    return ScriptProfiler::getTopEntries(entries, topN);
+}
+
 void ScriptEngines::loadDefaultScripts() {
     loadScript(DEFAULT_SCRIPTS_LOCATION);
 }
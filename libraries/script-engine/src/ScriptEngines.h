@@ -17,6 +17,7 @@
 #include <memory>
 
 #include <QtCore/QObject>
+#include <QtCore/QJsonArray>
 #include <QtCore/QMutex>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QUrl>
@@ -155,6 +156,32 @@ public:
      */
     Q_INVOKABLE QVariantList getRunning();
 
+    /*@jsdoc
+     * Starts or stops timing the calls into all the scripts, client entity scripts included: the timers, the entity 
+     * methods, the entity event handlers, the loading of the entity scripts and the updates. The scripts started later are 
+     * timed too while profiling is on.
+     * @function ScriptDiscoveryService.setProfilingEnabled
+     * @param {boolean} enabled - <code>true</code> to time the calls, <code>false</code> to stop.
+     */
+    Q_INVOKABLE void setProfilingEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets the calls into the scripts that took the most time over the last 10 to 20 seconds, while profiling is enabled 
+     * with {@link ScriptDiscoveryService.setProfilingEnabled|setProfilingEnabled}.
+     * @function ScriptDiscoveryService.getProfileReport
+     * @param {number} [topN=20] - The number of calls to report.
+     * @returns {ScriptDiscoveryService.ProfileEntry[]} The calls, the most time spent in the call itself first.
+     * @example <caption>Report the most expensive script calls.</caption>
+     * ScriptDiscoveryService.setProfilingEnabled(true);
+     * Script.setTimeout(function () {
+     *     print(JSON.stringify(ScriptDiscoveryService.getProfileReport(10)));
+     * }, 10000);
+     */
+    Q_INVOKABLE QVariantList getProfileReport(int topN = 20);
+
+    // the calls into the scripts of all the engines, see ScriptEngine::getProfileReport
+    QJsonArray getProfileEntries(int topN);
+
     /*@jsdoc
      * Gets a list of all script files that are in the default scripts directory of the Interface installation.
      * @function ScriptDiscoveryService.getPublic
@@ -351,6 +378,7 @@ protected:
     ScriptsModelFilter _scriptsModelFilter;
     std::atomic<bool> _isStopped { false };
     std::atomic<bool> _isReloading { false };
+    std::atomic<bool> _isProfilingEnabled { false };
     bool _defaultScriptsLocationOverridden { false };
     QString _debugScriptUrl;
 
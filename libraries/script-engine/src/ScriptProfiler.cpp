@@ -0,0 +1,130 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonObject>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+static const quint64 PROFILE_WINDOW_USECS = 10 * USECS_PER_SECOND;
+
+uint qHash(const ScriptProfiler::Key& key, uint seed) {
+    return qHash(key.entityID, seed) ^ qHash(key.kind, seed) ^ qHash(key.function, seed);
+}
+
+ScriptProfiler::Scope::Scope(ScriptProfiler& profiler, const EntityItemID& entityID, const QString& kind,
+                             const QScriptValue& function) :
+    _profiler(profiler)
+{
+    if (_profiler.isEnabled()) {
+        QString name = function.property("name").toString();
+        start(entityID, kind, name.isEmpty() ? "anonymous" : name);
+    }
+}
+
+ScriptProfiler::Scope::Scope(ScriptProfiler& profiler, const EntityItemID& entityID, const QString& kind,
+                             const QString& function) :
+    _profiler(profiler)
+{
+    if (_profiler.isEnabled()) {
+        start(entityID, kind, function);
+    }
+}
+
+void ScriptProfiler::Scope::start(const EntityItemID& entityID, const QString& kind, const QString& function) {
+    _isActive = true;
+    _entityID = entityID;
+    _kind = kind;
+    _function = function;
+    _profiler._childUsecs.push_back(0);
+    _startUsecs = usecTimestampNow();
+}
+
+ScriptProfiler::Scope::~Scope() {
+    if (!_isActive) {
+        return;
+    }
+    quint64 totalUsecs = usecTimestampNow() - _startUsecs;
+    quint64 childUsecs = _profiler._childUsecs.back();
+    _profiler._childUsecs.pop_back();
+    if (!_profiler._childUsecs.empty()) {
+        _profiler._childUsecs.back() += totalUsecs;
+    }
+    _profiler.record({ _entityID, _kind, _function }, totalUsecs, totalUsecs - std::min(childUsecs, totalUsecs));
+}
+
+void ScriptProfiler::record(const Key& key, quint64 totalUsecs, quint64 selfUsecs) {
+    quint64 now = usecTimestampNow();
+    std::lock_guard<std::mutex> lock(_statsMutex);
+    if (now - _windowStartUsecs > PROFILE_WINDOW_USECS) {
+        _previousWindow.swap(_currentWindow);
+        _currentWindow.clear();
+        _windowStartUsecs = now;
+    }
+    Stats& stats = _currentWindow[key];
+    ++stats.calls;
+    stats.totalUsecs += totalUsecs;
+    stats.selfUsecs += selfUsecs;
+    stats.maxUsecs = std::max(stats.maxUsecs, totalUsecs);
+}
+
+QJsonArray ScriptProfiler::getReport(int topN) const {
+    QHash<Key, Stats> merged;
+    {
+        std::lock_guard<std::mutex> lock(_statsMutex);
+        merged = _previousWindow;
+        for (auto itr = _currentWindow.cbegin(); itr != _currentWindow.cend(); ++itr) {
+            Stats& stats = merged[itr.key()];
+            stats.calls += itr->calls;
+            stats.totalUsecs += itr->totalUsecs;
+            stats.selfUsecs += itr->selfUsecs;
+            stats.maxUsecs = std::max(stats.maxUsecs, itr->maxUsecs);
+        }
+    }
+
+    QJsonArray entries;
+    for (auto itr = merged.cbegin(); itr != merged.cend(); ++itr) {
+        QJsonObject entry;
+        if (!itr.key().entityID.isNull()) {
+            entry["entity_id"] = itr.key().entityID.toString();
+        }
+        entry["kind"] = itr.key().kind;
+        entry["function"] = itr.key().function;
+        entry["calls"] = (double)itr->calls;
+        entry["total_usecs"] = (double)itr->totalUsecs;
+        entry["self_usecs"] = (double)itr->selfUsecs;
+        entry["max_usecs"] = (double)itr->maxUsecs;
+        entries.push_back(entry);
+    }
+    return getTopEntries(entries, topN);
+}
+
+QJsonArray ScriptProfiler::getTopEntries(const QJsonArray& entries, int topN) {
+    std::vector<QJsonObject> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+        sorted.push_back(entry.toObject());
+    }
+    size_t count = std::min(sorted.size(), (size_t)std::max(topN, 0));
+    std::partial_sort(sorted.begin(), sorted.begin() + count, sorted.end(), [](const QJsonObject& a, const QJsonObject& b) {
+        return a["self_usecs"].toDouble() > b["self_usecs"].toDouble();
+    });
+
+    QJsonArray top;
+    for (size_t i = 0; i < count; ++i) {
+        top.push_back(sorted[i]);
+    }
+    return top;
+}
@@ -0,0 +1,91 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QString>
+#include <QtScript/QScriptValue>
+
+#include <EntityItemID.h>
+
+// Times the calls a ScriptEngine makes into its scripts: the timers, the entity methods, the entity event handlers, the
+// loading of the entity scripts and the updates, by entity and function. The time of a call made inside another is taken
+// out of the self time of the outer one, so the self times add up to the time spent in the scripts.
+//
+// The calls are timed on the script thread; the report, of the last 10 to 20 seconds, can be taken from any thread.
+class ScriptProfiler {
+public:
+    void setEnabled(bool enabled) { _isEnabled = enabled; }
+    bool isEnabled() const { return _isEnabled; }
+
+    class Scope {
+    public:
+        // the function is named after the function's name, or "anonymous"
+        Scope(ScriptProfiler& profiler, const EntityItemID& entityID, const QString& kind, const QScriptValue& function);
+        Scope(ScriptProfiler& profiler, const EntityItemID& entityID, const QString& kind, const QString& function);
+        ~Scope();
+
+    private:
+        void start(const EntityItemID& entityID, const QString& kind, const QString& function);
+
+        ScriptProfiler& _profiler;
+        bool _isActive { false };
+        EntityItemID _entityID;
+        QString _kind;
+        QString _function;
+        quint64 _startUsecs { 0 };
+    };
+
+    // the calls with the most self time first: objects of entity_id, kind, function, calls, total_usecs, self_usecs and
+    // max_usecs
+    QJsonArray getReport(int topN) const;
+
+    // the topN of reports of several profilers
+    static QJsonArray getTopEntries(const QJsonArray& entries, int topN);
+
+private:
+    struct Key {
+        EntityItemID entityID;
+        QString kind;
+        QString function;
+        bool operator==(const Key& other) const {
+            return entityID == other.entityID && kind == other.kind && function == other.function;
+        }
+    };
+    friend uint qHash(const Key& key, uint seed);
+
+    struct Stats {
+        quint64 calls { 0 };
+        quint64 totalUsecs { 0 };
+        quint64 selfUsecs { 0 };
+        quint64 maxUsecs { 0 };
+    };
+
+    void record(const Key& key, quint64 totalUsecs, quint64 selfUsecs);
+
+    std::atomic<bool> _isEnabled { false };
+    // the time of the calls inside each scope that is open, to take out of its self time
+    std::vector<quint64> _childUsecs;
+
+    mutable std::mutex _statsMutex;
+    QHash<Key, Stats> _currentWindow;
+    QHash<Key, Stats> _previousWindow;
+    quint64 _windowStartUsecs { 0 };
+};
+
+#endif // hifi_ScriptProfiler_h
@@ -0,0 +1,130 @@
+//
+//  ScriptTimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptTimerWheel.h"
+
+#include <algorithm>
+#include <limits>
+
+void ScriptTimerWheel::insert(TimerID id, quint64 dueMsecs, quint64 nowMsecs) {
+    if (_timers.empty()) {
+        // nothing is waiting, so rather than turn through the ticks since the wheel was last used start again from now,
+        // dropping what is left of the removed timers
+        for (auto& level : _levels) {
+            for (auto& slot : level) {
+                slot.clear();
+            }
+        }
+        _overflow.clear();
+        _currentTick = std::max(_currentTick, nowMsecs);
+    }
+    Timer& timer = _timers[id];
+    timer.dueMsecs = dueMsecs;
+    timer.serial = _nextSerial++;
+    place({ id, timer.serial }, dueMsecs);
+}
+
+bool ScriptTimerWheel::remove(TimerID id) {
+    return _timers.erase(id) > 0;
+}
+
+const ScriptTimerWheel::Timer* ScriptTimerWheel::findTimer(const Entry& entry) const {
+    auto itr = _timers.find(entry.first);
+    if (itr == _timers.end() || itr->second.serial != entry.second) {
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+void ScriptTimerWheel::place(const Entry& entry, quint64 dueMsecs) {
+    quint64 tick = std::max(dueMsecs, _currentTick);
+    // the lowest level whose span holds both the current tick and the due tick
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        int spanBits = SLOT_BITS * (level + 1);
+        if ((tick >> spanBits) == (_currentTick >> spanBits)) {
+            _levels[level][(tick >> (SLOT_BITS * level)) & SLOT_MASK].push_back(entry);
+            return;
+        }
+    }
+    _overflow.push_back(entry);
+}
+
+void ScriptTimerWheel::cascade(Slot& slot) {
+    Slot entries;
+    entries.swap(slot);
+    for (const auto& entry : entries) {
+        if (const Timer* timer = findTimer(entry)) {
+            place(entry, timer->dueMsecs);
+        }
+    }
+}
+
+void ScriptTimerWheel::advance(quint64 nowMsecs, std::vector<Expiry>& expired) {
+    while (_currentTick <= nowMsecs) {
+        // skip the ticks with nothing to expire or place again, which are most of them when the timers are few or far off
+        quint64 nextTick = getNextTick();
+        if (nextTick > nowMsecs) {
+            _currentTick = nowMsecs + 1;
+            return;
+        }
+        _currentTick = nextTick;
+
+        // entering the span of a slot of a higher level, from the top down so that the timers can fall through the levels
+        for (int level = NUM_LEVELS; level > 0; --level) {
+            quint64 spanMask = (1ULL << (SLOT_BITS * level)) - 1;
+            if ((_currentTick & spanMask) != 0) {
+                continue;
+            }
+            if (level == NUM_LEVELS) {
+                cascade(_overflow);
+            } else {
+                cascade(_levels[level][(_currentTick >> (SLOT_BITS * level)) & SLOT_MASK]);
+            }
+        }
+
+        Slot entries;
+        entries.swap(_levels[0][_currentTick & SLOT_MASK]);
+        for (const auto& entry : entries) {
+            if (const Timer* timer = findTimer(entry)) {
+                expired.push_back({ entry.first, timer->dueMsecs });
+                _timers.erase(entry.first);
+            }
+        }
+        ++_currentTick;
+    }
+}
+
+quint64 ScriptTimerWheel::getNextTick() const {
+    const auto hasTimers = [this](const Slot& slot) {
+        return std::any_of(slot.begin(), slot.end(), [this](const Entry& entry) { return findTimer(entry) != nullptr; });
+    };
+
+    // the slots behind the current one of each level are empty, and the current one is too unless the wheel is at its
+    // start and has yet to place its timers again, so the first slot with a timer in it of each level is the soonest there
+    quint64 nextTick = std::numeric_limits<quint64>::max();
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        int slotBits = SLOT_BITS * level;
+        int spanBits = SLOT_BITS * (level + 1);
+        quint64 spanStart = (_currentTick >> spanBits) << spanBits;
+        for (quint64 index = (_currentTick >> slotBits) & SLOT_MASK; index < (quint64)NUM_SLOTS; ++index) {
+            if (hasTimers(_levels[level][index])) {
+                nextTick = std::min(nextTick, std::max(spanStart + (index << slotBits), _currentTick));
+                break;
+            }
+        }
+    }
+    if (hasTimers(_overflow)) {
+        // the overflow is placed again at the start of each span of the top level
+        quint64 spanMask = (1ULL << (SLOT_BITS * NUM_LEVELS)) - 1;
+        nextTick = std::min(nextTick, (_currentTick + spanMask) & ~spanMask);
+    }
+    return nextTick;
+}
@@ -0,0 +1,79 @@
+//
+//  ScriptTimerWheel.h
+//  libraries/script-engine/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptTimerWheel_h
+#define hifi_ScriptTimerWheel_h
+
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+// A hierarchical timer wheel of 1 ms ticks for the script timers, so that a script engine runs all of its timers from
+// one QTimer instead of one each.
+//
+// The timers due within the current 64 ms are in the 64 slots of the first level, those due within the current 4096 ms
+// in the slots of the second level, and so on for 4 levels, about 4.6 hours; the rest wait in an overflow list. Each time
+// the wheel turns into the span of a slot of a higher level, the timers of that slot are placed again in a lower level,
+// so that adding, removing and expiring a timer cost the same however many there are.
+class ScriptTimerWheel {
+public:
+    using TimerID = quint32;
+    using Expiry = std::pair<TimerID, quint64>;
+
+    ScriptTimerWheel(quint64 nowMsecs = 0) : _currentTick(nowMsecs) {}
+
+    // a timer due before the current tick expires on the next advance; inserting an ID already in the wheel moves it
+    void insert(TimerID id, quint64 dueMsecs, quint64 nowMsecs);
+    bool remove(TimerID id);
+    bool contains(TimerID id) const { return _timers.find(id) != _timers.end(); }
+
+    size_t size() const { return _timers.size(); }
+    bool isEmpty() const { return _timers.empty(); }
+
+    // removes the timers due up to now and appends them with their due times to expired, earliest first
+    void advance(quint64 nowMsecs, std::vector<Expiry>& expired);
+
+    // the tick the wheel needs to be advanced at next: the due time of a timer, or when the timers of a higher level get
+    // placed again; no later than the earliest timer and never before the current tick, or the largest quint64 when empty
+    quint64 getNextTick() const;
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const quint64 SLOT_MASK = NUM_SLOTS - 1;
+    static const int NUM_LEVELS = 4;
+
+    struct Timer {
+        quint64 dueMsecs;
+        quint32 serial;
+    };
+    // a slot holds the serial of the insert along with the ID, so that a timer removed and inserted again before its old
+    // slot comes up is not found twice
+    using Entry = std::pair<TimerID, quint32>;
+    using Slot = std::vector<Entry>;
+
+    void place(const Entry& entry, quint64 dueMsecs);
+    void cascade(Slot& slot);
+    const Timer* findTimer(const Entry& entry) const;
+
+    std::array<std::array<Slot, NUM_SLOTS>, NUM_LEVELS> _levels;
+    Slot _overflow;
+    // a removed timer stays in its slot until the slot comes up, and is skipped then
+    std::unordered_map<TimerID, Timer> _timers;
+    quint32 _nextSerial { 0 };
+    // the earliest tick not yet expired
+    quint64 _currentTick;
+};
+
+#endif // hifi_ScriptTimerWheel_h
@@ -11,6 +11,8 @@
 
 #include "TypedArrays.h"
 
+#include <QtCore/QtEndian>
+
 #include <glm/glm.hpp>
 
 #include "ScriptEngine.h"
@@ -200,19 +202,15 @@ void TypedArray::setBytesPerElement(quint32 bytesPerElement) {
 }
 
 // templated helper functions
-// don't work for floats as they require single precision settings
+// the elements are read and written in place rather than through a QDataStream, so that reading does not take a
+// reference to the buffer and writing only detaches it when native code still shares it
 template<class T>
 QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString& name, uint id) {
     bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        
-        stream.setByteOrder(QDataStream::LittleEndian);
-        T result;
-        stream >> result;
+    if (ok && arrayBuffer && id + sizeof(T) <= (uint)arrayBuffer->size()) {
+        T result = qFromLittleEndian<T>(arrayBuffer->constData() + id);
         return result;
     }
     return QScriptValue();
@@ -220,12 +218,8 @@ QScriptValue propertyHelper(const QByteArray* arrayBuffer, const QScriptString&
 
 template<class T>
 void setPropertyHelper(QByteArray* arrayBuffer, const QScriptString& name, uint id, const QScriptValue& value) {
-    if (arrayBuffer && value.isNumber()) {
-        QDataStream stream(arrayBuffer, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        
-        stream << (T)value.toNumber();
+    if (arrayBuffer && value.isNumber() && id + sizeof(T) <= (uint)arrayBuffer->size()) {
+        qToLittleEndian<T>((T)value.toNumber(), arrayBuffer->data() + id);
     }
 }
 
@@ -274,15 +268,14 @@ QScriptValue Uint8ClampedArrayClass::property(const QScriptValue& object, const
 void Uint8ClampedArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
+    if (ba && value.isNumber() && id < (uint)ba->size()) {
+        quint8* element = reinterpret_cast<quint8*>(ba->data() + id);
         if (value.toNumber() > 255) {
-            stream << (quint8)255;
+            *element = 255;
         } else if (value.toNumber() < 0) {
-            stream << (quint8)0;
+            *element = 0;
         } else {
-            stream << (quint8)glm::clamp(qRound(value.toNumber()), 0, 255);
+            *element = (quint8)glm::clamp(qRound(value.toNumber()), 0, 255);
         }
     }
 }
@@ -357,17 +350,12 @@ Float32ArrayClass::Float32ArrayClass(ScriptEngine* scriptEngine) : TypedArray(sc
 }
 
 QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScriptString& name, uint id) {
-    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
+    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
+    bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        float result;
-        stream >> result;
+    if (ok && arrayBuffer && id + sizeof(float) <= (uint)arrayBuffer->size()) {
+        float result = qFromLittleEndian<float>(arrayBuffer->constData() + id);
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -379,13 +367,8 @@ QScriptValue Float32ArrayClass::property(const QScriptValue& object, const QScri
 void Float32ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-        
-        stream << (float)value.toNumber();
+    if (ba && value.isNumber() && id + sizeof(float) <= (uint)ba->size()) {
+        qToLittleEndian<float>((float)value.toNumber(), ba->data() + id);
     }
 }
 
@@ -394,17 +377,12 @@ Float64ArrayClass::Float64ArrayClass(ScriptEngine* scriptEngine) : TypedArray(sc
 }
 
 QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScriptString& name, uint id) {
-    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());bool ok = false;
+    QByteArray* arrayBuffer = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
+    bool ok = false;
     name.toArrayIndex(&ok);
     
-    if (ok && arrayBuffer) {
-        QDataStream stream(*arrayBuffer);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        double result;
-        stream >> result;
+    if (ok && arrayBuffer && id + sizeof(double) <= (uint)arrayBuffer->size()) {
+        double result = qFromLittleEndian<double>(arrayBuffer->constData() + id);
         if (isNaN(result)) {
             return QScriptValue();
         }
@@ -416,13 +394,8 @@ QScriptValue Float64ArrayClass::property(const QScriptValue& object, const QScri
 void Float64ArrayClass::setProperty(QScriptValue& object, const QScriptString& name,
                                   uint id, const QScriptValue& value) {
     QByteArray* ba = qscriptvalue_cast<QByteArray*>(object.data().property(_bufferName).data());
-    if (ba && value.isNumber()) {
-        QDataStream stream(ba, QIODevice::ReadWrite);
-        stream.skipRawData(id);
-        stream.setByteOrder(QDataStream::LittleEndian);
-        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
-        
-        stream << (double)value.toNumber();
+    if (ba && value.isNumber() && id + sizeof(double) <= (uint)ba->size()) {
+        qToLittleEndian<double>((double)value.toNumber(), ba->data() + id);
     }
 }
 
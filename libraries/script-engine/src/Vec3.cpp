@@ -18,6 +18,8 @@
 #include <GLMHelpers.h>
 #include <glm/gtx/string_cast.hpp>
 
+#include <RegisteredMetaTypes.h>
+
 #include "NumericalConstants.h"
 #include "ScriptEngine.h"
 #include "ScriptEngineLogging.h"
@@ -94,3 +96,128 @@ float Vec3::getAngle(const glm::vec3& v1, const glm::vec3& v2) {
     return glm::acos(glm::dot(glm::normalize(v1), glm::normalize(v2)));
 }
 
+
+namespace {
+
+glm::vec3 vec3Argument(QScriptContext* context, int index) {
+    glm::vec3 v;
+    vec3FromScriptValue(context->argument(index), v);
+    return v;
+}
+
+bool hasArguments(QScriptContext* context, int count) {
+    if (context->argumentCount() < count) {
+        context->throwError(QScriptContext::TypeError,
+            QString("Vec3: expected %1 arguments, got %2").arg(count).arg(context->argumentCount()));
+        return false;
+    }
+    return true;
+}
+
+QScriptValue nativeSum(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, vec3Argument(context, 0) + vec3Argument(context, 1));
+}
+
+QScriptValue nativeSubtract(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, vec3Argument(context, 0) - vec3Argument(context, 1));
+}
+
+QScriptValue nativeMultiply(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    // the scale factor can come first or second, as with the two overloads of the slot
+    if (context->argument(0).isNumber()) {
+        return vec3ToScriptValue(engine, (float)context->argument(0).toNumber() * vec3Argument(context, 1));
+    }
+    return vec3ToScriptValue(engine, vec3Argument(context, 0) * (float)context->argument(1).toNumber());
+}
+
+QScriptValue nativeMultiplyVbyV(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, vec3Argument(context, 0) * vec3Argument(context, 1));
+}
+
+QScriptValue nativeMultiplyQbyV(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    glm::quat q;
+    quatFromScriptValue(context->argument(0), q);
+    return vec3ToScriptValue(engine, q * vec3Argument(context, 1));
+}
+
+QScriptValue nativeDot(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return QScriptValue(glm::dot(vec3Argument(context, 0), vec3Argument(context, 1)));
+}
+
+QScriptValue nativeCross(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, glm::cross(vec3Argument(context, 0), vec3Argument(context, 1)));
+}
+
+QScriptValue nativeLength(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return QScriptValue(glm::length(vec3Argument(context, 0)));
+}
+
+QScriptValue nativeDistance(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 2)) {
+        return QScriptValue();
+    }
+    return QScriptValue(glm::distance(vec3Argument(context, 0), vec3Argument(context, 1)));
+}
+
+QScriptValue nativeNormalize(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 1)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine, glm::normalize(vec3Argument(context, 0)));
+}
+
+QScriptValue nativeMix(QScriptContext* context, QScriptEngine* engine) {
+    if (!hasArguments(context, 3)) {
+        return QScriptValue();
+    }
+    return vec3ToScriptValue(engine,
+        glm::mix(vec3Argument(context, 0), vec3Argument(context, 1), (float)context->argument(2).toNumber()));
+}
+
+}
+
+void Vec3::installNativeFunctions(QScriptEngine* engine) {
+    QScriptValue library = engine->globalObject().property("Vec3");
+    if (!library.isQObject()) {
+        return;
+    }
+    // the other functions and the constants are found on the prototype, and called with it as this
+    QScriptValue natives = engine->newObject();
+    natives.setPrototype(library);
+    natives.setProperty("sum", engine->newFunction(nativeSum, 2));
+    natives.setProperty("subtract", engine->newFunction(nativeSubtract, 2));
+    natives.setProperty("multiply", engine->newFunction(nativeMultiply, 2));
+    natives.setProperty("multiplyVbyV", engine->newFunction(nativeMultiplyVbyV, 2));
+    natives.setProperty("multiplyQbyV", engine->newFunction(nativeMultiplyQbyV, 2));
+    natives.setProperty("dot", engine->newFunction(nativeDot, 2));
+    natives.setProperty("cross", engine->newFunction(nativeCross, 2));
+    natives.setProperty("length", engine->newFunction(nativeLength, 1));
+    natives.setProperty("distance", engine->newFunction(nativeDistance, 2));
+    natives.setProperty("normalize", engine->newFunction(nativeNormalize, 1));
+    natives.setProperty("mix", engine->newFunction(nativeMix, 3));
+    engine->globalObject().setProperty("Vec3", natives);
+}
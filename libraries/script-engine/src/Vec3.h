@@ -97,6 +97,11 @@ class Vec3 : public QObject, protected QScriptable {
     Q_PROPERTY(glm::vec3 UP READ UP CONSTANT)
     Q_PROPERTY(glm::vec3 FRONT READ FRONT CONSTANT)
 
+public:
+    // puts an object in front of the global Vec3 of the engine that does the most called math natively, without the
+    // QObject method call and its QVariant marshaling, and leaves the rest to this object
+    static void installNativeFunctions(QScriptEngine* engine);
+
 public slots:
     
     /*@jsdoc
@@ -20,6 +20,7 @@
 #include <QtScript/QScriptContextInfo>
 
 #include "Profile.h"
+#include "RegisteredMetaTypes.h"
 
 const QString BaseScriptEngine::SCRIPT_EXCEPTION_FORMAT { "[%0] %1 in %2:%3" };
 const QString BaseScriptEngine::SCRIPT_BACKTRACE_SEP { "\n    " };
@@ -35,6 +36,29 @@ bool BaseScriptEngine::IS_THREADSAFE_INVOCATION(const QThread *thread, const QSt
     return false;
 }
 
+const BaseScriptEngine::ValueTypeHandles* BaseScriptEngine::getValueTypeHandles(QScriptEngine* engine) {
+    auto baseEngine = qobject_cast<BaseScriptEngine*>(engine);
+    if (!baseEngine) {
+        return nullptr;
+    }
+    if (!baseEngine->_valueTypeHandles) {
+        auto handles = std::make_unique<ValueTypeHandles>();
+        handles->x = baseEngine->toStringHandle("x");
+        handles->y = baseEngine->toStringHandle("y");
+        handles->z = baseEngine->toStringHandle("z");
+        handles->w = baseEngine->toStringHandle("w");
+        handles->r = baseEngine->toStringHandle("r");
+        handles->g = baseEngine->toStringHandle("g");
+        handles->b = baseEngine->toStringHandle("b");
+        handles->red = baseEngine->toStringHandle("red");
+        handles->green = baseEngine->toStringHandle("green");
+        handles->blue = baseEngine->toStringHandle("blue");
+        handles->vec3Prototype = getVec3Prototype(baseEngine);
+        baseEngine->_valueTypeHandles = std::move(handles);
+    }
+    return baseEngine->_valueTypeHandles.get();
+}
+
 // engine-aware JS Error copier and factory
 QScriptValue BaseScriptEngine::makeError(const QScriptValue& _other, const QString& type) {
     if (!IS_THREADSAFE_INVOCATION(thread(), __FUNCTION__)) {
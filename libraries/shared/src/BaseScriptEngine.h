@@ -13,9 +13,11 @@
 #define hifi_BaseScriptEngine_h
 
 #include <functional>
+#include <memory>
 #include <QtCore/QDebug>
 #include <QtCore/QSharedPointer>
 #include <QtScript/QScriptEngine>
+#include <QtScript/QScriptString>
 
 class ScriptEngine;
 using ScriptEnginePointer = QSharedPointer<ScriptEngine>;
@@ -30,8 +32,21 @@ public:
     // threadsafe "unbound" version of QScriptEngine::nullValue()
     static const QScriptValue unboundNullValue() { return QScriptValue(0, QScriptValue::NullValue); }
 
+    // The names of the vec3 and quat components and the prototype of the vec3 values, for the glm conversions to look
+    // up once per engine rather than by string on every Vec3 and Quat call.
+    class ValueTypeHandles {
+    public:
+        QScriptString x, y, z, w;
+        QScriptString r, g, b;
+        QScriptString red, green, blue;
+        QScriptValue vec3Prototype;
+    };
+
     BaseScriptEngine() {}
 
+    // \return the handles of the engine if it is a BaseScriptEngine, else nullptr
+    static const ValueTypeHandles* getValueTypeHandles(QScriptEngine* engine);
+
     /*@jsdoc
      * @function Script.lintScript
      * @param {string} sourceCode - Source code.
@@ -104,6 +119,9 @@ protected:
 #ifdef DEBUG_JS
     static void _debugDump(const QString& header, const QScriptValue& object, const QString& footer = QString());
 #endif
+
+private:
+    std::unique_ptr<ValueTypeHandles> _valueTypeHandles;
 };
 
 // Standardized CPS callback helpers (see: http://fredkschott.com/post/2014/03/understanding-error-first-callbacks-in-node-js/)
@@ -12,6 +12,9 @@
 #ifndef hifi_BlendshapeConstants_h
 #define hifi_BlendshapeConstants_h
 
+#include <memory>
+#include <vector>
+
 #include <QHash>
 #include <QString>
 
@@ -126,4 +129,13 @@ struct BlendshapeOffsetUnpacked {
 
 using BlendshapeOffset = BlendshapeOffsetPacked;
 
+// The blended offsets of all the meshes of a model, one mesh after the other, along with the vertex count of each mesh,
+// 0 for the meshes without blendshapes. The ModelBlender writes them while the render side only reads them.
+struct BlendedVertices {
+    int blendNumber { 0 };
+    std::vector<BlendshapeOffset> offsets;
+    std::vector<int> meshSizes;
+};
+using BlendedVerticesPointer = std::shared_ptr<const BlendedVertices>;
+
 #endif // hifi_BlendshapeConstants_h
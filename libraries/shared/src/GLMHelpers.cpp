@@ -11,6 +11,7 @@
 
 #include "GLMHelpers.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -231,6 +232,322 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+// bits are stored most significant first from bitOffset on
+static void writeBits(unsigned char* buffer, int bitOffset, uint32_t value, int numBits) {
+    for (int i = numBits - 1; i >= 0; --i, ++bitOffset) {
+        unsigned char mask = 0x80 >> (bitOffset & 7);
+        if (value & (1U << i)) {
+            buffer[bitOffset >> 3] |= mask;
+        } else {
+            buffer[bitOffset >> 3] &= ~mask;
+        }
+    }
+}
+
+static uint32_t readBits(const unsigned char* buffer, int bitOffset, int numBits) {
+    uint32_t value = 0;
+    for (int i = 0; i < numBits; ++i, ++bitOffset) {
+        value = (value << 1) | ((buffer[bitOffset >> 3] >> (7 - (bitOffset & 7))) & 1);
+    }
+    return value;
+}
+
+int packOrientationQuatToBits(unsigned char* buffer, int bitOffset, const glm::quat& quatInput, int bitsPerComponent) {
+    assert(bitsPerComponent > 1 && bitsPerComponent <= 15);
+
+    uint8_t largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabs(quatInput[i]) > fabs(quatInput[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative.
+    glm::quat q = quatInput[largestComponent] > 0 ? -quatInput : quatInput;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t RANGE = (1 << bitsPerComponent) - 1;
+
+    writeBits(buffer, bitOffset, largestComponent, 2);
+    int numBits = 2;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            float value = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+            // round to nearest, the fewer bits the more it matters
+            writeBits(buffer, bitOffset + numBits, (uint32_t)(value * RANGE + 0.5f), bitsPerComponent);
+            numBits += bitsPerComponent;
+        }
+    }
+    return numBits;
+}
+
+int unpackOrientationQuatFromBits(const unsigned char* buffer, int bitOffset, glm::quat& quatOutput, int bitsPerComponent) {
+    assert(bitsPerComponent > 1 && bitsPerComponent <= 15);
+
+    const float RANGE = (float)((1 << bitsPerComponent) - 1);
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+    uint8_t largestComponent = (uint8_t)readBits(buffer, bitOffset, 2);
+    int numBits = 2;
+    float floatComponents[3];
+    for (int i = 0; i < 3; i++) {
+        float value = (float)readBits(buffer, bitOffset + numBits, bitsPerComponent) / RANGE;
+        floatComponents[i] = value * (2.0f * MAGNITUDE) - MAGNITUDE;
+        numBits += bitsPerComponent;
+    }
+
+    // missingComponent is always negative.
+    float missingComponent = -sqrtf(std::max(0.0f, 1.0f - floatComponents[0] * floatComponents[0] -
+        floatComponents[1] * floatComponents[1] - floatComponents[2] * floatComponents[2]));
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            quatOutput[i] = floatComponents[j];
+            j++;
+        } else {
+            quatOutput[i] = missingComponent;
+        }
+    }
+    return numBits;
+}
+
+int packUnitVec3ToBits(unsigned char* buffer, int bitOffset, const glm::vec3& vectorInput, int bitsPerComponent) {
+    assert(bitsPerComponent > 1 && bitsPerComponent <= 16);
+
+    // offset binary, so -1, 0 and 1 are all exact
+    const int32_t HALF_RANGE = (1 << (bitsPerComponent - 1)) - 1;
+    for (int i = 0; i < 3; i++) {
+        float value = glm::clamp(vectorInput[i], -1.0f, 1.0f);
+        int32_t quantized = (int32_t)roundf(value * HALF_RANGE);
+        writeBits(buffer, bitOffset + i * bitsPerComponent, (uint32_t)(quantized + HALF_RANGE), bitsPerComponent);
+    }
+    return 3 * bitsPerComponent;
+}
+
+int unpackUnitVec3FromBits(const unsigned char* buffer, int bitOffset, glm::vec3& vectorOutput, int bitsPerComponent) {
+    assert(bitsPerComponent > 1 && bitsPerComponent <= 16);
+
+    const int32_t HALF_RANGE = (1 << (bitsPerComponent - 1)) - 1;
+    for (int i = 0; i < 3; i++) {
+        int32_t quantized = (int32_t)readBits(buffer, bitOffset + i * bitsPerComponent, bitsPerComponent) - HALF_RANGE;
+        vectorOutput[i] = (float)quantized / (float)HALF_RANGE;
+    }
+    return 3 * bitsPerComponent;
+}
+
+namespace {
+    template <typename T>
+    const T& strided(const T* first, size_t stride, int index) {
+        return *reinterpret_cast<const T*>(reinterpret_cast<const unsigned char*>(first) + stride * index);
+    }
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // picks a where mask is set, otherwise b
+    inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+        return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+    }
+
+    // four quats as x, y, z and w across them
+    inline void loadQuats(const glm::quat* quats, size_t stride, int index, __m128& x, __m128& y, __m128& z, __m128& w) {
+        x = _mm_loadu_ps(&strided(quats, stride, index).x);
+        y = _mm_loadu_ps(&strided(quats, stride, index + 1).x);
+        z = _mm_loadu_ps(&strided(quats, stride, index + 2).x);
+        w = _mm_loadu_ps(&strided(quats, stride, index + 3).x);
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+    }
+
+    inline __m128 loadVec3(const glm::vec3& vector) {
+        // reads just the three floats, the vector may be at the end of its struct
+        __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(&vector.x)));
+        return _mm_movelh_ps(xy, _mm_load_ss(&vector.z));
+    }
+
+    inline void loadVec3s(const glm::vec3* vectors, size_t stride, int index, __m128& x, __m128& y, __m128& z) {
+        x = loadVec3(strided(vectors, stride, index));
+        y = loadVec3(strided(vectors, stride, index + 1));
+        z = loadVec3(strided(vectors, stride, index + 2));
+        __m128 w = loadVec3(strided(vectors, stride, index + 3));
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+    }
+
+    inline void storeBigEndianShorts(unsigned char* buffer, __m128i values) {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), values);
+        for (int i = 0; i < 4; i++) {
+            buffer[i * 6] = HI_BYTE(lanes[i]);
+            buffer[i * 6 + 1] = LO_BYTE(lanes[i]);
+        }
+    }
+
+    inline void storeShorts(unsigned char* buffer, __m128i values) {
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), values);
+        for (int i = 0; i < 4; i++) {
+            int16_t value = (int16_t)lanes[i];
+            memcpy(buffer + i * 6, &value, sizeof(value));
+        }
+    }
+#endif
+}
+
+// Quaternion memory order is x, y, z, w unless GLM is told otherwise, which the loads below rely on.
+#if (GLM_ARCH & GLM_ARCH_SSE2_BIT) && !defined(GLM_FORCE_QUAT_DATA_WXYZ)
+#define HIFI_SSE2_QUAT_BATCHES
+#endif
+
+void packOrientationQuatsToSixBytes(unsigned char* buffer, const glm::quat* quats, size_t stride, int count) {
+    int i = 0;
+#ifdef HIFI_SSE2_QUAT_BATCHES
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t NUM_BITS_PER_COMPONENT = 15;
+    const uint32_t RANGE = (1 << NUM_BITS_PER_COMPONENT) - 1;
+
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 magnitude = _mm_set1_ps(MAGNITUDE);
+    const __m128 twoMagnitude = _mm_set1_ps(2.0f * MAGNITUDE);
+    const __m128 range = _mm_set1_ps((float)RANGE);
+    const __m128i componentMask = _mm_set1_epi32(0x7fff);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z, w;
+        loadQuats(quats, stride, i, x, y, z, w);
+
+        // find largest component, the first of equals wins as in packOrientationQuatToSixBytes
+        __m128 largest = _mm_and_ps(x, absMask);
+        __m128i largestComponent = _mm_setzero_si128();
+        __m128 isLarger = _mm_cmpgt_ps(_mm_and_ps(y, absMask), largest);
+        largest = select(isLarger, _mm_and_ps(y, absMask), largest);
+        largestComponent = select(_mm_castps_si128(isLarger), _mm_set1_epi32(1), largestComponent);
+        isLarger = _mm_cmpgt_ps(_mm_and_ps(z, absMask), largest);
+        largest = select(isLarger, _mm_and_ps(z, absMask), largest);
+        largestComponent = select(_mm_castps_si128(isLarger), _mm_set1_epi32(2), largestComponent);
+        isLarger = _mm_cmpgt_ps(_mm_and_ps(w, absMask), largest);
+        largestComponent = select(_mm_castps_si128(isLarger), _mm_set1_epi32(3), largestComponent);
+
+        __m128 is0 = _mm_castsi128_ps(_mm_cmpeq_epi32(largestComponent, _mm_setzero_si128()));
+        __m128 is1 = _mm_castsi128_ps(_mm_cmpeq_epi32(largestComponent, _mm_set1_epi32(1)));
+        __m128 is2 = _mm_castsi128_ps(_mm_cmpeq_epi32(largestComponent, _mm_set1_epi32(2)));
+
+        // ensure that the sign of the dropped component is always negative.
+        __m128 dropped = select(is0, x, select(is1, y, select(is2, z, w)));
+        __m128 negate = _mm_and_ps(_mm_cmpgt_ps(dropped, _mm_setzero_ps()), signMask);
+        x = _mm_xor_ps(x, negate);
+        y = _mm_xor_ps(y, negate);
+        z = _mm_xor_ps(z, negate);
+        w = _mm_xor_ps(w, negate);
+
+        // the smallest three, in component order
+        __m128 first = select(is0, y, x);
+        __m128 second = select(_mm_or_ps(is0, is1), z, y);
+        __m128 third = select(_mm_or_ps(_mm_or_ps(is0, is1), is2), w, z);
+
+        // transform into 0..1 range and quantize into 0..range
+        auto quantize = [&](__m128 component) {
+            __m128 value = _mm_div_ps(_mm_add_ps(component, magnitude), twoMagnitude);
+            return _mm_and_si128(_mm_cvttps_epi32(_mm_mul_ps(value, range)), _mm_set1_epi32(0xffff));
+        };
+        __m128i components0 = quantize(first);
+        __m128i components1 = quantize(second);
+        __m128i components2 = quantize(third);
+
+        // encode the largestComponent into the high bits of the first two components
+        components0 = _mm_or_si128(_mm_and_si128(components0, componentMask),
+            _mm_slli_epi32(_mm_and_si128(largestComponent, _mm_set1_epi32(0x01)), 15));
+        components1 = _mm_or_si128(_mm_and_si128(components1, componentMask),
+            _mm_slli_epi32(_mm_and_si128(largestComponent, _mm_set1_epi32(0x02)), 14));
+
+        unsigned char* destination = buffer + i * 6;
+        storeBigEndianShorts(destination, components0);
+        storeBigEndianShorts(destination + 2, components1);
+        storeBigEndianShorts(destination + 4, components2);
+    }
+#endif
+    for (; i < count; i++) {
+        packOrientationQuatToSixBytes(buffer + i * 6, strided(quats, stride, i));
+    }
+}
+
+void packFloatVec3sToSignedTwoByteFixed(unsigned char* buffer, const glm::vec3* vectors, size_t stride, int count,
+                                        float divisor, int radix) {
+    int i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    using FixedType = int16_t;
+    const __m128 divisors = _mm_set1_ps(divisor);
+    const __m128 scale = _mm_set1_ps((float)(1 << radix));
+    const __m128 fixedMin = _mm_set1_ps((float)std::numeric_limits<FixedType>::min());
+    const __m128 fixedMax = _mm_set1_ps((float)std::numeric_limits<FixedType>::max());
+
+    auto toFixed = [&](__m128 component) {
+        __m128 scaled = _mm_mul_ps(_mm_div_ps(component, divisors), scale);
+        return _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaled, fixedMin), fixedMax));
+    };
+
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y, z;
+        loadVec3s(vectors, stride, i, x, y, z);
+
+        unsigned char* destination = buffer + i * 6;
+        storeShorts(destination, toFixed(x));
+        storeShorts(destination + 2, toFixed(y));
+        storeShorts(destination + 4, toFixed(z));
+    }
+#endif
+    for (; i < count; i++) {
+        packFloatVec3ToSignedTwoByteFixed(buffer + i * 6, strided(vectors, stride, i) / divisor, radix);
+    }
+}
+
+void findQuatsDifferingByDot(const glm::quat* a, const glm::quat* b, size_t stride, int count, float minDot, uint8_t* differs) {
+    int i = 0;
+#ifdef HIFI_SSE2_QUAT_BATCHES
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 minDots = _mm_set1_ps(minDot);
+    for (; i + 4 <= count; i += 4) {
+        __m128 ax, ay, az, aw, bx, by, bz, bw;
+        loadQuats(a, stride, i, ax, ay, az, aw);
+        loadQuats(b, stride, i, bx, by, bz, bw);
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(_mm_and_ps(dot, absMask), minDots));
+        for (int j = 0; j < 4; j++) {
+            differs[i + j] = (mask >> j) & 1;
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        differs[i] = fabsf(glm::dot(strided(a, stride, i), strided(b, stride, i))) < minDot;
+    }
+}
+
+void findVec3sDifferingByDistance(const glm::vec3* a, const glm::vec3* b, size_t stride, int count, float maxDistance,
+                                  uint8_t* differs) {
+    int i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    const __m128 maxDistances = _mm_set1_ps(maxDistance);
+    for (; i + 4 <= count; i += 4) {
+        __m128 ax, ay, az, bx, by, bz;
+        loadVec3s(a, stride, i, ax, ay, az);
+        loadVec3s(b, stride, i, bx, by, bz);
+        __m128 dx = _mm_sub_ps(ax, bx);
+        __m128 dy = _mm_sub_ps(ay, by);
+        __m128 dz = _mm_sub_ps(az, bz);
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(distance, maxDistances));
+        for (int j = 0; j < 4; j++) {
+            differs[i + j] = (mask >> j) & 1;
+        }
+    }
+#endif
+    for (; i < count; i++) {
+        differs[i] = glm::distance(strided(a, stride, i), strided(b, stride, i)) > maxDistance;
+    }
+}
+
 bool closeEnough(float a, float b, float relativeError) {
     assert(relativeError >= 0.0f);
     // NOTE: we add EPSILON to the denominator so we can avoid checking for division by zero.
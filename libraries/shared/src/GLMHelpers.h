@@ -118,6 +118,28 @@ int unpackOrientationQuatFromBytes(const unsigned char* buffer, glm::quat& quatO
 int packOrientationQuatToSixBytes(unsigned char* buffer, const glm::quat& quatInput);
 int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& quatOutput);
 
+// the same smallest-three method with a chosen number of bits per component (up to 15), packed at a bit offset
+// into a bit stream so consecutive values share bytes. Returns the number of bits written or read.
+int packOrientationQuatToBits(unsigned char* buffer, int bitOffset, const glm::quat& quatInput, int bitsPerComponent);
+int unpackOrientationQuatFromBits(const unsigned char* buffer, int bitOffset, glm::quat& quatOutput, int bitsPerComponent);
+
+// packs a vec3 with components in -1 to 1 with a chosen number of bits per component (up to 16) into a bit stream
+int packUnitVec3ToBits(unsigned char* buffer, int bitOffset, const glm::vec3& vectorInput, int bitsPerComponent);
+int unpackUnitVec3FromBits(const unsigned char* buffer, int bitOffset, glm::vec3& vectorOutput, int bitsPerComponent);
+
+// Batch forms of the above for count values read stride bytes apart, so a member of an array of structs can be
+// used in place. They work four values at a time with SSE2 where it's available and give the same results as the
+// one-at-a-time functions, byte for byte; the packed values are written 6 bytes apart.
+void packOrientationQuatsToSixBytes(unsigned char* buffer, const glm::quat* quats, size_t stride, int count);
+void packFloatVec3sToSignedTwoByteFixed(unsigned char* buffer, const glm::vec3* vectors, size_t stride, int count,
+                                        float divisor, int radix);
+
+// for count pairs read stride bytes apart, sets differs[i] to whether fabsf(glm::dot(a[i], b[i])) < minDot,
+// or for the vec3s whether glm::distance(a[i], b[i]) > maxDistance (to within rounding at the threshold)
+void findQuatsDifferingByDot(const glm::quat* a, const glm::quat* b, size_t stride, int count, float minDot, uint8_t* differs);
+void findVec3sDifferingByDistance(const glm::vec3* a, const glm::vec3* b, size_t stride, int count, float maxDistance,
+                                  uint8_t* differs);
+
 // Ratios need the be highly accurate when less than 10, but not very accurate above 10, and they
 // are never greater than 1000 to 1, this allows us to encode each component in 16bits
 int packFloatRatioToTwoByte(unsigned char* buffer, float ratio);
@@ -11,12 +11,26 @@
 
 #include "Gzip.h"
 
+#include <future>
+#include <thread>
+#include <vector>
+
+#include <QBuffer>
+#include <QIODevice>
+
 #include <zlib.h>
 
 const int GZIP_WINDOWS_BIT = 31;
 const int GZIP_CHUNK_SIZE = 4096;
 const int DEFAULT_MEM_LEVEL = 8;
 
+const int GZIP_STREAM_CHUNK_SIZE = 64 * 1024;
+const int RAW_DEFLATE_WINDOW_BITS = -15;
+const int DEFLATE_WINDOW_SIZE = 32 * 1024;
+// content this large is compressed on several threads, in blocks of this size
+const qint64 PARALLEL_GZIP_MIN_SIZE = 4 * 1024 * 1024;
+const int PARALLEL_GZIP_BLOCK_SIZE = 1024 * 1024;
+
 bool gunzip(QByteArray source, QByteArray &destination) {
     destination.clear();
     if (source.length() == 0) {
@@ -94,6 +108,14 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
         return true;
     }
 
+    if (source.length() >= PARALLEL_GZIP_MIN_SIZE) {
+        QBuffer sourceBuffer(&source);
+        QBuffer destinationBuffer(&destination);
+        sourceBuffer.open(QIODevice::ReadOnly);
+        destinationBuffer.open(QIODevice::WriteOnly);
+        return gzip(sourceBuffer, destinationBuffer, compressionLevel);
+    }
+
     int flushOrFinish = 0;
     z_stream strm;
     strm.zalloc = Z_NULL;
@@ -153,3 +175,268 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+namespace {
+
+bool readChunk(QIODevice& source, QByteArray& chunk, int maxSize) {
+    chunk.resize(maxSize);
+    qint64 size = 0;
+    while (size < maxSize) {
+        qint64 read = source.read(chunk.data() + size, maxSize - size);
+        if (read < 0) {
+            return false;
+        }
+        if (read == 0) {
+            break;
+        }
+        size += read;
+    }
+    chunk.resize(size);
+    return true;
+}
+
+bool writeAll(QIODevice& destination, const char* data, qint64 size) {
+    while (size > 0) {
+        qint64 written = destination.write(data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool deflateChunks(z_stream& strm, QIODevice& source, QIODevice& destination) {
+    QByteArray input;
+    int status = Z_OK;
+    int flushOrFinish = Z_NO_FLUSH;
+    while (flushOrFinish != Z_FINISH) {
+        if (!readChunk(source, input, GZIP_STREAM_CHUNK_SIZE)) {
+            return false;
+        }
+        flushOrFinish = input.size() < GZIP_STREAM_CHUNK_SIZE ? Z_FINISH : Z_NO_FLUSH;
+        strm.next_in = (unsigned char*)input.data();
+        strm.avail_in = input.size();
+
+        for (;;) {
+            char out[GZIP_STREAM_CHUNK_SIZE];
+            strm.next_out = (unsigned char*)out;
+            strm.avail_out = GZIP_STREAM_CHUNK_SIZE;
+            status = deflate(&strm, flushOrFinish);
+            if (status == Z_STREAM_ERROR) {
+                return false;
+            }
+            int available = (GZIP_STREAM_CHUNK_SIZE - strm.avail_out);
+            if (available > 0 && !writeAll(destination, out, available)) {
+                return false;
+            }
+            if (strm.avail_out != 0) {
+                break;
+            }
+        }
+    }
+    return status == Z_STREAM_END;
+}
+
+// A block of content compressed on its own, as raw deflate data that follows on from the block before it: it is
+// primed with the end of that block, and ends at a byte boundary, so the blocks concatenate into one deflate stream.
+struct DeflateBlock {
+    QByteArray input;
+    QByteArray dictionary;
+    bool isLast { false };
+    QByteArray output;
+    uLong crc { 0 };
+};
+
+bool deflateBlock(DeflateBlock& block, int compressionLevel) {
+    block.crc = crc32(crc32(0L, Z_NULL, 0), (const Bytef*)block.input.constData(), block.input.size());
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    if (deflateInit2(&strm, compressionLevel, Z_DEFLATED, RAW_DEFLATE_WINDOW_BITS, DEFAULT_MEM_LEVEL,
+                     Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    if (!block.dictionary.isEmpty()) {
+        deflateSetDictionary(&strm, (const Bytef*)block.dictionary.constData(), block.dictionary.size());
+    }
+
+    int flushOrFinish = block.isLast ? Z_FINISH : Z_SYNC_FLUSH;
+    strm.next_in = (unsigned char*)block.input.data();
+    strm.avail_in = block.input.size();
+    int status;
+    for (;;) {
+        char out[GZIP_STREAM_CHUNK_SIZE];
+        strm.next_out = (unsigned char*)out;
+        strm.avail_out = GZIP_STREAM_CHUNK_SIZE;
+        status = deflate(&strm, flushOrFinish);
+        if (status == Z_STREAM_ERROR) {
+            deflateEnd(&strm);
+            return false;
+        }
+        int available = (GZIP_STREAM_CHUNK_SIZE - strm.avail_out);
+        if (available > 0) {
+            block.output.append(out, available);
+        }
+        if (strm.avail_out != 0) {
+            break;
+        }
+    }
+    deflateEnd(&strm);
+    return block.isLast ? status == Z_STREAM_END : status == Z_OK;
+}
+
+void appendLittleEndian(QByteArray& data, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        data.append((char)((value >> (8 * i)) & 0xff));
+    }
+}
+
+// the way pigz does it: a gzip header, the blocks' deflate data, and a trailer with the CRC combined from theirs
+bool parallelGzip(QIODevice& source, QIODevice& destination, int compressionLevel, int numThreads) {
+    static const char GZIP_HEADER[] = { '\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, '\xff' };
+    if (!writeAll(destination, GZIP_HEADER, sizeof(GZIP_HEADER))) {
+        return false;
+    }
+
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint32_t totalSize = 0; // modulo 2^32, as gzip keeps it
+    QByteArray dictionary;
+    // read a block ahead, to know which is the last
+    QByteArray next;
+    if (!readChunk(source, next, PARALLEL_GZIP_BLOCK_SIZE)) {
+        return false;
+    }
+    bool isLast = false;
+    while (!isLast) {
+        // read a block for each thread, then compress them all at once
+        std::vector<DeflateBlock> blocks;
+        while ((int)blocks.size() < numThreads && !isLast) {
+            DeflateBlock block;
+            block.input = next;
+            block.dictionary = dictionary;
+            if (!readChunk(source, next, PARALLEL_GZIP_BLOCK_SIZE)) {
+                return false;
+            }
+            isLast = next.isEmpty();
+            block.isLast = isLast;
+            dictionary = block.input.right(DEFLATE_WINDOW_SIZE);
+            blocks.push_back(block);
+        }
+
+        std::vector<std::future<bool>> results;
+        for (auto& block : blocks) {
+            results.push_back(std::async(std::launch::async, [&block, compressionLevel] {
+                return deflateBlock(block, compressionLevel);
+            }));
+        }
+        bool success = true;
+        for (auto& result : results) {
+            success = result.get() && success;
+        }
+        if (!success) {
+            return false;
+        }
+
+        for (const auto& block : blocks) {
+            if (!writeAll(destination, block.output.constData(), block.output.size())) {
+                return false;
+            }
+            crc = crc32_combine(crc, block.crc, block.input.size());
+            totalSize += (uint32_t)block.input.size();
+        }
+    }
+
+    QByteArray trailer;
+    appendLittleEndian(trailer, (uint32_t)crc);
+    appendLittleEndian(trailer, totalSize);
+    return writeAll(destination, trailer.constData(), trailer.size());
+}
+
+}
+
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel) {
+    compressionLevel = qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel));
+
+    int numThreads = qMax(1, (int)std::thread::hardware_concurrency());
+    if (numThreads > 1 && source.bytesAvailable() >= PARALLEL_GZIP_MIN_SIZE) {
+        return parallelGzip(source, destination, compressionLevel, numThreads);
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = Z_NULL;
+    strm.avail_in = 0;
+
+    int status = deflateInit2(&strm, compressionLevel, Z_DEFLATED, GZIP_WINDOWS_BIT, DEFAULT_MEM_LEVEL,
+                              Z_DEFAULT_STRATEGY);
+    if (status != Z_OK) {
+        return false;
+    }
+    bool success = deflateChunks(strm, source, destination);
+    deflateEnd(&strm);
+    return success;
+}
+
+bool gunzip(QIODevice& source, QIODevice& destination) {
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+
+    int status = inflateInit2(&strm, GZIP_WINDOWS_BIT);
+    if (status != Z_OK) {
+        return false;
+    }
+
+    QByteArray input;
+    bool hasInput = false;
+    while (status != Z_STREAM_END) {
+        if (!readChunk(source, input, GZIP_STREAM_CHUNK_SIZE)) {
+            inflateEnd(&strm);
+            return false;
+        }
+        if (input.isEmpty()) {
+            break; // truncated, or no content at all
+        }
+        hasInput = true;
+        strm.next_in = (unsigned char*)input.data();
+        strm.avail_in = input.size();
+
+        for (;;) {
+            char out[GZIP_STREAM_CHUNK_SIZE];
+            strm.next_out = (unsigned char*)out;
+            strm.avail_out = GZIP_STREAM_CHUNK_SIZE;
+
+            status = inflate(&strm, Z_NO_FLUSH);
+            switch (status) {
+                case Z_NEED_DICT:
+                case Z_DATA_ERROR:
+                case Z_MEM_ERROR:
+                case Z_STREAM_ERROR:
+                    inflateEnd(&strm);
+                    return false;
+            }
+
+            int available = (GZIP_STREAM_CHUNK_SIZE - strm.avail_out);
+            if (available > 0 && !writeAll(destination, out, available)) {
+                inflateEnd(&strm);
+                return false;
+            }
+            if (strm.avail_out != 0 || status == Z_STREAM_END) {
+                break;
+            }
+        }
+    }
+
+    inflateEnd(&strm);
+    // as the QByteArray version, no content at all is no error
+    return status == Z_STREAM_END || !hasInput;
+}
@@ -14,6 +14,8 @@
 
 #include <QByteArray>
 
+class QIODevice;
+
 // The compression level must be Z_DEFAULT_COMPRESSION (-1), or between 0 and
 // 9: 1 gives best speed, 9 gives best compression, 0 gives no
 // compression at all (the input data is simply copied a block at a
@@ -24,4 +26,11 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// Streaming versions, for content too large to hold both compressed and uncompressed in memory. They read the source
+// until it has no more data, so are for files and buffers rather than sockets. Large content is compressed a block at a
+// time on several threads, into the one gzip stream any gunzip reads.
+bool gzip(QIODevice& source, QIODevice& destination, int compressionLevel = -1);
+
+bool gunzip(QIODevice& source, QIODevice& destination);
+
 #endif
@@ -0,0 +1,218 @@
+//
+//  LockFreeQueueThread.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_LockFreeQueueThread_h
+#define hifi_LockFreeQueueThread_h
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QThread>
+
+#include "GenericThread.h"
+#include "NumericalConstants.h"
+#include "shared/BoundedMPSCQueue.h"
+
+// A GenericQueueThread for items queued at a high rate from any number of threads. Producers queue into a lock-free
+// ring without taking a lock or waking the thread unless it is parked, and the thread processes what has been queued
+// in batches. Items that don't fit in the ring spill into a locked list instead of being dropped or waiting for room,
+// since the thread may itself be queueing them.
+//   An idle thread spins for a while before it parks, spinning longer when items came in while it spun last time
+// and less when they didn't, so that a steady stream of items never pays for a wake up.
+template <typename T>
+class LockFreeQueueThread : public GenericThread {
+public:
+    static const size_t DEFAULT_CAPACITY = 4096;
+
+    struct Stats {
+        uint64_t numQueued { 0 };
+        uint64_t numProcessed { 0 };
+        uint64_t highWaterMark { 0 }; // the most items that were ever waiting at once
+        uint64_t numSpilled { 0 }; // the items that found the ring full
+        uint64_t numParks { 0 };
+    };
+
+    LockFreeQueueThread(size_t capacity = DEFAULT_CAPACITY) : GenericThread(), _queue(capacity) {
+        _batch.reserve(_queue.capacity());
+    }
+
+    virtual ~LockFreeQueueThread() {}
+
+    // thread-safe
+    void queueItem(T t) {
+        // counted first, so that the thread never sees more processed than queued
+        auto numQueued = _numQueued.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto numProcessed = _numProcessed.load(std::memory_order_relaxed);
+        if (numQueued > numProcessed) {
+            auto numWaiting = numQueued - numProcessed;
+            auto highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+            while (numWaiting > highWaterMark &&
+                   !_highWaterMark.compare_exchange_weak(highWaterMark, numWaiting, std::memory_order_relaxed)) {
+            }
+        }
+
+        // once items have spilled the rest follow them, until the thread has taken them
+        if (_hasSpilled.load(std::memory_order_acquire) || !_queue.tryPush(t)) {
+            std::lock_guard<std::mutex> lock(_spillMutex);
+            _spilled.push_back(std::move(t));
+            _hasSpilled.store(true, std::memory_order_release);
+            _numSpilled.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // pairs with the fence in park, so that either this sees the thread parked or the thread sees the item
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_isParked.load(std::memory_order_relaxed)) {
+            wake();
+        }
+    }
+
+    void waitIdle(uint32_t maxWaitMs = UINT32_MAX) {
+        QElapsedTimer timer;
+        timer.start();
+        while (timer.elapsed() < maxWaitMs) {
+            if (_numProcessed.load(std::memory_order_acquire) == _numQueued.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    Stats getStats() const {
+        Stats stats;
+        stats.numQueued = _numQueued.load(std::memory_order_relaxed);
+        stats.numProcessed = _numProcessed.load(std::memory_order_relaxed);
+        stats.highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+        stats.numSpilled = _numSpilled.load(std::memory_order_relaxed);
+        stats.numParks = _numParks.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    virtual bool process() override {
+        std::unique_lock<std::mutex> batchLock(_batchMutex);
+        // only the thread waits for items, another thread flushing the queue takes what is there
+        if (!drain() && isThreaded() && QThread::currentThread() == _thread) {
+            if (!spin()) {
+                park();
+            }
+            drain();
+        }
+
+        if (_batch.empty()) {
+            return isStillRunning();
+        }
+
+        bool result = processQueueItems(_batch.data(), _batch.size());
+        _numProcessed.fetch_add(_batch.size(), std::memory_order_release);
+        _batch.clear();
+        return result;
+    }
+
+    virtual void terminating() override {
+        wake();
+    }
+
+protected:
+    static const int MIN_SPINS = 16;
+    static const int MAX_SPINS = 4096;
+
+    virtual uint32_t getMaxWait() {
+        return MSECS_PER_SECOND;
+    }
+
+    // the items in the order they were queued
+    virtual bool processQueueItems(const T* items, size_t count) = 0;
+
+private:
+    // moves what was queued to the batch, false if nothing was
+    bool drain() {
+        T item;
+        while (_batch.size() < _queue.capacity() && _queue.tryPop(item)) {
+            _batch.push_back(std::move(item));
+        }
+        if (_hasSpilled.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(_spillMutex);
+            // take what reached the ring while the flag was being set
+            while (_queue.tryPop(item)) {
+                _batch.push_back(std::move(item));
+            }
+            std::move(_spilled.begin(), _spilled.end(), std::back_inserter(_batch));
+            _spilled.clear();
+            _hasSpilled.store(false, std::memory_order_release);
+        }
+        return !_batch.empty();
+    }
+
+    // waits for an item without parking, true if one came
+    bool spin() {
+        bool hasItems = false;
+        for (int i = 0; i < _spins && !hasItems; ++i) {
+            std::this_thread::yield();
+            hasItems = _numQueued.load(std::memory_order_relaxed) != _numProcessed.load(std::memory_order_relaxed);
+        }
+        if (hasItems) {
+            _spins = (_spins * 2 < MAX_SPINS) ? _spins * 2 : MAX_SPINS;
+        } else {
+            _spins = (_spins / 2 > MIN_SPINS) ? _spins / 2 : MIN_SPINS;
+        }
+        return hasItems;
+    }
+
+    void park() {
+        std::unique_lock<std::mutex> lock(_parkMutex);
+        _isParked.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_numQueued.load(std::memory_order_relaxed) == _numProcessed.load(std::memory_order_relaxed) &&
+                isStillRunning()) {
+            _numParks.fetch_add(1, std::memory_order_relaxed);
+            _hasItems.wait_for(lock, std::chrono::milliseconds(getMaxWait()));
+        }
+        _isParked.store(false, std::memory_order_relaxed);
+    }
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(_parkMutex);
+        }
+        _hasItems.notify_one();
+    }
+
+    BoundedMPSCQueue<T> _queue;
+
+    // process can also be called from other threads, to flush the queue
+    std::mutex _batchMutex;
+    std::vector<T> _batch; // guarded by _batchMutex
+    int _spins { MIN_SPINS }; // guarded by _batchMutex
+
+    std::mutex _spillMutex;
+    std::vector<T> _spilled; // guarded by _spillMutex
+    std::atomic<bool> _hasSpilled { false };
+
+    std::mutex _parkMutex;
+    std::condition_variable _hasItems;
+    std::atomic<bool> _isParked { false };
+
+    std::atomic<uint64_t> _numQueued { 0 };
+    std::atomic<uint64_t> _numProcessed { 0 };
+    std::atomic<uint64_t> _highWaterMark { 0 };
+    std::atomic<uint64_t> _numSpilled { 0 };
+    std::atomic<uint64_t> _numParks { 0 };
+};
+
+#endif // hifi_LockFreeQueueThread_h
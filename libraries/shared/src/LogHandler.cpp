@@ -12,7 +12,11 @@
 
 #include "LogHandler.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 #ifdef Q_OS_WIN
 #include <windows.h>
@@ -29,8 +33,173 @@
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include "NumericalConstants.h"
+#include "shared/BoundedMPSCQueue.h"
+
 QMutex LogHandler::_mutex(QMutex::Recursive);
 
+// the messages a thread can have waiting for the writer before it drops them
+const size_t LOG_QUEUE_CAPACITY = 1024;
+
+// how often the writer writes the messages waiting; the threads logging don't wake it, so that logging costs them no
+// more than a push to their queue
+const int LOG_WRITE_INTERVAL_MSECS = 20;
+
+// beyond which the debug, info and warning messages of a category are counted rather than written, for the second
+const int MAX_MESSAGES_PER_CATEGORY_PER_SECOND = 100;
+
+struct LogHandler::LogRecord {
+    quint64 sequence { 0 }; // the order the messages were logged in, across threads
+    LogMsgType type { LogDebug };
+    QByteArray category;
+    QString source; // the basename of the file of a [qml] console message
+    QString message;
+    QString formattedMessage; // if the message was formatted as it was logged
+    qint64 time { 0 }; // msecs since the epoch
+    size_t threadID { 0 };
+};
+
+namespace {
+    // the messages of one thread, which only that thread pushes
+    struct LogQueue {
+        LogQueue() : records(LOG_QUEUE_CAPACITY) {}
+
+        BoundedMPSCQueue<LogHandler::LogRecord> records;
+        std::atomic<bool> isThreadFinished { false };
+    };
+
+    // the calling thread's queue, which the writer forgets once the thread has finished and the queue is empty
+    thread_local LogQueue* threadQueue { nullptr };
+    thread_local bool isThreadExiting { false };
+
+    struct ThreadQueueGuard {
+        ~ThreadQueueGuard() {
+            if (threadQueue) {
+                threadQueue->isThreadFinished.store(true, std::memory_order_release);
+            }
+            threadQueue = nullptr;
+            isThreadExiting = true;
+        }
+    };
+    thread_local ThreadQueueGuard threadQueueGuard;
+}
+
+// Writes the messages queued by the threads that log, in the order they were logged.
+class LogHandler::Writer {
+public:
+    Writer(LogHandler& handler) : _handler(handler) {
+        _thread = std::thread([this] { run(); });
+    }
+
+    ~Writer() {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _isStopping = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+        write();
+    }
+
+    void queue(LogRecord& record) {
+        record.sequence = _nextSequence.fetch_add(1, std::memory_order_relaxed);
+
+        if (!threadQueue) {
+            if (isThreadExiting) {
+                // the thread's queue is gone, so what it logs as it exits is written right away
+                write(&record);
+                return;
+            }
+            (void)&threadQueueGuard;
+            auto queue = std::make_shared<LogQueue>();
+            threadQueue = queue.get();
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            _queues.push_back(queue);
+        }
+
+        if (!threadQueue->records.tryPush(record)) {
+            _handler._numDroppedMessages++;
+            _numDroppedSinceWrite++;
+        }
+    }
+
+    // writes the messages queued, then the one given if any; from the writer thread, or any thread flushing
+    void write(const LogRecord* lastRecord = nullptr) {
+        std::lock_guard<std::mutex> writeLock(_writeMutex);
+
+        std::vector<std::shared_ptr<LogQueue>> queues;
+        {
+            std::lock_guard<std::mutex> lock(_queuesMutex);
+            queues = _queues;
+        }
+        _records.clear();
+        for (const auto& queue : queues) {
+            // once the thread has finished, what it pushed before is there to pop
+            bool isThreadFinished = queue->isThreadFinished.load(std::memory_order_acquire);
+            LogRecord record;
+            while (queue->records.tryPop(record)) {
+                _records.push_back(std::move(record));
+            }
+            if (isThreadFinished) {
+                std::lock_guard<std::mutex> lock(_queuesMutex);
+                _queues.erase(std::remove(_queues.begin(), _queues.end(), queue), _queues.end());
+            }
+        }
+        std::sort(_records.begin(), _records.end(), [](const LogRecord& a, const LogRecord& b) {
+            return a.sequence < b.sequence;
+        });
+
+        for (const auto& record : _records) {
+            _handler.writeRecord(record);
+        }
+        if (lastRecord) {
+            _handler.writeRecord(*lastRecord);
+        }
+
+        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        auto numDropped = _numDroppedSinceWrite.exchange(0);
+        if (numDropped > 0) {
+            LogRecord dropped;
+            dropped.type = LogSuppressed;
+            dropped.message = QString("%1 log messages were dropped, logged faster than they could be written").arg(numDropped);
+            dropped.time = now;
+            _handler.writeRecord(dropped);
+        }
+        _handler.writeSuppressedCounts(now);
+
+        if (!_records.empty() || lastRecord || numDropped > 0) {
+            fflush(stdout);
+        }
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        while (!_isStopping) {
+            _wake.wait_for(lock, std::chrono::milliseconds(LOG_WRITE_INTERVAL_MSECS));
+            lock.unlock();
+            write();
+            lock.lock();
+        }
+    }
+
+    LogHandler& _handler;
+
+    std::atomic<quint64> _nextSequence { 0 };
+    std::atomic<quint64> _numDroppedSinceWrite { 0 };
+
+    std::mutex _queuesMutex;
+    std::vector<std::shared_ptr<LogQueue>> _queues;
+
+    std::mutex _writeMutex;
+    std::vector<LogRecord> _records;
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wake;
+    bool _isStopping { false };
+    std::thread _thread;
+};
+
 LogHandler& LogHandler::getInstance() {
     static LogHandler staticInstance;
     return staticInstance;
@@ -66,10 +235,19 @@ LogHandler::LogHandler() {
             _shouldDisplayMilliseconds = true;
         } else if (option == "keep_repeats") {
             _keepRepeats = true;
+        } else if (option == "sync") {
+            _synchronous = true;
         } else if (option != "") {
             fprintf(stdout, "Unrecognized option in VIRCADIA_LOG_OPTIONS: '%s'\n", option.toUtf8().constData());
         }
     }
+
+    _writer.reset(new Writer(*this));
+}
+
+LogHandler::~LogHandler() {
+    // writes what is still queued
+    _writer.reset();
 }
 
 const char* stringForLogType(LogMsgType msgType) {
@@ -142,25 +320,63 @@ void LogHandler::setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds) {
 
 
 void LogHandler::flushRepeatedMessages() {
-    QMutexLocker lock(&_mutex);
+    QStringList repeatLogMessages;
+    {
+        QMutexLocker lock(&_mutex);
+
+        // New repeat-suppress scheme:
+        for (int m = 0; m < (int)_repeatedMessageRecords.size(); ++m) {
+            int repeatCount = _repeatedMessageRecords[m].repeatCount;
+            if (repeatCount > 1) {
+                repeatLogMessages.append(QString().setNum(repeatCount) + " repeated log entries - Last entry: \""
+                    + _repeatedMessageRecords[m].repeatString + "\"");
+                _repeatedMessageRecords[m].repeatCount = 0;
+                _repeatedMessageRecords[m].repeatString = QString();
+            }
+        }
+    }
+
+    for (const auto& repeatLogMessage : repeatLogMessages) {
+        queueMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
+    }
+}
 
-    // New repeat-suppress scheme:
-    for (int m = 0; m < (int)_repeatedMessageRecords.size(); ++m) {
-        int repeatCount = _repeatedMessageRecords[m].repeatCount;
-        if (repeatCount > 1) {
-            QString repeatLogMessage = QString().setNum(repeatCount) + " repeated log entries - Last entry: \"" 
-                    + _repeatedMessageRecords[m].repeatString + "\"";
-            printMessage(LogSuppressed, QMessageLogContext(), repeatLogMessage);
-            _repeatedMessageRecords[m].repeatCount = 0;
-            _repeatedMessageRecords[m].repeatString = QString();
+LogHandler::LogRecord LogHandler::makeRecord(LogMsgType type, const QMessageLogContext& context, const QString& message) const {
+    LogRecord record;
+    record.type = type;
+    record.category = context.category;
+    // for [qml] console.* messages include an abbreviated source filename
+    if (context.category && context.file && !strcmp("qml", context.category)) {
+        if (const char* basename = strrchr(context.file, '/')) {
+            record.source = basename + 1;
         }
     }
+    record.message = message;
+    record.time = QDateTime::currentMSecsSinceEpoch();
+    record.threadID = (size_t)QThread::currentThreadId();
+    return record;
 }
 
-QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+void LogHandler::queueRecord(LogRecord& record) {
+    _writer->queue(record);
+    if (_synchronous || record.type == LogFatal) {
+        flush();
+    }
+}
+
+void LogHandler::queueMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
     if (message.isEmpty()) {
-        return QString();
+        return;
     }
+    auto record = makeRecord(type, context, message);
+    queueRecord(record);
+}
+
+void LogHandler::flush() {
+    _writer->write();
+}
+
+QString LogHandler::formatMessage(const LogRecord& record) {
     QMutexLocker lock(&_mutex);
 
     // log prefix is in the following format
@@ -171,40 +387,65 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         dateFormatPtr = &DATE_STRING_FORMAT_WITH_MILLISECONDS;
     }
 
-    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::currentDateTime().toString(*dateFormatPtr),
-        stringForLogType(type), context.category);
+    QString prefixString = QString("[%1] [%2] [%3]").arg(QDateTime::fromMSecsSinceEpoch(record.time).toString(*dateFormatPtr),
+        stringForLogType(record.type), QString::fromLatin1(record.category));
 
     if (_shouldOutputProcessID) {
         prefixString.append(QString(" [%1]").arg(QCoreApplication::applicationPid()));
     }
 
     if (_shouldOutputThreadID) {
-        size_t threadID = (size_t)QThread::currentThreadId();
-        prefixString.append(QString(" [%1]").arg(threadID));
+        prefixString.append(QString(" [%1]").arg(record.threadID));
     }
 
     if (!_targetName.isEmpty()) {
         prefixString.append(QString(" [%1]").arg(_targetName));
     }
 
-    // for [qml] console.* messages include an abbreviated source filename
-    if (context.category && context.file && !strcmp("qml", context.category)) {
-        if (const char* basename = strrchr(context.file, '/')) {
-            prefixString.append(QString(" [%1]").arg(basename+1));
+    if (!record.source.isEmpty()) {
+        prefixString.append(QString(" [%1]").arg(record.source));
+    }
+
+    return QString("%1 %2\n").arg(prefixString, record.message.split('\n').join('\n' + prefixString + " "));
+}
+
+QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& context, const QString& message) {
+    if (message.isEmpty()) {
+        return QString();
+    }
+
+    auto record = makeRecord(type, context, message);
+    record.formattedMessage = formatMessage(record);
+    QString logMessage = record.formattedMessage;
+    queueRecord(record);
+    return logMessage;
+}
+
+void LogHandler::writeRecord(const LogRecord& record) {
+    if (!_keepRepeats && (record.type == LogDebug || record.type == LogInfo || record.type == LogWarning)) {
+        auto& rate = _categoryRates[record.category];
+        if (record.time - rate.windowStart >= (qint64)MSECS_PER_SECOND) {
+            writeSuppressedCounts(record.time);
+            rate.windowStart = record.time;
+            rate.numMessages = 0;
+        }
+        if (++rate.numMessages > MAX_MESSAGES_PER_CATEGORY_PER_SECOND) {
+            ++rate.numSuppressed;
+            return;
         }
     }
 
-    QString logMessage = QString("%1 %2\n").arg(prefixString, message.split('\n').join('\n' + prefixString + " "));
+    QString logMessage = record.formattedMessage.isEmpty() ? formatMessage(record) : record.formattedMessage;
 
     const char* color = "";
     const char* resetColor = "";
 
     if (_useColor) {
-        color = colorForLogType(type);
+        color = colorForLogType(record.type);
         resetColor = colorReset();
     }
 
-    if (_keepRepeats || _previousMessage != message) {
+    if (_keepRepeats || _previousMessage != record.message) {
         if (_repeatCount > 0) {
             fprintf(stdout, "[Previous message was repeated %i times]\n", _repeatCount);
         }
@@ -215,16 +456,30 @@ QString LogHandler::printMessage(LogMsgType type, const QMessageLogContext& cont
         _repeatCount++;
     }
 
-    _previousMessage = message;
+    _previousMessage = record.message;
 #ifdef Q_OS_WIN
     // On windows, this will output log lines into the Visual Studio "output" tab
     OutputDebugStringA(qPrintable(logMessage));
 #endif
-    return logMessage;
+}
+
+void LogHandler::writeSuppressedCounts(qint64 now) {
+    for (auto rate = _categoryRates.begin(); rate != _categoryRates.end(); ++rate) {
+        if (rate.value().numSuppressed > 0 && now - rate.value().windowStart >= (qint64)MSECS_PER_SECOND) {
+            LogRecord suppressed;
+            suppressed.type = LogSuppressed;
+            suppressed.category = rate.key();
+            suppressed.message = QString("%1 log messages suppressed, over %2 in a second")
+                .arg(rate.value().numSuppressed).arg(MAX_MESSAGES_PER_CATEGORY_PER_SECOND);
+            suppressed.time = now;
+            rate.value().numSuppressed = 0;
+            writeRecord(suppressed);
+        }
+    }
 }
 
 void LogHandler::verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message) {
-    getInstance().printMessage((LogMsgType) type, context, message);
+    getInstance().queueMessage((LogMsgType) type, context, message);
 }
 
 void LogHandler::setupRepeatedMessageFlusher() {
@@ -248,16 +503,22 @@ int LogHandler::newRepeatedMessageID() {
 
 void LogHandler::printRepeatedMessage(int messageID, LogMsgType type, const QMessageLogContext& context,
                                       const QString& message) {
-    QMutexLocker lock(&_mutex);
-    if (messageID >= _currentMessageID) {
-        return;
+    bool isFirstRepeat = false;
+    {
+        QMutexLocker lock(&_mutex);
+        if (messageID >= _currentMessageID) {
+            return;
+        }
+
+        isFirstRepeat = _repeatedMessageRecords[messageID].repeatCount == 0;
+        if (!isFirstRepeat) {
+            _repeatedMessageRecords[messageID].repeatString = message;
+        }
+
+        ++_repeatedMessageRecords[messageID].repeatCount;
     }
 
-    if (_repeatedMessageRecords[messageID].repeatCount == 0) {
-        printMessage(type, context, message);
-    } else {
-        _repeatedMessageRecords[messageID].repeatString = message;
+    if (isFirstRepeat) {
+        queueMessage(type, context, message);
     }
- 
-    ++_repeatedMessageRecords[messageID].repeatCount;
 }
@@ -16,9 +16,11 @@
 #include <QObject>
 #include <QString>
 #include <QRegExp>
+#include <QHash>
 #include <QMutex>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 const int VERBOSE_LOG_INTERVAL_SECONDS = 5;
 
@@ -32,11 +34,19 @@ enum LogMsgType {
 };
 
 /// Handles custom message handling and sending of stats/logs to Logstash instance
+///
+/// Messages are queued by the threads that log them, each to a lock-free queue of its own, and formatted and written
+/// by a writer thread, so that a thread logging under load never waits on the output. A thread that logs faster than
+/// the writer keeps up with loses the messages its queue has no room for; the writer reports how many were dropped.
+/// The writer also collapses repeated messages and limits how many messages of a category it writes each second.
 class LogHandler : public QObject {
     Q_OBJECT
 public:
     static LogHandler& getInstance();
 
+    /// a message as it was logged, for the writer to format
+    struct LogRecord;
+
     /// sets the target name to output via the verboseMessageHandler, called once before logging begins
     /// \param targetName the desired target name to output in logs
     void setTargetName(const QString& targetName);
@@ -45,8 +55,15 @@ public:
     void setShouldOutputThreadID(bool shouldOutputThreadID);
     void setShouldDisplayMilliseconds(bool shouldDisplayMilliseconds);
 
+    /// queues the message for output, and returns it formatted for the caller's own log
     QString printMessage(LogMsgType type, const QMessageLogContext& context, const QString &message);
 
+    /// writes the messages queued so far, from the calling thread
+    void flush();
+
+    /// the number of messages dropped since the start because their thread's queue was full
+    quint64 getNumDroppedMessages() const { return _numDroppedMessages; }
+
     /// a qtMessageHandler that can be hooked up to a target that links to Qt
     /// prints various process, message type, and time information
     static void verboseMessageHandler(QtMsgType type, const QMessageLogContext& context, const QString &message);
@@ -58,9 +75,17 @@ public:
 
 private:
     LogHandler();
-    ~LogHandler() = default;
+    ~LogHandler();
+
+    class Writer;
 
     void flushRepeatedMessages();
+    LogRecord makeRecord(LogMsgType type, const QMessageLogContext& context, const QString& message) const;
+    void queueRecord(LogRecord& record);
+    void queueMessage(LogMsgType type, const QMessageLogContext& context, const QString& message);
+    QString formatMessage(const LogRecord& record);
+    void writeRecord(const LogRecord& record);
+    void writeSuppressedCounts(qint64 now);
 
     QString _targetName;
     bool _shouldOutputProcessID { false };
@@ -68,9 +93,20 @@ private:
     bool _shouldDisplayMilliseconds { false };
     bool _useColor { false };
     bool _keepRepeats { false };
+    bool _synchronous { false };
 
+    // only used by whichever thread is writing
     QString _previousMessage;
     int _repeatCount { 0 };
+    struct CategoryRate {
+        qint64 windowStart { 0 }; // msecs since the epoch
+        int numMessages { 0 };
+        int numSuppressed { 0 };
+    };
+    QHash<QByteArray, CategoryRate> _categoryRates;
+
+    std::unique_ptr<Writer> _writer;
+    std::atomic<quint64> _numDroppedMessages { 0 };
 
 
     int _currentMessageID { 0 };
@@ -19,6 +19,7 @@ public:
     MovingPercentile(int numSamples, float percentile = 0.5f);
 
     void updatePercentile(qint64 sample);
+    void reset();
     qint64 getValueAtPercentile() const { return _valueAtPercentile; }
 
 private:
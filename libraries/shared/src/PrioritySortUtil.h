@@ -11,6 +11,9 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <memory>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
@@ -41,14 +44,18 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
-    template <typename T>
+    template <typename T, typename Allocator = std::allocator<T>>
     class PriorityQueue {
     public:
+        using Vector = std::vector<T, Allocator>;
+
         PriorityQueue() = delete;
-        PriorityQueue(const ConicalViewFrustums& views) : _views(views), _usecCurrentTime(usecTimestampNow()) { }
-        PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight)
-            : _views(views), _angularWeight(angularWeight), _centerWeight(centerWeight), _ageWeight(ageWeight)
-            , _usecCurrentTime(usecTimestampNow()) {
+        PriorityQueue(const ConicalViewFrustums& views, const Allocator& allocator = Allocator())
+            : _views(views), _vector(allocator), _usecCurrentTime(usecTimestampNow()) { }
+        PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight,
+                      const Allocator& allocator = Allocator())
+            : _views(views), _vector(allocator), _angularWeight(angularWeight), _centerWeight(centerWeight)
+            , _ageWeight(ageWeight), _usecCurrentTime(usecTimestampNow()) {
         }
 
         void setViews(const ConicalViewFrustums& views) { _views = views; }
@@ -68,7 +75,7 @@ namespace PrioritySortUtil {
         void reserve(size_t num) {
             _vector.reserve(num);
         }
-        const std::vector<T>& getSortedVector(int numToSort = 0) {
+        const Vector& getSortedVector(int numToSort = 0) {
             if (numToSort == 0 || numToSort >= (int)_vector.size()) {
                 std::sort(_vector.begin(), _vector.end(),
                     [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
@@ -124,7 +131,7 @@ namespace PrioritySortUtil {
         }
 
         ConicalViewFrustums _views;
-        std::vector<T> _vector;
+        Vector _vector;
         float _angularWeight { DEFAULT_ANGULAR_COEF };
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
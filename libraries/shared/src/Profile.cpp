@@ -11,6 +11,7 @@
 
 Q_LOGGING_CATEGORY(trace_app, "trace.app")
 Q_LOGGING_CATEGORY(trace_app_detail, "trace.app.detail")
+Q_LOGGING_CATEGORY(trace_audio, "trace.audio")
 Q_LOGGING_CATEGORY(trace_metadata, "trace.metadata")
 Q_LOGGING_CATEGORY(trace_network, "trace.network")
 Q_LOGGING_CATEGORY(trace_picks, "trace.picks")
@@ -48,6 +49,23 @@ static bool tracingEnabled() {
     return (tracer && tracer->isEnabled());
 }
 
+static bool recordingEnabled() {
+    if (!DependencyManager::isSet<tracing::Tracer>()) {
+        return false;
+    }
+
+    auto tracer = DependencyManager::get<tracing::Tracer>();
+    return (tracer && tracer->isRecording());
+}
+
+// records to the flight recorder when only it is on
+static void recordDuration(const QLoggingCategory& category, const QString& name, tracing::EventType type, uint64_t payload) {
+    if (recordingEnabled()) {
+        auto tracer = DependencyManager::get<tracing::Tracer>();
+        tracer->getRecorder().record(category, name, type, tracing::Tracer::now(), (int64_t)payload);
+    }
+}
+
 DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
 }
 
@@ -57,7 +75,11 @@ Duration::Duration(const QLoggingCategory& category,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
+    if (!category.isDebugEnabled()) {
+        return;
+    }
+
+    if (tracingEnabled()) {
         QVariantMap args = baseArgs;
         args["nv_payload"] = QVariant::fromValue(payload);
         tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
@@ -75,15 +97,24 @@ Duration::Duration(const QLoggingCategory& category,
 
         nvtxRangePushEx(&eventAttrib);
 #endif
+    } else {
+        // the recorder keeps no arguments, so skip building them
+        recordDuration(_category, _name, tracing::DurationBegin, payload);
     }
 }
 
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    if (!_category.isDebugEnabled()) {
+        return;
+    }
+
+    if (tracingEnabled()) {
         tracing::traceEvent(_category, _name, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
+    } else {
+        recordDuration(_category, _name, tracing::DurationEnd, 0);
     }
 }
 
@@ -118,7 +149,7 @@ ConditionalDuration::ConditionalDuration(const QLoggingCategory& category, const
 }
 
 ConditionalDuration::~ConditionalDuration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    if ((tracingEnabled() || recordingEnabled()) && _category.isDebugEnabled()) {
         auto endTime = tracing::Tracer::now();
         auto duration = endTime - _startTime;
         if (duration >= _minTime) {
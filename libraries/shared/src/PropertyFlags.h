@@ -52,6 +52,11 @@ public:
     
     void setHasProperty(Enum flag, bool value = true);
     bool getHasProperty(Enum flag) const;
+    // true if any property is set in both, without building the intersection (only looks at the properties that have
+    // been previously set, like the bitwise operators below)
+    bool intersects(const PropertyFlags& other) const;
+    // the first flag set at or after flag, or -1 if there is none, skipping a byte of unset flags at a time
+    int getNextProperty(int flag) const;
     QByteArray encode();
     size_t decode(const uint8_t* data, size_t length);
     size_t decode(const QByteArray& fromEncoded);
@@ -156,6 +161,45 @@ template<typename Enum> inline bool PropertyFlags<Enum>::getHasProperty(Enum fla
     return _flags.testBit(flag);
 }
 
+template<typename Enum> inline bool PropertyFlags<Enum>::intersects(const PropertyFlags& other) const {
+    int firstFlag = std::max(_minFlag, other._minFlag);
+    int lastFlag = std::min(_maxFlag, other._maxFlag);
+    for (int flag = firstFlag; flag <= lastFlag; flag++) {
+        if (_flags.testBit(flag) && other._flags.testBit(flag)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Enum> inline int PropertyFlags<Enum>::getNextProperty(int flag) const {
+    if (flag < 0) {
+        flag = 0;
+    }
+    if (flag > _maxFlag) {
+        return _trailingFlipped ? flag : -1;
+    }
+    const uchar* bytes = reinterpret_cast<const uchar*>(_flags.bits());
+    int numBytes = (_flags.size() + 7) / 8;
+    int byteIndex = flag / 8;
+    uchar byte = bytes[byteIndex] & (uchar)(0xFF << (flag % 8));
+    while (byte == 0) {
+        if (++byteIndex == numBytes) {
+            return _trailingFlipped ? _maxFlag + 1 : -1;
+        }
+        byte = bytes[byteIndex];
+    }
+    int nextFlag = byteIndex * 8;
+    while ((byte & 1) == 0) {
+        byte >>= 1;
+        ++nextFlag;
+    }
+    if (nextFlag > _maxFlag) {
+        return _trailingFlipped ? _maxFlag + 1 : -1;
+    }
+    return nextFlag;
+}
+
 const int BITS_PER_BYTE = 8;
 
 template<typename Enum> inline QByteArray PropertyFlags<Enum>::encode() {
@@ -26,6 +26,8 @@
 #include <QtScript/QScriptValueIterator>
 #include <QJsonDocument>
 
+#include "BaseScriptEngine.h"
+
 int uint32MetaTypeId = qRegisterMetaType<glm::uint32>("uint32");
 int glmUint32MetaTypeId = qRegisterMetaType<glm::uint32>("glm::uint32");
 int vec2MetaTypeId = qRegisterMetaType<glm::vec2>();
@@ -46,6 +48,11 @@ int voidLambdaType = qRegisterMetaType<std::function<void()>>();
 int variantLambdaType = qRegisterMetaType<std::function<QVariant()>>();
 int stencilModeMetaTypeId = qRegisterMetaType<StencilMaskMode>();
 
+// the numbers are read directly, anything else as it converts through a QVariant
+static inline float scriptValueToFloat(const QScriptValue& value) {
+    return value.isNumber() ? (float)value.toNumber() : value.toVariant().toFloat();
+}
+
 void registerMetaTypes(QScriptEngine* engine) {
     qScriptRegisterMetaType(engine, vec2ToScriptValue, vec2FromScriptValue);
     qScriptRegisterMetaType(engine, vec3ToScriptValue, vec3FromScriptValue);
@@ -170,7 +177,7 @@ glm::vec2 vec2FromVariant(const QVariant &object) {
     return vec2FromVariant(object, valid);
 }
 
-QScriptValue vec3ToScriptValue(QScriptEngine* engine, const glm::vec3& vec3) {
+QScriptValue getVec3Prototype(QScriptEngine* engine) {
     auto prototype = engine->globalObject().property("__hifi_vec3__");
     if (!prototype.property("defined").toBool()) {
         prototype = engine->evaluate(
@@ -188,11 +195,23 @@ QScriptValue vec3ToScriptValue(QScriptEngine* engine, const glm::vec3& vec3) {
             "})"
         );
     }
+    return prototype;
+}
+
+QScriptValue vec3ToScriptValue(QScriptEngine* engine, const glm::vec3& vec3) {
     QScriptValue value = engine->newObject();
+    auto handles = BaseScriptEngine::getValueTypeHandles(engine);
+    if (handles) {
+        value.setProperty(handles->x, vec3.x);
+        value.setProperty(handles->y, vec3.y);
+        value.setProperty(handles->z, vec3.z);
+        value.setPrototype(handles->vec3Prototype);
+        return value;
+    }
     value.setProperty("x", vec3.x);
     value.setProperty("y", vec3.y);
     value.setProperty("z", vec3.z);
-    value.setPrototype(prototype);
+    value.setPrototype(getVec3Prototype(engine));
     return value;
 }
 
@@ -239,6 +258,34 @@ void vec3FromScriptValue(const QScriptValue& object, glm::vec3& vec3) {
             vec3.y = list[1].toFloat();
             vec3.z = list[2].toFloat();
         }
+    } else if (auto handles = BaseScriptEngine::getValueTypeHandles(object.engine())) {
+        QScriptValue x = object.property(handles->x);
+        if (!x.isValid()) {
+            x = object.property(handles->r);
+        }
+        if (!x.isValid()) {
+            x = object.property(handles->red);
+        }
+
+        QScriptValue y = object.property(handles->y);
+        if (!y.isValid()) {
+            y = object.property(handles->g);
+        }
+        if (!y.isValid()) {
+            y = object.property(handles->green);
+        }
+
+        QScriptValue z = object.property(handles->z);
+        if (!z.isValid()) {
+            z = object.property(handles->b);
+        }
+        if (!z.isValid()) {
+            z = object.property(handles->blue);
+        }
+
+        vec3.x = scriptValueToFloat(x);
+        vec3.y = scriptValueToFloat(y);
+        vec3.z = scriptValueToFloat(z);
     } else {
         QScriptValue x = object.property("x");
         if (!x.isValid()) {
@@ -765,6 +812,14 @@ QScriptValue quatToScriptValue(QScriptEngine* engine, const glm::quat& quat) {
         // if quat contains a NaN don't try to convert it
         return obj;
     }
+    auto handles = BaseScriptEngine::getValueTypeHandles(engine);
+    if (handles) {
+        obj.setProperty(handles->x, quat.x);
+        obj.setProperty(handles->y, quat.y);
+        obj.setProperty(handles->z, quat.z);
+        obj.setProperty(handles->w, quat.w);
+        return obj;
+    }
     obj.setProperty("x", quat.x);
     obj.setProperty("y", quat.y);
     obj.setProperty("z", quat.z);
@@ -773,10 +828,18 @@ QScriptValue quatToScriptValue(QScriptEngine* engine, const glm::quat& quat) {
 }
 
 void quatFromScriptValue(const QScriptValue& object, glm::quat &quat) {
-    quat.x = object.property("x").toVariant().toFloat();
-    quat.y = object.property("y").toVariant().toFloat();
-    quat.z = object.property("z").toVariant().toFloat();
-    quat.w = object.property("w").toVariant().toFloat();
+    auto handles = BaseScriptEngine::getValueTypeHandles(object.engine());
+    if (handles) {
+        quat.x = scriptValueToFloat(object.property(handles->x));
+        quat.y = scriptValueToFloat(object.property(handles->y));
+        quat.z = scriptValueToFloat(object.property(handles->z));
+        quat.w = scriptValueToFloat(object.property(handles->w));
+    } else {
+        quat.x = object.property("x").toVariant().toFloat();
+        quat.y = object.property("y").toVariant().toFloat();
+        quat.z = object.property("z").toVariant().toFloat();
+        quat.w = object.property("w").toVariant().toFloat();
+    }
 
     // enforce normalized quaternion
     float length = glm::length(quat);
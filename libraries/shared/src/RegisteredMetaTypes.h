@@ -116,6 +116,8 @@ glm::vec2 vec2FromVariant(const QVariant& object);
 * Entities.editEntity(<id>, { position: "#00FF00"});                            // { x: 0, y: 255, z: 0 }
 */
 QScriptValue vec3ToScriptValue(QScriptEngine* engine, const glm::vec3& vec3);
+// the prototype with the index and color accessors of the vec3 values
+QScriptValue getVec3Prototype(QScriptEngine* engine);
 QScriptValue vec3ColorToScriptValue(QScriptEngine* engine, const glm::vec3& vec3);
 void vec3FromScriptValue(const QScriptValue& object, glm::vec3& vec3);
 
@@ -99,6 +99,11 @@ void ShapeInfo::clear() {
     _sphereCollection.clear();
     _halfExtents = glm::vec3(0.0f);
     _offset = glm::vec3(0.0f);
+    _bakedBVH.clear();
+    _bakedMeshScale = glm::vec3(1.0f);
+    _bakedMeshRotation = glm::quat();
+    _bakedMeshTranslation = glm::vec3(0.0f);
+    _hasBakedMesh = false;
     _hash64 = 0;
     _type = SHAPE_TYPE_NONE;
 }
@@ -177,6 +182,15 @@ void ShapeInfo::setOffset(const glm::vec3& offset) {
     _hash64 = 0;
 }
 
+void ShapeInfo::setBakedMesh(const QByteArray& bvh, const glm::vec3& scale, const glm::quat& rotation, const glm::vec3& translation) {
+    _bakedBVH = bvh;
+    _bakedMeshScale = scale;
+    _bakedMeshRotation = rotation;
+    _bakedMeshTranslation = translation;
+    _hasBakedMesh = true;
+    _hash64 = 0;
+}
+
 uint32_t ShapeInfo::getNumSubShapes() const {
     switch (_type) {
         case SHAPE_TYPE_NONE:
@@ -282,6 +296,13 @@ uint64_t ShapeInfo::getHash() const {
         } else if (_type != SHAPE_TYPE_SIMPLE_HULL) {
             hasher.hashVec3(_halfExtents);
             hasher.hashVec3(_offset);
+            if (_hasBakedMesh) {
+                // the baked mesh is positioned differently from the one built from the model's meshes
+                hasher.hashVec3(_bakedMeshScale);
+                hasher.hashVec3(glm::vec3(_bakedMeshRotation.x, _bakedMeshRotation.y, _bakedMeshRotation.z));
+                hasher.hashFloat(_bakedMeshRotation.w);
+                hasher.hashVec3(_bakedMeshTranslation);
+            }
         } else {
             // TODO: we could avoid hashing all of these points if we were to supply the ShapeInfo with a unique
             // descriptive string.  Shapes that are uniquely described by their type and URL could just put their
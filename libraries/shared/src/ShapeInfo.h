@@ -12,10 +12,12 @@
 #ifndef hifi_ShapeInfo_h
 #define hifi_ShapeInfo_h
 
+#include <QByteArray>
 #include <QVector>
 #include <QString>
 #include <QUrl>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
 
 const float MIN_SHAPE_OFFSET = 0.001f; // offsets less than 1mm will be ignored
@@ -71,11 +73,21 @@ public:
     void setCapsuleY(float radius, float cylinderHalfHeight);
     void setMultiSphere(const std::vector<glm::vec3>& centers, const std::vector<float>& radiuses);
     void setOffset(const glm::vec3& offset);    
+    // For a static mesh baked along with its model: the bounding volume hierarchy baked over its points and triangle
+    // indices, which are then as the model had them, and the scale, rotation and translation, in that order, from there to
+    // the shape frame
+    void setBakedMesh(const QByteArray& bvh, const glm::vec3& scale, const glm::quat& rotation, const glm::vec3& translation);
 
     ShapeType getType() const { return _type; }
 
     const glm::vec3& getHalfExtents() const { return _halfExtents; }
     const glm::vec3& getOffset() const { return _offset; }
+    const QUrl& getURL() const { return _url; }
+    bool hasBakedMesh() const { return _hasBakedMesh; }
+    const QByteArray& getBakedBVH() const { return _bakedBVH; }
+    const glm::vec3& getBakedMeshScale() const { return _bakedMeshScale; }
+    const glm::quat& getBakedMeshRotation() const { return _bakedMeshRotation; }
+    const glm::vec3& getBakedMeshTranslation() const { return _bakedMeshTranslation; }
     uint32_t getNumSubShapes() const;
 
     PointCollection& getPointCollection() { return _pointCollection; }
@@ -100,6 +112,11 @@ protected:
     TriangleIndices _triangleIndices;
     glm::vec3 _halfExtents = glm::vec3(0.0f);
     glm::vec3 _offset = glm::vec3(0.0f);
+    QByteArray _bakedBVH;
+    glm::vec3 _bakedMeshScale = glm::vec3(1.0f);
+    glm::quat _bakedMeshRotation;
+    glm::vec3 _bakedMeshTranslation = glm::vec3(0.0f);
+    bool _hasBakedMesh { false };
     mutable uint64_t _hash64;
     ShapeType _type = SHAPE_TYPE_NONE;
 };
@@ -49,6 +49,7 @@ extern "C" FILE * __cdecl __iob_func(void) {
 #if defined(Q_OS_LINUX) || defined(Q_OS_MAC)
 #include <signal.h>
 #include <cerrno>
+#include <unistd.h>
 #endif
 
 #include <QtCore/QDebug>
@@ -887,6 +888,23 @@ bool getMemoryInfo(MemoryInfo& info) {
     return false;
 }
 
+uint64_t getTotalPhysicalMemory() {
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX ms;
+    ms.dwLength = sizeof(ms);
+    if (GlobalMemoryStatusEx(&ms)) {
+        return ms.ullTotalPhys;
+    }
+#elif defined(Q_OS_LINUX) || defined(Q_OS_MAC)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && pageSize > 0) {
+        return (uint64_t)pages * (uint64_t)pageSize;
+    }
+#endif
+    return 0;
+}
+
 // Largely taken from: https://msdn.microsoft.com/en-us/library/windows/desktop/ms683194(v=vs.85).aspx
 
 #ifdef Q_OS_WIN
@@ -207,6 +207,9 @@ struct MemoryInfo {
 
 bool getMemoryInfo(MemoryInfo& info);
 
+// The physical memory installed, or 0 if it can't be told
+uint64_t getTotalPhysicalMemory();
+
 struct ProcessorInfo {
     int32_t numPhysicalProcessorPackages;
     int32_t numProcessorCores;
@@ -15,6 +15,8 @@
 const uint8_t YIELD_SIMULATION_PRIORITY = 1;
 const uint8_t VOLUNTEER_SIMULATION_PRIORITY = YIELD_SIMULATION_PRIORITY + 1;
 const uint8_t RECRUIT_SIMULATION_PRIORITY = VOLUNTEER_SIMULATION_PRIORITY + 1;
+// a headless simulator of a region bids above the VOLUNTEER and RECRUIT bids of the clients but below their scripts
+const uint8_t SERVER_SIMULATION_PRIORITY = RECRUIT_SIMULATION_PRIORITY + 1;
 
 const uint8_t SCRIPT_GRAB_SIMULATION_PRIORITY = 128;
 const uint8_t SCRIPT_POKE_SIMULATION_PRIORITY = SCRIPT_GRAB_SIMULATION_PRIORITY - 1;
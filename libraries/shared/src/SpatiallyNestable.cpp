@@ -80,6 +80,10 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    if (parentChanged) {
+        invalidateWorldTransform();
+        invalidateDescendantWorldTransforms();
+    }
 
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
@@ -185,7 +189,11 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        invalidateWorldTransform();
+        invalidateDescendantWorldTransforms();
+    }
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -513,6 +521,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
             }
             if (changed) {
                 Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+                invalidateWorldTransform();
                 _translationChanged = usecTimestampNow();
             }
         });
@@ -557,6 +566,7 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
             changed = true;
             myWorldTransform.setTranslation(position);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            invalidateWorldTransform();
             _translationChanged = usecTimestampNow();
         }
     });
@@ -610,6 +620,7 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
             changed = true;
             myWorldTransform.setRotation(orientation);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            invalidateWorldTransform();
             _rotationChanged = usecTimestampNow();
         }
     });
@@ -747,12 +758,33 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 }
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
+    uint32_t generation = _worldTransformGeneration.load(std::memory_order_acquire);
+    {
+        std::lock_guard<std::mutex> lock(_worldTransformCacheMutex);
+        // a parent that has gone since leaves the transform to be found again, failing as it did before caching
+        if (_cachedWorldTransformGeneration == generation && !(_cachedWorldTransformHasParent && _parent.expired())) {
+            success = true;
+            return _cachedWorldTransform;
+        }
+    }
+
     Transform result;
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    // the transform is only kept if nothing moved while it was found, else the next call finds it again
+    if (success) {
+        bool hasParent = !_parent.expired();
+        std::lock_guard<std::mutex> lock(_worldTransformCacheMutex);
+        if (_worldTransformGeneration.load(std::memory_order_acquire) == generation) {
+            _cachedWorldTransform = result;
+            _cachedWorldTransformGeneration = generation;
+            _cachedWorldTransformHasParent = hasParent;
+        }
+    }
     return result;
 }
 
@@ -828,6 +860,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             Transform::inverseMult(_transform, parentTransform, transform);
             if (_transform != beforeTransform) {
                 changed = true;
+                invalidateWorldTransform();
                 _translationChanged = usecTimestampNow();
                 _rotationChanged = usecTimestampNow();
             }
@@ -884,10 +917,13 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
             changed = true;
             myWorldTransform.setScale(scale);
             Transform::inverseMult(_transform, parentTransform, myWorldTransform);
+            invalidateWorldTransform();
             _scaleChanged = usecTimestampNow();
         }
     });
     if (success && changed) {
+        // the children's world transforms carry this scale, though their locations haven't changed
+        invalidateDescendantWorldTransforms();
         dimensionsChanged();
     }
 }
@@ -911,6 +947,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     _transformLock.withWriteLock([&] {
         if (_transform != transform) {
             _transform = transform;
+            invalidateWorldTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
@@ -941,6 +978,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
     _transformLock.withWriteLock([&] {
         if (_transform.getTranslation() != position) {
             _transform.setTranslation(position);
+            invalidateWorldTransform();
             changed = true;
             _translationChanged = usecTimestampNow();
         }
@@ -968,6 +1006,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
     _transformLock.withWriteLock([&] {
         if (_transform.getRotation() != orientation) {
             _transform.setRotation(orientation);
+            invalidateWorldTransform();
             changed = true;
             _rotationChanged = usecTimestampNow();
         }
@@ -1024,11 +1063,13 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         if (_transform.getScale() != scale) {
             _transform.setScale(scale);
+            invalidateWorldTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
         }
     });
     if (changed) {
+        invalidateDescendantWorldTransforms();
         dimensionsChanged();
     }
 }
@@ -1128,6 +1169,8 @@ void SpatiallyNestable::forEachDescendantTest(const ChildLambdaTest& actor) cons
 }
 
 void SpatiallyNestable::locationChanged(bool tellPhysics, bool tellChildren) {
+    // this is also how the avatars and the animated models tell the children of their joints that they moved, once a frame
+    invalidateWorldTransform();
     if (tellChildren) {
         forEachChild([&](SpatiallyNestablePointer object) {
             object->locationChanged(tellPhysics, tellChildren);
@@ -1135,6 +1178,12 @@ void SpatiallyNestable::locationChanged(bool tellPhysics, bool tellChildren) {
     }
 }
 
+void SpatiallyNestable::invalidateDescendantWorldTransforms() {
+    forEachDescendant([](const SpatiallyNestablePointer& descendant) {
+        descendant->invalidateWorldTransform();
+    });
+}
+
 AACube SpatiallyNestable::getMaximumAACube(bool& success) const {
     return AACube(getWorldPosition(success) - glm::vec3(defaultAACubeSize / 2.0f), defaultAACubeSize);
 }
@@ -1377,6 +1426,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     _transformLock.withWriteLock([&] {
         if (_transform != localTransform) {
             _transform = localTransform;
+            invalidateWorldTransform();
             changed = true;
             _scaleChanged = usecTimestampNow();
             _translationChanged = usecTimestampNow();
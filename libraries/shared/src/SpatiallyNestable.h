@@ -12,6 +12,9 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+#include <mutex>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -250,6 +253,11 @@ protected:
 
     mutable std::atomic<uint32_t> _ancestorChainRenderableVersion { 0 };
 
+    // called when this object's world transform has changed without its location changing, as when its parent or the
+    // scale it has passed on changes
+    void invalidateWorldTransform() { _worldTransformGeneration.fetch_add(1, std::memory_order_release); }
+    void invalidateDescendantWorldTransforms();
+
 private:
     SpatiallyNestable() = delete;
     const NestableType _nestableType; // EntityItem or an AvatarData
@@ -261,6 +269,14 @@ private:
     mutable ReadWriteLockable _velocityLock;
     mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
+
+    // getTransform keeps the world transform it finds until the generation is bumped, by a change of the local
+    // transform or the parenting here or by locationChanged, which the ancestors call down their children as they move
+    std::atomic<uint32_t> _worldTransformGeneration { 1 };
+    mutable std::mutex _worldTransformCacheMutex;
+    mutable Transform _cachedWorldTransform;
+    mutable uint32_t _cachedWorldTransformGeneration { 0 };
+    mutable bool _cachedWorldTransformHasParent { false };
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
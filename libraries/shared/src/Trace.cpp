@@ -40,6 +40,30 @@ bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+// the one number the recorder keeps of the arguments of an event
+static int64_t recordedValue(EventType type, const QString& id, const QVariantMap& args) {
+    if (type == Counter) {
+        return args.empty() ? 0 : TraceRecorder::counterToValue(args.first().toDouble());
+    }
+    if (type == DurationBegin) {
+        return args.value("nv_payload").toLongLong();
+    }
+    if (id.isEmpty()) {
+        return 0;
+    }
+    bool ok;
+    int64_t numericID = id.toLongLong(&ok);
+    return ok ? numericID : (int64_t)qHash(id);
+}
+
+Tracer::Tracer() {
+    bool ok = false;
+    float recorderSeconds = qEnvironmentVariable("HIFI_TRACE_RECORDER_SECONDS").toFloat(&ok);
+    if (ok && recorderSeconds > 0.0f) {
+        _recorder.start(recorderSeconds);
+    }
+}
+
 void Tracer::startTracing() {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
@@ -226,7 +250,7 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
-    if (!_enabled && type != Metadata) {
+    if (!_enabled && type != Metadata && !_recorder.isRecording()) {
         return;
     }
 
@@ -236,6 +260,14 @@ void Tracer::traceEvent(const QLoggingCategory& category,
 void Tracer::traceEvent(const QLoggingCategory& category, 
     const QString& name, EventType type, int64_t timestamp, const QString& id, 
     const QVariantMap& args, const QVariantMap& extra) {
+    if (type == Metadata) {
+        if (name == "thread_name") {
+            _recorder.setThreadName(args.value("name").toString());
+        }
+    } else if (_recorder.isRecording()) {
+        _recorder.record(category, name, type, timestamp, recordedValue(type, id, args));
+    }
+
     if (!_enabled && type != Metadata) {
         return;
     }
@@ -20,6 +20,7 @@
 #include <QtCore/QLoggingCategory>
 
 #include "DependencyManager.h"
+#include "TraceRecorder.h"
 
 namespace tracing {
 
@@ -78,6 +79,9 @@ struct TraceEvent {
 
 class Tracer : public Dependency {
 public:
+    // starts the recorder when $HIFI_TRACE_RECORDER_SECONDS is set
+    Tracer();
+
     static int64_t now();
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -95,6 +99,10 @@ public:
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // the flight recorder, which keeps the last events whether or not tracing is enabled
+    TraceRecorder& getRecorder() { return _recorder; }
+    bool isRecording() const { return _recorder.isRecording(); }
+
 private:
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -106,6 +114,7 @@ private:
     std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+    TraceRecorder _recorder;
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
@@ -132,6 +141,17 @@ inline void traceEvent(const QLoggingCategory& category, const QString& name, Ev
     traceEvent(category, name, type, QString::number(id), args, extra);
 }
 
+// dumps the flight recorder, if it is recording, when something went wrong
+inline void requestRecordingDump(const QString& reason) {
+    if (!DependencyManager::isSet<Tracer>()) {
+        return;
+    }
+    const auto& tracer = DependencyManager::get<Tracer>();
+    if (tracer && tracer->isRecording()) {
+        tracer->getRecorder().requestDump(reason);
+    }
+}
+
 }
 
 #endif // hifi_Trace_h
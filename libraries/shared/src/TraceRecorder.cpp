@@ -0,0 +1,437 @@
+//
+//  TraceRecorder.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+#include "Gzip.h"
+#include "NumericalConstants.h"
+#include "SharedLogging.h"
+#include "Trace.h"
+#include "shared/FileUtils.h"
+
+using namespace tracing;
+
+namespace {
+    // unique across recorders, so that a thread never mistakes the rings of one for those of another
+    std::atomic<uint64_t> nextGeneration { 1 };
+
+    struct ThreadEvents {
+        int64_t threadID;
+        QString threadName;
+        std::vector<RecordedEvent> events;
+    };
+}
+
+// the ring and interned names of the current thread
+struct TraceRecorder::ThreadState {
+    ~ThreadState() {
+        if (buffer) {
+            buffer->_isFinished.store(true, std::memory_order_release);
+        }
+    }
+
+    uint64_t generation { 0 };
+    std::shared_ptr<ThreadBuffer> buffer;
+    QString threadName;
+    QHash<QString, uint32_t> names;
+    QHash<const QLoggingCategory*, uint32_t> categories;
+};
+
+TraceRecorder::ThreadBuffer::ThreadBuffer(size_t capacity) :
+    _events(new RecordedEvent[capacity]),
+    _mask(capacity - 1)
+{
+}
+
+std::vector<RecordedEvent> TraceRecorder::ThreadBuffer::snapshot() const {
+    const uint64_t capacity = _mask + 1;
+    uint64_t head = _head.load(std::memory_order_acquire);
+    uint64_t begin = head > capacity ? head - capacity : 0;
+
+    std::vector<RecordedEvent> events;
+    events.reserve(head - begin);
+    for (uint64_t i = begin; i < head; ++i) {
+        events.push_back(_events[i & _mask]);
+    }
+
+    // the thread kept writing while the events were copied: drop those it overwrote, and the one it may be writing
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t headAfter = _head.load(std::memory_order_relaxed);
+    uint64_t firstIntact = headAfter + 1 > capacity ? headAfter + 1 - capacity : 0;
+    if (firstIntact > begin) {
+        size_t numOverwritten = (size_t)std::min<uint64_t>(firstIntact - begin, events.size());
+        events.erase(events.begin(), events.begin() + numOverwritten);
+    }
+    return events;
+}
+
+TraceRecorder::~TraceRecorder() {
+    std::lock_guard<std::mutex> lock(_dumpMutex);
+    if (_dumpThread.joinable()) {
+        _dumpThread.join();
+    }
+}
+
+void TraceRecorder::start(float seconds, size_t eventsPerThread) {
+    size_t capacity = 2;
+    while (capacity < eventsPerThread) {
+        capacity <<= 1;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _buffers.clear();
+    _names.clear();
+    _nameIDs.clear();
+    _seconds = seconds;
+    _eventsPerThread = capacity;
+    _generation.store(nextGeneration.fetch_add(1), std::memory_order_release);
+    _isRecording.store(true, std::memory_order_release);
+
+    qCDebug(shared) << "Recording the last" << seconds << "seconds of trace events," << capacity << "events per thread";
+}
+
+void TraceRecorder::stop() {
+    _isRecording.store(false, std::memory_order_release);
+}
+
+TraceRecorder::ThreadState& TraceRecorder::getThreadState() {
+    static thread_local ThreadState state;
+    return state;
+}
+
+bool TraceRecorder::attach(ThreadState& state) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!isRecording()) {
+        return false;
+    }
+
+    if (state.buffer) {
+        state.buffer->_isFinished.store(true, std::memory_order_release);
+        state.buffer.reset();
+    }
+    state.names.clear();
+    state.categories.clear();
+
+    // take the ring of a finished thread once its last event is older than what a dump keeps
+    int64_t expiredTimestamp = Tracer::now() - (int64_t)(_seconds * USECS_PER_SECOND);
+    for (const auto& buffer : _buffers) {
+        if (buffer->_isFinished.load(std::memory_order_acquire)) {
+            uint64_t head = buffer->_head.load(std::memory_order_relaxed);
+            if (head == 0 || buffer->_events[(head - 1) & buffer->_mask].timestamp < expiredTimestamp) {
+                buffer->_head.store(0, std::memory_order_relaxed);
+                buffer->_isFinished.store(false, std::memory_order_relaxed);
+                state.buffer = buffer;
+                break;
+            }
+        }
+    }
+    if (!state.buffer) {
+        state.buffer = std::make_shared<ThreadBuffer>(_eventsPerThread);
+        _buffers.push_back(state.buffer);
+    }
+
+    state.buffer->_threadID = int64_t(QThread::currentThreadId());
+    state.buffer->_threadName = state.threadName;
+    state.generation = _generation.load(std::memory_order_acquire);
+    return true;
+}
+
+uint32_t TraceRecorder::intern(ThreadState& state, const QString& name) {
+    auto it = state.names.constFind(name);
+    if (it != state.names.constEnd()) {
+        return it.value();
+    }
+
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = _nameIDs.constFind(name);
+        if (found != _nameIDs.constEnd()) {
+            id = found.value();
+        } else {
+            id = (uint32_t)_names.size();
+            _names.push_back(name);
+            _nameIDs.insert(name, id);
+        }
+    }
+    state.names.insert(name, id);
+    return id;
+}
+
+uint32_t TraceRecorder::internCategory(ThreadState& state, const QLoggingCategory& category) {
+    auto it = state.categories.constFind(&category);
+    if (it != state.categories.constEnd()) {
+        return it.value();
+    }
+
+    uint32_t id = intern(state, QString(category.categoryName()));
+    state.categories.insert(&category, id);
+    return id;
+}
+
+void TraceRecorder::record(const QLoggingCategory& category, const QString& name, char type, int64_t timestamp,
+                           int64_t value) {
+    if (!isRecording()) {
+        return;
+    }
+
+    ThreadState& state = getThreadState();
+    if (state.generation != _generation.load(std::memory_order_acquire) && !attach(state)) {
+        return;
+    }
+
+    RecordedEvent event {};
+    event.timestamp = timestamp;
+    event.value = value;
+    event.name = intern(state, name);
+    event.category = internCategory(state, category);
+    event.type = type;
+    state.buffer->push(event);
+}
+
+void TraceRecorder::setThreadName(const QString& name) {
+    ThreadState& state = getThreadState();
+    state.threadName = name;
+    if (state.buffer && state.generation == _generation.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        state.buffer->_threadName = name;
+    }
+}
+
+bool TraceRecorder::dump(const QString& filename, const QString& reason) {
+    QString fullPath = FileUtils::replaceDateTimeTokens(filename);
+    fullPath = FileUtils::computeDocumentPath(fullPath);
+    if (!FileUtils::canCreateFile(fullPath)) {
+        return false;
+    }
+
+    std::vector<QString> names;
+    std::vector<ThreadEvents> threads;
+    float seconds;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        names = _names;
+        seconds = _seconds;
+        for (const auto& buffer : _buffers) {
+            threads.push_back({ buffer->_threadID, buffer->_threadName, buffer->snapshot() });
+        }
+    }
+
+    int64_t endTimestamp = Tracer::now();
+    int64_t beginTimestamp = endTimestamp - (int64_t)(seconds * USECS_PER_SECOND);
+
+    QSaveFile file(fullPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "Failed to open the trace recording" << fullPath;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out << FILE_MAGIC << FILE_VERSION;
+    out << (qint64)QCoreApplication::applicationPid() << QCoreApplication::applicationName() << reason;
+    out << (qint64)beginTimestamp << (qint64)endTimestamp;
+
+    out << (quint32)names.size();
+    for (const auto& name : names) {
+        out << name;
+    }
+
+    out << (quint32)threads.size();
+    for (const auto& thread : threads) {
+        auto first = std::find_if(thread.events.begin(), thread.events.end(), [&](const RecordedEvent& event) {
+            return event.timestamp >= beginTimestamp;
+        });
+        out << (qint64)thread.threadID << thread.threadName << (quint32)(thread.events.end() - first);
+        for (auto it = first; it != thread.events.end(); ++it) {
+            out << (qint64)it->timestamp << (qint64)it->value << (quint32)it->name << (quint32)it->category
+                << (qint8)it->type;
+        }
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qCWarning(shared) << "Failed to write the trace recording" << fullPath;
+        return false;
+    }
+
+    qCDebug(shared) << "Wrote the trace recording" << fullPath;
+    return true;
+}
+
+void TraceRecorder::requestDump(const QString& reason) {
+    if (!isRecording()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_dumpMutex);
+    int64_t now = Tracer::now();
+    if (_lastDumpRequest != 0 && now - _lastDumpRequest < MIN_DUMP_INTERVAL_SECS * USECS_PER_SECOND) {
+        return;
+    }
+    _lastDumpRequest = now;
+
+    // the last dump finished long ago
+    if (_dumpThread.joinable()) {
+        _dumpThread.join();
+    }
+
+    QString filename = "traces/" + QCoreApplication::applicationName() + "-" +
+        QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss") + ".hftrace";
+    qCDebug(shared) << "Dumping the trace recording after" << reason;
+    _dumpThread = std::thread([this, filename, reason] {
+        dump(filename, reason);
+    });
+}
+
+bool TraceRecorder::convertToJson(const QString& dumpFilename, const QString& jsonFilename) {
+    QFile file(dumpFilename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(shared) << "Failed to open the trace recording" << dumpFilename;
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != FILE_MAGIC || version != FILE_VERSION) {
+        qCWarning(shared) << dumpFilename << "is not a trace recording of version" << FILE_VERSION;
+        return false;
+    }
+
+    qint64 processID, beginTimestamp, endTimestamp;
+    QString applicationName, reason;
+    in >> processID >> applicationName >> reason >> beginTimestamp >> endTimestamp;
+
+    quint32 numNames;
+    in >> numNames;
+    std::vector<QString> names(numNames);
+    for (auto& name : names) {
+        in >> name;
+    }
+    auto nameOf = [&](quint32 id) {
+        return id < names.size() ? names[id] : QString();
+    };
+
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        out << "[\n";
+        bool first = true;
+        auto writeEvent = [&](const QJsonObject& event) {
+            if (first) {
+                first = false;
+            } else {
+                out << ",\n";
+            }
+            out << QJsonDocument(event).toJson(QJsonDocument::Compact);
+        };
+
+        quint32 numThreads;
+        in >> numThreads;
+        for (quint32 i = 0; i < numThreads && in.status() == QDataStream::Ok; ++i) {
+            qint64 threadID;
+            QString threadName;
+            quint32 numEvents;
+            in >> threadID >> threadName >> numEvents;
+            if (!threadName.isEmpty()) {
+                writeEvent({
+                    { "name", "thread_name" },
+                    { "ph", "M" },
+                    { "pid", processID },
+                    { "tid", threadID },
+                    { "args", QJsonObject { { "name", threadName } } }
+                });
+            }
+
+            for (quint32 j = 0; j < numEvents && in.status() == QDataStream::Ok; ++j) {
+                qint64 timestamp, value;
+                quint32 name, category;
+                qint8 type;
+                in >> timestamp >> value >> name >> category >> type;
+
+                QJsonObject event {
+                    { "name", nameOf(name) },
+                    { "cat", nameOf(category) },
+                    { "ph", QString(QLatin1Char((char)type)) },
+                    { "ts", timestamp },
+                    { "pid", processID },
+                    { "tid", threadID }
+                };
+                switch (type) {
+                    case Counter:
+                        event["args"] = QJsonObject { { nameOf(name), valueToCounter(value) } };
+                        break;
+                    case DurationBegin:
+                        event["args"] = QJsonObject { { "nv_payload", value } };
+                        break;
+                    case Instant:
+                        event["s"] = "t";
+                        break;
+                    case AsyncNestableStart:
+                    case AsyncNestableInstant:
+                    case AsyncNestableEnd:
+                    case FlowStart:
+                    case FlowStep:
+                    case FlowEnd:
+                        event["id"] = QString::number(value);
+                        break;
+                    default:
+                        break;
+                }
+                writeEvent(event);
+            }
+        }
+        out << "\n]";
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qCWarning(shared) << "The trace recording" << dumpFilename << "is truncated";
+        return false;
+    }
+
+    if (jsonFilename.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(data, compressed);
+        data = compressed;
+    }
+
+    QSaveFile jsonFile(jsonFilename);
+    if (!jsonFile.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "Failed to open" << jsonFilename;
+        return false;
+    }
+    jsonFile.write(data);
+    return jsonFile.commit();
+}
+
+int64_t TraceRecorder::counterToValue(double counter) {
+    int64_t value;
+    memcpy(&value, &counter, sizeof(value));
+    return value;
+}
+
+double TraceRecorder::valueToCounter(int64_t value) {
+    double counter;
+    memcpy(&counter, &value, sizeof(counter));
+    return counter;
+}
@@ -0,0 +1,132 @@
+//
+//  TraceRecorder.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_TraceRecorder_h
+#define hifi_TraceRecorder_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+namespace tracing {
+
+// A trace event as the recorder keeps it: the name and category are interned and the arguments reduced to one number.
+struct RecordedEvent {
+    int64_t timestamp; // usecs, from Tracer::now
+    // the id of async and flow events, the payload of durations or the value of counters, as the bits of a double
+    int64_t value;
+    uint32_t name;
+    uint32_t category;
+    char type; // a tracing::EventType
+    char reserved[7];
+};
+
+static_assert(sizeof(RecordedEvent) == 32, "RecordedEvent should stay a fixed 32 bytes");
+
+// Keeps the last seconds of trace events of every thread in memory at all times (a "flight recorder") and writes them
+// to a binary file on demand, or when something went wrong. Each thread writes to a ring of its own without locks or
+// allocations once its names are interned, so that recording can be left on in production, servers included.
+//   A dump is converted offline, with convertToJson or tools/trace-convert, to the Chrome trace event JSON that
+//   chrome://tracing and Perfetto read.
+class TraceRecorder {
+public:
+    static const uint32_t FILE_MAGIC = 0x48465452; // "HFTR"
+    static const uint32_t FILE_VERSION = 1;
+    static const size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+    static const int MIN_DUMP_INTERVAL_SECS = 60;
+
+    ~TraceRecorder();
+
+    // drops the events recorded so far; the events per thread are rounded up to a power of two
+    void start(float seconds, size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+    void stop();
+    bool isRecording() const { return _isRecording.load(std::memory_order_relaxed); }
+    float getSeconds() const { return _seconds; }
+
+    // thread-safe
+    void record(const QLoggingCategory& category, const QString& name, char type, int64_t timestamp, int64_t value = 0);
+    void setThreadName(const QString& name);
+
+    // thread-safe, writes the events of the last seconds of every thread and returns false if they could not be written
+    bool dump(const QString& filename, const QString& reason = QString());
+
+    // thread-safe, dumps to the traces folder of the documents on a worker thread, at most once every
+    // MIN_DUMP_INTERVAL_SECS, for when something went wrong such as a frame overrun
+    void requestDump(const QString& reason);
+
+    // converts a dump to Chrome trace event JSON, compressed if the filename ends in .gz
+    static bool convertToJson(const QString& dumpFilename, const QString& jsonFilename);
+
+    // the RecordedEvent value of a counter, and back
+    static int64_t counterToValue(double counter);
+    static double valueToCounter(int64_t value);
+
+private:
+    // the ring of one thread, written only by that thread
+    struct ThreadBuffer {
+        ThreadBuffer(size_t capacity);
+
+        void push(const RecordedEvent& event) {
+            uint64_t head = _head.load(std::memory_order_relaxed);
+            _events[head & _mask] = event;
+            _head.store(head + 1, std::memory_order_release);
+        }
+
+        // the events that were not overwritten while they were copied, oldest first
+        std::vector<RecordedEvent> snapshot() const;
+
+        std::unique_ptr<RecordedEvent[]> _events;
+        size_t _mask;
+        std::atomic<uint64_t> _head { 0 };
+
+        // guarded by the mutex of the recorder
+        int64_t _threadID { 0 };
+        QString _threadName;
+
+        // set when its thread exits, so that the ring can be handed to a new thread
+        std::atomic<bool> _isFinished { false };
+    };
+
+    struct ThreadState;
+    static ThreadState& getThreadState();
+
+    // gives the thread a ring of this recording, false if not recording
+    bool attach(ThreadState& state);
+    uint32_t intern(ThreadState& state, const QString& name);
+    uint32_t internCategory(ThreadState& state, const QLoggingCategory& category);
+
+    std::atomic<bool> _isRecording { false };
+    // changes with each start, so that threads drop the rings and names of an earlier recording
+    std::atomic<uint64_t> _generation { 0 };
+    float _seconds { 0.0f };
+    size_t _eventsPerThread { DEFAULT_EVENTS_PER_THREAD };
+
+    std::mutex _mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> _buffers; // guarded by _mutex
+    std::vector<QString> _names; // guarded by _mutex
+    QHash<QString, uint32_t> _nameIDs; // guarded by _mutex
+
+    std::mutex _dumpMutex;
+    std::thread _dumpThread; // guarded by _dumpMutex
+    int64_t _lastDumpRequest { 0 }; // guarded by _dumpMutex
+};
+
+}
+
+#endif // hifi_TraceRecorder_h
@@ -0,0 +1,122 @@
+//
+//  BoundedMPSCQueue.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BoundedMPSCQueue_h
+#define hifi_BoundedMPSCQueue_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// A fixed-size lock-free ring (after Dmitry Vyukov's bounded queue) for any number of producers and one consumer.
+// A producer never waits on the consumer: when the ring is full it drops the oldest item to make room,
+// which suits data where a newer item supersedes an older one.
+template <typename T>
+class BoundedMPSCQueue {
+public:
+    // the capacity is rounded up to a power of two
+    explicit BoundedMPSCQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _mask = size - 1;
+        _cells.reset(new Cell[size]);
+        for (size_t i = 0; i < size; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMPSCQueue(const BoundedMPSCQueue&) = delete;
+    BoundedMPSCQueue& operator=(const BoundedMPSCQueue&) = delete;
+
+    // thread-safe, returns false if the oldest item had to be dropped to make room for this one
+    bool push(T value) {
+        bool droppedOldest = false;
+        while (!tryPush(value)) {
+            T dropped;
+            if (tryPop(dropped)) {
+                _numDropped.fetch_add(1, std::memory_order_relaxed);
+                droppedOldest = true;
+            }
+        }
+        return droppedOldest;
+    }
+
+    // thread-safe, returns false without taking the value if the ring is full
+    bool tryPush(T& value) {
+        size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+            if (difference == 0) {
+                if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // full
+            } else {
+                position = _enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // for the consumer (producers also pop when they drop the oldest item)
+    bool tryPop(T& value) {
+        size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &_cells[position & _mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+            if (difference == 0) {
+                if (_dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // empty
+            } else {
+                position = _dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(position + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+    uint64_t getNumDropped() const { return _numDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    size_t _mask { 0 };
+
+    // kept on separate cache lines so producers and the consumer don't contend on them
+    alignas(64) std::atomic<size_t> _enqueuePosition { 0 };
+    alignas(64) std::atomic<size_t> _dequeuePosition { 0 };
+    alignas(64) std::atomic<uint64_t> _numDropped { 0 };
+};
+
+#endif // hifi_BoundedMPSCQueue_h
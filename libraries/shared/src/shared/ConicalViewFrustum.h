@@ -57,6 +57,8 @@ public:
     // Just test for within radius.
     void setPositionAndSimpleRadius(const glm::vec3& position, float radius);
 
+    void translate(const glm::vec3& offset) { _position += offset; }
+
 private:
     glm::vec3 _position { 0.0f, 0.0f, 0.0f };
     glm::vec3 _direction { 0.0f, 0.0f, 1.0f };
@@ -217,6 +217,22 @@ FilePointer FileCache::getFile(const Key& key) {
     return file;
 }
 
+void FileCache::removeFile(const Key& key) {
+    Lock lock(_mutex);
+
+    const auto it = _files.find(key);
+    if (it == _files.cend()) {
+        return;
+    }
+    FilePointer file = it->second.lock();
+    if (file) {
+        eject(file);
+        emit dirty();
+    } else {
+        _files.erase(it);
+    }
+}
+
 std::string FileCache::getFilepath(const Key& key) {
     return _dirpath + DIR_SEP + key + EXT_SEP + _ext;
 }
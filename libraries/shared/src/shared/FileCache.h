@@ -99,6 +99,9 @@ public:
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
     FilePointer getFile(const Key& key);
 
+    // Remove a file from the cache, it is deleted from disk once no longer in use
+    void removeFile(const Key& key);
+
     /// create a file
     virtual std::unique_ptr<File> createFile(Metadata&& metadata, const std::string& filepath);
 
@@ -22,7 +22,7 @@
 #include "../SharedUtil.h"
 #include "../SharedLogging.h"
 
-class FilePersistThread : public GenericQueueThread < QString > {
+class FilePersistThread : public LockFreeQueueThread<QString> {
     Q_OBJECT
 public:
     FilePersistThread(const FileLogger& logger);
@@ -31,7 +31,7 @@ signals:
 
 protected:
     void rollFileIfNecessary(QFile& file, bool force = false, bool notifyListenersIfRolled = true);
-    virtual bool processQueueItems(const Queue& messages) override;
+    virtual bool processQueueItems(const QString* messages, size_t count) override;
 
 private:
     const FileLogger& _logger;
@@ -113,14 +113,14 @@ void FilePersistThread::rollFileIfNecessary(QFile& file, bool force, bool notify
     }
 }
 
-bool FilePersistThread::processQueueItems(const Queue& messages) {
+bool FilePersistThread::processQueueItems(const QString* messages, size_t count) {
     QMutexLocker lock(&_fileMutex);
     QFile file(_logger._fileName);
     rollFileIfNecessary(file);
     if (file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
         QTextStream out(&file);
-        for (const QString& message : messages) {
-            out << message;
+        for (size_t i = 0; i < count; ++i) {
+            out << messages[i];
         }
     }
     return true;
@@ -0,0 +1,150 @@
+//
+//  FrameArena.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameArena_h
+#define hifi_FrameArena_h
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A bump allocator for scratch data that lives no longer than a frame. Allocating moves a pointer along a block, freeing
+// does nothing (except give back the latest allocation, so that a growing vector reuses its own space), and reset
+// releases everything at once. When a frame outgrew the arena, reset replaces its blocks with one that holds all that
+// the frame used, so that once the frames settle the arena stops going to the heap.
+//   Not thread-safe: each thread that builds frames keeps its own.
+class FrameArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    struct Stats {
+        uint64_t numAllocations { 0 };
+        uint64_t numBytesAllocated { 0 };
+        uint64_t numHeapAllocations { 0 }; // the blocks the arena had to take from the heap
+    };
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE) : _blockSize(blockSize) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+        ++_stats.numAllocations;
+        _stats.numBytesAllocated += size;
+
+        uintptr_t address = align(_next, alignment);
+        if (_blocks.empty() || address + size > _end) {
+            addBlock(size + alignment);
+            address = align(_next, alignment);
+        }
+        _last = _next;
+        _next = address + size;
+        _used += _next - _last;
+        if (_used > _peakUsed) {
+            _peakUsed = _used;
+        }
+        return reinterpret_cast<void*>(address);
+    }
+
+    void deallocate(void* pointer, size_t size) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        if (address + size == _next && _last <= address) {
+            _used -= _next - _last;
+            _next = _last;
+        }
+    }
+
+    // frees all that was allocated since the last reset
+    void reset() {
+        if (_blocks.size() > 1) {
+            size_t size = _peakUsed > _blockSize ? _peakUsed : _blockSize;
+            _blocks.clear();
+            addBlock(size);
+        } else if (!_blocks.empty()) {
+            _next = reinterpret_cast<uintptr_t>(_blocks.back().get());
+        }
+        _last = _next;
+        _used = 0;
+        _peakUsed = 0;
+    }
+
+    // the stats since the last call
+    Stats harvestStats() {
+        Stats stats = _stats;
+        _stats = Stats();
+        return stats;
+    }
+
+private:
+    static uintptr_t align(uintptr_t address, size_t alignment) {
+        return (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+    }
+
+    void addBlock(size_t minSize) {
+        size_t size = _blockSize;
+        while (size < minSize) {
+            size *= 2;
+        }
+        _blocks.emplace_back(new char[size]);
+        ++_stats.numHeapAllocations;
+        _next = _last = reinterpret_cast<uintptr_t>(_blocks.back().get());
+        _end = _next + size;
+    }
+
+    const size_t _blockSize;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    uintptr_t _next { 0 };
+    uintptr_t _last { 0 }; // where the latest allocation began, including its padding
+    uintptr_t _end { 0 };
+    size_t _used { 0 }; // the bytes taken, including padding, over all blocks
+    size_t _peakUsed { 0 }; // the most bytes taken at once this frame
+    Stats _stats;
+};
+
+// An allocator for standard containers that takes its memory from a FrameArena. The containers must not outlive the
+// frame they were filled in.
+template <typename T>
+class FrameArenaAllocator {
+public:
+    using value_type = T;
+
+    FrameArenaAllocator(FrameArena& arena) : _arena(&arena) {}
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* pointer, size_t count) {
+        _arena->deallocate(pointer, count * sizeof(T));
+    }
+
+    FrameArena* getArena() const { return _arena; }
+
+private:
+    FrameArena* _arena;
+};
+
+template <typename T, typename U>
+bool operator==(const FrameArenaAllocator<T>& lhs, const FrameArenaAllocator<U>& rhs) {
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const FrameArenaAllocator<T>& lhs, const FrameArenaAllocator<U>& rhs) {
+    return lhs.getArena() != rhs.getArena();
+}
+
+template <typename T>
+using FrameArenaVector = std::vector<T, FrameArenaAllocator<T>>;
+
+#endif // hifi_FrameArena_h
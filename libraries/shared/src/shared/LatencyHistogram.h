@@ -0,0 +1,119 @@
+//
+//  LatencyHistogram.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LatencyHistogram_h
+#define hifi_LatencyHistogram_h
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// A fixed-size histogram of durations (after HdrHistogram): each power of two range is split into
+// SUB_BUCKETS_PER_OCTAVE linear buckets, so any recorded value is known to within 1 / SUB_BUCKETS_PER_OCTAVE
+// of itself no matter its size. Recording is a few integer operations with no allocation, and histograms
+// from several threads can be summed to get the distribution across all of them.
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 3;
+    static const int SUB_BUCKETS_PER_OCTAVE = 1 << SUB_BUCKET_BITS;
+    static const int MAX_VALUE_BITS = 27; // about 134 seconds in usecs, anything longer lands in the last bucket
+    static const int NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS_PER_OCTAVE;
+
+    static int bucketFor(uint64_t value) {
+        if (value < (uint64_t)SUB_BUCKETS_PER_OCTAVE) {
+            return (int)value;
+        }
+        int highestBit = 63;
+        while (!(value & (1ULL << highestBit))) {
+            --highestBit;
+        }
+        int octave = highestBit - SUB_BUCKET_BITS + 1;
+        int subBucket = (int)(value >> (highestBit - SUB_BUCKET_BITS)) & (SUB_BUCKETS_PER_OCTAVE - 1);
+        return std::min(octave * SUB_BUCKETS_PER_OCTAVE + subBucket, NUM_BUCKETS - 1);
+    }
+
+    // the largest value that lands in this bucket
+    static uint64_t bucketUpperBound(int bucket) {
+        if (bucket < SUB_BUCKETS_PER_OCTAVE) {
+            return (uint64_t)bucket;
+        }
+        int octave = bucket / SUB_BUCKETS_PER_OCTAVE;
+        uint64_t subBucket = (uint64_t)(bucket % SUB_BUCKETS_PER_OCTAVE);
+        int shift = octave - 1;
+        return ((SUB_BUCKETS_PER_OCTAVE + subBucket + 1) << shift) - 1;
+    }
+
+    void record(uint64_t value) {
+        ++_buckets[bucketFor(value)];
+        ++_count;
+        _total += value;
+        _max = std::max(_max, value);
+    }
+
+    void reset() {
+        _buckets.fill(0);
+        _count = 0;
+        _total = 0;
+        _max = 0;
+    }
+
+    LatencyHistogram& operator+=(const LatencyHistogram& rhs) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            _buckets[i] += rhs._buckets[i];
+        }
+        _count += rhs._count;
+        _total += rhs._total;
+        _max = std::max(_max, rhs._max);
+        return *this;
+    }
+
+    // for rebuilding a histogram sent bucket by bucket, followed by the totals of what was recorded
+    void addToBucket(int bucket, uint32_t count) {
+        _buckets[std::min(std::max(bucket, 0), NUM_BUCKETS - 1)] += count;
+        _count += count;
+    }
+    void addToTotals(uint64_t total, uint64_t max) {
+        _total += total;
+        _max = std::max(_max, max);
+    }
+
+    uint32_t getBucketCount(int bucket) const { return _buckets[bucket]; }
+    uint64_t getCount() const { return _count; }
+    uint64_t getTotal() const { return _total; }
+    uint64_t getMax() const { return _max; }
+    double getMean() const { return _count ? (double)_total / (double)_count : 0.0; }
+
+    // the value below which at least this percentage (0 - 100) of the recorded values fall, 0 when empty
+    uint64_t getPercentile(double percentile) const {
+        if (_count == 0) {
+            return 0;
+        }
+        uint64_t rank = (uint64_t)((percentile / 100.0) * (double)_count + 0.5);
+        rank = std::min(std::max(rank, (uint64_t)1), _count);
+
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += _buckets[i];
+            if (seen >= rank) {
+                return std::min(bucketUpperBound(i), _max);
+            }
+        }
+        return _max;
+    }
+
+private:
+    std::array<uint32_t, NUM_BUCKETS> _buckets {};
+    uint64_t _count { 0 };
+    uint64_t _total { 0 };
+    uint64_t _max { 0 };
+};
+
+#endif // hifi_LatencyHistogram_h
@@ -0,0 +1,147 @@
+//
+//  ShardedHashMap.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShardedHashMap_h
+#define hifi_ShardedHashMap_h
+
+#include <array>
+#include <cstddef>
+
+#include <QtCore/QHash>
+#include <QtCore/QReadWriteLock>
+
+// A thread-safe hash map split into shards by key hash, each a QHash behind its own lock, so threads working on
+// different keys rarely touch the same lock. Each shard sits on its own cache line so that taking one shard's lock
+// doesn't slow down the readers of its neighbours. Operations on one key are atomic; those across the whole map
+// (size(), forEach(), takeAll()) visit the shards one at a time, so they only see a consistent map if no one is
+// writing at the same time.
+template <typename Key, typename Value, size_t NUM_SHARDS = 64>
+class ShardedHashMap {
+public:
+    ShardedHashMap() = default;
+    ShardedHashMap(const ShardedHashMap&) = delete;
+    ShardedHashMap& operator=(const ShardedHashMap&) = delete;
+
+    // a default-constructed Value if the key isn't there
+    Value value(const Key& key) const {
+        const Shard& shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.value(key);
+    }
+
+    bool contains(const Key& key) const {
+        const Shard& shard = shardFor(key);
+        QReadLocker locker(&shard.lock);
+        return shard.hash.contains(key);
+    }
+
+    void insert(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        shard.hash.insert(key, value);
+    }
+
+    // false, leaving the map as it was, if the key is already there
+    bool insertIfAbsent(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        auto found = shard.hash.find(key);
+        if (found != shard.hash.end()) {
+            return false;
+        }
+        shard.hash.insert(key, value);
+        return true;
+    }
+
+    bool remove(const Key& key) {
+        Shard& shard = shardFor(key);
+        QWriteLocker locker(&shard.lock);
+        return shard.hash.remove(key) > 0;
+    }
+
+    int size() const {
+        int size = 0;
+        for (const auto& shard : _shards) {
+            QReadLocker locker(&shard.lock);
+            size += shard.hash.size();
+        }
+        return size;
+    }
+
+    bool isEmpty() const { return size() == 0; }
+
+    void clear() {
+        for (auto& shard : _shards) {
+            QWriteLocker locker(&shard.lock);
+            shard.hash.clear();
+        }
+    }
+
+    // calls f(key, value) for each entry with the entry's shard read-locked, so f mustn't change the map
+    template <typename F>
+    void forEach(F&& f) const {
+        for (const auto& shard : _shards) {
+            QReadLocker locker(&shard.lock);
+            for (auto i = shard.hash.cbegin(); i != shard.hash.cend(); ++i) {
+                f(i.key(), i.value());
+            }
+        }
+    }
+
+    // copies the entries into one QHash
+    QHash<Key, Value> toHash() const {
+        QHash<Key, Value> hash;
+        forEach([&](const Key& key, const Value& value) {
+            hash.insert(key, value);
+        });
+        return hash;
+    }
+
+    // moves the entries out into one QHash, leaving the map empty
+    QHash<Key, Value> takeAll() {
+        QHash<Key, Value> hash;
+        for (auto& shard : _shards) {
+            QHash<Key, Value> shardHash;
+            {
+                QWriteLocker locker(&shard.lock);
+                shardHash.swap(shard.hash);
+            }
+            if (hash.isEmpty()) {
+                hash.swap(shardHash);
+            } else {
+                for (auto i = shardHash.cbegin(); i != shardHash.cend(); ++i) {
+                    hash.insert(i.key(), i.value());
+                }
+            }
+        }
+        return hash;
+    }
+
+private:
+    static_assert(NUM_SHARDS > 0 && (NUM_SHARDS & (NUM_SHARDS - 1)) == 0, "NUM_SHARDS must be a power of two");
+
+    struct alignas(64) Shard {
+        mutable QReadWriteLock lock;
+        QHash<Key, Value> hash;
+    };
+
+    // the shard takes the high bits of the hash, the QHash in it uses the low ones
+    static size_t shardIndex(const Key& key) {
+        uint hash = qHash(key);
+        return (size_t)((hash * 2654435769u) >> 16) & (NUM_SHARDS - 1);
+    }
+    Shard& shardFor(const Key& key) { return _shards[shardIndex(key)]; }
+    const Shard& shardFor(const Key& key) const { return _shards[shardIndex(key)]; }
+
+    std::array<Shard, NUM_SHARDS> _shards;
+};
+
+#endif // hifi_ShardedHashMap_h
@@ -12,6 +12,11 @@
 #include <QtCore/QDebug>
 #include "StorageLogging.h"
 
+#if defined(Q_OS_UNIX)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 Q_LOGGING_CATEGORY(storagelogging, "hifi.core.storage")
 
 using namespace storage;
@@ -19,6 +24,16 @@ using namespace storage;
 ViewStorage::ViewStorage(const storage::StoragePointer& owner, size_t size, const uint8_t* data)
     : _owner(owner), _size(size), _data(data) {}
 
+void ViewStorage::prefetch(size_t offset, size_t size) const {
+    if (offset >= _size) {
+        return;
+    }
+    if (0 == size || size > _size - offset) {
+        size = _size - offset;
+    }
+    _owner->prefetch((size_t)(_data - _owner->data()) + offset, size);
+}
+
 StoragePointer Storage::createView(size_t viewSize, size_t offset) const {
     auto selfSize = size();
     if (0 == viewSize) {
@@ -103,3 +118,30 @@ FileStorage::~FileStorage() {
         _file.close();
     }
 }
+
+void FileStorage::prefetch(size_t offset, size_t size) const {
+    // the fallback is in memory already
+    if (!_mapped || !_fallback.isEmpty() || offset >= _size) {
+        return;
+    }
+    if (0 == size || size > _size - offset) {
+        size = _size - offset;
+    }
+
+#if defined(Q_OS_UNIX)
+    // let the kernel read the whole range ahead rather than one fault at a time
+    static const uintptr_t SYSTEM_PAGE_SIZE = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)(_mapped + offset) & ~(SYSTEM_PAGE_SIZE - 1);
+    madvise((void*)start, (uintptr_t)(_mapped + offset + size) - start, MADV_WILLNEED);
+#endif
+
+    // touch every page, so they are resident once this returns
+    const size_t PAGE_SIZE = 4096;
+    const volatile uint8_t* data = _mapped + offset;
+    uint8_t sum = 0;
+    for (size_t i = 0; i < size; i += PAGE_SIZE) {
+        sum += data[i];
+    }
+    sum += data[size - 1];
+    (void)sum;
+}
@@ -37,6 +37,10 @@ namespace storage {
         virtual size_t size() const = 0;
         virtual operator bool() const { return true; }
 
+        // Reads the range into memory now if it isn't already, so that reading it later won't block on disk IO.  Only
+        // file backed storage has anything to do.  A size of 0 means up to the end.
+        virtual void prefetch(size_t offset = 0, size_t size = 0) const {}
+
         StoragePointer createView(size_t size = 0, size_t offset = 0) const;
         StoragePointer toFileStorage(const QString& filename) const;
         StoragePointer toMemoryStorage() const;
@@ -71,6 +75,7 @@ namespace storage {
         uint8_t* mutableData() override { return _hasWriteAccess ? _mapped : nullptr; }
         size_t size() const override { return _size; }
         operator bool() const override { return _valid; }
+        void prefetch(size_t offset = 0, size_t size = 0) const override;
     private:
         // For compressed QRC files we can't map the file object, so we need to read it into memory
         QByteArray _fallback;
@@ -88,6 +93,7 @@ namespace storage {
         uint8_t* mutableData() override { throw std::runtime_error("Cannot modify ViewStorage");  }
         size_t size() const override { return _size; }
         operator bool() const override { return *_owner; }
+        void prefetch(size_t offset = 0, size_t size = 0) const override;
     private:
         const storage::StoragePointer _owner;
         const size_t _size;
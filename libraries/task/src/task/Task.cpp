@@ -10,8 +10,16 @@
 //
 #include "Task.h"
 
+#include <TBBHelpers.h>
+
 using namespace task;
 
+void task::runConcurrently(const std::vector<std::function<void()>>& jobs) {
+    tbb::parallel_for((size_t)0, jobs.size(), [&](size_t i) {
+        jobs[i]();
+    });
+}
+
 JobContext::JobContext() {
 }
 
@@ -15,6 +15,7 @@
 #include "Config.h"
 #include "Varying.h"
 
+#include <functional>
 #include <unordered_map>
 
 namespace task {
@@ -50,6 +51,10 @@ protected:
 // - The taskFlow object allowing for messaging control flow commands from within a Job::run
 // - The current Config object attached to the Job::run currently called.
 // The JobContext can be derived to add more global state to it that Jobs can access
+//
+// The consecutive jobs a task adds with addConcurrentJob form a group, which runs concurrently when the context can fork:
+// each job of the group runs on its own fork, wrapped by runFork() on the worker thread it gets, then the task joins
+// the forks, in the order the jobs were added, before running the next jobs.
 class JobContext {
 public:
     JobContext();
@@ -60,10 +65,22 @@ public:
     // Task flow control
     TaskFlow taskFlow{};
 
+    // A copy of the context for a job of a concurrent group to run with, or nullptr to run the group in order on this one
+    virtual std::shared_ptr<JobContext> fork() const { return nullptr; }
+    virtual void runFork(const std::function<void()>& run) { run(); }
+    virtual void join(const std::vector<std::shared_ptr<JobContext>>& forks) {}
+
+    // Called around the run of every job and task, on the context it runs with, for a context to instrument them
+    virtual void beginJob(JobConcept& job) {}
+    virtual void endJob(JobConcept& job) {}
+
 protected:
 };
 using JobContextPointer = std::shared_ptr<JobContext>;
 
+// Runs the jobs on worker threads and returns once they are all done
+void runConcurrently(const std::vector<std::function<void()>>& jobs);
+
 // The guts of a job
 class JobConcept {
 public:
@@ -82,9 +99,14 @@ public:
     virtual void applyConfiguration() = 0;
     void setCPURunTime(const std::chrono::nanoseconds& runtime) { (_config)->setCPURunTime(runtime); }
 
+    // Concurrent jobs neither use the outputs of, nor share state with, the concurrent jobs next to them
+    bool isConcurrent() const { return _isConcurrent; }
+    void setConcurrent(bool concurrent) { _isConcurrent = concurrent; }
+
     QConfigPointer _config;
 protected:
     const std::string _name;
+    bool _isConcurrent { false };
 };
 
 
@@ -195,6 +217,9 @@ public:
     QConfigPointer& getConfiguration() const { return _concept->getConfiguration(); }
     void applyConfiguration() { return _concept->applyConfiguration(); }
 
+    bool isConcurrent() const { return _concept->isConcurrent(); }
+    void setConcurrent(bool concurrent) { _concept->setConcurrent(concurrent); }
+
     template <class I> void feedInput(const I& in) { _concept->editInput().template edit<I>() = in; }
     template <class I, class S> void feedInput(int index, const S& inS) { (_concept->editInput().template editN<I>(index)).template edit<S>() = inS; }
 
@@ -213,7 +238,9 @@ public:
     virtual void run(const ContextPointer& jobContext) {
         TimeProfiler probe(getName());
         auto startTime = std::chrono::high_resolution_clock::now();
+        jobContext->beginJob(*_concept);
         _concept->run(jobContext);
+        jobContext->endJob(*_concept);
         _concept->setCPURunTime((std::chrono::high_resolution_clock::now() - startTime));
     }
 
@@ -269,6 +296,56 @@ public:
             const auto input = Varying(typename NT::JobModel::Input());
             return addJob<NT>(name, input, std::forward<NA>(args)...);
         }
+
+        // Create a new job which may run concurrently with the concurrent jobs added right before or after it
+        template <class NT, class... NA> const Varying addConcurrentJob(std::string name, const Varying& input, NA&&... args) {
+            const auto output = addJob<NT>(name, input, std::forward<NA>(args)...);
+            _jobs.back().setConcurrent(true);
+            return output;
+        }
+
+        // Run the jobs from begin on, up to the first one not concurrent, each on a fork of the context
+        // Returns the index of the next job to run
+        size_t runConcurrentJobs(const ContextPointer& jobContext, size_t begin) {
+            size_t end = begin;
+            while (end < _jobs.size() && _jobs[end].isConcurrent()) {
+                end++;
+            }
+
+            std::vector<JobContextPointer> forks;
+            std::vector<std::function<void()>> runs;
+            for (size_t i = begin; i < end; i++) {
+                auto fork = std::static_pointer_cast<Context>(jobContext->fork());
+                if (!fork) {
+                    break;
+                }
+                auto job = _jobs[i];
+                runs.push_back([job, fork]() mutable {
+                    fork->runFork([&] { job.run(fork); });
+                });
+                forks.push_back(fork);
+            }
+
+            if (forks.size() < end - begin) {
+                // The context can't fork, so run the jobs one after the other
+                for (size_t i = begin; i < end; i++) {
+                    _jobs[i].run(jobContext);
+                    if (jobContext->taskFlow.doAbortTask()) {
+                        return _jobs.size();
+                    }
+                }
+                return end;
+            }
+
+            runConcurrently(runs);
+            jobContext->join(forks);
+            for (const auto& fork : forks) {
+                if (fork->taskFlow.doAbortTask()) {
+                    jobContext->taskFlow.abortTask();
+                }
+            }
+            return jobContext->taskFlow.doAbortTask() ? _jobs.size() : end;
+        }
     };
 
     template <class T, class C = Config, class I = None, class O = None> class TaskModel : public TaskConcept {
@@ -330,8 +407,15 @@ public:
         void run(const ContextPointer& jobContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->isEnabled()) {
-                for (auto job : TaskConcept::_jobs) {
-                    job.run(jobContext);
+                auto& jobs = TaskConcept::_jobs;
+                for (size_t i = 0; i < jobs.size();) {
+                    if (jobs[i].isConcurrent()) {
+                        i = TaskConcept::runConcurrentJobs(jobContext, i);
+                    } else {
+                        auto job = jobs[i];
+                        job.run(jobContext);
+                        i++;
+                    }
                     if (jobContext->taskFlow.doAbortTask()) {
                         jobContext->taskFlow.reset();
                         return;
@@ -353,6 +437,9 @@ public:
         const auto input = Varying(typename T::JobModel::Input());
         return std::static_pointer_cast<TaskConcept>(JobType::_concept)->template addJob<T>(name, input, std::forward<A>(args)...);
     }
+    template <class T, class... A> const Varying addConcurrentJob(std::string name, const Varying& input, A&&... args) {
+        return std::static_pointer_cast<TaskConcept>(JobType::_concept)->template addConcurrentJob<T>(name, input, std::forward<A>(args)...);
+    }
 
     std::shared_ptr<Config> getConfiguration() {
         return std::static_pointer_cast<Config>(JobType::_concept->getConfiguration());
@@ -20,6 +20,49 @@
 
 using namespace workload;
 
+// The region of a proxy: the lowest one it touches in any of the views, or R4
+static uint8_t classifyProxy(const Views& views, const glm::vec3& proxyCenter, float proxyRadius) {
+    uint8_t region = Region::R4;
+    for (const auto& view : views) {
+        // for each 'view' we need only increment 'k' below the current value of 'region'
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = proxyRadius + view.regions[k].w;
+            if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+// The regions of four proxies, one to a lane. Each region is tested from the highest down so that the lowest one
+// touched is left in the lane, which gives the same result as classifyProxy without branching per proxy.
+static __m128i classifyFourProxies(const Views& views, const float* xs, const float* ys, const float* zs,
+                                   const float* radii) {
+    __m128 x = _mm_loadu_ps(xs);
+    __m128 y = _mm_loadu_ps(ys);
+    __m128 z = _mm_loadu_ps(zs);
+    __m128 radius = _mm_loadu_ps(radii);
+    __m128i region = _mm_set1_epi32(Region::R4);
+    for (int k = (int)Region::NUM_TRACKED_REGIONS - 1; k >= 0; --k) {
+        __m128i regionK = _mm_set1_epi32(k);
+        for (const auto& view : views) {
+            const Sphere& sphere = view.regions[k];
+            __m128 dx = _mm_sub_ps(x, _mm_set1_ps(sphere.x));
+            __m128 dy = _mm_sub_ps(y, _mm_set1_ps(sphere.y));
+            __m128 dz = _mm_sub_ps(z, _mm_set1_ps(sphere.z));
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            __m128 touchDistance = _mm_add_ps(radius, _mm_set1_ps(sphere.w));
+            __m128i touches = _mm_castps_si128(_mm_cmplt_ps(distance2, _mm_mul_ps(touchDistance, touchDistance)));
+            region = _mm_or_si128(_mm_and_si128(touches, regionK), _mm_andnot_si128(touches, region));
+        }
+    }
+    return region;
+}
+#endif
+
 Space::Space() : Collection() {
 }
 
@@ -31,6 +74,10 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _proxyXs.resize(maxID + 100);
+        _proxyYs.resize(maxID + 100);
+        _proxyZs.resize(maxID + 100);
+        _proxyRadii.resize(maxID + 100);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -52,7 +99,7 @@ void Space::processResets(const Transaction::Resets& transactions) {
         auto& item = _proxies[proxyID];
 
         // Reset the item with a new payload
-        item.sphere = (std::get<1>(reset));
+        setProxySphere(proxyID, std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
 
         _owners[proxyID] = (std::get<2>(reset));
@@ -82,41 +129,46 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
             continue;
         }
 
-        // Access the true item
-        auto& item = _proxies[updateID];
-
         // Update the item
-        item.sphere = (std::get<1>(update));
+        setProxySphere(updateID, std::get<1>(update));
     }
 }
 
+void Space::setProxySphere(Index proxyID, const Sphere& sphere) {
+    _proxies[proxyID].sphere = sphere;
+    _proxyXs[proxyID] = sphere.x;
+    _proxyYs[proxyID] = sphere.y;
+    _proxyZs[proxyID] = sphere.z;
+    _proxyRadii[proxyID] = sphere.w;
+}
+
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
     uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
+    auto setRegion = [&](uint32_t i, uint8_t region) {
         Proxy& proxy = _proxies[i];
         if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
             proxy.prevRegion = proxy.region;
             proxy.region = region;
             if (proxy.region != proxy.prevRegion) {
                 changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
             }
         }
+    };
+
+    uint32_t i = 0;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    alignas(16) int32_t regions[4];
+    for (; i + 4 <= numProxies; i += 4) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(regions),
+                        classifyFourProxies(_views, &_proxyXs[i], &_proxyYs[i], &_proxyZs[i], &_proxyRadii[i]));
+        for (uint32_t j = 0; j < 4; ++j) {
+            setRegion(i + j, (uint8_t)regions[j]);
+        }
+    }
+#endif
+    for (; i < numProxies; ++i) {
+        setRegion(i, classifyProxy(_views, glm::vec3(_proxyXs[i], _proxyYs[i], _proxyZs[i]), _proxyRadii[i]));
     }
 }
 
@@ -161,6 +213,10 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _proxyXs.clear();
+    _proxyYs.clear();
+    _proxyZs.clear();
+    _proxyRadii.clear();
     _views.clear();
 }
 
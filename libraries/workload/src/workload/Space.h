@@ -59,12 +59,20 @@ private:
     void processResets(const Transaction::Resets& transactions);
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
+    void setProxySphere(Index proxyID, const Sphere& sphere);
 
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    // The spheres of the proxies again, one array per component, so that categorizeAndGetChanges
+    // can classify several proxies at once
+    std::vector<float> _proxyXs;
+    std::vector<float> _proxyYs;
+    std::vector<float> _proxyZs;
+    std::vector<float> _proxyRadii;
+
     Views _views;
 };
 
@@ -57,7 +57,7 @@ void View::updateRegionsDefault(View& view) {
 
 void View::updateRegionsFromBackFronts(View& view) {
     for (int i = 0; i < (int)Region::NUM_TRACKED_REGIONS; i++) {
-        view.regions[i] = evalRegionSphere(view, view.regionBackFronts[i].x, view.regionBackFronts[i].y);
+        view.regions[i] = evalRegionSphere(view, view.weight * view.regionBackFronts[i].x, view.weight * view.regionBackFronts[i].y);
     }
 }
 
@@ -47,6 +47,9 @@ public:
     // Origin radius
     float originRadius{ 0.5f };
 
+    // Scale of the region distances, below 1 for the views that matter less than the main one (e.g. a secondary camera)
+    float weight{ 1.0f };
+
     // N regions distances
     glm::vec2 regionBackFronts[Region::NUM_TRACKED_REGIONS];
 
@@ -10,6 +10,8 @@
 //
 #include "ViewTask.h"
 
+#include <algorithm>
+
 #include <Profile.h>
 
 using namespace workload;
@@ -28,6 +30,13 @@ void SetupViews::run(const WorkloadContextPointer& renderContext, const Input& i
     // If views are frozen don't use the input
     if (!data.freezeViews) {
         _views = inputs;
+        if (_views.size() > 2 + (size_t)data.maxSecondaryViews) {
+            // over budget, the secondary views that matter least are dropped
+            std::stable_sort(_views.begin() + 2, _views.end(), [](const View& a, const View& b) {
+                return a.weight > b.weight;
+            });
+            _views.resize(2 + data.maxSecondaryViews);
+        }
     }
 
     auto& outViews = outputs;
@@ -53,6 +53,7 @@ namespace workload {
         Q_PROPERTY(bool forceViewHorizontal READ forceViewHorizontal WRITE setForceViewHorizontal NOTIFY dirty)
 
         Q_PROPERTY(bool simulateSecondaryCamera READ simulateSecondaryCamera WRITE setSimulateSecondaryCamera NOTIFY dirty)
+        Q_PROPERTY(int maxSecondaryViews READ getMaxSecondaryViews WRITE setMaxSecondaryViews NOTIFY dirty)
 
     public:
 
@@ -80,6 +81,9 @@ namespace workload {
         bool simulateSecondaryCamera() const { return data.simulateSecondaryCamera; }
         void setSimulateSecondaryCamera(bool use) { data.simulateSecondaryCamera = use; emit dirty(); }
 
+        int getMaxSecondaryViews() const { return data.maxSecondaryViews; }
+        void setMaxSecondaryViews(int max) { data.maxSecondaryViews = (max > 0) ? max : 0; emit dirty(); }
+
         struct Data {
             float r1Back { MAX_VIEW_BACK_FRONTS[0].x };
             float r1Front { MAX_VIEW_BACK_FRONTS[0].y };
@@ -94,6 +98,9 @@ namespace workload {
             bool useAvatarView{ false };
             bool forceViewHorizontal{ false };
             bool simulateSecondaryCamera{ false };
+
+            // the secondary views beyond the head and camera ones that are kept, those of the highest weight first
+            int maxSecondaryViews{ 2 };
         } data;
 
     signals:
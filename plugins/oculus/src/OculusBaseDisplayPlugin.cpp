@@ -173,7 +173,7 @@ void OculusBaseDisplayPlugin::updatePresentPose() {
     ovrTrackingState trackingState;
     _currentPresentFrameInfo.sensorSampleTime = ovr_GetTimeInSeconds();
     _currentPresentFrameInfo.predictedDisplayTime = ovr_GetPredictedDisplayTime(_session, 0);
-    trackingState = ovr::getTrackingState(_currentRenderFrameInfo.predictedDisplayTime);
+    trackingState = ovr::getTrackingState(_currentPresentFrameInfo.predictedDisplayTime);
     _currentPresentFrameInfo.presentPose = ovr::toGlm(trackingState.HeadPose.ThePose);
     _currentPresentFrameInfo.renderPose = _currentPresentFrameInfo.presentPose;
 }
@@ -247,7 +247,7 @@ void OculusDisplayPlugin::hmdPresent() {
 
 
 QJsonObject OculusDisplayPlugin::getHardwareStats() const {
-    QJsonObject hardwareStats;
+    QJsonObject hardwareStats = Parent::getHardwareStats();
     hardwareStats["asw_active"] = _aswActive.load();
     hardwareStats["app_dropped_frame_count"] = _appDroppedFrames.load();
     hardwareStats["compositor_dropped_frame_count"] = _compositorDroppedFrames.load();
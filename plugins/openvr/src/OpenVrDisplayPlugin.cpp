@@ -252,7 +252,16 @@ public:
 
             updateProgram();
             {
-                auto presentRotation = glm::mat3(_nextRender.poses[0]);
+                mat4 sensorResetMat;
+                _plugin.withNonPresentThreadLock([&] { sensorResetMat = _plugin._sensorResetMat; });
+
+                // reproject to where the HMD is now predicted to be, rather than where WaitGetPoses predicted it would be
+                auto presentPose = _nextRender.poses[0];
+                vr::TrackedDevicePose_t latchedPose;
+                if (_plugin.latchHmdPose(latchedPose)) {
+                    presentPose = sensorResetMat * toGlm(latchedPose.mDeviceToAbsoluteTracking);
+                }
+                auto presentRotation = glm::mat3(presentPose);
                 auto renderRotation = glm::mat3(_current.pose);
                 for (size_t i = 0; i < 2; ++i) {
                     _reprojection.projections[i] = _plugin._eyeProjections[i];
@@ -277,10 +286,16 @@ public:
                 static const vr::VRTextureBounds_t leftBounds{ 0, 0, 0.5f, 1 };
                 static const vr::VRTextureBounds_t rightBounds{ 0.5f, 0, 1, 1 };
 
-                vr::Texture_t texture{ (void*)(uintptr_t)_colors[currentColorBuffer], vr::TextureType_OpenGL,
-                                       vr::ColorSpace_Auto };
-                vr::VRCompositor()->Submit(vr::Eye_Left, &texture, &leftBounds);
-                vr::VRCompositor()->Submit(vr::Eye_Right, &texture, &rightBounds);
+                // the frame now shows the rotation reprojected to from where it was rendered
+                mat4 submittedPose = glm::mat4(presentRotation);
+                submittedPose[3] = _current.pose[3];
+                vr::VRTextureWithPose_t texture;
+                texture.handle = (void*)(uintptr_t)_colors[currentColorBuffer];
+                texture.eType = vr::TextureType_OpenGL;
+                texture.eColorSpace = vr::ColorSpace_Auto;
+                texture.mDeviceToAbsoluteTracking = toOpenVr(glm::inverse(sensorResetMat) * submittedPose);
+                vr::VRCompositor()->Submit(vr::Eye_Left, &texture, &leftBounds, vr::Submit_TextureWithPose);
+                vr::VRCompositor()->Submit(vr::Eye_Right, &texture, &rightBounds, vr::Submit_TextureWithPose);
                 _plugin._presentRate.increment();
                 PoseData nextRender, nextSim;
                 nextRender.frameIndex = _plugin.presentCount();
@@ -294,9 +309,6 @@ public:
                     }
                 }
 
-                mat4 sensorResetMat;
-                _plugin.withNonPresentThreadLock([&] { sensorResetMat = _plugin._sensorResetMat; });
-
                 nextRender.update(sensorResetMat);
                 nextSim.update(sensorResetMat);
                 _plugin.withNonPresentThreadLock([&] {
@@ -449,6 +461,11 @@ bool OpenVrDisplayPlugin::internalActivate() {
     qDebug() << "OpenVR Async Reprojection active:  " << _asyncReprojectionActive;
     qDebug() << "OpenVR Threaded submit enabled:  " << _threadedSubmit;
 
+    _displayFrequency = _system->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float);
+    _secondsFromVsyncToPhotons =
+        _system->GetFloatTrackedDeviceProperty(vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_SecondsFromVsyncToPhotons_Float);
+    _trackingSpace = vr::VRCompositor()->GetTrackingSpace();
+
     _openVrDisplayActive = true;
     _system->GetRecommendedRenderTargetSize(&_renderTargetSize.x, &_renderTargetSize.y);
     // Recommended render target size is per-eye, so double the X size for
@@ -558,6 +575,21 @@ static bool isBadPose(vr::HmdMatrix34_t* mat) {
     return false;
 }
 
+// Samples the HMD's pose as predicted for the next vsync the compositor can show, later than the prediction WaitGetPoses
+// made at the end of the previous present
+bool OpenVrDisplayPlugin::latchHmdPose(vr::TrackedDevicePose_t& pose) const {
+    float secondsSinceLastVsync;
+    uint64_t frameCounter;
+    if (!_system || _displayFrequency <= 0.0f || !_system->GetTimeSinceLastVsync(&secondsSinceLastVsync, &frameCounter)) {
+        return false;
+    }
+
+    float secondsToPhotons = 1.0f / _displayFrequency - secondsSinceLastVsync + _secondsFromVsyncToPhotons;
+    _system->GetDeviceToAbsoluteTrackingPose(_trackingSpace, secondsToPhotons, &pose, 1);
+    return pose.bPoseIsValid && pose.eTrackingResult == vr::TrackingResult_Running_OK &&
+        !isBadPose(&pose.mDeviceToAbsoluteTracking);
+}
+
 bool OpenVrDisplayPlugin::beginFrameRender(uint32_t frameIndex) {
     PROFILE_RANGE_EX(render, __FUNCTION__, 0xff7fff00, frameIndex)
     handleOpenVrEvents();
@@ -666,10 +698,15 @@ void OpenVrDisplayPlugin::hmdPresent() {
         _visionSqueezeParametersBuffer.edit<VisionSqueezeParameters>()._rightProjection = _eyeProjections[1];
         _visionSqueezeParametersBuffer.edit<VisionSqueezeParameters>()._hmdSensorMatrix = _currentPresentFrameInfo.presentPose;
 
+        // tell the compositor the pose the frame was corrected to, so that its own reprojection starts from there
         GLuint glTexId = getGLBackend()->getTextureID(_compositeFramebuffer->getRenderBuffer(0));
-        vr::Texture_t vrTexture{ (void*)(uintptr_t)glTexId, vr::TextureType_OpenGL, vr::ColorSpace_Auto };
-        vr::VRCompositor()->Submit(vr::Eye_Left, &vrTexture, &OPENVR_TEXTURE_BOUNDS_LEFT);
-        vr::VRCompositor()->Submit(vr::Eye_Right, &vrTexture, &OPENVR_TEXTURE_BOUNDS_RIGHT);
+        vr::VRTextureWithPose_t vrTexture;
+        vrTexture.handle = (void*)(uintptr_t)glTexId;
+        vrTexture.eType = vr::TextureType_OpenGL;
+        vrTexture.eColorSpace = vr::ColorSpace_Auto;
+        vrTexture.mDeviceToAbsoluteTracking = _presentVrPose.mDeviceToAbsoluteTracking;
+        vr::VRCompositor()->Submit(vr::Eye_Left, &vrTexture, &OPENVR_TEXTURE_BOUNDS_LEFT, vr::Submit_TextureWithPose);
+        vr::VRCompositor()->Submit(vr::Eye_Right, &vrTexture, &OPENVR_TEXTURE_BOUNDS_RIGHT, vr::Submit_TextureWithPose);
         vr::VRCompositor()->PostPresentHandoff();
         _presentRate.increment();
     }
@@ -709,7 +746,17 @@ bool OpenVrDisplayPlugin::isHmdMounted() const {
 }
 
 void OpenVrDisplayPlugin::updatePresentPose() {
-    _currentPresentFrameInfo.presentPose = _nextRenderPoseData.poses[vr::k_unTrackedDeviceIndex_Hmd];
+    // latched just before the frame's batches execute, so the camera correction follows the HMD up to the present
+    vr::TrackedDevicePose_t latchedPose;
+    if (latchHmdPose(latchedPose)) {
+        mat4 resetMat;
+        withPresentThreadLock([&] { resetMat = _sensorResetMat; });
+        _presentVrPose = latchedPose;
+        _currentPresentFrameInfo.presentPose = resetMat * toGlm(latchedPose.mDeviceToAbsoluteTracking);
+    } else {
+        _presentVrPose = _nextRenderPoseData.vrPoses[vr::k_unTrackedDeviceIndex_Hmd];
+        _currentPresentFrameInfo.presentPose = _nextRenderPoseData.poses[vr::k_unTrackedDeviceIndex_Hmd];
+    }
 }
 
 bool OpenVrDisplayPlugin::suppressKeyboard() {
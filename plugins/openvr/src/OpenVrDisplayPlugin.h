@@ -89,11 +89,20 @@ protected:
     void postPreview() override;
 
 private:
+    bool latchHmdPose(vr::TrackedDevicePose_t& pose) const;
+
     vr::IVRSystem* _system { nullptr };
     std::atomic<uint32_t> _keyboardSupressionCount{ 0 };
 
     vr::HmdMatrix34_t _lastGoodHMDPose;
     mat4 _sensorResetMat;
+
+    // for predicting when the frame being presented reaches the display
+    float _displayFrequency { 0.0f };
+    float _secondsFromVsyncToPhotons { 0.0f };
+    vr::ETrackingUniverseOrigin _trackingSpace { vr::TrackingUniverseStanding };
+    // the raw pose of the HMD the frame being presented was corrected to, as the compositor is told it
+    vr::TrackedDevicePose_t _presentVrPose {};
     bool _threadedSubmit { true };
 
     CompositeInfo::Array _compositeInfos;
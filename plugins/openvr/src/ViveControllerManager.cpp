@@ -372,6 +372,7 @@ bool ViveControllerManager::activate() {
     loadSettings();
 
     if (!_system) {
+        std::lock_guard<std::mutex> lock(_systemMutex);
         _system = acquireOpenVrSystem();
     }
 
@@ -420,6 +421,7 @@ void ViveControllerManager::deactivate() {
 
     if (_system) {
         _container->makeRenderingContextCurrent();
+        std::lock_guard<std::mutex> lock(_systemMutex);
         releaseOpenVrSystem();
         _system = nullptr;
     }
@@ -775,6 +777,7 @@ void ViveControllerManager::pluginUpdate(float deltaTime, const controller::Inpu
     } else if (isDesktopMode()) {
         _nextSimPoseData.resetToInvalid();
     }
+    _samplePoses = !isDesktopMode() || _desktopMode;
 
     auto userInputMapper = DependencyManager::get<controller::UserInputMapper>();
     handleOpenVrEvents();
@@ -858,6 +861,34 @@ ViveControllerManager::InputDevice::InputDevice(vr::IVRSystem*& system) :
     _configStringMap[Config::FeetHipsChestAndShoulders] = QString("FeetHipsChestAndShoulders");
 }
 
+bool ViveControllerManager::sampleLatchedPoses(controller::LatchedPoses& poses) {
+    if (!_samplePoses) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_systemMutex);
+    if (!_system) {
+        return false;
+    }
+
+    // the poses as they are now, unlike the display plugin's, which are predicted to when the frame will be seen
+    vr::TrackedDevicePose_t vrPoses[vr::k_unMaxTrackedDeviceCount];
+    _system->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0, vrPoses, vr::k_unMaxTrackedDeviceCount);
+
+    auto latchPose = [&](vr::TrackedDeviceIndex_t deviceIndex, controller::LatchedPoses::Channel channel) {
+        if (deviceIndex >= vr::k_unMaxTrackedDeviceCount || !vrPoses[deviceIndex].bPoseIsValid ||
+            vrPoses[deviceIndex].eTrackingResult != vr::TrackingResult_Running_OK) {
+            return;
+        }
+        mat4 mat = toGlm(vrPoses[deviceIndex].mDeviceToAbsoluteTracking);
+        poses.poses[channel] = controller::Pose(extractTranslation(mat), glmExtractRotation(mat),
+                                                toGlm(vrPoses[deviceIndex].vVelocity), toGlm(vrPoses[deviceIndex].vAngularVelocity));
+    };
+    latchPose(vr::k_unTrackedDeviceIndex_Hmd, controller::LatchedPoses::HEAD);
+    latchPose(_system->GetTrackedDeviceIndexForControllerRole(vr::TrackedControllerRole_LeftHand), controller::LatchedPoses::LEFT_HAND);
+    latchPose(_system->GetTrackedDeviceIndexForControllerRole(vr::TrackedControllerRole_RightHand), controller::LatchedPoses::RIGHT_HAND);
+    return true;
+}
+
 void ViveControllerManager::InputDevice::update(float deltaTime, const controller::InputCalibrationData& inputCalibrationData) {
     _poseStateMap.clear();
     _buttonPressedMap.clear();
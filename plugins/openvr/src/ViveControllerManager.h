@@ -13,6 +13,8 @@
 #define hifi__ViveControllerManager
 
 #include <QObject>
+#include <atomic>
+#include <mutex>
 #include <unordered_set>
 #include <vector>
 #include <map>
@@ -89,6 +91,7 @@ public:
     void updateCameraHandTracker(float deltaTime, const controller::InputCalibrationData& inputCalibrationData);
 #endif
     void pluginUpdate(float deltaTime, const controller::InputCalibrationData& inputCalibrationData) override;
+    bool sampleLatchedPoses(controller::LatchedPoses& poses) override;
 
     virtual void saveSettings() const override;
     virtual void loadSettings() override;
@@ -260,6 +263,8 @@ private:
     int _rightHandRenderID { 0 };
 
     vr::IVRSystem* _system { nullptr };
+    std::mutex _systemMutex; // held by the input thread while it samples, so that _system isn't released under it
+    std::atomic<bool> _samplePoses { false }; // whether the devices are tracked, as pluginUpdate last found
     std::shared_ptr<InputDevice> _inputDevice { std::make_shared<InputDevice>(_system) };
 
     bool _eyeTrackingEnabled{ false };
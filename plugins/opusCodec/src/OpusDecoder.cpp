@@ -129,3 +129,28 @@ void AthenaOpusDecoder::lostFrame(QByteArray &decodedBuffer) {
     }
 
 }
+
+void AthenaOpusDecoder::recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) {
+    assert(_decoder);
+
+    PerformanceTimer perfTimer("AthenaOpusDecoder::recoverFrame");
+
+    int bufferSize = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * static_cast<int>(sizeof(int16_t))
+        * _opusNumChannels;
+    decodedBuffer.resize(bufferSize);
+    int bufferFrames = decodedBuffer.size() / _opusNumChannels / static_cast<int>(sizeof(opus_int16));
+
+    // decodes the in-band FEC of the next frame, or conceals the loss if the next frame has none
+    int decoded_frames = opus_decode(_decoder, reinterpret_cast<const unsigned char*>(nextEncodedBuffer.data()),
+        nextEncodedBuffer.length(), reinterpret_cast<opus_int16*>(decodedBuffer.data()), bufferFrames, 1);
+
+    if (decoded_frames >= 0) {
+        if (decoded_frames < bufferFrames) {
+            int start = decoded_frames * static_cast<int>(sizeof(int16_t)) * _opusNumChannels;
+            memset(&decodedBuffer.data()[start], 0, static_cast<size_t>(decodedBuffer.length() - start));
+        }
+    } else {
+        qCWarning(decoder) << "Failed to recover lost frame: " << error_to_string(decoded_frames);
+        lostFrame(decodedBuffer);
+    }
+}
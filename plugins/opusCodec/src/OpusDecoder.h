@@ -24,6 +24,7 @@ public:
 
     virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override;
     virtual void lostFrame(QByteArray &decodedBuffer) override;
+    virtual void recoverFrame(const QByteArray& nextEncodedBuffer, QByteArray& decodedBuffer) override;
 
 
 private:
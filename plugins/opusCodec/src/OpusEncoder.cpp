@@ -57,6 +57,9 @@ AthenaOpusEncoder::AthenaOpusEncoder(int sampleRate, int numChannels) {
     setComplexity(DEFAULT_COMPLEXITY);
     setApplication(DEFAULT_APPLICATION);
     setSignal(DEFAULT_SIGNAL);
+    setInbandFEC(DEFAULT_INBAND_FEC);
+    setExpectedPacketLossPercentage(DEFAULT_EXPECTED_PACKET_LOSS_PERCENTAGE);
+    setDTX(DEFAULT_DTX);
 
     qCDebug(encoder) << "Opus encoder initialized, sampleRate = " << sampleRate << "; numChannels = " << numChannels;
 }
@@ -89,6 +92,12 @@ void AthenaOpusEncoder::encode(const QByteArray& decodedBuffer, QByteArray& enco
 
 }
 
+bool AthenaOpusEncoder::isSilentFrame(const QByteArray& encodedBuffer) const {
+    // a frame of discontinuous transmission
+    const int MAX_DTX_FRAME_BYTES = 2;
+    return encodedBuffer.size() <= MAX_DTX_FRAME_BYTES;
+}
+
 int AthenaOpusEncoder::getComplexity() const {
     assert(_encoder);
     int returnValue;
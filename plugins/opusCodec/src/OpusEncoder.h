@@ -21,6 +21,7 @@ public:
     ~AthenaOpusEncoder() override;
 
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override;
+    virtual bool isSilentFrame(const QByteArray& encodedBuffer) const override;
 
 
     int getComplexity() const;
@@ -65,6 +66,11 @@ private:
     const int DEFAULT_COMPLEXITY = 10;
     const int DEFAULT_APPLICATION = OPUS_APPLICATION_VOIP;
     const int DEFAULT_SIGNAL = OPUS_AUTO;
+    // each frame carries a lower rate copy of the one before it, for the decoder to recover a lost frame from
+    const int DEFAULT_INBAND_FEC = 1;
+    const int DEFAULT_EXPECTED_PACKET_LOSS_PERCENTAGE = 10;
+    // silence is encoded in frames of 2 bytes or less, which need not be sent
+    const int DEFAULT_DTX = 1;
 
     int _opusSampleRate = 0;
     int _opusChannels = 0;
@@ -0,0 +1,110 @@
+"use strict";
+
+//
+//  renderBenchmark.js
+//  scripts/developer/tests
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Flies the camera along a fixed path through a local scene and records the timings of every frame rendered.
+//  Run it with:
+//      interface --testScript renderBenchmark.js quitWhenFinished --testScene <entities.json> --testResultsLocation <dir>
+//  The scene's atp:/ assets are read from the directory beside it named <entities>.atp. The camera advances by a fixed step
+//  per update rather than by the time elapsed, so each run renders the same views whatever the hardware; the LOD is fixed
+//  so that a slow machine doesn't lighten its own load.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+(function () {
+
+    var LOD_ANGLE_DEG = 0.5;
+    var SETTLE_FRAMES = 60;
+    var STEPS_PER_SEGMENT = 300;
+    var REPORT_NAME = "renderBenchmark";
+
+    // The path, as points relative to the avatar when the benchmark starts; the camera looks at the next point.
+    var PATH = [
+        { x: 0, y: 2, z: 0 },
+        { x: 0, y: 2, z: -20 },
+        { x: 20, y: 5, z: -20 },
+        { x: 20, y: 10, z: 20 },
+        { x: -20, y: 5, z: 20 },
+        { x: -20, y: 2, z: -20 },
+        { x: 0, y: 2, z: 0 }
+    ];
+
+    var origin;
+    var step = 0;
+    var settleCount = 0;
+    var previousCameraMode;
+    var previousAutomaticLOD;
+    var previousLODAngle;
+
+    function pathPoint(index) {
+        return Vec3.sum(origin, PATH[Math.min(index, PATH.length - 1)]);
+    }
+
+    function updateCamera() {
+        var segment = Math.floor(step / STEPS_PER_SEGMENT);
+        var alpha = (step % STEPS_PER_SEGMENT) / STEPS_PER_SEGMENT;
+        var position = Vec3.mix(pathPoint(segment), pathPoint(segment + 1), alpha);
+        var target = pathPoint(segment + 2);
+        var direction = Vec3.subtract(Vec3.mix(pathPoint(segment + 1), target, alpha), position);
+        Camera.position = position;
+        if (Vec3.length(direction) > 0) {
+            Camera.orientation = Quat.lookAtSimple(position, Vec3.sum(position, direction));
+        }
+    }
+
+    function finish() {
+        Script.update.disconnect(update);
+        var reportPath = REPORT_NAME + "-{DATE}-{TIME}";
+        Test.stopFrameTimings(reportPath + ".json");
+
+        LODManager.setAutomaticLODAdjust(previousAutomaticLOD);
+        LODManager.lodAngleDeg = previousLODAngle;
+        Camera.mode = previousCameraMode;
+        Script.stop();
+    }
+
+    function update() {
+        // let the scene's first frames, with their texture uploads, go by before recording
+        if (settleCount < SETTLE_FRAMES) {
+            ++settleCount;
+            updateCamera();
+            if (settleCount === SETTLE_FRAMES) {
+                Test.startFrameTimings();
+            }
+            return;
+        }
+
+        ++step;
+        if (step >= (PATH.length - 1) * STEPS_PER_SEGMENT) {
+            finish();
+            return;
+        }
+        updateCamera();
+    }
+
+    var scene = Test.getTestSceneLocation();
+    if (scene !== "" && !Test.loadTestSceneFile(scene)) {
+        print("renderBenchmark: couldn't load " + scene);
+        Script.stop();
+        return;
+    }
+    Test.waitIdle();
+
+    previousCameraMode = Camera.mode;
+    previousAutomaticLOD = LODManager.getAutomaticLODAdjust();
+    previousLODAngle = LODManager.lodAngleDeg;
+    LODManager.setAutomaticLODAdjust(false);
+    LODManager.lodAngleDeg = LOD_ANGLE_DEG;
+
+    origin = MyAvatar.position;
+    Camera.mode = "independent";
+    updateCamera();
+    Script.update.connect(update);
+}());
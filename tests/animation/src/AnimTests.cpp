@@ -15,6 +15,7 @@
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <AnimPoseBuffer.h>
 #include <ExternalResource.h>
 #include <NodeList.h>
 #include <AddressManager.h>
@@ -708,4 +709,102 @@ void AnimTests::testExpressionEvaluator() {
     TEST_BOOL_EXPR(!(true && f) && true);
 }
 
+static AnimPoseVec makeTestPoses(size_t numPoses, float phase) {
+    AnimPoseVec poses;
+    poses.reserve(numPoses);
+    for (size_t i = 0; i < numPoses; i++) {
+        float t = (float)i + phase;
+        glm::vec3 axis = glm::normalize(glm::vec3(sinf(t), cosf(2.0f * t), 0.5f));
+        glm::quat rot = glm::angleAxis(3.0f * sinf(0.7f * t), axis);
+        if (i % 3 == 0) {
+            // the other side of the sphere, same rotation
+            rot = -rot;
+        }
+        poses.push_back(AnimPose(glm::vec3(1.0f + 0.1f * sinf(t)), rot, glm::vec3(sinf(t), cosf(t), 0.1f * t)));
+    }
+    return poses;
+}
+
+void AnimTests::testAnimPoseBuffer() {
+    // not a multiple of the lane count, to check the padding
+    const size_t NUM_POSES = 23;
+    AnimPoseVec a = makeTestPoses(NUM_POSES, 0.0f);
+    AnimPoseVec b = makeTestPoses(NUM_POSES, 1.3f);
+
+    AnimPoseBuffer aBuffer(a);
+    AnimPoseBuffer bBuffer(b);
+    QCOMPARE(aBuffer.size(), NUM_POSES);
+
+    AnimPoseVec roundTrip;
+    aBuffer.store(roundTrip);
+    QCOMPARE(roundTrip.size(), NUM_POSES);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(roundTrip[i].trans(), a[i].trans(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(roundTrip[i].rot(), a[i].rot(), TEST_EPSILON);
+    }
+
+    // same as the AnimPoseVec blend
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec expected(NUM_POSES);
+        ::blend(NUM_POSES, a.data(), b.data(), alpha, expected.data());
+
+        AnimPoseBuffer result;
+        ::blend(aBuffer, bBuffer, alpha, result);
+        for (size_t i = 0; i < NUM_POSES; i++) {
+            AnimPose pose = result.getPose(i);
+            QCOMPARE_WITH_ABS_ERROR(pose.scale(), expected[i].scale(), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(pose.rot(), expected[i].rot(), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected[i].trans(), TEST_EPSILON);
+        }
+    }
+
+    // per joint alphas
+    std::vector<float> alphas(NUM_POSES);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        alphas[i] = (float)i / (float)(NUM_POSES - 1);
+    }
+    AnimPoseBuffer result;
+    ::blend(aBuffer, bBuffer, alphas.data(), result);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        AnimPose expected;
+        ::blend(1, &a[i], &b[i], alphas[i], &expected);
+        AnimPose pose = result.getPose(i);
+        QCOMPARE_WITH_ABS_ERROR(pose.rot(), expected.rot(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected.trans(), TEST_EPSILON);
+    }
+
+    // accumulating the two poses with weights adding up to one is a blend
+    result.resize(NUM_POSES);
+    result.zero();
+    ::accumulate(aBuffer, 0.75f, result);
+    ::accumulate(bBuffer, 0.25f, result);
+    ::normalizeRotations(result);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        AnimPose expected;
+        ::blend(1, &a[i], &b[i], 0.25f, &expected);
+        AnimPose pose = result.getPose(i);
+        QCOMPARE_WITH_ABS_ERROR(pose.scale(), expected.scale(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(pose.rot(), expected.rot(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected.trans(), TEST_EPSILON);
+    }
+}
+
+static const size_t BENCHMARK_NUM_POSES = 128;
 
+void AnimTests::benchmarkBlendPoses() {
+    AnimPoseVec a = makeTestPoses(BENCHMARK_NUM_POSES, 0.0f);
+    AnimPoseVec b = makeTestPoses(BENCHMARK_NUM_POSES, 1.3f);
+    AnimPoseVec result(BENCHMARK_NUM_POSES);
+    QBENCHMARK {
+        ::blend(BENCHMARK_NUM_POSES, a.data(), b.data(), 0.3f, result.data());
+    }
+}
+
+void AnimTests::benchmarkBlendPoseBuffers() {
+    AnimPoseBuffer a(makeTestPoses(BENCHMARK_NUM_POSES, 0.0f));
+    AnimPoseBuffer b(makeTestPoses(BENCHMARK_NUM_POSES, 1.3f));
+    AnimPoseBuffer result;
+    QBENCHMARK {
+        ::blend(a, b, 0.3f, result);
+    }
+}
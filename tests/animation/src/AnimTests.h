@@ -27,6 +27,9 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testAnimPoseBuffer();
+    void benchmarkBlendPoses();
+    void benchmarkBlendPoseBuffers();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
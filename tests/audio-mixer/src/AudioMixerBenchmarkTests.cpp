@@ -0,0 +1,454 @@
+//
+//  AudioMixerBenchmarkTests.cpp
+//  tests/audio-mixer/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerBenchmarkTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <AccountManager.h>
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <DependencyManager.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <StatTracker.h>
+#include <plugins/CodecPlugin.h>
+#include <plugins/PluginManager.h>
+
+#include "AudioMixer.h"
+#include "AudioMixerClientData.h"
+#include "AudioMixerSlavePool.h"
+
+// the calls to operator new of every thread, the slaves included
+static std::atomic<uint64_t> numAllocations { 0 };
+
+void* operator new(std::size_t size) {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size > 0 ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+QTEST_MAIN(AudioMixerBenchmarkTests)
+
+namespace {
+    const int DEFAULT_NUM_LISTENERS = 100;
+    const int DEFAULT_NUM_SOURCES = 50;
+    const int DEFAULT_NUM_FRAMES = 1000;
+    const int DEFAULT_NUM_ZONES = 4;
+    const QString DEFAULT_CODEC_NAME = "opus";
+
+    // the jitter buffers fill and the streams become active before the frames are measured
+    const int NUM_WARMUP_FRAMES = 50;
+
+    const uint32_t RANDOM_SEED = 1;
+    // the listeners and sources are spread over a square as large as keeps their density the same at any count
+    const float AREA_PER_NODE = 25.0f; // m^2
+    const glm::vec3 AVATAR_BOX_SCALE(0.5f, 1.8f, 0.5f);
+    const float ZONE_HEIGHT = 20.0f;
+    const float ZONE_COEFFICIENT = 0.5f;
+    const quint8 MAX_INJECTOR_VOLUME = 0xFF;
+
+    // a voice: a buzz of harmonics in syllables of a quarter second, with a pause after each phrase
+    const int VOICE_FRAMES = 400;
+    const float VOICE_PITCH = 140.0f; // Hz
+    const int VOICE_HARMONICS = 8;
+    const float VOICE_AMPLITUDE = 6000.0f;
+    const float SYLLABLES_PER_SECOND = 4.0f;
+    const float PHRASE_SECONDS = 2.0f;
+    const float SPEAKING_FRACTION = 0.75f;
+
+    enum Phase {
+        QUEUE,
+        PACKETS,
+        EVENTS,
+        MIX,
+        NUM_PHASES
+    };
+    const char* PHASE_NAMES[NUM_PHASES] = { "queue", "packets", "events", "mix" };
+
+    int intFromEnvironment(const char* name, int defaultValue, int minValue = 1) {
+        bool ok = false;
+        int value = qEnvironmentVariableIntValue(name, &ok);
+        return ok && value >= minValue ? value : defaultValue;
+    }
+
+    std::vector<int16_t> createVoice() {
+        std::vector<int16_t> samples(VOICE_FRAMES * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            float time = (float)i / AudioConstants::SAMPLE_RATE;
+            float syllable = time * SYLLABLES_PER_SECOND - floorf(time * SYLLABLES_PER_SECOND);
+            float phrase = time / PHRASE_SECONDS - floorf(time / PHRASE_SECONDS);
+            float envelope = phrase < SPEAKING_FRACTION ? sinf(PI * syllable) : 0.0f;
+
+            float value = 0.0f;
+            for (int harmonic = 1; harmonic <= VOICE_HARMONICS; ++harmonic) {
+                value += sinf(TWO_PI * VOICE_PITCH * harmonic * time) / harmonic;
+            }
+            samples[i] = (int16_t)(VOICE_AMPLITUDE * envelope * value);
+        }
+        return samples;
+    }
+
+    struct SyntheticNode {
+        SharedNodePointer node;
+        // the payload of the packet sent every frame, up to its audio
+        QByteArray header;
+        int voiceFrame { 0 };
+    };
+}
+
+void AudioMixerBenchmarkTests::initTestCase() {
+    _numListeners = intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_LISTENERS", DEFAULT_NUM_LISTENERS);
+    _numSources = intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_SOURCES", DEFAULT_NUM_SOURCES);
+    _numFrames = intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_FRAMES", DEFAULT_NUM_FRAMES);
+    _numThreads = intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_THREADS", QThread::idealThreadCount());
+
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<StatTracker>();
+    DependencyManager::set<AccountManager>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::AudioMixer);
+
+    // only load codec plugins, as the mixer does
+    auto pluginManager = DependencyManager::set<PluginManager>();
+    pluginManager->setPluginFilter([](const QJsonObject& metaData) {
+        return metaData["MetaData"]["name"].toString().contains("codec", Qt::CaseInsensitive);
+    });
+
+    QVERIFY(_sink.bind(QHostAddress::LocalHost, 0));
+}
+
+void AudioMixerBenchmarkTests::pcmBenchmark() {
+    Scenario scenario;
+    scenario.name = "pcm";
+    runScenario(scenario);
+}
+
+void AudioMixerBenchmarkTests::codecBenchmark() {
+    QString codecName = qEnvironmentVariable("HIFI_AUDIO_MIXER_BENCHMARK_CODEC", DEFAULT_CODEC_NAME);
+    const auto& codecPlugins = PluginManager::getInstance()->getCodecPlugins();
+    auto it = std::find_if(codecPlugins.begin(), codecPlugins.end(), [&](const CodecPluginPointer& codec) {
+        return codec->getName() == codecName;
+    });
+    if (it == codecPlugins.end()) {
+        QSKIP(qPrintable("The " + codecName + " codec plugin is not available"));
+    }
+
+    Scenario scenario;
+    scenario.name = "codec";
+    scenario.codecName = codecName;
+    scenario.codec = *it;
+    runScenario(scenario);
+}
+
+void AudioMixerBenchmarkTests::zonesBenchmark() {
+    Scenario scenario;
+    scenario.name = "zones";
+    scenario.numZones = intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_ZONES", DEFAULT_NUM_ZONES);
+    runScenario(scenario);
+}
+
+void AudioMixerBenchmarkTests::ignoreBenchmark() {
+    Scenario scenario;
+    scenario.name = "ignore";
+    scenario.numIgnoredSources = std::min(intFromEnvironment("HIFI_AUDIO_MIXER_BENCHMARK_IGNORED",
+                                                             std::max(_numSources / 4, 1)), _numSources);
+    runScenario(scenario);
+}
+
+void AudioMixerBenchmarkTests::cleanupTestCase() {
+    QJsonObject report;
+    report["benchmark"] = "audio-mixer";
+    report["numListeners"] = _numListeners;
+    report["numSources"] = _numSources;
+    report["numFrames"] = _numFrames;
+    report["numThreads"] = _numThreads;
+    report["frameBudgetUsecs"] = AudioConstants::NETWORK_FRAME_USECS;
+    report["scenarios"] = _results;
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Compact);
+    qInfo().noquote() << json;
+
+    QString outputPath = qEnvironmentVariable("HIFI_AUDIO_MIXER_BENCHMARK_OUTPUT");
+    if (!outputPath.isEmpty()) {
+        QSaveFile file(outputPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(json);
+        QVERIFY(file.commit());
+    }
+
+    _sink.close();
+}
+
+void AudioMixerBenchmarkTests::runScenario(const Scenario& scenario) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SockAddr sinkAddress(SocketType::UDP, QHostAddress::LocalHost, _sink.localPort());
+
+    std::mt19937 random(RANDOM_SEED);
+    const float areaSize = sqrtf(AREA_PER_NODE * (_numListeners + _numSources));
+    std::uniform_real_distribution<float> coordinate(0.0f, areaSize);
+    std::uniform_real_distribution<float> yaw(0.0f, TWO_PI);
+    std::uniform_int_distribution<int> voiceFrame(0, VOICE_FRAMES - 1);
+
+    // the zones are slabs across the area, attenuating the sources heard from the others
+    AudioMixer::_audioZones.clear();
+    AudioMixer::_zoneSettings.clear();
+    const float zoneWidth = areaSize / std::max(scenario.numZones, 1);
+    for (int i = 0; i < scenario.numZones; ++i) {
+        AABox area(glm::vec3(i * zoneWidth, -0.5f * ZONE_HEIGHT, 0.0f), glm::vec3(zoneWidth, ZONE_HEIGHT, areaSize));
+        AudioMixer::_audioZones.push_back({ QString("zone%1").arg(i), area });
+        for (int j = 0; j < scenario.numZones; ++j) {
+            if (i != j) {
+                AudioMixer::_zoneSettings.push_back({ i, j, ZONE_COEFFICIENT });
+            }
+        }
+    }
+
+    Node::LocalID nextLocalID = 0;
+    auto addNode = [&]() {
+        QUuid nodeID = QUuid::createUuid();
+        SharedNodePointer node = nodeList->addOrUpdateNode(nodeID, NodeType::Agent, sinkAddress, sinkAddress,
+                                                           ++nextLocalID);
+        node->activatePublicSocket();
+        node->setLinkedData(std::unique_ptr<NodeData> { new AudioMixerClientData(nodeID, node->getLocalID()) });
+        return node;
+    };
+
+    // the listeners send silent frames from their avatars
+    std::vector<SyntheticNode> listeners(_numListeners);
+    for (auto& listener : listeners) {
+        listener.node = addNode();
+        if (scenario.codec) {
+            static_cast<AudioMixerClientData*>(listener.node->getLinkedData())->setupCodec(scenario.codec,
+                                                                                           scenario.codecName);
+        }
+
+        glm::vec3 position(coordinate(random), 0.0f, coordinate(random));
+        glm::quat orientation = glm::angleAxis(yaw(random), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::vec3 boxCorner = position - 0.5f * AVATAR_BOX_SCALE;
+
+        auto packet = NLPacket::create(PacketType::SilentAudioFrame);
+        packet->writePrimitive((quint16)0);
+        packet->writeString(scenario.codecName);
+        packet->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        packet->writePrimitive(position);
+        packet->writePrimitive(orientation);
+        packet->writePrimitive(boxCorner);
+        packet->writePrimitive(AVATAR_BOX_SCALE);
+        listener.header = QByteArray(packet->getPayload(), (int)packet->getPayloadSize());
+    }
+
+    // the sources inject a mono voice each, as an AudioInjector does
+    std::vector<SyntheticNode> sources(_numSources);
+    for (auto& source : sources) {
+        source.node = addNode();
+        source.voiceFrame = voiceFrame(random);
+
+        glm::vec3 position(coordinate(random), 0.0f, coordinate(random));
+        glm::quat orientation = glm::angleAxis(yaw(random), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::vec3 boxCorner(0.0f);
+
+        auto packet = NLPacket::create(PacketType::InjectAudio);
+        packet->writePrimitive((quint16)0);
+        packet->writeString(QString());
+        QDataStream packetStream(packet.get());
+        packetStream << QUuid::createUuid();
+        packetStream << false;
+        packetStream << (uchar)0;
+        packetStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+        packetStream.writeRawData(reinterpret_cast<const char*>(&orientation), sizeof(orientation));
+        packetStream.writeRawData(reinterpret_cast<const char*>(&position), sizeof(position));
+        packetStream.writeRawData(reinterpret_cast<const char*>(&boxCorner), sizeof(boxCorner));
+        packetStream << 0.0f;
+        packetStream << MAX_INJECTOR_VOLUME;
+        packetStream << false;
+        source.header = QByteArray(packet->getPayload(), (int)packet->pos());
+    }
+
+    // each listener ignores the following sources
+    for (int i = 0; i < _numListeners && scenario.numIgnoredSources > 0; ++i) {
+        QByteArray payload;
+        payload.append((char)true);
+        for (int j = 0; j < scenario.numIgnoredSources; ++j) {
+            payload.append(sources[(i + j) % _numSources].node->getUUID().toRfc4122());
+        }
+        auto& node = listeners[i].node;
+        auto message = QSharedPointer<ReceivedMessage>::create(payload, PacketType::NodeIgnoreRequest,
+            versionForPacketType(PacketType::NodeIgnoreRequest), sinkAddress, node->getLocalID());
+        static_cast<AudioMixerClientData*>(node->getLinkedData())->queuePacket(message, node);
+    }
+
+    const std::vector<int16_t> voice = createVoice();
+    auto queuePacket = [&](const SyntheticNode& synthetic, PacketType type, quint16 sequence, const int16_t* samples) {
+        QByteArray payload = synthetic.header;
+        memcpy(payload.data(), &sequence, sizeof(sequence));
+        if (samples) {
+            payload.append(reinterpret_cast<const char*>(samples), AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL);
+        }
+        auto message = QSharedPointer<ReceivedMessage>::create(payload, type, versionForPacketType(type), sinkAddress,
+                                                               synthetic.node->getLocalID());
+        static_cast<AudioMixerClientData*>(synthetic.node->getLinkedData())->queuePacket(message, synthetic.node);
+    };
+
+    MemoryInfo memoryBefore;
+    getMemoryInfo(memoryBefore);
+
+    // the shared data outlives the slaves
+    AudioMixerSlave::SharedData sharedData;
+    AudioMixerSlavePool slavePool(sharedData, _numThreads);
+
+    AudioMixerStats stats;
+    uint64_t phaseUsecs[NUM_PHASES] = {};
+    uint64_t phaseAllocations[NUM_PHASES] = {};
+    uint64_t maxFrameUsecs = 0;
+
+    unsigned int frame = 1;
+    for (int i = 0; i < NUM_WARMUP_FRAMES + _numFrames; ++i, ++frame) {
+        uint64_t timestamps[NUM_PHASES + 1];
+        uint64_t allocations[NUM_PHASES + 1];
+        timestamps[QUEUE] = usecTimestampNow();
+        allocations[QUEUE] = numAllocations.load(std::memory_order_relaxed);
+
+        // the packets the clients sent during the last frame
+        quint16 sequence = (quint16)i;
+        for (const auto& listener : listeners) {
+            queuePacket(listener, PacketType::SilentAudioFrame, sequence, nullptr);
+        }
+        for (auto& source : sources) {
+            const int16_t* samples = &voice[source.voiceFrame * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+            queuePacket(source, PacketType::InjectAudio, sequence, samples);
+            source.voiceFrame = (source.voiceFrame + 1) % VOICE_FRAMES;
+        }
+
+        timestamps[PACKETS] = usecTimestampNow();
+        allocations[PACKETS] = numAllocations.load(std::memory_order_relaxed);
+
+        sharedData.addedStreams.clear();
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            slavePool.processPackets(cbegin, cend);
+        });
+
+        timestamps[EVENTS] = usecTimestampNow();
+        allocations[EVENTS] = numAllocations.load(std::memory_order_relaxed);
+
+        sharedData.removedNodes.clear();
+        sharedData.removedStreams.clear();
+        QCoreApplication::processEvents();
+
+        timestamps[MIX] = usecTimestampNow();
+        allocations[MIX] = numAllocations.load(std::memory_order_relaxed);
+
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            sharedData.foaZones.prepare(cbegin, cend, frame);
+            slavePool.mix(cbegin, cend, frame, -1);
+        });
+        if (sharedData.hrtfCache.isEnabled()) {
+            sharedData.hrtfCache.prune(frame);
+        }
+
+        timestamps[NUM_PHASES] = usecTimestampNow();
+        allocations[NUM_PHASES] = numAllocations.load(std::memory_order_relaxed);
+
+        bool isMeasured = i >= NUM_WARMUP_FRAMES;
+        slavePool.each([&](AudioMixerSlave& slave) {
+            if (isMeasured) {
+                stats.accumulate(slave.stats);
+            }
+            slave.stats.reset();
+        });
+
+        if (isMeasured) {
+            for (int phase = 0; phase < NUM_PHASES; ++phase) {
+                phaseUsecs[phase] += timestamps[phase + 1] - timestamps[phase];
+                phaseAllocations[phase] += allocations[phase + 1] - allocations[phase];
+            }
+            // the queue phase stands in for the network, it is not part of the frame of the mixer
+            maxFrameUsecs = std::max(maxFrameUsecs, timestamps[NUM_PHASES] - timestamps[PACKETS]);
+        }
+    }
+
+    MemoryInfo memoryAfter;
+    getMemoryInfo(memoryAfter);
+
+    QCOMPARE(stats.sumListeners, _numListeners * _numFrames);
+    QVERIFY(stats.sumStreams > 0);
+
+    uint64_t frameUsecs = phaseUsecs[PACKETS] + phaseUsecs[EVENTS] + phaseUsecs[MIX];
+    uint64_t frameAllocations = phaseAllocations[PACKETS] + phaseAllocations[EVENTS] + phaseAllocations[MIX];
+    const double numFrames = (double)_numFrames;
+
+    QJsonObject phases;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        QJsonObject phaseResult;
+        phaseResult["averageUsecs"] = (double)phaseUsecs[phase] / numFrames;
+        phaseResult["allocationsPerFrame"] = (double)phaseAllocations[phase] / numFrames;
+        phases[PHASE_NAMES[phase]] = phaseResult;
+    }
+
+    QJsonObject mixer;
+    mixer["streams"] = stats.sumStreams / numFrames;
+    mixer["silentListeners"] = stats.sumListenersSilent / numFrames;
+    mixer["active"] = stats.active / numFrames;
+    mixer["inactive"] = stats.inactive / numFrames;
+    mixer["skipped"] = stats.skipped / numFrames;
+    mixer["masked"] = stats.masked / numFrames;
+    mixer["hrtfRenders"] = stats.hrtfRenders / numFrames;
+    mixer["hrtfResets"] = stats.hrtfResets / numFrames;
+    mixer["hrtfUpdates"] = stats.hrtfUpdates / numFrames;
+    mixer["manualStereoMixes"] = stats.manualStereoMixes / numFrames;
+    mixer["workSteals"] = stats.workSteals / numFrames;
+
+    QJsonObject result;
+    result["name"] = scenario.name;
+    result["codec"] = scenario.codecName.isEmpty() ? QString("pcm") : scenario.codecName;
+    result["numZones"] = scenario.numZones;
+    result["numIgnoredSources"] = scenario.numIgnoredSources;
+    result["seconds"] = (double)frameUsecs / (double)USECS_PER_SECOND;
+    result["framesPerSecond"] = frameUsecs > 0 ? numFrames * (double)USECS_PER_SECOND / (double)frameUsecs : 0.0;
+    result["averageFrameUsecs"] = (double)frameUsecs / numFrames;
+    result["maxFrameUsecs"] = (double)maxFrameUsecs;
+    result["allocationsPerFrame"] = (double)frameAllocations / numFrames;
+    result["phases"] = phases;
+    result["mixer"] = mixer;
+    result["processMemoryBytes"] = (double)memoryAfter.processUsedMemoryBytes;
+    result["scenarioMemoryBytes"] = (double)memoryAfter.processUsedMemoryBytes - (double)memoryBefore.processUsedMemoryBytes;
+    result["peakProcessMemoryBytes"] = (double)memoryAfter.processPeakUsedMemoryBytes;
+    _results.append(result);
+
+    nodeList->eraseAllNodes("Audio mixer benchmark scenario finished");
+    AudioMixer::_audioZones.clear();
+    AudioMixer::_zoneSettings.clear();
+}
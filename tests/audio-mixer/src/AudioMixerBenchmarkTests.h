@@ -0,0 +1,62 @@
+//
+//  AudioMixerBenchmarkTests.h
+//  tests/audio-mixer/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerBenchmarkTests_h
+#define hifi_AudioMixerBenchmarkTests_h
+
+#include <QtCore/QJsonArray>
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QtTest>
+
+#include <plugins/Forward.h>
+
+// Runs the frames of an audio mixer headless: synthetic listeners send a silent frame and synthetic sources inject a
+// voice every frame, then the packets are processed and the mixes sent to a local socket through the AudioMixerSlavePool,
+// as AudioMixer::start does. Reports the frames per second, the time and allocations of each phase and the mixer stats
+// of each scenario as JSON, printed and written to $HIFI_AUDIO_MIXER_BENCHMARK_OUTPUT when it is set.
+//
+// $HIFI_AUDIO_MIXER_BENCHMARK_LISTENERS, _SOURCES, _FRAMES and _THREADS override the size of the scenarios,
+// _CODEC the codec of the codec scenario, _ZONES the number of zones of the zones scenario and _IGNORED the number of
+// sources each listener ignores in the ignore scenario.
+class AudioMixerBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void pcmBenchmark();
+    void codecBenchmark();
+    void zonesBenchmark();
+    void ignoreBenchmark();
+    void cleanupTestCase();
+
+private:
+    struct Scenario {
+        QString name;
+        QString codecName;
+        CodecPluginPointer codec;
+        int numZones { 0 };
+        int numIgnoredSources { 0 };
+    };
+
+    void runScenario(const Scenario& scenario);
+
+    int _numListeners { 0 };
+    int _numSources { 0 };
+    int _numFrames { 0 };
+    int _numThreads { 0 };
+
+    // receives the mixes
+    QUdpSocket _sink;
+
+    QJsonArray _results;
+};
+
+#endif // hifi_AudioMixerBenchmarkTests_h
@@ -0,0 +1,73 @@
+//
+//  AudioLimiterTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioLimiterTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "AudioLimiter.h"
+
+QTEST_MAIN(AudioLimiterTests)
+
+static const int SAMPLE_RATE = 48000;
+// more than a block of the limiter's peak detection, so that the blocks are split within each render
+static const int FRAMES_PER_RENDER = 1000;
+static const int NUM_RENDERS = 48;
+// the renders before the limiter settles
+static const int NUM_SETTLING_RENDERS = 5;
+
+// the largest output sample of a stereo 440 Hz tone, once the limiter has settled
+static int renderPeak(float amplitude) {
+    AudioLimiter limiter(SAMPLE_RATE, 2);
+    std::vector<float> input(2 * FRAMES_PER_RENDER);
+    std::vector<int16_t> output(2 * FRAMES_PER_RENDER);
+
+    int peak = 0;
+    for (int render = 0; render < NUM_RENDERS; render++) {
+        for (int n = 0; n < FRAMES_PER_RENDER; n++) {
+            float sample = amplitude * sinf(2.0f * (float)M_PI * 440.0f * (render * FRAMES_PER_RENDER + n) / SAMPLE_RATE);
+            input[2 * n + 0] = sample;
+            input[2 * n + 1] = -sample;
+        }
+        limiter.render(input.data(), output.data(), FRAMES_PER_RENDER);
+
+        if (render >= NUM_SETTLING_RENDERS) {
+            for (int16_t sample : output) {
+                peak = std::max(peak, std::abs((int)sample));
+            }
+        }
+    }
+    return peak;
+}
+
+// the gain of the limiter below its threshold: the -0.3 dB output ceiling, in 16 bits
+static const float OUTPUT_GAIN = 0.9661f * 32768.0f;
+
+void AudioLimiterTests::testSilence() {
+    // only the dither
+    QVERIFY(renderPeak(0.0f) <= 1);
+}
+
+void AudioLimiterTests::testBelowThreshold() {
+    const float AMPLITUDE = 0.25f;
+    int expected = (int)(AMPLITUDE * OUTPUT_GAIN);
+    QVERIFY(std::abs(renderPeak(AMPLITUDE) - expected) <= 2);
+}
+
+void AudioLimiterTests::testAboveThreshold() {
+    // limited to the output ceiling, without clipping or wrapping around
+    int ceiling = (int)ceilf(OUTPUT_GAIN);
+    int peak = renderPeak(4.0f);
+    QVERIFY(peak <= ceiling);
+    QVERIFY(peak >= ceiling - 100);
+}
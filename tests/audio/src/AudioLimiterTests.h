@@ -0,0 +1,25 @@
+//
+//  AudioLimiterTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioLimiterTests_h
+#define hifi_AudioLimiterTests_h
+
+#include <QtTest/QtTest>
+
+class AudioLimiterTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSilence();
+    void testBelowThreshold();
+    void testAboveThreshold();
+};
+
+#endif // hifi_AudioLimiterTests_h
@@ -0,0 +1,74 @@
+//
+//  TextureCompressionTest.cpp
+//  tests/gpu/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressionTest.h"
+
+#include <QtGui/QImage>
+
+#include <gpu/Texture.h>
+#include <image/TextureProcessing.h>
+
+QTEST_MAIN(TextureCompressionTest)
+
+Q_DECLARE_METATYPE(image::CompressionQuality)
+
+namespace {
+    const int TEXTURE_SIZE = 1024;
+
+    // gradients with a bit of noise, so the blocks aren't all trivial to encode
+    QImage createTestImage() {
+        QImage image(TEXTURE_SIZE, TEXTURE_SIZE, QImage::Format_ARGB32);
+        uint32_t noise = 1;
+        for (int y = 0; y < TEXTURE_SIZE; ++y) {
+            auto line = reinterpret_cast<QRgb*>(image.scanLine(y));
+            for (int x = 0; x < TEXTURE_SIZE; ++x) {
+                noise = noise * 1664525u + 1013904223u;
+                int n = (int)(noise >> 28);
+                line[x] = qRgba((x / 4 + n) & 0xFF, (y / 4 + n) & 0xFF, ((x + y) / 8) & 0xFF, 0xFF);
+            }
+        }
+        return image;
+    }
+}
+
+void TextureCompressionTest::benchmarkCompression_data() {
+    QTest::addColumn<image::CompressionQuality>("quality");
+    QTest::addColumn<bool>("gpuCompression");
+
+    QTest::newRow("fastest cpu") << image::CompressionQuality::Fastest << false;
+    QTest::newRow("normal cpu") << image::CompressionQuality::Normal << false;
+    QTest::newRow("production cpu") << image::CompressionQuality::Production << false;
+    QTest::newRow("fastest gpu") << image::CompressionQuality::Fastest << true;
+    QTest::newRow("normal gpu") << image::CompressionQuality::Normal << true;
+    QTest::newRow("production gpu") << image::CompressionQuality::Production << true;
+}
+
+void TextureCompressionTest::benchmarkCompression() {
+    QFETCH(image::CompressionQuality, quality);
+    QFETCH(bool, gpuCompression);
+
+    image::setCompressionQuality(quality);
+    image::setGPUCompressionEnabled(gpuCompression);
+
+    QImage source = createTestImage();
+    gpu::TexturePointer texture;
+    QBENCHMARK {
+        texture = image::TextureUsage::createAlbedoTextureFromImage(image::Image(source), "benchmark", true,
+                                                                    gpu::BackendTarget::GL45, false);
+    }
+
+    QVERIFY(texture);
+    QVERIFY(texture->getStoredMipFormat().isCompressed());
+    QVERIFY(texture->isStoredMipFaceAvailable(0));
+
+    image::setCompressionQuality(image::CompressionQuality::Production);
+    image::setGPUCompressionEnabled(true);
+}
@@ -0,0 +1,23 @@
+//
+//  TextureCompressionTest.h
+//  tests/gpu/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class TextureCompressionTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Benchmarks compressing an unbaked texture to BC at each quality, on the CPU and with GPU compression enabled
+    void benchmarkCompression_data();
+    void benchmarkCompression();
+};
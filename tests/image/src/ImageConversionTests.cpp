@@ -0,0 +1,118 @@
+//
+//  ImageConversionTests.cpp
+//  tests/image/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageConversionTests.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include <QtTest/QtTest>
+
+#include <image/ImageConversion.h>
+
+QTEST_GUILESS_MAIN(ImageConversionTests)
+
+using namespace image;
+
+// not a multiple of any vector width, so the scalar tails get tested too
+static const size_t PIXEL_COUNT = 1037;
+
+static std::vector<uint32_t> makeARGB32Pixels() {
+    std::mt19937 generator(1);
+    std::vector<uint32_t> pixels(PIXEL_COUNT);
+    for (auto& pixel : pixels) {
+        pixel = generator();
+    }
+    pixels[0] = 0x00000000;
+    pixels[1] = 0xffffffff;
+    return pixels;
+}
+
+static std::vector<glm::vec4> makeFloatPixels(bool withSpecialValues) {
+    const float SPECIAL_VALUES[] = {
+        0.0f, -0.0f, 1.0e-6f, 6.10e-5f, 6.2e-5f, 0.5f, 1.0f, 6.50e4f, 1.0e30f, -1.0e30f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN()
+    };
+    const size_t SPECIAL_VALUE_COUNT = sizeof(SPECIAL_VALUES) / sizeof(SPECIAL_VALUES[0]);
+
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> colorRange(-0.5f, 1.5f);
+    std::uniform_real_distribution<float> hdrRange(-10.0f, 7.0e4f);
+    std::vector<glm::vec4> pixels(PIXEL_COUNT);
+    for (size_t i = 0; i < PIXEL_COUNT; ++i) {
+        pixels[i] = glm::vec4(colorRange(generator), hdrRange(generator), colorRange(generator), colorRange(generator));
+        if (withSpecialValues) {
+            pixels[i][i % 3] = SPECIAL_VALUES[i % SPECIAL_VALUE_COUNT];
+        } else if (i % 3 == 0) {
+            pixels[i] = glm::vec4(i % 2, 1.0f, 0.0f, 254.5f / 255.0f);
+        }
+    }
+    return pixels;
+}
+
+// Every set of kernels gives the very same floats as the scalar one
+void ImageConversionTests::testARGB32ToFloat() {
+    auto source = makeARGB32Pixels();
+    std::vector<glm::vec4> expected(PIXEL_COUNT);
+    getScalarConversionKernels().argb32ToFloat(source.data(), expected.data(), PIXEL_COUNT);
+
+    for (auto kernels : getSupportedConversionKernels()) {
+        std::vector<glm::vec4> output(PIXEL_COUNT);
+        kernels->argb32ToFloat(source.data(), output.data(), PIXEL_COUNT);
+        QVERIFY2(memcmp(output.data(), expected.data(), PIXEL_COUNT * sizeof(glm::vec4)) == 0, kernels->name);
+    }
+    QCOMPARE(expected[1], glm::vec4(1.0f));
+}
+
+// Every set of kernels rounds and clamps the floats to the same QRgb as the scalar one
+void ImageConversionTests::testFloatToARGB32() {
+    auto source = makeFloatPixels(false);
+    std::vector<uint32_t> expected(PIXEL_COUNT);
+    getScalarConversionKernels().floatToARGB32(source.data(), expected.data(), PIXEL_COUNT);
+
+    for (auto kernels : getSupportedConversionKernels()) {
+        std::vector<uint32_t> output(PIXEL_COUNT);
+        kernels->floatToARGB32(source.data(), output.data(), PIXEL_COUNT);
+        QVERIFY2(output == expected, kernels->name);
+    }
+    QCOMPARE(expected[0], (uint32_t)0xfe00ff00);
+}
+
+// Every set of kernels packs the same bits as glm, down to denormals, overflows, infinities and NaN
+void ImageConversionTests::testFloatToR11G11B10F() {
+    auto source = makeFloatPixels(true);
+    std::vector<uint32_t> expected(PIXEL_COUNT);
+    getScalarConversionKernels().floatToR11G11B10F(source.data(), expected.data(), PIXEL_COUNT);
+
+    for (auto kernels : getSupportedConversionKernels()) {
+        std::vector<uint32_t> output(PIXEL_COUNT);
+        kernels->floatToR11G11B10F(source.data(), output.data(), PIXEL_COUNT);
+        QVERIFY2(output == expected, kernels->name);
+    }
+}
+
+// Every set of kernels moves each channel to red as the scalar one
+void ImageConversionTests::testChannelToRed() {
+    for (auto channel : { ColorChannel::RED, ColorChannel::GREEN, ColorChannel::BLUE, ColorChannel::ALPHA, ColorChannel::NONE }) {
+        auto expected = makeARGB32Pixels();
+        getScalarConversionKernels().channelToRed(expected.data(), PIXEL_COUNT, channel);
+
+        for (auto kernels : getSupportedConversionKernels()) {
+            auto output = makeARGB32Pixels();
+            kernels->channelToRed(output.data(), PIXEL_COUNT, channel);
+            QVERIFY2(output == expected, kernels->name);
+        }
+        QCOMPARE(expected[1], (uint32_t)0xffff0000);
+    }
+}
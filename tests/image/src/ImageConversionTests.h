@@ -0,0 +1,26 @@
+//
+//  ImageConversionTests.h
+//  tests/image/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ImageConversionTests_h
+#define hifi_ImageConversionTests_h
+
+#include <QtCore/QObject>
+
+class ImageConversionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testARGB32ToFloat();
+    void testFloatToARGB32();
+    void testFloatToR11G11B10F();
+    void testChannelToRed();
+};
+
+#endif // hifi_ImageConversionTests_h
@@ -13,6 +13,7 @@
 #include <QtTest/QtTest>
 
 #include <ktx/KTX.h>
+#include <ktx/Supercompression.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
 #include <image/TextureProcessing.h>
@@ -201,3 +202,44 @@ int mainTemp(int, char**) {
     return 0;
 }
 #endif
+
+// every level of a supercompressed KTX, fetched by the range its level index gives, inflates to the original level
+void KtxTests::testKtxSupercompression() {
+    const QString TEST_IMAGE = getRootPath() + "/scripts/developer/tests/cube_texture.png";
+    QImage image(TEST_IMAGE);
+    std::atomic<bool> abortSignal;
+    gpu::TexturePointer testTexture =
+        image::TextureUsage::process2DTextureColorFromImage(std::move(image), TEST_IMAGE.toStdString(), true, gpu::BackendTarget::GL45, true, abortSignal);
+    QVERIFY(testTexture);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture, glm::ivec2(testTexture->getWidth(), testTexture->getHeight()));
+    QVERIFY(ktxMemory.get());
+
+    QByteArray supercompressed = ktx::supercompress(*ktxMemory);
+    QVERIFY(!supercompressed.isNull());
+    QVERIFY((size_t)supercompressed.size() < ktxMemory->getStorage()->size());
+
+    auto bytes = reinterpret_cast<const ktx::Byte*>(supercompressed.constData());
+    auto header = reinterpret_cast<const ktx::Header*>(bytes);
+    QVERIFY(ktx::checkIdentifier(header->identifier));
+    QCOMPARE(header->numberOfMipmapLevels, ktxMemory->getHeader().numberOfMipmapLevels);
+    auto keyValues = ktx::KTX::parseKeyValues(header->bytesOfKeyValueData, bytes + ktx::KTX_HEADER_SIZE);
+    QVERIFY(ktx::isSupercompressed(keyValues));
+    QVERIFY(!ktx::isSupercompressed(ktx::removeSupercompressionKeys(keyValues)));
+
+    auto levels = ktx::getSupercompressedLevels(keyValues);
+    QCOMPARE(levels.size(), ktxMemory->_images.size());
+    QCOMPARE(ktx::evalSupercompressedStorageSize(*header, levels), (size_t)supercompressed.size());
+
+    auto imagesStart = ktx::KTX_HEADER_SIZE + header->bytesOfKeyValueData + ktx::IMAGE_SIZE_WIDTH;
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const auto& image = ktxMemory->_images[i];
+        auto level = ktx::decompressLevel(bytes + imagesStart + levels[i].byteOffset, levels[i].byteLength, levels[i]);
+        QCOMPARE((uint32_t)level.size(), image._imageSize);
+        QVERIFY(0 == memcmp(level.constData(), image._faceBytes[0], image._imageSize));
+    }
+
+    // a level that doesn't inflate to its expected size is rejected
+    auto corruptLevel = levels[0];
+    corruptLevel.uncompressedByteLength += 1;
+    QVERIFY(ktx::decompressLevel(bytes + imagesStart + levels[0].byteOffset, levels[0].byteLength, corruptLevel).isNull());
+}
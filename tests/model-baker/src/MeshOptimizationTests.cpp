@@ -0,0 +1,133 @@
+//
+//  MeshOptimizationTests.cpp
+//  tests/model-baker/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshOptimizationTests.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+#include <QtTest/QtTest>
+
+#include <model-baker/MeshOptimization.h>
+
+QTEST_GUILESS_MAIN(MeshOptimizationTests)
+
+static const int GRID_SIZE = 40;
+
+// a wavy grid of GRID_SIZE x GRID_SIZE quads, its triangles shuffled
+static hfm::Mesh makeGridMesh() {
+    hfm::Mesh mesh;
+    for (int y = 0; y <= GRID_SIZE; y++) {
+        for (int x = 0; x <= GRID_SIZE; x++) {
+            mesh.vertices.push_back(glm::vec3(x, y, sinf(x * 0.3f)));
+            mesh.texCoords.push_back(glm::vec2(x, y) / (float)GRID_SIZE);
+            mesh.originalIndices.push_back(mesh.originalIndices.size());
+        }
+    }
+
+    std::vector<std::array<int, 3>> triangles;
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            int corner = y * (GRID_SIZE + 1) + x;
+            triangles.push_back({ { corner, corner + 1, corner + GRID_SIZE + 1 } });
+            triangles.push_back({ { corner + 1, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1 } });
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1));
+
+    hfm::MeshPart part;
+    for (const auto& triangle : triangles) {
+        part.triangleIndices.append({ triangle[0], triangle[1], triangle[2] });
+    }
+    mesh.parts.push_back(part);
+    return mesh;
+}
+
+// the triangles of a mesh as the original vertices of their corners, sorted so meshes can be compared regardless of
+// their order
+static std::vector<std::array<int, 3>> getOriginalTriangles(const hfm::Mesh& mesh) {
+    std::vector<std::array<int, 3>> triangles;
+    const auto& indices = mesh.parts[0].triangleIndices;
+    for (int i = 0; i < indices.size(); i += 3) {
+        std::array<int, 3> triangle { { mesh.originalIndices[indices[i]], mesh.originalIndices[indices[i + 1]],
+                                        mesh.originalIndices[indices[i + 2]] } };
+        // rotate rather than sort the corners, to keep the winding
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// the reordered triangles should be the same ones, transforming far fewer vertices than the shuffled ones
+void MeshOptimizationTests::testVertexCache() {
+    hfm::Mesh mesh = makeGridMesh();
+    auto& indices = mesh.parts[0].triangleIndices;
+    float shuffledACMR = baker::calculateACMR(indices);
+
+    QVERIFY(baker::optimizeVertexCache(indices, mesh.vertices.size()));
+    QCOMPARE(getOriginalTriangles(mesh), getOriginalTriangles(makeGridMesh()));
+    QVERIFY(shuffledACMR > 2.5f);
+    QVERIFY(baker::calculateACMR(indices) < 0.8f);
+}
+
+// sorting the runs of triangles shouldn't lose any of them, nor cost more than a few cache hits at their seams
+void MeshOptimizationTests::testOverdraw() {
+    hfm::Mesh mesh = makeGridMesh();
+    auto& indices = mesh.parts[0].triangleIndices;
+    baker::optimizeVertexCache(indices, mesh.vertices.size());
+    float optimizedACMR = baker::calculateACMR(indices);
+
+    baker::optimizeOverdraw(indices, mesh.vertices);
+    QCOMPARE(getOriginalTriangles(mesh), getOriginalTriangles(makeGridMesh()));
+    QVERIFY(baker::calculateACMR(indices) <= optimizedACMR * 1.05f);
+}
+
+// the vertices should be numbered in the order they are drawn, taking their attributes and blendshapes along
+void MeshOptimizationTests::testVertexFetch() {
+    hfm::Mesh mesh = makeGridMesh();
+    const hfm::Mesh original = mesh;
+    hfm::Blendshape blendshape;
+    blendshape.indices = { 0, GRID_SIZE, original.vertices.size() - 1 };
+    std::vector<hfm::Blendshape> blendshapes { blendshape };
+
+    QVERIFY(baker::optimizeVertexFetch(mesh, blendshapes));
+    QCOMPARE(getOriginalTriangles(mesh), getOriginalTriangles(original));
+    int nextVertex = 0;
+    for (int index : mesh.parts[0].triangleIndices) {
+        QVERIFY(index <= nextVertex);
+        nextVertex = std::max(nextVertex, index + 1);
+    }
+    for (int i = 0; i < mesh.vertices.size(); i++) {
+        int originalIndex = mesh.originalIndices[i];
+        QCOMPARE(mesh.vertices[i], original.vertices[originalIndex]);
+        QCOMPARE(mesh.texCoords[i], original.texCoords[originalIndex]);
+    }
+    for (int i = 0; i < blendshape.indices.size(); i++) {
+        QCOMPARE(mesh.originalIndices[blendshapes[0].indices[i]], blendshape.indices[i]);
+    }
+
+    // once in order, there's nothing left to renumber
+    QVERIFY(!baker::optimizeVertexFetch(mesh, blendshapes));
+}
+
+// indices past the vertices should leave the mesh untouched rather than crash
+void MeshOptimizationTests::testInvalidIndices() {
+    hfm::Mesh mesh = makeGridMesh();
+    mesh.parts[0].triangleIndices.append({ 0, 1, mesh.vertices.size() });
+    const auto indices = mesh.parts[0].triangleIndices;
+    std::vector<hfm::Blendshape> blendshapes;
+
+    baker::optimizeMesh(mesh, blendshapes, true);
+    QCOMPARE(mesh.parts[0].triangleIndices, indices);
+}
@@ -0,0 +1,26 @@
+//
+//  MeshOptimizationTests.h
+//  tests/model-baker/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshOptimizationTests_h
+#define hifi_MeshOptimizationTests_h
+
+#include <QtCore/QObject>
+
+class MeshOptimizationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testVertexCache();
+    void testOverdraw();
+    void testVertexFetch();
+    void testInvalidIndices();
+};
+
+#endif // hifi_MeshOptimizationTests_h
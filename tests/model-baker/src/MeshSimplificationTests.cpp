@@ -0,0 +1,135 @@
+//
+//  MeshSimplificationTests.cpp
+//  tests/model-baker/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MeshSimplificationTests.h"
+
+#include <cmath>
+
+#include <QtTest/QtTest>
+
+#include <model-baker/MeshSimplification.h>
+
+QTEST_GUILESS_MAIN(MeshSimplificationTests)
+
+static const int SPHERE_RINGS = 48;
+static const int SPHERE_SEGMENTS = 48;
+
+// a unit sphere, its poles and seam shared between triangles so it's closed
+static hfm::Mesh makeSphereMesh() {
+    hfm::Mesh mesh;
+    mesh.vertices.push_back(glm::vec3(0.0f, 1.0f, 0.0f));
+    for (int ring = 1; ring < SPHERE_RINGS; ring++) {
+        float theta = (float)M_PI * ring / SPHERE_RINGS;
+        for (int segment = 0; segment < SPHERE_SEGMENTS; segment++) {
+            float phi = 2.0f * (float)M_PI * segment / SPHERE_SEGMENTS;
+            mesh.vertices.push_back(glm::vec3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi)));
+        }
+    }
+    mesh.vertices.push_back(glm::vec3(0.0f, -1.0f, 0.0f));
+    const int southPole = mesh.vertices.size() - 1;
+
+    auto ringVertex = [](int ring, int segment) {
+        return 1 + (ring - 1) * SPHERE_SEGMENTS + segment % SPHERE_SEGMENTS;
+    };
+    hfm::MeshPart part;
+    for (int segment = 0; segment < SPHERE_SEGMENTS; segment++) {
+        part.triangleIndices.append({ 0, ringVertex(1, segment + 1), ringVertex(1, segment) });
+        for (int ring = 1; ring < SPHERE_RINGS - 1; ring++) {
+            int a = ringVertex(ring, segment);
+            int b = ringVertex(ring, segment + 1);
+            int c = ringVertex(ring + 1, segment);
+            int d = ringVertex(ring + 1, segment + 1);
+            part.triangleIndices.append({ a, b, c, b, d, c });
+        }
+        part.triangleIndices.append({ southPole, ringVertex(SPHERE_RINGS - 1, segment), ringVertex(SPHERE_RINGS - 1, segment + 1) });
+    }
+    mesh.parts.push_back(part);
+    return mesh;
+}
+
+// the simplified sphere should have about the triangles asked for, with its vertices still on the sphere
+void MeshSimplificationTests::testSimplifyTriangles() {
+    hfm::Mesh mesh = makeSphereMesh();
+    const auto& indices = mesh.parts[0].triangleIndices;
+    const int targetIndexCount = indices.size() / 4 / 3 * 3;
+
+    float error;
+    QVector<int> simplified = baker::simplifyTriangles(indices, mesh.vertices, targetIndexCount, 1.0f, &error);
+    QVERIFY(simplified.size() <= targetIndexCount);
+    QVERIFY(simplified.size() > targetIndexCount / 2);
+    QCOMPARE(simplified.size() % 3, 0);
+    QVERIFY(error > 0.0f && error < 0.1f);
+    for (int i = 0; i < simplified.size(); i += 3) {
+        QVERIFY(simplified[i] != simplified[i + 1] && simplified[i + 1] != simplified[i + 2] && simplified[i + 2] != simplified[i]);
+    }
+
+    // no collapse is free on a sphere, so nothing moves without error
+    QCOMPARE(baker::simplifyTriangles(indices, mesh.vertices, targetIndexCount, 0.0f), indices);
+}
+
+// a flat square of triangles should simplify down to its fixed corners and edges
+void MeshSimplificationTests::testLockedBorder() {
+    const int size = 16;
+    QVector<glm::vec3> vertices;
+    for (int y = 0; y <= size; y++) {
+        for (int x = 0; x <= size; x++) {
+            vertices.push_back(glm::vec3(x, y, 0.0f));
+        }
+    }
+    QVector<int> indices;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            int corner = y * (size + 1) + x;
+            indices.append({ corner, corner + 1, corner + size + 1, corner + 1, corner + size + 2, corner + size + 1 });
+        }
+    }
+
+    QVector<int> simplified = baker::simplifyTriangles(indices, vertices, 3, 1.0f);
+    QVERIFY(simplified.size() < indices.size() / 4);
+    QSet<int> used;
+    for (int index : simplified) {
+        used.insert(index);
+    }
+    for (int i = 0; i <= size; i++) {
+        QVERIFY(used.contains(i));
+        QVERIFY(used.contains(size * (size + 1) + i));
+        QVERIFY(used.contains(i * (size + 1)));
+        QVERIFY(used.contains(i * (size + 1) + size));
+    }
+}
+
+// each level should be simpler than the one before, and further from the full detail
+void MeshSimplificationTests::testBuildMeshLODs() {
+    hfm::Mesh mesh = makeSphereMesh();
+    baker::buildMeshLODs(mesh, 3, 0.5f, 0.05f);
+    QCOMPARE(mesh.lodErrors.size(), 3);
+    QCOMPARE(mesh.parts[0].lodTriangleIndices.size(), 3);
+
+    int previousIndexCount = mesh.parts[0].triangleIndices.size();
+    float previousError = 0.0f;
+    for (int lod = 0; lod < mesh.lodErrors.size(); lod++) {
+        int indexCount = mesh.parts[0].lodTriangleIndices[lod].size();
+        QVERIFY(indexCount < previousIndexCount);
+        QVERIFY(mesh.lodErrors[lod] >= previousError);
+        previousIndexCount = indexCount;
+        previousError = mesh.lodErrors[lod];
+    }
+
+    // too few triangles to bother
+    hfm::Mesh quad;
+    quad.vertices = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    hfm::MeshPart part;
+    part.triangleIndices = { 0, 1, 2, 0, 2, 3 };
+    quad.parts.push_back(part);
+    baker::buildMeshLODs(quad, 3, 0.5f, 0.05f);
+    QVERIFY(quad.lodErrors.isEmpty());
+    QVERIFY(quad.parts[0].lodTriangleIndices.isEmpty());
+}
@@ -0,0 +1,25 @@
+//
+//  MeshSimplificationTests.h
+//  tests/model-baker/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MeshSimplificationTests_h
+#define hifi_MeshSimplificationTests_h
+
+#include <QtCore/QObject>
+
+class MeshSimplificationTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testSimplifyTriangles();
+    void testLockedBorder();
+    void testBuildMeshLODs();
+};
+
+#endif // hifi_MeshSimplificationTests_h
@@ -0,0 +1,75 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <random>
+#include <unordered_set>
+
+#include <AssetUtils.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+namespace {
+    const uint32_t MIN_CHUNK_SIZE = 16 * 1024;
+    const uint32_t MAX_CHUNK_SIZE = 256 * 1024;
+
+    QByteArray randomData(int size, unsigned int seed) {
+        std::mt19937 generator(seed);
+        QByteArray data(size, Qt::Uninitialized);
+        for (int i = 0; i < size; ++i) {
+            data[i] = (char)(generator() & 0xFF);
+        }
+        return data;
+    }
+}
+
+void AssetChunkingTests::coverageTest() {
+    QByteArray data = randomData(4 * 1024 * 1024 + 123, 1);
+    auto chunks = AssetUtils::chunkData(data.constData(), data.size());
+
+    QVERIFY(chunks.size() > 1);
+    uint64_t offset = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk = chunks[i];
+        QCOMPARE(chunk.offset, offset);
+        QVERIFY(chunk.size <= MAX_CHUNK_SIZE);
+        if (i + 1 < chunks.size()) {
+            QVERIFY(chunk.size >= MIN_CHUNK_SIZE);
+        }
+        QCOMPARE(chunk.hash, AssetUtils::hashData(data.mid((int)chunk.offset, (int)chunk.size)));
+        offset += chunk.size;
+    }
+    QCOMPARE(offset, (uint64_t)data.size());
+}
+
+void AssetChunkingTests::insertionTest() {
+    QByteArray data = randomData(4 * 1024 * 1024, 2);
+    QByteArray editedData = data;
+    editedData.insert(data.size() / 2, QByteArray(100, 'x'));
+
+    auto chunks = AssetUtils::chunkData(data.constData(), data.size());
+    auto editedChunks = AssetUtils::chunkData(editedData.constData(), editedData.size());
+
+    std::unordered_set<std::string> hashes;
+    for (const auto& chunk : chunks) {
+        hashes.insert(chunk.hash.toStdString());
+    }
+    size_t numChangedChunks = 0;
+    for (const auto& chunk : editedChunks) {
+        if (hashes.find(chunk.hash.toStdString()) == hashes.end()) {
+            ++numChangedChunks;
+        }
+    }
+
+    // the boundaries resynchronize right after the insertion
+    QVERIFY(numChangedChunks <= 3);
+}
@@ -0,0 +1,29 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkingTests_h
+#define hifi_AssetChunkingTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the chunks cover the data in order and stay within the size bounds
+    void coverageTest();
+
+    // Test that inserting bytes only changes the chunks around the insertion
+    void insertionTest();
+};
+
+#endif // hifi_AssetChunkingTests_h
@@ -0,0 +1,94 @@
+//
+//  ContentNetworkCacheTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContentNetworkCacheTests.h"
+
+#include <memory>
+
+#include <AssetUtils.h>
+#include <ContentNetworkCache.h>
+
+QTEST_MAIN(ContentNetworkCacheTests)
+
+namespace {
+    const qint64 MAXIMUM_CACHE_SIZE = 64 * 1024 * 1024;
+
+    bool store(ContentNetworkCache& cache, const QUrl& url, const QByteArray& content) {
+        QNetworkCacheMetaData metaData;
+        metaData.setUrl(url);
+        metaData.setSaveToDisk(true);
+        auto device = cache.prepare(metaData);
+        if (!device) {
+            return false;
+        }
+        device->write(content);
+        cache.insert(device);
+        return true;
+    }
+
+    QByteArray load(ContentNetworkCache& cache, const QUrl& url) {
+        auto device = std::unique_ptr<QIODevice>(cache.data(url));
+        return device ? device->readAll() : QByteArray();
+    }
+}
+
+void ContentNetworkCacheTests::deduplicationTest() {
+    ContentNetworkCache cache(_directory.filePath("deduplication"), MAXIMUM_CACHE_SIZE);
+    QByteArray content(1000, 'a');
+
+    QVERIFY(store(cache, QUrl("http://one.example/texture.png"), content));
+    QVERIFY(store(cache, QUrl("https://two.example/other.png#fragment"), content));
+
+    QCOMPARE(cache.cacheSize(), (qint64)content.size());
+    QCOMPARE(load(cache, QUrl("http://one.example/texture.png")), content);
+    QCOMPARE(load(cache, QUrl("https://two.example/other.png")), content);
+    QVERIFY(!cache.metaData(QUrl("http://three.example/texture.png")).isValid());
+
+    QVERIFY(cache.remove(QUrl("http://one.example/texture.png")));
+    QVERIFY(!cache.metaData(QUrl("http://one.example/texture.png")).isValid());
+    QCOMPARE(load(cache, QUrl("https://two.example/other.png")), content);
+}
+
+void ContentNetworkCacheTests::atpHashTest() {
+    ContentNetworkCache cache(_directory.filePath("atp"), MAXIMUM_CACHE_SIZE);
+    QByteArray content(1000, 'b');
+    QString hash = AssetUtils::hashData(content).toHex();
+
+    QVERIFY(store(cache, QUrl("http://one.example/sound.wav"), content));
+    QVERIFY(cache.metaData(QUrl("atp:" + hash)).isValid());
+    QCOMPARE(load(cache, QUrl("atp:" + hash.toUpper())), content);
+
+    // content not matching the hash its URL names isn't stored
+    QVERIFY(store(cache, QUrl("atp:" + QString(hash).replace(0, 1, hash[0] == 'a' ? "b" : "a")), content));
+    QCOMPARE(cache.cacheSize(), (qint64)content.size());
+}
+
+void ContentNetworkCacheTests::persistenceTest() {
+    QString directory = _directory.filePath("persistence");
+    QByteArray content(1000, 'c');
+    QByteArray corruptContent(1000, 'd');
+    {
+        ContentNetworkCache cache(directory, MAXIMUM_CACHE_SIZE);
+        QVERIFY(store(cache, QUrl("http://one.example/model.fbx"), content));
+        QVERIFY(store(cache, QUrl("http://one.example/corrupt.fbx"), corruptContent));
+    }
+
+    QString corruptFile = QDir(directory).filePath("content/" + AssetUtils::hashData(corruptContent).toHex() + ".blob");
+    QFile file(corruptFile);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(QByteArray(1000, 'e'));
+    file.close();
+
+    ContentNetworkCache cache(directory, MAXIMUM_CACHE_SIZE);
+    QCOMPARE(load(cache, QUrl("http://one.example/model.fbx")), content);
+    QVERIFY(load(cache, QUrl("http://one.example/corrupt.fbx")).isNull());
+    QVERIFY(!cache.metaData(QUrl("http://one.example/corrupt.fbx")).isValid());
+}
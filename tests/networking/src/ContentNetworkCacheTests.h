@@ -0,0 +1,36 @@
+//
+//  ContentNetworkCacheTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContentNetworkCacheTests_h
+#define hifi_ContentNetworkCacheTests_h
+
+#pragma once
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+class ContentNetworkCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the same content under two URLs is only stored once
+    void deduplicationTest();
+
+    // Test that atp: URLs find content by hash, whatever URL it was stored under
+    void atpHashTest();
+
+    // Test that content and index files survive a restart, and that corrupt content isn't returned
+    void persistenceTest();
+
+private:
+    QTemporaryDir _directory;
+};
+
+#endif // hifi_ContentNetworkCacheTests_h
@@ -0,0 +1,144 @@
+//
+//  LossListTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LossListTests.h"
+
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+
+using namespace udt;
+
+QTEST_MAIN(LossListTests)
+
+namespace {
+    SequenceNumber seq(SequenceNumber::Type value) {
+        return SequenceNumber(value);
+    }
+}
+
+void LossListTests::insertTest() {
+    LossList list;
+    list.append(seq(10), seq(19));
+    list.append(seq(20));
+    QCOMPARE(list.getLength(), 11);
+    QCOMPARE(list.getNumRanges(), 1);
+
+    list.append(seq(30), seq(39));
+    QCOMPARE(list.getNumRanges(), 2);
+
+    // fills the hole between the two ranges
+    list.insert(seq(21), seq(29));
+    QCOMPARE(list.getLength(), 30);
+    QCOMPARE(list.getNumRanges(), 1);
+
+    // overlaps what is already there
+    list.insert(seq(5), seq(15));
+    QCOMPARE(list.getLength(), 35);
+    QCOMPARE(list.getFirstSequenceNumber(), seq(5));
+    QVERIFY(list.contains(seq(39)));
+    QVERIFY(!list.contains(seq(40)));
+}
+
+void LossListTests::removeTest() {
+    LossList list;
+    list.append(seq(0), seq(99));
+
+    QVERIFY(list.remove(seq(50)));
+    QVERIFY(!list.remove(seq(50)));
+    QCOMPARE(list.getLength(), 99);
+    QCOMPARE(list.getNumRanges(), 2);
+
+    list.remove(seq(10), seq(19));
+    QCOMPARE(list.getLength(), 89);
+    QCOMPARE(list.getNumRanges(), 3);
+    QVERIFY(list.contains(seq(9)));
+    QVERIFY(!list.contains(seq(10)));
+    QVERIFY(!list.contains(seq(19)));
+    QVERIFY(list.contains(seq(20)));
+
+    // spans several ranges
+    list.remove(seq(5), seq(60));
+    QCOMPARE(list.getLength(), 44);
+    QCOMPARE(list.getNumRanges(), 2);
+
+    QCOMPARE(list.popFirstSequenceNumber(), seq(0));
+    QCOMPARE(list.getFirstSequenceNumber(), seq(1));
+
+    list.remove(seq(0), seq(99));
+    QVERIFY(list.isEmpty());
+    QCOMPARE(list.getNumRanges(), 0);
+}
+
+void LossListTests::wrapTest() {
+    const SequenceNumber::Type MAX = SequenceNumber::MAX;
+
+    QCOMPARE(seq(0) - 1, seq(MAX));
+    QCOMPARE(seq(2) - 5, seq(MAX - 2));
+
+    LossList list;
+    list.append(seq(MAX - 9), seq(MAX));
+    list.append(seq(0), seq(9));
+    QCOMPARE(list.getLength(), 20);
+    QCOMPARE(list.getNumRanges(), 1);
+
+    list.remove(seq(0), seq(4));
+    QCOMPARE(list.getLength(), 15);
+    QVERIFY(list.contains(seq(MAX)));
+    QVERIFY(!list.contains(seq(0)));
+    QVERIFY(list.contains(seq(5)));
+    QCOMPARE(list.getFirstSequenceNumber(), seq(MAX - 9));
+
+    list.insert(seq(MAX), seq(2));
+    QCOMPARE(list.getLength(), 18);
+    QCOMPARE(list.getNumRanges(), 2);
+}
+
+void LossListTests::writeNewestTest() {
+    const int NUM_RANGES = 10;
+    const int MAX_PAIRS = 4;
+
+    LossList list;
+    for (int i = 0; i < NUM_RANGES; ++i) {
+        list.append(seq(i * 10), seq(i * 10 + 4));
+    }
+
+    auto packet = ControlPacket::create(ControlPacket::ACK, 2 * MAX_PAIRS * sizeof(SequenceNumber));
+    list.writeNewest(*packet, MAX_PAIRS);
+    QCOMPARE(packet->getPayloadSize(), (qint64)(2 * MAX_PAIRS * sizeof(SequenceNumber)));
+
+    packet->seek(0);
+    for (int i = NUM_RANGES - MAX_PAIRS; i < NUM_RANGES; ++i) {
+        SequenceNumber first, last;
+        packet->readPrimitive(&first);
+        packet->readPrimitive(&last);
+        QCOMPARE(first, seq(i * 10));
+        QCOMPARE(last, seq(i * 10 + 4));
+    }
+}
+
+void LossListTests::benchmark() {
+    const int NUM_SEQUENCE_NUMBERS = 100000;
+
+    QBENCHMARK {
+        LossList list;
+        // every other packet lost, then recovered out of order
+        for (int i = 0; i < NUM_SEQUENCE_NUMBERS; i += 2) {
+            list.append(seq(i));
+        }
+        for (int i = NUM_SEQUENCE_NUMBERS - 2; i >= 0; i -= 4) {
+            list.remove(seq(i));
+        }
+        for (int i = 0; i < NUM_SEQUENCE_NUMBERS; i += 4) {
+            list.remove(seq(i));
+        }
+        QVERIFY(list.isEmpty());
+    }
+}
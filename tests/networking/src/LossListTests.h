@@ -0,0 +1,38 @@
+//
+//  LossListTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LossListTests_h
+#define hifi_LossListTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class LossListTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that appended and inserted ranges merge with their neighbours
+    void insertTest();
+
+    // Test that removes split the ranges they fall inside of
+    void removeTest();
+
+    // Test ranges across the wraparound of the sequence numbers
+    void wrapTest();
+
+    // Test that the newest ranges are the ones written to a packet
+    void writeNewestTest();
+
+    // Measure a list with many holes, as on a lossy link
+    void benchmark();
+};
+
+#endif // hifi_LossListTests_h
@@ -0,0 +1,55 @@
+//
+//  NodeSnapshotTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeSnapshotTests.h"
+
+#include <LimitedNodeList.h>
+
+QTEST_MAIN(NodeSnapshotTests)
+
+static SharedNodePointer makeNode(NodeType_t type) {
+    return SharedNodePointer(new Node(QUuid::createUuid(), type, SockAddr(), SockAddr()));
+}
+
+void NodeSnapshotTests::groupByTypeTest() {
+    std::vector<SharedNodePointer> nodes {
+        makeNode(NodeType::Agent), makeNode(NodeType::AudioMixer), makeNode(NodeType::Agent),
+        makeNode(NodeType::EntityScriptServer), makeNode(NodeType::Agent)
+    };
+    NodeSnapshot snapshot(nodes);
+    QCOMPARE(snapshot.size(), nodes.size());
+
+    int numAgents = 0;
+    for (const auto& node : snapshot.ofType(NodeType::Agent)) {
+        QCOMPARE(node->getType(), NodeType::Agent);
+        ++numAgents;
+    }
+    QCOMPARE(numAgents, 3);
+
+    auto mixers = snapshot.ofType(NodeType::AudioMixer);
+    QCOMPARE(std::distance(mixers.begin(), mixers.end()), (ptrdiff_t)1);
+    QCOMPARE(*mixers.begin(), nodes[1]);
+
+    auto scriptServers = snapshot.ofType(NodeType::EntityScriptServer);
+    QCOMPARE(std::distance(scriptServers.begin(), scriptServers.end()), (ptrdiff_t)1);
+    QCOMPARE(*scriptServers.begin(), nodes[3]);
+}
+
+void NodeSnapshotTests::emptyTest() {
+    NodeSnapshot snapshot(std::vector<SharedNodePointer> { makeNode(NodeType::Agent) });
+    auto mixers = snapshot.ofType(NodeType::AvatarMixer);
+    QVERIFY(mixers.begin() == mixers.end());
+
+    NodeSnapshot empty { std::vector<SharedNodePointer>() };
+    QCOMPARE(empty.size(), (size_t)0);
+    auto agents = empty.ofType(NodeType::Agent);
+    QVERIFY(agents.begin() == agents.end());
+}
@@ -0,0 +1,29 @@
+//
+//  NodeSnapshotTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeSnapshotTests_h
+#define hifi_NodeSnapshotTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class NodeSnapshotTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the nodes of each type are found together, whatever order they were given in
+    void groupByTypeTest();
+
+    // Test a type with no nodes and an empty snapshot
+    void emptyTest();
+};
+
+#endif // hifi_NodeSnapshotTests_h
@@ -0,0 +1,75 @@
+//
+//  NodeTelemetryTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeTelemetryTests.h"
+
+#include <NodeTelemetry.h>
+
+QTEST_MAIN(NodeTelemetryTests)
+
+void NodeTelemetryTests::init() {
+    NodeTelemetry::reset();
+}
+
+void NodeTelemetryTests::roundTripTest() {
+    NodeTelemetry::addToCounter("packets", 5);
+    NodeTelemetry::addToCounter("packets", 7);
+    NodeTelemetry::setGauge("nodes", 3.5);
+    for (uint64_t value : { 10, 20, 300, 4000 }) {
+        NodeTelemetry::recordValue("frame_usecs", value);
+    }
+
+    NodeTelemetry::Metrics metrics;
+    QVERIFY(NodeTelemetry::accumulate(NodeTelemetry::takeSnapshot(), metrics));
+    QCOMPARE(metrics.size(), (size_t)3);
+
+    QCOMPARE(metrics["packets"].type, NodeTelemetry::Counter);
+    QCOMPARE(metrics["packets"].value, 12.0);
+    QCOMPARE(metrics["nodes"].type, NodeTelemetry::Gauge);
+    QCOMPARE(metrics["nodes"].value, 3.5);
+
+    const auto& frames = metrics["frame_usecs"];
+    QCOMPARE(frames.type, NodeTelemetry::Histogram);
+    QCOMPARE(frames.histogram.getCount(), (uint64_t)4);
+    QCOMPARE(frames.histogram.getTotal(), (uint64_t)4330);
+    QCOMPARE(frames.histogram.getMax(), (uint64_t)4000);
+    for (uint64_t value : { 10, 20, 300, 4000 }) {
+        QCOMPARE(frames.histogram.getBucketCount(LatencyHistogram::bucketFor(value)), (uint32_t)1);
+    }
+}
+
+void NodeTelemetryTests::deltaTest() {
+    NodeTelemetry::Metrics metrics;
+    NodeTelemetry::addToCounter("packets", 5);
+    NodeTelemetry::recordValue("frame_usecs", 100);
+    QVERIFY(NodeTelemetry::accumulate(NodeTelemetry::takeSnapshot(), metrics));
+
+    // nothing new since
+    QVERIFY(NodeTelemetry::takeSnapshot().isEmpty());
+
+    NodeTelemetry::addToCounter("packets", 2);
+    NodeTelemetry::recordValue("frame_usecs", 200);
+    NodeTelemetry::recordValue("frame_usecs", 300);
+    QVERIFY(NodeTelemetry::accumulate(NodeTelemetry::takeSnapshot(), metrics));
+
+    QCOMPARE(metrics["packets"].value, 7.0);
+    QCOMPARE(metrics["frame_usecs"].histogram.getCount(), (uint64_t)3);
+    QCOMPARE(metrics["frame_usecs"].histogram.getTotal(), (uint64_t)600);
+    QCOMPARE(metrics["frame_usecs"].histogram.getMax(), (uint64_t)300);
+}
+
+void NodeTelemetryTests::malformedTest() {
+    NodeTelemetry::recordValue("frame_usecs", 100);
+    QByteArray snapshot = NodeTelemetry::takeSnapshot();
+
+    NodeTelemetry::Metrics metrics;
+    QVERIFY(!NodeTelemetry::accumulate(snapshot.left(snapshot.size() - 1), metrics));
+}
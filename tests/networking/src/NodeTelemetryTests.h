@@ -0,0 +1,34 @@
+//
+//  NodeTelemetryTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTelemetryTests_h
+#define hifi_NodeTelemetryTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class NodeTelemetryTests : public QObject {
+    Q_OBJECT
+private slots:
+    void init();
+
+    // Test that each type of metric arrives as it was recorded
+    void roundTripTest();
+
+    // Test that a snapshot only holds what changed since the one before, and that they add up on the receiving side
+    void deltaTest();
+
+    // Test that a truncated snapshot is refused
+    void malformedTest();
+};
+
+#endif // hifi_NodeTelemetryTests_h
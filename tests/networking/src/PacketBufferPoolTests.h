@@ -0,0 +1,32 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that buffers are recycled once released
+    void reuseTest();
+
+    // Test buffers released on another thread than the one that allocated them
+    void crossThreadTest();
+
+    // Test buffers too large for the pool and plain heap buffers
+    void heapTest();
+};
+
+#endif // hifi_PacketBufferPoolTests_h
@@ -0,0 +1,132 @@
+//
+//  PacketCipherTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCipherTests.h"
+
+#include <NLPacket.h>
+#include <PacketCipher.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(PacketCipherTests)
+
+namespace {
+    const NLPacket::LocalID SENDER_ID = 42;
+
+    std::unique_ptr<NLPacket> createPayloadPacket(const QByteArray& payload) {
+        auto packet = NLPacket::create(PacketType::AvatarData, payload.size());
+        packet->write(payload);
+        packet->writeSourceID(SENDER_ID);
+        return packet;
+    }
+
+    // as the receiver sees the packet
+    std::unique_ptr<udt::Packet> receive(const NLPacket& packet) {
+        auto buffer = udt::PacketBufferPool::allocate(packet.getDataSize());
+        memcpy(buffer.get(), packet.getData(), packet.getDataSize());
+        return udt::Packet::fromReceivedPacket(std::move(buffer), packet.getDataSize(), SockAddr());
+    }
+}
+
+void PacketCipherTests::roundTripTest() {
+    auto secret = QUuid::createUuid();
+    PacketCipher sender;
+    PacketCipher receiver;
+    QVERIFY(sender.setKey(secret));
+    QVERIFY(receiver.setKey(secret));
+
+    QByteArray payload(1000, 'x');
+    auto packet = createPayloadPacket(payload);
+    QVERIFY(packet->sealPayload(sender));
+
+    auto received = receive(*packet);
+    QVERIFY(QByteArray(received->getData() + NLPacket::totalHeaderSize(PacketType::AvatarData), payload.size()) != payload);
+    QVERIFY(NLPacket::openPayload(*received, receiver));
+    QCOMPARE(QByteArray(received->getData() + NLPacket::totalHeaderSize(PacketType::AvatarData), payload.size()), payload);
+
+    // an empty payload is still authenticated
+    auto emptyPacket = createPayloadPacket(QByteArray());
+    QVERIFY(emptyPacket->sealPayload(sender));
+    auto receivedEmpty = receive(*emptyPacket);
+    QVERIFY(NLPacket::openPayload(*receivedEmpty, receiver));
+}
+
+void PacketCipherTests::tamperTest() {
+    auto secret = QUuid::createUuid();
+    PacketCipher sender;
+    PacketCipher receiver;
+    PacketCipher stranger;
+    QVERIFY(sender.setKey(secret));
+    QVERIFY(receiver.setKey(secret));
+    QVERIFY(stranger.setKey(QUuid::createUuid()));
+
+    // a flipped payload bit
+    auto packet = createPayloadPacket(QByteArray(100, 'x'));
+    QVERIFY(packet->sealPayload(sender));
+    auto received = receive(*packet);
+    received->getData()[received->getDataSize() - 1] ^= 1;
+    QVERIFY(!NLPacket::openPayload(*received, receiver));
+
+    // another source ID, which is authenticated with the payload
+    packet = createPayloadPacket(QByteArray(100, 'x'));
+    QVERIFY(packet->sealPayload(sender));
+    packet->writeSourceID(SENDER_ID + 1);
+    QVERIFY(!NLPacket::openPayload(*receive(*packet), receiver));
+
+    // another secret
+    packet = createPayloadPacket(QByteArray(100, 'x'));
+    QVERIFY(packet->sealPayload(sender));
+    QVERIFY(!NLPacket::openPayload(*receive(*packet), stranger));
+
+    // no key at all
+    PacketCipher unkeyed;
+    QVERIFY(!createPayloadPacket(QByteArray(100, 'x'))->sealPayload(unkeyed));
+}
+
+void PacketCipherTests::rekeyTest() {
+    auto secret = QUuid::createUuid();
+    PacketCipher receiver;
+    QVERIFY(receiver.setKey(secret));
+
+    QByteArray payload(100, 'x');
+    QByteArray sealed[2];
+    for (auto& sealedPacket : sealed) {
+        PacketCipher sender;
+        QVERIFY(sender.setKey(secret));
+
+        auto packet = createPayloadPacket(payload);
+        QVERIFY(packet->sealPayload(sender));
+        sealedPacket = QByteArray(packet->getData(), (int)packet->getDataSize());
+        QVERIFY(NLPacket::openPayload(*receive(*packet), receiver));
+    }
+
+    // both are the first packet of their cipher, but they must not share a nonce and so a keystream
+    QVERIFY(sealed[0] != sealed[1]);
+}
+
+void PacketCipherTests::benchmark() {
+    const int NUM_PACKETS = 1000;
+
+    auto secret = QUuid::createUuid();
+    PacketCipher sender;
+    PacketCipher receiver;
+    sender.setKey(secret);
+    receiver.setKey(secret);
+
+    auto packet = createPayloadPacket(QByteArray(NLPacket::maxPayloadSize(PacketType::AvatarData), 'x'));
+
+    // sealed and opened in place, as the sender and the receiver do
+    QBENCHMARK {
+        for (int i = 0; i < NUM_PACKETS; ++i) {
+            QVERIFY(packet->sealPayload(sender));
+            QVERIFY(NLPacket::openPayload(*packet, receiver));
+        }
+    }
+}
@@ -0,0 +1,35 @@
+//
+//  PacketCipherTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCipherTests_h
+#define hifi_PacketCipherTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketCipherTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a sealed packet opens to its payload with the same secret
+    void roundTripTest();
+
+    // Test that tampered packets, other senders and other secrets do not open
+    void tamperTest();
+
+    // Test that a cipher keyed again with the same secret, as for a node that is added again, seals with new nonces
+    void rekeyTest();
+
+    // Measure sealing and opening full packets
+    void benchmark();
+};
+
+#endif // hifi_PacketCipherTests_h
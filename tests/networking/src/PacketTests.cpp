@@ -14,6 +14,7 @@
 #include <test-utils/QTestExtensions.h>
 
 #include <NLPacket.h>
+#include <udt/PacketQueue.h>
 
 QTEST_MAIN(PacketTests)
 
@@ -181,3 +182,35 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::sendPriorityTest() {
+    auto packet = NLPacket::create(PacketType::BulkAvatarData);
+    QCOMPARE(packet->getSendPriority(), udt::Packet::SendPriority::Bulk);
+    packet->setSendPriority(udt::Packet::SendPriority::High);
+
+    // the priority is local to the sender
+    auto readPacket = copyToReadPacket(packet);
+    QCOMPARE(readPacket->getSendPriority(), udt::Packet::SendPriority::Bulk);
+
+    udt::PacketQueue queue;
+    for (int i = 0; i < 3; ++i) {
+        auto bulkPacket = udt::Packet::create(-1, true);
+        bulkPacket->writePrimitive(i);
+        queue.queuePacket(std::move(bulkPacket));
+    }
+    auto highPriorityPacket = udt::Packet::create(-1, true);
+    highPriorityPacket->writePrimitive(-1);
+    highPriorityPacket->setSendPriority(udt::Packet::SendPriority::High);
+    queue.queuePacket(std::move(highPriorityPacket));
+
+    // the high priority packet jumps the queue, the bulk packets then follow in their order
+    for (int expected = -1; expected < 3; ++expected) {
+        auto taken = queue.takePacket();
+        QVERIFY(taken);
+        int value;
+        taken->seek(0);
+        taken->readPrimitive(&value);
+        QCOMPARE(value, expected);
+    }
+    QVERIFY(queue.isEmpty());
+}
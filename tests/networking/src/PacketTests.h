@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test that high priority packets are taken from a send queue first
+    void sendPriorityTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -0,0 +1,68 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <NLPacket.h>
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+void ReceivedMessageTests::singlePacketTest() {
+    const QByteArray PAYLOAD("avatar data");
+
+    auto packet = NLPacket::create(PacketType::AvatarData);
+    packet->write(PAYLOAD);
+    packet->seek(0);
+    const char* payload = packet->getPayload();
+
+    ReceivedMessage message(std::move(packet));
+    QVERIFY(message.isComplete());
+    QVERIFY(message.getNotifier() == nullptr);
+    QCOMPARE(message.getRawMessage(), payload);
+    QCOMPARE(message.getSize(), (qint64)PAYLOAD.size());
+
+    char head[5];
+    QCOMPARE(message.readHead(head, sizeof(head)), (qint64)sizeof(head));
+    QCOMPARE(QByteArray(head, sizeof(head)), PAYLOAD.left(sizeof(head)));
+
+    message.seek(0);
+    QByteArray all = message.readAll();
+    QCOMPARE(all, PAYLOAD);
+    QVERIFY(all.constData() != payload);
+    QVERIFY(message.getMessage().constData() != payload);
+}
+
+void ReceivedMessageTests::multiPacketTest() {
+    const QByteArray FIRST("first ");
+    const QByteArray LAST("last");
+
+    auto first = NLPacket::create(PacketType::AssetGetReply, -1, true, true);
+    first->writeMessageNumber(1, NLPacket::FIRST, 0);
+    first->write(FIRST);
+    first->seek(0);
+
+    auto last = NLPacket::create(PacketType::AssetGetReply, -1, true, true);
+    last->writeMessageNumber(1, NLPacket::LAST, 1);
+    last->write(LAST);
+    last->seek(0);
+
+    ReceivedMessage message(*first);
+    QVERIFY(!message.isComplete());
+    QVERIFY(message.getNotifier() != nullptr);
+
+    QSignalSpy completed(message.getNotifier(), &ReceivedMessageNotifier::completed);
+    message.appendPacket(*last);
+    QVERIFY(message.isComplete());
+    QCOMPARE(completed.count(), 1);
+    QCOMPARE(message.getNumPackets(), (qint64)2);
+    QCOMPARE(message.readAll(), FIRST + LAST);
+}
@@ -0,0 +1,29 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a single-packet message reads from its packet, and hands out copies
+    void singlePacketTest();
+
+    // Test that a message of several packets copies them and signals its progress
+    void multiPacketTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
@@ -0,0 +1,223 @@
+//
+//  EntityEncodeTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodeTests.h"
+
+#include <EntityItemProperties.h>
+#include <EntityPropertyCodec.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(EntityEncodeTests)
+
+namespace {
+    const EntityItemID ENTITY_ID { QUuid::createUuid() };
+
+    OctreeElement::AppendState encode(const EntityItemProperties& properties, QByteArray& buffer) {
+        buffer.resize(NLPacket::maxPayloadSize(PacketType::EntityEdit));
+        EntityPropertyFlags didntFitProperties;
+        return EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, ENTITY_ID, properties, buffer,
+                                                            properties.getChangedProperties(), didntFitProperties);
+    }
+
+    void runEncodeBenchmark(const EntityItemProperties& properties) {
+        QByteArray buffer;
+        QBENCHMARK {
+            encode(properties, buffer);
+        }
+    }
+
+    // a box whose shared properties are all set, as when an entity is added
+    EntityItemProperties makeSharedProperties() {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setParentID(QUuid::createUuid());
+        properties.setParentJointIndex(3);
+        properties.setVisible(false);
+        properties.setName("box");
+        properties.setLocked(true);
+        properties.setUserData("{\"grabbableKey\":{\"grabbable\":true}}");
+        properties.setHref("hifi://somewhere");
+        properties.setDescription("a box");
+        properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+        properties.setDimensions(glm::vec3(0.5f));
+        properties.setRotation(glm::quat(0.0f, 1.0f, 0.0f, 0.0f));
+        properties.setRegistrationPoint(glm::vec3(0.25f));
+        properties.setCreated(1234);
+        properties.setLastEditedBy(QUuid::createUuid());
+        properties.setCanCastShadow(false);
+        properties.setRenderLayer(RenderLayer::FRONT);
+        properties.setPrimitiveMode(PrimitiveMode::LINES);
+        properties.setIgnorePickIntersection(true);
+        properties.setRenderWithZones({ QUuid::createUuid() });
+        properties.setBillboardMode(BillboardMode::FULL);
+        properties.setDensity(500.0f);
+        properties.setVelocity(glm::vec3(0.0f, 1.0f, 0.0f));
+        properties.setAngularVelocity(glm::vec3(1.0f, 0.0f, 0.0f));
+        properties.setGravity(glm::vec3(0.0f, -9.8f, 0.0f));
+        properties.setAcceleration(glm::vec3(0.0f, -1.0f, 0.0f));
+        properties.setDamping(0.5f);
+        properties.setAngularDamping(0.25f);
+        properties.setRestitution(0.75f);
+        properties.setFriction(0.125f);
+        properties.setLifetime(60.0f);
+        properties.setCollisionless(true);
+        properties.setCollisionMask(7);
+        properties.setDynamic(true);
+        properties.setCollisionSoundURL("http://example.com/bump.wav");
+        properties.setCloneable(true);
+        properties.setCloneLifetime(30.0f);
+        properties.setCloneLimit(4.0f);
+        properties.setScript("http://example.com/box.js");
+        properties.setScriptTimestamp(5678);
+        properties.setItemName("Box");
+        properties.setEditionNumber(2);
+        properties.getGrab().setGrabbable(false);
+        return properties;
+    }
+}
+
+void EntityEncodeTests::groupPropertiesTest() {
+    KeyLightPropertyGroup keyLight;
+    QVERIFY(keyLight.getGroupProperties().getHasProperty(PROP_KEYLIGHT_COLOR));
+    QVERIFY(keyLight.getGroupProperties().getHasProperty(PROP_KEYLIGHT_SHADOW_MAX_DISTANCE));
+    QVERIFY(!keyLight.getGroupProperties().getHasProperty(PROP_POSITION));
+
+    EntityPropertyFlags requestedProperties;
+    QVERIFY(!keyLight.hasRequestedProperties(requestedProperties));
+    requestedProperties += PROP_POSITION;
+    requestedProperties += PROP_SKYBOX_COLOR;
+    QVERIFY(!keyLight.hasRequestedProperties(requestedProperties));
+    requestedProperties += PROP_KEYLIGHT_INTENSITY;
+    QVERIFY(keyLight.hasRequestedProperties(requestedProperties));
+    requestedProperties -= PROP_KEYLIGHT_INTENSITY;
+    QVERIFY(!keyLight.hasRequestedProperties(requestedProperties));
+}
+
+void EntityEncodeTests::zoneEditRoundTripTest() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Zone);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    properties.getKeyLight().setIntensity(0.25f);
+
+    QByteArray buffer;
+    QCOMPARE(encode(properties, buffer), OctreeElement::COMPLETED);
+
+    int processedBytes = 0;
+    EntityItemID entityID;
+    EntityItemProperties decoded;
+    QVERIFY(EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                         buffer.size(), processedBytes, entityID, decoded));
+    QCOMPARE(entityID, ENTITY_ID);
+    QCOMPARE(decoded.getPosition(), properties.getPosition());
+    QCOMPARE(decoded.getKeyLight().getIntensity(), 0.25f);
+    QVERIFY(decoded.getKeyLight().intensityChanged());
+    QVERIFY(!decoded.getKeyLight().colorChanged());
+    QVERIFY(decoded.getAmbientLight().getChangedProperties().isEmpty());
+    QVERIFY(decoded.getHaze().getChangedProperties().isEmpty());
+}
+
+void EntityEncodeTests::zoneScalarEditBenchmark() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Zone);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    runEncodeBenchmark(properties);
+}
+
+void EntityEncodeTests::zoneGroupEditBenchmark() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Zone);
+    properties.getKeyLight().setIntensity(0.25f);
+    runEncodeBenchmark(properties);
+}
+
+void EntityEncodeTests::modelScalarEditBenchmark() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Model);
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    runEncodeBenchmark(properties);
+}
+
+void EntityEncodeTests::zoneAllPropertiesEditBenchmark() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Zone);
+    properties.markAllChanged();
+    runEncodeBenchmark(properties);
+}
+
+void EntityEncodeTests::nextPropertyTest() {
+    EntityPropertyFlags flags;
+    QCOMPARE(flags.getNextProperty(0), -1);
+
+    flags += PROP_VISIBLE;
+    flags += PROP_DENSITY;
+    flags += PROP_STATIC_CERTIFICATE_VERSION;
+    QCOMPARE(flags.getNextProperty(0), (int)PROP_VISIBLE);
+    QCOMPARE(flags.getNextProperty(PROP_VISIBLE), (int)PROP_VISIBLE);
+    QCOMPARE(flags.getNextProperty(PROP_VISIBLE + 1), (int)PROP_DENSITY);
+    QCOMPARE(flags.getNextProperty(PROP_DENSITY + 1), (int)PROP_STATIC_CERTIFICATE_VERSION);
+    QCOMPARE(flags.getNextProperty(PROP_STATIC_CERTIFICATE_VERSION + 1), -1);
+
+    int numProperties = 0;
+    for (int property = flags.getNextProperty(0); property != -1; property = flags.getNextProperty(property + 1)) {
+        QVERIFY(flags.getHasProperty((EntityPropertyList)property));
+        ++numProperties;
+    }
+    QCOMPARE(numProperties, 3);
+}
+
+void EntityEncodeTests::sharedPropertiesRoundTripTest() {
+    EntityItemProperties properties = makeSharedProperties();
+    QVERIFY(EntityPropertyCodec::getDescriptor(PROP_POSITION).encode);
+    QVERIFY(!EntityPropertyCodec::getDescriptor(PROP_OWNING_AVATAR_ID).encode);
+    QVERIFY(!EntityPropertyCodec::getDescriptor(PROP_GRAB_GRABBABLE).encode);
+
+    QByteArray buffer;
+    QCOMPARE(encode(properties, buffer), OctreeElement::COMPLETED);
+
+    int processedBytes = 0;
+    EntityItemID entityID;
+    EntityItemProperties decoded;
+    QVERIFY(EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                         buffer.size(), processedBytes, entityID, decoded));
+    QCOMPARE(processedBytes, buffer.size());
+    QCOMPARE(decoded.getParentID(), properties.getParentID());
+    QCOMPARE(decoded.getParentJointIndex(), properties.getParentJointIndex());
+    QCOMPARE(decoded.getName(), properties.getName());
+    QCOMPARE(decoded.getUserData(), properties.getUserData());
+    QCOMPARE(decoded.getPosition(), properties.getPosition());
+    QCOMPARE(decoded.getRotation(), properties.getRotation());
+    QCOMPARE(decoded.getLastEditedBy(), properties.getLastEditedBy());
+    QCOMPARE(decoded.getRenderLayer(), properties.getRenderLayer());
+    QCOMPARE(decoded.getRenderWithZones(), properties.getRenderWithZones());
+    QCOMPARE(decoded.getBillboardMode(), properties.getBillboardMode());
+    QCOMPARE(decoded.getGrab().getGrabbable(), false);
+    QCOMPARE(decoded.getGravity(), properties.getGravity());
+    QCOMPARE(decoded.getCollisionMask(), properties.getCollisionMask());
+    QCOMPARE(decoded.getCloneLimit(), properties.getCloneLimit());
+    QCOMPARE(decoded.getScriptTimestamp(), properties.getScriptTimestamp());
+    QCOMPARE(decoded.getEditionNumber(), properties.getEditionNumber());
+}
+
+void EntityEncodeTests::sharedPropertiesEncodeBenchmark() {
+    runEncodeBenchmark(makeSharedProperties());
+}
+
+void EntityEncodeTests::sharedPropertiesDecodeBenchmark() {
+    QByteArray buffer;
+    encode(makeSharedProperties(), buffer);
+    QBENCHMARK {
+        int processedBytes = 0;
+        EntityItemID entityID;
+        EntityItemProperties decoded;
+        EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                                                     buffer.size(), processedBytes, entityID, decoded);
+    }
+}
@@ -0,0 +1,37 @@
+//
+//  EntityEncodeTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodeTests_h
+#define hifi_EntityEncodeTests_h
+
+#include <QtTest/QtTest>
+
+// Checks that property groups with nothing requested are skipped when encoding, and times encoding the edit packets
+// of zones and models, which have the most grouped properties, when only one property has changed. Also checks and
+// times the table of properties shared by all entity types, which are encoded and decoded by EntityPropertyCodec.
+class EntityEncodeTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void groupPropertiesTest();
+    void zoneEditRoundTripTest();
+    void zoneScalarEditBenchmark();
+    void zoneGroupEditBenchmark();
+    void modelScalarEditBenchmark();
+    void zoneAllPropertiesEditBenchmark();
+
+    void nextPropertyTest();
+    void sharedPropertiesRoundTripTest();
+    void sharedPropertiesEncodeBenchmark();
+    void sharedPropertiesDecodeBenchmark();
+};
+
+#endif // hifi_EntityEncodeTests_h
@@ -0,0 +1,155 @@
+//
+//  EntityMapTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityMapTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QThread>
+
+#include <EntityItemID.h>
+#include <shared/ShardedHashMap.h>
+
+QTEST_MAIN(EntityMapTests)
+
+namespace {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_OPERATIONS_PER_THREAD = 200000;
+    // one edit in this many operations for the mixed benchmarks, about what an entity server sees
+    const int OPERATIONS_PER_EDIT = 50;
+
+    using Value = std::shared_ptr<int>;
+
+    std::vector<EntityItemID> ids;
+
+    class LockedHash {
+    public:
+        Value value(const EntityItemID& id) const {
+            QReadLocker locker(&_lock);
+            return _hash.value(id);
+        }
+        void insert(const EntityItemID& id, const Value& value) {
+            QWriteLocker locker(&_lock);
+            _hash.insert(id, value);
+        }
+        void remove(const EntityItemID& id) {
+            QWriteLocker locker(&_lock);
+            _hash.remove(id);
+        }
+
+    private:
+        mutable QReadWriteLock _lock;
+        QHash<EntityItemID, Value> _hash;
+    };
+
+    // each thread walks the ids from its own starting point, replacing an entry every editInterval operations
+    template <typename Map>
+    void runThreads(Map& map, int editInterval) {
+        int numThreads = std::max(QThread::idealThreadCount(), 2);
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < numThreads; ++thread) {
+            threads.emplace_back([&map, thread, numThreads, editInterval] {
+                size_t index = (size_t)thread * ids.size() / numThreads;
+                int numFound = 0;
+                for (int i = 0; i < NUM_OPERATIONS_PER_THREAD; ++i) {
+                    const EntityItemID& id = ids[index];
+                    if (editInterval > 0 && i % editInterval == 0) {
+                        map.remove(id);
+                        map.insert(id, std::make_shared<int>(i));
+                    } else if (map.value(id)) {
+                        ++numFound;
+                    }
+                    index = (index + 1) % ids.size();
+                }
+                Q_UNUSED(numFound);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    template <typename Map>
+    void fill(Map& map) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+            map.insert(ids[i], std::make_shared<int>((int)i));
+        }
+    }
+}
+
+void EntityMapTests::initTestCase() {
+    ids.reserve(NUM_ENTITIES);
+    for (int i = 0; i < NUM_ENTITIES; ++i) {
+        ids.push_back(EntityItemID(QUuid::createUuid()));
+    }
+}
+
+void EntityMapTests::shardedMapTest() {
+    ShardedHashMap<EntityItemID, Value> map;
+    const int NUM_TEST_ENTITIES = 1000;
+    for (int i = 0; i < NUM_TEST_ENTITIES; ++i) {
+        QVERIFY(map.insertIfAbsent(ids[i], std::make_shared<int>(i)));
+    }
+    QVERIFY(!map.insertIfAbsent(ids[0], std::make_shared<int>(-1)));
+    QCOMPARE(*map.value(ids[0]), 0);
+    QCOMPARE(map.size(), NUM_TEST_ENTITIES);
+    QVERIFY(!map.value(ids[NUM_TEST_ENTITIES]));
+
+    QVERIFY(map.remove(ids[1]));
+    QVERIFY(!map.remove(ids[1]));
+    QVERIFY(!map.contains(ids[1]));
+
+    int sum = 0;
+    map.forEach([&](const EntityItemID&, const Value& value) {
+        sum += *value;
+    });
+    QCOMPARE(sum, (NUM_TEST_ENTITIES - 1) * NUM_TEST_ENTITIES / 2 - 1);
+
+    auto hash = map.takeAll();
+    QCOMPARE(hash.size(), NUM_TEST_ENTITIES - 1);
+    QVERIFY(map.isEmpty());
+}
+
+void EntityMapTests::lockedHashLookupBenchmark() {
+    LockedHash map;
+    fill(map);
+    QBENCHMARK {
+        runThreads(map, 0);
+    }
+}
+
+void EntityMapTests::shardedMapLookupBenchmark() {
+    ShardedHashMap<EntityItemID, Value> map;
+    fill(map);
+    QBENCHMARK {
+        runThreads(map, 0);
+    }
+}
+
+void EntityMapTests::lockedHashMixedBenchmark() {
+    LockedHash map;
+    fill(map);
+    QBENCHMARK {
+        runThreads(map, OPERATIONS_PER_EDIT);
+    }
+}
+
+void EntityMapTests::shardedMapMixedBenchmark() {
+    ShardedHashMap<EntityItemID, Value> map;
+    fill(map);
+    QBENCHMARK {
+        runThreads(map, OPERATIONS_PER_EDIT);
+    }
+}
@@ -0,0 +1,31 @@
+//
+//  EntityMapTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityMapTests_h
+#define hifi_EntityMapTests_h
+
+#include <QtTest/QtTest>
+
+// Compares looking entities up by ID, from as many threads as there are cores, in one QHash behind a QReadWriteLock
+// as EntityTree used to and in the ShardedHashMap it uses now.
+class EntityMapTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void shardedMapTest();
+    void lockedHashLookupBenchmark();
+    void shardedMapLookupBenchmark();
+    void lockedHashMixedBenchmark();
+    void shardedMapMixedBenchmark();
+};
+
+#endif // hifi_EntityMapTests_h
@@ -0,0 +1,94 @@
+//
+//  EntityOwnedRegionTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityOwnedRegionTests.h"
+
+#include <EntityItem.h>
+#include <EntityTree.h>
+#include <EntityTypes.h>
+
+QTEST_MAIN(EntityOwnedRegionTests)
+
+namespace {
+    // a 10 m cube with its corner at the origin
+    const AACube OWNED_REGION(glm::vec3(0.0f), 10.0f);
+    const glm::vec3 INSIDE(5.0f, 5.0f, 5.0f);
+    const glm::vec3 OUTSIDE(50.0f, 5.0f, 5.0f);
+
+    EntityItemPointer makeEntity(const glm::vec3& position, const QUuid& parentID = QUuid()) {
+        EntityItemProperties properties;
+        properties.setPosition(position);
+        properties.setParentID(parentID);
+        return EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()), properties);
+    }
+}
+
+void EntityOwnedRegionTests::addTest() {
+    EntityTree tree;
+    tree.setOwnedRegion(OWNED_REGION);
+
+    EntityItemProperties properties;
+    properties.setPosition(INSIDE);
+    QVERIFY(tree.isInOwnedRegion(properties));
+    properties.setPosition(OUTSIDE);
+    QVERIFY(!tree.isInOwnedRegion(properties));
+
+    // a child is its parent's server's business
+    properties.setParentID(QUuid::createUuid());
+    QVERIFY(tree.isInOwnedRegion(properties));
+}
+
+void EntityOwnedRegionTests::moveOutTest() {
+    EntityTree tree;
+    auto entity = makeEntity(INSIDE);
+    QVERIFY(entity);
+
+    EntityItemProperties move;
+    move.setPosition(OUTSIDE);
+
+    // anything goes without a region
+    QVERIFY(tree.isEditInOwnedRegion(entity, move));
+
+    tree.setOwnedRegion(OWNED_REGION);
+    QVERIFY(!tree.isEditInOwnedRegion(entity, move));
+
+    EntityItemProperties moveWithin;
+    moveWithin.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(tree.isEditInOwnedRegion(entity, moveWithin));
+
+    // edits that don't move it are left alone
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    QVERIFY(tree.isEditInOwnedRegion(entity, rename));
+
+    // and so are the moves of children, which are relative to their parent
+    auto child = makeEntity(OUTSIDE, QUuid::createUuid());
+    QVERIFY(tree.isEditInOwnedRegion(child, move));
+}
+
+void EntityOwnedRegionTests::unparentOutsideTest() {
+    EntityTree tree;
+    tree.setOwnedRegion(OWNED_REGION);
+
+    EntityItemProperties unparent;
+    unparent.setParentID(QUuid());
+    unparent.setPosition(OUTSIDE);
+    QVERIFY(!tree.isEditInOwnedRegion(makeEntity(INSIDE, QUuid::createUuid()), unparent));
+
+    unparent.setPosition(INSIDE);
+    QVERIFY(tree.isEditInOwnedRegion(makeEntity(OUTSIDE, QUuid::createUuid()), unparent));
+
+    // parenting to another entity takes it off this server's hands
+    EntityItemProperties parent;
+    parent.setParentID(QUuid::createUuid());
+    parent.setPosition(OUTSIDE);
+    QVERIFY(tree.isEditInOwnedRegion(makeEntity(INSIDE), parent));
+}
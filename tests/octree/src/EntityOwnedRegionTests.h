@@ -0,0 +1,26 @@
+//
+//  EntityOwnedRegionTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityOwnedRegionTests_h
+#define hifi_EntityOwnedRegionTests_h
+
+#include <QtTest/QtTest>
+
+class EntityOwnedRegionTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void addTest();
+    void moveOutTest();
+    void unparentOutsideTest();
+};
+
+#endif // hifi_EntityOwnedRegionTests_h
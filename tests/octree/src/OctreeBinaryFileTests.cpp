@@ -0,0 +1,89 @@
+//
+//  OctreeBinaryFileTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeBinaryFileTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <OctreeBinaryFile.h>
+
+QTEST_MAIN(OctreeBinaryFileTests)
+
+void OctreeBinaryFileTests::roundTripTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("models.bin");
+
+    // enough records, some of them large, to span several chunks
+    const int NUM_RECORDS = 2000;
+    const QUuid fileID = QUuid::createUuid();
+    std::vector<QUuid> ids;
+    std::vector<QByteArray> datas;
+    OctreeBinaryFile::Writer writer(42, fileID, 7, "{\"Paths\":{}}");
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        ids.push_back(QUuid::createUuid());
+        datas.push_back(QByteArray(i % 100 == 0 ? 70000 : 10 + i % 300, (char)('a' + i % 26)));
+        writer.addRecord(ids.back(), (uint8_t)(i % 2), datas.back());
+    }
+    QCOMPARE(writer.getNumRecords(), (uint32_t)NUM_RECORDS);
+    QVERIFY(writer.write(fileName));
+    QVERIFY(OctreeBinaryFile::isBinaryFile(fileName));
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(reader.open(fileName));
+    QCOMPARE(reader.getVersion(), (uint8_t)42);
+    QCOMPARE(reader.getID(), fileID);
+    QCOMPARE(reader.getDataVersion(), 7);
+    QCOMPARE(reader.getMetadata(), QByteArray("{\"Paths\":{}}"));
+    QCOMPARE(reader.getNumRecords(), (uint32_t)NUM_RECORDS);
+    QVERIFY(reader.getNumChunks() > 1);
+
+    int recordIndex = 0;
+    QByteArray buffer;
+    std::vector<OctreeBinaryFile::Record> records;
+    for (int chunk = 0; chunk < reader.getNumChunks(); ++chunk) {
+        QVERIFY(reader.readChunk(chunk, buffer, records));
+        for (const auto& record : records) {
+            QVERIFY(recordIndex < NUM_RECORDS);
+            QCOMPARE(record.id, ids[recordIndex]);
+            QCOMPARE(record.encoding, (uint8_t)(recordIndex % 2));
+            QCOMPARE(QByteArray(record.data, record.size), datas[recordIndex]);
+            ++recordIndex;
+        }
+    }
+    QCOMPARE(recordIndex, NUM_RECORDS);
+    QVERIFY(!reader.readChunk(reader.getNumChunks(), buffer, records));
+}
+
+void OctreeBinaryFileTests::truncatedFileTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("models.bin");
+
+    OctreeBinaryFile::Writer writer(1, QUuid::createUuid(), 0, QByteArray());
+    writer.addRecord(QUuid::createUuid(), 0, QByteArray(1000, 'x'));
+    QVERIFY(writer.write(fileName));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 10));
+    file.close();
+
+    OctreeBinaryFile::Reader reader;
+    QVERIFY(!reader.open(fileName));
+
+    // a JSON persist file isn't mistaken for one
+    QFile jsonFile(dir.filePath("models.json"));
+    QVERIFY(jsonFile.open(QIODevice::WriteOnly));
+    jsonFile.write("{\"Entities\":[]}");
+    jsonFile.close();
+    QVERIFY(!OctreeBinaryFile::isBinaryFile(jsonFile.fileName()));
+}
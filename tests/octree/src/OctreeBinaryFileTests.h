@@ -0,0 +1,25 @@
+//
+//  OctreeBinaryFileTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeBinaryFileTests_h
+#define hifi_OctreeBinaryFileTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeBinaryFileTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTripTest();
+    void truncatedFileTest();
+};
+
+#endif // hifi_OctreeBinaryFileTests_h
@@ -0,0 +1,91 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+namespace {
+    // as the persist files have it, the version comes after the entities
+    const QByteArray CONTENT {
+        "{\n"
+        "  \"DataVersion\": 3,\n"
+        "  \"Entities\": [\n"
+        "    { \"id\": \"{6f5bd7b0-4dbf-4b5c-9b6c-5c1a1fd62f00}\", \"name\": \"one ] }\", \"type\": \"Box\" },\n"
+        "    { \"id\": \"{6f5bd7b0-4dbf-4b5c-9b6c-5c1a1fd62f01}\", \"userData\": \"{\\\"a\\\": [1, 2]}\", \"type\": \"Zone\" }\n"
+        "  ],\n"
+        "  \"Id\": \"{a1b2c3d4-0000-4000-8000-000000000001}\",\n"
+        "  \"Version\": 120\n"
+        "}\n"
+    };
+}
+
+void OctreeEntitiesFileParserTests::streamEntitiesTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(CONTENT);
+
+    QVariantMap header;
+    QStringList types;
+    bool success = parser.parseEntities(header, [&](QJsonObject& entity) {
+        // the whole header is read before any entity
+        if (header["Version"].toInt() != 120 || header["DataVersion"].toInt() != 3) {
+            return false;
+        }
+        types.append(entity["type"].toString());
+        return true;
+    });
+    QVERIFY2(success, parser.getErrorString().c_str());
+    QCOMPARE(types, QStringList({ "Box", "Zone" }));
+    QVERIFY(!header.contains("Entities"));
+    QCOMPARE(header["Id"].toUuid(), QUuid("{a1b2c3d4-0000-4000-8000-000000000001}"));
+}
+
+void OctreeEntitiesFileParserTests::headerOnlyTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(CONTENT);
+
+    QVariantMap header;
+    QVERIFY2(parser.parseEntities(header, nullptr), parser.getErrorString().c_str());
+    QCOMPARE(header["Version"].toInt(), 120);
+    QCOMPARE(header["DataVersion"].toInt(), 3);
+    QVERIFY(!header.contains("Entities"));
+}
+
+void OctreeEntitiesFileParserTests::parseToMapTest() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(CONTENT);
+
+    QVariantMap parsedEntities;
+    QVERIFY2(parser.parseEntities(parsedEntities), parser.getErrorString().c_str());
+    QCOMPARE(parsedEntities["Version"].toInt(), 120);
+    QVariantList entities = parsedEntities["Entities"].toList();
+    QCOMPARE(entities.size(), 2);
+    QCOMPARE(entities[0].toMap()["name"].toString(), QString("one ] }"));
+}
+
+void OctreeEntitiesFileParserTests::malformedTest() {
+    const QByteArray UNTERMINATED { "{ \"DataVersion\": 3, \"Entities\": [ { \"type\": \"Box\" }, " };
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(UNTERMINATED);
+    QVariantMap header;
+    QVERIFY(!parser.parseEntities(header, nullptr));
+
+    // a rejected entity stops the parse
+    parser.setEntitiesString(CONTENT);
+    int numEntities = 0;
+    QVERIFY(!parser.parseEntities(header, [&](QJsonObject& entity) {
+        ++numEntities;
+        return false;
+    }));
+    QCOMPARE(numEntities, 1);
+}
@@ -0,0 +1,110 @@
+//
+//  OctreeJournalTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournalTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <OctreeJournal.h>
+
+QTEST_MAIN(OctreeJournalTests)
+
+void OctreeJournalTests::roundTripTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("models.bin.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+    const QUuid entityID = QUuid::createUuid();
+
+    OctreeJournal journal;
+    QVERIFY(journal.open(fileName, 3, snapshotID, 10));
+    journal.append(OctreeJournal::Upsert, entityID, 1, QByteArray("first"));
+    journal.appendCheckpoint(11);
+    QVERIFY(journal.flush());
+
+    // reopening to carry on keeps what was there
+    OctreeJournal reopened;
+    QVERIFY(reopened.open(fileName, 3, snapshotID, 10, true));
+    reopened.append(OctreeJournal::Delete, entityID);
+    QVERIFY(reopened.flush());
+
+    std::vector<OctreeJournal::Entry> entries;
+    int checkpointDataVersion = 0;
+    QVERIFY(OctreeJournal::read(fileName, 3, snapshotID, 10, entries, checkpointDataVersion));
+    QCOMPARE(checkpointDataVersion, 11);
+    QCOMPARE((int)entries.size(), 3);
+    QCOMPARE(entries[0].type, OctreeJournal::Upsert);
+    QCOMPARE(entries[0].id, entityID);
+    QCOMPARE(entries[0].encoding, (uint8_t)1);
+    QCOMPARE(entries[0].data, QByteArray("first"));
+    QCOMPARE(entries[1].type, OctreeJournal::Checkpoint);
+    QCOMPARE(entries[2].type, OctreeJournal::Delete);
+    QCOMPARE(entries[2].id, entityID);
+}
+
+void OctreeJournalTests::otherSnapshotTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("models.bin.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    OctreeJournal journal;
+    QVERIFY(journal.open(fileName, 3, snapshotID, 10));
+    journal.append(OctreeJournal::Upsert, QUuid::createUuid(), 0, QByteArray("data"));
+    QVERIFY(journal.flush());
+
+    std::vector<OctreeJournal::Entry> entries;
+    int checkpointDataVersion = 0;
+    QVERIFY(!OctreeJournal::read(fileName, 3, snapshotID, 11, entries, checkpointDataVersion));
+    QVERIFY(!OctreeJournal::read(fileName, 4, snapshotID, 10, entries, checkpointDataVersion));
+    QVERIFY(!OctreeJournal::read(fileName, 3, QUuid::createUuid(), 10, entries, checkpointDataVersion));
+    QVERIFY(entries.empty());
+
+    // carrying on from another snapshot starts the journal over
+    OctreeJournal reopened;
+    QVERIFY(reopened.open(fileName, 3, snapshotID, 11, true));
+    QVERIFY(OctreeJournal::read(fileName, 3, snapshotID, 11, entries, checkpointDataVersion));
+    QVERIFY(entries.empty());
+    QCOMPARE(checkpointDataVersion, 11);
+}
+
+void OctreeJournalTests::incompleteEntryTest() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString fileName = dir.filePath("models.bin.journal");
+    const QUuid snapshotID = QUuid::createUuid();
+
+    OctreeJournal journal;
+    QVERIFY(journal.open(fileName, 3, snapshotID, 10));
+    journal.append(OctreeJournal::Upsert, QUuid::createUuid(), 0, QByteArray(100, 'a'));
+    journal.append(OctreeJournal::Upsert, QUuid::createUuid(), 0, QByteArray(100, 'b'));
+    QVERIFY(journal.flush());
+    qint64 completeSize = journal.size();
+
+    // as if a crash cut the last entry short
+    QFile file(fileName);
+    QVERIFY(file.resize(completeSize - 10));
+
+    std::vector<OctreeJournal::Entry> entries;
+    int checkpointDataVersion = 0;
+    QVERIFY(OctreeJournal::read(fileName, 3, snapshotID, 10, entries, checkpointDataVersion));
+    QCOMPARE((int)entries.size(), 1);
+    QCOMPARE(entries[0].data, QByteArray(100, 'a'));
+
+    // entries appended after reopening follow the last complete one
+    OctreeJournal reopened;
+    QVERIFY(reopened.open(fileName, 3, snapshotID, 10, true));
+    reopened.append(OctreeJournal::Delete, QUuid::createUuid());
+    QVERIFY(reopened.flush());
+    QVERIFY(OctreeJournal::read(fileName, 3, snapshotID, 10, entries, checkpointDataVersion));
+    QCOMPARE((int)entries.size(), 2);
+    QCOMPARE(entries[1].type, OctreeJournal::Delete);
+}
@@ -0,0 +1,365 @@
+//
+//  PhysicsBenchmarkTests.cpp
+//  tests/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsBenchmarkTests.h"
+
+#include <algorithm>
+#include <memory>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+
+#include <glm/gtx/quaternion.hpp>
+
+#include <BulletUtil.h>
+#include <ObjectMotionState.h>
+#include <PhysicsCollisionGroups.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <SharedUtil.h>
+#include <ShapeManager.h>
+
+QTEST_MAIN(PhysicsBenchmarkTests)
+
+namespace {
+    const int DEFAULT_NUM_STEPS = 600;
+    const int MESH_BUILD_TIMEOUT = 30000; // msec
+    // a body below this has fallen through the floor
+    const float MIN_BODY_HEIGHT = -10.0f;
+    const glm::vec3 DEFAULT_CONE_TWIST_AXIS(1.0f, 0.0f, 0.0f);
+
+    glm::vec3 vec3FromJson(const QJsonValue& value, const glm::vec3& defaultValue = glm::vec3(0.0f)) {
+        if (!value.isObject()) {
+            return defaultValue;
+        }
+        QJsonObject object = value.toObject();
+        return glm::vec3(object["x"].toDouble(), object["y"].toDouble(), object["z"].toDouble());
+    }
+
+    glm::quat quatFromJson(const QJsonValue& value) {
+        if (!value.isObject()) {
+            return glm::quat();
+        }
+        QJsonObject object = value.toObject();
+        return glm::normalize(glm::quat(object["w"].toDouble(), object["x"].toDouble(),
+                                        object["y"].toDouble(), object["z"].toDouble()));
+    }
+
+    // the parts of an EntityMotionState that the simulation reads, taken from an exported entity
+    class BenchmarkMotionState : public ObjectMotionState {
+    public:
+        BenchmarkMotionState(const btCollisionShape* shape, const QJsonObject& entity) :
+            ObjectMotionState(shape),
+            _id(QUuid(entity["id"].toString())),
+            _shapeType(ShapeInfo::getShapeTypeForName(entity["shapeType"].toString())),
+            _dynamic(entity["dynamic"].toBool()),
+            _position(vec3FromJson(entity["position"])),
+            _rotation(quatFromJson(entity["rotation"])),
+            _velocity(vec3FromJson(entity["velocity"])),
+            _angularVelocity(vec3FromJson(entity["angularVelocity"])),
+            _gravity(vec3FromJson(entity["gravity"])),
+            _friction((float)entity["friction"].toDouble(0.5)),
+            _restitution((float)entity["restitution"].toDouble(0.5)),
+            _damping((float)entity["damping"].toDouble(0.39)),
+            _angularDamping((float)entity["angularDamping"].toDouble(0.39))
+        {
+            glm::vec3 dimensions = vec3FromJson(entity["dimensions"], glm::vec3(1.0f));
+            setMass((float)entity["density"].toDouble(1000.0) * dimensions.x * dimensions.y * dimensions.z);
+        }
+
+        uint32_t getIncomingDirtyFlags() const override { return 0; }
+        void clearIncomingDirtyFlags(uint32_t mask) override {}
+
+        PhysicsMotionType computePhysicsMotionType() const override {
+            return _dynamic ? MOTION_TYPE_DYNAMIC : MOTION_TYPE_STATIC;
+        }
+        bool isMoving() const override {
+            return glm::length2(_velocity) > 0.0f || glm::length2(_angularVelocity) > 0.0f;
+        }
+
+        float getObjectRestitution() const override { return _restitution; }
+        float getObjectFriction() const override { return _friction; }
+        float getObjectLinearDamping() const override { return _damping; }
+        float getObjectAngularDamping() const override { return _angularDamping; }
+
+        glm::vec3 getObjectPosition() const override { return _position - getWorldOffset(); }
+        glm::quat getObjectRotation() const override { return _rotation; }
+        glm::vec3 getObjectLinearVelocity() const override { return _velocity; }
+        glm::vec3 getObjectAngularVelocity() const override { return _angularVelocity; }
+        glm::vec3 getObjectGravity() const override { return _gravity; }
+
+        const QUuid getObjectID() const override { return _id; }
+        QUuid getSimulatorID() const override { return QUuid(); }
+        ShapeType getShapeType() const override { return _shapeType; }
+
+        void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override {
+            group = _dynamic ? BULLET_COLLISION_GROUP_DYNAMIC : BULLET_COLLISION_GROUP_STATIC;
+            mask = _dynamic ? BULLET_COLLISION_MASK_DYNAMIC : BULLET_COLLISION_MASK_STATIC;
+        }
+
+        void getWorldTransform(btTransform& worldTrans) const override {
+            worldTrans.setOrigin(glmToBullet(getObjectPosition()));
+            worldTrans.setRotation(glmToBullet(_rotation));
+        }
+
+        void setWorldTransform(const btTransform& worldTrans) override {
+            _position = bulletToGLM(worldTrans.getOrigin()) + getWorldOffset();
+            _rotation = bulletToGLM(worldTrans.getRotation());
+            _velocity = getBodyLinearVelocity();
+            _angularVelocity = getBodyAngularVelocity();
+        }
+
+        bool isDynamic() const { return _dynamic; }
+        const glm::vec3& getPosition() const { return _position; }
+
+    private:
+        QUuid _id;
+        ShapeType _shapeType;
+        bool _dynamic;
+        glm::vec3 _position;
+        glm::quat _rotation;
+        glm::vec3 _velocity;
+        glm::vec3 _angularVelocity;
+        glm::vec3 _gravity;
+        float _friction;
+        float _restitution;
+        float _damping;
+        float _angularDamping;
+    };
+
+    ShapeInfo computeShapeInfo(const QJsonObject& entity) {
+        ShapeInfo info;
+        ShapeType type = ShapeInfo::getShapeTypeForName(entity["shapeType"].toString());
+        glm::vec3 halfExtents = 0.5f * vec3FromJson(entity["dimensions"], glm::vec3(1.0f));
+        if (type != SHAPE_TYPE_STATIC_MESH) {
+            info.setParams(type, halfExtents);
+            return info;
+        }
+
+        // the exports name the model of a static-mesh, the scenes carry its triangles instead
+        QJsonObject mesh = entity["collisionMesh"].toObject();
+        QJsonArray vertices = mesh["vertices"].toArray();
+        ShapeInfo::PointList points;
+        for (int i = 0; i + 2 < vertices.size(); i += 3) {
+            points.push_back(glm::vec3(vertices[i].toDouble(), vertices[i + 1].toDouble(), vertices[i + 2].toDouble()));
+        }
+        info.setParams(type, halfExtents, entity["id"].toString());
+        info.setPointCollection(ShapeInfo::PointCollection({ points }));
+        for (const auto& index : mesh["indices"].toArray()) {
+            info.getTriangleIndices().push_back(index.toInt());
+        }
+        return info;
+    }
+
+    btTypedConstraint* createConstraint(const QJsonObject& arguments, btRigidBody* bodyA, btRigidBody* bodyB) {
+        QString type = arguments["type"].toString();
+        btVector3 pivotInA = glmToBullet(vec3FromJson(arguments["pivot"]));
+        btVector3 pivotInB = glmToBullet(vec3FromJson(arguments["otherPivot"]));
+        glm::vec3 axisInA = glm::normalize(vec3FromJson(arguments["axis"], DEFAULT_CONE_TWIST_AXIS));
+        glm::vec3 axisInB = glm::normalize(vec3FromJson(arguments["otherAxis"], DEFAULT_CONE_TWIST_AXIS));
+
+        if (type == "ball-socket") {
+            return new btPoint2PointConstraint(*bodyA, *bodyB, pivotInA, pivotInB);
+        }
+        if (type == "cone-twist") {
+            btTransform frameInA(glmToBullet(glm::rotation(DEFAULT_CONE_TWIST_AXIS, axisInA)), pivotInA);
+            btTransform frameInB(glmToBullet(glm::rotation(DEFAULT_CONE_TWIST_AXIS, axisInB)), pivotInB);
+            auto constraint = new btConeTwistConstraint(*bodyA, *bodyB, frameInA, frameInB);
+            constraint->setLimit((btScalar)arguments["swingSpan1"].toDouble(TWO_PI),
+                                 (btScalar)arguments["swingSpan2"].toDouble(TWO_PI),
+                                 (btScalar)arguments["twistSpan"].toDouble(TWO_PI));
+            return constraint;
+        }
+        if (type == "hinge") {
+            auto constraint = new btHingeConstraint(*bodyA, *bodyB, pivotInA, pivotInB,
+                                                    glmToBullet(axisInA), glmToBullet(axisInB), true);
+            constraint->setLimit((btScalar)arguments["low"].toDouble(-TWO_PI), (btScalar)arguments["high"].toDouble(TWO_PI));
+            return constraint;
+        }
+        return nullptr;
+    }
+}
+
+void PhysicsBenchmarkTests::initTestCase() {
+    _scenesDirectory = qEnvironmentVariable("HIFI_PHYSICS_BENCHMARK_SCENES", PHYSICS_BENCHMARK_SCENES_DIR);
+    bool ok = false;
+    _numSteps = qEnvironmentVariableIntValue("HIFI_PHYSICS_BENCHMARK_STEPS", &ok);
+    if (!ok || _numSteps <= 0) {
+        _numSteps = DEFAULT_NUM_STEPS;
+    }
+}
+
+void PhysicsBenchmarkTests::stacksBenchmark() {
+    runScene("stacks");
+}
+
+void PhysicsBenchmarkTests::ragdollsBenchmark() {
+    runScene("ragdolls");
+}
+
+void PhysicsBenchmarkTests::pileBenchmark() {
+    runScene("pile");
+}
+
+void PhysicsBenchmarkTests::meshBenchmark() {
+    runScene("mesh");
+}
+
+void PhysicsBenchmarkTests::cleanupTestCase() {
+    QJsonObject report;
+    report["benchmark"] = "physics";
+    report["numSteps"] = _numSteps;
+    report["timeStep"] = PHYSICS_ENGINE_FIXED_SUBSTEP;
+#if defined(HIFI_MULTITHREADED_PHYSICS)
+    report["multithreaded"] = true;
+#else
+    report["multithreaded"] = false;
+#endif
+    report["scenes"] = _results;
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Compact);
+    qInfo().noquote() << json;
+
+    QString outputPath = qEnvironmentVariable("HIFI_PHYSICS_BENCHMARK_OUTPUT");
+    if (!outputPath.isEmpty()) {
+        QSaveFile file(outputPath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(json);
+        QVERIFY(file.commit());
+    }
+}
+
+void PhysicsBenchmarkTests::runScene(const QString& name) {
+    QFile file(_scenesDirectory + "/" + name + ".json");
+    QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.fileName()));
+    QJsonParseError error;
+    QJsonObject scene = QJsonDocument::fromJson(file.readAll(), &error).object();
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    MemoryInfo memoryBefore;
+    getMemoryInfo(memoryBefore);
+
+    // the shapes outlive the motion states that hold them
+    ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+    std::vector<std::unique_ptr<BenchmarkMotionState>> motionStates;
+    QHash<QUuid, BenchmarkMotionState*> motionStatesByID;
+    int numDynamicBodies = 0;
+    for (const auto& value : scene["Entities"].toArray()) {
+        QJsonObject entity = value.toObject();
+        ShapeInfo info = computeShapeInfo(entity);
+        const btCollisionShape* shape = shapeManager.getShape(info);
+        if (!shape && info.getType() == SHAPE_TYPE_STATIC_MESH) {
+            // the mesh is built on a worker thread
+            uint64_t key = info.getHash();
+            QTRY_VERIFY_WITH_TIMEOUT((shape = shapeManager.getShapeByKey(key)) != nullptr, MESH_BUILD_TIMEOUT);
+        }
+        QVERIFY2(shape, qPrintable(entity["id"].toString()));
+        motionStates.emplace_back(new BenchmarkMotionState(shape, entity));
+        motionStatesByID[motionStates.back()->getObjectID()] = motionStates.back().get();
+        if (motionStates.back()->isDynamic()) {
+            ++numDynamicBodies;
+        }
+    }
+    QVERIFY(numDynamicBodies > 0);
+
+    PhysicsEngine engine(glm::vec3(0.0f));
+    engine.init();
+    // the whole scene is simulated rather than what fits the active body budget
+    engine.setMaxActiveBodies(std::max(numDynamicBodies, PhysicsEngine::DEFAULT_MAX_ACTIVE_BODIES));
+    PhysicsEngine::Transaction transaction;
+    for (const auto& motionState : motionStates) {
+        transaction.objectsToAdd.push_back(motionState.get());
+    }
+    engine.processTransaction(transaction);
+    QCOMPARE(engine.getNumCollisionObjects(), (int32_t)motionStates.size());
+
+    btDiscreteDynamicsWorld* world = engine.getDynamicsWorld();
+    std::vector<std::unique_ptr<btTypedConstraint>> constraints;
+    for (const auto& value : scene["Constraints"].toArray()) {
+        QJsonObject arguments = value.toObject();
+        BenchmarkMotionState* motionStateA = motionStatesByID.value(QUuid(arguments["entityID"].toString()));
+        BenchmarkMotionState* motionStateB = motionStatesByID.value(QUuid(arguments["otherEntityID"].toString()));
+        QVERIFY(motionStateA && motionStateB);
+        btTypedConstraint* constraint = createConstraint(arguments, motionStateA->getRigidBody(),
+                                                         motionStateB->getRigidBody());
+        QVERIFY2(constraint, qPrintable(arguments["type"].toString()));
+        constraints.emplace_back(constraint);
+        const bool DISABLE_COLLISIONS_BETWEEN_LINKED_BODIES = true;
+        world->addConstraint(constraint, DISABLE_COLLISIONS_BETWEEN_LINKED_BODIES);
+    }
+
+    btDispatcher* dispatcher = world->getDispatcher();
+    uint64_t totalUsecs = 0;
+    uint64_t maxStepUsecs = 0;
+    uint64_t totalContacts = 0;
+    uint64_t totalManifolds = 0;
+    int maxContacts = 0;
+    for (int i = 0; i < _numSteps; ++i) {
+        uint64_t start = usecTimestampNow();
+        engine.stepSimulation(PHYSICS_ENGINE_FIXED_SUBSTEP);
+        uint64_t stepUsecs = usecTimestampNow() - start;
+        totalUsecs += stepUsecs;
+        maxStepUsecs = std::max(maxStepUsecs, stepUsecs);
+
+        int numManifolds = dispatcher->getNumManifolds();
+        int numContacts = 0;
+        for (int j = 0; j < numManifolds; ++j) {
+            numContacts += dispatcher->getManifoldByIndexInternal(j)->getNumContacts();
+        }
+        totalManifolds += numManifolds;
+        totalContacts += numContacts;
+        maxContacts = std::max(maxContacts, numContacts);
+
+        // the contact events are harvested every step as the simulations do
+        engine.getCollisionEvents();
+    }
+
+    MemoryInfo memoryAfter;
+    getMemoryInfo(memoryAfter);
+
+    for (const auto& motionState : motionStates) {
+        const glm::vec3& position = motionState->getPosition();
+        QVERIFY2(!glm::any(glm::isnan(position)) && position.y > MIN_BODY_HEIGHT,
+                 qPrintable(motionState->getObjectID().toString()));
+    }
+
+    QJsonObject result;
+    result["name"] = name;
+    result["numBodies"] = (int)motionStates.size();
+    result["numDynamicBodies"] = numDynamicBodies;
+    result["numConstraints"] = (int)constraints.size();
+    result["numShapes"] = shapeManager.getNumShapes();
+    result["seconds"] = (double)totalUsecs / (double)USECS_PER_SECOND;
+    result["stepsPerSecond"] = totalUsecs > 0 ? (double)_numSteps * (double)USECS_PER_SECOND / (double)totalUsecs : 0.0;
+    result["averageStepUsecs"] = (double)totalUsecs / (double)_numSteps;
+    result["maxStepUsecs"] = (double)maxStepUsecs;
+    result["averageContacts"] = (double)totalContacts / (double)_numSteps;
+    result["maxContacts"] = maxContacts;
+    result["averageManifolds"] = (double)totalManifolds / (double)_numSteps;
+    result["numActiveBodies"] = engine.getActivationStats().numActiveBodies;
+    result["processMemoryBytes"] = (double)memoryAfter.processUsedMemoryBytes;
+    result["sceneMemoryBytes"] = (double)memoryAfter.processUsedMemoryBytes - (double)memoryBefore.processUsedMemoryBytes;
+    result["peakProcessMemoryBytes"] = (double)memoryAfter.processPeakUsedMemoryBytes;
+    _results.append(result);
+
+    for (const auto& constraint : constraints) {
+        world->removeConstraint(constraint.get());
+    }
+    constraints.clear();
+    transaction.clear();
+    for (const auto& motionState : motionStates) {
+        transaction.objectsToRemove.push_back(motionState.get());
+    }
+    engine.processTransaction(transaction);
+    motionStates.clear();
+}
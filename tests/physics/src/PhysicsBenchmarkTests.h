@@ -0,0 +1,46 @@
+//
+//  PhysicsBenchmarkTests.h
+//  tests/physics/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsBenchmarkTests_h
+#define hifi_PhysicsBenchmarkTests_h
+
+#include <QtCore/QJsonArray>
+#include <QtTest/QtTest>
+
+// Steps the recorded scenes in tests/physics/scenes headless and reports the steps per second, the contacts and the
+// memory of each as JSON, printed and written to $HIFI_PHYSICS_BENCHMARK_OUTPUT when it is set.
+//
+// The scenes are entity exports: the Entities with their id, position, rotation, dimensions, shapeType, dynamic,
+// density, gravity, velocity, angularVelocity, friction, restitution, damping and angularDamping, and a collisionMesh
+// of vertices and indices in place of the model of a static-mesh. The Constraints take the arguments of the
+// ball-socket, cone-twist and hinge actions between two entities.
+//
+// $HIFI_PHYSICS_BENCHMARK_STEPS overrides the number of steps and $HIFI_PHYSICS_BENCHMARK_SCENES the scene directory.
+class PhysicsBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void stacksBenchmark();
+    void ragdollsBenchmark();
+    void pileBenchmark();
+    void meshBenchmark();
+    void cleanupTestCase();
+
+private:
+    void runScene(const QString& name);
+
+    QString _scenesDirectory;
+    int _numSteps { 0 };
+    QJsonArray _results;
+};
+
+#endif // hifi_PhysicsBenchmarkTests_h
@@ -13,6 +13,7 @@
 
 #include <iostream>
 
+#include <BakedBVH.h>
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +245,74 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::addBakedStaticMeshShape() {
+    // a grid of triangles, with the bvh over them baked the way BuildCollisionShapesTask does
+    const int GRID_SIZE = 8;
+    QVector<glm::vec3> points;
+    QVector<int32_t> indices;
+    for (int i = 0; i <= GRID_SIZE; ++i) {
+        for (int j = 0; j <= GRID_SIZE; ++j) {
+            points.push_back(glm::vec3((float)i, 0.1f * (float)((i * j) % 3), (float)j));
+        }
+    }
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            int corner = i * (GRID_SIZE + 1) + j;
+            indices << corner << corner + 1 << corner + GRID_SIZE + 1;
+            indices << corner + 1 << corner + GRID_SIZE + 2 << corner + GRID_SIZE + 1;
+        }
+    }
+    btIndexedMesh indexedMesh;
+    indexedMesh.m_numTriangles = indices.size() / 3;
+    indexedMesh.m_triangleIndexBase = reinterpret_cast<const unsigned char*>(indices.constData());
+    indexedMesh.m_triangleIndexStride = 3 * sizeof(int32_t);
+    indexedMesh.m_numVertices = points.size();
+    indexedMesh.m_vertexBase = reinterpret_cast<const unsigned char*>(points.constData());
+    indexedMesh.m_vertexStride = sizeof(glm::vec3);
+    btTriangleIndexVertexArray meshInterface;
+    meshInterface.addIndexedMesh(indexedMesh, PHY_INTEGER);
+    btBvhTriangleMeshShape bakedShape(&meshInterface, true);
+    QByteArray bvh = BakedBVH::serialize(*bakedShape.getOptimizedBvh());
+    QVERIFY(!bvh.isEmpty());
+
+    // the baked mesh is scaled and moved, so the shape is a compound of the scaled mesh
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3((float)GRID_SIZE), "baked");
+    info.setPointCollection(ShapeInfo::PointCollection({ points }));
+    info.getTriangleIndices() = indices;
+    glm::vec3 scale(2.0f, 1.0f, 2.0f);
+    glm::vec3 translation(1.0f, 0.0f, 0.0f);
+    info.setBakedMesh(bvh, scale, glm::quat(), translation);
+
+    // it is created right away rather than on a worker thread
+    ShapeManager shapeManager;
+    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)0);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    const btCompoundShape* compoundShape = static_cast<const btCompoundShape*>(shape);
+    QCOMPARE(compoundShape->getNumChildShapes(), 1);
+    QCOMPARE(compoundShape->getChildShape(0)->getShapeType(), (int)SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE);
+
+    // it covers the scaled and moved triangles
+    btTransform identity;
+    identity.setIdentity();
+    btVector3 minCorner, maxCorner;
+    shape->getAabb(identity, minCorner, maxCorner);
+    QVERIFY(minCorner.getX() <= translation.x + 0.01f && maxCorner.getX() >= translation.x + scale.x * GRID_SIZE - 0.01f);
+    QVERIFY(maxCorner.getZ() >= scale.z * GRID_SIZE - 0.01f);
+
+    // a bvh baked elsewhere, or damaged, is built again instead
+    ShapeInfo otherInfo = info;
+    otherInfo.setBakedMesh(QByteArray(64, 'x'), glm::vec3(1.0f), glm::quat(), glm::vec3(0.0f));
+    const btCollisionShape* otherShape = shapeManager.getShape(otherInfo);
+    QVERIFY(otherShape != nullptr);
+    QCOMPARE(otherShape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    QCOMPARE(shapeManager.getNumShapes(), 2);
+
+    shapeManager.releaseShape(shape);
+    shapeManager.releaseShape(otherShape);
+    shapeManager.collectGarbage();
+    QCOMPARE(shapeManager.getNumShapes(), 0);
+}
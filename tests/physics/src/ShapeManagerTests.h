@@ -25,6 +25,7 @@ private slots:
     void addCylinderShape();
     void addCapsuleShape();
     void addCompoundShape();
+    void addBakedStaticMeshShape();
 };
 
 #endif // hifi_ShapeManagerTests_h
@@ -14,6 +14,8 @@
 #pragma clang diagnostic ignored "-Wunused-private-field"
 #endif
 
+#include <algorithm>
+
 #include <QtGlobal>
 #include <QtTest/QtTest>
 #include <QtCore/QTemporaryFile>
@@ -119,10 +121,105 @@ void testClipOrdering() {
     Q_UNUSED(lastFrameTimeOffset); // FIXME - Unix build not yet upgraded to Qt 5.5.1 we can remove this once it is
 }
 
+void testFrameIndex() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough frames for the index to take more than one frame
+    static const int NUM_FRAMES = 5000;
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, QByteArray::number(i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == NUM_FRAMES);
+
+    // a second clip of the file shares the mapping of the first
+    auto otherClip = Clip::fromFile(fileName);
+    QVERIFY(otherClip != Clip::Pointer());
+    QVERIFY(otherClip->frameCount() == NUM_FRAMES);
+
+    writeClip->seek(0);
+    readClip->seek(0);
+    otherClip->seek(0);
+    for (auto writeFrame = writeClip->nextFrame(); writeFrame; writeFrame = writeClip->nextFrame()) {
+        auto readFrame = readClip->nextFrame();
+        auto otherFrame = otherClip->nextFrame();
+        QVERIFY(readFrame && otherFrame);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+        QVERIFY(otherFrame->data == writeFrame->data);
+    }
+}
+
+// stores frames reversed, to tell that the codec was used
+class ReversingCodec : public FrameCodec {
+public:
+    QByteArray encode(const QByteArray& data) override { return reversed(data); }
+    QByteArray decode(const QByteArray& encoded) override { return reversed(encoded); }
+
+private:
+    static QByteArray reversed(const QByteArray& data) {
+        QByteArray result = data;
+        std::reverse(result.begin(), result.end());
+        return result;
+    }
+};
+
+void testFrameEncoding() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    auto codecFrameType = Frame::registerFrameType(CODEC_TEST_NAME);
+    Frame::registerFrameCodec(CODEC_TEST_NAME, "reverse", [] { return std::make_shared<ReversingCodec>(); });
+
+    // frames that change a little from one to the next, as avatar frames do, interleaved with frames of a codec
+    static const int NUM_FRAMES = 1000;
+    auto writeClip = Clip::newClip();
+    QByteArray data(256, 'a');
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        data[i % data.size()] = (char)i;
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)i, data));
+        writeClip->addFrame(std::make_shared<Frame>(codecFrameType, (float)i, QByteArray::number(i)));
+    }
+    Clip::toFile(fileName, writeClip);
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == 2 * NUM_FRAMES);
+
+    writeClip->seek(0);
+    for (auto writeFrame = writeClip->nextFrame(); writeFrame; writeFrame = writeClip->nextFrame()) {
+        auto readFrame = readClip->nextFrame();
+        QVERIFY(readFrame);
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+
+    // seeking lands between keyframes
+    writeClip->seekFrameTime(NUM_FRAMES / 2 + 1);
+    readClip->seekFrameTime(NUM_FRAMES / 2 + 1);
+    QVERIFY(readClip->peekFrame() && writeClip->peekFrame());
+    QVERIFY(readClip->peekFrame()->data == writeClip->peekFrame()->data);
+}
+
 int main(int, const char**) {
     setupHifiApplication("Recording Test");
 
     testFrameTypeRegistration();
     testFilePersist();
     testClipOrdering();
+    testFrameIndex();
+    testFrameEncoding();
 }
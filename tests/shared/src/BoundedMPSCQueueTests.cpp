@@ -0,0 +1,104 @@
+//
+//  BoundedMPSCQueueTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BoundedMPSCQueueTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <shared/BoundedMPSCQueue.h>
+
+QTEST_MAIN(BoundedMPSCQueueTests)
+
+void BoundedMPSCQueueTests::fifoTest() {
+    BoundedMPSCQueue<int> queue(5);
+    QCOMPARE((int)queue.capacity(), 8);
+
+    int value;
+    QVERIFY(!queue.tryPop(value));
+
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(!queue.push(i));
+    }
+    for (int i = 0; i < 8; ++i) {
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.tryPop(value));
+    QCOMPARE((int)queue.getNumDropped(), 0);
+}
+
+void BoundedMPSCQueueTests::dropOldestTest() {
+    BoundedMPSCQueue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        queue.push(i);
+    }
+    QVERIFY(queue.push(4));
+    QVERIFY(queue.push(5));
+    QCOMPARE((int)queue.getNumDropped(), 2);
+
+    int value;
+    for (int i = 2; i < 6; ++i) {
+        QVERIFY(queue.tryPop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!queue.tryPop(value));
+}
+
+void BoundedMPSCQueueTests::concurrentProducersTest() {
+    const int NUM_PRODUCERS = 4;
+    const int NUM_ITEMS_PER_PRODUCER = 100000;
+    BoundedMPSCQueue<int> queue(64);
+
+    std::atomic<bool> producing { true };
+    int numPopped = 0;
+    bool inOrder = true;
+
+    std::thread consumer([&] {
+        std::vector<int> lastPopped(NUM_PRODUCERS, -1);
+        auto check = [&](int value) {
+            int producer = value / NUM_ITEMS_PER_PRODUCER;
+            int item = value % NUM_ITEMS_PER_PRODUCER;
+            inOrder = inOrder && item > lastPopped[producer];
+            lastPopped[producer] = item;
+            ++numPopped;
+        };
+
+        int value;
+        while (producing) {
+            if (queue.tryPop(value)) {
+                check(value);
+            }
+        }
+        while (queue.tryPop(value)) {
+            check(value);
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 0; i < NUM_ITEMS_PER_PRODUCER; ++i) {
+                queue.push(producer * NUM_ITEMS_PER_PRODUCER + i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    producing = false;
+    consumer.join();
+
+    // every item was either popped or counted as dropped, and each producer's items came out in order
+    QVERIFY(inOrder);
+    QCOMPARE(numPopped + (int)queue.getNumDropped(), NUM_PRODUCERS * NUM_ITEMS_PER_PRODUCER);
+}
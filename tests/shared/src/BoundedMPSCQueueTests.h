@@ -0,0 +1,25 @@
+//
+//  BoundedMPSCQueueTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BoundedMPSCQueueTests_h
+#define hifi_BoundedMPSCQueueTests_h
+
+#include <QtTest/QtTest>
+
+class BoundedMPSCQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    void fifoTest();
+    void dropOldestTest();
+    void concurrentProducersTest();
+};
+
+#endif // hifi_BoundedMPSCQueueTests_h
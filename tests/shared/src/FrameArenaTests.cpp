@@ -0,0 +1,56 @@
+//
+//  FrameArenaTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameArenaTests.h"
+
+#include <shared/FrameArena.h>
+
+QTEST_MAIN(FrameArenaTests)
+
+void FrameArenaTests::alignmentTest() {
+    FrameArena arena(256);
+    arena.allocate(1, 1);
+    void* pointer = arena.allocate(sizeof(double), alignof(double));
+    QCOMPARE((int)(reinterpret_cast<uintptr_t>(pointer) % alignof(double)), 0);
+
+    // larger than a block
+    void* large = arena.allocate(1000, 64);
+    QCOMPARE((int)(reinterpret_cast<uintptr_t>(large) % 64), 0);
+
+    FrameArena::Stats stats = arena.harvestStats();
+    QCOMPARE((int)stats.numAllocations, 3);
+    QCOMPARE((int)stats.numBytesAllocated, 1 + (int)sizeof(double) + 1000);
+    QCOMPARE((int)stats.numHeapAllocations, 2);
+}
+
+void FrameArenaTests::steadyStateTest() {
+    FrameArena arena(256);
+    const int NUM_FRAMES = 4;
+    for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+        arena.reset();
+        FrameArenaVector<int> values { FrameArenaAllocator<int>(arena) };
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        QCOMPARE(values[999], 999);
+
+        // the first frame grows the arena, the second starts in one block that holds it all, and the rest reuse it
+        FrameArena::Stats stats = arena.harvestStats();
+        QVERIFY(stats.numAllocations > 0);
+        if (frame == 0) {
+            QVERIFY(stats.numHeapAllocations > 1);
+        } else if (frame == 1) {
+            QCOMPARE((int)stats.numHeapAllocations, 1);
+        } else {
+            QCOMPARE((int)stats.numHeapAllocations, 0);
+        }
+    }
+}
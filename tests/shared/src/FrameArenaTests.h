@@ -0,0 +1,24 @@
+//
+//  FrameArenaTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameArenaTests_h
+#define hifi_FrameArenaTests_h
+
+#include <QtTest/QtTest>
+
+class FrameArenaTests : public QObject {
+    Q_OBJECT
+private slots:
+    void alignmentTest();
+    void steadyStateTest();
+};
+
+#endif // hifi_FrameArenaTests_h
@@ -105,6 +105,101 @@ void GLMHelpersTests::testSixByteOrientationCompression() {
     testQuatCompression(-(ROT_Z_30 * ROT_X_90 * ROT_Y_180));
 }
 
+void GLMHelpersTests::testBitPackedCompression() {
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+    const std::vector<glm::quat> QUATS = { ROT_X_90, -ROT_Y_180, ROT_Z_30, ROT_X_90 * ROT_Z_30, -(ROT_Y_180 * ROT_Z_30) };
+    const std::vector<glm::vec3> VECS = { glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(-0.25f, 0.5f, 0.999f), glm::vec3(0.0f) };
+
+    for (int bits = 8; bits <= 15; ++bits) {
+        // everything is packed back to back so each value lands at a different bit alignment
+        uint8_t buffer[64] = { 0 };
+        int bitOffset = 0;
+        for (const auto& quat : QUATS) {
+            bitOffset += packOrientationQuatToBits(buffer, bitOffset, quat, bits);
+        }
+        for (const auto& vec : VECS) {
+            bitOffset += packUnitVec3ToBits(buffer, bitOffset, vec, bits);
+        }
+        QCOMPARE(bitOffset, (int)(QUATS.size() * (2 + 3 * bits) + VECS.size() * 3 * bits));
+
+        const float MAX_QUAT_COMPONENT_ERROR = 0.70710678f / (float)((1 << bits) - 1) + 1.0e-5f;
+        const float MAX_VEC_COMPONENT_ERROR = 0.5f / (float)((1 << (bits - 1)) - 1) + 1.0e-5f;
+
+        bitOffset = 0;
+        for (const auto& quat : QUATS) {
+            glm::quat q;
+            bitOffset += unpackOrientationQuatFromBits(buffer, bitOffset, q, bits);
+            if (glm::dot(q, quat) < 0.0f) {
+                q = -q;
+            }
+            QCOMPARE_WITH_ABS_ERROR(q.x, quat.x, MAX_QUAT_COMPONENT_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(q.y, quat.y, MAX_QUAT_COMPONENT_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(q.z, quat.z, MAX_QUAT_COMPONENT_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(q.w, quat.w, MAX_QUAT_COMPONENT_ERROR);
+        }
+        for (const auto& vec : VECS) {
+            glm::vec3 v;
+            bitOffset += unpackUnitVec3FromBits(buffer, bitOffset, v, bits);
+            QCOMPARE_WITH_ABS_ERROR(v.x, vec.x, MAX_VEC_COMPONENT_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(v.y, vec.y, MAX_VEC_COMPONENT_ERROR);
+            QCOMPARE_WITH_ABS_ERROR(v.z, vec.z, MAX_VEC_COMPONENT_ERROR);
+        }
+    }
+}
+
+void GLMHelpersTests::testBatchPacking() {
+    struct Joint {
+        glm::quat rotation;
+        glm::vec3 translation;
+        bool flag;
+    };
+
+    // an odd count so both the four-wide path and the tail are covered
+    const int NUM_JOINTS = 23;
+    std::vector<Joint> joints(NUM_JOINTS);
+    std::vector<Joint> others(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        float angle = 0.37f * i;
+        joints[i].rotation = glm::angleAxis(angle, glm::normalize(glm::vec3(sinf(angle), 1.0f, cosf(3.0f * angle))));
+        joints[i].translation = glm::vec3(sinf(angle), -2.0f * cosf(angle), 0.1f * i);
+        others[i] = joints[i];
+        if (i % 3 == 0) {
+            others[i].rotation = glm::angleAxis(0.1f, Vectors::UNIT_X) * joints[i].rotation;
+            others[i].translation += glm::vec3(0.0f, 0.01f, 0.0f);
+        }
+    }
+
+    const int PACKED_SIZE = 6;
+    const float DIVISOR = 3.0f;
+    const int RADIX = 14;
+    std::vector<uint8_t> batch(NUM_JOINTS * PACKED_SIZE);
+    std::vector<uint8_t> single(NUM_JOINTS * PACKED_SIZE);
+
+    packOrientationQuatsToSixBytes(batch.data(), &joints[0].rotation, sizeof(Joint), NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        packOrientationQuatToSixBytes(single.data() + i * PACKED_SIZE, joints[i].rotation);
+    }
+    QCOMPARE(batch, single);
+
+    packFloatVec3sToSignedTwoByteFixed(batch.data(), &joints[0].translation, sizeof(Joint), NUM_JOINTS, DIVISOR, RADIX);
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        packFloatVec3ToSignedTwoByteFixed(single.data() + i * PACKED_SIZE, joints[i].translation / DIVISOR, RADIX);
+    }
+    QCOMPARE(batch, single);
+
+    std::vector<uint8_t> differs(NUM_JOINTS);
+    findQuatsDifferingByDot(&joints[0].rotation, &others[0].rotation, sizeof(Joint), NUM_JOINTS, 0.9999f, differs.data());
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        QCOMPARE((bool)differs[i], i % 3 == 0);
+    }
+    findVec3sDifferingByDistance(&joints[0].translation, &others[0].translation, sizeof(Joint), NUM_JOINTS, 0.005f, differs.data());
+    for (int i = 0; i < NUM_JOINTS; ++i) {
+        QCOMPARE((bool)differs[i], i % 3 == 0);
+    }
+}
+
 #define LOOPS 500000
 
 void GLMHelpersTests::testSimd() {
@@ -20,6 +20,8 @@ class GLMHelpersTests : public QObject {
 private slots:
     void testEulerDecomposition();
     void testSixByteOrientationCompression();
+    void testBitPackedCompression();
+    void testBatchPacking();
     void testSimd();
     void testGenerateBasisVectors();
     void roundPerf();
@@ -0,0 +1,102 @@
+//
+//  GzipTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GzipTests.h"
+
+#include <QBuffer>
+
+#include <Gzip.h>
+
+QTEST_MAIN(GzipTests)
+
+static QByteArray makeContent(int size) {
+    // compressible, but not trivially
+    QByteArray content;
+    content.reserve(size);
+    uint32_t seed = 12345;
+    while (content.size() < size) {
+        seed = seed * 1664525 + 1013904223;
+        content.append("{ \"name\": \"entity\", \"position\": " + QByteArray::number(seed % 1000) + " },\n");
+    }
+    content.resize(size);
+    return content;
+}
+
+static bool streamGzip(QByteArray source, QByteArray& destination) {
+    QBuffer sourceBuffer(&source);
+    QBuffer destinationBuffer(&destination);
+    sourceBuffer.open(QIODevice::ReadOnly);
+    destinationBuffer.open(QIODevice::WriteOnly);
+    return gzip(sourceBuffer, destinationBuffer);
+}
+
+static bool streamGunzip(QByteArray source, QByteArray& destination) {
+    QBuffer sourceBuffer(&source);
+    QBuffer destinationBuffer(&destination);
+    sourceBuffer.open(QIODevice::ReadOnly);
+    destinationBuffer.open(QIODevice::WriteOnly);
+    return gunzip(sourceBuffer, destinationBuffer);
+}
+
+void GzipTests::roundTripTest() {
+    QByteArray content = makeContent(100 * 1000);
+    QByteArray compressed;
+    QByteArray decompressed;
+    QVERIFY(gzip(content, compressed));
+    QVERIFY(compressed.size() < content.size());
+    QVERIFY(gunzip(compressed, decompressed));
+    QCOMPARE(decompressed, content);
+
+    QVERIFY(gzip(QByteArray(), compressed));
+    QVERIFY(compressed.isEmpty());
+}
+
+void GzipTests::streamingTest() {
+    // the streaming and in-memory versions read each other's content
+    QByteArray content = makeContent(300 * 1000 + 7);
+    QByteArray compressed;
+    QByteArray decompressed;
+    QVERIFY(streamGzip(content, compressed));
+    QVERIFY(gunzip(compressed, decompressed));
+    QCOMPARE(decompressed, content);
+
+    QVERIFY(gzip(content, compressed));
+    decompressed.clear();
+    QVERIFY(streamGunzip(compressed, decompressed));
+    QCOMPARE(decompressed, content);
+}
+
+void GzipTests::largeContentTest() {
+    // large enough to be compressed in blocks on several threads, into the one stream
+    QByteArray content = makeContent(9 * 1024 * 1024 + 123);
+    QByteArray compressed;
+    QByteArray decompressed;
+    QVERIFY(streamGzip(content, compressed));
+    QVERIFY(compressed.size() < content.size() / 2);
+    QVERIFY(gunzip(compressed, decompressed));
+    QCOMPARE(decompressed.size(), content.size());
+    QCOMPARE(decompressed, content);
+
+    QVERIFY(gzip(content, compressed));
+    decompressed.clear();
+    QVERIFY(streamGunzip(compressed, decompressed));
+    QCOMPARE(decompressed, content);
+}
+
+void GzipTests::corruptContentTest() {
+    QByteArray content = makeContent(50 * 1000);
+    QByteArray compressed;
+    QByteArray decompressed;
+    QVERIFY(gzip(content, compressed));
+
+    QVERIFY(!streamGunzip(content, decompressed));
+    QVERIFY(!streamGunzip(compressed.left(compressed.size() / 2), decompressed));
+}
@@ -0,0 +1,26 @@
+//
+//  GzipTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GzipTests_h
+#define hifi_GzipTests_h
+
+#include <QtTest/QtTest>
+
+class GzipTests : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripTest();
+    void streamingTest();
+    void largeContentTest();
+    void corruptContentTest();
+};
+
+#endif // hifi_GzipTests_h
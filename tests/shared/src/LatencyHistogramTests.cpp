@@ -0,0 +1,75 @@
+//
+//  LatencyHistogramTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogramTests.h"
+
+#include <shared/LatencyHistogram.h>
+
+QTEST_MAIN(LatencyHistogramTests)
+
+void LatencyHistogramTests::bucketBoundsTest() {
+    // every value lands in a bucket that holds it, and is known to within an eighth of itself
+    int previousBucket = -1;
+    for (uint64_t value = 0; value < (1ULL << LatencyHistogram::MAX_VALUE_BITS); value += value < 1000 ? 1 : value / 997) {
+        int bucket = LatencyHistogram::bucketFor(value);
+        QVERIFY(bucket >= previousBucket);
+        QVERIFY(value <= LatencyHistogram::bucketUpperBound(bucket));
+        if (bucket > 0) {
+            QVERIFY(value > LatencyHistogram::bucketUpperBound(bucket - 1));
+        }
+        QVERIFY(LatencyHistogram::bucketUpperBound(bucket) - value <= value / LatencyHistogram::SUB_BUCKETS_PER_OCTAVE);
+        previousBucket = bucket;
+    }
+
+    // values too large for the histogram are kept in the last bucket
+    QCOMPARE(LatencyHistogram::bucketFor(1ULL << 40), LatencyHistogram::NUM_BUCKETS - 1);
+}
+
+void LatencyHistogramTests::percentileTest() {
+    LatencyHistogram histogram;
+    QCOMPARE((int)histogram.getPercentile(99.0), 0);
+
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        histogram.record(value);
+    }
+    QCOMPARE((int)histogram.getCount(), 1000);
+    QCOMPARE((int)histogram.getMax(), 1000);
+    QCOMPARE(histogram.getMean(), 500.5);
+
+    uint64_t median = histogram.getPercentile(50.0);
+    QVERIFY(median >= 500 && median <= 500 + 500 / LatencyHistogram::SUB_BUCKETS_PER_OCTAVE);
+
+    // the tail is reported no higher than the largest value seen
+    QCOMPARE((int)histogram.getPercentile(99.9), 1000);
+    QCOMPARE((int)histogram.getPercentile(100.0), 1000);
+
+    histogram.reset();
+    QCOMPARE((int)histogram.getCount(), 0);
+    QCOMPARE((int)histogram.getMax(), 0);
+}
+
+void LatencyHistogramTests::mergeTest() {
+    LatencyHistogram fast;
+    LatencyHistogram slow;
+    for (int i = 0; i < 99; ++i) {
+        fast.record(100);
+    }
+    slow.record(50000);
+
+    LatencyHistogram merged;
+    merged += fast;
+    merged += slow;
+
+    QCOMPARE((int)merged.getCount(), 100);
+    QCOMPARE((int)merged.getMax(), 50000);
+    QVERIFY(merged.getPercentile(50.0) <= 100 + 100 / LatencyHistogram::SUB_BUCKETS_PER_OCTAVE);
+    QCOMPARE((int)merged.getPercentile(100.0), 50000);
+}
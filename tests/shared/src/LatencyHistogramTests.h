@@ -0,0 +1,25 @@
+//
+//  LatencyHistogramTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LatencyHistogramTests_h
+#define hifi_LatencyHistogramTests_h
+
+#include <QtTest/QtTest>
+
+class LatencyHistogramTests : public QObject {
+    Q_OBJECT
+private slots:
+    void bucketBoundsTest();
+    void percentileTest();
+    void mergeTest();
+};
+
+#endif // hifi_LatencyHistogramTests_h
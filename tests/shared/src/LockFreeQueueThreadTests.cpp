@@ -0,0 +1,96 @@
+//
+//  LockFreeQueueThreadTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LockFreeQueueThreadTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <LockFreeQueueThread.h>
+
+QTEST_MAIN(LockFreeQueueThreadTests)
+
+// records the items it is given, only ever from one thread at a time
+class RecordingQueueThread : public LockFreeQueueThread<int> {
+public:
+    RecordingQueueThread(size_t capacity) : LockFreeQueueThread<int>(capacity) {}
+
+    std::vector<int> items;
+    int numBatches { 0 };
+
+protected:
+    bool processQueueItems(const int* batch, size_t count) override {
+        items.insert(items.end(), batch, batch + count);
+        ++numBatches;
+        return true;
+    }
+};
+
+void LockFreeQueueThreadTests::nonThreadedTest() {
+    RecordingQueueThread thread(4);
+    thread.initialize(false);
+
+    // more than fit in the ring, so that some spill
+    for (int i = 0; i < 10; ++i) {
+        thread.queueItem(i);
+    }
+    thread.threadRoutine();
+
+    QCOMPARE((int)thread.items.size(), 10);
+    for (int i = 0; i < 10; ++i) {
+        QCOMPARE(thread.items[i], i);
+    }
+    QCOMPARE(thread.numBatches, 1);
+
+    auto stats = thread.getStats();
+    QCOMPARE((int)stats.numQueued, 10);
+    QCOMPARE((int)stats.numProcessed, 10);
+    QCOMPARE((int)stats.highWaterMark, 10);
+    QCOMPARE((int)stats.numSpilled, 6);
+    thread.terminate();
+}
+
+void LockFreeQueueThreadTests::concurrentProducersTest() {
+    const int NUM_PRODUCERS = 4;
+    const int NUM_ITEMS_PER_PRODUCER = 100000;
+    RecordingQueueThread thread(64);
+    thread.initialize(true);
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < NUM_PRODUCERS; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 0; i < NUM_ITEMS_PER_PRODUCER; ++i) {
+                thread.queueItem(producer * NUM_ITEMS_PER_PRODUCER + i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    thread.waitIdle();
+    thread.terminate();
+
+    // nothing was dropped, and each producer's items came out in order
+    QCOMPARE((int)thread.items.size(), NUM_PRODUCERS * NUM_ITEMS_PER_PRODUCER);
+    std::vector<int> lastItems(NUM_PRODUCERS, -1);
+    bool inOrder = true;
+    for (int value : thread.items) {
+        int producer = value / NUM_ITEMS_PER_PRODUCER;
+        int item = value % NUM_ITEMS_PER_PRODUCER;
+        inOrder = inOrder && item == lastItems[producer] + 1;
+        lastItems[producer] = item;
+    }
+    QVERIFY(inOrder);
+
+    auto stats = thread.getStats();
+    QCOMPARE(stats.numProcessed, stats.numQueued);
+    QVERIFY(stats.highWaterMark > 0);
+}
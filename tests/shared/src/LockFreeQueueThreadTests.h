@@ -0,0 +1,24 @@
+//
+//  LockFreeQueueThreadTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LockFreeQueueThreadTests_h
+#define hifi_LockFreeQueueThreadTests_h
+
+#include <QtTest/QtTest>
+
+class LockFreeQueueThreadTests : public QObject {
+    Q_OBJECT
+private slots:
+    void nonThreadedTest();
+    void concurrentProducersTest();
+};
+
+#endif // hifi_LockFreeQueueThreadTests_h
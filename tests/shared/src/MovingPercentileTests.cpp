@@ -39,6 +39,21 @@ void MovingPercentileTests::testRunningMedian() {
         testRunningMedianForN(n);
 }
 
+void MovingPercentileTests::testReset() {
+    MovingPercentile movingMax(10, 1.0f);
+    for (int s = 0; s < 10; ++s) {
+        movingMax.updatePercentile(100 + s);
+    }
+    QCOMPARE(movingMax.getValueAtPercentile(), (qint64)109);
+
+    // the samples from before the reset are forgotten
+    movingMax.reset();
+    QCOMPARE(movingMax.getValueAtPercentile(), (qint64)0);
+    movingMax.updatePercentile(5);
+    movingMax.updatePercentile(3);
+    QCOMPARE(movingMax.getValueAtPercentile(), (qint64)5);
+}
+
 
 int64_t MovingPercentileTests::random() {
     return ((int64_t) rand() << 48) ^
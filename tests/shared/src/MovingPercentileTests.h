@@ -22,6 +22,7 @@ private slots:
     void testRunningMin ();
     void testRunningMax ();
     void testRunningMedian ();
+    void testReset ();
 
 private:
     // Utilities and helper functions
@@ -0,0 +1,100 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <NumericalConstants.h>
+#include <SpatialParentFinder.h>
+#include <SpatiallyNestable.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.0001f;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        auto found = nestables.find(parentID);
+        success = found != nestables.end();
+        return success ? found.value() : SpatiallyNestableWeakPointer();
+    }
+
+    QHash<QUuid, SpatiallyNestableWeakPointer> nestables;
+};
+
+static SpatiallyNestablePointer makeNestable(const glm::vec3& localPosition, const SpatiallyNestablePointer& parent = nullptr) {
+    auto nestable = std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid());
+    auto finder = DependencyManager::get<SpatialParentFinder>().staticCast<TestParentFinder>();
+    finder->nestables[nestable->getID()] = nestable;
+    if (parent) {
+        nestable->setParentID(parent->getID());
+    }
+    nestable->setLocalPosition(localPosition);
+    return nestable;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::set<SpatialParentFinder, TestParentFinder>();
+}
+
+void SpatiallyNestableTests::cachedTransformTest() {
+    auto parent = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto child = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f), parent);
+
+    // the second read comes from the cache, and agrees with the first
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f), EPSILON);
+
+    child->setLocalPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 2.0f, 0.0f), EPSILON);
+
+    child->setWorldPosition(glm::vec3(3.0f, 3.0f, 3.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getLocalPosition(), glm::vec3(2.0f, 3.0f, 3.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(3.0f, 3.0f, 3.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::ancestorMovedTest() {
+    auto grandparent = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto parent = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f), grandparent);
+    auto child = makeNestable(glm::vec3(0.0f, 0.0f, 1.0f), parent);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 1.0f), EPSILON);
+
+    // a move of the root reaches the cached transforms all the way down
+    grandparent->setWorldPosition(glm::vec3(5.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(parent->getWorldPosition(), glm::vec3(5.0f, 1.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(5.0f, 1.0f, 1.0f), EPSILON);
+
+    grandparent->setWorldOrientation(glm::angleAxis(PI, glm::vec3(0.0f, 0.0f, 1.0f)));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(5.0f, -1.0f, 1.0f), EPSILON);
+
+    // and so does a change of scale
+    grandparent->setSNScale(glm::vec3(2.0f));
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(5.0f, -2.0f, 2.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::reparentTest() {
+    auto first = makeNestable(glm::vec3(1.0f, 0.0f, 0.0f));
+    auto second = makeNestable(glm::vec3(0.0f, 0.0f, 4.0f));
+    auto child = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f), first);
+    auto grandchild = makeNestable(glm::vec3(0.0f, 1.0f, 0.0f), child);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(1.0f, 2.0f, 0.0f), EPSILON);
+
+    // the local transforms stay as they were, relative to the new parent
+    child->setParentID(second->getID());
+    QCOMPARE_WITH_ABS_ERROR(child->getWorldPosition(), glm::vec3(0.0f, 1.0f, 4.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(0.0f, 2.0f, 4.0f), EPSILON);
+
+    child->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(grandchild->getWorldPosition(), glm::vec3(0.0f, 2.0f, 0.0f), EPSILON);
+}
@@ -75,3 +75,21 @@ void StorageTests::testConversion() {
         QCOMPARE(fileInfo.size(), (qint64)newSize);
     }
 }
+
+void StorageTests::testFileViews() {
+    StoragePointer memoryPointer = std::make_shared<MemoryStorage>(_testData.size(), _testData.data());
+    StoragePointer viewPointer;
+    {
+        // a view keeps its file mapped once nothing else does
+        auto filePointer = memoryPointer->toFileStorage(_testFile);
+        viewPointer = filePointer->createView(100, 900);
+    }
+    QCOMPARE((bool)*viewPointer, true);
+    QCOMPARE(viewPointer->size(), (size_t)100);
+
+    // prefetching ranges in and past the view doesn't change what it reads
+    viewPointer->prefetch();
+    viewPointer->prefetch(50, 1000);
+    viewPointer->prefetch(100);
+    QCOMPARE(memcmp(_testData.data() + 900, viewPointer->data(), viewPointer->size()), 0);
+}
@@ -10,8 +10,13 @@
 
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
 
 #include <Profile.h>
+#include <TraceRecorder.h>
 
 #include <NumericalConstants.h>
 #include <test-utils/QTestExtensions.h>
@@ -45,3 +50,48 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testTraceRecorder() {
+    const size_t EVENTS_PER_THREAD = 256;
+    const int NUM_EVENTS = 1000;
+
+    tracing::TraceRecorder recorder;
+    recorder.start(10.0f, EVENTS_PER_THREAD);
+    recorder.setThreadName("TraceTests");
+    for (int i = 0; i < NUM_EVENTS; ++i) {
+        recorder.record(trace_test(), "TestCounter", tracing::Counter, tracing::Tracer::now(),
+            tracing::TraceRecorder::counterToValue(i));
+    }
+    recorder.stop();
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString dumpFilename = dir.filePath("testTrace.hftrace");
+    const QString jsonFilename = dir.filePath("testTrace.json");
+    QVERIFY(recorder.dump(dumpFilename, "test"));
+    QVERIFY(tracing::TraceRecorder::convertToJson(dumpFilename, jsonFilename));
+
+    QFile jsonFile(jsonFilename);
+    QVERIFY(jsonFile.open(QIODevice::ReadOnly));
+    QJsonParseError error;
+    auto document = QJsonDocument::fromJson(jsonFile.readAll(), &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+    QVERIFY(document.isArray());
+
+    // only the newest events fit in the ring, oldest first
+    std::vector<double> values;
+    bool hasThreadName = false;
+    for (const auto& value : document.array()) {
+        auto event = value.toObject();
+        if (event["ph"].toString() == "M") {
+            hasThreadName = hasThreadName || event["args"].toObject()["name"].toString() == "TraceTests";
+        } else if (event["name"].toString() == "TestCounter") {
+            QCOMPARE(event["cat"].toString(), QString("trace.test"));
+            values.push_back(event["args"].toObject()["TestCounter"].toDouble());
+        }
+    }
+    QVERIFY(hasThreadName);
+    QCOMPARE(values.size(), EVENTS_PER_THREAD);
+    QCOMPARE(values.front(), (double)(NUM_EVENTS - EVENTS_PER_THREAD));
+    QCOMPARE(values.back(), (double)(NUM_EVENTS - 1));
+}
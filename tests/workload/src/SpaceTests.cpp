@@ -115,6 +115,83 @@ void SpaceTests::testOverlaps() {
 #endif
 }
 
+static workload::View makeView(const glm::vec3& origin, float r1, float r2, float r3) {
+    workload::View view;
+    view.origin = origin;
+    view.regions[workload::Region::R1] = workload::Sphere(origin, r1);
+    view.regions[workload::Region::R2] = workload::Sphere(origin, r2);
+    view.regions[workload::Region::R3] = workload::Sphere(origin, r3);
+    return view;
+}
+
+static void addProxies(workload::Space& space, const std::vector<workload::Sphere>& spheres) {
+    workload::Transaction transaction;
+    for (const auto& sphere : spheres) {
+        transaction.reset(space.allocateID(), sphere, workload::Owner());
+    }
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+}
+
+void SpaceTests::testCategorize() {
+    const float WIDTH = 100.0f;
+    const uint32_t NUM_PROXIES = 1001; // not a multiple of 4, so some are classified one at a time
+    std::vector<workload::Sphere> spheres;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        spheres.push_back(workload::Sphere(WIDTH * (2.0f * (float)rand() / (float)RAND_MAX - 1.0f),
+                                           WIDTH * (2.0f * (float)rand() / (float)RAND_MAX - 1.0f),
+                                           WIDTH * (2.0f * (float)rand() / (float)RAND_MAX - 1.0f),
+                                           (float)rand() / (float)RAND_MAX));
+    }
+
+    workload::Space space;
+    addProxies(space, spheres);
+    workload::Views views { makeView(glm::vec3(0.0f), 10.0f, 30.0f, 60.0f),
+                            makeView(glm::vec3(50.0f, 0.0f, 0.0f), 5.0f, 20.0f, 40.0f) };
+    space.setViews(views);
+
+    std::vector<workload::Space::Change> changes;
+    space.categorizeAndGetChanges(changes);
+    // every proxy leaves UNKNOWN on the first pass
+    QCOMPARE((uint32_t)changes.size(), NUM_PROXIES);
+
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        uint8_t expected = workload::Region::R4;
+        for (const auto& view : views) {
+            for (uint8_t k = 0; k < expected; ++k) {
+                float touchDistance = spheres[i].w + view.regions[k].w;
+                glm::vec3 offset = glm::vec3(spheres[i]) - glm::vec3(view.regions[k]);
+                if (glm::dot(offset, offset) < touchDistance * touchDistance) {
+                    expected = k;
+                    break;
+                }
+            }
+        }
+        QCOMPARE(space.getRegion(i), expected);
+    }
+
+    // nothing moved, so nothing changes
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+    QCOMPARE((uint32_t)changes.size(), (uint32_t)0);
+
+    // a proxy moved into R1 of the first view is the only change
+    workload::Transaction transaction;
+    transaction.update(7, workload::Sphere(0.0f, 0.0f, 0.0f, 1.0f));
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+    QCOMPARE(space.getRegion(7), (uint8_t)workload::Region::R1);
+    QVERIFY(changes.size() <= 1);
+    if (changes.size() == 1) {
+        QCOMPARE(changes[0].proxyId, 7);
+        QCOMPARE(changes[0].region, (uint8_t)workload::Region::R1);
+    }
+}
+
 #ifdef MANUAL_TEST
 
 const float WORLD_WIDTH = 1000.0f;
@@ -284,4 +361,31 @@ void SpaceTests::benchmark() {
     std::cout << "];" << std::endl;
 }
 
+void SpaceTests::benchmarkCategorize() {
+    uint32_t numProxies[] = { 1000, 10000, 100000 };
+    for (uint32_t n : numProxies) {
+        std::vector<workload::Space::Sphere> spheres;
+        generateSpheres(n, spheres);
+
+        workload::Space space;
+        addProxies(space, spheres);
+        space.setViews({ makeView(glm::vec3(0.0f), 0.25f * WORLD_WIDTH, 0.5f * WORLD_WIDTH, 0.75f * WORLD_WIDTH),
+                         makeView(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH),
+                                  0.25f * WORLD_WIDTH, 0.5f * WORLD_WIDTH, 0.75f * WORLD_WIDTH) });
+
+        std::vector<workload::Space::Change> changes;
+        space.categorizeAndGetChanges(changes);
+
+        // the steady state, where few proxies cross a region
+        const uint32_t NUM_FRAMES = 100;
+        uint64_t startTime = usecTimestampNow();
+        for (uint32_t i = 0; i < NUM_FRAMES; ++i) {
+            changes.clear();
+            space.categorizeAndGetChanges(changes);
+        }
+        uint64_t usec = usecTimestampNow() - startTime;
+        std::cout << "categorizeAndGetChanges of " << n << " proxies: " << usec / NUM_FRAMES << " usec" << std::endl;
+    }
+}
+
 #endif // MANUAL_TEST
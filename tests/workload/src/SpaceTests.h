@@ -21,8 +21,10 @@ class SpaceTests : public QObject {
 
 private slots:
     void testOverlaps();
+    void testCategorize();
 #ifdef MANUAL_TEST
     void benchmark();
+    void benchmarkCategorize();
 #endif // MANUAL_TEST
 };
 
@@ -0,0 +1,33 @@
+//
+//  main.cpp
+//  tools/trace-convert/src
+//
+//  Created by Vircadia contributors.
+//  Copyright 2023 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+
+#include <SharedUtil.h>
+#include <TraceRecorder.h>
+
+// Converts a dump of the trace recorder to Chrome trace event JSON, which chrome://tracing and Perfetto load.
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Trace Convert");
+
+    QCoreApplication app(argc, argv);
+    const auto arguments = app.arguments();
+    if (arguments.size() != 3) {
+        qWarning().noquote() << "usage: trace-convert <recording.hftrace> <trace.json[.gz]>";
+        return 1;
+    }
+
+    if (!tracing::TraceRecorder::convertToJson(arguments[1], arguments[2])) {
+        return 2;
+    }
+    return 0;
+}